@@ -16,6 +16,9 @@ class RequestType(enum.IntEnum):
     WriteMemory = 2,
     ProcessList = 3,
     SetGetProcess = 4,
+    PerfStats = 5,
+    ReadMemoryBatch = 6,
+    SubscribeMemory = 7,
 
 CITRA_PORT = 45987
 
@@ -23,6 +26,7 @@ class Citra:
     def __init__(self, address="127.0.0.1", port=CITRA_PORT):
         self.socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
         self.address = address
+        self.subscriptions = {}
 
     def is_connected(self):
         return self.socket is not None
@@ -89,6 +93,38 @@ class Citra:
 
         self.socket.recv(MAX_PACKET_SIZE)
 
+    def perf_stats(self):
+        """
+        Returns the performance statistics of the last period the frontend measured. The frame
+        breakdown holds the (p50, p95, p99, max) of each category per system frame, in seconds.
+        """
+        request_data = struct.pack("II", 0, 0)
+        request, request_id = self._generate_header(RequestType.PerfStats, len(request_data))
+        request += request_data
+        self.socket.sendto(request, (self.address, CITRA_PORT))
+
+        raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+        reply_data = self._read_and_validate_header(raw_reply, request_id, RequestType.PerfStats)
+
+        if not reply_data:
+            return None
+        fields = struct.unpack("<fffI28fI", reply_data[:0x84])
+        categories = ["frame", "svc", "ipc", "gpu", "swap", "jit", "shader_compiles"]
+        breakdown = {name: tuple(fields[4 + i * 4 : 8 + i * 4]) for i, name in enumerate(categories)}
+        services = {}
+        for i in range(fields[32]):
+            service_data = reply_data[0x84 + i * 0x14 : 0x84 + (i + 1) * 0x14]
+            name, requests, time, max_time = struct.unpack("<8sfff", service_data)
+            services[name.rstrip(b"\x00").decode("ascii")] = (requests, time, max_time)
+        return {
+            "system_fps": fields[0],
+            "game_fps": fields[1],
+            "emulation_speed": fields[2],
+            "shader_compiles": fields[3],
+            "frame_breakdown": breakdown,
+            "ipc_services": services,
+        }
+
     def read_memory(self, read_address, read_size):
         """
         >>> c.read_memory(0x100000, 4)
@@ -114,6 +150,79 @@ class Citra:
 
         return result
 
+    def read_memory_batch(self, ranges):
+        """
+        Reads a list of (address, size) ranges in one request, at most MAX_REQUEST_DATA_SIZE
+        bytes in total. Returns the contents of each range.
+        >>> c.read_memory_batch([(0x100000, 4), (0x100000, 2)])
+        [b'\\x07\\x00\\x00\\xeb', b'\\x07\\x00']
+        """
+        request_data = self._pack_ranges(ranges)
+        request, request_id = self._generate_header(RequestType.ReadMemoryBatch, len(request_data))
+        request += request_data
+        self.socket.sendto(request, (self.address, CITRA_PORT))
+
+        raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+        reply_data = self._read_and_validate_header(raw_reply, request_id,
+                                                    RequestType.ReadMemoryBatch)
+        if not reply_data:
+            return None
+        return self._split_ranges(ranges, reply_data)
+
+    def subscribe_memory(self, ranges, subscription_id=None):
+        """
+        Asks for a list of (address, size) ranges to be sent every frame, read them with
+        receive_subscription. Subscribing again with the same id replaces the ranges, subscribing
+        with no ranges cancels the subscription. Returns the subscription id, or None if there
+        are too many subscriptions.
+        """
+        request_data = self._pack_ranges(ranges)
+        request_id = random.getrandbits(32) if subscription_id is None else subscription_id
+        request = struct.pack("IIII", CURRENT_REQUEST_VERSION, request_id,
+                              RequestType.SubscribeMemory, len(request_data))
+        request += request_data
+        self.socket.sendto(request, (self.address, CITRA_PORT))
+
+        raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+        reply_data = self._read_and_validate_header(raw_reply, request_id,
+                                                    RequestType.SubscribeMemory)
+        if not reply_data or struct.unpack("I", reply_data)[0] == 0:
+            return None
+        if ranges:
+            self.subscriptions[request_id] = list(ranges)
+        else:
+            self.subscriptions.pop(request_id, None)
+        return request_id
+
+    def receive_subscription(self):
+        """
+        Waits for the next frame of any subscription. Returns its id and the contents of each
+        of its ranges.
+        """
+        while True:
+            raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+            reply_id = struct.unpack("I", raw_reply[4:8])[0]
+            ranges = self.subscriptions.get(reply_id)
+            if ranges is None:
+                continue
+            reply_data = self._read_and_validate_header(raw_reply, reply_id,
+                                                        RequestType.SubscribeMemory)
+            if reply_data:
+                return (reply_id, self._split_ranges(ranges, reply_data))
+
+    def _pack_ranges(self, ranges):
+        request_data = struct.pack("I", len(ranges))
+        for address, size in ranges:
+            request_data += struct.pack("II", address, size)
+        return request_data
+
+    def _split_ranges(self, ranges, data):
+        contents = []
+        for _, size in ranges:
+            contents.append(data[:size])
+            data = data[size:]
+        return contents
+
     def write_memory(self, write_address, write_contents):
         """
         >>> c.write_memory(0x100000, b"\\xff\\xff\\xff\\xff")
@@ -125,6 +125,12 @@ object NativeLibrary {
     external fun surfaceDestroyed()
     external fun doFrame()
 
+    /**
+     * Asks the emulator caches to release the memory they can do without, as the system is
+     * running low on memory.
+     */
+    external fun trimMemory()
+
     /**
      * Unpauses emulation from a paused state.
      */
@@ -602,6 +608,15 @@ object NativeLibrary {
             FileUtil.getFilesName(path)
         }
 
+    @Keep
+    @JvmStatic
+    fun getFilesInfo(path: String): Array<Any> =
+        if (FileUtil.isNativePath(path)) {
+            CitraApplication.documentsTree.getFilesInfo(path)
+        } else {
+            FileUtil.getFilesInfo(Uri.parse(path))
+        }
+
     @Keep
     @JvmStatic
     fun getSize(path: String): Long =
@@ -7,6 +7,7 @@ package org.citra.citra_emu.activities
 import android.Manifest.permission
 import android.annotation.SuppressLint
 import android.app.Activity
+import android.content.ComponentCallbacks2
 import android.content.Intent
 import android.content.SharedPreferences
 import android.content.pm.PackageManager
@@ -126,6 +127,14 @@ class EmulationActivity : AppCompatActivity() {
         enableFullscreenImmersive()
     }
 
+    override fun onTrimMemory(level: Int) {
+        super.onTrimMemory(level)
+        // Give the caches back before the system starts killing processes.
+        if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW) {
+            NativeLibrary.trimMemory()
+        }
+    }
+
     public override fun onRestart() {
         super.onRestart()
         NativeLibrary.reloadCameraDevices()
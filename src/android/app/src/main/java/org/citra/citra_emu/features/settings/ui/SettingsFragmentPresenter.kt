@@ -795,6 +795,15 @@ class SettingsFragmentPresenter(private val fragmentView: SettingsFragmentView)
                     BooleanSetting.USE_ARTIC_BASE_CONTROLLER.defaultValue
                 )
             )
+            add(
+                SwitchSetting(
+                    BooleanSetting.INPUT_LATE_LATCH,
+                    R.string.input_late_latch,
+                    R.string.input_late_latch_description,
+                    BooleanSetting.INPUT_LATE_LATCH.key,
+                    BooleanSetting.INPUT_LATE_LATCH.defaultValue
+                )
+            )
         }
     }
 
@@ -952,6 +961,15 @@ class SettingsFragmentPresenter(private val fragmentView: SettingsFragmentView)
                     BooleanSetting.DISABLE_RIGHT_EYE_RENDER.defaultValue
                 )
             )
+            add(
+                SwitchSetting(
+                    BooleanSetting.DISABLE_RIGHT_EYE_DRAWS,
+                    R.string.disable_right_eye_draws,
+                    R.string.disable_right_eye_draws_description,
+                    BooleanSetting.DISABLE_RIGHT_EYE_DRAWS.key,
+                    BooleanSetting.DISABLE_RIGHT_EYE_DRAWS.defaultValue
+                )
+            )
 
             add(HeaderSetting(R.string.cardboard_vr))
             add(
@@ -11,7 +11,12 @@ import android.provider.DocumentsContract
  * A struct that is much more "cheaper" than DocumentFile.
  * Only contains the information we needed.
  */
-class CheapDocument(val filename: String, val mimeType: String, val uri: Uri) {
+class CheapDocument(
+    val filename: String,
+    val mimeType: String,
+    val uri: Uri,
+    val size: Long = 0
+) {
     val isDirectory: Boolean
         get() = mimeType == DocumentsContract.Document.MIME_TYPE_DIR
 }
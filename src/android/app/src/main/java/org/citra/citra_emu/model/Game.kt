@@ -63,7 +63,7 @@ class Game(
         val allExtensions: Set<String> get() = extensions + badExtensions
 
         val extensions: Set<String> = HashSet(
-            listOf("3dsx", "elf", "axf", "cci", "cxi", "app")
+            listOf("3dsx", "elf", "axf", "cci", "cxi", "app", "zcci", "zcxi")
         )
 
         val badExtensions: Set<String> = HashSet(
@@ -90,6 +90,16 @@ class DocumentsTree {
         return node.getChildNames()
     }
 
+    @Synchronized
+    fun getFilesInfo(filepath: String): Array<Any> {
+        val node = resolvePath(filepath)
+        if (node == null || !node.isDirectory) {
+            return arrayOf(arrayOf<String>(), LongArray(0))
+        }
+        // The sizes change as files are written, so they are read fresh instead of cached.
+        return FileUtil.getFilesInfo(node.uri!!)
+    }
+
     @Synchronized
     fun getFileSize(filepath: String): Long {
         val node = resolvePath(filepath)
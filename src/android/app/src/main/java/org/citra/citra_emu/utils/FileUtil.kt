@@ -128,7 +128,8 @@ object FileUtil {
         val columns = arrayOf(
             DocumentsContract.Document.COLUMN_DOCUMENT_ID,
             DocumentsContract.Document.COLUMN_DISPLAY_NAME,
-            DocumentsContract.Document.COLUMN_MIME_TYPE
+            DocumentsContract.Document.COLUMN_MIME_TYPE,
+            DocumentsContract.Document.COLUMN_SIZE
         )
         var c: Cursor? = null
         val results: MutableList<CheapDocument> = ArrayList()
@@ -145,8 +146,10 @@ object FileUtil {
                 val documentId = c.getString(0)
                 val documentName = c.getString(1)
                 val documentMimeType = c.getString(2)
+                val documentSize = if (c.isNull(3)) 0 else c.getLong(3)
                 val documentUri = DocumentsContract.buildDocumentUriUsingTree(uri, documentId)
-                val document = CheapDocument(documentName, documentMimeType, documentUri)
+                val document =
+                    CheapDocument(documentName, documentMimeType, documentUri, documentSize)
                 results.add(document)
             }
         } catch (e: Exception) {
@@ -247,6 +250,22 @@ object FileUtil {
         return files.toTypedArray<String?>()
     }
 
+    /**
+     * Lists the files of a directory along with their sizes, from a single query.
+     *
+     * @param uri Directory content uri
+     * @return The file names and an array of their sizes, where directories have a size of -1
+     */
+    @JvmStatic
+    fun getFilesInfo(uri: Uri): Array<Any> {
+        val documents = listFiles(uri)
+        val names = Array(documents.size) { documents[it].filename }
+        val sizes = LongArray(documents.size) {
+            if (documents[it].isDirectory) -1 else documents[it].size
+        }
+        return arrayOf(names, sizes)
+    }
+
     /**
      * Get file size from given path.
      *
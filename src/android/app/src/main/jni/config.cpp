@@ -129,10 +129,29 @@ void Config::ReadValues() {
                                                  InputCommon::CemuhookUDP::DEFAULT_PORT));
 
     ReadSetting("Controls", Settings::values.use_artic_base_controller);
+    ReadSetting("Controls", Settings::values.input_late_latch);
 
     // Core
     ReadSetting("Core", Settings::values.use_cpu_jit);
     ReadSetting("Core", Settings::values.cpu_clock_percentage);
+    ReadSetting("Core", Settings::values.parallel_cpu_cores);
+    ReadSetting("Core", Settings::values.skip_idle_loops);
+    ReadSetting("Core", Settings::values.use_tick_profiles);
+    ReadSetting("Core", Settings::values.calibrate_tick_profiles);
+    ReadSetting("Core", Settings::values.adaptive_slice_length);
+    ReadSetting("Core", Settings::values.use_huge_pages);
+    ReadSetting("Core", Settings::values.romfs_cache_size);
+    ReadSetting("Core", Settings::values.save_data_write_back);
+    ReadSetting("Core", Settings::values.fs_delay_mode);
+    ReadSetting("Core", Settings::values.fs_delay_table);
+    ReadSetting("Core", Settings::values.enable_rewind);
+    ReadSetting("Core", Settings::values.rewind_interval);
+    ReadSetting("Core", Settings::values.rewind_buffer_size);
+    ReadSetting("Core", Settings::values.prewarm_savestate_surfaces);
+    ReadSetting("Core", Settings::values.incremental_savestates);
+    ReadSetting("Core", Settings::values.movie_turbo_playback);
+    ReadSetting("Core", Settings::values.movie_checkpoint_interval);
+    ReadSetting("Core", Settings::values.reset_to_boot_snapshot);
 
     // Renderer
     Settings::values.use_gles = sdl2_config->GetBoolean("Renderer", "use_gles", true);
@@ -140,13 +159,21 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "shaders_accurate_mul", false);
     ReadSetting("Renderer", Settings::values.graphics_api);
     ReadSetting("Renderer", Settings::values.async_presentation);
+    ReadSetting("Renderer", Settings::values.skip_unchanged_uploads);
+    ReadSetting("Renderer", Settings::values.texture_memory_budget);
+    ReadSetting("Renderer", Settings::values.generate_mipmaps);
+    ReadSetting("Renderer", Settings::values.parallel_command_recording);
+    ReadSetting("Renderer", Settings::values.present_queue_depth);
+    ReadSetting("Renderer", Settings::values.bindless_textures);
     ReadSetting("Renderer", Settings::values.async_shader_compilation);
+    ReadSetting("Renderer", Settings::values.use_uber_shaders);
     ReadSetting("Renderer", Settings::values.spirv_shader_gen);
     ReadSetting("Renderer", Settings::values.disable_spirv_optimizer);
     ReadSetting("Renderer", Settings::values.use_hw_shader);
     ReadSetting("Renderer", Settings::values.use_shader_jit);
     ReadSetting("Renderer", Settings::values.resolution_factor);
     ReadSetting("Renderer", Settings::values.use_disk_shader_cache);
+    ReadSetting("Renderer", Settings::values.use_shared_shader_cache);
     ReadSetting("Renderer", Settings::values.use_vsync_new);
     ReadSetting("Renderer", Settings::values.texture_filter);
     ReadSetting("Renderer", Settings::values.texture_sampling);
@@ -174,6 +201,7 @@ void Config::ReadValues() {
     ReadSetting("Renderer", Settings::values.bg_blue);
     ReadSetting("Renderer", Settings::values.delay_game_render_thread_us);
     ReadSetting("Renderer", Settings::values.disable_right_eye_render);
+    ReadSetting("Renderer", Settings::values.disable_right_eye_draws);
 
     // Layout
     // Somewhat inelegant solution to ensure layout value is between 0 and 5 on read
@@ -220,14 +248,17 @@ void Config::ReadValues() {
 
     // Utility
     ReadSetting("Utility", Settings::values.dump_textures);
+    ReadSetting("Utility", Settings::values.texture_dump_compression);
     ReadSetting("Utility", Settings::values.custom_textures);
     ReadSetting("Utility", Settings::values.preload_textures);
     ReadSetting("Utility", Settings::values.async_custom_loading);
+    ReadSetting("Utility", Settings::values.custom_texture_budget);
 
     // Audio
     ReadSetting("Audio", Settings::values.audio_emulation);
     ReadSetting("Audio", Settings::values.enable_audio_stretching);
     ReadSetting("Audio", Settings::values.enable_realtime_audio);
+    ReadSetting("Audio", Settings::values.threaded_audio_hle);
     ReadSetting("Audio", Settings::values.volume);
     ReadSetting("Audio", Settings::values.output_type);
     ReadSetting("Audio", Settings::values.output_device);
@@ -236,6 +267,8 @@ void Config::ReadValues() {
 
     // Data Storage
     ReadSetting("Data Storage", Settings::values.use_virtual_sd);
+    ReadSetting("Data Storage", Settings::values.use_artic_disk_cache);
+    ReadSetting("Data Storage", Settings::values.use_artic_compression);
 
     // System
     ReadSetting("System", Settings::values.is_new_3ds);
@@ -307,6 +340,10 @@ void Config::ReadValues() {
         sdl2_config->GetString("WebService", "web_api_url", "https://api.citra-emu.org");
     NetSettings::values.citra_username = sdl2_config->GetString("WebService", "citra_username", "");
     NetSettings::values.citra_token = sdl2_config->GetString("WebService", "citra_token", "");
+
+    // Multiplayer
+    NetSettings::values.direct_connections =
+        sdl2_config->GetBoolean("Multiplayer", "direct_connections", false);
 }
 
 void Config::Reload() {
@@ -26,6 +26,7 @@
 #include "common/file_util.h"
 #include "common/logging/backend.h"
 #include "common/logging/log.h"
+#include "common/memory_detect.h"
 #include "common/microprofile.h"
 #include "common/scm_rev.h"
 #include "common/scope_exit.h"
@@ -496,6 +497,12 @@ void Java_org_citra_citra_1emu_NativeLibrary_unPauseEmulation([[maybe_unused]] J
     }
 }
 
+void Java_org_citra_citra_1emu_NativeLibrary_trimMemory([[maybe_unused]] JNIEnv* env,
+                                                        [[maybe_unused]] jobject obj) {
+    LOG_INFO(Frontend, "Releasing cached memory at the request of the system");
+    Common::RequestMemoryTrim();
+}
+
 void Java_org_citra_citra_1emu_NativeLibrary_pauseEmulation([[maybe_unused]] JNIEnv* env,
                                                             [[maybe_unused]] jobject obj) {
     pause_emulation = true;
@@ -2,18 +2,33 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstddef>
 #include "audio_core/dsp_interface.h"
 #include "audio_core/sink.h"
 #include "audio_core/sink_details.h"
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/dumping/backend.h"
 
 namespace AudioCore {
 
-DspInterface::DspInterface(Core::System& system_) : system(system_) {}
+namespace {
+
+/// Latency the audio output starts with, in frames of the native sample rate.
+constexpr std::size_t InitialTargetLatency = samples_per_frame * 4;
+/// Bounds of the adaptive target latency.
+constexpr std::size_t MinTargetLatency = samples_per_frame * 2;
+constexpr std::size_t MaxTargetLatency = samples_per_frame * 16;
+/// Callbacks without an underrun after which the target latency is lowered again.
+constexpr std::size_t LatencyDecayCallbacks = 512;
+
+} // Anonymous namespace
+
+DspInterface::DspInterface(Core::System& system_)
+    : system(system_), stretch_input(fifo.Capacity() * 2), target_latency(InitialTargetLatency) {}
 
 DspInterface::~DspInterface() = default;
 
@@ -74,9 +89,8 @@ void DspInterface::OutputCallback(s16* buffer, std::size_t num_frames) {
 
     std::size_t frames_written = 0;
     if (performing_time_stretching) {
-        const std::vector<s16> in{fifo.Pop()};
-        const std::size_t num_in{in.size() / 2};
-        frames_written = time_stretcher.Process(in.data(), num_in, buffer, num_frames);
+        const std::size_t num_in = fifo.Pop(stretch_input.data(), fifo.Capacity());
+        frames_written = time_stretcher.Process(stretch_input.data(), num_in, buffer, num_frames);
     } else {
         if (flushing_time_stretcher) {
             time_stretcher.Flush();
@@ -87,7 +101,9 @@ void DspInterface::OutputCallback(s16* buffer, std::size_t num_frames) {
             // so that they do not bleed into the next time the stretcher is enabled.
             time_stretcher.Clear();
         }
+        TrimQueuedFrames(num_frames);
         frames_written += fifo.Pop(buffer, num_frames - frames_written);
+        UpdateTargetLatency(frames_written, num_frames);
     }
 
     if (frames_written > 0) {
@@ -111,4 +127,29 @@ void DspInterface::OutputCallback(s16* buffer, std::size_t num_frames) {
     }
 }
 
+void DspInterface::TrimQueuedFrames(std::size_t num_frames) {
+    // Emulation running slightly faster than the sink makes the queue grow without bound, which
+    // is heard as lag. Output is unstretched here, so skip ahead instead of letting it build up.
+    const std::size_t queued = fifo.Size();
+    if (queued > num_frames + target_latency * 2) {
+        fifo.Discard(queued - num_frames - target_latency);
+    }
+}
+
+void DspInterface::UpdateTargetLatency(std::size_t frames_written, std::size_t num_frames) {
+    // An empty queue means emulation is paused or silent, only a partial fill is an underrun.
+    if (frames_written > 0 && frames_written < num_frames) {
+        underrun_count++;
+        callbacks_since_underrun = 0;
+        target_latency = std::min(target_latency + num_frames, MaxTargetLatency);
+        LOG_DEBUG(Audio, "Audio underrun {}, target latency raised to {} frames", underrun_count,
+                  target_latency);
+        return;
+    }
+    if (++callbacks_since_underrun >= LatencyDecayCallbacks) {
+        callbacks_since_underrun = 0;
+        target_latency = std::max(target_latency - target_latency / 4, MinTargetLatency);
+    }
+}
+
 } // namespace AudioCore
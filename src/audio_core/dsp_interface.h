@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <span>
+#include <vector>
 #include <boost/serialization/access.hpp>
 #include "audio_core/audio_types.h"
 #include "audio_core/time_stretch.h"
@@ -113,6 +114,10 @@ protected:
 private:
     void FlushResidualStretcherAudio();
     void OutputCallback(s16* buffer, std::size_t num_frames);
+    /// Drops queued audio that built up beyond the target latency while not stretching.
+    void TrimQueuedFrames(std::size_t num_frames);
+    /// Raises the target latency after an underrun and slowly lowers it while output is steady.
+    void UpdateTargetLatency(std::size_t frames_written, std::size_t num_frames);
 
     Core::System& system;
 
@@ -121,6 +126,10 @@ private:
     std::atomic<bool> flushing_time_stretcher = false;
     Common::RingBuffer<s16, 0x2000, 2> fifo;
     std::array<s16, 2> last_frame{};
+    std::vector<s16> stretch_input;
+    std::size_t target_latency;
+    std::size_t callbacks_since_underrun = 0;
+    std::size_t underrun_count = 0;
     TimeStretcher time_stretcher;
     std::unique_ptr<Sink> sink;
 
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <neaacdec.h>
 #include "audio_core/hle/aac_decoder.h"
 
@@ -105,7 +106,10 @@ BinaryMessage AACDecoder::Decode(const BinaryMessage& request) {
         data_len -= init_result;
     }
 
-    std::array<std::vector<s16>, 2> out_streams;
+    // The stream buffers are kept between requests, so they only grow for the first frames.
+    for (auto& stream : out_streams) {
+        stream.clear();
+    }
 
     while (data_len > 0) {
         NeAACDecFrameInfo frame_info;
@@ -120,11 +124,16 @@ BinaryMessage AACDecoder::Decode(const BinaryMessage& request) {
         response.decode_aac_response.sample_rate = GetSampleRateEnum(frame_info.samplerate);
         response.decode_aac_response.num_channels = frame_info.channels;
 
-        // Split the decode result into channels.
-        u32 num_samples = frame_info.samples / frame_info.channels;
-        for (u32 sample = 0; sample < num_samples; sample++) {
-            for (u32 ch = 0; ch < frame_info.channels; ch++) {
-                out_streams[ch].push_back(curr_sample_buffer[(sample * frame_info.channels) + ch]);
+        // Split the decode result into channels, anything past stereo has nowhere to go.
+        const u32 num_channels = frame_info.channels;
+        const u32 num_samples = frame_info.samples / num_channels;
+        for (u32 ch = 0; ch < std::min<u32>(num_channels, out_streams.size()); ch++) {
+            auto& stream = out_streams[ch];
+            const std::size_t offset = stream.size();
+            stream.resize(offset + num_samples);
+            const s16* in = curr_sample_buffer + ch;
+            for (u32 sample = 0; sample < num_samples; sample++) {
+                stream[offset + sample] = in[sample * num_channels];
             }
         }
 
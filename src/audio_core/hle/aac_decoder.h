@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
 #include "audio_core/hle/decoder.h"
 
 namespace AudioCore::HLE {
@@ -23,6 +25,7 @@ private:
     Memory::MemorySystem& memory;
     NeAACDecHandle decoder = nullptr;
     bool decoder_initialized = false;
+    std::array<std::vector<s16>, 2> out_streams;
 };
 
 } // namespace AudioCore::HLE
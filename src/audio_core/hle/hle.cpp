@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <thread>
 
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/base_object.hpp>
@@ -24,6 +25,7 @@
 #include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
+#include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 
@@ -74,10 +76,17 @@ private:
     HLE::SharedMemory& ReadRegion();
     HLE::SharedMemory& WriteRegion();
 
-    StereoFrame16 GenerateCurrentFrame();
+    StereoFrame16 GenerateCurrentFrame(HLE::SharedMemory& read, HLE::SharedMemory& write);
     bool Tick();
     void AudioTickCallback(s64 cycles_late);
 
+    /// Hands the current configuration to the audio thread and returns the frame it generated
+    /// from the configuration of the previous tick.
+    StereoFrame16 TickThreaded();
+    /// Waits for the audio thread to finish the frame it is generating, if any.
+    void WaitForFrame();
+    void AudioThreadLoop(std::stop_token stop_token);
+
     DspState dsp_state = DspState::Off;
     std::array<std::vector<u8>, num_dsp_pipe> pipe_data{};
 
@@ -99,8 +108,24 @@ private:
 
     std::function<void(Service::DSP::InterruptType type, DspPipe pipe)> interrupt_handler{};
 
+    /// Frames are generated on the audio thread one tick ahead, from a snapshot of the
+    /// configuration. The emulation thread only waits for it at ticks and pipe writes.
+    bool threaded{};
+    bool frame_in_flight{};
+    bool frame_ready{};
+    HLE::SharedMemory thread_read;
+    HLE::SharedMemory thread_write;
+    StereoFrame16 thread_frame{};
+    Common::Event frame_requested;
+    Common::Event frame_done;
+    std::jthread audio_thread;
+
     template <class Archive>
     void serialize(Archive& ar, const unsigned int) {
+        // A frame still being generated would race with the sources being serialized, the
+        // statuses it produces are dropped.
+        WaitForFrame();
+        frame_ready = false;
         ar & dsp_state;
         ar & pipe_data;
         ar & dsp_memory.raw_memory;
@@ -125,10 +150,20 @@ DspHle::Impl::Impl(DspHle& parent_, Memory::MemorySystem& memory, Core::Timing&
             this->AudioTickCallback(cycles_late);
         });
     core_timing.ScheduleEvent(audio_frame_ticks, tick_event);
+
+    threaded = Settings::values.threaded_audio_hle.GetValue();
+    if (threaded) {
+        audio_thread =
+            std::jthread([this](std::stop_token stop_token) { AudioThreadLoop(stop_token); });
+    }
 }
 
 DspHle::Impl::~Impl() {
     core_timing.UnscheduleEvent(tick_event, 0);
+    if (threaded) {
+        audio_thread.request_stop();
+        frame_requested.Set();
+    }
 }
 
 DspState DspHle::Impl::GetDspState() const {
@@ -201,6 +236,9 @@ size_t DspHle::Impl::GetPipeReadableSize(DspPipe pipe_number) const {
 }
 
 void DspHle::Impl::PipeWrite(DspPipe pipe_number, std::span<const u8> buffer) {
+    // State changes and decodes must not overlap with a frame being generated.
+    WaitForFrame();
+
     switch (pipe_number) {
     case DspPipe::Audio: {
         if (buffer.size() != 4) {
@@ -367,10 +405,8 @@ HLE::SharedMemory& DspHle::Impl::WriteRegion() {
     return CurrentRegionIndex() != 0 ? dsp_memory.region_0 : dsp_memory.region_1;
 }
 
-StereoFrame16 DspHle::Impl::GenerateCurrentFrame() {
-    HLE::SharedMemory& read = ReadRegion();
-    HLE::SharedMemory& write = WriteRegion();
-
+StereoFrame16 DspHle::Impl::GenerateCurrentFrame(HLE::SharedMemory& read,
+                                                  HLE::SharedMemory& write) {
     std::array<QuadFrame32, 3> intermediate_mixes = {};
 
     // Generate intermediate mixes
@@ -403,13 +439,68 @@ bool DspHle::Impl::Tick() {
 
     // TODO: Check dsp::DSP semaphore (which indicates emulated application has finished writing to
     // shared memory region)
-    current_frame = GenerateCurrentFrame();
+    if (threaded) {
+        current_frame = TickThreaded();
+    } else {
+        current_frame = GenerateCurrentFrame(ReadRegion(), WriteRegion());
+    }
 
     parent.OutputFrame(std::move(current_frame));
 
     return GetDspState() == DspState::On;
 }
 
+StereoFrame16 DspHle::Impl::TickThreaded() {
+    WaitForFrame();
+
+    StereoFrame16 current_frame = {};
+    if (frame_ready) {
+        HLE::SharedMemory& write = WriteRegion();
+        write.source_statuses = thread_write.source_statuses;
+        write.dsp_status = thread_write.dsp_status;
+        write.intermediate_mix_samples = thread_write.intermediate_mix_samples;
+        write.final_samples = thread_write.final_samples;
+        current_frame = thread_frame;
+        frame_ready = false;
+    }
+
+    // The configuration is consumed now, as the sources would when generating synchronously.
+    HLE::SharedMemory& read = ReadRegion();
+    thread_read = read;
+    for (auto& config : read.source_configurations.config) {
+        if (config.buffer_queue_dirty) {
+            config.buffers_dirty = 0;
+        }
+        config.dirty_raw = 0;
+    }
+    read.dsp_configuration.dirty_raw = 0;
+
+    frame_in_flight = true;
+    frame_requested.Set();
+    return current_frame;
+}
+
+void DspHle::Impl::WaitForFrame() {
+    if (!frame_in_flight) {
+        return;
+    }
+    frame_done.Wait();
+    frame_in_flight = false;
+    frame_ready = true;
+}
+
+void DspHle::Impl::AudioThreadLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("DspHle");
+    while (true) {
+        frame_requested.Wait();
+        if (stop_token.stop_requested()) {
+            break;
+        }
+        thread_frame = GenerateCurrentFrame(thread_read, thread_write);
+        frame_done.Set();
+    }
+}
+
 void DspHle::Impl::AudioTickCallback(s64 cycles_late) {
     if (Tick()) {
         // TODO(merry): Signal all the other interrupts as appropriate.
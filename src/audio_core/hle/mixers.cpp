@@ -8,6 +8,15 @@
 #include "common/assert.h"
 #include "common/logging/log.h"
 
+#if defined(CITRA_HAS_SSE42)
+#include <smmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#define CITRA_HAS_NEON
+#include <arm_neon.h>
+#endif
+
 namespace AudioCore::HLE {
 
 void Mixers::Reset() {
@@ -94,6 +103,42 @@ static std::array<s16, 2> AddAndClampToS16(const std::array<s16, 2>& a,
             ClampToS16(static_cast<s32>(a[1]) + static_cast<s32>(b[1]))};
 }
 
+#if defined(CITRA_HAS_SSE42) || defined(CITRA_HAS_NEON)
+/// Downmixes the quadraphonic samples to stereo and accumulates them into the frame.
+static void DownmixStereo(StereoFrame16& frame, float gain, const QuadFrame32& samples) {
+    // Two samples are downmixed at a time, the saturating pack and add of the vector units
+    // perform the clamps of the scalar path.
+    static_assert(samples_per_frame % 2 == 0);
+#if defined(CITRA_HAS_SSE42)
+    const __m128 vgain = _mm_set1_ps(gain);
+    const auto downmix = [&vgain](const std::array<s32, 4>& sample) {
+        const __m128i quad = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sample.data()));
+        const __m128 product = _mm_mul_ps(vgain, _mm_cvtepi32_ps(quad));
+        return _mm_add_ps(product, _mm_movehl_ps(product, product));
+    };
+    for (std::size_t i = 0; i < samples_per_frame; i += 2) {
+        const __m128 stereo = _mm_movelh_ps(downmix(samples[i]), downmix(samples[i + 1]));
+        const __m128i converted = _mm_cvttps_epi32(stereo);
+        auto* const out = reinterpret_cast<__m128i*>(frame[i].data());
+        const __m128i mixed =
+            _mm_adds_epi16(_mm_loadl_epi64(out), _mm_packs_epi32(converted, converted));
+        _mm_storel_epi64(out, mixed);
+    }
+#else
+    const auto downmix = [gain](const std::array<s32, 4>& sample) {
+        const float32x4_t product = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(sample.data())), gain);
+        return vadd_f32(vget_low_f32(product), vget_high_f32(product));
+    };
+    for (std::size_t i = 0; i < samples_per_frame; i += 2) {
+        const float32x4_t stereo = vcombine_f32(downmix(samples[i]), downmix(samples[i + 1]));
+        const int16x4_t converted = vqmovn_s32(vcvtq_s32_f32(stereo));
+        s16* const out = frame[i].data();
+        vst1_s16(out, vqadd_s16(vld1_s16(out), converted));
+    }
+#endif
+}
+#endif
+
 void Mixers::DownmixAndMixIntoCurrentFrame(float gain, const QuadFrame32& samples) {
     // TODO(merry): Limiter. (Currently we're performing final mixing assuming a disabled limiter.)
 
@@ -117,6 +162,9 @@ void Mixers::DownmixAndMixIntoCurrentFrame(float gain, const QuadFrame32& sample
         // fallthrough
 
     case OutputFormat::Stereo:
+#if defined(CITRA_HAS_SSE42) || defined(CITRA_HAS_NEON)
+        DownmixStereo(current_frame, gain, samples);
+#else
         std::transform(
             current_frame.begin(), current_frame.end(), samples.begin(), current_frame.begin(),
             [gain](const std::array<s16, 2>& accumulator,
@@ -127,6 +175,7 @@ void Mixers::DownmixAndMixIntoCurrentFrame(float gain, const QuadFrame32& sample
                 // Mix into current frame
                 return AddAndClampToS16(accumulator, {left, right});
             });
+#endif
         return;
     }
 
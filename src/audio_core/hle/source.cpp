@@ -9,9 +9,19 @@
 #include "audio_core/hle/source.h"
 #include "audio_core/interpolate.h"
 #include "common/assert.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "core/memory.h"
 
+#if defined(CITRA_HAS_SSE42)
+#include <smmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#define CITRA_HAS_NEON
+#include <arm_neon.h>
+#endif
+
 namespace AudioCore::HLE {
 
 SourceStatus::Status Source::Tick(SourceConfiguration::Configuration& config,
@@ -30,6 +40,39 @@ void Source::MixInto(QuadFrame32& dest, std::size_t intermediate_mix_id) const {
         return;
 
     const std::array<float, 4>& gains = state.gain.at(intermediate_mix_id);
+#if defined(CITRA_HAS_SSE42) || defined(CITRA_HAS_NEON)
+    // Conversion from stereo (current_frame) to quadraphonic (dest) occurs here. Each stereo
+    // sample is duplicated into the four lanes of a vector, two samples at a time.
+    static_assert(samples_per_frame % 2 == 0);
+#if defined(CITRA_HAS_SSE42)
+    const __m128 gain = _mm_loadu_ps(gains.data());
+    const auto mix = [&gain](s32* out, __m128i stereo) {
+        const __m128 product = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(stereo)), gain);
+        const __m128i sum = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<__m128i*>(out)),
+                                          _mm_cvttps_epi32(product));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sum);
+    };
+    for (std::size_t samplei = 0; samplei < samples_per_frame; samplei += 2) {
+        const __m128i pair =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(current_frame[samplei].data()));
+        const __m128i stereo = _mm_unpacklo_epi32(pair, pair);
+        mix(dest[samplei].data(), stereo);
+        mix(dest[samplei + 1].data(), _mm_srli_si128(stereo, 8));
+    }
+#else
+    const float32x4_t gain = vld1q_f32(gains.data());
+    const auto mix = [&gain](s32* out, int32x2_t stereo) {
+        const int32x4_t quad = vcombine_s32(stereo, stereo);
+        const float32x4_t product = vmulq_f32(vcvtq_f32_s32(quad), gain);
+        vst1q_s32(out, vaddq_s32(vld1q_s32(out), vcvtq_s32_f32(product)));
+    };
+    for (std::size_t samplei = 0; samplei < samples_per_frame; samplei += 2) {
+        const int32x4_t pair = vmovl_s16(vld1_s16(current_frame[samplei].data()));
+        mix(dest[samplei].data(), vget_low_s32(pair));
+        mix(dest[samplei + 1].data(), vget_high_s32(pair));
+    }
+#endif
+#else
     for (std::size_t samplei = 0; samplei < samples_per_frame; samplei++) {
         // Conversion from stereo (current_frame) to quadraphonic (dest) occurs here.
         dest[samplei][0] += static_cast<s32>(gains[0] * current_frame[samplei][0]);
@@ -37,11 +80,13 @@ void Source::MixInto(QuadFrame32& dest, std::size_t intermediate_mix_id) const {
         dest[samplei][2] += static_cast<s32>(gains[2] * current_frame[samplei][0]);
         dest[samplei][3] += static_cast<s32>(gains[3] * current_frame[samplei][1]);
     }
+#endif
 }
 
 void Source::Reset() {
     current_frame.fill({});
     state = {};
+    decode_cache = {};
 }
 
 void Source::SetMemory(Memory::MemorySystem& memory) {
@@ -386,22 +431,7 @@ bool Source::DequeueBuffer() {
     const u8* const memory = memory_system->GetPhysicalPointer(buf.physical_address & 0xFFFFFFFC);
     if (memory) {
         const unsigned num_channels = buf.mono_or_stereo == MonoOrStereo::Stereo ? 2 : 1;
-        switch (buf.format) {
-        case Format::PCM8:
-            state.current_buffer = Codec::DecodePCM8(num_channels, memory, buf.length);
-            break;
-        case Format::PCM16:
-            state.current_buffer = Codec::DecodePCM16(num_channels, memory, buf.length);
-            break;
-        case Format::ADPCM:
-            DEBUG_ASSERT(num_channels == 1);
-            state.current_buffer =
-                Codec::DecodeADPCM(memory, buf.length, state.adpcm_coeffs, state.adpcm_state);
-            break;
-        default:
-            UNIMPLEMENTED();
-            break;
-        }
+        DecodeBuffer(buf, memory, num_channels);
     } else {
         LOG_WARNING(Audio_DSP,
                     "source_id={} buffer_id={} length={}: Invalid physical address {:#010x}",
@@ -436,6 +466,71 @@ bool Source::DequeueBuffer() {
     return true;
 }
 
+void Source::DecodeBuffer(const Buffer& buf, const u8* memory, unsigned num_channels) {
+    std::size_t data_size = 0;
+    switch (buf.format) {
+    case Format::PCM8:
+        data_size = static_cast<std::size_t>(buf.length) * num_channels;
+        break;
+    case Format::PCM16:
+        data_size = static_cast<std::size_t>(buf.length) * num_channels * sizeof(s16);
+        break;
+    case Format::ADPCM:
+        // Frames are 8 bytes long containing 14 samples each.
+        data_size = (static_cast<std::size_t>(buf.length) + 13) / 14 * 8;
+        break;
+    default:
+        break;
+    }
+
+    // Only looping buffers are replayed, caching streamed buffers would only add a copy.
+    const bool cacheable = buf.is_looping && data_size != 0;
+    const u64 data_hash = cacheable ? Common::ComputeHash64(memory, data_size) : 0;
+    auto& cache = decode_cache;
+    if (cacheable && cache.valid && cache.physical_address == buf.physical_address &&
+        cache.length == buf.length && cache.format == buf.format &&
+        cache.num_channels == num_channels && cache.data_hash == data_hash &&
+        (buf.format != Format::ADPCM ||
+         (cache.adpcm_coeffs == state.adpcm_coeffs &&
+          cache.adpcm_state_in.yn1 == state.adpcm_state.yn1 &&
+          cache.adpcm_state_in.yn2 == state.adpcm_state.yn2))) {
+        state.current_buffer = cache.samples;
+        state.adpcm_state = cache.adpcm_state_out;
+        return;
+    }
+
+    const Codec::ADPCMState adpcm_state_in = state.adpcm_state;
+    switch (buf.format) {
+    case Format::PCM8:
+        state.current_buffer = Codec::DecodePCM8(num_channels, memory, buf.length);
+        break;
+    case Format::PCM16:
+        state.current_buffer = Codec::DecodePCM16(num_channels, memory, buf.length);
+        break;
+    case Format::ADPCM:
+        DEBUG_ASSERT(num_channels == 1);
+        state.current_buffer =
+            Codec::DecodeADPCM(memory, buf.length, state.adpcm_coeffs, state.adpcm_state);
+        break;
+    default:
+        UNIMPLEMENTED();
+        break;
+    }
+
+    cache.valid = cacheable;
+    if (cacheable) {
+        cache.physical_address = buf.physical_address;
+        cache.length = buf.length;
+        cache.format = buf.format;
+        cache.num_channels = num_channels;
+        cache.data_hash = data_hash;
+        cache.adpcm_coeffs = state.adpcm_coeffs;
+        cache.adpcm_state_in = adpcm_state_in;
+        cache.adpcm_state_out = state.adpcm_state;
+        cache.samples = state.current_buffer;
+    }
+}
+
 SourceStatus::Status Source::GetCurrentStatus() {
     SourceStatus::Status ret;
 
@@ -182,6 +182,21 @@ private:
 
     } state;
 
+    /// The last looping buffer decoded by this source. A loop is replayed from it instead of being
+    /// decoded again while the guest data and the decoder state it was decoded with are unchanged.
+    struct DecodeCache {
+        bool valid;
+        PAddr physical_address;
+        u32 length;
+        Format format;
+        unsigned num_channels;
+        u64 data_hash;
+        std::array<s16, 16> adpcm_coeffs;
+        Codec::ADPCMState adpcm_state_in;
+        Codec::ADPCMState adpcm_state_out;
+        AudioInterp::StereoBuffer16 samples;
+    } decode_cache{};
+
     // Internal functions
 
     /// INTERNAL: Update our internal state based on the current config.
@@ -191,6 +206,8 @@ private:
     /// INTERNAL: Dequeues a buffer and does preprocessing on it (decoding, resampling). Puts it
     /// into current_buffer.
     bool DequeueBuffer();
+    /// INTERNAL: Decodes a buffer into current_buffer, looping buffers go through decode_cache.
+    void DecodeBuffer(const Buffer& buf, const u8* memory, unsigned num_channels);
     /// INTERNAL: Generates a SourceStatus::Status based on our internal state.
     SourceStatus::Status GetCurrentStatus();
 
@@ -3,9 +3,19 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include "audio_core/interpolate.h"
 #include "common/assert.h"
 
+#if defined(CITRA_HAS_SSE42)
+#include <smmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#define CITRA_HAS_NEON
+#include <arm_neon.h>
+#endif
+
 namespace AudioCore::AudioInterp {
 
 // Calculations are done in fixed point with 24 fractional bits.
@@ -57,19 +67,56 @@ void None(State& state, StereoBuffer16& input, float rate, StereoFrame16& output
         [](u64 fraction, const auto& x0, const auto& x1, const auto& x2) { return x0; });
 }
 
+/// Interpolates both channels between x0 and x1 at the provided fraction.
+static std::array<s16, 2> LinearSample(u64 fraction, const std::array<s16, 2>& x0,
+                                       const std::array<s16, 2>& x1) {
+#if defined(CITRA_HAS_SSE42) || defined(CITRA_HAS_NEON)
+    // The scalar path divides the product as an unsigned value, which after the truncation to
+    // 16 bits rounds towards negative infinity, so the vector paths shift the product instead.
+    u32 packed0, packed1;
+    std::memcpy(&packed0, x0.data(), sizeof(packed0));
+    std::memcpy(&packed1, x1.data(), sizeof(packed1));
+#if defined(CITRA_HAS_SSE42)
+    const __m128i v0 = _mm_cvtsi32_si128(static_cast<s32>(packed0));
+    const __m128i v1 = _mm_cvtsi32_si128(static_cast<s32>(packed1));
+    // This is a saturated subtraction. (Verified by black-box fuzzing.)
+    const __m128i delta = _mm_cvtepi16_epi64(_mm_subs_epi16(v1, v0));
+    const __m128i product = _mm_mul_epi32(delta, _mm_set1_epi32(static_cast<s32>(fraction)));
+    // Only the low halves of the shifted products are kept, so a logical shift is enough.
+    const __m128i step = _mm_shuffle_epi32(_mm_srli_epi64(product, 24), _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i sum = _mm_add_epi32(_mm_cvtepi16_epi32(v0), step);
+    const s32 packed = _mm_cvtsi128_si32(_mm_packs_epi32(sum, sum));
+#else
+    const int16x4_t v0 = vreinterpret_s16_u32(vdup_n_u32(packed0));
+    const int16x4_t v1 = vreinterpret_s16_u32(vdup_n_u32(packed1));
+    // This is a saturated subtraction. (Verified by black-box fuzzing.)
+    const int32x2_t delta = vget_low_s32(vmovl_s16(vqsub_s16(v1, v0)));
+    const int64x2_t product = vmull_s32(delta, vdup_n_s32(static_cast<s32>(fraction)));
+    const int32x2_t step = vmovn_s64(vshrq_n_s64(product, 24));
+    const int32x2_t sum = vadd_s32(vget_low_s32(vmovl_s16(v0)), step);
+    const s32 packed = vget_lane_s32(vreinterpret_s32_s16(vmovn_s32(vcombine_s32(sum, sum))), 0);
+#endif
+    std::array<s16, 2> result;
+    std::memcpy(result.data(), &packed, sizeof(packed));
+    return result;
+#else
+    // This is a saturated subtraction. (Verified by black-box fuzzing.)
+    s64 delta0 = std::clamp<s64>(x1[0] - x0[0], -32768, 32767);
+    s64 delta1 = std::clamp<s64>(x1[1] - x0[1], -32768, 32767);
+
+    return std::array<s16, 2>{
+        static_cast<s16>(x0[0] + fraction * delta0 / scale_factor),
+        static_cast<s16>(x0[1] + fraction * delta1 / scale_factor),
+    };
+#endif
+}
+
 void Linear(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
             std::size_t& outputi) {
     // Note on accuracy: Some values that this produces are +/- 1 from the actual firmware.
     StepOverSamples(state, input, rate, output, outputi,
                     [](u64 fraction, const auto& x0, const auto& x1, const auto& x2) {
-                        // This is a saturated subtraction. (Verified by black-box fuzzing.)
-                        s64 delta0 = std::clamp<s64>(x1[0] - x0[0], -32768, 32767);
-                        s64 delta1 = std::clamp<s64>(x1[1] - x0[1], -32768, 32767);
-
-                        return std::array<s16, 2>{
-                            static_cast<s16>(x0[0] + fraction * delta0 / scale_factor),
-                            static_cast<s16>(x0[1] + fraction * delta1 / scale_factor),
-                        };
+                        return LinearSample(fraction, x0, x1);
                     });
 }
 
@@ -4,13 +4,14 @@
 
 #include <array>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <teakra/teakra.h>
 #include "audio_core/lle/lle.h"
 #include "common/assert.h"
 #include "common/bit_field.h"
 #include "common/swap.h"
-#include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/dsp/dsp_dsp.h"
@@ -142,44 +143,70 @@ struct DspLle::Impl final {
 
     const bool multithread;
     std::thread teakra_thread;
-    Common::Barrier teakra_slice_barrier{2};
-    std::atomic<bool> stop_signal = false;
-    std::size_t stop_generation;
+    std::mutex teakra_slice_mutex;
+    std::condition_variable teakra_slice_cv;
+    u32 pending_slices = 0; ///< Slices granted to the DSP thread that it has not finished yet.
+    bool stop_signal = false;
 
     static constexpr u32 DspDataOffset = 0x40000;
     static constexpr u32 TeakraSlice = 16384;
+    /// Slices the DSP thread may lag behind the timing events before the CPU thread waits on it.
+    static constexpr u32 TeakraMaxPendingSlices = 4;
 
     void TeakraThread() {
         while (true) {
-            teakra.Run(TeakraSlice);
-            teakra_slice_barrier.Sync();
-            if (stop_signal) {
-                if (stop_generation == teakra_slice_barrier.Generation())
+            {
+                std::unique_lock lock{teakra_slice_mutex};
+                teakra_slice_cv.wait(lock, [this] { return pending_slices > 0 || stop_signal; });
+                if (stop_signal) {
                     break;
+                }
+            }
+            teakra.Run(TeakraSlice);
+            {
+                std::scoped_lock lock{teakra_slice_mutex};
+                pending_slices--;
             }
+            teakra_slice_cv.notify_all();
         }
+    }
+
+    void StartTeakraThread() {
+        // The DSP thread starts with one slice in flight, as it always runs ahead of the CPU.
+        pending_slices = 1;
         stop_signal = false;
+        teakra_thread = std::thread(&Impl::TeakraThread, this);
     }
 
     void StopTeakraThread() {
         if (teakra_thread.joinable()) {
-            stop_generation = teakra_slice_barrier.Generation() + 1;
-            stop_signal = true;
-            teakra_slice_barrier.Sync();
+            {
+                std::scoped_lock lock{teakra_slice_mutex};
+                stop_signal = true;
+            }
+            teakra_slice_cv.notify_all();
             teakra_thread.join();
         }
     }
 
-    void RunTeakraSlice() {
+    /**
+     * Runs a slice of DSP cycles. When the DSP runs on its own thread, the slice is queued and
+     * the call only waits until no more than max_pending slices are left to run, so the CPU
+     * thread does not have to meet the DSP thread at every slice.
+     */
+    void RunTeakraSlice(u32 max_pending = 1) {
         if (multithread) {
-            teakra_slice_barrier.Sync();
+            std::unique_lock lock{teakra_slice_mutex};
+            pending_slices++;
+            teakra_slice_cv.notify_all();
+            teakra_slice_cv.wait(lock, [&] { return pending_slices <= max_pending; });
         } else {
             teakra.Run(TeakraSlice);
         }
     }
 
     void TeakraSliceEvent(u64 late) {
-        RunTeakraSlice();
+        RunTeakraSlice(TeakraMaxPendingSlices);
         u64 next = TeakraSlice * 2; // DSP runs at clock rate half of the CPU rate
         if (next < late)
             next = 0;
@@ -329,7 +356,7 @@ struct DspLle::Impl final {
         core_timing.ScheduleEvent(TeakraSlice, teakra_slice_event, 0);
 
         if (multithread) {
-            teakra_thread = std::thread(&Impl::TeakraThread, this);
+            StartTeakraThread();
         }
 
         // Wait for initialization
@@ -25,6 +25,21 @@ constexpr char help_string[] =
     // TODO: Move -m outside of this check when it is implemented in Qt frontend
     "-m, --multiplayer [nick:password@address:port]   Nickname, password, address and port for "
     "multiplayer (currently only usable with SDL frontend)\n"
+    "-H, --headless              Run with the software renderer and no display or frame limit "
+    "(SDL frontend only)\n"
+    "-D, --dump-frames [path]    Write the screens of every frame as PNGs to the given directory "
+    "(with --headless)\n"
+    "-c, --frames [count]        Exit after the given number of frames (with --headless)\n"
+    "-t, --replay [path]         Time the replay of a CiTrace file on the configured renderer, "
+    "the application is only used to boot the system (SDL frontend only)\n"
+    "-l, --replay-loops [count]  Number of times to replay the trace (with --replay)\n"
+    "-b, --batch [path]          Run the headless jobs of a job file and check the hash of their "
+    "last frame (SDL frontend only)\n"
+    "-j, --batch-jobs [count]    Number of jobs to run at the same time (with --batch)\n"
+    "-T, --profile-trace [path]  Write the profiler scopes as a Chrome trace JSON file, which "
+    "chrome://tracing and Perfetto open (SDL frontend only)\n"
+    "-F, --profile-frames [[first:]count]   Frames to trace (with --profile-trace), all of them "
+    "until exit by default\n"
 #endif
 #ifdef ENABLE_ROOM
     "    --room                  Utilize dedicated multiplayer room functionality (equivalent to "
@@ -17,15 +17,18 @@ QtCameraInterface::QtCameraInterface(const Service::CAM::Flip& flip) {
 }
 
 void QtCameraInterface::SetFormat(Service::CAM::OutputFormat output_format) {
+    converted_frame.clear();
     output_rgb = output_format == Service::CAM::OutputFormat::RGB565;
 }
 
 void QtCameraInterface::SetResolution(const Service::CAM::Resolution& resolution) {
+    converted_frame.clear();
     width = resolution.width;
     height = resolution.height;
 }
 
 void QtCameraInterface::SetFlip(Service::CAM::Flip flip) {
+    converted_frame.clear();
     using namespace Service::CAM;
     flip_horizontal = basic_flip_horizontal ^ (flip == Flip::Horizontal || flip == Flip::Reverse);
     flip_vertical = basic_flip_vertical ^ (flip == Flip::Vertical || flip == Flip::Reverse);
@@ -38,8 +41,15 @@ void QtCameraInterface::SetEffect(Service::CAM::Effect effect) {
 }
 
 std::vector<u16> QtCameraInterface::ReceiveFrame() {
-    return CameraUtil::ProcessImage(QtReceiveFrame(), width, height, output_rgb, flip_horizontal,
-                                    flip_vertical);
+    if (is_static_image && !converted_frame.empty()) {
+        return converted_frame;
+    }
+    std::vector<u16> frame = CameraUtil::ProcessImage(QtReceiveFrame(), width, height, output_rgb,
+                                                      flip_horizontal, flip_vertical);
+    if (is_static_image) {
+        converted_frame = frame;
+    }
+    return frame;
 }
 
 std::unique_ptr<CameraInterface> QtCameraFactory::CreatePreview(const std::string& config,
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "core/frontend/camera/factory.h"
 
 namespace Camera {
@@ -20,11 +21,16 @@ public:
     std::vector<u16> ReceiveFrame() override;
     virtual QImage QtReceiveFrame() = 0;
 
+protected:
+    /// Set by sources whose image never changes, they are then only converted once per setting.
+    bool is_static_image = false;
+
 private:
     int width, height;
     bool output_rgb;
     bool flip_horizontal, flip_vertical;
     bool basic_flip_horizontal, basic_flip_vertical;
+    std::vector<u16> converted_frame;
 };
 
 // Base class for camera factories of citra_qt
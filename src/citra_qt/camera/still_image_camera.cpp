@@ -12,7 +12,9 @@
 namespace Camera {
 
 StillImageCamera::StillImageCamera(QImage image_, const Service::CAM::Flip& flip)
-    : QtCameraInterface(flip), image(std::move(image_)) {}
+    : QtCameraInterface(flip), image(std::move(image_)) {
+    is_static_image = true;
+}
 
 StillImageCamera::~StillImageCamera() {
     StillImageCameraFactory::last_path.clear();
@@ -826,6 +826,13 @@ void GMainWindow::InitializeHotkeys() {
     connect_shortcut(QStringLiteral("Increase Speed Limit"), [&] { AdjustSpeedLimit(true); });
     connect_shortcut(QStringLiteral("Decrease Speed Limit"), [&] { AdjustSpeedLimit(false); });
 
+    connect_shortcut(QStringLiteral("Rewind"), [&] {
+        if (emulation_running) {
+            system.SendSignal(Core::System::Signal::Rewind);
+            system.frame_limiter.AdvanceFrame();
+        }
+    });
+
     connect_shortcut(QStringLiteral("Audio Mute/Unmute"), &GMainWindow::OnMute);
     connect_shortcut(QStringLiteral("Audio Volume Down"), &GMainWindow::OnDecreaseVolume);
     connect_shortcut(QStringLiteral("Audio Volume Up"), &GMainWindow::OnIncreaseVolume);
@@ -2236,7 +2243,8 @@ void GMainWindow::OnMenuSetUpSystemFiles() {
 void GMainWindow::OnMenuInstallCIA() {
     QStringList filepaths = QFileDialog::getOpenFileNames(
         this, tr("Load Files"), UISettings::values.roms_path,
-        tr("3DS Installation File (*.CIA*)") + QStringLiteral(";;") + tr("All Files (*.*)"));
+        tr("3DS Installation File (*.CIA* *.ZCIA*)") + QStringLiteral(";;") +
+            tr("All Files (*.*)"));
 
     if (filepaths.isEmpty()) {
         return;
@@ -3220,6 +3228,9 @@ void GMainWindow::UpdateStatusBar() {
         artic_traffic_label->setText(
             tr("Artic Traffic: %1 %2%3").arg(value, 0, 'f', 0).arg(unit).arg(event));
         artic_traffic_label->setStyleSheet(style_sheet);
+        artic_traffic_label->setToolTip(tr("%1 requests/s, %2 ms mean latency")
+                                            .arg(results.artic_requests, 0, 'f', 0)
+                                            .arg(results.artic_latency * 1000.0, 0, 'f', 1));
     }
 
     if (Settings::GetFrameLimit() == 0) {
@@ -3231,14 +3242,67 @@ void GMainWindow::UpdateStatusBar() {
     }
     game_fps_label->setText(tr("App: %1 FPS").arg(results.game_fps, 0, 'f', 0));
     if (UISettings::values.show_advanced_frametime_info) {
+        const u64 texture_used_mib = results.texture_memory_used >> 20;
+        const QString texture_memory =
+            results.texture_memory_budget != 0
+                ? tr("%1/%2 MiB").arg(texture_used_mib).arg(results.texture_memory_budget >> 20)
+                : tr("%1 MiB").arg(texture_used_mib);
+        const QString custom_textures =
+            results.custom_texture_queue_depth != 0 || results.custom_texture_latency != 0
+                ? tr(", Custom: %1 queued, %2 ms")
+                      .arg(results.custom_texture_queue_depth)
+                      .arg(results.custom_texture_latency * 1000.0, 0, 'f', 1)
+                : QString{};
+        const QString staging =
+            results.staging_memory != 0
+                ? (results.staging_stalls != 0
+                       ? tr(", Staging: %1 MiB, %2 stalls")
+                             .arg(results.staging_memory >> 20)
+                             .arg(results.staging_stalls)
+                       : tr(", Staging: %1 MiB").arg(results.staging_memory >> 20))
+                : QString{};
+        const QString render_passes =
+            results.render_passes != 0
+                ? tr(", Passes: %1 (%2 merged, %3 MiB saved)")
+                      .arg(results.render_passes, 0, 'f', 0)
+                      .arg(results.merged_render_passes, 0, 'f', 0)
+                      .arg(results.render_pass_bytes_saved / (1024.0 * 1024.0), 0, 'f', 1)
+                : QString{};
+        const QString present_latency =
+            results.present_latency != 0
+                ? tr(", Present: %1 ms").arg(results.present_latency * 1000.0, 0, 'f', 1)
+                : QString{};
+        const QString software_transfers =
+            results.software_transfers != 0
+                ? tr(", SW transfers: %1/%2")
+                      .arg(results.software_transfers, 0, 'f', 1)
+                      .arg(results.gpu_transfers, 0, 'f', 1)
+                : QString{};
         emu_frametime_label->setText(
-            tr("Frame: %1 ms (GPU: [CMD: %2 ms, SWP: %3 ms], IPC: %4 ms, SVC: %5 ms, Rem: %6 ms)")
+            tr("Frame: %1 ms (GPU: [CMD: %2 ms, SWP: %3 ms], IPC: %4 ms, SVC: %5 ms, Rem: %6 ms, "
+               "Tex: %7%8)")
                 .arg(results.time_vblank_interval * 1000.0, 2, 'f', 2)
                 .arg(results.time_gpu * 1000.0, 2, 'f', 2)
                 .arg(results.time_swap * 1000.0, 2, 'f', 2)
                 .arg(results.time_hle_ipc * 1000.0, 2, 'f', 2)
                 .arg(results.time_hle_svc * 1000.0, 2, 'f', 2)
-                .arg(results.time_remaining * 1000.0, 2, 'f', 2));
+                .arg(results.time_remaining * 1000.0, 2, 'f', 2)
+                .arg(texture_memory + custom_textures + staging)
+                .arg(render_passes + present_latency + software_transfers));
+
+        // The most expensive SVCs, which the SVC time above sums up.
+        QString svcs;
+        for (std::size_t i = 0; i < std::min<std::size_t>(results.svcs.size(), 5); i++) {
+            const auto& svc = results.svcs[i];
+            svcs += tr("\n%1: %2 calls, %3 ms")
+                        .arg(QString::fromStdString(svc.name))
+                        .arg(svc.calls_per_frame, 0, 'f', 0)
+                        .arg(svc.time_per_frame * 1000.0, 0, 'f', 2);
+        }
+        emu_frametime_label->setToolTip(
+            tr("Time taken to emulate a 3DS frame, not counting framelimiting or v-sync. For "
+               "full-speed emulation this should be at most 16.67 ms.") +
+            svcs);
     } else {
         emu_frametime_label->setText(
             tr("Frame: %1 ms").arg(results.time_vblank_interval * 1000.0, 2, 'f', 2));
@@ -3514,8 +3578,8 @@ static bool IsSingleFileDropEvent(const QMimeData* mime) {
     return mime->hasUrls() && mime->urls().length() == 1;
 }
 
-static const std::array<std::string, 8> AcceptedExtensions = {"cci", "cxi", "bin", "3dsx",
-                                                              "app", "elf", "axf"};
+static const std::array<std::string, 9> AcceptedExtensions = {
+    "cci", "cxi", "bin", "3dsx", "app", "elf", "axf", "zcci", "zcxi"};
 
 static bool IsCorrectFileExtension(const QMimeData* mime) {
     const QString& filename = mime->urls().at(0).toLocalFile();
@@ -54,7 +54,7 @@ const std::array<std::array<int, 5>, Settings::NativeAnalog::NumAnalogs> QtConfi
 // This must be in alphabetical order according to action name as it must have the same order as
 // UISetting::values.shortcuts, which is alphabetically ordered.
 // clang-format off
-const std::array<UISettings::Shortcut, 38> QtConfig::default_hotkeys {{
+const std::array<UISettings::Shortcut, 39> QtConfig::default_hotkeys {{
      {QStringLiteral("Advance Frame"),            QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::ApplicationShortcut}},
      {QStringLiteral("Audio Mute/Unmute"),        QStringLiteral("Main Window"), {QStringLiteral("Ctrl+M"), Qt::WindowShortcut}},
      {QStringLiteral("Audio Volume Down"),        QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::WindowShortcut}},
@@ -80,6 +80,7 @@ const std::array<UISettings::Shortcut, 38> QtConfig::default_hotkeys {{
      {QStringLiteral("Quick Load"),               QStringLiteral("Main Window"), {QStringLiteral(""),       Qt::WindowShortcut}},
      {QStringLiteral("Remove Amiibo"),            QStringLiteral("Main Window"), {QStringLiteral("F3"),     Qt::ApplicationShortcut}},
      {QStringLiteral("Restart Emulation"),        QStringLiteral("Main Window"), {QStringLiteral("F6"),     Qt::WindowShortcut}},
+     {QStringLiteral("Rewind"),                   QStringLiteral("Main Window"), {QStringLiteral("Backspace"), Qt::WindowShortcut}},
      {QStringLiteral("Rotate Screens Upright"),   QStringLiteral("Main Window"), {QStringLiteral("F8"),     Qt::WindowShortcut}},
      {QStringLiteral("Save to Oldest Non-Quicksave Slot"),  QStringLiteral("Main Window"), {QStringLiteral("Ctrl+C"), Qt::WindowShortcut}},
      {QStringLiteral("Stop Emulation"),           QStringLiteral("Main Window"), {QStringLiteral("F5"),     Qt::WindowShortcut}},
@@ -289,6 +290,7 @@ void QtConfig::ReadAudioValues() {
         ReadBasicSetting(Settings::values.output_device);
         ReadBasicSetting(Settings::values.input_type);
         ReadBasicSetting(Settings::values.input_device);
+        ReadBasicSetting(Settings::values.threaded_audio_hle);
     }
 
     qt_config->endGroup();
@@ -332,6 +334,7 @@ void QtConfig::ReadControlValues() {
     qt_config->beginGroup(QStringLiteral("Controls"));
 
     ReadBasicSetting(Settings::values.use_artic_base_controller);
+    ReadBasicSetting(Settings::values.input_late_latch);
 
     int num_touch_from_button_maps =
         qt_config->beginReadArray(QStringLiteral("touch_from_button_maps"));
@@ -454,6 +457,11 @@ void QtConfig::ReadUtilityValues() {
     ReadGlobalSetting(Settings::values.preload_textures);
     ReadGlobalSetting(Settings::values.async_custom_loading);
 
+    if (global) {
+        ReadBasicSetting(Settings::values.texture_dump_compression);
+        ReadBasicSetting(Settings::values.custom_texture_budget);
+    }
+
     qt_config->endGroup();
 }
 
@@ -461,9 +469,27 @@ void QtConfig::ReadCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     ReadGlobalSetting(Settings::values.cpu_clock_percentage);
+    ReadGlobalSetting(Settings::values.fs_delay_mode);
 
     if (global) {
         ReadBasicSetting(Settings::values.use_cpu_jit);
+        ReadBasicSetting(Settings::values.parallel_cpu_cores);
+        ReadBasicSetting(Settings::values.skip_idle_loops);
+        ReadBasicSetting(Settings::values.use_tick_profiles);
+        ReadBasicSetting(Settings::values.calibrate_tick_profiles);
+        ReadBasicSetting(Settings::values.adaptive_slice_length);
+        ReadBasicSetting(Settings::values.use_huge_pages);
+        ReadBasicSetting(Settings::values.romfs_cache_size);
+        ReadBasicSetting(Settings::values.save_data_write_back);
+        ReadBasicSetting(Settings::values.fs_delay_table);
+        ReadBasicSetting(Settings::values.enable_rewind);
+        ReadBasicSetting(Settings::values.rewind_interval);
+        ReadBasicSetting(Settings::values.rewind_buffer_size);
+        ReadBasicSetting(Settings::values.prewarm_savestate_surfaces);
+        ReadBasicSetting(Settings::values.incremental_savestates);
+        ReadBasicSetting(Settings::values.movie_turbo_playback);
+        ReadBasicSetting(Settings::values.movie_checkpoint_interval);
+        ReadBasicSetting(Settings::values.reset_to_boot_snapshot);
         ReadBasicSetting(Settings::values.delay_start_for_lle_modules);
     }
 
@@ -475,6 +501,8 @@ void QtConfig::ReadDataStorageValues() {
 
     ReadBasicSetting(Settings::values.use_virtual_sd);
     ReadBasicSetting(Settings::values.use_custom_storage);
+    ReadBasicSetting(Settings::values.use_artic_disk_cache);
+    ReadBasicSetting(Settings::values.use_artic_compression);
 
     const std::string nand_dir =
         ReadSetting(QStringLiteral("nand_directory"), QStringLiteral("")).toString().toStdString();
@@ -598,6 +626,8 @@ void QtConfig::ReadMultiplayerValues() {
         ReadSetting(QStringLiteral("multiplayer_filter_hide_empty"), false).toBool();
     UISettings::values.multiplayer_filter_hide_full =
         ReadSetting(QStringLiteral("multiplayer_filter_hide_full"), false).toBool();
+    NetSettings::values.direct_connections =
+        ReadSetting(QStringLiteral("direct_connections"), false).toBool();
 
     // Read ban list back
     int size = qt_config->beginReadArray(QStringLiteral("username_ban_list"));
@@ -698,9 +728,18 @@ void QtConfig::ReadRendererValues() {
 
     ReadGlobalSetting(Settings::values.delay_game_render_thread_us);
     ReadGlobalSetting(Settings::values.disable_right_eye_render);
+    ReadGlobalSetting(Settings::values.disable_right_eye_draws);
 
     if (global) {
         ReadBasicSetting(Settings::values.use_shader_jit);
+        ReadBasicSetting(Settings::values.use_shared_shader_cache);
+        ReadBasicSetting(Settings::values.use_uber_shaders);
+        ReadBasicSetting(Settings::values.skip_unchanged_uploads);
+        ReadBasicSetting(Settings::values.texture_memory_budget);
+        ReadBasicSetting(Settings::values.generate_mipmaps);
+        ReadBasicSetting(Settings::values.parallel_command_recording);
+        ReadBasicSetting(Settings::values.present_queue_depth);
+        ReadBasicSetting(Settings::values.bindless_textures);
     }
 
     qt_config->endGroup();
@@ -920,6 +959,7 @@ void QtConfig::SaveAudioValues() {
         WriteBasicSetting(Settings::values.output_device);
         WriteBasicSetting(Settings::values.input_type);
         WriteBasicSetting(Settings::values.input_device);
+        WriteBasicSetting(Settings::values.threaded_audio_hle);
     }
 
     qt_config->endGroup();
@@ -959,6 +999,7 @@ void QtConfig::SaveControlValues() {
     qt_config->beginGroup(QStringLiteral("Controls"));
 
     WriteBasicSetting(Settings::values.use_artic_base_controller);
+    WriteBasicSetting(Settings::values.input_late_latch);
 
     WriteSetting(QStringLiteral("profile"), Settings::values.current_input_profile_index, 0);
     qt_config->beginWriteArray(QStringLiteral("profiles"));
@@ -1024,6 +1065,11 @@ void QtConfig::SaveUtilityValues() {
     WriteGlobalSetting(Settings::values.preload_textures);
     WriteGlobalSetting(Settings::values.async_custom_loading);
 
+    if (global) {
+        WriteBasicSetting(Settings::values.texture_dump_compression);
+        WriteBasicSetting(Settings::values.custom_texture_budget);
+    }
+
     qt_config->endGroup();
 }
 
@@ -1031,9 +1077,27 @@ void QtConfig::SaveCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     WriteGlobalSetting(Settings::values.cpu_clock_percentage);
+    WriteGlobalSetting(Settings::values.fs_delay_mode);
 
     if (global) {
         WriteBasicSetting(Settings::values.use_cpu_jit);
+        WriteBasicSetting(Settings::values.parallel_cpu_cores);
+        WriteBasicSetting(Settings::values.skip_idle_loops);
+        WriteBasicSetting(Settings::values.use_tick_profiles);
+        WriteBasicSetting(Settings::values.calibrate_tick_profiles);
+        WriteBasicSetting(Settings::values.adaptive_slice_length);
+        WriteBasicSetting(Settings::values.use_huge_pages);
+        WriteBasicSetting(Settings::values.romfs_cache_size);
+        WriteBasicSetting(Settings::values.save_data_write_back);
+        WriteBasicSetting(Settings::values.fs_delay_table);
+        WriteBasicSetting(Settings::values.enable_rewind);
+        WriteBasicSetting(Settings::values.rewind_interval);
+        WriteBasicSetting(Settings::values.rewind_buffer_size);
+        WriteBasicSetting(Settings::values.prewarm_savestate_surfaces);
+        WriteBasicSetting(Settings::values.incremental_savestates);
+        WriteBasicSetting(Settings::values.movie_turbo_playback);
+        WriteBasicSetting(Settings::values.movie_checkpoint_interval);
+        WriteBasicSetting(Settings::values.reset_to_boot_snapshot);
         WriteBasicSetting(Settings::values.delay_start_for_lle_modules);
     }
 
@@ -1045,6 +1109,8 @@ void QtConfig::SaveDataStorageValues() {
 
     WriteBasicSetting(Settings::values.use_virtual_sd);
     WriteBasicSetting(Settings::values.use_custom_storage);
+    WriteBasicSetting(Settings::values.use_artic_disk_cache);
+    WriteBasicSetting(Settings::values.use_artic_compression);
     WriteSetting(QStringLiteral("nand_directory"),
                  QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::NANDDir)),
                  QStringLiteral(""));
@@ -1154,6 +1220,8 @@ void QtConfig::SaveMultiplayerValues() {
                  UISettings::values.multiplayer_filter_hide_empty, false);
     WriteSetting(QStringLiteral("multiplayer_filter_hide_full"),
                  UISettings::values.multiplayer_filter_hide_full, false);
+    WriteSetting(QStringLiteral("direct_connections"), NetSettings::values.direct_connections,
+                 false);
 
     // Write ban list
     qt_config->beginWriteArray(QStringLiteral("username_ban_list"));
@@ -1228,10 +1296,19 @@ void QtConfig::SaveRendererValues() {
 
     WriteGlobalSetting(Settings::values.delay_game_render_thread_us);
     WriteGlobalSetting(Settings::values.disable_right_eye_render);
+    WriteGlobalSetting(Settings::values.disable_right_eye_draws);
 
     if (global) {
         WriteSetting(QStringLiteral("use_shader_jit"), Settings::values.use_shader_jit.GetValue(),
                      true);
+        WriteBasicSetting(Settings::values.use_shared_shader_cache);
+        WriteBasicSetting(Settings::values.use_uber_shaders);
+        WriteBasicSetting(Settings::values.skip_unchanged_uploads);
+        WriteBasicSetting(Settings::values.texture_memory_budget);
+        WriteBasicSetting(Settings::values.generate_mipmaps);
+        WriteBasicSetting(Settings::values.parallel_command_recording);
+        WriteBasicSetting(Settings::values.present_queue_depth);
+        WriteBasicSetting(Settings::values.bindless_textures);
     }
 
     qt_config->endGroup();
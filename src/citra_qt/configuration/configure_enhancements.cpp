@@ -7,9 +7,7 @@
 #include "citra_qt/configuration/configure_enhancements.h"
 #include "common/settings.h"
 #include "ui_configure_enhancements.h"
-#ifdef ENABLE_OPENGL
-#include "video_core/renderer_opengl/post_processing_opengl.h"
-#endif
+#include "video_core/post_processing.h"
 
 ConfigureEnhancements::ConfigureEnhancements(QWidget* parent)
     : QWidget(parent), ui(std::make_unique<Ui::ConfigureEnhancements>()) {
@@ -67,6 +65,7 @@ void ConfigureEnhancements::SetConfiguration() {
     ui->toggle_preload_textures->setChecked(Settings::values.preload_textures.GetValue());
     ui->toggle_async_custom_loading->setChecked(Settings::values.async_custom_loading.GetValue());
     ui->disable_right_eye_render->setChecked(Settings::values.disable_right_eye_render.GetValue());
+    ui->disable_right_eye_draws->setChecked(Settings::values.disable_right_eye_draws.GetValue());
 }
 
 void ConfigureEnhancements::updateShaders(Settings::StereoRenderOption stereo_option) {
@@ -92,14 +91,12 @@ void ConfigureEnhancements::updateShaders(Settings::StereoRenderOption stereo_op
 
     ui->shader_combobox->setCurrentIndex(0);
 
-#ifdef ENABLE_OPENGL
-    for (const auto& shader : OpenGL::GetPostProcessingShaderList(
+    for (const auto& shader : VideoCore::GetPostProcessingShaderList(
              stereo_option == Settings::StereoRenderOption::Anaglyph)) {
         ui->shader_combobox->addItem(QString::fromStdString(shader));
         if (current_shader == shader)
             ui->shader_combobox->setCurrentIndex(ui->shader_combobox->count() - 1);
     }
-#endif
 }
 
 void ConfigureEnhancements::RetranslateUI() {
@@ -138,6 +135,8 @@ void ConfigureEnhancements::ApplyConfiguration() {
     ConfigurationShared::ApplyPerGameSetting(&Settings::values.disable_right_eye_render,
                                              ui->disable_right_eye_render,
                                              disable_right_eye_render);
+    ConfigurationShared::ApplyPerGameSetting(&Settings::values.disable_right_eye_draws,
+                                             ui->disable_right_eye_draws, disable_right_eye_draws);
 }
 
 void ConfigureEnhancements::SetupPerGameUI() {
@@ -153,6 +152,8 @@ void ConfigureEnhancements::SetupPerGameUI() {
             Settings::values.async_custom_loading.UsingGlobal());
         ui->disable_right_eye_render->setEnabled(
             Settings::values.disable_right_eye_render.UsingGlobal());
+        ui->disable_right_eye_draws->setEnabled(
+            Settings::values.disable_right_eye_draws.UsingGlobal());
         return;
     }
 
@@ -176,6 +177,9 @@ void ConfigureEnhancements::SetupPerGameUI() {
     ConfigurationShared::SetColoredTristate(ui->disable_right_eye_render,
                                             Settings::values.disable_right_eye_render,
                                             disable_right_eye_render);
+    ConfigurationShared::SetColoredTristate(ui->disable_right_eye_draws,
+                                            Settings::values.disable_right_eye_draws,
+                                            disable_right_eye_draws);
 
     ConfigurationShared::SetColoredComboBox(
         ui->resolution_factor_combobox, ui->widget_resolution,
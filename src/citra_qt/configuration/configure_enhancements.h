@@ -44,5 +44,6 @@ private:
     ConfigurationShared::CheckState preload_textures;
     ConfigurationShared::CheckState async_custom_loading;
     ConfigurationShared::CheckState disable_right_eye_render;
+    ConfigurationShared::CheckState disable_right_eye_draws;
     QColor bg_color;
 };
@@ -2,12 +2,18 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include "citra_qt/compatibility_list.h"
 #include "citra_qt/game_list.h"
 #include "citra_qt/game_list_p.h"
@@ -15,8 +21,11 @@
 #include "citra_qt/uisettings.h"
 #include "common/common_paths.h"
 #include "common/file_util.h"
+#include "common/logging/log.h"
 #include "core/hle/service/am/am.h"
 #include "core/hle/service/fs/archive.h"
+#include "core/hw/aes/key.h"
+#include "core/hw/unique_data.h"
 #include "core/loader/loader.h"
 
 namespace {
@@ -24,6 +33,14 @@ bool HasSupportedFileExtension(const std::string& file_name) {
     const QFileInfo file = QFileInfo(QString::fromStdString(file_name));
     return GameList::supported_file_extensions.contains(file.suffix(), Qt::CaseInsensitive);
 }
+
+// Bump whenever the layout of the cache or what is stored in TitleMetadata changes.
+constexpr quint32 MetadataCacheVersion = 1;
+
+QString GetMetadataCachePath() {
+    return QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir)) +
+           QStringLiteral("game_list/metadata.bin");
+}
 } // Anonymous namespace
 
 GameListWorker::GameListWorker(QVector<UISettings::GameDir>& game_dirs,
@@ -48,90 +65,195 @@ void GameListWorker::AddFstEntriesToGameList(const std::string& dir_path, unsign
         const std::string physical_name = directory + DIR_SEP + virtual_name;
         const bool is_dir = FileUtil::IsDirectory(physical_name);
         if (!is_dir && HasSupportedFileExtension(physical_name)) {
-            std::unique_ptr<Loader::AppLoader> loader = Loader::GetLoader(physical_name);
-            if (!loader) {
-                return true;
-            }
+            // Titles are read in parallel, as reading them is much slower than listing them.
+            scan_workers->QueueWork([this, physical_name, parent_dir, media_type] {
+                AddEntry(physical_name, parent_dir, media_type);
+            });
+        } else if (is_dir && recursion > 0) {
+            watch_list.append(QString::fromStdString(physical_name));
+            AddFstEntriesToGameList(physical_name, recursion - 1, parent_dir, media_type);
+        }
 
-            bool executable = false;
-            const auto res = loader->IsExecutable(executable);
-            if (!executable && res != Loader::ResultStatus::ErrorEncrypted) {
-                return true;
-            }
+        return true;
+    };
 
-            u64 program_id = 0;
-            loader->ReadProgramId(program_id);
-
-            u64 extdata_id = 0;
-            loader->ReadExtdataId(extdata_id);
-
-            std::vector<u8> smdh;
-            // Look for an update icon if available
-            if (!(program_id & ~0x00040000FFFFFFFF)) {
-                std::string update_path = Service::AM::GetTitleContentPath(
-                    Service::FS::MediaType::SDMC, program_id | 0x0000000E00000000);
-                if (FileUtil::Exists(update_path)) {
-                    std::unique_ptr<Loader::AppLoader> update_loader =
-                        Loader::GetLoader(update_path);
-                    if (update_loader) {
-                        update_loader->ReadIcon(smdh);
-                    }
-                }
-            }
+    FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
+}
 
-            if (!Loader::IsValidSMDH(smdh)) {
-                // Read the original smdh if there is no valid update smdh
-                loader->ReadIcon(smdh);
-            }
+void GameListWorker::AddEntry(const std::string& physical_name, GameListDir* parent_dir,
+                              Service::FS::MediaType media_type) {
+    if (stop_processing) {
+        return;
+    }
+
+    const TitleMetadata title = GetTitleMetadata(physical_name);
+    if (!title.is_title) {
+        return;
+    }
+    const u64 program_id = title.program_id;
+
+    std::vector<u8> smdh;
+    // Look for an update icon if available
+    if (!(program_id & ~0x00040000FFFFFFFF)) {
+        std::string update_path = Service::AM::GetTitleContentPath(
+            Service::FS::MediaType::SDMC, program_id | 0x0000000E00000000);
+        if (FileUtil::Exists(update_path)) {
+            smdh = GetTitleMetadata(update_path).smdh;
+        }
+    }
 
-            const auto system_title = ((program_id >> 32) & 0xFFFFFFFF) == 0x00040010;
-            if (Loader::IsValidSMDH(smdh)) {
-                if (system_title) {
-                    auto smdh_struct = reinterpret_cast<Loader::SMDH*>(smdh.data());
-                    if (!(smdh_struct->flags & Loader::SMDH::Flags::Visible)) {
-                        // Skip system titles without the visible flag.
-                        return true;
-                    }
-                }
-            } else if (UISettings::values.game_list_hide_no_icon || system_title) {
-                // Skip this invalid entry
-                return true;
+    if (!Loader::IsValidSMDH(smdh)) {
+        // Use the original smdh if there is no valid update smdh
+        smdh = title.smdh;
+    }
+
+    const auto system_title = ((program_id >> 32) & 0xFFFFFFFF) == 0x00040010;
+    if (Loader::IsValidSMDH(smdh)) {
+        if (system_title) {
+            auto smdh_struct = reinterpret_cast<Loader::SMDH*>(smdh.data());
+            if (!(smdh_struct->flags & Loader::SMDH::Flags::Visible)) {
+                // Skip system titles without the visible flag.
+                return;
             }
+        }
+    } else if (UISettings::values.game_list_hide_no_icon || system_title) {
+        // Skip this invalid entry
+        return;
+    }
 
-            auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
-
-            // The game list uses this as compatibility number for untested games
-            QString compatibility(QStringLiteral("99"));
-            if (it != compatibility_list.end())
-                compatibility = it->second.first;
-
-            emit EntryReady(
-                {
-                    new GameListItemPath(QString::fromStdString(physical_name), smdh, program_id,
-                                         extdata_id, media_type,
-                                         res == Loader::ResultStatus::ErrorEncrypted),
-                    new GameListItemCompat(compatibility),
-                    new GameListItemRegion(smdh),
-                    new GameListItem(
-                        QString::fromStdString(Loader::GetFileTypeString(loader->GetFileType()))),
-                    new GameListItemSize(FileUtil::GetSize(physical_name)),
-                    new GameListItemPlayTime(play_time_manager.GetPlayTime(program_id)),
-                },
-                parent_dir);
+    auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
-        } else if (is_dir && recursion > 0) {
-            watch_list.append(QString::fromStdString(physical_name));
-            AddFstEntriesToGameList(physical_name, recursion - 1, parent_dir, media_type);
+    // The game list uses this as compatibility number for untested games
+    QString compatibility(QStringLiteral("99"));
+    if (it != compatibility_list.end())
+        compatibility = it->second.first;
+
+    emit EntryReady(
+        {
+            new GameListItemPath(QString::fromStdString(physical_name), smdh, program_id,
+                                 title.extdata_id, media_type, title.encrypted),
+            new GameListItemCompat(compatibility),
+            new GameListItemRegion(smdh),
+            new GameListItem(title.file_type),
+            new GameListItemSize(static_cast<u64>(title.size)),
+            new GameListItemPlayTime(play_time_manager.GetPlayTime(program_id)),
+        },
+        parent_dir);
+}
+
+GameListWorker::TitleMetadata GameListWorker::GetTitleMetadata(const std::string& physical_name) {
+    const QFileInfo file_info(QString::fromStdString(physical_name));
+    const qint64 size = file_info.size();
+    const qint64 last_modified = file_info.lastModified().toMSecsSinceEpoch();
+    {
+        std::scoped_lock lock{metadata_cache_mutex};
+        // Encrypted titles are always read again, as keys may have been added since.
+        const auto it = metadata_cache.find(physical_name);
+        if (it != metadata_cache.end() && it->second.size == size &&
+            it->second.last_modified == last_modified && !it->second.encrypted) {
+            it->second.used = true;
+            return it->second;
         }
+    }
 
-        return true;
-    };
+    TitleMetadata title;
+    title.size = size;
+    title.last_modified = last_modified;
+    title.used = true;
+    if (std::unique_ptr<Loader::AppLoader> loader = Loader::GetLoader(physical_name)) {
+        bool executable = false;
+        const auto res = loader->IsExecutable(executable);
+        title.encrypted = res == Loader::ResultStatus::ErrorEncrypted;
+        title.is_title = executable || title.encrypted;
+        loader->ReadProgramId(title.program_id);
+        loader->ReadExtdataId(title.extdata_id);
+        loader->ReadIcon(title.smdh);
+        title.file_type = QString::fromStdString(Loader::GetFileTypeString(loader->GetFileType()));
+    }
 
-    FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
+    std::scoped_lock lock{metadata_cache_mutex};
+    metadata_cache.insert_or_assign(physical_name, title);
+    metadata_cache_changed = true;
+    return title;
+}
+
+void GameListWorker::LoadMetadataCache() {
+    QFile file(GetMetadataCachePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    quint32 version;
+    quint32 count;
+    stream >> version >> count;
+    if (stream.status() != QDataStream::Ok || version != MetadataCacheVersion) {
+        return;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        QByteArray smdh;
+        TitleMetadata title;
+        quint64 program_id;
+        quint64 extdata_id;
+        stream >> path >> title.size >> title.last_modified >> title.is_title >>
+            title.encrypted >> program_id >> extdata_id >> title.file_type >> smdh;
+        title.program_id = program_id;
+        title.extdata_id = extdata_id;
+        title.smdh.assign(smdh.begin(), smdh.end());
+        if (stream.status() == QDataStream::Ok) {
+            metadata_cache.insert_or_assign(path.toStdString(), std::move(title));
+        }
+    }
+    loaded_cache_entries = metadata_cache.size();
+}
+
+void GameListWorker::SaveMetadataCache() {
+    // Titles that were not seen during this scan have been removed or moved away.
+    std::size_t used_entries = 0;
+    for (const auto& [path, title] : metadata_cache) {
+        used_entries += title.used ? 1 : 0;
+    }
+    if (!metadata_cache_changed && used_entries == loaded_cache_entries) {
+        return;
+    }
+
+    const QString cache_path = GetMetadataCachePath();
+    if (!FileUtil::CreateFullPath(cache_path.toStdString())) {
+        return;
+    }
+    QSaveFile file(cache_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_WARNING(Frontend, "Could not write the game list cache to {}",
+                    cache_path.toStdString());
+        return;
+    }
+    QDataStream stream(&file);
+    stream << MetadataCacheVersion << static_cast<quint32>(used_entries);
+    for (const auto& [path, title] : metadata_cache) {
+        if (!title.used) {
+            continue;
+        }
+        stream << QString::fromStdString(path) << title.size << title.last_modified
+               << title.is_title << title.encrypted << static_cast<quint64>(title.program_id)
+               << static_cast<quint64>(title.extdata_id) << title.file_type
+               << QByteArray(reinterpret_cast<const char*>(title.smdh.data()),
+                             static_cast<qsizetype>(title.smdh.size()));
+    }
+    file.commit();
 }
 
 void GameListWorker::run() {
     stop_processing = false;
+
+    // Keys and console unique data are loaded lazily, do it before titles are read in parallel.
+    HW::AES::InitKeys();
+    HW::UniqueData::LoadOTP();
+    HW::UniqueData::LoadMovable();
+
+    LoadMetadataCache();
+    scan_workers = std::make_unique<Common::ThreadWorker>(
+        std::clamp(std::thread::hardware_concurrency(), 2U, 8U), "GameListScan");
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (game_dir.path == QStringLiteral("INSTALLED")) {
             QString games_path =
@@ -171,6 +293,12 @@ void GameListWorker::run() {
         }
     }
 
+    scan_workers->WaitForRequests();
+    scan_workers.reset();
+    if (!stop_processing) {
+        SaveMetadataCache();
+    }
+
     emit Finished(watch_list);
 }
 
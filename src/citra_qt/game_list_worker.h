@@ -6,7 +6,10 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <QList>
 #include <QObject>
 #include <QRunnable>
@@ -15,6 +18,7 @@
 #include "citra_qt/compatibility_list.h"
 #include "citra_qt/play_time_manager.h"
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 
 namespace Service::FS {
 enum class MediaType : u32;
@@ -57,13 +61,43 @@ signals:
     void Finished(QStringList watch_list);
 
 private:
+    /// Information read from a title file, cached on disk as reading it is slow on large libraries.
+    struct TitleMetadata {
+        qint64 size = 0;
+        qint64 last_modified = 0;
+        bool is_title = false; // Whether the file is executable or encrypted
+        bool encrypted = false;
+        u64 program_id = 0;
+        u64 extdata_id = 0;
+        QString file_type;
+        std::vector<u8> smdh;
+        bool used = false; // Whether the file was seen during this scan, not saved
+    };
+
     void AddFstEntriesToGameList(const std::string& dir_path, unsigned int recursion,
                                  GameListDir* parent_dir, Service::FS::MediaType media_type);
 
+    /// Reads a title and emits its entry. Runs on the scan worker threads.
+    void AddEntry(const std::string& physical_name, GameListDir* parent_dir,
+                  Service::FS::MediaType media_type);
+
+    /// Returns the metadata of a file, only reading the file if it changed since it was cached.
+    TitleMetadata GetTitleMetadata(const std::string& physical_name);
+
+    void LoadMetadataCache();
+    void SaveMetadataCache();
+
     QVector<UISettings::GameDir>& game_dirs;
     const CompatibilityList& compatibility_list;
     const PlayTime::PlayTimeManager& play_time_manager;
 
     QStringList watch_list;
     std::atomic_bool stop_processing;
+
+    std::unique_ptr<Common::ThreadWorker> scan_workers;
+
+    std::unordered_map<std::string, TitleMetadata> metadata_cache;
+    std::size_t loaded_cache_entries = 0;
+    bool metadata_cache_changed = false;
+    std::mutex metadata_cache_mutex;
 };
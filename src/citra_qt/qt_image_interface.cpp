@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <QImage>
 #include <QImageReader>
 #include <QString>
@@ -33,10 +34,13 @@ bool QtImageInterface::DecodePNG(std::vector<u8>& dst, u32& width, u32& height,
 }
 
 bool QtImageInterface::EncodePNG(const std::string& path, u32 width, u32 height,
-                                 std::span<const u8> src) {
+                                 std::span<const u8> src, u32 compression_level) {
     QImage image(src.data(), width, height, QImage::Format_RGBA8888);
 
-    if (!image.save(QString::fromStdString(path), "PNG")) {
+    // Qt derives the zlib level of png files from the quality, with 100 storing them uncompressed.
+    const int level = static_cast<int>(std::min(compression_level, 9U));
+    const int quality = 100 - (level * 91 + 8) / 9;
+    if (!image.save(QString::fromStdString(path), "PNG", quality)) {
         LOG_ERROR(Frontend, "Failed to save {}", path);
         return false;
     }
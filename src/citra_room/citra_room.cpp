@@ -7,8 +7,12 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <cryptopp/base64.h>
+#include <fmt/format.h>
+// httplib needs to be included before windows.h for winsock2.h
+#include <httplib.h>
 
 #ifdef _WIN32
 // windows.h needs to be included before shellapi.h
@@ -56,6 +60,12 @@ static void PrintHelp(const char* argv0) {
                  "--web-api-url       Citra Web API url\n"
                  "--ban-list-file     The file for storing the room ban list\n"
                  "--log-file          The file for storing the room log\n"
+                 "--stats-port        Serve room metrics over HTTP on this port, at /metrics\n"
+                 "--stats-address     The address to serve room metrics on, 127.0.0.1 by default\n"
+                 "--max-member-packet-rate  Packets a member may send per second, the rest are\n"
+                 "                    dropped\n"
+                 "--max-data-in-transit  Unacknowledged bytes to all members above which chat\n"
+                 "                    messages are dropped and game changes are delayed\n"
                  "-h, --help          Display this help and exit\n"
                  "-v, --version       Output version information and exit\n";
 }
@@ -153,6 +163,72 @@ static void SaveBanList(const Network::Room::BanList& ban_list, const std::strin
     file.flush();
 }
 
+/// Escapes a label value of the Prometheus text format.
+static std::string EscapeLabelValue(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/// Formats the traffic and the members of the room in the Prometheus text format.
+static std::string FormatRoomMetrics(const Network::Room& room) {
+    const Network::Room::TrafficStats stats = room.GetTrafficStats();
+    const std::vector<Network::Room::Member> members = room.GetRoomMemberList();
+
+    std::string out;
+    const auto add_metric = [&out](std::string_view name, std::string_view type,
+                                   std::string_view help, u64 value) {
+        out += fmt::format("# HELP {0} {1}\n# TYPE {0} {2}\n{0} {3}\n", name, help, type, value);
+    };
+    add_metric("azahar_room_members", "gauge", "Members in the room.", members.size());
+    add_metric("azahar_room_member_slots", "gauge", "Maximum number of members in the room.",
+               room.GetRoomInformation().member_slots);
+    add_metric("azahar_room_received_packets_total", "counter", "Packets received by the room.",
+               stats.packets_received);
+    add_metric("azahar_room_received_bytes_total", "counter", "Bytes received by the room.",
+               stats.bytes_received);
+    add_metric("azahar_room_sent_packets_total", "counter", "Packets sent by the room.",
+               stats.packets_sent);
+    add_metric("azahar_room_sent_bytes_total", "counter", "Bytes sent by the room.",
+               stats.bytes_sent);
+    add_metric("azahar_room_relayed_wifi_packets_total", "counter",
+               "WifiPackets forwarded by the room.", stats.wifi_packets_relayed);
+    add_metric("azahar_room_dropped_packets_total", "counter",
+               "Packets dropped for exceeding the packet rate of a member.", stats.packets_dropped);
+    add_metric("azahar_room_dropped_chat_messages_total", "counter",
+               "Chat messages dropped while the room was overloaded.",
+               stats.chat_messages_dropped);
+
+    const auto add_member_metric = [&out, &members](std::string_view name, std::string_view type,
+                                                    std::string_view help, auto value) {
+        out += fmt::format("# HELP {0} {1}\n# TYPE {0} {2}\n", name, help, type);
+        for (const auto& member : members) {
+            out += fmt::format("{}{{nickname=\"{}\"}} {}\n", name,
+                               EscapeLabelValue(member.nickname), value(member));
+        }
+    };
+    add_member_metric("azahar_room_member_round_trip_time_milliseconds", "gauge",
+                      "Mean round trip time to the member.",
+                      [](const auto& member) { return member.round_trip_time; });
+    add_member_metric("azahar_room_member_data_in_transit_bytes", "gauge",
+                      "Reliable data sent to the member and not acknowledged yet.",
+                      [](const auto& member) { return member.data_in_transit; });
+    add_member_metric("azahar_room_member_dropped_packets_total", "counter",
+                      "Packets of the member dropped for exceeding its packet rate.",
+                      [](const auto& member) { return member.packets_dropped; });
+    return out;
+}
+
 static void InitializeLogging(const std::string& log_file) {
     Common::Log::Initialize(log_file);
     Common::Log::SetColorConsoleBackendEnabled(true);
@@ -182,6 +258,9 @@ void LaunchRoom(int argc, char** argv, bool called_by_option) {
     u64 preferred_game_id = 0;
     u16 port = Network::DefaultRoomPort;
     u32 max_members = 16;
+    std::string stats_address = "127.0.0.1";
+    u16 stats_port = 0;
+    Network::Room::LoadLimits load_limits{};
 
     static struct option long_options[] = {
         {"room-name", required_argument, 0, 'n'},
@@ -196,6 +275,10 @@ void LaunchRoom(int argc, char** argv, bool called_by_option) {
         {"web-api-url", required_argument, 0, 'a'},
         {"ban-list-file", required_argument, 0, 'b'},
         {"log-file", required_argument, 0, 'l'},
+        {"stats-port", required_argument, 0, 'S'},
+        {"stats-address", required_argument, 0, 'A'},
+        {"max-member-packet-rate", required_argument, 0, 'r'},
+        {"max-data-in-transit", required_argument, 0, 'q'},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         // Removed options
@@ -249,6 +332,18 @@ void LaunchRoom(int argc, char** argv, bool called_by_option) {
             case 'l':
                 log_file.assign(optarg);
                 break;
+            case 'S':
+                stats_port = static_cast<u16>(strtoul(optarg, &endarg, 0));
+                break;
+            case 'A':
+                stats_address.assign(optarg);
+                break;
+            case 'r':
+                load_limits.max_member_packets_per_second = strtoul(optarg, &endarg, 0);
+                break;
+            case 'q':
+                load_limits.max_data_in_transit = strtoul(optarg, &endarg, 0);
+                break;
             case 'h':
                 PrintHelp(argv[0]);
                 exit(0);
@@ -353,6 +448,26 @@ void LaunchRoom(int argc, char** argv, bool called_by_option) {
             std::cout << "Failed to create room: \n\n";
             exit(-1);
         }
+        room->SetLoadLimits(load_limits);
+
+        std::unique_ptr<httplib::Server> stats_server;
+        std::thread stats_thread;
+        if (stats_port != 0) {
+            stats_server = std::make_unique<httplib::Server>();
+            stats_server->Get("/metrics", [room](const httplib::Request&, httplib::Response& res) {
+                res.set_content(FormatRoomMetrics(*room), "text/plain; version=0.0.4");
+            });
+            if (stats_server->bind_to_port(stats_address, stats_port)) {
+                std::cout << "Serving room metrics on " << stats_address << ":" << stats_port
+                          << "/metrics\n\n";
+                stats_thread = std::thread([&stats_server] { stats_server->listen_after_bind(); });
+            } else {
+                std::cout << "Failed to serve room metrics on " << stats_address << ":"
+                          << stats_port << "\n\n";
+                stats_server.reset();
+            }
+        }
+
         std::cout << "Room is open. Close with Q+Enter...\n\n";
         auto announce_session = std::make_unique<Network::AnnounceMultiplayerSession>();
         if (announce) {
@@ -370,6 +485,10 @@ void LaunchRoom(int argc, char** argv, bool called_by_option) {
             announce_session->Stop();
         }
         announce_session.reset();
+        if (stats_server) {
+            stats_server->stop();
+            stats_thread.join();
+        }
         // Save the ban list
         if (!ban_list_file.empty()) {
             SaveBanList(room->GetBanList(), ban_list_file);
@@ -0,0 +1,197 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <fmt/format.h>
+#include "citra_sdl/batch.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace Batch {
+
+namespace {
+
+#ifdef _WIN32
+constexpr char NullDevice[] = "NUL";
+#else
+constexpr char NullDevice[] = "/dev/null";
+#endif
+
+/// What a headless run reported, missing if it did not get to print its result.
+struct JobResult {
+    u64 frames{};
+    u64 hash{};
+    double fps{};
+};
+
+std::string Quote(const std::string& argument) {
+    return fmt::format("\"{}\"", argument);
+}
+
+std::string JobCommand(const std::string& executable, const Job& job) {
+    std::string command =
+        fmt::format("{} -n --headless --frames {}", Quote(executable), job.frames);
+    if (!job.movie.empty()) {
+        command += fmt::format(" --movie-play {}", Quote(job.movie));
+    }
+    command += fmt::format(" {} 2>{}", Quote(job.title), NullDevice);
+#ifdef _WIN32
+    // cmd strips the outer quotes of the command line it is given.
+    command = fmt::format("\"{}\"", command);
+#endif
+    return command;
+}
+
+/// Runs a job in its own process and parses the result it prints.
+std::optional<JobResult> RunJob(const std::string& command) {
+    std::FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        return std::nullopt;
+    }
+
+    std::optional<JobResult> result;
+    std::string output;
+    char buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), pipe)) {
+        output += buffer;
+    }
+    std::istringstream stream{output};
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.starts_with(ResultPrefix)) {
+            continue;
+        }
+        JobResult parsed;
+        if (std::sscanf(line.c_str() + sizeof(ResultPrefix) - 1,
+                        " %" SCNu64 " frames, hash %" SCNx64 ", %lf fps", &parsed.frames,
+                        &parsed.hash, &parsed.fps) == 3) {
+            result = parsed;
+        }
+    }
+
+    if (pclose(pipe) != 0) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+std::optional<std::vector<Job>> ParseJobFile(const std::string& path) {
+    std::string contents;
+    if (!FileUtil::Exists(path) || FileUtil::ReadFileToString(true, path, contents) == 0) {
+        LOG_CRITICAL(Frontend, "Failed to read the job file {}", path);
+        return std::nullopt;
+    }
+
+    std::vector<Job> jobs;
+    std::istringstream stream{contents};
+    std::string line;
+    for (u32 line_number = 1; std::getline(stream, line); line_number++) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        const std::vector<std::string> fields = Common::SplitString(line, '\t');
+        if (fields.size() != 4) {
+            LOG_CRITICAL(Frontend, "{}:{}: expected 4 tab separated fields, got {}", path,
+                         line_number, fields.size());
+            return std::nullopt;
+        }
+        Job job{
+            .title = fields[0],
+            .movie = fields[1] == "-" ? std::string{} : fields[1],
+        };
+        try {
+            job.frames = std::stoull(fields[2]);
+            if (fields[3] != "-") {
+                job.expected_hash = std::stoull(fields[3], nullptr, 16);
+            }
+        } catch (...) {
+            LOG_CRITICAL(Frontend, "{}:{}: invalid frame count or hash", path, line_number);
+            return std::nullopt;
+        }
+        if (job.frames == 0) {
+            LOG_CRITICAL(Frontend, "{}:{}: the frame count must not be 0", path, line_number);
+            return std::nullopt;
+        }
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+int RunJobFile(const std::string& executable, const std::string& job_file, u32 num_workers) {
+    const auto jobs = ParseJobFile(job_file);
+    if (!jobs) {
+        return 1;
+    }
+
+    std::atomic<std::size_t> next_job{0};
+    std::atomic<u32> num_failed{0};
+    std::mutex output_mutex;
+    const auto worker = [&] {
+        for (std::size_t i = next_job++; i < jobs->size(); i = next_job++) {
+            const Job& job = (*jobs)[i];
+            const std::string command = JobCommand(executable, job);
+            const auto result = RunJob(command);
+
+            std::string status;
+            bool failed = true;
+            if (!result) {
+                status = fmt::format("FAILED to run: {}", command);
+            } else if (result->frames < job.frames) {
+                status = fmt::format("FAILED after {} frames", result->frames);
+            } else if (job.expected_hash && *job.expected_hash != result->hash) {
+                status = fmt::format("MISMATCH, expected hash {:016X}", *job.expected_hash);
+            } else {
+                status = job.expected_hash ? "OK" : "NO EXPECTED HASH";
+                failed = false;
+            }
+            if (failed) {
+                num_failed++;
+            }
+
+            std::scoped_lock lock{output_mutex};
+            if (result) {
+                std::cout << fmt::format("Job {}: {} | {} frames, hash {:016X}, {:.1f} fps | {}",
+                                         i + 1, job.title, result->frames, result->hash,
+                                         result->fps, status)
+                          << std::endl;
+            } else {
+                std::cout << fmt::format("Job {}: {} | {}", i + 1, job.title, status)
+                          << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (u32 i = 0; i < std::max(num_workers, 1U); i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    std::cout << fmt::format("{} of {} jobs passed", jobs->size() - num_failed, jobs->size())
+              << std::endl;
+    return num_failed == 0 ? 0 : 1;
+}
+
+} // namespace Batch
@@ -0,0 +1,42 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Batch {
+
+/// Prefix of the line a headless run prints its result on, parsed by the batch runner.
+constexpr char ResultPrefix[] = "Headless result:";
+
+/// One headless run of a title, checked against the hash of its last frame.
+struct Job {
+    std::string title;
+    std::string movie;
+    u64 frames;
+    std::optional<u64> expected_hash;
+};
+
+/**
+ * Parses a job file, one job per line with tab separated fields: the title path, the movie to
+ * play or - for none, the number of frames to run and the expected hash of the last frame or -
+ * to only report it. Empty lines and lines starting with # are ignored.
+ * @returns The jobs, or nullopt if the file could not be read or holds a malformed line
+ */
+std::optional<std::vector<Job>> ParseJobFile(const std::string& path);
+
+/**
+ * Runs the jobs of a job file on a pool of headless emulator processes, as the system only
+ * supports one instance per process, and prints the frame rate and the result of each job.
+ * @param executable Path of this executable, started for every job
+ * @param num_workers Number of jobs running at the same time
+ * @returns The process exit code, 0 if every job ran and matched its expected hash
+ */
+int RunJobFile(const std::string& executable, const std::string& job_file, u32 num_workers);
+
+} // namespace Batch
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -11,17 +12,21 @@
 // This needs to be included before getopt.h because the latter #defines symbols used by it
 #include "common/microprofile.h"
 
+#include "citra_sdl/batch.h"
 #include "citra_sdl/config.h"
 #include "citra_sdl/emu_window/emu_window_sdl2.h"
 #ifdef ENABLE_OPENGL
 #include "citra_sdl/emu_window/emu_window_sdl2_gl.h"
 #endif
 #ifdef ENABLE_SOFTWARE_RENDERER
+#include "citra_sdl/emu_window/emu_window_sdl2_headless.h"
 #include "citra_sdl/emu_window/emu_window_sdl2_sw.h"
+#include "video_core/renderer_software/renderer_software.h"
 #endif
 #ifdef ENABLE_VULKAN
 #include "citra_sdl/emu_window/emu_window_sdl2_vk.h"
 #endif
+#include "SDL_hints.h"
 #include "SDL_messagebox.h"
 #include "citra_meta/common_strings.h"
 #include "common/common_paths.h"
@@ -41,6 +46,7 @@
 #include "core/hle/service/am/am.h"
 #include "core/hle/service/cfg/cfg.h"
 #include "core/movie.h"
+#include "core/tracer/player.h"
 #include "input_common/main.h"
 #include "network/network.h"
 #include "video_core/gpu.h"
@@ -184,6 +190,16 @@ void LaunchSdlFrontend(int argc, char** argv) {
     std::string movie_record_author;
     std::string movie_play;
     std::string dump_video;
+    bool headless = false;
+    std::string dump_frames;
+    u64 frame_count = 0;
+    std::string replay;
+    u64 replay_loops = 1;
+    std::string profile_trace;
+    u64 profile_first_frame = 0;
+    u64 profile_num_frames = 0;
+    std::string batch;
+    u32 batch_jobs = 1;
 
     char* endarg;
 #ifdef _WIN32
@@ -205,31 +221,75 @@ void LaunchSdlFrontend(int argc, char** argv) {
     u16 port = Network::DefaultRoomPort;
 
     static struct option long_options[] = {
+        {"batch", required_argument, 0, 'b'},
+        {"batch-jobs", required_argument, 0, 'j'},
         {"dump-video", required_argument, 0, 'd'},
+        {"dump-frames", required_argument, 0, 'D'},
+        {"frames", required_argument, 0, 'c'},
         {"fullscreen", no_argument, 0, 'f'},
+        {"profile-frames", required_argument, 0, 'F'},
         {"gdbport", required_argument, 0, 'g'},
+        {"headless", no_argument, 0, 'H'},
         {"help", no_argument, 0, 'h'},
         {"install", required_argument, 0, 'i'},
+        {"replay", required_argument, 0, 't'},
+        {"replay-loops", required_argument, 0, 'l'},
         {"movie-play", required_argument, 0, 'p'},
         {"movie-record", required_argument, 0, 'r'},
         {"movie-record-author", required_argument, 0, 'a'},
         {"multiplayer", required_argument, 0, 'm'},
+        {"profile-trace", required_argument, 0, 'T'},
         {"version", no_argument, 0, 'v'},
         {"windowed", no_argument, 0, 'w'},
         {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "d:fg:hi:p:r:a:m:nvw", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "b:c:d:D:fF:g:Hhi:j:l:p:r:a:m:nt:T:vw", long_options,
+                              &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
+            case 'b':
+                batch = optarg;
+                break;
+            case 'c':
+                errno = 0;
+                frame_count = strtoull(optarg, &endarg, 0);
+                if (endarg == optarg)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--frames");
+                    exit(1);
+                }
+                break;
             case 'd':
                 dump_video = optarg;
                 break;
+            case 'D':
+                dump_frames = optarg;
+                break;
             case 'f':
                 fullscreen = true;
                 LOG_INFO(Frontend, "Starting in fullscreen mode...");
                 break;
+            case 'F':
+                // Either a frame count, or the first frame and the count separated by a colon.
+                errno = 0;
+                profile_num_frames = strtoull(optarg, &endarg, 0);
+                if (endarg != optarg && *endarg == ':') {
+                    profile_first_frame = profile_num_frames;
+                    const char* count = endarg + 1;
+                    profile_num_frames = strtoull(count, &endarg, 0);
+                    if (endarg == count)
+                        errno = EINVAL;
+                }
+                if (endarg == optarg || *endarg != '\0')
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--profile-frames");
+                    exit(1);
+                }
+                break;
             case 'g':
                 errno = 0;
                 gdb_port = strtoul(optarg, &endarg, 0);
@@ -241,6 +301,9 @@ void LaunchSdlFrontend(int argc, char** argv) {
                     exit(1);
                 }
                 break;
+            case 'H':
+                headless = true;
+                break;
             case 'h':
                 PrintHelp(argv[0]);
                 exit(0);
@@ -255,9 +318,35 @@ void LaunchSdlFrontend(int argc, char** argv) {
                     exit(1);
                 break;
             }
+            case 'j':
+                errno = 0;
+                batch_jobs = strtoul(optarg, &endarg, 0);
+                if (endarg == optarg || batch_jobs == 0)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--batch-jobs");
+                    exit(1);
+                }
+                break;
+            case 'l':
+                errno = 0;
+                replay_loops = strtoull(optarg, &endarg, 0);
+                if (endarg == optarg || replay_loops == 0)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--replay-loops");
+                    exit(1);
+                }
+                break;
             case 'p':
                 movie_play = optarg;
                 break;
+            case 't':
+                replay = optarg;
+                break;
+            case 'T':
+                profile_trace = optarg;
+                break;
             case 'r':
                 movie_record = optarg;
                 break;
@@ -316,6 +405,10 @@ void LaunchSdlFrontend(int argc, char** argv) {
     LocalFree(argv_w);
 #endif
 
+    if (!batch.empty()) {
+        exit(Batch::RunJobFile(argv[0], batch, batch_jobs));
+    }
+
     MicroProfileOnThreadCreate("EmuThread");
     SCOPE_EXIT({ MicroProfileShutdown(); });
 
@@ -339,6 +432,28 @@ void LaunchSdlFrontend(int argc, char** argv) {
         movie.PrepareForPlayback(movie_play);
     }
 
+    if (headless) {
+#ifdef ENABLE_SOFTWARE_RENDERER
+        // Frames are only consumed through the renderer, run as fast as possible without audio.
+        Settings::values.graphics_api = Settings::GraphicsAPI::Software;
+        Settings::values.frame_limit = 0;
+        Settings::values.output_type = AudioCore::SinkType::Null;
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+#else
+        LOG_CRITICAL(Frontend, "Headless mode requires the software renderer");
+        exit(-1);
+#endif
+    } else if (!dump_frames.empty() || frame_count != 0) {
+        LOG_CRITICAL(Frontend, "--dump-frames and --frames require --headless");
+        exit(-1);
+    }
+
+    if (!replay.empty()) {
+        // The trace is submitted from this thread and timed, it must not wait for vblanks.
+        Settings::values.use_gpu_thread = false;
+        Settings::values.frame_limit = 0;
+    }
+
     // Apply the command line arguments
     Settings::values.gdbstub_port = gdb_port;
     Settings::values.use_gdbstub = use_gdbstub;
@@ -351,6 +466,11 @@ void LaunchSdlFrontend(int argc, char** argv) {
 
     const auto create_emu_window = [&](bool fullscreen,
                                        bool is_secondary) -> std::unique_ptr<EmuWindow_SDL2> {
+#ifdef ENABLE_SOFTWARE_RENDERER
+        if (headless) {
+            return std::make_unique<EmuWindow_SDL2_Headless>(system, dump_frames, frame_count);
+        }
+#endif
         const auto graphics_api = Settings::values.graphics_api.GetValue();
         switch (graphics_api) {
 #ifdef ENABLE_OPENGL
@@ -429,6 +549,13 @@ void LaunchSdlFrontend(int argc, char** argv) {
         break;
     }
 
+#ifdef ENABLE_SOFTWARE_RENDERER
+    if (headless) {
+        static_cast<EmuWindow_SDL2_Headless&>(*emu_window)
+            .BindRenderer(static_cast<SwRenderer::RendererSoftware&>(system.GPU().Renderer()));
+    }
+#endif
+
     if (use_multiplayer) {
         if (auto member = Network::GetRoomMember().lock()) {
             member->BindOnChatMessageRecieved(OnMessageReceived);
@@ -483,10 +610,33 @@ void LaunchSdlFrontend(int argc, char** argv) {
                       total);
         });
 
+    if (!profile_trace.empty() &&
+        !Common::StartMicroProfileTrace(profile_trace, profile_first_frame, profile_num_frames)) {
+        LOG_ERROR(Frontend, "Failed to open profile trace file {}", profile_trace);
+    }
+
     const auto secondary_is_open = [&secondary_window] {
         // if the secondary window isn't created, it shouldn't affect the main loop
         return secondary_window ? secondary_window->IsOpen() : true;
     };
+    if (!replay.empty()) {
+        CiTrace::Player player{system};
+        const bool loaded = player.Load(replay);
+        for (u64 i = 0; loaded && i < replay_loops && emu_window->IsOpen(); i++) {
+            const auto stats = player.Replay();
+            const auto perf = system.GetAndResetPerfStats();
+            std::cout << fmt::format("Replay {}: {} frames, {} draws, {} KiB uploaded, frame time "
+                                     "min {:.3f} ms, mean {:.3f} ms, max {:.3f} ms, {:.1f} render "
+                                     "passes per frame, {} staging stalls",
+                                     i + 1, stats.frames, stats.draws, stats.upload_bytes / 1024,
+                                     stats.min_frame_time * 1000.0, stats.mean_frame_time * 1000.0,
+                                     stats.max_frame_time * 1000.0, perf.render_passes,
+                                     perf.staging_stalls)
+                      << std::endl;
+        }
+        emu_window->RequestClose();
+    }
+    const auto run_start = std::chrono::steady_clock::now();
     while (emu_window->IsOpen() && secondary_is_open()) {
         const auto result = system.RunLoop();
 
@@ -502,6 +652,19 @@ void LaunchSdlFrontend(int argc, char** argv) {
         }
     }
     emu_window->RequestClose();
+    Common::StopMicroProfileTrace();
+#ifdef ENABLE_SOFTWARE_RENDERER
+    if (headless) {
+        // Parsed by the batch runner, see Batch::RunJobFile.
+        const auto& headless_window = static_cast<EmuWindow_SDL2_Headless&>(*emu_window);
+        const std::chrono::duration<double> run_time =
+            std::chrono::steady_clock::now() - run_start;
+        std::cout << fmt::format("{} {} frames, hash {:016X}, {:.1f} fps", Batch::ResultPrefix,
+                                 headless_window.FrameCount(), headless_window.FrameHash(),
+                                 headless_window.FrameCount() / run_time.count())
+                  << std::endl;
+    }
+#endif
     if (secondary_window) {
         secondary_window->RequestClose();
     }
@@ -127,23 +127,50 @@ void SdlConfig::ReadValues() {
         static_cast<u16>(sdl2_config->GetInteger("Controls", "udp_input_port",
                                                  InputCommon::CemuhookUDP::DEFAULT_PORT));
     ReadSetting("Controls", Settings::values.use_artic_base_controller);
+    ReadSetting("Controls", Settings::values.input_late_latch);
 
     // Core
     ReadSetting("Core", Settings::values.use_cpu_jit);
     ReadSetting("Core", Settings::values.cpu_clock_percentage);
+    ReadSetting("Core", Settings::values.parallel_cpu_cores);
+    ReadSetting("Core", Settings::values.skip_idle_loops);
+    ReadSetting("Core", Settings::values.use_tick_profiles);
+    ReadSetting("Core", Settings::values.calibrate_tick_profiles);
+    ReadSetting("Core", Settings::values.adaptive_slice_length);
+    ReadSetting("Core", Settings::values.use_huge_pages);
+    ReadSetting("Core", Settings::values.romfs_cache_size);
+    ReadSetting("Core", Settings::values.save_data_write_back);
+    ReadSetting("Core", Settings::values.fs_delay_mode);
+    ReadSetting("Core", Settings::values.fs_delay_table);
+    ReadSetting("Core", Settings::values.enable_rewind);
+    ReadSetting("Core", Settings::values.rewind_interval);
+    ReadSetting("Core", Settings::values.rewind_buffer_size);
+    ReadSetting("Core", Settings::values.prewarm_savestate_surfaces);
+    ReadSetting("Core", Settings::values.incremental_savestates);
+    ReadSetting("Core", Settings::values.movie_turbo_playback);
+    ReadSetting("Core", Settings::values.movie_checkpoint_interval);
+    ReadSetting("Core", Settings::values.reset_to_boot_snapshot);
 
     // Renderer
     ReadSetting("Renderer", Settings::values.graphics_api);
     ReadSetting("Renderer", Settings::values.physical_device);
     ReadSetting("Renderer", Settings::values.spirv_shader_gen);
     ReadSetting("Renderer", Settings::values.async_shader_compilation);
+    ReadSetting("Renderer", Settings::values.use_uber_shaders);
     ReadSetting("Renderer", Settings::values.async_presentation);
+    ReadSetting("Renderer", Settings::values.skip_unchanged_uploads);
+    ReadSetting("Renderer", Settings::values.texture_memory_budget);
+    ReadSetting("Renderer", Settings::values.generate_mipmaps);
+    ReadSetting("Renderer", Settings::values.parallel_command_recording);
+    ReadSetting("Renderer", Settings::values.present_queue_depth);
+    ReadSetting("Renderer", Settings::values.bindless_textures);
     ReadSetting("Renderer", Settings::values.use_gles);
     ReadSetting("Renderer", Settings::values.use_hw_shader);
     ReadSetting("Renderer", Settings::values.shaders_accurate_mul);
     ReadSetting("Renderer", Settings::values.use_shader_jit);
     ReadSetting("Renderer", Settings::values.resolution_factor);
     ReadSetting("Renderer", Settings::values.use_disk_shader_cache);
+    ReadSetting("Renderer", Settings::values.use_shared_shader_cache);
     ReadSetting("Renderer", Settings::values.frame_limit);
     ReadSetting("Renderer", Settings::values.use_vsync_new);
     ReadSetting("Renderer", Settings::values.texture_filter);
@@ -161,6 +188,7 @@ void SdlConfig::ReadValues() {
     ReadSetting("Renderer", Settings::values.bg_green);
     ReadSetting("Renderer", Settings::values.bg_blue);
     ReadSetting("Renderer", Settings::values.disable_right_eye_render);
+    ReadSetting("Renderer", Settings::values.disable_right_eye_draws);
 
     // Layout
     ReadSetting("Layout", Settings::values.layout_option);
@@ -196,14 +224,17 @@ void SdlConfig::ReadValues() {
 
     // Utility
     ReadSetting("Utility", Settings::values.dump_textures);
+    ReadSetting("Utility", Settings::values.texture_dump_compression);
     ReadSetting("Utility", Settings::values.custom_textures);
     ReadSetting("Utility", Settings::values.preload_textures);
     ReadSetting("Utility", Settings::values.async_custom_loading);
+    ReadSetting("Utility", Settings::values.custom_texture_budget);
 
     // Audio
     ReadSetting("Audio", Settings::values.audio_emulation);
     ReadSetting("Audio", Settings::values.enable_audio_stretching);
     ReadSetting("Audio", Settings::values.enable_realtime_audio);
+    ReadSetting("Audio", Settings::values.threaded_audio_hle);
     ReadSetting("Audio", Settings::values.volume);
     ReadSetting("Audio", Settings::values.output_type);
     ReadSetting("Audio", Settings::values.output_device);
@@ -213,6 +244,8 @@ void SdlConfig::ReadValues() {
     // Data Storage
     ReadSetting("Data Storage", Settings::values.use_virtual_sd);
     ReadSetting("Data Storage", Settings::values.use_custom_storage);
+    ReadSetting("Data Storage", Settings::values.use_artic_disk_cache);
+    ReadSetting("Data Storage", Settings::values.use_artic_compression);
 
     if (Settings::values.use_custom_storage) {
         FileUtil::UpdateUserPath(FileUtil::UserPath::NANDDir,
@@ -359,6 +392,10 @@ void SdlConfig::ReadValues() {
     NetSettings::values.citra_username = sdl2_config->GetString("WebService", "citra_username", "");
     NetSettings::values.citra_token = sdl2_config->GetString("WebService", "citra_token", "");
 
+    // Multiplayer
+    NetSettings::values.direct_connections =
+        sdl2_config->GetBoolean("Multiplayer", "direct_connections", false);
+
     // Video Dumping
     Settings::values.output_format =
         sdl2_config->GetString("Video Dumping", "output_format", "webm");
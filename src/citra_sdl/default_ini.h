@@ -86,6 +86,11 @@ udp_input_port=
 # The pad to request data on. Should be between 0 (Pad 1) and 3 (Pad 4). (Default 0)
 udp_pad_index=
 
+# Sample the controls right before every vblank instead of only on the fixed HID update interval,
+# and poll SDL controllers more often. Lowers input latency at a small CPU cost.
+# 0 (default): Off, 1: On
+input_late_latch=
+
 [Core]
 # Whether to use the Just-In-Time (JIT) compiler for CPU emulation
 # 0: Interpreter (slow), 1 (default): JIT (fast)
@@ -97,6 +102,96 @@ use_cpu_jit =
 # Range is any positive integer (but we suspect 25 - 400 is a good idea) Default is 100
 cpu_clock_percentage =
 
+# Whether to run each emulated CPU core on its own host thread (experimental, requires the JIT)
+# Only speeds up New 3DS titles that use the extra cores.
+# 0 (default): Off, 1: On
+parallel_cpu_cores =
+
+# Whether to skip ahead to the next scheduled event when a guest thread spins in a loop that
+# polls memory without changing any state. Saves host CPU time and power.
+# 0 (default): Off, 1: On
+skip_idle_loops =
+
+# Whether to apply the per-title CPU clock profiles found in the tick_profiles config folder
+# 0: Off, 1 (default): On
+use_tick_profiles =
+
+# Whether to derive a CPU clock profile for the running title from its measured performance.
+# The profile is written when emulation stops.
+# 0 (default): Off, 1: On
+calibrate_tick_profiles =
+
+# Whether to lengthen CPU slices while no events are pending and shorten them while the host
+# is handing work to the emulated system. Reduces scheduling overhead in RunLoop.
+# 0 (default): Off, 1: On
+adaptive_slice_length =
+
+# Whether to back the emulated FCRAM and VRAM with huge pages when the host provides them.
+# Takes effect when emulation starts.
+# 0 (default): Off, 1: On
+use_huge_pages =
+
+# Size in MiB of the cache of decrypted RomFS blocks, which are also read ahead sequentially
+# 0: Disabled, game data is read straight from disk, 8 (default)
+romfs_cache_size =
+
+# Buffers save data writes in memory and writes them to disk when the application flushes or
+# closes the file, instead of on every write. Reduces stalls on slow storage.
+# 0 (default): Off, 1: On
+save_data_write_back =
+
+# How long file system reads and opens take to complete
+# 0 (default): Hardware, uses the latencies measured on a real console
+# 1: Table, uses the latencies listed in fs_delay_table
+# 2: Instant, completes file system requests without delay. Reduces load times, but can break
+# games that depend on the timing of their reads
+fs_delay_mode =
+
+# Path to a table of file system latencies used when fs_delay_mode is 1. Every line has the form
+# `<archive> <read|open> <length> <delay in ns>`, where archive is one of romfs, exefs, savedata,
+# extsavedata, sdmc, sdmcwriteonly or * to match any of them, and length is ignored for opens.
+# Read delays are interpolated between the listed lengths. Lines starting with # are ignored.
+# Empty (default): fs_delay_table.txt in the config directory
+fs_delay_table =
+
+# Keeps in-memory snapshots of the emulation to step back through by pressing Backspace
+# 0 (default): Off, 1: On
+enable_rewind =
+
+# Number of frames emulated between rewind snapshots, each press steps back by one snapshot
+# Default: 30
+rewind_interval =
+
+# Memory in MiB the rewind snapshots may take, the oldest ones are dropped beyond it.
+# RAM is stored as compressed deltas between snapshots, a copy of the full RAM comes on top.
+# Default: 256
+rewind_buffer_size =
+
+# Whether save states record the textures in use, so that loading one uploads them right away
+# instead of on the frames after the load.
+# 0: Off, 1 (default): On
+prewarm_savestate_surfaces =
+
+# Whether save states only store the RAM pages that changed since a full copy of the RAM kept in
+# a .base file next to the slot. Saving again to a slot then writes far less. The state can't be
+# loaded without its .base file, nor by builds without this option.
+# 0 (default): Off, 1: On
+incremental_savestates =
+
+# Whether movies are played back as fast as possible and without audio.
+# 0 (default): Off, 1: On
+movie_turbo_playback =
+
+# Number of frames between the savestate checkpoints stored in movies being recorded. Playback
+# seeks by loading the checkpoint before the target input. Each checkpoint takes tens of MiB.
+# 0 (default): No checkpoints
+movie_checkpoint_interval =
+
+# Whether the state right after booting a title is kept in memory, so that resetting the title
+# restores it instead of booting again. Speeds up booting the same title many times in a row.
+# 0 (default): Off, 1: On
+reset_to_boot_snapshot =
+
 [Renderer]
 # Whether to render using OpenGL or Software
 # 0: Software, 1: OpenGL (default), 2: Vulkan
@@ -127,6 +222,47 @@ use_vsync_new =
 # 0: Off, 1 (default. On)
 use_disk_shader_cache =
 
+# Shares generated fragment shaders between all games, so that a game that was never played before
+# starts with the shaders that other games already compiled for this GPU and driver
+# 0 (default): Off, 1: On
+use_shared_shader_cache =
+
+# Hashes the guest data of textures before uploading them again, and skips the upload when it is
+# unchanged since the last one. Helps games that keep rewriting the same texture data
+# 0 (default): Off, 1: On
+skip_unchanged_uploads =
+
+# Host memory in MiB that cached textures may use before the least recently used ones are evicted.
+# Automatic uses the memory budget reported by the Vulkan driver, and is unlimited on OpenGL
+# 0 (default): Automatic, otherwise the budget in MiB
+texture_memory_budget =
+
+# Generates the mip levels of textures from their base level on the GPU instead of uploading the
+# mip levels stored by the app. Saves upload time, but textures with distinct mip levels look wrong
+# 0 (default): Off, 1: On
+generate_mipmaps =
+
+# Records the draws of each render pass to secondary command buffers on several threads, which
+# are then executed in order. Helps heavy frames on CPUs with many cores (Vulkan only)
+# 0 (default): Off, 1: On
+parallel_command_recording =
+
+# Number of frames that may be queued for presentation ahead of the display. Lower values reduce
+# input latency and, on OpenGL, the memory held by the presentation frames. Higher values absorb
+# frame time spikes
+# 1 (default) - 3
+present_queue_depth =
+
+# Whether to reference textures by bindless handles instead of binding them to texture units
+# before each draw. Requires GL_ARB_bindless_texture (OpenGL only)
+# 0 (default): Off, 1: On
+bindless_textures =
+
+# Whether to draw with a generic fragment shader while the shaders of a new configuration are
+# compiled in the background. Only used with async_shader_compilation (Vulkan only)
+# 0: Off, 1: On (default)
+use_uber_shaders =
+
 # Resolution scale factor
 # 0: Auto (scales resolution to window size), 1: Native 3DS screen resolution, Otherwise a scale
 # factor for the 3DS resolution
@@ -222,6 +358,10 @@ large_screen_proportion =
 # 0 (default): Off, 1: On
 dump_textures =
 
+# PNG compression level of dumped textures, lower levels encode faster into larger files.
+# 0 (uncompressed) - 9 (smallest), 4 (default)
+texture_dump_compression =
+
 # Reads PNG files from load/textures/[Title ID]/ and replaces textures.
 # 0 (default): Off, 1: On
 custom_textures =
@@ -234,6 +374,11 @@ preload_textures =
 # 0: Off, 1 (default): On
 async_custom_loading =
 
+# Memory in MiB that decoded custom textures may use while streaming, the least recently used
+# textures are released over it and decoded again when needed. Ignored when preloading.
+# 0 (default): Unlimited
+custom_texture_budget =
+
 [Audio]
 # Whether or not to enable DSP LLE
 # 0 (default): No, 1: Yes
@@ -253,6 +398,10 @@ enable_audio_stretching =
 # 0 (default): No, 1: Yes
 enable_realtime_audio =
 
+# Whether to generate HLE audio frames on a separate thread, one frame ahead of the application
+# 0 (default): No, 1: Yes
+threaded_audio_hle =
+
 # Output volume.
 # 1.0 (default): 100%, 0.0; mute
 volume =
@@ -282,6 +431,16 @@ use_virtual_sd =
 # 1: Yes, 0 (default): No
 use_custom_storage =
 
+# Whether to keep the RomFS of titles played over Artic Base in an encrypted cache on disk, so
+# that later sessions against the same console load faster. Requires a linked console.
+# 0 (default): Off, 1: On
+use_artic_disk_cache =
+
+# Whether to ask the Artic Base server to compress the data it sends, which helps on slow Wi-Fi.
+# The server must support compression, older servers may fail to connect with it enabled.
+# 0 (default): Off, 1: On
+use_artic_compression =
+
 # The path of the virtual SD card directory.
 # empty (default) will use the user_path
 sdmc_directory =
@@ -373,6 +532,12 @@ web_api_url = https://api.citra-emu.org
 citra_username =
 citra_token =
 
+[Multiplayer]
+# Whether to send local wireless traffic directly to the other members of a room that allow it,
+# falling back to the room relay when they cannot be reached
+# 0 (default): Off, 1: On
+direct_connections =
+
 [Video Dumping]
 # Format of the video to output, default: webm
 output_format =
@@ -10,6 +10,7 @@
 #include "citra_sdl/emu_window/emu_window_sdl2.h"
 #include "common/logging/log.h"
 #include "common/scm_rev.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "input_common/keyboard.h"
 #include "input_common/main.h"
@@ -68,6 +69,11 @@ void EmuWindow_SDL2::OnFingerUp() {
 
 void EmuWindow_SDL2::OnKeyEvent(int key, u8 state) {
     if (state == SDL_PRESSED) {
+        // There is no hotkey configuration here, so rewinding is bound to a fixed key. Holding it
+        // keeps stepping back as the key repeats.
+        if (key == SDL_SCANCODE_BACKSPACE && Settings::values.enable_rewind) {
+            system.SendSignal(Core::System::Signal::Rewind);
+        }
         InputCommon::GetKeyboard()->PressKey(key);
     } else if (state == SDL_RELEASED) {
         InputCommon::GetKeyboard()->ReleaseKey(key);
@@ -0,0 +1,103 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <fmt/format.h>
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include "citra_sdl/emu_window/emu_window_sdl2_headless.h"
+#include "common/file_util.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/frontend/image_interface.h"
+#include "video_core/renderer_software/renderer_software.h"
+
+namespace {
+
+class DummyContext : public Frontend::GraphicsContext {};
+
+/// Favours speed over size, the frames are usually compared and thrown away.
+constexpr u32 DUMP_COMPRESSION_LEVEL = 1;
+
+} // Anonymous namespace
+
+EmuWindow_SDL2_Headless::EmuWindow_SDL2_Headless(Core::System& system_, std::string dump_path_,
+                                                 u64 frame_limit_)
+    : EmuWindow_SDL2{system_, false}, dump_path{std::move(dump_path_)}, frame_limit{frame_limit_} {
+    render_window = nullptr;
+    dummy_window = nullptr;
+
+    if (!dump_path.empty()) {
+        if (dump_path.back() != '/') {
+            dump_path += '/';
+        }
+        if (!FileUtil::CreateFullPath(dump_path)) {
+            LOG_CRITICAL(Frontend, "Failed to create frame dump directory {}", dump_path);
+            exit(1);
+        }
+    }
+
+    UpdateCurrentFramebufferLayout(Core::kScreenTopWidth,
+                                   Core::kScreenTopHeight + Core::kScreenBottomHeight);
+}
+
+EmuWindow_SDL2_Headless::~EmuWindow_SDL2_Headless() = default;
+
+std::unique_ptr<Frontend::GraphicsContext> EmuWindow_SDL2_Headless::CreateSharedContext() const {
+    return std::make_unique<DummyContext>();
+}
+
+void EmuWindow_SDL2_Headless::PollEvents() {
+    // There is no window, only the quit event raised on SIGINT and SIGTERM matters.
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            RequestClose();
+        }
+    }
+
+    const u32 current_time = SDL_GetTicks();
+    if (current_time > last_time + 2000) {
+        const auto results = system.GetAndResetPerfStats();
+        const auto& frame_time = results.frame_breakdown.frame;
+        LOG_INFO(Frontend,
+                 "Frame {} | FPS: {:.0f} ({:.0f}%) | Frame time p50 {:.2f} ms, p99 {:.2f} ms, max "
+                 "{:.2f} ms | {} shaders compiled",
+                 frame_count, results.game_fps, results.emulation_speed * 100.0f,
+                 frame_time.p50 * 1000.0, frame_time.p99 * 1000.0, frame_time.max * 1000.0,
+                 results.shader_compiles);
+        last_time = current_time;
+    }
+}
+
+void EmuWindow_SDL2_Headless::BindRenderer(SwRenderer::RendererSoftware& renderer) {
+    renderer.SetFrameCallback(
+        [this](std::span<const SwRenderer::ScreenInfo, 3> screens) { OnFrame(screens); });
+}
+
+void EmuWindow_SDL2_Headless::OnFrame(std::span<const SwRenderer::ScreenInfo, 3> screens) {
+    if (!dump_path.empty()) {
+        const auto image_interface = system.GetImageInterface();
+        const auto dump_screen = [&](const SwRenderer::ScreenInfo& info, std::string_view name) {
+            // Screens are stored rotated, each of the width rows holds a column of the screen.
+            const std::string path = fmt::format("{}{:06}_{}.png", dump_path, frame_count, name);
+            if (!image_interface->EncodePNG(path, info.height, info.width, info.pixels,
+                                            DUMP_COMPRESSION_LEVEL)) {
+                LOG_ERROR(Frontend, "Failed to write frame {}", path);
+            }
+        };
+        dump_screen(screens[0], "top");
+        dump_screen(screens[2], "bottom");
+    }
+
+    const auto hash_screen = [](const SwRenderer::ScreenInfo& info) {
+        return Common::ComputeHash64(info.pixels.data(), info.pixels.size());
+    };
+    frame_hash = Common::HashCombine(hash_screen(screens[0]), hash_screen(screens[2]));
+
+    frame_count++;
+    if (frame_limit != 0 && frame_count >= frame_limit) {
+        RequestClose();
+    }
+}
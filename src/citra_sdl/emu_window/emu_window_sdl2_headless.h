@@ -0,0 +1,72 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include "citra_sdl/emu_window/emu_window_sdl2.h"
+
+namespace SwRenderer {
+class RendererSoftware;
+struct ScreenInfo;
+} // namespace SwRenderer
+
+namespace Core {
+class System;
+}
+
+/**
+ * A window without a display for the software renderer. Frames are taken from the renderer on
+ * the emulation thread as they are composed, optionally written out as PNGs, and never
+ * presented, so the emulation runs as fast as the host allows.
+ */
+class EmuWindow_SDL2_Headless : public EmuWindow_SDL2 {
+public:
+    /**
+     * @param dump_path Directory the screens of every frame are written to, empty to not write
+     * @param frame_limit Number of frames after which the window closes itself, 0 for no limit
+     */
+    explicit EmuWindow_SDL2_Headless(Core::System& system, std::string dump_path,
+                                     u64 frame_limit);
+    ~EmuWindow_SDL2_Headless();
+
+    void PollEvents() override;
+    std::unique_ptr<GraphicsContext> CreateSharedContext() const override;
+    void MakeCurrent() override {}
+    void DoneCurrent() override {}
+
+    /// Starts receiving the frames of the renderer, must be called once the system is loaded
+    void BindRenderer(SwRenderer::RendererSoftware& renderer);
+
+    /// Returns the number of frames received from the renderer.
+    [[nodiscard]] u64 FrameCount() const noexcept {
+        return frame_count;
+    }
+
+    /// Returns a hash of the screens of the last frame, 0 before the first one.
+    [[nodiscard]] u64 FrameHash() const noexcept {
+        return frame_hash;
+    }
+
+protected:
+    void OnMinimalClientAreaChangeRequest(std::pair<u32, u32> minimal_size) override {}
+
+private:
+    /// Called by the renderer on the emulation thread for every frame.
+    void OnFrame(std::span<const SwRenderer::ScreenInfo, 3> screens);
+
+    /// Directory frames are written to.
+    std::string dump_path;
+
+    /// Number of frames to run for, 0 for no limit.
+    u64 frame_limit;
+
+    /// Number of frames received from the renderer.
+    u64 frame_count{};
+
+    /// Hash of the top and bottom screens of the last frame.
+    u64 frame_hash{};
+};
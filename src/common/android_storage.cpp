@@ -150,6 +150,34 @@ std::vector<std::string> GetFilesName(const std::string& filepath) {
     return vector;
 }
 
+std::vector<FileInfo> GetFilesInfo(const std::string& filepath) {
+    std::vector<FileInfo> infos;
+    if (get_files_info == nullptr)
+        return infos;
+    auto env = GetEnvForThread();
+    jstring j_filepath = env->NewStringUTF(filepath.c_str());
+    auto j_object =
+        (jobjectArray)env->CallStaticObjectMethod(native_library, get_files_info, j_filepath);
+    auto j_names = (jobjectArray)env->GetObjectArrayElement(j_object, 0);
+    auto j_sizes = (jlongArray)env->GetObjectArrayElement(j_object, 1);
+    const jsize j_size = env->GetArrayLength(j_names);
+    std::vector<jlong> sizes(j_size);
+    env->GetLongArrayRegion(j_sizes, 0, j_size, sizes.data());
+    infos.reserve(j_size);
+    for (int i = 0; i < j_size; i++) {
+        auto string = (jstring)(env->GetObjectArrayElement(j_names, i));
+        const char* name = env->GetStringUTFChars(string, nullptr);
+        infos.push_back({
+            .name = name,
+            .is_directory = sizes[i] < 0,
+            .size = sizes[i] < 0 ? 0 : static_cast<std::uint64_t>(sizes[i]),
+        });
+        env->ReleaseStringUTFChars(string, name);
+        env->DeleteLocalRef(string);
+    }
+    return infos;
+}
+
 bool CopyFile(const std::string& source, const std::string& destination_path,
               const std::string& destination_filename) {
     if (copy_file == nullptr)
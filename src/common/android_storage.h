@@ -19,6 +19,8 @@
       open_content_uri, "openContentUri", "(Ljava/lang/String;Ljava/lang/String;)I")               \
     V(GetFilesName, std::vector<std::string>, (const std::string& filepath), get_files_name,       \
       "getFilesName", "(Ljava/lang/String;)[Ljava/lang/String;")                                   \
+    V(GetFilesInfo, std::vector<FileInfo>, (const std::string& filepath), get_files_info,          \
+      "getFilesInfo", "(Ljava/lang/String;)[Ljava/lang/Object;")                                   \
     V(CopyFile, bool,                                                                              \
       (const std::string& source, const std::string& destination_path,                             \
        const std::string& destination_filename),                                                   \
@@ -34,6 +36,13 @@
     V(DeleteDocument, bool, delete_document, CallStaticBooleanMethod, "deleteDocument",            \
       "(Ljava/lang/String;)Z")
 namespace AndroidStorage {
+/// An entry of a directory listed by GetFilesInfo.
+struct FileInfo {
+    std::string name;
+    bool is_directory;
+    std::uint64_t size;
+};
+
 static JavaVM* g_jvm = nullptr;
 static jclass native_library = nullptr;
 #define FR(FunctionName, ReturnValue, JMethodID, Caller, JMethodName, Signature) F(JMethodID)
@@ -0,0 +1,94 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include "common/block_cache.h"
+
+namespace Common {
+
+BlockCache::BlockCache(std::size_t capacity, std::size_t read_ahead_blocks,
+                       std::size_t num_workers, std::string thread_name, LoadFunction load)
+    : capacity(capacity), read_ahead_blocks(read_ahead_blocks), num_workers(num_workers),
+      thread_name(std::move(thread_name)), load(std::move(load)) {}
+
+BlockCache::~BlockCache() = default;
+
+void BlockCache::SetNumBlocks(std::size_t num_blocks_) {
+    std::scoped_lock lock{cache_mutex};
+    num_blocks = num_blocks_;
+}
+
+std::size_t BlockCache::Read(std::size_t block, std::size_t offset, std::size_t length,
+                             u8* buffer) {
+    bool hit;
+    bool sequential;
+    {
+        std::scoped_lock lock{cache_mutex};
+        sequential = block == last_read_block + 1;
+        last_read_block = block;
+        hit = CopyFromCache(block, offset, length, buffer);
+    }
+
+    std::size_t copied = length;
+    if (!hit) {
+        std::vector<u8> data = load(block);
+        copied = data.size() > offset ? std::min(length, data.size() - offset) : 0;
+        std::memcpy(buffer, data.data() + offset, copied);
+        Insert(block, std::move(data));
+    }
+
+    if (sequential) {
+        for (std::size_t i = 1; i <= read_ahead_blocks; ++i) {
+            QueueReadAhead(block + i);
+        }
+    }
+    return copied;
+}
+
+bool BlockCache::Contains(std::size_t block) {
+    std::scoped_lock lock{cache_mutex};
+    return cache_index.contains(block);
+}
+
+bool BlockCache::CopyFromCache(std::size_t block, std::size_t offset, std::size_t length,
+                               u8* buffer) {
+    const auto it = cache_index.find(block);
+    if (it == cache_index.end() || it->second->data.size() < offset + length) {
+        return false;
+    }
+    cache.splice(cache.begin(), cache, it->second);
+    std::memcpy(buffer, it->second->data.data() + offset, length);
+    return true;
+}
+
+void BlockCache::Insert(std::size_t block, std::vector<u8>&& data) {
+    std::scoped_lock lock{cache_mutex};
+    pending_read_ahead.erase(block);
+    if (capacity == 0 || data.empty() || cache_index.contains(block)) {
+        return;
+    }
+    if (cache.size() >= capacity) {
+        cache_index.erase(cache.back().index);
+        cache.pop_back();
+    }
+    cache.push_front(CacheBlock{block, std::move(data)});
+    cache_index.emplace(block, cache.begin());
+}
+
+void BlockCache::QueueReadAhead(std::size_t block) {
+    {
+        std::scoped_lock lock{cache_mutex};
+        if (capacity == 0 || block >= num_blocks || cache_index.contains(block) ||
+            !pending_read_ahead.insert(block).second) {
+            return;
+        }
+    }
+    std::call_once(read_ahead_workers_created, [this] {
+        read_ahead_workers = std::make_unique<Common::ThreadWorker>(num_workers, thread_name);
+    });
+    read_ahead_workers->QueueWork([this, block] { Insert(block, load(block)); });
+}
+
+} // namespace Common
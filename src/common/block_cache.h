@@ -0,0 +1,91 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+
+namespace Common {
+
+/**
+ * LRU cache of the blocks of a file that have to be decoded before use, such as decrypted or
+ * decompressed blocks. When the blocks are read in order, the following ones are loaded ahead of
+ * time on background threads. The cache can be used from several threads at once.
+ */
+class BlockCache {
+public:
+    /// Loads a whole block, returns an empty vector if it could not be loaded.
+    using LoadFunction = std::function<std::vector<u8>(std::size_t block)>;
+
+    /**
+     * @param capacity Number of blocks that are kept around
+     * @param read_ahead_blocks Number of blocks past a sequential read that are loaded ahead
+     * @param num_workers Number of threads the blocks are loaded ahead on
+     * @param thread_name Name of these threads
+     * @param load Loads a block, called from the reading thread and the read-ahead threads
+     */
+    BlockCache(std::size_t capacity, std::size_t read_ahead_blocks, std::size_t num_workers,
+               std::string thread_name, LoadFunction load);
+    ~BlockCache();
+
+    [[nodiscard]] std::size_t Capacity() const {
+        return capacity;
+    }
+
+    /// Sets the number of blocks of the file, blocks past the end are not read ahead.
+    void SetNumBlocks(std::size_t num_blocks);
+
+    /**
+     * Copies part of a block into buffer, loading the block if it is not cached.
+     * @returns The number of bytes copied, less than length if the block is too short
+     */
+    std::size_t Read(std::size_t block, std::size_t offset, std::size_t length, u8* buffer);
+
+    /// Whether the block is cached, so reading it won't load it.
+    [[nodiscard]] bool Contains(std::size_t block);
+
+private:
+    struct CacheBlock {
+        std::size_t index;
+        std::vector<u8> data;
+    };
+
+    std::size_t capacity;
+    std::size_t read_ahead_blocks;
+    std::size_t num_workers;
+    std::string thread_name;
+    LoadFunction load;
+    std::size_t num_blocks = 0;
+
+    // Most recently used block first.
+    std::list<CacheBlock> cache;
+    std::unordered_map<std::size_t, std::list<CacheBlock>::iterator> cache_index;
+    std::unordered_set<std::size_t> pending_read_ahead;
+    std::size_t last_read_block = std::numeric_limits<std::size_t>::max();
+    std::mutex cache_mutex;
+
+    // Declared last so that queued read-ahead is stopped before the cache is destroyed.
+    std::once_flag read_ahead_workers_created;
+    std::unique_ptr<Common::ThreadWorker> read_ahead_workers;
+
+    /// Copies the requested part of a block into buffer if it is cached. Requires cache_mutex.
+    bool CopyFromCache(std::size_t block, std::size_t offset, std::size_t length, u8* buffer);
+
+    /// Inserts a loaded block, evicting the least recently used one if needed.
+    void Insert(std::size_t block, std::vector<u8>&& data);
+
+    void QueueReadAhead(std::size_t block);
+};
+
+} // namespace Common
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
@@ -11,6 +12,7 @@
 #include <mutex>
 #include <new>
 
+#include "common/common_types.h"
 #include "common/polyfill_thread.h"
 
 namespace Common {
@@ -248,4 +250,94 @@ private:
     std::mutex read_mutex;
 };
 
+/**
+ * Queue many threads push to without locking and a single thread pops from. Unlike the queues
+ * above, pushing never waits, it fails when the queue is full.
+ */
+template <typename T, std::size_t Capacity = detail::DefaultCapacity>
+class LockFreeMPSCQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+    LockFreeMPSCQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order::relaxed);
+        }
+    }
+
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        // Each cell holds the write index it can be written at next, producers claim a cell by
+        // advancing the write index past it.
+        std::size_t write_index = m_write_index.load(std::memory_order::relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &m_cells[write_index % Capacity];
+            const std::size_t sequence = cell->sequence.load(std::memory_order::acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - write_index);
+            if (diff == 0) {
+                if (m_write_index.compare_exchange_weak(write_index, write_index + 1,
+                                                        std::memory_order::relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The consumer hasn't popped the element written a lap earlier yet.
+                return false;
+            } else {
+                write_index = m_write_index.load(std::memory_order::relaxed);
+            }
+        }
+
+        cell->data = T(std::forward<Args>(args)...);
+        cell->sequence.store(write_index + 1, std::memory_order::release);
+
+        m_push_count.fetch_add(1, std::memory_order::release);
+        m_push_count.notify_one();
+        return true;
+    }
+
+    bool TryPop(T& t) {
+        Cell& cell = m_cells[m_read_index % Capacity];
+        if (cell.sequence.load(std::memory_order::acquire) != m_read_index + 1) {
+            return false;
+        }
+        t = std::move(cell.data);
+        cell.sequence.store(m_read_index + Capacity, std::memory_order::release);
+        ++m_read_index;
+        return true;
+    }
+
+    /// Waits for an element to pop, returns false if a stop was requested first.
+    bool PopWait(T& t, std::stop_token stop_token) {
+        std::stop_callback callback(stop_token, [this] {
+            m_push_count.fetch_add(1, std::memory_order::release);
+            m_push_count.notify_one();
+        });
+        while (!TryPop(t)) {
+            if (stop_token.stop_requested()) {
+                return false;
+            }
+            // Pushes after the load change the count, so the wait can't miss them.
+            const u32 push_count = m_push_count.load(std::memory_order::acquire);
+            if (TryPop(t)) {
+                return true;
+            }
+            m_push_count.wait(push_count, std::memory_order::acquire);
+        }
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic_size_t sequence;
+        T data;
+    };
+
+    alignas(128) std::atomic_size_t m_write_index{0};
+    alignas(128) std::atomic<u32> m_push_count{0};
+    alignas(128) std::size_t m_read_index{0};
+
+    std::array<Cell, Capacity> m_cells;
+};
+
 } // namespace Common
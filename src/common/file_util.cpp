@@ -56,6 +56,7 @@
 #include <dirent.h>
 #include <pwd.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #endif
 
 #if defined(__APPLE__)
@@ -94,6 +95,11 @@ namespace FileUtil {
 
 using Common::GetLastErrorMsg;
 
+#ifdef ANDROID
+// Size of the stdio buffer of files opened through the storage access framework.
+constexpr std::size_t AndroidStreamBufferSize = 128 * 1024;
+#endif
+
 // Remove any ending forward slashes from directory paths
 // Modifies argument.
 static void StripTailDirSlashes(std::string& fname) {
@@ -513,42 +519,94 @@ bool ForeachDirectoryEntry(u64* num_entries_out, const std::string& directory,
     return true;
 }
 
+std::optional<std::vector<DirectoryEntry>> ListDirectory(const std::string& directory) {
+    LOG_TRACE(Common_Filesystem, "directory {}", directory);
+
+    std::vector<DirectoryEntry> entries;
+#ifdef _WIN32
+    WIN32_FIND_DATAW ffd;
+    HANDLE handle_find = FindFirstFileW(Common::UTF8ToUTF16W(directory + "\\*").c_str(), &ffd);
+    if (handle_find == INVALID_HANDLE_VALUE) {
+        return std::nullopt;
+    }
+    do {
+        std::string name = Common::UTF16ToUTF8(ffd.cFileName);
+        if (name == "." || name == "..") {
+            continue;
+        }
+        const bool is_directory = (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        const u64 size = is_directory ? 0 : (u64{ffd.nFileSizeHigh} << 32) | ffd.nFileSizeLow;
+        entries.push_back({std::move(name), is_directory, size});
+    } while (FindNextFileW(handle_find, &ffd) != 0);
+    FindClose(handle_find);
+#elif ANDROID
+    // A single call to the storage provider instead of two round trips through JNI per entry.
+    for (auto& info : AndroidStorage::GetFilesInfo(directory)) {
+        entries.push_back({std::move(info.name), info.is_directory, info.size});
+    }
+#else
+    DIR* dirp = opendir(directory.c_str());
+    if (!dirp) {
+        return std::nullopt;
+    }
+    while (struct dirent* result = readdir(dirp)) {
+        std::string name(result->d_name);
+        if (name == "." || name == "..") {
+            continue;
+        }
+        // The entry type saves the stat of directories, one stat gives the rest both type and
+        // size where the separate queries took three.
+        if (result->d_type == DT_DIR) {
+            entries.push_back({std::move(name), true, 0});
+            continue;
+        }
+        struct stat file_info;
+        const std::string path = directory + DIR_SEP + name;
+        if (stat(path.c_str(), &file_info) != 0) {
+            LOG_DEBUG(Common_Filesystem, "stat failed on {}: {}", path, GetLastErrorMsg());
+            entries.push_back({std::move(name), false, 0});
+            continue;
+        }
+        const bool is_directory = S_ISDIR(file_info.st_mode);
+        entries.push_back({std::move(name), is_directory,
+                           is_directory ? 0 : static_cast<u64>(file_info.st_size)});
+    }
+    closedir(dirp);
+#endif
+    return entries;
+}
+
 u64 ScanDirectoryTree(const std::string& directory, FSTEntry& parent_entry, unsigned int recursion,
                       std::atomic<bool>* stop_flag) {
-    const auto callback = [recursion, &parent_entry,
-                           stop_flag](u64* num_entries_out, const std::string& directory,
-                                      const std::string& virtual_name) -> bool {
+    auto entries = ListDirectory(directory);
+    if (!entries) {
+        return 0;
+    }
+
+    u64 num_entries = 0;
+    parent_entry.children.reserve(parent_entry.children.size() + entries->size());
+    for (DirectoryEntry& directory_entry : *entries) {
         // Break early and return error if stop is requested
         if (stop_flag && *stop_flag) {
-            return false;
+            return 0;
         }
 
         FSTEntry entry;
-        entry.virtualName = virtual_name;
-        entry.physicalName = directory + DIR_SEP + virtual_name;
-
-        if (IsDirectory(entry.physicalName)) {
-            entry.isDirectory = true;
-            // is a directory, lets go inside if we didn't recurse to often
-            if (recursion > 0) {
-                entry.size = ScanDirectoryTree(entry.physicalName, entry, recursion - 1);
-                *num_entries_out += entry.size;
-            } else {
-                entry.size = 0;
-            }
-        } else { // is a file
-            entry.isDirectory = false;
-            entry.size = GetSize(entry.physicalName);
+        entry.physicalName = directory + DIR_SEP + directory_entry.name;
+        entry.virtualName = std::move(directory_entry.name);
+        entry.isDirectory = directory_entry.is_directory;
+        entry.size = directory_entry.size;
+        // is a directory, lets go inside if we didn't recurse to often
+        if (entry.isDirectory && recursion > 0) {
+            entry.size = ScanDirectoryTree(entry.physicalName, entry, recursion - 1, stop_flag);
+            num_entries += entry.size;
         }
-        (*num_entries_out)++;
+        num_entries++;
 
         // Push into the tree
         parent_entry.children.push_back(std::move(entry));
-        return true;
-    };
-
-    u64 num_entries;
-    return ForeachDirectoryEntry(&num_entries, directory, callback) ? num_entries : 0;
+    }
+    return num_entries;
 }
 
 void GetAllFilesFromNestedEntries(FSTEntry& directory, std::vector<FSTEntry>& output) {
@@ -1154,6 +1212,12 @@ bool IOFile::Open() {
             LOG_ERROR(Common_Filesystem, "Error on file: {}, error: {}", filename,
                       strerror(error_num));
         }
+        // Scoped storage goes through FUSE, where every call costs a round trip to the provider
+        // process. The default stdio buffer of bionic is only BUFSIZ bytes, so a larger one turns
+        // streams of small reads and writes into a few large ones.
+        if (m_file != nullptr) {
+            std::setvbuf(m_file, nullptr, _IOFBF, AndroidStreamBufferSize);
+        }
     }
 
     m_good = m_file != nullptr;
@@ -1415,6 +1479,58 @@ void OpenFStream<std::ios_base::out>(
     boost::iostreams::file_descriptor_sink file_descriptor_sink(fd, boost::iostreams::close_handle);
     fstream.open(file_descriptor_sink);
 }
+
+MappedFile::MappedFile(const IOFile& file) {
+    const int fd = file.GetFd();
+    const u64 file_size = file.GetSize();
+    if (fd < 0 || file_size == 0 || file_size > std::numeric_limits<std::size_t>::max()) {
+        return;
+    }
+
+#ifdef _WIN32
+    const auto file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        LOG_WARNING(Common_Filesystem, "Could not map {}: {}", file.Filename(),
+                    Common::GetLastErrorMsg());
+        return;
+    }
+    void* view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        LOG_WARNING(Common_Filesystem, "Could not map {}: {}", file.Filename(),
+                    Common::GetLastErrorMsg());
+        CloseHandle(mapping_handle);
+        mapping_handle = nullptr;
+        return;
+    }
+#else
+    void* view = mmap(nullptr, static_cast<std::size_t>(file_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        LOG_WARNING(Common_Filesystem, "Could not map {}: {}", file.Filename(),
+                    Common::GetLastErrorMsg());
+        return;
+    }
+#endif
+
+    data = static_cast<const u8*>(view);
+    size = static_cast<std::size_t>(file_size);
+}
+
+MappedFile::~MappedFile() {
+    if (data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping_handle);
+#else
+    munmap(const_cast<u8*>(data), size);
+#endif
+}
+
 } // namespace FileUtil
 
 SERIALIZE_EXPORT_IMPL(FileUtil::IOFile)
@@ -167,6 +167,22 @@ using DirectoryEntryCallable = std::function<bool(
 bool ForeachDirectoryEntry(u64* num_entries_out, const std::string& directory,
                            DirectoryEntryCallable callback);
 
+/// An entry of a directory, as listed by ListDirectory.
+struct DirectoryEntry {
+    std::string name;
+    bool is_directory;
+    u64 size; ///< file length, 0 for directories
+};
+
+/**
+ * Lists the files and directories contained within a directory. Their type and size are read
+ * along with the names where the host provides them, instead of with a query per entry.
+ * @param directory the directory to list
+ * @return the entries, or nullopt if the directory could not be opened
+ */
+[[nodiscard]] std::optional<std::vector<DirectoryEntry>> ListDirectory(
+    const std::string& directory);
+
 /**
  * Scans the directory tree, storing the results.
  * @param directory the parent directory to start scanning from
@@ -436,8 +452,8 @@ public:
     bool Seek(s64 off, int origin) {
         return SeekImpl(off, origin);
     }
-    [[nodiscard]] u64 Tell() const;
-    [[nodiscard]] u64 GetSize() const;
+    [[nodiscard]] virtual u64 Tell() const;
+    [[nodiscard]] virtual u64 GetSize() const;
     bool Resize(u64 size);
     bool Flush();
 
@@ -451,6 +467,11 @@ public:
         return false;
     }
 
+    // Whether reads are transparently decompressed, so offsets do not match the file on disk
+    virtual bool IsCompressed() {
+        return false;
+    }
+
     const std::string& Filename() const {
         return filename;
     }
@@ -524,6 +545,33 @@ private:
     friend class boost::serialization::access;
 };
 
+/**
+ * Read-only memory mapping of a whole file, so that reads can be served from the host page cache
+ * without going through the C stdio functions. Mapping can fail, for example on hosts without
+ * enough address space, in which case callers should fall back to IOFile reads.
+ */
+class MappedFile : public NonCopyable {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const IOFile& file);
+    ~MappedFile();
+
+    [[nodiscard]] bool IsValid() const {
+        return data != nullptr;
+    }
+
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {data, size};
+    }
+
+private:
+    const u8* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* mapping_handle = nullptr;
+#endif
+};
+
 template <std::ios_base::openmode o, typename T>
 void OpenFStream(T& fstream, const std::string& filename);
 } // namespace FileUtil
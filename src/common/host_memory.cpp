@@ -0,0 +1,185 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/host_memory.h"
+#include "common/logging/log.h"
+
+namespace Common {
+
+#ifdef _WIN32
+
+static u8* AllocateLargePages(std::size_t& size) {
+    const std::size_t large_page_size = GetLargePageMinimum();
+    if (large_page_size == 0) {
+        return nullptr;
+    }
+
+    // Large pages need SeLockMemoryPrivilege, which the user has to be granted beforehand.
+    HANDLE token;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        return nullptr;
+    }
+    TOKEN_PRIVILEGES privileges{};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    const bool has_privilege =
+        LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+        AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+        GetLastError() == ERROR_SUCCESS;
+    CloseHandle(token);
+    if (!has_privilege) {
+        return nullptr;
+    }
+
+    const std::size_t aligned_size = AlignUp(size, large_page_size);
+    void* pointer = VirtualAlloc(nullptr, aligned_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                 PAGE_READWRITE);
+    if (pointer) {
+        size = aligned_size;
+    }
+    return static_cast<u8*>(pointer);
+}
+
+HostMemoryPtr AllocateHostMemory(std::size_t size, bool use_huge_pages) {
+    if (use_huge_pages) {
+        std::size_t aligned_size = size;
+        if (u8* pointer = AllocateLargePages(aligned_size)) {
+            LOG_INFO(Common_Memory, "Allocated {:#x} bytes with large pages", aligned_size);
+            return HostMemoryPtr{pointer, HostMemoryDeleter{aligned_size}};
+        }
+        LOG_WARNING(Common_Memory, "Large pages are unavailable, using regular pages");
+    }
+
+    void* pointer = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    ASSERT_MSG(pointer, "Failed to allocate {:#x} bytes of host memory", size);
+    return HostMemoryPtr{static_cast<u8*>(pointer), HostMemoryDeleter{size}};
+}
+
+void HostMemoryDeleter::operator()(u8* pointer) const {
+    VirtualFree(pointer, 0, MEM_RELEASE);
+}
+
+#else
+
+HostMemoryPtr AllocateHostMemory(std::size_t size, bool use_huge_pages) {
+    [[maybe_unused]] constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+
+#ifdef MAP_HUGETLB
+    if (use_huge_pages) {
+        // Explicit huge pages only succeed if the administrator reserved enough of them.
+        const std::size_t aligned_size = AlignUp(size, HugePageSize);
+        void* pointer = mmap(nullptr, aligned_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pointer != MAP_FAILED) {
+            LOG_INFO(Common_Memory, "Allocated {:#x} bytes with explicit huge pages",
+                     aligned_size);
+            return HostMemoryPtr{static_cast<u8*>(pointer), HostMemoryDeleter{aligned_size}};
+        }
+    }
+#endif
+
+    void* pointer =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_MSG(pointer != MAP_FAILED, "Failed to allocate {:#x} bytes of host memory", size);
+
+#ifdef MADV_HUGEPAGE
+    if (use_huge_pages) {
+        // Transparent huge pages are only a hint, the kernel keeps regular pages if it can't
+        // find contiguous memory.
+        if (madvise(pointer, size, MADV_HUGEPAGE) == 0) {
+            LOG_INFO(Common_Memory, "Allocated {:#x} bytes with transparent huge pages", size);
+        } else {
+            LOG_WARNING(Common_Memory, "Huge pages are unavailable, using regular pages");
+        }
+    }
+#else
+    if (use_huge_pages) {
+        LOG_WARNING(Common_Memory, "Huge pages are not supported on this platform");
+    }
+#endif
+
+    return HostMemoryPtr{static_cast<u8*>(pointer), HostMemoryDeleter{size}};
+}
+
+void HostMemoryDeleter::operator()(u8* pointer) const {
+    munmap(pointer, size);
+}
+
+#endif
+
+#if defined(__linux__) && !defined(__ANDROID__)
+// Android only declares memfd_create from API level 30, older devices copy the contents back.
+#define HOST_MEMORY_SNAPSHOT_FILE
+
+static bool WriteAll(int fd, std::span<const u8> contents) {
+    std::size_t written = 0;
+    while (written < contents.size()) {
+        const ssize_t result = write(fd, contents.data() + written, contents.size() - written);
+        if (result <= 0) {
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+#endif
+
+HostMemorySnapshot::HostMemorySnapshot(std::span<const u8> contents) : size{contents.size()} {
+#ifdef HOST_MEMORY_SNAPSHOT_FILE
+    fd = memfd_create("HostMemorySnapshot", MFD_CLOEXEC);
+    if (fd >= 0 && WriteAll(fd, contents)) {
+        return;
+    }
+    LOG_WARNING(Common_Memory, "Could not store a memory snapshot in a file, copying it instead");
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+#endif
+    copy.assign(contents.begin(), contents.end());
+}
+
+HostMemorySnapshot::~HostMemorySnapshot() {
+#ifdef HOST_MEMORY_SNAPSHOT_FILE
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+void HostMemorySnapshot::Restore(std::span<u8> memory) const {
+    ASSERT(memory.size() == size);
+#ifdef HOST_MEMORY_SNAPSHOT_FILE
+    if (fd >= 0) {
+        const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const bool page_aligned = reinterpret_cast<uintptr_t>(memory.data()) % page_size == 0 &&
+                                  size % page_size == 0;
+        if (page_aligned && mmap(memory.data(), size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_FIXED, fd, 0) != MAP_FAILED) {
+            return;
+        }
+        std::size_t read = 0;
+        while (read < size) {
+            const ssize_t result = pread(fd, memory.data() + read, size - read,
+                                         static_cast<off_t>(read));
+            ASSERT_MSG(result > 0, "Failed to read a memory snapshot");
+            read += static_cast<std::size_t>(result);
+        }
+        return;
+    }
+#endif
+    std::memcpy(memory.data(), copy.data(), size);
+}
+
+} // namespace Common
@@ -0,0 +1,64 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Releases memory returned by AllocateHostMemory.
+struct HostMemoryDeleter {
+    std::size_t size{};
+    void operator()(u8* pointer) const;
+};
+
+using HostMemoryPtr = std::unique_ptr<u8[], HostMemoryDeleter>;
+
+/**
+ * Allocates zero-initialised host memory for a large emulated memory region.
+ * @param size Size of the allocation in bytes
+ * @param use_huge_pages Whether to back the allocation with huge pages (explicit huge pages or
+ *                       transparent huge pages on Linux, large pages on Windows). Falls back to
+ *                       regular pages if the host doesn't provide them.
+ * @return Pointer to the allocation, never null
+ */
+[[nodiscard]] HostMemoryPtr AllocateHostMemory(std::size_t size, bool use_huge_pages);
+
+/**
+ * A copy of the contents of host memory that memory can be reset to many times. On Linux the
+ * copy is kept in an anonymous file that is mapped copy-on-write over the memory being reset, so
+ * a reset is a single mapping and only the pages written afterwards get copied. Elsewhere the
+ * contents are copied back.
+ */
+class HostMemorySnapshot {
+public:
+    explicit HostMemorySnapshot(std::span<const u8> contents);
+    ~HostMemorySnapshot();
+
+    HostMemorySnapshot(const HostMemorySnapshot&) = delete;
+    HostMemorySnapshot& operator=(const HostMemorySnapshot&) = delete;
+
+    /**
+     * Resets memory to the snapshot.
+     * @param memory Memory of the size of the snapshot. It is only mapped over if it was
+     *               returned by AllocateHostMemory, as the mapping replaces whole host pages.
+     */
+    void Restore(std::span<u8> memory) const;
+
+    [[nodiscard]] std::size_t Size() const noexcept {
+        return size;
+    }
+
+private:
+    std::size_t size;
+    int fd = -1;          ///< Anonymous file holding the contents, -1 if there is none
+    std::vector<u8> copy; ///< The contents, when they could not be put in a file
+};
+
+} // namespace Common
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <chrono>
+#include <thread>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/regex.hpp>
 
@@ -253,24 +254,36 @@ public:
         color_console_backend.SetEnabled(enabled);
     }
 
+    bool CheckMessage(Class log_class, Level log_level) const {
+        return filter.CheckMessage(log_class, log_level);
+    }
+
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, std::string message) {
-        if (!filter.CheckMessage(log_class, log_level)) {
-            return;
-        }
         Entry new_entry =
             CreateEntry(log_class, log_level, filename, line_num, function, std::move(message));
-        if (!regex_filter.empty() &&
-            !boost::regex_search(FormatLogMessage(new_entry), regex_filter)) {
-            return;
-        }
         if (Settings::values.instant_debug_log.GetValue()) {
+            if (!MatchesRegexFilter(new_entry)) {
+                return;
+            }
             ForEachBackend([&new_entry](Backend& backend) {
                 backend.Write(new_entry);
                 backend.Flush();
             });
-        } else {
-            message_queue.EmplaceWait(new_entry);
+            return;
+        }
+
+        // The queue never blocks the logging thread. When the log thread can't keep up, messages
+        // below errors are dropped and counted instead.
+        if (message_queue.TryEmplace(std::move(new_entry))) {
+            return;
+        }
+        if (log_level < Level::Error) {
+            dropped_entries.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        while (!message_queue.TryEmplace(std::move(new_entry))) {
+            std::this_thread::yield();
         }
     }
 
@@ -344,11 +357,19 @@ private:
             Common::SetCurrentThreadName("citra:Log");
             Entry entry;
             const auto write_logs = [this, &entry]() {
+                if (const u64 dropped = dropped_entries.exchange(0, std::memory_order_relaxed)) {
+                    const auto dropped_entry = CreateEntry(
+                        Class::Log, Level::Warning, "?", 0, "?",
+                        fmt::format("Dropped {} log messages, logging could not keep up", dropped));
+                    ForEachBackend([&](Backend& backend) { backend.Write(dropped_entry); });
+                }
+                if (!MatchesRegexFilter(entry)) {
+                    return;
+                }
                 ForEachBackend([&entry](Backend& backend) { backend.Write(entry); });
             };
             while (!stop_token.stop_requested()) {
-                message_queue.PopWait(entry, stop_token);
-                if (entry.filename != nullptr) {
+                if (message_queue.PopWait(entry, stop_token)) {
                     write_logs();
                 }
             }
@@ -387,6 +408,11 @@ private:
         };
     }
 
+    /// Formatting the message for the regex is left to the log thread, off the logging thread.
+    bool MatchesRegexFilter(const Entry& entry) const {
+        return regex_filter.empty() || boost::regex_search(FormatLogMessage(entry), regex_filter);
+    }
+
     void ForEachBackend(auto lambda) {
         lambda(static_cast<Backend&>(debugger_backend));
         lambda(static_cast<Backend&>(color_console_backend));
@@ -441,7 +467,8 @@ private:
     LogcatBackend lc_backend{};
 #endif
 
-    MPSCQueue<Entry> message_queue{};
+    LockFreeMPSCQueue<Entry> message_queue{};
+    std::atomic<u64> dropped_entries{0};
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
     std::jthread backend_thread;
 
@@ -485,9 +512,14 @@ void SetColorConsoleBackendEnabled(bool enabled) {
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, fmt::string_view format,
                        const fmt::format_args& args) {
-    if (!initialization_in_progress_suppress_logging) {
-        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function,
-                                   fmt::vformat(format, args));
+    if (initialization_in_progress_suppress_logging) {
+        return;
+    }
+    // Messages are filtered before formatting, so filtered out debug logs cost next to nothing.
+    auto& instance = Impl::Instance();
+    if (instance.CheckMessage(log_class, log_level)) {
+        instance.PushEntry(log_class, log_level, filename, line_num, function,
+                           fmt::vformat(format, args));
     }
 }
 } // namespace Common::Log
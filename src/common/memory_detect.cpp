@@ -16,10 +16,23 @@
 #endif
 #endif
 
+#include <atomic>
+#include "common/literals.h"
 #include "common/memory_detect.h"
 
 namespace Common {
 
+namespace {
+
+using namespace Common::Literals;
+
+/// Hosts sold with 4 GiB of RAM report a bit less, as part of it is reserved by the firmware.
+constexpr u64 LowMemoryHostLimit = 4608_MiB;
+
+std::atomic<u64> memory_trim_count{0};
+
+} // Anonymous namespace
+
 // Detects the RAM and Swapfile sizes
 const MemoryInfo GetMemInfo() {
     MemoryInfo mem_info{};
@@ -73,4 +86,17 @@ u64 GetPageSize() {
 #endif
 }
 
+bool IsLowMemoryHost() {
+    static const bool is_low_memory = GetMemInfo().total_physical_memory < LowMemoryHostLimit;
+    return is_low_memory;
+}
+
+void RequestMemoryTrim() {
+    memory_trim_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+u64 GetMemoryTrimCount() {
+    return memory_trim_count.load(std::memory_order_relaxed);
+}
+
 } // namespace Common
@@ -25,4 +25,22 @@ struct MemoryInfo {
  */
 u64 GetPageSize();
 
+/**
+ * Returns true on hosts with little enough RAM, such as 3 and 4 GiB phones, that the caches
+ * without a user set budget should default to a small one instead of growing unbounded.
+ */
+[[nodiscard]] bool IsLowMemoryHost();
+
+/**
+ * Asks the caches to release the memory they can do without, for when the OS warns that the
+ * process is about to be killed. The caches check for it on their next periodic cleanup.
+ */
+void RequestMemoryTrim();
+
+/**
+ * Returns the number of memory trims requested so far. Caches keep the last count they handled
+ * and trim whenever it changed.
+ */
+[[nodiscard]] u64 GetMemoryTrimCount();
+
 } // namespace Common
@@ -5,3 +5,217 @@
 // Includes the MicroProfile implementation in this file for compilation
 #define MICROPROFILE_IMPL 1
 #include "common/microprofile.h"
+
+#include <array>
+#include <mutex>
+#include <vector>
+#include <fmt/format.h>
+#include "common/file_util.h"
+
+namespace Common {
+
+#if MICROPROFILE_ENABLED
+
+namespace {
+
+struct TraceState {
+    std::mutex mutex;
+    FileUtil::IOFile file;
+    bool running = false;
+    bool first_event = true;
+    bool restore_all_groups = false;
+    bool restore_force_enable = false;
+    u64 frames_to_skip = 0;
+    u64 frames_left = 0; ///< Zero when tracing until stopped.
+    u64 frame_number = 0;
+    u32 last_frame_index = 0;
+    int64_t start_tick = 0;
+    int64_t end_tick = 0;
+    std::array<std::vector<u32>, MICROPROFILE_MAX_THREADS> stacks;
+    std::array<std::string, MICROPROFILE_MAX_THREADS> thread_names;
+    std::string buffer;
+};
+
+TraceState g_trace;
+
+/// Names come from source literals, only the characters JSON reserves need escaping.
+std::string EscapeJson(const char* str) {
+    std::string escaped;
+    for (; *str != '\0'; ++str) {
+        if (*str == '"' || *str == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(*str);
+    }
+    return escaped;
+}
+
+void AppendEvent(TraceState& trace, std::string_view event) {
+    trace.buffer.append(trace.first_event ? "\n" : ",\n");
+    trace.buffer.append(event);
+    trace.first_event = false;
+}
+
+double TickToMicroseconds(const TraceState& trace, MicroProfileLogEntry entry) {
+    return static_cast<double>(MicroProfileLogTickDifference(trace.start_tick, entry)) * 1e6 /
+           static_cast<double>(MicroProfileTicksPerSecondCpu());
+}
+
+void AppendLeave(TraceState& trace, u32 thread, double timestamp) {
+    AppendEvent(trace, fmt::format(R"({{"ph":"E","ts":{:.3f},"pid":0,"tid":{}}})", timestamp,
+                                   thread));
+}
+
+/// Converts the log entries of the frame MicroProfile just completed to trace events.
+void AppendFrame(TraceState& trace) {
+    const MicroProfile& profile = g_MicroProfile;
+    const uint32_t frame = profile.nFrameCurrent;
+    const uint32_t next_frame = (frame + 1) % MICROPROFILE_MAX_FRAME_HISTORY;
+    if (trace.frame_number == 0) {
+        trace.start_tick = profile.Frames[frame].nFrameStartCpu;
+    }
+    trace.end_tick = profile.Frames[next_frame].nFrameStartCpu;
+    const double frame_start = TickToMicroseconds(trace, profile.Frames[frame].nFrameStartCpu);
+    AppendEvent(trace, fmt::format(R"({{"name":"Frame {}","ph":"i","s":"g","ts":{:.3f},)"
+                                   R"("pid":0,"tid":0}})",
+                                   trace.frame_number, frame_start));
+
+    for (uint32_t thread = 0; thread < profile.nNumLogs; ++thread) {
+        const MicroProfileThreadLog* log = profile.Pool[thread];
+        if (!log || log->nGpu) {
+            continue;
+        }
+        if (trace.thread_names[thread] != log->ThreadName) {
+            // Logs of exited threads are reused by new ones.
+            trace.thread_names[thread] = log->ThreadName;
+            trace.stacks[thread].clear();
+            AppendEvent(trace, fmt::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},)"
+                                           R"("args":{{"name":"{}"}}}})",
+                                           thread, EscapeJson(log->ThreadName)));
+        }
+
+        auto& stack = trace.stacks[thread];
+        const uint32_t end = profile.Frames[next_frame].nLogStart[thread];
+        for (uint32_t i = profile.Frames[frame].nLogStart[thread]; i != end;
+             i = (i + 1) % MICROPROFILE_BUFFER_SIZE) {
+            const MicroProfileLogEntry entry = log->Log[i];
+            const auto timer = static_cast<u32>(MicroProfileLogTimerIndex(entry));
+            switch (MicroProfileLogType(entry)) {
+            case MP_LOG_ENTER: {
+                const auto& info = profile.TimerInfo[timer];
+                stack.push_back(timer);
+                AppendEvent(trace,
+                            fmt::format(R"({{"name":"{}","cat":"{}","ph":"B","ts":{:.3f},)"
+                                        R"("pid":0,"tid":{}}})",
+                                        EscapeJson(info.pName),
+                                        EscapeJson(profile.GroupInfo[info.nGroupIndex].pName),
+                                        TickToMicroseconds(trace, entry), thread));
+                break;
+            }
+            case MP_LOG_LEAVE:
+                // Scopes entered before the trace started have no begin event to close.
+                if (!stack.empty()) {
+                    stack.pop_back();
+                    AppendLeave(trace, thread, TickToMicroseconds(trace, entry));
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void FinishTrace(TraceState& trace) {
+    const double end = TickToMicroseconds(trace, trace.end_tick);
+    for (u32 thread = 0; thread < trace.stacks.size(); ++thread) {
+        for (std::size_t i = 0; i < trace.stacks[thread].size(); ++i) {
+            AppendLeave(trace, thread, end);
+        }
+        trace.stacks[thread].clear();
+    }
+    trace.buffer.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+    trace.file.WriteString(trace.buffer);
+    trace.file.Close();
+    trace.buffer.clear();
+    trace.running = false;
+
+    std::lock_guard lock{MicroProfileGetMutex()};
+    MicroProfileSetEnableAllGroups(trace.restore_all_groups);
+    MicroProfileSetForceEnable(trace.restore_force_enable);
+}
+
+} // Anonymous namespace
+
+bool StartMicroProfileTrace(const std::string& path, u64 first_frame, u64 num_frames) {
+    std::scoped_lock lock{g_trace.mutex, MicroProfileGetMutex()};
+    if (g_trace.running) {
+        return false;
+    }
+    g_trace.file = FileUtil::IOFile(path, "w");
+    if (!g_trace.file.IsOpen()) {
+        return false;
+    }
+    g_trace.file.WriteString(R"({"traceEvents":[)");
+    g_trace.running = true;
+    g_trace.first_event = true;
+    g_trace.frames_to_skip = first_frame;
+    g_trace.frames_left = num_frames;
+    g_trace.frame_number = 0;
+    g_trace.last_frame_index = g_MicroProfile.nFrameCurrentIndex;
+    g_trace.start_tick = g_trace.end_tick = MP_TICK();
+    g_trace.thread_names.fill({});
+
+    // Frames only advance while the profiler runs, which the profiler dialog can toggle.
+    g_trace.restore_all_groups = MicroProfileGetEnableAllGroups();
+    g_trace.restore_force_enable = MicroProfileGetForceEnable();
+    MicroProfileSetEnableAllGroups(true);
+    MicroProfileSetForceEnable(true);
+    return true;
+}
+
+void StopMicroProfileTrace() {
+    std::lock_guard lock{g_trace.mutex};
+    if (g_trace.running) {
+        FinishTrace(g_trace);
+    }
+}
+
+void MicroProfileTraceFlip() {
+    std::lock_guard lock{g_trace.mutex};
+    if (!g_trace.running) {
+        return;
+    }
+    {
+        std::lock_guard profile_lock{MicroProfileGetMutex()};
+        if (g_MicroProfile.nFrameCurrentIndex == g_trace.last_frame_index) {
+            return;
+        }
+        g_trace.last_frame_index = g_MicroProfile.nFrameCurrentIndex;
+        if (g_trace.frames_to_skip > 0) {
+            --g_trace.frames_to_skip;
+            return;
+        }
+        AppendFrame(g_trace);
+    }
+    ++g_trace.frame_number;
+    g_trace.file.WriteString(g_trace.buffer);
+    g_trace.buffer.clear();
+    if (g_trace.frames_left > 0 && --g_trace.frames_left == 0) {
+        FinishTrace(g_trace);
+    }
+}
+
+#else
+
+bool StartMicroProfileTrace(const std::string& path, u64 first_frame, u64 num_frames) {
+    return false;
+}
+
+void StopMicroProfileTrace() {}
+
+void MicroProfileTraceFlip() {}
+
+#endif
+
+} // namespace Common
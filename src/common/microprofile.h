@@ -23,3 +23,28 @@ typedef void* HANDLE;
 #include <microprofile.h>
 
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
+
+#include <string>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Starts writing the MicroProfile scopes of every thread to a Chrome trace event JSON file, which
+ * chrome://tracing and Perfetto both open. Frames are written as they complete, so the range is
+ * not limited by the frame history MicroProfile keeps. All profiler groups are enabled while
+ * tracing.
+ * @param path File to write the trace to.
+ * @param first_frame Number of frames to skip from now before the trace starts.
+ * @param num_frames Number of frames to trace, zero to trace until StopMicroProfileTrace.
+ * @return False if the file could not be opened or a trace is already running.
+ */
+bool StartMicroProfileTrace(const std::string& path, u64 first_frame, u64 num_frames);
+
+/// Finishes the running trace, if any, closing the scopes still open.
+void StopMicroProfileTrace();
+
+/// Writes the frame that just completed to the running trace, called after MicroProfileFlip.
+void MicroProfileTraceFlip();
+
+} // namespace Common
@@ -0,0 +1,122 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "common/alignment.h"
+
+namespace Common {
+
+/**
+ * Thread-safe free list of fixed-size blocks. Blocks are carved out of chunks which are never
+ * returned to the system, so the pool only grows to the peak number of live blocks and freed
+ * blocks are handed out again in LIFO order while they are still hot in the cache.
+ */
+template <std::size_t Size, std::size_t Align>
+class FixedBlockPool {
+    static_assert(Align <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+public:
+    /// Returns the pool shared by every allocation of this size and alignment.
+    static FixedBlockPool& Instance() {
+        // Intentionally leaked, as pooled objects may still be released during static destruction.
+        static FixedBlockPool* pool = new FixedBlockPool;
+        return *pool;
+    }
+
+    void* Allocate() {
+        std::scoped_lock lock{mutex};
+        if (!free_list) {
+            Grow();
+        }
+        FreeBlock* block = free_list;
+        free_list = block->next;
+        return block;
+    }
+
+    void Deallocate(void* ptr) noexcept {
+        std::scoped_lock lock{mutex};
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = free_list;
+        free_list = block;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr std::size_t BlockStride =
+        AlignUp(std::max(Size, sizeof(FreeBlock)), std::max(Align, alignof(FreeBlock)));
+    static constexpr std::size_t BlocksPerChunk = 64;
+
+    FixedBlockPool() = default;
+
+    void Grow() {
+        auto& chunk =
+            chunks.emplace_back(std::make_unique<std::byte[]>(BlockStride * BlocksPerChunk));
+        for (std::size_t i = BlocksPerChunk; i-- > 0;) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk.get() + i * BlockStride);
+            block->next = free_list;
+            free_list = block;
+        }
+    }
+
+    std::mutex mutex;
+    FreeBlock* free_list = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+};
+
+/**
+ * Allocator that serves single-object allocations from a FixedBlockPool. When used with
+ * std::allocate_shared the control block is allocated together with the object, so one pooled
+ * block backs each shared object.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n != 1) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        return static_cast<T*>(Pool::Instance().Allocate());
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (n != 1) {
+            std::allocator<T>{}.deallocate(ptr, n);
+            return;
+        }
+        Pool::Instance().Deallocate(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept {
+        return true;
+    }
+
+private:
+    using Pool = FixedBlockPool<sizeof(T), alignof(T)>;
+};
+
+/// Equivalent of std::make_shared that allocates the object from a per-size pool.
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooledShared(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<Args>(args)...);
+}
+
+} // namespace Common
@@ -0,0 +1,78 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * A value published by one writer at a time and read by any number of threads without locking.
+ * Readers copy the whole value and retry if a write happened meanwhile, so they always see a
+ * coherent value at the cost of a copy. Meant for small state structs updated far less often than
+ * they are read, like the state of an input device.
+ * @tparam T Value type, must be trivially copyable.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+
+    explicit SeqLock(const T& value) {
+        Store(value);
+    }
+
+    /// Publishes a new value. Writers must not run concurrently with each other.
+    void Store(const T& value) {
+        std::array<u64, NumWords> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const u32 seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < NumWords; i++) {
+            data[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /// Returns a copy of the last published value.
+    [[nodiscard]] T Load() const {
+        std::array<u64, NumWords> words;
+        u32 before;
+        u32 after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < NumWords; i++) {
+                words[i] = data[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    /// Returns a counter that changes on every Store, to tell whether a value is still current.
+    [[nodiscard]] u32 Sequence() const {
+        return sequence.load(std::memory_order_acquire) & ~1U;
+    }
+
+private:
+    static constexpr std::size_t NumWords = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+
+    std::atomic<u32> sequence{0};
+    std::array<std::atomic<u64>, NumWords> data{};
+};
+
+} // namespace Common
@@ -57,6 +57,19 @@ std::string_view GetTextureFilterName(TextureFilter filter) {
     }
 }
 
+std::string_view GetFSDelayModeName(FSDelayMode mode) {
+    switch (mode) {
+    case FSDelayMode::Hardware:
+        return "Hardware";
+    case FSDelayMode::Table:
+        return "Table";
+    case FSDelayMode::Instant:
+        return "Instant";
+    default:
+        return "Invalid";
+    }
+}
+
 std::string_view GetTextureSamplingName(TextureSampling sampling) {
     switch (sampling) {
     case TextureSampling::GameControlled:
@@ -85,11 +98,38 @@ void LogSettings() {
     LOG_INFO(Config, "Azahar Configuration:");
     log_setting("Core_UseCpuJit", values.use_cpu_jit.GetValue());
     log_setting("Core_CPUClockPercentage", values.cpu_clock_percentage.GetValue());
+    log_setting("Core_ParallelCPUCores", values.parallel_cpu_cores.GetValue());
+    log_setting("Core_SkipIdleLoops", values.skip_idle_loops.GetValue());
+    log_setting("Core_UseTickProfiles", values.use_tick_profiles.GetValue());
+    log_setting("Core_CalibrateTickProfiles", values.calibrate_tick_profiles.GetValue());
+    log_setting("Core_AdaptiveSliceLength", values.adaptive_slice_length.GetValue());
+    log_setting("Core_UseHugePages", values.use_huge_pages.GetValue());
+    log_setting("Core_RomFSCacheSize", values.romfs_cache_size.GetValue());
+    log_setting("Core_SaveDataWriteBack", values.save_data_write_back.GetValue());
+    log_setting("Core_FSDelayMode", GetFSDelayModeName(values.fs_delay_mode.GetValue()));
+    log_setting("Core_FSDelayTable", values.fs_delay_table.GetValue());
+    log_setting("Core_EnableRewind", values.enable_rewind.GetValue());
+    log_setting("Core_RewindInterval", values.rewind_interval.GetValue());
+    log_setting("Core_RewindBufferSize", values.rewind_buffer_size.GetValue());
+    log_setting("Core_PrewarmSavestateSurfaces", values.prewarm_savestate_surfaces.GetValue());
+    log_setting("Core_IncrementalSavestates", values.incremental_savestates.GetValue());
+    log_setting("Core_MovieTurboPlayback", values.movie_turbo_playback.GetValue());
+    log_setting("Core_MovieCheckpointInterval", values.movie_checkpoint_interval.GetValue());
+    log_setting("Core_ResetToBootSnapshot", values.reset_to_boot_snapshot.GetValue());
     log_setting("Controller_UseArticController", values.use_artic_base_controller.GetValue());
+    log_setting("Controller_InputLateLatch", values.input_late_latch.GetValue());
     log_setting("Renderer_UseGLES", values.use_gles.GetValue());
     log_setting("Renderer_GraphicsAPI", GetGraphicsAPIName(values.graphics_api.GetValue()));
     log_setting("Renderer_AsyncShaders", values.async_shader_compilation.GetValue());
+    log_setting("Renderer_UseUberShaders", values.use_uber_shaders.GetValue());
     log_setting("Renderer_AsyncPresentation", values.async_presentation.GetValue());
+    log_setting("Renderer_UseGpuThread", values.use_gpu_thread.GetValue());
+    log_setting("Renderer_SkipUnchangedUploads", values.skip_unchanged_uploads.GetValue());
+    log_setting("Renderer_TextureMemoryBudget", values.texture_memory_budget.GetValue());
+    log_setting("Renderer_GenerateMipmaps", values.generate_mipmaps.GetValue());
+    log_setting("Renderer_ParallelCommandRecording", values.parallel_command_recording.GetValue());
+    log_setting("Renderer_PresentQueueDepth", values.present_queue_depth.GetValue());
+    log_setting("Renderer_BindlessTextures", values.bindless_textures.GetValue());
     log_setting("Renderer_SpirvShaderGen", values.spirv_shader_gen.GetValue());
     log_setting("Renderer_DisableSpirvOptimizer", values.disable_spirv_optimizer.GetValue());
     log_setting("Renderer_Debug", values.renderer_debug.GetValue());
@@ -106,6 +146,7 @@ void LogSettings() {
                 GetTextureSamplingName(values.texture_sampling.GetValue()));
     log_setting("Renderer_DelayGameRenderThreasUs", values.delay_game_render_thread_us.GetValue());
     log_setting("Renderer_DisableRightEyeRender", values.disable_right_eye_render.GetValue());
+    log_setting("Renderer_DisableRightEyeDraws", values.disable_right_eye_draws.GetValue());
     log_setting("Stereoscopy_Render3d", values.render_3d.GetValue());
     log_setting("Stereoscopy_Factor3d", values.factor_3d.GetValue());
     log_setting("Stereoscopy_MonoRenderOption", values.mono_render_option.GetValue());
@@ -120,10 +161,13 @@ void LogSettings() {
     log_setting("Layout_LargeScreenProportion", values.large_screen_proportion.GetValue());
     log_setting("Layout_SmallScreenPosition", values.small_screen_position.GetValue());
     log_setting("Utility_DumpTextures", values.dump_textures.GetValue());
+    log_setting("Utility_TextureDumpCompression", values.texture_dump_compression.GetValue());
     log_setting("Utility_CustomTextures", values.custom_textures.GetValue());
     log_setting("Utility_PreloadTextures", values.preload_textures.GetValue());
     log_setting("Utility_AsyncCustomLoading", values.async_custom_loading.GetValue());
+    log_setting("Utility_CustomTextureBudget", values.custom_texture_budget.GetValue());
     log_setting("Utility_UseDiskShaderCache", values.use_disk_shader_cache.GetValue());
+    log_setting("Utility_UseSharedShaderCache", values.use_shared_shader_cache.GetValue());
     log_setting("Audio_Emulation", GetAudioEmulationName(values.audio_emulation.GetValue()));
     log_setting("Audio_OutputType", values.output_type.GetValue());
     log_setting("Audio_OutputDevice", values.output_device.GetValue());
@@ -131,6 +175,7 @@ void LogSettings() {
     log_setting("Audio_InputDevice", values.input_device.GetValue());
     log_setting("Audio_EnableAudioStretching", values.enable_audio_stretching.GetValue());
     log_setting("Audio_EnableRealtime", values.enable_realtime_audio.GetValue());
+    log_setting("Audio_ThreadedHLE", values.threaded_audio_hle.GetValue());
     using namespace Service::CAM;
     log_setting("Camera_OuterRightName", values.camera_name[OuterRightCamera]);
     log_setting("Camera_OuterRightConfig", values.camera_config[OuterRightCamera]);
@@ -143,6 +188,8 @@ void LogSettings() {
     log_setting("Camera_OuterLeftFlip", values.camera_flip[OuterLeftCamera]);
     log_setting("DataStorage_UseVirtualSd", values.use_virtual_sd.GetValue());
     log_setting("DataStorage_UseCustomStorage", values.use_custom_storage.GetValue());
+    log_setting("DataStorage_UseArticDiskCache", values.use_artic_disk_cache.GetValue());
+    log_setting("DataStorage_UseArticCompression", values.use_artic_compression.GetValue());
     if (values.use_custom_storage) {
         log_setting("DataStorage_SdmcDir", FileUtil::GetUserPath(FileUtil::UserPath::SDMCDir));
         log_setting("DataStorage_NandDir", FileUtil::GetUserPath(FileUtil::UserPath::NANDDir));
@@ -189,6 +236,7 @@ void RestoreGlobalState(bool is_powered_on) {
     values.cpu_clock_percentage.SetGlobal(true);
     values.is_new_3ds.SetGlobal(true);
     values.lle_applets.SetGlobal(true);
+    values.fs_delay_mode.SetGlobal(true);
 
     // Renderer
     values.graphics_api.SetGlobal(true);
@@ -224,6 +272,7 @@ void RestoreGlobalState(bool is_powered_on) {
     values.custom_textures.SetGlobal(true);
     values.preload_textures.SetGlobal(true);
     values.disable_right_eye_render.SetGlobal(true);
+    values.disable_right_eye_draws.SetGlobal(true);
 }
 
 void LoadProfile(int index) {
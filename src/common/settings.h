@@ -106,6 +106,12 @@ enum class TextureSampling : u32 {
     Linear = 2,
 };
 
+enum class FSDelayMode : u32 {
+    Hardware = 0,
+    Table = 1,
+    Instant = 2,
+};
+
 enum class AspectRatio : u32 {
     Default = 0,
     R16_9 = 1,
@@ -453,12 +459,31 @@ struct Values {
     std::vector<InputProfile> input_profiles; ///< The list of input profiles
     std::vector<TouchFromButtonMap> touch_from_button_maps;
     Setting<bool> use_artic_base_controller{false, "use_artic_base_controller"};
+    Setting<bool> input_late_latch{false, "input_late_latch"};
 
     SwitchableSetting<bool> enable_gamemode{true, "enable_gamemode"};
 
     // Core
     Setting<bool> use_cpu_jit{true, "use_cpu_jit"};
     SwitchableSetting<s32, true> cpu_clock_percentage{100, 5, 400, "cpu_clock_percentage"};
+    Setting<bool> parallel_cpu_cores{false, "parallel_cpu_cores"};
+    Setting<bool> skip_idle_loops{false, "skip_idle_loops"};
+    Setting<bool> use_tick_profiles{true, "use_tick_profiles"};
+    Setting<bool> calibrate_tick_profiles{false, "calibrate_tick_profiles"};
+    Setting<bool> adaptive_slice_length{false, "adaptive_slice_length"};
+    Setting<bool> use_huge_pages{false, "use_huge_pages"};
+    Setting<u32> romfs_cache_size{8, "romfs_cache_size"};
+    Setting<bool> save_data_write_back{false, "save_data_write_back"};
+    SwitchableSetting<FSDelayMode> fs_delay_mode{FSDelayMode::Hardware, "fs_delay_mode"};
+    Setting<std::string> fs_delay_table{"", "fs_delay_table"};
+    Setting<bool> enable_rewind{false, "enable_rewind"};
+    Setting<u32> rewind_interval{30, "rewind_interval"};
+    Setting<u32> rewind_buffer_size{256, "rewind_buffer_size"};
+    Setting<bool> prewarm_savestate_surfaces{true, "prewarm_savestate_surfaces"};
+    Setting<bool> incremental_savestates{false, "incremental_savestates"};
+    Setting<bool> movie_turbo_playback{false, "movie_turbo_playback"};
+    Setting<u32> movie_checkpoint_interval{0, "movie_checkpoint_interval"};
+    Setting<bool> reset_to_boot_snapshot{false, "reset_to_boot_snapshot"};
     SwitchableSetting<bool> is_new_3ds{true, "is_new_3ds"};
     SwitchableSetting<bool> lle_applets{true, "lle_applets"};
     SwitchableSetting<bool> deterministic_async_operations{false, "deterministic_async_operations"};
@@ -468,6 +493,8 @@ struct Values {
     // Data Storage
     Setting<bool> use_virtual_sd{true, "use_virtual_sd"};
     Setting<bool> use_custom_storage{false, "use_custom_storage"};
+    Setting<bool> use_artic_disk_cache{false, "use_artic_disk_cache"};
+    Setting<bool> use_artic_compression{false, "use_artic_compression"};
 
     // System
     SwitchableSetting<s32> region_value{REGION_VALUE_AUTO_SELECT, "region_value"};
@@ -500,9 +527,20 @@ struct Values {
     SwitchableSetting<bool> spirv_shader_gen{true, "spirv_shader_gen"};
     SwitchableSetting<bool> disable_spirv_optimizer{true, "disable_spirv_optimizer"};
     SwitchableSetting<bool> async_shader_compilation{false, "async_shader_compilation"};
+    Setting<bool> use_uber_shaders{true, "use_uber_shaders"};
     SwitchableSetting<bool> async_presentation{true, "async_presentation"};
+    // Not read from the frontend configs: the rasterizer cache marks pages as cached from the GPU
+    // thread, racing the page table accesses of the CPU.
+    Setting<bool> use_gpu_thread{false, "use_gpu_thread"};
+    Setting<bool> skip_unchanged_uploads{false, "skip_unchanged_uploads"};
+    Setting<u32> texture_memory_budget{0, "texture_memory_budget"};
+    Setting<bool> generate_mipmaps{false, "generate_mipmaps"};
+    Setting<bool> parallel_command_recording{false, "parallel_command_recording"};
+    Setting<u32, true> present_queue_depth{1, 1, 3, "present_queue_depth"};
+    Setting<bool> bindless_textures{false, "bindless_textures"};
     SwitchableSetting<bool> use_hw_shader{true, "use_hw_shader"};
     SwitchableSetting<bool> use_disk_shader_cache{true, "use_disk_shader_cache"};
+    Setting<bool> use_shared_shader_cache{false, "use_shared_shader_cache"};
     SwitchableSetting<bool> shaders_accurate_mul{true, "shaders_accurate_mul"};
     SwitchableSetting<bool> use_vsync_new{true, "use_vsync_new"};
     Setting<bool> use_shader_jit{true, "use_shader_jit"};
@@ -569,16 +607,20 @@ struct Values {
     SwitchableSetting<std::string> anaglyph_shader_name{"dubois (builtin)", "anaglyph_shader_name"};
 
     SwitchableSetting<bool> dump_textures{false, "dump_textures"};
+    Setting<u32, true> texture_dump_compression{4, 0, 9, "texture_dump_compression"};
     SwitchableSetting<bool> custom_textures{false, "custom_textures"};
     SwitchableSetting<bool> preload_textures{false, "preload_textures"};
     SwitchableSetting<bool> async_custom_loading{true, "async_custom_loading"};
+    Setting<u32> custom_texture_budget{0, "custom_texture_budget"};
     SwitchableSetting<bool> disable_right_eye_render{false, "disable_right_eye_render"};
+    SwitchableSetting<bool> disable_right_eye_draws{false, "disable_right_eye_draws"};
 
     // Audio
     bool audio_muted;
     SwitchableSetting<AudioEmulation> audio_emulation{AudioEmulation::HLE, "audio_emulation"};
     SwitchableSetting<bool> enable_audio_stretching{true, "enable_audio_stretching"};
     SwitchableSetting<bool> enable_realtime_audio{false, "enable_realtime_audio"};
+    Setting<bool> threaded_audio_hle{false, "threaded_audio_hle"};
     SwitchableSetting<float, true> volume{1.f, 0.f, 1.f, "volume"};
     Setting<AudioCore::SinkType> output_type{AudioCore::SinkType::Auto, "output_type"};
     Setting<std::string> output_device{"auto", "output_device"};
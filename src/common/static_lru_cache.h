@@ -92,6 +92,12 @@ public:
         m_list.clear();
     }
 
+    // Removes all the elements and resets their values, releasing the memory they hold.
+    void reset() {
+        m_list.clear();
+        m_array.fill(value_type{});
+    }
+
 private:
     typename list_type::const_iterator find(const key_type& key) const {
         return std::find_if(m_list.cbegin(), m_list.cend(),
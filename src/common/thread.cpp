@@ -12,6 +12,9 @@
 #elif defined(_WIN32)
 #include <windows.h>
 #include "common/string_util.h"
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 #else
 #if defined(__Bitrig__) || defined(__DragonFly__) || defined(__FreeBSD__) || defined(__OpenBSD__)
 #include <pthread_np.h>
@@ -120,4 +123,41 @@ void SetCurrentThreadName(const char*) {
 
 #endif
 
+void PreciseSleep(std::chrono::nanoseconds duration) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + duration;
+
+#ifdef _WIN32
+    // High resolution waitable timers wake up within half a millisecond, plain sleeps only after
+    // the next tick of the system timer.
+    static thread_local const HANDLE timer = CreateWaitableTimerExW(
+        nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    const auto spin_threshold = std::chrono::microseconds{timer ? 500 : 2000};
+    for (auto remaining = deadline - Clock::now(); remaining > spin_threshold;
+         remaining = deadline - Clock::now()) {
+        const auto sleep_time = remaining - spin_threshold;
+        if (!timer) {
+            std::this_thread::sleep_for(sleep_time);
+            continue;
+        }
+        // Negative due times are relative, in 100 nanosecond units.
+        LARGE_INTEGER due_time;
+        due_time.QuadPart = -static_cast<LONGLONG>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_time).count() / 100);
+        SetWaitableTimerEx(timer, &due_time, 0, nullptr, nullptr, nullptr, 0);
+        WaitForSingleObject(timer, INFINITE);
+    }
+#else
+    constexpr auto spin_threshold = std::chrono::milliseconds{1};
+    for (auto remaining = deadline - Clock::now(); remaining > spin_threshold;
+         remaining = deadline - Clock::now()) {
+        std::this_thread::sleep_for(remaining - spin_threshold);
+    }
+#endif
+
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
 } // namespace Common
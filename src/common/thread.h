@@ -112,4 +112,10 @@ void SetCurrentThreadPriority(ThreadPriority new_priority);
 
 void SetCurrentThreadName(const char* name);
 
+/**
+ * Sleeps for the duration with sub-millisecond precision. The OS sleep covers most of it and
+ * the last stretch is spun on, as OS sleeps can overshoot by a scheduler tick.
+ */
+void PreciseSleep(std::chrono::nanoseconds duration);
+
 } // namespace Common
@@ -6,7 +6,9 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <deque>
+#include <vector>
 #include <boost/serialization/deque.hpp>
 #include <boost/serialization/split_member.hpp>
 #include "common/common_types.h"
@@ -15,24 +17,17 @@ namespace Common {
 
 template <class T, unsigned int N>
 struct ThreadQueueList {
-    // TODO(yuriks): If performance proves to be a problem, the std::deques can be replaced with
-    //               (dynamically resizable) circular buffers to remove their overhead when
-    //               inserting and popping.
+    static_assert(N <= 64, "Priority levels are tracked in a 64-bit mask");
 
     using Priority = unsigned int;
 
     // Number of priority levels. (Valid levels are [0..NUM_QUEUES).)
     static constexpr Priority NUM_QUEUES = N;
 
-    ThreadQueueList() {
-        first = nullptr;
-    }
-
     // Only for debugging, returns priority level.
     [[nodiscard]] Priority contains(const T& uid) const {
         for (Priority i = 0; i < NUM_QUEUES; ++i) {
-            const Queue& cur = queues[i];
-            if (std::find(cur.data.cbegin(), cur.data.cend(), uid) != cur.data.cend()) {
+            if (queues[i].contains(uid)) {
                 return i;
             }
         }
@@ -41,167 +36,213 @@ struct ThreadQueueList {
     }
 
     [[nodiscard]] T get_first() const {
-        const Queue* cur = first;
-        while (cur != nullptr) {
-            if (!cur->data.empty()) {
-                return cur->data.front();
-            }
-            cur = cur->next_nonempty;
+        if (nonempty_mask == 0) {
+            return T();
         }
-
-        return T();
+        return queues[std::countr_zero(nonempty_mask)].front();
     }
 
     T pop_first() {
-        Queue* cur = first;
-        while (cur != nullptr) {
-            if (!cur->data.empty()) {
-                auto tmp = std::move(cur->data.front());
-                cur->data.pop_front();
-                return tmp;
-            }
-            cur = cur->next_nonempty;
+        if (nonempty_mask == 0) {
+            return T();
         }
-
-        return T();
+        return pop_front(static_cast<Priority>(std::countr_zero(nonempty_mask)));
     }
 
     T pop_first_better(Priority priority) {
-        Queue* cur = first;
-        Queue* stop = &queues[priority];
-        while (cur < stop) {
-            if (!cur->data.empty()) {
-                auto tmp = std::move(cur->data.front());
-                cur->data.pop_front();
-                return tmp;
-            }
-            cur = cur->next_nonempty;
+        const u64 better_mask = nonempty_mask & ((u64{1} << priority) - 1);
+        if (better_mask == 0) {
+            return T();
         }
-
-        return T();
+        return pop_front(static_cast<Priority>(std::countr_zero(better_mask)));
     }
 
     void push_front(Priority priority, const T& thread_id) {
-        Queue* cur = &queues[priority];
-        cur->data.push_front(thread_id);
+        queues[priority].push_front(thread_id);
+        nonempty_mask |= u64{1} << priority;
     }
 
     void push_back(Priority priority, const T& thread_id) {
-        Queue* cur = &queues[priority];
-        cur->data.push_back(thread_id);
+        queues[priority].push_back(thread_id);
+        nonempty_mask |= u64{1} << priority;
     }
 
     void move(const T& thread_id, Priority old_priority, Priority new_priority) {
         remove(old_priority, thread_id);
-        prepare(new_priority);
         push_back(new_priority, thread_id);
     }
 
     void remove(Priority priority, const T& thread_id) {
-        Queue* const cur = &queues[priority];
-        const auto iter = std::remove(cur->data.begin(), cur->data.end(), thread_id);
-        cur->data.erase(iter, cur->data.end());
+        Queue& cur = queues[priority];
+        cur.remove(thread_id);
+        if (cur.empty()) {
+            nonempty_mask &= ~(u64{1} << priority);
+        }
     }
 
     void rotate(Priority priority) {
-        Queue* cur = &queues[priority];
-
-        if (cur->data.size() > 1) {
-            cur->data.push_back(std::move(cur->data.front()));
-            cur->data.pop_front();
-        }
+        queues[priority].rotate();
     }
 
     void clear() {
-        queues.fill(Queue());
-        first = nullptr;
+        for (Queue& queue : queues) {
+            queue.clear();
+        }
+        nonempty_mask = 0;
     }
 
     [[nodiscard]] bool empty(Priority priority) const {
-        const Queue* cur = &queues[priority];
-        return cur->data.empty();
-    }
-
-    void prepare(Priority priority) {
-        Queue* cur = &queues[priority];
-        if (cur->next_nonempty == UnlinkedTag())
-            link(priority);
+        return (nonempty_mask & (u64{1} << priority)) == 0;
     }
 
 private:
-    struct Queue {
-        // Points to the next active priority, skipping over ones that have never been used.
-        Queue* next_nonempty = UnlinkedTag();
-        // Double-ended queue of threads in this priority level
-        std::deque<T> data;
-    };
+    /**
+     * Ring buffer of the threads in one priority level. Its storage only grows, so once the
+     * scheduler has warmed up pushing and popping never allocates.
+     */
+    class Queue {
+    public:
+        [[nodiscard]] bool empty() const {
+            return count == 0;
+        }
 
-    /// Special tag used to mark priority levels that have never been used.
-    static Queue* UnlinkedTag() {
-        return reinterpret_cast<Queue*>(1);
-    }
+        [[nodiscard]] std::size_t size() const {
+            return count;
+        }
 
-    void link(Priority priority) {
-        Queue* cur = &queues[priority];
+        [[nodiscard]] const T& front() const {
+            return buffer[head];
+        }
+
+        [[nodiscard]] const T& at(std::size_t index) const {
+            return buffer[(head + index) & (buffer.size() - 1)];
+        }
+
+        [[nodiscard]] bool contains(const T& value) const {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (at(i) == value) {
+                    return true;
+                }
+            }
+            return false;
+        }
 
-        for (int i = priority - 1; i >= 0; --i) {
-            if (queues[i].next_nonempty != UnlinkedTag()) {
-                cur->next_nonempty = queues[i].next_nonempty;
-                queues[i].next_nonempty = cur;
+        void push_back(const T& value) {
+            Reserve(count + 1);
+            buffer[(head + count) & (buffer.size() - 1)] = value;
+            ++count;
+        }
+
+        void push_front(const T& value) {
+            Reserve(count + 1);
+            head = (head - 1) & (buffer.size() - 1);
+            buffer[head] = value;
+            ++count;
+        }
+
+        T pop_front() {
+            T value = std::move(buffer[head]);
+            head = (head + 1) & (buffer.size() - 1);
+            --count;
+            return value;
+        }
+
+        /// Removes every occurrence of the value while keeping the order of the others.
+        void remove(const T& value) {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const T& current = at(i);
+                if (current != value) {
+                    buffer[(head + kept) & (buffer.size() - 1)] = current;
+                    ++kept;
+                }
+            }
+            count = kept;
+        }
+
+        void rotate() {
+            if (count > 1) {
+                push_back(pop_front());
+            }
+        }
+
+        void clear() {
+            head = 0;
+            count = 0;
+        }
+
+    private:
+        void Reserve(std::size_t new_count) {
+            if (new_count <= buffer.size()) {
                 return;
             }
+            std::vector<T> new_buffer(std::max<std::size_t>(8, buffer.size() * 2));
+            for (std::size_t i = 0; i < count; ++i) {
+                new_buffer[i] = at(i);
+            }
+            buffer = std::move(new_buffer);
+            head = 0;
         }
 
-        cur->next_nonempty = first;
-        first = cur;
+        std::vector<T> buffer;
+        std::size_t head = 0;
+        std::size_t count = 0;
+    };
+
+    T pop_front(Priority priority) {
+        Queue& cur = queues[priority];
+        T value = cur.pop_front();
+        if (cur.empty()) {
+            nonempty_mask &= ~(u64{1} << priority);
+        }
+        return value;
     }
 
-    // The first queue that's ever been used.
-    Queue* first;
+    // Bit i is set when the queue of priority level i holds at least one thread.
+    u64 nonempty_mask = 0;
     // The priority level queues of thread ids.
     std::array<Queue, NUM_QUEUES> queues;
 
-    s64 ToIndex(const Queue* q) const {
-        if (q == nullptr) {
-            return -2;
-        } else if (q == UnlinkedTag()) {
-            return -1;
-        } else {
-            return q - queues.data();
-        }
-    }
+    // The archive layout predates the bitmap: it stores the index of the first used level and, per
+    // level, the next used level followed by its threads. Used levels are written as a chain of the
+    // non-empty ones, and the links are ignored when loading.
+    static constexpr s64 NullIndex = -2;
+    static constexpr s64 UnlinkedIndex = -1;
 
-    Queue* ToPointer(s64 idx) {
-        if (idx == -1) {
-            return UnlinkedTag();
-        } else if (idx < 0) {
-            return nullptr;
-        } else {
-            return &queues[idx];
-        }
+    s64 NextNonEmpty(s64 priority) const {
+        const u64 later_mask = priority + 1 >= 64 ? 0 : nonempty_mask >> (priority + 1);
+        return later_mask == 0 ? NullIndex : priority + 1 + std::countr_zero(later_mask);
     }
 
     friend class boost::serialization::access;
     template <class Archive>
     void save(Archive& ar, const unsigned int file_version) const {
-        const s64 idx = ToIndex(first);
+        const s64 idx = NextNonEmpty(-1);
         ar << idx;
         for (std::size_t i = 0; i < NUM_QUEUES; i++) {
-            const s64 idx1 = ToIndex(queues[i].next_nonempty);
+            const Queue& cur = queues[i];
+            const s64 idx1 = cur.empty() ? UnlinkedIndex : NextNonEmpty(static_cast<s64>(i));
             ar << idx1;
-            ar << queues[i].data;
+            std::deque<T> data;
+            for (std::size_t j = 0; j < cur.size(); ++j) {
+                data.push_back(cur.at(j));
+            }
+            ar << data;
         }
     }
 
     template <class Archive>
     void load(Archive& ar, const unsigned int file_version) {
+        clear();
         s64 idx;
         ar >> idx;
-        first = ToPointer(idx);
         for (std::size_t i = 0; i < NUM_QUEUES; i++) {
             ar >> idx;
-            queues[i].next_nonempty = ToPointer(idx);
-            ar >> queues[i].data;
+            std::deque<T> data;
+            ar >> data;
+            for (const T& thread_id : data) {
+                push_back(static_cast<Priority>(i), thread_id);
+            }
         }
     }
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -14,12 +16,23 @@
 #include <vector>
 #include <queue>
 
+#include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/thread.h"
 #include "common/unique_function.h"
 
 namespace Common {
 
+/// Order in which queued work is picked up by the workers, first in first out within a priority.
+enum class WorkPriority : u8 {
+    /// Work something is waiting on right now, such as a texture needed by the current frame.
+    High,
+    Normal,
+    /// Work nothing waits on, such as writing dumps to disk.
+    Background,
+    Count,
+};
+
 template <class StateType = void>
 class StatefulThreadWorker {
     static constexpr bool with_state = !std::is_same_v<StateType, void>;
@@ -47,16 +60,19 @@ public:
                     Task task;
                     {
                         std::unique_lock lock{queue_mutex};
-                        if (requests.empty()) {
+                        if (num_requests == 0) {
                             wait_condition.notify_all();
                         }
                         Common::CondvarWait(condition, lock, stop_token,
-                                            [this] { return !requests.empty(); });
+                                            [this] { return num_requests != 0; });
                         if (stop_token.stop_requested()) {
                             break;
                         }
-                        task = std::move(requests.front());
-                        requests.pop();
+                        auto& queue = *std::find_if(requests.begin(), requests.end(),
+                                                    [](const auto& q) { return !q.empty(); });
+                        task = std::move(queue.front());
+                        queue.pop();
+                        --num_requests;
                     }
                     if constexpr (with_state) {
                         task(&state);
@@ -81,10 +97,11 @@ public:
     StatefulThreadWorker& operator=(StatefulThreadWorker&&) = delete;
     StatefulThreadWorker(StatefulThreadWorker&&) = delete;
 
-    void QueueWork(Task work) {
+    void QueueWork(Task work, WorkPriority priority = WorkPriority::Normal) {
         {
             std::unique_lock lock{queue_mutex};
-            requests.emplace(std::move(work));
+            requests[static_cast<std::size_t>(priority)].emplace(std::move(work));
+            ++num_requests;
             ++work_scheduled;
         }
         condition.notify_one();
@@ -107,7 +124,8 @@ public:
     }
 
 private:
-    std::queue<Task> requests;
+    std::array<std::queue<Task>, static_cast<std::size_t>(WorkPriority::Count)> requests;
+    std::size_t num_requests{};
     std::mutex queue_mutex;
     std::condition_variable_any condition;
     std::condition_variable wait_condition;
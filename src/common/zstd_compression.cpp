@@ -3,8 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <memory>
 #include <zstd.h>
 
+#include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/zstd_compression.h"
 
@@ -70,4 +72,101 @@ std::vector<u8> DecompressDataZSTD(std::span<const u8> compressed) {
     return decompressed;
 }
 
+bool CompressDataZSTDToFile(std::span<const u8> source, FileUtil::IOFile& file, u32 num_workers) {
+    const std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ZSTD_createCCtx(),
+                                                                        ZSTD_freeCCtx};
+    if (!context) {
+        LOG_ERROR(Common, "Could not create ZSTD compression context");
+        return false;
+    }
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+    // Pledging the size keeps it in the frame header, so decompression can size its output.
+    ZSTD_CCtx_setPledgedSrcSize(context.get(), source.size());
+    if (num_workers > 0) {
+        const std::size_t result =
+            ZSTD_CCtx_setParameter(context.get(), ZSTD_c_nbWorkers, static_cast<int>(num_workers));
+        if (ZSTD_isError(result)) {
+            LOG_WARNING(Common, "ZSTD multithreading is unavailable, compressing on one thread: {}",
+                        ZSTD_getErrorName(result));
+        }
+    }
+
+    std::vector<u8> chunk(ZSTD_CStreamOutSize());
+    ZSTD_inBuffer input{source.data(), source.size(), 0};
+    std::size_t remaining;
+    do {
+        ZSTD_outBuffer output{chunk.data(), chunk.size(), 0};
+        remaining = ZSTD_compressStream2(context.get(), &output, &input, ZSTD_e_end);
+        if (ZSTD_isError(remaining)) {
+            LOG_ERROR(Common, "Error compressing ZSTD data: {} ({})", ZSTD_getErrorName(remaining),
+                      remaining);
+            return false;
+        }
+        if (file.WriteBytes(chunk.data(), output.pos) != output.pos) {
+            LOG_ERROR(Common, "Could not write ZSTD data to file");
+            return false;
+        }
+    } while (remaining != 0);
+    return true;
+}
+
+std::vector<u8> DecompressDataZSTDFromFile(FileUtil::IOFile& file) {
+    const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(),
+                                                                        ZSTD_freeDCtx};
+    if (!context) {
+        LOG_ERROR(Common, "Could not create ZSTD decompression context");
+        return {};
+    }
+
+    std::vector<u8> chunk(ZSTD_DStreamInSize());
+    std::vector<u8> decompressed;
+    std::size_t written = 0;
+    bool first_chunk = true;
+    bool known_size = false;
+    bool output_full = false;
+    ZSTD_inBuffer input{chunk.data(), 0, 0};
+    std::size_t remaining;
+    do {
+        // Data the decoder could not flush into a full output is drained before reading more.
+        if (input.pos == input.size && !output_full) {
+            input.size = file.ReadBytes(chunk.data(), chunk.size());
+            input.pos = 0;
+            if (input.size == 0) {
+                LOG_ERROR(Common, "ZSTD data ended before the end of its frame");
+                return {};
+            }
+            if (first_chunk) {
+                first_chunk = false;
+                const std::size_t content_size =
+                    ZSTD_getFrameContentSize(chunk.data(), input.size);
+                if (content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+                    content_size != ZSTD_CONTENTSIZE_ERROR) {
+                    decompressed.resize(content_size);
+                    known_size = true;
+                }
+            }
+        }
+        if (written == decompressed.size()) {
+            // Past a known size only the end of the frame is left, which needs little room.
+            const std::size_t growth = known_size
+                                           ? ZSTD_DStreamOutSize()
+                                           : std::max(decompressed.size(), ZSTD_DStreamOutSize());
+            decompressed.resize(decompressed.size() + growth);
+        }
+
+        ZSTD_outBuffer output{decompressed.data() + written, decompressed.size() - written, 0};
+        remaining = ZSTD_decompressStream(context.get(), &output, &input);
+        if (ZSTD_isError(remaining)) {
+            LOG_ERROR(Common, "Error decompressing ZSTD data: {} ({})",
+                      ZSTD_getErrorName(remaining), remaining);
+            return {};
+        }
+        written += output.pos;
+        output_full = output.pos == output.size;
+    } while (remaining != 0);
+
+    decompressed.resize(written);
+    return decompressed;
+}
+
 } // namespace Common::Compression
@@ -9,6 +9,10 @@
 
 #include "common/common_types.h"
 
+namespace FileUtil {
+class IOFile;
+}
+
 namespace Common::Compression {
 
 /**
@@ -40,4 +44,28 @@ namespace Common::Compression {
  */
 [[nodiscard]] std::vector<u8> DecompressDataZSTD(std::span<const u8> compressed);
 
+/**
+ * Compresses a source memory region with Zstandard with the default compression level and streams
+ * the compressed data to the current position of a file, so that it is never held in memory as a
+ * whole.
+ *
+ * @param source the uncompressed source memory region.
+ * @param file the file to write the compressed data to.
+ * @param num_workers the number of threads zstd compresses on, 0 compresses on the calling thread.
+ *
+ * @return true if all the compressed data was written.
+ */
+[[nodiscard]] bool CompressDataZSTDToFile(std::span<const u8> source, FileUtil::IOFile& file,
+                                          u32 num_workers);
+
+/**
+ * Decompresses a Zstandard frame read in chunks from the current position of a file and returns
+ * the uncompressed data in a vector.
+ *
+ * @param file the file to read the compressed data from, up to the end of the frame.
+ *
+ * @return the decompressed data, empty on failure.
+ */
+[[nodiscard]] std::vector<u8> DecompressDataZSTDFromFile(FileUtil::IOFile& file);
+
 } // namespace Common::Compression
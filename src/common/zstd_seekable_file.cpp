@@ -0,0 +1,231 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <zstd.h>
+#include "common/archives.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "common/zstd_seekable_file.h"
+
+SERIALIZE_EXPORT_IMPL(Common::Compression::SeekableZstdIOFile)
+
+namespace Common::Compression {
+
+bool IsSeekableZstdFile(FileUtil::IOFile& file) {
+    u32_le magic{};
+    return file.ReadAtBytes(&magic, sizeof(magic), 0) == sizeof(magic) &&
+           magic == SeekableZstdMagic;
+}
+
+bool CompressSeekableZstdFile(FileUtil::IOFile& source, FileUtil::IOFile& destination,
+                              u32 frame_size, s32 compression_level) {
+    if (frame_size == 0) {
+        return false;
+    }
+    const u64 size = source.GetSize();
+    const u64 frame_count = (size + frame_size - 1) / frame_size;
+    if (frame_count > std::numeric_limits<u32>::max()) {
+        LOG_ERROR(Common, "File is too big for {} byte frames", frame_size);
+        return false;
+    }
+
+    SeekableZstdHeader header{};
+    header.magic = SeekableZstdMagic;
+    header.version = SeekableZstdVersion;
+    header.frame_size = frame_size;
+    header.frame_count = static_cast<u32>(frame_count);
+    header.uncompressed_size = size;
+
+    // The header is written again once the location of the index is known.
+    if (!source.Seek(0, SEEK_SET) || !destination.Seek(0, SEEK_SET) ||
+        destination.WriteObject(header) != 1) {
+        return false;
+    }
+
+    std::vector<u64_le> index;
+    index.reserve(frame_count + 1);
+    std::vector<u8> frame(frame_size);
+    u64 offset = sizeof(header);
+    for (u64 i = 0; i < frame_count; ++i) {
+        const std::size_t length =
+            static_cast<std::size_t>(std::min<u64>(frame_size, size - i * frame_size));
+        if (source.ReadBytes(frame.data(), length) != length) {
+            LOG_ERROR(Common, "Could not read frame {} of {}", i, source.Filename());
+            return false;
+        }
+        const std::vector<u8> compressed =
+            CompressDataZSTD(std::span{frame.data(), length}, compression_level);
+        if (compressed.empty() ||
+            destination.WriteBytes(compressed.data(), compressed.size()) != compressed.size()) {
+            return false;
+        }
+        index.push_back(offset);
+        offset += compressed.size();
+    }
+    index.push_back(offset);
+
+    header.index_offset = offset;
+    return destination.WriteArray(index.data(), index.size()) == index.size() &&
+           destination.Seek(0, SEEK_SET) && destination.WriteObject(header) == 1 &&
+           destination.Flush();
+}
+
+namespace {
+
+std::size_t NumReadAheadWorkers() {
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+}
+
+} // Anonymous namespace
+
+SeekableZstdIOFile::SeekableZstdIOFile()
+    : cache(cache_capacity, read_ahead_frames, NumReadAheadWorkers(), "ZstdReadAhead",
+            [this](std::size_t frame) { return DecompressFrame(frame); }) {}
+
+SeekableZstdIOFile::SeekableZstdIOFile(const std::string& filename)
+    : IOFile(filename, "rb"),
+      cache(cache_capacity, read_ahead_frames, NumReadAheadWorkers(), "ZstdReadAhead",
+            [this](std::size_t frame) { return DecompressFrame(frame); }) {
+    LoadIndex();
+}
+
+SeekableZstdIOFile::~SeekableZstdIOFile() = default;
+
+void SeekableZstdIOFile::LoadIndex() {
+    frame_size = 0;
+    uncompressed_size = 0;
+    frame_offsets.clear();
+    cache.SetNumBlocks(0);
+
+    SeekableZstdHeader header{};
+    if (IOFile::ReadAtImpl(&header, 1, sizeof(header), 0) != sizeof(header) ||
+        header.magic != SeekableZstdMagic) {
+        LOG_ERROR(Common, "{} is not a seekable zstd image", Filename());
+        return;
+    }
+    if (header.version != SeekableZstdVersion || header.frame_size == 0 ||
+        (header.uncompressed_size + header.frame_size - 1) / header.frame_size !=
+            header.frame_count) {
+        LOG_ERROR(Common, "{} has an unsupported seekable zstd header", Filename());
+        return;
+    }
+
+    std::vector<u64_le> index(static_cast<std::size_t>(header.frame_count) + 1);
+    const std::size_t index_size = index.size() * sizeof(u64_le);
+    if (IOFile::ReadAtImpl(index.data(), index.size(), sizeof(u64_le), header.index_offset) !=
+        index_size) {
+        LOG_ERROR(Common, "Could not read the frame index of {}", Filename());
+        return;
+    }
+    if (index.front() != sizeof(header) || index.back() != header.index_offset ||
+        !std::is_sorted(index.begin(), index.end())) {
+        LOG_ERROR(Common, "{} has a corrupted frame index", Filename());
+        return;
+    }
+
+    frame_offsets.assign(index.begin(), index.end());
+    uncompressed_size = header.uncompressed_size;
+    frame_size = header.frame_size;
+    cache.SetNumBlocks(static_cast<std::size_t>(header.frame_count));
+}
+
+std::size_t SeekableZstdIOFile::ReadImpl(void* data, std::size_t length, std::size_t data_size) {
+    const std::size_t items_read = ReadAtImpl(data, length, data_size, position);
+    if (items_read != std::numeric_limits<std::size_t>::max()) {
+        position += items_read * data_size;
+    }
+    return items_read;
+}
+
+std::size_t SeekableZstdIOFile::ReadAtImpl(void* data, std::size_t length, std::size_t data_size,
+                                           std::size_t offset) {
+    if (!IsValid()) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    if (length == 0 || offset >= uncompressed_size) {
+        return 0;
+    }
+
+    auto* buffer = static_cast<u8*>(data);
+    const std::size_t total =
+        static_cast<std::size_t>(std::min<u64>(length * data_size, uncompressed_size - offset));
+    std::size_t read_progress = 0;
+    while (read_progress < total) {
+        const u64 current = offset + read_progress;
+        const std::size_t frame = static_cast<std::size_t>(current / frame_size);
+        const std::size_t into = static_cast<std::size_t>(current % frame_size);
+        const std::size_t copy_amount =
+            std::min<std::size_t>(total - read_progress, frame_size - into);
+        if (cache.Read(frame, into, copy_amount, buffer + read_progress) != copy_amount) {
+            break;
+        }
+        read_progress += copy_amount;
+    }
+    return read_progress / data_size;
+}
+
+std::size_t SeekableZstdIOFile::WriteImpl(const void* data, std::size_t length,
+                                          std::size_t data_size) {
+    LOG_ERROR(Common, "Seekable zstd images are read-only");
+    return 0;
+}
+
+bool SeekableZstdIOFile::SeekImpl(s64 off, int origin) {
+    s64 base;
+    switch (origin) {
+    case SEEK_SET:
+        base = 0;
+        break;
+    case SEEK_CUR:
+        base = static_cast<s64>(position);
+        break;
+    case SEEK_END:
+        base = static_cast<s64>(uncompressed_size);
+        break;
+    default:
+        return false;
+    }
+    if (base + off < 0) {
+        return false;
+    }
+    position = static_cast<u64>(base + off);
+    return true;
+}
+
+std::vector<u8> SeekableZstdIOFile::DecompressFrame(std::size_t frame) {
+    const u64 compressed_offset = frame_offsets[frame];
+    const std::size_t compressed_size =
+        static_cast<std::size_t>(frame_offsets[frame + 1] - compressed_offset);
+    std::vector<u8> compressed(compressed_size);
+    if (IOFile::ReadAtImpl(compressed.data(), compressed.size(), 1,
+                           static_cast<std::size_t>(compressed_offset)) != compressed_size) {
+        LOG_ERROR(Common, "Could not read frame {} of {}", frame, Filename());
+        return {};
+    }
+
+    std::vector<u8> data(static_cast<std::size_t>(
+        std::min<u64>(frame_size, uncompressed_size - static_cast<u64>(frame) * frame_size)));
+    const std::size_t result =
+        ZSTD_decompress(data.data(), data.size(), compressed.data(), compressed.size());
+    if (ZSTD_isError(result) || result != data.size()) {
+        LOG_ERROR(Common, "Could not decompress frame {} of {}: {}", frame, Filename(),
+                  ZSTD_isError(result) ? ZSTD_getErrorName(result) : "size mismatch");
+        return {};
+    }
+    return data;
+}
+
+std::unique_ptr<FileUtil::IOFile> OpenImageFile(const std::string& filename) {
+    auto file = std::make_unique<FileUtil::IOFile>(filename, "rb");
+    if (!file->IsOpen() || !IsSeekableZstdFile(*file)) {
+        return file;
+    }
+    // Even if the image is corrupted, its raw contents are of no use to the caller.
+    return std::make_unique<SeekableZstdIOFile>(filename);
+}
+
+} // namespace Common::Compression
@@ -0,0 +1,127 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/export.hpp>
+#include "common/block_cache.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/swap.h"
+
+namespace Common::Compression {
+
+/**
+ * Seekable zstd images store a file as independently compressed frames of frame_size bytes, each
+ * a complete zstd frame, followed by an index of frame_count + 1 little endian u64 offsets. Frame
+ * i spans [index[i], index[i + 1]) and the last entry points to the index itself. Any part of the
+ * image can be read by decompressing only the frames it covers.
+ */
+struct SeekableZstdHeader {
+    u32_le magic;
+    u32_le version;
+    u32_le frame_size;
+    u32_le frame_count;
+    u64_le uncompressed_size;
+    u64_le index_offset;
+};
+static_assert(sizeof(SeekableZstdHeader) == 0x20, "SeekableZstdHeader has incorrect size");
+
+constexpr u32 SeekableZstdMagic = 0x4B53335A; // "Z3SK"
+constexpr u32 SeekableZstdVersion = 1;
+constexpr u32 DefaultSeekableZstdFrameSize = 256 * 1024;
+
+/// Returns whether the file on disk is a seekable zstd image.
+[[nodiscard]] bool IsSeekableZstdFile(FileUtil::IOFile& file);
+
+/**
+ * Writes the whole source file to destination as a seekable zstd image.
+ *
+ * @param frame_size the uncompressed size of each frame. Smaller frames make random reads
+ * cheaper at the cost of a worse compression ratio.
+ * @param compression_level the used compression level. Should be between 1 and 22.
+ *
+ * @return true if the image was written successfully.
+ */
+bool CompressSeekableZstdFile(FileUtil::IOFile& source, FileUtil::IOFile& destination,
+                              u32 frame_size = DefaultSeekableZstdFrameSize,
+                              s32 compression_level = 3);
+
+/**
+ * Read-only file that transparently decompresses a seekable zstd image. Decompressed frames are
+ * kept in a small LRU cache, and when the file is read sequentially the following frames are
+ * decompressed ahead of time on a pool of background threads. Positional reads can be made from
+ * several threads at once.
+ */
+class SeekableZstdIOFile : public FileUtil::IOFile {
+public:
+    SeekableZstdIOFile();
+    explicit SeekableZstdIOFile(const std::string& filename);
+    ~SeekableZstdIOFile() override;
+
+    /// Returns whether the image header and index were loaded successfully.
+    [[nodiscard]] bool IsValid() const {
+        return frame_size != 0;
+    }
+
+    bool IsCompressed() override {
+        return true;
+    }
+
+    [[nodiscard]] u64 Tell() const override {
+        return position;
+    }
+
+    [[nodiscard]] u64 GetSize() const override {
+        return uncompressed_size;
+    }
+
+private:
+    // Number of decompressed frames that are kept around.
+    static constexpr std::size_t cache_capacity = 16;
+    // Number of frames past a sequential read that are decompressed ahead.
+    static constexpr std::size_t read_ahead_frames = 4;
+
+    u64 position = 0;
+    u64 uncompressed_size = 0;
+    u32 frame_size = 0;
+    std::vector<u64> frame_offsets;
+
+    // Declared last so that queued read-ahead is stopped before the index is destroyed.
+    Common::BlockCache cache;
+
+    void LoadIndex();
+
+    std::size_t ReadImpl(void* data, std::size_t length, std::size_t data_size) override;
+    std::size_t ReadAtImpl(void* data, std::size_t length, std::size_t data_size,
+                           std::size_t offset) override;
+    std::size_t WriteImpl(const void* data, std::size_t length, std::size_t data_size) override;
+
+    bool SeekImpl(s64 off, int origin) override;
+
+    std::vector<u8> DecompressFrame(std::size_t frame);
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+        ar& boost::serialization::base_object<FileUtil::IOFile>(*this);
+        if (Archive::is_loading::value) {
+            LoadIndex();
+        }
+    }
+    friend class boost::serialization::access;
+};
+
+/**
+ * Opens a game image for reading. Seekable zstd images are opened as a SeekableZstdIOFile so
+ * that callers see the decompressed contents, other files are opened as a plain IOFile.
+ */
+[[nodiscard]] std::unique_ptr<FileUtil::IOFile> OpenImageFile(const std::string& filename);
+
+} // namespace Common::Compression
+
+BOOST_CLASS_EXPORT_KEY(Common::Compression::SeekableZstdIOFile)
@@ -3,9 +3,11 @@
 // Refer to the license.txt file included.
 
 #include <cstring>
+#include <limits>
 #include <dynarmic/interface/A32/a32.h>
 #include <dynarmic/interface/optimization_flags.h>
 #include "common/assert.h"
+#include "common/hash.h"
 #include "common/microprofile.h"
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #include "core/arm/dynarmic/arm_dynarmic_cp15.h"
@@ -14,6 +16,7 @@
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/svc.h"
 #include "core/memory.h"
 
@@ -25,43 +28,92 @@ public:
         : parent(parent), svc_context(parent.system), memory(parent.memory) {}
     ~DynarmicUserCallbacks() = default;
 
+    /**
+     * Runs a callback that leaves the JIT. When the cores run on their own host threads, this
+     * serializes it against the other cores and makes this core the running one meanwhile.
+     */
+    template <typename Func>
+    auto WithHLELock(Func&& func) {
+        if (!parent.system.IsRunningCoresInParallel()) {
+            return func();
+        }
+        std::scoped_lock lock{parent.system.Kernel().GetHLELock()};
+        parent.system.SetRunningCore(&parent);
+        return func();
+    }
+
     std::uint8_t MemoryRead8(VAddr vaddr) override {
-        return memory.Read8(vaddr);
+        return WithHLELock([&] { return memory.Read8(vaddr); });
     }
     std::uint16_t MemoryRead16(VAddr vaddr) override {
-        return memory.Read16(vaddr);
+        return WithHLELock([&] { return memory.Read16(vaddr); });
     }
     std::uint32_t MemoryRead32(VAddr vaddr) override {
-        return memory.Read32(vaddr);
+        return WithHLELock([&] { return memory.Read32(vaddr); });
     }
     std::uint64_t MemoryRead64(VAddr vaddr) override {
-        return memory.Read64(vaddr);
+        return WithHLELock([&] { return memory.Read64(vaddr); });
     }
 
     void MemoryWrite8(VAddr vaddr, std::uint8_t value) override {
-        memory.Write8(vaddr, value);
+        WithHLELock([&] { memory.Write8(vaddr, value); });
     }
     void MemoryWrite16(VAddr vaddr, std::uint16_t value) override {
-        memory.Write16(vaddr, value);
+        WithHLELock([&] { memory.Write16(vaddr, value); });
     }
     void MemoryWrite32(VAddr vaddr, std::uint32_t value) override {
-        memory.Write32(vaddr, value);
+        WithHLELock([&] { memory.Write32(vaddr, value); });
     }
     void MemoryWrite64(VAddr vaddr, std::uint64_t value) override {
-        memory.Write64(vaddr, value);
+        WithHLELock([&] { memory.Write64(vaddr, value); });
     }
 
+    /**
+     * Store-exclusives to pages with a host pointer are committed through this core's page table,
+     * which doesn't need the HLE lock even when the cores run in parallel. Other pages, and all of
+     * them while the core has no page table, go through the current process' address space under
+     * the lock.
+     */
     bool MemoryWriteExclusive8(u32 vaddr, u8 value, u8 expected) override {
-        return memory.WriteExclusive8(vaddr, value, expected);
+        if (parent.current_page_table) {
+            if (const auto result = memory.WriteExclusive8(*parent.current_page_table, vaddr, value,
+                                                           expected)) {
+                return *result;
+            }
+        }
+        return WithHLELock([&] { return memory.WriteExclusive8(vaddr, value, expected); });
     }
     bool MemoryWriteExclusive16(u32 vaddr, u16 value, u16 expected) override {
-        return memory.WriteExclusive16(vaddr, value, expected);
+        if (parent.current_page_table) {
+            if (const auto result = memory.WriteExclusive16(*parent.current_page_table, vaddr,
+                                                            value, expected)) {
+                return *result;
+            }
+        }
+        return WithHLELock([&] { return memory.WriteExclusive16(vaddr, value, expected); });
     }
     bool MemoryWriteExclusive32(u32 vaddr, u32 value, u32 expected) override {
-        return memory.WriteExclusive32(vaddr, value, expected);
+        if (parent.current_page_table) {
+            if (const auto result = memory.WriteExclusive32(*parent.current_page_table, vaddr,
+                                                            value, expected)) {
+                return *result;
+            }
+        }
+        return WithHLELock([&] { return memory.WriteExclusive32(vaddr, value, expected); });
     }
     bool MemoryWriteExclusive64(u32 vaddr, u64 value, u64 expected) override {
-        return memory.WriteExclusive64(vaddr, value, expected);
+        if (parent.current_page_table) {
+            if (const auto result = memory.WriteExclusive64(*parent.current_page_table, vaddr,
+                                                            value, expected)) {
+                return *result;
+            }
+        }
+        return WithHLELock([&] { return memory.WriteExclusive64(vaddr, value, expected); });
+    }
+
+    std::optional<std::uint32_t> MemoryReadCode(VAddr vaddr) override {
+        parent.TrackCodePage(vaddr);
+        return MemoryRead32(vaddr);
     }
 
     void InterpreterFallback(VAddr pc, std::size_t num_instructions) override {
@@ -71,7 +123,7 @@ public:
     }
 
     void CallSVC(std::uint32_t swi) override {
-        svc_context.CallSVC(swi);
+        WithHLELock([&] { svc_context.CallSVC(swi); });
     }
 
     void ExceptionRaised(VAddr pc, Dynarmic::A32::Exception exception) override {
@@ -136,7 +188,8 @@ ARM_Dynarmic::~ARM_Dynarmic() = default;
 MICROPROFILE_DEFINE(ARM_Jit, "ARM JIT", "ARM JIT", MP_RGB(255, 64, 64));
 
 void ARM_Dynarmic::Run() {
-    ASSERT(memory.GetCurrentPageTable() == current_page_table);
+    ASSERT(system.IsRunningCoresInParallel() ||
+           memory.GetCurrentPageTable() == current_page_table);
     MICROPROFILE_SCOPE(ARM_Jit);
 
     jit->Run();
@@ -257,13 +310,81 @@ void ARM_Dynarmic::PrepareReschedule() {
 }
 
 void ARM_Dynarmic::ClearInstructionCache() {
-    for (const auto& j : jits) {
-        j.second->ClearCache();
+    // Guest code usually requests a full flush after patching a small part of itself, so only
+    // drop the pages that actually changed since they were translated.
+    // A page is only hashed when code is first translated from it, so this misses a page that was
+    // changed, translated from again and then changed back before the flush: its hash matches and
+    // the blocks translated from the intermediate contents are kept. This only happens when the
+    // guest runs the intermediate code without flushing it first.
+    for (const auto& [page_table, j] : jits) {
+        InvalidateChangedCodePages(*j, page_table.get(), code_page_hashes[page_table], 0,
+                                   std::numeric_limits<u32>::max());
     }
 }
 
 void ARM_Dynarmic::InvalidateCacheRange(u32 start_address, std::size_t length) {
-    jit->InvalidateCacheRange(start_address, length);
+    InvalidateChangedCodePages(*jit, current_page_table.get(), *current_code_pages, start_address,
+                               length);
+}
+
+static std::optional<u64> HashCodePage(Memory::PageTable* page_table, VAddr page) {
+    if (!page_table) {
+        return std::nullopt;
+    }
+    const u8* pointer = page_table->GetPointerArray()[page >> Memory::CITRA_PAGE_BITS];
+    if (!pointer) {
+        return std::nullopt;
+    }
+    return Common::ComputeHash64(pointer, Memory::CITRA_PAGE_SIZE);
+}
+
+void ARM_Dynarmic::TrackCodePage(VAddr vaddr) {
+    const VAddr page = vaddr & ~Memory::CITRA_PAGE_MASK;
+    if (current_code_pages->contains(page)) {
+        return;
+    }
+    current_code_pages->emplace(page, HashCodePage(current_page_table.get(), page));
+}
+
+void ARM_Dynarmic::InvalidateChangedCodePages(Dynarmic::A32::Jit& target,
+                                              Memory::PageTable* page_table,
+                                              CodePageHashes& hashes, VAddr start,
+                                              std::size_t length) {
+    if (length == 0) {
+        return;
+    }
+    const VAddr first_page = start & ~Memory::CITRA_PAGE_MASK;
+    const VAddr last_page = static_cast<VAddr>(
+        std::min<u64>(static_cast<u64>(start) + length - 1, std::numeric_limits<u32>::max()) &
+        ~Memory::CITRA_PAGE_MASK);
+
+    const auto invalidate_if_changed = [&](VAddr page, const std::optional<u64>& hash) {
+        if (hash && *hash == HashCodePage(page_table, page)) {
+            return false;
+        }
+        target.InvalidateCacheRange(page, Memory::CITRA_PAGE_SIZE);
+        return true;
+    };
+
+    // Pick whichever is smaller to walk, the tracked pages or the requested range.
+    const u64 num_pages = ((last_page - first_page) >> Memory::CITRA_PAGE_BITS) + 1;
+    if (num_pages > hashes.size()) {
+        for (auto it = hashes.begin(); it != hashes.end();) {
+            if (it->first >= first_page && it->first <= last_page &&
+                invalidate_if_changed(it->first, it->second)) {
+                it = hashes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return;
+    }
+    for (u64 page = first_page; page <= last_page; page += Memory::CITRA_PAGE_SIZE) {
+        const auto it = hashes.find(static_cast<VAddr>(page));
+        if (it != hashes.end() && invalidate_if_changed(it->first, it->second)) {
+            hashes.erase(it);
+        }
+    }
 }
 
 void ARM_Dynarmic::ClearExclusiveState() {
@@ -281,6 +402,7 @@ void ARM_Dynarmic::SetPageTable(const std::shared_ptr<Memory::PageTable>& page_t
         SaveContext(ctx);
     }
 
+    current_code_pages = &code_page_hashes[current_page_table];
     auto iter = jits.find(current_page_table);
     if (iter != jits.end()) {
         jit = iter->second.get();
@@ -6,6 +6,8 @@
 
 #include <map>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <dynarmic/interface/A32/a32.h>
 #include "common/common_types.h"
 #include "core/arm/arm_interface.h"
@@ -60,8 +62,19 @@ protected:
     std::shared_ptr<Memory::PageTable> GetPageTable() const override;
 
 private:
+    /// Hashes of the guest code pages translated by a JIT, nullopt if a page can't be hashed.
+    /// Taken when the first block is translated from the page, not updated by later translations.
+    using CodePageHashes = std::unordered_map<VAddr, std::optional<u64>>;
+
     void ServeBreak();
 
+    /// Records that the guest code at the given address is being translated.
+    void TrackCodePage(VAddr vaddr);
+
+    /// Invalidates the translated code of every tracked page in the range whose contents changed.
+    void InvalidateChangedCodePages(Dynarmic::A32::Jit& target, Memory::PageTable* page_table,
+                                    CodePageHashes& hashes, VAddr start, std::size_t length);
+
     friend class DynarmicUserCallbacks;
     Core::System& system;
     Memory::MemorySystem& memory;
@@ -75,6 +88,8 @@ private:
     Dynarmic::A32::Jit* jit = nullptr;
     std::shared_ptr<Memory::PageTable> current_page_table = nullptr;
     std::map<std::shared_ptr<Memory::PageTable>, std::unique_ptr<Dynarmic::A32::Jit>> jits;
+    std::map<std::shared_ptr<Memory::PageTable>, CodePageHashes> code_page_hashes;
+    CodePageHashes* current_code_pages = nullptr;
 };
 
 } // namespace Core
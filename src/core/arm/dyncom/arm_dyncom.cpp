@@ -19,6 +19,7 @@ ARM_DynCom::ARM_DynCom(Core::System& system_, Memory::MemorySystem& memory,
                        std::shared_ptr<Core::Timing::Timer> timer)
     : ARM_Interface(id, timer), system(system_) {
     state = std::make_unique<ARMul_State>(system, memory, initial_mode);
+    state->SetPageTable(memory.GetCurrentPageTable());
 }
 
 ARM_DynCom::~ARM_DynCom() {}
@@ -32,20 +33,19 @@ void ARM_DynCom::Step() {
 }
 
 void ARM_DynCom::ClearInstructionCache() {
-    state->instruction_cache.clear();
-    trans_cache_buf_top = 0;
+    state->ClearInstructionCache();
 }
 
-void ARM_DynCom::InvalidateCacheRange(u32, std::size_t) {
-    ClearInstructionCache();
+void ARM_DynCom::InvalidateCacheRange(u32 start_address, std::size_t length) {
+    state->InvalidateCacheRange(start_address, length);
 }
 
 void ARM_DynCom::SetPageTable(const std::shared_ptr<Memory::PageTable>& page_table) {
-    ClearInstructionCache();
+    state->SetPageTable(page_table);
 }
 
 std::shared_ptr<Memory::PageTable> ARM_DynCom::GetPageTable() const {
-    return nullptr;
+    return state->GetPageTable();
 }
 
 void ARM_DynCom::SetPC(u32 pc) {
@@ -98,6 +98,7 @@ void ARM_DynCom::SetCP15Register(CP15Register reg, u32 value) {
 
 void ARM_DynCom::ExecuteInstructions(u64 num_instructions) {
     state->NumInstrsToExecute = num_instructions;
+    state->ValidateInstructionCache(trans_cache_generation);
     const u32 ticks_executed = InterpreterMainLoop(state.get());
     if (timer) {
         timer->AddTicks(ticks_executed);
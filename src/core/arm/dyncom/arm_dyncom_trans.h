@@ -494,5 +494,12 @@ extern const transop_fp_t arm_instruction_trans[];
 extern const std::size_t arm_instruction_trans_len;
 
 #define TRANS_CACHE_SIZE (64 * 1024 * 2000)
+// Space kept free in the translation buffer so that a whole block can always be translated.
+#define TRANS_CACHE_BLOCK_RESERVE (1024 * 1024)
 extern char trans_cache_buf[TRANS_CACHE_SIZE];
 extern std::size_t trans_cache_buf_top;
+// Incremented every time the translation buffer is recycled, invalidating every cached block.
+extern u64 trans_cache_generation;
+
+// Recycles the translation buffer if it can't fit another block.
+void ReserveTranslationCache();
@@ -0,0 +1,53 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "core/arm/idle_loop_detector.h"
+
+namespace Core {
+
+// Mode and Thumb bits, the condition flags may differ depending on where in the loop we stopped.
+constexpr u32 CPSR_STATE_MASK = 0x3F;
+
+void IdleLoopDetector::OnSliceStart(const Kernel::Thread* thread, u64 events_fired) {
+    if (thread != last_thread) {
+        matching_slices = 0;
+        idle = false;
+    } else if (events_fired != last_events_fired) {
+        // Keep the streak so the loop is skipped again right after one confirming slice.
+        idle = false;
+    }
+    last_events_fired = events_fired;
+}
+
+void IdleLoopDetector::OnSliceExecuted(ARM_Interface& core, const Kernel::Thread* thread) {
+    ARM_Interface::ThreadContext context{};
+    core.SaveContext(context);
+
+    if (thread == last_thread && MatchesLastContext(context)) {
+        matching_slices = std::min(matching_slices + 1, IdleSliceThreshold);
+    } else {
+        matching_slices = 0;
+    }
+    last_context = context;
+    last_thread = thread;
+    idle = matching_slices >= IdleSliceThreshold;
+}
+
+bool IdleLoopDetector::MatchesLastContext(const ARM_Interface::ThreadContext& context) const {
+    const u32 pc = context.GetProgramCounter();
+    const u32 last_pc = last_context.GetProgramCounter();
+    if ((pc > last_pc ? pc - last_pc : last_pc - pc) > MaxLoopSize) {
+        return false;
+    }
+    if ((context.cpsr & CPSR_STATE_MASK) != (last_context.cpsr & CPSR_STATE_MASK)) {
+        return false;
+    }
+    return std::equal(context.cpu_registers.begin(), context.cpu_registers.end() - 1,
+                      last_context.cpu_registers.begin()) &&
+           context.fpu_registers == last_context.fpu_registers &&
+           context.fpscr == last_context.fpscr;
+}
+
+} // namespace Core
@@ -0,0 +1,57 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+#include "core/arm/arm_interface.h"
+
+namespace Kernel {
+class Thread;
+}
+
+namespace Core {
+
+/**
+ * Detects guest threads spinning in a loop that polls memory without changing any state, such as
+ * `while (!*flag) {}`. Such a loop can only be released by something outside of it (a timing
+ * event, an HLE service or another core), so once detected the scheduler can skip straight to the
+ * next timing event instead of burning host time executing it.
+ *
+ * A loop is considered idle when the registers at the end of several consecutive slices are
+ * identical, the PC aside which may land anywhere inside the loop body.
+ */
+class IdleLoopDetector {
+public:
+    /// Number of consecutive matching slices after which a loop is considered idle
+    static constexpr u32 IdleSliceThreshold = 4;
+
+    /// Largest distance between the PCs of two matching slices, bounds the loop body size
+    static constexpr u32 MaxLoopSize = 0x40;
+
+    /// Returns true if the core is spinning in an idle loop
+    [[nodiscard]] bool IsIdle() const {
+        return idle;
+    }
+
+    /**
+     * Called before each slice of the core. Stops skipping whenever something may have changed
+     * what the loop polls, so that the next slice executes the loop again and re-evaluates it.
+     */
+    void OnSliceStart(const Kernel::Thread* thread, u64 events_fired);
+
+    /// Called after the core executed a slice of guest code
+    void OnSliceExecuted(ARM_Interface& core, const Kernel::Thread* thread);
+
+private:
+    bool MatchesLastContext(const ARM_Interface::ThreadContext& context) const;
+
+    ARM_Interface::ThreadContext last_context{};
+    const Kernel::Thread* last_thread = nullptr;
+    u64 last_events_fired = 0;
+    u32 matching_slices = 0;
+    bool idle = false;
+};
+
+} // namespace Core
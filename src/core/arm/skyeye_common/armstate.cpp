@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include "common/logging/log.h"
 #include "common/swap.h"
 #include "core/arm/skyeye_common/armstate.h"
@@ -12,7 +13,7 @@
 
 ARMul_State::ARMul_State(Core::System& system_, Memory::MemorySystem& memory_,
                          PrivilegeMode initial_mode)
-    : system{system_}, memory{memory_} {
+    : system{system_}, memory{memory_}, svc_context{system_} {
     Reset();
     ChangePrivilegeMode(initial_mode);
 }
@@ -193,16 +194,135 @@ static void CheckMemoryBreakpoint(u32 address, GDBStub::BreakpointType type) {
 }
 #endif
 
-u8 ARMul_State::ReadMemory8(u32 address) const {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Read);
+void ARMul_State::SetPageTable(const std::shared_ptr<Memory::PageTable>& page_table_) {
+    if (page_table != page_table_) {
+        std::erase_if(inactive_caches, [](const InactiveCache& cache) {
+            return cache.page_table.expired();
+        });
+        if (page_table && !instruction_cache.empty()) {
+            inactive_caches.push_back({page_table, std::move(instruction_cache),
+                                       std::move(instruction_cache_pages)});
+        }
+        instruction_cache.clear();
+        instruction_cache_pages.clear();
+
+        const auto it = std::find_if(
+            inactive_caches.begin(), inactive_caches.end(),
+            [&](const InactiveCache& cache) { return cache.page_table.lock() == page_table_; });
+        if (it != inactive_caches.end()) {
+            instruction_cache = std::move(it->blocks);
+            instruction_cache_pages = std::move(it->pages);
+            inactive_caches.erase(it);
+        }
+    }
 
-    return memory.Read8(address);
+    page_table = page_table_;
+    page_pointers = page_table ? page_table->GetPointerArray().data() : nullptr;
 }
 
-u16 ARMul_State::ReadMemory16(u32 address) const {
+void ARMul_State::AddCachedBlock(u32 start_address, u32 end_address, std::size_t offset) {
+    instruction_cache[start_address] = offset;
+
+    const u32 first_page = start_address >> Memory::CITRA_PAGE_BITS;
+    const u32 last_page = (end_address - 1) >> Memory::CITRA_PAGE_BITS;
+    for (u32 page = first_page; page <= last_page; ++page) {
+        instruction_cache_pages[page].push_back(start_address);
+    }
+}
+
+void ARMul_State::InvalidateBlocks(std::unordered_map<u32, std::size_t>& blocks,
+                                   CachedPages& pages, u32 start_address, std::size_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    const u32 first_page = start_address >> Memory::CITRA_PAGE_BITS;
+    const u32 last_page = static_cast<u32>(start_address + length - 1) >> Memory::CITRA_PAGE_BITS;
+    for (u32 page = first_page; page <= last_page; ++page) {
+        const auto it = pages.find(page);
+        if (it == pages.end()) {
+            continue;
+        }
+        for (const u32 block_address : it->second) {
+            blocks.erase(block_address);
+        }
+        pages.erase(it);
+    }
+}
+
+void ARMul_State::InvalidateCacheRange(u32 start_address, std::size_t length) {
+    InvalidateBlocks(instruction_cache, instruction_cache_pages, start_address, length);
+    for (auto& cache : inactive_caches) {
+        InvalidateBlocks(cache.blocks, cache.pages, start_address, length);
+    }
+}
+
+void ARMul_State::ClearInstructionCache() {
+    instruction_cache.clear();
+    instruction_cache_pages.clear();
+    inactive_caches.clear();
+}
+
+void ARMul_State::ValidateInstructionCache(u64 generation) {
+    if (instruction_cache_generation != generation) {
+        ClearInstructionCache();
+        instruction_cache_generation = generation;
+    }
+}
+
+u8* ARMul_State::GetFastmemPointer(u32 address) const {
+    if (!page_pointers) {
+        return nullptr;
+    }
+    u8* page = page_pointers[address >> Memory::CITRA_PAGE_BITS];
+    return page ? page + (address & Memory::CITRA_PAGE_MASK) : nullptr;
+}
+
+template <typename T>
+T ARMul_State::ReadMemory(u32 address) const {
     CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Read);
 
-    u16 data = memory.Read16(address);
+    if (const u8* pointer = GetFastmemPointer(address)) {
+        T value;
+        std::memcpy(&value, pointer, sizeof(T));
+        return value;
+    }
+    if constexpr (sizeof(T) == 1) {
+        return memory.Read8(address);
+    } else if constexpr (sizeof(T) == 2) {
+        return memory.Read16(address);
+    } else if constexpr (sizeof(T) == 4) {
+        return memory.Read32(address);
+    } else {
+        return memory.Read64(address);
+    }
+}
+
+template <typename T>
+void ARMul_State::WriteMemory(u32 address, T data) {
+    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Write);
+
+    if (u8* pointer = GetFastmemPointer(address)) {
+        std::memcpy(pointer, &data, sizeof(T));
+        return;
+    }
+    if constexpr (sizeof(T) == 1) {
+        memory.Write8(address, data);
+    } else if constexpr (sizeof(T) == 2) {
+        memory.Write16(address, data);
+    } else if constexpr (sizeof(T) == 4) {
+        memory.Write32(address, data);
+    } else {
+        memory.Write64(address, data);
+    }
+}
+
+u8 ARMul_State::ReadMemory8(u32 address) const {
+    return ReadMemory<u8>(address);
+}
+
+u16 ARMul_State::ReadMemory16(u32 address) const {
+    u16 data = ReadMemory<u16>(address);
 
     if (InBigEndianMode())
         data = Common::swap16(data);
@@ -211,9 +331,7 @@ u16 ARMul_State::ReadMemory16(u32 address) const {
 }
 
 u32 ARMul_State::ReadMemory32(u32 address) const {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Read);
-
-    u32 data = memory.Read32(address);
+    u32 data = ReadMemory<u32>(address);
 
     if (InBigEndianMode())
         data = Common::swap32(data);
@@ -222,9 +340,7 @@ u32 ARMul_State::ReadMemory32(u32 address) const {
 }
 
 u64 ARMul_State::ReadMemory64(u32 address) const {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Read);
-
-    u64 data = memory.Read64(address);
+    u64 data = ReadMemory<u64>(address);
 
     if (InBigEndianMode())
         data = Common::swap64(data);
@@ -233,36 +349,28 @@ u64 ARMul_State::ReadMemory64(u32 address) const {
 }
 
 void ARMul_State::WriteMemory8(u32 address, u8 data) {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Write);
-
-    memory.Write8(address, data);
+    WriteMemory<u8>(address, data);
 }
 
 void ARMul_State::WriteMemory16(u32 address, u16 data) {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Write);
-
     if (InBigEndianMode())
         data = Common::swap16(data);
 
-    memory.Write16(address, data);
+    WriteMemory<u16>(address, data);
 }
 
 void ARMul_State::WriteMemory32(u32 address, u32 data) {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Write);
-
     if (InBigEndianMode())
         data = Common::swap32(data);
 
-    memory.Write32(address, data);
+    WriteMemory<u32>(address, data);
 }
 
 void ARMul_State::WriteMemory64(u32 address, u64 data) {
-    CheckMemoryBreakpoint(address, GDBStub::BreakpointType::Write);
-
     if (InBigEndianMode())
         data = Common::swap64(data);
 
-    memory.Write64(address, data);
+    WriteMemory<u64>(address, data);
 }
 
 // Reads from the CP15 registers. Used with implementation of the MRC instruction.
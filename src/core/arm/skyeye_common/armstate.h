@@ -18,10 +18,13 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include "common/common_types.h"
 #include "core/arm/skyeye_common/arm_regformat.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/hle/kernel/svc.h"
 
 namespace Core {
 class System;
@@ -29,7 +32,8 @@ class System;
 
 namespace Memory {
 class MemorySystem;
-}
+struct PageTable;
+} // namespace Memory
 
 // Signal levels
 enum { LOW = 0, HIGH = 1, LOWHIGH = 1, HIGHLOW = 2 };
@@ -164,6 +168,12 @@ public:
     void WriteMemory32(u32 address, u32 data);
     void WriteMemory64(u32 address, u64 data);
 
+    /// Sets the page table used by the direct memory access fast path, may be null.
+    void SetPageTable(const std::shared_ptr<Memory::PageTable>& page_table);
+    std::shared_ptr<Memory::PageTable> GetPageTable() const {
+        return page_table;
+    }
+
     u32 ReadCP15Register(u32 crn, u32 opcode_1, u32 crm, u32 opcode_2) const;
     void WriteCP15Register(u32 value, u32 crn, u32 opcode_1, u32 crm, u32 opcode_2);
 
@@ -208,6 +218,8 @@ public:
 
     Core::System& system;
     Memory::MemorySystem& memory;
+    /// Kept for the SWI instructions, so that they do not set up a new SVC handler every call
+    Kernel::SVCContext svc_context;
 
     std::array<u32, 16> Reg{}; // The current register file
     std::array<u32, 2> Reg_usr{};
@@ -252,13 +264,51 @@ public:
     unsigned bigendSig;
     unsigned syscallSig;
 
-    // TODO(bunnei): Move this cache to a better place - it should be per codeset (likely per
-    // process for our purposes), not per ARMul_State (which tracks CPU core state).
+    /// Records a translated block covering [start_address, end_address) at the given offset of
+    /// the translation buffer.
+    void AddCachedBlock(u32 start_address, u32 end_address, std::size_t offset);
+    /// Drops the translated blocks overlapping the given guest address range.
+    void InvalidateCacheRange(u32 start_address, std::size_t length);
+    /// Drops every translated block, including the ones kept for inactive page tables.
+    void ClearInstructionCache();
+    /// Drops every translated block if the translation buffer was recycled since they were made.
+    void ValidateInstructionCache(u64 generation);
+
+    // Translated blocks of the current page table, keyed by guest address. Blocks of other page
+    // tables are kept aside while they are not current so process switches don't re-decode code.
     std::unordered_map<u32, std::size_t> instruction_cache;
 
 private:
     void ResetMPCoreCP15Registers();
 
+    /// Returns the host pointer backing the address, or null if the access has to go through
+    /// MemorySystem (unmapped, MMIO or rasterizer cached pages).
+    u8* GetFastmemPointer(u32 address) const;
+
+    template <typename T>
+    T ReadMemory(u32 address) const;
+    template <typename T>
+    void WriteMemory(u32 address, T data);
+
+    std::shared_ptr<Memory::PageTable> page_table;
+    u8* const* page_pointers = nullptr;
+
+    using CachedPages = std::unordered_map<u32, std::vector<u32>>;
+
+    struct InactiveCache {
+        std::weak_ptr<Memory::PageTable> page_table;
+        std::unordered_map<u32, std::size_t> blocks;
+        CachedPages pages;
+    };
+
+    static void InvalidateBlocks(std::unordered_map<u32, std::size_t>& blocks, CachedPages& pages,
+                                 u32 start_address, std::size_t length);
+
+    /// Start addresses of the blocks in instruction_cache that touch each page.
+    CachedPages instruction_cache_pages;
+    std::vector<InactiveCache> inactive_caches;
+    u64 instruction_cache_generation = 0;
+
     // Defines a reservation granule of 2 words, which protects the first 2 words starting at the
     // tag. This is the smallest granule allowed by the v7 spec, and is coincidentally just large
     // enough to support LDR/STREXD.
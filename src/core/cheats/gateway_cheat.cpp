@@ -32,7 +32,7 @@ struct State {
 };
 
 template <typename T, typename ReadFunction, typename WriteFunction>
-static inline std::enable_if_t<std::is_integral_v<T>> WriteOp(const GatewayCheat::CheatLine& line,
+static inline std::enable_if_t<std::is_integral_v<T>> WriteOp(const GatewayCheat::Instruction& line,
                                                               const State& state,
                                                               ReadFunction read_func,
                                                               WriteFunction write_func,
@@ -46,7 +46,7 @@ static inline std::enable_if_t<std::is_integral_v<T>> WriteOp(const GatewayCheat
 }
 
 template <typename T, typename ReadFunction, typename CompareFunc>
-static inline std::enable_if_t<std::is_integral_v<T>> CompOp(const GatewayCheat::CheatLine& line,
+static inline std::enable_if_t<std::is_integral_v<T>> CompOp(const GatewayCheat::Instruction& line,
                                                              State& state, ReadFunction read_func,
                                                              CompareFunc comp) {
     u32 addr = line.address + state.offset;
@@ -57,12 +57,12 @@ static inline std::enable_if_t<std::is_integral_v<T>> CompOp(const GatewayCheat:
 }
 
 static inline void LoadOffsetOp(Memory::MemorySystem& memory, const Kernel::Process& process,
-                                const GatewayCheat::CheatLine& line, State& state) {
+                                const GatewayCheat::Instruction& line, State& state) {
     u32 addr = line.address + state.offset;
     state.offset = memory.Read32(process, addr);
 }
 
-static inline void LoopOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void LoopOp(const GatewayCheat::Instruction& line, State& state) {
     state.loop_flag = state.loop_count < line.value;
     state.loop_count++;
     state.loop_back_line = state.current_line_nr;
@@ -94,21 +94,21 @@ static inline void FullTerminateOp(State& state) {
     }
 }
 
-static inline void SetOffsetOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void SetOffsetOp(const GatewayCheat::Instruction& line, State& state) {
     state.offset = line.value;
 }
 
-static inline void AddValueOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void AddValueOp(const GatewayCheat::Instruction& line, State& state) {
     state.reg += line.value;
 }
 
-static inline void SetValueOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void SetValueOp(const GatewayCheat::Instruction& line, State& state) {
     state.reg = line.value;
 }
 
 template <typename T, typename ReadFunction, typename WriteFunction>
 static inline std::enable_if_t<std::is_integral_v<T>> IncrementiveWriteOp(
-    const GatewayCheat::CheatLine& line, State& state, ReadFunction read_func,
+    const GatewayCheat::Instruction& line, State& state, ReadFunction read_func,
     WriteFunction write_func, Core::System& system) {
     u32 addr = line.value + state.offset;
     T val = read_func(addr);
@@ -120,66 +120,39 @@ static inline std::enable_if_t<std::is_integral_v<T>> IncrementiveWriteOp(
 }
 
 template <typename T, typename ReadFunction>
-static inline std::enable_if_t<std::is_integral_v<T>> LoadOp(const GatewayCheat::CheatLine& line,
+static inline std::enable_if_t<std::is_integral_v<T>> LoadOp(const GatewayCheat::Instruction& line,
                                                              State& state, ReadFunction read_func) {
 
     u32 addr = line.value + state.offset;
     state.reg = read_func(addr);
 }
 
-static inline void AddOffsetOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void AddOffsetOp(const GatewayCheat::Instruction& line, State& state) {
     state.offset += line.value;
 }
 
-static inline void JokerOp(const GatewayCheat::CheatLine& line, State& state,
-                           const Core::System& system) {
-    u32 pad_state = system.ServiceManager()
-                        .GetService<Service::HID::Module::Interface>("hid:USER")
-                        ->GetModule()
-                        ->GetState()
-                        .hex;
+static inline void JokerOp(const GatewayCheat::Instruction& line, State& state,
+                           const Service::HID::Module& hid) {
+    u32 pad_state = hid.GetState().hex;
     bool pressed = (pad_state & line.value) == line.value;
     if (!pressed) {
         state.if_flag++;
     }
 }
 
-static inline void PatchOp(const GatewayCheat::CheatLine& line, State& state, Core::System& system,
-                           const Kernel::Process& process,
-                           std::span<const GatewayCheat::CheatLine> cheat_lines) {
+static inline void PatchOp(const GatewayCheat::Instruction& line, State& state,
+                           Core::System& system, const Kernel::Process& process,
+                           std::span<const u8> patch_data) {
     if (state.if_flag > 0) {
         // Skip over the additional patch lines
-        state.current_line_nr += static_cast<int>(std::ceil(line.value / 8.0));
+        state.current_line_nr += line.patch_skip_lines;
         return;
     }
-    u32 num_bytes = line.value;
     u32 addr = line.address + state.offset;
-    system.InvalidateCacheRange(addr, num_bytes);
-
-    bool first = true;
-    u32 bit_offset = 0;
-    if (num_bytes > 0)
-        state.current_line_nr++; // skip over the current code
-    while (num_bytes >= 4) {
-        u32 tmp = first ? cheat_lines[state.current_line_nr].first
-                        : cheat_lines[state.current_line_nr].value;
-        if (!first && num_bytes > 4) {
-            state.current_line_nr++;
-        }
-        first = !first;
-        system.Memory().Write32(process, addr, tmp);
-        addr += 4;
-        num_bytes -= 4;
-    }
-    while (num_bytes > 0) {
-        u32 tmp = (first ? cheat_lines[state.current_line_nr].first
-                         : cheat_lines[state.current_line_nr].value) >>
-                  bit_offset;
-        system.Memory().Write8(process, addr, static_cast<u8>(tmp));
-        addr += 1;
-        num_bytes -= 1;
-        bit_offset += 8;
-    }
+    system.InvalidateCacheRange(addr, line.value);
+    system.Memory().WriteBlock(process, addr, patch_data.data() + line.patch_offset,
+                               line.patch_size);
+    state.current_line_nr = line.patch_end_line;
 }
 
 GatewayCheat::CheatLine::CheatLine(const std::string& line) {
@@ -213,6 +186,7 @@ GatewayCheat::CheatLine::CheatLine(const std::string& line) {
 GatewayCheat::GatewayCheat(std::string name_, std::vector<CheatLine> cheat_lines_,
                            std::string comments_)
     : name(std::move(name_)), cheat_lines(std::move(cheat_lines_)), comments(std::move(comments_)) {
+    Compile();
 }
 
 GatewayCheat::GatewayCheat(std::string name_, std::string code, std::string comments_)
@@ -226,10 +200,53 @@ GatewayCheat::GatewayCheat(std::string name_, std::string code, std::string comm
             temp_cheat_lines.emplace_back(line);
     }
     cheat_lines = std::move(temp_cheat_lines);
+    Compile();
 }
 
 GatewayCheat::~GatewayCheat() = default;
 
+void GatewayCheat::Compile() {
+    instructions.clear();
+    patch_data.clear();
+    uses_joker = false;
+
+    for (std::size_t line_nr = 0; line_nr < cheat_lines.size(); line_nr++) {
+        const CheatLine& line = cheat_lines[line_nr];
+        Instruction& instruction = instructions.emplace_back(Instruction{
+            .type = line.type,
+            .address = line.address,
+            .value = line.value,
+            .patch_offset = 0,
+            .patch_size = 0,
+            .patch_end_line = static_cast<u32>(line_nr),
+            .patch_skip_lines = 0,
+        });
+        uses_joker |= line.type == CheatType::Joker;
+        if (line.type != CheatType::Patch) {
+            continue;
+        }
+
+        // The bytes a patch copies are the following lines read as pairs of words, gathered here
+        // so that executing it is a single block write.
+        instruction.patch_skip_lines = static_cast<u32>(std::ceil(line.value / 8.0));
+        instruction.patch_offset = static_cast<u32>(patch_data.size());
+        const std::size_t available = (cheat_lines.size() - line_nr - 1) * 8;
+        if (line.value > available) {
+            LOG_ERROR(Core_Cheats, "Cheat {} patches {} bytes past its last line", name,
+                      line.value - available);
+        }
+        std::size_t end_line = line_nr;
+        for (u32 i = 0; i < std::min<std::size_t>(line.value, available); i++) {
+            end_line = line_nr + 1 + i / 8;
+            const CheatLine& data_line = cheat_lines[end_line];
+            const u32 word = (i % 8) < 4 ? data_line.first : data_line.value;
+            patch_data.push_back(static_cast<u8>(word >> ((i % 4) * 8)));
+        }
+        instruction.patch_size = static_cast<u32>(patch_data.size()) - instruction.patch_offset;
+        instruction.patch_end_line = static_cast<u32>(end_line);
+    }
+}
+
 void GatewayCheat::Execute(Core::System& system, u32 process_id) const {
     State state;
 
@@ -239,6 +256,14 @@ void GatewayCheat::Execute(Core::System& system, u32 process_id) const {
         return;
     }
 
+    const Service::HID::Module* hid = nullptr;
+    if (uses_joker) {
+        hid = system.ServiceManager()
+                  .GetService<Service::HID::Module::Interface>("hid:USER")
+                  ->GetModule()
+                  .get();
+    }
+
     auto Read8 = [&memory, &process](VAddr addr) { return memory.Read8(*process, addr); };
     auto Read16 = [&memory, &process](VAddr addr) { return memory.Read16(*process, addr); };
     auto Read32 = [&memory, &process](VAddr addr) { return memory.Read32(*process, addr); };
@@ -252,9 +277,9 @@ void GatewayCheat::Execute(Core::System& system, u32 process_id) const {
         memory.Write32(*process, addr, value);
     };
 
-    for (state.current_line_nr = 0; state.current_line_nr < cheat_lines.size();
+    for (state.current_line_nr = 0; state.current_line_nr < instructions.size();
          state.current_line_nr++) {
-        auto line = cheat_lines[state.current_line_nr];
+        const Instruction& line = instructions[state.current_line_nr];
         if (state.if_flag > 0) {
             switch (line.type) {
             case CheatType::GreaterThan32:
@@ -273,7 +298,7 @@ void GatewayCheat::Execute(Core::System& system, u32 process_id) const {
                 // EXXXXXXX YYYYYYYY
                 // Copies YYYYYYYY bytes from (current code location + 8) to [XXXXXXXX + offset].
                 // We need to call this here to skip the additional patch lines
-                PatchOp(line, state, system, *process, cheat_lines);
+                PatchOp(line, state, system, *process, patch_data);
                 break;
             case CheatType::Terminator:
                 // D0000000 00000000 - ENDIF
@@ -423,13 +448,13 @@ void GatewayCheat::Execute(Core::System& system, u32 process_id) const {
         }
         case CheatType::Joker: {
             // DD000000 XXXXXXXX – if KEYPAD has value XXXXXXXX execute next block
-            JokerOp(line, state, system);
+            JokerOp(line, state, *hid);
             break;
         }
         case CheatType::Patch: {
             // EXXXXXXX YYYYYYYY
             // Copies YYYYYYYY bytes from (current code location + 8) to [XXXXXXXX + offset].
-            PatchOp(line, state, system, *process, cheat_lines);
+            PatchOp(line, state, system, *process, patch_data);
             break;
         }
         }
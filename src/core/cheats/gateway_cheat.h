@@ -55,6 +55,17 @@ public:
         bool valid = true;
     };
 
+    /// A cheat line decoded once for execution, one per line so that line numbers still apply.
+    struct Instruction {
+        CheatType type;
+        u32 address;
+        u32 value;
+        u32 patch_offset;     ///< Patch: offset of the bytes to copy in patch_data
+        u32 patch_size;       ///< Patch: number of bytes to copy
+        u32 patch_end_line;   ///< Patch: last line holding the bytes to copy
+        u32 patch_skip_lines; ///< Patch: number of lines skipped when not executed
+    };
+
     GatewayCheat(std::string name, std::vector<CheatLine> cheat_lines, std::string comments);
     GatewayCheat(std::string name, std::string code, std::string comments);
     ~GatewayCheat();
@@ -80,9 +91,15 @@ public:
     static std::vector<std::shared_ptr<CheatBase>> LoadFile(const std::string& filepath);
 
 private:
+    /// Decodes the cheat lines into the instructions Execute runs.
+    void Compile();
+
     std::atomic<bool> enabled = false;
     const std::string name;
     std::vector<CheatLine> cheat_lines;
+    std::vector<Instruction> instructions;
+    std::vector<u8> patch_data; ///< The bytes of all patches, in the order of their lines
+    bool uses_joker = false;
     const std::string comments;
 };
 } // namespace Cheats
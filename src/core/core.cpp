@@ -2,14 +2,18 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <stdexcept>
 #include <utility>
+#include <boost/container/small_vector.hpp>
 #include <boost/serialization/array.hpp>
 #include "audio_core/dsp_interface.h"
 #include "audio_core/hle/hle.h"
 #include "audio_core/lle/lle.h"
 #include "common/arch.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
+#include "common/memory_detect.h"
 #include "common/settings.h"
 #include "core/arm/arm_interface.h"
 #include "core/arm/exclusive_monitor.h"
@@ -44,6 +48,8 @@
 #include "core/hw/aes/key.h"
 #include "core/loader/loader.h"
 #include "core/movie.h"
+#include "core/rewind_buffer.h"
+#include "core/tick_profile.h"
 #ifdef ENABLE_SCRIPTING
 #include "core/rpc/server.h"
 #endif
@@ -52,8 +58,14 @@
 #include "video_core/gpu.h"
 #include "video_core/renderer_base.h"
 
+using namespace Common::Literals;
+
 namespace Core {
 
+/// Largest rewind buffer on low memory hosts, where the default one risks getting the process
+/// killed.
+constexpr u64 LowMemoryRewindBudget = 64_MiB;
+
 /*static*/ System System::s_instance;
 
 template <>
@@ -80,8 +92,136 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
     if (!IsPoweredOn()) {
         return ResultStatus::ErrorNotInitialized;
     }
+    if (perf_stats) {
+        perf_stats->AddRunLoopIteration();
+    }
+
+    // Frontend signals, save states and the GDB server are rare, so they share a single flag
+    // word and the common path only has to load it.
+    const u32 attention = attention_flags.load(std::memory_order_relaxed);
+    if (attention != 0) {
+        if (const auto result = HandleAttention(attention, tight_loop)) {
+            return *result;
+        }
+    }
+
+    if (perf_stats) {
+        perf_stats->BeginCPUProcessing();
+    }
 
-    if (GDBStub::IsServerEnabled()) {
+    // All cores should have executed the same amount of ticks. If this is not the case an event was
+    // scheduled with a cycles_into_future smaller then the current downcount.
+    // So we have to get those cores to the same global time first
+    u64 global_ticks = timing->GetGlobalTicks();
+    s64 max_delay = 0;
+    ARM_Interface* current_core_to_execute = nullptr;
+    for (auto& cpu_core : cpu_cores) {
+        if (cpu_core->GetTimer().GetTicks() < global_ticks) {
+            s64 delay = global_ticks - cpu_core->GetTimer().GetTicks();
+            running_core = cpu_core.get();
+            kernel->SetRunningCPU(running_core);
+            cpu_core->GetTimer().Advance();
+            cpu_core->PrepareReschedule();
+            kernel->GetThreadManager(cpu_core->GetID()).Reschedule();
+            cpu_core->GetTimer().SetNextSlice(delay);
+            if (max_delay < delay) {
+                max_delay = delay;
+                current_core_to_execute = cpu_core.get();
+            }
+        }
+    }
+
+    // jit sometimes overshoot by a few ticks which might lead to a minimal desync in the cores.
+    // This small difference shouldn't make it necessary to sync the cores and would only cost
+    // performance. Thus we don't sync delays below min_delay
+    static constexpr s64 min_delay = 100;
+    if (max_delay > min_delay) {
+        LOG_TRACE(Core_ARM11, "Core {} running (delayed) for {} ticks",
+                  current_core_to_execute->GetID(),
+                  current_core_to_execute->GetTimer().GetDowncount());
+        if (running_core != current_core_to_execute) {
+            running_core = current_core_to_execute;
+            kernel->SetRunningCPU(running_core);
+        }
+        if (kernel->GetCurrentThreadManager().GetCurrentThread() == nullptr) {
+            LOG_TRACE(Core_ARM11, "Core {} idling", current_core_to_execute->GetID());
+            current_core_to_execute->GetTimer().Idle();
+            PrepareReschedule();
+        } else {
+            if (tight_loop) {
+                current_core_to_execute->Run();
+            } else {
+                current_core_to_execute->Step();
+            }
+        }
+    } else {
+        // Now all cores are at the same global time. So we will run them one after the other
+        // with a max slice that is the minimum of all max slices of all cores
+        // TODO: Make special check for idle since we can easily revert the time of idle cores
+        s64 max_slice = timing->GetSliceLimit();
+        for (const auto& cpu_core : cpu_cores) {
+            running_core = cpu_core.get();
+            kernel->SetRunningCPU(running_core);
+            cpu_core->GetTimer().Advance();
+            cpu_core->PrepareReschedule();
+            kernel->GetThreadManager(cpu_core->GetID()).Reschedule();
+            max_slice = std::min(max_slice, cpu_core->GetTimer().GetMaxSliceLength());
+        }
+        if (CanRunCoresInParallel(tight_loop)) {
+            RunCoresInParallel(max_slice);
+        } else {
+            for (auto& cpu_core : cpu_cores) {
+                cpu_core->GetTimer().SetNextSlice(max_slice);
+                auto start_ticks = cpu_core->GetTimer().GetTicks();
+                LOG_TRACE(Core_ARM11, "Core {} running for {} ticks", cpu_core->GetID(),
+                          cpu_core->GetTimer().GetDowncount());
+                running_core = cpu_core.get();
+                kernel->SetRunningCPU(running_core);
+                // If we don't have a currently active thread then don't execute instructions,
+                // instead advance to the next event and try to yield to the next thread
+                if (kernel->GetCurrentThreadManager().GetCurrentThread() == nullptr) {
+                    LOG_TRACE(Core_ARM11, "Core {} idling", cpu_core->GetID());
+                    cpu_core->GetTimer().Idle();
+                    PrepareReschedule();
+                } else if (tight_loop && CanSkipIdleSlice(*cpu_core)) {
+                    LOG_TRACE(Core_ARM11, "Core {} skipping idle loop", cpu_core->GetID());
+                    cpu_core->GetTimer().Idle();
+                } else {
+                    if (tight_loop) {
+                        cpu_core->Run();
+                        if (!idle_loop_detectors.empty()) {
+                            idle_loop_detectors[cpu_core->GetID()].OnSliceExecuted(
+                                *cpu_core, kernel->GetCurrentThreadManager().GetCurrentThread());
+                        }
+                    } else {
+                        cpu_core->Step();
+                    }
+                }
+                max_slice = cpu_core->GetTimer().GetTicks() - start_ticks;
+            }
+        }
+    }
+
+    if (perf_stats) {
+        perf_stats->EndCPUProcessing();
+    }
+
+    if (attention & AttentionDebugger) {
+        GDBStub::SetCpuStepFlag(false);
+    }
+
+    timing->UpdateSliceLimit((attention & (AttentionSignal | AttentionSaveState)) != 0);
+
+    // Invalidations deferred during the slice must not outlive it.
+    memory->FlushPendingRasterizerInvalidations();
+
+    Reschedule();
+
+    return status;
+}
+
+std::optional<System::ResultStatus> System::HandleAttention(u32 attention, bool& tight_loop) {
+    if (attention & AttentionDebugger) {
         Kernel::Thread* thread = kernel->GetCurrentThreadManager().GetCurrentThread();
         if (thread && running_core) {
             running_core->SaveContext(thread->context);
@@ -101,8 +241,9 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
 
     Signal signal{Signal::None};
     u32 param{};
-    {
+    if (attention & AttentionSignal) {
         std::scoped_lock lock{signal_mutex};
+        attention_flags.fetch_and(~AttentionSignal, std::memory_order_relaxed);
         if (current_signal != Signal::None) {
             signal = current_signal;
             param = signal_param;
@@ -129,6 +270,7 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
         save_state_slot = param;
         save_state_request_time = std::chrono::steady_clock::now();
         save_state_request_status = SaveStateStatus::LOADING;
+        attention_flags.fetch_or(AttentionSaveState, std::memory_order_relaxed);
         break;
     }
     case Signal::Save: {
@@ -140,16 +282,77 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
         save_state_slot = param;
         save_state_request_time = std::chrono::steady_clock::now();
         save_state_request_status = SaveStateStatus::SAVING;
+        attention_flags.fetch_or(AttentionSaveState, std::memory_order_relaxed);
         break;
     }
+    case Signal::Rewind:
+        if (rewind_buffer) {
+            rewind_requested = true;
+            attention_flags.fetch_or(AttentionRewind, std::memory_order_relaxed);
+        } else {
+            LOG_WARNING(Core, "Rewinding is disabled");
+        }
+        break;
+    case Signal::MovieSeek:
+        movie_seek_target = param;
+        attention_flags.fetch_or(AttentionMovie, std::memory_order_relaxed);
+        break;
     default:
         break;
     }
 
+    if ((attention_flags.load(std::memory_order_relaxed) & AttentionRewind) && kernel.get() &&
+        !kernel->AreAsyncOperationsPending() &&
+        save_state_request_status == SaveStateStatus::NONE) {
+        attention_flags.fetch_and(~AttentionRewind, std::memory_order_relaxed);
+        if (rewind_requested) {
+            rewind_requested = false;
+            try {
+                RewindToSnapshot();
+            } catch (const std::exception& e) {
+                LOG_ERROR(Core, "Error rewinding: {}", e.what());
+                status_details = e.what();
+                return ResultStatus::ErrorSavestate;
+            }
+            frame_limiter.WaitOnce();
+            return ResultStatus::Success;
+        }
+        TakeRewindSnapshot();
+    }
+
+    if ((attention_flags.load(std::memory_order_relaxed) & AttentionBootSnapshot) &&
+        kernel.get() && !kernel->AreAsyncOperationsPending() &&
+        save_state_request_status == SaveStateStatus::NONE) {
+        attention_flags.fetch_and(~AttentionBootSnapshot, std::memory_order_relaxed);
+        TakeBootSnapshot();
+    }
+
+    if ((attention_flags.load(std::memory_order_relaxed) & AttentionMovie) && kernel.get() &&
+        !kernel->AreAsyncOperationsPending() &&
+        save_state_request_status == SaveStateStatus::NONE) {
+        attention_flags.fetch_and(~AttentionMovie, std::memory_order_relaxed);
+        if (movie_seek_target) {
+            const u64 input_index = *movie_seek_target;
+            movie_seek_target.reset();
+            try {
+                SeekMovie(input_index);
+            } catch (const std::exception& e) {
+                LOG_ERROR(Core, "Error seeking the movie: {}", e.what());
+                status_details = e.what();
+                return ResultStatus::ErrorSavestate;
+            }
+            frame_limiter.WaitOnce();
+            return ResultStatus::Success;
+        }
+        if (movie.GetPlayMode() == Movie::PlayMode::Recording) {
+            TakeMovieCheckpoint();
+        }
+    }
+
     if (save_state_request_status == SaveStateStatus::LOADING && kernel.get() &&
         !kernel->AreAsyncOperationsPending()) {
         const u32 slot = save_state_slot;
-        save_state_request_status = SaveStateStatus::NONE;
+        ClearSaveStateRequest();
         LOG_INFO(Core, "Begin load of slot {}", slot);
         try {
             System::LoadState(slot);
@@ -163,7 +366,7 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
         return ResultStatus::Success;
     } else if (save_state_request_status == SaveStateStatus::SAVING && kernel.get() &&
                !kernel->AreAsyncOperationsPending()) {
-        save_state_request_status = SaveStateStatus::NONE;
+        ClearSaveStateRequest();
         const u32 slot = save_state_slot;
         LOG_INFO(Core, "Begin save to slot {}", slot);
         try {
@@ -179,101 +382,99 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
     } else if (save_state_request_status != SaveStateStatus::NONE &&
                (std::chrono::steady_clock::now() - save_state_request_time) >
                    std::chrono::seconds(5)) {
-        save_state_request_status = SaveStateStatus::NONE;
+        ClearSaveStateRequest();
         LOG_ERROR(Core, "Cannot perform save state operation due to pending async operations");
         status_details = "Cannot perform save state operation due to pending async operations";
         return ResultStatus::ErrorSavestate;
     }
 
-    // All cores should have executed the same amount of ticks. If this is not the case an event was
-    // scheduled with a cycles_into_future smaller then the current downcount.
-    // So we have to get those cores to the same global time first
-    u64 global_ticks = timing->GetGlobalTicks();
-    s64 max_delay = 0;
-    ARM_Interface* current_core_to_execute = nullptr;
-    for (auto& cpu_core : cpu_cores) {
-        if (cpu_core->GetTimer().GetTicks() < global_ticks) {
-            s64 delay = global_ticks - cpu_core->GetTimer().GetTicks();
-            running_core = cpu_core.get();
-            kernel->SetRunningCPU(running_core);
-            cpu_core->GetTimer().Advance();
-            cpu_core->PrepareReschedule();
-            kernel->GetThreadManager(cpu_core->GetID()).Reschedule();
-            cpu_core->GetTimer().SetNextSlice(delay);
-            if (max_delay < delay) {
-                max_delay = delay;
-                current_core_to_execute = cpu_core.get();
-            }
+    return std::nullopt;
+}
+
+void System::ClearSaveStateRequest() {
+    save_state_request_status = SaveStateStatus::NONE;
+    attention_flags.fetch_and(~AttentionSaveState, std::memory_order_relaxed);
+}
+
+bool System::CanRunCoresInParallel(bool tight_loop) const {
+    if (!cpu_workers || !tight_loop || GDBStub::IsServerEnabled()) {
+        return false;
+    }
+    // Memory accesses that miss the page table go through the global current page table, so
+    // only run in parallel while every active core executes threads of the same process.
+    std::shared_ptr<Kernel::Process> process;
+    for (const auto& cpu_core : cpu_cores) {
+        const auto thread = kernel->GetThreadManager(cpu_core->GetID()).GetCurrentThread();
+        if (thread == nullptr) {
+            continue;
         }
+        auto owner = thread->owner_process.lock();
+        if (process && owner != process) {
+            return false;
+        }
+        process = std::move(owner);
     }
+    return true;
+}
 
-    // jit sometimes overshoot by a few ticks which might lead to a minimal desync in the cores.
-    // This small difference shouldn't make it necessary to sync the cores and would only cost
-    // performance. Thus we don't sync delays below min_delay
-    static constexpr s64 min_delay = 100;
-    if (max_delay > min_delay) {
-        LOG_TRACE(Core_ARM11, "Core {} running (delayed) for {} ticks",
-                  current_core_to_execute->GetID(),
-                  current_core_to_execute->GetTimer().GetDowncount());
-        if (running_core != current_core_to_execute) {
-            running_core = current_core_to_execute;
-            kernel->SetRunningCPU(running_core);
-        }
+void System::RunCoresInParallel(s64 max_slice) {
+    boost::container::small_vector<ARM_Interface*, 4> active_cores;
+    for (auto& cpu_core : cpu_cores) {
+        cpu_core->GetTimer().SetNextSlice(max_slice);
+        running_core = cpu_core.get();
+        kernel->SetRunningCPU(running_core);
         if (kernel->GetCurrentThreadManager().GetCurrentThread() == nullptr) {
-            LOG_TRACE(Core_ARM11, "Core {} idling", current_core_to_execute->GetID());
-            current_core_to_execute->GetTimer().Idle();
+            LOG_TRACE(Core_ARM11, "Core {} idling", cpu_core->GetID());
+            cpu_core->GetTimer().Idle();
             PrepareReschedule();
         } else {
-            if (tight_loop) {
-                current_core_to_execute->Run();
-            } else {
-                current_core_to_execute->Step();
-            }
-        }
-    } else {
-        // Now all cores are at the same global time. So we will run them one after the other
-        // with a max slice that is the minimum of all max slices of all cores
-        // TODO: Make special check for idle since we can easily revert the time of idle cores
-        s64 max_slice = Timing::MAX_SLICE_LENGTH;
-        for (const auto& cpu_core : cpu_cores) {
-            running_core = cpu_core.get();
-            kernel->SetRunningCPU(running_core);
-            cpu_core->GetTimer().Advance();
-            cpu_core->PrepareReschedule();
-            kernel->GetThreadManager(cpu_core->GetID()).Reschedule();
-            max_slice = std::min(max_slice, cpu_core->GetTimer().GetMaxSliceLength());
-        }
-        for (auto& cpu_core : cpu_cores) {
-            cpu_core->GetTimer().SetNextSlice(max_slice);
-            auto start_ticks = cpu_core->GetTimer().GetTicks();
-            LOG_TRACE(Core_ARM11, "Core {} running for {} ticks", cpu_core->GetID(),
-                      cpu_core->GetTimer().GetDowncount());
-            running_core = cpu_core.get();
-            kernel->SetRunningCPU(running_core);
-            // If we don't have a currently active thread then don't execute instructions,
-            // instead advance to the next event and try to yield to the next thread
-            if (kernel->GetCurrentThreadManager().GetCurrentThread() == nullptr) {
-                LOG_TRACE(Core_ARM11, "Core {} idling", cpu_core->GetID());
-                cpu_core->GetTimer().Idle();
-                PrepareReschedule();
-            } else {
-                if (tight_loop) {
-                    cpu_core->Run();
-                } else {
-                    cpu_core->Step();
-                }
-            }
-            max_slice = cpu_core->GetTimer().GetTicks() - start_ticks;
+            active_cores.push_back(cpu_core.get());
         }
     }
+    if (active_cores.empty()) {
+        return;
+    }
 
-    if (GDBStub::IsServerEnabled()) {
-        GDBStub::SetCpuStepFlag(false);
+    // Cores drift apart by at most one slice here, the next RunLoop iteration catches up the
+    // cores that ran behind before a new synchronized slice starts.
+    LOG_TRACE(Core_ARM11, "Running {} cores in parallel for {} ticks", active_cores.size(),
+              max_slice);
+    SetRunningCore(active_cores[0]);
+    cores_running_in_parallel = active_cores.size() > 1;
+    for (std::size_t i = 1; i < active_cores.size(); ++i) {
+        cpu_workers->QueueWork([core = active_cores[i]] { core->Run(); });
     }
+    active_cores[0]->Run();
+    cpu_workers->WaitForRequests();
+    cores_running_in_parallel = false;
+}
 
-    Reschedule();
+bool System::CanSkipIdleSlice(ARM_Interface& core) {
+    if (idle_loop_detectors.empty()) {
+        return false;
+    }
+    auto& detector = idle_loop_detectors[core.GetID()];
+    detector.OnSliceStart(kernel->GetThreadManager(core.GetID()).GetCurrentThread(),
+                          core.GetTimer().GetEventsFired());
+    if (!detector.IsIdle()) {
+        return false;
+    }
+    // Another core doing actual work might be the one releasing the loop, keep executing it.
+    for (const auto& other : cpu_cores) {
+        if (other.get() != &core &&
+            kernel->GetThreadManager(other->GetID()).GetCurrentThread() != nullptr &&
+            !idle_loop_detectors[other->GetID()].IsIdle()) {
+            return false;
+        }
+    }
+    return true;
+}
 
-    return status;
+void System::SetRunningCore(ARM_Interface* core) {
+    if (running_core != core) {
+        running_core = core;
+        kernel->SetRunningCPU(core);
+    }
 }
 
 bool System::SendSignal(System::Signal signal, u32 param) {
@@ -284,15 +485,30 @@ bool System::SendSignal(System::Signal signal, u32 param) {
     }
     current_signal = signal;
     signal_param = param;
+    attention_flags.fetch_or(AttentionSignal, std::memory_order_relaxed);
     return true;
 }
 
+void System::SetDebuggerEnabled(bool enabled) {
+    if (enabled) {
+        attention_flags.fetch_or(AttentionDebugger, std::memory_order_relaxed);
+    } else {
+        attention_flags.fetch_and(~AttentionDebugger, std::memory_order_relaxed);
+    }
+}
+
 System::ResultStatus System::SingleStep() {
     return RunLoop(false);
 }
 
 System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::string& filepath,
                                   Frontend::EmuWindow* secondary_window) {
+    using Clock = std::chrono::steady_clock;
+    const auto boot_start = Clock::now();
+    const auto elapsed_ms = [](Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    };
+
     Settings::ResetTemporaryFrameLimit();
     FileUtil::SetCurrentRomPath(filepath);
     if (early_app_loader) {
@@ -343,6 +559,7 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
     if (Settings::values.is_new_3ds) {
         num_cores = 4;
     }
+    const auto init_start = Clock::now();
     ResultStatus init_result{
         Init(emu_window, secondary_window, *memory_mode.first, *n3ds_hw_caps.first, num_cores)};
     if (init_result != ResultStatus::Success) {
@@ -367,6 +584,7 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
         restore_plugin_context.reset();
     }
 
+    const auto load_start = Clock::now();
     std::shared_ptr<Kernel::Process> process;
     const Loader::ResultStatus load_result{app_loader->Load(process)};
     if (Loader::ResultStatus::Success != load_result) {
@@ -393,11 +611,40 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
                   static_cast<u32>(load_result));
     }
 
+    gpu->SwitchShaderDiskCache(title_id);
+
     cheat_engine.LoadCheatFile(title_id);
     cheat_engine.Connect(process->process_id);
 
     perf_stats = std::make_unique<PerfStats>(title_id);
 
+    tick_profile.reset();
+    if (Settings::values.use_tick_profiles) {
+        tick_profile = TickProfile::Load(title_id);
+    }
+    tick_calibrator.reset();
+    if (Settings::values.calibrate_tick_profiles && title_id != 0) {
+        tick_calibrator = std::make_unique<TickCalibrator>();
+    }
+    UpdateCPUClockSpeed();
+
+    const auto title_start = Clock::now();
+    rewind_buffer.reset();
+    rewind_requested = false;
+    movie_seek_target.reset();
+    if (Settings::values.enable_rewind) {
+        u64 rewind_budget = Settings::values.rewind_buffer_size.GetValue() * 1_MiB;
+        if (Common::IsLowMemoryHost() && rewind_budget > LowMemoryRewindBudget) {
+            LOG_INFO(Core, "Limiting the rewind buffer to {} MiB on this low memory host",
+                     LowMemoryRewindBudget >> 20);
+            rewind_budget = LowMemoryRewindBudget;
+        }
+        rewind_buffer = std::make_unique<RewindBuffer>(rewind_budget);
+        rewind_trim_count = Common::GetMemoryTrimCount();
+        ScheduleRewindSnapshot();
+    }
+    StartMovieCheckpoints();
+
     if (Settings::values.dump_textures) {
         custom_tex_manager->PrepareDumping(title_id);
     }
@@ -405,12 +652,24 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
         custom_tex_manager->FindCustomTextures();
     }
 
+    if (Settings::values.reset_to_boot_snapshot) {
+        attention_flags.fetch_or(AttentionBootSnapshot, std::memory_order_relaxed);
+    }
+
     status = ResultStatus::Success;
     m_emu_window = &emu_window;
     m_secondary_window = secondary_window;
     m_filepath = filepath;
     self_delete_pending = false;
 
+    const auto boot_end = Clock::now();
+    LOG_INFO(Core,
+             "Booted {:016X} in {} ms: loader {} ms, system {} ms, application {} ms, "
+             "title data {} ms",
+             title_id, elapsed_ms(boot_start, boot_end), elapsed_ms(boot_start, init_start),
+             elapsed_ms(init_start, load_start), elapsed_ms(load_start, title_start),
+             elapsed_ms(title_start, boot_end));
+
     // Reset counters and set time origin to current frame
     [[maybe_unused]] const PerfStats::Results result = GetAndResetPerfStats();
     perf_stats->BeginSystemFrame();
@@ -423,8 +682,24 @@ void System::PrepareReschedule() {
 }
 
 PerfStats::Results System::GetAndResetPerfStats() {
-    return (perf_stats && timing) ? perf_stats->GetAndResetStats(timing->GetGlobalTimeUs())
-                                  : PerfStats::Results{};
+    if (!perf_stats || !timing) {
+        return PerfStats::Results{};
+    }
+    const auto results = perf_stats->GetAndResetStats(timing->GetGlobalTimeUs());
+    if (tick_calibrator && results.time_vblank_interval > 0) {
+        tick_calibrator->AddSample(results.emulation_speed,
+                                   results.time_remaining / results.time_vblank_interval);
+    }
+    return results;
+}
+
+void System::UpdateCPUClockSpeed() {
+    const u32 percentage = GetEffectiveClockPercentage(
+        Settings::values.cpu_clock_percentage.GetValue(), tick_profile);
+    timing->UpdateClockSpeed(percentage);
+    if (perf_stats) {
+        perf_stats->SetCPUClockPercentage(percentage);
+    }
 }
 
 PerfStats::Results System::GetLastPerfStats() {
@@ -457,6 +732,14 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
 
     timing = std::make_unique<Timing>(num_cores, Settings::values.cpu_clock_percentage.GetValue(),
                                       movie.GetOverrideBaseTicks());
+    // Rewind snapshots are taken between slices like save states, so the event only raises
+    // attention. Save states can carry it into sessions with rewinding disabled.
+    rewind_snapshot_event =
+        timing->RegisterEvent("System::RewindSnapshot", [this](std::uintptr_t, s64) {
+            if (rewind_buffer) {
+                attention_flags.fetch_or(AttentionRewind, std::memory_order_relaxed);
+            }
+        });
 
     kernel = std::make_unique<Kernel::KernelSystem>(
         *memory, *timing, [this] { PrepareReschedule(); }, memory_mode, num_cores, n3ds_hw_caps,
@@ -488,6 +771,13 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
     kernel->SetCPUs(cpu_cores);
     kernel->SetRunningCPU(cpu_cores[0].get());
 
+    if (Settings::values.skip_idle_loops) {
+        idle_loop_detectors.resize(num_cores);
+    }
+    if (Settings::values.parallel_cpu_cores && Settings::values.use_cpu_jit && num_cores > 1) {
+        cpu_workers = std::make_unique<Common::ThreadWorker>(num_cores - 1, "CPUCore");
+    }
+
     const auto audio_emulation = Settings::values.audio_emulation.GetValue();
     if (audio_emulation == Settings::AudioEmulation::HLE) {
         dsp_core = std::make_unique<AudioCore::DspHle>(*this);
@@ -597,6 +887,14 @@ const Cheats::CheatEngine& System::CheatEngine() const {
     return cheat_engine;
 }
 
+void System::PushRPCSubscriptions() {
+#ifdef ENABLE_SCRIPTING
+    if (rpc_server) {
+        rpc_server->PushSubscriptions();
+    }
+#endif
+}
+
 void System::RegisterVideoDumper(std::shared_ptr<VideoDumper::Backend> dumper) {
     video_dumper = std::move(dumper);
 }
@@ -630,16 +928,32 @@ void System::RegisterImageInterface(std::shared_ptr<Frontend::ImageInterface> im
 }
 
 void System::Shutdown(bool is_deserializing) {
+    WaitForSaveStateWrite();
 
     // Shutdown emulation session
     is_powered_on = false;
 
+    if (memory && gpu) {
+        memory->FlushPendingRasterizerInvalidations();
+    }
     gpu.reset();
     if (!is_deserializing) {
         lle_modules.clear();
         GDBStub::Shutdown();
+        if (tick_calibrator) {
+            if (const auto profile = tick_calibrator->Derive(tick_profile)) {
+                LOG_INFO(Core, "Calibrated tick profile for {:016X}: clock {}%", title_id,
+                         profile->clock_percentage);
+                if (!profile->Save(title_id)) {
+                    LOG_ERROR(Core, "Failed to save the tick profile for {:016X}", title_id);
+                }
+            }
+            tick_calibrator.reset();
+        }
         perf_stats.reset();
         app_loader.reset();
+        rewind_buffer.reset();
+        boot_snapshot.reset();
     }
     custom_tex_manager.reset();
 #ifdef ENABLE_SCRIPTING
@@ -648,6 +962,8 @@ void System::Shutdown(bool is_deserializing) {
     archive_manager.reset();
     service_manager.reset();
     dsp_core.reset();
+    cpu_workers.reset();
+    idle_loop_detectors.clear();
     kernel.reset();
     cpu_cores.clear();
     exclusive_monitor.reset();
@@ -672,6 +988,10 @@ void System::Shutdown(bool is_deserializing) {
 }
 
 void System::Reset() {
+    if (RestoreBootSnapshot()) {
+        return;
+    }
+
     // This is NOT a proper reset, but a temporary workaround by shutting down the system and
     // reloading.
     // TODO: Properly implement the reset
@@ -711,7 +1031,7 @@ void System::ApplySettings() {
     }
 
     if (IsPoweredOn()) {
-        CoreTiming().UpdateClockSpeed(Settings::values.cpu_clock_percentage.GetValue());
+        UpdateCPUClockSpeed();
         dsp_core->SetSink(Settings::values.output_type.GetValue(),
                           Settings::values.output_device.GetValue());
         dsp_core->EnableStretching(Settings::values.enable_audio_stretching.GetValue());
@@ -809,6 +1129,7 @@ void System::serialize(Archive& ar, const unsigned int file_version) {
         throw std::runtime_error("LLE audio not supported for save states");
     }
 
+    memory->SetSerializeRam(serialize_ram);
     ar&* memory.get();
     ar&* kernel.get();
     ar&* gpu.get();
@@ -835,7 +1156,9 @@ void System::serialize(Archive& ar, const unsigned int file_version) {
             if (thread) {
                 const std::shared_ptr<Kernel::Process> process = thread->owner_process.lock();
                 if (process) {
+                    gpu->Synchronize();
                     gpu->Renderer().Rasterizer()->SwitchDiskResources(process->codeset->program_id);
+                    gpu->SwitchShaderDiskCache(process->codeset->program_id);
                 }
             }
         }
@@ -8,16 +8,22 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <boost/optional.hpp>
 #include <boost/serialization/version.hpp>
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 #include "core/arm/arm_interface.h"
+#include "core/arm/idle_loop_detector.h"
 #include "core/cheats/cheats.h"
 #include "core/hle/service/apt/applet_manager.h"
 #include "core/hle/service/plgldr/plgldr.h"
 #include "core/movie.h"
 #include "core/perf_stats.h"
+#include "core/savestate.h"
+#include "core/tick_profile.h"
 
 namespace Frontend {
 class EmuWindow;
@@ -74,7 +80,9 @@ namespace Core {
 
 class ARM_Interface;
 class ExclusiveMonitor;
+class RewindBuffer;
 class Timing;
+struct TimingEventType;
 
 class System {
 public:
@@ -132,10 +140,13 @@ public:
     /// Shutdown and then load again
     void Reset();
 
-    enum class Signal : u32 { None, Shutdown, Reset, Save, Load };
+    enum class Signal : u32 { None, Shutdown, Reset, Save, Load, Rewind, MovieSeek };
 
     bool SendSignal(Signal signal, u32 param = 0);
 
+    /// Tells RunLoop whether it has to service the GDB server on every iteration.
+    void SetDebuggerEnabled(bool enabled);
+
     /// Request reset of the system
     void RequestReset(const std::string& chainload = "") {
         m_chainloadpath = chainload;
@@ -177,6 +188,12 @@ public:
         }
     }
 
+    void ReportArticRequests(u32 count, std::chrono::microseconds latency) {
+        if (perf_stats) {
+            perf_stats->AddArticBaseRequests(count, latency);
+        }
+    }
+
     void ReportPerfArticEvent(PerfStats::PerfArticEventBits event, bool set) {
         if (perf_stats) {
             perf_stats->ReportPerfArticEvent(event, set);
@@ -214,6 +231,17 @@ public:
         return static_cast<u32>(cpu_cores.size());
     }
 
+    /// Returns true while the emulated cores are executing concurrently on their own host threads
+    [[nodiscard]] bool IsRunningCoresInParallel() const {
+        return cores_running_in_parallel;
+    }
+
+    /**
+     * Makes the given core the running one. While cores run in parallel, this must be called with
+     * the HLE lock held before entering the kernel on behalf of that core.
+     */
+    void SetRunningCore(ARM_Interface* core);
+
     void InvalidateCacheRange(u32 start_address, std::size_t length) {
         for (const auto& cpu : cpu_cores) {
             cpu->InvalidateCacheRange(start_address, length);
@@ -287,6 +315,15 @@ public:
     /// Gets a const reference to the movie recorder
     [[nodiscard]] const Core::Movie& Movie() const;
 
+    /// Starts the checkpoints of the movie recording that just started, the first one right away.
+    void StartMovieCheckpoints();
+
+    /// Counts an emulated frame towards the next movie checkpoint, called on every VBlank.
+    void CountMovieCheckpointFrame();
+
+    /// Sends the memory subscriptions of the RPC clients, called once per frame.
+    void PushRPCSubscriptions();
+
     /// Video Dumper interface
 
     void RegisterVideoDumper(std::shared_ptr<VideoDumper::Backend> video_dumper);
@@ -356,8 +393,12 @@ public:
         return save_state_status;
     }
 
+    /// Serializes the system and queues the state to be compressed and written to the slot.
     void SaveState(u32 slot) const;
 
+    /// Waits until the save state queued last has been written.
+    void WaitForSaveStateWrite() const;
+
     void LoadState(u32 slot);
 
     /// Self delete ncch
@@ -393,6 +434,57 @@ private:
     /// Reschedule the core emulation
     void Reschedule();
 
+    /// Applies the CPU clock setting combined with the tick profile of the running title
+    void UpdateCPUClockSpeed();
+
+    /// Conditions that make RunLoop leave its fast path, stored in attention_flags.
+    enum AttentionFlag : u32 {
+        AttentionSignal = 1 << 0,       ///< A frontend sent a signal
+        AttentionDebugger = 1 << 1,     ///< The GDB server is enabled
+        AttentionSaveState = 1 << 2,    ///< A save state operation is waiting to be performed
+        AttentionRewind = 1 << 3,       ///< A rewind snapshot is due or stepping back was requested
+        AttentionMovie = 1 << 4,        ///< A movie checkpoint is due or seeking was requested
+        AttentionBootSnapshot = 1 << 5, ///< The title booted and its snapshot was not taken yet
+    };
+
+    /**
+     * Services the GDB server, frontend signals and pending save state operations flagged in
+     * attention. Returns the status RunLoop has to return with, if it can't run the cores.
+     */
+    std::optional<ResultStatus> HandleAttention(u32 attention, bool& tight_loop);
+
+    void ClearSaveStateRequest();
+
+    /// Schedules the event that raises attention once the next rewind snapshot is due.
+    void ScheduleRewindSnapshot();
+
+    /// Stores the system in the rewind buffer, disables rewinding if it can't be serialized.
+    void TakeRewindSnapshot();
+
+    /// Restores the newest rewind snapshot and removes it from the rewind buffer.
+    void RewindToSnapshot();
+
+    /// Keeps the system as it is right after booting for resets to restore.
+    void TakeBootSnapshot();
+
+    /// Restores the boot snapshot, returns false if the title has to be booted again instead.
+    bool RestoreBootSnapshot();
+
+    /// Stores the system as a checkpoint in the movie being recorded.
+    void TakeMovieCheckpoint();
+
+    /// Loads the newest movie checkpoint before the input index if needed, then plays up to it.
+    void SeekMovie(u64 input_index);
+
+    /// Returns true if the current slice can be executed with one host thread per core
+    [[nodiscard]] bool CanRunCoresInParallel(bool tight_loop) const;
+
+    /// Runs all cores for the given slice length, each on its own host thread
+    void RunCoresInParallel(s64 max_slice);
+
+    /// Returns true if the core is spinning in an idle loop and its next slice can be skipped
+    [[nodiscard]] bool CanSkipIdleSlice(ARM_Interface& core);
+
     /// AppLoader used to load the current executing application
     std::unique_ptr<Loader::AppLoader> app_loader;
 
@@ -403,6 +495,36 @@ private:
     std::vector<std::shared_ptr<ARM_Interface>> cpu_cores;
     ARM_Interface* running_core = nullptr;
 
+    /// Host threads used to execute the secondary cores when parallel_cpu_cores is enabled
+    std::unique_ptr<Common::ThreadWorker> cpu_workers;
+    std::atomic_bool cores_running_in_parallel{};
+
+    /// Tick profile of the running title, if any
+    std::optional<TickProfile> tick_profile;
+    /// Collects samples to derive a tick profile when calibrate_tick_profiles is enabled
+    std::unique_ptr<TickCalibrator> tick_calibrator;
+
+    /// In-memory snapshots to step back through, null unless enable_rewind is set
+    std::unique_ptr<RewindBuffer> rewind_buffer;
+    /// Raises AttentionRewind when a rewind snapshot is due
+    TimingEventType* rewind_snapshot_event{};
+    /// Whether the frontend asked to step back to the newest rewind snapshot
+    bool rewind_requested{};
+    /// Memory trim count last handled by dropping the rewind snapshots
+    u64 rewind_trim_count{};
+    /// Frames emulated since the last checkpoint of the movie being recorded
+    u32 movie_checkpoint_frames{};
+    /// Input index the frontend asked the movie being played back to seek to
+    std::optional<u64> movie_seek_target;
+    /// The system right after booting, null unless reset_to_boot_snapshot is set. Kept across
+    /// resets, which restore it instead of booting the title again.
+    std::unique_ptr<BootSnapshot> boot_snapshot;
+    /// Whether serialization includes the RAM, which rewind snapshots store on their own
+    mutable bool serialize_ram = true;
+
+    /// Per core idle loop detection state, empty unless skip_idle_loops is enabled
+    std::vector<IdleLoopDetector> idle_loop_detectors;
+
     /// DSP core
     std::unique_ptr<AudioCore::DspInterface> dsp_core;
 
@@ -455,6 +577,10 @@ private:
     SaveStateStatus save_state_request_status = SaveStateStatus::NONE;
     u32 save_state_slot = 0;
     std::chrono::steady_clock::time_point save_state_request_time{};
+    /// Compresses and writes serialized save states off the emulation thread.
+    mutable std::unique_ptr<Common::ThreadWorker> save_state_writer;
+    /// Page hashes of the bases of incremental save states, by the path of their slot
+    mutable std::unordered_map<std::string, SaveStateBase> save_state_bases;
 
     ResultStatus status = ResultStatus::Success;
     std::string status_details = "";
@@ -469,6 +595,7 @@ private:
     std::mutex signal_mutex;
     Signal current_signal;
     u32 signal_param;
+    std::atomic<u32> attention_flags{};
 
     std::function<bool()> mic_permission_func;
     bool mic_permission_granted = false;
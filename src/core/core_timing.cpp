@@ -21,6 +21,167 @@ bool Timing::Event::operator<(const Timing::Event& right) const {
     return std::tie(time, fifo_order) < std::tie(right.time, right.fifo_order);
 }
 
+void Timing::EventQueue::Push(const Event& event) {
+    u32 slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot].event = event;
+    } else {
+        slot = static_cast<u32>(slots.size());
+        slots.push_back(Slot{event, 0, InvalidSlot, InvalidSlot});
+    }
+    LinkKey(slot);
+    heap.push_back(slot);
+    slots[slot].heap_index = static_cast<u32>(heap.size() - 1);
+    SiftUp(heap.size() - 1);
+}
+
+Timing::Event Timing::EventQueue::Pop() {
+    ASSERT(!heap.empty());
+    Event event = slots[heap.front()].event;
+    EraseAt(0);
+    return event;
+}
+
+std::size_t Timing::EventQueue::Remove(const TimingEventType* type, std::uintptr_t user_data) {
+    const auto it = key_heads.find(Key{type, user_data});
+    if (it == key_heads.end()) {
+        return 0;
+    }
+    std::size_t removed = 0;
+    u32 slot = it->second;
+    while (slot != InvalidSlot) {
+        const u32 next = slots[slot].next_in_key;
+        EraseAt(slots[slot].heap_index);
+        slot = next;
+        ++removed;
+    }
+    return removed;
+}
+
+std::size_t Timing::EventQueue::Remove(const TimingEventType* type) {
+    std::vector<u32> matches;
+    for (const u32 slot : heap) {
+        if (slots[slot].event.type == type) {
+            matches.push_back(slot);
+        }
+    }
+    for (const u32 slot : matches) {
+        EraseAt(slots[slot].heap_index);
+    }
+    return matches.size();
+}
+
+void Timing::EventQueue::Clear() {
+    slots.clear();
+    free_slots.clear();
+    heap.clear();
+    key_heads.clear();
+}
+
+std::vector<Timing::Event> Timing::EventQueue::ToVector() const {
+    std::vector<Event> events;
+    events.reserve(heap.size());
+    for (const u32 slot : heap) {
+        events.push_back(slots[slot].event);
+    }
+    return events;
+}
+
+void Timing::EventQueue::Assign(const std::vector<Event>& events) {
+    Clear();
+    slots.reserve(events.size());
+    heap.reserve(events.size());
+    for (const Event& event : events) {
+        Push(event);
+    }
+}
+
+void Timing::EventQueue::SiftUp(std::size_t index) {
+    const u32 slot = heap[index];
+    while (index > 0) {
+        const std::size_t parent = (index - 1) / Arity;
+        if (!Less(slot, heap[parent])) {
+            break;
+        }
+        Place(index, heap[parent]);
+        index = parent;
+    }
+    Place(index, slot);
+}
+
+void Timing::EventQueue::SiftDown(std::size_t index) {
+    const u32 slot = heap[index];
+    const std::size_t size = heap.size();
+    while (true) {
+        const std::size_t first_child = index * Arity + 1;
+        if (first_child >= size) {
+            break;
+        }
+        const std::size_t last_child = std::min(first_child + Arity, size);
+        std::size_t best = first_child;
+        for (std::size_t child = first_child + 1; child < last_child; ++child) {
+            if (Less(heap[child], heap[best])) {
+                best = child;
+            }
+        }
+        if (!Less(heap[best], slot)) {
+            break;
+        }
+        Place(index, heap[best]);
+        index = best;
+    }
+    Place(index, slot);
+}
+
+void Timing::EventQueue::Place(std::size_t index, u32 slot) {
+    heap[index] = slot;
+    slots[slot].heap_index = static_cast<u32>(index);
+}
+
+void Timing::EventQueue::EraseAt(std::size_t index) {
+    const u32 slot = heap[index];
+    const u32 last = heap.back();
+    heap.pop_back();
+    if (index < heap.size()) {
+        Place(index, last);
+        SiftUp(index);
+        SiftDown(slots[last].heap_index);
+    }
+    UnlinkKey(slot);
+    free_slots.push_back(slot);
+}
+
+void Timing::EventQueue::LinkKey(u32 slot) {
+    Slot& entry = slots[slot];
+    const auto [it, inserted] =
+        key_heads.try_emplace(Key{entry.event.type, entry.event.user_data}, slot);
+    entry.prev_in_key = InvalidSlot;
+    entry.next_in_key = inserted ? InvalidSlot : it->second;
+    if (!inserted) {
+        slots[it->second].prev_in_key = slot;
+        it->second = slot;
+    }
+}
+
+void Timing::EventQueue::UnlinkKey(u32 slot) {
+    const Slot& entry = slots[slot];
+    if (entry.next_in_key != InvalidSlot) {
+        slots[entry.next_in_key].prev_in_key = entry.prev_in_key;
+    }
+    if (entry.prev_in_key != InvalidSlot) {
+        slots[entry.prev_in_key].next_in_key = entry.next_in_key;
+        return;
+    }
+    const Key key{entry.event.type, entry.event.user_data};
+    if (entry.next_in_key != InvalidSlot) {
+        key_heads[key] = entry.next_in_key;
+    } else {
+        key_heads.erase(key);
+    }
+}
+
 Timing::Timing(std::size_t num_cores, u32 cpu_clock_percentage, s64 override_base_ticks) {
     // Generate non-zero base tick count to simulate time the system ran before launching the game.
     // This accounts for games that rely on the system tick to seed randomness.
@@ -92,9 +253,7 @@ void Timing::ScheduleEvent(s64 cycles_into_future, const TimingEventType* event_
             if (!timer->is_timer_sane)
                 timer->ForceExceptionCheck(cycles_into_future);
 
-            timer->event_queue.emplace_back(
-                Event{timeout, timer->event_fifo_id++, user_data, event_type});
-            std::push_heap(timer->event_queue.begin(), timer->event_queue.end(), std::greater<>());
+            timer->event_queue.Push(Event{timeout, timer->event_fifo_id++, user_data, event_type});
         } else {
             timer->ts_queue.Push(Event{static_cast<s64>(timer->GetTicks() + cycles_into_future), 0,
                                        user_data, event_type});
@@ -106,16 +265,8 @@ void Timing::UnscheduleEvent(const TimingEventType* event_type, std::uintptr_t u
     if (event_queue_locked) {
         return;
     }
-    for (auto timer : timers) {
-        auto itr = std::remove_if(
-            timer->event_queue.begin(), timer->event_queue.end(),
-            [&](const Event& e) { return e.type == event_type && e.user_data == user_data; });
-
-        // Removing random items breaks the invariant so we have to re-establish it.
-        if (itr != timer->event_queue.end()) {
-            timer->event_queue.erase(itr, timer->event_queue.end());
-            std::make_heap(timer->event_queue.begin(), timer->event_queue.end(), std::greater<>());
-        }
+    for (auto& timer : timers) {
+        timer->event_queue.Remove(event_type, user_data);
     }
     // TODO:remove events from ts_queue
 }
@@ -124,15 +275,8 @@ void Timing::RemoveEvent(const TimingEventType* event_type) {
     if (event_queue_locked) {
         return;
     }
-    for (auto timer : timers) {
-        auto itr = std::remove_if(timer->event_queue.begin(), timer->event_queue.end(),
-                                  [&](const Event& e) { return e.type == event_type; });
-
-        // Removing random items breaks the invariant so we have to re-establish it.
-        if (itr != timer->event_queue.end()) {
-            timer->event_queue.erase(itr, timer->event_queue.end());
-            std::make_heap(timer->event_queue.begin(), timer->event_queue.end(), std::greater<>());
-        }
+    for (auto& timer : timers) {
+        timer->event_queue.Remove(event_type);
     }
     // TODO:remove events from ts_queue
 }
@@ -153,6 +297,32 @@ s64 Timing::GetGlobalTicks() const {
     return (*timer)->GetTicks();
 }
 
+void Timing::UpdateSliceLimit(bool host_request_pending) {
+    if (!Settings::values.adaptive_slice_length) {
+        slice_limit = MAX_SLICE_LENGTH;
+        return;
+    }
+
+    u64 events_fired = 0;
+    u64 host_events_received = 0;
+    for (const auto& timer : timers) {
+        events_fired += timer->GetEventsFired();
+        host_events_received += timer->GetHostEventsReceived();
+    }
+    const bool events_dispatched = events_fired != last_events_fired;
+    const bool host_events_arrived = host_events_received != last_host_events_received;
+    last_events_fired = events_fired;
+    last_host_events_received = host_events_received;
+
+    if (host_request_pending || host_events_arrived) {
+        slice_limit = MIN_ADAPTIVE_SLICE_LENGTH;
+    } else if (events_dispatched) {
+        slice_limit = std::min<s64>(slice_limit * 2, MAX_SLICE_LENGTH);
+    } else {
+        slice_limit = std::min(slice_limit * 2, MAX_ADAPTIVE_SLICE_LENGTH);
+    }
+}
+
 std::chrono::microseconds Timing::GetGlobalTimeUs() const {
     return std::chrono::microseconds{GetGlobalTicks() * 1000000 / BASE_CLOCK_RATE_ARM11};
 }
@@ -193,17 +363,17 @@ void Timing::Timer::ForceExceptionCheck(s64 cycles) {
 
 void Timing::Timer::MoveEvents() {
     for (Event ev; ts_queue.Pop(ev);) {
+        ++host_events_received;
         ev.fifo_order = event_fifo_id++;
-        event_queue.emplace_back(std::move(ev));
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        event_queue.Push(ev);
     }
 }
 
 s64 Timing::Timer::GetMaxSliceLength() const {
-    const auto& next_event = event_queue.begin();
-    if (next_event != event_queue.end()) {
-        ASSERT(next_event->time - executed_ticks > 0);
-        return next_event->time - executed_ticks;
+    if (!event_queue.Empty()) {
+        const Event& next_event = event_queue.Top();
+        ASSERT(next_event.time - executed_ticks > 0);
+        return next_event.time - executed_ticks;
     }
     return MAX_SLICE_LENGTH;
 }
@@ -219,10 +389,9 @@ void Timing::Timer::Advance() {
 
     is_timer_sane = true;
 
-    while (!event_queue.empty() && event_queue.front().time <= executed_ticks) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+    while (!event_queue.Empty() && event_queue.Top().time <= executed_ticks) {
+        const Event evt = event_queue.Pop();
+        ++events_fired;
         if (evt.type->callback != nullptr) {
             evt.type->callback(evt.user_data, static_cast<int>(executed_ticks - evt.time));
         } else {
@@ -237,9 +406,9 @@ void Timing::Timer::SetNextSlice(s64 max_slice_length) {
     slice_length = max_slice_length;
 
     // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
+    if (!event_queue.Empty()) {
         slice_length = static_cast<int>(
-            std::min<s64>(event_queue.front().time - executed_ticks, max_slice_length));
+            std::min<s64>(event_queue.Top().time - executed_ticks, max_slice_length));
     }
 
     downcount = slice_length;
@@ -26,6 +26,7 @@
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/vector.hpp>
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/threadsafe_queue.h"
 #include "core/global.h"
@@ -175,6 +176,92 @@ public:
         BOOST_SERIALIZATION_SPLIT_MEMBER()
     };
 
+    /**
+     * Min-heap of pending events ordered by (time, fifo_order).
+     * Events live in stable slots and the 4-ary heap only shuffles slot indices, so every slot
+     * knows its own heap position. Slots sharing the same (type, user_data) pair are chained in
+     * an intrusive list, which lets UnscheduleEvent() remove them in O(log n) each instead of
+     * scanning and re-heapifying the whole queue.
+     */
+    class EventQueue {
+    public:
+        bool Empty() const {
+            return heap.empty();
+        }
+
+        std::size_t Size() const {
+            return heap.size();
+        }
+
+        /// Returns the earliest pending event. The queue must not be empty.
+        const Event& Top() const {
+            return slots[heap.front()].event;
+        }
+
+        void Push(const Event& event);
+
+        /// Removes and returns the earliest pending event. The queue must not be empty.
+        Event Pop();
+
+        /// Removes all events matching the given type and user data, returns the removed count.
+        std::size_t Remove(const TimingEventType* type, std::uintptr_t user_data);
+
+        /// Removes all events of the given type regardless of their user data.
+        std::size_t Remove(const TimingEventType* type);
+
+        void Clear();
+
+        /// Returns a copy of the pending events in heap order.
+        std::vector<Event> ToVector() const;
+
+        /// Replaces the contents of the queue with the given events.
+        void Assign(const std::vector<Event>& events);
+
+    private:
+        static constexpr std::size_t Arity = 4;
+        static constexpr u32 InvalidSlot = std::numeric_limits<u32>::max();
+
+        struct Slot {
+            Event event;
+            u32 heap_index;
+            u32 prev_in_key;
+            u32 next_in_key;
+        };
+
+        struct Key {
+            const TimingEventType* type;
+            std::uintptr_t user_data;
+
+            bool operator==(const Key& other) const {
+                return type == other.type && user_data == other.user_data;
+            }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key& key) const noexcept {
+                const u64 type = reinterpret_cast<std::uintptr_t>(key.type);
+                return static_cast<std::size_t>(
+                    Common::HashCombine(type, static_cast<u64>(key.user_data)));
+            }
+        };
+
+        bool Less(u32 lhs, u32 rhs) const {
+            return slots[lhs].event < slots[rhs].event;
+        }
+
+        void SiftUp(std::size_t index);
+        void SiftDown(std::size_t index);
+        void Place(std::size_t index, u32 slot);
+        void EraseAt(std::size_t index);
+        void LinkKey(u32 slot);
+        void UnlinkKey(u32 slot);
+
+        std::vector<Slot> slots;
+        std::vector<u32> free_slots;
+        std::vector<u32> heap;
+        std::unordered_map<Key, u32, KeyHash> key_heads;
+    };
+
     // currently Service::HID::pad_update_ticks is the smallest interval for an event that gets
     // always scheduled. Therfore we use this as orientation for the MAX_SLICE_LENGTH
     // For performance bigger slice length are desired, though this will lead to cores desync
@@ -183,6 +270,10 @@ public:
     // scheduled and repated.
     static constexpr int MAX_SLICE_LENGTH = BASE_CLOCK_RATE_ARM11 / 234;
 
+    // Bounds of the slice limit when adaptive slice lengths are enabled.
+    static constexpr s64 MIN_ADAPTIVE_SLICE_LENGTH = MAX_SLICE_LENGTH / 4;
+    static constexpr s64 MAX_ADAPTIVE_SLICE_LENGTH = MAX_SLICE_LENGTH * 4;
+
     class Timer {
     public:
         Timer(s64 base_ticks = 0);
@@ -199,6 +290,16 @@ public:
         u64 GetTicks() const;
         u64 GetIdleTicks() const;
 
+        /// Returns the number of events this timer has dispatched so far
+        u64 GetEventsFired() const {
+            return events_fired;
+        }
+
+        /// Returns the number of events this timer has received from other threads so far
+        u64 GetHostEventsReceived() const {
+            return host_events_received;
+        }
+
         void AddTicks(u64 ticks);
 
         s64 GetDowncount() const;
@@ -209,11 +310,10 @@ public:
 
     private:
         friend class Timing;
-        // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-        // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-        // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-        // accommodated by the standard adaptor class.
-        std::vector<Event> event_queue;
+        // An indexed 4-ary heap rather than std::priority_queue, because we need to be able to
+        // serialize, unserialize and erase arbitrary events (RemoveEvent()) regardless of the
+        // queue order. These aren't accommodated by the standard adaptor class.
+        EventQueue event_queue;
         u64 event_fifo_id = 0;
         // the queue for storing the events from other threads threadsafe until they will be added
         // to the event_queue by the emu thread
@@ -231,6 +331,8 @@ public:
         s64 downcount = MAX_SLICE_LENGTH;
         s64 executed_ticks = 0;
         u64 idled_cycles = 0;
+        u64 events_fired = 0;
+        u64 host_events_received = 0;
 
         // Stores a scaling for the internal clockspeed. Changing this number results in
         // under/overclocking the guest cpu
@@ -239,7 +341,15 @@ public:
         template <class Archive>
         void serialize(Archive& ar, const unsigned int) {
             MoveEvents();
-            ar & event_queue;
+            // Serialized as a plain vector of events to keep the savestate layout unchanged.
+            std::vector<Event> events;
+            if (!Archive::is_loading::value) {
+                events = event_queue.ToVector();
+            }
+            ar & events;
+            if (Archive::is_loading::value) {
+                event_queue.Assign(events);
+            }
             ar & event_fifo_id;
             ar & slice_length;
             ar & downcount;
@@ -285,6 +395,20 @@ public:
 
     std::shared_ptr<Timer> GetTimer(std::size_t cpu_id);
 
+    /// Returns the longest slice the cores may run for before returning to the dispatcher loop.
+    s64 GetSliceLimit() const {
+        return slice_limit;
+    }
+
+    /**
+     * Adapts the slice limit after a dispatcher loop iteration. Slices grow while no events are
+     * dispatched, return to MAX_SLICE_LENGTH once events fire again and shrink below it while
+     * other threads hand work to the emulated system, so it gets picked up with less latency.
+     * Has no effect unless adaptive slice lengths are enabled.
+     * @param host_request_pending Whether the frontend is waiting on the dispatcher loop
+     */
+    void UpdateSliceLimit(bool host_request_pending);
+
     // Used after deserializing to unprotect the event queue.
     void UnlockEventQueue() {
         event_queue_locked = false;
@@ -301,6 +425,10 @@ private:
     std::vector<std::shared_ptr<Timer>> timers;
     Timer* current_timer = nullptr;
 
+    s64 slice_limit = MAX_SLICE_LENGTH;
+    u64 last_events_fired = 0;
+    u64 last_host_events_received = 0;
+
     // When true, the event queue can't be modified. Used while deserializing to workaround
     // destructor side effects.
     bool event_queue_locked = false;
@@ -204,11 +204,11 @@ public:
 
     u64 GetOpenDelayNs() {
         if (delay_generator != nullptr) {
-            return delay_generator->GetOpenDelayNs();
+            return delay_generator->GetConfiguredOpenDelayNs();
         }
         LOG_ERROR(Service_FS, "Delay generator was not initalized. Using default");
         delay_generator = std::make_unique<DefaultDelayGenerator>();
-        return delay_generator->GetOpenDelayNs();
+        return delay_generator->GetConfiguredOpenDelayNs();
     }
 
     virtual Result SetSaveDataSecureValue(u32 secure_value_slot, u64 secure_value, bool flush) {
@@ -10,6 +10,7 @@
 #include "common/common_types.h"
 #include "common/file_util.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/file_sys/archive_artic.h"
 #include "core/file_sys/archive_extsavedata.h"
 #include "core/file_sys/disk_archive.h"
@@ -30,7 +31,8 @@ class FixSizeDiskFile : public DiskFile {
 public:
     FixSizeDiskFile(FileUtil::IOFile&& file, const Mode& mode,
                     std::unique_ptr<DelayGenerator> delay_generator_)
-        : DiskFile(std::move(file), mode, std::move(delay_generator_)) {
+        : DiskFile(std::move(file), mode, std::move(delay_generator_),
+                   Settings::values.save_data_write_back.GetValue()) {
         size = GetSize();
     }
 
@@ -86,6 +88,10 @@ public:
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "extsavedata";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
@@ -40,6 +40,10 @@ public:
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "sdmc";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
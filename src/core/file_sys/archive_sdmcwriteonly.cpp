@@ -37,6 +37,10 @@ public:
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "sdmcwriteonly";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include "artic_cache.h"
+#include "common/hash.h"
+#include "common/memory_detect.h"
 
 namespace FileSys {
 ResultVal<std::size_t> ArticCache::Read(s32 file_handle, std::size_t offset, std::size_t length,
@@ -10,6 +12,7 @@ ResultVal<std::size_t> ArticCache::Read(s32 file_handle, std::size_t offset, std
     if (length == 0)
         return size_t();
 
+    TrimIfRequested();
     const auto segments = BreakupRead(offset, length);
     std::size_t read_progress = 0;
 
@@ -65,20 +68,49 @@ ResultVal<std::size_t> ArticCache::Read(s32 file_handle, std::size_t offset, std
 
     // TODO(PabloMK7): Make cache thread safe, read the comment in CacheReady function.
     std::unique_lock read_guard(cache_mutex);
-    for (const auto& seg : segments) {
-        std::size_t read_size = cache_line_size;
-        std::size_t page = OffsetToPage(seg.first);
-        // Check if segment is in cache
-        auto cache_entry = cache.request(page);
-        if (!cache_entry.first) {
-            // If not found, read from artic and cache the data
-            auto res = ReadFromArtic(file_handle, cache_entry.second.data(), read_size, page);
-            if (res.Failed())
-                return res;
-            read_size = res.Unwrap();
-            LOG_TRACE(Service_FS, "ArticCache MISS: page={}, length={}, into={}", page, seg.second,
-                      (seg.first - page));
-        } else {
+    std::array<std::pair<bool, std::array<u8, cache_line_size>*>, max_breakup_pages> entries;
+    std::array<std::size_t, max_breakup_pages> read_sizes;
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        auto cache_entry = cache.request(OffsetToPage(segments[i].first));
+        entries[i] = {cache_entry.first, &cache_entry.second};
+        read_sizes[i] = cache_line_size;
+    }
+
+    std::array<u8, max_breakup_pages * cache_line_size> run_buffer;
+    // Consecutive pages missing from the cache are read together instead of one by one.
+    for (std::size_t first = 0; first < segments.size(); first++) {
+        if (entries[first].first) {
+            continue;
+        }
+        std::size_t last = first;
+        while (last + 1 < segments.size() && !entries[last + 1].first) {
+            last++;
+        }
+        const std::size_t page = OffsetToPage(segments[first].first);
+        const std::size_t run_length = (last - first + 1) * cache_line_size;
+        u8* destination = first == last ? entries[first].second->data() : run_buffer.data();
+        auto res = ReadFromArtic(file_handle, destination, run_length, page);
+        if (res.Failed())
+            return res;
+        const std::size_t run_read = res.Unwrap();
+        for (std::size_t i = first; i <= last; i++) {
+            const std::size_t page_start = (i - first) * cache_line_size;
+            read_sizes[i] = std::min(run_read - std::min(run_read, page_start), cache_line_size);
+            if (first != last) {
+                std::memcpy(entries[i].second->data(), run_buffer.data() + page_start,
+                            read_sizes[i]);
+            }
+        }
+        LOG_TRACE(Service_FS, "ArticCache MISS: page={}, pages={}", page, last - first + 1);
+        first = last;
+    }
+
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        const auto& seg = segments[i];
+        const std::size_t read_size = read_sizes[i];
+        const std::size_t page = OffsetToPage(seg.first);
+        const auto& cache_entry = *entries[i].second;
+        if (entries[i].first) {
             LOG_TRACE(Service_FS, "ArticCache HIT: page={}, length={}, into={}", page, seg.second,
                       (seg.first - page));
         }
@@ -86,8 +118,7 @@ ResultVal<std::size_t> ArticCache::Read(s32 file_handle, std::size_t offset, std
             (read_size > (seg.first - page))
                 ? std::min((seg.first - page) + seg.second, read_size) - (seg.first - page)
                 : 0;
-        std::memcpy(buffer + read_progress, cache_entry.second.data() + (seg.first - page),
-                    copy_amount);
+        std::memcpy(buffer + read_progress, cache_entry.data() + (seg.first - page), copy_amount);
         read_progress += copy_amount;
     }
     return read_progress;
@@ -115,11 +146,38 @@ void ArticCache::Clear() {
     data_size = std::nullopt;
 }
 
+void ArticCache::TrimIfRequested() {
+    const u64 trim_count = Common::GetMemoryTrimCount();
+    if (memory_trim_count.exchange(trim_count) == trim_count) {
+        return;
+    }
+    // The small cache is a fixed array, only the big reads hold memory of their own.
+    std::unique_lock l1(big_cache_mutex), l2(very_big_cache_mutex);
+    big_cache.reset();
+    very_big_cache.reset();
+}
+
+void ArticCache::OpenDiskCache(s32 file_handle, u64 program_id, const std::string& path) {
+    auto size = GetSize(file_handle);
+    if (size.Failed())
+        return;
+
+    std::array<u8, ArticDiskCache::PageSize> first_page;
+    auto res = ReadFromServer(file_handle, first_page.data(), first_page.size(), 0);
+    if (res.Failed())
+        return;
+
+    const u64 content_hash = Common::ComputeHash64(first_page.data(), res.Unwrap());
+    disk_cache = ArticDiskCache::Open(path, program_id, size.Unwrap(), content_hash);
+}
+
 ResultVal<size_t> ArticCache::Write(s32 file_handle, std::size_t offset, std::size_t length,
                                     const u8* buffer, u32 flags) {
     // Can probably do better, but write operations are usually done at the end, so it doesn't
     // matter much
     Clear();
+    if (disk_cache)
+        disk_cache->Invalidate();
 
     size_t written_amount = 0;
     while (written_amount != length) {
@@ -182,33 +240,74 @@ ResultVal<size_t> ArticCache::GetSize(s32 file_handle) {
 
 ResultVal<size_t> ArticCache::ReadFromArtic(s32 file_handle, u8* buffer, size_t len,
                                             size_t offset) {
+    if (!disk_cache)
+        return ReadFromServer(file_handle, buffer, len, offset);
+
+    // Only the pages missing on disk are read from the server, in chunks the size of a big read.
+    std::vector<u8> chunk;
+    for (const auto& [range_offset, range_length] : disk_cache->MissingRanges(offset, len)) {
+        for (size_t done = 0; done < range_length; done += big_cache_skip) {
+            chunk.resize(std::min(big_cache_skip, range_length - done));
+            auto res = ReadFromServer(file_handle, chunk.data(), chunk.size(), range_offset + done);
+            if (res.Failed())
+                return res;
+            disk_cache->Write(range_offset + done, res.Unwrap(), chunk.data());
+            if (res.Unwrap() != chunk.size())
+                break;
+        }
+    }
+
+    const size_t cached_size = disk_cache->GetDataSize();
+    const size_t expected = std::min(len, cached_size - std::min(offset, cached_size));
+    const size_t read_amount = disk_cache->Read(offset, len, buffer);
+    if (read_amount != expected) {
+        LOG_WARNING(Service_FS, "ArticCache disk read incomplete: offset={}, length={}", offset,
+                    len);
+        return ReadFromServer(file_handle, buffer, len, offset);
+    }
+    return read_amount;
+}
+
+ResultVal<size_t> ArticCache::ReadFromServer(s32 file_handle, u8* buffer, size_t len,
+                                             size_t offset) {
+    const size_t max_read = client->GetServerRequestMaxSize() - 0x100;
     size_t read_amount = 0;
     while (read_amount != len) {
-        size_t to_read =
-            std::min<size_t>(client->GetServerRequestMaxSize() - 0x100, len - read_amount);
+        // Reads bigger than a request are split in several requests sent together.
+        std::vector<Network::ArticBase::Client::Request> requests;
+        std::vector<size_t> request_sizes;
+        for (size_t queued = read_amount; queued != len && requests.size() < max_pipelined_reads;) {
+            const size_t to_read = std::min<size_t>(max_read, len - queued);
+            auto& req = requests.emplace_back(client->NewRequest("FSFILE_Read"));
+            req.AddParameterS32(file_handle);
+            req.AddParameterS64(static_cast<s64>(offset + queued));
+            req.AddParameterS32(static_cast<s32>(to_read));
+            request_sizes.push_back(to_read);
+            queued += to_read;
+        }
 
-        auto req = client->NewRequest("FSFILE_Read");
-        req.AddParameterS32(file_handle);
-        req.AddParameterS64(static_cast<s64>(offset + read_amount));
-        req.AddParameterS32(static_cast<s32>(to_read));
-        auto resp = client->Send(req);
-        if (!resp.has_value() || !resp->Succeeded())
-            return Result(-1);
+        auto responses = client->SendMultiple(requests);
+        for (size_t i = 0; i < responses.size(); i++) {
+            auto& resp = responses[i];
+            if (!resp.has_value() || !resp->Succeeded())
+                return Result(-1);
 
-        auto res = Result(static_cast<u32>(resp->GetMethodResult()));
-        if (res.IsError())
-            return res;
+            auto res = Result(static_cast<u32>(resp->GetMethodResult()));
+            if (res.IsError())
+                return res;
 
-        auto read_buff = resp->GetResponseBuffer(0);
-        size_t actually_read = 0;
-        if (read_buff.has_value()) {
-            actually_read = read_buff->second;
-            memcpy(buffer + read_amount, read_buff->first, actually_read);
-        }
+            auto read_buff = resp->GetResponseBuffer(0);
+            size_t actually_read = 0;
+            if (read_buff.has_value()) {
+                actually_read = std::min(read_buff->second, request_sizes[i]);
+                memcpy(buffer + read_amount, read_buff->first, actually_read);
+            }
 
-        read_amount += actually_read;
-        if (actually_read != to_read)
-            break;
+            read_amount += actually_read;
+            // The data of the requests after a short read does not follow on from it.
+            if (actually_read != request_sizes[i])
+                return read_amount;
+        }
     }
     return read_amount;
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <shared_mutex>
 #include "vector"
 
@@ -15,6 +16,7 @@
 #include "common/common_types.h"
 #include "common/static_lru_cache.h"
 #include "core/file_sys/archive_backend.h"
+#include "core/file_sys/artic_disk_cache.h"
 #include "core/hle/result.h"
 #include "network/artic_base/artic_base_client.h"
 
@@ -41,15 +43,27 @@ public:
         data_size = size;
     }
 
+    /**
+     * Keeps the file in an on-disk cache at path from now on, so that later sessions read it
+     * locally instead of from the server. The cache is validated against the file size and the
+     * contents of its first page.
+     */
+    void OpenDiskCache(s32 file_handle, u64 program_id, const std::string& path);
+
 private:
     std::shared_ptr<Network::ArticBase::Client> client;
     std::optional<size_t> data_size;
+    std::unique_ptr<ArticDiskCache> disk_cache;
 
     // Total cache size: 32MB small, 512MB big (worst case), 160MB very big (worst case).
     // The worst case values are unrealistic, they will never happen in any real game.
     static constexpr std::size_t cache_line_size = 4 * 1024;
     static constexpr std::size_t cache_line_count = 256;
     static constexpr std::size_t max_breakup_size = 8 * 1024;
+    // Most pages a read broken up in cache lines can touch.
+    static constexpr std::size_t max_breakup_pages = max_breakup_size / cache_line_size + 1;
+    // Most read requests in flight at once, bounding the server work memory they need.
+    static constexpr std::size_t max_pipelined_reads = 4;
 
     static constexpr std::size_t big_cache_skip = 1 * 1024 * 1024;
     static constexpr std::size_t big_cache_lines = 1024;
@@ -75,8 +89,14 @@ private:
                            very_big_cache_lines>
         very_big_cache;
     std::shared_mutex very_big_cache_mutex;
+    /// Memory trim count last handled by releasing the big caches.
+    std::atomic<u64> memory_trim_count{};
+
+    /// Releases the big caches if a memory trim was requested since the last read.
+    void TrimIfRequested();
 
     ResultVal<std::size_t> ReadFromArtic(s32 file_handle, u8* buffer, size_t len, size_t offset);
+    ResultVal<std::size_t> ReadFromServer(s32 file_handle, u8* buffer, size_t len, size_t offset);
 
     std::size_t OffsetToPage(std::size_t offset) {
         return Common::AlignDown<std::size_t>(offset, cache_line_size);
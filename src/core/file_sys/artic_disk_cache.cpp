@@ -0,0 +1,161 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <bit>
+#include "common/alignment.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
+#include "core/file_sys/artic_disk_cache.h"
+#include "core/hw/unique_data.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr u32 CacheMagic = 0x43444341; // "ACDC"
+constexpr u32 CacheVersion = 1;
+
+struct Header {
+    u32_le magic;
+    u32_le version;
+    u64_le program_id;
+    u64_le data_size;
+    u64_le content_hash;
+};
+static_assert(sizeof(Header) == 0x20, "Header has wrong size");
+
+} // Anonymous namespace
+
+ArticDiskCache::ArticDiskCache(std::unique_ptr<FileUtil::IOFile> file_, std::size_t data_size_)
+    : file{std::move(file_)}, data_size{data_size_},
+      stored_pages(Common::AlignUp(Common::AlignUp(data_size, PageSize) / PageSize, 8) / 8) {
+    data_offset = Common::AlignUp(sizeof(Header) + stored_pages.size(), PageSize);
+}
+
+ArticDiskCache::~ArticDiskCache() {
+    std::scoped_lock lock{mutex};
+    FlushStoredPages();
+}
+
+std::unique_ptr<ArticDiskCache> ArticDiskCache::Open(const std::string& path, u64 program_id,
+                                                     std::size_t data_size, u64 content_hash) {
+    auto file =
+        HW::UniqueData::OpenUniqueCryptoFile(path, FileUtil::Exists(path) ? "r+b" : "w+b",
+                                             HW::UniqueData::UniqueCryptoFileID::ArticCache);
+    if (!file->IsOpen()) {
+        LOG_WARNING(Service_FS, "Could not open Artic disk cache {}, is the console linked?", path);
+        return nullptr;
+    }
+
+    std::unique_ptr<ArticDiskCache> cache{new ArticDiskCache(std::move(file), data_size)};
+    auto& stored_pages = cache->stored_pages;
+    Header header{};
+    const bool valid =
+        cache->file->ReadAtBytes(&header, sizeof(header), 0) == sizeof(header) &&
+        header.magic == CacheMagic && header.version == CacheVersion &&
+        header.program_id == program_id && header.data_size == data_size &&
+        header.content_hash == content_hash &&
+        cache->file->ReadAtBytes(stored_pages.data(), stored_pages.size(), sizeof(header)) ==
+            stored_pages.size();
+    if (!valid) {
+        LOG_INFO(Service_FS, "Creating Artic disk cache {}", path);
+        std::fill(stored_pages.begin(), stored_pages.end(), u8{0});
+        cache->file->Resize(0);
+        cache->WriteHeader(program_id, content_hash);
+        cache->stored_pages_dirty = true;
+        cache->FlushStoredPages();
+        return cache;
+    }
+
+    std::size_t stored_count = 0;
+    for (const u8 byte : stored_pages) {
+        stored_count += std::popcount(byte);
+    }
+    LOG_INFO(Service_FS, "Loaded Artic disk cache {} with {} of {} pages", path, stored_count,
+             Common::AlignUp(data_size, PageSize) / PageSize);
+    return cache;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> ArticDiskCache::MissingRanges(
+    std::size_t offset, std::size_t length) {
+    std::scoped_lock lock{mutex};
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    const std::size_t end = std::min(offset + length, data_size);
+    for (std::size_t page = offset / PageSize; page * PageSize < end; page++) {
+        if (IsStored(page)) {
+            continue;
+        }
+        const std::size_t page_end = std::min((page + 1) * PageSize, data_size);
+        if (!ranges.empty() && ranges.back().first + ranges.back().second == page * PageSize) {
+            ranges.back().second = page_end - ranges.back().first;
+        } else {
+            ranges.emplace_back(page * PageSize, page_end - page * PageSize);
+        }
+    }
+    return ranges;
+}
+
+void ArticDiskCache::Write(std::size_t offset, std::size_t length, const u8* data) {
+    std::scoped_lock lock{mutex};
+    length = std::min(length, data_size - std::min(offset, data_size));
+    // The last page of the file is shorter, it is kept when the data reaches the end of the file.
+    const std::size_t stored_length =
+        offset + length == data_size ? length : Common::AlignDown(length, PageSize);
+    if (stored_length == 0 || !file->Seek(data_offset + offset, SEEK_SET) ||
+        file->WriteBytes(data, stored_length) != stored_length) {
+        return;
+    }
+    for (std::size_t page = offset / PageSize; page * PageSize < offset + stored_length; page++) {
+        stored_pages[page / 8] |= static_cast<u8>(1 << (page % 8));
+    }
+    stored_pages_dirty = true;
+}
+
+std::size_t ArticDiskCache::Read(std::size_t offset, std::size_t length, u8* buffer) {
+    std::scoped_lock lock{mutex};
+    const std::size_t end = std::min(offset + length, data_size);
+    std::size_t page = offset / PageSize;
+    while (page * PageSize < end && IsStored(page)) {
+        page++;
+    }
+    const std::size_t available = std::min(page * PageSize, end) - std::min(offset, end);
+    if (available == 0) {
+        return 0;
+    }
+    return file->ReadAtBytes(buffer, available, data_offset + offset);
+}
+
+void ArticDiskCache::Invalidate() {
+    std::scoped_lock lock{mutex};
+    std::fill(stored_pages.begin(), stored_pages.end(), u8{0});
+    stored_pages_dirty = true;
+    FlushStoredPages();
+}
+
+void ArticDiskCache::WriteHeader(u64 program_id, u64 content_hash) {
+    Header header{};
+    header.magic = CacheMagic;
+    header.version = CacheVersion;
+    header.program_id = program_id;
+    header.data_size = data_size;
+    header.content_hash = content_hash;
+    file->Seek(0, SEEK_SET);
+    file->WriteBytes(&header, sizeof(header));
+}
+
+void ArticDiskCache::FlushStoredPages() {
+    if (!stored_pages_dirty) {
+        return;
+    }
+    // Pages are written before they are marked as stored, a cache left behind by a crash only
+    // misses the pages stored since the last flush.
+    if (file->Seek(sizeof(Header), SEEK_SET) &&
+        file->WriteBytes(stored_pages.data(), stored_pages.size()) == stored_pages.size()) {
+        file->Flush();
+        stored_pages_dirty = false;
+    }
+}
+
+} // namespace FileSys
@@ -0,0 +1,77 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+#include "common/file_util.h"
+
+namespace FileSys {
+
+/**
+ * Keeps the pages of a file read from an Artic Base server in a file on disk, so that later
+ * sessions against the same console read them locally. The file is encrypted with a key unique
+ * to the linked console and tagged with the size and a hash of the start of the data it caches,
+ * a cache that no longer matches the data on the server is discarded.
+ */
+class ArticDiskCache {
+public:
+    static constexpr std::size_t PageSize = 4 * 1024;
+
+    ~ArticDiskCache();
+
+    /**
+     * Opens the cache at path, or creates it if it is missing or is for different data.
+     * @param program_id Title the cached file belongs to.
+     * @param data_size Size of the cached file.
+     * @param content_hash Hash identifying the contents of the cached file.
+     * @return The cache, or nullptr if there is no linked console to encrypt it with.
+     */
+    static std::unique_ptr<ArticDiskCache> Open(const std::string& path, u64 program_id,
+                                                std::size_t data_size, u64 content_hash);
+
+    std::size_t GetDataSize() const noexcept {
+        return data_size;
+    }
+
+    /// Returns the page aligned ranges of offset to offset + length that are not stored yet.
+    std::vector<std::pair<std::size_t, std::size_t>> MissingRanges(std::size_t offset,
+                                                                   std::size_t length);
+
+    /**
+     * Stores data read from the server, only the pages it covers entirely are kept.
+     * @param offset Page aligned offset of the data in the cached file.
+     */
+    void Write(std::size_t offset, std::size_t length, const u8* data);
+
+    /// Reads from the stored pages, stopping at the first page that is not stored.
+    std::size_t Read(std::size_t offset, std::size_t length, u8* buffer);
+
+    /// Forgets all the stored pages.
+    void Invalidate();
+
+private:
+    ArticDiskCache(std::unique_ptr<FileUtil::IOFile> file, std::size_t data_size);
+
+    bool IsStored(std::size_t page) const {
+        return (stored_pages[page / 8] >> (page % 8)) & 1;
+    }
+
+    void WriteHeader(u64 program_id, u64 content_hash);
+    void FlushStoredPages();
+
+    std::unique_ptr<FileUtil::IOFile> file;
+    std::size_t data_size;
+    std::size_t data_offset;
+    std::vector<u8> stored_pages; ///< One bit per page, set once the page is in the file.
+    bool stored_pages_dirty = false;
+    std::mutex mutex;
+};
+
+} // namespace FileSys
@@ -3,15 +3,164 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include "common/archives.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/string_util.h"
 #include "core/file_sys/delay_generator.h"
 
 SERIALIZE_EXPORT_IMPL(FileSys::DefaultDelayGenerator)
 
 namespace FileSys {
 
+namespace {
+
+std::string GetDelayTablePath() {
+    const std::string& path = Settings::values.fs_delay_table.GetValue();
+    if (!path.empty()) {
+        return path;
+    }
+    return FileUtil::GetUserPath(FileUtil::UserPath::ConfigDir) + "fs_delay_table.txt";
+}
+
+/// Returns the table at the configured path, reloading it only when the path changes.
+std::shared_ptr<const DelayTable> GetConfiguredDelayTable() {
+    static std::mutex mutex;
+    static std::string loaded_path;
+    static std::shared_ptr<const DelayTable> table;
+
+    std::scoped_lock lock{mutex};
+    const std::string path = GetDelayTablePath();
+    if (table && path == loaded_path) {
+        return table;
+    }
+    loaded_path = path;
+
+    std::string contents;
+    if (!FileUtil::Exists(path) || FileUtil::ReadFileToString(true, path, contents) == 0) {
+        LOG_WARNING(Service_FS, "Could not read delay table {}, using the hardware delays", path);
+        table = std::make_shared<const DelayTable>();
+        return table;
+    }
+    table = std::make_shared<const DelayTable>(DelayTable::Parse(contents, path));
+    return table;
+}
+
+} // Anonymous namespace
+
+DelayTable DelayTable::Parse(std::string_view text, std::string_view source) {
+    DelayTable table;
+    std::istringstream stream{std::string{text}};
+    for (std::string line; std::getline(stream, line);) {
+        line = Common::StripSpaces(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream fields{line};
+        std::string archive_type;
+        std::string operation;
+        u64 length;
+        u64 delay;
+        if (!(fields >> archive_type >> operation >> length >> delay) ||
+            (operation != "read" && operation != "open")) {
+            LOG_ERROR(Service_FS, "Invalid line '{}' in {}", line, source);
+            continue;
+        }
+        ArchiveDelays& delays = table.archives[archive_type];
+        if (operation == "open") {
+            delays.open_delay = delay;
+            continue;
+        }
+        auto& points = delays.read_points;
+        const auto it = std::lower_bound(points.begin(), points.end(), length,
+                                         [](const auto& point, u64 l) { return point.first < l; });
+        if (it != points.end() && it->first == length) {
+            it->second = delay;
+        } else {
+            points.emplace(it, length, delay);
+        }
+    }
+    return table;
+}
+
+const DelayTable::ArchiveDelays* DelayTable::Find(std::string_view archive_type) const {
+    if (const auto it = archives.find(archive_type); it != archives.end()) {
+        return &it->second;
+    }
+    if (const auto it = archives.find("*"); it != archives.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+std::optional<u64> DelayTable::GetReadDelayNs(std::string_view archive_type,
+                                              std::size_t length) const {
+    const ArchiveDelays* delays = Find(archive_type);
+    if (!delays || delays->read_points.empty()) {
+        return std::nullopt;
+    }
+    const auto& points = delays->read_points;
+    if (points.size() == 1) {
+        return points.front().second;
+    }
+
+    // Interpolate on the segment containing the length, or the closest one outside the table.
+    const auto upper = std::upper_bound(points.begin() + 1, points.end() - 1, length,
+                                        [](u64 l, const auto& point) { return l < point.first; });
+    const auto& [x0, y0] = *std::prev(upper);
+    const auto& [x1, y1] = *upper;
+    const double slope = (static_cast<double>(y1) - static_cast<double>(y0)) /
+                         static_cast<double>(x1 - x0);
+    const double delay =
+        static_cast<double>(y0) + slope * (static_cast<double>(length) - static_cast<double>(x0));
+    return static_cast<u64>(std::max(delay, 0.0));
+}
+
+std::optional<u64> DelayTable::GetOpenDelayNs(std::string_view archive_type) const {
+    const ArchiveDelays* delays = Find(archive_type);
+    if (!delays) {
+        return std::nullopt;
+    }
+    return delays->open_delay;
+}
+
 DelayGenerator::~DelayGenerator() = default;
 
+u64 DelayGenerator::GetConfiguredReadDelayNs(std::size_t length) {
+    switch (Settings::values.fs_delay_mode.GetValue()) {
+    case Settings::FSDelayMode::Instant:
+        return 0;
+    case Settings::FSDelayMode::Table:
+        if (const auto delay =
+                GetConfiguredDelayTable()->GetReadDelayNs(GetArchiveType(), length)) {
+            return *delay;
+        }
+        break;
+    default:
+        break;
+    }
+    return GetReadDelayNs(length);
+}
+
+u64 DelayGenerator::GetConfiguredOpenDelayNs() {
+    switch (Settings::values.fs_delay_mode.GetValue()) {
+    case Settings::FSDelayMode::Instant:
+        return 0;
+    case Settings::FSDelayMode::Table:
+        if (const auto delay = GetConfiguredDelayTable()->GetOpenDelayNs(GetArchiveType())) {
+            return *delay;
+        }
+        break;
+    default:
+        break;
+    }
+    return GetOpenDelayNs();
+}
+
 u64 DefaultDelayGenerator::GetReadDelayNs(std::size_t length) {
     // This is the delay measured for a romfs read.
     // For now we will take that as a default
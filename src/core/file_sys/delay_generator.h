@@ -5,6 +5,12 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
 #include "common/common_types.h"
@@ -19,12 +25,57 @@ private:
 
 namespace FileSys {
 
+/**
+ * Table of measured file system latencies. Every line that is not empty or a comment has the form
+ * `<archive type> <read|open> <length> <delay ns>`, where `*` as archive type applies to every
+ * archive type without its own entries. Read delays are interpolated linearly between the listed
+ * lengths and the outermost segments are extended past them. Open delays ignore the length.
+ */
+class DelayTable {
+public:
+    /// Parses a table, skipping and logging malformed lines.
+    static DelayTable Parse(std::string_view text, std::string_view source = "delay table");
+
+    [[nodiscard]] bool Empty() const {
+        return archives.empty();
+    }
+
+    [[nodiscard]] std::optional<u64> GetReadDelayNs(std::string_view archive_type,
+                                                    std::size_t length) const;
+    [[nodiscard]] std::optional<u64> GetOpenDelayNs(std::string_view archive_type) const;
+
+private:
+    struct ArchiveDelays {
+        // Pairs of read length and delay, sorted by length.
+        std::vector<std::pair<u64, u64>> read_points;
+        std::optional<u64> open_delay;
+    };
+
+    const ArchiveDelays* Find(std::string_view archive_type) const;
+
+    std::map<std::string, ArchiveDelays, std::less<>> archives;
+};
+
 class DelayGenerator {
 public:
     virtual ~DelayGenerator();
     virtual u64 GetReadDelayNs(std::size_t length) = 0;
     virtual u64 GetOpenDelayNs() = 0;
 
+    /// Name of the archive type that is used to look up its delays in the delay table.
+    virtual std::string_view GetArchiveType() const {
+        return "default";
+    }
+
+    /**
+     * Returns the delay of a read of the given length for the configured delay mode. Table mode
+     * falls back to the measured model for archive types the table does not list.
+     */
+    u64 GetConfiguredReadDelayNs(std::size_t length);
+
+    /// Returns the delay of opening a file for the configured delay mode.
+    u64 GetConfiguredOpenDelayNs();
+
     // TODO (B3N30): Add getter for all other file/directory io operations
 private:
     template <class Archive>
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include "common/archives.h"
 #include "common/common_types.h"
@@ -16,13 +17,50 @@ SERIALIZE_EXPORT_IMPL(FileSys::DiskDirectory)
 
 namespace FileSys {
 
+DiskFile::~DiskFile() {
+    CommitPendingWrites();
+}
+
 ResultVal<std::size_t> DiskFile::Read(const u64 offset, const std::size_t length,
                                       u8* buffer) const {
     if (!mode.read_flag)
         return ResultInvalidOpenFlags;
 
-    file->Seek(offset, SEEK_SET);
-    return file->ReadBytes(buffer, length);
+    if (pending_writes.empty()) {
+        file->Seek(offset, SEEK_SET);
+        return file->ReadBytes(buffer, length);
+    }
+
+    const u64 size = GetSize();
+    if (offset >= size) {
+        return 0ULL;
+    }
+    const std::size_t read_length =
+        static_cast<std::size_t>(std::min<u64>(length, size - offset));
+    // Anything between the end of the host file and a pending write past it reads as zeroes.
+    const u64 file_size = file->GetSize();
+    std::size_t file_read = 0;
+    if (offset < file_size) {
+        file->Seek(offset, SEEK_SET);
+        file_read = file->ReadBytes(
+            buffer, static_cast<std::size_t>(std::min<u64>(read_length, file_size - offset)));
+        file_read = file_read > read_length ? 0 : file_read;
+    }
+    std::memset(buffer + file_read, 0, read_length - file_read);
+
+    auto it = pending_writes.upper_bound(offset);
+    if (it != pending_writes.begin()) {
+        --it;
+    }
+    for (; it != pending_writes.end() && it->first < offset + read_length; ++it) {
+        const u64 start = std::max(offset, it->first);
+        const u64 end = std::min<u64>(offset + read_length, it->first + it->second.size());
+        if (start < end) {
+            std::memcpy(buffer + (start - offset), it->second.data() + (start - it->first),
+                        static_cast<std::size_t>(end - start));
+        }
+    }
+    return read_length;
 }
 
 ResultVal<std::size_t> DiskFile::Write(const u64 offset, const std::size_t length, const bool flush,
@@ -30,6 +68,15 @@ ResultVal<std::size_t> DiskFile::Write(const u64 offset, const std::size_t lengt
     if (!mode.write_flag)
         return ResultInvalidOpenFlags;
 
+    if (write_back) {
+        // The flush flag is ignored, committing on Flush and Close is what avoids the stalls.
+        AddPendingWrite(offset, length, buffer);
+        if (pending_write_bytes >= MaxPendingWriteBytes) {
+            CommitPendingWrites();
+        }
+        return length;
+    }
+
     file->Seek(offset, SEEK_SET);
     std::size_t written = file->WriteBytes(buffer, length);
     if (flush)
@@ -38,19 +85,92 @@ ResultVal<std::size_t> DiskFile::Write(const u64 offset, const std::size_t lengt
 }
 
 u64 DiskFile::GetSize() const {
-    return file->GetSize();
+    const u64 file_size = file->GetSize();
+    if (pending_writes.empty()) {
+        return file_size;
+    }
+    const auto& [last_offset, last_data] = *pending_writes.rbegin();
+    return std::max<u64>(file_size, last_offset + last_data.size());
 }
 
 bool DiskFile::SetSize(const u64 size) const {
+    CommitPendingWrites();
     file->Resize(size);
     file->Flush();
     return true;
 }
 
 bool DiskFile::Close() {
+    CommitPendingWrites();
     return file->Close();
 }
 
+void DiskFile::Flush() const {
+    CommitPendingWrites();
+    file->Flush();
+}
+
+void DiskFile::AddPendingWrite(u64 offset, std::size_t length, const u8* buffer) {
+    if (length == 0) {
+        return;
+    }
+    const u64 end = offset + length;
+
+    // Find the pending writes that overlap or touch the new one.
+    auto first = pending_writes.upper_bound(offset);
+    if (first != pending_writes.begin()) {
+        const auto previous = std::prev(first);
+        if (previous->first + previous->second.size() >= offset) {
+            first = previous;
+        }
+    }
+    auto last = first;
+    u64 merged_start = offset;
+    u64 merged_end = end;
+    while (last != pending_writes.end() && last->first <= end) {
+        merged_start = std::min(merged_start, last->first);
+        merged_end = std::max<u64>(merged_end, last->first + last->second.size());
+        ++last;
+    }
+
+    // Fast path for the common case of sequential writes extending a single pending write.
+    if (first != last && std::next(first) == last && first->first <= offset) {
+        auto& data = first->second;
+        pending_write_bytes -= data.size();
+        data.resize(static_cast<std::size_t>(merged_end - merged_start));
+        std::memcpy(data.data() + (offset - merged_start), buffer, length);
+        pending_write_bytes += data.size();
+        return;
+    }
+
+    std::vector<u8> merged(static_cast<std::size_t>(merged_end - merged_start));
+    for (auto it = first; it != last; ++it) {
+        std::memcpy(merged.data() + (it->first - merged_start), it->second.data(),
+                    it->second.size());
+        pending_write_bytes -= it->second.size();
+    }
+    std::memcpy(merged.data() + (offset - merged_start), buffer, length);
+    pending_writes.erase(first, last);
+    pending_write_bytes += merged.size();
+    pending_writes.emplace(merged_start, std::move(merged));
+}
+
+void DiskFile::CommitPendingWrites() const {
+    if (pending_writes.empty()) {
+        return;
+    }
+    for (const auto& [offset, data] : pending_writes) {
+        file->Seek(offset, SEEK_SET);
+        if (file->WriteBytes(data.data(), data.size()) != data.size()) {
+            LOG_ERROR(Service_FS, "Could not write {} bytes at offset {} to {}", data.size(),
+                      offset, file->Filename());
+        }
+    }
+    file->Flush();
+    pending_writes.clear();
+    pending_write_bytes = 0;
+}
+
 DiskDirectory::DiskDirectory(const std::string& path) {
     directory.size = FileUtil::ScanDirectoryTree(path, directory);
     directory.isDirectory = true;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,25 +21,29 @@
 
 namespace FileSys {
 
+/**
+ * A file on the host disk. With write-back enabled, writes are kept in memory and coalesced, and
+ * are only written to the host file when the file is flushed, resized, closed or serialized, or
+ * when too much data is pending. Reads see the pending writes.
+ */
 class DiskFile : public FileBackend {
 public:
     DiskFile(FileUtil::IOFile&& file_, const Mode& mode_,
-             std::unique_ptr<DelayGenerator> delay_generator_)
-        : file(new FileUtil::IOFile(std::move(file_))) {
+             std::unique_ptr<DelayGenerator> delay_generator_, bool write_back_ = false)
+        : file(new FileUtil::IOFile(std::move(file_))), write_back(write_back_) {
         delay_generator = std::move(delay_generator_);
         mode.hex = mode_.hex;
     }
 
+    ~DiskFile() override;
+
     ResultVal<std::size_t> Read(u64 offset, std::size_t length, u8* buffer) const override;
     ResultVal<std::size_t> Write(u64 offset, std::size_t length, bool flush, bool update_timestamp,
                                  const u8* buffer) override;
     u64 GetSize() const override;
     bool SetSize(u64 size) const override;
     bool Close() override;
-
-    void Flush() const override {
-        file->Flush();
-    }
+    void Flush() const override;
 
 protected:
     Mode mode;
@@ -47,8 +52,24 @@ protected:
     DiskFile() = default;
 
 private:
+    // Pending writes are committed once they add up to this many bytes.
+    static constexpr std::size_t MaxPendingWriteBytes = 4 * 1024 * 1024;
+
+    bool write_back = false;
+    // Non-overlapping, non-adjacent pending writes by file offset.
+    mutable std::map<u64, std::vector<u8>> pending_writes;
+    mutable std::size_t pending_write_bytes = 0;
+
+    void AddPendingWrite(u64 offset, std::size_t length, const u8* buffer);
+
+    /// Writes all pending writes to the host file in one pass.
+    void CommitPendingWrites() const;
+
     template <class Archive>
     void serialize(Archive& ar, const unsigned int) {
+        if (Archive::is_saving::value) {
+            CommitPendingWrites();
+        }
         ar& boost::serialization::base_object<FileBackend>(*this);
         ar & mode.hex;
         ar & file;
@@ -46,20 +46,20 @@ public:
      */
     u64 GetReadDelayNs(std::size_t length) {
         if (delay_generator != nullptr) {
-            return delay_generator->GetReadDelayNs(length);
+            return delay_generator->GetConfiguredReadDelayNs(length);
         }
         LOG_ERROR(Service_FS, "Delay generator was not initalized. Using default");
         delay_generator = std::make_unique<DefaultDelayGenerator>();
-        return delay_generator->GetReadDelayNs(length);
+        return delay_generator->GetConfiguredReadDelayNs(length);
     }
 
     u64 GetOpenDelayNs() {
         if (delay_generator != nullptr) {
-            return delay_generator->GetOpenDelayNs();
+            return delay_generator->GetConfiguredOpenDelayNs();
         }
         LOG_ERROR(Service_FS, "Delay generator was not initalized. Using default");
         delay_generator = std::make_unique<DefaultDelayGenerator>();
-        return delay_generator->GetOpenDelayNs();
+        return delay_generator->GetConfiguredOpenDelayNs();
     }
 
     /**
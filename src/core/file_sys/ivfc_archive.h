@@ -38,6 +38,10 @@ class IVFCDelayGenerator : public DelayGenerator {
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "romfs";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
@@ -62,6 +66,10 @@ public:
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "romfs";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
@@ -86,6 +94,10 @@ public:
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "exefs";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
@@ -4,11 +4,15 @@
 
 #include <algorithm>
 #include <cstring>
+#include <sstream>
+#include <boost/serialization/vector.hpp>
+#include <fmt/format.h>
 #include "common/alignment.h"
 #include "common/archives.h"
 #include "common/assert.h"
 #include "common/common_paths.h"
 #include "common/file_util.h"
+#include "common/hash.h"
 #include "common/string_util.h"
 #include "common/swap.h"
 #include "core/file_sys/layered_fs.h"
@@ -23,6 +27,8 @@ struct FileRelocationInfo {
     u64 original_offset;           // Type 0. Offset is absolute
     std::string replace_file_path; // Type 1
     std::vector<u8> patched_file;  // Type 2
+    std::string patch_file_path;   // Type 2
+    u64 original_size = 0;         // Type 2
     u64 size;                      // Relocated file size
 };
 struct LayeredFS::File {
@@ -54,6 +60,75 @@ struct FileMetadata {
 };
 static_assert(sizeof(FileMetadata) == 0x20, "Size of FileMetadata is not correct");
 
+namespace {
+
+// Bump whenever the layout of the rebuilt metadata or of the cache file changes.
+constexpr u32 MetadataCacheVersion = 1;
+
+struct MetadataCacheFile {
+    u64 data_offset;
+    int type;
+    u64 original_offset;
+    u64 original_size;
+    u64 size;
+    std::string path;
+    std::string source_path; // Replacement or patch file
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+        ar & data_offset;
+        ar & type;
+        ar & original_offset;
+        ar & original_size;
+        ar & size;
+        ar & path;
+        ar & source_path;
+    }
+};
+
+struct MetadataCache {
+    u32 version;
+    u64 key;
+    std::vector<u8> metadata;
+    u64 data_size;
+    std::vector<MetadataCacheFile> files;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+        ar & version;
+        ar & key;
+        ar & metadata;
+        ar & data_size;
+        ar & files;
+    }
+};
+
+void AppendDirectoryListing(std::string& listing, const FileUtil::FSTEntry& entry,
+                            std::size_t root_length) {
+    for (const auto& child : entry.children) {
+        listing += fmt::format("{}:{}:{}\n", child.physicalName.substr(root_length),
+                               child.isDirectory, child.size);
+        AppendDirectoryListing(listing, child, root_length);
+    }
+}
+
+std::string GetDirectoryListing(std::string path) {
+    if (!FileUtil::Exists(path)) {
+        return {};
+    }
+    if (path.back() == '/' || path.back() == '\\') {
+        // ScanDirectoryTree expects a path without trailing '/'
+        path.erase(path.size() - 1, 1);
+    }
+    FileUtil::FSTEntry result;
+    FileUtil::ScanDirectoryTree(path, result, 256);
+    std::string listing;
+    AppendDirectoryListing(listing, result, path.size());
+    return listing;
+}
+
+} // Anonymous namespace
+
 LayeredFS::LayeredFS() = default;
 
 LayeredFS::LayeredFS(std::shared_ptr<RomFSReader> romfs_, std::string patch_path_,
@@ -68,6 +143,12 @@ void LayeredFS::Load() {
 
     ASSERT_MSG(header.header_length == sizeof(header), "Header size is incorrect");
 
+    // Only mod loading is cached, dumping needs the directory tree.
+    const u64 cache_key = load_relocations ? ComputeCacheKey() : 0;
+    if (load_relocations && LoadCachedMetadata(cache_key)) {
+        return;
+    }
+
     // TODO: is root always the first directory in table?
     root.parent = &root;
     LoadDirectory(root, 0);
@@ -78,6 +159,10 @@ void LayeredFS::Load() {
     }
 
     RebuildMetadata();
+
+    if (load_relocations) {
+        SaveCachedMetadata(cache_key);
+    }
 }
 
 LayeredFS::~LayeredFS() = default;
@@ -230,42 +315,155 @@ void LayeredFS::LoadExtRelocations() {
                 continue;
             }
 
-            FileUtil::IOFile patch_file(entry.physicalName, "rb");
-            if (!patch_file) {
-                LOG_ERROR(Service_FS, "LayeredFS Could not open file {}", entry.physicalName);
-                continue;
+            if (PatchFile(*file_path_map[file_path], entry.physicalName)) {
+                LOG_INFO(Service_FS, "LayeredFS patched file {}", file_path);
             }
+        } else {
+            LOG_WARNING(Service_FS, "LayeredFS unknown ext file {}", path);
+        }
+    }
+}
 
-            const auto size = patch_file.GetSize();
-            std::vector<u8> patch(size);
-            if (patch_file.ReadBytes(patch.data(), size) != size) {
-                LOG_ERROR(Service_FS, "LayeredFS Could not read file {}", entry.physicalName);
-                continue;
-            }
+bool LayeredFS::PatchFile(File& file, const std::string& patch_file_path) {
+    FileUtil::IOFile patch_file(patch_file_path, "rb");
+    if (!patch_file) {
+        LOG_ERROR(Service_FS, "LayeredFS Could not open file {}", patch_file_path);
+        return false;
+    }
 
-            auto& file = *file_path_map[file_path];
-            std::vector<u8> buffer(file.relocation.size); // Original size
-            romfs->ReadFile(file.relocation.original_offset, buffer.size(), buffer.data());
+    const auto size = patch_file.GetSize();
+    std::vector<u8> patch(size);
+    if (patch_file.ReadBytes(patch.data(), size) != size) {
+        LOG_ERROR(Service_FS, "LayeredFS Could not read file {}", patch_file_path);
+        return false;
+    }
 
-            bool ret = false;
-            if (extension == ".ips") {
-                ret = Patch::ApplyIpsPatch(patch, buffer);
-            } else {
-                ret = Patch::ApplyBpsPatch(patch, buffer);
-            }
+    std::vector<u8> buffer(file.relocation.size); // Original size
+    romfs->ReadFile(file.relocation.original_offset, buffer.size(), buffer.data());
 
-            if (ret) {
-                LOG_INFO(Service_FS, "LayeredFS patched file {}", file_path);
+    bool ret = false;
+    if (patch_file_path.ends_with(".ips")) {
+        ret = Patch::ApplyIpsPatch(patch, buffer);
+    } else {
+        ret = Patch::ApplyBpsPatch(patch, buffer);
+    }
 
-                file.relocation.type = 2;
-                file.relocation.size = buffer.size();
-                file.relocation.patched_file = std::move(buffer);
-            } else {
-                LOG_ERROR(Service_FS, "LayeredFS failed to patch file {}", file_path);
+    if (!ret) {
+        LOG_ERROR(Service_FS, "LayeredFS failed to patch file {}", file.path);
+        return false;
+    }
+
+    file.relocation.type = 2;
+    file.relocation.original_size = file.relocation.size;
+    file.relocation.size = buffer.size();
+    file.relocation.patched_file = std::move(buffer);
+    file.relocation.patch_file_path = patch_file_path;
+    return true;
+}
+
+u64 LayeredFS::ComputeCacheKey() {
+    std::vector<u8> base_metadata(header.file_data_offset);
+    romfs->ReadFile(0, base_metadata.size(), base_metadata.data());
+
+    const std::string listing = fmt::format(
+        "{}\n{}\n{}\n{}", MetadataCacheVersion, romfs->GetSize(),
+        GetDirectoryListing(patch_path), GetDirectoryListing(patch_ext_path));
+    return Common::HashCombine(Common::ComputeHash64(base_metadata.data(), base_metadata.size()),
+                               Common::ComputeHash64(listing.data(), listing.size()));
+}
+
+std::string LayeredFS::GetCachePath() const {
+    const std::string mod_path = patch_path + '|' + patch_ext_path;
+    return fmt::format("{}layered_fs{}{:016X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::CacheDir), DIR_SEP,
+                       Common::ComputeHash64(mod_path.data(), mod_path.size()));
+}
+
+bool LayeredFS::LoadCachedMetadata(u64 cache_key) {
+    std::string data;
+    if (FileUtil::ReadFileToString(false, GetCachePath(), data) == 0) {
+        return false;
+    }
+
+    MetadataCache cache;
+    try {
+        std::istringstream stream(std::move(data));
+        iarchive ia{stream};
+        ia >> cache;
+    } catch (const std::exception& e) {
+        LOG_WARNING(Service_FS, "LayeredFS metadata cache is corrupted: {}", e.what());
+        return false;
+    }
+    if (cache.version != MetadataCacheVersion || cache.key != cache_key) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<File>> files;
+    std::map<u64, File*> offsets;
+    for (const auto& entry : cache.files) {
+        auto file = std::make_unique<File>();
+        file->path = entry.path;
+        file->parent = nullptr;
+        file->relocation.type = entry.type;
+        file->relocation.original_offset = entry.original_offset;
+        file->relocation.size = entry.size;
+        if (entry.type == 1) {
+            file->relocation.replace_file_path = entry.source_path;
+        } else if (entry.type == 2) {
+            // Patched contents are not cached, apply the patch again.
+            file->relocation.size = entry.original_size;
+            if (!PatchFile(*file, entry.source_path) || file->relocation.size != entry.size) {
+                return false;
             }
-        } else {
-            LOG_WARNING(Service_FS, "LayeredFS unknown ext file {}", path);
         }
+        offsets.emplace(entry.data_offset, file.get());
+        files.emplace_back(std::move(file));
+    }
+
+    metadata = std::move(cache.metadata);
+    current_data_offset = cache.data_size;
+    data_offset_map = std::move(offsets);
+    cached_files = std::move(files);
+    LOG_INFO(Service_FS, "LayeredFS loaded metadata for {} files from cache", cached_files.size());
+    return true;
+}
+
+void LayeredFS::SaveCachedMetadata(u64 cache_key) {
+    MetadataCache cache{
+        .version = MetadataCacheVersion,
+        .key = cache_key,
+        .metadata = metadata,
+        .data_size = current_data_offset,
+        .files = {},
+    };
+    cache.files.reserve(data_offset_map.size());
+    for (const auto& [data_offset, file] : data_offset_map) {
+        const auto& relocation = file->relocation;
+        cache.files.push_back(MetadataCacheFile{
+            .data_offset = data_offset,
+            .type = relocation.type,
+            .original_offset = relocation.original_offset,
+            .original_size = relocation.original_size,
+            .size = relocation.size,
+            .path = file->path,
+            .source_path = relocation.type == 1   ? relocation.replace_file_path
+                           : relocation.type == 2 ? relocation.patch_file_path
+                                                  : std::string{},
+        });
+    }
+
+    const std::string path = GetCachePath();
+    std::ostringstream stream;
+    try {
+        oarchive oa{stream};
+        oa << cache;
+    } catch (const std::exception& e) {
+        LOG_WARNING(Service_FS, "Could not serialize LayeredFS metadata cache: {}", e.what());
+        return;
+    }
+    if (!FileUtil::CreateFullPath(path) ||
+        FileUtil::WriteStringToFile(false, path, stream.str()) == 0) {
+        LOG_WARNING(Service_FS, "Could not write LayeredFS metadata cache to {}", path);
     }
 }
 
@@ -106,6 +106,20 @@ private:
 
     void RebuildMetadata();
 
+    // Applies the IPS/BPS patch at patch_file_path to the original contents of file
+    bool PatchFile(File& file, const std::string& patch_file_path);
+
+    // Hash of everything the rebuilt metadata depends on: the base RomFS metadata and the
+    // listing of both mod directories
+    u64 ComputeCacheKey();
+
+    std::string GetCachePath() const;
+
+    // Restores the rebuilt metadata saved by a previous load with the same cache key
+    bool LoadCachedMetadata(u64 cache_key);
+
+    void SaveCachedMetadata(u64 cache_key);
+
     void Load();
 
     std::shared_ptr<RomFSReader> romfs;
@@ -120,6 +134,9 @@ private:
     std::map<u64, File*> data_offset_map; // assigned data offset -> file
     std::vector<u8> metadata;             // Includes header, hash table and metadata
 
+    // Files restored from the metadata cache, which have no directory tree
+    std::vector<std::unique_ptr<File>> cached_files;
+
     // Used for rebuilding header
     std::vector<u32_le> directory_hash_table;
     std::vector<u32_le> file_hash_table;
@@ -4,12 +4,17 @@
 
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <span>
+#include <tuple>
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
 #include <cryptopp/sha.h>
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/memory_detect.h"
+#include "common/static_lru_cache.h"
+#include "common/zstd_seekable_file.h"
 #include "core/core.h"
 #include "core/file_sys/layered_fs.h"
 #include "core/file_sys/ncch_container.h"
@@ -62,50 +67,44 @@ static bool LZSS_Decompress(std::span<const u8> compressed, std::span<u8> decomp
     std::size_t index = compressed.size() - ((buffer_top_and_bottom >> 24) & 0xFF);
     std::size_t stop_index = compressed.size() - (buffer_top_and_bottom & 0xFFFFFF);
 
-    std::memset(decompressed.data(), 0, decompressed.size());
     std::memcpy(decompressed.data(), compressed.data(), compressed.size());
+    std::memset(decompressed.data() + compressed.size(), 0,
+                decompressed.size() - compressed.size());
 
+    const u8* in = compressed.data();
+    u8* dst = decompressed.data();
     while (index > stop_index) {
-        u8 control = compressed[--index];
-
-        for (unsigned i = 0; i < 8; i++) {
-            if (index <= stop_index)
-                break;
-            if (index <= 0)
-                break;
-            if (out <= 0)
-                break;
-
-            if (control & 0x80) {
-                // Check if compression is out of bounds
-                if (index < 2)
-                    return false;
-                index -= 2;
-
-                u32 segment_offset = compressed[index] | (compressed[index + 1] << 8);
-                u32 segment_size = ((segment_offset >> 12) & 15) + 3;
-                segment_offset &= 0x0FFF;
-                segment_offset += 2;
-
-                // Check if compression is out of bounds
-                if (out < segment_size)
-                    return false;
-
-                for (unsigned j = 0; j < segment_size; j++) {
-                    // Check if compression is out of bounds
-                    if (out + segment_offset >= decompressed.size())
-                        return false;
-
-                    u8 data = decompressed[out + segment_offset];
-                    decompressed[--out] = data;
-                }
+        u8 control = in[--index];
+
+        for (unsigned i = 0; i < 8 && index > stop_index && out > 0; i++, control <<= 1) {
+            if (!(control & 0x80)) {
+                dst[--out] = in[--index];
+                continue;
+            }
+
+            // Check if compression is out of bounds
+            if (index < 2)
+                return false;
+            index -= 2;
+
+            const u32 segment = in[index] | (in[index + 1] << 8);
+            const std::size_t segment_size = ((segment >> 12) & 15) + 3;
+            const std::size_t segment_offset = (segment & 0x0FFF) + 2;
+
+            // Check if compression is out of bounds, the first byte copied is the furthest one
+            if (out < segment_size || out + segment_offset >= decompressed.size())
+                return false;
+
+            // Each byte is copied from segment_offset + 1 bytes above it, the copy only reads
+            // bytes it wrote itself when the segment is longer than that distance.
+            out -= segment_size;
+            if (segment_size <= segment_offset + 1) {
+                std::memcpy(dst + out, dst + out + segment_offset + 1, segment_size);
             } else {
-                // Check if compression is out of bounds
-                if (out < 1)
-                    return false;
-                decompressed[--out] = compressed[--index];
+                for (std::size_t j = segment_size; j-- > 0;) {
+                    dst[out + j] = dst[out + j + segment_offset + 1];
+                }
             }
-            control <<= 1;
         }
     }
     return true;
@@ -113,7 +112,7 @@ static bool LZSS_Decompress(std::span<const u8> compressed, std::span<u8> decomp
 
 NCCHContainer::NCCHContainer(const std::string& filepath, u32 ncch_offset, u32 partition)
     : ncch_offset(ncch_offset), partition(partition), filepath(filepath) {
-    file = std::make_unique<FileUtil::IOFile>(filepath, "rb");
+    file = Common::Compression::OpenImageFile(filepath);
 }
 
 Loader::ResultStatus NCCHContainer::OpenFile(const std::string& filepath_, u32 ncch_offset_,
@@ -121,7 +120,7 @@ Loader::ResultStatus NCCHContainer::OpenFile(const std::string& filepath_, u32 n
     filepath = filepath_;
     ncch_offset = ncch_offset_;
     partition = partition_;
-    file = std::make_unique<FileUtil::IOFile>(filepath_, "rb");
+    file = Common::Compression::OpenImageFile(filepath_);
 
     if (!file->IsOpen()) {
         LOG_WARNING(Service_FS, "Failed to open {}", filepath);
@@ -385,6 +384,37 @@ Loader::ResultStatus NCCHContainer::LoadOverrides() {
     return Loader::ResultStatus::Success;
 }
 
+/// Title ID high of the system applets, which games launch again every time they show them.
+constexpr u32 AppletTitleIdHigh = 0x00040030;
+
+/// Identifies a compressed .code section by its program ID, size and hash in the ExeFS header.
+using AppletCodeKey = std::tuple<u64, u32, std::array<u8, 0x20>>;
+
+/// Decompressed .code sections of the last launched applets, so that launching one again skips
+/// reading, decrypting and decompressing it.
+static std::mutex applet_code_mutex;
+static Common::StaticLRUCache<AppletCodeKey, std::vector<u8>, 4> applet_code_cache;
+static u64 applet_code_trim_count = 0;
+
+static bool FindAppletCode(const AppletCodeKey& key, std::vector<u8>& buffer) {
+    std::scoped_lock lock{applet_code_mutex};
+    const u64 trim_count = Common::GetMemoryTrimCount();
+    if (applet_code_trim_count != trim_count) {
+        applet_code_trim_count = trim_count;
+        applet_code_cache.reset();
+    }
+    if (!applet_code_cache.contains(key)) {
+        return false;
+    }
+    buffer = applet_code_cache.request(key).second;
+    return true;
+}
+
+static void CacheAppletCode(const AppletCodeKey& key, std::span<const u8> code) {
+    std::scoped_lock lock{applet_code_mutex};
+    applet_code_cache.request(key).second.assign(code.begin(), code.end());
+}
+
 Loader::ResultStatus NCCHContainer::LoadSectionExeFS(const char* name, std::vector<u8>& buffer) {
     Loader::ResultStatus result = Load();
     if (result != Loader::ResultStatus::Success)
@@ -460,6 +490,17 @@ Loader::ResultStatus NCCHContainer::LoadSectionExeFS(const char* name, std::vect
             size_t section_size = is_proto ? Common::AlignUp(section.size, 0x10) : section.size;
 
             if (strcmp(section.name, ".code") == 0 && is_compressed) {
+                // The hashes are stored in reverse order
+                AppletCodeKey key{ncch_header.program_id, section.size, {}};
+                std::memcpy(std::get<2>(key).data(),
+                            exefs_header.hashes[kMaxSections - 1 - section_number],
+                            std::get<2>(key).size());
+                const bool is_applet =
+                    static_cast<u32>(ncch_header.program_id >> 32) == AppletTitleIdHigh;
+                if (is_applet && FindAppletCode(key, buffer)) {
+                    return Loader::ResultStatus::Success;
+                }
+
                 // Section is compressed, read compressed .code section...
                 std::vector<u8> temp_buffer(section_size);
                 if (exefs_file->ReadBytes(temp_buffer.data(), temp_buffer.size()) !=
@@ -471,6 +512,9 @@ Loader::ResultStatus NCCHContainer::LoadSectionExeFS(const char* name, std::vect
                 if (!LZSS_Decompress(temp_buffer, buffer)) {
                     return Loader::ResultStatus::ErrorInvalidFormat;
                 }
+                if (is_applet) {
+                    CacheAppletCode(key, buffer);
+                }
             } else {
                 // Section is uncompressed...
                 buffer.resize(section_size);
@@ -611,7 +655,7 @@ Loader::ResultStatus NCCHContainer::ReadRomFS(std::shared_ptr<RomFSReader>& romf
         romfs_file_inner = HW::UniqueData::OpenUniqueCryptoFile(
             filepath, "rb", HW::UniqueData::UniqueCryptoFileID::NCCH);
     } else {
-        romfs_file_inner = std::make_unique<FileUtil::IOFile>(filepath, "rb");
+        romfs_file_inner = Common::Compression::OpenImageFile(filepath);
     }
 
     if (!romfs_file_inner->IsOpen())
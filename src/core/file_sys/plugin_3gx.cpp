@@ -19,47 +19,35 @@
 // DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include <cstring>
 #include "core/file_sys/file_backend.h"
 #include "core/file_sys/plugin_3gx.h"
 #include "core/file_sys/plugin_3gx_bootloader.h"
 #include "core/hle/kernel/vm_manager.h"
 #include "core/loader/loader.h"
 
-static std::string ReadTextInfo(FileUtil::IOFile& file, std::size_t offset, std::size_t max_size) {
+static std::string ReadTextInfo(std::span<const u8> file_data, std::size_t offset,
+                                std::size_t max_size) {
     if (offset == 0 || max_size == 0 ||
         max_size > 0x400) { // Limit read string size to 0x400 bytes, just in case
         return "";
     }
-    std::vector<char> char_data(max_size);
-
-    const u64 prev_offset = file.Tell();
-    if (!file.Seek(offset, SEEK_SET)) {
-        return "";
-    }
-    if (file.ReadBytes(char_data.data(), max_size) != max_size) {
-        file.Seek(prev_offset, SEEK_SET);
+    if (offset > file_data.size() || max_size > file_data.size() - offset) {
         return "";
     }
-    char_data[max_size - 1] = '\0';
-    return std::string(char_data.data());
+    const char* text = reinterpret_cast<const char*>(file_data.data() + offset);
+    return std::string(text, strnlen(text, max_size - 1));
 }
 
-static bool ReadSection(std::vector<u8>& data_out, FileUtil::IOFile& file, std::size_t offset,
-                        std::size_t size) {
+static bool ReadSection(std::span<const u8>& data_out, std::span<const u8> file_data,
+                        std::size_t offset, std::size_t size) {
     if (size > 0x5000000) { // Limit read section size to 5MiB, just in case
         return false;
     }
-    data_out.resize(size);
-
-    const u64 prev_offset = file.Tell();
-
-    if (!file.Seek(offset, SEEK_SET)) {
-        return false;
-    }
-    if (file.ReadBytes(data_out.data(), size) != size) {
-        file.Seek(prev_offset, SEEK_SET);
+    if (offset > file_data.size() || size > file_data.size() - offset) {
         return false;
     }
+    data_out = file_data.subspan(offset, size);
     return true;
 }
 
@@ -73,15 +61,22 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Load(
         return Loader::ResultStatus::Error;
     }
 
-    // Load CIA Header
-    std::vector<u8> header_data(sizeof(_3gx_Header));
-    if (file.ReadBytes(header_data.data(), sizeof(_3gx_Header)) != sizeof(_3gx_Header)) {
+    // Read the whole plugin at once, the sections are then copied to guest memory from it
+    const u64 file_size = file.GetSize();
+    if (file_size < sizeof(_3gx_Header) || file_size > max_file_size) {
+        LOG_ERROR(Service_PLGLDR, "Failed to load 3GX plugin. File corrupted: {}",
+                  plg_context.plugin_path);
+        return Loader::ResultStatus::Error;
+    }
+    file_data.resize(file_size);
+    if (file.ReadBytes(file_data.data(), file_data.size()) != file_data.size()) {
         LOG_ERROR(Service_PLGLDR, "Failed to load 3GX plugin. File corrupted: {}",
                   plg_context.plugin_path);
         return Loader::ResultStatus::Error;
     }
 
-    std::memcpy(&header, header_data.data(), sizeof(_3gx_Header));
+    // Load CIA Header
+    std::memcpy(&header, file_data.data(), sizeof(_3gx_Header));
 
     // Check magic value
     if (std::memcmp(&header.magic, _3GX_magic, 8) != 0) {
@@ -97,26 +92,23 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Load(
     }
 
     // Load strings
-    author = ReadTextInfo(file, header.infos.author_msg_offset, header.infos.author_len);
-    title = ReadTextInfo(file, header.infos.title_msg_offset, header.infos.title_len);
+    author = ReadTextInfo(file_data, header.infos.author_msg_offset, header.infos.author_len);
+    title = ReadTextInfo(file_data, header.infos.title_msg_offset, header.infos.title_len);
     description =
-        ReadTextInfo(file, header.infos.description_msg_offset, header.infos.description_len);
-    summary = ReadTextInfo(file, header.infos.summary_msg_offset, header.infos.summary_len);
+        ReadTextInfo(file_data, header.infos.description_msg_offset, header.infos.description_len);
+    summary = ReadTextInfo(file_data, header.infos.summary_msg_offset, header.infos.summary_len);
 
     LOG_INFO(Service_PLGLDR, "Trying to load plugin - Title: {} - Author: {}", title, author);
 
     // Load compatible TIDs
     {
-        std::vector<u8> raw_TID_data;
-        if (!ReadSection(raw_TID_data, file, header.targets.title_offsets,
+        std::span<const u8> raw_TID_data;
+        if (!ReadSection(raw_TID_data, file_data, header.targets.title_offsets,
                          header.targets.count * sizeof(u32))) {
             return Loader::ResultStatus::Error;
         }
-        compatible_TID.reserve(header.targets.count); // compatible_TID should be empty right now
-        for (u32 i = 0; i < u32(header.targets.count); i++) {
-            compatible_TID.push_back(
-                u32_le(*reinterpret_cast<u32*>(raw_TID_data.data() + i * sizeof(u32))));
-        }
+        compatible_TID.resize(header.targets.count); // compatible_TID should be empty right now
+        std::memcpy(compatible_TID.data(), raw_TID_data.data(), raw_TID_data.size());
     }
 
     if (!compatible_TID.empty() &&
@@ -132,11 +124,15 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Load(
     if (header.infos.flags.embedded_exe_func.Value() &&
         header.executable.exe_load_func_offset != 0) {
         exe_load_func.clear();
-        std::vector<u8> out;
+        std::span<const u8> out;
         for (int i = 0; i < 32; i++) {
-            ReadSection(out, file, header.executable.exe_load_func_offset + i * sizeof(u32),
-                        sizeof(u32));
-            u32 instruction = *reinterpret_cast<u32_le*>(out.data());
+            if (!ReadSection(out, file_data,
+                             header.executable.exe_load_func_offset + i * sizeof(u32),
+                             sizeof(u32))) {
+                break;
+            }
+            u32_le instruction;
+            std::memcpy(&instruction, out.data(), sizeof(u32));
             if (instruction == 0xE320F000) {
                 break;
             }
@@ -147,11 +143,11 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Load(
     }
 
     // Load code sections
-    if (!ReadSection(text_section, file, header.executable.code_offset,
+    if (!ReadSection(text_section, file_data, header.executable.code_offset,
                      header.executable.code_size) ||
-        !ReadSection(rodata_section, file, header.executable.rodata_offset,
+        !ReadSection(rodata_section, file_data, header.executable.rodata_offset,
                      header.executable.rodata_size) ||
-        !ReadSection(data_section, file, header.executable.data_offset,
+        !ReadSection(data_section, file_data, header.executable.data_offset,
                      header.executable.data_size)) {
         LOG_ERROR(Service_PLGLDR, "Failed to load 3GX plugin. File corrupted: {}",
                   plg_context.plugin_path);
@@ -187,6 +183,11 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Map(
     const u32 exe_size = (sizeof(PluginHeader) + text_section.size() + rodata_section.size() +
                           data_section.size() + header.executable.bss_size + 0x1000) &
                          ~0xFFFu;
+    if (exe_size > block_size - _3GX_fb_size) {
+        LOG_ERROR(Service_PLGLDR, "Failed to load 3GX plugin. Executable too large: {}",
+                  plg_context.plugin_path);
+        return Loader::ResultStatus::Error;
+    }
 
     // Allocate the framebuffer block so that is in the highest FCRAM position possible
     auto offset_fb =
@@ -216,7 +217,17 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Map(
         return Loader::ResultStatus::ErrorMemoryAllocationFailed;
     }
     auto backing_memory = kernel.memory.GetFCRAMRef(*offset);
-    std::fill(backing_memory.GetPtr(), backing_memory.GetPtr() + block_size - _3GX_fb_size, 0);
+
+    // Copy the sections straight to the block, then clear the rest of it
+    u8* const exe_ptr = backing_memory.GetPtr() + sizeof(PluginHeader);
+    std::memcpy(exe_ptr, text_section.data(), text_section.size());
+    std::memcpy(exe_ptr + text_section.size(), rodata_section.data(), rodata_section.size());
+    std::memcpy(exe_ptr + text_section.size() + rodata_section.size(), data_section.data(),
+                data_section.size());
+    const std::size_t loaded_size =
+        sizeof(PluginHeader) + text_section.size() + rodata_section.size() + data_section.size();
+    std::fill(backing_memory.GetPtr() + loaded_size,
+              backing_memory.GetPtr() + block_size - _3GX_fb_size, 0);
 
     // Then we map part of the memory, which contains the executable
     auto vma = process.vm_manager.MapBackingMemory(_3GX_exe_load_addr, backing_memory, exe_size,
@@ -225,18 +236,6 @@ Loader::ResultStatus FileSys::Plugin3GXLoader::Map(
     ASSERT(vma.Succeeded());
     process.vm_manager.Reprotect(vma.Unwrap(), Kernel::VMAPermission::ReadWriteExecute);
 
-    // Write text section
-    kernel.memory.WriteBlock(process, _3GX_exe_load_addr + sizeof(PluginHeader),
-                             text_section.data(), header.executable.code_size);
-    // Write rodata section
-    kernel.memory.WriteBlock(
-        process, _3GX_exe_load_addr + sizeof(PluginHeader) + header.executable.code_size,
-        rodata_section.data(), header.executable.rodata_size);
-    // Write data section
-    kernel.memory.WriteBlock(process,
-                             _3GX_exe_load_addr + sizeof(PluginHeader) +
-                                 header.executable.code_size + header.executable.rodata_size,
-                             data_section.data(), header.executable.data_size);
     // Prepare plugin header and write it
     PluginHeader plugin_header = {0};
     plugin_header.version = header.version;
@@ -144,10 +144,15 @@ private:
     std::string summary;
     std::string description;
 
+    /// Limit the plugin file size to 256MiB, just in case
+    static constexpr std::size_t max_file_size = 0x10000000;
+
     std::vector<u32> compatible_TID;
-    std::vector<u8> text_section;
-    std::vector<u8> data_section;
-    std::vector<u8> rodata_section;
+    /// The whole plugin file, the sections below point into it.
+    std::vector<u8> file_data;
+    std::span<const u8> text_section;
+    std::span<const u8> data_section;
+    std::span<const u8> rodata_section;
 
     std::vector<u32> exe_load_func;
     u32_le exe_load_args[4];
@@ -3,11 +3,15 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <vector>
-#include <cryptopp/aes.h>
-#include <cryptopp/modes.h>
+#include <fmt/format.h>
 #include "common/archives.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/file_sys/archive_artic.h"
 #include "core/file_sys/archive_backend.h"
 #include "core/file_sys/romfs_reader.h"
@@ -18,97 +22,125 @@ SERIALIZE_EXPORT_IMPL(FileSys::DirectRomFSReader)
 
 namespace FileSys {
 
+namespace {
+
+std::size_t GetCacheCapacity(std::size_t block_size) {
+    return static_cast<std::size_t>(Settings::values.romfs_cache_size.GetValue()) * 1024 * 1024 /
+           block_size;
+}
+
+} // Anonymous namespace
+
+DirectRomFSReader::DirectRomFSReader(std::unique_ptr<FileUtil::IOFile>&& file,
+                                     std::size_t file_offset, std::size_t data_size)
+    : file(std::move(file)), file_offset(file_offset), data_size(data_size),
+      block_cache(GetCacheCapacity(cache_block_size), read_ahead_blocks, 1, "RomFSReadAhead",
+                  [this](std::size_t block) { return LoadBlock(block); }) {
+    MapFile();
+}
+
+DirectRomFSReader::DirectRomFSReader()
+    : block_cache(GetCacheCapacity(cache_block_size), read_ahead_blocks, 1, "RomFSReadAhead",
+                  [this](std::size_t block) { return LoadBlock(block); }) {}
+
+DirectRomFSReader::~DirectRomFSReader() = default;
+
+void DirectRomFSReader::MapFile() {
+    block_cache.SetNumBlocks(static_cast<std::size_t>(
+        (data_size + cache_block_size - 1) / cache_block_size));
+    mapping.reset();
+    if (!file || file->IsCrypto() || file->IsCompressed()) {
+        return;
+    }
+    auto new_mapping = std::make_unique<FileUtil::MappedFile>(*file);
+    if (new_mapping->IsValid() && new_mapping->Data().size() >= file_offset + data_size) {
+        mapping = std::move(new_mapping);
+    }
+}
+
 std::size_t DirectRomFSReader::ReadFile(std::size_t offset, std::size_t length, u8* buffer) {
+    if (offset >= data_size) {
+        return 0;
+    }
     length = std::min(length, static_cast<std::size_t>(data_size) - offset);
     if (length == 0)
         return 0; // Crypto++ does not like zero size buffer
 
-    const auto segments = BreakupRead(offset, length);
-    std::size_t read_progress = 0;
+    if (mapping) {
+        std::memcpy(buffer, mapping->Data().data() + file_offset + offset, length);
+        return length;
+    }
 
     // Skip cache if the read is too big
-    if (segments.size() == 1 && segments[0].second > cache_line_size) {
-        length = file->ReadAtBytes(buffer, length, file_offset + offset);
+    if (block_cache.Capacity() == 0 || length > cache_block_size) {
         LOG_TRACE(Service_FS, "RomFS Cache SKIP: offset={}, length={}", offset, length);
-        return length;
+        return ReadFromFile(buffer, length, offset);
     }
 
-    // TODO(PabloMK7): Make cache thread safe, read the comment in CacheReady function.
-    // std::unique_lock<std::shared_mutex> read_guard(cache_mutex);
-    for (const auto& seg : segments) {
-        std::size_t read_size = cache_line_size;
-        std::size_t page = OffsetToPage(seg.first);
-        // Check if segment is in cache
-        auto cache_entry = cache.request(page);
-        if (!cache_entry.first) {
-            // If not found, read from disk and cache the data
-            read_size = file->ReadAtBytes(cache_entry.second.data(), read_size, file_offset + page);
-            LOG_TRACE(Service_FS, "RomFS Cache MISS: page={}, length={}, into={}", page, seg.second,
-                      (seg.first - page));
-        } else {
-            LOG_TRACE(Service_FS, "RomFS Cache HIT: page={}, length={}, into={}", page, seg.second,
-                      (seg.first - page));
+    const std::size_t first_block = offset / cache_block_size;
+    const std::size_t last_block = (offset + length - 1) / cache_block_size;
+    std::size_t read_progress = 0;
+    for (std::size_t block = first_block; block <= last_block; ++block) {
+        const std::size_t into = offset + read_progress - block * cache_block_size;
+        const std::size_t copy_amount = std::min(length - read_progress, cache_block_size - into);
+        const std::size_t copied =
+            block_cache.Read(block, into, copy_amount, buffer + read_progress);
+        read_progress += copied;
+        if (copied != copy_amount) {
+            break;
         }
-        std::size_t copy_amount =
-            (read_size > (seg.first - page))
-                ? std::min((seg.first - page) + seg.second, read_size) - (seg.first - page)
-                : 0;
-        std::memcpy(buffer + read_progress, cache_entry.second.data() + (seg.first - page),
-                    copy_amount);
-        read_progress += copy_amount;
     }
     return read_progress;
 }
 
 bool DirectRomFSReader::AllowsCachedReads() const {
-    return true;
+    // Local reads are always done inline, the block cache only makes them cheaper.
+    return false;
 }
 
 bool DirectRomFSReader::CacheReady(std::size_t file_offset, std::size_t length) {
-    auto segments = BreakupRead(file_offset, length);
-    if (segments.size() == 1 && segments[0].second > cache_line_size) {
+    // Small local reads are done inline whether they hit or not, so their timing doesn't depend
+    // on the host. Read-ahead only makes them cheaper.
+    return length <= cache_block_size;
+}
+
+bool DirectRomFSReader::IsCached(std::size_t file_offset, std::size_t length) {
+    if (mapping || block_cache.Capacity() == 0 || length > cache_block_size) {
         return false;
-    } else {
-        // TODO(PabloMK7): Since the LRU cache is not thread safe, a lock must be used.
-        // However, this completely breaks the point of using a cache, because
-        // smaller reads may be blocked by bigger reads. For now, always return
-        // data being in cache to prevent the need of a lock, and only read data
-        // asynchronously if it is too big to use the cache.
-        /*
-        std::shared_lock<std::shared_mutex> read_guard(cache_mutex);
-        for (auto it = segments.begin(); it != segments.end(); it++) {
-            if (!cache.contains(OffsetToPage(it->first)))
-                return false;
-        }
-        */
+    }
+    if (file_offset >= data_size) {
         return true;
     }
-}
-
-std::vector<std::pair<std::size_t, std::size_t>> DirectRomFSReader::BreakupRead(
-    std::size_t offset, std::size_t length) {
-
-    std::vector<std::pair<std::size_t, std::size_t>> ret;
-
-    // Reads bigger than the cache line size will probably never hit again
-    if (length > cache_line_size) {
-        ret.push_back(std::make_pair(offset, length));
-        return ret;
+    length = std::min(length, static_cast<std::size_t>(data_size) - file_offset);
+    if (length == 0) {
+        return true;
     }
 
-    std::size_t curr_offset = offset;
-    while (length) {
-        std::size_t next_page = OffsetToPage(curr_offset + cache_line_size);
-        std::size_t curr_page_len = std::min(length, next_page - curr_offset);
-        ret.push_back(std::make_pair(curr_offset, curr_page_len));
-        curr_offset = next_page;
-        length -= curr_page_len;
+    const std::size_t last_block = (file_offset + length - 1) / cache_block_size;
+    for (std::size_t block = file_offset / cache_block_size; block <= last_block; ++block) {
+        if (!block_cache.Contains(block)) {
+            return false;
+        }
     }
-    return ret;
+    return true;
+}
+
+std::size_t DirectRomFSReader::ReadFromFile(u8* buffer, std::size_t length, std::size_t offset) {
+    std::scoped_lock lock{file_mutex};
+    const std::size_t read = file->ReadAtBytes(buffer, length, file_offset + offset);
+    return read == std::numeric_limits<std::size_t>::max() ? 0 : read;
+}
+
+std::vector<u8> DirectRomFSReader::LoadBlock(std::size_t block) {
+    const std::size_t block_offset = block * cache_block_size;
+    std::vector<u8> data(
+        std::min(cache_block_size, static_cast<std::size_t>(data_size) - block_offset));
+    data.resize(ReadFromFile(data.data(), data.size(), block_offset));
+    return data;
 }
 
 ArticRomFSReader::ArticRomFSReader(std::shared_ptr<Network::ArticBase::Client>& cli,
-                                   bool is_update_romfs)
+                                   bool is_update_romfs, u64 program_id)
     : client(cli), cache(cli) {
     auto req = client->NewRequest("FSUSER_OpenFileDirectly");
 
@@ -169,9 +201,25 @@ ArticRomFSReader::ArticRomFSReader(std::shared_ptr<Network::ArticBase::Client>&
 
     data_size = static_cast<size_t>(*reinterpret_cast<u64*>(size_buf->first));
     load_status = Loader::ResultStatus::Success;
+
+    if (program_id == 0) {
+        return;
+    }
+    const std::string cache_path = fmt::format("{}artic" DIR_SEP "{:016X}{}",
+                                               FileUtil::GetUserPath(FileUtil::UserPath::CacheDir),
+                                               program_id, is_update_romfs ? "_update" : "");
+    FileUtil::CreateFullPath(cache_path);
+    if (Settings::values.use_artic_disk_cache) {
+        cache.ForceSetSize(data_size);
+        cache.OpenDiskCache(romfs_handle, program_id, cache_path + ".bin");
+    }
+    trace_path = cache_path + ".trace";
+    LoadTrace();
 }
 
 ArticRomFSReader::~ArticRomFSReader() {
+    prefetch_worker.reset();
+    SaveTrace();
     if (romfs_handle != -1) {
         auto req = client->NewRequest("FSFILE_Close");
         req.AddParameterS32(romfs_handle);
@@ -182,6 +230,9 @@ ArticRomFSReader::~ArticRomFSReader() {
 
 std::size_t ArticRomFSReader::ReadFile(std::size_t offset, std::size_t length, u8* buffer) {
     length = std::min(length, static_cast<std::size_t>(data_size) - offset);
+    if (!trace_path.empty()) {
+        RecordAndPrefetch(offset, length);
+    }
     auto res = cache.Read(romfs_handle, offset, length, buffer);
     if (res.Failed())
         return 0;
@@ -197,6 +248,8 @@ bool ArticRomFSReader::CacheReady(std::size_t file_offset, std::size_t length) {
 }
 
 void ArticRomFSReader::CloseFile() {
+    prefetch_worker.reset();
+    SaveTrace();
     if (romfs_handle != -1) {
         auto req = client->NewRequest("FSFILE_Close");
         req.AddParameterS32(romfs_handle);
@@ -205,4 +258,86 @@ void ArticRomFSReader::CloseFile() {
     }
 }
 
+void ArticRomFSReader::LoadTrace() {
+    FileUtil::IOFile file(trace_path, "rb");
+    if (!file.IsOpen()) {
+        return;
+    }
+    u64_le traced_size{};
+    if (file.ReadBytes(&traced_size, sizeof(traced_size)) != sizeof(traced_size) ||
+        traced_size != data_size) {
+        // The title was updated since, the recorded offsets are meaningless now.
+        return;
+    }
+    prefetch_reads.resize(
+        std::min<std::size_t>((file.GetSize() - sizeof(traced_size)) / sizeof(TraceRead),
+                              max_trace_reads));
+    prefetch_reads.resize(file.ReadArray(prefetch_reads.data(), prefetch_reads.size()));
+    if (prefetch_reads.empty()) {
+        return;
+    }
+    LOG_INFO(Service_FS, "Prefetching {} recorded RomFS reads from {}", prefetch_reads.size(),
+             trace_path);
+    prefetch_worker = std::make_unique<Common::ThreadWorker>(1, "ArticPrefetch");
+}
+
+void ArticRomFSReader::SaveTrace() {
+    std::scoped_lock lock{trace_mutex};
+    // A session that stopped earlier than the recorded one would only lose reads.
+    if (trace_path.empty() || recorded_reads.empty() ||
+        recorded_reads.size() < prefetch_reads.size()) {
+        return;
+    }
+    FileUtil::IOFile file(trace_path, "wb");
+    const u64_le traced_size = data_size;
+    if (!file.IsOpen() || file.WriteBytes(&traced_size, sizeof(traced_size)) != sizeof(u64_le) ||
+        file.WriteArray(recorded_reads.data(), recorded_reads.size()) != recorded_reads.size()) {
+        LOG_WARNING(Service_FS, "Could not save RomFS read trace {}", trace_path);
+    }
+    recorded_reads.clear();
+}
+
+void ArticRomFSReader::RecordAndPrefetch(std::size_t offset, std::size_t length) {
+    const TraceRead read{offset, length};
+    std::scoped_lock lock{trace_mutex};
+    if (recorded_reads.size() < max_trace_reads) {
+        recorded_reads.push_back(read);
+    }
+    if (!prefetch_worker) {
+        return;
+    }
+
+    // Games mostly read in the same order, small deviations are skipped over.
+    const std::size_t window_end =
+        std::min(prefetch_reads.size(), prefetch_cursor + trace_match_window);
+    const auto match = std::find(prefetch_reads.begin() + prefetch_cursor,
+                                 prefetch_reads.begin() + window_end, read);
+    if (match == prefetch_reads.begin() + window_end) {
+        return;
+    }
+    prefetch_cursor = std::distance(prefetch_reads.begin(), match) + 1;
+    prefetch_end = std::max(prefetch_end, prefetch_cursor);
+
+    std::size_t ahead = 0;
+    for (std::size_t i = prefetch_cursor; i < prefetch_end; i++) {
+        ahead += prefetch_reads[i].length;
+    }
+    for (; prefetch_end < prefetch_reads.size() && ahead < prefetch_budget; prefetch_end++) {
+        const TraceRead next = prefetch_reads[prefetch_end];
+        ahead += next.length;
+        if (next.length > max_prefetch_read || next.offset + next.length > data_size) {
+            continue;
+        }
+        prefetch_worker->QueueWork([this, next] {
+            if (cache.CacheReady(next.offset, next.length)) {
+                return;
+            }
+            LOG_TRACE(Service_FS, "ArticCache PREFETCH: offset={}, length={}", next.offset,
+                      next.length);
+            std::vector<u8> buffer(next.length);
+            cache.Read(romfs_handle, next.offset, next.length, buffer.data());
+        });
+    }
+}
+
 } // namespace FileSys
@@ -5,14 +5,16 @@
 #pragma once
 
 #include <array>
+#include <mutex>
 #include <shared_mutex>
+#include <vector>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
-#include "common/alignment.h"
+#include "common/block_cache.h"
 #include "common/common_types.h"
 #include "common/file_util.h"
-#include "common/static_lru_cache.h"
+#include "common/thread_worker.h"
 #include "core/file_sys/artic_cache.h"
 #include "network/artic_base/artic_base_client.h"
 
@@ -41,15 +43,18 @@ private:
 };
 
 /**
- * A RomFS reader that directly reads the RomFS file.
+ * A RomFS reader that directly reads the RomFS file. Files without console unique crypto are
+ * memory mapped when possible, so reads are copied straight from the host page cache. Otherwise
+ * small reads are served from an LRU cache of large decrypted blocks, and when the game reads
+ * sequentially the following blocks are fetched ahead of time on a background thread. The reader
+ * can be used from several threads at once.
  */
 class DirectRomFSReader : public RomFSReader {
 public:
     DirectRomFSReader(std::unique_ptr<FileUtil::IOFile>&& file, std::size_t file_offset,
-                      std::size_t data_size)
-        : file(std::move(file)), file_offset(file_offset), data_size(data_size) {}
+                      std::size_t data_size);
 
-    ~DirectRomFSReader() override = default;
+    ~DirectRomFSReader() override;
 
     std::size_t GetSize() const override {
         return data_size;
@@ -61,27 +66,38 @@ public:
 
     bool CacheReady(std::size_t file_offset, std::size_t length) override;
 
+    /// Whether the range is in the block cache, so reading it won't touch the file.
+    bool IsCached(std::size_t file_offset, std::size_t length);
+
 private:
+    // Reads bigger than a block are not cached, as they will probably never hit again.
+    static constexpr std::size_t cache_block_size = 128 * 1024;
+    // Number of blocks past a sequential read that are fetched ahead.
+    static constexpr std::size_t read_ahead_blocks = 2;
+
     std::unique_ptr<FileUtil::IOFile> file;
     u64 file_offset;
     u64 data_size;
 
-    // Total cache size: 128KB
-    static constexpr std::size_t cache_line_size = (1 << 13); // About 8KB
-    static constexpr std::size_t cache_line_count = 16;
+    // Mapping of the whole file, if it could be mapped.
+    std::unique_ptr<FileUtil::MappedFile> mapping;
 
-    Common::StaticLRUCache<std::size_t, std::array<u8, cache_line_size>, cache_line_count> cache;
-    // TODO(PabloMK7): Make cache thread safe, read the comment in CacheReady function.
-    // std::shared_mutex cache_mutex;
+    // Serializes accesses to the file, as crypto files keep their cipher state in the handle.
+    std::mutex file_mutex;
 
-    DirectRomFSReader() = default;
+    // Declared last so that queued read-ahead is stopped before the file is closed. The capacity
+    // comes from the romfs_cache_size setting.
+    Common::BlockCache block_cache;
 
-    std::size_t OffsetToPage(std::size_t offset) {
-        return Common::AlignDown<std::size_t>(offset, cache_line_size);
-    }
+    DirectRomFSReader();
+
+    /// Maps the file if possible and sizes the block cache for it.
+    void MapFile();
+
+    std::size_t ReadFromFile(u8* buffer, std::size_t length, std::size_t offset);
 
-    std::vector<std::pair<std::size_t, std::size_t>> BreakupRead(std::size_t offset,
-                                                                 std::size_t length);
+    /// Loads a whole block from the file.
+    std::vector<u8> LoadBlock(std::size_t block);
 
     template <class Archive>
     void serialize(Archive& ar, const unsigned int) {
@@ -89,17 +105,29 @@ private:
         ar & file;
         ar & file_offset;
         ar & data_size;
+        if (Archive::is_loading::value) {
+            MapFile();
+        }
     }
     friend class boost::serialization::access;
 };
 
 /**
  * A RomFS reader that reads from an artic base server.
+ *
+ * The reads of the title are recorded and saved when the file is closed. In later sessions of
+ * the title they are prefetched in the background a bit ahead of the game, so that the sequences
+ * of small reads loading screens do overlap with the emulation instead of stalling it.
  */
 class ArticRomFSReader : public RomFSReader {
 public:
     ArticRomFSReader() = default;
-    ArticRomFSReader(std::shared_ptr<Network::ArticBase::Client>& cli, bool is_update_romfs);
+    /**
+     * Opens the RomFS of the title running on the server.
+     * @param program_id Title the RomFS belongs to, keys the on-disk cache when it is enabled.
+     */
+    ArticRomFSReader(std::shared_ptr<Network::ArticBase::Client>& cli, bool is_update_romfs,
+                     u64 program_id);
 
     ~ArticRomFSReader() override;
 
@@ -124,6 +152,22 @@ public:
     void CloseFile();
 
 private:
+    // Most bytes of recorded reads fetched ahead of the game. Kept below the size of the small
+    // reads cache, so that prefetched pages are not evicted before the game gets to them.
+    static constexpr std::size_t prefetch_budget = 512 * 1024;
+    // Reads bigger than this are not prefetched, as the cache would not keep them for long.
+    static constexpr std::size_t max_prefetch_read = 1024 * 1024;
+    // Number of recorded reads past the last matched one a read is looked up in.
+    static constexpr std::size_t trace_match_window = 64;
+    static constexpr std::size_t max_trace_reads = 64 * 1024;
+
+    struct TraceRead {
+        u64_le offset;
+        u64_le length;
+
+        bool operator==(const TraceRead&) const = default;
+    };
+
     std::shared_ptr<Network::ArticBase::Client> client;
     size_t data_size = 0;
     s32 romfs_handle = -1;
@@ -131,6 +175,22 @@ private:
 
     ArticCache cache;
 
+    std::string trace_path;
+    std::vector<TraceRead> recorded_reads;
+    std::vector<TraceRead> prefetch_reads;
+    std::size_t prefetch_cursor = 0;
+    std::size_t prefetch_end = 0;
+    std::mutex trace_mutex;
+
+    // Declared last so that queued prefetches are stopped before the cache is destroyed.
+    std::unique_ptr<Common::ThreadWorker> prefetch_worker;
+
+    void LoadTrace();
+    void SaveTrace();
+
+    /// Records a read of the game and queues the recorded reads that came after it last time.
+    void RecordAndPrefetch(std::size_t offset, std::size_t length);
+
     template <class Archive>
     void serialize(Archive& ar, const unsigned int) {
         ar& boost::serialization::base_object<RomFSReader>(*this);
@@ -4,6 +4,7 @@
 
 #include "common/archives.h"
 #include "common/file_util.h"
+#include "common/settings.h"
 #include "core/file_sys/disk_archive.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/path_parser.h"
@@ -32,6 +33,10 @@ public:
         return IPCDelayNanoseconds;
     }
 
+    std::string_view GetArchiveType() const override {
+        return "savedata";
+    }
+
     SERIALIZE_DELAY_GENERATOR
 };
 
@@ -91,7 +96,8 @@ ResultVal<std::unique_ptr<FileBackend>> SaveDataArchive::OpenFile(const Path& pa
     }
 
     std::unique_ptr<DelayGenerator> delay_generator = std::make_unique<SaveDataDelayGenerator>();
-    return std::make_unique<DiskFile>(std::move(file), mode, std::move(delay_generator));
+    return std::make_unique<DiskFile>(std::move(file), mode, std::move(delay_generator),
+                                      Settings::values.save_data_write_back.GetValue());
 }
 
 Result SaveDataArchive::DeleteFile(const Path& path) const {
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <mutex>
+#include <string>
 #include <fmt/format.h>
 #include "common/file_util.h"
 #include "common/logging/log.h"
@@ -9,10 +11,40 @@
 
 namespace FileSys {
 
+namespace {
+
+std::string SeedDBPath() {
+    return fmt::format("{}/seeddb.bin", FileUtil::GetUserPath(FileUtil::UserPath::SysDataDir));
+}
+
+std::mutex seed_db_mutex;
+SeedDB loaded_seed_db;
+/// Path loaded_seed_db was loaded from, empty if it is not loaded.
+std::string loaded_seed_db_path;
+
+/**
+ * Returns the seed database of the current user directory, loading it if it is not loaded yet or
+ * the user directory changed. seed_db_mutex must be held.
+ * @returns The seed database, or nullptr if it could not be loaded
+ */
+SeedDB* GetLoadedSeedDB() {
+    const std::string path = SeedDBPath();
+    if (loaded_seed_db_path != path) {
+        loaded_seed_db_path.clear();
+        if (!loaded_seed_db.Load()) {
+            return nullptr;
+        }
+        loaded_seed_db_path = path;
+    }
+    return &loaded_seed_db;
+}
+
+} // Anonymous namespace
+
 bool SeedDB::Load() {
     seeds.clear();
-    const std::string path{
-        fmt::format("{}/seeddb.bin", FileUtil::GetUserPath(FileUtil::UserPath::SysDataDir))};
+    indices.clear();
+    const std::string path = SeedDBPath();
     if (!FileUtil::Exists(path)) {
         if (!FileUtil::CreateFullPath(path)) {
             LOG_ERROR(Service_FS, "Failed to create seed database");
@@ -54,12 +86,12 @@ bool SeedDB::Load() {
         }
         seeds.push_back(seed);
     }
+    BuildIndex();
     return true;
 }
 
 bool SeedDB::Save() {
-    const std::string path{
-        fmt::format("{}/seeddb.bin", FileUtil::GetUserPath(FileUtil::UserPath::SysDataDir))};
+    const std::string path = SeedDBPath();
     if (!FileUtil::CreateFullPath(path)) {
         LOG_ERROR(Service_FS, "Failed to create seed database");
         return false;
@@ -99,16 +131,17 @@ bool SeedDB::Save() {
 }
 
 void SeedDB::Add(const Seed& seed) {
+    indices.try_emplace(seed.title_id, seeds.size());
     seeds.push_back(seed);
 }
 
 bool SeedDB::Delete(u64 title_id) {
-    auto it = std::find_if(seeds.begin(), seeds.end(),
-                           [title_id](const auto& seed) { return seed.title_id == title_id; });
-    if (it == seeds.end()) {
+    const auto it = indices.find(title_id);
+    if (it == indices.end()) {
         return false;
     }
-    seeds.erase(it);
+    seeds.erase(seeds.begin() + it->second);
+    BuildIndex();
     return true;
 }
 
@@ -116,59 +149,73 @@ std::size_t SeedDB::GetCount() const {
     return seeds.size();
 }
 
-auto SeedDB::FindSeedByTitleID(u64 title_id) const {
-    return std::find_if(seeds.begin(), seeds.end(),
-                        [title_id](const auto& seed) { return seed.title_id == title_id; });
+const Seed* SeedDB::FindSeedByTitleID(u64 title_id) const {
+    const auto it = indices.find(title_id);
+    return it != indices.end() ? &seeds[it->second] : nullptr;
+}
+
+void SeedDB::BuildIndex() {
+    indices.clear();
+    indices.reserve(seeds.size());
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        indices.try_emplace(seeds[i].title_id, i);
+    }
 }
 
 bool AddSeed(const Seed& seed) {
     // TODO: does this skip/replace if the SeedDB contains a seed for seed.title_id?
-    SeedDB db;
-    if (!db.Load()) {
+    std::scoped_lock lock{seed_db_mutex};
+    SeedDB* db = GetLoadedSeedDB();
+    if (!db) {
         LOG_ERROR(Service_FS, "Failed to load seed database");
         return false;
     }
-    db.Add(seed);
-    if (!db.Save()) {
+    db->Add(seed);
+    if (!db->Save()) {
         LOG_ERROR(Service_FS, "Failed to save seed database");
+        // Reload what is on disk on the next use.
+        loaded_seed_db_path.clear();
         return false;
     }
     return true;
 }
 
 std::optional<Seed::Data> GetSeed(u64 title_id) {
-    SeedDB db;
-    if (!db.Load()) {
+    std::scoped_lock lock{seed_db_mutex};
+    const SeedDB* db = GetLoadedSeedDB();
+    if (!db) {
         return std::nullopt;
     }
-    const auto found_seed_iter{db.FindSeedByTitleID(title_id)};
-    if (found_seed_iter != db.seeds.end()) {
-        return found_seed_iter->data;
+    if (const Seed* seed = db->FindSeedByTitleID(title_id)) {
+        return seed->data;
     }
     return std::nullopt;
 }
 
 bool DeleteSeed(u64 title_id) {
-    SeedDB db;
-    if (!db.Load()) {
+    std::scoped_lock lock{seed_db_mutex};
+    SeedDB* db = GetLoadedSeedDB();
+    if (!db) {
         LOG_ERROR(Service_FS, "Failed to load seed database");
         return false;
     }
-    bool found = db.Delete(title_id);
+    bool found = db->Delete(title_id);
     if (found) {
-        if (!db.Save()) {
+        if (!db->Save()) {
             LOG_ERROR(Service_FS, "Failed to save seed database");
+            loaded_seed_db_path.clear();
         }
     }
     return found;
 }
 
 u32 GetSeedCount() {
-    SeedDB db;
-    if (!db.Load()) {
+    std::scoped_lock lock{seed_db_mutex};
+    const SeedDB* db = GetLoadedSeedDB();
+    if (!db) {
         return 0;
     }
-    return static_cast<u32>(db.GetCount());
+    return static_cast<u32>(db->GetCount());
 }
 
 } // namespace FileSys
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
@@ -31,9 +32,17 @@ struct SeedDB {
     bool Delete(u64 title_id);
 
     std::size_t GetCount() const;
-    auto FindSeedByTitleID(u64 title_id) const;
+    const Seed* FindSeedByTitleID(u64 title_id) const;
+
+private:
+    void BuildIndex();
+
+    /// Index in seeds of the first seed of each title.
+    std::unordered_map<u64, std::size_t> indices;
 };
 
+// The functions below share one seed database in memory, loaded from the user directory on its
+// first use instead of on every lookup.
 bool AddSeed(const Seed& seed);
 std::optional<Seed::Data> GetSeed(u64 title_id);
 bool DeleteSeed(u64 title_id);
@@ -186,6 +186,10 @@ std::array<u8, 16> TitleMetadata::GetContentCTRByIndex(std::size_t index) const
     return ctr;
 }
 
+const std::array<u8, 0x20>& TitleMetadata::GetContentHashByIndex(std::size_t index) const {
+    return tmd_chunks[index].hash;
+}
+
 bool TitleMetadata::HasEncryptedContent(const CIAHeader* header) const {
     return std::any_of(tmd_chunks.begin(), tmd_chunks.end(), [header](auto& chunk) {
         bool is_crypted =
@@ -101,6 +101,7 @@ public:
     u64 GetContentSizeByIndex(std::size_t index) const;
     bool GetContentOptional(std::size_t index) const;
     std::array<u8, 16> GetContentCTRByIndex(std::size_t index) const;
+    const std::array<u8, 0x20>& GetContentHashByIndex(std::size_t index) const;
     bool HasEncryptedContent(const CIAHeader* header = nullptr) const;
 
     void SetTitleID(u64 title_id);
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #define DDSKTX_IMPLEMENT
 #include <dds-ktx.h>
 #include <lodepng.h>
@@ -44,9 +45,20 @@ bool ImageInterface::DecodeDDS(std::vector<u8>& dst, u32& width, u32& height, dd
 }
 
 bool ImageInterface::EncodePNG(const std::string& path, u32 width, u32 height,
-                               std::span<const u8> src) {
+                               std::span<const u8> src, u32 compression_level) {
+    // Level 4 matches the lodepng defaults, lower levels trade file size for encoding speed.
+    lodepng::State state;
+    auto& zlib = state.encoder.zlibsettings;
+    if (compression_level == 0) {
+        zlib.btype = 0;
+    } else {
+        zlib.windowsize = 1U << std::min(compression_level + 7, 15U);
+        zlib.lazymatching = compression_level >= 4;
+    }
+    state.encoder.filter_strategy = compression_level >= 3 ? LFS_MINSUM : LFS_ZERO;
+
     std::vector<u8> out;
-    const u32 lodepng_ret = lodepng::encode(out, src.data(), width, height);
+    const u32 lodepng_ret = lodepng::encode(out, src.data(), width, height, state);
     if (lodepng_ret) {
         LOG_ERROR(Frontend, "Failed to encode {} because {}", path,
                   lodepng_error_text(lodepng_ret));
@@ -23,7 +23,9 @@ public:
     virtual bool DecodePNG(std::vector<u8>& dst, u32& width, u32& height, std::span<const u8> src);
     virtual bool DecodeDDS(std::vector<u8>& dst, u32& width, u32& height, ddsktx_format& format,
                            std::span<const u8> src);
-    virtual bool EncodePNG(const std::string& path, u32 width, u32 height, std::span<const u8> src);
+    /// Encodes src to a png at path, compression_level ranges from 0 (none) to 9 (smallest).
+    virtual bool EncodePNG(const std::string& path, u32 width, u32 height, std::span<const u8> src,
+                           u32 compression_level);
 };
 
 } // namespace Frontend
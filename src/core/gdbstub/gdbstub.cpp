@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <bitset>
 #include <csignal>
 #include <cstdarg>
 #include <cstdio>
@@ -157,6 +158,9 @@ using BreakpointMap = std::map<VAddr, Breakpoint>;
 BreakpointMap breakpoints_execute;
 BreakpointMap breakpoints_read;
 BreakpointMap breakpoints_write;
+
+/// Pages holding a read or write watchpoint, so accesses elsewhere skip the breakpoint maps.
+std::bitset<(1ULL << 32) / Memory::CITRA_PAGE_SIZE> watched_pages;
 } // Anonymous namespace
 
 static Kernel::Thread* FindThreadById(int id) {
@@ -391,6 +395,20 @@ static BreakpointMap& GetBreakpointMap(BreakpointType type) {
     }
 }
 
+/// Marks the pages covered by the read and write watchpoints.
+static void UpdateWatchedPages() {
+    watched_pages.reset();
+    for (const BreakpointMap* map : {&breakpoints_read, &breakpoints_write}) {
+        for (const auto& [addr, breakpoint] : *map) {
+            const u64 end = static_cast<u64>(addr) + std::max(breakpoint.len, 1U);
+            for (u64 page = addr >> Memory::CITRA_PAGE_BITS;
+                 page <= (end - 1) >> Memory::CITRA_PAGE_BITS; page++) {
+                watched_pages.set(page);
+            }
+        }
+    }
+}
+
 /**
  * Remove the breakpoint from the given address of the specified type.
  *
@@ -418,6 +436,9 @@ static void RemoveBreakpoint(BreakpointType type, VAddr addr) {
         }
     }
     p.erase(addr);
+    if (type != BreakpointType::Execute) {
+        UpdateWatchedPages();
+    }
 }
 
 BreakpointAddress GetNextBreakpointFromAddress(VAddr addr, BreakpointType type) {
@@ -440,13 +461,17 @@ bool CheckBreakpoint(VAddr addr, BreakpointType type) {
     if (!IsConnected()) {
         return false;
     }
+    if (type != BreakpointType::Execute && !watched_pages.test(addr >> Memory::CITRA_PAGE_BITS)) {
+        return false;
+    }
 
+    // Watchpoints cover a range, so look for the closest one starting at or before the address.
     const BreakpointMap& p = GetBreakpointMap(type);
-    const auto bp = p.find(addr);
-
-    if (bp == p.end()) {
+    auto bp = p.upper_bound(addr);
+    if (bp == p.begin()) {
         return false;
     }
+    bp = std::prev(bp);
 
     u32 len = bp->second.len;
 
@@ -485,14 +510,20 @@ static void SendPacket(const char packet) {
     }
 }
 
-void SendReply(const char* reply) {
+/**
+ * Send reply to gdb client, which may hold binary data.
+ *
+ * @param reply Reply to be sent to client.
+ * @param length Length of the reply.
+ */
+static void SendReply(const u8* reply, u32 length) {
     if (!IsConnected()) {
         return;
     }
 
     std::memset(command_buffer, 0, sizeof(command_buffer));
 
-    command_length = static_cast<u32>(strlen(reply));
+    command_length = length;
     if (command_length + 4 > sizeof(command_buffer)) {
         LOG_ERROR(Debug_GDBStub, "command_buffer overflow in SendReply");
         return;
@@ -521,6 +552,10 @@ void SendReply(const char* reply) {
     }
 }
 
+void SendReply(const char* reply) {
+    SendReply(reinterpret_cast<const u8*>(reply), static_cast<u32>(strlen(reply)));
+}
+
 /// Handle query command from gdb client.
 static void HandleQuery() {
     const char* query = reinterpret_cast<const char*>(command_buffer + 1);
@@ -530,7 +565,7 @@ static void HandleQuery() {
         SendReply("T0");
     } else if (strncmp(query, "Supported", strlen("Supported")) == 0) {
         // PacketSize needs to be large enough for target xml
-        SendReply("PacketSize=2000;qXfer:features:read+;qXfer:threads:read+");
+        SendReply("PacketSize=2000;qXfer:features:read+;qXfer:threads:read+;binary-upload+");
     } else if (strncmp(query, "Xfer:features:read:target.xml:",
                        strlen("Xfer:features:read:target.xml:")) == 0) {
         SendReply(target_xml);
@@ -820,63 +855,106 @@ static void WriteRegisters() {
     SendReply("OK");
 }
 
-/// Read location in memory specified by gdb client.
-static void ReadMemory() {
-    static u8 reply[GDB_BUFFER_SIZE - 4];
-
+/// Parses the address and the length of a memory packet, returns the end of the length.
+static const u8* ParseMemoryRange(VAddr& addr, u32& len, u8 length_end) {
     auto start_offset = command_buffer + 1;
     auto addr_pos = std::find(start_offset, command_buffer + command_length, ',');
-    VAddr addr = HexToInt(start_offset, static_cast<u32>(addr_pos - start_offset));
+    addr = HexToInt(start_offset, static_cast<u32>(addr_pos - start_offset));
 
     start_offset = addr_pos + 1;
-    u32 len =
-        HexToInt(start_offset, static_cast<u32>((command_buffer + command_length) - start_offset));
+    auto len_pos = std::find(start_offset, command_buffer + command_length, length_end);
+    len = HexToInt(start_offset, static_cast<u32>(len_pos - start_offset));
+    return len_pos;
+}
+
+static bool IsValidAddress(VAddr addr) {
+    auto& system = Core::System::GetInstance();
+    return system.Memory().IsValidVirtualAddress(*system.Kernel().GetCurrentProcess(), addr);
+}
+
+/**
+ * Read location in memory specified by gdb client, as hex digits for m packets or as escaped
+ * binary data for x packets.
+ */
+static void ReadMemory(bool binary) {
+    static u8 reply[GDB_BUFFER_SIZE - 4];
+
+    VAddr addr;
+    u32 len;
+    ParseMemoryRange(addr, len, '\0');
 
     LOG_DEBUG(Debug_GDBStub, "ReadMemory addr: {:08x} len: {:08x}", addr, len);
 
-    if (len * 2 > sizeof(reply)) {
-        SendReply("E01");
+    // Both encodings take at most two bytes per byte of memory.
+    if (len * 2 + 1 > sizeof(reply)) {
+        return SendReply("E01");
     }
-
-    auto& memory = Core::System::GetInstance().Memory();
-    if (!memory.IsValidVirtualAddress(*Core::System::GetInstance().Kernel().GetCurrentProcess(),
-                                      addr)) {
+    if (!IsValidAddress(addr)) {
         return SendReply("E00");
     }
 
     std::vector<u8> data(len);
-    memory.ReadBlock(addr, data.data(), len);
+    Core::System::GetInstance().Memory().ReadBlock(addr, data.data(), len);
 
-    MemToGdbHex(reply, data.data(), len);
-    reply[len * 2] = '\0';
+    if (!binary) {
+        MemToGdbHex(reply, data.data(), len);
+        reply[len * 2] = '\0';
 
-    auto reply_str = reinterpret_cast<char*>(reply);
+        auto reply_str = reinterpret_cast<char*>(reply);
 
-    LOG_DEBUG(Debug_GDBStub, "ReadMemory result: {}", reply_str);
-    SendReply(reply_str);
-}
+        LOG_DEBUG(Debug_GDBStub, "ReadMemory result: {}", reply_str);
+        return SendReply(reply_str);
+    }
 
-/// Modify location in memory with data received from the gdb client.
-static void WriteMemory() {
-    auto start_offset = command_buffer + 1;
-    auto addr_pos = std::find(start_offset, command_buffer + command_length, ',');
-    VAddr addr = HexToInt(start_offset, static_cast<u32>(addr_pos - start_offset));
+    u32 reply_length = 0;
+    reply[reply_length++] = 'b';
+    for (const u8 byte : data) {
+        if (byte == '#' || byte == '$' || byte == '}' || byte == '*') {
+            reply[reply_length++] = '}';
+            reply[reply_length++] = byte ^ 0x20;
+        } else {
+            reply[reply_length++] = byte;
+        }
+    }
+    SendReply(reply, reply_length);
+}
 
-    start_offset = addr_pos + 1;
-    auto len_pos = std::find(start_offset, command_buffer + command_length, ':');
-    u32 len = HexToInt(start_offset, static_cast<u32>(len_pos - start_offset));
+/**
+ * Modify location in memory with data received from the gdb client, as hex digits for M
+ * packets or as escaped binary data for X packets.
+ */
+static void WriteMemory(bool binary) {
+    VAddr addr;
+    u32 len;
+    const u8* data_start = ParseMemoryRange(addr, len, ':') + 1;
 
-    auto& memory = Core::System::GetInstance().Memory();
-    if (!memory.IsValidVirtualAddress(*Core::System::GetInstance().Kernel().GetCurrentProcess(),
-                                      addr)) {
+    // An empty X packet probes for binary write support.
+    if (len != 0 && !IsValidAddress(addr)) {
         return SendReply("E00");
     }
 
     std::vector<u8> data(len);
+    const u8* const data_end = command_buffer + command_length;
+    if (!binary) {
+        if (data_start + len * 2 > data_end) {
+            return SendReply("E01");
+        }
+        GdbHexToMem(data.data(), data_start, len);
+    } else {
+        const u8* in = data_start;
+        for (u32 i = 0; i < len; i++) {
+            if (in >= data_end) {
+                return SendReply("E01");
+            }
+            data[i] = *in == '}' && in + 1 < data_end ? *++in ^ 0x20 : *in;
+            in++;
+        }
+    }
 
-    GdbHexToMem(data.data(), len_pos + 1, len);
-    memory.WriteBlock(addr, data.data(), len);
-    Core::GetRunningCore().ClearInstructionCache();
+    if (len != 0) {
+        Core::System::GetInstance().Memory().WriteBlock(addr, data.data(), len);
+        Core::GetRunningCore().ClearInstructionCache();
+    }
     SendReply("OK");
 }
 
@@ -940,6 +1018,9 @@ static bool CommitBreakpoint(BreakpointType type, VAddr addr, u32 len) {
         Core::GetRunningCore().ClearInstructionCache();
     }
     p.insert({addr, breakpoint});
+    if (type != BreakpointType::Execute) {
+        UpdateWatchedPages();
+    }
 
     LOG_DEBUG(Debug_GDBStub, "gdb: added {} breakpoint: {:08x} bytes at {:08x}\n", type,
               breakpoint.len, breakpoint.addr);
@@ -1091,10 +1172,16 @@ void HandlePacket(Core::System& system) {
         WriteRegister();
         break;
     case 'm':
-        ReadMemory();
+        ReadMemory(false);
+        break;
+    case 'x':
+        ReadMemory(true);
         break;
     case 'M':
-        WriteMemory();
+        WriteMemory(false);
+        break;
+    case 'X':
+        WriteMemory(true);
         break;
     case 's':
         Step();
@@ -1125,6 +1212,7 @@ void SetServerPort(u16 port) {
 void ToggleServer(bool status) {
     if (status) {
         server_enabled = status;
+        Core::System::GetInstance().SetDebuggerEnabled(true);
 
         // Start server
         if (!IsConnected() && Core::System::GetInstance().IsPoweredOn()) {
@@ -1137,6 +1225,7 @@ void ToggleServer(bool status) {
         }
 
         server_enabled = status;
+        Core::System::GetInstance().SetDebuggerEnabled(false);
     }
 }
 
@@ -6,6 +6,7 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/string.hpp>
+#include <boost/serialization/unordered_map.hpp>
 #include <boost/serialization/vector.hpp>
 #include "common/archives.h"
 #include "common/common_types.h"
@@ -22,54 +23,79 @@ SERIALIZE_EXPORT_IMPL(Kernel::AddressArbiter::Callback)
 
 namespace Kernel {
 
+void AddressArbiter::WaitLists::Add(std::shared_ptr<Thread> thread) {
+    // Keeps the threads of an older savestate ahead of this one.
+    SortWaitingThreads();
+    const VAddr address = thread->wait_address;
+    lists[address].emplace_back(std::move(thread));
+}
+
+AddressArbiter::WaitLists::List* AddressArbiter::WaitLists::Find(VAddr address) {
+    SortWaitingThreads();
+    const auto it = lists.find(address);
+    return it != lists.end() ? &it->second : nullptr;
+}
+
+void AddressArbiter::WaitLists::Erase(VAddr address) {
+    lists.erase(address);
+}
+
+void AddressArbiter::WaitLists::AddUnsorted(List threads) {
+    unsorted.insert(unsorted.end(), std::make_move_iterator(threads.begin()),
+                    std::make_move_iterator(threads.end()));
+}
+
+void AddressArbiter::WaitLists::SortWaitingThreads() {
+    for (auto& thread : unsorted) {
+        lists[thread->wait_address].emplace_back(std::move(thread));
+    }
+    unsorted.clear();
+}
+
 void AddressArbiter::WaitThread(std::shared_ptr<Thread> thread, VAddr wait_address) {
     thread->wait_address = wait_address;
     thread->status = ThreadStatus::WaitArb;
-    waiting_threads.emplace_back(std::move(thread));
+    waiting_threads.Add(std::move(thread));
 }
 
 u64 AddressArbiter::ResumeAllThreads(VAddr address) {
-    // Determine which threads are waiting on this address, those should be woken up.
-    auto itr = std::stable_partition(waiting_threads.begin(), waiting_threads.end(),
-                                     [address](const auto& thread) {
-                                         ASSERT_MSG(thread->status == ThreadStatus::WaitArb,
-                                                    "Inconsistent AddressArbiter state");
-                                         return thread->wait_address != address;
-                                     });
-
-    // Wake up all the found threads
-    const u64 num_threads = std::distance(itr, waiting_threads.end());
-    std::for_each(itr, waiting_threads.end(), [](auto& thread) { thread->ResumeFromWait(); });
-
-    // Remove the woken up threads from the wait list.
-    waiting_threads.erase(itr, waiting_threads.end());
+    auto* const threads = waiting_threads.Find(address);
+    if (!threads) {
+        return 0;
+    }
+
+    // Wake up all the threads waiting on this address and drop their wait list.
+    const u64 num_threads = threads->size();
+    for (auto& thread : *threads) {
+        ASSERT_MSG(thread->status == ThreadStatus::WaitArb, "Inconsistent AddressArbiter state");
+        thread->ResumeFromWait();
+    }
+    waiting_threads.Erase(address);
     return num_threads;
 }
 
 bool AddressArbiter::ResumeHighestPriorityThread(VAddr address) {
-    // Determine which threads are waiting on this address, those should be considered for wakeup.
-    auto matches_start = std::stable_partition(
-        waiting_threads.begin(), waiting_threads.end(), [address](const auto& thread) {
-            ASSERT_MSG(thread->status == ThreadStatus::WaitArb,
-                       "Inconsistent AddressArbiter state");
-            return thread->wait_address != address;
-        });
+    auto* const threads = waiting_threads.Find(address);
+    if (!threads) {
+        return false;
+    }
 
     // Iterate through threads, find highest priority thread that is waiting to be arbitrated.
     // Note: The real kernel will pick the first thread in the list if more than one have the
-    // same highest priority value. Lower priority values mean higher priority.
-    auto itr = std::min_element(matches_start, waiting_threads.end(),
+    // same highest priority value. Lower priority values mean higher priority. The priorities
+    // can change while the threads wait, so the list is kept in arrival order and searched.
+    auto itr = std::min_element(threads->begin(), threads->end(),
                                 [](const auto& lhs, const auto& rhs) {
                                     return lhs->current_priority < rhs->current_priority;
                                 });
-
-    if (itr == waiting_threads.end()) {
-        return false;
-    }
+    ASSERT_MSG((*itr)->status == ThreadStatus::WaitArb, "Inconsistent AddressArbiter state");
 
     auto thread = *itr;
     thread->ResumeFromWait();
-    waiting_threads.erase(itr);
+    threads->erase(itr);
+    if (threads->empty()) {
+        waiting_threads.Erase(address);
+    }
 
     return true;
 }
@@ -111,8 +137,14 @@ void AddressArbiter::WakeUp(ThreadWakeupReason reason, std::shared_ptr<Thread> t
                             std::shared_ptr<WaitObject> object) {
     ASSERT(reason == ThreadWakeupReason::Timeout);
     // Remove the newly-awakened thread from the Arbiter's waiting list.
-    waiting_threads.erase(std::remove(waiting_threads.begin(), waiting_threads.end(), thread),
-                          waiting_threads.end());
+    auto* const threads = waiting_threads.Find(thread->wait_address);
+    if (!threads) {
+        return;
+    }
+    threads->erase(std::remove(threads->begin(), threads->end(), thread), threads->end());
+    if (threads->empty()) {
+        waiting_threads.Erase(thread->wait_address);
+    }
 };
 
 Result AddressArbiter::ArbitrateAddress(std::shared_ptr<Thread> thread, ArbitrationType type,
@@ -191,10 +223,17 @@ Result AddressArbiter::ArbitrateAddress(std::shared_ptr<Thread> thread, Arbitrat
 }
 
 template <class Archive>
-void AddressArbiter::serialize(Archive& ar, const unsigned int) {
+void AddressArbiter::serialize(Archive& ar, const unsigned int file_version) {
     ar& boost::serialization::base_object<Object>(*this);
     ar & name;
-    ar & waiting_threads;
+    if (file_version >= 1) {
+        ar & waiting_threads.lists;
+        ar & waiting_threads.unsorted;
+    } else {
+        WaitLists::List threads;
+        ar & threads;
+        waiting_threads.AddUnsorted(std::move(threads));
+    }
     ar & timeout_callback;
     ar & resource_limit;
 }
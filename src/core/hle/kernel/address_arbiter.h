@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <boost/serialization/export.hpp>
 #include "common/common_types.h"
@@ -55,6 +56,34 @@ public:
 
     class Callback;
 
+    /// Threads waiting on the addresses of an arbiter, in arrival order per address.
+    class WaitLists {
+    public:
+        using List = std::vector<std::shared_ptr<Thread>>;
+
+        /// Appends the thread to the list of its wait address.
+        void Add(std::shared_ptr<Thread> thread);
+
+        /// Returns the list of the threads waiting on the address, or null if there are none.
+        List* Find(VAddr address);
+
+        /// Drops the list of the address.
+        void Erase(VAddr address);
+
+        /// Takes the waiting threads an older savestate stored as one list. They are split by
+        /// address on first use, as the threads may not have been fully loaded yet.
+        void AddUnsorted(List threads);
+
+    private:
+        /// Splits the threads of an older savestate up by their wait address.
+        void SortWaitingThreads();
+
+        std::unordered_map<VAddr, List> lists;
+        List unsorted;
+
+        friend class AddressArbiter;
+    };
+
 private:
     KernelSystem& kernel;
 
@@ -68,8 +97,8 @@ private:
     /// the resumed thread.
     bool ResumeHighestPriorityThread(VAddr address);
 
-    /// Threads waiting for the address arbiter to be signaled.
-    std::vector<std::shared_ptr<Thread>> waiting_threads;
+    /// Threads waiting for the address arbiter to be signaled
+    WaitLists waiting_threads;
 
     std::shared_ptr<Callback> timeout_callback;
 
@@ -84,5 +113,6 @@ private:
 } // namespace Kernel
 
 BOOST_CLASS_EXPORT_KEY(Kernel::AddressArbiter)
+BOOST_CLASS_VERSION(Kernel::AddressArbiter, 1)
 BOOST_CLASS_EXPORT_KEY(Kernel::AddressArbiter::Callback)
 CONSTRUCT_KERNEL_OBJECT(Kernel::AddressArbiter)
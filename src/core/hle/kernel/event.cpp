@@ -6,6 +6,7 @@
 #include <boost/serialization/string.hpp>
 #include "common/archives.h"
 #include "common/assert.h"
+#include "common/object_pool.h"
 #include "core/hle/kernel/event.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/resource_limit.h"
@@ -24,7 +25,7 @@ Event::~Event() {
 }
 
 std::shared_ptr<Event> KernelSystem::CreateEvent(ResetType reset_type, std::string name) {
-    auto event = std::make_shared<Event>(*this);
+    auto event = Common::MakePooledShared<Event>(*this);
     event->signaled = false;
     event->reset_type = reset_type;
     event->name = std::move(name);
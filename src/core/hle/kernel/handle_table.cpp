@@ -16,15 +16,6 @@
 SERIALIZE_EXPORT_IMPL(Kernel::HandleTable)
 
 namespace Kernel {
-namespace {
-constexpr u16 GetSlot(Handle handle) {
-    return handle >> 15;
-}
-
-constexpr u16 GetGeneration(Handle handle) {
-    return handle & 0x7FFF;
-}
-} // Anonymous namespace
 
 HandleTable::HandleTable(KernelSystem& kernel) : kernel(kernel) {
     next_generation = 1;
@@ -73,9 +64,7 @@ Result HandleTable::Close(Handle handle) {
 }
 
 bool HandleTable::IsValid(Handle handle) const {
-    const u16 slot = GetSlot(handle);
-    const u16 generation = GetGeneration(handle);
-    return slot < MAX_COUNT && objects[slot] != nullptr && generations[slot] == generation;
+    return LookupSlot(handle) != nullptr;
 }
 
 std::shared_ptr<Object> HandleTable::GetGeneric(Handle handle) const {
@@ -85,10 +74,7 @@ std::shared_ptr<Object> HandleTable::GetGeneric(Handle handle) const {
         return kernel.GetCurrentProcess();
     }
 
-    if (!IsValid(handle)) {
-        return nullptr;
-    }
-    return objects[GetSlot(handle)];
+    return LookupSlot(handle);
 }
 
 void HandleTable::Clear() {
@@ -85,7 +85,11 @@ public:
      */
     template <class T>
     std::shared_ptr<T> Get(Handle handle) const {
-        return DynamicObjectCast<T>(GetGeneric(handle));
+        if (IsPseudoHandle(handle)) {
+            return DynamicObjectCast<T>(GetGeneric(handle));
+        }
+        // Cast straight from the slot so that only the returned pointer touches the ref-count.
+        return DynamicObjectCast<T>(LookupSlot(handle));
     }
 
     /// Closes all handles held in this table.
@@ -98,6 +102,31 @@ private:
      */
     static const std::size_t MAX_COUNT = 4096;
 
+    static constexpr u16 GetSlot(Handle handle) {
+        return static_cast<u16>(handle >> 15);
+    }
+
+    static constexpr u16 GetGeneration(Handle handle) {
+        return handle & 0x7FFF;
+    }
+
+    static constexpr bool IsPseudoHandle(Handle handle) {
+        return handle == CurrentThread || handle == CurrentProcess;
+    }
+
+    /**
+     * Returns the object stored in the slot referenced by the handle, or a reference to an empty
+     * pointer if the handle is out of range or stale. Pseudo-handles are not resolved.
+     */
+    const std::shared_ptr<Object>& LookupSlot(Handle handle) const {
+        static const std::shared_ptr<Object> null_object;
+        const u16 slot = GetSlot(handle);
+        if (slot >= MAX_COUNT || generations[slot] != GetGeneration(handle) || !objects[slot]) {
+            return null_object;
+        }
+        return objects[slot];
+    }
+
     /// Stores the Object referenced by the handle or null if the slot is empty.
     std::array<std::shared_ptr<Object>, MAX_COUNT> objects;
 
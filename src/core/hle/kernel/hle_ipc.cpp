@@ -359,4 +359,13 @@ void MappedBuffer::Write(const void* src_buffer, std::size_t offset, std::size_t
     memory->WriteBlock(*process, address + static_cast<VAddr>(offset), src_buffer, size);
 }
 
+std::span<u8> MappedBuffer::GetContiguousView(std::size_t offset, std::size_t size) {
+    if (offset + size > this->size) {
+        return {};
+    }
+    u8* pointer =
+        memory->GetContiguousPointer(*process, address + static_cast<VAddr>(offset), size);
+    return pointer ? std::span<u8>{pointer, size} : std::span<u8>{};
+}
+
 } // namespace Kernel
@@ -9,7 +9,9 @@
 #include <chrono>
 #include <future>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <boost/container/small_vector.hpp>
 #include <boost/serialization/export.hpp>
@@ -68,6 +70,11 @@ public:
      */
     virtual void ClientDisconnected(std::shared_ptr<ServerSession> server_session);
 
+    /// Returns the name under which the cost of requests to this handler is reported.
+    virtual std::string_view GetHandlerName() const {
+        return "Unknown";
+    }
+
     /// Empty placeholder structure for services with no per-session data. The session data classes
     /// in each service must inherit from this.
     struct SessionDataBase {
@@ -127,6 +134,14 @@ public:
     // interface for service
     void Read(void* dest_buffer, std::size_t offset, std::size_t size);
     void Write(const void* src_buffer, std::size_t offset, std::size_t size);
+
+    /**
+     * Returns a view of the guest memory in [offset, offset + size) that services can read from or
+     * write into in place, skipping the bounce buffer of Read/Write. This is only possible when
+     * the range is contiguous in host memory and not held by the rasterizer cache; otherwise the
+     * returned span is empty and Read/Write must be used instead.
+     */
+    std::span<u8> GetContiguousView(std::size_t offset, std::size_t size);
     std::size_t GetSize() const {
         return size;
     }
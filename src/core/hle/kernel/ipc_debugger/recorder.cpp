@@ -42,28 +42,24 @@ ObjectInfo GetObjectInfo(const Kernel::Process* process) {
 Recorder::Recorder() = default;
 Recorder::~Recorder() = default;
 
-bool Recorder::IsEnabled() const {
-    return enabled.load(std::memory_order_relaxed);
-}
-
 void Recorder::RegisterRequest(const std::shared_ptr<Kernel::ClientSession>& client_session,
                                const std::shared_ptr<Kernel::Thread>& client_thread) {
     const u32 thread_id = client_thread->GetThreadId();
 
     if (auto owner_process = client_thread->owner_process.lock()) {
-        RequestRecord record = {/* id */ ++record_count,
-                                /* status */ RequestStatus::Sent,
-                                /* client_process */ GetObjectInfo(owner_process.get()),
-                                /* client_thread */ GetObjectInfo(client_thread.get()),
-                                /* client_session */ GetObjectInfo(client_session.get()),
-                                /* client_port */ GetObjectInfo(client_session->parent->port.get()),
-                                /* server_process */ {},
-                                /* server_thread */ {},
-                                /* server_session */ GetObjectInfo(client_session->parent->server)};
-        record_map.insert_or_assign(thread_id, std::make_unique<RequestRecord>(record));
+        auto record = std::make_unique<RequestRecord>(RequestRecord{
+            .id = ++record_count,
+            .status = RequestStatus::Sent,
+            .client_process = GetObjectInfo(owner_process.get()),
+            .client_thread = GetObjectInfo(client_thread.get()),
+            .client_session = GetObjectInfo(client_session.get()),
+            .client_port = GetObjectInfo(client_session->parent->port.get()),
+            .server_session = GetObjectInfo(client_session->parent->server),
+        });
+        InvokeCallbacks(*record);
+
+        record_map.insert_or_assign(thread_id, std::move(record));
         client_session_map.insert_or_assign(thread_id, client_session);
-
-        InvokeCallbacks(record);
     }
 }
 
@@ -145,12 +141,14 @@ CallbackHandle Recorder::BindCallback(CallbackType callback) {
     std::unique_lock lock(callback_mutex);
     CallbackHandle handle = std::make_shared<CallbackType>(callback);
     callbacks.emplace(handle);
+    UpdateRecording();
     return handle;
 }
 
 void Recorder::UnbindCallback(const CallbackHandle& handle) {
     std::unique_lock lock(callback_mutex);
     callbacks.erase(handle);
+    UpdateRecording();
 }
 
 void Recorder::InvokeCallbacks(const RequestRecord& request) {
@@ -163,7 +161,14 @@ void Recorder::InvokeCallbacks(const RequestRecord& request) {
 }
 
 void Recorder::SetEnabled(bool enabled_) {
-    enabled.store(enabled_, std::memory_order_relaxed);
+    std::unique_lock lock(callback_mutex);
+    enabled = enabled_;
+    UpdateRecording();
+}
+
+void Recorder::UpdateRecording() {
+    // Records are only reported through the callbacks, so there is nothing to build without one.
+    recording.store(enabled && !callbacks.empty(), std::memory_order_relaxed);
 }
 
 } // namespace IPCDebugger
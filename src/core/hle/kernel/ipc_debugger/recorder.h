@@ -73,9 +73,12 @@ public:
     ~Recorder();
 
     /**
-     * Returns whether the recorder is enabled.
+     * Returns whether the recorder is enabled and has a callback to report the records to. This
+     * is checked on every IPC request, so it stays inline.
      */
-    bool IsEnabled() const;
+    bool IsEnabled() const {
+        return recording.load(std::memory_order_relaxed);
+    }
 
     /**
      * Registers a request into the recorder. The request is then assoicated with the client thread.
@@ -113,6 +116,7 @@ public:
 
 private:
     void InvokeCallbacks(const RequestRecord& request);
+    void UpdateRecording();
 
     std::unordered_map<u32, std::unique_ptr<RequestRecord>> record_map;
     int record_count{};
@@ -120,7 +124,9 @@ private:
     // Temporary client session map for function name handling
     std::unordered_map<u32, std::shared_ptr<Kernel::ClientSession>> client_session_map;
 
-    std::atomic_bool enabled{false};
+    bool enabled{false};
+    /// Whether enabled and at least one callback is bound, updated with the callback mutex held.
+    std::atomic_bool recording{false};
 
     std::set<CallbackHandle> callbacks;
     mutable std::shared_mutex callback_mutex;
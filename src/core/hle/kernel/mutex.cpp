@@ -7,6 +7,7 @@
 #include <boost/serialization/string.hpp>
 #include "common/archives.h"
 #include "common/assert.h"
+#include "common/object_pool.h"
 #include "core/core.h"
 #include "core/hle/kernel/errors.h"
 #include "core/hle/kernel/kernel.h"
@@ -37,7 +38,7 @@ Mutex::~Mutex() {
 }
 
 std::shared_ptr<Mutex> KernelSystem::CreateMutex(bool initial_locked, std::string name) {
-    auto mutex = std::make_shared<Mutex>(*this);
+    auto mutex = Common::MakePooledShared<Mutex>(*this);
     mutex->lock_count = 0;
     mutex->name = std::move(name);
     mutex->holding_thread = nullptr;
@@ -5,6 +5,7 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/string.hpp>
 #include "common/archives.h"
+#include "common/object_pool.h"
 #include "core/hle/kernel/errors.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
@@ -32,7 +33,7 @@ ResultVal<std::shared_ptr<Semaphore>> KernelSystem::CreateSemaphore(s32 initial_
 
     // When the semaphore is created, some slots are reserved for other threads,
     // and the rest is reserved for the caller thread
-    auto semaphore = std::make_shared<Semaphore>(*this);
+    auto semaphore = Common::MakePooledShared<Semaphore>(*this);
     semaphore->max_count = max_count;
     semaphore->available_count = initial_count;
     semaphore->name = std::move(name);
@@ -95,21 +95,31 @@ Handler::Handler(Core::Timing& timing, u64 override_init_time) : timing(timing)
     SetWifiState(WifiState::Internet);
 }
 
+/// Returns Jan 1 2000 in local time as milliseconds since the Unix epoch.
+static s64 GetEpoch2000() {
+    // std::mktime takes the C library time zone lock and may reload the time zone, the result
+    // does not change while running so it is only computed once.
+    static const s64 epoch = [] {
+        std::tm epoch_tm;
+        epoch_tm.tm_sec = 0;
+        epoch_tm.tm_min = 0;
+        epoch_tm.tm_hour = 0;
+        epoch_tm.tm_mday = 1;
+        epoch_tm.tm_mon = 0;
+        epoch_tm.tm_year = 100;
+        epoch_tm.tm_isdst = 0;
+        return static_cast<s64>(std::mktime(&epoch_tm)) * 1000;
+    }();
+    return epoch;
+}
+
 u64 Handler::GetSystemTimeSince2000() const {
     std::chrono::milliseconds now =
         init_time + std::chrono::duration_cast<std::chrono::milliseconds>(timing.GetGlobalTimeUs());
 
     // 3DS system does't allow user to set a time before Jan 1 2000,
     // so we use it as an auxiliary epoch to calculate the console time.
-    std::tm epoch_tm;
-    epoch_tm.tm_sec = 0;
-    epoch_tm.tm_min = 0;
-    epoch_tm.tm_hour = 0;
-    epoch_tm.tm_mday = 1;
-    epoch_tm.tm_mon = 0;
-    epoch_tm.tm_year = 100;
-    epoch_tm.tm_isdst = 0;
-    s64 epoch = std::mktime(&epoch_tm) * 1000;
+    const s64 epoch = GetEpoch2000();
 
     // Only when system time is after 2000, we set it as 3DS system time
     if (now.count() > epoch) {
@@ -658,15 +658,16 @@ Result SVC::SendSyncRequest(Handle handle) {
         kernel.GetIPCRecorder().RegisterRequest(session, thread);
     }
 
-    const bool is_hle =
-        session->parent->server != nullptr && session->parent->server->hle_handler != nullptr;
+    // Keep the handler alive, the session may be closed while the request is being served.
+    const auto hle_handler =
+        session->parent->server != nullptr ? session->parent->server->hle_handler : nullptr;
 
-    if (is_hle) {
+    if (hle_handler) {
         system.perf_stats->BeginIPCProcessing();
     }
     const auto res = session->SendSyncRequest(thread);
-    if (is_hle) {
-        system.perf_stats->EndIPCProcessing();
+    if (hle_handler) {
+        system.perf_stats->EndIPCProcessing(hle_handler->GetHandlerName());
     }
 
     return res;
@@ -1500,8 +1501,9 @@ Result SVC::QueryProcessMemory(MemoryInfo* memory_info, PageInfo* page_info, Han
     };
 
     std::reverse_iterator rvma(vma);
+    std::reverse_iterator rend(process->vm_manager.vma_map.cbegin());
 
-    auto lower = std::find_if(rvma, process->vm_manager.vma_map.crend(), mismatch);
+    auto lower = std::find_if(rvma, rend, mismatch);
     --lower;
     auto upper = std::find_if(vma, process->vm_manager.vma_map.cend(), mismatch);
     --upper;
@@ -2127,7 +2129,7 @@ Result SVC::ControlProcess(Handle process_handle, u32 process_OP, u32 varg2, u32
         for (auto it = process->vm_manager.vma_map.cbegin();
              it != process->vm_manager.vma_map.cend(); it++) {
             if (it->second.meminfo_state != MemoryState::Free)
-                process->vm_manager.Reprotect(it, Kernel::VMAPermission::ReadWriteExecute);
+                it = process->vm_manager.Reprotect(it, Kernel::VMAPermission::ReadWriteExecute);
         }
         return ResultSuccess;
     }
@@ -2397,16 +2399,18 @@ void SVC::CallSVC(u32 immediate) {
                      "Running threads from exiting processes is unimplemented");
 
     const FunctionDef* info = GetSVCInfo(immediate);
+    if (!info) {
+        system.perf_stats->EndSVCProcessing(immediate, "Unknown");
+        return;
+    }
     LOG_TRACE(Kernel_SVC, "calling {}", info->name);
-    if (info) {
-        if (info->func) {
-            system.GetRunningCore().GetTimer().AddTicks(info->cycles);
-            (this->*(info->func))();
-        } else {
-            LOG_ERROR(Kernel_SVC, "unimplemented SVC function {:02X} {}(..)", info->id, info->name);
-        }
+    if (info->func) {
+        system.GetRunningCore().GetTimer().AddTicks(info->cycles);
+        (this->*(info->func))();
+    } else {
+        LOG_ERROR(Kernel_SVC, "unimplemented SVC function {:02X} {}(..)", info->id, info->name);
     }
-    system.perf_stats->EndSVCProcessing();
+    system.perf_stats->EndSVCProcessing(info->id, info->name);
 }
 
 SVC::SVC(Core::System& system) : system(system), kernel(system.Kernel()), memory(system.Memory()) {}
@@ -12,6 +12,7 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/object_pool.h"
 #include "common/serialization/boost_flat_set.h"
 #include "common/settings.h"
 #include "core/arm/arm_interface.h"
@@ -375,10 +376,9 @@ ResultVal<std::shared_ptr<Thread>> KernelSystem::CreateThread(
                       ErrorSummary::InvalidArgument, ErrorLevel::Permanent);
     }
 
-    auto thread = std::make_shared<Thread>(*this, processor_id);
+    auto thread = Common::MakePooledShared<Thread>(*this, processor_id);
 
     thread_managers[processor_id]->thread_list.push_back(thread);
-    thread_managers[processor_id]->ready_queue.prepare(priority);
 
     thread->thread_id = NewThreadId();
     thread->status = ThreadStatus::Dormant;
@@ -413,8 +413,6 @@ void Thread::SetPriority(u32 priority) {
     // If thread was ready, adjust queues
     if (status == ThreadStatus::Ready)
         thread_manager.ready_queue.move(this, current_priority, priority);
-    else
-        thread_manager.ready_queue.prepare(priority);
 
     nominal_priority = current_priority = priority;
 }
@@ -432,8 +430,6 @@ void Thread::BoostPriority(u32 priority) {
     // If thread was ready, adjust queues
     if (status == ThreadStatus::Ready)
         thread_manager.ready_queue.move(this, current_priority, priority);
-    else
-        thread_manager.ready_queue.prepare(priority);
     current_priority = priority;
 }
 
@@ -7,6 +7,7 @@
 #include "common/archives.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/object_pool.h"
 #include "core/core.h"
 #include "core/hle/kernel/handle_table.h"
 #include "core/hle/kernel/object.h"
@@ -31,7 +32,7 @@ Timer::~Timer() {
 }
 
 std::shared_ptr<Timer> KernelSystem::CreateTimer(ResetType reset_type, std::string name) {
-    auto timer = std::make_shared<Timer>(*this);
+    auto timer = Common::MakePooledShared<Timer>(*this);
     timer->reset_type = reset_type;
     timer->signaled = false;
     timer->name = std::move(name);
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/split_member.hpp>
@@ -19,6 +20,9 @@ SERIALIZE_EXPORT_IMPL(Kernel::VirtualMemoryArea)
 
 namespace Kernel {
 
+/// Number of VMAs reserved up front. A booted title typically has a few dozen areas.
+constexpr std::size_t INITIAL_VMA_CAPACITY = 64;
+
 static const char* GetMemoryStateName(MemoryState state) {
     static const char* names[] = {
         "Free",   "Reserved",   "IO",      "Static", "Code",      "Private",
@@ -63,6 +67,7 @@ void VMManager::Reset() {
     ASSERT(!is_locked);
 
     vma_map.clear();
+    vma_map.reserve(INITIAL_VMA_CAPACITY);
 
     // Initialize the map with a single free region covering the entire managed space.
     VirtualMemoryArea initial_vma;
@@ -158,10 +163,9 @@ Result VMManager::ChangeMemoryState(VAddr target, u32 size, MemoryState expected
 
     CASCADE_RESULT(auto vma, CarveVMARange(target, size));
 
-    const VMAIter end = vma_map.end();
     // The comparison against the end of the range must be done using addresses since VMAs can be
     // merged during this process, causing invalidation of the iterators.
-    while (vma != end && vma->second.base < target_end) {
+    while (vma != vma_map.end() && vma->second.base < target_end) {
         vma->second.permissions = new_perms;
         vma->second.meminfo_state = new_state;
         UpdatePageTableForVMA(vma->second);
@@ -191,10 +195,9 @@ Result VMManager::UnmapRange(VAddr target, u32 size) {
     CASCADE_RESULT(VMAIter vma, CarveVMARange(target, size));
     const VAddr target_end = target + size;
 
-    const VMAIter end = vma_map.end();
     // The comparison against the end of the range must be done using addresses since VMAs can be
     // merged during this process, causing invalidation of the iterators.
-    while (vma != end && vma->second.base < target_end) {
+    while (vma != vma_map.end() && vma->second.base < target_end) {
         vma = std::next(Unmap(vma));
     }
 
@@ -220,10 +223,9 @@ Result VMManager::ReprotectRange(VAddr target, u32 size, VMAPermission new_perms
     CASCADE_RESULT(VMAIter vma, CarveVMARange(target, size));
     const VAddr target_end = target + size;
 
-    const VMAIter end = vma_map.end();
     // The comparison against the end of the range must be done using addresses since VMAs can be
     // merged during this process, causing invalidation of the iterators.
-    while (vma != end && vma->second.base < target_end) {
+    while (vma != vma_map.end() && vma->second.base < target_end) {
         vma = std::next(StripIterConstness(Reprotect(vma, new_perms)));
     }
 
@@ -278,7 +280,7 @@ ResultVal<VMManager::VMAIter> VMManager::CarveVMA(VAddr base, u32 size) {
 
     if (end_in_vma != vma.size) {
         // Split VMA at the end of the allocated region
-        SplitVMA(vma_handle, end_in_vma);
+        vma_handle = std::prev(SplitVMA(vma_handle, end_in_vma));
     }
     if (start_in_vma != 0) {
         // Split VMA at the start of the allocated region
@@ -310,7 +312,9 @@ ResultVal<VMManager::VMAIter> VMManager::CarveVMARange(VAddr target, u32 size) {
 
     VMAIter end_vma = StripIterConstness(FindVMA(target_end));
     if (end_vma != vma_map.end() && target_end != end_vma->second.base) {
-        end_vma = SplitVMA(end_vma, target_end - end_vma->second.base);
+        // Inserting the split invalidates begin_vma, so look it up again afterwards.
+        SplitVMA(end_vma, target_end - end_vma->second.base);
+        begin_vma = StripIterConstness(FindVMA(target));
     }
 
     return begin_vma;
@@ -399,7 +403,17 @@ ResultVal<std::vector<std::pair<MemoryRef, u32>>> VMManager::GetBackingBlocksFor
 
 template <class Archive>
 void VMManager::serialize(Archive& ar, const unsigned int) {
-    ar & vma_map;
+    // The VMAs are archived as a std::map so that existing save states remain loadable.
+    std::map<VAddr, VirtualMemoryArea> vmas;
+    if (Archive::is_saving::value) {
+        vmas.insert(vma_map.begin(), vma_map.end());
+    }
+    ar & vmas;
+    if (Archive::is_loading::value) {
+        vma_map.clear();
+        vma_map.reserve(std::max(vmas.size(), INITIAL_VMA_CAPACITY));
+        vma_map.insert(boost::container::ordered_unique_range, vmas.begin(), vmas.end());
+    }
     ar & page_table;
     if (Archive::is_loading::value) {
         is_locked = true;
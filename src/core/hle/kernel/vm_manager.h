@@ -4,8 +4,8 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
+#include <boost/container/flat_map.hpp>
 #include <boost/serialization/export.hpp>
 #include "common/common_types.h"
 #include "common/memory_ref.h"
@@ -107,8 +107,11 @@ public:
      * `elem.base + elem.size == next.base` is preserved, and mergeable regions must always be
      * merged when possible so that no two similar and adjacent regions exist that have not been
      * merged.
+     *
+     * The VMAs are stored contiguously, so any insertion or removal invalidates outstanding
+     * handles; callers must continue from the handle returned by the modifying operation.
      */
-    std::map<VAddr, VirtualMemoryArea> vma_map;
+    boost::container::flat_map<VAddr, VirtualMemoryArea> vma_map;
     using VMAHandle = decltype(vma_map)::const_iterator;
 
     explicit VMManager(Memory::MemorySystem& memory, Kernel::Process& proc);
@@ -208,7 +211,8 @@ private:
 
     /**
      * Splits a VMA in two, at the specified offset.
-     * @returns the right side of the split, with the original iterator becoming the left side.
+     * @returns the right side of the split. The original iterator is invalidated; the left side is
+     *          the element preceding the returned one.
      */
     VMAIter SplitVMA(VMAIter vma, u32 offset_in_vma);
 
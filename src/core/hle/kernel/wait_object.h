@@ -71,7 +71,8 @@ private:
 
 // Specialization of DynamicObjectCast for WaitObjects
 template <>
-inline std::shared_ptr<WaitObject> DynamicObjectCast<WaitObject>(std::shared_ptr<Object> object) {
+inline std::shared_ptr<WaitObject> DynamicObjectCast<WaitObject>(
+    const std::shared_ptr<Object>& object) {
     if (object != nullptr && object->IsWaitable()) {
         return std::static_pointer_cast<WaitObject>(object);
     }
@@ -3,19 +3,25 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
+#include <thread>
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
+#include <cryptopp/sha.h>
 #include <fmt/format.h>
 #include <openssl/rand.h>
 #include "common/alignment.h"
 #include "common/archives.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/hacks/hack_manager.h"
 #include "common/logging/log.h"
 #include "common/string_util.h"
+#include "common/thread.h"
+#include "common/zstd_seekable_file.h"
 #include "core/core.h"
 #include "core/file_sys/certificate.h"
 #include "core/file_sys/errors.h"
@@ -36,6 +42,7 @@
 #include "core/hle/service/am/am_u.h"
 #include "core/hle/service/fs/archive.h"
 #include "core/hle/service/fs/fs_user.h"
+#include "core/hw/aes/cipher.h"
 #include "core/hw/aes/key.h"
 #include "core/hw/rsa/rsa.h"
 #include "core/hw/unique_data.h"
@@ -91,7 +98,9 @@ static_assert(sizeof(TicketInfo) == 0x18, "Ticket info structure size is wrong")
 
 class CIAFile::DecryptionState {
 public:
-    std::vector<CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption> content;
+    std::vector<HW::AES::CBCDecryptor> content;
+    // Running SHA-256 of each decrypted content, checked against the TMD once it is complete.
+    std::vector<CryptoPP::SHA256> content_hash;
 };
 
 NCCHCryptoFile::NCCHCryptoFile(const std::string& out_file, bool encrypted_content) {
@@ -363,13 +372,8 @@ void NCCHCryptoFile::Write(const u8* buffer, std::size_t length) {
                         ctr = &romfs_ctr;
                     }
 
-                    CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption d(key->data(), key->size(),
-                                                                    ctr->data());
-                    size_t offset = written - reg->seek_from;
-                    if (offset != 0) {
-                        d.Seek(offset);
-                    }
-                    d.ProcessData(temp.data(), buffer, to_write);
+                    HW::AES::TransformCTR({buffer, to_write}, temp, *key, *ctr,
+                                          written - reg->seek_from);
                     file->WriteBytes(temp.data(), to_write);
 
                     if (reg->type == CryptoRegion::EXEFS_HDR) {
@@ -577,9 +581,12 @@ ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length,
                     install_results.push_back(current_content_install_result);
                     return current_content_install_result.result;
                 }
-                decryption_state->content[i].ProcessData(temp.data(), temp.data(), temp.size());
+                decryption_state->content[i].Process(temp);
             }
 
+            auto& hash = decryption_state->content_hash[i];
+            hash.Update(temp.data(), temp.size());
+
             file.Write(temp.data(), temp.size());
             if (file.IsError()) {
                 // This can never happen in real HW
@@ -595,6 +602,14 @@ ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length,
             content_written[i] += available_to_write;
             LOG_DEBUG(Service_AM, "Wrote {} to content {}, total {}", available_to_write, i,
                       content_written[i]);
+
+            if (content_written[i] == size) {
+                std::array<u8, CryptoPP::SHA256::DIGESTSIZE> digest;
+                hash.Final(digest.data());
+                if (digest != tmd.GetContentHashByIndex(i)) {
+                    LOG_WARNING(Service_AM, "Content {} does not match the hash in the TMD", i);
+                }
+            }
         }
     }
 
@@ -689,6 +704,8 @@ Result CIAFile::PrepareToImportContent(const FileSys::TitleMetadata& tmd) {
 
     auto content_count = container.GetTitleMetadata().GetContentCount();
     content_written.resize(content_count);
+    decryption_state->content_hash.clear();
+    decryption_state->content_hash.resize(content_count);
 
     current_content_file.reset();
     current_content_index = -1;
@@ -709,8 +726,7 @@ Result CIAFile::PrepareToImportContent(const FileSys::TitleMetadata& tmd) {
                 decryption_state->content.resize(content_count);
                 for (std::size_t i = 0; i < content_count; ++i) {
                     auto ctr = tmd.GetContentCTRByIndex(i);
-                    decryption_state->content[i].SetKeyWithIV(title_key->data(), title_key->size(),
-                                                              ctr.data());
+                    decryption_state->content[i].SetKeyWithIV(*title_key, ctr);
                 }
             } else {
                 LOG_ERROR(Service_AM, "Could not read title key from ticket for encrypted CIA.");
@@ -1052,6 +1068,10 @@ void ContentFile::Cancel(FS::MediaType media_type, u64 title_id) {
     FileUtil::Delete(path);
 }
 
+// Size and number of the buffers used to stream a CIA from disk during InstallCIA.
+constexpr std::size_t CIA_INSTALL_BUFFER_SIZE = 0x100000;
+constexpr std::size_t CIA_INSTALL_BUFFER_COUNT = 4;
+
 InstallStatus InstallCIA(const std::string& path,
                          std::function<ProgressCallback>&& update_callback) {
     LOG_INFO(Service_AM, "Installing {}...", path);
@@ -1072,20 +1092,52 @@ InstallStatus InstallCIA(const std::string& path,
             return InstallStatus::ErrorEncrypted;
         }
 
-        FileUtil::IOFile file(path, "rb");
-        if (!file.IsOpen()) {
+        const auto file = Common::Compression::OpenImageFile(path);
+        if (!file->IsOpen()) {
             LOG_ERROR(Service_AM, "Could not open CIA file '{}'.", path);
             return InstallStatus::ErrorFailedToOpenFile;
         }
 
-        std::vector<u8> buffer;
-        buffer.resize(0x10000);
-        auto file_size = file.GetSize();
+        // The CIA is read on a separate thread so that disk reads overlap with decrypting,
+        // hashing and writing the contents. Chunks are passed through a fixed set of buffers,
+        // and a buffer is only refilled once the install stage hands it back.
+        std::array<std::vector<u8>, CIA_INSTALL_BUFFER_COUNT> buffers;
+        Common::SPSCQueue<std::size_t, CIA_INSTALL_BUFFER_COUNT> filled_buffers;
+        Common::SPSCQueue<std::size_t, CIA_INSTALL_BUFFER_COUNT> free_buffers;
+        const auto file_size = file->GetSize();
+
+        std::jthread reader([&](std::stop_token stop_token) {
+            Common::SetCurrentThreadName("CIAReader");
+            std::size_t total_bytes_read = 0;
+            for (std::size_t i = 0; total_bytes_read != file_size; ++i) {
+                if (i >= CIA_INSTALL_BUFFER_COUNT) {
+                    std::size_t returned_buffer;
+                    free_buffers.PopWait(returned_buffer, stop_token);
+                    if (stop_token.stop_requested()) {
+                        return;
+                    }
+                }
+                auto& buffer = buffers[i % CIA_INSTALL_BUFFER_COUNT];
+                buffer.resize(CIA_INSTALL_BUFFER_SIZE);
+                const std::size_t bytes_read = file->ReadBytes(buffer.data(), buffer.size());
+                filled_buffers.EmplaceWait(bytes_read);
+                if (bytes_read == 0) {
+                    return;
+                }
+                total_bytes_read += bytes_read;
+            }
+        });
+
+        const auto start_time = std::chrono::steady_clock::now();
         std::size_t total_bytes_read = 0;
-        while (total_bytes_read != file_size) {
-            std::size_t bytes_read = file.ReadBytes(buffer.data(), buffer.size());
+        for (std::size_t i = 0; total_bytes_read != file_size; ++i) {
+            const std::size_t bytes_read = filled_buffers.PopWait();
+            if (bytes_read == 0) {
+                LOG_ERROR(Service_AM, "Could not read CIA file '{}'.", path);
+                return InstallStatus::ErrorAborted;
+            }
             auto result = installFile.Write(static_cast<u64>(total_bytes_read), bytes_read, true,
-                                            false, static_cast<u8*>(buffer.data()));
+                                            false, buffers[i % CIA_INSTALL_BUFFER_COUNT].data());
 
             if (update_callback) {
                 update_callback(total_bytes_read, file_size);
@@ -1096,7 +1148,14 @@ InstallStatus InstallCIA(const std::string& path,
                 return InstallStatus::ErrorAborted;
             }
             total_bytes_read += bytes_read;
+            free_buffers.EmplaceWait(i);
         }
+        reader.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        LOG_INFO(Service_AM, "Wrote {} bytes in {:.2f}s ({:.1f} MiB/s)", file_size,
+                 elapsed.count(),
+                 elapsed.count() > 0 ? file_size / elapsed.count() / (1024.0 * 1024.0) : 0.0);
         installFile.Close();
 
         InstallStatus install_res = InstallStatus::Success;
@@ -1331,6 +1390,7 @@ void Module::ScanForTitlesImpl(Service::FS::MediaType media_type) {
     LOG_DEBUG(Service_AM, "Starting title scan for media_type={}", static_cast<int>(media_type));
 
     std::string title_path = GetMediaTitlePath(media_type);
+    TitleIndex* index = GetTitleIndex(media_type);
 
     FileUtil::FSTEntry entries;
     FileUtil::ScanDirectoryTree(title_path, entries, 1, &stop_scan_flag);
@@ -1354,18 +1414,43 @@ void Module::ScanForTitlesImpl(Service::FS::MediaType media_type) {
                     if (FileUtil::Exists(GetTitleContentPath(media_type, tid))) {
                         am_title_list[static_cast<u32>(media_type)].push_back(tid);
                     }
+                } else if (index && index->Validate(tid)) {
+                    am_title_list[static_cast<u32>(media_type)].push_back(tid);
                 } else {
-                    FileSys::NCCHContainer container(GetTitleContentPath(media_type, tid));
+                    const std::string content_path = GetTitleContentPath(media_type, tid);
+                    FileSys::NCCHContainer container(content_path);
                     if (container.Load() == Loader::ResultStatus::Success) {
                         am_title_list[static_cast<u32>(media_type)].push_back(tid);
+                        if (index) {
+                            index->Insert(tid, GetTitleMetadataPath(media_type, tid),
+                                          content_path);
+                        }
                     }
                 }
             }
         }
     }
+    // An interrupted scan did not validate every title, pruning would drop the rest.
+    if (index && !stop_scan_flag) {
+        index->Prune();
+        index->Save();
+    }
     LOG_DEBUG(Service_AM, "Finished title scan for media_type={}", static_cast<int>(media_type));
 }
 
+TitleIndex* Module::GetTitleIndex(Service::FS::MediaType media_type) {
+    if (media_type != Service::FS::MediaType::NAND && media_type != Service::FS::MediaType::SDMC) {
+        return nullptr;
+    }
+    auto& index = title_indices[static_cast<u32>(media_type)];
+    if (!index) {
+        index.emplace(fmt::format("{}title_index/{}.txt",
+                                  FileUtil::GetUserPath(FileUtil::UserPath::CacheDir),
+                                  media_type == Service::FS::MediaType::NAND ? "nand" : "sdmc"));
+    }
+    return &*index;
+}
+
 void Module::ScanForAllTitles() {
     if (Settings::values.deterministic_async_operations) {
         ScanForTicketsImpl();
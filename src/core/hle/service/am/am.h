@@ -10,6 +10,7 @@
 #include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 #include <boost/serialization/array.hpp>
@@ -23,6 +24,7 @@
 #include "core/global.h"
 #include "core/hle/kernel/mutex.h"
 #include "core/hle/result.h"
+#include "core/hle/service/am/title_index.h"
 #include "core/hle/service/service.h"
 #include "network/artic_base/artic_base_client.h"
 
@@ -1070,6 +1072,9 @@ private:
 
     void ScanForTitlesImpl(Service::FS::MediaType media_type);
 
+    /// Returns the title index of a storage medium, or nullptr if it has none.
+    TitleIndex* GetTitleIndex(Service::FS::MediaType media_type);
+
     /**
      * Scans all storage mediums for titles for listing.
      */
@@ -1086,6 +1091,8 @@ private:
     std::future<void> scan_all_future;
     std::mutex am_lists_mutex;
     std::array<std::vector<u64_le>, 3> am_title_list;
+    /// Titles found by earlier scans of the NAND and the SD card, loaded on their first scan.
+    std::array<std::optional<TitleIndex>, 2> title_indices;
     std::multimap<u64, u64> am_ticket_list;
 
     std::shared_ptr<Kernel::Mutex> system_updater_mutex;
@@ -0,0 +1,124 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <optional>
+#include <sstream>
+#include <vector>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "core/hle/service/am/title_index.h"
+
+namespace Service::AM {
+
+namespace {
+
+constexpr std::string_view IndexHeader = "title index v1";
+
+/// Returns the size of a file, or nullopt if it does not exist.
+std::optional<u64> FileSize(const std::string& path) {
+    if (path.empty() || !FileUtil::Exists(path) || FileUtil::IsDirectory(path)) {
+        return std::nullopt;
+    }
+    return FileUtil::GetSize(path);
+}
+
+} // Anonymous namespace
+
+TitleIndex::TitleIndex(std::string path_) : path{std::move(path_)} {
+    std::string contents;
+    if (!FileUtil::Exists(path) || FileUtil::ReadFileToString(true, path, contents) == 0) {
+        return;
+    }
+
+    std::istringstream stream{contents};
+    std::string line;
+    if (!std::getline(stream, line) || line != IndexHeader) {
+        LOG_WARNING(Service_AM, "Discarding title index {} with an unknown format", path);
+        dirty = true;
+        return;
+    }
+    while (std::getline(stream, line)) {
+        const std::vector<std::string> fields = Common::SplitString(line, '\t');
+        if (fields.size() != 5) {
+            continue;
+        }
+        try {
+            const u64 title_id = std::stoull(fields[0], nullptr, 16);
+            entries[title_id] = Entry{
+                .tmd_path = fields[3],
+                .content_path = fields[4],
+                .tmd_size = std::stoull(fields[1]),
+                .content_size = std::stoull(fields[2]),
+            };
+        } catch (...) {
+            dirty = true;
+        }
+    }
+}
+
+bool TitleIndex::Validate(u64 title_id) {
+    const auto it = entries.find(title_id);
+    if (it == entries.end()) {
+        return false;
+    }
+    const Entry& entry = it->second;
+    if (FileSize(entry.tmd_path) != entry.tmd_size ||
+        FileSize(entry.content_path) != entry.content_size) {
+        return false;
+    }
+    seen.insert(title_id);
+    return true;
+}
+
+bool TitleIndex::Insert(u64 title_id, const std::string& tmd_path,
+                        const std::string& content_path) {
+    const auto tmd_size = FileSize(tmd_path);
+    const auto content_size = FileSize(content_path);
+    if (!tmd_size || !content_size) {
+        return false;
+    }
+    entries[title_id] = Entry{
+        .tmd_path = tmd_path,
+        .content_path = content_path,
+        .tmd_size = *tmd_size,
+        .content_size = *content_size,
+    };
+    seen.insert(title_id);
+    dirty = true;
+    return true;
+}
+
+void TitleIndex::Prune() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (seen.contains(it->first)) {
+            it++;
+        } else {
+            it = entries.erase(it);
+            dirty = true;
+        }
+    }
+    seen.clear();
+}
+
+bool TitleIndex::Save() {
+    if (!dirty || path.empty()) {
+        return true;
+    }
+    std::string contents = fmt::format("{}\n", IndexHeader);
+    for (const auto& [title_id, entry] : entries) {
+        contents += fmt::format("{:016X}\t{}\t{}\t{}\t{}\n", title_id, entry.tmd_size,
+                                entry.content_size, entry.tmd_path, entry.content_path);
+    }
+    if (!FileUtil::CreateFullPath(path) ||
+        FileUtil::WriteStringToFile(true, path, contents) != contents.size()) {
+        LOG_ERROR(Service_AM, "Failed to write the title index {}", path);
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+} // namespace Service::AM
@@ -0,0 +1,58 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include "common/common_types.h"
+
+namespace Service::AM {
+
+/**
+ * Persisted record of the titles a storage medium was found to hold, so the title scan does not
+ * have to parse the TMD and the NCCH of every installed title again. An entry stays valid as long
+ * as its TMD and main content still exist with the size they had when the title was indexed,
+ * which is checked when the title is looked up.
+ *
+ * Indexes are stored as text, one title per line with tab separated fields.
+ */
+class TitleIndex {
+public:
+    struct Entry {
+        std::string tmd_path;
+        std::string content_path;
+        u64 tmd_size;
+        u64 content_size;
+    };
+
+    TitleIndex() = default;
+    explicit TitleIndex(std::string path);
+
+    /// Returns true if the title is indexed and its files did not change since.
+    bool Validate(u64 title_id);
+
+    /// Indexes a title from its files on disk, returns false if they do not exist.
+    bool Insert(u64 title_id, const std::string& tmd_path, const std::string& content_path);
+
+    /// Removes the titles that were neither validated nor inserted since the last call, which are
+    /// the ones no longer installed.
+    void Prune();
+
+    /// Writes the index back if it changed, returns false on failure.
+    bool Save();
+
+    [[nodiscard]] std::size_t Size() const noexcept {
+        return entries.size();
+    }
+
+private:
+    std::string path;
+    std::map<u64, Entry> entries;
+    std::set<u64> seen;
+    bool dirty = false;
+};
+
+} // namespace Service::AM
@@ -251,57 +251,71 @@ std::vector<NsDataEntry> OnlineService::GetNsDataEntries() {
     }
 
     std::vector<NsDataEntry> ns_data;
+    std::map<std::pair<std::string, u64>, std::optional<NsDataEntry>> checked_files;
     const auto boss_files = GetBossExtDataFiles(boss_archive.get());
     for (const auto& current_file : boss_files) {
-        constexpr u32 boss_header_length = 0x34;
-        if (current_file.is_directory || current_file.file_size < boss_header_length) {
-            LOG_WARNING(Service_BOSS,
-                        "SpotPass extdata contains directory or file is too short: '{}'",
-                        Common::UTF16ToUTF8(current_file.filename));
-            continue;
+        auto key = std::make_pair(Common::UTF16ToUTF8(current_file.filename),
+                                  current_file.file_size);
+        auto cached = ns_data_cache.extract(key);
+        auto& entry = checked_files[std::move(key)];
+        entry = cached ? std::move(cached.mapped())
+                       : ReadNsDataEntry(boss_archive.get(), current_file);
+        if (entry) {
+            ns_data.push_back(*entry);
         }
+    }
+    // Files that are gone are forgotten.
+    ns_data_cache = std::move(checked_files);
 
-        FileSys::Mode mode{};
-        mode.read_flag.Assign(1);
+    return ns_data;
+}
 
-        NsDataEntry entry{.filename = Common::UTF16ToUTF8(current_file.filename)};
-        auto file_result = boss_archive->OpenFile("/" + entry.filename, mode);
-        if (!file_result.Succeeded()) {
-            LOG_WARNING(Service_BOSS, "Opening SpotPass file failed.");
-            continue;
-        }
+std::optional<NsDataEntry> OnlineService::ReadNsDataEntry(FileSys::ArchiveBackend* boss_archive,
+                                                          const FileSys::Entry& current_file) {
+    constexpr u32 boss_header_length = 0x34;
+    if (current_file.is_directory || current_file.file_size < boss_header_length) {
+        LOG_WARNING(Service_BOSS, "SpotPass extdata contains directory or file is too short: '{}'",
+                    Common::UTF16ToUTF8(current_file.filename));
+        return std::nullopt;
+    }
 
-        auto file = std::move(file_result).Unwrap();
-        file->Read(0, boss_header_length, reinterpret_cast<u8*>(&entry.header));
-        if (entry.header.header_length != BOSS_EXTDATA_HEADER_LENGTH) {
-            LOG_WARNING(
-                Service_BOSS,
-                "Incorrect header length or non-SpotPass file; expected {:#010x}, found {:#010x}",
-                BOSS_EXTDATA_HEADER_LENGTH, entry.header.header_length);
-            continue;
-        }
+    FileSys::Mode mode{};
+    mode.read_flag.Assign(1);
 
-        if (entry.header.program_id != program_id) {
-            LOG_WARNING(Service_BOSS,
-                        "Mismatched program ID in SpotPass data. Was expecting "
-                        "{:#018x}, found {:#018x}",
-                        program_id, static_cast<u64>(entry.header.program_id));
-            continue;
-        }
+    NsDataEntry entry{.filename = Common::UTF16ToUTF8(current_file.filename)};
+    auto file_result = boss_archive->OpenFile("/" + entry.filename, mode);
+    if (!file_result.Succeeded()) {
+        LOG_WARNING(Service_BOSS, "Opening SpotPass file failed.");
+        return std::nullopt;
+    }
 
-        // Check the payload size is correct, excluding header
-        if (entry.header.payload_size != (current_file.file_size - boss_header_length)) {
-            LOG_WARNING(Service_BOSS,
-                        "Mismatched file size, was expecting {:#010x}, found {:#010x}",
-                        static_cast<u32>(entry.header.payload_size),
-                        current_file.file_size - boss_header_length);
-            continue;
-        }
+    auto file = std::move(file_result).Unwrap();
+    file->Read(0, boss_header_length, reinterpret_cast<u8*>(&entry.header));
+    if (entry.header.header_length != BOSS_EXTDATA_HEADER_LENGTH) {
+        LOG_WARNING(
+            Service_BOSS,
+            "Incorrect header length or non-SpotPass file; expected {:#010x}, found {:#010x}",
+            BOSS_EXTDATA_HEADER_LENGTH, entry.header.header_length);
+        return std::nullopt;
+    }
 
-        ns_data.push_back(entry);
+    if (entry.header.program_id != program_id) {
+        LOG_WARNING(Service_BOSS,
+                    "Mismatched program ID in SpotPass data. Was expecting "
+                    "{:#018x}, found {:#018x}",
+                    program_id, static_cast<u64>(entry.header.program_id));
+        return std::nullopt;
     }
 
-    return ns_data;
+    // Check the payload size is correct, excluding header
+    if (entry.header.payload_size != (current_file.file_size - boss_header_length)) {
+        LOG_WARNING(Service_BOSS, "Mismatched file size, was expecting {:#010x}, found {:#010x}",
+                    static_cast<u32>(entry.header.payload_size),
+                    current_file.file_size - boss_header_length);
+        return std::nullopt;
+    }
+
+    return entry;
 }
 
 u16 OnlineService::GetNsDataIdList(const u32 filter, const u32 max_entries,
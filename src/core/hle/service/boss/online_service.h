@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <map>
+#include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -198,10 +201,16 @@ private:
     std::vector<FileSys::Entry> GetBossExtDataFiles(FileSys::ArchiveBackend* boss_archive);
     FileSys::Path GetBossDataDir();
     std::vector<NsDataEntry> GetNsDataEntries();
+    std::optional<NsDataEntry> ReadNsDataEntry(FileSys::ArchiveBackend* boss_archive,
+                                               const FileSys::Entry& file);
 
     BossTaskProperties current_props;
     std::map<std::string, BossTaskProperties> task_id_list;
 
+    /// The SpotPass files checked before by name and size, with their entry if they are valid,
+    /// so that listing the NsData only opens the files that changed.
+    std::map<std::pair<std::string, u64>, std::optional<NsDataEntry>> ns_data_cache;
+
     u64 program_id;
     u64 extdata_id;
 
@@ -40,6 +40,9 @@ void Module::serialize(Archive& ar, const unsigned int) {
     ar & cecinfo_event;
     ar & cecinfosys_event;
     ar & change_state_event;
+    if (Archive::is_loading::value) {
+        box_file_cache.clear();
+    }
 }
 SERIALIZE_IMPL(Module)
 
@@ -376,6 +379,7 @@ void Module::Interface::Write(Kernel::HLERequestContext& ctx) {
         [[maybe_unused]] const u32 bytes_written = static_cast<u32>(
             session_data->file->Write(0, buffer.size(), true, false, buffer.data()).Unwrap());
         session_data->file->Close();
+        cecd->box_file_cache.clear();
 
         rb.Push(ResultSuccess);
     }
@@ -554,6 +558,7 @@ void Module::Interface::Delete(Kernel::HLERequestContext& ctx) {
     FileSys::Mode mode;
     mode.write_flag.Assign(1);
 
+    cecd->box_file_cache.clear();
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 2);
     switch (path_type) {
     case CecDataPathType::RootDir:
@@ -610,6 +615,7 @@ void Module::Interface::SetData(Kernel::HLERequestContext& ctx) {
 
             file->Write(0, buffer.size(), true, false, buffer.data());
             file->Close();
+            cecd->box_file_cache.clear();
         }
     }
 
@@ -768,6 +774,7 @@ void Module::Interface::OpenAndWrite(Kernel::HLERequestContext& ctx) {
             [[maybe_unused]] const u32 bytes_written = static_cast<u32>(
                 file->Write(0, buffer.size(), true, false, buffer.data()).Unwrap());
             file->Close();
+            cecd->box_file_cache.clear();
 
             rb.Push(ResultSuccess);
         } else {
@@ -809,14 +816,44 @@ void Module::Interface::OpenAndRead(Kernel::HLERequestContext& ctx) {
                        ErrorLevel::Status));
         rb.Push<u32>(0); // No entries read
         break;
-    default: // If not directory, then it is a file
+    default: { // If not directory, then it is a file
+        // The box indexes are polled by the CEC sysmodule and games on every box access, they are
+        // served from memory until the save data is written.
+        const bool is_box_index =
+            path_type == CecDataPathType::MboxList || path_type == CecDataPathType::MboxInfo ||
+            path_type == CecDataPathType::InboxInfo || path_type == CecDataPathType::OutboxInfo ||
+            path_type == CecDataPathType::OutboxIndex;
+        const std::string path_string = path.AsString();
+        if (is_box_index) {
+            const auto cached = cecd->box_file_cache.find(path_string);
+            if (cached != cecd->box_file_cache.end()) {
+                std::vector<u8> buffer(buffer_size);
+                const u32 bytes_read =
+                    static_cast<u32>(std::min<std::size_t>(buffer_size, cached->second.size()));
+                std::memcpy(buffer.data(), cached->second.data(), bytes_read);
+                write_buffer.Write(buffer.data(), 0, buffer_size);
+
+                rb.Push(ResultSuccess);
+                rb.Push<u32>(bytes_read);
+                break;
+            }
+        }
+
         auto file_result = cecd->cecd_system_save_data_archive->OpenFile(path, mode);
         if (file_result.Succeeded()) {
             auto file = std::move(file_result).Unwrap();
             std::vector<u8> buffer(buffer_size);
 
-            const u32 bytes_read =
-                static_cast<u32>(file->Read(0, buffer_size, buffer.data()).Unwrap());
+            u32 bytes_read;
+            if (is_box_index) {
+                std::vector<u8> contents(static_cast<std::size_t>(file->GetSize()));
+                contents.resize(file->Read(0, contents.size(), contents.data()).Unwrap());
+                bytes_read = static_cast<u32>(std::min<std::size_t>(buffer_size, contents.size()));
+                std::memcpy(buffer.data(), contents.data(), bytes_read);
+                cecd->box_file_cache.insert_or_assign(path_string, std::move(contents));
+            } else {
+                bytes_read = static_cast<u32>(file->Read(0, buffer_size, buffer.data()).Unwrap());
+            }
             write_buffer.Write(buffer.data(), 0, buffer_size);
             file->Close();
 
@@ -828,6 +865,7 @@ void Module::Interface::OpenAndRead(Kernel::HLERequestContext& ctx) {
             rb.Push<u32>(0); // No bytes read
         }
     }
+    }
     rb.PushMappedBuffer(write_buffer);
 
     LOG_DEBUG(Service_CECD,
@@ -1251,10 +1289,9 @@ void Module::CheckAndUpdateFile(const CecDataPathType path_type, const u32 ncch_
                 auto message_result = cecd_system_save_data_archive->OpenFile(message_path, mode);
 
                 auto message = std::move(message_result).Unwrap();
-                const u32 message_size = static_cast<u32>(message->GetSize());
-                std::vector<u8> buffer(message_size);
-
-                void(message->Read(0, message_size, buffer.data()).Unwrap());
+                // Only the header of the message is needed, not its content.
+                std::vector<u8> buffer(sizeof(CecMessageHeader));
+                void(message->Read(0, buffer.size(), buffer.data()).Unwrap());
                 message->Close();
 
                 std::memcpy(&message_headers[outbox_info_header.message_num++], buffer.data(),
@@ -1341,10 +1378,9 @@ void Module::CheckAndUpdateFile(const CecDataPathType path_type, const u32 ncch_
                 auto message_result = cecd_system_save_data_archive->OpenFile(message_path, mode);
 
                 auto message = std::move(message_result).Unwrap();
-                const u32 message_size = static_cast<u32>(message->GetSize());
-                std::vector<u8> buffer(message_size);
-
-                void(message->Read(0, message_size, buffer.data()).Unwrap());
+                // Only the header of the message is needed, not its content.
+                std::vector<u8> buffer(sizeof(CecMessageHeader));
+                void(message->Read(0, buffer.size(), buffer.data()).Unwrap());
                 message->Close();
 
                 // Message id is at offset 0x20, and is 8 bytes
@@ -6,6 +6,9 @@
 
 #include <memory>
 #include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "common/bit_field.h"
 #include "common/common_funcs.h"
 #include "core/hle/kernel/event.h"
@@ -623,6 +626,8 @@ private:
                             std::vector<u8>& file_buffer);
 
     std::unique_ptr<FileSys::ArchiveBackend> cecd_system_save_data_archive;
+    /// Contents of the box index files read through OpenAndRead, by path. Cleared on any write.
+    std::unordered_map<std::string, std::vector<u8>> box_file_cache;
 
     std::shared_ptr<Kernel::Event> cecinfo_event;
     std::shared_ptr<Kernel::Event> cecinfosys_event;
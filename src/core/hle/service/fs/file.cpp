@@ -79,13 +79,20 @@ void File::Read(Kernel::HLERequestContext& ctx) {
     if (!backend->AllowsCachedReads()) {
         auto& buffer = rp.PopMappedBuffer();
         IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-        std::unique_ptr<u8[]> data = std::make_unique_for_overwrite<u8[]>(length);
-        const auto read = backend->Read(offset, length, data.get());
+        // Read straight into guest memory when possible, otherwise bounce through a host buffer.
+        const auto view = buffer.GetContiguousView(0, length);
+        std::unique_ptr<u8[]> data;
+        if (view.empty()) {
+            data = std::make_unique_for_overwrite<u8[]>(length);
+        }
+        const auto read = backend->Read(offset, length, view.empty() ? data.get() : view.data());
         if (read.Failed()) {
             rb.Push(read.Code());
             rb.Push<u32>(0);
         } else {
-            buffer.Write(data.get(), 0, *read);
+            if (view.empty()) {
+                buffer.Write(data.get(), 0, *read);
+            }
             rb.Push(ResultSuccess);
             rb.Push<u32>(static_cast<u32>(*read));
         }
@@ -108,6 +115,7 @@ void File::Read(Kernel::HLERequestContext& ctx) {
         Kernel::MappedBuffer* buffer;
         std::unique_ptr<u8[]> data;
         std::size_t read_size;
+        bool read_in_place = false;
     };
 
     auto async_data = std::make_shared<AsyncData>();
@@ -120,11 +128,23 @@ void File::Read(Kernel::HLERequestContext& ctx) {
     }
 
     // LOG_DEBUG(Service_FS, "cache={}, offset={}, length={}", cache_ready, offset, length);
+    // Only the Artic Base backends get here, local files are read above. Reads that miss the
+    // cache wait on the network, so they get a thread of their own.
     ctx.RunAsync(
         [this, async_data](Kernel::HLERequestContext& ctx) {
-            async_data->data = std::make_unique_for_overwrite<u8[]>(async_data->length);
-            const auto read =
-                backend->Read(async_data->offset, async_data->length, async_data->data.get());
+            // Cache hits are served on the emulation thread, so they can be read straight into
+            // guest memory. Real asynchronous reads must not touch it from the worker thread.
+            std::span<u8> view;
+            if (async_data->cache_ready) {
+                view = async_data->buffer->GetContiguousView(0, async_data->length);
+            }
+            async_data->read_in_place = !view.empty();
+            u8* destination = view.data();
+            if (!async_data->read_in_place) {
+                async_data->data = std::make_unique_for_overwrite<u8[]>(async_data->length);
+                destination = async_data->data.get();
+            }
+            const auto read = backend->Read(async_data->offset, async_data->length, destination);
             if (read.Failed()) {
                 async_data->ret = read.Code();
                 async_data->read_size = 0;
@@ -155,7 +175,9 @@ void File::Read(Kernel::HLERequestContext& ctx) {
                 rb.Push(async_data->ret);
                 rb.Push<u32>(0);
             } else {
-                async_data->buffer->Write(async_data->data.get(), 0, async_data->read_size);
+                if (!async_data->read_in_place) {
+                    async_data->buffer->Write(async_data->data.get(), 0, async_data->read_size);
+                }
                 rb.Push(ResultSuccess);
                 rb.Push<u32>(static_cast<u32>(async_data->read_size));
             }
@@ -187,10 +209,15 @@ void File::Write(Kernel::HLERequestContext& ctx) {
     bool flush = (flags & 0xFF) != 0, update_timestamp = (flags & 0xFF00) != 0;
 
     if (!backend->AllowsCachedReads()) {
-        std::vector<u8> data(length);
-        buffer.Read(data.data(), 0, data.size());
-        ResultVal<std::size_t> written =
-            backend->Write(offset, data.size(), flush, update_timestamp, data.data());
+        // Write straight from guest memory when possible, otherwise bounce through a host buffer.
+        const auto view = buffer.GetContiguousView(0, length);
+        std::vector<u8> data;
+        if (view.empty()) {
+            data.resize(length);
+            buffer.Read(data.data(), 0, data.size());
+        }
+        ResultVal<std::size_t> written = backend->Write(
+            offset, length, flush, update_timestamp, view.empty() ? data.data() : view.data());
 
         // Update file size
         file->size = backend->GetSize();
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <span>
 #include <vector>
 #include <boost/serialization/base_object.hpp>
@@ -417,7 +418,11 @@ void GSP_GPU::TriggerCmdReqQueue(Kernel::HLERequestContext& ctx) {
 
     bool requires_delay = false;
 
-    while (command_buffer->number_commands) {
+    // The queue holds at most 15 commands, they are collected and handed to the GPU at once.
+    std::array<Command, 0xF> commands;
+    std::size_t num_commands = 0;
+
+    while (command_buffer->number_commands && num_commands < commands.size()) {
         if (command_buffer->should_stop) {
             command_buffer->status.Assign(CommandBuffer::STATUS_STOPPED);
             break;
@@ -437,17 +442,18 @@ void GSP_GPU::TriggerCmdReqQueue(Kernel::HLERequestContext& ctx) {
         command_buffer->index.Assign((command_buffer->index + 1) % 0xF);
 
         gpu.Debugger().GXCommandProcessed(command);
-
-        // Decode and execute command
-        system.perf_stats->BeginGPUProcessing();
-        gpu.Execute(command);
-        system.perf_stats->EndGPUProcessing();
+        commands[num_commands++] = command;
 
         if (command.stop) {
             command_buffer->should_stop.Assign(1);
         }
     }
 
+    // Decode and execute the commands
+    system.perf_stats->BeginGPUProcessing();
+    gpu.Execute(std::span{commands.data(), num_commands});
+    system.perf_stats->EndGPUProcessing();
+
     if (requires_delay) {
         ctx.RunAsync(
             [](Kernel::HLERequestContext& ctx) {
@@ -616,7 +622,9 @@ Result GSP_GPU::AcquireGpuRight(const Kernel::HLERequestContext& ctx,
                 ErrorLevel::Success};
     }
 
+    gpu.Synchronize();
     gpu.Renderer().Rasterizer()->SwitchDiskResources(process->codeset->program_id);
+    gpu.SwitchShaderDiskCache(process->codeset->program_id);
 
     if (blocking) {
         // TODO: The thread should be put to sleep until acquired.
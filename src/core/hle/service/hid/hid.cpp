@@ -301,9 +301,9 @@ void Module::UpdatePadCallback(std::uintptr_t user_data, s64 cycles_late) {
 
     // TODO(xperia64): How the 3D Slider is updated by the HID module needs to be RE'd
     // and possibly moved to its own Core::Timing event.
-    mem->pad.sliderstate_3d = (Settings::values.factor_3d.GetValue() / 100.0f);
-    system.Kernel().GetSharedPageHandler().Set3DSlider(Settings::values.factor_3d.GetValue() /
-                                                       100.0f);
+    const float slider_3d = Settings::values.factor_3d.GetValue() / 100.0f;
+    mem->pad.sliderstate_3d = slider_3d;
+    system.Kernel().GetSharedPageHandler().Set3DSlider(slider_3d);
 
     // Reschedule recurrent event
     system.CoreTiming().ScheduleEvent(pad_update_ticks - cycles_late, pad_update_event);
@@ -697,6 +697,16 @@ void Module::ReloadInputDevices() {
     is_device_reload_pending.store(true);
 }
 
+void Module::LatchPadState() {
+    // Movies store one input per pad update, extra updates would make them desync.
+    if (!Settings::values.input_late_latch.GetValue() ||
+        system.Movie().GetPlayMode() != Core::Movie::PlayMode::None) {
+        return;
+    }
+    system.CoreTiming().UnscheduleEvent(pad_update_event, 0);
+    UpdatePadCallback(0, 0);
+}
+
 const PadState& Module::GetState() const {
     return state;
 }
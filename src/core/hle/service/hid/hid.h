@@ -336,6 +336,13 @@ public:
 
     void ReloadInputDevices();
 
+    /**
+     * Samples the input devices into shared memory right away when input late latch is enabled,
+     * and restarts the pad update interval from now. Called right before vblank, so the pad state
+     * games read after waiting for vblank is at most as old as the frame.
+     */
+    void LatchPadState();
+
     const PadState& GetState() const;
 
     // Updating period for each HID device. These empirical values are measured from a 11.2 3DS.
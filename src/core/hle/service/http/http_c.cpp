@@ -278,6 +278,86 @@ std::string Context::ParseMultipartFormData() {
     return httplib::detail::serialize_multipart_formdata_get_content_type(multipart_boundary);
 }
 
+std::unique_ptr<httplib::ClientImpl> ClientPool::Acquire(const Key& key) {
+    std::scoped_lock lock{mutex};
+    const auto it = idle_clients.find(key);
+    if (it == idle_clients.end()) {
+        return nullptr;
+    }
+    auto& clients = it->second;
+    const auto now = std::chrono::steady_clock::now();
+    while (!clients.empty()) {
+        IdleClient idle = std::move(clients.back());
+        clients.pop_back();
+        if (now - idle.released < IdleTimeout) {
+            LOG_DEBUG(Service_HTTP, "Reusing connection to {}:{}", key.host, key.port);
+            return std::move(idle.client);
+        }
+    }
+    return nullptr;
+}
+
+void ClientPool::Release(const Key& key, std::unique_ptr<httplib::ClientImpl> client) {
+    if (!client->is_socket_open()) {
+        return;
+    }
+    std::scoped_lock lock{mutex};
+    auto& clients = idle_clients[key];
+    if (clients.size() >= MaxIdlePerServer) {
+        clients.erase(clients.begin());
+    }
+    clients.push_back({std::move(client), std::chrono::steady_clock::now()});
+}
+
+void ClientPool::ResumeSessions(const Key& key, httplib::SSLClient& client) {
+    SSL_CTX* ctx = client.ssl_context();
+    if (!ctx) {
+        return;
+    }
+    SessionSlot* slot;
+    {
+        std::scoped_lock lock{sessions_mutex};
+        slot = &sessions[key];
+        slot->pool = this;
+    }
+    SSL_CTX_set_app_data(ctx, slot);
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &ClientPool::OnNewSession);
+    // httplib gives no access to the connection before its handshake, the session to resume is
+    // set from the info callback when the handshake starts, before the client hello is built.
+    SSL_CTX_set_info_callback(ctx, &ClientPool::OnHandshakeInfo);
+}
+
+ClientPool::~ClientPool() {
+    for (auto& [key, slot] : sessions) {
+        if (slot.session) {
+            SSL_SESSION_free(slot.session);
+        }
+    }
+}
+
+int ClientPool::OnNewSession(SSL* ssl, SSL_SESSION* session) {
+    auto* slot = static_cast<SessionSlot*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    std::scoped_lock lock{slot->pool->sessions_mutex};
+    if (slot->session) {
+        SSL_SESSION_free(slot->session);
+    }
+    // Returning 1 keeps the reference to the session.
+    slot->session = session;
+    return 1;
+}
+
+void ClientPool::OnHandshakeInfo(const SSL* ssl, int where, int ret) {
+    if (!(where & SSL_CB_HANDSHAKE_START) || !SSL_in_before(ssl)) {
+        return;
+    }
+    auto* slot = static_cast<SessionSlot*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    std::scoped_lock lock{slot->pool->sessions_mutex};
+    if (slot->session) {
+        SSL_set_session(const_cast<SSL*>(ssl), slot->session);
+    }
+}
+
 void Context::MakeRequest() {
     ASSERT(state == RequestState::NotStarted);
 
@@ -303,6 +383,15 @@ void Context::MakeRequest() {
         total_download_size_bytes = total;
         return true;
     };
+    // The body is made available to ReceiveData as it arrives.
+    request.content_receiver = [this](const char* data, std::size_t data_length, u64, u64) {
+        {
+            std::scoped_lock lock{body_mutex};
+            response.body.append(data, data_length);
+        }
+        body_received.notify_all();
+        return true;
+    };
 
     for (const auto& header : headers) {
         pending_headers.push_back(header);
@@ -369,31 +458,41 @@ void Context::MakeRequest() {
     } else {
         MakeRequestNonSSL(request, url_info, pending_headers);
     }
+
+    {
+        std::scoped_lock lock{body_mutex};
+        body_complete = true;
+    }
+    body_received.notify_all();
 }
 
 void Context::MakeRequestNonSSL(httplib::Request& request, const URLInfo& url_info,
                                 std::vector<Context::RequestHeader>& pending_headers) {
-    httplib::Error error{-1};
-    std::unique_ptr<httplib::Client> client =
-        std::make_unique<httplib::Client>(url_info.host, url_info.port);
-
-    client->set_header_writer(
-        [this, &pending_headers](httplib::Stream& strm, httplib::Headers& httplib_headers) {
-            return HandleHeaderWrite(pending_headers, strm, httplib_headers);
-        });
-
-    if (!client->send(request, response, error)) {
-        LOG_ERROR(Service_HTTP, "Request failed: {}: {}", error, httplib::to_string(error));
-        state = RequestState::Completed;
-    } else {
-        LOG_DEBUG(Service_HTTP, "Request successful");
-        state = RequestState::ReceivingBody;
+    const ClientPool::Key key{url_info.host, url_info.port, false, false};
+    std::unique_ptr<httplib::ClientImpl> client = client_pool->Acquire(key);
+    if (!client) {
+        client = std::make_unique<httplib::ClientImpl>(url_info.host, url_info.port);
+        client->set_keep_alive(true);
     }
+
+    SendRequest(*client, request, pending_headers);
+    client_pool->Release(key, std::move(client));
 }
 
 void Context::MakeRequestSSL(httplib::Request& request, const URLInfo& url_info,
                              std::vector<Context::RequestHeader>& pending_headers) {
-    httplib::Error error{-1};
+    // Connections with the certificate of a client cert context are not shared, as the context
+    // can be closed and replaced.
+    const bool shared = uses_default_client_cert || ssl_config.client_cert_ctx.expired();
+    const ClientPool::Key pool_key{url_info.host, url_info.port, true, uses_default_client_cert};
+    if (shared) {
+        if (auto client = client_pool->Acquire(pool_key)) {
+            SendRequest(*client, request, pending_headers);
+            client_pool->Release(pool_key, std::move(client));
+            return;
+        }
+    }
+
     X509* cert = nullptr;
     EVP_PKEY* key = nullptr;
     const unsigned char* cert_data = nullptr;
@@ -434,13 +533,26 @@ void Context::MakeRequestSSL(httplib::Request& request, const URLInfo& url_info,
     // https://www.3dbrew.org/wiki/SSL_Services#SSLOpt
     // Hack: Since for now RootCerts are not implemented we set the VerifyMode to None.
     client->enable_server_certificate_verification(false);
+    client->set_keep_alive(shared);
+    if (shared) {
+        client_pool->ResumeSessions(pool_key, *client);
+    }
+
+    SendRequest(*client, request, pending_headers);
+    if (shared) {
+        client_pool->Release(pool_key, std::move(client));
+    }
+}
 
-    client->set_header_writer(
+void Context::SendRequest(httplib::ClientImpl& client, httplib::Request& request,
+                          std::vector<Context::RequestHeader>& pending_headers) {
+    httplib::Error error{-1};
+    client.set_header_writer(
         [this, &pending_headers](httplib::Stream& strm, httplib::Headers& httplib_headers) {
             return HandleHeaderWrite(pending_headers, strm, httplib_headers);
         });
 
-    if (!client->send(request, response, error)) {
+    if (!client.send(request, response, error)) {
         LOG_ERROR(Service_HTTP, "Request failed: {}: {}", error, httplib::to_string(error));
         state = RequestState::Completed;
     } else {
@@ -679,14 +791,20 @@ void HTTP_C::ReceiveDataImpl(Kernel::HLERequestContext& ctx, bool timeout) {
         [this, async_data](Kernel::HLERequestContext& ctx) {
             Context& http_context = GetContext(async_data->context_handle);
 
+            // Wait until the buffer can be filled or the whole body was received.
+            const auto has_data = [&http_context, async_data] {
+                return http_context.body_complete ||
+                       http_context.response.body.size() - http_context.current_copied_data >=
+                           async_data->buffer_size;
+            };
+            std::unique_lock lock{http_context.body_mutex};
             if (async_data->timeout) {
-                const auto wait_res = http_context.request_future.wait_for(
-                    std::chrono::nanoseconds(async_data->timeout_nanos));
-                if (wait_res == std::future_status::timeout) {
+                if (!http_context.body_received.wait_for(
+                        lock, std::chrono::nanoseconds(async_data->timeout_nanos), has_data)) {
                     async_data->async_res = ErrorTimeout;
                 }
             } else {
-                http_context.request_future.wait();
+                http_context.body_received.wait(lock, has_data);
             }
             // Simulate small delay from HTTP receive.
             return 1'000'000;
@@ -699,11 +817,12 @@ void HTTP_C::ReceiveDataImpl(Kernel::HLERequestContext& ctx, bool timeout) {
                 return;
             }
             Context& http_context = GetContext(async_data->context_handle);
+            std::scoped_lock lock{http_context.body_mutex};
 
             const std::size_t remaining_data =
                 http_context.response.body.size() - http_context.current_copied_data;
 
-            if (async_data->buffer_size >= remaining_data) {
+            if (async_data->buffer_size >= remaining_data && http_context.body_complete) {
                 async_data->buffer->Write(http_context.response.body.data() +
                                               http_context.current_copied_data,
                                           0, remaining_data);
@@ -788,6 +907,7 @@ void HTTP_C::CreateContext(Kernel::HLERequestContext& ctx) {
     contexts[context_counter].socket_buffer_size = 0;
     contexts[context_counter].handle = context_counter;
     contexts[context_counter].session_id = session_data->session_id;
+    contexts[context_counter].client_pool = &client_pool;
 
     session_data->num_http_contexts++;
 
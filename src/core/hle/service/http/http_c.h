@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -160,6 +164,62 @@ struct ClCertAData {
     bool init = false;
 };
 
+/**
+ * Keeps the connections of finished requests open, so that later requests to the same server
+ * from any context reuse them instead of connecting and negotiating TLS again.
+ */
+class ClientPool {
+public:
+    /// Identifies the requests a connection can be reused for.
+    struct Key {
+        std::string host;
+        int port;
+        bool is_https;
+        bool default_client_cert;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    /// Takes an idle connection to the server, returns null if there is none.
+    std::unique_ptr<httplib::ClientImpl> Acquire(const Key& key);
+
+    /// Keeps a connection for later requests if the server left it open.
+    void Release(const Key& key, std::unique_ptr<httplib::ClientImpl> client);
+
+    /**
+     * Makes a new TLS connection resume the last session negotiated with the server, so that
+     * connecting again after the idle connections were closed skips the full handshake.
+     */
+    void ResumeSessions(const Key& key, httplib::SSLClient& client);
+
+    ~ClientPool();
+
+private:
+    static constexpr std::size_t MaxIdlePerServer = 4;
+    /// Servers close idle connections after a while, older ones are not worth checking.
+    static constexpr auto IdleTimeout = std::chrono::seconds(30);
+
+    struct IdleClient {
+        std::unique_ptr<httplib::ClientImpl> client;
+        std::chrono::steady_clock::time_point released;
+    };
+
+    /// The last TLS session negotiated with a server, pointed to by the contexts of its clients.
+    struct SessionSlot {
+        ClientPool* pool{};
+        SSL_SESSION* session{};
+    };
+
+    static int OnNewSession(SSL* ssl, SSL_SESSION* session);
+    static void OnHandshakeInfo(const SSL* ssl, int where, int ret);
+
+    std::mutex sessions_mutex;
+    std::map<Key, SessionSlot> sessions;
+
+    std::mutex mutex;
+    std::map<Key, std::vector<IdleClient>> idle_clients;
+};
+
 /// Represents an HTTP context.
 class Context final {
 public:
@@ -274,6 +334,7 @@ public:
     u32 socket_buffer_size;
     std::vector<RequestHeader> headers;
     const ClCertAData* clcert_data;
+    ClientPool* client_pool;
     bool post_data_added = false;
     bool post_pending_request = false;
     Params post_data;
@@ -293,6 +354,11 @@ public:
     httplib::Response response;
     Common::Event finish_post_data;
 
+    /// Guards the response body, which is received while the guest is already reading it.
+    std::mutex body_mutex;
+    std::condition_variable body_received;
+    bool body_complete = false;
+
     void ParseAsciiPostData();
     std::string ParseMultipartFormData();
     void MakeRequest();
@@ -300,6 +366,8 @@ public:
                            std::vector<Context::RequestHeader>& pending_headers);
     void MakeRequestSSL(httplib::Request& request, const URLInfo& url_info,
                         std::vector<Context::RequestHeader>& pending_headers);
+    void SendRequest(httplib::ClientImpl& client, httplib::Request& request,
+                     std::vector<Context::RequestHeader>& pending_headers);
     bool ContentProvider(size_t offset, size_t length, httplib::DataSink& sink);
     bool ChunkedContentProvider(size_t offset, httplib::DataSink& sink);
     std::size_t HandleHeaderWrite(std::vector<Context::RequestHeader>& pending_headers,
@@ -883,6 +951,9 @@ private:
     /// The next handle number to use when a new ClientCert context is created.
     ClientCertContext::Handle client_certs_counter = 0;
 
+    /// Connections shared by all the contexts, destroyed after them.
+    ClientPool client_pool;
+
     /// Global list of HTTP contexts currently opened.
     std::unordered_map<Context::Handle, Context> contexts;
 
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include "common/alignment.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
@@ -63,6 +64,28 @@ VAddr CROHelper::SegmentTagToAddress(SegmentTag segment_tag) const {
     return entry.offset + segment_tag.offset_into_segment;
 }
 
+VAddr CROHelper::SegmentTagToAddress(std::span<const SegmentEntry> segments,
+                                     SegmentTag segment_tag) {
+    if (segment_tag.segment_index >= segments.size())
+        return 0;
+
+    const SegmentEntry& entry = segments[segment_tag.segment_index];
+
+    if (segment_tag.offset_into_segment >= entry.size)
+        return 0;
+
+    return entry.offset + segment_tag.offset_into_segment;
+}
+
+void CROHelper::FlushRelocatedPages() {
+    std::sort(relocated_pages.begin(), relocated_pages.end());
+    const auto end = std::unique(relocated_pages.begin(), relocated_pages.end());
+    for (auto it = relocated_pages.begin(); it != end; ++it) {
+        system.InvalidateCacheRange(*it, Memory::CITRA_PAGE_SIZE);
+    }
+    relocated_pages.clear();
+}
+
 Result CROHelper::ApplyRelocation(VAddr target_address, RelocationType relocation_type, u32 addend,
                                   u32 symbol_address, u32 target_future_address) {
 
@@ -72,11 +95,11 @@ Result CROHelper::ApplyRelocation(VAddr target_address, RelocationType relocatio
     case RelocationType::AbsoluteAddress:
     case RelocationType::AbsoluteAddress2:
         system.Memory().Write32(target_address, symbol_address + addend);
-        system.InvalidateCacheRange(target_address, sizeof(u32));
+        relocated_pages.push_back(target_address & ~Memory::CITRA_PAGE_MASK);
         break;
     case RelocationType::RelativeAddress:
         system.Memory().Write32(target_address, symbol_address + addend - target_future_address);
-        system.InvalidateCacheRange(target_address, sizeof(u32));
+        relocated_pages.push_back(target_address & ~Memory::CITRA_PAGE_MASK);
         break;
     case RelocationType::ThumbBranch:
     case RelocationType::ArmBranch:
@@ -99,7 +122,7 @@ Result CROHelper::ClearRelocation(VAddr target_address, RelocationType relocatio
     case RelocationType::AbsoluteAddress2:
     case RelocationType::RelativeAddress:
         system.Memory().Write32(target_address, 0);
-        system.InvalidateCacheRange(target_address, sizeof(u32));
+        relocated_pages.push_back(target_address & ~Memory::CITRA_PAGE_MASK);
         break;
     case RelocationType::ThumbBranch:
     case RelocationType::ArmBranch:
@@ -118,22 +141,29 @@ Result CROHelper::ApplyRelocationBatch(VAddr batch, u32 symbol_address, bool res
     if (symbol_address == 0 && !reset)
         return CROFormatError(0x10);
 
+    const auto segments = GetEntries<SegmentEntry>(system.Memory(), GetField(SegmentNum));
+    RelocationEntry first_relocation{};
     VAddr relocation_address = batch;
+    Result result = ResultSuccess;
     while (true) {
         RelocationEntry relocation;
         system.Memory().ReadBlock(process, relocation_address, &relocation,
                                   sizeof(RelocationEntry));
+        if (relocation_address == batch) {
+            first_relocation = relocation;
+        }
 
-        VAddr relocation_target = SegmentTagToAddress(relocation.target_position);
+        VAddr relocation_target = SegmentTagToAddress(segments, relocation.target_position);
         if (relocation_target == 0) {
-            return CROFormatError(0x12);
+            result = CROFormatError(0x12);
+            break;
         }
 
-        Result result = ApplyRelocation(relocation_target, relocation.type, relocation.addend,
-                                        symbol_address, relocation_target);
+        result = ApplyRelocation(relocation_target, relocation.type, relocation.addend,
+                                 symbol_address, relocation_target);
         if (result.IsError()) {
             LOG_ERROR(Service_LDR, "Error applying relocation {:08X}", result.raw);
-            return result;
+            break;
         }
 
         if (relocation.is_batch_end)
@@ -141,11 +171,13 @@ Result CROHelper::ApplyRelocationBatch(VAddr batch, u32 symbol_address, bool res
 
         relocation_address += sizeof(RelocationEntry);
     }
+    FlushRelocatedPages();
+    if (result.IsError()) {
+        return result;
+    }
 
-    RelocationEntry relocation;
-    system.Memory().ReadBlock(process, batch, &relocation, sizeof(RelocationEntry));
-    relocation.is_batch_resolved = reset ? 0 : 1;
-    system.Memory().WriteBlock(process, batch, &relocation, sizeof(RelocationEntry));
+    first_relocation.is_batch_resolved = reset ? 0 : 1;
+    system.Memory().WriteBlock(process, batch, &first_relocation, sizeof(RelocationEntry));
     return ResultSuccess;
 }
 
@@ -154,14 +186,20 @@ VAddr CROHelper::FindExportNamedSymbol(const std::string& name) const {
         return 0;
 
     std::size_t len = name.size();
+    const VAddr tree_address = GetField(ExportTreeTableOffset);
+    const auto get_tree_entry = [&](std::size_t index, ExportTreeEntry& tree_entry) {
+        system.Memory().ReadBlock(process,
+                                  tree_address + static_cast<u32>(index * sizeof(ExportTreeEntry)),
+                                  &tree_entry, sizeof(ExportTreeEntry));
+    };
     ExportTreeEntry entry;
-    GetEntry(system.Memory(), 0, entry);
+    get_tree_entry(0, entry);
     ExportTreeEntry::Child next;
     next.raw = entry.left.raw;
     u32 found_id;
 
     while (true) {
-        GetEntry(system.Memory(), next.next_index, entry);
+        get_tree_entry(next.next_index, entry);
 
         if (next.is_end) {
             found_id = entry.export_table_index;
@@ -474,73 +512,80 @@ VAddr CROHelper::GetOnUnresolvedAddress() {
 Result CROHelper::ResetExternalRelocations() {
     u32 unresolved_symbol = GetOnUnresolvedAddress();
     u32 external_relocation_num = GetField(ExternalRelocationNum);
-    ExternalRelocationEntry relocation;
+    auto relocations =
+        GetEntries<ExternalRelocationEntry>(system.Memory(), external_relocation_num);
 
     // Verifies that the last relocation is the end of a batch
-    GetEntry(system.Memory(), external_relocation_num - 1, relocation);
-    if (!relocation.is_batch_end) {
+    if (relocations.empty() || !relocations.back().is_batch_end) {
         return CROFormatError(0x12);
     }
 
+    const auto segments = GetEntries<SegmentEntry>(system.Memory(), GetField(SegmentNum));
+    Result result = ResultSuccess;
     bool batch_begin = true;
-    for (u32 i = 0; i < external_relocation_num; ++i) {
-        GetEntry(system.Memory(), i, relocation);
-        VAddr relocation_target = SegmentTagToAddress(relocation.target_position);
+    for (ExternalRelocationEntry& relocation : relocations) {
+        VAddr relocation_target = SegmentTagToAddress(segments, relocation.target_position);
 
         if (relocation_target == 0) {
-            return CROFormatError(0x12);
+            result = CROFormatError(0x12);
+            break;
         }
 
-        Result result = ApplyRelocation(relocation_target, relocation.type, relocation.addend,
-                                        unresolved_symbol, relocation_target);
+        result = ApplyRelocation(relocation_target, relocation.type, relocation.addend,
+                                 unresolved_symbol, relocation_target);
         if (result.IsError()) {
             LOG_ERROR(Service_LDR, "Error applying relocation {:08X}", result.raw);
-            return result;
+            break;
         }
 
         if (batch_begin) {
             // resets to unresolved state
             relocation.is_batch_resolved = 0;
-            SetEntry(system.Memory(), i, relocation);
         }
 
         // if current is an end, then the next is a beginning
         batch_begin = relocation.is_batch_end != 0;
     }
 
-    return ResultSuccess;
+    SetEntries<ExternalRelocationEntry>(system.Memory(), relocations);
+    FlushRelocatedPages();
+    return result;
 }
 
 Result CROHelper::ClearExternalRelocations() {
     u32 external_relocation_num = GetField(ExternalRelocationNum);
-    ExternalRelocationEntry relocation;
+    auto relocations =
+        GetEntries<ExternalRelocationEntry>(system.Memory(), external_relocation_num);
+    const auto segments = GetEntries<SegmentEntry>(system.Memory(), GetField(SegmentNum));
 
+    Result result = ResultSuccess;
     bool batch_begin = true;
-    for (u32 i = 0; i < external_relocation_num; ++i) {
-        GetEntry(system.Memory(), i, relocation);
-        VAddr relocation_target = SegmentTagToAddress(relocation.target_position);
+    for (ExternalRelocationEntry& relocation : relocations) {
+        VAddr relocation_target = SegmentTagToAddress(segments, relocation.target_position);
 
         if (relocation_target == 0) {
-            return CROFormatError(0x12);
+            result = CROFormatError(0x12);
+            break;
         }
 
-        Result result = ClearRelocation(relocation_target, relocation.type);
+        result = ClearRelocation(relocation_target, relocation.type);
         if (result.IsError()) {
             LOG_ERROR(Service_LDR, "Error clearing relocation {:08X}", result.raw);
-            return result;
+            break;
         }
 
         if (batch_begin) {
             // resets to unresolved state
             relocation.is_batch_resolved = 0;
-            SetEntry(system.Memory(), i, relocation);
         }
 
         // if current is an end, then the next is a beginning
         batch_begin = relocation.is_batch_end != 0;
     }
 
-    return ResultSuccess;
+    SetEntries<ExternalRelocationEntry>(system.Memory(), relocations);
+    FlushRelocatedPages();
+    return result;
 }
 
 Result CROHelper::ApplyStaticAnonymousSymbolToCRS(VAddr crs_address) {
@@ -576,19 +621,18 @@ Result CROHelper::ApplyStaticAnonymousSymbolToCRS(VAddr crs_address) {
 }
 
 Result CROHelper::ApplyInternalRelocations(u32 old_data_segment_address) {
-    u32 segment_num = GetField(SegmentNum);
-    u32 internal_relocation_num = GetField(InternalRelocationNum);
-    for (u32 i = 0; i < internal_relocation_num; ++i) {
-        InternalRelocationEntry relocation;
-        GetEntry(system.Memory(), i, relocation);
-        VAddr target_addressB = SegmentTagToAddress(relocation.target_position);
+    const auto segments = GetEntries<SegmentEntry>(system.Memory(), GetField(SegmentNum));
+    const auto relocations = GetEntries<InternalRelocationEntry>(
+        system.Memory(), GetField(InternalRelocationNum));
+    for (const InternalRelocationEntry& relocation : relocations) {
+        VAddr target_addressB = SegmentTagToAddress(segments, relocation.target_position);
         if (target_addressB == 0) {
+            FlushRelocatedPages();
             return CROFormatError(0x15);
         }
 
         VAddr target_address;
-        SegmentEntry target_segment;
-        GetEntry(system.Memory(), relocation.target_position.segment_index, target_segment);
+        const SegmentEntry& target_segment = segments[relocation.target_position.segment_index];
 
         if (target_segment.type == SegmentType::Data) {
             // If the relocation is to the .data segment, we need to relocate it in the old buffer
@@ -598,42 +642,47 @@ Result CROHelper::ApplyInternalRelocations(u32 old_data_segment_address) {
             target_address = target_addressB;
         }
 
-        if (relocation.symbol_segment >= segment_num) {
+        if (relocation.symbol_segment >= segments.size()) {
+            FlushRelocatedPages();
             return CROFormatError(0x15);
         }
 
-        SegmentEntry symbol_segment;
-        GetEntry(system.Memory(), relocation.symbol_segment, symbol_segment);
+        const SegmentEntry& symbol_segment = segments[relocation.symbol_segment];
         LOG_TRACE(Service_LDR, "Internally relocates 0x{:08X} with 0x{:08X}", target_address,
                   symbol_segment.offset);
         Result result = ApplyRelocation(target_address, relocation.type, relocation.addend,
                                         symbol_segment.offset, target_addressB);
         if (result.IsError()) {
             LOG_ERROR(Service_LDR, "Error applying relocation {:08X}", result.raw);
+            FlushRelocatedPages();
             return result;
         }
     }
+    FlushRelocatedPages();
     return ResultSuccess;
 }
 
 Result CROHelper::ClearInternalRelocations() {
-    u32 internal_relocation_num = GetField(InternalRelocationNum);
-    for (u32 i = 0; i < internal_relocation_num; ++i) {
-        InternalRelocationEntry relocation;
-        GetEntry(system.Memory(), i, relocation);
-        VAddr target_address = SegmentTagToAddress(relocation.target_position);
+    const auto segments = GetEntries<SegmentEntry>(system.Memory(), GetField(SegmentNum));
+    const auto relocations = GetEntries<InternalRelocationEntry>(
+        system.Memory(), GetField(InternalRelocationNum));
+    Result result = ResultSuccess;
+    for (const InternalRelocationEntry& relocation : relocations) {
+        VAddr target_address = SegmentTagToAddress(segments, relocation.target_position);
 
         if (target_address == 0) {
-            return CROFormatError(0x15);
+            result = CROFormatError(0x15);
+            break;
         }
 
-        Result result = ClearRelocation(target_address, relocation.type);
+        result = ClearRelocation(target_address, relocation.type);
         if (result.IsError()) {
             LOG_ERROR(Service_LDR, "Error clearing relocation {:08X}", result.raw);
-            return result;
+            break;
         }
     }
-    return ResultSuccess;
+    FlushRelocatedPages();
+    return result;
 }
 
 void CROHelper::UnrebaseImportAnonymousSymbolTable() {
@@ -749,41 +798,44 @@ void CROHelper::UnrebaseHeader() {
 
 Result CROHelper::ApplyImportNamedSymbol(VAddr crs_address) {
     u32 import_strings_size = GetField(ImportStringsSize);
-    u32 symbol_import_num = GetField(ImportNamedSymbolNum);
-    for (u32 i = 0; i < symbol_import_num; ++i) {
-        ImportNamedSymbolEntry entry;
-        GetEntry(system.Memory(), i, entry);
+    const auto entries =
+        GetEntries<ImportNamedSymbolEntry>(system.Memory(), GetField(ImportNamedSymbolNum));
+
+    // The auto-link modules do not change while the imports are resolved, walk their list once
+    // instead of once per import.
+    std::vector<CROHelper> sources;
+    ForEachAutoLinkCRO(process, system, crs_address, [&](CROHelper source) -> ResultVal<bool> {
+        sources.push_back(source);
+        return true;
+    });
+
+    for (const ImportNamedSymbolEntry& entry : entries) {
         VAddr relocation_addr = entry.relocation_batch_offset;
         ExternalRelocationEntry relocation_entry;
         system.Memory().ReadBlock(process, relocation_addr, &relocation_entry,
                                   sizeof(ExternalRelocationEntry));
 
-        if (!relocation_entry.is_batch_resolved) {
-            Result result = ForEachAutoLinkCRO(
-                process, system, crs_address, [&](CROHelper source) -> ResultVal<bool> {
-                    std::string symbol_name =
-                        system.Memory().ReadCString(entry.name_offset, import_strings_size);
-                    u32 symbol_address = source.FindExportNamedSymbol(symbol_name);
-
-                    if (symbol_address != 0) {
-                        LOG_TRACE(Service_LDR, "CRO \"{}\" imports \"{}\" from \"{}\"",
-                                  ModuleName(), symbol_name, source.ModuleName());
+        if (relocation_entry.is_batch_resolved) {
+            continue;
+        }
 
-                        Result result = ApplyRelocationBatch(relocation_addr, symbol_address);
-                        if (result.IsError()) {
-                            LOG_ERROR(Service_LDR, "Error applying relocation batch {:08X}",
-                                      result.raw);
-                            return result;
-                        }
+        const std::string symbol_name =
+            system.Memory().ReadCString(entry.name_offset, import_strings_size);
+        for (const CROHelper& source : sources) {
+            u32 symbol_address = source.FindExportNamedSymbol(symbol_name);
+            if (symbol_address == 0) {
+                continue;
+            }
 
-                        return false;
-                    }
+            LOG_TRACE(Service_LDR, "CRO \"{}\" imports \"{}\" from \"{}\"", ModuleName(),
+                      symbol_name, source.ModuleName());
 
-                    return true;
-                });
+            Result result = ApplyRelocationBatch(relocation_addr, symbol_address);
             if (result.IsError()) {
+                LOG_ERROR(Service_LDR, "Error applying relocation batch {:08X}", result.raw);
                 return result;
             }
+            break;
         }
     }
     return ResultSuccess;
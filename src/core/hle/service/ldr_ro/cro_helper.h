@@ -5,7 +5,9 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <tuple>
+#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/hle/result.h"
@@ -142,6 +144,8 @@ private:
     const VAddr module_address; ///< the virtual address of this module
     Kernel::Process& process;   ///< the owner process of this module
     Core::System& system;
+    /// Pages written by relocations whose JIT cache was not invalidated yet
+    std::vector<VAddr> relocated_pages;
 
     /**
      * Each item in this enum represents a u32 field in the header begin from address+0x80,
@@ -434,6 +438,42 @@ private:
                           &data, sizeof(T));
     }
 
+    /**
+     * Reads a whole module table at once.
+     * @param count the number of entries in the table
+     * @returns std::vector<T> the entries of the table
+     * @note the entry type must have the static member TABLE_OFFSET_FIELD
+     *       indicating which table the entries are in.
+     */
+    template <typename T>
+    std::vector<T> GetEntries(Memory::MemorySystem& memory, u32 count) const {
+        std::vector<T> entries(count);
+        memory.ReadBlock(process, GetField(T::TABLE_OFFSET_FIELD), entries.data(),
+                         entries.size() * sizeof(T));
+        return entries;
+    }
+
+    /**
+     * Writes a whole module table at once.
+     * @param entries the entries of the table, starting from the first one
+     * @note the entry type must have the static member TABLE_OFFSET_FIELD
+     *       indicating which table the entries are in.
+     */
+    template <typename T>
+    void SetEntries(Memory::MemorySystem& memory, std::span<const T> entries) {
+        memory.WriteBlock(process, GetField(T::TABLE_OFFSET_FIELD), entries.data(),
+                          entries.size() * sizeof(T));
+    }
+
+    /**
+     * Converts a segment tag to virtual address using a segment table read beforehand.
+     * @param segments the segment table of the module
+     * @param segment_tag the segment tag to convert
+     * @returns VAddr the virtual address the segment tag points to; 0 if invalid.
+     */
+    static VAddr SegmentTagToAddress(std::span<const SegmentEntry> segments,
+                                     SegmentTag segment_tag);
+
     /**
      * Converts a segment tag to virtual address in this module.
      * @param segment_tag the segment tag to convert
@@ -484,7 +524,13 @@ private:
     }
 
     /**
-     * Applies a relocation
+     * Invalidates the JIT cache of the pages written by relocations since the last call. Batches
+     * of relocations mostly write to the same few pages, which are then checked only once.
+     */
+    void FlushRelocatedPages();
+
+    /**
+     * Applies a relocation. The JIT cache is invalidated by the next FlushRelocatedPages call.
      * @param target_address where to apply the relocation
      * @param relocation_type the type of the relocation
      * @param addend address addend applied to the relocated symbol
@@ -497,7 +543,8 @@ private:
                            u32 symbol_address, u32 target_future_address);
 
     /**
-     * Clears a relocation to zero
+     * Clears a relocation to zero. The JIT cache is invalidated by the next FlushRelocatedPages
+     * call.
      * @param target_address where to apply the relocation
      * @param relocation_type the type of the relocation
      * @returns Result ResultSuccess on success, otherwise error code.
@@ -8,6 +8,15 @@
 
 namespace Service::MVD {
 
+/**
+ * mvd:std, the New 3DS H.264 video decoder service. None of the commands are implemented yet, so
+ * titles that decode video through it are currently unsupported.
+ *
+ * A host backed decoder belongs here: ProcessNALUnit would feed the NAL units to the decoder and
+ * the decoded frames would be written to the buffers set through SetOutputBuffer, converted with
+ * the Y2R conversion in HW::Y2R. The IPC layouts of these commands still have to be verified
+ * against hardware first.
+ */
 class MVD_STD final : public ServiceFramework<MVD_STD> {
 public:
     MVD_STD();
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <chrono>
+#include <cstring>
 #include <boost/crc.hpp>
 #include <cryptopp/osrng.h>
 
@@ -349,7 +350,7 @@ Result NfcDevice::Mount() {
         return ResultSuccess;
     }
 
-    if (!AmiiboCrypto::DecodeAmiibo(encrypted_tag.file, tag.file)) {
+    if (!DecodeTag()) {
         LOG_ERROR(Service_NFC, "Can't decode amiibo {}", device_state);
         return ResultNeedFormat;
     }
@@ -358,6 +359,19 @@ Result NfcDevice::Mount() {
     return ResultSuccess;
 }
 
+bool NfcDevice::DecodeTag() {
+    if (decoded_tag && std::memcmp(&decoded_tag->encrypted, &encrypted_tag.file,
+                                   sizeof(EncryptedNTAG215File)) == 0) {
+        tag.file = decoded_tag->decoded;
+        return true;
+    }
+    if (!AmiiboCrypto::DecodeAmiibo(encrypted_tag.file, tag.file)) {
+        return false;
+    }
+    decoded_tag = DecodedTag{encrypted_tag.file, tag.file};
+    return true;
+}
+
 Result NfcDevice::MountAmiibo() {
     TagInfo tag_info{};
     const auto result = GetTagInfo(tag_info);
@@ -394,7 +408,7 @@ Result NfcDevice::PartiallyMount() {
         return ResultSuccess;
     }
 
-    if (!AmiiboCrypto::DecodeAmiibo(encrypted_tag.file, tag.file)) {
+    if (!DecodeTag()) {
         LOG_ERROR(Service_NFC, "Can't decode amiibo {}", device_state);
         return ResultNeedFormat;
     }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <optional>
 #include <span>
 #include <vector>
 #include <boost/serialization/binary_object.hpp>
@@ -85,6 +86,16 @@ private:
 
     void BuildAmiiboWithoutKeys();
 
+    /// Decodes the encrypted tag into tag, reusing the last decoded tag if it was decoded from the
+    /// same data, as games mount the same tag again on every scan.
+    bool DecodeTag();
+
+    /// The last tag decoded with keys, and the encrypted data it was decoded from.
+    struct DecodedTag {
+        EncryptedNTAG215File encrypted;
+        NTAG215File decoded;
+    };
+
     std::shared_ptr<Kernel::Event> tag_in_range_event = nullptr;
     std::shared_ptr<Kernel::Event> tag_out_of_range_event = nullptr;
     Core::TimingEventType* remove_amiibo_event = nullptr;
@@ -104,6 +115,7 @@ private:
 
     SerializableAmiiboFile tag{};
     SerializableEncryptedAmiiboFile encrypted_tag{};
+    std::optional<DecodedTag> decoded_tag;
     Core::System& system;
 
     template <class Archive>
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <fmt/format.h>
 #include "common/assert.h"
 #include "common/hacks/hack_manager.h"
@@ -242,6 +243,7 @@ void Init(Core::System& core, u64 loading_titleid, std::vector<u64>& lle_modules
             continue;
         }
 
+        const auto start = std::chrono::steady_clock::now();
         const bool has_lle = allow_lle &&
                              core.GetSaveStateStatus() != Core::System::SaveStateStatus::LOADING &&
                              AttemptLLE(service_module, loading_titleid);
@@ -252,6 +254,11 @@ void Init(Core::System& core, u64 loading_titleid, std::vector<u64>& lle_modules
             service_module.init_function(core);
         }
         lle_module_present |= has_lle;
+        LOG_DEBUG(Service, "Initialized {} ({}) in {} us", service_module.name,
+                  has_lle ? "LLE" : "HLE",
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count());
     }
     if (lle_module_present) {
         // If there is at least one LLE module, tell the kernel to
@@ -9,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <boost/container/flat_map.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/shared_ptr.hpp>
@@ -53,6 +54,10 @@ public:
         return service_name;
     }
 
+    std::string_view GetHandlerName() const override {
+        return service_name;
+    }
+
     /**
      * Returns the maximum number of sessions that can be connected to this service at the same
      * time.
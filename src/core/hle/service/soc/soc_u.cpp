@@ -19,6 +19,7 @@
 #include "core/hle/kernel/shared_memory.h"
 #include "core/hle/result.h"
 #include "core/hle/service/soc/soc_u.h"
+#include "core/hle/service/soc/socket_readiness.h"
 #include "network/socket_manager.h"
 
 #ifdef _WIN32
@@ -423,6 +424,10 @@ u32 SOC_U::SetSocketBlocking(SocketHolder& socket_holder, bool blocking) {
     return posix_ret;
 }
 
+static bool IsWouldBlock(int error) {
+    return error == ERRNO(EAGAIN) || error == ERRNO(EWOULDBLOCK);
+}
+
 std::optional<std::reference_wrapper<SocketHolder>> SOC_U::GetSocketHolder(u32 ctr_socket_fd,
                                                                            u32 process_id,
                                                                            IPC::RequestParser& rp) {
@@ -450,8 +455,9 @@ std::optional<std::reference_wrapper<SocketHolder>> SOC_U::GetSocketHolder(u32 c
 }
 
 void SOC_U::CloseAndDeleteAllSockets(s32 process_id) {
-    std::erase_if(created_sockets, [process_id](const auto& entry) {
+    std::erase_if(created_sockets, [this, process_id](const auto& entry) {
         if (process_id == -1 || entry.second.ownerProcess == static_cast<u32>(process_id)) {
+            readiness->Forget(entry.second.socket_fd);
             closesocket(entry.second.socket_fd);
             return true;
         }
@@ -1093,6 +1099,7 @@ void SOC_U::Close(Kernel::HLERequestContext& ctx) {
     SocketHolder& holder = socket_holder_optional->get();
 
     s32 ret = 0;
+    readiness->Forget(holder.socket_fd);
     ret = closesocket(holder.socket_fd);
 
     if (ret != 0) {
@@ -1136,9 +1143,16 @@ void SOC_U::SendToOther(Kernel::HLERequestContext& ctx) {
         flags |= MSG_DONTWAIT;
     }
 #endif // _WIN32
-    std::vector<u8> input_buff(len);
-    input_mapped_buff.Read(input_buff.data(), 0,
-                           std::min(input_mapped_buff.GetSize(), static_cast<std::size_t>(len)));
+    // Send straight from guest memory when possible, otherwise bounce through a host buffer.
+    const auto input_view = input_mapped_buff.GetContiguousView(0, len);
+    std::vector<u8> input_buff;
+    if (input_view.empty()) {
+        input_buff.resize(len);
+        input_mapped_buff.Read(
+            input_buff.data(), 0,
+            std::min(input_mapped_buff.GetSize(), static_cast<std::size_t>(len)));
+    }
+    const u8* input_data = input_view.empty() ? input_buff.data() : input_view.data();
 
     s32 ret = -1;
     if (addr_len > 0) {
@@ -1147,12 +1161,11 @@ void SOC_U::SendToOther(Kernel::HLERequestContext& ctx) {
                     std::min<size_t>(addr_len, sizeof(ctr_dest_addr)));
         auto [dest_addr, dest_addr_len] = CTRSockAddr::ToPlatform(ctr_dest_addr);
         ret = static_cast<s32>(
-            ::sendto(holder.socket_fd, reinterpret_cast<const char*>(input_buff.data()), len, flags,
+            ::sendto(holder.socket_fd, reinterpret_cast<const char*>(input_data), len, flags,
                      reinterpret_cast<sockaddr*>(&dest_addr), dest_addr_len));
     } else {
-        ret = static_cast<s32>(::sendto(holder.socket_fd,
-                                        reinterpret_cast<const char*>(input_buff.data()), len,
-                                        flags, nullptr, 0));
+        ret = static_cast<s32>(::sendto(holder.socket_fd, reinterpret_cast<const char*>(input_data),
+                                        len, flags, nullptr, 0));
     }
 
     const auto send_error = (ret == SOCKET_ERROR_VALUE) ? GET_ERRNO : 0;
@@ -1303,13 +1316,20 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
         bool was_blocking;
 #endif
         bool is_blocking;
+        bool known_idle;
+        u64 sequence;
 
         // Output
         s32 ret{};
         int recv_error;
         Kernel::MappedBuffer* buffer;
         std::vector<u8> output_buff;
+        std::span<u8> output_view;
         std::vector<u8> addr_buff;
+
+        u8* OutputData() {
+            return output_view.empty() ? output_buff.data() : output_view.data();
+        }
     };
 
     auto async_data = std::make_shared<AsyncData>();
@@ -1318,7 +1338,14 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
     async_data->len = len;
     async_data->flags = flags;
     async_data->addr_len = addr_len;
-    async_data->output_buff.resize(len);
+    // Non-blocking receives complete on the emulation thread and can land straight in guest
+    // memory. Blocking ones run on a worker thread and must go through a host buffer.
+    if (!needs_async) {
+        async_data->output_view = buffer.GetContiguousView(0, len);
+    }
+    if (async_data->output_view.empty()) {
+        async_data->output_buff.resize(len);
+    }
     async_data->addr_buff.resize(addr_len);
     async_data->fd_info = &holder;
     async_data->socket_handle = socket_handle;
@@ -1327,9 +1354,18 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
     async_data->was_blocking = was_blocking;
 #endif
     async_data->is_blocking = needs_async;
+    // Receives that do not wait fail right away on sockets known to have nothing to read.
+    async_data->sequence = readiness->Sequence(holder.socket_fd);
+    async_data->known_idle =
+        !needs_async && readiness->IsIdle(holder.socket_fd, SocketReadiness::Readable);
 
     ctx.RunAsync(
         [async_data](Kernel::HLERequestContext& ctx) {
+            if (async_data->known_idle) {
+                async_data->ret = SOCKET_ERROR_VALUE;
+                async_data->recv_error = ERRNO(EAGAIN);
+                return 0;
+            }
             sockaddr_storage src_addr;
             socklen_t src_addr_len = sizeof(src_addr);
             CTRSockAddr ctr_src_addr;
@@ -1340,7 +1376,7 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
             if (async_data->addr_len > 0) {
                 async_data->ret = static_cast<s32>(::recvfrom(
                     async_data->fd_info->socket_fd,
-                    reinterpret_cast<char*>(async_data->output_buff.data()), async_data->len,
+                    reinterpret_cast<char*>(async_data->OutputData()), async_data->len,
                     async_data->flags, reinterpret_cast<sockaddr*>(&src_addr), &src_addr_len));
                 if (async_data->ret >= 0 && src_addr_len > 0) {
                     ctr_src_addr = CTRSockAddr::FromPlatform(src_addr);
@@ -1350,7 +1386,7 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
             } else {
                 async_data->ret = static_cast<s32>(
                     ::recvfrom(async_data->fd_info->socket_fd,
-                               reinterpret_cast<char*>(async_data->output_buff.data()),
+                               reinterpret_cast<char*>(async_data->OutputData()),
                                async_data->len, async_data->flags, NULL, 0));
                 async_data->addr_buff.resize(0);
             }
@@ -1358,17 +1394,20 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
             return 0;
         },
         [this, async_data](Kernel::HLERequestContext& ctx) {
+            if (!async_data->is_blocking && !async_data->known_idle &&
+                async_data->ret == SOCKET_ERROR_VALUE && IsWouldBlock(async_data->recv_error)) {
+                readiness->MarkIdle(async_data->fd_info->socket_fd, SocketReadiness::Readable,
+                                    async_data->sequence);
+            }
             if (async_data->ret == SOCKET_ERROR_VALUE) {
                 async_data->ret = TranslateError(async_data->recv_error);
-            } else {
+            } else if (async_data->output_view.empty()) {
                 async_data->buffer->Write(async_data->output_buff.data(), 0, async_data->ret);
             }
 #ifdef _WIN32
             if (async_data->dont_wait && async_data->was_blocking) {
                 SetSocketBlocking(*async_data->fd_info, true);
             }
-#else
-            (void)this;
 #endif
             LOG_SEND_RECV(Service_SOC, "called, fd={}, ret={}", async_data->socket_handle,
                           static_cast<s32>(async_data->ret));
@@ -1422,6 +1461,8 @@ void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
         bool was_blocking;
 #endif
         bool is_blocking;
+        bool known_idle;
+        u64 sequence;
 
         // Output
         s32 ret{};
@@ -1444,9 +1485,18 @@ void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
     async_data->was_blocking = was_blocking;
 #endif
     async_data->is_blocking = needs_async;
+    // Receives that do not wait fail right away on sockets known to have nothing to read.
+    async_data->sequence = readiness->Sequence(holder.socket_fd);
+    async_data->known_idle =
+        !needs_async && readiness->IsIdle(holder.socket_fd, SocketReadiness::Readable);
 
     ctx.RunAsync(
         [async_data](Kernel::HLERequestContext& ctx) {
+            if (async_data->known_idle) {
+                async_data->ret = SOCKET_ERROR_VALUE;
+                async_data->recv_error = ERRNO(EAGAIN);
+                return 0;
+            }
             sockaddr_storage src_addr;
             socklen_t src_addr_len = sizeof(src_addr);
             CTRSockAddr ctr_src_addr;
@@ -1475,13 +1525,16 @@ void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
             return 0;
         },
         [this, async_data](Kernel::HLERequestContext& ctx) {
+            if (!async_data->is_blocking && !async_data->known_idle &&
+                async_data->ret == SOCKET_ERROR_VALUE && IsWouldBlock(async_data->recv_error)) {
+                readiness->MarkIdle(async_data->fd_info->socket_fd, SocketReadiness::Readable,
+                                    async_data->sequence);
+            }
 
 #ifdef _WIN32
             if (async_data->dont_wait && async_data->was_blocking) {
                 SetSocketBlocking(*async_data->fd_info, true);
             }
-#else
-            (void)this;
 #endif
             s32 total_received = async_data->ret;
             if (async_data->ret == SOCKET_ERROR_VALUE) {
@@ -1521,6 +1574,8 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
         std::vector<pollfd> platform_pollfd;
         std::vector<u8> has_libctru_bug;
         std::vector<CTRPollFD> ctr_fds;
+        std::vector<u64> sequences;
+        bool known_idle;
 
         // Output
         s32 ret;
@@ -1529,6 +1584,7 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
     auto async_data = std::make_shared<AsyncData>();
     async_data->timeout = timeout;
     async_data->nfds = nfds;
+    async_data->sequences.resize(nfds);
 
     async_data->ctr_fds.resize(nfds);
     std::memcpy(async_data->ctr_fds.data(), input_fds.data(), nfds * sizeof(CTRPollFD));
@@ -1546,8 +1602,25 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
             CTRPollFD::ToPlatform(*this, async_data->ctr_fds[i], async_data->has_libctru_bug[i]);
     }
 
+    // Polls that do not wait are answered without the host when none of the sockets has events.
+    async_data->known_idle = timeout == 0 && nfds > 0;
+    for (u32 i = 0; i < nfds; i++) {
+        const pollfd& platform_fd = async_data->platform_pollfd[i];
+        async_data->sequences[i] = readiness->Sequence(platform_fd.fd);
+        async_data->known_idle =
+            async_data->known_idle &&
+            readiness->IsIdle(platform_fd.fd, SocketReadiness::EventClasses(platform_fd.events));
+    }
+
     ctx.RunAsync(
         [async_data](Kernel::HLERequestContext& ctx) {
+            if (async_data->known_idle) {
+                for (auto& platform_fd : async_data->platform_pollfd) {
+                    platform_fd.revents = 0;
+                }
+                async_data->ret = 0;
+                return 0;
+            }
             async_data->ret =
                 ::poll(async_data->platform_pollfd.data(), async_data->nfds, async_data->timeout);
             if (async_data->ret == SOCKET_ERROR_VALUE) {
@@ -1556,6 +1629,16 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
             return 0;
         },
         [this, async_data](Kernel::HLERequestContext& ctx) {
+            if (async_data->ret != SOCKET_ERROR_VALUE && !async_data->known_idle) {
+                for (u32 i = 0; i < async_data->nfds; i++) {
+                    const pollfd& platform_fd = async_data->platform_pollfd[i];
+                    readiness->MarkIdle(
+                        platform_fd.fd,
+                        SocketReadiness::IdleClasses(platform_fd.events, platform_fd.revents),
+                        async_data->sequences[i]);
+                }
+            }
+
             // Now update the output 3ds_pollfd structure
             for (u32 i = 0; i < async_data->nfds; i++) {
                 async_data->ctr_fds[i] = CTRPollFD::FromPlatform(
@@ -1632,6 +1715,7 @@ void SOC_U::Shutdown(Kernel::HLERequestContext& ctx) {
     }
     SocketHolder& holder = socket_holder_optional->get();
 
+    readiness->Forget(holder.socket_fd);
     s32 ret = ::shutdown(holder.socket_fd, how);
     if (ret != 0) {
         ret = TranslateError(GET_ERRNO);
@@ -2225,13 +2309,19 @@ SOC_U::SOC_U() : ServiceFramework("soc:U", 18) {
     RegisterHandlers(functions);
 
     Network::SocketManager::EnableSockets();
+    readiness = std::make_unique<SocketReadiness>();
 }
 
 SOC_U::~SOC_U() {
     CloseAndDeleteAllSockets();
+    readiness.reset();
     Network::SocketManager::DisableSockets();
 }
 
+void SOC_U::ResetReadiness() {
+    readiness->Clear();
+}
+
 std::optional<SOC_U::InterfaceInfo> SOC_U::GetDefaultInterfaceInfo() {
     if (this->interface_info_cached) {
         return InterfaceInfo(this->interface_info);
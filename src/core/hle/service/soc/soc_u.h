@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <boost/serialization/set.hpp>
@@ -21,6 +22,8 @@ class RequestParser;
 
 namespace Service::SOC {
 
+class SocketReadiness;
+
 /// Holds information about a particular socket
 struct SocketHolder {
 #ifdef _WIN32
@@ -160,6 +163,12 @@ private:
     std::unordered_map<u32, SocketHolder> created_sockets;
     std::set<u32> initialized_processes;
 
+    /// Sockets known to be idle, to answer non-blocking polls and receives without the host
+    std::unique_ptr<SocketReadiness> readiness;
+
+    // Forgets the idle sockets, whose descriptors may not match the loaded ones.
+    void ResetReadiness();
+
     /// Cache interface info for the current session
     /// These two fields are not saved to savestates on purpose
     /// as network interfaces may change and it's better to.
@@ -173,6 +182,9 @@ private:
         ar& boost::serialization::base_object<Kernel::SessionRequestHandler>(*this);
         ar & created_sockets;
         ar & initialized_processes;
+        if (Archive::is_loading::value) {
+            ResetReadiness();
+        }
     }
     friend class boost::serialization::access;
 };
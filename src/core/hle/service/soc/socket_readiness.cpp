@@ -0,0 +1,174 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <vector>
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/hle/service/soc/socket_readiness.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#define GET_ERRNO WSAGetLastError()
+#define poll(x, y, z) WSAPoll(x, y, z);
+#else
+#define GET_ERRNO errno
+#define closesocket(x) close(x)
+#endif
+
+namespace Service::SOC {
+
+SocketReadiness::SocketReadiness() {
+    wake_fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    // A socket connected to itself, which wakes the thread up by sending it a datagram
+    if (wake_fd == InvalidSocket ||
+        ::bind(wake_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::getsockname(wake_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0 ||
+        ::connect(wake_fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0) {
+        LOG_WARNING(Service_SOC, "Could not create the socket readiness wake socket: {}",
+                    GET_ERRNO);
+        if (wake_fd != InvalidSocket) {
+            closesocket(wake_fd);
+        }
+        wake_fd = InvalidSocket;
+        return;
+    }
+    thread = std::thread(&SocketReadiness::WatchLoop, this);
+}
+
+SocketReadiness::~SocketReadiness() {
+    if (wake_fd == InvalidSocket) {
+        return;
+    }
+    stop = true;
+    wake_pending = false;
+    Wake();
+    thread.join();
+    closesocket(wake_fd);
+}
+
+u8 SocketReadiness::EventClasses(short events) {
+    if (events & (POLLPRI | POLLRDBAND | POLLWRBAND)) {
+        return 0;
+    }
+    u8 classes = 0;
+    if (events & (POLLIN | POLLRDNORM)) {
+        classes |= Readable;
+    }
+    if (events & (POLLOUT | POLLWRNORM)) {
+        classes |= Writable;
+    }
+    return classes;
+}
+
+u8 SocketReadiness::IdleClasses(short events, short revents) {
+    if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+        return 0;
+    }
+    u8 classes = EventClasses(events);
+    if (revents & (POLLIN | POLLRDNORM | POLLRDBAND | POLLPRI)) {
+        classes &= ~Readable;
+    }
+    if (revents & (POLLOUT | POLLWRNORM | POLLWRBAND)) {
+        classes &= ~Writable;
+    }
+    return classes;
+}
+
+u64 SocketReadiness::Sequence(SocketHolder::SOCKET fd) {
+    std::scoped_lock lock{mutex};
+    return entries[fd].sequence;
+}
+
+bool SocketReadiness::IsIdle(SocketHolder::SOCKET fd, u8 classes) {
+    std::scoped_lock lock{mutex};
+    const auto entry = entries.find(fd);
+    return classes != 0 && entry != entries.end() && (entry->second.idle & classes) == classes;
+}
+
+void SocketReadiness::MarkIdle(SocketHolder::SOCKET fd, u8 classes, u64 sequence) {
+    if (wake_fd == InvalidSocket || classes == 0) {
+        return;
+    }
+    std::scoped_lock lock{mutex};
+    const auto entry = entries.find(fd);
+    if (entry == entries.end() || entry->second.sequence != sequence ||
+        (entry->second.idle & classes) == classes) {
+        return;
+    }
+    entry->second.idle |= classes;
+    Wake();
+}
+
+void SocketReadiness::Forget(SocketHolder::SOCKET fd) {
+    std::scoped_lock lock{mutex};
+    entries.erase(fd);
+}
+
+void SocketReadiness::Clear() {
+    std::scoped_lock lock{mutex};
+    entries.clear();
+}
+
+void SocketReadiness::Wake() {
+    if (!wake_pending.exchange(true)) {
+        const char data = 0;
+        ::send(wake_fd, &data, sizeof(data), 0);
+    }
+}
+
+void SocketReadiness::WatchLoop() {
+    Common::SetCurrentThreadName("SocketReadiness");
+    std::vector<pollfd> fds;
+    while (!stop) {
+        fds.clear();
+        fds.push_back(pollfd{.fd = wake_fd, .events = POLLIN, .revents = 0});
+        {
+            std::scoped_lock lock{mutex};
+            for (const auto& [fd, entry] : entries) {
+                if (entry.idle != 0) {
+                    const short events =
+                        static_cast<short>((entry.idle & Readable ? POLLIN : 0) |
+                                           (entry.idle & Writable ? POLLOUT : 0));
+                    fds.push_back(pollfd{.fd = fd, .events = events, .revents = 0});
+                }
+            }
+        }
+
+        const int ret = ::poll(fds.data(), static_cast<u32>(fds.size()), -1);
+        if (ret <= 0) {
+            continue;
+        }
+        if (fds[0].revents & POLLIN) {
+            char data;
+            ::recv(wake_fd, &data, sizeof(data), 0);
+            wake_pending = false;
+        }
+
+        std::scoped_lock lock{mutex};
+        for (std::size_t i = 1; i < fds.size(); i++) {
+            const auto entry = entries.find(fds[i].fd);
+            if (fds[i].revents == 0 || entry == entries.end()) {
+                continue;
+            }
+            entry->second.idle &= IdleClasses(fds[i].events, fds[i].revents);
+            entry->second.sequence++;
+        }
+    }
+}
+
+} // namespace Service::SOC
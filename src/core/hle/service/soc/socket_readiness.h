@@ -0,0 +1,74 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "common/common_types.h"
+#include "core/hle/service/soc/soc_u.h"
+
+namespace Service::SOC {
+
+/**
+ * Tracks the sockets known to have nothing to read or no room to write, so that non-blocking
+ * polls and receives on them are answered without calling the host. A socket only becomes idle
+ * when a host call finds it so, and a thread waiting on all the idle sockets marks them ready
+ * again as soon as the host reports an event on them. Sockets not known to be idle always go to
+ * the host, so the cache can only delay readiness by the time the thread takes to wake up.
+ */
+class SocketReadiness {
+public:
+    static constexpr u8 Readable = 1 << 0;
+    static constexpr u8 Writable = 1 << 1;
+
+    SocketReadiness();
+    ~SocketReadiness();
+
+    /// Returns the readiness classes polled for by the events, or 0 if they are not cached.
+    static u8 EventClasses(short events);
+
+    /// Returns the classes of the polled events that the host did not report.
+    static u8 IdleClasses(short events, short revents);
+
+    /// Returns the count of events seen on the socket, to be taken before calling the host.
+    u64 Sequence(SocketHolder::SOCKET fd);
+
+    /// Returns whether the socket is known to be idle for all the classes.
+    bool IsIdle(SocketHolder::SOCKET fd, u8 classes);
+
+    /**
+     * Records that a host call found the socket idle for the classes, unless the thread saw an
+     * event on it after the sequence was taken.
+     */
+    void MarkIdle(SocketHolder::SOCKET fd, u8 classes, u64 sequence);
+
+    /// Forgets a socket before it is closed, or when it changes in ways that are not polled.
+    void Forget(SocketHolder::SOCKET fd);
+
+    void Clear();
+
+private:
+    static constexpr auto InvalidSocket = static_cast<SocketHolder::SOCKET>(-1);
+
+    struct Entry {
+        u8 idle = 0;      ///< Classes the socket was found idle for, with no event since
+        u64 sequence = 0; ///< Count of the times the thread saw events on the socket
+    };
+
+    void Wake();
+
+    void WatchLoop();
+
+    std::mutex mutex;
+    std::unordered_map<SocketHolder::SOCKET, Entry> entries;
+    SocketHolder::SOCKET wake_fd = InvalidSocket;
+    std::atomic_bool wake_pending = false;
+    std::atomic_bool stop = false;
+    std::thread thread;
+};
+
+} // namespace Service::SOC
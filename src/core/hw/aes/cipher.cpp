@@ -0,0 +1,68 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cryptopp/aes.h>
+#include <cryptopp/modes.h>
+#include "common/arch.h"
+#include "common/assert.h"
+#include "core/hw/aes/cipher.h"
+
+#if CITRA_ARCH(x86_64)
+#include "common/x64/cpu_detect.h"
+#elif CITRA_ARCH(arm64)
+#include "common/aarch64/cpu_detect.h"
+#endif
+
+namespace HW::AES {
+
+bool IsHostAESAccelerated() {
+#if CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
+    // Crypto++ dispatches to AES-NI or the ARMv8 crypto extensions at runtime when present.
+    return Common::GetCPUCaps().aes;
+#else
+    return false;
+#endif
+}
+
+void TransformCTR(std::span<const u8> input, std::span<u8> output, const AESKey& key,
+                  const AESKey& ctr, u64 offset) {
+    ASSERT(output.size() >= input.size());
+    if (input.empty()) {
+        return; // Crypto++ does not like zero size buffer
+    }
+    CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption d(key.data(), key.size(), ctr.data());
+    if (offset != 0) {
+        d.Seek(offset);
+    }
+    d.ProcessData(output.data(), input.data(), input.size());
+}
+
+struct CBCDecryptor::Impl {
+    CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption d;
+};
+
+CBCDecryptor::CBCDecryptor() : impl(std::make_unique<Impl>()) {}
+
+CBCDecryptor::CBCDecryptor(const AESKey& key, const AESKey& iv) : CBCDecryptor() {
+    SetKeyWithIV(key, iv);
+}
+
+CBCDecryptor::~CBCDecryptor() = default;
+
+CBCDecryptor::CBCDecryptor(CBCDecryptor&&) noexcept = default;
+CBCDecryptor& CBCDecryptor::operator=(CBCDecryptor&&) noexcept = default;
+
+void CBCDecryptor::SetKeyWithIV(const AESKey& key, const AESKey& iv) {
+    impl->d.SetKeyWithIV(key.data(), key.size(), iv.data());
+}
+
+void CBCDecryptor::Process(std::span<u8> data) {
+    DEBUG_ASSERT(data.size() % AES_BLOCK_SIZE == 0);
+    if (data.empty()) {
+        return;
+    }
+    impl->d.ProcessData(data.data(), data.data(), data.size());
+}
+
+} // namespace HW::AES
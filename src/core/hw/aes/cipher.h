@@ -0,0 +1,53 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include "common/common_types.h"
+#include "core/hw/aes/key.h"
+
+namespace HW::AES {
+
+/// Returns whether the host CPU has AES instructions that the ciphers below can use.
+bool IsHostAESAccelerated();
+
+/**
+ * Encrypts or decrypts a span of data with AES-CTR, which is the same operation in both
+ * directions. Callers should pass spans as large as they have available, as the whole span is
+ * processed in a single pass over the key stream.
+ * @param input The data to transform
+ * @param output Where the result is written. May alias input, and must be at least as large
+ * @param key The normal key to use
+ * @param ctr The initial counter of the key stream
+ * @param offset Position in bytes of the first byte of input within the key stream
+ */
+void TransformCTR(std::span<const u8> input, std::span<u8> output, const AESKey& key,
+                  const AESKey& ctr, u64 offset = 0);
+
+/**
+ * AES-CBC decryptor that keeps its chaining state between calls, for data that is received in
+ * pieces. Every piece must be a multiple of the AES block size.
+ */
+class CBCDecryptor {
+public:
+    CBCDecryptor();
+    CBCDecryptor(const AESKey& key, const AESKey& iv);
+    ~CBCDecryptor();
+
+    CBCDecryptor(CBCDecryptor&&) noexcept;
+    CBCDecryptor& operator=(CBCDecryptor&&) noexcept;
+
+    void SetKeyWithIV(const AESKey& key, const AESKey& iv);
+
+    /// Decrypts the data in place, continuing from the end of the previous call.
+    void Process(std::span<u8> data);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace HW::AES
@@ -161,6 +161,7 @@ MovableSedFull& GetMovableSed();
 
 enum class UniqueCryptoFileID {
     NCCH = 0,
+    ArticCache = 1,
 };
 
 void InvalidateSecureData();
@@ -51,8 +51,13 @@ Apploader_Artic::Apploader_Artic(Core::System& system_, const std::string& serve
         system_.SetStatus(Core::System::ResultStatus::ErrorArticDisconnected,
                           msg.empty() ? nullptr : msg.c_str());
     });
+    client->SetCompressionRequested(Settings::values.use_artic_compression.GetValue());
     client->SetArticReportTrafficCallback(
         [&system_](u32 bytes) { system_.ReportArticTraffic(bytes); });
+    client->SetArticReportLatencyCallback(
+        [&system_](u32 count, std::chrono::microseconds latency) {
+            system_.ReportArticRequests(count, latency);
+        });
     client->SetReportArticEventCallback([&system_](u64 event) {
         Core::PerfStats::PerfArticEventBits ev =
             static_cast<Core::PerfStats::PerfArticEventBits>(event & 0xFFFFFFFF);
@@ -776,12 +781,18 @@ ResultStatus Apploader_Artic::ReadExtdataId(u64& out_extdata_id) {
 }
 
 ResultStatus Apploader_Artic::ReadRomFS(std::shared_ptr<FileSys::RomFSReader>& romfs_file) {
-    main_romfs_reader = romfs_file = std::make_shared<FileSys::ArticRomFSReader>(client, false);
+    u64 program_id = 0;
+    ReadProgramId(program_id);
+    main_romfs_reader = romfs_file =
+        std::make_shared<FileSys::ArticRomFSReader>(client, false, program_id);
     return static_cast<FileSys::ArticRomFSReader*>(romfs_file.get())->OpenStatus();
 }
 
 ResultStatus Apploader_Artic::ReadUpdateRomFS(std::shared_ptr<FileSys::RomFSReader>& romfs_file) {
-    update_romfs_reader = romfs_file = std::make_shared<FileSys::ArticRomFSReader>(client, true);
+    u64 program_id = 0;
+    ReadProgramId(program_id);
+    update_romfs_reader = romfs_file =
+        std::make_shared<FileSys::ArticRomFSReader>(client, true, program_id);
     return static_cast<FileSys::ArticRomFSReader*>(romfs_file.get())->OpenStatus();
 }
 
@@ -6,6 +6,7 @@
 #include <string>
 #include "common/logging/log.h"
 #include "common/string_util.h"
+#include "common/zstd_seekable_file.h"
 #include "core/core.h"
 #include "core/hle/kernel/process.h"
 #include "core/loader/3dsx.h"
@@ -16,6 +17,14 @@
 namespace Loader {
 
 FileType IdentifyFile(FileUtil::IOFile& file) {
+    if (Common::Compression::IsSeekableZstdFile(file)) {
+        // Only NCCH containers open their image again through OpenImageFile, the other loaders
+        // read the raw file they are given.
+        Common::Compression::SeekableZstdIOFile image(file.Filename());
+        const FileType type = AppLoader_NCCH::IdentifyType(image);
+        return type == FileType::Error ? FileType::Unknown : type;
+    }
+
     FileType type;
 
 #define CHECK_TYPE(loader)                                                                         \
@@ -48,16 +57,16 @@ FileType GuessFromExtension(const std::string& extension_) {
     if (extension == ".elf" || extension == ".axf")
         return FileType::ELF;
 
-    if (extension == ".cci")
+    if (extension == ".cci" || extension == ".zcci")
         return FileType::CCI;
 
-    if (extension == ".cxi" || extension == ".app")
+    if (extension == ".cxi" || extension == ".app" || extension == ".zcxi")
         return FileType::CXI;
 
     if (extension == ".3dsx")
         return FileType::THREEDSX;
 
-    if (extension == ".cia")
+    if (extension == ".cia" || extension == ".zcia")
         return FileType::CIA;
 
     return FileType::Unknown;
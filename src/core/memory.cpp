@@ -11,6 +11,7 @@
 #include "common/assert.h"
 #include "common/atomic_ops.h"
 #include "common/common_types.h"
+#include "common/host_memory.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "common/swap.h"
@@ -88,9 +89,14 @@ class MemorySystem::Impl {
 public:
     // Visual Studio would try to allocate these on compile time
     // if they are std::array which would exceed the memory limit.
-    std::unique_ptr<u8[]> fcram = std::make_unique<u8[]>(Memory::FCRAM_N3DS_SIZE);
-    std::unique_ptr<u8[]> vram = std::make_unique<u8[]>(Memory::VRAM_SIZE);
-    std::unique_ptr<u8[]> n3ds_extra_ram = std::make_unique<u8[]>(Memory::N3DS_EXTRA_RAM_SIZE);
+    // They are mapped directly so they can be backed by huge pages, which takes TLB pressure off
+    // fastmem and GetPointer while games stream textures.
+    Common::HostMemoryPtr fcram = Common::AllocateHostMemory(
+        Memory::FCRAM_N3DS_SIZE, Settings::values.use_huge_pages.GetValue());
+    Common::HostMemoryPtr vram =
+        Common::AllocateHostMemory(Memory::VRAM_SIZE, Settings::values.use_huge_pages.GetValue());
+    Common::HostMemoryPtr n3ds_extra_ram = Common::AllocateHostMemory(
+        Memory::N3DS_EXTRA_RAM_SIZE, Settings::values.use_huge_pages.GetValue());
 
     Core::System& system;
     std::shared_ptr<PageTable> current_page_table = nullptr;
@@ -99,6 +105,16 @@ public:
 
     AudioCore::DspInterface* dsp = nullptr;
 
+    /// Whether serialize writes the contents of the regions returned by GetSerializedRam.
+    bool serialize_ram = true;
+
+    /// Upper bound of the deferred invalidations kept before they are handed over regardless.
+    static constexpr std::size_t MaxPendingInvalidations = 256;
+    /// Physical intervals invalidated by the CPU that the rasterizer hasn't processed yet.
+    std::vector<std::pair<PAddr, PAddr>> pending_invalidations;
+    /// The intervals being handed over, as the GPU flushes pending invalidations itself.
+    std::vector<std::pair<PAddr, PAddr>> flushing_invalidations;
+
     std::shared_ptr<BackingMem> fcram_mem;
     std::shared_ptr<BackingMem> vram_mem;
     std::shared_ptr<BackingMem> n3ds_extra_ram_mem;
@@ -155,102 +171,150 @@ public:
         return system.GetRunningCore().GetPC();
     }
 
-    template <bool UNSAFE>
-    void ReadBlockImpl(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
-                       const std::size_t size) {
-        auto& page_table = *process.vm_manager.page_table;
+    /// Returns the physical address of the 3GX plugin framebuffer, or 0 if none is mapped.
+    PAddr GetPluginFBAddr() {
+        auto plg_ldr = Service::PLGLDR::GetService(system);
+        return plg_ldr ? plg_ldr->GetPluginFBAddr() : 0;
+    }
+
+    RasterizerVAddrList PhysicalToVirtualAddressForRasterizer(PAddr addr, PAddr plugin_fb_addr) {
+        if (addr >= VRAM_PADDR && addr < VRAM_PADDR_END) {
+            return {addr - VRAM_PADDR + VRAM_VADDR};
+        }
+        // NOTE: Order matters here.
+        if (plugin_fb_addr && addr >= plugin_fb_addr &&
+            addr < plugin_fb_addr + PLUGIN_3GX_FB_SIZE) {
+            return {addr - plugin_fb_addr + PLUGIN_3GX_FB_VADDR};
+        }
+        if (addr >= FCRAM_PADDR && addr < FCRAM_PADDR_END) {
+            return {addr - FCRAM_PADDR + LINEAR_HEAP_VADDR,
+                    addr - FCRAM_PADDR + NEW_LINEAR_HEAP_VADDR};
+        }
+        if (addr >= FCRAM_PADDR_END && addr < FCRAM_N3DS_PADDR_END) {
+            return {addr - FCRAM_PADDR + NEW_LINEAR_HEAP_VADDR};
+        }
+        // While the physical <-> virtual mapping is 1:1 for the regions supported by the cache,
+        // some games (like Pokemon Super Mystery Dungeon) will try to use textures that go beyond
+        // the end address of VRAM, causing the Virtual->Physical translation to fail when flushing
+        // parts of the texture.
+        LOG_ERROR(HW_Memory,
+                  "Trying to use invalid physical address for rasterizer: {:08X} at PC 0x{:08X}",
+                  addr, GetPC());
+        return {};
+    }
+
+    /// Returns the host pointer backing the page for block operations, null for unmapped pages.
+    u8* GetBlockPointer(PageTable& page_table, PageType type, std::size_t page_index,
+                        std::size_t page_offset) {
+        switch (type) {
+        case PageType::Unmapped:
+            return nullptr;
+        case PageType::Memory:
+            DEBUG_ASSERT(page_table.pointers[page_index]);
+            return page_table.pointers[page_index] + page_offset;
+        case PageType::RasterizerCachedMemory:
+            return GetPointerForRasterizerCache(
+                       static_cast<VAddr>((page_index << CITRA_PAGE_BITS) + page_offset))
+                .GetPtr();
+        default:
+            UNREACHABLE();
+        }
+        return nullptr;
+    }
 
+    /**
+     * Splits [addr, addr + size) into spans of consecutive pages that share their page type and
+     * are backed by contiguous host memory, so block operations handle each span with a single
+     * copy and at most one rasterizer flush instead of once per page.
+     * @param func Called as func(type, span_vaddr, span_pointer, span_size), span_pointer is null
+     *             for unmapped spans
+     */
+    template <typename Func>
+    void WalkBlock(PageTable& page_table, const VAddr addr, const std::size_t size,
+                   Func&& func) {
         std::size_t remaining_size = size;
-        std::size_t page_index = src_addr >> CITRA_PAGE_BITS;
-        std::size_t page_offset = src_addr & CITRA_PAGE_MASK;
+        std::size_t page_index = addr >> CITRA_PAGE_BITS;
+        std::size_t page_offset = addr & CITRA_PAGE_MASK;
 
         while (remaining_size > 0) {
-            const std::size_t copy_amount = std::min(CITRA_PAGE_SIZE - page_offset, remaining_size);
-            const VAddr current_vaddr =
+            const PageType type = page_table.attributes[page_index];
+            const VAddr span_vaddr =
                 static_cast<VAddr>((page_index << CITRA_PAGE_BITS) + page_offset);
+            u8* const span_pointer = GetBlockPointer(page_table, type, page_index, page_offset);
+            std::size_t span_size = std::min(CITRA_PAGE_SIZE - page_offset, remaining_size);
+            remaining_size -= span_size;
+            page_index++;
 
-            switch (page_table.attributes[page_index]) {
-            case PageType::Unmapped: {
-                LOG_ERROR(
-                    HW_Memory,
-                    "unmapped ReadBlock @ 0x{:08X} (start address = 0x{:08X}, size = {}) at PC "
-                    "0x{:08X}",
-                    current_vaddr, src_addr, size, GetPC());
-                std::memset(dest_buffer, 0, copy_amount);
-                break;
+            while (remaining_size > 0 && page_table.attributes[page_index] == type &&
+                   GetBlockPointer(page_table, type, page_index, 0) ==
+                       (span_pointer ? span_pointer + span_size : nullptr)) {
+                const std::size_t copy_amount =
+                    std::min<std::size_t>(CITRA_PAGE_SIZE, remaining_size);
+                span_size += copy_amount;
+                remaining_size -= copy_amount;
+                page_index++;
             }
-            case PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
 
-                const u8* src_ptr = page_table.pointers[page_index] + page_offset;
-                std::memcpy(dest_buffer, src_ptr, copy_amount);
-                break;
-            }
-            case PageType::RasterizerCachedMemory: {
-                if constexpr (!UNSAFE) {
-                    RasterizerFlushVirtualRegion(current_vaddr, static_cast<u32>(copy_amount),
-                                                 FlushMode::Flush);
-                }
-                std::memcpy(dest_buffer, GetPointerForRasterizerCache(current_vaddr), copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
+            func(type, span_vaddr, span_pointer, span_size);
             page_offset = 0;
-            dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
-            remaining_size -= copy_amount;
         }
     }
 
+    template <bool UNSAFE>
+    void ReadBlockImpl(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
+                       const std::size_t size) {
+        WalkBlock(*process.vm_manager.page_table, src_addr, size,
+                  [&](PageType type, VAddr span_vaddr, const u8* src_ptr, std::size_t span_size) {
+                      switch (type) {
+                      case PageType::Unmapped:
+                          LOG_ERROR(HW_Memory,
+                                    "unmapped ReadBlock @ 0x{:08X} (start address = 0x{:08X}, "
+                                    "size = {}) at PC 0x{:08X}",
+                                    span_vaddr, src_addr, size, GetPC());
+                          std::memset(dest_buffer, 0, span_size);
+                          break;
+                      case PageType::RasterizerCachedMemory:
+                          if constexpr (!UNSAFE) {
+                              RasterizerFlushVirtualRegion(
+                                  span_vaddr, static_cast<u32>(span_size), FlushMode::Flush);
+                          }
+                          [[fallthrough]];
+                      case PageType::Memory:
+                          std::memcpy(dest_buffer, src_ptr, span_size);
+                          break;
+                      default:
+                          UNREACHABLE();
+                      }
+                      dest_buffer = static_cast<u8*>(dest_buffer) + span_size;
+                  });
+    }
+
     template <bool UNSAFE>
     void WriteBlockImpl(const Kernel::Process& process, const VAddr dest_addr,
                         const void* src_buffer, const std::size_t size) {
-        auto& page_table = *process.vm_manager.page_table;
-        std::size_t remaining_size = size;
-        std::size_t page_index = dest_addr >> CITRA_PAGE_BITS;
-        std::size_t page_offset = dest_addr & CITRA_PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount = std::min(CITRA_PAGE_SIZE - page_offset, remaining_size);
-            const VAddr current_vaddr =
-                static_cast<VAddr>((page_index << CITRA_PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case PageType::Unmapped: {
-                LOG_ERROR(
-                    HW_Memory,
-                    "unmapped WriteBlock @ 0x{:08X} (start address = 0x{:08X}, size = {}) at PC "
-                    "0x{:08X}",
-                    current_vaddr, dest_addr, size, GetPC());
-                break;
-            }
-            case PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
-
-                u8* dest_ptr = page_table.pointers[page_index] + page_offset;
-                std::memcpy(dest_ptr, src_buffer, copy_amount);
-                break;
-            }
-            case PageType::RasterizerCachedMemory: {
-                if constexpr (!UNSAFE) {
-                    RasterizerFlushVirtualRegion(current_vaddr, static_cast<u32>(copy_amount),
-                                                 FlushMode::Invalidate);
-                }
-                std::memcpy(GetPointerForRasterizerCache(current_vaddr), src_buffer, copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
-            remaining_size -= copy_amount;
-        }
+        WalkBlock(*process.vm_manager.page_table, dest_addr, size,
+                  [&](PageType type, VAddr span_vaddr, u8* dest_ptr, std::size_t span_size) {
+                      switch (type) {
+                      case PageType::Unmapped:
+                          LOG_ERROR(HW_Memory,
+                                    "unmapped WriteBlock @ 0x{:08X} (start address = 0x{:08X}, "
+                                    "size = {}) at PC 0x{:08X}",
+                                    span_vaddr, dest_addr, size, GetPC());
+                          break;
+                      case PageType::RasterizerCachedMemory:
+                          if constexpr (!UNSAFE) {
+                              RasterizerFlushVirtualRegion(
+                                  span_vaddr, static_cast<u32>(span_size), FlushMode::Invalidate);
+                          }
+                          [[fallthrough]];
+                      case PageType::Memory:
+                          std::memcpy(dest_ptr, src_buffer, span_size);
+                          break;
+                      default:
+                          UNREACHABLE();
+                      }
+                      src_buffer = static_cast<const u8*>(src_buffer) + span_size;
+                  });
     }
 
     MemoryRef GetPointerForRasterizerCache(VAddr addr) const {
@@ -275,6 +339,26 @@ public:
         return MemoryRef{};
     }
 
+    void FlushPendingInvalidations() {
+        if (pending_invalidations.empty()) {
+            return;
+        }
+
+        flushing_invalidations.swap(pending_invalidations);
+        std::sort(flushing_invalidations.begin(), flushing_invalidations.end());
+        auto& gpu = system.GPU();
+        auto [start, end] = flushing_invalidations.front();
+        for (const auto& [interval_start, interval_end] : flushing_invalidations) {
+            if (interval_start > end) {
+                gpu.InvalidateRegion(start, end - start);
+                start = interval_start;
+            }
+            end = std::max(end, interval_end);
+        }
+        gpu.InvalidateRegion(start, end - start);
+        flushing_invalidations.clear();
+    }
+
     void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode) {
         const VAddr end = start + size;
 
@@ -284,22 +368,33 @@ public:
                 return;
             }
 
-            auto& renderer = system.GPU().Renderer();
+            auto& gpu = system.GPU();
             VAddr overlap_start = std::max(start, region_start);
             VAddr overlap_end = std::min(end, region_end);
             PAddr physical_start = paddr_region_start + (overlap_start - region_start);
             u32 overlap_size = overlap_end - overlap_start;
 
-            auto* rasterizer = renderer.Rasterizer();
+            if (mode == FlushMode::Invalidate &&
+                overlap_size > VideoCore::RasterizerInterface::MaxFlushingInvalidationSize) {
+                // These only mark surfaces invalid, so consecutive CPU writes can be merged and
+                // handed over once before the rasterizer is used next.
+                pending_invalidations.emplace_back(physical_start, physical_start + overlap_size);
+                if (pending_invalidations.size() >= MaxPendingInvalidations) {
+                    FlushPendingInvalidations();
+                }
+                return;
+            }
+
+            FlushPendingInvalidations();
             switch (mode) {
             case FlushMode::Flush:
-                rasterizer->FlushRegion(physical_start, overlap_size);
+                gpu.FlushRegion(physical_start, overlap_size);
                 break;
             case FlushMode::Invalidate:
-                rasterizer->InvalidateRegion(physical_start, overlap_size);
+                gpu.InvalidateRegion(physical_start, overlap_size);
                 break;
             case FlushMode::FlushAndInvalidate:
-                rasterizer->FlushAndInvalidateRegion(physical_start, overlap_size);
+                gpu.FlushAndInvalidateRegion(physical_start, overlap_size);
                 break;
             }
         };
@@ -313,17 +408,25 @@ public:
         }
     }
 
+    std::array<std::span<u8>, 3> GetSerializedRam(bool n3ds_ram) {
+        return {
+            std::span{vram.get(), Memory::VRAM_SIZE},
+            std::span{fcram.get(), n3ds_ram ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE},
+            std::span{n3ds_extra_ram.get(), n3ds_ram ? Memory::N3DS_EXTRA_RAM_SIZE : 0},
+        };
+    }
+
 private:
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int file_version) {
         bool save_n3ds_ram = Settings::values.is_new_3ds.GetValue();
         ar & save_n3ds_ram;
-        ar& boost::serialization::make_binary_object(vram.get(), Memory::VRAM_SIZE);
-        ar& boost::serialization::make_binary_object(
-            fcram.get(), save_n3ds_ram ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE);
-        ar& boost::serialization::make_binary_object(
-            n3ds_extra_ram.get(), save_n3ds_ram ? Memory::N3DS_EXTRA_RAM_SIZE : 0);
+        if (serialize_ram) {
+            for (const auto region : GetSerializedRam(save_n3ds_ram)) {
+                ar& boost::serialization::make_binary_object(region.data(), region.size());
+            }
+        }
         ar & cache_marker;
         ar & page_table_list;
         // dsp is set from Core::System at startup
@@ -382,6 +485,14 @@ void MemorySystem::SetCurrentPageTable(std::shared_ptr<PageTable> page_table) {
     impl->current_page_table = page_table;
 }
 
+std::array<std::span<u8>, 3> MemorySystem::GetSerializedRam() {
+    return impl->GetSerializedRam(Settings::values.is_new_3ds.GetValue());
+}
+
+void MemorySystem::SetSerializeRam(bool serialize) {
+    impl->serialize_ram = serialize;
+}
+
 std::shared_ptr<PageTable> MemorySystem::GetCurrentPageTable() const {
     return impl->current_page_table;
 }
@@ -390,6 +501,10 @@ void MemorySystem::RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode
     impl->RasterizerFlushVirtualRegion(start, size, mode);
 }
 
+void MemorySystem::FlushPendingRasterizerInvalidations() {
+    impl->FlushPendingInvalidations();
+}
+
 void MemorySystem::MapPages(PageTable& page_table, u32 base, u32 size, MemoryRef memory,
                             PageType type) {
     LOG_DEBUG(HW_Memory, "Mapping {} onto {:08X}-{:08X}", (void*)memory.GetPtr(),
@@ -542,13 +657,21 @@ void MemorySystem::Write(const std::shared_ptr<PageTable>& page_table, const VAd
 }
 
 template <typename T>
-bool MemorySystem::WriteExclusive(const VAddr vaddr, const T data, const T expected) {
-    u8* page_pointer = impl->current_page_table->pointers[vaddr >> CITRA_PAGE_BITS];
+std::optional<bool> MemorySystem::WriteExclusive(PageTable& page_table, const VAddr vaddr,
+                                                 const T data, const T expected) {
+    u8* page_pointer = page_table.pointers[vaddr >> CITRA_PAGE_BITS];
+    if (!page_pointer) {
+        return std::nullopt;
+    }
+    const auto volatile_pointer =
+        reinterpret_cast<volatile T*>(&page_pointer[vaddr & CITRA_PAGE_MASK]);
+    return Common::AtomicCompareAndSwap(volatile_pointer, data, expected);
+}
 
-    if (page_pointer) {
-        const auto volatile_pointer =
-            reinterpret_cast<volatile T*>(&page_pointer[vaddr & CITRA_PAGE_MASK]);
-        return Common::AtomicCompareAndSwap(volatile_pointer, data, expected);
+template <typename T>
+bool MemorySystem::WriteExclusive(const VAddr vaddr, const T data, const T expected) {
+    if (const auto result = WriteExclusive(*impl->current_page_table, vaddr, data, expected)) {
+        return *result;
     }
 
     PageType type = impl->current_page_table->attributes[vaddr >> CITRA_PAGE_BITS];
@@ -695,32 +818,8 @@ MemoryRef MemorySystem::GetPhysicalRef(PAddr address) {
     return physical_ptr_cache.second;
 }
 
-std::vector<VAddr> MemorySystem::PhysicalToVirtualAddressForRasterizer(PAddr addr) {
-    if (addr >= VRAM_PADDR && addr < VRAM_PADDR_END) {
-        return {addr - VRAM_PADDR + VRAM_VADDR};
-    }
-    // NOTE: Order matters here.
-    auto plg_ldr = Service::PLGLDR::GetService(impl->system);
-    if (plg_ldr) {
-        auto fb_addr = plg_ldr->GetPluginFBAddr();
-        if (addr >= fb_addr && addr < fb_addr + PLUGIN_3GX_FB_SIZE) {
-            return {addr - fb_addr + PLUGIN_3GX_FB_VADDR};
-        }
-    }
-    if (addr >= FCRAM_PADDR && addr < FCRAM_PADDR_END) {
-        return {addr - FCRAM_PADDR + LINEAR_HEAP_VADDR, addr - FCRAM_PADDR + NEW_LINEAR_HEAP_VADDR};
-    }
-    if (addr >= FCRAM_PADDR_END && addr < FCRAM_N3DS_PADDR_END) {
-        return {addr - FCRAM_PADDR + NEW_LINEAR_HEAP_VADDR};
-    }
-    // While the physical <-> virtual mapping is 1:1 for the regions supported by the cache,
-    // some games (like Pokemon Super Mystery Dungeon) will try to use textures that go beyond
-    // the end address of VRAM, causing the Virtual->Physical translation to fail when flushing
-    // parts of the texture.
-    LOG_ERROR(HW_Memory,
-              "Trying to use invalid physical address for rasterizer: {:08X} at PC 0x{:08X}", addr,
-              impl->GetPC());
-    return {};
+RasterizerVAddrList MemorySystem::PhysicalToVirtualAddressForRasterizer(PAddr addr) {
+    return impl->PhysicalToVirtualAddressForRasterizer(addr, impl->GetPluginFBAddr());
 }
 
 void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached) {
@@ -730,9 +829,10 @@ void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached
 
     u32 num_pages = ((start + size - 1) >> CITRA_PAGE_BITS) - (start >> CITRA_PAGE_BITS) + 1;
     PAddr paddr = start;
+    const PAddr plugin_fb_addr = impl->GetPluginFBAddr();
 
     for (unsigned i = 0; i < num_pages; ++i, paddr += CITRA_PAGE_SIZE) {
-        for (VAddr vaddr : PhysicalToVirtualAddressForRasterizer(paddr)) {
+        for (VAddr vaddr : impl->PhysicalToVirtualAddressForRasterizer(paddr, plugin_fb_addr)) {
             impl->cache_marker.Mark(vaddr, cached);
             for (auto& page_table : impl->page_table_list) {
                 PageType& page_type = page_table->attributes[vaddr >> CITRA_PAGE_BITS];
@@ -805,6 +905,24 @@ u64 MemorySystem::Read64(const Kernel::Process& process, VAddr addr) {
     return Read<u64_le>(process.vm_manager.page_table, addr);
 }
 
+u8* MemorySystem::GetContiguousPointer(const Kernel::Process& process, const VAddr vaddr,
+                                         const std::size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+    u8* pointer = nullptr;
+    bool contiguous = true;
+    impl->WalkBlock(*process.vm_manager.page_table, vaddr, size,
+                    [&](PageType type, VAddr, u8* span_pointer, std::size_t span_size) {
+                        if (type != PageType::Memory || span_size != size) {
+                            contiguous = false;
+                            return;
+                        }
+                        pointer = span_pointer;
+                    });
+    return contiguous ? pointer : nullptr;
+}
+
 void MemorySystem::ReadBlock(const Kernel::Process& process, const VAddr src_addr,
                              void* dest_buffer, const std::size_t size) {
     return impl->ReadBlockImpl<false>(process, src_addr, dest_buffer, size);
@@ -863,6 +981,26 @@ bool MemorySystem::WriteExclusive64(const VAddr addr, const u64 data, const u64
     return WriteExclusive<u64_le>(addr, data, expected);
 }
 
+std::optional<bool> MemorySystem::WriteExclusive8(PageTable& page_table, const VAddr addr,
+                                                  const u8 data, const u8 expected) {
+    return WriteExclusive<u8>(page_table, addr, data, expected);
+}
+
+std::optional<bool> MemorySystem::WriteExclusive16(PageTable& page_table, const VAddr addr,
+                                                   const u16 data, const u16 expected) {
+    return WriteExclusive<u16_le>(page_table, addr, data, expected);
+}
+
+std::optional<bool> MemorySystem::WriteExclusive32(PageTable& page_table, const VAddr addr,
+                                                   const u32 data, const u32 expected) {
+    return WriteExclusive<u32_le>(page_table, addr, data, expected);
+}
+
+std::optional<bool> MemorySystem::WriteExclusive64(PageTable& page_table, const VAddr addr,
+                                                   const u64 data, const u64 expected) {
+    return WriteExclusive<u64_le>(page_table, addr, data, expected);
+}
+
 void MemorySystem::WriteBlock(const Kernel::Process& process, const VAddr dest_addr,
                               const void* src_buffer, const std::size_t size) {
     return impl->WriteBlockImpl<false>(process, dest_addr, src_buffer, size);
@@ -876,45 +1014,26 @@ void MemorySystem::WriteBlock(const VAddr dest_addr, const void* src_buffer,
 
 void MemorySystem::ZeroBlock(const Kernel::Process& process, const VAddr dest_addr,
                              const std::size_t size) {
-    auto& page_table = *process.vm_manager.page_table;
-    std::size_t remaining_size = size;
-    std::size_t page_index = dest_addr >> CITRA_PAGE_BITS;
-    std::size_t page_offset = dest_addr & CITRA_PAGE_MASK;
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount = std::min(CITRA_PAGE_SIZE - page_offset, remaining_size);
-        const VAddr current_vaddr =
-            static_cast<VAddr>((page_index << CITRA_PAGE_BITS) + page_offset);
-
-        switch (page_table.attributes[page_index]) {
-        case PageType::Unmapped: {
-            LOG_ERROR(HW_Memory,
-                      "unmapped ZeroBlock @ 0x{:08X} (start address = 0x{:08X}, size = {}) at PC "
-                      "0x{:08X}",
-                      current_vaddr, dest_addr, size, impl->GetPC());
-            break;
-        }
-        case PageType::Memory: {
-            DEBUG_ASSERT(page_table.pointers[page_index]);
-
-            u8* dest_ptr = page_table.pointers[page_index] + page_offset;
-            std::memset(dest_ptr, 0, copy_amount);
-            break;
-        }
-        case PageType::RasterizerCachedMemory: {
-            RasterizerFlushVirtualRegion(current_vaddr, static_cast<u32>(copy_amount),
-                                         FlushMode::Invalidate);
-            std::memset(GetPointerForRasterizerCache(current_vaddr), 0, copy_amount);
-            break;
-        }
-        default:
-            UNREACHABLE();
-        }
-
-        page_index++;
-        page_offset = 0;
-        remaining_size -= copy_amount;
-    }
+    impl->WalkBlock(*process.vm_manager.page_table, dest_addr, size,
+                    [&](PageType type, VAddr span_vaddr, u8* dest_ptr, std::size_t span_size) {
+                        switch (type) {
+                        case PageType::Unmapped:
+                            LOG_ERROR(HW_Memory,
+                                      "unmapped ZeroBlock @ 0x{:08X} (start address = 0x{:08X}, "
+                                      "size = {}) at PC 0x{:08X}",
+                                      span_vaddr, dest_addr, size, impl->GetPC());
+                            break;
+                        case PageType::RasterizerCachedMemory:
+                            RasterizerFlushVirtualRegion(span_vaddr, static_cast<u32>(span_size),
+                                                         FlushMode::Invalidate);
+                            [[fallthrough]];
+                        case PageType::Memory:
+                            std::memset(dest_ptr, 0, span_size);
+                            break;
+                        default:
+                            UNREACHABLE();
+                        }
+                    });
 }
 
 void MemorySystem::CopyBlock(const Kernel::Process& process, VAddr dest_addr, VAddr src_addr,
@@ -925,48 +1044,29 @@ void MemorySystem::CopyBlock(const Kernel::Process& process, VAddr dest_addr, VA
 void MemorySystem::CopyBlock(const Kernel::Process& dest_process,
                              const Kernel::Process& src_process, VAddr dest_addr, VAddr src_addr,
                              std::size_t size) {
-    auto& page_table = *src_process.vm_manager.page_table;
-    std::size_t remaining_size = size;
-    std::size_t page_index = src_addr >> CITRA_PAGE_BITS;
-    std::size_t page_offset = src_addr & CITRA_PAGE_MASK;
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount = std::min(CITRA_PAGE_SIZE - page_offset, remaining_size);
-        const VAddr current_vaddr =
-            static_cast<VAddr>((page_index << CITRA_PAGE_BITS) + page_offset);
-
-        switch (page_table.attributes[page_index]) {
-        case PageType::Unmapped: {
-            LOG_ERROR(HW_Memory,
-                      "unmapped CopyBlock @ 0x{:08X} (start address = 0x{:08X}, size = {}) at PC "
-                      "0x{:08X}",
-                      current_vaddr, src_addr, size, impl->GetPC());
-            ZeroBlock(dest_process, dest_addr, copy_amount);
-            break;
-        }
-        case PageType::Memory: {
-            DEBUG_ASSERT(page_table.pointers[page_index]);
-            const u8* src_ptr = page_table.pointers[page_index] + page_offset;
-            WriteBlock(dest_process, dest_addr, src_ptr, copy_amount);
-            break;
-        }
-        case PageType::RasterizerCachedMemory: {
-            RasterizerFlushVirtualRegion(current_vaddr, static_cast<u32>(copy_amount),
-                                         FlushMode::Flush);
-            WriteBlock(dest_process, dest_addr, GetPointerForRasterizerCache(current_vaddr),
-                       copy_amount);
-            break;
-        }
-        default:
-            UNREACHABLE();
-        }
-
-        page_index++;
-        page_offset = 0;
-        dest_addr += static_cast<VAddr>(copy_amount);
-        src_addr += static_cast<VAddr>(copy_amount);
-        remaining_size -= copy_amount;
-    }
+    impl->WalkBlock(
+        *src_process.vm_manager.page_table, src_addr, size,
+        [&](PageType type, VAddr span_vaddr, const u8* src_ptr, std::size_t span_size) {
+            switch (type) {
+            case PageType::Unmapped:
+                LOG_ERROR(HW_Memory,
+                          "unmapped CopyBlock @ 0x{:08X} (start address = 0x{:08X}, size = {}) at "
+                          "PC 0x{:08X}",
+                          span_vaddr, src_addr, size, impl->GetPC());
+                ZeroBlock(dest_process, dest_addr, span_size);
+                break;
+            case PageType::RasterizerCachedMemory:
+                RasterizerFlushVirtualRegion(span_vaddr, static_cast<u32>(span_size),
+                                             FlushMode::Flush);
+                [[fallthrough]];
+            case PageType::Memory:
+                WriteBlock(dest_process, dest_addr, src_ptr, span_size);
+                break;
+            default:
+                UNREACHABLE();
+            }
+            dest_addr += static_cast<VAddr>(span_size);
+        });
 }
 
 u32 MemorySystem::GetFCRAMOffset(const u8* pointer) const {
@@ -5,7 +5,10 @@
 #pragma once
 #include <array>
 #include <cstddef>
+#include <optional>
+#include <span>
 #include <string>
+#include <boost/container/static_vector.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/vector.hpp>
 #include "common/common_types.h"
@@ -235,6 +238,10 @@ enum class FlushMode {
     FlushAndInvalidate,
 };
 
+/// Virtual aliases of a rasterizer-accessible physical address. A physical page is visible at
+/// most through the linear heap and the New 3DS linear heap, so the list is stored inline.
+using RasterizerVAddrList = boost::container::static_vector<VAddr, 2>;
+
 class MemorySystem {
 public:
     explicit MemorySystem(Core::System& system);
@@ -276,6 +283,20 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a pointer to a block of the given process' address space that is backed by contiguous
+     * host memory which the rasterizer cache does not hold, so that it can be accessed directly
+     * without flushing or invalidating anything.
+     *
+     * @param process The process whose address space is accessed.
+     * @param vaddr   Virtual address of the start of the block.
+     * @param size    Size of the block in bytes.
+     *
+     * @returns The pointer to the block, or nullptr if any part of it is unmapped, cached by the
+     *          rasterizer or not contiguous in host memory.
+     */
+    u8* GetContiguousPointer(const Kernel::Process& process, VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -469,6 +490,24 @@ public:
     bool WriteExclusive32(const VAddr addr, const u32 data, const u32 expected);
     bool WriteExclusive64(const VAddr addr, const u64 data, const u64 expected);
 
+    /**
+     * Writes a {8, 16, 32, 64}-bit unsigned integer through the given page table if and only if
+     * the address contains the expected value. This operation is atomic. Only pages with a host
+     * pointer are handled, as those need neither the current process nor the rasterizer, so this
+     * may be called from a CPU core running on its own host thread without the HLE lock.
+     *
+     * @returns the result of the write as above, or std::nullopt if the page has no host pointer
+     *          and the write has to go through the current process' address space instead.
+     */
+    std::optional<bool> WriteExclusive8(PageTable& page_table, const VAddr addr, const u8 data,
+                                        const u8 expected);
+    std::optional<bool> WriteExclusive16(PageTable& page_table, const VAddr addr, const u16 data,
+                                         const u16 expected);
+    std::optional<bool> WriteExclusive32(PageTable& page_table, const VAddr addr, const u32 data,
+                                         const u32 expected);
+    std::optional<bool> WriteExclusive64(PageTable& page_table, const VAddr addr, const u64 data,
+                                         const u64 expected);
+
     /**
      * Reads a null-terminated string from the given virtual address.
      * This function will continually read characters until either:
@@ -609,7 +648,7 @@ public:
     void RasterizerMarkRegionCached(PAddr start, u32 size, bool cached);
 
     /// For a rasterizer-accessible PAddr, gets a list of all possible VAddr
-    std::vector<VAddr> PhysicalToVirtualAddressForRasterizer(PAddr addr);
+    RasterizerVAddrList PhysicalToVirtualAddressForRasterizer(PAddr addr);
 
     /// Gets a pointer to the memory region beginning at the specified physical address.
     u8* GetPhysicalPointer(PAddr address);
@@ -645,6 +684,21 @@ public:
 
     void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode);
 
+    /**
+     * Hands the invalidations deferred by RasterizerFlushVirtualRegion over to the rasterizer,
+     * merged into as few intervals as possible. Must be called before the rasterizer is used.
+     */
+    void FlushPendingRasterizerInvalidations();
+
+    /// Returns VRAM, FCRAM and the New 3DS extra RAM, sized as they are serialized.
+    std::array<std::span<u8>, 3> GetSerializedRam();
+
+    /**
+     * Sets whether serializing the memory system includes the contents of the regions returned by
+     * GetSerializedRam, for snapshots that store them on their own.
+     */
+    void SetSerializeRam(bool serialize);
+
 private:
     template <typename T>
     T Read(const std::shared_ptr<PageTable>& page_table, const VAddr vaddr);
@@ -655,6 +709,10 @@ private:
     template <typename T>
     bool WriteExclusive(const VAddr vaddr, const T data, const T expected);
 
+    template <typename T>
+    std::optional<bool> WriteExclusive(PageTable& page_table, const VAddr vaddr, const T data,
+                                       const T expected);
+
     /**
      * Gets the pointer for virtual memory where the page is marked as RasterizerCachedMemory.
      * This is used to access the memory where the page pointer is nullptr due to rasterizer cache.
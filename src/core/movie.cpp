@@ -122,12 +122,36 @@ struct CTMHeader {
     u32_le rerecord_count;       /// Number of rerecords when making the movie
     u64_le input_count;          /// Number of inputs (button and pad states) when making the movie
     s64_le timing_base_ticks;    /// The base system tick count to initialize core timing with.
+    u32_le num_checkpoints;      /// Number of savestate checkpoints following the inputs
+    u64_le checkpoints_offset;   /// Offset of the checkpoints in the file, 0 if there are none
 
-    std::array<u8, 156> reserved; /// Make heading 256 bytes so it has consistent size
+    std::array<u8, 144> reserved; /// Make heading 256 bytes so it has consistent size
 };
 static_assert(sizeof(CTMHeader) == 256, "CTMHeader should be 256 bytes");
 #pragma pack(pop)
 
+#pragma pack(push, 1)
+struct CTMCheckpointHeader {
+    u64_le input; /// Input count at which the savestate was taken
+    u64_le size;  /// Size of the zstd compressed savestate that follows
+};
+static_assert(sizeof(CTMCheckpointHeader) == 16, "CTMCheckpointHeader should be 16 bytes");
+#pragma pack(pop)
+
+/// Returns the size of the inputs of a movie file, which are followed by its checkpoints.
+static u64 GetInputSize(const CTMHeader& header, u64 file_size) {
+    if (header.num_checkpoints == 0 || header.checkpoints_offset < sizeof(CTMHeader) ||
+        header.checkpoints_offset > file_size) {
+        return file_size - sizeof(CTMHeader);
+    }
+    return header.checkpoints_offset - sizeof(CTMHeader);
+}
+
+/// Converts an input count to the index reported to the frontend.
+static u64 ToInputIndex(u64 input) {
+    return static_cast<u64>(std::nearbyint(input / 234.0 * SCREEN_REFRESH_RATE));
+}
+
 static u64 GetInputCount(std::span<const u8> input) {
     u64 input_count = 0;
     for (std::size_t pos = 0; pos < input.size(); pos += sizeof(ControllerState)) {
@@ -144,7 +168,7 @@ static u64 GetInputCount(std::span<const u8> input) {
     return input_count;
 }
 
-Movie::Movie(const Core::System& system_) : system{system_} {}
+Movie::Movie(Core::System& system_) : system{system_} {}
 
 Movie::~Movie() = default;
 
@@ -156,8 +180,11 @@ void Movie::serialize(Archive& ar, const unsigned int file_version) {
     current_byte = static_cast<std::size_t>(_current_byte);
     ar & current_input;
 
-    std::vector<u8> recorded_input_ = recorded_input;
-    ar & recorded_input_;
+    std::vector<u8> recorded_input_;
+    if (!checkpoint_serialization) {
+        recorded_input_ = recorded_input;
+        ar & recorded_input_;
+    }
 
     ar & init_time;
     ar & base_ticks;
@@ -176,6 +203,17 @@ void Movie::serialize(Archive& ar, const unsigned int file_version) {
         ar & id;
     }
 
+    if (checkpoint_serialization) {
+        // Checkpoints are stored in the movie they belong to, so they leave out its input.
+        if (Archive::is_loading::value) {
+            if (current_byte > recorded_input.size()) {
+                throw std::runtime_error("Movie checkpoint is past the end of the movie");
+            }
+            play_mode = PlayMode::Playing;
+        }
+        return;
+    }
+
     // Whether the state was made in MovieFinished state
     bool post_movie = play_mode == PlayMode::MovieFinished;
     ar & post_movie;
@@ -183,6 +221,10 @@ void Movie::serialize(Archive& ar, const unsigned int file_version) {
     if (Archive::is_loading::value && id != 0) {
         if (!read_only) {
             recorded_input = std::move(recorded_input_);
+            // Checkpoints past the state belong to the timeline being rerecorded.
+            std::erase_if(checkpoints, [this](const Checkpoint& checkpoint) {
+                return checkpoint.input > current_input;
+            });
         }
 
         if (post_movie) {
@@ -220,16 +262,18 @@ Movie::PlayMode Movie::GetPlayMode() const {
 }
 
 u64 Movie::GetCurrentInputIndex() const {
-    return static_cast<u64>(std::nearbyint(current_input / 234.0 * SCREEN_REFRESH_RATE));
+    return ToInputIndex(current_input);
 }
 u64 Movie::GetTotalInputCount() const {
-    return static_cast<u64>(std::nearbyint(total_input / 234.0 * SCREEN_REFRESH_RATE));
+    return ToInputIndex(total_input);
 }
 
 void Movie::CheckInputEnd() {
     if (current_byte + sizeof(ControllerState) > recorded_input.size()) {
         LOG_INFO(Movie, "Playback finished");
         play_mode = PlayMode::MovieFinished;
+        seek_target.reset();
+        UpdateTurbo();
         playback_completion_callback();
     }
 }
@@ -484,6 +528,23 @@ Movie::ValidationResult Movie::ValidateInput(std::span<const u8> input, u64 expe
 
 void Movie::SaveMovie() {
     LOG_INFO(Movie, "Saving recorded movie to '{}'", record_movie_file);
+
+    // Checkpoints still in the file being overwritten are read beforehand.
+    if (std::ranges::any_of(checkpoints, [](const Checkpoint& c) { return c.state.empty(); })) {
+        FileUtil::IOFile old_record(record_movie_file, "rb");
+        for (auto& checkpoint : checkpoints) {
+            if (checkpoint.state.empty()) {
+                checkpoint.state.resize(checkpoint.size);
+                old_record.ReadAtArray(checkpoint.state.data(), checkpoint.size,
+                                       checkpoint.file_offset);
+            }
+        }
+        if (!old_record.IsGood()) {
+            LOG_ERROR(Movie, "Unable to read the checkpoints of the movie, dropping them");
+            checkpoints.clear();
+        }
+    }
+
     FileUtil::IOFile save_record(record_movie_file, "wb");
 
     if (!save_record.IsGood()) {
@@ -503,6 +564,8 @@ void Movie::SaveMovie() {
 
     header.rerecord_count = rerecord_count;
     header.input_count = GetInputCount(recorded_input);
+    header.num_checkpoints = static_cast<u32>(checkpoints.size());
+    header.checkpoints_offset = checkpoints.empty() ? 0 : sizeof(CTMHeader) + recorded_input.size();
 
     std::string rev_bytes;
     CryptoPP::StringSource(Common::g_scm_rev, true,
@@ -511,6 +574,14 @@ void Movie::SaveMovie() {
 
     save_record.WriteBytes(&header, sizeof(CTMHeader));
     save_record.WriteBytes(recorded_input.data(), recorded_input.size());
+    u64 offset = header.checkpoints_offset;
+    for (auto& checkpoint : checkpoints) {
+        const CTMCheckpointHeader checkpoint_header{checkpoint.input, checkpoint.state.size()};
+        save_record.WriteObject(checkpoint_header);
+        save_record.WriteBytes(checkpoint.state.data(), checkpoint.state.size());
+        checkpoint.file_offset = offset + sizeof(CTMCheckpointHeader);
+        offset = checkpoint.file_offset + checkpoint.size;
+    }
 
     if (!save_record.IsGood()) {
         LOG_ERROR(Movie, "Error saving movie");
@@ -540,7 +611,7 @@ void Movie::StartPlayback(const std::string& movie_file) {
             rerecord_count = header.rerecord_count;
             total_input = header.input_count;
 
-            recorded_input.resize(size - sizeof(CTMHeader));
+            recorded_input.resize(GetInputSize(header, size));
             save_record.ReadArray(recorded_input.data(), recorded_input.size());
 
             current_byte = 0;
@@ -548,7 +619,24 @@ void Movie::StartPlayback(const std::string& movie_file) {
             id = header.id;
             program_id = header.program_id;
 
-            LOG_INFO(Movie, "Loaded Movie, ID: {:016X}", id);
+            // Only the location of the checkpoints is read, their states when seeking.
+            checkpoints.clear();
+            u64 offset = sizeof(CTMHeader) + recorded_input.size();
+            for (u32 i = 0; i < header.num_checkpoints; i++) {
+                CTMCheckpointHeader checkpoint_header;
+                if (save_record.ReadAtArray(&checkpoint_header, 1, offset) != 1 ||
+                    offset + sizeof(checkpoint_header) + checkpoint_header.size > size) {
+                    LOG_ERROR(Movie, "Movie checkpoint {} is truncated", i);
+                    break;
+                }
+                offset += sizeof(checkpoint_header);
+                checkpoints.push_back(
+                    {checkpoint_header.input, offset, checkpoint_header.size, {}});
+                offset += checkpoint_header.size;
+            }
+
+            LOG_INFO(Movie, "Loaded Movie, ID: {:016X}, {} checkpoints", id, checkpoints.size());
+            UpdateTurbo();
         }
     } else {
         LOG_ERROR(Movie, "Failed to playback movie: Unable to open '{}'", movie_file);
@@ -560,6 +648,7 @@ void Movie::StartRecording(const std::string& movie_file, const std::string& aut
     record_movie_file = movie_file;
     record_movie_author = author;
     rerecord_count = 1;
+    checkpoints.clear();
 
     // Generate a random ID
     CryptoPP::AutoSeededRandomPool rng;
@@ -570,6 +659,7 @@ void Movie::StartRecording(const std::string& movie_file, const std::string& aut
     system.GetAppLoader().ReadProgramId(program_id);
 
     LOG_INFO(Movie, "Enabling Movie recording, ID: {:016X}", id);
+    system.StartMovieCheckpoints();
 }
 
 void Movie::SetReadOnly(bool read_only_) {
@@ -645,7 +735,7 @@ Movie::ValidationResult Movie::ValidateMovie(const std::string& movie_file) cons
         return ValidationResult::OK;
     }
 
-    std::vector<u8> input(size - sizeof(header));
+    std::vector<u8> input(GetInputSize(header, size));
     save_record.ReadArray(input.data(), input.size());
     return ValidateInput(input, header.input_count);
 }
@@ -675,6 +765,69 @@ void Movie::Shutdown() {
     init_time = 0;
     base_ticks = -1;
     id = 0;
+    checkpoints.clear();
+    seek_target.reset();
+    UpdateTurbo();
+}
+
+void Movie::AddCheckpoint(std::vector<u8> state) {
+    if (!checkpoints.empty() && checkpoints.back().input == current_input) {
+        checkpoints.pop_back();
+    }
+    const u64 size = state.size();
+    checkpoints.push_back({current_input, 0, size, std::move(state)});
+}
+
+std::vector<u8> Movie::ReadCheckpoint(u64 input_index, u64& checkpoint_index) const {
+    const auto it = std::find_if(checkpoints.rbegin(), checkpoints.rend(),
+                                 [input_index](const Checkpoint& checkpoint) {
+                                     return ToInputIndex(checkpoint.input) <= input_index;
+                                 });
+    if (it == checkpoints.rend()) {
+        return {};
+    }
+    checkpoint_index = ToInputIndex(it->input);
+    if (!it->state.empty()) {
+        return it->state;
+    }
+
+    std::vector<u8> state(it->size);
+    FileUtil::IOFile save_record(record_movie_file, "rb");
+    if (save_record.ReadAtArray(state.data(), state.size(), it->file_offset) != state.size()) {
+        LOG_ERROR(Movie, "Unable to read movie checkpoint from '{}'", record_movie_file);
+        return {};
+    }
+    return state;
+}
+
+void Movie::SetSeekTarget(u64 input_index) {
+    if (play_mode == PlayMode::Playing && GetCurrentInputIndex() < input_index) {
+        seek_target = input_index;
+    } else {
+        seek_target.reset();
+    }
+    UpdateTurbo();
+}
+
+void Movie::UpdateTurbo() {
+    const bool turbo = play_mode == PlayMode::Playing &&
+                       (Settings::values.movie_turbo_playback.GetValue() || seek_target);
+    if (turbo == turbo_active) {
+        return;
+    }
+    turbo_active = turbo;
+    if (turbo) {
+        saved_is_temporary_frame_limit = Settings::is_temporary_frame_limit;
+        saved_temporary_frame_limit = Settings::temporary_frame_limit;
+        saved_audio_muted = Settings::values.audio_muted;
+        Settings::is_temporary_frame_limit = true;
+        Settings::temporary_frame_limit = 0;
+        Settings::values.audio_muted = true;
+    } else {
+        Settings::is_temporary_frame_limit = saved_is_temporary_frame_limit;
+        Settings::temporary_frame_limit = saved_temporary_frame_limit;
+        Settings::values.audio_muted = saved_audio_muted;
+    }
 }
 
 template <typename... Targs>
@@ -682,6 +835,11 @@ void Movie::Handle(Targs&... Fargs) {
     if (play_mode == PlayMode::Playing) {
         ASSERT(current_byte + sizeof(ControllerState) <= recorded_input.size());
         Play(Fargs...);
+        if (seek_target && GetCurrentInputIndex() >= *seek_target) {
+            LOG_INFO(Movie, "Reached input {}", *seek_target);
+            seek_target.reset();
+            UpdateTurbo();
+        }
         CheckInputEnd();
     } else if (play_mode == PlayMode::Recording) {
         Record(Fargs...);
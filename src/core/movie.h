@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 #include <span>
 #include <boost/serialization/vector.hpp>
 #include "common/common_types.h"
@@ -44,7 +45,7 @@ public:
         Invalid,
     };
 
-    explicit Movie(const Core::System& system);
+    explicit Movie(Core::System& system);
     ~Movie();
 
     void SetPlaybackCompletionCallback(std::function<void()> completion_callback);
@@ -139,7 +140,37 @@ public:
      */
     void SaveMovie();
 
+    /// Stores a compressed savestate taken at the current input in the movie being recorded.
+    void AddCheckpoint(std::vector<u8> state);
+
+    /**
+     * Reads the newest checkpoint at or before the given input index.
+     * @param input_index Input index, as returned by GetCurrentInputIndex.
+     * @param checkpoint_index Set to the input index the checkpoint was taken at.
+     * @return The compressed savestate, empty if there is no such checkpoint.
+     */
+    std::vector<u8> ReadCheckpoint(u64 input_index, u64& checkpoint_index) const;
+
+    /// Sets whether the movie is serialized as part of a checkpoint, which leaves out the input.
+    void SetCheckpointSerialization(bool checkpoint) {
+        checkpoint_serialization = checkpoint;
+    }
+
+    /// Plays back without frame limiting nor audio until the given input index is reached.
+    void SetSeekTarget(u64 input_index);
+
 private:
+    /// A savestate stored in the movie file, to seek without playing back from the start.
+    struct Checkpoint {
+        u64 input;             ///< Value of current_input when the state was taken
+        u64 file_offset;       ///< Offset of the state in the movie file, if read from one
+        u64 size;              ///< Size of the compressed state
+        std::vector<u8> state; ///< Compressed state, empty until read from the movie file
+    };
+
+    /// Turns turbo playback on or off depending on the play mode, the settings and the seek.
+    void UpdateTurbo();
+
     void CheckInputEnd();
 
     template <typename... Targs>
@@ -165,7 +196,7 @@ private:
     ValidationResult ValidateInput(std::span<const u8> input, u64 expected_count) const;
 
 private:
-    const Core::System& system;
+    Core::System& system;
     PlayMode play_mode;
 
     std::string record_movie_file;
@@ -187,6 +218,16 @@ private:
 
     std::function<void()> playback_completion_callback = [] {};
 
+    std::vector<Checkpoint> checkpoints;
+    bool checkpoint_serialization = false;
+    std::optional<u64> seek_target;
+
+    // Frame limit and audio settings turbo playback overrides, restored when it ends.
+    bool turbo_active = false;
+    bool saved_is_temporary_frame_limit = false;
+    double saved_temporary_frame_limit = 0;
+    bool saved_audio_muted = false;
+
     template <class Archive>
     void serialize(Archive& ar, const unsigned int file_version);
     friend class boost::serialization::access;
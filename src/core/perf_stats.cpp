@@ -12,6 +12,7 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 #include "common/file_util.h"
+#include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/core_timing.h"
 #include "core/perf_stats.h"
@@ -26,12 +27,19 @@ constexpr double FRAME_LENGTH = 1.0 / SCREEN_REFRESH_RATE;
 // Purposefully ignore the first five frames, as there's a significant amount of overhead in
 // booting that we shouldn't account for
 constexpr std::size_t IgnoreFrames = 5;
+// Frontends reset the stats every second, this only bounds the samples when nothing does
+constexpr std::size_t MaxFrameSamples = 3600;
 
 namespace Core {
 
 PerfStats::PerfStats(u64 title_id) : title_id(title_id) {}
 
 PerfStats::~PerfStats() {
+    if (total_software_transfers != 0) {
+        LOG_INFO(Core, "Title {:016X}: {} of {} GPU transfers fell back to the software path",
+                 title_id, total_software_transfers.load(), total_gpu_transfers.load());
+    }
+
     if (!Settings::values.record_frame_times || title_id == 0) {
         return;
     }
@@ -52,16 +60,32 @@ void PerfStats::BeginSVCProcessing() {
     start_svc_time = Clock::now();
 }
 
-void PerfStats::EndSVCProcessing() {
-    accumulated_svc_time += (Clock::now() - start_svc_time);
+void PerfStats::EndSVCProcessing(u32 svc_id, const char* name) {
+    const auto elapsed = Clock::now() - start_svc_time;
+    accumulated_svc_time += elapsed;
+
+    SVCCounters& counters = svc_counters[svc_id % svc_counters.size()];
+    counters.name = name;
+    counters.calls++;
+    counters.time += elapsed;
 }
 
 void PerfStats::BeginIPCProcessing() {
     start_ipc_time = Clock::now();
 }
 
-void PerfStats::EndIPCProcessing() {
-    accumulated_ipc_time += (Clock::now() - start_ipc_time);
+void PerfStats::EndIPCProcessing(std::string_view service_name) {
+    const auto elapsed = Clock::now() - start_ipc_time;
+    accumulated_ipc_time += elapsed;
+
+    std::scoped_lock lock{object_mutex};
+    auto it = ipc_service_counters.find(service_name);
+    if (it == ipc_service_counters.end()) {
+        it = ipc_service_counters.emplace(std::string{service_name}, IPCServiceCounters{}).first;
+    }
+    it->second.requests++;
+    it->second.time += elapsed;
+    it->second.frame_time += elapsed;
 }
 
 void PerfStats::BeginGPUProcessing() {
@@ -80,6 +104,14 @@ void PerfStats::EndSwap() {
     accumulated_swap_time += (Clock::now() - start_swap_time);
 }
 
+void PerfStats::BeginCPUProcessing() {
+    start_cpu_time = Clock::now();
+}
+
+void PerfStats::EndCPUProcessing() {
+    accumulated_cpu_time += (Clock::now() - start_cpu_time);
+}
+
 void PerfStats::BeginSystemFrame() {
     std::scoped_lock lock{object_mutex};
 
@@ -98,6 +130,38 @@ void PerfStats::EndSystemFrame() {
     accumulated_frametime += frame_time;
     system_frames += 1;
 
+    const FrameTotals totals{
+        .svc = accumulated_svc_time,
+        .ipc = accumulated_ipc_time,
+        .gpu = accumulated_gpu_time,
+        .swap = accumulated_swap_time,
+        .cpu = accumulated_cpu_time,
+    };
+    const u32 compiles = frame_shader_compiles.exchange(0, std::memory_order_relaxed);
+    if (frame_samples.size() < MaxFrameSamples) {
+        const auto seconds = [](Clock::duration duration) {
+            return static_cast<float>(duration_cast<DoubleSecs>(duration).count());
+        };
+        const auto svc = totals.svc - frame_totals.svc;
+        const auto ipc = totals.ipc - frame_totals.ipc;
+        const auto gpu = totals.gpu - frame_totals.gpu;
+        frame_samples.push_back({
+            .frame = seconds(frame_time),
+            .svc = seconds(svc - ipc),
+            .ipc = seconds(ipc - gpu),
+            .gpu = seconds(gpu),
+            .swap = seconds(totals.swap - frame_totals.swap),
+            .jit = seconds(std::max(totals.cpu - frame_totals.cpu - svc, Clock::duration::zero())),
+            .shader_compiles = compiles,
+        });
+    }
+    frame_totals = totals;
+    shader_compiles += compiles;
+    for (auto& [name, counters] : ipc_service_counters) {
+        counters.max_frame_time = std::max(counters.max_frame_time, counters.frame_time);
+        counters.frame_time = Clock::duration::zero();
+    }
+
     // TODO: Track previous frame times in a less stupid way. -OS
     previous_previous_frame_length = previous_frame_length;
 
@@ -162,8 +226,109 @@ PerfStats::Results PerfStats::GetAndResetStats(microseconds current_system_time_
                              .count() /
                          static_cast<double>(system_frames))
                       : 0;
+    last_stats.time_jit =
+        system_frames
+            ? (duration_cast<DoubleSecs>(std::max(accumulated_cpu_time - accumulated_svc_time,
+                                                  Clock::duration::zero()))
+                   .count() /
+               static_cast<double>(system_frames))
+            : 0;
     last_stats.emulation_speed = system_us_per_second.count() / 1'000'000.0;
+    last_stats.cpu_clock_percentage = cpu_clock_percentage;
+    last_stats.texture_memory_used = texture_memory_used;
+    last_stats.texture_memory_budget = texture_memory_budget;
+    last_stats.evicted_textures = evicted_textures;
+    last_stats.staging_memory = staging_memory;
+    last_stats.staging_stalls = staging_stalls;
+    const auto per_frame = [this](u64 count) {
+        return game_frames ? static_cast<double>(count) / static_cast<double>(game_frames) : 0;
+    };
+    last_stats.render_passes = per_frame(render_passes);
+    last_stats.merged_render_passes = per_frame(merged_render_passes);
+    last_stats.render_pass_bytes_saved = per_frame(render_pass_bytes_saved);
+    last_stats.gpu_transfers = per_frame(gpu_transfers);
+    last_stats.software_transfers = per_frame(software_transfers);
+    last_stats.present_latency = static_cast<double>(present_latency_us) / 1'000'000.0;
+    last_stats.custom_texture_queue_depth = custom_texture_queue_depth;
+    last_stats.custom_texture_latency =
+        custom_texture_uploads ? static_cast<double>(custom_texture_latency_us) /
+                                     (1'000'000.0 * custom_texture_uploads)
+                               : 0;
+    last_stats.run_loop_iterations_per_frame =
+        system_frames
+            ? static_cast<double>(run_loop_iterations) / static_cast<double>(system_frames)
+            : 0;
+    last_stats.ipc_services.clear();
+    if (system_frames) {
+        for (auto& [name, counters] : ipc_service_counters) {
+            if (counters.requests == 0) {
+                continue;
+            }
+            last_stats.ipc_services.push_back({
+                .name = name,
+                .requests_per_frame =
+                    static_cast<double>(counters.requests) / static_cast<double>(system_frames),
+                .time_per_frame = duration_cast<DoubleSecs>(counters.time).count() /
+                                  static_cast<double>(system_frames),
+                .max_time_per_frame = duration_cast<DoubleSecs>(counters.max_frame_time).count(),
+            });
+        }
+        std::sort(last_stats.ipc_services.begin(), last_stats.ipc_services.end(),
+                  [](const IPCServiceStats& a, const IPCServiceStats& b) {
+                      return a.time_per_frame > b.time_per_frame;
+                  });
+    }
+    last_stats.svcs.clear();
+    if (system_frames) {
+        for (const SVCCounters& counters : svc_counters) {
+            if (counters.calls == 0) {
+                continue;
+            }
+            last_stats.svcs.push_back({
+                .name = counters.name,
+                .calls_per_frame =
+                    static_cast<double>(counters.calls) / static_cast<double>(system_frames),
+                .time_per_frame = duration_cast<DoubleSecs>(counters.time).count() /
+                                  static_cast<double>(system_frames),
+            });
+        }
+        std::sort(last_stats.svcs.begin(), last_stats.svcs.end(),
+                  [](const SVCStats& a, const SVCStats& b) {
+                      return a.time_per_frame > b.time_per_frame;
+                  });
+    }
+    last_stats.shader_compiles = shader_compiles;
+
+    std::vector<double> values(frame_samples.size());
+    const auto percentiles = [this, &values](auto member) -> FramePercentiles {
+        if (values.empty()) {
+            return {};
+        }
+        std::transform(frame_samples.begin(), frame_samples.end(), values.begin(),
+                       [member](const FrameSample& sample) {
+                           return static_cast<double>(sample.*member);
+                       });
+        std::sort(values.begin(), values.end());
+        const auto at = [&values](double quantile) {
+            return values[static_cast<std::size_t>(quantile * (values.size() - 1) + 0.5)];
+        };
+        return {.p50 = at(0.50), .p95 = at(0.95), .p99 = at(0.99), .max = values.back()};
+    };
+    last_stats.frame_breakdown = {
+        .frame = percentiles(&FrameSample::frame),
+        .svc = percentiles(&FrameSample::svc),
+        .ipc = percentiles(&FrameSample::ipc),
+        .gpu = percentiles(&FrameSample::gpu),
+        .swap = percentiles(&FrameSample::swap),
+        .jit = percentiles(&FrameSample::jit),
+        .shader_compiles = percentiles(&FrameSample::shader_compiles),
+    };
     last_stats.artic_transmitted = static_cast<double>(artic_transmitted) / interval;
+    last_stats.artic_requests = static_cast<double>(artic_requests) / interval;
+    last_stats.artic_latency =
+        artic_request_groups ? static_cast<double>(artic_latency_us) /
+                                   (1'000'000.0 * artic_request_groups)
+                             : 0;
     last_stats.artic_events.raw = artic_events.raw | prev_artic_event.raw;
 
     // Reset counters
@@ -172,11 +337,35 @@ PerfStats::Results PerfStats::GetAndResetStats(microseconds current_system_time_
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     accumulated_svc_time = Clock::duration::zero();
+    for (SVCCounters& counters : svc_counters) {
+        counters.calls = 0;
+        counters.time = Clock::duration::zero();
+    }
     accumulated_ipc_time = Clock::duration::zero();
+    for (auto& [name, counters] : ipc_service_counters) {
+        counters = {};
+    }
     accumulated_gpu_time = Clock::duration::zero();
     accumulated_swap_time = Clock::duration::zero();
+    accumulated_cpu_time = Clock::duration::zero();
+    frame_totals = {};
+    frame_samples.clear();
+    shader_compiles = 0;
     game_frames = 0;
     artic_transmitted = 0;
+    artic_requests = 0;
+    artic_request_groups = 0;
+    artic_latency_us = 0;
+    run_loop_iterations = 0;
+    evicted_textures = 0;
+    staging_stalls = 0;
+    render_passes = 0;
+    merged_render_passes = 0;
+    render_pass_bytes_saved = 0;
+    gpu_transfers = 0;
+    software_transfers = 0;
+    custom_texture_uploads = 0;
+    custom_texture_latency_us = 0;
     prev_artic_event.raw &= artic_events.raw;
 
     return last_stats;
@@ -240,7 +429,7 @@ void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
         std::clamp(frame_limiting_delta_err, -max_lag_time_us, max_lag_time_us);
 
     if (frame_limiting_delta_err > microseconds::zero()) {
-        std::this_thread::sleep_for(frame_limiting_delta_err);
+        Common::PreciseSleep(frame_limiting_delta_err);
         auto now_after_sleep = Clock::now();
         frame_limiting_delta_err -= duration_cast<microseconds>(now_after_sleep - now);
         now = now_after_sleep;
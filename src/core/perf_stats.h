@@ -8,7 +8,12 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
 #include "common/thread.h"
@@ -49,6 +54,46 @@ public:
         }
     };
 
+    /// Cost of the HLE requests served by one service
+    struct IPCServiceStats {
+        std::string name;
+        /// Number of requests per system frame
+        double requests_per_frame = 0;
+        /// Walltime in seconds per system frame spent serving requests, including GPU work
+        double time_per_frame = 0;
+        /// Walltime in seconds of the system frame that spent the most serving requests
+        double max_time_per_frame = 0;
+    };
+
+    /// Cost of the calls to one SVC
+    struct SVCStats {
+        std::string name;
+        /// Number of calls per system frame
+        double calls_per_frame = 0;
+        /// Walltime in seconds per system frame spent in the calls, including IPC and GPU work
+        double time_per_frame = 0;
+    };
+
+    /// Distribution of a per system frame measurement since the last reset
+    struct FramePercentiles {
+        double p50 = 0;
+        double p95 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    /// Per system frame distributions of the walltime categories, in seconds, and of the shader
+    /// compilations, which show stutter that the means hide
+    struct FrameBreakdown {
+        FramePercentiles frame;
+        FramePercentiles svc;
+        FramePercentiles ipc;
+        FramePercentiles gpu;
+        FramePercentiles swap;
+        FramePercentiles jit;
+        FramePercentiles shader_compiles;
+    };
+
     struct Results {
         /// System FPS (LCD VBlanks) in Hz
         double system_fps;
@@ -67,22 +112,69 @@ public:
         double time_swap;
         // Walltime in seconds of the vblank interval spent in other operations
         double time_remaining;
+        // Walltime in seconds of the vblank interval spent executing guest code, excluding SVCs
+        double time_jit = 0;
         /// Ratio of walltime / emulated time elapsed
         double emulation_speed;
+        /// Emulated CPU clock percentage in effect, including the title tick profile
+        u32 cpu_clock_percentage = 100;
+        /// Number of System::RunLoop iterations per system frame
+        double run_loop_iterations_per_frame = 0;
+        /// Estimated host memory used by cached textures, in bytes
+        u64 texture_memory_used = 0;
+        /// Memory cached textures may use before they are evicted, zero when unlimited
+        u64 texture_memory_budget = 0;
+        /// Number of textures evicted because of the memory budget
+        u32 evicted_textures = 0;
+        /// Host memory held by the texture upload staging buffers, in bytes
+        u64 staging_memory = 0;
+        /// Number of texture uploads that waited for the GPU to free staging memory
+        u32 staging_stalls = 0;
+        /// Render passes begun per frame
+        double render_passes = 0;
+        /// Render passes per frame that continued the previous pass instead of restarting it
+        double merged_render_passes = 0;
+        /// Estimated attachment bytes per frame that merged passes did not store and load again
+        double render_pass_bytes_saved = 0;
+        /// Mean time in seconds between the end of a frame and it reaching the display
+        double present_latency = 0;
+        /// Display transfers, texture copies and memory fills per frame
+        double gpu_transfers = 0;
+        /// Transfers per frame the rasterizer could not accelerate, done on the CPU instead
+        double software_transfers = 0;
+        /// Custom texture uploads waiting for their material to be decoded
+        u32 custom_texture_queue_depth = 0;
+        /// Mean time in seconds between requesting and uploading a custom texture
+        double custom_texture_latency = 0;
+        /// Per-service IPC cost, most expensive first
+        std::vector<IPCServiceStats> ipc_services;
+        /// Per-SVC cost, most expensive first
+        std::vector<SVCStats> svcs;
+        /// Number of host shaders compiled
+        u32 shader_compiles = 0;
+        /// Per system frame distributions of the timings above
+        FrameBreakdown frame_breakdown;
         /// Artic base bytes per second
         double artic_transmitted = 0;
+        /// Artic base requests per second
+        double artic_requests = 0;
+        /// Mean time in seconds until the responses of a group of Artic base requests arrived
+        double artic_latency = 0;
         /// Artic base events
         PerfArticEvents artic_events{};
     };
 
     void BeginSVCProcessing();
-    void EndSVCProcessing();
+    /// Ends the SVC begun last, whose name must outlive the stats
+    void EndSVCProcessing(u32 svc_id, const char* name);
     void BeginIPCProcessing();
-    void EndIPCProcessing();
+    void EndIPCProcessing(std::string_view service_name);
     void BeginGPUProcessing();
     void EndGPUProcessing();
     void StartSwap();
     void EndSwap();
+    void BeginCPUProcessing();
+    void EndCPUProcessing();
     void BeginSystemFrame();
     void EndSystemFrame();
     void EndGameFrame();
@@ -108,10 +200,69 @@ public:
      */
     double GetStableFrameTimeScale() const;
 
+    void SetCPUClockPercentage(u32 percentage) {
+        cpu_clock_percentage = percentage;
+    }
+
+    void ReportTextureMemory(u64 used, u64 budget, u32 evicted) {
+        texture_memory_used = used;
+        texture_memory_budget = budget;
+        evicted_textures.fetch_add(evicted, std::memory_order_relaxed);
+    }
+
+    void ReportStagingMemory(u64 used, u32 stalls) {
+        staging_memory = used;
+        staging_stalls.fetch_add(stalls, std::memory_order_relaxed);
+    }
+
+    void ReportRenderPasses(u32 passes, u32 merged, u64 bytes_saved) {
+        render_passes.fetch_add(passes, std::memory_order_relaxed);
+        merged_render_passes.fetch_add(merged, std::memory_order_relaxed);
+        render_pass_bytes_saved.fetch_add(bytes_saved, std::memory_order_relaxed);
+    }
+
+    void ReportGPUTransfer(bool accelerated) {
+        gpu_transfers.fetch_add(1, std::memory_order_relaxed);
+        total_gpu_transfers.fetch_add(1, std::memory_order_relaxed);
+        if (!accelerated) {
+            software_transfers.fetch_add(1, std::memory_order_relaxed);
+            total_software_transfers.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ReportPresentLatency(std::chrono::microseconds latency) {
+        if (latency.count() != 0) {
+            present_latency_us = latency.count();
+        }
+    }
+
+    void ReportCustomTextureQueue(u32 depth) {
+        custom_texture_queue_depth = depth;
+    }
+
+    void AddCustomTextureUpload(std::chrono::microseconds latency) {
+        custom_texture_uploads.fetch_add(1, std::memory_order_relaxed);
+        custom_texture_latency_us.fetch_add(latency.count(), std::memory_order_relaxed);
+    }
+
+    void ReportShaderCompiles(u32 count) {
+        frame_shader_compiles.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void AddRunLoopIteration() {
+        run_loop_iterations.fetch_add(1, std::memory_order_relaxed);
+    }
+
     void AddArticBaseTraffic(u32 bytes) {
         artic_transmitted += bytes;
     }
 
+    void AddArticBaseRequests(u32 count, std::chrono::microseconds latency) {
+        artic_requests.fetch_add(count, std::memory_order_relaxed);
+        artic_request_groups.fetch_add(1, std::memory_order_relaxed);
+        artic_latency_us.fetch_add(latency.count(), std::memory_order_relaxed);
+    }
+
     void ReportPerfArticEvent(PerfArticEventBits event, bool set) {
         if (set) {
             artic_events.Set(event, set);
@@ -145,6 +296,39 @@ private:
     u32 game_frames = 0;
     /// Cumulative number of transmitted artic base traffic
     std::atomic<u32> artic_transmitted = 0;
+    /// Cumulative Artic base requests and their latency since last reset
+    std::atomic<u32> artic_requests = 0;
+    std::atomic<u32> artic_request_groups = 0;
+    std::atomic<u64> artic_latency_us = 0;
+    /// Cumulative number of System::RunLoop iterations since last reset
+    std::atomic<u32> run_loop_iterations = 0;
+    /// Emulated CPU clock percentage reported in the results
+    std::atomic<u32> cpu_clock_percentage = 100;
+    /// Texture cache memory reported in the results
+    std::atomic<u64> texture_memory_used = 0;
+    std::atomic<u64> texture_memory_budget = 0;
+    /// Cumulative number of textures evicted since last reset
+    std::atomic<u32> evicted_textures = 0;
+    /// Texture upload staging reported in the results
+    std::atomic<u64> staging_memory = 0;
+    /// Cumulative number of staging stalls since last reset
+    std::atomic<u32> staging_stalls = 0;
+    /// Cumulative render pass counts since last reset
+    std::atomic<u32> render_passes = 0;
+    std::atomic<u32> merged_render_passes = 0;
+    std::atomic<u64> render_pass_bytes_saved = 0;
+    /// Cumulative GPU transfer counts since last reset
+    std::atomic<u32> gpu_transfers = 0;
+    std::atomic<u32> software_transfers = 0;
+    /// GPU transfer counts since the title started, logged when it stops
+    std::atomic<u64> total_gpu_transfers = 0;
+    std::atomic<u64> total_software_transfers = 0;
+    /// Latest mean presentation latency reported by the renderer
+    std::atomic<u64> present_latency_us = 0;
+    /// Custom texture streaming reported in the results
+    std::atomic<u32> custom_texture_queue_depth = 0;
+    std::atomic<u32> custom_texture_uploads = 0;
+    std::atomic<u64> custom_texture_latency_us = 0;
     // System events that affect performance
     PerfArticEvents artic_events;
 
@@ -162,15 +346,64 @@ private:
     Clock::time_point start_svc_time = reset_point;
     Clock::duration accumulated_svc_time = Clock::duration::zero();
 
+    struct SVCCounters {
+        const char* name = nullptr;
+        u32 calls = 0;
+        Clock::duration time = Clock::duration::zero();
+    };
+    /// Cumulative per-SVC cost since last reset, indexed by SVC number. SVCs are accounted on the
+    /// emulation thread like accumulated_svc_time, so this takes no lock.
+    std::array<SVCCounters, 0x100> svc_counters{};
+
     Clock::time_point start_ipc_time = reset_point;
     Clock::duration accumulated_ipc_time = Clock::duration::zero();
 
+    struct IPCServiceCounters {
+        u32 requests = 0;
+        Clock::duration time = Clock::duration::zero();
+        Clock::duration frame_time = Clock::duration::zero();
+        Clock::duration max_frame_time = Clock::duration::zero();
+    };
+    /// Cumulative per-service IPC cost since last reset. Entries are zeroed rather than erased on
+    /// reset so that accounting a request does not allocate once a service has been seen.
+    std::map<std::string, IPCServiceCounters, std::less<>> ipc_service_counters;
+
     Clock::time_point start_gpu_time = reset_point;
     Clock::duration accumulated_gpu_time = Clock::duration::zero();
 
     Clock::time_point start_swap_time = reset_point;
     Clock::duration accumulated_swap_time = Clock::duration::zero();
 
+    Clock::time_point start_cpu_time = reset_point;
+    Clock::duration accumulated_cpu_time = Clock::duration::zero();
+
+    /// Shaders compiled since the end of the previous system frame
+    std::atomic<u32> frame_shader_compiles = 0;
+    /// Cumulative number of shaders compiled since last reset
+    u32 shader_compiles = 0;
+
+    struct FrameSample {
+        float frame;
+        float svc;
+        float ipc;
+        float gpu;
+        float swap;
+        float jit;
+        u32 shader_compiles;
+    };
+    /// Cumulative timings at the end of the previous system frame, which the next frame's sample
+    /// is taken relative to
+    struct FrameTotals {
+        Clock::duration svc = Clock::duration::zero();
+        Clock::duration ipc = Clock::duration::zero();
+        Clock::duration gpu = Clock::duration::zero();
+        Clock::duration swap = Clock::duration::zero();
+        Clock::duration cpu = Clock::duration::zero();
+    };
+    FrameTotals frame_totals;
+    /// Per system frame timings since last reset, bounded in case the stats are never reset
+    std::vector<FrameSample> frame_samples;
+
     /// Last recorded performance statistics.
     Results last_stats;
 };
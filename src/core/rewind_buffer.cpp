@@ -0,0 +1,111 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/rewind_buffer.h"
+
+namespace Core {
+
+namespace {
+
+/// Deltas are mostly zero, the fastest level already compresses them well.
+constexpr s32 DeltaCompressionLevel = 1;
+
+std::size_t TotalSize(auto ram) {
+    std::size_t size = 0;
+    for (const auto region : ram) {
+        size += region.size();
+    }
+    return size;
+}
+
+} // Anonymous namespace
+
+RewindBuffer::RewindBuffer(std::size_t memory_budget_) : memory_budget{memory_budget_} {}
+
+RewindBuffer::~RewindBuffer() = default;
+
+void RewindBuffer::Push(std::string state, std::span<const std::span<const u8>> ram) {
+    const std::size_t ram_size = TotalSize(ram);
+    if (reference.size() != ram_size) {
+        // The deltas of the stored snapshots only apply to the RAM layout they were taken from.
+        Clear();
+        reference.assign(ram_size, 0);
+    }
+    scratch.resize(ChunkSize);
+
+    Snapshot snapshot{.state = std::move(state), .chunks = {}, .size = 0};
+    u8* reference_chunk = reference.data();
+    for (const auto region : ram) {
+        for (std::size_t offset = 0; offset < region.size(); offset += ChunkSize) {
+            const std::size_t length = std::min(ChunkSize, region.size() - offset);
+            const u8* current = region.data() + offset;
+            auto& chunk = snapshot.chunks.emplace_back();
+            if (std::memcmp(current, reference_chunk, length) != 0) {
+                for (std::size_t i = 0; i < length; i++) {
+                    scratch[i] = current[i] ^ reference_chunk[i];
+                }
+                chunk = Common::Compression::CompressDataZSTD({scratch.data(), length},
+                                                              DeltaCompressionLevel);
+                std::memcpy(reference_chunk, current, length);
+                snapshot.size += chunk.size();
+            }
+            reference_chunk += length;
+        }
+    }
+    snapshot.size += snapshot.state.size() + snapshot.chunks.size() * sizeof(std::vector<u8>);
+
+    stored_size += snapshot.size;
+    snapshots.push_back(std::move(snapshot));
+    while (stored_size > memory_budget && snapshots.size() > 1) {
+        stored_size -= snapshots.front().size;
+        snapshots.pop_front();
+    }
+}
+
+bool RewindBuffer::Pop(std::span<const std::span<u8>> ram) {
+    if (snapshots.empty()) {
+        return false;
+    }
+    if (TotalSize(ram) != reference.size()) {
+        LOG_ERROR(Core, "RAM layout changed since the rewind snapshots were taken");
+        Clear();
+        return false;
+    }
+
+    Snapshot snapshot = std::move(snapshots.back());
+    snapshots.pop_back();
+    stored_size -= snapshot.size;
+
+    // The reference holds the RAM of this snapshot, applying its deltas turns it into the RAM of
+    // the snapshot before.
+    u8* reference_chunk = reference.data();
+    auto chunk = snapshot.chunks.begin();
+    for (const auto region : ram) {
+        std::memcpy(region.data(), reference_chunk, region.size());
+        for (std::size_t offset = 0; offset < region.size(); offset += ChunkSize, ++chunk) {
+            const std::size_t length = std::min(ChunkSize, region.size() - offset);
+            if (!chunk->empty()) {
+                const auto delta = Common::Compression::DecompressDataZSTD(*chunk);
+                for (std::size_t i = 0; i < std::min(length, delta.size()); i++) {
+                    reference_chunk[i] ^= delta[i];
+                }
+            }
+            reference_chunk += length;
+        }
+    }
+    return true;
+}
+
+void RewindBuffer::Clear() {
+    snapshots.clear();
+    stored_size = 0;
+    reference.clear();
+    reference.shrink_to_fit();
+}
+
+} // namespace Core
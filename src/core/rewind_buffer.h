@@ -0,0 +1,82 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core {
+
+/**
+ * A ring of in-memory snapshots of the emulated system to step back through. The state of the
+ * system other than its RAM is kept as serialized, the RAM is split in chunks stored as the zstd
+ * compressed XOR with the RAM of the snapshot before. Chunks that did not change take no space.
+ *
+ * The RAM of the newest snapshot is kept uncompressed as the reference the deltas are applied
+ * to, so taking a snapshot and stepping back by one only touch the chunks that changed. The
+ * oldest snapshots are dropped once the stored snapshots exceed the memory budget.
+ */
+class RewindBuffer {
+public:
+    /// Size of the blocks RAM is compared and compressed in.
+    static constexpr std::size_t ChunkSize = 0x10000;
+
+    explicit RewindBuffer(std::size_t memory_budget);
+    ~RewindBuffer();
+
+    /**
+     * Stores a snapshot.
+     * @param state The serialized system, without its RAM.
+     * @param ram The RAM regions of the system, the same ones on every call.
+     */
+    void Push(std::string state, std::span<const std::span<const u8>> ram);
+
+    /// Returns the serialized system of the newest snapshot, the buffer must not be empty.
+    [[nodiscard]] const std::string& NewestState() const {
+        return snapshots.back().state;
+    }
+
+    /**
+     * Restores the RAM of the newest snapshot and removes it. The system is deserialized from
+     * NewestState first, as that recreates the memory the RAM is written to.
+     * @param ram The RAM regions to write to, matching the ones the snapshot was taken from.
+     * @return False if there was no snapshot to restore.
+     */
+    bool Pop(std::span<const std::span<u8>> ram);
+
+    /// Drops all the snapshots.
+    void Clear();
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return snapshots.empty();
+    }
+
+    [[nodiscard]] std::size_t Count() const noexcept {
+        return snapshots.size();
+    }
+
+    /// Returns the memory taken by the stored snapshots, excluding the reference RAM.
+    [[nodiscard]] std::size_t StoredSize() const noexcept {
+        return stored_size;
+    }
+
+private:
+    struct Snapshot {
+        std::string state;
+        std::vector<std::vector<u8>> chunks; ///< Compressed deltas, empty for unchanged chunks.
+        std::size_t size;
+    };
+
+    std::size_t memory_budget;
+    std::size_t stored_size{};
+    std::deque<Snapshot> snapshots;
+    std::vector<u8> reference; ///< The RAM of the newest snapshot, its regions concatenated.
+    std::vector<u8> scratch;
+};
+
+} // namespace Core
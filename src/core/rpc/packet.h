@@ -17,6 +17,9 @@ enum class PacketType : u32 {
     WriteMemory = 2,
     ProcessList = 3,
     SetGetProcess = 4,
+    PerfStats = 5,
+    ReadMemoryBatch = 6,
+    SubscribeMemory = 7,
 };
 
 struct PacketHeader {
@@ -33,6 +36,42 @@ struct ProcessInfo {
     std::array<u8, 8> process_name;
 };
 static_assert(sizeof(ProcessInfo) == 0x14, "Incorrect ProcessInfo size");
+
+/// Per system frame distribution of a measurement, times are in seconds
+struct FramePercentilesInfo {
+    float p50;
+    float p95;
+    float p99;
+    float max;
+};
+static_assert(sizeof(FramePercentilesInfo) == 0x10, "Incorrect FramePercentilesInfo size");
+
+struct PerfStatsInfo {
+    float system_fps;
+    float game_fps;
+    float emulation_speed;
+    u32 shader_compiles;
+    /// Frame, SVC, IPC, GPU, swap and JIT times, then shader compilations
+    std::array<FramePercentilesInfo, 7> frame_breakdown;
+    u32 num_services;
+};
+static_assert(sizeof(PerfStatsInfo) == 0x84, "Incorrect PerfStatsInfo size");
+
+/// IPC cost of one service, the most expensive ones follow PerfStatsInfo
+struct ServiceStatsInfo {
+    std::array<u8, 8> name;
+    float requests_per_frame;
+    float time_per_frame;
+    float max_time_per_frame;
+};
+static_assert(sizeof(ServiceStatsInfo) == 0x14, "Incorrect ServiceStatsInfo size");
+
+/// Memory range of a batched read or a subscription, follows a u32 count of ranges
+struct MemoryRange {
+    u32 address;
+    u32 size;
+};
+static_assert(sizeof(MemoryRange) == 0x8, "Incorrect MemoryRange size");
 #pragma pack(pop)
 
 constexpr u32 CURRENT_VERSION = 1;
@@ -41,6 +80,10 @@ constexpr u32 MAX_PACKET_DATA_SIZE = 1024;
 constexpr u32 MAX_PACKET_SIZE = MIN_PACKET_SIZE + MAX_PACKET_DATA_SIZE;
 constexpr u32 MAX_READ_SIZE = MAX_PACKET_DATA_SIZE;
 constexpr u32 MAX_PROCESSES_IN_LIST = (MAX_PACKET_DATA_SIZE - sizeof(u32)) / sizeof(ProcessInfo);
+constexpr u32 MAX_MEMORY_RANGES = (MAX_PACKET_DATA_SIZE - sizeof(u32)) / sizeof(MemoryRange);
+constexpr u32 MAX_SUBSCRIPTIONS = 16;
+constexpr u32 MAX_SERVICES_IN_PERF_STATS =
+    (MAX_PACKET_DATA_SIZE - sizeof(PerfStatsInfo)) / sizeof(ServiceStatsInfo);
 
 class Packet {
 public:
@@ -2,10 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <optional>
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/hle/kernel/process.h"
 #include "core/memory.h"
+#include "core/perf_stats.h"
 #include "core/rpc/packet.h"
 #include "core/rpc/rpc_server.h"
 
@@ -19,30 +22,126 @@ RPCServer::RPCServer(Core::System& system_) : system{system_} {
 
 RPCServer::~RPCServer() = default;
 
+namespace {
+
+/// Parses the count and the ranges of a batched read or a subscription, which read at most
+/// MAX_READ_SIZE bytes in total to fit in one reply.
+std::optional<std::vector<MemoryRange>> ParseRanges(Packet& packet) {
+    const auto packet_data = packet.GetPacketData();
+    u32 count = 0;
+    std::memcpy(&count, packet_data.data(), sizeof(count));
+    if (count > MAX_MEMORY_RANGES ||
+        packet.GetPacketDataSize() < sizeof(count) + count * sizeof(MemoryRange)) {
+        return std::nullopt;
+    }
+
+    std::vector<MemoryRange> ranges(count);
+    std::memcpy(ranges.data(), packet_data.data() + sizeof(count), count * sizeof(MemoryRange));
+    u64 total_size = 0;
+    for (const MemoryRange& range : ranges) {
+        if (range.size == 0) {
+            return std::nullopt;
+        }
+        total_size += range.size;
+    }
+    if (total_size > MAX_READ_SIZE) {
+        return std::nullopt;
+    }
+    return ranges;
+}
+
+u32 TotalSize(std::span<const MemoryRange> ranges) {
+    u32 size = 0;
+    for (const MemoryRange& range : ranges) {
+        size += range.size;
+    }
+    return size;
+}
+
+} // Anonymous namespace
+
+bool RPCServer::ReadRanges(std::span<const MemoryRange> ranges, u8* out_data) {
+    std::shared_ptr<Kernel::Process> process;
+    if (selected_pid != 0xFFFFFFFF) {
+        process = system.Kernel().GetProcessById(selected_pid);
+        if (!process) {
+            LOG_ERROR(RPC_Server, "Selected process does not exist.");
+            return false;
+        }
+    }
+
+    for (const MemoryRange& range : ranges) {
+        if (process) {
+            system.Memory().ReadBlock(*process, range.address, out_data, range.size);
+        } else {
+            system.Memory().ReadBlock(range.address, out_data, range.size);
+        }
+        out_data += range.size;
+    }
+    return true;
+}
+
 void RPCServer::HandleReadMemory(Packet& packet, u32 address, u32 data_size) {
     if (data_size > MAX_READ_SIZE) {
         return;
     }
-    u32 read_size = data_size;
+    const MemoryRange range{address, data_size};
 
     // Note: Memory read occurs asynchronously from the state of the emulator
     if (selected_pid == 0xFFFFFFFF) {
         LOG_ERROR(RPC_Server, "No target process selected, memory access may be invalid.");
-        system.Memory().ReadBlock(address, packet.GetPacketData().data(), data_size);
-    } else {
-        auto process = system.Kernel().GetProcessById(selected_pid);
-        if (process) {
-            system.Memory().ReadBlock(*process, address, packet.GetPacketData().data(), data_size);
-        } else {
-            LOG_ERROR(RPC_Server, "Selected process does not exist.");
-            read_size = 0;
-        }
     }
+    const bool read = ReadRanges({&range, 1}, packet.GetPacketData().data());
+
+    packet.SetPacketDataSize(read ? data_size : 0);
+    packet.SendReply();
+}
+
+void RPCServer::HandleReadMemoryBatch(Packet& packet, std::span<const MemoryRange> ranges) {
+    // Note: Memory read occurs asynchronously from the state of the emulator
+    if (selected_pid == 0xFFFFFFFF) {
+        LOG_ERROR(RPC_Server, "No target process selected, memory access may be invalid.");
+    }
+    const bool read = ReadRanges(ranges, packet.GetPacketData().data());
 
-    packet.SetPacketDataSize(read_size);
+    packet.SetPacketDataSize(read ? TotalSize(ranges) : 0);
     packet.SendReply();
 }
 
+void RPCServer::HandleSubscribeMemory(std::unique_ptr<Packet> packet,
+                                      std::vector<MemoryRange> ranges) {
+    // Subscriptions are identified by their request id. Subscribing again with the same id
+    // replaces the ranges, subscribing without ranges cancels the subscription.
+    std::scoped_lock lock{subscription_mutex};
+    const auto it = std::ranges::find_if(subscriptions, [&](const Subscription& subscription) {
+        return subscription.packet->GetId() == packet->GetId();
+    });
+    if (it != subscriptions.end()) {
+        subscriptions.erase(it);
+    }
+    const bool accepted = ranges.empty() || subscriptions.size() < MAX_SUBSCRIPTIONS;
+
+    // The reply holds 1 if the request was applied and 0 if there are too many subscriptions.
+    const u32 result = accepted ? 1 : 0;
+    std::memcpy(packet->GetPacketData().data(), &result, sizeof(result));
+    packet->SetPacketDataSize(sizeof(result));
+    packet->SendReply();
+
+    if (accepted && !ranges.empty()) {
+        subscriptions.push_back({std::move(packet), std::move(ranges)});
+    }
+}
+
+void RPCServer::PushSubscriptions() {
+    std::scoped_lock lock{subscription_mutex};
+    for (const Subscription& subscription : subscriptions) {
+        Packet& packet = *subscription.packet;
+        const bool read = ReadRanges(subscription.ranges, packet.GetPacketData().data());
+        packet.SetPacketDataSize(read ? TotalSize(subscription.ranges) : 0);
+        packet.SendReply();
+    }
+}
+
 void RPCServer::HandleWriteMemory(Packet& packet, u32 address, std::span<const u8> data) {
     // Only allow writing to certain memory regions
     if ((address >= Memory::PROCESS_IMAGE_VADDR && address <= Memory::PROCESS_IMAGE_VADDR_END) ||
@@ -115,6 +214,59 @@ void RPCServer::HandleSetGetProcess(Packet& packet, u32 operation, u32 process_i
     packet.SendReply();
 }
 
+void RPCServer::HandlePerfStats(Packet& packet) {
+    // The frontends reset the stats periodically, this reports their last period.
+    const PerfStats::Results results =
+        system.perf_stats ? system.perf_stats->GetLastStats() : PerfStats::Results{};
+
+    const auto to_info = [](const PerfStats::FramePercentiles& percentiles) {
+        return FramePercentilesInfo{
+            .p50 = static_cast<float>(percentiles.p50),
+            .p95 = static_cast<float>(percentiles.p95),
+            .p99 = static_cast<float>(percentiles.p99),
+            .max = static_cast<float>(percentiles.max),
+        };
+    };
+    const auto& breakdown = results.frame_breakdown;
+    const u32 num_services =
+        std::min(static_cast<u32>(results.ipc_services.size()), MAX_SERVICES_IN_PERF_STATS);
+    const PerfStatsInfo info{
+        .system_fps = static_cast<float>(results.system_fps),
+        .game_fps = static_cast<float>(results.game_fps),
+        .emulation_speed = static_cast<float>(results.emulation_speed),
+        .shader_compiles = results.shader_compiles,
+        .frame_breakdown = {to_info(breakdown.frame), to_info(breakdown.svc),
+                            to_info(breakdown.ipc), to_info(breakdown.gpu),
+                            to_info(breakdown.swap), to_info(breakdown.jit),
+                            to_info(breakdown.shader_compiles)},
+        .num_services = num_services,
+    };
+
+    u8* out_data = packet.GetPacketData().data();
+    u32 written_bytes = 0;
+
+    memcpy(out_data + written_bytes, &info, sizeof(info));
+    written_bytes += sizeof(info);
+
+    for (u32 i = 0; i < num_services; i++) {
+        const auto& service = results.ipc_services[i];
+        ServiceStatsInfo service_info{
+            .name = {},
+            .requests_per_frame = static_cast<float>(service.requests_per_frame),
+            .time_per_frame = static_cast<float>(service.time_per_frame),
+            .max_time_per_frame = static_cast<float>(service.max_time_per_frame),
+        };
+        memcpy(service_info.name.data(), service.name.data(),
+               std::min(service.name.size(), service_info.name.size()));
+
+        memcpy(out_data + written_bytes, &service_info, sizeof(ServiceStatsInfo));
+        written_bytes += sizeof(ServiceStatsInfo);
+    }
+
+    packet.SetPacketDataSize(written_bytes);
+    packet.SendReply();
+}
+
 bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
     if (packet_header.version <= CURRENT_VERSION) {
         switch (packet_header.packet_type) {
@@ -122,10 +274,18 @@ bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
         case PacketType::WriteMemory:
         case PacketType::ProcessList:
         case PacketType::SetGetProcess:
+        case PacketType::PerfStats:
             if (packet_header.packet_size >= (sizeof(u32) * 2)) {
                 return true;
             }
             break;
+        case PacketType::ReadMemoryBatch:
+        case PacketType::SubscribeMemory:
+            // These start with the count of the ranges that follow.
+            if (packet_header.packet_size >= sizeof(u32)) {
+                return true;
+            }
+            break;
         default:
             break;
         }
@@ -138,7 +298,7 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
     const auto packet_data = request_packet->GetPacketData();
 
     if (ValidatePacket(request_packet->GetHeader())) {
-        // Currently, all request types use to arguments
+        // Most request types use two arguments
         u32 arg1 = 0;
         u32 arg2 = 0;
         std::memcpy(&arg1, packet_data.data(), sizeof(arg1));
@@ -166,6 +326,22 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
             HandleSetGetProcess(*request_packet, arg1, arg2);
             success = true;
             break;
+        case PacketType::PerfStats:
+            HandlePerfStats(*request_packet);
+            success = true;
+            break;
+        case PacketType::ReadMemoryBatch:
+            if (auto ranges = ParseRanges(*request_packet); ranges && !ranges->empty()) {
+                HandleReadMemoryBatch(*request_packet, *ranges);
+                success = true;
+            }
+            break;
+        case PacketType::SubscribeMemory:
+            if (auto ranges = ParseRanges(*request_packet)) {
+                HandleSubscribeMemory(std::move(request_packet), std::move(*ranges));
+                success = true;
+            }
+            break;
         default:
             break;
         }
@@ -6,7 +6,9 @@
 
 #include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <span>
+#include <vector>
 #include "common/polyfill_thread.h"
 #include "common/threadsafe_queue.h"
 
@@ -17,6 +19,7 @@ class System;
 namespace Core::RPC {
 
 class Packet;
+struct MemoryRange;
 struct PacketHeader;
 
 class RPCServer {
@@ -26,11 +29,25 @@ public:
 
     void QueueRequest(std::unique_ptr<RPC::Packet> request);
 
+    /// Sends the memory ranges of every subscription to its client, called once per frame.
+    void PushSubscriptions();
+
 private:
+    struct Subscription {
+        std::unique_ptr<Packet> packet;
+        std::vector<MemoryRange> ranges;
+    };
+
+    /// Reads the ranges back to back, returns false if the selected process does not exist.
+    bool ReadRanges(std::span<const MemoryRange> ranges, u8* out_data);
+
     void HandleReadMemory(Packet& packet, u32 address, u32 data_size);
+    void HandleReadMemoryBatch(Packet& packet, std::span<const MemoryRange> ranges);
+    void HandleSubscribeMemory(std::unique_ptr<Packet> packet, std::vector<MemoryRange> ranges);
     void HandleWriteMemory(Packet& packet, u32 address, std::span<const u8> data);
     void HandleProcessList(Packet& packet, u32 start_index, u32 max_amount);
     void HandleSetGetProcess(Packet& packet, u32 operation, u32 process_id);
+    void HandlePerfStats(Packet& packet);
     bool ValidatePacket(const PacketHeader& packet_header);
     void HandleSingleRequest(std::unique_ptr<Packet> request);
     void HandleRequestsLoop(std::stop_token stop_token);
@@ -40,6 +57,9 @@ private:
     Common::SPSCQueue<std::unique_ptr<Packet>, true> request_queue;
     std::jthread request_handler_thread;
     u32 selected_pid = 0xFFFFFFFF;
+
+    std::mutex subscription_mutex;
+    std::vector<Subscription> subscriptions;
 };
 
 } // namespace Core::RPC
@@ -38,4 +38,8 @@ void Server::NewRequestCallback(std::unique_ptr<RPC::Packet> new_request) {
     rpc_server.QueueRequest(std::move(new_request));
 }
 
+void Server::PushSubscriptions() {
+    rpc_server.PushSubscriptions();
+}
+
 }; // namespace Core::RPC
@@ -23,6 +23,9 @@ public:
 
     void NewRequestCallback(std::unique_ptr<Packet> new_request);
 
+    /// Sends the memory subscriptions of the clients, called once per frame.
+    void PushSubscriptions();
+
 private:
     RPCServer rpc_server;
     std::unique_ptr<UDPServer> udp_server;
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <mutex>
 #include <thread>
 #include <boost/asio.hpp>
 #include "common/common_types.h"
@@ -66,8 +67,12 @@ private:
         std::memcpy(reply_buffer.data() + (4 * sizeof(u32)), reply_packet.GetPacketData().data(),
                     reply_packet.GetPacketDataSize());
 
+        // Subscriptions are pushed from the emulation thread while requests are answered.
         boost::system::error_code error;
-        socket.send_to(boost::asio::buffer(reply_buffer), endpoint, 0, error);
+        {
+            std::scoped_lock lock{send_mutex};
+            socket.send_to(boost::asio::buffer(reply_buffer), endpoint, 0, error);
+        }
 
         if (error) {
             LOG_WARNING(RPC_Server, "Failed to send reply: {}", error.message());
@@ -84,6 +89,7 @@ private:
     boost::asio::ip::udp::socket socket;
     std::array<u8, MAX_PACKET_SIZE> request_buffer;
     boost::asio::ip::udp::endpoint remote_endpoint;
+    std::mutex send_mutex;
 
     std::function<void(std::unique_ptr<Packet>)> new_request_callback;
 };
@@ -2,22 +2,37 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
+#include <thread>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/serialization/binary_object.hpp>
+#include <boost/serialization/vector.hpp>
 #include <cryptopp/hex.h>
 #include <fmt/ranges.h>
 #include "common/archives.h"
 #include "common/file_util.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
+#include "common/memory_detect.h"
 #include "common/scm_rev.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
 #include "common/swap.h"
 #include "common/zstd_compression.h"
 #include "core/core.h"
+#include "core/core_timing.h"
 #include "core/loader/loader.h"
+#include "core/memory.h"
 #include "core/movie.h"
+#include "core/rewind_buffer.h"
 #include "core/savestate.h"
 #include "core/savestate_data.h"
 #include "network/network.h"
+#include "video_core/gpu.h"
+#include "video_core/rasterizer_interface.h"
 
 namespace Core {
 
@@ -29,14 +44,68 @@ struct CSTHeader {
     u64_le time;                   /// The time when this save state was created
     std::array<u8, 20> build_name; /// The build name (Canary/Nightly) with the version number
     u32_le zero = 0;               /// Should be zero, just in case.
+    u32_le num_surfaces = 0;       /// Number of surface descriptors at the end of the file
+    u64_le base_id = 0;            /// Base the RAM pages are stored against, 0 if the RAM is whole
 
-    std::array<u8, 192> reserved{}; /// Make heading 256 bytes so it has consistent size
+    std::array<u8, 180> reserved{}; /// Make heading 256 bytes so it has consistent size
 };
 static_assert(sizeof(CSTHeader) == 256, "CSTHeader should be 256 bytes");
+
+struct CSBHeader {
+    std::array<u8, 4> filetype; /// Unique Identifier to check the file type (always "CSB"0x1B)
+    u32_le zero = 0;            /// Should be zero, just in case.
+    u64_le id;                  /// Matches the base_id of the save states stored against it
+    u64_le ram_size;            /// Size of the RAM that follows compressed
+};
+static_assert(sizeof(CSBHeader) == 24, "CSBHeader should be 24 bytes");
 #pragma pack(pop)
 
 constexpr std::array<u8, 4> header_magic_bytes{{'C', 'S', 'T', 0x1B}};
 
+/// Movie checkpoints are taken while recording, the fastest level keeps them from stalling it.
+constexpr s32 MovieCheckpointCompressionLevel = 1;
+
+/// Most surfaces recorded in a save state, a handful of frames rarely touch more than this.
+constexpr std::size_t MaxSavedSurfaces = 1024;
+
+constexpr std::array<u8, 4> base_header_magic_bytes{{'C', 'S', 'B', 0x1B}};
+
+/// Incremental save states store the whole RAM again once this share of the pages changed.
+constexpr std::size_t RebaseDirtyPageRatio = 2;
+
+static std::string GetSaveStateBasePath(const std::string& path) {
+    return path + ".base";
+}
+
+/// Returns the id of the base written next to the save state at path, 0 if there is none.
+static u64 ReadSaveStateBaseId(const std::string& path) {
+    FileUtil::IOFile file(GetSaveStateBasePath(path), "rb");
+    CSBHeader header;
+    if (!file || file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.filetype != base_header_magic_bytes) {
+        return 0;
+    }
+    return header.id;
+}
+
+static void HashPages(std::vector<u64>& hashes, std::span<const u8> ram) {
+    for (std::size_t offset = 0; offset < ram.size(); offset += Memory::CITRA_PAGE_SIZE) {
+        hashes.push_back(Common::ComputeHash64(ram.data() + offset, Memory::CITRA_PAGE_SIZE));
+    }
+}
+
+/// Returns the given page of the RAM regions, counting the pages of all regions in order.
+static u8* GetRamPage(std::span<const std::span<u8>> ram, std::size_t page) {
+    for (const auto region : ram) {
+        const std::size_t num_pages = region.size() / Memory::CITRA_PAGE_SIZE;
+        if (page < num_pages) {
+            return region.data() + page * Memory::CITRA_PAGE_SIZE;
+        }
+        page -= num_pages;
+    }
+    return nullptr;
+}
+
 static std::string GetSaveStatePath(u64 program_id, u64 movie_id, u32 slot) {
     if (movie_id) {
         return fmt::format("{}{:016X}.movie{:016X}.{:02d}.cst",
@@ -129,14 +198,8 @@ void System::SaveState(u32 slot) const {
         }
     }
 
-    std::ostringstream sstream{std::ios_base::binary};
-    // Serialize
-    oarchive oa{sstream};
-    oa&* this;
-
-    const std::string& str{sstream.str()};
-    const auto data = std::span<const u8>{reinterpret_cast<const u8*>(str.data()), str.size()};
-    auto buffer = Common::Compression::CompressDataZSTDDefault(data);
+    // Only one state is in flight at a time, so a slot is never written twice at once.
+    WaitForSaveStateWrite();
 
     const u64 movie_id = movie.GetCurrentMovieID();
     const auto path = GetSaveStatePath(title_id, movie_id, slot);
@@ -144,11 +207,67 @@ void System::SaveState(u32 slot) const {
         throw std::runtime_error("Could not create path " + path);
     }
 
-    FileUtil::IOFile file(path, "wb");
-    if (!file) {
-        throw std::runtime_error("Could not open file " + path);
+    // Serializing clears the rasterizer cache, so the surfaces in use are recorded first.
+    std::vector<VideoCore::SurfaceDescriptor> surfaces;
+    if (Settings::values.prewarm_savestate_surfaces) {
+        surfaces = gpu->GetSurfaceDescriptors(MaxSavedSurfaces);
+    }
+
+    // Incremental states store only the RAM pages that differ from the base written next to the
+    // slot. Writes from the JIT go straight to host memory, so the pages are compared by hash.
+    const auto ram = memory->GetSerializedRam();
+    std::vector<u32> dirty_pages;
+    std::vector<u8> base_ram;
+    u64 base_id = 0;
+    if (Settings::values.incremental_savestates) {
+        std::vector<u64> page_hashes;
+        for (const auto region : ram) {
+            HashPages(page_hashes, region);
+        }
+
+        SaveStateBase& base = save_state_bases[path];
+        bool rebase = base.page_hashes.size() != page_hashes.size() ||
+                      ReadSaveStateBaseId(path) != base.id;
+        for (u32 page = 0; page < page_hashes.size() && !rebase; page++) {
+            if (page_hashes[page] != base.page_hashes[page]) {
+                dirty_pages.push_back(page);
+                rebase = dirty_pages.size() * RebaseDirtyPageRatio > page_hashes.size();
+            }
+        }
+        if (rebase) {
+            dirty_pages.clear();
+            for (const auto region : ram) {
+                base_ram.insert(base_ram.end(), region.begin(), region.end());
+            }
+            const u64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::system_clock::now().time_since_epoch())
+                                .count();
+            base.id = std::max<u64>(now, base.id + 1);
+            base.page_hashes = std::move(page_hashes);
+        }
+        base_id = base.id;
+    }
+
+    std::ostringstream sstream{std::ios_base::binary};
+    {
+        serialize_ram = base_id == 0;
+        SCOPE_EXIT({ serialize_ram = true; });
+
+        // Serialize
+        oarchive oa{sstream};
+        oa&* this;
+        if (base_id != 0) {
+            oa & dirty_pages;
+            for (const u32 page : dirty_pages) {
+                oa& boost::serialization::make_binary_object(GetRamPage(ram, page),
+                                                             Memory::CITRA_PAGE_SIZE);
+            }
+        }
     }
 
+    // Moving the buffer out of the stream avoids a copy of the whole serialized system.
+    std::string data = std::move(sstream).str();
+
     CSTHeader header{};
     header.filetype = header_magic_bytes;
     header.program_id = title_id;
@@ -163,10 +282,71 @@ void System::SaveState(u32 slot) const {
     std::memset(header.build_name.data(), 0, sizeof(header.build_name));
     std::memcpy(header.build_name.data(), build_fullname.c_str(),
                 std::min(build_fullname.length(), sizeof(header.build_name) - 1));
+    header.num_surfaces = static_cast<u32>(surfaces.size());
+    header.base_id = base_id;
+
+    if (!save_state_writer) {
+        save_state_writer = std::make_unique<Common::ThreadWorker>(1, "SaveStateWriter");
+    }
+    save_state_writer->QueueWork([data = std::move(data), surfaces = std::move(surfaces),
+                                  base_ram = std::move(base_ram), header, path] {
+        // The writer is already off the emulation thread, the extra zstd workers only shorten
+        // how long the uncompressed state is kept alive.
+        const u32 num_workers = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+
+        // A new base is written before the state stored against it, and both only replace the
+        // previous files once complete.
+        const std::string base_path = GetSaveStateBasePath(path);
+        const std::string base_temp_path = base_path + ".tmp";
+        if (!base_ram.empty()) {
+            const CSBHeader base_header{
+                .filetype = base_header_magic_bytes,
+                .id = header.base_id,
+                .ram_size = base_ram.size(),
+            };
+            FileUtil::IOFile file(base_temp_path, "wb");
+            if (!file || file.WriteObject(base_header) != 1 ||
+                !Common::Compression::CompressDataZSTDToFile(base_ram, file, num_workers)) {
+                LOG_ERROR(Core, "Could not write save state base to {}", base_temp_path);
+                return;
+            }
+        }
+
+        // Write next to the slot and replace it once complete, so that listing the save states
+        // meanwhile never sees a partial file. The compressed data is streamed straight to it.
+        const std::string temp_path = path + ".tmp";
+        {
+            FileUtil::IOFile file(temp_path, "wb");
+            if (!file || file.WriteBytes(&header, sizeof(header)) != sizeof(header) ||
+                !Common::Compression::CompressDataZSTDToFile(
+                    std::span<const u8>{reinterpret_cast<const u8*>(data.data()), data.size()},
+                    file, num_workers) ||
+                file.WriteArray(surfaces.data(), surfaces.size()) != surfaces.size()) {
+                LOG_ERROR(Core, "Could not write save state to {}", temp_path);
+                return;
+            }
+        }
+        if (!base_ram.empty()) {
+            if (FileUtil::Exists(base_path)) {
+                FileUtil::Delete(base_path);
+            }
+            if (!FileUtil::Rename(base_temp_path, base_path)) {
+                LOG_ERROR(Core, "Could not move save state base to {}", base_path);
+                return;
+            }
+        }
+        if (FileUtil::Exists(path)) {
+            FileUtil::Delete(path);
+        }
+        if (!FileUtil::Rename(temp_path, path)) {
+            LOG_ERROR(Core, "Could not move save state to {}", path);
+        }
+    });
+}
 
-    if (file.WriteBytes(&header, sizeof(header)) != sizeof(header) ||
-        file.WriteBytes(buffer.data(), buffer.size()) != buffer.size()) {
-        throw std::runtime_error("Could not write to file " + path);
+void System::WaitForSaveStateWrite() const {
+    if (save_state_writer) {
+        save_state_writer->WaitForRequests();
     }
 }
 
@@ -180,13 +360,15 @@ void System::LoadState(u32 slot) {
         throw std::runtime_error("Unable to load while connected to multiplayer");
     }
 
+    WaitForSaveStateWrite();
+
     const u64 movie_id = movie.GetCurrentMovieID();
     const auto path = GetSaveStatePath(title_id, movie_id, slot);
 
     std::vector<u8> decompressed;
+    std::vector<VideoCore::SurfaceDescriptor> surfaces;
+    u64 base_id = 0;
     {
-        std::vector<u8> buffer(FileUtil::GetSize(path) - sizeof(CSTHeader));
-
         FileUtil::IOFile file(path, "rb");
 
         // load header
@@ -201,20 +383,313 @@ void System::LoadState(u32 slot) {
         if (!ValidateSaveState(header, info, title_id, movie_id)) {
             throw std::runtime_error("Invalid savestate");
         }
+        base_id = header.base_id;
 
-        if (file.ReadBytes(buffer.data(), buffer.size()) != buffer.size()) {
-            throw std::runtime_error("Could not read from file at " + path);
+        // Decompressing while reading never holds the whole compressed state in memory.
+        decompressed = Common::Compression::DecompressDataZSTDFromFile(file);
+        if (decompressed.empty()) {
+            throw std::runtime_error("Could not decompress save state at " + path);
+        }
+
+        // The surfaces follow the compressed state, which older builds stop reading at.
+        const u64 surfaces_size = u64{header.num_surfaces} * sizeof(VideoCore::SurfaceDescriptor);
+        if (Settings::values.prewarm_savestate_surfaces && header.num_surfaces != 0 &&
+            header.num_surfaces <= MaxSavedSurfaces && file.GetSize() >= surfaces_size) {
+            surfaces.resize(header.num_surfaces);
+            if (file.ReadAtArray(surfaces.data(), surfaces.size(),
+                                 file.GetSize() - surfaces_size) != surfaces.size()) {
+                LOG_WARNING(Core, "Could not read the surfaces of save state {}", path);
+                surfaces.clear();
+            }
         }
-        decompressed = Common::Compression::DecompressDataZSTD(buffer);
     }
-    std::istringstream sstream{
-        std::string{reinterpret_cast<char*>(decompressed.data()), decompressed.size()},
-        std::ios_base::binary};
-    decompressed.clear();
 
-    // Deserialize
-    iarchive ia{sstream};
-    ia&* this;
+    // The base is checked before deserializing, as the system can't be restored without it.
+    std::vector<u8> base_ram;
+    if (base_id != 0) {
+        const std::string base_path = GetSaveStateBasePath(path);
+        FileUtil::IOFile file(base_path, "rb");
+        CSBHeader base_header;
+        if (file.ReadBytes(&base_header, sizeof(base_header)) != sizeof(base_header) ||
+            base_header.filetype != base_header_magic_bytes || base_header.id != base_id) {
+            throw std::runtime_error("Save state base at " + base_path + " is missing or stale");
+        }
+        base_ram = Common::Compression::DecompressDataZSTDFromFile(file);
+        if (base_ram.size() != base_header.ram_size) {
+            throw std::runtime_error("Could not decompress save state base at " + base_path);
+        }
+    }
+
+    // Reading the archive from the decompressed buffer in place avoids copying it to a string.
+    boost::iostreams::stream<boost::iostreams::array_source> sstream{
+        reinterpret_cast<const char*>(decompressed.data()), decompressed.size()};
+    {
+        serialize_ram = base_id == 0;
+        SCOPE_EXIT({ serialize_ram = true; });
+
+        // Deserialize
+        iarchive ia{sstream};
+        ia&* this;
+
+        if (base_id != 0) {
+            // Deserializing recreated the memory system, the base and the pages stored against it
+            // go into the new one.
+            const auto ram = memory->GetSerializedRam();
+            std::size_t ram_size = 0;
+            for (const auto region : ram) {
+                ram_size += region.size();
+            }
+            if (ram_size != base_ram.size()) {
+                throw std::runtime_error("Save state base doesn't match the emulated RAM");
+            }
+            const u8* base_region = base_ram.data();
+            for (const auto region : ram) {
+                std::memcpy(region.data(), base_region, region.size());
+                base_region += region.size();
+            }
+
+            std::vector<u32> dirty_pages;
+            ia & dirty_pages;
+            for (const u32 page : dirty_pages) {
+                u8* const dest = GetRamPage(ram, page);
+                if (!dest) {
+                    throw std::runtime_error("Save state stores a page outside the emulated RAM");
+                }
+                ia& boost::serialization::make_binary_object(dest, Memory::CITRA_PAGE_SIZE);
+            }
+            // Nothing may keep what it read from the RAM before it was restored.
+            gpu->ClearAll(false);
+
+            // Saving to the slot again only needs the pages that differ from the same base.
+            SaveStateBase& base = save_state_bases[path];
+            base.id = base_id;
+            base.page_hashes.clear();
+            HashPages(base.page_hashes, base_ram);
+        }
+    }
+
+    // Uploading the surfaces the state used right away spares the first frames after the load
+    // from recreating them one draw at a time.
+    if (!surfaces.empty()) {
+        gpu->PrewarmSurfaces(surfaces);
+    }
+
+    // The rewind snapshots belong to the timeline the save state replaced.
+    if (rewind_buffer) {
+        rewind_buffer->Clear();
+        ScheduleRewindSnapshot();
+    }
+    movie_checkpoint_frames = 0;
+}
+
+void System::ScheduleRewindSnapshot() {
+    const u64 interval = std::max(Settings::values.rewind_interval.GetValue(), 1U);
+    timing->RemoveEvent(rewind_snapshot_event);
+    timing->ScheduleEvent(static_cast<s64>(interval * VideoCore::FRAME_TICKS),
+                          rewind_snapshot_event);
+}
+
+void System::TakeRewindSnapshot() {
+    ScheduleRewindSnapshot();
+    // Under memory pressure the history is dropped, and the buffer starts over from here.
+    if (const u64 trim_count = Common::GetMemoryTrimCount(); trim_count != rewind_trim_count) {
+        rewind_trim_count = trim_count;
+        rewind_buffer->Clear();
+    }
+    try {
+        if (app_loader && !app_loader->SupportsSaveStates()) {
+            throw std::runtime_error("The current app loader doesn't support save states");
+        }
+
+        // The RAM dominates a save state and mostly doesn't change between snapshots, so only the
+        // rest of the system goes through the archive and the buffer stores RAM as deltas.
+        std::ostringstream sstream{std::ios_base::binary};
+        serialize_ram = false;
+        SCOPE_EXIT({ serialize_ram = true; });
+        {
+            oarchive oa{sstream};
+            oa&* this;
+        }
+
+        const auto ram = memory->GetSerializedRam();
+        const std::array<std::span<const u8>, 3> regions{ram[0], ram[1], ram[2]};
+        rewind_buffer->Push(std::move(sstream).str(), regions);
+    } catch (const std::exception& e) {
+        LOG_ERROR(Core, "Disabling rewind, could not take a snapshot: {}", e.what());
+        rewind_buffer.reset();
+    }
+}
+
+void System::RewindToSnapshot() {
+    if (rewind_buffer->IsEmpty()) {
+        LOG_INFO(Core, "No rewind snapshot left");
+        return;
+    }
+    if (Network::GetRoomMember().lock()->IsConnected()) {
+        throw std::runtime_error("Unable to rewind while connected to multiplayer");
+    }
+
+    {
+        const std::string& state = rewind_buffer->NewestState();
+        boost::iostreams::stream<boost::iostreams::array_source> sstream{state.data(),
+                                                                         state.size()};
+        serialize_ram = false;
+        SCOPE_EXIT({ serialize_ram = true; });
+        iarchive ia{sstream};
+        ia&* this;
+    }
+
+    // Deserializing recreated the memory system, the RAM of the snapshot goes into the new one.
+    if (!rewind_buffer->Pop(memory->GetSerializedRam())) {
+        throw std::runtime_error("Could not restore the RAM of the rewind snapshot");
+    }
+    // Nothing may keep what it read from the RAM the system was recreated with.
+    gpu->ClearAll(false);
+    ScheduleRewindSnapshot();
+}
+
+void System::TakeBootSnapshot() {
+    try {
+        if (app_loader && !app_loader->SupportsSaveStates()) {
+            throw std::runtime_error("The current app loader doesn't support save states");
+        }
+
+        auto snapshot = std::make_unique<BootSnapshot>();
+        snapshot->path = m_filepath;
+        std::ostringstream sstream{std::ios_base::binary};
+        serialize_ram = false;
+        SCOPE_EXIT({ serialize_ram = true; });
+        {
+            oarchive oa{sstream};
+            oa&* this;
+        }
+        snapshot->state = std::move(sstream).str();
+
+        const auto ram = memory->GetSerializedRam();
+        for (std::size_t i = 0; i < ram.size(); i++) {
+            snapshot->ram[i] = std::make_unique<Common::HostMemorySnapshot>(ram[i]);
+        }
+        boot_snapshot = std::move(snapshot);
+        LOG_INFO(Core, "Took the boot snapshot of {}", m_filepath);
+    } catch (const std::exception& e) {
+        LOG_ERROR(Core, "Could not take the boot snapshot: {}", e.what());
+    }
+}
+
+bool System::RestoreBootSnapshot() {
+    if (!boot_snapshot || !IsPoweredOn() || boot_snapshot->path != m_filepath ||
+        !m_chainloadpath.empty() || kernel->AreAsyncOperationsPending() ||
+        Network::GetRoomMember().lock()->IsConnected()) {
+        return false;
+    }
+
+    try {
+        const std::string& state = boot_snapshot->state;
+        boost::iostreams::stream<boost::iostreams::array_source> sstream{state.data(),
+                                                                         state.size()};
+        serialize_ram = false;
+        SCOPE_EXIT({ serialize_ram = true; });
+        iarchive ia{sstream};
+        ia&* this;
+    } catch (const std::exception& e) {
+        // The system is left half restored, booting the title again recreates all of it.
+        LOG_ERROR(Core, "Could not restore the boot snapshot: {}", e.what());
+        boot_snapshot.reset();
+        return false;
+    }
+
+    // Deserializing recreated the memory system, the RAM of the snapshot is mapped into the new
+    // one and only gets copied where the title writes to it.
+    const auto ram = memory->GetSerializedRam();
+    for (std::size_t i = 0; i < ram.size(); i++) {
+        boot_snapshot->ram[i]->Restore(ram[i]);
+    }
+    gpu->ClearAll(false);
+    if (rewind_buffer) {
+        rewind_buffer->Clear();
+        ScheduleRewindSnapshot();
+    }
+    perf_stats->BeginSystemFrame();
+    LOG_INFO(Core, "Restored the boot snapshot of {}", m_filepath);
+    return true;
+}
+
+void System::StartMovieCheckpoints() {
+    movie_checkpoint_frames = 0;
+    if (movie.GetPlayMode() == Movie::PlayMode::Recording &&
+        Settings::values.movie_checkpoint_interval.GetValue() != 0) {
+        attention_flags.fetch_or(AttentionMovie, std::memory_order_relaxed);
+    }
+}
+
+void System::CountMovieCheckpointFrame() {
+    // Taken between slices once requested, so unlike a timing event this doesn't change how
+    // recording and playback split the emulation into slices.
+    const u32 interval = Settings::values.movie_checkpoint_interval.GetValue();
+    if (interval == 0 || movie.GetPlayMode() != Movie::PlayMode::Recording) {
+        return;
+    }
+    if (++movie_checkpoint_frames >= interval) {
+        attention_flags.fetch_or(AttentionMovie, std::memory_order_relaxed);
+    }
+}
+
+void System::TakeMovieCheckpoint() {
+    movie_checkpoint_frames = 0;
+    try {
+        if (app_loader && !app_loader->SupportsSaveStates()) {
+            throw std::runtime_error("The current app loader doesn't support save states");
+        }
+
+        std::ostringstream sstream{std::ios_base::binary};
+        movie.SetCheckpointSerialization(true);
+        SCOPE_EXIT({ movie.SetCheckpointSerialization(false); });
+        {
+            oarchive oa{sstream};
+            oa&* this;
+        }
+
+        const std::string data = std::move(sstream).str();
+        movie.AddCheckpoint(Common::Compression::CompressDataZSTD(
+            std::span<const u8>{reinterpret_cast<const u8*>(data.data()), data.size()},
+            MovieCheckpointCompressionLevel));
+    } catch (const std::exception& e) {
+        LOG_ERROR(Core, "Could not take a movie checkpoint: {}", e.what());
+    }
+}
+
+void System::SeekMovie(u64 input_index) {
+    const bool finished = movie.GetPlayMode() == Movie::PlayMode::MovieFinished;
+    if (movie.GetPlayMode() != Movie::PlayMode::Playing && !finished) {
+        throw std::runtime_error("Seeking requires a movie being played back");
+    }
+
+    // Playing on is cheaper than loading a checkpoint the playback already went past.
+    const u64 current_index = movie.GetCurrentInputIndex();
+    u64 checkpoint_index = 0;
+    const std::vector<u8> state = movie.ReadCheckpoint(input_index, checkpoint_index);
+    if (!state.empty() &&
+        (finished || input_index < current_index || checkpoint_index > current_index)) {
+        const std::vector<u8> decompressed = Common::Compression::DecompressDataZSTD(state);
+        if (decompressed.empty()) {
+            throw std::runtime_error("Could not decompress the movie checkpoint");
+        }
+        boost::iostreams::stream<boost::iostreams::array_source> sstream{
+            reinterpret_cast<const char*>(decompressed.data()), decompressed.size()};
+        movie.SetCheckpointSerialization(true);
+        SCOPE_EXIT({ movie.SetCheckpointSerialization(false); });
+        iarchive ia{sstream};
+        ia&* this;
+
+        if (rewind_buffer) {
+            rewind_buffer->Clear();
+            ScheduleRewindSnapshot();
+        }
+        LOG_INFO(Core, "Loaded the movie checkpoint at input {}", checkpoint_index);
+    } else if (finished || input_index < current_index) {
+        throw std::runtime_error("No movie checkpoint before the input to seek to");
+    }
+    movie.SetSeekTarget(input_index);
 }
 
 } // namespace Core
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <string>
 #include <vector>
 #include "common/common_types.h"
+#include "common/host_memory.h"
 
 namespace Core {
 
@@ -20,6 +23,20 @@ struct SaveStateInfo {
     std::string build_name;
 };
 
+/// The RAM of the base written next to a slot, incremental save states of the slot only store the
+/// pages that differ from it.
+struct SaveStateBase {
+    u64 id{};
+    std::vector<u64> page_hashes;
+};
+
+/// The system right after a title booted, which resets restore instead of booting it again.
+struct BootSnapshot {
+    std::string path;  ///< The file the title was booted from
+    std::string state; ///< The serialized system, without its RAM
+    std::array<std::unique_ptr<Common::HostMemorySnapshot>, 3> ram; ///< See GetSerializedRam
+};
+
 constexpr u32 SaveStateSlotCount = 11; // Maximum count of savestate slots
 
 std::vector<SaveStateInfo> ListSaveStates(u64 program_id, u64 movie_id);
@@ -0,0 +1,118 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "core/tick_profile.h"
+
+namespace Core {
+
+namespace {
+
+// Samples spending at least this fraction of the frame in guest code are considered CPU-bound.
+constexpr double CpuBoundThreshold = 0.5;
+
+std::string GetProfilePath(u64 title_id) {
+    return fmt::format("{}tick_profiles/{:016X}.txt",
+                       FileUtil::GetUserPath(FileUtil::UserPath::ConfigDir), title_id);
+}
+
+} // Anonymous namespace
+
+std::optional<TickProfile> TickProfile::Load(u64 title_id) {
+    const std::string path = GetProfilePath(title_id);
+    std::string contents;
+    if (!FileUtil::Exists(path) || FileUtil::ReadFileToString(true, path, contents) == 0) {
+        return std::nullopt;
+    }
+
+    TickProfile profile{};
+    std::istringstream stream{contents};
+    for (std::string line; std::getline(stream, line);) {
+        line = Common::StripSpaces(line.substr(0, line.find('#')));
+        const auto separator = line.find('=');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        const std::string key = Common::StripSpaces(line.substr(0, separator));
+        const std::string value = Common::StripSpaces(line.substr(separator + 1));
+        try {
+            if (key == "clock_percentage") {
+                profile.clock_percentage = static_cast<u32>(std::stoul(value));
+            } else if (key == "calibrated") {
+                profile.calibrated = std::stoul(value) != 0;
+            } else {
+                LOG_WARNING(Core, "Unknown tick profile key '{}' in {}", key, path);
+            }
+        } catch (const std::exception&) {
+            LOG_ERROR(Core, "Invalid value '{}' for '{}' in {}", value, key, path);
+        }
+    }
+
+    if (profile.clock_percentage == 0) {
+        LOG_ERROR(Core, "Ignoring tick profile {} with a zero clock percentage", path);
+        return std::nullopt;
+    }
+    LOG_INFO(Core, "Loaded tick profile for {:016X}: clock {}%", title_id,
+             profile.clock_percentage);
+    return profile;
+}
+
+bool TickProfile::Save(u64 title_id) const {
+    const std::string path = GetProfilePath(title_id);
+    if (!FileUtil::CreateFullPath(path)) {
+        return false;
+    }
+    const std::string contents =
+        fmt::format("# Azahar tick profile\nclock_percentage = {}\ncalibrated = {}\n",
+                    clock_percentage, calibrated ? 1 : 0);
+    return FileUtil::WriteStringToFile(true, path, contents) == contents.size();
+}
+
+u32 GetEffectiveClockPercentage(u32 setting_percentage, const std::optional<TickProfile>& profile) {
+    if (!profile) {
+        return setting_percentage;
+    }
+    const u64 percentage = static_cast<u64>(setting_percentage) * profile->clock_percentage / 100;
+    return static_cast<u32>(std::clamp<u64>(percentage, 5, 400));
+}
+
+void TickCalibrator::AddSample(double emulation_speed, double cpu_time_fraction) {
+    // Skip intervals without any emulated progress, such as while paused or loading.
+    if (!(emulation_speed > 0.0)) {
+        return;
+    }
+    ++samples;
+    if (cpu_time_fraction >= CpuBoundThreshold) {
+        ++cpu_bound_samples;
+        cpu_bound_speed_sum += std::min(emulation_speed, 1.0);
+    }
+}
+
+std::optional<TickProfile> TickCalibrator::Derive(const std::optional<TickProfile>& current) const {
+    if (samples < MinSamples) {
+        return std::nullopt;
+    }
+    TickProfile profile{};
+    profile.calibrated = true;
+
+    // Titles that are mostly limited by something else than the CPU stay at full accuracy.
+    if (cpu_bound_samples * 2 < samples) {
+        return profile;
+    }
+    const double mean_speed = cpu_bound_speed_sum / cpu_bound_samples;
+    const u32 current_percentage = current ? current->clock_percentage : 100;
+    profile.clock_percentage =
+        std::clamp(static_cast<u32>(std::floor(current_percentage * mean_speed)),
+                   std::min(MinClockPercentage, current_percentage), current_percentage);
+    return profile;
+}
+
+} // namespace Core
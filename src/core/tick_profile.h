@@ -0,0 +1,68 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include "common/common_types.h"
+
+namespace Core {
+
+/**
+ * Per-title scaling of the emulated CPU clock, applied on top of the cpu_clock_percentage
+ * setting. CPU-bound titles can be underclocked through their profile while timing-sensitive
+ * ones keep running at full accuracy.
+ *
+ * Profiles are stored as `<config dir>/tick_profiles/<title id>.txt` and contain `key = value`
+ * lines, `#` starting a comment.
+ */
+struct TickProfile {
+    /// Clock percentage relative to the cpu_clock_percentage setting
+    u32 clock_percentage = 100;
+    /// Whether the profile was derived by a calibration run instead of written by hand
+    bool calibrated = false;
+
+    /// Loads the profile of the given title, returns nullopt if it has none
+    static std::optional<TickProfile> Load(u64 title_id);
+
+    /// Writes the profile of the given title, returns true on success
+    bool Save(u64 title_id) const;
+};
+
+/// Returns the clock percentage to use given the global setting and an optional title profile.
+u32 GetEffectiveClockPercentage(u32 setting_percentage, const std::optional<TickProfile>& profile);
+
+/**
+ * Derives a tick profile from the performance of a running title. A sample is taken every time
+ * the perf stats are collected, titles that spend most of their frame time executing guest code
+ * while running below full speed get underclocked by the speed they are missing.
+ */
+class TickCalibrator {
+public:
+    /// Minimum number of samples before a profile can be derived
+    static constexpr u32 MinSamples = 10;
+
+    /// Lowest clock percentage a calibration run may produce
+    static constexpr u32 MinClockPercentage = 50;
+
+    /**
+     * Records a sample.
+     * @param emulation_speed Ratio of emulated time to walltime over the sampled interval.
+     * @param cpu_time_fraction Fraction of the frame time spent outside of HLE, GPU and swap.
+     */
+    void AddSample(double emulation_speed, double cpu_time_fraction);
+
+    /**
+     * Derives the profile from the recorded samples.
+     * @param current Profile the samples were taken with, if any.
+     */
+    [[nodiscard]] std::optional<TickProfile> Derive(const std::optional<TickProfile>& current) const;
+
+private:
+    u32 samples = 0;
+    u32 cpu_bound_samples = 0;
+    double cpu_bound_speed_sum = 0.0;
+};
+
+} // namespace Core
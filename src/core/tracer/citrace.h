@@ -10,6 +10,9 @@ namespace CiTrace {
 
 // NOTE: Things are stored in little-endian
 
+/// Physical address of the GPU register file, the address of a register write is relative to it.
+constexpr u32 GPURegistersBase = 0x10400000;
+
 #pragma pack(1)
 
 struct CTHeader {
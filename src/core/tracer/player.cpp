@@ -0,0 +1,178 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/memory.h"
+#include "core/perf_stats.h"
+#include "core/tracer/player.h"
+#include "video_core/gpu.h"
+#include "video_core/pica/pica_core.h"
+#include "video_core/renderer_base.h"
+
+namespace CiTrace {
+
+namespace {
+
+/// Virtual address the GPU registers are mapped at, register writes are replayed through it.
+constexpr VAddr VADDR_GPU = 0x1EF00000;
+
+constexpr u32 INTERNAL_REGS_INDEX = static_cast<u32>(GPU_REG_INDEX(internal));
+
+} // Anonymous namespace
+
+Player::Player(Core::System& system_) : system{system_} {}
+
+Player::~Player() = default;
+
+bool Player::Load(const std::string& filename) {
+    FileUtil::IOFile file(filename, "rb");
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open CiTrace file {}", filename);
+        return false;
+    }
+
+    data.resize(file.GetSize());
+    if (data.size() < sizeof(CTHeader) || file.ReadBytes(data.data(), data.size()) != data.size()) {
+        LOG_ERROR(HW_GPU, "Failed to read CiTrace file {}", filename);
+        return false;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(CTHeader));
+    if (std::memcmp(header.magic, CTHeader::ExpectedMagicWord(), 4) != 0 ||
+        header.version != CTHeader::ExpectedVersion()) {
+        LOG_ERROR(HW_GPU, "{} is not a CiTrace file of version {}", filename,
+                  CTHeader::ExpectedVersion());
+        return false;
+    }
+
+    const u64 stream_end =
+        static_cast<u64>(header.stream_offset) + header.stream_size * sizeof(CTStreamElement);
+    if (stream_end > data.size()) {
+        LOG_ERROR(HW_GPU, "CiTrace file {} is truncated", filename);
+        return false;
+    }
+    stream = std::span{reinterpret_cast<const CTStreamElement*>(data.data() + header.stream_offset),
+                       header.stream_size};
+    return true;
+}
+
+Player::Stats Player::Replay() {
+    using Clock = std::chrono::steady_clock;
+
+    ApplyInitialState();
+
+    Stats stats{};
+    double total_frame_time = 0.0;
+    stats.min_frame_time = std::numeric_limits<double>::max();
+    auto frame_start = Clock::now();
+
+    for (const CTStreamElement& element : stream) {
+        switch (element.type) {
+        case FrameMarker: {
+            system.GPU().Renderer().SwapBuffers();
+            system.perf_stats->EndGameFrame();
+            const auto frame_end = Clock::now();
+            const double frame_time =
+                std::chrono::duration<double>(frame_end - frame_start).count();
+            stats.frames++;
+            stats.min_frame_time = std::min(stats.min_frame_time, frame_time);
+            stats.max_frame_time = std::max(stats.max_frame_time, frame_time);
+            total_frame_time += frame_time;
+            frame_start = frame_end;
+            break;
+        }
+        case MemoryLoad: {
+            const CTMemoryLoad& load = element.memory_load;
+            u8* dest = system.Memory().GetPhysicalPointer(load.physical_address);
+            if (!dest || static_cast<u64>(load.file_offset) + load.size > data.size()) {
+                LOG_ERROR(HW_GPU, "Skipping invalid memory load to {:#010X}",
+                          load.physical_address);
+                break;
+            }
+            std::memcpy(dest, data.data() + load.file_offset, load.size);
+            system.GPU().InvalidateRegion(load.physical_address, load.size);
+            stats.upload_bytes += load.size;
+            break;
+        }
+        case RegisterWrite:
+            stats.draws += WriteRegister(element.register_write) ? 1 : 0;
+            break;
+        default:
+            LOG_ERROR(HW_GPU, "Unknown CiTrace stream element {:#X}",
+                      static_cast<u32>(element.type));
+            break;
+        }
+    }
+
+    if (stats.frames == 0) {
+        stats.min_frame_time = 0.0;
+    } else {
+        stats.mean_frame_time = total_frame_time / stats.frames;
+    }
+    return stats;
+}
+
+std::span<const u32> Player::GetArray(u32 offset, u32 size) const {
+    if (static_cast<u64>(offset) + static_cast<u64>(size) * sizeof(u32) > data.size()) {
+        LOG_ERROR(HW_GPU, "Initial state array at {:#X} is out of bounds", offset);
+        return {};
+    }
+    return std::span{reinterpret_cast<const u32*>(data.data() + offset), size};
+}
+
+void Player::ApplyInitialState() {
+    const auto& initial = header.initial_state_offsets;
+    auto& pica = system.GPU().PicaCore();
+
+    const auto copy = [](auto& dest, std::span<const u32> source) {
+        const std::size_t size = std::min(source.size_bytes(), sizeof(dest));
+        std::memcpy(std::addressof(dest), source.data(), size);
+    };
+    copy(pica.regs_lcd, GetArray(initial.lcd_registers, initial.lcd_registers_size));
+    copy(pica.regs.reg_array, GetArray(initial.pica_registers, initial.pica_registers_size));
+    copy(pica.vs_setup.program_code,
+         GetArray(initial.vs_program_binary, initial.vs_program_binary_size));
+    copy(pica.vs_setup.swizzle_data,
+         GetArray(initial.vs_swizzle_data, initial.vs_swizzle_data_size));
+    pica.vs_setup.MarkProgramCodeDirty();
+    pica.vs_setup.MarkSwizzleDataDirty();
+
+    // Attributes and uniforms are stored as raw 24-bit floats, four components each.
+    const auto decode = [](auto& dest, std::span<const u32> source) {
+        for (std::size_t i = 0; i < std::min(dest.size(), source.size() / 4); i++) {
+            for (std::size_t comp = 0; comp < 4; comp++) {
+                dest[i][comp] = Pica::f24::FromRaw(source[4 * i + comp]);
+            }
+        }
+    };
+    decode(pica.input_default_attributes,
+           GetArray(initial.default_attributes, initial.default_attributes_size));
+    decode(pica.vs_setup.uniforms.f,
+           GetArray(initial.vs_float_uniforms, initial.vs_float_uniforms_size));
+    pica.vs_setup.uniforms_dirty = true;
+
+    pica.dirty_regs.SetAll();
+}
+
+bool Player::WriteRegister(const CTRegisterWrite& write) {
+    const u32 index = (write.physical_address - GPURegistersBase) / sizeof(u32);
+    if (index < INTERNAL_REGS_INDEX) {
+        system.GPU().WriteReg(VADDR_GPU + index * static_cast<u32>(sizeof(u32)), write.value);
+        return false;
+    }
+
+    // Internal registers are replayed as command list writes, so that they trigger draws.
+    const u32 id = index - INTERNAL_REGS_INDEX;
+    system.GPU().PicaCore().WriteInternalReg(id, write.value, 0xF);
+    return id == PICA_REG_INDEX(pipeline.trigger_draw) ||
+           id == PICA_REG_INDEX(pipeline.trigger_draw_indexed);
+}
+
+} // namespace CiTrace
@@ -0,0 +1,60 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "core/tracer/citrace.h"
+
+namespace Core {
+class System;
+}
+
+namespace CiTrace {
+
+/**
+ * Replays a recorded CiTrace against the renderer of a running system. The initial state is
+ * restored before every replay, so a trace may be replayed several times to time the renderer.
+ */
+class Player {
+public:
+    struct Stats {
+        u32 frames;             ///< Frame markers replayed.
+        u32 draws;              ///< Draw calls triggered by the replayed command lists.
+        u64 upload_bytes;       ///< Bytes of guest memory loaded from the trace.
+        double min_frame_time;  ///< Shortest frame, in seconds.
+        double mean_frame_time; ///< Mean frame time, in seconds.
+        double max_frame_time;  ///< Longest frame, in seconds.
+    };
+
+    explicit Player(Core::System& system);
+    ~Player();
+
+    /// Reads the provided trace file, returns false when it is not a valid trace.
+    bool Load(const std::string& filename);
+
+    /// Restores the initial state of the trace and replays its stream once.
+    Stats Replay();
+
+private:
+    /// Returns the u32 array at the provided offset of the trace file.
+    std::span<const u32> GetArray(u32 offset, u32 size) const;
+
+    /// Writes the recorded initial state to the GPU.
+    void ApplyInitialState();
+
+    /// Writes a recorded register to the GPU, returns true when the write triggered a draw.
+    bool WriteRegister(const CTRegisterWrite& write);
+
+private:
+    Core::System& system;
+    std::vector<u8> data;
+    CTHeader header{};
+    std::span<const CTStreamElement> stream;
+};
+
+} // namespace CiTrace
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <functional>
@@ -19,6 +20,8 @@
 #include "common/logging/log.h"
 #include "common/math_util.h"
 #include "common/param_package.h"
+#include "common/seqlock.h"
+#include "common/settings.h"
 #include "common/threadsafe_queue.h"
 #include "core/frontend/input.h"
 #include "input_common/sdl/sdl_impl.h"
@@ -183,28 +186,46 @@ public:
     }
 
     void SetButton(int button, bool value) {
+        if (button < 0 || button >= MaxButtons) {
+            return;
+        }
         std::lock_guard lock{mutex};
-        state.buttons[button] = value;
+        const u64 bit = u64{1} << (button % 64);
+        state.buttons[button / 64] = value ? state.buttons[button / 64] | bit
+                                           : state.buttons[button / 64] & ~bit;
+        published_state.Store(state);
     }
 
     bool GetButton(int button) const {
-        std::lock_guard lock{mutex};
-        return state.buttons.at(button);
+        if (button < 0 || button >= MaxButtons) {
+            return false;
+        }
+        return ((published_state.Load().buttons[button / 64] >> (button % 64)) & 1) != 0;
     }
 
     void SetAxis(int axis, Sint16 value) {
+        if (axis < 0 || axis >= MaxAxes) {
+            return;
+        }
         std::lock_guard lock{mutex};
         state.axes[axis] = value;
+        published_state.Store(state);
     }
 
     float GetAxis(int axis) const {
-        std::lock_guard lock{mutex};
-        return state.axes.at(axis) / 32767.0f;
+        if (axis < 0 || axis >= MaxAxes) {
+            return 0.0f;
+        }
+        return published_state.Load().axes[axis] / 32767.0f;
     }
 
     std::tuple<float, float> GetAnalog(int axis_x, int axis_y) const {
-        float x = GetAxis(axis_x);
-        float y = GetAxis(axis_y);
+        const State current = published_state.Load();
+        const auto get_axis = [&current](int axis) {
+            return axis >= 0 && axis < MaxAxes ? current.axes[axis] / 32767.0f : 0.0f;
+        };
+        float x = get_axis(axis_x);
+        float y = get_axis(axis_y);
         y = -y; // 3DS uses an y-axis inverse from SDL
 
         // Make sure the coordinates are in the unit circle,
@@ -220,13 +241,19 @@ public:
     }
 
     void SetHat(int hat, Uint8 direction) {
+        if (hat < 0 || hat >= MaxHats) {
+            return;
+        }
         std::lock_guard lock{mutex};
         state.hats[hat] = direction;
+        published_state.Store(state);
     }
 
     bool GetHatDirection(int hat, Uint8 direction) const {
-        std::lock_guard lock{mutex};
-        return (state.hats.at(hat) & direction) != 0;
+        if (hat < 0 || hat >= MaxHats) {
+            return false;
+        }
+        return (published_state.Load().hats[hat] & direction) != 0;
     }
 
     void SetAccel(const float x, const float y, const float z) {
@@ -234,16 +261,18 @@ public:
         state.accel.x = x;
         state.accel.y = y;
         state.accel.z = z;
+        published_state.Store(state);
     }
     void SetGyro(const float pitch, const float yaw, const float roll) {
         std::lock_guard lock{mutex};
         state.gyro.x = pitch;
         state.gyro.y = yaw;
         state.gyro.z = roll;
+        published_state.Store(state);
     }
     std::tuple<Common::Vec3<float>, Common::Vec3<float>> GetMotion() const {
-        std::lock_guard lock{mutex};
-        return std::make_tuple(state.accel, state.gyro);
+        const State current = published_state.Load();
+        return std::make_tuple(current.accel, current.gyro);
     }
 
     /**
@@ -274,20 +303,29 @@ public:
     }
 
 private:
+    // Inputs past these are ignored, no controller SDL supports comes close to them.
+    static constexpr int MaxButtons = 128;
+    static constexpr int MaxAxes = 32;
+    static constexpr int MaxHats = 8;
+
     struct State {
-        std::unordered_map<int, bool> buttons;
-        std::unordered_map<int, Sint16> axes;
-        std::unordered_map<int, Uint8> hats;
-        Common::Vec3<float> accel;
-        Common::Vec3<float> gyro;
-    } state;
+        std::array<u64, MaxButtons / 64> buttons{};
+        std::array<Sint16, MaxAxes> axes{};
+        std::array<Uint8, MaxHats> hats{};
+        Common::Vec3<float> accel{};
+        Common::Vec3<float> gyro{};
+    };
+    /// The state being built by the SDL event thread, guarded by the mutex.
+    State state;
+    /// The state read by the input devices on the emulation thread without locking.
+    Common::SeqLock<State> published_state;
     std::string guid;
     int port;
     bool has_gyro{false};
     bool has_accel{false};
     std::unique_ptr<SDL_Joystick, decltype(&SDL_JoystickClose)> sdl_joystick;
     std::unique_ptr<SDL_GameController, decltype(&SDL_GameControllerClose)> sdl_controller;
-    mutable std::mutex mutex;
+    std::mutex mutex;
 };
 
 struct SDLGameControllerDeleter {
@@ -733,8 +771,6 @@ public:
             } else {
                 direction = 0;
             }
-            // This is necessary so accessing GetHat with hat won't crash
-            joystick->SetHat(hat, SDL_HAT_CENTERED);
             return std::make_unique<SDLDirectionButton>(joystick, hat, direction);
         }
 
@@ -751,14 +787,10 @@ public:
                 trigger_if_greater = true;
                 LOG_ERROR(Input, "Unknown direction {}", direction_name);
             }
-            // This is necessary so accessing GetAxis with axis won't crash
-            joystick->SetAxis(axis, 0);
             return std::make_unique<SDLAxisButton>(joystick, axis, threshold, trigger_if_greater);
         }
 
         const int button = params.Get("button", 0);
-        // This is necessary so accessing GetButton with button won't crash
-        joystick->SetButton(button, false);
         return std::make_unique<SDLButton>(joystick, button);
     }
 
@@ -787,9 +819,6 @@ public:
 
         auto joystick = state.GetSDLJoystickByGUID(guid, port);
 
-        // This is necessary so accessing GetAxis with axis_x and axis_y won't crash
-        joystick->SetAxis(axis_x, 0);
-        joystick->SetAxis(axis_y, 0);
         return std::make_unique<SDLAnalog>(joystick, axis_x, axis_y, deadzone);
     }
 
@@ -858,7 +887,10 @@ SDLState::SDLState() {
             using namespace std::chrono_literals;
             while (initialized) {
                 SDL_PumpEvents();
-                std::this_thread::sleep_for(10ms);
+                // The state of the controllers is only as recent as the last pump, with late
+                // latch the HID samples it right before vblank and expects it to be fresh.
+                std::this_thread::sleep_for(Settings::values.input_late_latch.GetValue() ? 1ms
+                                                                                         : 10ms);
             }
         });
     }
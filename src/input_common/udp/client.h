@@ -12,6 +12,7 @@
 #include <thread>
 #include <tuple>
 #include "common/common_types.h"
+#include "common/seqlock.h"
 #include "common/thread.h"
 #include "common/vector_math.h"
 
@@ -29,9 +30,18 @@ struct Version;
 } // namespace Response
 
 struct DeviceStatus {
+    /// The last pad data received, published by the socket thread and read without locking.
+    struct PadStatus {
+        Common::Vec3<float> accel{};
+        Common::Vec3<float> gyro{};
+        float touch_x{};
+        float touch_y{};
+        bool touch_pressed{};
+    };
+    Common::SeqLock<PadStatus> pad_status;
+
+    /// Guards the touch calibration.
     std::mutex update_mutex;
-    std::tuple<Common::Vec3<float>, Common::Vec3<float>> motion_status;
-    std::tuple<float, float, bool> touch_status;
 
     // calibration data for scaling the device's touch area to 3ds
     struct CalibrationData {
@@ -5,6 +5,7 @@
 #include "artic_base_client.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/zstd_compression.h"
 
 #include "chrono"
 #include "limits.h"
@@ -311,6 +312,15 @@ bool Client::Connect() {
     }
     max_parameter_count = max_param_value;
 
+    if (compression_requested) {
+        const auto compression = SendSimpleRequest("COMPRESS");
+        if (compression == ArticBaseCommon::CompressionZSTD) {
+            LOG_INFO(Network, "Artic Base server compresses responses");
+        } else {
+            LOG_WARNING(Network, "Artic Base server does not support compressed responses");
+        }
+    }
+
     auto worker_ports = SendSimpleRequest("PORTS");
     if (!worker_ports.has_value()) {
         shutdown(main_socket, SHUT_RDWR);
@@ -447,28 +457,52 @@ std::optional<std::pair<void*, size_t>> Client::Response::GetResponseBuffer(u32
 }
 
 std::optional<Client::Response> Client::Send(Request& request) {
-    if (stopped)
-        return std::nullopt;
+    return std::move(SendMultiple({&request, 1}).front());
+}
 
-    request.request_packet.parameterCount = static_cast<u32>(request.parameters.size());
-    PendingResponse resp(request);
+std::vector<std::optional<Client::Response>> Client::SendMultiple(std::span<Request> requests) {
+    std::vector<std::optional<Response>> responses(requests.size());
+    if (stopped || requests.empty())
+        return responses;
 
+    std::vector<std::unique_ptr<PendingResponse>> pending;
+    pending.reserve(requests.size());
     {
         std::scoped_lock l(recv_map_mutex);
-        pending_responses[request.request_packet.requestID] = &resp;
+        for (Request& request : requests) {
+            request.request_packet.parameterCount = static_cast<u32>(request.parameters.size());
+            auto& resp = pending.emplace_back(new PendingResponse(request));
+            pending_responses[request.request_packet.requestID] = resp.get();
+        }
     }
 
-    auto respPacket = SendRequestPacket(request.request_packet, false, request.parameters);
-    if (stopped || !respPacket.has_value()) {
+    const auto send_time = std::chrono::steady_clock::now();
+    std::size_t sent = 0;
+    while (sent < requests.size() && !stopped &&
+           SendRequestPacket(requests[sent].request_packet, false, requests[sent].parameters)) {
+        sent++;
+    }
+    if (sent != requests.size()) {
+        // Requests that were sent are answered, or signaled once the handlers stop on the error.
         std::scoped_lock l(recv_map_mutex);
-        pending_responses.erase(request.request_packet.requestID);
-        return std::nullopt;
+        for (std::size_t i = sent; i < requests.size(); i++) {
+            pending_responses.erase(requests[i].request_packet.requestID);
+        }
     }
 
-    std::unique_lock cv_lk(resp.cv_mutex);
-    resp.cv.wait(cv_lk, [&resp]() { return resp.is_done; });
+    for (std::size_t i = 0; i < sent; i++) {
+        PendingResponse& resp = *pending[i];
+        std::unique_lock cv_lk(resp.cv_mutex);
+        resp.cv.wait(cv_lk, [&resp]() { return resp.is_done; });
+        responses[i] = std::move(resp.response);
+    }
 
-    return std::optional<Client::Response>(std::move(resp.response));
+    if (report_latency_callback && sent != 0) {
+        report_latency_callback(static_cast<u32>(sent),
+                                std::chrono::duration_cast<std::chrono::microseconds>(
+                                    std::chrono::steady_clock::now() - send_time));
+    }
+    return responses;
 }
 
 void Client::LogOnServer(ArticBaseCommon::LogOnServerType log_type, const std::string& message) {
@@ -765,8 +799,24 @@ void Client::Handler::RunLoop() {
                            "ArticBase Handler: Cannot allocate buffer");
                 pending_response->response.resp_data_size =
                     static_cast<size_t>(dataPacket.resp.bufferSize);
-                if (!client.Read(handler_socket, pending_response->response.resp_data_buffer,
-                                 dataPacket.resp.bufferSize)) {
+                if (dataPacket.resp.compressedSize) {
+                    std::vector<u8> compressed(dataPacket.resp.compressedSize);
+                    if (!client.Read(handler_socket, compressed.data(), compressed.size())) {
+                        signal_error();
+                        break;
+                    }
+                    const auto data = Common::Compression::DecompressDataZSTD(compressed);
+                    if (data.size() != pending_response->response.resp_data_size) {
+                        LOG_ERROR(Network, "Method {} sent a corrupted compressed response",
+                                  pending_response->request.method_name);
+                        signal_error();
+                        break;
+                    }
+                    std::memcpy(pending_response->response.resp_data_buffer, data.data(),
+                                data.size());
+                } else if (!client.Read(handler_socket,
+                                        pending_response->response.resp_data_buffer,
+                                        dataPacket.resp.bufferSize)) {
                     signal_error();
                 }
             }
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #pragma once
+#include "chrono"
 #include "condition_variable"
 #include "cstring"
 #include "functional"
@@ -10,6 +11,7 @@
 #include "memory"
 #include "mutex"
 #include "optional"
+#include "span"
 #include "string"
 #include "thread"
 #include "utility"
@@ -147,6 +149,13 @@ public:
         report_traffic_callback = callback;
     }
 
+    /// Sets the callback receiving the number of requests of each Send or SendMultiple call and
+    /// the time until all their responses arrived.
+    void SetArticReportLatencyCallback(
+        const std::function<void(u32, std::chrono::microseconds)>& callback) {
+        report_latency_callback = callback;
+    }
+
     void ReportArticEvent(u64 event) {
         if (report_artic_event_callback) {
             report_artic_event_callback(event);
@@ -165,6 +174,11 @@ public:
         ping_enabled = enable;
     }
 
+    /// Asks the server to compress responses on Connect. The server must support the request.
+    void SetCompressionRequested(bool request) {
+        compression_requested = request;
+    }
+
     void LogOnServer(ArticBaseCommon::LogOnServerType log_type, const std::string& message);
 
 private:
@@ -197,6 +211,7 @@ private:
     std::mutex ping_cv_mutex;
     std::atomic<bool> ping_run = true;
     bool ping_enabled = true;
+    bool compression_requested = false;
 
     void StopImpl(bool from_error);
 
@@ -210,6 +225,7 @@ private:
     bool Write(SocketHolder sockFD, const void* buffer, size_t size,
                const std::chrono::nanoseconds& timeout = std::chrono::nanoseconds(0));
     std::function<void(u32)> report_traffic_callback;
+    std::function<void(u32, std::chrono::microseconds)> report_latency_callback;
 
     std::optional<ArticBaseCommon::DataPacket> SendRequestPacket(
         const ArticBaseCommon::RequestPacket& req, bool expect_response,
@@ -343,6 +359,12 @@ public:
 
     std::optional<Response> Send(Request& request);
 
+    /**
+     * Sends all the requests before waiting for the first response, so that their round trips
+     * overlap instead of adding up. The responses are returned in the order of the requests.
+     */
+    std::vector<std::optional<Response>> SendMultiple(std::span<Request> requests);
+
 private:
     class PendingResponse {
     public:
@@ -67,6 +67,15 @@ struct Buffer {
 #pragma warning(pop)
 #endif
 
+/**
+ * Response compression, negotiated once the connection is set up. The client sends the simple
+ * request $COMPRESS, and a server answering it with CompressionZSTD may then send the buffer of
+ * any response as a single zstd frame, setting compressedSize to the size of the frame. The frame
+ * is sent in place of the buffer and decompresses to bufferSize bytes. Servers are expected to only
+ * compress buffers large enough and compressible enough to be worth it, at a fast level.
+ */
+constexpr char CompressionZSTD[] = "ZSTD";
+
 struct ResponseMethod {
     enum class ArticResult : u32 {
         SUCCESS = 0,
@@ -80,7 +89,8 @@ struct ResponseMethod {
         int provideInputBufferID;
     };
     int bufferSize{};
-    u8 padding[0x10]{};
+    u32 compressedSize{}; ///< Size of the compressed buffer, 0 if it was not compressed.
+    u8 padding[0xC]{};
 };
 
 struct DataPacket {
@@ -13,6 +13,11 @@ struct Values {
     std::string web_api_url;
     std::string citra_username;
     std::string citra_token;
+
+    // Multiplayer
+    /// Whether to send local wireless traffic directly to the other members that allow it,
+    /// instead of relaying it through the room.
+    bool direct_connections = false;
 } extern values;
 
 } // namespace NetSettings
@@ -25,9 +25,77 @@ u64 ntohll(u64 x) {
 }
 #endif
 
+namespace {
+
+/// Buffers larger than this are released instead of pooled, WifiPackets fit in it.
+constexpr std::size_t MaxPooledCapacity = 0x1000;
+/// Buffers kept per thread, about as many as packets are in flight in one loop iteration.
+constexpr std::size_t MaxPooledBuffers = 64;
+
+struct BufferPool {
+    std::vector<std::vector<char>> buffers;
+    ~BufferPool();
+};
+
+/// Set when the pool of the thread is gone, for packets destroyed at exit after it.
+thread_local bool buffer_pool_destroyed = false;
+
+BufferPool::~BufferPool() {
+    buffer_pool_destroyed = true;
+}
+
+std::vector<std::vector<char>>* GetBufferPool() {
+    if (buffer_pool_destroyed) {
+        return nullptr;
+    }
+    thread_local BufferPool pool;
+    return &pool.buffers;
+}
+
+} // Anonymous namespace
+
+Packet::~Packet() {
+    if (data.capacity() == 0 || data.capacity() > MaxPooledCapacity) {
+        return;
+    }
+    auto* pool = GetBufferPool();
+    if (pool && pool->size() < MaxPooledBuffers) {
+        data.clear();
+        pool->push_back(std::move(data));
+    }
+}
+
+Packet::Packet(const void* in_data, std::size_t size_in_bytes)
+    : external_data{static_cast<const char*>(in_data)}, external_size{size_in_bytes} {}
+
+void Packet::Reserve(std::size_t size_in_bytes) {
+    Detach();
+    if (data.capacity() == 0 && size_in_bytes <= MaxPooledCapacity) {
+        auto* pool = GetBufferPool();
+        if (pool && !pool->empty()) {
+            data = std::move(pool->back());
+            pool->pop_back();
+        }
+    }
+    data.reserve(size_in_bytes);
+}
+
+void Packet::Detach() {
+    if (external_data) {
+        const char* in_data = external_data;
+        external_data = nullptr;
+        data.assign(in_data, in_data + external_size);
+        external_size = 0;
+    }
+}
+
 void Packet::Append(const void* in_data, std::size_t size_in_bytes) {
+    Detach();
     if (in_data && (size_in_bytes > 0)) {
         std::size_t start = data.size();
+        if (data.capacity() == 0) {
+            Reserve(size_in_bytes);
+        }
         data.resize(start + size_in_bytes);
         std::memcpy(&data[start], in_data, size_in_bytes);
     }
@@ -35,19 +103,21 @@ void Packet::Append(const void* in_data, std::size_t size_in_bytes) {
 
 void Packet::Read(void* out_data, std::size_t size_in_bytes) {
     if (out_data && CheckSize(size_in_bytes)) {
-        std::memcpy(out_data, &data[read_pos], size_in_bytes);
+        std::memcpy(out_data, Bytes() + read_pos, size_in_bytes);
         read_pos += size_in_bytes;
     }
 }
 
 void Packet::Clear() {
+    external_data = nullptr;
+    external_size = 0;
     data.clear();
     read_pos = 0;
     is_valid = true;
 }
 
 const void* Packet::GetData() const {
-    return !data.empty() ? &data[0] : nullptr;
+    return GetDataSize() > 0 ? Bytes() : nullptr;
 }
 
 void Packet::IgnoreBytes(u32 length) {
@@ -55,11 +125,11 @@ void Packet::IgnoreBytes(u32 length) {
 }
 
 std::size_t Packet::GetDataSize() const {
-    return data.size();
+    return external_data ? external_size : data.size();
 }
 
 bool Packet::EndOfPacket() const {
-    return read_pos >= data.size();
+    return read_pos >= GetDataSize();
 }
 
 Packet::operator bool() const {
@@ -143,7 +213,7 @@ Packet& Packet::operator>>(char* out_data) {
 
     if ((length > 0) && CheckSize(length)) {
         // Then extract characters
-        std::memcpy(out_data, &data[read_pos], length);
+        std::memcpy(out_data, Bytes() + read_pos, length);
         out_data[length] = '\0';
 
         // Update reading position
@@ -161,7 +231,7 @@ Packet& Packet::operator>>(std::string& out_data) {
     out_data.clear();
     if ((length > 0) && CheckSize(length)) {
         // Then extract characters
-        out_data.assign(&data[read_pos], length);
+        out_data.assign(Bytes() + read_pos, length);
 
         // Update reading position
         read_pos += length;
@@ -255,7 +325,7 @@ Packet& Packet::operator<<(const std::string& in_data) {
 }
 
 bool Packet::CheckSize(std::size_t size) {
-    is_valid = is_valid && (read_pos + size <= data.size());
+    is_valid = is_valid && (read_pos + size <= GetDataSize());
 
     return is_valid;
 }
@@ -5,16 +5,44 @@
 #pragma once
 
 #include <array>
+#include <type_traits>
 #include <vector>
 #include "common/common_types.h"
 
 namespace Network {
 
-/// A class that serializes data for network transfer. It also handles endianess
+/// Types that are serialized as they are, which vectors and arrays are copied of at once.
+template <typename T>
+constexpr bool IsByte = std::is_same_v<T, u8> || std::is_same_v<T, s8>;
+
+/**
+ * A class that serializes data for network transfer. It also handles endianess
+ *
+ * The buffers of packets are kept in a small per-thread pool when they are destroyed, so the
+ * packets built over and over by the room and its members reuse them instead of allocating.
+ */
 class Packet {
 public:
     Packet() = default;
-    ~Packet() = default;
+    ~Packet();
+
+    /**
+     * Creates a packet that reads from received data in place instead of copying it.
+     * @param data Pointer to the received bytes, which must outlive the packet
+     * @param size_in_bytes Number of received bytes
+     */
+    Packet(const void* data, std::size_t size_in_bytes);
+
+    Packet(const Packet&) = default;
+    Packet& operator=(const Packet&) = default;
+    Packet(Packet&&) noexcept = default;
+    Packet& operator=(Packet&&) noexcept = default;
+
+    /**
+     * Reserves space for the data that is going to be appended, to allocate it only once.
+     * @param size_in_bytes Expected total size of the packet
+     */
+    void Reserve(std::size_t size_in_bytes);
 
     /**
      * Append data to the end of the packet
@@ -111,10 +139,20 @@ private:
      */
     bool CheckSize(std::size_t size);
 
+    /// Returns the bytes of the packet, either the read in place ones or the stored ones.
+    const char* Bytes() const {
+        return external_data ? external_data : data.data();
+    }
+
+    /// Copies the data read in place into the packet before it is modified.
+    void Detach();
+
     // Member data
-    std::vector<char> data;   ///< Data stored in the packet
-    std::size_t read_pos = 0; ///< Current reading position in the packet
-    bool is_valid = true;     ///< Reading state of the packet
+    std::vector<char> data;               ///< Data stored in the packet
+    const char* external_data = nullptr;  ///< Received data read in place, if any
+    std::size_t external_size = 0;        ///< Size of the received data read in place
+    std::size_t read_pos = 0;             ///< Current reading position in the packet
+    bool is_valid = true;                 ///< Reading state of the packet
 };
 
 template <typename T>
@@ -122,6 +160,15 @@ Packet& Packet::operator>>(std::vector<T>& out_data) {
     // First extract the size
     u32 size = 0;
     *this >> size;
+    if constexpr (IsByte<T>) {
+        // Bytes need no conversion, copy them at once
+        out_data.clear();
+        if (CheckSize(size)) {
+            out_data.resize(size);
+            Read(out_data.data(), size);
+        }
+        return *this;
+    }
     out_data.resize(size);
 
     // Then extract the data
@@ -135,6 +182,10 @@ Packet& Packet::operator>>(std::vector<T>& out_data) {
 
 template <typename T, std::size_t S>
 Packet& Packet::operator>>(std::array<T, S>& out_data) {
+    if constexpr (IsByte<T>) {
+        Read(out_data.data(), S);
+        return *this;
+    }
     for (std::size_t i = 0; i < out_data.size(); ++i) {
         T character;
         *this >> character;
@@ -149,6 +200,10 @@ Packet& Packet::operator<<(const std::vector<T>& in_data) {
     *this << static_cast<u32>(in_data.size());
 
     // Then insert the data
+    if constexpr (IsByte<T>) {
+        Append(in_data.data(), in_data.size());
+        return *this;
+    }
     for (std::size_t i = 0; i < in_data.size(); ++i) {
         *this << in_data[i];
     }
@@ -157,6 +212,10 @@ Packet& Packet::operator<<(const std::vector<T>& in_data) {
 
 template <typename T, std::size_t S>
 Packet& Packet::operator<<(const std::array<T, S>& in_data) {
+    if constexpr (IsByte<T>) {
+        Append(in_data.data(), S);
+        return *this;
+    }
     for (std::size_t i = 0; i < in_data.size(); ++i) {
         *this << in_data[i];
     }
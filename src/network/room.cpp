@@ -4,12 +4,14 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <random>
 #include <regex>
 #include <sstream>
 #include <thread>
 #include "common/logging/log.h"
+#include "common/thread_worker.h"
 #include "enet/enet.h"
 #include "network/packet.h"
 #include "network/room.h"
@@ -40,7 +42,15 @@ public:
         MacAddress mac_address;      ///< The assigned mac address of the member.
         /// Data of the user, often including authenticated forum username.
         VerifyUser::UserData user_data;
-        ENetPeer* peer; ///< The remote peer.
+        ENetPeer* peer;                  ///< The remote peer.
+        bool direct_connections = false; ///< Whether WifiPackets may be sent to it directly.
+
+        u32 round_trip_time = 0; ///< Copied from the peer on the room thread.
+        u32 data_in_transit = 0; ///< Copied from the peer on the room thread.
+        u64 packets_dropped = 0;
+        /// Packets received from the member since the start of the current one second window.
+        u32 window_packets = 0;
+        std::chrono::steady_clock::time_point window_start{};
     };
     using MemberList = std::vector<Member>;
     MemberList members;              ///< Information about the members of this room
@@ -60,17 +70,78 @@ public:
     /// Verification backend of the room
     std::unique_ptr<VerifyUser::Backend> verify_backend;
 
+    /// Runs the verification backend, which may wait on web requests, away from the room thread.
+    std::unique_ptr<Common::ThreadWorker> verify_worker;
+
+    struct VerifiedJoin {
+        ENetPeer* peer;
+        u32 connect_id; ///< Tells the peer apart from later connections reusing its slot.
+        Member member;
+    };
+    std::vector<VerifiedJoin> verified_joins; ///< Joins to be completed by the room thread.
+    std::mutex verified_joins_mutex;
+
+    /// What a client sent while its join was being verified, applied when the join completes.
+    struct PendingJoin {
+        ENetPeer* peer;
+        u32 connect_id;
+        GameInfo game_info;
+        bool direct_connections = false;
+    };
+    std::vector<PendingJoin> pending_joins; ///< Only accessed by the room thread.
+
+    std::atomic<u64> packets_received{};
+    std::atomic<u64> bytes_received{};
+    std::atomic<u64> packets_sent{};
+    std::atomic<u64> bytes_sent{};
+    std::atomic<u64> wifi_packets_relayed{};
+    std::atomic<u64> packets_dropped{};
+    std::atomic<u64> chat_messages_dropped{};
+
+    std::atomic<u32> max_member_packets_per_second{}; ///< See LoadLimits
+    std::atomic<u32> max_data_in_transit{};           ///< See LoadLimits
+
+    bool overloaded = false;               ///< Whether max_data_in_transit is exceeded.
+    bool room_information_pending = false; ///< Whether game changes were not broadcast yet.
+
     /// Thread function that will receive and dispatch messages until the room is destroyed.
     void ServerLoop();
     void StartLoop();
 
+    /// Dispatches a received ENet event to its handler.
+    void HandleEvent(ENetEvent& event);
+
+    /// Moves the traffic counted by ENet since the last call to the room totals.
+    void UpdateTrafficStats();
+
+    /// Copies the connection stats of the peers to the members and checks if the room is
+    /// overloaded.
+    void UpdateMemberStats();
+
+    /**
+     * Counts a WifiPacket or chat message received from a member against its packet rate.
+     * @returns Whether the packet should be handled, false if it exceeds the rate
+     */
+    bool AdmitPacket(const ENetPeer* client);
+
     /**
      * Parses and answers a room join request from a client.
      * Validates the uniqueness of the username and assigns the MAC address
-     * that the client will use for the remainder of the connection.
+     * that the client will use for the remainder of the connection. The user is then verified on
+     * the verification thread, and the join is completed by CompleteVerifiedJoins.
      */
     void HandleJoinRequest(const ENetEvent* event);
 
+    /**
+     * Adds the members verified since the last call to the room, checking again that they are
+     * still unique as other members may have joined during the verification.
+     */
+    void CompleteVerifiedJoins();
+    void CompleteJoin(VerifiedJoin& join);
+
+    /// Returns the join of the client that is still being verified, or nullptr if there is none.
+    PendingJoin* FindPendingJoin(const ENetPeer* client);
+
     /**
      * Parses and answers a kick request from a client.
      * Validates the permissions and that the given user exists and then kicks the member.
@@ -215,6 +286,24 @@ public:
      */
     void BroadcastRoomInformation();
 
+    /**
+     * Marks the member as accepting direct connections from the other members and sends the
+     * updated peer lists.
+     */
+    void HandleDirectConnectRequest(const ENetEvent* event);
+
+    /**
+     * Sends each member accepting direct connections the endpoints of the other ones, as seen by
+     * the room. The packet has the structure:
+     * <MessageID>IdDirectConnectPeers
+     * <u32> num_peers
+     * This is followed by the following three values for each peer:
+     * <MacAddress> mac_address of that member
+     * <u32> host of that member, in network byte order
+     * <u16> port of that member
+     */
+    void SendDirectConnectPeers();
+
     /**
      * Generates a free MAC address to assign to a new client.
      * The first 3 bytes are the NintendoOUI 0x00, 0x1F, 0x32
@@ -250,49 +339,136 @@ public:
 void Room::RoomImpl::ServerLoop() {
     while (state != State::Closed) {
         ENetEvent event;
-        if (enet_host_service(server, &event, 16) > 0) {
-            switch (event.type) {
-            case ENET_EVENT_TYPE_RECEIVE:
-                switch (event.packet->data[0]) {
-                case IdJoinRequest:
-                    HandleJoinRequest(&event);
-                    break;
-                case IdSetGameInfo:
-                    HandleGameNamePacket(&event);
-                    break;
-                case IdWifiPacket:
-                    HandleWifiPacket(&event);
-                    break;
-                case IdChatMessage:
-                    HandleChatPacket(&event);
-                    break;
-                // Moderation
-                case IdModKick:
-                    HandleModKickPacket(&event);
-                    break;
-                case IdModBan:
-                    HandleModBanPacket(&event);
-                    break;
-                case IdModUnban:
-                    HandleModUnbanPacket(&event);
-                    break;
-                case IdModGetBanList:
-                    HandleModGetBanListPacket(&event);
-                    break;
-                }
-                enet_packet_destroy(event.packet);
-                break;
-            case ENET_EVENT_TYPE_DISCONNECT:
-                HandleClientDisconnection(event.peer);
-                break;
-            case ENET_EVENT_TYPE_NONE:
-            case ENET_EVENT_TYPE_CONNECT:
-                break;
-            }
+        // Every event that is ready is handled before flushing, so that ENet sends the packets
+        // queued for each member in as few datagrams as possible.
+        int result = enet_host_service(server, &event, 16);
+        while (result > 0) {
+            HandleEvent(event);
+            result = enet_host_check_events(server, &event);
+        }
+        CompleteVerifiedJoins();
+        if (room_information_pending && !overloaded) {
+            BroadcastRoomInformation();
         }
+        enet_host_flush(server);
+        UpdateTrafficStats();
+        UpdateMemberStats();
     }
     // Close the connection to all members:
     SendCloseMessage();
+    UpdateTrafficStats();
+}
+
+void Room::RoomImpl::HandleEvent(ENetEvent& event) {
+    switch (event.type) {
+    case ENET_EVENT_TYPE_RECEIVE:
+        if ((event.packet->data[0] == IdWifiPacket || event.packet->data[0] == IdChatMessage) &&
+            !AdmitPacket(event.peer)) {
+            enet_packet_destroy(event.packet);
+            break;
+        }
+        switch (event.packet->data[0]) {
+        case IdJoinRequest:
+            HandleJoinRequest(&event);
+            break;
+        case IdSetGameInfo:
+            HandleGameNamePacket(&event);
+            break;
+        case IdWifiPacket:
+            HandleWifiPacket(&event);
+            break;
+        case IdChatMessage:
+            if (overloaded) {
+                chat_messages_dropped++;
+            } else {
+                HandleChatPacket(&event);
+            }
+            break;
+        // Moderation
+        case IdModKick:
+            HandleModKickPacket(&event);
+            break;
+        case IdModBan:
+            HandleModBanPacket(&event);
+            break;
+        case IdModUnban:
+            HandleModUnbanPacket(&event);
+            break;
+        case IdModGetBanList:
+            HandleModGetBanListPacket(&event);
+            break;
+        case IdDirectConnectRequest:
+            HandleDirectConnectRequest(&event);
+            break;
+        }
+        enet_packet_destroy(event.packet);
+        break;
+    case ENET_EVENT_TYPE_DISCONNECT:
+        HandleClientDisconnection(event.peer);
+        break;
+    case ENET_EVENT_TYPE_NONE:
+    case ENET_EVENT_TYPE_CONNECT:
+        break;
+    }
+}
+
+void Room::RoomImpl::UpdateTrafficStats() {
+    packets_received += server->totalReceivedPackets;
+    bytes_received += server->totalReceivedData;
+    packets_sent += server->totalSentPackets;
+    bytes_sent += server->totalSentData;
+    server->totalReceivedPackets = 0;
+    server->totalReceivedData = 0;
+    server->totalSentPackets = 0;
+    server->totalSentData = 0;
+}
+
+void Room::RoomImpl::UpdateMemberStats() {
+    u64 total_data_in_transit = 0;
+    {
+        std::lock_guard lock(member_mutex);
+        for (auto& member : members) {
+            member.round_trip_time = member.peer->roundTripTime;
+            member.data_in_transit = member.peer->reliableDataInTransit;
+            total_data_in_transit += member.data_in_transit;
+        }
+    }
+
+    const u32 max = max_data_in_transit;
+    const bool was_overloaded = overloaded;
+    overloaded = max != 0 && total_data_in_transit > max;
+    if (overloaded && !was_overloaded) {
+        LOG_WARNING(Network, "Room overloaded with {} bytes in transit, dropping chat messages",
+                    total_data_in_transit);
+    } else if (!overloaded && was_overloaded) {
+        LOG_INFO(Network, "Room recovered from overload");
+    }
+}
+
+bool Room::RoomImpl::AdmitPacket(const ENetPeer* client) {
+    const u32 max = max_member_packets_per_second;
+    if (max == 0) {
+        return true;
+    }
+    std::lock_guard lock(member_mutex);
+    const auto member =
+        std::find_if(members.begin(), members.end(),
+                     [client](const Member& member) { return member.peer == client; });
+    if (member == members.end()) {
+        return true;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - member->window_start >= std::chrono::seconds(1)) {
+        member->window_start = now;
+        member->window_packets = 0;
+    }
+    if (member->window_packets >= max) {
+        member->packets_dropped++;
+        packets_dropped++;
+        return false;
+    }
+    member->window_packets++;
+    return true;
 }
 
 void Room::RoomImpl::StartLoop() {
@@ -307,8 +483,7 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
             return;
         }
     }
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string nickname;
     packet >> nickname;
@@ -359,21 +534,88 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
         return;
     }
 
-    // At this point the client is ready to be added to the room.
+    // At this point the client is ready to be verified and added to the room.
     Member member{};
     member.mac_address = preferred_mac;
     member.console_id_hash = console_id_hash;
     member.nickname = nickname;
     member.peer = event->peer;
 
+    if (PendingJoin* pending = FindPendingJoin(event->peer)) {
+        *pending = PendingJoin{event->peer, event->peer->connectID};
+    } else {
+        pending_joins.push_back({event->peer, event->peer->connectID});
+    }
+
     std::string uid;
     {
         std::lock_guard lock(verify_UID_mutex);
         uid = verify_UID;
     }
-    member.user_data = verify_backend->LoadUserData(uid, token);
+    verify_worker->QueueWork([this, peer = event->peer, connect_id = event->peer->connectID,
+                              uid = std::move(uid), token = std::move(token),
+                              member = std::move(member)]() mutable {
+        member.user_data = verify_backend->LoadUserData(uid, token);
+        std::lock_guard lock(verified_joins_mutex);
+        verified_joins.push_back({peer, connect_id, std::move(member)});
+    });
+}
+
+void Room::RoomImpl::CompleteVerifiedJoins() {
+    std::vector<VerifiedJoin> joins;
+    {
+        std::lock_guard lock(verified_joins_mutex);
+        joins.swap(verified_joins);
+    }
+    for (auto& join : joins) {
+        CompleteJoin(join);
+    }
+}
+
+Room::RoomImpl::PendingJoin* Room::RoomImpl::FindPendingJoin(const ENetPeer* client) {
+    const auto pending =
+        std::find_if(pending_joins.begin(), pending_joins.end(), [client](const PendingJoin& join) {
+            return join.peer == client && join.connect_id == client->connectID;
+        });
+    return pending == pending_joins.end() ? nullptr : &*pending;
+}
+
+void Room::RoomImpl::CompleteJoin(VerifiedJoin& join) {
+    ENetPeer* peer = join.peer;
+    Member& member = join.member;
+    const auto pending =
+        std::find_if(pending_joins.begin(), pending_joins.end(), [&join](const PendingJoin& other) {
+            return other.peer == join.peer && other.connect_id == join.connect_id;
+        });
+    if (pending != pending_joins.end()) {
+        member.game_info = pending->game_info;
+        member.direct_connections = pending->direct_connections;
+        pending_joins.erase(pending);
+    }
+    if (peer->state != ENET_PEER_STATE_CONNECTED || peer->connectID != join.connect_id) {
+        return; // The client left during the verification
+    }
+    {
+        std::lock_guard lock(member_mutex);
+        if (members.size() >= room_information.member_slots) {
+            SendRoomIsFull(peer);
+            return;
+        }
+    }
+    if (!IsValidNickname(member.nickname)) {
+        SendNameCollision(peer);
+        return;
+    }
+    if (!IsValidMacAddress(member.mac_address)) {
+        SendMacCollision(peer);
+        return;
+    }
+    if (!IsValidConsoleId(member.console_id_hash)) {
+        SendConsoleIdCollision(peer);
+        return;
+    }
 
-    if (nickname == room_information.host_username) {
+    if (member.nickname == room_information.host_username) {
         member.user_data.moderator = true;
         LOG_INFO(Network, "User {} is a moderator", std::string(room_information.host_username));
     }
@@ -387,17 +629,17 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
             std::find(username_ban_list.begin(), username_ban_list.end(),
                       member.user_data.username) != username_ban_list.end()) {
 
-            SendUserBanned(event->peer);
+            SendUserBanned(peer);
             return;
         }
 
         // Check IP ban
         char ip_raw[256];
-        enet_address_get_host_ip(&event->peer->address, ip_raw, sizeof(ip_raw) - 1);
+        enet_address_get_host_ip(&peer->address, ip_raw, sizeof(ip_raw) - 1);
         ip = ip_raw;
 
         if (std::find(ip_ban_list.begin(), ip_ban_list.end(), ip) != ip_ban_list.end()) {
-            SendUserBanned(event->peer);
+            SendUserBanned(peer);
             return;
         }
     }
@@ -405,6 +647,7 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
     // Notify everyone that the user has joined.
     SendStatusMessage(IdMemberJoin, member.nickname, member.user_data.username, ip);
 
+    const MacAddress mac_address = member.mac_address;
     {
         std::lock_guard lock(member_mutex);
         members.push_back(std::move(member));
@@ -412,10 +655,10 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
 
     // Notify everyone that the room information has changed.
     BroadcastRoomInformation();
-    if (HasModPermission(event->peer)) {
-        SendJoinSuccessAsMod(event->peer, preferred_mac);
+    if (HasModPermission(peer)) {
+        SendJoinSuccessAsMod(peer, mac_address);
     } else {
-        SendJoinSuccess(event->peer, preferred_mac);
+        SendJoinSuccess(peer, mac_address);
     }
 }
 
@@ -425,8 +668,7 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
         return;
     }
 
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string nickname;
@@ -452,6 +694,8 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
         enet_address_get_host_ip(&target_member->peer->address, ip_raw, sizeof(ip_raw) - 1);
         ip = ip_raw;
 
+        // Disconnecting drops the packets still queued for the member, such as the notification.
+        enet_host_flush(server);
         enet_peer_disconnect(target_member->peer, 0);
         members.erase(target_member);
     }
@@ -467,8 +711,7 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
         return;
     }
 
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string nickname;
@@ -495,6 +738,8 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
         enet_address_get_host_ip(&target_member->peer->address, ip_raw, sizeof(ip_raw) - 1);
         ip = ip_raw;
 
+        // Disconnecting drops the packets still queued for the member, such as the notification.
+        enet_host_flush(server);
         enet_peer_disconnect(target_member->peer, 0);
         members.erase(target_member);
     }
@@ -528,8 +773,7 @@ void Room::RoomImpl::HandleModUnbanPacket(const ENetEvent* event) {
         return;
     }
 
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string address;
@@ -622,7 +866,6 @@ void Room::RoomImpl::SendNameCollision(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendMacCollision(ENetPeer* client) {
@@ -632,7 +875,6 @@ void Room::RoomImpl::SendMacCollision(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendConsoleIdCollision(ENetPeer* client) {
@@ -642,7 +884,6 @@ void Room::RoomImpl::SendConsoleIdCollision(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendWrongPassword(ENetPeer* client) {
@@ -652,7 +893,6 @@ void Room::RoomImpl::SendWrongPassword(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendRoomIsFull(ENetPeer* client) {
@@ -662,7 +902,6 @@ void Room::RoomImpl::SendRoomIsFull(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendVersionMismatch(ENetPeer* client) {
@@ -673,7 +912,6 @@ void Room::RoomImpl::SendVersionMismatch(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendJoinSuccess(ENetPeer* client, MacAddress mac_address) {
@@ -683,7 +921,6 @@ void Room::RoomImpl::SendJoinSuccess(ENetPeer* client, MacAddress mac_address) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendJoinSuccessAsMod(ENetPeer* client, MacAddress mac_address) {
@@ -693,7 +930,6 @@ void Room::RoomImpl::SendJoinSuccessAsMod(ENetPeer* client, MacAddress mac_addre
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendUserKicked(ENetPeer* client) {
@@ -703,7 +939,6 @@ void Room::RoomImpl::SendUserKicked(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendUserBanned(ENetPeer* client) {
@@ -713,7 +948,6 @@ void Room::RoomImpl::SendUserBanned(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendModPermissionDenied(ENetPeer* client) {
@@ -723,7 +957,6 @@ void Room::RoomImpl::SendModPermissionDenied(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendModNoSuchUser(ENetPeer* client) {
@@ -733,7 +966,6 @@ void Room::RoomImpl::SendModNoSuchUser(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
@@ -748,7 +980,6 @@ void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendCloseMessage() {
@@ -783,7 +1014,6 @@ void Room::RoomImpl::SendStatusMessage(StatusMessageTypes type, const std::strin
             enet_peer_send(member.peer, 0, enet_packet);
         }
     }
-    enet_host_flush(server);
 
     const std::string display_name =
         username.empty() ? nickname : fmt::format("{} ({})", nickname, username);
@@ -808,6 +1038,8 @@ void Room::RoomImpl::SendStatusMessage(StatusMessageTypes type, const std::strin
 }
 
 void Room::RoomImpl::BroadcastRoomInformation() {
+    room_information_pending = false;
+
     Packet packet;
     packet << static_cast<u8>(IdRoomInformation);
     packet << room_information.name;
@@ -834,7 +1066,60 @@ void Room::RoomImpl::BroadcastRoomInformation() {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_host_broadcast(server, 0, enet_packet);
-    enet_host_flush(server);
+
+    // The room information is sent whenever members join or leave, so are the peer lists.
+    SendDirectConnectPeers();
+}
+
+void Room::RoomImpl::HandleDirectConnectRequest(const ENetEvent* event) {
+    {
+        std::lock_guard lock(member_mutex);
+        auto member =
+            std::find_if(members.begin(), members.end(), [event](const Member& member) -> bool {
+                return member.peer == event->peer;
+            });
+        if (member == members.end()) {
+            // The peers are sent to the client once it has joined.
+            if (PendingJoin* pending = FindPendingJoin(event->peer)) {
+                pending->direct_connections = true;
+            }
+            return;
+        }
+        if (member->direct_connections) {
+            return;
+        }
+        member->direct_connections = true;
+    }
+    SendDirectConnectPeers();
+}
+
+void Room::RoomImpl::SendDirectConnectPeers() {
+    std::lock_guard lock(member_mutex);
+    const auto num_direct =
+        static_cast<u32>(std::count_if(members.begin(), members.end(), [](const Member& member) {
+            return member.direct_connections;
+        }));
+    if (num_direct == 0) {
+        return;
+    }
+    for (const auto& member : members) {
+        if (!member.direct_connections) {
+            continue;
+        }
+        Packet packet;
+        packet << static_cast<u8>(IdDirectConnectPeers);
+        packet << num_direct - 1;
+        for (const auto& peer : members) {
+            if (peer.direct_connections && peer.peer != member.peer) {
+                packet << peer.mac_address;
+                packet << static_cast<u32>(peer.peer->address.host);
+                packet << static_cast<u16>(peer.peer->address.port);
+            }
+        }
+        ENetPacket* enet_packet =
+            enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
+        enet_peer_send(member.peer, 0, enet_packet);
+    }
 }
 
 MacAddress Room::RoomImpl::GenerateMacAddress() {
@@ -850,8 +1135,7 @@ MacAddress Room::RoomImpl::GenerateMacAddress() {
 }
 
 void Room::RoomImpl::HandleWifiPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{event->packet->data, event->packet->dataLength};
     in_packet.IgnoreBytes(sizeof(u8));         // Message type
     in_packet.IgnoreBytes(sizeof(u8));         // WifiPacket Type
     in_packet.IgnoreBytes(sizeof(u8));         // WifiPacket Channel
@@ -859,10 +1143,9 @@ void Room::RoomImpl::HandleWifiPacket(const ENetEvent* event) {
     MacAddress destination_address;
     in_packet >> destination_address;
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
+    ENetPacket* enet_packet = enet_packet_create(event->packet->data, event->packet->dataLength,
                                                  ENET_PACKET_FLAG_RELIABLE);
+    wifi_packets_relayed++;
 
     if (destination_address == BroadcastMac) { // Send the data to everyone except the sender
         std::lock_guard lock(member_mutex);
@@ -894,12 +1177,10 @@ void Room::RoomImpl::HandleWifiPacket(const ENetEvent* event) {
             enet_packet_destroy(enet_packet);
         }
     }
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{event->packet->data, event->packet->dataLength};
 
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string message;
@@ -918,6 +1199,8 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
     message.resize(std::min(static_cast<u32>(message.size()), MaxMessageSize));
 
     Packet out_packet;
+    out_packet.Reserve(sizeof(u8) + 3 * sizeof(u32) + sending_member->nickname.size() +
+                       sending_member->user_data.username.size() + message.size());
     out_packet << static_cast<u8>(IdChatMessage);
     out_packet << sending_member->nickname;
     out_packet << sending_member->user_data.username;
@@ -937,7 +1220,6 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
         enet_packet_destroy(enet_packet);
     }
 
-    enet_host_flush(server);
 
     if (sending_member->user_data.username.empty()) {
         LOG_INFO(Network, "{}: {}", sending_member->nickname, message);
@@ -948,8 +1230,7 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
 }
 
 void Room::RoomImpl::HandleGameNamePacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{event->packet->data, event->packet->dataLength};
 
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     GameInfo game_info;
@@ -975,9 +1256,20 @@ void Room::RoomImpl::HandleGameNamePacket(const ENetEvent* event) {
             } else {
                 LOG_INFO(Network, "{} is playing {}", display_name, game_info.name);
             }
+        } else {
+            // The game is announced with the join.
+            if (PendingJoin* pending = FindPendingJoin(event->peer)) {
+                pending->game_info = game_info;
+            }
+            return;
         }
     }
-    BroadcastRoomInformation();
+    // Game changes can wait for the room to recover, unlike joins and leaves.
+    if (overloaded) {
+        room_information_pending = true;
+    } else {
+        BroadcastRoomInformation();
+    }
 }
 
 void Room::RoomImpl::HandleClientDisconnection(ENetPeer* client) {
@@ -999,6 +1291,7 @@ void Room::RoomImpl::HandleClientDisconnection(ENetPeer* client) {
             members.erase(member);
         }
     }
+    std::erase_if(pending_joins, [client](const PendingJoin& join) { return join.peer == client; });
 
     // Announce the change to all clients.
     enet_peer_disconnect(client, 0);
@@ -1045,6 +1338,16 @@ bool Room::Create(const std::string& name, const std::string& description,
     room_impl->username_ban_list = ban_list.first;
     room_impl->ip_ban_list = ban_list.second;
 
+    room_impl->packets_received = 0;
+    room_impl->bytes_received = 0;
+    room_impl->packets_sent = 0;
+    room_impl->bytes_sent = 0;
+    room_impl->wifi_packets_relayed = 0;
+    room_impl->packets_dropped = 0;
+    room_impl->chat_messages_dropped = 0;
+    room_impl->overloaded = false;
+    room_impl->room_information_pending = false;
+    room_impl->verify_worker = std::make_unique<Common::ThreadWorker>(1, "RoomVerify");
     room_impl->StartLoop();
     return true;
 }
@@ -1062,6 +1365,23 @@ std::string Room::GetVerifyUID() const {
     return room_impl->verify_UID;
 }
 
+Room::TrafficStats Room::GetTrafficStats() const {
+    return {
+        .packets_received = room_impl->packets_received,
+        .bytes_received = room_impl->bytes_received,
+        .packets_sent = room_impl->packets_sent,
+        .bytes_sent = room_impl->bytes_sent,
+        .wifi_packets_relayed = room_impl->wifi_packets_relayed,
+        .packets_dropped = room_impl->packets_dropped,
+        .chat_messages_dropped = room_impl->chat_messages_dropped,
+    };
+}
+
+void Room::SetLoadLimits(const LoadLimits& limits) {
+    room_impl->max_member_packets_per_second = limits.max_member_packets_per_second;
+    room_impl->max_data_in_transit = limits.max_data_in_transit;
+}
+
 Room::BanList Room::GetBanList() const {
     std::lock_guard lock(room_impl->ban_list_mutex);
     return {room_impl->username_ban_list, room_impl->ip_ban_list};
@@ -1078,6 +1398,9 @@ std::vector<Room::Member> Room::GetRoomMemberList() const {
         member.avatar_url = member_impl.user_data.avatar_url;
         member.mac_address = member_impl.mac_address;
         member.game_info = member_impl.game_info;
+        member.round_trip_time = member_impl.round_trip_time;
+        member.data_in_transit = member_impl.data_in_transit;
+        member.packets_dropped = member_impl.packets_dropped;
         member_list.push_back(member);
     }
     return member_list;
@@ -1096,6 +1419,12 @@ void Room::Destroy() {
     room_impl->state = State::Closed;
     room_impl->room_thread->join();
     room_impl->room_thread.reset();
+    room_impl->verify_worker.reset();
+    room_impl->verified_joins.clear();
+
+    const TrafficStats stats = GetTrafficStats();
+    LOG_INFO(Network, "Room closed, received {} packets ({} bytes), sent {} packets ({} bytes)",
+             stats.packets_received, stats.bytes_received, stats.packets_sent, stats.bytes_sent);
 
     if (room_impl->server) {
         enet_host_destroy(room_impl->server);
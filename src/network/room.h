@@ -75,6 +75,9 @@ enum RoomMessageTypes : u8 {
     IdModPermissionDenied,
     IdModNoSuchUser,
     IdJoinSuccessAsMod,
+    /// Direct connections between members
+    IdDirectConnectRequest,
+    IdDirectConnectPeers,
 };
 
 /// Types of system status messages
@@ -101,6 +104,32 @@ public:
         std::string avatar_url;   ///< Url to the member's avatar. Can be empty.
         GameInfo game_info;       ///< The current game of the member
         MacAddress mac_address;   ///< The assigned mac address of the member.
+        u32 round_trip_time;      ///< Mean round trip time to the member, in milliseconds.
+        u32 data_in_transit;      ///< Reliable data sent and not acknowledged yet, in bytes.
+        u64 packets_dropped;      ///< Packets of the member dropped for exceeding its rate.
+    };
+
+    /// Traffic of the room since it was created, as counted by ENet.
+    struct TrafficStats {
+        u64 packets_received;
+        u64 bytes_received;
+        u64 packets_sent;
+        u64 bytes_sent;
+        u64 wifi_packets_relayed;  ///< WifiPackets forwarded, counted once for broadcasts.
+        u64 packets_dropped;       ///< Packets dropped for exceeding the packet rate of a member.
+        u64 chat_messages_dropped; ///< Chat messages dropped while the room was overloaded.
+    };
+
+    /// Limits keeping the room responsive under load, 0 disables a limit.
+    struct LoadLimits {
+        /// WifiPackets and chat messages a member may send per second, the rest are dropped.
+        u32 max_member_packets_per_second = 0;
+        /**
+         * Reliable data in transit to all the members, in bytes, above which the room is
+         * overloaded. Chat messages are then dropped and game changes are sent to the members
+         * once the room has recovered.
+         */
+        u32 max_data_in_transit = 0;
     };
 
     Room();
@@ -126,6 +155,16 @@ public:
      */
     std::vector<Member> GetRoomMemberList() const;
 
+    /**
+     * Gets the traffic of the room, it can be polled to compute the throughput.
+     */
+    TrafficStats GetTrafficStats() const;
+
+    /**
+     * Sets the load limits of the room, they can be changed while it is open.
+     */
+    void SetLoadLimits(const LoadLimits& limits);
+
     /**
      * Checks if the room is password protected
      */
@@ -4,12 +4,16 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <list>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <thread>
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "enet/enet.h"
+#include "network/network_settings.h"
 #include "network/packet.h"
 #include "network/room_member.h"
 
@@ -17,6 +21,12 @@ namespace Network {
 
 constexpr u32 ConnectionTimeoutMs = 5000;
 
+/// Most members WifiPackets are sent to directly, as many as local wireless supports.
+constexpr std::size_t MaxDirectPeers = 16;
+/// Datagrams sent to open the NAT of a member for the connection of the other one.
+constexpr u32 PunchAttempts = 10;
+constexpr auto PunchInterval = std::chrono::milliseconds(500);
+
 class RoomMember::RoomMemberImpl {
 public:
     ENetHost* client = nullptr; ///< ENet network interface.
@@ -45,8 +55,24 @@ public:
     std::mutex network_mutex; ///< Mutex that controls access to the `client` variable.
     /// Thread that receives and dispatches network packets
     std::unique_ptr<std::thread> loop_thread;
-    std::mutex send_list_mutex;  ///< Mutex that controls access to the `send_list` variable.
-    std::list<Packet> send_list; ///< A list that stores all packets to send the async
+    struct OutgoingPacket {
+        Packet packet;
+        /// Destination of WifiPackets, which may be sent to it directly instead of to the room.
+        std::optional<MacAddress> wifi_destination;
+    };
+    std::mutex send_list_mutex; ///< Mutex that controls access to the `send_list` variable.
+    std::list<OutgoingPacket> send_list; ///< A list that stores all packets to send the async
+
+    /// A member WifiPackets are exchanged with directly. Only accessed by the loop thread.
+    struct DirectPeer {
+        MacAddress mac_address;
+        ENetAddress address;       ///< The endpoint of the member as seen by the room.
+        ENetPeer* peer = nullptr;  ///< The connection to the member, once established.
+        u32 punches_left = 0;      ///< Datagrams still to send to open our NAT to the member.
+        std::chrono::steady_clock::time_point next_punch;
+    };
+    bool direct_connections = false; ///< Whether direct connections were requested on joining.
+    std::vector<DirectPeer> direct_peers;
 
     template <typename T>
     using CallbackSet = std::set<CallbackHandle<T>>;
@@ -127,6 +153,27 @@ public:
      */
     void HandleModBanListResponsePacket(const ENetEvent* event);
 
+    /**
+     * Updates the members WifiPackets are exchanged with directly from the list sent by the room.
+     * Of each pair of members, the one with the lower MAC address connects to the other, which
+     * sends a few datagrams to the first one so that its NAT lets the connection through.
+     * @param event The ENet event that was received.
+     */
+    void HandleDirectConnectPeersPacket(const ENetEvent* event);
+
+    /// Handles an event of a direct connection to another member.
+    void HandleDirectPeerEvent(const ENetEvent& event);
+
+    /// Sends the NAT punching datagrams that are due.
+    void PunchDirectPeers();
+
+    /**
+     * Sends a WifiPacket directly to its destination when connections to all the members it is
+     * for are established.
+     * @return False if it has to be relayed by the room.
+     */
+    bool SendDirect(const MacAddress& destination, const Packet& packet);
+
     /**
      * Disconnects the RoomMember from the Room
      */
@@ -160,7 +207,9 @@ void RoomMember::RoomMemberImpl::MemberLoop() {
     while (IsConnected()) {
         std::lock_guard network_lock(network_mutex);
         ENetEvent event;
-        if (enet_host_service(client, &event, 16) > 0) {
+        if (enet_host_service(client, &event, 16) > 0 && event.peer != server) {
+            HandleDirectPeerEvent(event);
+        } else if (event.type != ENET_EVENT_TYPE_NONE) {
             switch (event.type) {
             case ENET_EVENT_TYPE_RECEIVE:
                 switch (event.packet->data[0]) {
@@ -234,6 +283,9 @@ void RoomMember::RoomMemberImpl::MemberLoop() {
                 case IdModNoSuchUser:
                     SetError(Error::NoSuchUser);
                     break;
+                case IdDirectConnectPeers:
+                    HandleDirectConnectPeersPacket(&event);
+                    break;
                 }
                 enet_packet_destroy(event.packet);
                 break;
@@ -253,16 +305,20 @@ void RoomMember::RoomMemberImpl::MemberLoop() {
             }
         }
 
-        std::list<Packet> packets;
+        std::list<OutgoingPacket> packets;
         {
             std::lock_guard send_list_lock(send_list_mutex);
             packets.swap(send_list);
         }
-        for (const auto& packet : packets) {
+        for (const auto& [packet, wifi_destination] : packets) {
+            if (wifi_destination && SendDirect(*wifi_destination, packet)) {
+                continue;
+            }
             ENetPacket* enetPacket = enet_packet_create(packet.GetData(), packet.GetDataSize(),
                                                         ENET_PACKET_FLAG_RELIABLE);
             enet_peer_send(server, 0, enetPacket);
         }
+        PunchDirectPeers();
         enet_host_flush(client);
     }
     Disconnect();
@@ -274,7 +330,7 @@ void RoomMember::RoomMemberImpl::StartLoop() {
 
 void RoomMember::RoomMemberImpl::Send(Packet&& packet) {
     std::lock_guard lock(send_list_mutex);
-    send_list.push_back(std::move(packet));
+    send_list.push_back({std::move(packet), std::nullopt});
 }
 
 void RoomMember::RoomMemberImpl::SendJoinRequest(const std::string& nickname,
@@ -294,8 +350,7 @@ void RoomMember::RoomMemberImpl::SendJoinRequest(const std::string& nickname,
 }
 
 void RoomMember::RoomMemberImpl::HandleRoomInformationPacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -338,8 +393,7 @@ void RoomMember::RoomMemberImpl::HandleRoomInformationPacket(const ENetEvent* ev
 }
 
 void RoomMember::RoomMemberImpl::HandleJoinPacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -350,8 +404,7 @@ void RoomMember::RoomMemberImpl::HandleJoinPacket(const ENetEvent* event) {
 
 void RoomMember::RoomMemberImpl::HandleWifiPackets(const ENetEvent* event) {
     WifiPacket wifi_packet{};
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -371,8 +424,7 @@ void RoomMember::RoomMemberImpl::HandleWifiPackets(const ENetEvent* event) {
 }
 
 void RoomMember::RoomMemberImpl::HandleChatPacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -386,8 +438,7 @@ void RoomMember::RoomMemberImpl::HandleChatPacket(const ENetEvent* event) {
 }
 
 void RoomMember::RoomMemberImpl::HandleStatusMessagePacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -402,8 +453,7 @@ void RoomMember::RoomMemberImpl::HandleStatusMessagePacket(const ENetEvent* even
 }
 
 void RoomMember::RoomMemberImpl::HandleModBanListResponsePacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{event->packet->data, event->packet->dataLength};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -414,10 +464,164 @@ void RoomMember::RoomMemberImpl::HandleModBanListResponsePacket(const ENetEvent*
     Invoke<Room::BanList>(ban_list);
 }
 
+void RoomMember::RoomMemberImpl::HandleDirectConnectPeersPacket(const ENetEvent* event) {
+    if (!direct_connections) {
+        return;
+    }
+    Packet packet{event->packet->data, event->packet->dataLength};
+
+    // Ignore the first byte, which is the message id.
+    packet.IgnoreBytes(sizeof(u8));
+
+    u32 num_peers;
+    packet >> num_peers;
+    std::vector<DirectPeer> peers;
+    for (u32 i = 0; i < num_peers && peers.size() < MaxDirectPeers; i++) {
+        DirectPeer& peer = peers.emplace_back();
+        u32 host;
+        u16 port;
+        packet >> peer.mac_address;
+        packet >> host;
+        packet >> port;
+        peer.address.host = host;
+        peer.address.port = port;
+    }
+
+    // Keep the members that are still in the list, connect to the new ones.
+    for (auto& peer : peers) {
+        const auto existing = std::find_if(
+            direct_peers.begin(), direct_peers.end(), [&peer](const DirectPeer& direct_peer) {
+                return direct_peer.mac_address == peer.mac_address &&
+                       direct_peer.address.host == peer.address.host &&
+                       direct_peer.address.port == peer.address.port;
+            });
+        if (existing != direct_peers.end()) {
+            peer = *existing;
+            existing->peer = nullptr;
+            continue;
+        }
+        if (mac_address < peer.mac_address) {
+            enet_host_connect(client, &peer.address, NumChannels, 0);
+        } else {
+            peer.punches_left = PunchAttempts;
+        }
+    }
+    for (const auto& direct_peer : direct_peers) {
+        if (direct_peer.peer) {
+            enet_peer_disconnect(direct_peer.peer, 0);
+        }
+    }
+    direct_peers = std::move(peers);
+}
+
+void RoomMember::RoomMemberImpl::HandleDirectPeerEvent(const ENetEvent& event) {
+    const auto direct_peer =
+        std::find_if(direct_peers.begin(), direct_peers.end(), [&event](const DirectPeer& peer) {
+            return peer.address.host == event.peer->address.host &&
+                   peer.address.port == event.peer->address.port;
+        });
+    switch (event.type) {
+    case ENET_EVENT_TYPE_CONNECT:
+        // Only members the room told us about may connect.
+        if (direct_peer == direct_peers.end()) {
+            enet_peer_reset(event.peer);
+            break;
+        }
+        LOG_INFO(Network, "Connected directly to {:02X}:{:02X}:{:02X}:{:02X}:{:02X}:{:02X}",
+                 direct_peer->mac_address[0], direct_peer->mac_address[1],
+                 direct_peer->mac_address[2], direct_peer->mac_address[3],
+                 direct_peer->mac_address[4], direct_peer->mac_address[5]);
+        direct_peer->peer = event.peer;
+        direct_peer->punches_left = 0;
+        break;
+    case ENET_EVENT_TYPE_RECEIVE:
+        if (direct_peer != direct_peers.end() && direct_peer->peer == event.peer &&
+            event.packet->data[0] == IdWifiPacket) {
+            HandleWifiPackets(&event);
+        }
+        enet_packet_destroy(event.packet);
+        break;
+    case ENET_EVENT_TYPE_DISCONNECT:
+        // The WifiPackets for the member are relayed by the room from now on.
+        if (direct_peer != direct_peers.end() && direct_peer->peer == event.peer) {
+            direct_peer->peer = nullptr;
+        }
+        break;
+    case ENET_EVENT_TYPE_NONE:
+        break;
+    }
+}
+
+void RoomMember::RoomMemberImpl::PunchDirectPeers() {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& peer : direct_peers) {
+        if (peer.punches_left == 0 || peer.next_punch > now) {
+            continue;
+        }
+        // ENet drops datagrams shorter than its header, so this only opens the NAT mapping.
+        const u8 punch = 0;
+        ENetBuffer buffer{};
+        buffer.data = const_cast<u8*>(&punch);
+        buffer.dataLength = sizeof(punch);
+        enet_socket_send(client->socket, &peer.address, &buffer, 1);
+        peer.punches_left--;
+        peer.next_punch = now + PunchInterval;
+    }
+}
+
+bool RoomMember::RoomMemberImpl::SendDirect(const MacAddress& destination, const Packet& packet) {
+    if (direct_peers.empty()) {
+        return false;
+    }
+    const auto is_connected = [this](const MacAddress& address) {
+        return std::any_of(direct_peers.begin(), direct_peers.end(),
+                           [&address](const DirectPeer& peer) {
+                               return peer.peer && peer.mac_address == address;
+                           });
+    };
+    if (destination == BroadcastMac) {
+        // Broadcasts are only sent directly when every other member can be reached that way, as
+        // the room would send them to everyone again otherwise.
+        if (!std::all_of(member_information.begin(), member_information.end(),
+                         [&](const MemberInformation& member) {
+                             return member.mac_address == mac_address ||
+                                    is_connected(member.mac_address);
+                         })) {
+            return false;
+        }
+        for (const auto& peer : direct_peers) {
+            if (peer.peer) {
+                enet_peer_send(peer.peer, 0,
+                               enet_packet_create(packet.GetData(), packet.GetDataSize(),
+                                                  ENET_PACKET_FLAG_RELIABLE));
+            }
+        }
+        return true;
+    }
+    const auto peer =
+        std::find_if(direct_peers.begin(), direct_peers.end(), [&](const DirectPeer& peer) {
+            return peer.peer && peer.mac_address == destination;
+        });
+    if (peer == direct_peers.end()) {
+        return false;
+    }
+    enet_peer_send(peer->peer, 0,
+                   enet_packet_create(packet.GetData(), packet.GetDataSize(),
+                                      ENET_PACKET_FLAG_RELIABLE));
+    return true;
+}
+
 void RoomMember::RoomMemberImpl::Disconnect() {
     member_information.clear();
     room_information.member_slots = 0;
     room_information.name.clear();
+    // The disconnections are sent along with the one from the room below.
+    for (const auto& direct_peer : direct_peers) {
+        if (direct_peer.peer) {
+            enet_peer_disconnect(direct_peer.peer, 0);
+        }
+    }
+    direct_peers.clear();
 
     if (!server)
         return;
@@ -430,6 +634,9 @@ void RoomMember::RoomMemberImpl::Disconnect() {
             enet_packet_destroy(event.packet); // Ignore all incoming data
             break;
         case ENET_EVENT_TYPE_DISCONNECT:
+            if (event.peer != server) {
+                break; // A direct connection to another member
+            }
             server = nullptr;
             return;
         case ENET_EVENT_TYPE_NONE:
@@ -549,8 +756,13 @@ void RoomMember::Join(const std::string& nick, const std::string& console_id_has
         room_member_impl->loop_thread.reset();
     }
 
+    // Direct connections to the other members go through the same host, so that they use the
+    // port the NAT already maps for the room.
+    room_member_impl->direct_connections = NetSettings::values.direct_connections;
     if (!room_member_impl->client) {
-        room_member_impl->client = enet_host_create(nullptr, 1, NumChannels, 0, 0);
+        room_member_impl->client = enet_host_create(
+            nullptr, room_member_impl->direct_connections ? MaxDirectPeers + 1 : 1, NumChannels,
+            0, 0);
         ASSERT_MSG(room_member_impl->client != nullptr, "Could not create client");
     }
 
@@ -575,6 +787,11 @@ void RoomMember::Join(const std::string& nick, const std::string& console_id_has
         room_member_impl->StartLoop();
         room_member_impl->SendJoinRequest(nick, console_id_hash, preferred_mac, password, token);
         SendGameInfo(room_member_impl->current_game_info);
+        if (room_member_impl->direct_connections) {
+            Packet packet;
+            packet << static_cast<u8>(IdDirectConnectRequest);
+            room_member_impl->Send(std::move(packet));
+        }
     } else {
         enet_peer_disconnect(room_member_impl->server, 0);
         room_member_impl->SetState(State::Idle);
@@ -587,14 +804,18 @@ bool RoomMember::IsConnected() const {
 }
 
 void RoomMember::SendWifiPacket(const WifiPacket& wifi_packet) {
+    // Message type, frame type, channel, both addresses and the size of the data
+    constexpr std::size_t HeaderSize = 3 * sizeof(u8) + 2 * sizeof(MacAddress) + sizeof(u32);
     Packet packet;
+    packet.Reserve(HeaderSize + wifi_packet.data.size());
     packet << static_cast<u8>(IdWifiPacket);
     packet << static_cast<u8>(wifi_packet.type);
     packet << wifi_packet.channel;
     packet << wifi_packet.transmitter_address;
     packet << wifi_packet.destination_address;
     packet << wifi_packet.data;
-    room_member_impl->Send(std::move(packet));
+    std::lock_guard lock(room_member_impl->send_list_mutex);
+    room_member_impl->send_list.push_back({std::move(packet), wifi_packet.destination_address});
 }
 
 void RoomMember::SendChatMessage(const std::string& message) {
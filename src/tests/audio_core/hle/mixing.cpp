@@ -0,0 +1,97 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "audio_core/hle/mixers.h"
+#include "audio_core/hle/shared_memory.h"
+#include "audio_core/hle/source.h"
+#include "core/core.h"
+#include "core/memory.h"
+
+namespace {
+
+using AudioCore::HLE::Source;
+using Configuration = AudioCore::HLE::SourceConfiguration::Configuration;
+
+constexpr std::size_t NUM_SAMPLES = 4096;
+
+/// Queues a looping stereo PCM16 buffer with the provided rate and gains on a source.
+void ConfigureSource(Source& source, u32 physical_address, float rate) {
+    Configuration config;
+    std::memset(&config, 0, sizeof(config));
+    config.enable = 1;
+    config.enable_dirty.Assign(1);
+    config.rate_multiplier = rate;
+    config.rate_multiplier_dirty.Assign(1);
+    config.interpolation_mode = Configuration::InterpolationMode::Linear;
+    config.interpolation_dirty.Assign(1);
+    for (std::size_t mix = 0; mix < 3; mix++) {
+        for (std::size_t channel = 0; channel < 4; channel++) {
+            config.gain[mix][channel] = 0.25f + 0.05f * static_cast<float>(mix + channel);
+        }
+    }
+    config.gain_0_dirty.Assign(1);
+    config.gain_1_dirty.Assign(1);
+    config.gain_2_dirty.Assign(1);
+    config.physical_address = physical_address;
+    config.length = static_cast<u32>(NUM_SAMPLES);
+    config.mono_or_stereo.Assign(Configuration::MonoOrStereo::Stereo);
+    config.format.Assign(Configuration::Format::PCM16);
+    config.is_looping.Assign(1);
+    config.embedded_buffer_dirty.Assign(1);
+
+    const s16_le adpcm_coeffs[16]{};
+    source.Tick(config, adpcm_coeffs);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Mix all HLE sources", "[.][benchmark][audio_core][hle]") {
+    Core::System system;
+    Memory::MemorySystem memory{system};
+
+    u8* const samples = memory.GetPhysicalPointer(Memory::FCRAM_PADDR);
+    REQUIRE(samples != nullptr);
+    for (std::size_t i = 0; i < NUM_SAMPLES * 2; i++) {
+        const s16 value = static_cast<s16>((i * 97) % 65536 - 32768);
+        std::memcpy(samples + i * sizeof(s16), &value, sizeof(s16));
+    }
+
+    std::array<std::unique_ptr<Source>, AudioCore::HLE::num_sources> sources;
+    for (std::size_t i = 0; i < sources.size(); i++) {
+        sources[i] = std::make_unique<Source>(i);
+        sources[i]->SetMemory(memory);
+        // Resample every source at a different rate, as games mixing many voices do.
+        ConfigureSource(*sources[i], Memory::FCRAM_PADDR, 0.5f + 0.05f * static_cast<float>(i));
+    }
+
+    Configuration idle;
+    std::memset(&idle, 0, sizeof(idle));
+    const s16_le adpcm_coeffs[16]{};
+    AudioCore::HLE::Mixers mixers;
+    AudioCore::HLE::DspConfiguration dsp_config;
+    std::memset(&dsp_config, 0, sizeof(dsp_config));
+    AudioCore::HLE::IntermediateMixSamples read_samples;
+    std::memset(&read_samples, 0, sizeof(read_samples));
+    AudioCore::HLE::IntermediateMixSamples write_samples;
+    std::array<AudioCore::QuadFrame32, 3> intermediate_mixes;
+
+    BENCHMARK("Generate and mix one frame") {
+        for (auto& source : sources) {
+            source->Tick(idle, adpcm_coeffs);
+        }
+        for (std::size_t mix = 0; mix < intermediate_mixes.size(); mix++) {
+            intermediate_mixes[mix].fill({});
+            for (const auto& source : sources) {
+                source->MixInto(intermediate_mixes[mix], mix);
+            }
+        }
+        mixers.Tick(dsp_config, read_samples, write_samples, intermediate_mixes);
+        return mixers.GetOutput()[0][0];
+    };
+}
@@ -0,0 +1,55 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/bounded_threadsafe_queue.h"
+
+TEST_CASE("LockFreeMPSCQueue", "[common]") {
+    Common::LockFreeMPSCQueue<u32, 8> queue;
+
+    // A full queue refuses new elements instead of waiting.
+    for (u32 i = 0; i < 8; i++) {
+        REQUIRE(queue.TryEmplace(i));
+    }
+    REQUIRE(!queue.TryEmplace(8U));
+    u32 value;
+    REQUIRE(queue.TryPop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.TryEmplace(8U));
+    for (u32 i = 1; i <= 8; i++) {
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(!queue.TryPop(value));
+
+    // Every element pushed by several producers is popped once, in order per producer.
+    constexpr u32 NumProducers = 4;
+    constexpr u32 NumElements = 0x4000;
+    std::vector<std::jthread> producers;
+    for (u32 producer = 0; producer < NumProducers; producer++) {
+        producers.emplace_back([&queue, producer] {
+            for (u32 i = 0; i < NumElements; i++) {
+                while (!queue.TryEmplace(producer << 16 | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<u32> next(NumProducers, 0);
+    std::stop_source stop_source;
+    for (u32 popped = 0; popped < NumProducers * NumElements; popped++) {
+        REQUIRE(queue.PopWait(value, stop_source.get_token()));
+        REQUIRE((value & 0xFFFF) == next[value >> 16]++);
+    }
+    REQUIRE(!queue.TryPop(value));
+
+    // A stop request wakes up a waiting consumer.
+    std::jthread stopper([&stop_source] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        stop_source.request_stop();
+    });
+    REQUIRE(!queue.PopWait(value, stop_source.get_token()));
+}
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <filesystem>
 #include <string>
 
 #include <catch2/catch_test_macros.hpp>
@@ -24,3 +25,30 @@ TEST_CASE("SplitFilename83 Sanity", "[common]") {
     REQUIRE(std::memcmp(short_name.data(), expected_short_name.data(), short_name.size()) == 0);
     REQUIRE(std::memcmp(extension.data(), expected_extension.data(), extension.size()) == 0);
 }
+
+TEST_CASE("ScanDirectoryTree reads the type and size of the entries", "[common]") {
+    const std::string root =
+        (std::filesystem::temp_directory_path() / "azahar_scan_directory_test").string();
+    FileUtil::DeleteDirRecursively(root);
+    REQUIRE(FileUtil::CreateFullPath(root + "/dir/"));
+    REQUIRE(FileUtil::WriteStringToFile(true, root + "/file.bin", "12345") == 5);
+    REQUIRE(FileUtil::WriteStringToFile(true, root + "/dir/nested.bin", "123") == 3);
+
+    FileUtil::FSTEntry tree{};
+    REQUIRE(FileUtil::ScanDirectoryTree(root, tree, 1) == 3);
+    REQUIRE(tree.children.size() == 2);
+    for (const FileUtil::FSTEntry& entry : tree.children) {
+        if (entry.virtualName == "dir") {
+            REQUIRE(entry.isDirectory);
+            REQUIRE(entry.size == 1);
+            REQUIRE(entry.children.size() == 1);
+            REQUIRE(entry.children[0].size == 3);
+        } else {
+            REQUIRE(entry.virtualName == "file.bin");
+            REQUIRE(!entry.isDirectory);
+            REQUIRE(entry.size == 5);
+        }
+    }
+
+    FileUtil::DeleteDirRecursively(root);
+}
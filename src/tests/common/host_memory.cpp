@@ -0,0 +1,70 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "common/host_memory.h"
+
+static constexpr std::size_t TestSize = 128 * 1024 * 1024;
+
+TEST_CASE("HostMemory[ZeroInitialized]", "[common]") {
+    for (const bool use_huge_pages : {false, true}) {
+        auto memory = Common::AllocateHostMemory(TestSize, use_huge_pages);
+        REQUIRE(memory);
+        REQUIRE(std::all_of(memory.get(), memory.get() + TestSize, [](u8 b) { return b == 0; }));
+        memory[0] = 0xAB;
+        memory[TestSize - 1] = 0xCD;
+        REQUIRE(memory[0] == 0xAB);
+        REQUIRE(memory[TestSize - 1] == 0xCD);
+    }
+}
+
+TEST_CASE("HostMemory[SnapshotRestore]", "[common]") {
+    constexpr std::size_t SnapshotSize = 4 * 1024 * 1024;
+    for (const bool use_huge_pages : {false, true}) {
+        auto memory = Common::AllocateHostMemory(SnapshotSize, use_huge_pages);
+        for (std::size_t i = 0; i < SnapshotSize; i++) {
+            memory[i] = static_cast<u8>(i * 7);
+        }
+        const Common::HostMemorySnapshot snapshot{{memory.get(), SnapshotSize}};
+
+        // Restoring twice checks that the writes in between did not reach the snapshot.
+        for (int run = 0; run < 2; run++) {
+            std::fill(memory.get(), memory.get() + SnapshotSize / 2, u8{0xFF});
+            memory[SnapshotSize - 1] = 0;
+            snapshot.Restore({memory.get(), SnapshotSize});
+            bool matches = true;
+            for (std::size_t i = 0; i < SnapshotSize; i++) {
+                matches &= memory[i] == static_cast<u8>(i * 7);
+            }
+            REQUIRE(matches);
+        }
+    }
+}
+
+// Random reads spread over an FCRAM sized region, like texture streaming from guest memory.
+// The gap between the two cases is the cost of TLB misses saved by huge pages.
+TEST_CASE("HostMemory[RandomAccessBenchmark]", "[.][benchmark]") {
+    std::mt19937 rng{42};
+    std::vector<u32> offsets(1 << 20);
+    for (auto& offset : offsets) {
+        offset = static_cast<u32>(rng() % TestSize);
+    }
+
+    for (const bool use_huge_pages : {false, true}) {
+        auto memory = Common::AllocateHostMemory(TestSize, use_huge_pages);
+        std::fill(memory.get(), memory.get() + TestSize, u8{1});
+
+        BENCHMARK(use_huge_pages ? "Huge pages" : "Regular pages") {
+            u32 sum = 0;
+            for (const u32 offset : offsets) {
+                sum += memory[offset];
+            }
+            return sum;
+        };
+    }
+}
@@ -0,0 +1,59 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/common_types.h"
+#include "common/object_pool.h"
+
+namespace {
+struct PooledObject : std::enable_shared_from_this<PooledObject> {
+    explicit PooledObject(int& live_count_) : live_count{live_count_} {
+        ++live_count;
+    }
+    ~PooledObject() {
+        --live_count;
+    }
+
+    int& live_count;
+    u64 payload[8]{};
+};
+} // Anonymous namespace
+
+TEST_CASE("ObjectPool[SharedSemantics]", "[common]") {
+    int live_count = 0;
+    std::weak_ptr<PooledObject> weak;
+    {
+        auto object = Common::MakePooledShared<PooledObject>(live_count);
+        REQUIRE(live_count == 1);
+        weak = object;
+        REQUIRE(object->shared_from_this() == object);
+        REQUIRE(weak.lock() == object);
+    }
+    REQUIRE(live_count == 0);
+    REQUIRE(weak.expired());
+}
+
+TEST_CASE("ObjectPool[ReusesBlocks]", "[common]") {
+    int live_count = 0;
+    auto first = Common::MakePooledShared<PooledObject>(live_count);
+    const PooledObject* address = first.get();
+    first.reset();
+
+    // Freed blocks are handed out again first.
+    auto second = Common::MakePooledShared<PooledObject>(live_count);
+    REQUIRE(second.get() == address);
+
+    // Enough live objects to span several chunks must not alias each other.
+    std::vector<std::shared_ptr<PooledObject>> objects;
+    for (int i = 0; i < 200; ++i) {
+        objects.push_back(Common::MakePooledShared<PooledObject>(live_count));
+        objects.back()->payload[0] = i;
+    }
+    for (int i = 0; i < 200; ++i) {
+        REQUIRE(objects[i]->payload[0] == static_cast<u64>(i));
+    }
+    REQUIRE(live_count == 201);
+}
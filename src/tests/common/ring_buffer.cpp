@@ -0,0 +1,30 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include "common/common_types.h"
+#include "common/ring_buffer.h"
+
+TEST_CASE("RingBuffer[Discard]", "[common]") {
+    Common::RingBuffer<s16, 8, 2> buffer;
+    const std::array<s16, 12> input{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    REQUIRE(buffer.Push(input.data(), 6) == 6);
+
+    REQUIRE(buffer.Discard(4) == 4);
+    REQUIRE(buffer.Size() == 2);
+
+    // Push across the end of the storage, then drop more than is queued.
+    REQUIRE(buffer.Push(input.data(), 4) == 4);
+    std::array<s16, 4> output{};
+    REQUIRE(buffer.Pop(output.data(), 2) == 2);
+    REQUIRE(output == std::array<s16, 4>{8, 9, 10, 11});
+    REQUIRE(buffer.Discard(100) == 4);
+    REQUIRE(buffer.Size() == 0);
+
+    REQUIRE(buffer.Push(input.data(), 1) == 1);
+    REQUIRE(buffer.Pop(output.data(), 1) == 1);
+    REQUIRE(output[0] == 0);
+    REQUIRE(output[1] == 1);
+}
@@ -0,0 +1,50 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "common/seqlock.h"
+
+namespace Common {
+
+TEST_CASE("SeqLock: Readers see whole values", "[common]") {
+    // Not a multiple of the word size, to cover the partial last word.
+    struct State {
+        std::array<u32, 9> values;
+        u8 tag;
+    };
+
+    SeqLock<State> lock;
+    REQUIRE(lock.Load().tag == 0);
+    const u32 initial_sequence = lock.Sequence();
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        State state{};
+        for (u32 i = 1; i <= 100000; i++) {
+            state.values.fill(i);
+            state.tag = static_cast<u8>(i);
+            lock.Store(state);
+        }
+        done = true;
+    });
+
+    bool torn = false;
+    while (!done) {
+        const State state = lock.Load();
+        for (const u32 value : state.values) {
+            torn |= value != state.values[0];
+        }
+        torn |= state.tag != static_cast<u8>(state.values[0]);
+    }
+    writer.join();
+
+    REQUIRE(!torn);
+    REQUIRE(lock.Load().values[8] == 100000);
+    REQUIRE(lock.Sequence() != initial_sequence);
+}
+
+} // namespace Common
@@ -0,0 +1,60 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <random>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "common/common_types.h"
+#include "common/static_lru_cache.h"
+
+namespace Common {
+
+TEST_CASE("StaticLRUCache evicts the least recently used element", "[common]") {
+    StaticLRUCache<u32, u32, 3> cache;
+    for (u32 key = 0; key < 3; key++) {
+        auto [found, value] = cache.request(key);
+        REQUIRE(!found);
+        value = key * 10;
+    }
+    REQUIRE(cache.size() == 3);
+
+    // Touching 0 makes 1 the least recently used element.
+    REQUIRE(cache.request(0).first);
+    REQUIRE(cache.request(0).second == 0);
+    REQUIRE(!cache.request(3).first);
+    REQUIRE(!cache.contains(1));
+    REQUIRE(cache.contains(0));
+    REQUIRE(cache.contains(2));
+    REQUIRE(cache.request(2).second == 20);
+
+    cache.clear();
+    REQUIRE(cache.empty());
+}
+
+TEST_CASE("StaticLRUCache lookups", "[.][benchmark]") {
+    // The shape of the page cache of ArticCache, 256 lines of 4 KiB.
+    constexpr std::size_t LineSize = 4 * 1024;
+    constexpr std::size_t NumLines = 256;
+    StaticLRUCache<std::size_t, std::array<u8, LineSize>, NumLines> cache;
+
+    // Mostly hits on recently read pages, with some misses on pages further away.
+    std::mt19937 rng{0};
+    std::geometric_distribution<std::size_t> distance{0.02};
+    std::vector<std::size_t> pages(4096);
+    for (auto& page : pages) {
+        page = distance(rng) * LineSize;
+    }
+
+    BENCHMARK("4096 page requests") {
+        std::size_t hits = 0;
+        for (const std::size_t page : pages) {
+            hits += cache.request(page).first;
+        }
+        return hits;
+    };
+}
+
+} // namespace Common
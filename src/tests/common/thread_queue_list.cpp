@@ -0,0 +1,94 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "common/thread_queue_list.h"
+
+using ReadyQueue = Common::ThreadQueueList<int*, 64>;
+
+TEST_CASE("ThreadQueueList[Ordering]", "[common]") {
+    std::array<int, 6> threads{};
+    ReadyQueue queue;
+
+    REQUIRE(queue.get_first() == nullptr);
+    REQUIRE(queue.pop_first() == nullptr);
+
+    queue.push_back(63, &threads[0]);
+    queue.push_back(48, &threads[1]);
+    queue.push_back(48, &threads[2]);
+    queue.push_front(48, &threads[3]);
+    queue.push_back(0, &threads[4]);
+
+    REQUIRE(queue.contains(&threads[2]) == 48);
+    REQUIRE(queue.get_first() == &threads[4]);
+    REQUIRE(queue.pop_first() == &threads[4]);
+    REQUIRE(queue.empty(0));
+
+    // Only strictly better priorities are taken.
+    REQUIRE(queue.pop_first_better(48) == nullptr);
+    REQUIRE(queue.pop_first_better(49) == &threads[3]);
+
+    queue.rotate(48);
+    REQUIRE(queue.pop_first() == &threads[2]);
+
+    queue.move(&threads[1], 48, 10);
+    REQUIRE(queue.empty(48));
+    REQUIRE(queue.pop_first() == &threads[1]);
+
+    queue.remove(63, &threads[0]);
+    REQUIRE(queue.pop_first() == nullptr);
+}
+
+TEST_CASE("ThreadQueueList[RingGrowth]", "[common]") {
+    std::array<int, 100> threads{};
+    ReadyQueue queue;
+
+    // Mixing both ends forces the ring buffer to wrap and grow.
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        if (i % 2) {
+            queue.push_back(30, &threads[i]);
+        } else {
+            queue.push_front(30, &threads[i]);
+        }
+    }
+    queue.remove(30, &threads[50]);
+    for (std::size_t i = 98; i < threads.size(); i -= 2) {
+        if (i != 50) {
+            REQUIRE(queue.pop_first() == &threads[i]);
+        }
+    }
+    for (std::size_t i = 1; i < threads.size(); i += 2) {
+        REQUIRE(queue.pop_first() == &threads[i]);
+    }
+    REQUIRE(queue.empty(30));
+}
+
+// Simulates a title with 32 threads spread over a few priorities that keep signalling each other:
+// every iteration the running thread is preempted by a woken thread and put back in the queue.
+TEST_CASE("ThreadQueueList[SchedulingBenchmark]", "[.][benchmark]") {
+    constexpr std::array<unsigned int, 4> Priorities{0x18, 0x20, 0x30, 0x3F};
+    std::array<int, 32> threads{};
+    ReadyQueue queue;
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        queue.push_back(Priorities[i % Priorities.size()], &threads[i]);
+    }
+
+    BENCHMARK("1000 wake/preempt/reschedule rounds") {
+        unsigned int running_priority = Priorities[3];
+        int* running = queue.pop_first();
+        for (int round = 0; round < 1000; ++round) {
+            int* next = queue.pop_first_better(running_priority);
+            if (next == nullptr) {
+                next = queue.pop_first();
+            }
+            queue.push_back(running_priority, running);
+            running = next;
+            running_priority = Priorities[round % Priorities.size()];
+        }
+        queue.push_back(running_priority, running);
+        return queue.get_first();
+    };
+}
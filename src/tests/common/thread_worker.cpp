@@ -0,0 +1,41 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <future>
+#include <mutex>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/thread_worker.h"
+
+namespace Common {
+
+TEST_CASE("ThreadWorker runs higher priority work first", "[common]") {
+    ThreadWorker worker{1, "TestWorker"};
+
+    // Hold the only worker until all the work is queued.
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    worker.QueueWork([released] { released.wait(); });
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    const auto record = [&](int value) {
+        return [&, value] {
+            std::scoped_lock lock{order_mutex};
+            order.push_back(value);
+        };
+    };
+    worker.QueueWork(record(4), WorkPriority::Background);
+    worker.QueueWork(record(2));
+    worker.QueueWork(record(0), WorkPriority::High);
+    worker.QueueWork(record(3));
+    worker.QueueWork(record(1), WorkPriority::High);
+
+    release.set_value();
+    worker.WaitForRequests();
+    const std::vector<int> expected{0, 1, 2, 3, 4};
+    REQUIRE(order == expected);
+}
+
+} // namespace Common
@@ -0,0 +1,55 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <filesystem>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/file_util.h"
+#include "common/zstd_compression.h"
+
+namespace Common::Compression {
+
+TEST_CASE("ZSTD file streaming round trip", "[common]") {
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string path = (temp_dir / "azahar_zstd_stream_test.bin").string();
+    constexpr u32 Trailer = 0x12345678;
+
+    // Several stream chunks worth of data, partly compressible.
+    std::vector<u8> contents(0x500000 + 0x123);
+    for (std::size_t i = 0; i < contents.size(); ++i) {
+        contents[i] = static_cast<u8>((i / 0x1000) % 3 == 0 ? i >> 6 : i * 131 + (i >> 11));
+    }
+
+    for (const u32 num_workers : {0U, 2U}) {
+        {
+            FileUtil::IOFile file(path, "wb");
+            REQUIRE(CompressDataZSTDToFile(contents, file, num_workers));
+            // Trailing data after the frame is not mistaken for part of it.
+            REQUIRE(file.WriteBytes(&Trailer, sizeof(Trailer)) == sizeof(Trailer));
+        }
+        REQUIRE(FileUtil::GetSize(path) < contents.size());
+
+        FileUtil::IOFile file(path, "rb");
+        REQUIRE(DecompressDataZSTDFromFile(file) == contents);
+        REQUIRE(DecompressDataZSTD(CompressDataZSTDDefault(contents)) == contents);
+    }
+
+    // A frame cut short is rejected instead of returning partial data.
+    std::vector<u8> compressed(FileUtil::GetSize(path) / 2);
+    {
+        FileUtil::IOFile file(path, "rb");
+        REQUIRE(file.ReadBytes(compressed.data(), compressed.size()) == compressed.size());
+    }
+    {
+        FileUtil::IOFile file(path, "wb");
+        REQUIRE(file.WriteBytes(compressed.data(), compressed.size()) == compressed.size());
+    }
+    FileUtil::IOFile file(path, "rb");
+    REQUIRE(DecompressDataZSTDFromFile(file).empty());
+    file.Close();
+
+    FileUtil::Delete(path);
+}
+
+} // namespace Common::Compression
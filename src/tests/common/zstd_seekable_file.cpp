@@ -0,0 +1,66 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/file_util.h"
+#include "common/zstd_seekable_file.h"
+
+namespace Common::Compression {
+
+TEST_CASE("SeekableZstdIOFile round trip", "[common]") {
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string raw_path = (temp_dir / "azahar_seekable_zstd_test.bin").string();
+    const std::string image_path = (temp_dir / "azahar_seekable_zstd_test.zcci").string();
+    constexpr u32 FrameSize = 0x10000;
+
+    std::vector<u8> contents(FrameSize * 5 + 0x123);
+    for (std::size_t i = 0; i < contents.size(); ++i) {
+        contents[i] = static_cast<u8>((i / 0x800) % 2 == 0 ? i >> 4 : i * 31 + (i >> 9));
+    }
+    {
+        FileUtil::IOFile raw(raw_path, "wb");
+        REQUIRE(raw.WriteBytes(contents.data(), contents.size()) == contents.size());
+    }
+    {
+        FileUtil::IOFile raw(raw_path, "rb");
+        FileUtil::IOFile image(image_path, "wb");
+        REQUIRE(CompressSeekableZstdFile(raw, image, FrameSize, 3));
+    }
+
+    {
+        auto plain = OpenImageFile(raw_path);
+        REQUIRE(!plain->IsCompressed());
+
+        auto file = OpenImageFile(image_path);
+        REQUIRE(file->IsCompressed());
+        REQUIRE(file->GetSize() == contents.size());
+        REQUIRE(file->GetSize() > FileUtil::GetSize(image_path));
+
+        // Sequential reads that straddle frame boundaries, including the short last frame.
+        std::vector<u8> buffer(0x3000);
+        for (std::size_t offset = 0; offset < contents.size(); offset += buffer.size()) {
+            const std::size_t expected = std::min(buffer.size(), contents.size() - offset);
+            REQUIRE(file->Tell() == offset);
+            REQUIRE(file->ReadBytes(buffer.data(), expected) == expected);
+            REQUIRE(std::memcmp(buffer.data(), contents.data() + offset, expected) == 0);
+        }
+
+        // Positional reads spanning several frames and reads past the end.
+        std::vector<u8> large(FrameSize * 3);
+        REQUIRE(file->ReadAtBytes(large.data(), large.size(), FrameSize / 2) == large.size());
+        REQUIRE(std::memcmp(large.data(), contents.data() + FrameSize / 2, large.size()) == 0);
+        REQUIRE(file->ReadAtBytes(large.data(), large.size(), contents.size() - 0x10) == 0x10);
+
+        REQUIRE(file->Seek(-0x20, SEEK_END));
+        REQUIRE(file->Tell() == contents.size() - 0x20);
+    }
+
+    FileUtil::Delete(raw_path);
+    FileUtil::Delete(image_path);
+}
+
+} // namespace Common::Compression
@@ -0,0 +1,86 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/arch.h"
+#if CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
+
+#include <array>
+#include <memory>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "core/arm/dynarmic/arm_dynarmic.h"
+#include "core/arm/dynarmic/arm_exclusive_monitor.h"
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+
+namespace {
+
+constexpr VAddr CodeAddress = Memory::HEAP_VADDR;
+constexpr VAddr CounterAddress = Memory::HEAP_VADDR + Memory::CITRA_PAGE_SIZE;
+
+// Increments the word at r1 forever, so every instruction is either a guest memory access or
+// a branch back to them.
+constexpr std::array<u32, 4> CounterLoop{
+    0xE5912000, // ldr r2, [r1]
+    0xE2822001, // add r2, r2, #1
+    0xE5812000, // str r2, [r1]
+    0xEAFFFFFB, // b CodeAddress
+};
+
+/// Runs the loop on the given core for one full timing slice and returns the counter.
+u32 RunSlice(Core::ARM_Interface& cpu, Memory::MemorySystem& memory) {
+    cpu.GetTimer().Advance();
+    cpu.GetTimer().SetNextSlice();
+    cpu.Run();
+    return memory.Read32(CounterAddress);
+}
+
+void ResetCore(Core::ARM_Interface& cpu, Memory::MemorySystem& memory) {
+    memory.Write32(CounterAddress, 0);
+    cpu.SetCPSR(USER32MODE);
+    cpu.SetReg(1, CounterAddress);
+    cpu.SetPC(CodeAddress);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ARM_DynCom and ARM_Dynarmic run the same guest loop", "[.][benchmark]") {
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(CodeAddress, memory.GetFCRAMRef(0), 2 * Memory::CITRA_PAGE_SIZE,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(process->vm_manager.page_table);
+    for (std::size_t i = 0; i < CounterLoop.size(); ++i) {
+        memory.Write32(CodeAddress + static_cast<VAddr>(i * sizeof(u32)), CounterLoop[i]);
+    }
+
+    Core::ARM_DynCom dyncom(system, memory, USER32MODE, 0, timing.GetTimer(0));
+    Core::DynarmicExclusiveMonitor exclusive_monitor(memory, 1);
+    Core::ARM_Dynarmic dynarmic(system, memory, 0, timing.GetTimer(0), exclusive_monitor);
+
+    ResetCore(dyncom, memory);
+    REQUIRE(RunSlice(dyncom, memory) > 0);
+    ResetCore(dynarmic, memory);
+    REQUIRE(RunSlice(dynarmic, memory) > 0);
+
+    BENCHMARK("ARM_DynCom one slice") {
+        return RunSlice(dyncom, memory);
+    };
+    BENCHMARK("ARM_Dynarmic one slice") {
+        return RunSlice(dynarmic, memory);
+    };
+}
+
+#endif // CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
@@ -2,12 +2,17 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <functional>
 #include <string>
+#include <vector>
 #include "common/file_util.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 
@@ -196,4 +201,115 @@ TEST_CASE("CoreTiming[ChainScheduling]", "[core]") {
     REQUIRE(MAX_SLICE_LENGTH == timing.GetTimer(0)->GetDowncount());
 }
 
+namespace ManyEventsTest {
+static constexpr u64 NUM_EVENTS = 16384;
+static std::vector<u64> fired;
+
+static void RecordCallback(std::uintptr_t user_data, s64 cycles_late) {
+    fired.push_back(user_data);
+}
+
+// Spreads the events over the slice without following the scheduling order.
+static constexpr s64 EventTime(u64 id) {
+    return static_cast<s64>((id * 7919) % NUM_EVENTS) + 1;
+}
+} // namespace ManyEventsTest
+
+TEST_CASE("CoreTiming[ManyEventsUnschedule]", "[core]") {
+    using namespace ManyEventsTest;
+
+    Core::Timing timing(1, 100);
+    Core::TimingEventType* cb = timing.RegisterEvent("callbackMany", RecordCallback);
+
+    // Enter slice 0
+    timing.GetTimer(0)->Advance();
+    timing.GetTimer(0)->SetNextSlice();
+
+    for (u64 id = 0; id < NUM_EVENTS; ++id) {
+        timing.ScheduleEvent(EventTime(id), cb, id, 0);
+    }
+    // Unschedule every odd event, they must never fire.
+    for (u64 id = 1; id < NUM_EVENTS; id += 2) {
+        timing.UnscheduleEvent(cb, id);
+    }
+
+    fired.clear();
+    timing.GetTimer(0)->AddTicks(NUM_EVENTS + 1);
+    timing.GetTimer(0)->Advance();
+
+    REQUIRE(fired.size() == NUM_EVENTS / 2);
+    REQUIRE(std::is_sorted(fired.begin(), fired.end(), [](u64 a, u64 b) {
+        return EventTime(a) < EventTime(b);
+    }));
+    REQUIRE(std::all_of(fired.begin(), fired.end(), [](u64 id) { return id % 2 == 0; }));
+}
+
+TEST_CASE("CoreTiming[AdaptiveSliceLimit]", "[core]") {
+    Settings::values.adaptive_slice_length = true;
+
+    Core::Timing timing(1, 100);
+    Core::TimingEventType* cb = timing.RegisterEvent("callbackSlice", [](std::uintptr_t, s64) {});
+
+    timing.GetTimer(0)->Advance();
+    REQUIRE(timing.GetSliceLimit() == MAX_SLICE_LENGTH);
+
+    // Slices grow while nothing is dispatched
+    timing.UpdateSliceLimit(false);
+    REQUIRE(timing.GetSliceLimit() == MAX_SLICE_LENGTH * 2);
+    timing.UpdateSliceLimit(false);
+    timing.UpdateSliceLimit(false);
+    REQUIRE(timing.GetSliceLimit() == Core::Timing::MAX_ADAPTIVE_SLICE_LENGTH);
+
+    // Dispatching an event returns to the base length
+    timing.ScheduleEvent(100, cb, 0, 0);
+    timing.GetTimer(0)->AddTicks(100);
+    timing.GetTimer(0)->Advance();
+    timing.UpdateSliceLimit(false);
+    REQUIRE(timing.GetSliceLimit() == MAX_SLICE_LENGTH);
+
+    // Work handed over from other threads and pending host requests shorten slices
+    timing.ScheduleEvent(100, cb, 0, 0, true);
+    timing.GetTimer(0)->Advance();
+    timing.UpdateSliceLimit(false);
+    REQUIRE(timing.GetSliceLimit() == Core::Timing::MIN_ADAPTIVE_SLICE_LENGTH);
+    timing.UpdateSliceLimit(true);
+    REQUIRE(timing.GetSliceLimit() == Core::Timing::MIN_ADAPTIVE_SLICE_LENGTH);
+
+    Settings::values.adaptive_slice_length = false;
+    timing.UpdateSliceLimit(false);
+    REQUIRE(timing.GetSliceLimit() == MAX_SLICE_LENGTH);
+}
+
+TEST_CASE("CoreTiming[EventQueueBenchmark]", "[.][benchmark]") {
+    using namespace ManyEventsTest;
+
+    // Reference implementation matching the previous std::vector + std::*_heap event queue.
+    BENCHMARK("Linear vector heap, schedule + unschedule") {
+        std::vector<Core::Timing::Event> queue;
+        for (u64 id = 0; id < NUM_EVENTS; ++id) {
+            queue.push_back(Core::Timing::Event{EventTime(id), id, id, nullptr});
+            std::push_heap(queue.begin(), queue.end(), std::greater<>());
+        }
+        for (u64 id = 1; id < NUM_EVENTS; id += 2) {
+            const auto itr = std::remove_if(queue.begin(), queue.end(),
+                                            [&](const auto& e) { return e.user_data == id; });
+            queue.erase(itr, queue.end());
+            std::make_heap(queue.begin(), queue.end(), std::greater<>());
+        }
+        return queue.size();
+    };
+
+    BENCHMARK("Indexed heap, schedule + unschedule") {
+        Core::Timing timing(1, 100);
+        Core::TimingEventType* cb = timing.RegisterEvent("callbackMany", RecordCallback);
+        for (u64 id = 0; id < NUM_EVENTS; ++id) {
+            timing.ScheduleEvent(EventTime(id), cb, id, 0);
+        }
+        for (u64 id = 1; id < NUM_EVENTS; id += 2) {
+            timing.UnscheduleEvent(cb, id);
+        }
+        return timing.GetTimer(0)->GetMaxSliceLength();
+    };
+}
+
 // TODO: Add tests for multiple timers
@@ -0,0 +1,35 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch_test_macros.hpp>
+#include "core/file_sys/delay_generator.h"
+
+namespace FileSys {
+
+TEST_CASE("DelayTable lookup", "[core][file_sys]") {
+    const DelayTable table = DelayTable::Parse(R"(
+# archive  operation  length  delay
+romfs read 0 1000
+romfs read 1000 3000
+romfs read 500 1500 # out of order
+romfs open 0 7000
+* open 0 42
+bogus line
+)");
+
+    REQUIRE(table.GetReadDelayNs("romfs", 0) == 1000);
+    REQUIRE(table.GetReadDelayNs("romfs", 250) == 1250);
+    REQUIRE(table.GetReadDelayNs("romfs", 750) == 2250);
+    // Extended past the last listed length.
+    REQUIRE(table.GetReadDelayNs("romfs", 2000) == 6000);
+    REQUIRE(table.GetOpenDelayNs("romfs") == 7000);
+
+    // Other archive types use the wildcard entries, which have no read delays.
+    REQUIRE(table.GetOpenDelayNs("savedata") == 42);
+    REQUIRE(!table.GetReadDelayNs("savedata", 100));
+
+    REQUIRE(DelayTable::Parse("").Empty());
+}
+
+} // namespace FileSys
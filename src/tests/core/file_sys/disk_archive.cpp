@@ -0,0 +1,71 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/file_util.h"
+#include "core/file_sys/disk_archive.h"
+
+namespace FileSys {
+
+TEST_CASE("DiskFile write-back", "[core][file_sys]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "azahar_disk_file_test.bin").string();
+    std::vector<u8> expected(0x100);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = static_cast<u8>(i);
+    }
+    {
+        FileUtil::IOFile out(path, "wb");
+        REQUIRE(out.WriteBytes(expected.data(), expected.size()) == expected.size());
+    }
+
+    Mode mode{};
+    mode.read_flag.Assign(1);
+    mode.write_flag.Assign(1);
+    {
+        DiskFile file(FileUtil::IOFile(path, "r+b"), mode, nullptr, true);
+
+        const auto write = [&](u64 offset, std::size_t length, u8 value) {
+            const std::vector<u8> data(length, value);
+            REQUIRE(file.Write(offset, length, true, false, data.data()).Unwrap() == length);
+            if (expected.size() < offset + length) {
+                expected.resize(offset + length);
+            }
+            std::memset(expected.data() + offset, value, length);
+        };
+        // Sequential small writes, an overlapping write, a write bridging two pending writes
+        // and one past the end of the file.
+        for (u64 offset = 0x10; offset < 0x40; offset += 4) {
+            write(offset, 4, 0xAA);
+        }
+        write(0x60, 0x10, 0xBB);
+        write(0x38, 0x30, 0xCC);
+        write(0x180, 0x8, 0xDD);
+
+        // Nothing reached the disk yet, but reads and the size see the pending writes.
+        REQUIRE(FileUtil::GetSize(path) == 0x100);
+        REQUIRE(file.GetSize() == expected.size());
+        std::vector<u8> buffer(expected.size() + 0x10);
+        REQUIRE(file.Read(0, buffer.size(), buffer.data()).Unwrap() == expected.size());
+        REQUIRE(std::memcmp(buffer.data(), expected.data(), expected.size()) == 0);
+        REQUIRE(file.Read(0x3C, 4, buffer.data()).Unwrap() == 4);
+        REQUIRE(std::memcmp(buffer.data(), expected.data() + 0x3C, 4) == 0);
+
+        file.Flush();
+        REQUIRE(FileUtil::GetSize(path) == expected.size());
+        write(0x0, 0x2, 0xEE);
+        REQUIRE(file.Close());
+    }
+
+    std::string contents;
+    FileUtil::ReadFileToString(false, path, contents);
+    REQUIRE(contents.size() == expected.size());
+    REQUIRE(std::memcmp(contents.data(), expected.data(), expected.size()) == 0);
+    FileUtil::Delete(path);
+}
+
+} // namespace FileSys
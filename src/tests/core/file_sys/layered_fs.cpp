@@ -0,0 +1,218 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "common/alignment.h"
+#include "common/file_util.h"
+#include "core/file_sys/layered_fs.h"
+
+namespace FileSys {
+
+namespace {
+
+class MemoryRomFSReader final : public RomFSReader {
+public:
+    explicit MemoryRomFSReader(std::vector<u8> data_) : data{std::move(data_)} {}
+
+    std::size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::size_t ReadFile(std::size_t offset, std::size_t length, u8* buffer) override {
+        if (offset >= data.size()) {
+            return 0;
+        }
+        length = std::min(length, data.size() - offset);
+        std::memcpy(buffer, data.data() + offset, length);
+        return length;
+    }
+
+    bool AllowsCachedReads() const override {
+        return false;
+    }
+
+    bool CacheReady(std::size_t file_offset, std::size_t length) override {
+        return false;
+    }
+
+private:
+    std::vector<u8> data;
+};
+
+constexpr u32 NoEntry = 0xFFFFFFFF;
+
+std::string DirectoryName(u32 directory) {
+    return fmt::format("dir{}", directory);
+}
+
+std::string FileName(u32 file) {
+    return fmt::format("file{}.bin", file);
+}
+
+u8 FileByte(u32 directory, u32 file, std::size_t offset) {
+    return static_cast<u8>(directory * 31 + file * 7 + offset);
+}
+
+std::size_t FileSize(u32 file) {
+    return 0x20 + file * 3;
+}
+
+void Append(std::vector<u8>& out, u32 value) {
+    const u32_le le{value};
+    const auto bytes = reinterpret_cast<const u8*>(&le);
+    out.insert(out.end(), bytes, bytes + sizeof(le));
+}
+
+void Append(std::vector<u8>& out, const std::string& name) {
+    for (const char c : name) {
+        out.push_back(static_cast<u8>(c));
+        out.push_back(0);
+    }
+    out.resize(Common::AlignUp(out.size(), 4));
+}
+
+u32 EntrySize(std::size_t metadata_size, const std::string& name) {
+    return static_cast<u32>(metadata_size + Common::AlignUp(name.size() * 2, 4));
+}
+
+/**
+ * Builds a RomFS with the given number of directories under the root, each holding the given
+ * number of files. The hash tables are left empty, as LayeredFS only walks the directory tree.
+ */
+std::vector<u8> BuildRomFS(u32 num_directories, u32 files_per_directory) {
+    constexpr std::size_t DirectoryMetadataSize = 0x18;
+    constexpr std::size_t FileMetadataSize = 0x20;
+
+    std::vector<u32> directory_offsets;
+    u32 offset = EntrySize(DirectoryMetadataSize, "");
+    for (u32 d = 0; d < num_directories; d++) {
+        directory_offsets.push_back(offset);
+        offset += EntrySize(DirectoryMetadataSize, DirectoryName(d));
+    }
+    std::vector<u32> file_offsets;
+    offset = 0;
+    for (u32 d = 0; d < num_directories; d++) {
+        for (u32 f = 0; f < files_per_directory; f++) {
+            file_offsets.push_back(offset);
+            offset += EntrySize(FileMetadataSize, FileName(f));
+        }
+    }
+
+    std::vector<u8> directories;
+    Append(directories, 0);
+    Append(directories, NoEntry);
+    Append(directories, num_directories != 0 ? directory_offsets[0] : NoEntry);
+    Append(directories, NoEntry);
+    Append(directories, NoEntry);
+    Append(directories, 0);
+    for (u32 d = 0; d < num_directories; d++) {
+        const std::string name = DirectoryName(d);
+        Append(directories, 0);
+        Append(directories, d + 1 < num_directories ? directory_offsets[d + 1] : NoEntry);
+        Append(directories, NoEntry);
+        Append(directories, files_per_directory != 0 ? file_offsets[d * files_per_directory]
+                                                     : NoEntry);
+        Append(directories, NoEntry);
+        Append(directories, static_cast<u32>(name.size() * 2));
+        Append(directories, name);
+    }
+
+    std::vector<u8> files;
+    std::vector<u8> file_data;
+    for (u32 d = 0; d < num_directories; d++) {
+        for (u32 f = 0; f < files_per_directory; f++) {
+            const std::string name = FileName(f);
+            const u64 data_offset = file_data.size();
+            Append(files, directory_offsets[d]);
+            Append(files, f + 1 < files_per_directory
+                              ? file_offsets[d * files_per_directory + f + 1]
+                              : NoEntry);
+            Append(files, static_cast<u32>(data_offset));
+            Append(files, static_cast<u32>(data_offset >> 32));
+            Append(files, static_cast<u32>(FileSize(f)));
+            Append(files, 0);
+            Append(files, NoEntry);
+            Append(files, static_cast<u32>(name.size() * 2));
+            Append(files, name);
+
+            for (std::size_t i = 0; i < FileSize(f); i++) {
+                file_data.push_back(FileByte(d, f, i));
+            }
+            file_data.resize(Common::AlignUp(file_data.size(), 16));
+        }
+    }
+
+    constexpr u32 HeaderSize = sizeof(RomFSHeader);
+    const u32 directories_offset = HeaderSize;
+    const u32 files_offset = directories_offset + static_cast<u32>(directories.size());
+    const u32 data_offset =
+        Common::AlignUp(files_offset + static_cast<u32>(files.size()), 16);
+
+    std::vector<u8> romfs;
+    Append(romfs, HeaderSize);
+    Append(romfs, directories_offset);
+    Append(romfs, 0);
+    Append(romfs, directories_offset);
+    Append(romfs, static_cast<u32>(directories.size()));
+    Append(romfs, files_offset);
+    Append(romfs, 0);
+    Append(romfs, files_offset);
+    Append(romfs, static_cast<u32>(files.size()));
+    Append(romfs, data_offset);
+    romfs.insert(romfs.end(), directories.begin(), directories.end());
+    romfs.insert(romfs.end(), files.begin(), files.end());
+    romfs.resize(data_offset);
+    romfs.insert(romfs.end(), file_data.begin(), file_data.end());
+    return romfs;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("LayeredFS rebuilds the RomFS metadata", "[core][file_sys]") {
+    constexpr u32 NumDirectories = 4;
+    constexpr u32 FilesPerDirectory = 5;
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "azahar_layered_fs_test").string();
+    std::filesystem::remove_all(path);
+
+    // Read the rebuilt RomFS back through a second layer, which walks its metadata.
+    auto layer = std::make_shared<LayeredFS>(
+        std::make_shared<MemoryRomFSReader>(BuildRomFS(NumDirectories, FilesPerDirectory)), "",
+        "", false);
+    LayeredFS reader{layer, "", "", false};
+    REQUIRE(reader.DumpRomFS(path));
+
+    for (u32 d = 0; d < NumDirectories; d++) {
+        for (u32 f = 0; f < FilesPerDirectory; f++) {
+            std::string contents;
+            const std::string file_path =
+                fmt::format("{}/{}/{}", path, DirectoryName(d), FileName(f));
+            REQUIRE(FileUtil::ReadFileToString(true, file_path, contents) == FileSize(f));
+            for (std::size_t i = 0; i < contents.size(); i++) {
+                REQUIRE(static_cast<u8>(contents[i]) == FileByte(d, f, i));
+            }
+        }
+    }
+
+    std::filesystem::remove_all(path);
+}
+
+TEST_CASE("LayeredFS build", "[.][benchmark]") {
+    auto romfs = std::make_shared<MemoryRomFSReader>(BuildRomFS(64, 64));
+
+    BENCHMARK("64 directories x 64 files") {
+        LayeredFS layered_fs{romfs, "", "", false};
+        return layered_fs.GetSize();
+    };
+}
+
+} // namespace FileSys
@@ -0,0 +1,127 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/file_util.h"
+#include "core/file_sys/romfs_reader.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr std::size_t FileOffset = 0x200;
+constexpr std::size_t DataSize = 0x100000 + 0x123;
+constexpr std::size_t BlockSize = 128 * 1024;
+
+/// A plain file that claims to be encrypted, so the reader can't map it and uses its block cache.
+class UnmappableFile final : public FileUtil::IOFile {
+public:
+    using IOFile::IOFile;
+
+    bool IsCrypto() override {
+        return true;
+    }
+};
+
+struct RomFSFile {
+    std::string path =
+        (std::filesystem::temp_directory_path() / "azahar_romfs_reader_test.bin").string();
+    std::vector<u8> contents = std::vector<u8>(FileOffset + DataSize);
+
+    RomFSFile() {
+        for (std::size_t i = 0; i < contents.size(); ++i) {
+            contents[i] = static_cast<u8>(i * 31 + (i >> 9));
+        }
+        FileUtil::IOFile out(path, "wb");
+        REQUIRE(out.WriteBytes(contents.data(), contents.size()) == contents.size());
+    }
+
+    ~RomFSFile() {
+        FileUtil::Delete(path);
+    }
+
+    const u8* Data() const {
+        return contents.data() + FileOffset;
+    }
+};
+
+void CheckReads(DirectRomFSReader& reader, const u8* data) {
+    std::vector<u8> buffer(0x3000);
+
+    // Sequential reads that straddle block boundaries, including the short last block.
+    for (std::size_t offset = 0; offset < DataSize; offset += buffer.size()) {
+        const std::size_t expected = std::min(buffer.size(), DataSize - offset);
+        REQUIRE(reader.ReadFile(offset, buffer.size(), buffer.data()) == expected);
+        REQUIRE(std::memcmp(buffer.data(), data + offset, expected) == 0);
+    }
+    CHECK(reader.CacheReady(0, 0x100));
+
+    REQUIRE(reader.ReadFile(0x1FFF0, 0x20, buffer.data()) == 0x20);
+    CHECK(std::memcmp(buffer.data(), data + 0x1FFF0, 0x20) == 0);
+    CHECK(reader.ReadFile(DataSize, 0x10, buffer.data()) == 0);
+
+    // Reads bigger than a block are never reported as ready to be done inline.
+    std::vector<u8> big(0x40000);
+    CHECK_FALSE(reader.CacheReady(0x10, big.size()));
+    REQUIRE(reader.ReadFile(0x10, big.size(), big.data()) == big.size());
+    CHECK(std::memcmp(big.data(), data + 0x10, big.size()) == 0);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DirectRomFSReader reads mapped files", "[core][file_sys]") {
+    const RomFSFile file;
+    DirectRomFSReader reader(std::make_unique<FileUtil::IOFile>(file.path, "rb"), FileOffset,
+                             DataSize);
+    CheckReads(reader, file.Data());
+}
+
+TEST_CASE("DirectRomFSReader block cache", "[core][file_sys]") {
+    const RomFSFile file;
+    DirectRomFSReader reader(std::make_unique<UnmappableFile>(file.path, "rb"), FileOffset,
+                             DataSize);
+
+    SECTION("reads") {
+        CheckReads(reader, file.Data());
+    }
+
+    SECTION("blocks are cached once read") {
+        std::vector<u8> buffer(0x100);
+        CHECK_FALSE(reader.IsCached(0x10, buffer.size()));
+        // Small reads are done inline even when they miss.
+        CHECK(reader.CacheReady(0x10, buffer.size()));
+        REQUIRE(reader.ReadFile(0x10, buffer.size(), buffer.data()) == buffer.size());
+        CHECK(std::memcmp(buffer.data(), file.Data() + 0x10, buffer.size()) == 0);
+        CHECK(reader.IsCached(0x10, buffer.size()));
+        CHECK(reader.IsCached(BlockSize - 0x100, 0x100));
+        CHECK_FALSE(reader.IsCached(6 * BlockSize, 0x100));
+    }
+
+    SECTION("sequential reads fetch the following blocks ahead") {
+        std::vector<u8> buffer(0x100);
+        REQUIRE(reader.ReadFile(0, buffer.size(), buffer.data()) == buffer.size());
+        REQUIRE(reader.ReadFile(BlockSize, buffer.size(), buffer.data()) == buffer.size());
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!reader.IsCached(3 * BlockSize, buffer.size()) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(reader.IsCached(2 * BlockSize, buffer.size()));
+        REQUIRE(reader.IsCached(3 * BlockSize, buffer.size()));
+
+        // Served from the block the worker read.
+        REQUIRE(reader.ReadFile(3 * BlockSize + 0x10, buffer.size(), buffer.data()) ==
+                buffer.size());
+        CHECK(std::memcmp(buffer.data(), file.Data() + 3 * BlockSize + 0x10, buffer.size()) == 0);
+    }
+}
+
+} // namespace FileSys
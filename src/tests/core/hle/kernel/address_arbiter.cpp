@@ -0,0 +1,151 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/address_arbiter.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+
+namespace Kernel {
+
+namespace {
+
+std::shared_ptr<Thread> MakeThread(KernelSystem& kernel, u32 priority, VAddr wait_address = 0) {
+    auto thread = std::make_shared<Thread>(kernel, 0);
+    thread->status = ThreadStatus::Dormant;
+    thread->current_priority = priority;
+    thread->wait_address = wait_address;
+    thread->tls_address = Memory::TLS_AREA_VADDR;
+    return thread;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AddressArbiter splits the wait list of older savestates", "[core][kernel]") {
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+
+    constexpr VAddr first = Memory::HEAP_VADDR;
+    constexpr VAddr second = Memory::HEAP_VADDR + 4;
+    const auto a = MakeThread(kernel, 0x30, first);
+    const auto b = MakeThread(kernel, 0x30, second);
+    const auto c = MakeThread(kernel, 0x30, first);
+
+    // A version 0 arbiter stored its waiting threads as one list in arrival order.
+    AddressArbiter::WaitLists wait_lists;
+    wait_lists.AddUnsorted({a, b, c});
+
+    SECTION("lookups split the list by wait address") {
+        const auto* const first_list = wait_lists.Find(first);
+        REQUIRE(first_list != nullptr);
+        CHECK(*first_list == AddressArbiter::WaitLists::List{a, c});
+        const auto* const second_list = wait_lists.Find(second);
+        REQUIRE(second_list != nullptr);
+        CHECK(*second_list == AddressArbiter::WaitLists::List{b});
+        CHECK(wait_lists.Find(second + 4) == nullptr);
+    }
+
+    SECTION("new waiters queue up behind the loaded ones") {
+        const auto d = MakeThread(kernel, 0x30, first);
+        wait_lists.Add(d);
+        const auto* const first_list = wait_lists.Find(first);
+        REQUIRE(first_list != nullptr);
+        CHECK(*first_list == AddressArbiter::WaitLists::List{a, c, d});
+
+        wait_lists.Erase(first);
+        CHECK(wait_lists.Find(first) == nullptr);
+        CHECK(wait_lists.Find(second) != nullptr);
+    }
+}
+
+TEST_CASE("AddressArbiter with many waiters", "[.][benchmark]") {
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, memory.GetFCRAMRef(0),
+                                  Memory::CITRA_PAGE_SIZE, Kernel::MemoryState::Private)
+                .Succeeded());
+    memory.SetCurrentPageTable(process->vm_manager.page_table);
+
+    constexpr std::size_t NumWaiters = 128;
+    const auto arbiter = kernel.CreateAddressArbiter("test");
+    // Below the priority at which signalling no thread charges the current core.
+    const auto signaller = MakeThread(kernel, 0x30);
+    std::vector<std::shared_ptr<Thread>> waiters;
+    for (std::size_t i = 0; i < NumWaiters; ++i) {
+        waiters.push_back(MakeThread(kernel, 0x18 + static_cast<u32>(i % 32)));
+    }
+    const auto address_of = [](std::size_t i) {
+        return Memory::HEAP_VADDR + static_cast<VAddr>(i * sizeof(u32));
+    };
+    for (std::size_t i = 0; i < NumWaiters; ++i) {
+        memory.Write32(address_of(i), 0);
+    }
+
+    // The value in memory is below 1, so every waiter goes to sleep.
+    const auto wait = [&](auto&& address) {
+        for (std::size_t i = 0; i < NumWaiters; ++i) {
+            arbiter->ArbitrateAddress(waiters[i], ArbitrationType::WaitIfLessThan, address(i), 1,
+                                      0);
+        }
+    };
+    // Takes the woken threads off the ready queue again.
+    const auto reset = [&] {
+        for (const auto& waiter : waiters) {
+            waiter->Stop();
+            waiter->status = ThreadStatus::Dormant;
+        }
+    };
+
+    wait([&](std::size_t) { return address_of(0); });
+    for (std::size_t i = 0; i < NumWaiters; ++i) {
+        REQUIRE(waiters[i]->status == ThreadStatus::WaitArb);
+    }
+    // The first of the highest priority waiters wakes up first.
+    arbiter->ArbitrateAddress(signaller, ArbitrationType::Signal, address_of(0), 1, 0);
+    CHECK(waiters[0]->status == ThreadStatus::Ready);
+    CHECK(waiters[32]->status == ThreadStatus::WaitArb);
+    CHECK(waiters[1]->status == ThreadStatus::WaitArb);
+    arbiter->ArbitrateAddress(signaller, ArbitrationType::Signal, address_of(0), -1, 0);
+    reset();
+    REQUIRE_FALSE(kernel.GetThreadManager(0).HaveReadyThreads());
+
+    BENCHMARK("128 waiters on one address, signalled one at a time") {
+        wait([&](std::size_t) { return address_of(0); });
+        for (std::size_t i = 0; i < NumWaiters; ++i) {
+            arbiter->ArbitrateAddress(signaller, ArbitrationType::Signal, address_of(0), 1, 0);
+        }
+        reset();
+    };
+    BENCHMARK("128 waiters on their own addresses, signalled in turn") {
+        wait(address_of);
+        for (std::size_t i = 0; i < NumWaiters; ++i) {
+            arbiter->ArbitrateAddress(signaller, ArbitrationType::Signal, address_of(i), 1, 0);
+        }
+        reset();
+    };
+    BENCHMARK("128 waiters on one address, all signalled at once") {
+        wait([&](std::size_t) { return address_of(0); });
+        arbiter->ArbitrateAddress(signaller, ArbitrationType::Signal, address_of(0), -1, 0);
+        reset();
+    };
+}
+
+} // namespace Kernel
@@ -0,0 +1,71 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/errors.h"
+#include "core/hle/kernel/event.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/mutex.h"
+
+namespace Kernel {
+
+TEST_CASE("HandleTable generations", "[core][kernel]") {
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    HandleTable table(kernel);
+
+    auto event = kernel.CreateEvent(ResetType::OneShot);
+    Handle handle{};
+    REQUIRE(table.Create(&handle, event) == ResultSuccess);
+    CHECK(table.IsValid(handle));
+    CHECK(table.Get<Event>(handle) == event);
+    CHECK(table.Get<WaitObject>(handle) == event);
+    CHECK(table.Get<Mutex>(handle) == nullptr);
+
+    REQUIRE(table.Close(handle) == ResultSuccess);
+    CHECK(!table.IsValid(handle));
+    CHECK(table.Close(handle) == ResultInvalidHandle);
+
+    // The freed slot is reused with a new generation, so the stale handle stays invalid.
+    Handle reused{};
+    REQUIRE(table.Create(&reused, kernel.CreateMutex(false)) == ResultSuccess);
+    CHECK(reused >> 15 == handle >> 15);
+    CHECK(reused != handle);
+    CHECK(table.GetGeneric(handle) == nullptr);
+    CHECK(table.Get<Mutex>(reused) != nullptr);
+}
+
+// Mirrors the handle validation loop of svcWaitSynchronizationN with the maximum of 64 handles.
+TEST_CASE("HandleTable WaitSynchronizationN lookups", "[.][benchmark]") {
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    HandleTable table(kernel);
+
+    std::array<Handle, 64> handles{};
+    for (auto& handle : handles) {
+        REQUIRE(table.Create(&handle, kernel.CreateEvent(ResetType::OneShot)) == ResultSuccess);
+    }
+
+    std::array<std::shared_ptr<WaitObject>, 64> objects;
+    BENCHMARK("Get<WaitObject> x 64") {
+        for (std::size_t i = 0; i < handles.size(); ++i) {
+            objects[i] = table.Get<WaitObject>(handles[i]);
+        }
+        return objects.back().get();
+    };
+}
+
+} // namespace Kernel
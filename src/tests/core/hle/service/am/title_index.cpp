@@ -0,0 +1,56 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <filesystem>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "common/file_util.h"
+#include "core/hle/service/am/title_index.h"
+
+namespace Service::AM {
+
+TEST_CASE("TitleIndex keeps titles whose files did not change", "[core][am]") {
+    const auto dir = std::filesystem::temp_directory_path() / "azahar_title_index_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const std::string index_path = (dir / "index.txt").string();
+    const std::string tmd_path = (dir / "00000000.tmd").string();
+    const std::string content_path = (dir / "00000000.app").string();
+    REQUIRE(FileUtil::WriteStringToFile(false, tmd_path, "tmd") == 3);
+    REQUIRE(FileUtil::WriteStringToFile(false, content_path, "content") == 7);
+
+    constexpr u64 title_id = 0x00040000'00055D00;
+    constexpr u64 other_title_id = 0x00040000'00030800;
+    {
+        TitleIndex index{index_path};
+        REQUIRE(!index.Validate(title_id));
+        REQUIRE(index.Insert(title_id, tmd_path, content_path));
+        REQUIRE(!index.Insert(other_title_id, tmd_path, (dir / "missing.app").string()));
+        index.Prune();
+        REQUIRE(index.Save());
+    }
+    {
+        TitleIndex index{index_path};
+        REQUIRE(index.Size() == 1);
+        REQUIRE(index.Validate(title_id));
+    }
+
+    SECTION("changed files invalidate the title") {
+        REQUIRE(FileUtil::WriteStringToFile(false, content_path, "new content") == 11);
+        TitleIndex index{index_path};
+        REQUIRE(!index.Validate(title_id));
+    }
+
+    SECTION("titles not seen by a scan are pruned") {
+        TitleIndex index{index_path};
+        index.Prune();
+        REQUIRE(index.Size() == 0);
+        REQUIRE(index.Save());
+        REQUIRE(TitleIndex{index_path}.Size() == 0);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+} // namespace Service::AM
@@ -0,0 +1,131 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "common/scope_exit.h"
+#include "core/hle/service/soc/socket_readiness.h"
+#include "network/socket_manager.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define closesocket(x) close(x)
+#endif
+
+namespace Service::SOC {
+
+namespace {
+
+template <typename Predicate>
+bool WaitFor(Predicate&& predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SocketReadiness classes of poll events", "[core][soc]") {
+    constexpr u8 Readable = SocketReadiness::Readable;
+    constexpr u8 Writable = SocketReadiness::Writable;
+
+    SECTION("normal data is cached") {
+        CHECK(SocketReadiness::EventClasses(POLLIN) == Readable);
+        CHECK(SocketReadiness::EventClasses(POLLRDNORM) == Readable);
+        CHECK(SocketReadiness::EventClasses(POLLOUT) == Writable);
+        CHECK(SocketReadiness::EventClasses(POLLIN | POLLOUT) == (Readable | Writable));
+    }
+
+    SECTION("priority data is not") {
+        CHECK(SocketReadiness::EventClasses(POLLPRI) == 0);
+        CHECK(SocketReadiness::EventClasses(POLLIN | POLLRDBAND) == 0);
+        CHECK(SocketReadiness::EventClasses(POLLOUT | POLLWRBAND) == 0);
+    }
+
+    SECTION("reported events are not idle") {
+        CHECK(SocketReadiness::IdleClasses(POLLIN | POLLOUT, 0) == (Readable | Writable));
+        CHECK(SocketReadiness::IdleClasses(POLLIN | POLLOUT, POLLOUT) == Readable);
+        CHECK(SocketReadiness::IdleClasses(POLLIN | POLLOUT, POLLIN) == Writable);
+        CHECK(SocketReadiness::IdleClasses(POLLIN, POLLPRI) == 0);
+    }
+
+    SECTION("errors and hang ups are not idle") {
+        CHECK(SocketReadiness::IdleClasses(POLLIN | POLLOUT, POLLERR) == 0);
+        CHECK(SocketReadiness::IdleClasses(POLLIN | POLLOUT, POLLHUP) == 0);
+        CHECK(SocketReadiness::IdleClasses(POLLIN | POLLOUT, POLLNVAL) == 0);
+    }
+}
+
+TEST_CASE("SocketReadiness idle sockets", "[core][soc]") {
+    Network::SocketManager::EnableSockets();
+    SCOPE_EXIT({ Network::SocketManager::DisableSockets(); });
+
+    // A datagram socket connected to itself, so the test can make it readable.
+    const auto fd = static_cast<SocketHolder::SOCKET>(::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    REQUIRE(fd != static_cast<SocketHolder::SOCKET>(-1));
+    SCOPE_EXIT({ closesocket(fd); });
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    REQUIRE(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0);
+    REQUIRE(::connect(fd, reinterpret_cast<sockaddr*>(&addr), addr_len) == 0);
+    const auto send_datagram = [fd] {
+        const char data = 0;
+        REQUIRE(::send(fd, &data, sizeof(data), 0) == sizeof(data));
+    };
+    const auto receive_datagram = [fd] {
+        char data;
+        REQUIRE(::recv(fd, &data, sizeof(data), 0) == sizeof(data));
+    };
+
+    SocketReadiness readiness;
+    constexpr u8 Readable = SocketReadiness::Readable;
+
+    // Nothing is known about a socket before a host call finds it idle.
+    const u64 sequence = readiness.Sequence(fd);
+    CHECK_FALSE(readiness.IsIdle(fd, Readable));
+    readiness.MarkIdle(fd, Readable, sequence);
+    CHECK(readiness.IsIdle(fd, Readable));
+    CHECK_FALSE(readiness.IsIdle(fd, Readable | SocketReadiness::Writable));
+
+    SECTION("an event makes the socket ready again") {
+        send_datagram();
+        REQUIRE(WaitFor([&] { return !readiness.IsIdle(fd, Readable); }));
+        CHECK(readiness.Sequence(fd) != sequence);
+    }
+
+    SECTION("an idle observation older than the last event is ignored") {
+        send_datagram();
+        REQUIRE(WaitFor([&] { return !readiness.IsIdle(fd, Readable); }));
+        receive_datagram();
+
+        // A host call that started before the event may still report the socket as idle.
+        readiness.MarkIdle(fd, Readable, sequence);
+        CHECK_FALSE(readiness.IsIdle(fd, Readable));
+
+        readiness.MarkIdle(fd, Readable, readiness.Sequence(fd));
+        CHECK(readiness.IsIdle(fd, Readable));
+    }
+
+    SECTION("forgotten sockets go to the host") {
+        readiness.Forget(fd);
+        CHECK_FALSE(readiness.IsIdle(fd, Readable));
+    }
+}
+
+} // namespace Service::SOC
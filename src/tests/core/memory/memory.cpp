@@ -2,10 +2,17 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
 #include "core/memory.h"
 
 TEST_CASE("memory.IsValidVirtualAddress", "[core][memory]") {
@@ -55,3 +62,189 @@ TEST_CASE("memory.IsValidVirtualAddress", "[core][memory]") {
         CHECK(memory.IsValidVirtualAddress(*process, Memory::CONFIG_MEMORY_VADDR) == false);
     }
 }
+
+TEST_CASE("memory.BlockOperations", "[core][memory]") {
+    constexpr u32 BlockSize = 16 * Memory::CITRA_PAGE_SIZE;
+
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    // Two separately mapped blocks that are contiguous in FCRAM
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, memory.GetFCRAMRef(0), BlockSize,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR + BlockSize, memory.GetFCRAMRef(BlockSize),
+                                  BlockSize, Kernel::MemoryState::Private)
+                .Succeeded());
+
+    std::vector<u8> data(BlockSize + 3 * Memory::CITRA_PAGE_SIZE / 2);
+    std::iota(data.begin(), data.end(), u8{1});
+    const VAddr addr = Memory::HEAP_VADDR + 0x123;
+
+    memory.WriteBlock(*process, addr, data.data(), data.size());
+    std::vector<u8> read(data.size());
+    memory.ReadBlock(*process, addr, read.data(), read.size());
+    CHECK(read == data);
+
+    memory.CopyBlock(*process, addr + BlockSize / 2, addr, Memory::CITRA_PAGE_SIZE * 3);
+    memory.ReadBlock(*process, addr + BlockSize / 2, read.data(), Memory::CITRA_PAGE_SIZE * 3);
+    CHECK(std::equal(data.begin(), data.begin() + Memory::CITRA_PAGE_SIZE * 3, read.begin()));
+
+    memory.ZeroBlock(*process, addr, data.size());
+    memory.ReadBlock(*process, addr, read.data(), read.size());
+    CHECK(std::all_of(read.begin(), read.end(), [](u8 b) { return b == 0; }));
+    // Both mappings are backed by consecutive FCRAM, so they can be viewed as one host block.
+    u8* const pointer = memory.GetContiguousPointer(*process, addr, data.size());
+    CHECK(pointer == memory.GetFCRAMPointer(0x123));
+    // Blocks that reach into unmapped memory cannot.
+    CHECK(memory.GetContiguousPointer(*process, addr, 2 * BlockSize) == nullptr);
+}
+
+TEST_CASE("memory.BlockOperations throughput", "[.][benchmark]") {
+    constexpr u32 BlockSize = 256 * Memory::CITRA_PAGE_SIZE;
+
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    REQUIRE(process->vm_manager
+                .MapBackingMemory(Memory::HEAP_VADDR, memory.GetFCRAMRef(0), 2 * BlockSize,
+                                  Kernel::MemoryState::Private)
+                .Succeeded());
+
+    std::vector<u8> buffer(BlockSize);
+    BENCHMARK("ReadBlock 1 MiB") {
+        memory.ReadBlock(*process, Memory::HEAP_VADDR + 0x10, buffer.data(), buffer.size());
+        return buffer[0];
+    };
+    BENCHMARK("WriteBlock 1 MiB") {
+        memory.WriteBlock(*process, Memory::HEAP_VADDR + 0x10, buffer.data(), buffer.size());
+    };
+    BENCHMARK("CopyBlock 1 MiB") {
+        memory.CopyBlock(*process, Memory::HEAP_VADDR + BlockSize, Memory::HEAP_VADDR, BlockSize);
+    };
+}
+
+static void IncrementExclusive(Core::ExclusiveMonitor& monitor, std::size_t core_index,
+                               VAddr addr, u32 iterations) {
+    for (u32 i = 0; i < iterations; ++i) {
+        u32 value;
+        do {
+            value = monitor.ExclusiveRead32(core_index, addr);
+        } while (!monitor.ExclusiveWrite32(core_index, addr, value + 1));
+    }
+}
+
+static void HammerExclusive(Core::ExclusiveMonitor& monitor, std::size_t num_cores, VAddr addr,
+                            u32 iterations) {
+    std::vector<std::thread> threads;
+    for (std::size_t core_index = 0; core_index < num_cores; ++core_index) {
+        threads.emplace_back(IncrementExclusive, std::ref(monitor), core_index, addr, iterations);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST_CASE("memory.ExclusiveMonitor", "[core][memory]") {
+    constexpr std::size_t NumCores = 4;
+    constexpr u32 Iterations = 10000;
+
+    Core::Timing timing(NumCores, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, NumCores,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    kernel.MapSharedPages(process->vm_manager);
+    memory.SetCurrentPageTable(process->vm_manager.page_table);
+
+    auto monitor = Core::MakeExclusiveMonitor(memory, NumCores);
+    if (!monitor) {
+        SKIP("No exclusive monitor for this configuration");
+    }
+
+    const VAddr addr = Memory::SHARED_PAGE_VADDR;
+    memory.Write32(addr, 0);
+    HammerExclusive(*monitor, NumCores, addr, Iterations);
+    REQUIRE(memory.Read32(addr) == NumCores * Iterations);
+}
+
+static void IncrementThroughPageTable(Memory::MemorySystem& memory,
+                                      Memory::PageTable& page_table, VAddr addr, u32 iterations) {
+    for (u32 i = 0; i < iterations; ++i) {
+        u32 value;
+        do {
+            value = memory.Read32(addr);
+        } while (!memory.WriteExclusive32(page_table, addr, value + 1, value).value());
+    }
+}
+
+TEST_CASE("memory.WriteExclusive through a core's page table", "[core][memory]") {
+    constexpr std::size_t NumCores = 4;
+    constexpr u32 Iterations = 10000;
+
+    Core::Timing timing(NumCores, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, NumCores,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    kernel.MapSharedPages(process->vm_manager);
+    memory.SetCurrentPageTable(process->vm_manager.page_table);
+
+    SECTION("pages without a host pointer are left to the current address space") {
+        CHECK_FALSE(memory.WriteExclusive32(*process->vm_manager.page_table, Memory::HEAP_VADDR, 1,
+                                            0)
+                        .has_value());
+    }
+
+    SECTION("no increments are lost when the cores commit concurrently") {
+        // This is the path the dynarmic store-exclusive callbacks take without the HLE lock.
+        const VAddr addr = Memory::SHARED_PAGE_VADDR;
+        memory.Write32(addr, 0);
+        std::vector<std::thread> threads;
+        for (std::size_t core_index = 0; core_index < NumCores; ++core_index) {
+            threads.emplace_back(IncrementThroughPageTable, std::ref(memory),
+                                 std::ref(*process->vm_manager.page_table), addr, Iterations);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(memory.Read32(addr) == NumCores * Iterations);
+    }
+}
+
+TEST_CASE("memory.ExclusiveMonitor contention", "[.][benchmark]") {
+    constexpr std::size_t NumCores = 4;
+
+    Core::Timing timing(NumCores, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, NumCores,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    kernel.MapSharedPages(process->vm_manager);
+    memory.SetCurrentPageTable(process->vm_manager.page_table);
+
+    auto monitor = Core::MakeExclusiveMonitor(memory, NumCores);
+    if (!monitor) {
+        SKIP("No exclusive monitor for this configuration");
+    }
+
+    BENCHMARK("4 cores x 100000 exclusive increments") {
+        HammerExclusive(*monitor, NumCores, Memory::SHARED_PAGE_VADDR, 100000);
+    };
+}
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <iterator>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -152,3 +154,126 @@ TEST_CASE("Memory Basics", "[kernel][memory]") {
         REQUIRE(code == ResultSuccess);
     }
 }
+
+/// Checks that the VMAs tile the address space and that no mergeable neighbours are left.
+static bool IsVMAMapConsistent(const Kernel::VMManager& manager) {
+    VAddr expected_base = 0;
+    for (auto it = manager.vma_map.begin(); it != manager.vma_map.end(); ++it) {
+        if (it->first != it->second.base || it->second.base != expected_base) {
+            return false;
+        }
+        const auto next = std::next(it);
+        if (next != manager.vma_map.end() && it->second.CanBeMergedWith(next->second)) {
+            return false;
+        }
+        expected_base += it->second.size;
+    }
+    return expected_base == Kernel::VMManager::MAX_ADDRESS;
+}
+
+TEST_CASE("VMManager fragmentation", "[kernel][memory]") {
+    constexpr u32 NumPages = 256;
+    auto mem = std::make_shared<BufferMem>(NumPages * Memory::CITRA_PAGE_SIZE);
+    MemoryRef block{mem};
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    Kernel::Process process(kernel);
+    auto manager = std::make_unique<Kernel::VMManager>(memory, process);
+
+    // Map every page separately with alternating states so that none of them merge.
+    for (u32 i = 0; i < NumPages; ++i) {
+        const auto state = i % 2 ? Kernel::MemoryState::Private : Kernel::MemoryState::Shared;
+        REQUIRE(manager
+                    ->MapBackingMemory(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE,
+                                       block + i * Memory::CITRA_PAGE_SIZE,
+                                       Memory::CITRA_PAGE_SIZE, state)
+                    .Succeeded());
+    }
+    CHECK(manager->vma_map.size() == NumPages + 2);
+    CHECK(IsVMAMapConsistent(*manager));
+
+    // Reprotecting a range that starts and ends inside mapped pages splits both edges.
+    REQUIRE(manager->ReprotectRange(Memory::HEAP_VADDR + 8 * Memory::CITRA_PAGE_SIZE,
+                                    64 * Memory::CITRA_PAGE_SIZE,
+                                    Kernel::VMAPermission::Read) == ResultSuccess);
+    CHECK(IsVMAMapConsistent(*manager));
+    CHECK(manager->FindVMA(Memory::HEAP_VADDR + 8 * Memory::CITRA_PAGE_SIZE)->second.permissions ==
+          Kernel::VMAPermission::Read);
+    CHECK(manager->FindVMA(Memory::HEAP_VADDR + 72 * Memory::CITRA_PAGE_SIZE)->second.permissions ==
+          Kernel::VMAPermission::ReadWrite);
+
+    // Unmapping every other page leaves isolated mappings behind.
+    for (u32 i = 0; i < NumPages; i += 2) {
+        REQUIRE(manager->UnmapRange(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE,
+                                    Memory::CITRA_PAGE_SIZE) == ResultSuccess);
+    }
+    CHECK(IsVMAMapConsistent(*manager));
+
+    REQUIRE(manager->ChangeMemoryState(Memory::HEAP_VADDR + Memory::CITRA_PAGE_SIZE,
+                                       Memory::CITRA_PAGE_SIZE, Kernel::MemoryState::Private,
+                                       Kernel::VMAPermission::Read, Kernel::MemoryState::Locked,
+                                       Kernel::VMAPermission::None) == ResultSuccess);
+    CHECK(IsVMAMapConsistent(*manager));
+
+    for (u32 i = 1; i < NumPages; i += 2) {
+        REQUIRE(manager->UnmapRange(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE,
+                                    Memory::CITRA_PAGE_SIZE) == ResultSuccess);
+    }
+    CHECK(manager->vma_map.size() == 1);
+    CHECK(IsVMAMapConsistent(*manager));
+}
+
+TEST_CASE("VMManager map/unmap/query", "[.][benchmark]") {
+    constexpr u32 NumRegions = 512;
+    auto mem = std::make_shared<BufferMem>(NumRegions * Memory::CITRA_PAGE_SIZE);
+    MemoryRef block{mem};
+    Core::Timing timing(1, 100);
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    Kernel::KernelSystem kernel(
+        memory, timing, [] {}, Kernel::MemoryMode::Prod, 1,
+        Kernel::New3dsHwCapabilities{false, false, Kernel::New3dsMemoryMode::Legacy});
+    Kernel::Process process(kernel);
+    auto manager = std::make_unique<Kernel::VMManager>(memory, process);
+
+    const auto map_region = [&](u32 i) {
+        const auto state = i % 2 ? Kernel::MemoryState::Private : Kernel::MemoryState::Code;
+        return manager
+            ->MapBackingMemory(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE,
+                               block + i * Memory::CITRA_PAGE_SIZE, Memory::CITRA_PAGE_SIZE, state)
+            .Succeeded();
+    };
+
+    // Mirrors CRO loading: many small mappings that are torn down again.
+    BENCHMARK("map and unmap 512 single-page regions") {
+        for (u32 i = 0; i < NumRegions; ++i) {
+            map_region(i);
+        }
+        return manager->UnmapRange(Memory::HEAP_VADDR, NumRegions * Memory::CITRA_PAGE_SIZE);
+    };
+
+    for (u32 i = 0; i < NumRegions; ++i) {
+        map_region(i);
+    }
+    // Mirrors svcQueryMemory against a fragmented address space.
+    BENCHMARK("query 512 regions") {
+        u32 total = 0;
+        for (u32 i = 0; i < NumRegions; ++i) {
+            total += manager->FindVMA(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE)->second.size;
+        }
+        return total;
+    };
+    // Mirrors heap churn: permission changes that split and re-merge VMAs.
+    BENCHMARK("reprotect 512 regions") {
+        for (u32 i = 0; i < NumRegions; ++i) {
+            manager->ReprotectRange(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE,
+                                    Memory::CITRA_PAGE_SIZE, Kernel::VMAPermission::Read);
+            manager->ReprotectRange(Memory::HEAP_VADDR + i * Memory::CITRA_PAGE_SIZE,
+                                    Memory::CITRA_PAGE_SIZE, Kernel::VMAPermission::ReadWrite);
+        }
+    };
+}
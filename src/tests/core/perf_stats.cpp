@@ -0,0 +1,74 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "core/perf_stats.h"
+
+namespace Core {
+
+TEST_CASE("PerfStats per-frame percentiles", "[core]") {
+    using namespace std::chrono_literals;
+    PerfStats perf_stats{0};
+
+    // One slow frame that compiled shaders among quick ones, like a stutter.
+    for (int i = 0; i < 20; ++i) {
+        perf_stats.BeginSystemFrame();
+        perf_stats.BeginGPUProcessing();
+        std::this_thread::sleep_for(i == 10 ? 20ms : 1ms);
+        perf_stats.EndGPUProcessing();
+        if (i == 10) {
+            perf_stats.ReportShaderCompiles(3);
+        }
+        perf_stats.EndSystemFrame();
+    }
+
+    const auto results = perf_stats.GetAndResetStats(std::chrono::microseconds{0});
+    const auto& frame = results.frame_breakdown.frame;
+    REQUIRE(results.shader_compiles == 3);
+    REQUIRE(results.frame_breakdown.shader_compiles.max == 3.0);
+    REQUIRE(results.frame_breakdown.shader_compiles.p50 == 0.0);
+    REQUIRE(frame.p50 <= frame.p95);
+    REQUIRE(frame.p95 <= frame.p99);
+    REQUIRE(frame.p99 <= frame.max);
+    REQUIRE(frame.max >= 0.02);
+    REQUIRE(frame.p50 < 0.02);
+    REQUIRE(results.frame_breakdown.gpu.max >= 0.02);
+
+    // The samples are cleared with the other counters.
+    const auto reset = perf_stats.GetAndResetStats(std::chrono::microseconds{0});
+    REQUIRE(reset.shader_compiles == 0);
+    REQUIRE(reset.frame_breakdown.frame.max == 0.0);
+}
+
+TEST_CASE("PerfStats per-SVC cost", "[core]") {
+    using namespace std::chrono_literals;
+    PerfStats perf_stats{0};
+
+    for (int i = 0; i < 4; ++i) {
+        perf_stats.BeginSystemFrame();
+        for (int j = 0; j < 3; ++j) {
+            perf_stats.BeginSVCProcessing();
+            perf_stats.EndSVCProcessing(0x28, "GetSystemTick");
+        }
+        perf_stats.BeginSVCProcessing();
+        std::this_thread::sleep_for(2ms);
+        perf_stats.EndSVCProcessing(0x24, "WaitSynchronization1");
+        perf_stats.EndSystemFrame();
+    }
+
+    const auto results = perf_stats.GetAndResetStats(std::chrono::microseconds{0});
+    REQUIRE(results.svcs.size() == 2);
+    REQUIRE(results.svcs[0].name == "WaitSynchronization1");
+    REQUIRE(results.svcs[0].calls_per_frame == 1.0);
+    REQUIRE(results.svcs[0].time_per_frame >= 0.002);
+    REQUIRE(results.svcs[1].name == "GetSystemTick");
+    REQUIRE(results.svcs[1].calls_per_frame == 3.0);
+
+    const auto reset = perf_stats.GetAndResetStats(std::chrono::microseconds{0});
+    REQUIRE(reset.svcs.empty());
+}
+
+} // namespace Core
@@ -0,0 +1,97 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "core/rewind_buffer.h"
+
+namespace Core {
+
+namespace {
+
+struct Ram {
+    std::vector<u8> large = std::vector<u8>(RewindBuffer::ChunkSize * 8);
+    std::vector<u8> small = std::vector<u8>(RewindBuffer::ChunkSize / 2 + 3);
+
+    std::array<std::span<const u8>, 2> Regions() const {
+        return {large, small};
+    }
+    std::array<std::span<u8>, 2> Regions() {
+        return {large, small};
+    }
+};
+
+/// Changes a few chunks of the RAM, as a frame of emulation would.
+void Step(Ram& ram, u32 step) {
+    for (std::size_t i = 0; i < 0x100; i++) {
+        ram.large[(step % 8) * RewindBuffer::ChunkSize + i * 97] = static_cast<u8>(step + i);
+    }
+    ram.small[step % ram.small.size()] ^= 0x5A;
+}
+
+/// Returns the state of the newest snapshot after restoring its RAM, empty if there is none.
+std::string Pop(RewindBuffer& buffer, Ram& ram) {
+    if (buffer.IsEmpty()) {
+        return {};
+    }
+    std::string state = buffer.NewestState();
+    REQUIRE(buffer.Pop(ram.Regions()));
+    return state;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RewindBuffer steps back through snapshots", "[core]") {
+    RewindBuffer buffer{64 * 1024 * 1024};
+    Ram ram;
+    std::vector<Ram> history;
+    for (u32 step = 0; step < 12; step++) {
+        Step(ram, step);
+        buffer.Push(std::to_string(step), std::as_const(ram).Regions());
+        history.push_back(ram);
+    }
+    REQUIRE(buffer.Count() == history.size());
+    // Unchanged chunks are not stored, so the snapshots together are smaller than one RAM copy.
+    REQUIRE(buffer.StoredSize() < ram.large.size());
+
+    // Emulation after a snapshot is thrown away when stepping back.
+    Step(ram, 100);
+    for (u32 step = 12; step-- > 6;) {
+        REQUIRE(Pop(buffer, ram) == std::to_string(step));
+        REQUIRE(ram.large == history[step].large);
+        REQUIRE(ram.small == history[step].small);
+    }
+
+    // Snapshots taken after stepping back continue from the restored RAM.
+    Step(ram, 200);
+    buffer.Push("200", std::as_const(ram).Regions());
+    const Ram branched = ram;
+    Step(ram, 201);
+    REQUIRE(Pop(buffer, ram) == "200");
+    REQUIRE(ram.large == branched.large);
+    REQUIRE(Pop(buffer, ram) == "5");
+    REQUIRE(ram.large == history[5].large);
+    REQUIRE(ram.small == history[5].small);
+}
+
+TEST_CASE("RewindBuffer drops the oldest snapshots over budget", "[core]") {
+    RewindBuffer buffer{4096};
+    Ram ram;
+    for (u32 step = 0; step < 32; step++) {
+        Step(ram, step);
+        buffer.Push(std::to_string(step), std::as_const(ram).Regions());
+    }
+    REQUIRE(buffer.Count() < 32);
+    REQUIRE(buffer.StoredSize() <= 4096);
+    REQUIRE(Pop(buffer, ram) == "31");
+
+    buffer.Clear();
+    REQUIRE(buffer.IsEmpty());
+    REQUIRE(!buffer.Pop(ram.Regions()));
+}
+
+} // namespace Core
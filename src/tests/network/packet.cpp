@@ -0,0 +1,81 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <string>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "network/packet.h"
+
+namespace Network {
+
+TEST_CASE("Packet round trip", "[network]") {
+    const std::array<u8, 6> mac{0x40, 0xF4, 0x07, 0x12, 0x34, 0x56};
+    std::vector<u8> payload(0x5A0);
+    for (std::size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<u8>(i * 7);
+    }
+    const std::vector<u16> words{0x1234, 0xABCD};
+
+    Packet packet;
+    packet.Reserve(0x600);
+    packet << u8{3} << mac << payload << words << std::string{"nickname"} << u64{0x1122334455};
+
+    // Received data is read in place, and copied once it is modified
+    Packet received{packet.GetData(), packet.GetDataSize()};
+    REQUIRE(received.GetData() == packet.GetData());
+
+    u8 id;
+    std::array<u8, 6> read_mac;
+    std::vector<u8> read_payload;
+    std::vector<u16> read_words;
+    std::string nickname;
+    u64 value;
+    received >> id >> read_mac >> read_payload >> read_words >> nickname >> value;
+    REQUIRE(received);
+    REQUIRE(received.EndOfPacket());
+    REQUIRE(id == 3);
+    REQUIRE(read_mac == mac);
+    REQUIRE(read_payload == payload);
+    REQUIRE(read_words == words);
+    REQUIRE(nickname == "nickname");
+    REQUIRE(value == 0x1122334455);
+
+    received << u8{1};
+    REQUIRE(received.GetData() != packet.GetData());
+    REQUIRE(received.GetDataSize() == packet.GetDataSize() + 1);
+
+    // A size past the end of the data is rejected instead of read
+    Packet truncated{packet.GetData(), 1 + mac.size() + sizeof(u32) + 0x10};
+    truncated >> id >> read_mac >> read_payload;
+    REQUIRE_FALSE(truncated);
+    REQUIRE(read_payload.empty());
+}
+
+TEST_CASE("Packet room broadcast", "[.][benchmark][network]") {
+    const std::array<u8, 6> transmitter{0x40, 0xF4, 0x07, 0x12, 0x34, 0x56};
+    const std::array<u8, 6> broadcast{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    const std::vector<u8> payload(0x400, 0x5A);
+    constexpr std::size_t NumMembers = 8;
+
+    // A member sends a WifiPacket that every other member of the room parses.
+    BENCHMARK("Serialize and parse a broadcast WifiPacket") {
+        Packet packet;
+        packet << u8{0} << u8{1} << u8{1} << transmitter << broadcast << payload;
+        std::size_t received_size = 0;
+        for (std::size_t member = 1; member < NumMembers; member++) {
+            Packet received{packet.GetData(), packet.GetDataSize()};
+            received.IgnoreBytes(3 * sizeof(u8));
+            std::array<u8, 6> transmitter_address;
+            std::array<u8, 6> destination_address;
+            std::vector<u8> data;
+            received >> transmitter_address >> destination_address >> data;
+            received_size += data.size();
+        }
+        return received_size;
+    };
+}
+
+} // namespace Network
@@ -0,0 +1,144 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/scope_exit.h"
+#include "network/network.h"
+#include "network/network_settings.h"
+#include "network/verify_user.h"
+
+namespace Network {
+
+namespace {
+
+constexpr u16 TestRoomPort = DefaultRoomPort + 1;
+
+template <typename Predicate>
+bool WaitFor(Predicate&& predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+/// Counts the WifiPackets a member receives and the members it knows about.
+class Observer {
+public:
+    explicit Observer(RoomMember& member) {
+        member.BindOnWifiPacketReceived([this](const WifiPacket&) {
+            std::scoped_lock lock{mutex};
+            received++;
+        });
+        // Called on the thread of the member, which owns the member list.
+        member.BindOnRoomInformationChanged([this, &member](const RoomInformation&) {
+            std::scoped_lock lock{mutex};
+            members = member.GetMemberInformation().size();
+        });
+    }
+
+    std::size_t Received() {
+        std::scoped_lock lock{mutex};
+        return received;
+    }
+
+    std::size_t Members() {
+        std::scoped_lock lock{mutex};
+        return members;
+    }
+
+private:
+    std::mutex mutex;
+    std::size_t received = 0;
+    std::size_t members = 0;
+};
+
+bool Join(RoomMember& member, const std::string& nickname, bool direct_connections) {
+    NetSettings::values.direct_connections = direct_connections;
+    member.Join(nickname, nickname, "127.0.0.1", TestRoomPort);
+    return WaitFor([&member] { return member.GetState() == RoomMember::State::Joined; });
+}
+
+WifiPacket MakePacket(const MacAddress& transmitter, const MacAddress& destination) {
+    WifiPacket packet{};
+    packet.type = WifiPacket::PacketType::Data;
+    packet.data = {0x01, 0x02, 0x03};
+    packet.transmitter_address = transmitter;
+    packet.destination_address = destination;
+    packet.channel = 1;
+    return packet;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RoomMember sends WifiPackets directly between members", "[network]") {
+    REQUIRE(Init());
+    const bool direct_connections = NetSettings::values.direct_connections;
+    SCOPE_EXIT({
+        NetSettings::values.direct_connections = direct_connections;
+        Shutdown();
+    });
+
+    Room room;
+    REQUIRE(room.Create("test", "", "127.0.0.1", TestRoomPort, "", MaxConcurrentConnections, "",
+                        "", 0, std::make_unique<VerifyUser::NullBackend>()));
+    SCOPE_EXIT({ room.Destroy(); });
+
+    RoomMember first;
+    RoomMember second;
+    Observer first_observer{first};
+    Observer second_observer{second};
+    REQUIRE(Join(first, "first", true));
+    SCOPE_EXIT({ first.Leave(); });
+    REQUIRE(Join(second, "second", true));
+    SCOPE_EXIT({ second.Leave(); });
+
+    // Packets go through the room until the connection between the members is established.
+    const auto send_to_second = [&] {
+        const u64 relayed = room.GetTrafficStats().wifi_packets_relayed;
+        const std::size_t received = second_observer.Received();
+        first.SendWifiPacket(MakePacket(first.GetMacAddress(), second.GetMacAddress()));
+        REQUIRE(WaitFor([&] { return second_observer.Received() > received; }));
+        return room.GetTrafficStats().wifi_packets_relayed == relayed;
+    };
+    REQUIRE(WaitFor(send_to_second));
+
+    SECTION("broadcasts go directly when every member is connected") {
+        const u64 relayed = room.GetTrafficStats().wifi_packets_relayed;
+        const std::size_t received = second_observer.Received();
+        first.SendWifiPacket(MakePacket(first.GetMacAddress(), BroadcastMac));
+        REQUIRE(WaitFor([&] { return second_observer.Received() > received; }));
+        CHECK(room.GetTrafficStats().wifi_packets_relayed == relayed);
+    }
+
+    SECTION("the room relays packets for members without a direct connection") {
+        RoomMember third;
+        Observer third_observer{third};
+        REQUIRE(Join(third, "third", false));
+        SCOPE_EXIT({ third.Leave(); });
+
+        const u64 relayed = room.GetTrafficStats().wifi_packets_relayed;
+        first.SendWifiPacket(MakePacket(first.GetMacAddress(), third.GetMacAddress()));
+        REQUIRE(WaitFor([&] { return third_observer.Received() > 0; }));
+        CHECK(room.GetTrafficStats().wifi_packets_relayed == relayed + 1);
+
+        // A broadcast has to reach the third member as well, so the room sends it to everyone.
+        REQUIRE(WaitFor([&] { return first_observer.Members() == 3; }));
+        const std::size_t received = second_observer.Received();
+        first.SendWifiPacket(MakePacket(first.GetMacAddress(), BroadcastMac));
+        REQUIRE(WaitFor([&] { return third_observer.Received() > 1; }));
+        REQUIRE(WaitFor([&] { return second_observer.Received() > received; }));
+        CHECK(room.GetTrafficStats().wifi_packets_relayed == relayed + 2);
+    }
+}
+
+} // namespace Network
@@ -0,0 +1,99 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "video_core/custom_textures/transcoder.h"
+
+namespace VideoCore {
+
+namespace {
+
+using Texel = std::array<u8, 4>;
+
+Texel TexelAt(const std::vector<u8>& rgba, u32 width, u32 x, u32 y) {
+    const std::size_t offset = (std::size_t{y} * width + x) * 4;
+    return {rgba[offset], rgba[offset + 1], rgba[offset + 2], rgba[offset + 3]};
+}
+
+// Red and blue endpoints, with the indices of the texels set to 0, 1, 2, 3 along each row.
+constexpr std::array<u8, 8> BC1_FOUR_COLOR = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4};
+// The same endpoints swapped, which selects the mode with a transparent fourth color.
+constexpr std::array<u8, 8> BC1_THREE_COLOR = {0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4};
+
+} // Anonymous namespace
+
+TEST_CASE("TranscodeToRGBA8 decodes BC1", "[video_core]") {
+    std::vector<u8> rgba;
+    REQUIRE(TranscodeToRGBA8(CustomPixelFormat::BC1, 4, 4, BC1_FOUR_COLOR, rgba));
+    REQUIRE(rgba.size() == 4 * 4 * 4);
+    for (u32 y = 0; y < 4; y++) {
+        REQUIRE(TexelAt(rgba, 4, 0, y) == Texel{255, 0, 0, 255});
+        REQUIRE(TexelAt(rgba, 4, 1, y) == Texel{0, 0, 255, 255});
+        REQUIRE(TexelAt(rgba, 4, 2, y) == Texel{170, 0, 85, 255});
+        REQUIRE(TexelAt(rgba, 4, 3, y) == Texel{85, 0, 170, 255});
+    }
+
+    REQUIRE(TranscodeToRGBA8(CustomPixelFormat::BC1, 4, 4, BC1_THREE_COLOR, rgba));
+    REQUIRE(TexelAt(rgba, 4, 0, 0) == Texel{0, 0, 255, 255});
+    REQUIRE(TexelAt(rgba, 4, 1, 0) == Texel{255, 0, 0, 255});
+    REQUIRE(TexelAt(rgba, 4, 2, 0) == Texel{127, 0, 127, 255});
+    REQUIRE(TexelAt(rgba, 4, 3, 0) == Texel{0, 0, 0, 0});
+}
+
+TEST_CASE("TranscodeToRGBA8 decodes BC3 and BC5 channels", "[video_core]") {
+    // Alpha endpoints 255 and 0 with texel indices 0, 1, 2, 3, ... and the opaque BC1 block.
+    std::array<u8, 16> bc3{};
+    bc3[0] = 255;
+    bc3[1] = 0;
+    u64 indices = 0;
+    for (u32 texel = 0; texel < 16; texel++) {
+        indices |= u64{texel % 8} << (3 * texel);
+    }
+    for (u32 i = 0; i < 6; i++) {
+        bc3[2 + i] = static_cast<u8>(indices >> (8 * i));
+    }
+    std::copy(BC1_THREE_COLOR.begin(), BC1_THREE_COLOR.end(), bc3.begin() + 8);
+
+    std::vector<u8> rgba;
+    REQUIRE(TranscodeToRGBA8(CustomPixelFormat::BC3, 4, 4, bc3, rgba));
+    constexpr std::array<u8, 8> alphas = {255, 0, 218, 182, 145, 109, 72, 36};
+    for (u32 texel = 0; texel < 16; texel++) {
+        REQUIRE(rgba[texel * 4 + 3] == alphas[texel % 8]);
+    }
+    // The color block of BC3 is always decoded with four opaque colors.
+    REQUIRE(TexelAt(rgba, 4, 3, 0) == Texel{170, 0, 85, alphas[3]});
+
+    std::array<u8, 16> bc5{};
+    std::copy(bc3.begin(), bc3.begin() + 8, bc5.begin());
+    bc5[8] = 10;
+    bc5[9] = 20;
+    REQUIRE(TranscodeToRGBA8(CustomPixelFormat::BC5, 4, 4, bc5, rgba));
+    REQUIRE(TexelAt(rgba, 4, 0, 0) == Texel{255, 10, 0, 255});
+    REQUIRE(TexelAt(rgba, 4, 2, 0) == Texel{218, 10, 0, 255});
+}
+
+TEST_CASE("TranscodeToRGBA8 clips edge blocks", "[video_core]") {
+    // A 6x5 texture takes 2x2 blocks, the second block of each row is opaque blue.
+    std::vector<u8> bc1;
+    for (u32 block = 0; block < 4; block++) {
+        const std::array<u8, 8> data =
+            block % 2 == 0 ? BC1_FOUR_COLOR : std::array<u8, 8>{0x1F, 0x00, 0x1F, 0x00};
+        bc1.insert(bc1.end(), data.begin(), data.end());
+    }
+
+    std::vector<u8> rgba;
+    REQUIRE(TranscodeToRGBA8(CustomPixelFormat::BC1, 6, 5, bc1, rgba));
+    REQUIRE(rgba.size() == 6 * 5 * 4);
+    REQUIRE(TexelAt(rgba, 6, 3, 4) == Texel{85, 0, 170, 255});
+    REQUIRE(TexelAt(rgba, 6, 4, 0) == Texel{0, 0, 255, 255});
+    REQUIRE(TexelAt(rgba, 6, 5, 4) == Texel{0, 0, 255, 255});
+
+    REQUIRE_FALSE(TranscodeToRGBA8(CustomPixelFormat::BC1, 12, 12, bc1, rgba));
+    REQUIRE_FALSE(TranscodeToRGBA8(CustomPixelFormat::BC7, 4, 4, bc1, rgba));
+    REQUIRE_FALSE(CanTranscodeToRGBA8(CustomPixelFormat::ASTC4));
+}
+
+} // namespace VideoCore
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <memory>
 #include <span>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -800,4 +801,44 @@ SHADER_TEST_CASE("Source Swizzle", "[video_core][shader]") {
             Common::Vec4f(iota_vec.y, iota_vec.y, iota_vec.y, iota_vec.y));
 }
 
+SHADER_TEST_CASE("Vertex transform throughput", "[.][benchmark]") {
+    const auto sh_position = SourceRegister::MakeInput(0);
+    const auto sh_color = SourceRegister::MakeInput(1);
+    const auto sh_texcoord = SourceRegister::MakeInput(2);
+    const auto sh_temp = SourceRegister::MakeTemporary(0);
+    const auto sh_out_position = DestRegister::MakeOutput(0);
+    const auto sh_out_color = DestRegister::MakeOutput(1);
+    const auto sh_out_texcoord = DestRegister::MakeOutput(2);
+    const auto c = [](u32 index) { return SourceRegister::MakeFloat(index); };
+
+    // The typical vertex shader of a game, a matrix transform and a few attribute operations.
+    auto shader = TestType({
+        {OpCode::Id::DP4, sh_out_position, "x", sh_position, "xyzw", c(0), "xyzw"},
+        {OpCode::Id::DP4, sh_out_position, "y", sh_position, "xyzw", c(1), "xyzw"},
+        {OpCode::Id::DP4, sh_out_position, "z", sh_position, "xyzw", c(2), "xyzw"},
+        {OpCode::Id::DP4, sh_out_position, "w", sh_position, "xyzw", c(3), "xyzw"},
+        {OpCode::Id::MUL, sh_temp, sh_color, c(4)},
+        {OpCode::Id::ADD, sh_out_color, sh_temp, c(5)},
+        {OpCode::Id::MOV, sh_out_texcoord, sh_texcoord},
+        {OpCode::Id::END},
+    });
+    for (u32 i = 0; i < 6; i++) {
+        const auto value = Pica::f24::FromFloat32(0.25f * static_cast<float>(i + 1));
+        shader.shader_setup->uniforms.f[i] = {value, value, value, value};
+    }
+
+    const std::array<Common::Vec4f, 3> inputs{
+        Common::Vec4f{1.0f, 2.0f, 3.0f, 1.0f},
+        Common::Vec4f{0.5f, 0.5f, 0.5f, 1.0f},
+        Common::Vec4f{0.25f, 0.75f, 0.0f, 0.0f},
+    };
+    Pica::ShaderUnit shader_unit;
+    BENCHMARK("1024 vertices") {
+        for (u32 i = 0; i < 1024; i++) {
+            shader.RunShader(shader_unit, inputs);
+        }
+        return shader_unit.output[0].x.ToFloat32();
+    };
+}
+
 #endif // CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
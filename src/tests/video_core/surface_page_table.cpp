@@ -0,0 +1,165 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "video_core/rasterizer_cache/surface_page_table.h"
+
+using VideoCore::SurfaceId;
+using VideoCore::SurfacePageTable;
+
+namespace {
+
+struct Region {
+    PAddr addr;
+    u32 size;
+};
+
+// Approximates the surfaces cached while rendering a 3D scene: both screens with their depth
+// buffers in VRAM, and a few hundred textures of 32x32 to 256x256 texels in FCRAM.
+std::vector<Region> MakeFrameSurfaces(std::mt19937& rng) {
+    constexpr PAddr VRAM = 0x18000000;
+    constexpr PAddr FCRAM = 0x20000000;
+    std::vector<Region> regions = {
+        {VRAM, 400 * 240 * 4},
+        {VRAM + 0x100000, 400 * 240 * 4},
+        {VRAM + 0x200000, 320 * 240 * 4},
+        {VRAM + 0x300000, 400 * 240 * 4},
+    };
+    std::uniform_int_distribution<u32> size_log2{5, 8};
+    std::uniform_int_distribution<u32> bytes_per_texel{1, 4};
+    std::uniform_int_distribution<u32> offset{0, 0x4000000 / 0x1000 - 1};
+    for (u32 i = 0; i < 400; i++) {
+        const u32 width = 1U << size_log2(rng);
+        const u32 height = 1U << size_log2(rng);
+        regions.push_back({FCRAM + offset(rng) * 0x1000, width * height * bytes_per_texel(rng)});
+    }
+    return regions;
+}
+
+std::vector<SurfaceId> Collect(const SurfacePageTable& table, PAddr addr, u32 size) {
+    std::vector<SurfaceId> surfaces;
+    table.ForEachPage(addr, size, [&](const std::vector<SurfaceId>& page) {
+        surfaces.insert(surfaces.end(), page.begin(), page.end());
+        return false;
+    });
+    return surfaces;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SurfacePageTable finds overlapping surfaces", "[video_core]") {
+    SurfacePageTable table;
+    const u32 page_size = 1U << SurfacePageTable::PAGE_BITS;
+    table.Add(0x18000000, page_size * 2, SurfaceId{0});
+    table.Add(0x18000000 + page_size, 16, SurfaceId{1});
+    table.Add(0x28000000, page_size * 300, SurfaceId{2});
+
+    REQUIRE(Collect(table, 0x18000000, 1) == std::vector{SurfaceId{0}});
+    REQUIRE(Collect(table, 0x18000000 + page_size, 1) == std::vector{SurfaceId{0}, SurfaceId{1}});
+    REQUIRE(Collect(table, 0x20000000, 0x4000000).empty());
+    REQUIRE(Collect(table, 0, 0xFFFFFFFF).size() == 2 + 1 + 300);
+
+    std::size_t calls = 0;
+    table.ForEachPage(0, 0xFFFFFFFF, [&](const std::vector<SurfaceId>&) { return ++calls == 3; });
+    REQUIRE(calls == 3);
+
+    REQUIRE(table.Remove(0x18000000, page_size * 2, SurfaceId{0}));
+    REQUIRE_FALSE(table.Remove(0x18000000, page_size * 2, SurfaceId{0}));
+    REQUIRE(Collect(table, 0x18000000, page_size * 2) == std::vector{SurfaceId{1}});
+    REQUIRE(table.Remove(0x18000000 + page_size, 16, SurfaceId{1}));
+    REQUIRE(Collect(table, 0x18000000, page_size * 2).empty());
+
+    table.Clear();
+    REQUIRE(Collect(table, 0, 0xFFFFFFFF).empty());
+}
+
+TEST_CASE("SurfacePageTable matches a page hash map", "[video_core]") {
+    constexpr u32 PageBits = SurfacePageTable::PAGE_BITS;
+    std::mt19937 rng{0};
+    const auto regions = MakeFrameSurfaces(rng);
+
+    SurfacePageTable table;
+    std::unordered_map<u32, std::vector<SurfaceId>> reference;
+    for (u32 i = 0; i < regions.size(); i++) {
+        table.Add(regions[i].addr, regions[i].size, SurfaceId{i});
+        for (u32 page = regions[i].addr >> PageBits;
+             page <= (regions[i].addr + regions[i].size - 1) >> PageBits; page++) {
+            reference[page].push_back(SurfaceId{i});
+        }
+    }
+
+    std::uniform_int_distribution<u32> addr{0x17F00000, 0x24000000};
+    std::uniform_int_distribution<u32> size{1, 0x200000};
+    for (u32 i = 0; i < 1000; i++) {
+        const PAddr query_addr = addr(rng);
+        const u32 query_size = size(rng);
+        std::vector<SurfaceId> expected;
+        for (u32 page = query_addr >> PageBits; page <= (query_addr + query_size - 1) >> PageBits;
+             page++) {
+            if (const auto it = reference.find(page); it != reference.end()) {
+                expected.insert(expected.end(), it->second.begin(), it->second.end());
+            }
+        }
+        REQUIRE(Collect(table, query_addr, query_size) == expected);
+    }
+}
+
+TEST_CASE("SurfacePageTable lookups", "[.][benchmark]") {
+    constexpr u32 PageBits = SurfacePageTable::PAGE_BITS;
+    std::mt19937 rng{0};
+    const auto regions = MakeFrameSurfaces(rng);
+
+    SurfacePageTable table;
+    std::unordered_map<u64, std::vector<SurfaceId>> hash_map;
+    for (u32 i = 0; i < regions.size(); i++) {
+        table.Add(regions[i].addr, regions[i].size, SurfaceId{i});
+        for (u64 page = regions[i].addr >> PageBits;
+             page <= (regions[i].addr + regions[i].size - 1) >> PageBits; page++) {
+            hash_map[page].push_back(SurfaceId{i});
+        }
+    }
+
+    const auto hash_map_count = [&](PAddr addr, u64 size) {
+        std::size_t count = 0;
+        for (u64 page = addr >> PageBits; page <= (addr + size - 1) >> PageBits; page++) {
+            if (const auto it = hash_map.find(page); it != hash_map.end()) {
+                count += it->second.size();
+            }
+        }
+        return count;
+    };
+    const auto table_count = [&](PAddr addr, u64 size) {
+        std::size_t count = 0;
+        table.ForEachPage(addr, size, [&](const std::vector<SurfaceId>& page) {
+            count += page.size();
+            return false;
+        });
+        return count;
+    };
+
+    BENCHMARK("Hash map, surface lookups") {
+        std::size_t count = 0;
+        for (const Region& region : regions) {
+            count += hash_map_count(region.addr, region.size);
+        }
+        return count;
+    };
+    BENCHMARK("Page table, surface lookups") {
+        std::size_t count = 0;
+        for (const Region& region : regions) {
+            count += table_count(region.addr, region.size);
+        }
+        return count;
+    };
+    BENCHMARK("Hash map, whole address space") {
+        return hash_map_count(0, 0xFFFFFFFF);
+    };
+    BENCHMARK("Page table, whole address space") {
+        return table_count(0, 0xFFFFFFFF);
+    };
+}
@@ -0,0 +1,122 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "video_core/renderer_software/sw_lighting.h"
+
+using Pica::LightingRegs;
+using SwRenderer::LightingTables;
+
+namespace {
+
+constexpr u32 F16One = 0x3C00;
+
+void FillLut(Pica::PicaCore::Lighting& state, LightingRegs::LightingSampler sampler, u32 value) {
+    for (auto& entry : state.luts[static_cast<std::size_t>(sampler)]) {
+        entry.raw = value;
+    }
+}
+
+/// A single white directional light facing the surface, lit through the D0 LUT indexed by NV.
+LightingRegs MakeRegs() {
+    LightingRegs regs{};
+    regs.config0.config.Assign(LightingRegs::LightingConfig::Config0);
+    regs.config1.disable_lut_d1.Assign(1);
+    regs.config1.disable_lut_fr.Assign(1);
+    regs.config1.disable_lut_rr.Assign(1);
+    regs.config1.disable_lut_rg.Assign(1);
+    regs.config1.disable_lut_rb.Assign(1);
+    regs.config1.disable_spot_atten.Assign(0xFF);
+    regs.config1.disable_dist_atten.Assign(0xFF);
+    regs.lut_input.d0.Assign(LightingRegs::LightingLutInput::NV);
+
+    auto& light = regs.light[0];
+    light.config.directional.Assign(1);
+    light.z.Assign(F16One);
+    light.specular_0.r.Assign(255);
+    light.specular_0.g.Assign(255);
+    light.specular_0.b.Assign(255);
+    return regs;
+}
+
+const Common::Quaternion<f32> Identity{{0.f, 0.f, 0.f}, 1.f};
+const std::array<Common::Vec4<u8>, 4> NoTextures{};
+
+} // Anonymous namespace
+
+TEST_CASE("sw_lighting.LutsAreDecodedWhenDirty", "[video_core][sw_lighting]") {
+    const LightingRegs regs = MakeRegs();
+    const Common::Vec3f view{0.f, 0.f, 1.f};
+    Pica::PicaCore::Lighting state{};
+    FillLut(state, LightingRegs::LightingSampler::Distribution0, 2048);
+
+    LightingTables tables;
+    tables.Update(regs, state);
+    REQUIRE(state.lut_dirty == 0);
+    REQUIRE(tables.ComputeFragmentsColors(regs, Identity, view, NoTextures).second.r() == 127);
+
+    // Writes that did not mark the LUT dirty are not picked up.
+    FillLut(state, LightingRegs::LightingSampler::Distribution0, 4095);
+    tables.Update(regs, state);
+    REQUIRE(tables.ComputeFragmentsColors(regs, Identity, view, NoTextures).second.r() == 127);
+
+    state.lut_dirty = 1U << static_cast<u32>(LightingRegs::LightingSampler::Distribution0);
+    tables.Update(regs, state);
+    REQUIRE(tables.ComputeFragmentsColors(regs, Identity, view, NoTextures).second.r() == 255);
+}
+
+TEST_CASE("sw_lighting.ComputeFragmentsColors throughput", "[.][benchmark]") {
+    constexpr u32 NumFragments = 4096;
+
+    // All eight lights positional with every LUT, spot and distance attenuation enabled.
+    LightingRegs regs{};
+    regs.config0.config.Assign(LightingRegs::LightingConfig::Config7);
+    regs.config0.enable_primary_alpha.Assign(1);
+    regs.config0.enable_secondary_alpha.Assign(1);
+    regs.max_light_index.Assign(7);
+    for (u32 num = 0; num < 8; num++) {
+        auto& light = regs.light[num];
+        light.x.Assign(F16One);
+        light.z.Assign(F16One);
+        light.spot_z.Assign(-2047);
+        light.dist_atten_scale.Assign(0x3F000);
+        light.diffuse.r.Assign(32 * num);
+        light.specular_0.g.Assign(32 * num);
+        light.specular_1.b.Assign(32 * num);
+    }
+    regs.light_enable.slot_1.Assign(1);
+    regs.light_enable.slot_2.Assign(2);
+    regs.light_enable.slot_3.Assign(3);
+    regs.light_enable.slot_4.Assign(4);
+    regs.light_enable.slot_5.Assign(5);
+    regs.light_enable.slot_6.Assign(6);
+    regs.light_enable.slot_7.Assign(7);
+
+    Pica::PicaCore::Lighting state{};
+    for (std::size_t lut = 0; lut < state.luts.size(); lut++) {
+        for (std::size_t i = 0; i < state.luts[lut].size(); i++) {
+            state.luts[lut][i].raw = static_cast<u32>((i * 16 + lut) & 0xFFF);
+        }
+    }
+    LightingTables tables;
+    tables.Update(regs, state);
+
+    std::array<Common::Vec3f, NumFragments> views;
+    for (u32 i = 0; i < NumFragments; i++) {
+        views[i] = {static_cast<f32>(i % 64) / 32.f - 1.f, static_cast<f32>(i / 64) / 32.f - 1.f,
+                    1.f};
+    }
+
+    BENCHMARK("ComputeFragmentsColors") {
+        u32 sum = 0;
+        for (const Common::Vec3f& view : views) {
+            const auto [primary, secondary] =
+                tables.ComputeFragmentsColors(regs, Identity, view, NoTextures);
+            sum += primary.r() + secondary.b();
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,110 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <random>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "video_core/rasterizer_cache/texture_codec.h"
+
+using VideoCore::PixelFormat;
+
+namespace {
+
+// Tiles are copied into a wider linear rectangle to catch stride mistakes.
+constexpr u32 LinearStride = 24;
+
+std::vector<u8> RandomBytes(std::size_t size, std::mt19937& rng) {
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+
+template <PixelFormat format, bool converted>
+void CheckTileCopy() {
+    constexpr u32 tile_size = GetFormatBpp(format) * 64 / 8;
+    constexpr u32 linear_size =
+        LinearStride * 8 * (converted ? 4 : VideoCore::GetFormatBytesPerPixel(format));
+
+    std::mt19937 rng{static_cast<u32>(format)};
+    for (u32 i = 0; i < 16; i++) {
+        auto tile = RandomBytes(tile_size, rng);
+        auto linear = RandomBytes(linear_size, rng);
+        auto expected_linear = linear;
+        VideoCore::MortonCopyTileScalar<true, format, converted>(LinearStride, tile,
+                                                                 expected_linear);
+        VideoCore::MortonCopyTileVector<true, format, converted>(LinearStride, tile.data(),
+                                                                 linear.data());
+        REQUIRE(linear == expected_linear);
+
+        auto expected_tile = tile;
+        VideoCore::MortonCopyTileScalar<false, format, converted>(LinearStride, expected_tile,
+                                                                  linear);
+        VideoCore::MortonCopyTileVector<false, format, converted>(LinearStride, tile.data(),
+                                                                  linear.data());
+        REQUIRE(tile == expected_tile);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MortonCopyTileVector matches the scalar reference", "[video_core]") {
+    CheckTileCopy<PixelFormat::RGBA8, false>();
+    CheckTileCopy<PixelFormat::RGBA8, true>();
+    CheckTileCopy<PixelFormat::RGB8, false>();
+    CheckTileCopy<PixelFormat::RGB8, true>();
+    CheckTileCopy<PixelFormat::RGB5A1, false>();
+    CheckTileCopy<PixelFormat::RGB5A1, true>();
+    CheckTileCopy<PixelFormat::RGB565, false>();
+    CheckTileCopy<PixelFormat::RGB565, true>();
+    CheckTileCopy<PixelFormat::RGBA4, false>();
+    CheckTileCopy<PixelFormat::RGBA4, true>();
+    CheckTileCopy<PixelFormat::IA8, false>();
+    CheckTileCopy<PixelFormat::D24S8, false>();
+}
+
+TEST_CASE("MortonCopyTile throughput", "[.][benchmark]") {
+    constexpr u32 NumTiles = 1024;
+    constexpr u32 TileSize = 64 * 2;
+    constexpr u32 LinearTileSize = 64 * 4;
+
+    std::mt19937 rng{0};
+    auto tiles = RandomBytes(NumTiles * TileSize, rng);
+    std::vector<u8> linear(NumTiles * LinearTileSize);
+    const auto tile = [&](u32 i) { return std::span{tiles}.subspan(i * TileSize, TileSize); };
+    const auto linear_tile = [&](u32 i) {
+        return std::span{linear}.subspan(i * LinearTileSize, LinearTileSize);
+    };
+
+    BENCHMARK("Scalar RGB565 decode") {
+        for (u32 i = 0; i < NumTiles; i++) {
+            VideoCore::MortonCopyTileScalar<true, PixelFormat::RGB565, true>(8, tile(i),
+                                                                            linear_tile(i));
+        }
+        return linear[0];
+    };
+    BENCHMARK("Vector RGB565 decode") {
+        for (u32 i = 0; i < NumTiles; i++) {
+            VideoCore::MortonCopyTileVector<true, PixelFormat::RGB565, true>(
+                8, tile(i).data(), linear_tile(i).data());
+        }
+        return linear[0];
+    };
+    BENCHMARK("Scalar RGB565 encode") {
+        for (u32 i = 0; i < NumTiles; i++) {
+            VideoCore::MortonCopyTileScalar<false, PixelFormat::RGB565, true>(8, tile(i),
+                                                                             linear_tile(i));
+        }
+        return tiles[0];
+    };
+    BENCHMARK("Vector RGB565 encode") {
+        for (u32 i = 0; i < NumTiles; i++) {
+            VideoCore::MortonCopyTileVector<false, PixelFormat::RGB565, true>(
+                8, tile(i).data(), linear_tile(i).data());
+        }
+        return tiles[0];
+    };
+}
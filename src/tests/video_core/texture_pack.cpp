@@ -0,0 +1,96 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/file_util.h"
+#include "video_core/custom_textures/texture_pack.h"
+
+namespace VideoCore {
+
+namespace {
+
+std::string WritePack(const std::string& name, const std::vector<u8>& payloads,
+                      const std::vector<TexturePackEntry>& entries, u64 index_offset) {
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    const TexturePackHeader header = {
+        .magic = TexturePackMagic,
+        .version = TexturePackVersion,
+        .entry_count = static_cast<u32>(entries.size()),
+        .reserved = 0,
+        .index_offset = index_offset,
+    };
+    FileUtil::IOFile file(path, "wb");
+    file.WriteObject(header);
+    file.WriteBytes(payloads.data(), payloads.size());
+    file.WriteArray(entries.data(), entries.size());
+    return path;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("TexturePack finds the entries of a hash", "[video_core]") {
+    constexpr std::string_view contents{"color\0\0\0norm\0\0\0\0", 16};
+    const std::vector<u8> payloads(contents.begin(), contents.end());
+    const u64 base = sizeof(TexturePackHeader);
+    const std::vector<TexturePackEntry> entries = {
+        {.hash = 0x10, .offset = base, .size = 5, .file_format = 1, .map_type = 0},
+        {.hash = 0x20, .offset = base, .size = 5, .file_format = 1, .map_type = 0},
+        {.hash = 0x20, .offset = base + 8, .size = 4, .file_format = 1, .map_type = 1},
+    };
+    const std::string path =
+        WritePack("azahar_texture_pack_test.pack", payloads, entries, base + payloads.size());
+
+    {
+        const TexturePack pack{path};
+        REQUIRE(pack.IsValid());
+        REQUIRE(pack.Entries().size() == 3);
+        REQUIRE(pack.Find(0x15).empty());
+        REQUIRE(pack.Find(0x30).empty());
+
+        const auto color = pack.Find(0x10);
+        REQUIRE(color.size() == 1);
+        const auto color_data = pack.Payload(color[0]);
+        REQUIRE(std::memcmp(color_data.data(), "color", color_data.size()) == 0);
+
+        const auto material = pack.Find(0x20);
+        REQUIRE(material.size() == 2);
+        REQUIRE(material[0].map_type == 0);
+        REQUIRE(material[1].map_type == 1);
+        const auto normal_data = pack.Payload(material[1]);
+        REQUIRE(normal_data.size() == 4);
+        REQUIRE(std::memcmp(normal_data.data(), "norm", normal_data.size()) == 0);
+    }
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("TexturePack rejects corrupted indices", "[video_core]") {
+    const std::vector<u8> payloads(8);
+    const u64 base = sizeof(TexturePackHeader);
+    const u64 index_offset = base + payloads.size();
+
+    const std::string unsorted = WritePack(
+        "azahar_texture_pack_unsorted.pack", payloads,
+        {{.hash = 2, .offset = base, .size = 8}, {.hash = 1, .offset = base, .size = 8}},
+        index_offset);
+    REQUIRE_FALSE(TexturePack{unsorted}.IsValid());
+    FileUtil::Delete(unsorted);
+
+    const std::string payload_out_of_bounds =
+        WritePack("azahar_texture_pack_payload.pack", payloads,
+                  {{.hash = 1, .offset = base, .size = 0x1000}}, index_offset);
+    REQUIRE_FALSE(TexturePack{payload_out_of_bounds}.IsValid());
+    FileUtil::Delete(payload_out_of_bounds);
+
+    const std::string index_out_of_bounds =
+        WritePack("azahar_texture_pack_index.pack", payloads,
+                  {{.hash = 1, .offset = base, .size = 8}}, index_offset + 8);
+    REQUIRE_FALSE(TexturePack{index_out_of_bounds}.IsValid());
+    FileUtil::Delete(index_out_of_bounds);
+}
+
+} // namespace VideoCore
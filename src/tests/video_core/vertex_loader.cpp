@@ -0,0 +1,129 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "core/core.h"
+#include "core/memory.h"
+#include "video_core/pica/vertex_loader.h"
+
+using Pica::AttributeBuffer;
+using Pica::PipelineRegs;
+using Pica::VertexLoader;
+using Format = PipelineRegs::VertexAttributeFormat;
+
+namespace {
+
+constexpr u32 VertexStride = 16;
+
+/**
+ * Configures a single loader with four attributes: three signed bytes, four unsigned bytes, two
+ * shorts and one float, packed into 16 bytes per vertex at the start of FCRAM.
+ */
+PipelineRegs MakeRegs() {
+    PipelineRegs regs{};
+    auto& attributes = regs.vertex_attributes;
+    attributes.base_address.Assign(Memory::FCRAM_PADDR / 16);
+    attributes.format0.Assign(Format::BYTE);
+    attributes.size0.Assign(2);
+    attributes.format1.Assign(Format::UBYTE);
+    attributes.size1.Assign(3);
+    attributes.format2.Assign(Format::SHORT);
+    attributes.size2.Assign(1);
+    attributes.format3.Assign(Format::FLOAT);
+    attributes.size3.Assign(0);
+    attributes.max_attribute_index.Assign(3);
+
+    auto& loader = attributes.attribute_loaders[0];
+    loader.comp0.Assign(0);
+    loader.comp1.Assign(1);
+    loader.comp2.Assign(2);
+    loader.comp3.Assign(3);
+    loader.byte_count.Assign(VertexStride);
+    loader.component_count.Assign(4);
+    return regs;
+}
+
+void WriteVertex(Memory::MemorySystem& memory, u32 vertex, s8 value) {
+    u8* data = memory.GetFCRAMPointer(vertex * VertexStride);
+    const s8 bytes[3] = {value, static_cast<s8>(-value), 0};
+    const u8 ubytes[4] = {static_cast<u8>(value), 0, 128, 255};
+    const s16 shorts[2] = {static_cast<s16>(value * 100), -32768};
+    const f32 single = value * 0.5f;
+    std::memcpy(data, bytes, sizeof(bytes));
+    std::memcpy(data + 3, ubytes, sizeof(ubytes));
+    std::memcpy(data + 8, shorts, sizeof(shorts));
+    std::memcpy(data + 12, &single, sizeof(single));
+}
+
+} // Anonymous namespace
+
+TEST_CASE("vertex_loader.AttributeFormats", "[video_core][vertex_loader]") {
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    WriteVertex(memory, 0, 1);
+    WriteVertex(memory, 1, 100);
+
+    const VertexLoader loader{memory, MakeRegs()};
+    REQUIRE(loader.GetNumTotalAttributes() == 4);
+
+    AttributeBuffer input{};
+    AttributeBuffer default_attributes{};
+    loader.LoadVertex(1, input, default_attributes);
+
+    const auto check = [&](u32 attrib, f32 x, f32 y, f32 z, f32 w) {
+        REQUIRE(input[attrib].x.ToFloat32() == x);
+        REQUIRE(input[attrib].y.ToFloat32() == y);
+        REQUIRE(input[attrib].z.ToFloat32() == z);
+        REQUIRE(input[attrib].w.ToFloat32() == w);
+    };
+    check(0, 100.f, -100.f, 0.f, 1.f);
+    check(1, 100.f, 0.f, 128.f, 255.f);
+    check(2, 10000.f, -32768.f, 0.f, 1.f);
+    check(3, 50.f, 0.f, 0.f, 1.f);
+}
+
+TEST_CASE("vertex_loader.DefaultAttributes", "[video_core][vertex_loader]") {
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    WriteVertex(memory, 0, 3);
+
+    PipelineRegs regs = MakeRegs();
+    regs.vertex_attributes.attribute_mask.Assign(1 << 2);
+    const VertexLoader loader{memory, regs};
+
+    AttributeBuffer input{};
+    AttributeBuffer default_attributes{};
+    default_attributes[2] = {f24::FromFloat32(1.f), f24::FromFloat32(2.f), f24::FromFloat32(3.f),
+                             f24::FromFloat32(4.f)};
+    loader.LoadVertex(0, input, default_attributes);
+
+    REQUIRE(input[0].x.ToFloat32() == 3.f);
+    REQUIRE(input[2].x.ToFloat32() == 1.f);
+    REQUIRE(input[2].w.ToFloat32() == 4.f);
+    REQUIRE(input[3].x.ToFloat32() == 1.5f);
+}
+
+TEST_CASE("vertex_loader.LoadVertex throughput", "[.][benchmark]") {
+    constexpr u32 NumVertices = 4096;
+
+    Core::System system;
+    Memory::MemorySystem memory{system};
+    for (u32 vertex = 0; vertex < NumVertices; ++vertex) {
+        WriteVertex(memory, vertex, static_cast<s8>(vertex));
+    }
+    const VertexLoader loader{memory, MakeRegs()};
+    AttributeBuffer default_attributes{};
+
+    BENCHMARK("LoadVertex") {
+        AttributeBuffer input;
+        f32 sum = 0.f;
+        for (u32 vertex = 0; vertex < NumVertices; ++vertex) {
+            loader.LoadVertex(vertex, input, default_attributes);
+            sum += input[3].x.ToFloat32();
+        }
+        return sum;
+    };
+}
@@ -29,6 +29,11 @@ enum class CustomFileFormat : u32 {
     KTX = 3,
 };
 
+/// Returns the bit of format in masks of the formats the host GPU can sample from
+constexpr u32 CustomFormatBit(CustomPixelFormat format) {
+    return 1U << static_cast<u32>(format);
+}
+
 std::string_view CustomPixelFormatAsString(CustomPixelFormat format);
 
 bool IsCustomFormatCompressed(CustomPixelFormat format);
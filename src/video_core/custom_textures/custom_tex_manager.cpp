@@ -11,10 +11,12 @@
 #include "common/string_util.h"
 #include "common/texture.h"
 #include "core/core.h"
+#include "core/perf_stats.h"
 #include "core/frontend/image_interface.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "video_core/custom_textures/custom_tex_manager.h"
+#include "video_core/custom_textures/texture_pack.h"
 #include "video_core/rasterizer_cache/surface_params.h"
 #include "video_core/rasterizer_cache/utils.h"
 
@@ -29,6 +31,14 @@ constexpr std::size_t MAX_UPLOADS_PER_TICK = 8;
 
 using namespace Common::Literals;
 
+// Budget of the decoded materials on low memory hosts when the user did not set one.
+constexpr u64 LOW_MEMORY_BUDGET = 256_MiB;
+
+u64 MemoryBudget() {
+    const u64 budget = Settings::values.custom_texture_budget.GetValue() * 1_MiB;
+    return budget == 0 && Common::IsLowMemoryHost() ? LOW_MEMORY_BUDGET : budget;
+}
+
 bool IsPow2(u32 value) {
     return value != 0 && (value & (value - 1)) == 0;
 }
@@ -56,7 +66,9 @@ MapType MakeMapType(std::string_view ext) {
 
 CustomTexManager::CustomTexManager(Core::System& system_)
     : system{system_}, image_interface{*system.GetImageInterface()},
-      async_custom_loading{Settings::values.async_custom_loading.GetValue()} {}
+      async_custom_loading{Settings::values.async_custom_loading.GetValue()},
+      memory_budget{MemoryBudget()},
+      dump_compression{Settings::values.texture_dump_compression.GetValue()} {}
 
 CustomTexManager::~CustomTexManager() = default;
 
@@ -65,15 +77,22 @@ void CustomTexManager::TickFrame() {
     if (!textures_loaded) {
         return;
     }
+    current_frame++;
+    const auto now = std::chrono::steady_clock::now();
     std::size_t num_uploads = 0;
     for (auto it = async_uploads.begin(); it != async_uploads.end();) {
         if (num_uploads >= MAX_UPLOADS_PER_TICK) {
-            return;
+            break;
         }
         switch (it->material->state) {
         case DecodeState::Decoded:
             it->func();
             num_uploads++;
+            MarkResident(it->material);
+            if (system.perf_stats) {
+                system.perf_stats->AddCustomTextureUpload(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - it->requested));
+            }
             [[fallthrough]];
         case DecodeState::Failed:
             it = async_uploads.erase(it);
@@ -83,6 +102,10 @@ void CustomTexManager::TickFrame() {
             break;
         }
     }
+    EvictMaterials();
+    if (system.perf_stats) {
+        system.perf_stats->ReportCustomTextureQueue(static_cast<u32>(async_uploads.size()));
+    }
 }
 
 void CustomTexManager::FindCustomTextures() {
@@ -94,6 +117,23 @@ void CustomTexManager::FindCustomTextures() {
     }
 
     const u64 title_id = system.Kernel().GetCurrentProcess()->codeset->program_id;
+
+    // A packed archive replaces the directory tree, its materials are created as they are used.
+    const std::string pack_path = fmt::format(
+        "{}textures/{:016X}/textures.pack", GetUserPath(FileUtil::UserPath::LoadDir), title_id);
+    if (FileUtil::Exists(pack_path)) {
+        texture_pack = std::make_unique<TexturePack>(pack_path);
+        if (texture_pack->IsValid()) {
+            if (!ReadConfig(title_id, true)) {
+                use_new_hash = false;
+                skip_mipmap = true;
+            }
+            textures_loaded = true;
+            return;
+        }
+        texture_pack.reset();
+    }
+
     const auto textures = GetTextures(title_id);
     if (!ReadConfig(title_id)) {
         use_new_hash = false;
@@ -216,6 +256,14 @@ void CustomTexManager::PreloadTextures(const std::atomic_bool& stop_run,
     const u64 max_mem =
         (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
 
+    if (texture_pack) {
+        for (const TexturePackEntry& entry : texture_pack->Entries()) {
+            if (!material_map.contains(entry.hash)) {
+                LoadPackedMaterial(entry.hash);
+            }
+        }
+    }
+
     workers->QueueWork([&]() {
         for (auto& [hash, material] : material_map) {
             if (size_sum > max_mem) {
@@ -225,7 +273,7 @@ void CustomTexManager::PreloadTextures(const std::atomic_bool& stop_run,
             if (stop_run) {
                 return;
             }
-            material->LoadFromDisk(flip_png_files);
+            material->LoadFromDisk(flip_png_files, supported_formats);
             size_sum += material->size;
             if (callback) {
                 callback(VideoCore::LoadCallbackStage::Preload, preloaded, custom_textures.size());
@@ -235,28 +283,20 @@ void CustomTexManager::PreloadTextures(const std::atomic_bool& stop_run,
     });
     workers->WaitForRequests();
     async_custom_loading = false;
+    // Preloaded textures are meant to stay in memory, so they are only evicted by memory trims.
+    memory_budget = 0;
 }
 
 void CustomTexManager::DumpTexture(const SurfaceParams& params, u32 level, std::span<u8> data,
                                    u64 data_hash) {
-    const u64 program_id = system.Kernel().GetCurrentProcess()->codeset->program_id;
-    const u32 data_size = static_cast<u32>(data.size());
-    const u32 width = params.width;
-    const u32 height = params.height;
-    const PixelFormat format = params.pixel_format;
-
-    std::string dump_path = fmt::format(
-        "{}textures/{:016X}/", FileUtil::GetUserPath(FileUtil::UserPath::DumpDir), program_id);
-    if (!FileUtil::CreateFullPath(dump_path)) {
-        LOG_ERROR(Render, "Unable to create {}", dump_path);
+    // Most uploads repeat a hash that was already seen, so reject those before any other work.
+    if (!dumped_textures.insert(data_hash).second) {
         return;
     }
 
-    dump_path +=
-        fmt::format("tex1_{}x{}_{:016X}_{}_mip{}.png", width, height, data_hash, format, level);
-    if (dumped_textures.contains(data_hash) || FileUtil::Exists(dump_path)) {
-        return;
-    }
+    const u32 width = params.width;
+    const u32 height = params.height;
+    const PixelFormat format = params.pixel_format;
 
     // Make sure the texture size is a power of 2.
     // If not, the surface is probably a framebuffer
@@ -266,51 +306,206 @@ void CustomTexManager::DumpTexture(const SurfaceParams& params, u32 level, std::
         return;
     }
 
-    const u32 decoded_size = width * height * 4;
-    std::vector<u8> pixels(data_size + decoded_size);
-    std::memcpy(pixels.data(), data.data(), data_size);
+    const u64 program_id = system.Kernel().GetCurrentProcess()->codeset->program_id;
+    if (dump_dir.empty() || dump_program_id != program_id) {
+        std::string dir = fmt::format(
+            "{}textures/{:016X}/", FileUtil::GetUserPath(FileUtil::UserPath::DumpDir), program_id);
+        if (!FileUtil::CreateFullPath(dir)) {
+            LOG_ERROR(Render, "Unable to create {}", dir);
+            return;
+        }
+        dump_dir = std::move(dir);
+        dump_program_id = program_id;
+    }
+    std::string dump_path = dump_dir + fmt::format("tex1_{}x{}_{:016X}_{}_mip{}.png", width, height,
+                                                   data_hash, format, level);
 
-    auto dump = [this, width, height, params, data_size, decoded_size, pixels = std::move(pixels),
+    // Only the guest data is copied here, decoding and encoding happen on the workers.
+    auto dump = [this, width, height, params, encoded = std::vector<u8>(data.begin(), data.end()),
                  dump_path = std::move(dump_path)]() mutable {
-        const std::span encoded = std::span{pixels}.first(data_size);
-        const std::span decoded = std::span{pixels}.last(decoded_size);
+        if (FileUtil::Exists(dump_path)) {
+            return;
+        }
+        std::vector<u8> decoded(width * height * 4);
         DecodeTexture(params, params.addr, params.end, encoded, decoded,
                       params.type == SurfaceType::Color);
         Common::FlipRGBA8Texture(decoded, width, height);
-        image_interface.EncodePNG(dump_path, width, height, decoded);
+        image_interface.EncodePNG(dump_path, width, height, decoded, dump_compression);
     };
     if (!workers) {
         CreateWorkers();
     }
-    workers->QueueWork(std::move(dump));
-    dumped_textures.insert(data_hash);
+    workers->QueueWork(std::move(dump), Common::WorkPriority::Background);
 }
 
 Material* CustomTexManager::GetMaterial(u64 data_hash) {
     const auto it = material_map.find(data_hash);
-    if (it == material_map.end()) {
-        LOG_WARNING(Render, "Unable to find replacement for surface with hash {:016X}", data_hash);
+    if (it != material_map.end()) {
+        return it->second.get();
+    }
+    if (texture_pack) {
+        if (Material* material = LoadPackedMaterial(data_hash)) {
+            return material;
+        }
+    }
+    LOG_WARNING(Render, "Unable to find replacement for surface with hash {:016X}", data_hash);
+    return nullptr;
+}
+
+Material* CustomTexManager::LoadPackedMaterial(u64 hash) {
+    const auto entries = texture_pack->Find(hash);
+    if (entries.empty()) {
         return nullptr;
     }
-    return it->second.get();
+
+    auto material = std::make_unique<Material>();
+    material->hash = hash;
+    for (const TexturePackEntry& entry : entries) {
+        const auto file_format = static_cast<CustomFileFormat>(u32{entry.file_format});
+        const auto map_type = static_cast<MapType>(u32{entry.map_type});
+        if (map_type >= MapType::MapCount) {
+            LOG_ERROR(Render, "Texture {:016X} of {} has an invalid map type", hash,
+                      texture_pack->Path());
+            continue;
+        }
+        if (file_format == CustomFileFormat::DDS && skip_mipmap) {
+            LOG_ERROR(Render, "Mipmap skip is incompatible with DDS textures, skipping!");
+            continue;
+        }
+
+        // Files mapped to several hashes are stored once, and are shared between their materials.
+        CustomTexture*& texture = packed_textures[entry.offset];
+        if (!texture) {
+            custom_textures.push_back(std::make_unique<CustomTexture>(image_interface));
+            texture = custom_textures.back().get();
+            texture->path = fmt::format("{}@{:#x}", texture_pack->Path(), u64{entry.offset});
+            texture->packed_data = texture_pack->Payload(entry);
+            texture->file_format = file_format;
+            texture->type = map_type;
+        }
+        texture->hashes.push_back(hash);
+        material->AddMapTexture(texture);
+    }
+    return material_map.emplace(hash, std::move(material)).first->second.get();
 }
 
 bool CustomTexManager::Decode(Material* material, std::function<bool()>&& upload) {
     if (!async_custom_loading) {
-        material->LoadFromDisk(flip_png_files);
+        material->last_use = current_frame;
+        material->LoadFromDisk(flip_png_files, supported_formats);
+        if (material->IsDecoded()) {
+            MarkResident(material);
+        }
         return upload();
     }
-    if (material->IsUnloaded()) {
-        material->state = DecodeState::Pending;
-        workers->QueueWork([material, this] { material->LoadFromDisk(flip_png_files); });
+    bool queue_decode = false;
+    {
+        // Requesting a queued material again moves it ahead of the materials of older frames.
+        std::scoped_lock lock{decode_queue_mutex};
+        material->last_use = current_frame;
+        if (material->IsUnloaded()) {
+            material->state = DecodeState::Pending;
+            decode_queue.push_back(material);
+            queue_decode = true;
+        }
+    }
+    if (queue_decode) {
+        workers->QueueWork([this] { DecodeNext(); }, Common::WorkPriority::High);
     }
     async_uploads.push_back({
         .material = material,
         .func = std::move(upload),
+        .requested = std::chrono::steady_clock::now(),
     });
     return false;
 }
 
+void CustomTexManager::DecodeNext() {
+    Material* material;
+    {
+        // Each queued work item decodes one material, so the queue can never be empty here.
+        std::scoped_lock lock{decode_queue_mutex};
+        const auto it = std::max_element(
+            decode_queue.begin(), decode_queue.end(),
+            [](const Material* a, const Material* b) { return a->last_use < b->last_use; });
+        material = *it;
+        *it = decode_queue.back();
+        decode_queue.pop_back();
+    }
+    material->LoadFromDisk(flip_png_files, supported_formats);
+}
+
+void CustomTexManager::MarkResident(Material* material) {
+    if (resident_materials.insert(material).second) {
+        resident_memory += material->size;
+    }
+}
+
+void CustomTexManager::EvictMaterials() {
+    // A memory trim request releases every material that was not used in the last frame.
+    const u64 trim_count = Common::GetMemoryTrimCount();
+    const bool trim = trim_count != memory_trim_count;
+    memory_trim_count = trim_count;
+    if (!trim && (memory_budget == 0 || resident_memory <= memory_budget)) {
+        return;
+    }
+    const u64 target = trim ? 0 : memory_budget;
+
+    // Materials waiting to be decoded or uploaded still need their data.
+    std::unordered_set<const Material*> busy_materials;
+    for (const AsyncUpload& upload : async_uploads) {
+        busy_materials.insert(upload.material);
+    }
+
+    std::vector<Material*> candidates{resident_materials.begin(), resident_materials.end()};
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Material* a, const Material* b) { return a->last_use < b->last_use; });
+
+    u32 evicted = 0;
+    std::vector<Material*> sharing;
+    for (Material* const material : candidates) {
+        // Keep the materials of the last frame, they are likely to be requested again.
+        if (resident_memory <= target || material->last_use + 1 >= current_frame) {
+            break;
+        }
+        if (!material->IsDecoded()) {
+            continue;
+        }
+
+        // Maps shared with other materials are released for all of them.
+        sharing.assign(1, material);
+        bool busy = false;
+        for (const CustomTexture* texture : material->textures) {
+            if (!texture) {
+                continue;
+            }
+            for (const u64 hash : texture->hashes) {
+                const auto it = material_map.find(hash);
+                if (it == material_map.end()) {
+                    continue;
+                }
+                Material* const shared = it->second.get();
+                busy |= shared->IsPending() || busy_materials.contains(shared);
+                sharing.push_back(shared);
+            }
+        }
+        if (busy) {
+            continue;
+        }
+        for (Material* const shared : sharing) {
+            if (resident_materials.erase(shared)) {
+                resident_memory -= shared->size;
+                evicted++;
+            }
+            if (shared->IsDecoded()) {
+                shared->Unload();
+            }
+        }
+    }
+    LOG_DEBUG(Render, "Evicted {} custom materials, {} MiB remain decoded", evicted,
+              resident_memory >> 20);
+}
+
 bool CustomTexManager::ReadConfig(u64 title_id, bool options_only) {
     const std::string load_path =
         fmt::format("{}textures/{:016X}/", GetUserPath(FileUtil::UserPath::LoadDir), title_id);
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <list>
+#include <mutex>
 #include <span>
 #include <unordered_map>
 #include <unordered_set>
@@ -23,10 +25,12 @@ struct FSTEntry;
 namespace VideoCore {
 
 class SurfaceParams;
+class TexturePack;
 
 struct AsyncUpload {
-    const Material* material;
+    Material* material;
     std::function<bool()> func;
+    std::chrono::steady_clock::time_point requested;
 };
 
 class CustomTexManager {
@@ -64,6 +68,11 @@ public:
         return skip_mipmap;
     }
 
+    /// Sets the mask of CustomFormatBit values the host GPU can sample from.
+    void SetSupportedFormats(u32 formats) noexcept {
+        supported_formats = formats;
+    }
+
     /// Returns true if the pack uses the new hashing method.
     bool UseNewHash() const noexcept {
         return use_new_hash;
@@ -76,6 +85,18 @@ private:
     /// Returns a vector of all custom texture files.
     std::vector<FileUtil::FSTEntry> GetTextures(u64 title_id);
 
+    /// Creates the material of hash from the packed archive, returns nullptr if it has none.
+    Material* LoadPackedMaterial(u64 hash);
+
+    /// Decodes the queued material that was requested most recently.
+    void DecodeNext();
+
+    /// Tracks the decoded data of material towards the memory budget.
+    void MarkResident(Material* material);
+
+    /// Releases the decoded data of the least recently used materials over the memory budget.
+    void EvictMaterials();
+
     /// Creates the thread workers.
     void CreateWorkers();
 
@@ -83,16 +104,29 @@ private:
     Core::System& system;
     Frontend::ImageInterface& image_interface;
     std::unordered_set<u64> dumped_textures;
+    std::string dump_dir;
+    u64 dump_program_id{};
     std::unordered_map<u64, std::unique_ptr<Material>> material_map;
     std::unordered_map<std::string, std::vector<u64>> path_to_hash_map;
     std::vector<std::unique_ptr<CustomTexture>> custom_textures;
+    std::unique_ptr<TexturePack> texture_pack;
+    std::unordered_map<u64, CustomTexture*> packed_textures;
     std::list<AsyncUpload> async_uploads;
+    std::mutex decode_queue_mutex;
+    std::vector<Material*> decode_queue;
+    std::unordered_set<Material*> resident_materials;
     std::unique_ptr<Common::ThreadWorker> workers;
+    u64 current_frame{};
+    u64 resident_memory{};
     bool textures_loaded{false};
     bool async_custom_loading{true};
     bool skip_mipmap{false};
     bool flip_png_files{true};
     bool use_new_hash{true};
+    u32 supported_formats{~0U};
+    u64 memory_budget{};
+    u64 memory_trim_count{};
+    u32 dump_compression{};
 };
 
 } // namespace VideoCore
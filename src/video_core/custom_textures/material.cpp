@@ -7,6 +7,7 @@
 #include "common/texture.h"
 #include "core/frontend/image_interface.h"
 #include "video_core/custom_textures/material.h"
+#include "video_core/custom_textures/transcoder.h"
 
 namespace VideoCore {
 
@@ -54,17 +55,23 @@ CustomTexture::CustomTexture(Frontend::ImageInterface& image_interface_)
 
 CustomTexture::~CustomTexture() = default;
 
-void CustomTexture::LoadFromDisk(bool flip_png) {
+void CustomTexture::LoadFromDisk(bool flip_png, u32 supported_formats) {
     std::scoped_lock lock{decode_mutex};
     if (IsLoaded()) {
         return;
     }
 
-    FileUtil::IOFile file{path, "rb"};
-    std::vector<u8> input(file.GetSize());
-    if (file.ReadBytes(input.data(), input.size()) != input.size()) {
-        LOG_CRITICAL(Render, "Failed to open custom texture: {}", path);
-        return;
+    // Textures of packed archives are decoded straight from the mapped file.
+    std::vector<u8> file_data;
+    std::span<const u8> input = packed_data;
+    if (input.empty()) {
+        FileUtil::IOFile file{path, "rb"};
+        file_data.resize(file.GetSize());
+        if (file.ReadBytes(file_data.data(), file_data.size()) != file_data.size()) {
+            LOG_CRITICAL(Render, "Failed to open custom texture: {}", path);
+            return;
+        }
+        input = file_data;
     }
     switch (file_format) {
     case CustomFileFormat::PNG:
@@ -72,13 +79,19 @@ void CustomTexture::LoadFromDisk(bool flip_png) {
         break;
     case CustomFileFormat::DDS:
     case CustomFileFormat::KTX:
-        LoadDDS(input);
+        LoadDDS(input, supported_formats);
         break;
     default:
         LOG_ERROR(Render, "Unknown file format {}", file_format);
     }
 }
 
+void CustomTexture::Unload() {
+    std::scoped_lock lock{decode_mutex};
+    data.clear();
+    data.shrink_to_fit();
+}
+
 void CustomTexture::LoadPNG(std::span<const u8> input, bool flip_png) {
     if (!image_interface.DecodePNG(data, width, height, input)) {
         LOG_ERROR(Render, "Failed to decode png: {}", path);
@@ -90,13 +103,28 @@ void CustomTexture::LoadPNG(std::span<const u8> input, bool flip_png) {
     format = CustomPixelFormat::RGBA8;
 }
 
-void CustomTexture::LoadDDS(std::span<const u8> input) {
+void CustomTexture::LoadDDS(std::span<const u8> input, u32 supported_formats) {
     ddsktx_format dds_format{};
     image_interface.DecodeDDS(data, width, height, dds_format, input);
     format = ToCustomPixelFormat(dds_format);
+    if (data.empty() || (supported_formats & CustomFormatBit(format)) != 0) {
+        return;
+    }
+
+    // Compressed payloads are uploaded as is, unless the host GPU can not sample their format.
+    std::vector<u8> rgba;
+    if (!TranscodeToRGBA8(format, width, height, data, rgba)) {
+        LOG_ERROR(Render, "Custom texture {} uses {} which the host GPU does not support", path,
+                  CustomPixelFormatAsString(format));
+        return;
+    }
+    LOG_DEBUG(Render, "Transcoded {} custom texture {} to RGBA8", CustomPixelFormatAsString(format),
+              path);
+    data = std::move(rgba);
+    format = CustomPixelFormat::RGBA8;
 }
 
-void Material::LoadFromDisk(bool flip_png) noexcept {
+void Material::LoadFromDisk(bool flip_png, u32 supported_formats) noexcept {
     if (IsDecoded()) {
         return;
     }
@@ -104,7 +132,7 @@ void Material::LoadFromDisk(bool flip_png) noexcept {
         if (!texture || texture->IsLoaded()) {
             continue;
         }
-        texture->LoadFromDisk(flip_png);
+        texture->LoadFromDisk(flip_png, supported_formats);
         size += texture->data.size();
         LOG_DEBUG(Render, "Loading {} map {}", MapTypeName(texture->type), texture->path);
     }
@@ -141,6 +169,16 @@ void Material::LoadFromDisk(bool flip_png) noexcept {
     state = DecodeState::Decoded;
 }
 
+void Material::Unload() noexcept {
+    for (CustomTexture* const texture : textures) {
+        if (texture) {
+            texture->Unload();
+        }
+    }
+    size = 0;
+    state = DecodeState::None;
+}
+
 void Material::AddMapTexture(CustomTexture* texture) noexcept {
     const std::size_t index = static_cast<std::size_t>(texture->type);
     if (textures[index]) {
@@ -37,7 +37,11 @@ public:
     explicit CustomTexture(Frontend::ImageInterface& image_interface);
     ~CustomTexture();
 
-    void LoadFromDisk(bool flip_png);
+    /// Loads and decodes the texture, formats missing from supported_formats are transcoded.
+    void LoadFromDisk(bool flip_png, u32 supported_formats);
+
+    /// Releases the decoded data, the texture can be loaded again afterwards.
+    void Unload();
 
     [[nodiscard]] bool IsParsed() const noexcept {
         return file_format != CustomFileFormat::None && !hashes.empty();
@@ -50,11 +54,12 @@ public:
 private:
     void LoadPNG(std::span<const u8> input, bool flip_png);
 
-    void LoadDDS(std::span<const u8> input);
+    void LoadDDS(std::span<const u8> input, u32 supported_formats);
 
 public:
     Frontend::ImageInterface& image_interface;
     std::string path;
+    std::span<const u8> packed_data;
     u32 width;
     u32 height;
     std::vector<u64> hashes;
@@ -73,8 +78,13 @@ struct Material {
     CustomPixelFormat format;
     std::array<CustomTexture*, MAX_MAPS> textures;
     std::atomic<DecodeState> state{};
+    /// Frame the material was last requested in, used to prioritize and evict decodes.
+    u64 last_use{};
+
+    void LoadFromDisk(bool flip_png, u32 supported_formats) noexcept;
 
-    void LoadFromDisk(bool flip_png) noexcept;
+    /// Releases the decoded data of all maps and returns the material to the unloaded state.
+    void Unload() noexcept;
 
     void AddMapTexture(CustomTexture* texture) noexcept;
 
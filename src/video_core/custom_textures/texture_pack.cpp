@@ -0,0 +1,79 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include "common/logging/log.h"
+#include "video_core/custom_textures/texture_pack.h"
+
+namespace VideoCore {
+
+namespace {
+
+bool EntryLess(const TexturePackEntry& lhs, const TexturePackEntry& rhs) {
+    return lhs.hash < rhs.hash || (lhs.hash == rhs.hash && lhs.map_type < rhs.map_type);
+}
+
+} // Anonymous namespace
+
+TexturePack::TexturePack(const std::string& path_)
+    : path{path_}, file{path, "rb"}, mapping{file} {
+    if (!mapping.IsValid()) {
+        LOG_ERROR(Render, "Unable to map texture pack {}", path);
+        return;
+    }
+
+    const std::span<const u8> data = mapping.Data();
+    TexturePackHeader header{};
+    if (data.size() < sizeof(header)) {
+        LOG_ERROR(Render, "{} is not a texture pack", path);
+        return;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != TexturePackMagic || header.version != TexturePackVersion) {
+        LOG_ERROR(Render, "{} is not a supported texture pack", path);
+        return;
+    }
+
+    // The index is read in place, so it must be aligned and within the file.
+    const u64 index_size = u64{header.entry_count} * sizeof(TexturePackEntry);
+    if (header.index_offset % alignof(TexturePackEntry) != 0 || header.index_offset > data.size() ||
+        data.size() - header.index_offset < index_size) {
+        LOG_ERROR(Render, "{} has a corrupted index", path);
+        return;
+    }
+    const std::span<const TexturePackEntry> index{
+        reinterpret_cast<const TexturePackEntry*>(data.data() + header.index_offset),
+        header.entry_count};
+    const bool payloads_valid = std::ranges::all_of(index, [&](const TexturePackEntry& entry) {
+        return entry.offset <= data.size() && data.size() - entry.offset >= entry.size;
+    });
+    if (!payloads_valid || !std::is_sorted(index.begin(), index.end(), EntryLess)) {
+        LOG_ERROR(Render, "{} has a corrupted index", path);
+        return;
+    }
+
+    entries = index;
+    LOG_INFO(Render, "Loaded texture pack {} with {} textures", path, entries.size());
+}
+
+TexturePack::~TexturePack() = default;
+
+std::span<const TexturePackEntry> TexturePack::Find(u64 hash) const {
+    const auto it = std::lower_bound(
+        entries.begin(), entries.end(), hash,
+        [](const TexturePackEntry& entry, u64 value) { return entry.hash < value; });
+    auto end = it;
+    while (end != entries.end() && end->hash == hash) {
+        ++end;
+    }
+    return {it, end};
+}
+
+std::span<const u8> TexturePack::Payload(const TexturePackEntry& entry) const {
+    return mapping.Data().subspan(static_cast<std::size_t>(entry.offset),
+                                  static_cast<std::size_t>(entry.size));
+}
+
+} // namespace VideoCore
@@ -0,0 +1,73 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+#include <string>
+#include "common/file_util.h"
+#include "common/swap.h"
+
+namespace VideoCore {
+
+/**
+ * Texture packs can be distributed as a single textures.pack file instead of a directory tree,
+ * which is built with tools/build-texture-pack.py. The file holds the files of the pack unchanged,
+ * so DDS and KTX textures keep their BCn and ASTC payloads, followed by an index that is sorted
+ * by hash. The file is mapped into memory and its textures are only decoded when first used.
+ */
+constexpr u32 TexturePackMagic = 0x4B505443; // "CTPK"
+constexpr u32 TexturePackVersion = 1;
+
+struct TexturePackHeader {
+    u32_le magic;
+    u32_le version;
+    u32_le entry_count;
+    u32_le reserved;
+    u64_le index_offset;
+};
+static_assert(sizeof(TexturePackHeader) == 24, "TexturePackHeader has incorrect size");
+
+/// Maps a texture hash to one of the files in the pack, entries are sorted by hash and map type.
+struct TexturePackEntry {
+    u64_le hash;
+    u64_le offset;
+    u64_le size;
+    u32_le file_format; ///< CustomFileFormat of the file
+    u32_le map_type;    ///< MapType of the file
+};
+static_assert(sizeof(TexturePackEntry) == 32, "TexturePackEntry has incorrect size");
+
+class TexturePack {
+public:
+    explicit TexturePack(const std::string& path);
+    ~TexturePack();
+
+    [[nodiscard]] bool IsValid() const noexcept {
+        return !entries.empty();
+    }
+
+    [[nodiscard]] const std::string& Path() const noexcept {
+        return path;
+    }
+
+    /// Returns all the entries of the pack.
+    [[nodiscard]] std::span<const TexturePackEntry> Entries() const noexcept {
+        return entries;
+    }
+
+    /// Returns the entries mapped to hash, one for each map type of the material.
+    [[nodiscard]] std::span<const TexturePackEntry> Find(u64 hash) const;
+
+    /// Returns the file data of the entry.
+    [[nodiscard]] std::span<const u8> Payload(const TexturePackEntry& entry) const;
+
+private:
+    std::string path;
+    FileUtil::IOFile file;
+    FileUtil::MappedFile mapping;
+    std::span<const TexturePackEntry> entries;
+};
+
+} // namespace VideoCore
@@ -0,0 +1,150 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "video_core/custom_textures/transcoder.h"
+
+namespace VideoCore {
+
+namespace {
+
+constexpr u32 BLOCK_WIDTH = 4;
+constexpr u32 BLOCK_HEIGHT = 4;
+
+/// RGBA8 texels of a block, in row major order.
+using Block = std::array<u8, BLOCK_WIDTH * BLOCK_HEIGHT * 4>;
+using Color = std::array<u8, 4>;
+
+Color Expand565(u16 color) {
+    const u32 r = (color >> 11) & 0x1F;
+    const u32 g = (color >> 5) & 0x3F;
+    const u32 b = color & 0x1F;
+    return {static_cast<u8>((r << 3) | (r >> 2)), static_cast<u8>((g << 2) | (g >> 4)),
+            static_cast<u8>((b << 3) | (b >> 2)), 255};
+}
+
+/// Decodes the color half of BC1 to BC3 blocks, the BC3 color block never has transparent texels
+void DecodeColorBlock(const u8* src, bool always_opaque, Block& block) {
+    u16 c0;
+    u16 c1;
+    u32 indices;
+    std::memcpy(&c0, src, sizeof(c0));
+    std::memcpy(&c1, src + 2, sizeof(c1));
+    std::memcpy(&indices, src + 4, sizeof(indices));
+
+    std::array<Color, 4> palette{Expand565(c0), Expand565(c1)};
+    if (c0 > c1 || always_opaque) {
+        for (std::size_t i = 0; i < 3; i++) {
+            palette[2][i] = static_cast<u8>((2 * palette[0][i] + palette[1][i]) / 3);
+            palette[3][i] = static_cast<u8>((palette[0][i] + 2 * palette[1][i]) / 3);
+        }
+        palette[2][3] = palette[3][3] = 255;
+    } else {
+        for (std::size_t i = 0; i < 3; i++) {
+            palette[2][i] = static_cast<u8>((palette[0][i] + palette[1][i]) / 2);
+        }
+        palette[2][3] = 255;
+        palette[3] = {0, 0, 0, 0};
+    }
+
+    for (u32 texel = 0; texel < BLOCK_WIDTH * BLOCK_HEIGHT; texel++) {
+        const Color& color = palette[(indices >> (2 * texel)) & 3];
+        std::memcpy(block.data() + texel * 4, color.data(), color.size());
+    }
+}
+
+/// Decodes a BC3 alpha block, which BC5 also uses for each of its two channels, into channel
+void DecodeChannelBlock(const u8* src, std::size_t channel, Block& block) {
+    u64 bits;
+    std::memcpy(&bits, src, sizeof(bits));
+    const u32 a0 = bits & 0xFF;
+    const u32 a1 = (bits >> 8) & 0xFF;
+
+    std::array<u8, 8> palette{static_cast<u8>(a0), static_cast<u8>(a1)};
+    if (a0 > a1) {
+        for (u32 i = 1; i < 7; i++) {
+            palette[i + 1] = static_cast<u8>(((7 - i) * a0 + i * a1) / 7);
+        }
+    } else {
+        for (u32 i = 1; i < 5; i++) {
+            palette[i + 1] = static_cast<u8>(((5 - i) * a0 + i * a1) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (u32 texel = 0; texel < BLOCK_WIDTH * BLOCK_HEIGHT; texel++) {
+        block[texel * 4 + channel] = palette[(bits >> (16 + 3 * texel)) & 7];
+    }
+}
+
+void DecodeBlock(CustomPixelFormat format, const u8* src, Block& block) {
+    switch (format) {
+    case CustomPixelFormat::BC1:
+        DecodeColorBlock(src, false, block);
+        break;
+    case CustomPixelFormat::BC3:
+        DecodeColorBlock(src + 8, true, block);
+        DecodeChannelBlock(src, 3, block);
+        break;
+    case CustomPixelFormat::BC5:
+        for (u32 texel = 0; texel < BLOCK_WIDTH * BLOCK_HEIGHT; texel++) {
+            block[texel * 4 + 2] = 0;
+            block[texel * 4 + 3] = 255;
+        }
+        DecodeChannelBlock(src, 0, block);
+        DecodeChannelBlock(src + 8, 1, block);
+        break;
+    default:
+        break;
+    }
+}
+
+} // Anonymous namespace
+
+bool CanTranscodeToRGBA8(CustomPixelFormat format) {
+    switch (format) {
+    case CustomPixelFormat::BC1:
+    case CustomPixelFormat::BC3:
+    case CustomPixelFormat::BC5:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool TranscodeToRGBA8(CustomPixelFormat format, u32 width, u32 height, std::span<const u8> src,
+                      std::vector<u8>& dst) {
+    if (!CanTranscodeToRGBA8(format)) {
+        return false;
+    }
+    const std::size_t block_size = format == CustomPixelFormat::BC1 ? 8 : 16;
+    const u32 blocks_x = (width + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+    const u32 blocks_y = (height + BLOCK_HEIGHT - 1) / BLOCK_HEIGHT;
+    if (src.size() < std::size_t{blocks_x} * blocks_y * block_size) {
+        return false;
+    }
+
+    dst.resize(std::size_t{width} * height * 4);
+    Block block;
+    for (u32 block_y = 0; block_y < blocks_y; block_y++) {
+        for (u32 block_x = 0; block_x < blocks_x; block_x++) {
+            DecodeBlock(format, src.data() + (block_y * blocks_x + block_x) * block_size, block);
+
+            // Blocks on the right and bottom edges can extend past the texture.
+            const u32 x = block_x * BLOCK_WIDTH;
+            const u32 row_texels = std::min(BLOCK_WIDTH, width - x);
+            for (u32 row = 0; row < BLOCK_HEIGHT && block_y * BLOCK_HEIGHT + row < height; row++) {
+                const std::size_t y = block_y * BLOCK_HEIGHT + row;
+                std::memcpy(dst.data() + (y * width + x) * 4, block.data() + row * BLOCK_WIDTH * 4,
+                            row_texels * 4);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace VideoCore
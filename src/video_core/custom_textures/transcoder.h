@@ -0,0 +1,24 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include "video_core/custom_textures/custom_format.h"
+
+namespace VideoCore {
+
+/// Returns true if textures stored with format can be transcoded to RGBA8 on the CPU.
+bool CanTranscodeToRGBA8(CustomPixelFormat format);
+
+/**
+ * Decodes the block compressed texture in src to RGBA8, keeping its row order. This is only used
+ * for formats the host GPU can not sample from, as it gives up the memory savings of the format.
+ * Returns false if the format can not be transcoded or src is too small.
+ */
+bool TranscodeToRGBA8(CustomPixelFormat format, u32 width, u32 height, std::span<const u8> src,
+                      std::vector<u8>& dst);
+
+} // namespace VideoCore
@@ -2,19 +2,24 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include "common/archives.h"
 #include "common/hacks/hack_manager.h"
 #include "common/microprofile.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/gsp/gsp_gpu.h"
+#include "core/hle/service/hid/hid.h"
 #include "core/hle/service/plgldr/plgldr.h"
+#include "core/tracer/recorder.h"
 #include "video_core/debug_utils/debug_utils.h"
 #include "video_core/gpu.h"
 #include "video_core/gpu_debugger.h"
 #include "video_core/gpu_impl.h"
+#include "video_core/gpu_thread.h"
 #include "video_core/pica/pica_core.h"
 #include "video_core/pica/regs_lcd.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_software/sw_blitter.h"
 #include "video_core/right_eye_disabler.h"
@@ -36,13 +41,44 @@ GPU::GPU(Core::System& system, Frontend::EmuWindow& emu_window,
         "GPU::VBlankCallback",
         [this](uintptr_t user_data, s64 cycles_late) { VBlankCallback(user_data, cycles_late); });
     impl->timing.ScheduleEvent(FRAME_TICKS, impl->vblank_event);
+    impl->interrupt_event = impl->timing.RegisterEvent(
+        "GPU::InterruptCallback", [this](uintptr_t user_data, s64 cycles_late) {
+            impl->signal_interrupt(static_cast<Service::GSP::InterruptId>(user_data));
+        });
 
     // Bind the rasterizer to the PICA GPU
     impl->pica.BindRasterizer(impl->rasterizer);
+
+    if (Settings::values.use_gpu_thread.GetValue()) {
+        // The OpenGL context is owned by the emulation thread.
+        if (Settings::values.graphics_api.GetValue() == Settings::GraphicsAPI::OpenGL) {
+            LOG_WARNING(HW_GPU, "The GPU thread is not supported by the OpenGL renderer");
+        } else {
+            impl->gpu_thread = std::make_unique<GPUThread>();
+        }
+    }
 }
 
 GPU::~GPU() = default;
 
+template <typename Func>
+void GPU::RunAsync(Func&& func) {
+    if (impl->gpu_thread && !impl->gpu_thread->IsGPUThread()) {
+        impl->gpu_thread->Push(std::forward<Func>(func));
+    } else {
+        func();
+    }
+}
+
+template <typename Func>
+void GPU::RunSync(Func&& func) {
+    if (impl->gpu_thread && !impl->gpu_thread->IsGPUThread()) {
+        impl->gpu_thread->Wait(impl->gpu_thread->Push(std::forward<Func>(func)));
+    } else {
+        func();
+    }
+}
+
 PAddr GPU::VirtualToPhysicalAddress(VAddr addr) {
     if (addr == 0) {
         return 0;
@@ -69,23 +105,89 @@ PAddr GPU::VirtualToPhysicalAddress(VAddr addr) {
 }
 
 void GPU::SetInterruptHandler(Service::GSP::InterruptHandler handler) {
+    Synchronize();
     impl->signal_interrupt = handler;
-    impl->pica.SetInterruptHandler(handler);
+    if (impl->gpu_thread) {
+        // Kernel objects may only be signalled from the emulation thread.
+        impl->gpu_interrupt = [this](Service::GSP::InterruptId interrupt_id) {
+            impl->timing.ScheduleEvent(0, impl->interrupt_event,
+                                       static_cast<std::uintptr_t>(interrupt_id), 0, true);
+        };
+    } else {
+        impl->gpu_interrupt = handler;
+    }
+    impl->pica.SetInterruptHandler(impl->gpu_interrupt);
 }
 
 void GPU::FlushRegion(PAddr addr, u32 size) {
-    impl->rasterizer->FlushRegion(addr, size);
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+    RunSync([this, addr, size] { impl->rasterizer->FlushRegion(addr, size); });
 }
 
 void GPU::InvalidateRegion(PAddr addr, u32 size) {
-    impl->rasterizer->InvalidateRegion(addr, size);
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+    // Invalidations are ordered with the GPU work around them, so there is no need to wait.
+    RunAsync([this, addr, size] { impl->rasterizer->InvalidateRegion(addr, size); });
+}
+
+void GPU::FlushAndInvalidateRegion(PAddr addr, u32 size) {
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+    RunSync([this, addr, size] { impl->rasterizer->FlushAndInvalidateRegion(addr, size); });
 }
 
 void GPU::ClearAll(bool flush) {
-    impl->rasterizer->ClearAll(flush);
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+    RunSync([this, flush] { impl->rasterizer->ClearAll(flush); });
 }
 
-void GPU::Execute(const Service::GSP::Command& command) {
+std::vector<VideoCore::SurfaceDescriptor> GPU::GetSurfaceDescriptors(std::size_t max_count) {
+    std::vector<VideoCore::SurfaceDescriptor> surfaces;
+    RunSync([&] { surfaces = impl->rasterizer->GetSurfaceDescriptors(max_count); });
+    return surfaces;
+}
+
+void GPU::PrewarmSurfaces(std::span<const VideoCore::SurfaceDescriptor> surfaces) {
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+    RunSync([this, surfaces] { impl->rasterizer->PrewarmSurfaces(surfaces); });
+}
+
+void GPU::Execute(std::span<const Service::GSP::Command> commands) {
+    const auto is_dma = [](const Service::GSP::Command& command) {
+        return command.id == Service::GSP::CommandId::RequestDma;
+    };
+
+    while (!commands.empty()) {
+        // CPU writes since the last GPU command may have invalidated surfaces these commands use.
+        // The guest does not run while the queue is drained, so only the DMA copies made in
+        // between can add more.
+        impl->system.Memory().FlushPendingRasterizerInvalidations();
+
+        // DMA requests are copies made by the CPU, so they complete on the emulation thread once
+        // the GPU is done with the memory.
+        if (is_dma(commands.front())) {
+            Synchronize();
+            ExecuteCommand(commands.front());
+            commands = commands.subspan(1);
+            continue;
+        }
+
+        // The commands up to the next DMA request are handed to the GPU as a single batch.
+        const auto batch_end = std::find_if(commands.begin(), commands.end(), is_dma);
+        if (impl->gpu_thread) {
+            RunAsync([this, batch = std::vector(commands.begin(), batch_end)] {
+                for (const auto& command : batch) {
+                    ExecuteCommand(command);
+                }
+            });
+        } else {
+            std::for_each(commands.begin(), batch_end,
+                          [this](const auto& command) { ExecuteCommand(command); });
+        }
+        commands = commands.subspan(std::distance(commands.begin(), batch_end));
+    }
+}
+
+void GPU::ExecuteCommand(const Service::GSP::Command& command) {
     using Service::GSP::CommandId;
     auto& regs = impl->pica.regs;
 
@@ -128,6 +230,7 @@ void GPU::Execute(const Service::GSP::Command& command) {
             memfill[0].address_end = VirtualToPhysicalAddress(params.end1) >> 3;
             memfill[0].value_32bit = params.value1;
             memfill[0].control = params.control1;
+            RecordRegs(GPU_REG_INDEX(memory_fill_config[0]), sizeof(memfill[0]) / sizeof(u32));
             MemoryFill(0);
         }
         if (params.start2 != 0) {
@@ -135,6 +238,7 @@ void GPU::Execute(const Service::GSP::Command& command) {
             memfill[1].address_end = VirtualToPhysicalAddress(params.end2) >> 3;
             memfill[1].value_32bit = params.value2;
             memfill[1].control = params.control2;
+            RecordRegs(GPU_REG_INDEX(memory_fill_config[1]), sizeof(memfill[1]) / sizeof(u32));
             MemoryFill(1);
         }
         break;
@@ -150,6 +254,8 @@ void GPU::Execute(const Service::GSP::Command& command) {
         display_transfer.output_size = params.out_buffer_size;
         display_transfer.flags = params.flags;
         display_transfer.trigger.Assign(1);
+        RecordRegs(GPU_REG_INDEX(display_transfer_config), sizeof(display_transfer) / sizeof(u32),
+                   GPU_REG_INDEX(display_transfer_config.trigger));
 
         // Trigger the display transfer.
         MemoryTransfer();
@@ -167,6 +273,8 @@ void GPU::Execute(const Service::GSP::Command& command) {
         texture_copy.texture_copy.output_size = params.out_width_gap;
         texture_copy.flags = params.flags;
         texture_copy.trigger.Assign(1);
+        RecordRegs(GPU_REG_INDEX(display_transfer_config), sizeof(texture_copy) / sizeof(u32),
+                   GPU_REG_INDEX(display_transfer_config.trigger));
 
         // Trigger the texture copy.
         MemoryTransfer();
@@ -191,38 +299,52 @@ void GPU::SetBufferSwap(u32 screen_id, const Service::GSP::FrameBufferInfo& info
     const PAddr phys_address_left = VirtualToPhysicalAddress(info.address_left);
     const PAddr phys_address_right = VirtualToPhysicalAddress(info.address_right);
 
-    // Update framebuffer properties.
-    auto& framebuffer = impl->pica.regs.framebuffer_config[screen_id];
-    if (info.active_fb == 0) {
-        framebuffer.address_left1 = phys_address_left;
-        framebuffer.address_right1 = phys_address_right;
-    } else {
-        framebuffer.address_left2 = phys_address_left;
-        framebuffer.address_right2 = phys_address_right;
-    }
-
-    framebuffer.stride = info.stride;
-    framebuffer.format = info.format;
-    framebuffer.active_fb = info.shown_fb;
+    RunAsync([this, screen_id, info, phys_address_left, phys_address_right] {
+        // Update framebuffer properties.
+        auto& framebuffer = impl->pica.regs.framebuffer_config[screen_id];
+        if (info.active_fb == 0) {
+            framebuffer.address_left1 = phys_address_left;
+            framebuffer.address_right1 = phys_address_right;
+        } else {
+            framebuffer.address_left2 = phys_address_left;
+            framebuffer.address_right2 = phys_address_right;
+        }
 
-    // Notify debugger about the buffer swap.
-    if (impl->debug_context) {
-        impl->debug_context->OnEvent(Pica::DebugContext::Event::BufferSwapped, nullptr);
-    }
+        framebuffer.stride = info.stride;
+        framebuffer.format = info.format;
+        framebuffer.active_fb = info.shown_fb;
+
+        // Notify debugger about the buffer swap.
+        if (impl->debug_context) {
+            impl->debug_context->OnEvent(Pica::DebugContext::Event::BufferSwapped, nullptr);
+            constexpr u32 framebuffer_words = sizeof(framebuffer) / sizeof(u32);
+            RecordRegs(GPU_REG_INDEX(framebuffer_config) + screen_id * framebuffer_words,
+                       framebuffer_words);
+            if (screen_id == 0 && impl->debug_context->recorder) {
+                impl->debug_context->recorder->FrameFinished();
+            }
+        }
 
-    if (screen_id == 0) {
-        MicroProfileFlip();
-        impl->system.perf_stats->EndGameFrame();
-        right_eye_disabler->ReportEndFrame();
-    }
+        if (screen_id == 0) {
+            MicroProfileFlip();
+            Common::MicroProfileTraceFlip();
+            impl->system.perf_stats->EndGameFrame();
+            right_eye_disabler->ReportEndFrame();
+        }
+    });
 }
 
 void GPU::SetColorFill(const Pica::ColorFill& fill) {
-    impl->pica.regs_lcd.color_fill_top = fill;
-    impl->pica.regs_lcd.color_fill_bottom = fill;
+    RunAsync([this, fill] {
+        impl->pica.regs_lcd.color_fill_top = fill;
+        impl->pica.regs_lcd.color_fill_bottom = fill;
+    });
 }
 
 u32 GPU::ReadReg(VAddr addr) {
+    // Registers are only read once the GPU has caught up with the writes before them.
+    Synchronize();
+
     switch (addr & 0xFFFFF000) {
     case VADDR_LCD: {
         const u32 offset = addr - VADDR_LCD;
@@ -233,6 +355,7 @@ u32 GPU::ReadReg(VAddr addr) {
     }
     case VADDR_GPU:
     case VADDR_GPU + 0x1000: {
+        impl->system.Memory().FlushPendingRasterizerInvalidations();
         const u32 offset = addr - VADDR_GPU;
         const u32 index = offset / sizeof(u32);
         ASSERT(addr % sizeof(u32) == 0);
@@ -245,6 +368,23 @@ u32 GPU::ReadReg(VAddr addr) {
 }
 
 void GPU::WriteReg(VAddr addr, u32 data) {
+    // Writes can trigger memory fills, display transfers and command lists, which must not use
+    // surfaces the CPU has invalidated since.
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+    RunAsync([this, addr, data] { WriteRegImpl(addr, data); });
+}
+
+void GPU::Synchronize() {
+    if (impl->gpu_thread) {
+        impl->gpu_thread->WaitIdle();
+    }
+}
+
+void GPU::SwitchShaderDiskCache(u64 title_id) {
+    RunSync([this, title_id] { impl->pica.SwitchShaderDiskCache(title_id); });
+}
+
+void GPU::WriteRegImpl(VAddr addr, u32 data) {
     switch (addr & 0xFFFFF000) {
     case VADDR_LCD: {
         const u32 offset = addr - VADDR_LCD;
@@ -263,6 +403,12 @@ void GPU::WriteReg(VAddr addr, u32 data) {
         ASSERT(index < Pica::PicaCore::Regs::NUM_REGS);
         impl->pica.regs.reg_array[index] = data;
 
+        // Command lists are recorded as the register writes they are made of.
+        if (index != GPU_REG_INDEX(internal.pipeline.command_buffer.trigger[0]) &&
+            index != GPU_REG_INDEX(internal.pipeline.command_buffer.trigger[1])) {
+            RecordRegs(index, 1);
+        }
+
         // Handle registers that trigger GPU actions
         switch (index) {
         case GPU_REG_INDEX(memory_fill_config[0].trigger):
@@ -327,7 +473,7 @@ void GPU::ReportLoadingProgramID(u64 program_ID) {
             break;
         }
     }
-    impl->rasterizer->SetAccurateMul(use_accurate_mul);
+    RunAsync([this, use_accurate_mul] { impl->rasterizer->SetAccurateMul(use_accurate_mul); });
 }
 
 void GPU::SubmitCmdList(u32 index) {
@@ -347,6 +493,32 @@ void GPU::SubmitCmdList(u32 index) {
     config.trigger[index] = 0;
 }
 
+void GPU::RecordRegs(u32 index, u32 count, u32 trigger) {
+    if (!impl->debug_context || !impl->debug_context->recorder) {
+        return;
+    }
+    const auto record = [this](u32 i) {
+        impl->debug_context->recorder->RegisterWritten(
+            CiTrace::GPURegistersBase + i * static_cast<u32>(sizeof(u32)),
+            impl->pica.regs.reg_array[i]);
+    };
+    for (u32 i = index; i < index + count; i++) {
+        if (i != trigger) {
+            record(i);
+        }
+    }
+    // The trigger is written last so that the replayed operation sees the whole configuration.
+    if (trigger >= index && trigger < index + count) {
+        record(trigger);
+    }
+}
+
+void GPU::ReportTransfer(bool accelerated) {
+    if (impl->system.perf_stats) {
+        impl->system.perf_stats->ReportGPUTransfer(accelerated);
+    }
+}
+
 void GPU::MemoryFill(u32 index) {
     // Check if a memory fill was triggered.
     auto& config = impl->pica.regs.memory_fill_config[index];
@@ -355,17 +527,19 @@ void GPU::MemoryFill(u32 index) {
     }
 
     // Perform memory fill.
-    if (!impl->rasterizer->AccelerateFill(config)) {
+    const bool accelerated = impl->rasterizer->AccelerateFill(config);
+    if (!accelerated) {
         impl->sw_blitter->MemoryFill(config);
     }
+    ReportTransfer(accelerated);
 
     // It seems that it won't signal interrupt if "address_start" is zero.
     // TODO: hwtest this
     if (config.GetStartAddress() != 0) {
         if (!index) {
-            impl->signal_interrupt(Service::GSP::InterruptId::PSC0);
+            impl->gpu_interrupt(Service::GSP::InterruptId::PSC0);
         } else {
-            impl->signal_interrupt(Service::GSP::InterruptId::PSC1);
+            impl->gpu_interrupt(Service::GSP::InterruptId::PSC1);
         }
     }
 
@@ -391,37 +565,60 @@ void GPU::MemoryTransfer() {
 
     // Perform memory transfer
     if (config.is_texture_copy) {
-        if (!impl->rasterizer->AccelerateTextureCopy(config)) {
+        const bool accelerated = impl->rasterizer->AccelerateTextureCopy(config);
+        if (!accelerated) {
             impl->sw_blitter->TextureCopy(config);
         }
+        ReportTransfer(accelerated);
     } else {
+        right_eye_disabler->ReportDisplayTransfer(config.GetPhysicalInputAddress(),
+                                                  config.GetPhysicalOutputAddress());
         if (right_eye_disabler->ShouldAllowDisplayTransfer(config.GetPhysicalInputAddress(),
                                                            config.input_height)) {
-            if (!impl->rasterizer->AccelerateDisplayTransfer(config)) {
+            const bool accelerated = impl->rasterizer->AccelerateDisplayTransfer(config);
+            if (!accelerated) {
                 impl->sw_blitter->DisplayTransfer(config);
             }
+            ReportTransfer(accelerated);
         }
     }
 
     // Complete transfer.
     config.trigger.Assign(0);
-    impl->signal_interrupt(Service::GSP::InterruptId::PPF);
+    impl->gpu_interrupt(Service::GSP::InterruptId::PPF);
 }
 
 void GPU::VBlankCallback(std::uintptr_t user_data, s64 cycles_late) {
-    // Present renderered frame.
-    impl->renderer->SwapBuffers();
+    impl->system.Memory().FlushPendingRasterizerInvalidations();
+
+    if (Settings::values.input_late_latch.GetValue()) {
+        if (const auto hid = Service::HID::GetModule(impl->system)) {
+            hid->LatchPadState();
+        }
+    }
+
+    // Present renderered frame. At most one frame is left for the GPU thread to finish, so that
+    // emulation never runs ahead of presentation.
+    if (impl->gpu_thread) {
+        impl->gpu_thread->Wait(impl->swap_fence);
+        impl->swap_fence = impl->gpu_thread->Push([this] { impl->renderer->SwapBuffers(); });
+    } else {
+        impl->renderer->SwapBuffers();
+    }
 
     // Signal to GSP that GPU interrupt has occurred
     impl->signal_interrupt(Service::GSP::InterruptId::PDC0);
     impl->signal_interrupt(Service::GSP::InterruptId::PDC1);
 
+    impl->system.CountMovieCheckpointFrame();
+
     // Reschedule recurrent event
     impl->timing.ScheduleEvent(FRAME_TICKS - cycles_late, impl->vblank_event);
 }
 
 template <class Archive>
 void GPU::serialize(Archive& ar, const u32 file_version) {
+    Synchronize();
     ar & impl->pica;
 }
 
@@ -5,7 +5,10 @@
 #pragma once
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <span>
+#include <vector>
 #include <boost/serialization/access.hpp>
 
 #include "core/hle/service/gsp/gsp_interrupt.h"
@@ -38,6 +41,7 @@ constexpr u64 FRAME_TICKS = 4481136ull;
 class GraphicsDebugger;
 class RendererBase;
 class RightEyeDisabler;
+struct SurfaceDescriptor;
 
 /**
  * The GPU class is the high level interface to the video_core for core services.
@@ -57,11 +61,20 @@ public:
     /// Notify rasterizer that any caches of the specified region should be invalidated
     void InvalidateRegion(PAddr addr, u32 size);
 
+    /// Notify rasterizer that any caches of the specified region should be flushed and invalidated
+    void FlushAndInvalidateRegion(PAddr addr, u32 size);
+
     /// Flushes and invalidates all memory in the rasterizer cache and removes any leftover state.
     void ClearAll(bool flush);
 
-    /// Executes the provided GSP command.
-    void Execute(const Service::GSP::Command& command);
+    /// Describes up to max_count surfaces of the rasterizer cache, most recently used first.
+    std::vector<VideoCore::SurfaceDescriptor> GetSurfaceDescriptors(std::size_t max_count);
+
+    /// Recreates the described surfaces in the rasterizer cache from emulated memory.
+    void PrewarmSurfaces(std::span<const VideoCore::SurfaceDescriptor> surfaces);
+
+    /// Executes the provided GSP commands in order.
+    void Execute(std::span<const Service::GSP::Command> commands);
 
     /// Updates GPU display framebuffer configuration using the specified parameters.
     void SetBufferSwap(u32 screen_id, const Service::GSP::FrameBufferInfo& info);
@@ -75,6 +88,12 @@ public:
     /// Writes the provided value to the GPU virtual address.
     void WriteReg(VAddr addr, u32 data);
 
+    /// Blocks until the GPU thread, when enabled, has completed all submitted work.
+    void Synchronize();
+
+    /// Prepares the CPU shader programs the provided title has used in previous sessions.
+    void SwitchShaderDiskCache(u64 title_id);
+
     /// Returns a mutable reference to the renderer.
     [[nodiscard]] VideoCore::RendererBase& Renderer();
 
@@ -97,8 +116,27 @@ public:
     void ReportLoadingProgramID(u64 program_ID);
 
 private:
+    /// Runs the work on the GPU thread when it is enabled, otherwise right away.
+    template <typename Func>
+    void RunAsync(Func&& func);
+
+    /// Same as RunAsync, but also waits for the work to complete.
+    template <typename Func>
+    void RunSync(Func&& func);
+
+    void ExecuteCommand(const Service::GSP::Command& command);
+
+    void WriteRegImpl(VAddr addr, u32 data);
+
     void SubmitCmdList(u32 index);
 
+    /// Stores the values of the provided GPU registers in the trace being recorded, the trigger
+    /// register of the range, if any, is stored last.
+    void RecordRegs(u32 index, u32 count, u32 trigger = std::numeric_limits<u32>::max());
+
+    /// Counts a transfer or fill in the perf stats, along with whether the rasterizer did it.
+    void ReportTransfer(bool accelerated);
+
     void MemoryFill(u32 index);
 
     void MemoryTransfer();
@@ -15,6 +15,7 @@
 #include "video_core/gpu.h"
 #include "video_core/gpu_debugger.h"
 #include "video_core/gpu_impl.h"
+#include "video_core/gpu_thread.h"
 #include "video_core/pica/pica_core.h"
 #include "video_core/pica/regs_lcd.h"
 #include "video_core/renderer_base.h"
@@ -34,7 +35,13 @@ struct GPU::Impl {
     RasterizerInterface* rasterizer;
     std::unique_ptr<SwRenderer::SwBlitter> sw_blitter;
     Core::TimingEventType* vblank_event;
+    Core::TimingEventType* interrupt_event;
     Service::GSP::InterruptHandler signal_interrupt;
+    // Signals the interrupts raised by work that may run on the GPU thread.
+    Service::GSP::InterruptHandler gpu_interrupt;
+    u64 swap_fence{};
+    // Declared last so that the thread is stopped before the state its work uses is destroyed.
+    std::unique_ptr<GPUThread> gpu_thread;
 
     explicit Impl(Core::System& system, Frontend::EmuWindow& emu_window,
                   Frontend::EmuWindow* secondary_window)
@@ -0,0 +1,55 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "video_core/gpu_thread.h"
+
+MICROPROFILE_DEFINE(GPU_WaitForThread, "GPU", "Wait for GPU thread", MP_RGB(255, 100, 100));
+
+namespace VideoCore {
+
+GPUThread::GPUThread() {
+    thread = std::jthread([this](std::stop_token stop_token) { ThreadLoop(stop_token); });
+}
+
+GPUThread::~GPUThread() = default;
+
+u64 GPUThread::Push(Work&& work) {
+    queue.Push(std::move(work));
+    return submitted_fence.fetch_add(1, std::memory_order::relaxed) + 1;
+}
+
+void GPUThread::Wait(u64 fence) {
+    // The GPU thread can not wait for itself, and everything before it has already completed.
+    if (IsGPUThread() || signaled_fence.load(std::memory_order::acquire) >= fence) {
+        return;
+    }
+
+    MICROPROFILE_SCOPE(GPU_WaitForThread);
+    std::unique_lock lock{fence_mutex};
+    fence_cv.wait(lock, [this, fence] {
+        return signaled_fence.load(std::memory_order::acquire) >= fence;
+    });
+}
+
+void GPUThread::ThreadLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("GPU");
+
+    while (!stop_token.stop_requested()) {
+        Work work = queue.PopWait(stop_token);
+        if (!work) {
+            break;
+        }
+        work();
+
+        {
+            std::scoped_lock lock{fence_mutex};
+            signaled_fence.fetch_add(1, std::memory_order::release);
+        }
+        fence_cv.notify_all();
+    }
+}
+
+} // namespace VideoCore
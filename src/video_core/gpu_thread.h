@@ -0,0 +1,58 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "common/threadsafe_queue.h"
+#include "common/unique_function.h"
+
+namespace VideoCore {
+
+/**
+ * Dedicated thread that runs the PICA front end, the transfer engine and presentation in the
+ * order the emulation thread submitted them in. Work is handed over through a single producer
+ * queue, so it must only be pushed from the emulation thread. Every piece of work is assigned a
+ * fence, which the emulation thread can wait on before it touches GPU state itself.
+ */
+class GPUThread {
+public:
+    using Work = Common::UniqueFunction<void>;
+
+    GPUThread();
+    ~GPUThread();
+
+    /// Queues work to run on the GPU thread and returns the fence that signals its completion.
+    u64 Push(Work&& work);
+
+    /// Blocks until the work of the provided fence has completed.
+    void Wait(u64 fence);
+
+    /// Blocks until all queued work has completed.
+    void WaitIdle() {
+        Wait(submitted_fence.load(std::memory_order::relaxed));
+    }
+
+    /// Returns true when called from the GPU thread itself.
+    [[nodiscard]] bool IsGPUThread() const {
+        return std::this_thread::get_id() == thread.get_id();
+    }
+
+private:
+    void ThreadLoop(std::stop_token stop_token);
+
+    Common::SPSCQueue<Work, true> queue;
+    std::atomic<u64> submitted_fence{};
+    std::atomic<u64> signaled_fence{};
+    std::mutex fence_mutex;
+    std::condition_variable fence_cv;
+    std::jthread thread;
+};
+
+} // namespace VideoCore
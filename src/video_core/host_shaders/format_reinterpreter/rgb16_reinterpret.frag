@@ -0,0 +1,57 @@
+// Copyright 2023 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+//? #version 430 core
+
+precision highp int;
+precision highp float;
+
+layout(location = 0) in mediump vec2 tex_coord;
+layout(location = 0) out lowp vec4 frag_color;
+
+layout(binding = 0) uniform lowp sampler2D source;
+
+// Values of VideoCore::PixelFormat
+layout(location = 2) uniform int src_format;
+layout(location = 3) uniform int dst_format;
+
+const int RGB5A1 = 2;
+const int RGB565 = 3;
+
+// Bits of the red, green, blue and alpha components of a 16-bit color format
+ivec4 ComponentWidths(int format) {
+    if (format == RGB5A1) {
+        return ivec4(5, 5, 5, 1);
+    } else if (format == RGB565) {
+        return ivec4(5, 6, 5, 0);
+    }
+    return ivec4(4, 4, 4, 4);
+}
+
+// Position of the lowest bit of each component, alpha takes the low bits
+ivec4 ComponentShifts(ivec4 widths) {
+    return ivec4(widths.a + widths.b + widths.g, widths.a + widths.b, widths.a, 0);
+}
+
+void main() {
+    mediump vec2 coord = tex_coord * vec2(textureSize(source, 0));
+    mediump ivec2 tex_icoord = ivec2(coord);
+
+    ivec4 src_widths = ComponentWidths(src_format);
+    ivec4 src_max = (ivec4(1) << src_widths) - 1;
+    ivec4 src_bits = ivec4(round(texelFetch(source, tex_icoord, 0) * vec4(src_max)));
+    ivec4 src_shifts = ComponentShifts(src_widths);
+    int raw = 0;
+    for (int i = 0; i < 4; i++) {
+        raw |= src_bits[i] << src_shifts[i];
+    }
+
+    ivec4 dst_widths = ComponentWidths(dst_format);
+    ivec4 dst_max = (ivec4(1) << dst_widths) - 1;
+    ivec4 dst_bits = (ivec4(raw) >> ComponentShifts(dst_widths)) & dst_max;
+    frag_color = vec4(dst_bits) / vec4(max(dst_max, ivec4(1)));
+    if (dst_widths.a == 0) {
+        frag_color.a = 1.0;
+    }
+}
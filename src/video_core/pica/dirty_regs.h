@@ -20,6 +20,38 @@ union DirtyRegs {
         qwords.fill(0ULL);
     }
 
+    void SetAll() {
+        qwords.fill(~0ULL);
+    }
+
+    bool CheckRasterState() const {
+        // Checks if GPUREG_FACECULLING_CONFIG, GPUREG_FRAGOP_CLIP or GPUREG_FRAMEBUFFER_DIM are
+        // dirty. The last one holds the flip bit.
+        static constexpr u64 RasterizerMask = M(rasterizer.cull_mode) | M(rasterizer.clip_enable);
+        static constexpr u64 FramebufferMask = M(framebuffer.framebuffer.width);
+        return (rasterizer & RasterizerMask) || (framebuffer & FramebufferMask);
+    }
+
+    bool CheckBlendState() const {
+        // Checks if GPUREG_COLOR_OPERATION, GPUREG_BLEND_FUNC, GPUREG_LOGIC_OP,
+        // GPUREG_BLEND_COLOR, GPUREG_DEPTH_COLOR_MASK or GPUREG_COLORBUFFER_WRITE are dirty
+        static constexpr u64 BlendStateMask = M_R(framebuffer.output_merger, 4) |
+                                              M(framebuffer.output_merger.depth_color_mask) |
+                                              M(framebuffer.framebuffer.allow_color_write);
+        return framebuffer & BlendStateMask;
+    }
+
+    bool CheckDepthStencilState() const {
+        // Checks if GPUREG_STENCIL_TEST, GPUREG_STENCIL_OP, GPUREG_DEPTH_COLOR_MASK,
+        // GPUREG_DEPTHBUFFER_WRITE or GPUREG_DEPTHBUFFER_FORMAT are dirty
+        static constexpr u64 DepthStencilMask =
+            M_R(framebuffer.output_merger.stencil_test, 2) |
+            M(framebuffer.output_merger.depth_color_mask) |
+            M(framebuffer.framebuffer.allow_depth_stencil_write) |
+            M(framebuffer.framebuffer.depth_format);
+        return framebuffer & DepthStencilMask;
+    }
+
     bool CheckClipping() const {
         // Checks if GPUREG_FRAGOP_CLIP or GPUREG_FRAGOP_CLIP_DATAi are dirty
         static constexpr u64 ClipMask = M_R(rasterizer.clip_enable, 5);
@@ -2,13 +2,19 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
 #include "common/arch.h"
 #include "common/archives.h"
+#include "common/math_util.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/memory.h"
+#include "core/tracer/recorder.h"
 #include "video_core/debug_utils/debug_utils.h"
 #include "video_core/pica/pica_core.h"
 #include "video_core/pica/vertex_loader.h"
@@ -30,6 +36,9 @@ union CommandHeader {
 };
 static_assert(sizeof(CommandHeader) == sizeof(u32), "CommandHeader has incorrect size!");
 
+// Draws with at least this many vertices have their vertex shader run on worker threads.
+constexpr u32 MIN_PARALLEL_VERTICES = 1024;
+
 PicaCore::PicaCore(Memory::MemorySystem& memory_, std::shared_ptr<DebugContext> debug_context_)
     : memory{memory_}, debug_context{std::move(debug_context_)},
       geometry_pipeline{regs.internal, gs_unit, gs_setup},
@@ -53,6 +62,10 @@ PicaCore::PicaCore(Memory::MemorySystem& memory_, std::shared_ptr<DebugContext>
 
 PicaCore::~PicaCore() = default;
 
+void PicaCore::SwitchShaderDiskCache(u64 title_id) {
+    shader_engine->SwitchDiskCache(title_id);
+}
+
 void PicaCore::InitializeRegs() {
     auto& framebuffer_top = regs.framebuffer_config[0];
     auto& framebuffer_sub = regs.framebuffer_config[1];
@@ -113,6 +126,16 @@ void PicaCore::ProcessCmdList(PAddr list, u32 size, bool ignore_list) {
         // Write to the requested PICA register.
         WriteInternalReg(header.cmd_id, value, header.parameter_mask);
 
+        // Shader uploads stream hundreds of words into one register, those are written in bulk
+        // when nothing observes the individual writes.
+        const std::span<const u32> extra_data{cmd_list.head + cmd_list.current_index,
+                                              header.extra_data_length.Value()};
+        if (!header.group_commands && header.parameter_mask == 0xF && !debug_context &&
+            !DebugUtils::IsPicaTracing() && WriteShaderWords(header.cmd_id, extra_data)) {
+            cmd_list.current_index += header.extra_data_length;
+            continue;
+        }
+
         // Write any extra paramters as well.
         for (u32 i = 0; i < header.extra_data_length; ++i) {
             const u32 cmd = header.cmd_id + (header.group_commands ? i + 1 : 0);
@@ -120,6 +143,58 @@ void PicaCore::ProcessCmdList(PAddr list, u32 size, bool ignore_list) {
             WriteInternalReg(cmd, extra_value, header.parameter_mask);
         }
     }
+
+    FlushImmediate();
+}
+
+bool PicaCore::WriteShaderWords(u32 id, std::span<const u32> words) {
+    if (words.empty()) {
+        return false;
+    }
+    const auto is_port = [id](u32 first_index) { return id - first_index < 8; };
+    const bool gs_shared = !regs.internal.pipeline.gs_unit_exclusive_configuration;
+
+    // Writes the words from the offset on, the ones past the end of the memory are dropped.
+    const auto upload = [&](u32& offset, std::size_t size, const char* name, auto&& write) {
+        const std::size_t count = offset < size ? std::min(words.size(), size - offset) : 0;
+        for (std::size_t i = 0; i < count; i++) {
+            write(static_cast<u32>(offset + i), words[i]);
+        }
+        offset += static_cast<u32>(count);
+        if (count < words.size()) {
+            LOG_ERROR(HW_GPU, "Invalid {} offset {}", name, offset);
+        }
+    };
+
+    if (is_port(PICA_REG_INDEX(vs.program.set_word[0]))) {
+        upload(regs.internal.vs.program.offset, 512, "VS program", [&](u32 offset, u32 value) {
+            vs_setup.WriteProgramCode(offset, value);
+            if (gs_shared) {
+                gs_setup.WriteProgramCode(offset, value);
+            }
+        });
+    } else if (is_port(PICA_REG_INDEX(vs.swizzle_patterns.set_word[0]))) {
+        upload(regs.internal.vs.swizzle_patterns.offset, vs_setup.swizzle_data.size(),
+               "VS swizzle pattern", [&](u32 offset, u32 value) {
+                   vs_setup.WriteSwizzleData(offset, value);
+                   if (gs_shared) {
+                       gs_setup.WriteSwizzleData(offset, value);
+                   }
+               });
+    } else if (is_port(PICA_REG_INDEX(gs.program.set_word[0]))) {
+        upload(regs.internal.gs.program.offset, 4096, "GS program",
+               [&](u32 offset, u32 value) { gs_setup.WriteProgramCode(offset, value); });
+    } else if (is_port(PICA_REG_INDEX(gs.swizzle_patterns.set_word[0]))) {
+        upload(regs.internal.gs.swizzle_patterns.offset, gs_setup.swizzle_data.size(),
+               "GS swizzle pattern",
+               [&](u32 offset, u32 value) { gs_setup.WriteSwizzleData(offset, value); });
+    } else {
+        return false;
+    }
+
+    regs.internal.reg_array[id] = words.back();
+    dirty_regs.Set(id);
+    return true;
 }
 
 void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
@@ -131,6 +206,12 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
         return;
     }
 
+    // Any write other than another immediate vertex ends the batch of immediate triangles.
+    if (immediate.batch_pending &&
+        id - PICA_REG_INDEX(pipeline.vs_default_attributes_setup.set_value[0]) >= 3) {
+        FlushImmediate();
+    }
+
     // Expand a 4-bit mask to 4-byte mask, e.g. 0b0101 -> 0x00FF00FF
     constexpr std::array<u32, 16> ExpandBitsToBytes = {
         0x00000000, 0x000000ff, 0x0000ff00, 0x0000ffff, 0x00ff0000, 0x00ff00ff,
@@ -142,6 +223,7 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
     const u32 old_value = regs.internal.reg_array[id];
     const u32 write_mask = ExpandBitsToBytes[mask];
     regs.internal.reg_array[id] = (old_value & ~write_mask) | (value & write_mask);
+    const u32 new_value = regs.internal.reg_array[id];
 
     // Track register write.
     DebugUtils::OnPicaRegWrite(id, mask, regs.internal.reg_array[id]);
@@ -235,8 +317,7 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
         if (offset >= 4096) {
             LOG_ERROR(HW_GPU, "Invalid GS program offset {}", offset);
         } else {
-            gs_setup.program_code[offset] = value;
-            gs_setup.MarkProgramCodeDirty();
+            gs_setup.WriteProgramCode(offset, value);
             offset++;
         }
         break;
@@ -254,8 +335,7 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
         if (offset >= gs_setup.swizzle_data.size()) {
             LOG_ERROR(HW_GPU, "Invalid GS swizzle pattern offset {}", offset);
         } else {
-            gs_setup.swizzle_data[offset] = value;
-            gs_setup.MarkSwizzleDataDirty();
+            gs_setup.WriteSwizzleData(offset, value);
             offset++;
         }
         break;
@@ -317,11 +397,9 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
         if (offset >= 512) {
             LOG_ERROR(HW_GPU, "Invalid VS program offset {}", offset);
         } else {
-            vs_setup.program_code[offset] = value;
-            vs_setup.MarkProgramCodeDirty();
+            vs_setup.WriteProgramCode(offset, value);
             if (!regs.internal.pipeline.gs_unit_exclusive_configuration) {
-                gs_setup.program_code[offset] = value;
-                gs_setup.MarkProgramCodeDirty();
+                gs_setup.WriteProgramCode(offset, value);
             }
             offset++;
         }
@@ -340,11 +418,9 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
         if (offset >= vs_setup.swizzle_data.size()) {
             LOG_ERROR(HW_GPU, "Invalid VS swizzle pattern offset {}", offset);
         } else {
-            vs_setup.swizzle_data[offset] = value;
-            vs_setup.MarkSwizzleDataDirty();
+            vs_setup.WriteSwizzleData(offset, value);
             if (!regs.internal.pipeline.gs_unit_exclusive_configuration) {
-                gs_setup.swizzle_data[offset] = value;
-                gs_setup.MarkSwizzleDataDirty();
+                gs_setup.WriteSwizzleData(offset, value);
             }
             offset++;
         }
@@ -425,6 +501,17 @@ void PicaCore::WriteInternalReg(u32 id, u32 value, u32 mask) {
 
     dirty_regs.Set(id);
 
+    // The write is recorded after its side effects, so a draw finds the memory it read already
+    // loaded on replay. Command list jumps and interrupts have nothing to act on in a replay.
+    if (debug_context && debug_context->recorder &&
+        id != PICA_REG_INDEX(pipeline.command_buffer.trigger[0]) &&
+        id != PICA_REG_INDEX(pipeline.command_buffer.trigger[1]) &&
+        id != PICA_REG_INDEX(trigger_irq)) {
+        const u32 index = static_cast<u32>(GPU_REG_INDEX(internal) + id);
+        debug_context->recorder->RegisterWritten(
+            CiTrace::GPURegistersBase + index * static_cast<u32>(sizeof(u32)), new_value);
+    }
+
     if (debug_context) {
         debug_context->OnEvent(DebugContext::Event::PicaCommandProcessed, &id);
     }
@@ -464,8 +551,25 @@ void PicaCore::SubmitImmediate(u32 value) {
 }
 
 void PicaCore::DrawImmediate() {
-    // Compile the vertex shader.
-    shader_engine->SetupBatch(vs_setup, regs.internal.vs.main_offset);
+    // The shaders and the geometry pipeline only change with register writes, which flush the
+    // batch, so they are set up once for all of its vertices.
+    if (!immediate.batch_pending) {
+        // Compile the vertex shader.
+        shader_engine->SetupBatch(vs_setup, regs.internal.vs.main_offset);
+
+        // Reconfigure geometry pipeline if needed.
+        if (immediate.reset_geometry_pipeline) {
+            geometry_pipeline.Reconfigure();
+            immediate.reset_geometry_pipeline = false;
+        }
+        ASSERT(!geometry_pipeline.NeedIndexInput());
+        geometry_pipeline.Setup(shader_engine.get());
+
+        if (debug_context && debug_context->recorder) {
+            RecordTextureMemory();
+        }
+        immediate.batch_pending = true;
+    }
 
     // Track vertex in the debug recorder.
     if (debug_context) {
@@ -481,21 +585,26 @@ void PicaCore::DrawImmediate() {
     shader_engine->Run(vs_setup, shader_unit);
     shader_unit.WriteOutput(regs.internal.vs, output);
 
-    // Reconfigure geometry pipeline if needed.
-    if (immediate.reset_geometry_pipeline) {
-        geometry_pipeline.Reconfigure();
-        immediate.reset_geometry_pipeline = false;
-    }
-
     // Send to geometry pipeline.
-    ASSERT(!geometry_pipeline.NeedIndexInput());
-    geometry_pipeline.Setup(shader_engine.get());
     geometry_pipeline.SubmitVertex(output);
 
-    // Flush the immediate triangle.
-    rasterizer->DrawTriangles();
     immediate.current_attribute = 0;
 
+    // The debugger steps through immediate draws one vertex at a time.
+    if (debug_context) {
+        FlushImmediate();
+    }
+}
+
+void PicaCore::FlushImmediate() {
+    if (!immediate.batch_pending) {
+        return;
+    }
+    immediate.batch_pending = false;
+
+    // Draw the triangles assembled from the vertices of the batch.
+    rasterizer->DrawTriangles();
+
     if (debug_context) {
         debug_context->OnEvent(DebugContext::Event::FinishedPrimitiveBatch, nullptr);
     }
@@ -507,6 +616,10 @@ void PicaCore::DrawArrays(bool is_indexed) {
     // Track vertex in the debug recorder.
     if (debug_context) {
         debug_context->OnEvent(DebugContext::Event::IncomingPrimitiveBatch, nullptr);
+        if (debug_context->recorder) {
+            RecordVertexMemory(is_indexed);
+            RecordTextureMemory();
+        }
     }
 
     const bool accelerate_draw = [this] {
@@ -547,6 +660,78 @@ void PicaCore::DrawArrays(bool is_indexed) {
     }
 }
 
+void PicaCore::RecordVertexMemory(bool is_indexed) {
+    const auto& pipeline = regs.internal.pipeline;
+    const PAddr base_address = pipeline.vertex_attributes.GetPhysicalBaseAddress();
+    const auto record = [&](PAddr address, u32 size) {
+        if (const u8* data = memory.GetPhysicalPointer(address); data && size != 0) {
+            debug_context->recorder->MemoryAccessed(data, size, address);
+        }
+    };
+
+    u32 vertex_min = pipeline.vertex_offset;
+    u32 vertex_max = pipeline.vertex_offset + pipeline.num_vertices - 1;
+    if (is_indexed) {
+        const auto& index_info = pipeline.index_array;
+        const PAddr address = base_address + index_info.offset;
+        const u8* index_data = memory.GetPhysicalPointer(address);
+        if (!index_data || pipeline.num_vertices == 0) {
+            return;
+        }
+        const bool index_u16 = index_info.format != 0;
+        if (index_u16) {
+            const auto res = Common::FindMinMax(
+                {reinterpret_cast<const u16*>(index_data), pipeline.num_vertices});
+            vertex_min = res.first;
+            vertex_max = res.second;
+        } else {
+            const auto res = Common::FindMinMax({index_data, pipeline.num_vertices});
+            vertex_min = res.first;
+            vertex_max = res.second;
+        }
+        record(address, pipeline.num_vertices * (index_u16 ? 2 : 1));
+    }
+
+    for (const auto& loader : pipeline.vertex_attributes.attribute_loaders) {
+        if (loader.component_count != 0) {
+            record(base_address + loader.data_offset + vertex_min * loader.byte_count,
+                   (vertex_max - vertex_min + 1) * loader.byte_count);
+        }
+    }
+}
+
+void PicaCore::RecordTextureMemory() {
+    const auto& texturing = regs.internal.texturing;
+    const auto record = [&](PAddr address, const TexturingRegs::FullTextureConfig& texture) {
+        u32 size = 0;
+        for (u32 level = 0; level <= texture.config.lod.max_level; level++) {
+            size += TexturingRegs::NibblesPerPixel(texture.format) *
+                    (texture.config.width >> level) * (texture.config.height >> level) / 2;
+        }
+        if (const u8* data = memory.GetPhysicalPointer(address); data && size != 0) {
+            debug_context->recorder->MemoryAccessed(data, size, address);
+        }
+    };
+
+    const auto textures = texturing.GetTextures();
+    for (std::size_t i = 0; i < textures.size(); i++) {
+        const auto& texture = textures[i];
+        if (!texture.enabled) {
+            continue;
+        }
+        const auto type = texture.config.type.Value();
+        if (i == 0 && (type == TexturingRegs::TextureConfig::TextureCube ||
+                       type == TexturingRegs::TextureConfig::ShadowCube)) {
+            for (u32 face = 0; face < 6; face++) {
+                record(texturing.GetCubePhysicalAddress(static_cast<TexturingRegs::CubeFace>(face)),
+                       texture);
+            }
+        } else {
+            record(texture.config.GetPhysicalAddress(), texture);
+        }
+    }
+}
+
 void PicaCore::LoadVertices(bool is_indexed) {
     // Read and validate vertex information from the loaders
     const auto& pipeline = regs.internal.pipeline;
@@ -560,16 +745,21 @@ void PicaCore::LoadVertices(bool is_indexed) {
     const u16* index_address_16 = reinterpret_cast<const u16*>(index_address_8);
     const bool index_u16 = index_info.format != 0;
 
-    // Simple circular-replacement vertex cache
-    const std::size_t VERTEX_CACHE_SIZE = 64;
-    std::array<bool, VERTEX_CACHE_SIZE> vertex_cache_valid{};
-    std::array<u16, VERTEX_CACHE_SIZE> vertex_cache_ids;
-    std::array<AttributeBuffer, VERTEX_CACHE_SIZE> vertex_cache;
-    u32 vertex_cache_pos = 0;
+    // Shaded vertices are only reused within a draw.
+    if (is_indexed) {
+        vertex_cache.Invalidate();
+    }
+
+    // Vertices are shaded in small batches, so the shader engine can run them back to back.
+    constexpr std::size_t VERTEX_BATCH_SIZE = 8;
+    std::array<ShaderUnit, VERTEX_BATCH_SIZE> batch_units;
+    std::array<AttributeBuffer, VERTEX_BATCH_SIZE> batch_outputs;
+    std::array<u32, VERTEX_BATCH_SIZE> batch_vertices;
+    std::array<bool, VERTEX_BATCH_SIZE> batch_shaded;
+    std::size_t batch_size = 0;
+    std::size_t num_shaded = 0;
 
     // Compile the vertex shader for this batch.
-    ShaderUnit shader_unit;
-    AttributeBuffer vs_output;
     shader_engine->SetupBatch(vs_setup, regs.internal.vs.main_offset);
 
     // Setup geometry pipeline in case we are using a geometry shader.
@@ -577,6 +767,59 @@ void PicaCore::LoadVertices(bool is_indexed) {
     geometry_pipeline.Setup(shader_engine.get());
     ASSERT(!geometry_pipeline.NeedIndexInput() || is_indexed);
 
+    // Large draws are shaded on worker threads, while the geometry pipeline is still fed on this
+    // thread in submission order. Each vertex referenced by the draw is shaded exactly once, which
+    // gives the same results as the vertex cache.
+    if (pipeline.num_vertices >= MIN_PARALLEL_VERTICES && !debug_context &&
+        !geometry_pipeline.NeedIndexInput()) {
+        std::vector<u32> vertices;
+        std::vector<u32> vertex_slots(pipeline.num_vertices);
+        if (is_indexed) {
+            constexpr u32 INVALID_SLOT = std::numeric_limits<u32>::max();
+            std::vector<u32> index_slots(index_u16 ? 0x10000 : 0x100, INVALID_SLOT);
+            for (u32 index = 0; index < pipeline.num_vertices; ++index) {
+                const u32 vertex = index_u16 ? index_address_16[index] : index_address_8[index];
+                if (index_slots[vertex] == INVALID_SLOT) {
+                    index_slots[vertex] = static_cast<u32>(vertices.size());
+                    vertices.push_back(vertex);
+                }
+                vertex_slots[index] = index_slots[vertex];
+            }
+        } else {
+            vertices.resize(pipeline.num_vertices);
+            std::iota(vertices.begin(), vertices.end(), pipeline.vertex_offset);
+            std::iota(vertex_slots.begin(), vertex_slots.end(), 0);
+        }
+
+        const u32 max_vertex = *std::max_element(vertices.begin(), vertices.end());
+        if (loader.CanLoadConcurrently(max_vertex)) {
+            ShadeVerticesParallel(loader, vertices, vertex_slots);
+            return;
+        }
+    }
+
+    const auto flush_batch = [&] {
+        shader_engine->RunBatch(vs_setup, std::span{batch_units.data(), num_shaded});
+
+        std::size_t unit = 0;
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            if (batch_shaded[i]) {
+                batch_units[unit++].WriteOutput(regs.internal.vs, batch_outputs[i]);
+
+                // Cache the vertex when doing indexed rendering.
+                if (is_indexed) {
+                    vertex_cache.Insert(batch_vertices[i], batch_outputs[i]);
+                }
+            }
+
+            // Send to geometry pipeline
+            geometry_pipeline.SubmitVertex(batch_outputs[i]);
+        }
+
+        batch_size = 0;
+        num_shaded = 0;
+    };
+
     for (u32 index = 0; index < pipeline.num_vertices; ++index) {
         // Indexed rendering doesn't use the start offset
         const u32 vertex = is_indexed
@@ -590,19 +833,16 @@ void PicaCore::LoadVertices(bool is_indexed) {
                 continue;
             }
 
-            for (u32 i = 0; i < VERTEX_CACHE_SIZE; ++i) {
-                if (vertex_cache_valid[i] && vertex == vertex_cache_ids[i]) {
-                    vs_output = vertex_cache[i];
-                    vertex_cache_hit = true;
-                    break;
-                }
+            if (const AttributeBuffer* cached = vertex_cache.Find(vertex)) {
+                batch_outputs[batch_size] = *cached;
+                vertex_cache_hit = true;
             }
         }
 
         if (!vertex_cache_hit) {
             // Initialize data for the current vertex
             AttributeBuffer input;
-            loader.LoadVertex(base_address, index, vertex, input, input_default_attributes);
+            loader.LoadVertex(vertex, input, input_default_attributes);
 
             // Record vertex processing to the debugger.
             if (debug_context) {
@@ -610,22 +850,49 @@ void PicaCore::LoadVertices(bool is_indexed) {
                                        std::addressof(input));
             }
 
-            // Invoke the vertex shader for this vertex.
-            shader_unit.LoadInput(regs.internal.vs, input);
-            shader_engine->Run(vs_setup, shader_unit);
-            shader_unit.WriteOutput(regs.internal.vs, vs_output);
-
-            // Cache the vertex when doing indexed rendering.
-            if (is_indexed) {
-                vertex_cache[vertex_cache_pos] = vs_output;
-                vertex_cache_valid[vertex_cache_pos] = true;
-                vertex_cache_ids[vertex_cache_pos] = vertex;
-                vertex_cache_pos = (vertex_cache_pos + 1) % VERTEX_CACHE_SIZE;
-            }
+            // Queue the vertex shader invocation for this vertex.
+            batch_units[num_shaded++].LoadInput(regs.internal.vs, input);
+        }
+
+        batch_vertices[batch_size] = vertex;
+        batch_shaded[batch_size] = !vertex_cache_hit;
+        if (++batch_size == VERTEX_BATCH_SIZE) {
+            flush_batch();
         }
+    }
+
+    flush_batch();
+}
 
-        // Send to geometry pipeline
-        geometry_pipeline.SubmitVertex(vs_output);
+void PicaCore::ShadeVerticesParallel(const VertexLoader& loader, std::span<const u32> vertices,
+                                     std::span<const u32> vertex_slots) {
+    if (!vertex_workers) {
+        const std::size_t num_workers =
+            std::clamp<std::size_t>(std::thread::hardware_concurrency(), 2, 8);
+        vertex_workers = std::make_unique<Common::ThreadWorker>(num_workers, "VertexShader");
+    }
+
+    std::vector<AttributeBuffer> outputs(vertices.size());
+    const std::size_t chunk_size = std::max<std::size_t>(
+        MIN_PARALLEL_VERTICES / 4,
+        (vertices.size() + vertex_workers->NumWorkers() - 1) / vertex_workers->NumWorkers());
+    for (std::size_t begin = 0; begin < vertices.size(); begin += chunk_size) {
+        const std::size_t end = std::min(begin + chunk_size, vertices.size());
+        vertex_workers->QueueWork([this, &loader, &outputs, vertices, begin, end] {
+            ShaderUnit shader_unit;
+            AttributeBuffer input;
+            for (std::size_t i = begin; i < end; ++i) {
+                loader.LoadVertex(vertices[i], input, input_default_attributes);
+                shader_unit.LoadInput(regs.internal.vs, input);
+                shader_engine->Run(vs_setup, shader_unit);
+                shader_unit.WriteOutput(regs.internal.vs, outputs[i]);
+            }
+        });
+    }
+    vertex_workers->WaitForRequests();
+
+    for (const u32 slot : vertex_slots) {
+        geometry_pipeline.SubmitVertex(outputs[slot]);
     }
 }
 
@@ -682,6 +949,16 @@ PicaCore::RenderPropertiesGuess PicaCore::GuessCmdRenderProperties(PAddr list, u
         if (process_write(header.cmd_id, value))
             break;
 
+        // Shader uploads stream hundreds of words into one register, those are written in bulk
+        // when nothing observes the individual writes.
+        const std::span<const u32> extra_data{cmd_list.head + cmd_list.current_index,
+                                              header.extra_data_length.Value()};
+        if (!header.group_commands && header.parameter_mask == 0xF && !debug_context &&
+            !DebugUtils::IsPicaTracing() && WriteShaderWords(header.cmd_id, extra_data)) {
+            cmd_list.current_index += header.extra_data_length;
+            continue;
+        }
+
         // Write any extra paramters as well.
         for (u32 i = 0; i < header.extra_data_length; ++i) {
             const u32 cmd = header.cmd_id + (header.group_commands ? i + 1 : 0);
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <limits>
+#include <span>
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 #include "core/hle/service/gsp/gsp_interrupt.h"
 #include "video_core/pica/dirty_regs.h"
 #include "video_core/pica/geometry_pipeline.h"
@@ -28,6 +31,7 @@ namespace Pica {
 
 class DebugContext;
 class ShaderEngine;
+class VertexLoader;
 
 class PicaCore {
 public:
@@ -40,19 +44,43 @@ public:
 
     void ProcessCmdList(PAddr list, u32 size, bool ignore_list);
 
+    /// Switches the shader engine to the programs recorded on disk for the provided title.
+    void SwitchShaderDiskCache(u64 title_id);
+
+    /// Writes an internal register the way a command list would, used to replay traces.
+    void WriteInternalReg(u32 id, u32 value, u32 mask);
+
 private:
     void InitializeRegs();
 
-    void WriteInternalReg(u32 id, u32 value, u32 mask);
+    /**
+     * Writes a run of words to a shader program or swizzle pattern upload register, skipping the
+     * per write bookkeeping of WriteInternalReg.
+     * @returns False if the register is not one of those, nothing was written then
+     */
+    bool WriteShaderWords(u32 id, std::span<const u32> words);
 
     void SubmitImmediate(u32 data);
 
     void DrawImmediate();
 
+    /// Draws the triangles of the pending immediate mode batch, if any.
+    void FlushImmediate();
+
     void DrawArrays(bool is_indexed);
 
     void LoadVertices(bool is_indexed);
 
+    /// Stores the vertex and index data the draw reads in the trace being recorded.
+    void RecordVertexMemory(bool is_indexed);
+
+    /// Stores the textures the draw samples in the trace being recorded.
+    void RecordTextureMemory();
+
+    /// Shades the provided vertices on the worker threads and submits them in slot order.
+    void ShadeVerticesParallel(const VertexLoader& loader, std::span<const u32> vertices,
+                               std::span<const u32> vertex_slots);
+
 public:
     union Regs {
         static constexpr std::size_t NUM_REGS = 0x732;
@@ -100,6 +128,8 @@ public:
         u32 current_attribute{};
         bool reset_geometry_pipeline{true};
         PackedAttribute queue;
+        /// Not serialized, command list processing flushes the batch before returning.
+        bool batch_pending{};
 
         void Reset() {
             current_attribute = 0;
@@ -285,6 +315,10 @@ private:
         ar & geometry_pipeline;
         ar & primitive_assembler;
         ar & cmd_list;
+        if (Archive::is_loading::value) {
+            // The rasterizer state has to be rebuilt from the loaded registers.
+            dirty_regs.SetAll();
+        }
     }
 
 public:
@@ -306,6 +340,35 @@ private:
     PrimitiveAssembler primitive_assembler;
     CommandList cmd_list;
     std::unique_ptr<ShaderEngine> shader_engine;
+    std::unique_ptr<Common::ThreadWorker> vertex_workers;
+
+    /**
+     * Direct mapped post-transform cache of indexed draws, keyed by the vertex index. It is much
+     * larger than the 64 entry cache of the hardware, so repeated indices are shaded less often.
+     * Vertex shaders have no side effects, so reusing an output is always safe.
+     */
+    struct VertexCache {
+        static constexpr std::size_t SIZE = 256;
+        static constexpr u32 INVALID_VERTEX = std::numeric_limits<u32>::max();
+
+        void Invalidate() {
+            vertices.fill(INVALID_VERTEX);
+        }
+
+        const AttributeBuffer* Find(u32 vertex) const {
+            const std::size_t slot = vertex % SIZE;
+            return vertices[slot] == vertex ? &outputs[slot] : nullptr;
+        }
+
+        void Insert(u32 vertex, const AttributeBuffer& output) {
+            const std::size_t slot = vertex % SIZE;
+            vertices[slot] = vertex;
+            outputs[slot] = output;
+        }
+
+        std::array<u32, SIZE> vertices;
+        std::array<AttributeBuffer, SIZE> outputs;
+    } vertex_cache;
 };
 
 #define GPU_REG_INDEX(field_name) (offsetof(Pica::PicaCore::Regs, field_name) / sizeof(u32))
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <optional>
+#include <utility>
 #include "common/vector_math.h"
 #include "video_core/pica/packed_attribute.h"
 #include "video_core/pica_types.h"
@@ -65,6 +66,17 @@ public:
 
     u64 GetSwizzleDataHash();
 
+    /// Writes a word of the program, the hash is only invalidated when the word changes, so
+    /// programs uploaded again unchanged every frame do not get hashed again.
+    void WriteProgramCode(u32 offset, u32 value) {
+        program_code_hash_dirty |= std::exchange(program_code[offset], value) != value;
+    }
+
+    /// Writes a word of the swizzle data, invalidating its hash when the word changes.
+    void WriteSwizzleData(u32 offset, u32 value) {
+        swizzle_data_hash_dirty |= std::exchange(swizzle_data[offset], value) != value;
+    }
+
     void MarkProgramCodeDirty() {
         program_code_hash_dirty = true;
     }
@@ -2,14 +2,100 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <bit>
+#include <cstring>
+#include <type_traits>
 #include "common/alignment.h"
+#include "common/arch.h"
 #include "common/logging/log.h"
 #include "video_core/pica/vertex_loader.h"
 
+#ifdef CITRA_HAS_SSE42
+#include <emmintrin.h>
+#include <smmintrin.h>
+#elif CITRA_ARCH(arm64)
+#include <arm_neon.h>
+#endif
+
 namespace Pica {
 
+namespace {
+
+/// Widens all four elements of an attribute into floats at once.
+template <typename T>
+void ConvertElements(const std::array<T, 4>& in, std::array<f32, 4>& out) {
+    if constexpr (std::is_same_v<T, f32>) {
+        out = in;
+    } else {
+#ifdef CITRA_HAS_SSE42
+        __m128i values;
+        if constexpr (std::is_same_v<T, s8>) {
+            values = _mm_cvtepi8_epi32(_mm_cvtsi32_si128(std::bit_cast<s32>(in)));
+        } else if constexpr (std::is_same_v<T, u8>) {
+            values = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(std::bit_cast<s32>(in)));
+        } else {
+            values =
+                _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in.data())));
+        }
+        _mm_storeu_ps(out.data(), _mm_cvtepi32_ps(values));
+#elif CITRA_ARCH(arm64)
+        if constexpr (std::is_same_v<T, s8>) {
+            const int8x8_t bytes = vreinterpret_s8_u32(vdup_n_u32(std::bit_cast<u32>(in)));
+            const int32x4_t values = vmovl_s16(vget_low_s16(vmovl_s8(bytes)));
+            vst1q_f32(out.data(), vcvtq_f32_s32(values));
+        } else if constexpr (std::is_same_v<T, u8>) {
+            const uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(std::bit_cast<u32>(in)));
+            const uint32x4_t values = vmovl_u16(vget_low_u16(vmovl_u8(bytes)));
+            vst1q_f32(out.data(), vcvtq_f32_u32(values));
+        } else {
+            vst1q_f32(out.data(), vcvtq_f32_s32(vmovl_s16(vld1_s16(in.data()))));
+        }
+#else
+        for (std::size_t i = 0; i < 4; ++i) {
+            out[i] = static_cast<f32>(in[i]);
+        }
+#endif
+    }
+}
+
+template <typename T, u32 NumElements>
+void LoadAttribute(const u8* data, Common::Vec4<f24>& out) {
+    // Missing elements are read as zero, only w gets a default value of one.
+    std::array<T, 4> elements{};
+    std::memcpy(elements.data(), data, NumElements * sizeof(T));
+
+    std::array<f32, 4> values;
+    ConvertElements(elements, values);
+    for (std::size_t i = 0; i < 4; ++i) {
+        out[i] = f24::FromFloat32(values[i]);
+    }
+
+    // Default attribute values set if array elements have < 4 components. This
+    // is *not* carried over from the default attribute settings even if they're
+    // enabled for this attribute.
+    if constexpr (NumElements < 4) {
+        out.w = f24::One();
+    }
+}
+
+template <typename T>
+constexpr std::array<VertexLoader::AttributeLoadFunc, 4> MakeAttributeLoaders() {
+    return {&LoadAttribute<T, 1>, &LoadAttribute<T, 2>, &LoadAttribute<T, 3>,
+            &LoadAttribute<T, 4>};
+}
+
+// Indexed by the attribute format and then by the number of elements minus one.
+constexpr std::array<std::array<VertexLoader::AttributeLoadFunc, 4>, 4> attribute_loaders = {
+    MakeAttributeLoaders<s8>(),
+    MakeAttributeLoaders<u8>(),
+    MakeAttributeLoaders<s16>(),
+    MakeAttributeLoaders<f32>(),
+};
+
+} // Anonymous namespace
+
 VertexLoader::VertexLoader(Memory::MemorySystem& memory_, const PipelineRegs& regs)
-    : memory{memory_} {
+    : memory{memory_}, base_address{regs.vertex_attributes.GetPhysicalBaseAddress()} {
     const auto& attribute_config = regs.vertex_attributes;
     num_total_attributes = attribute_config.GetNumTotalAttributes();
 
@@ -41,10 +127,13 @@ VertexLoader::VertexLoader(Memory::MemorySystem& memory_, const PipelineRegs& re
                 vertex_attribute_sources[attribute_index] = loader_config.data_offset + offset;
                 vertex_attribute_strides[attribute_index] =
                     static_cast<u32>(loader_config.byte_count);
-                vertex_attribute_formats[attribute_index] =
-                    attribute_config.GetFormat(attribute_index);
                 vertex_attribute_elements[attribute_index] =
                     attribute_config.GetNumElements(attribute_index);
+                vertex_attribute_bytes[attribute_index] =
+                    attribute_config.GetStride(attribute_index);
+                vertex_attribute_loaders[attribute_index] =
+                    attribute_loaders[static_cast<u32>(attribute_config.GetFormat(
+                        attribute_index))][attribute_config.GetNumElements(attribute_index) - 1];
                 offset += attribute_config.GetStride(attribute_index);
             } else if (attribute_index < 16) {
                 // Attribute ids 12, 13, 14 and 15 signify 4, 8, 12 and 16-byte paddings,
@@ -57,11 +146,47 @@ VertexLoader::VertexLoader(Memory::MemorySystem& memory_, const PipelineRegs& re
             }
         }
     }
+
+    // Resolve the memory backing each attribute once, instead of on every vertex.
+    for (s32 i = 0; i < num_total_attributes; ++i) {
+        if (vertex_attribute_is_default[i] || vertex_attribute_elements[i] == 0) {
+            continue;
+        }
+        const MemoryRef ref = memory.GetPhysicalRef(base_address + vertex_attribute_sources[i]);
+        vertex_attribute_data[i] = ref.GetPtr();
+        vertex_attribute_data_size[i] = ref.GetSize();
+    }
 }
 
 VertexLoader::~VertexLoader() = default;
 
-void VertexLoader::LoadVertex(PAddr base_address, u32 index, u32 vertex, AttributeBuffer& input,
+bool VertexLoader::CanLoadConcurrently(u32 max_vertex) const {
+    for (s32 i = 0; i < num_total_attributes; ++i) {
+        if (vertex_attribute_is_default[i] || vertex_attribute_elements[i] == 0) {
+            continue;
+        }
+        const std::size_t end =
+            static_cast<std::size_t>(vertex_attribute_strides[i]) * max_vertex +
+            vertex_attribute_bytes[i];
+        if (!vertex_attribute_data[i] || end > vertex_attribute_data_size[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const u8* VertexLoader::GetAttributeData(u32 attrib, u32 vertex) const {
+    const std::size_t offset = static_cast<std::size_t>(vertex_attribute_strides[attrib]) * vertex;
+    if (vertex_attribute_data[attrib] &&
+        offset + vertex_attribute_bytes[attrib] <= vertex_attribute_data_size[attrib]) {
+        return vertex_attribute_data[attrib] + offset;
+    }
+    // The vertex lies past the end of the memory region, let the memory system sort it out.
+    return memory.GetPhysicalPointer(base_address + vertex_attribute_sources[attrib] +
+                                     vertex_attribute_strides[attrib] * vertex);
+}
+
+void VertexLoader::LoadVertex(u32 vertex, AttributeBuffer& input,
                               AttributeBuffer& input_default_attributes) const {
     for (s32 i = 0; i < num_total_attributes; ++i) {
         // Load the default attribute if we're configured to do so
@@ -79,30 +204,7 @@ void VertexLoader::LoadVertex(PAddr base_address, u32 index, u32 vertex, Attribu
         }
 
         // Load per-vertex data from the loader arrays
-        const PAddr source_addr =
-            base_address + vertex_attribute_sources[i] + vertex_attribute_strides[i] * vertex;
-
-        switch (vertex_attribute_formats[i]) {
-        case PipelineRegs::VertexAttributeFormat::BYTE:
-            LoadAttribute<s8>(source_addr, i, input);
-            break;
-        case PipelineRegs::VertexAttributeFormat::UBYTE:
-            LoadAttribute<u8>(source_addr, i, input);
-            break;
-        case PipelineRegs::VertexAttributeFormat::SHORT:
-            LoadAttribute<s16>(source_addr, i, input);
-            break;
-        case PipelineRegs::VertexAttributeFormat::FLOAT:
-            LoadAttribute<f32>(source_addr, i, input);
-            break;
-        }
-
-        // Default attribute values set if array elements have < 4 components. This
-        // is *not* carried over from the default attribute settings even if they're
-        // enabled for this attribute.
-        for (u32 comp = vertex_attribute_elements[i]; comp < 4; comp++) {
-            input[i][comp] = comp == 3 ? f24::One() : f24::Zero();
-        }
+        vertex_attribute_loaders[i](GetAttributeData(i, vertex), input[i]);
     }
 }
 
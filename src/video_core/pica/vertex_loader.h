@@ -16,31 +16,42 @@ namespace Pica {
 
 class VertexLoader {
 public:
+    /// Converts the elements of one attribute of a vertex into an input register.
+    using AttributeLoadFunc = void (*)(const u8* data, Common::Vec4<f24>& out);
+
     explicit VertexLoader(Memory::MemorySystem& memory_, const PipelineRegs& regs);
     ~VertexLoader();
 
-    void LoadVertex(PAddr base_address, u32 index, u32 vertex, AttributeBuffer& input,
+    void LoadVertex(u32 vertex, AttributeBuffer& input,
                     AttributeBuffer& input_default_attributes) const;
 
-    template <typename T>
-    void LoadAttribute(PAddr source_addr, u32 attrib, AttributeBuffer& out) const {
-        const T* data = reinterpret_cast<const T*>(memory.GetPhysicalPointer(source_addr));
-        for (u32 comp = 0; comp < vertex_attribute_elements[attrib]; ++comp) {
-            out[attrib][comp] = f24::FromFloat32(data[comp]);
-        }
-    }
+    /**
+     * Returns whether all vertices up to max_vertex can be loaded from the memory resolved when
+     * the loader was created. Such loads don't go through the memory system, so they can be made
+     * from several threads at once.
+     */
+    [[nodiscard]] bool CanLoadConcurrently(u32 max_vertex) const;
 
     int GetNumTotalAttributes() const {
         return num_total_attributes;
     }
 
 private:
+    /// Returns a pointer to the data of the attribute for the provided vertex.
+    const u8* GetAttributeData(u32 attrib, u32 vertex) const;
+
     Memory::MemorySystem& memory;
+    PAddr base_address;
     std::array<u32, 16> vertex_attribute_sources;
     std::array<u32, 16> vertex_attribute_strides{};
-    std::array<PipelineRegs::VertexAttributeFormat, 16> vertex_attribute_formats;
     std::array<u32, 16> vertex_attribute_elements{};
+    std::array<u32, 16> vertex_attribute_bytes{};
     std::array<bool, 16> vertex_attribute_is_default;
+    std::array<AttributeLoadFunc, 16> vertex_attribute_loaders{};
+    // Host pointers to the first vertex of each attribute, resolved once per batch, along with
+    // the amount of bytes that can be read from them.
+    std::array<const u8*, 16> vertex_attribute_data{};
+    std::array<std::size_t, 16> vertex_attribute_data_size{};
     int num_total_attributes = 0;
 };
 
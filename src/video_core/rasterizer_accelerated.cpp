@@ -55,7 +55,10 @@ RasterizerAccelerated::HardwareVertex::HardwareVertex(const Pica::OutputVertex&
 }
 
 RasterizerAccelerated::RasterizerAccelerated(Memory::MemorySystem& memory_, Pica::PicaCore& pica_)
-    : memory{memory_}, pica{pica_}, regs{pica.regs.internal} {}
+    : memory{memory_}, pica{pica_}, regs{pica.regs.internal} {
+    // Nothing has been synced with the registers yet.
+    pica.dirty_regs.SetAll();
+}
 
 /**
  * This is a helper function to resolve an issue when interpolating opposite quaternions. See below
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <optional>
+#include "common/hash.h"
 #include "common/vector_math.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/shader/generator/pica_fs_config.h"
@@ -19,6 +23,54 @@ class PicaCore;
 
 namespace VideoCore {
 
+/**
+ * Remembers where data was written to a stream buffer since it last wrapped around, keyed by a
+ * hash of its contents. Switching back to data that is still in the buffer, such as a LUT or a
+ * uniform block, only changes the offset the shaders read it from, instead of converting and
+ * uploading it again.
+ * @tparam Capacity Number of uploads remembered, the oldest one is forgotten first
+ */
+template <std::size_t Capacity>
+class StreamUploadCache {
+public:
+    /// Returns the hash identifying some contents, tagged with the kind of data they are.
+    template <typename T>
+    [[nodiscard]] static u64 Hash(const T& contents, u64 kind) {
+        return Common::HashCombine(kind, Common::ComputeHash64(&contents, sizeof(contents)));
+    }
+
+    /// Returns the offset data with this hash was uploaded at, if it is still in the buffer.
+    [[nodiscard]] std::optional<int> Find(u64 hash) const {
+        for (std::size_t i = 0; i < size; i++) {
+            if (entries[i].hash == hash) {
+                return entries[i].offset;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void Insert(u64 hash, int offset) {
+        entries[next] = {hash, offset};
+        next = (next + 1) % Capacity;
+        size = std::max(size, next == 0 ? Capacity : next);
+    }
+
+    /// Forgets every upload, must be called when the buffer wraps around and overwrites them.
+    void Clear() {
+        size = 0;
+        next = 0;
+    }
+
+private:
+    struct Entry {
+        u64 hash;
+        int offset;
+    };
+    std::array<Entry, Capacity> entries{};
+    std::size_t size{};
+    std::size_t next{};
+};
+
 class RasterizerAccelerated : public RasterizerInterface {
 public:
     explicit RasterizerAccelerated(Memory::MemorySystem& memory, Pica::PicaCore& pica);
@@ -66,6 +118,13 @@ protected:
     Pica::Shader::Generator::FSUniformData fs_data{};
     bool vs_data_dirty = true;
     bool fs_data_dirty = true;
+
+    /// Uploads in the lighting and fog LUT buffer, enough for a few sets of all of them.
+    StreamUploadCache<64> lf_lut_cache;
+    /// Uploads in the procedural texture LUT buffer.
+    StreamUploadCache<32> proctex_lut_cache;
+    /// Uploads in the uniform buffer, of the VS, FS, and PICA shader uniform blocks.
+    StreamUploadCache<32> uniform_cache;
 };
 
 } // namespace VideoCore
@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
 #include <boost/container/small_vector.hpp>
 #include <boost/range/iterator_range.hpp>
 #include "common/alignment.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
+#include "common/memory_detect.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
@@ -28,6 +31,12 @@ MICROPROFILE_DECLARE(RasterizerCache_UploadSurface);
 MICROPROFILE_DECLARE(RasterizerCache_DownloadSurface);
 MICROPROFILE_DECLARE(RasterizerCache_Invalidation);
 
+// Number of synchronous downloads after which the readback of a surface is started early.
+constexpr u32 MIN_FLUSHES_FOR_READBACK = 2;
+
+// Surface memory budget on low memory hosts when the user did not set one.
+constexpr u64 LOW_MEMORY_SURFACE_BUDGET = u64{512} << 20;
+
 constexpr auto RangeFromInterval(const auto& map, const auto& interval) {
     return boost::make_iterator_range(map.equal_range(interval));
 }
@@ -40,7 +49,9 @@ RasterizerCache<T>::RasterizerCache(Memory::MemorySystem& memory_,
       renderer{renderer_}, resolution_scale_factor{renderer.GetResolutionScaleFactor()},
       filter{Settings::values.texture_filter.GetValue()},
       dump_textures{Settings::values.dump_textures.GetValue()},
-      use_custom_textures{Settings::values.custom_textures.GetValue()} {
+      use_custom_textures{Settings::values.custom_textures.GetValue()},
+      skip_unchanged_uploads{Settings::values.skip_unchanged_uploads.GetValue()},
+      generate_mipmaps{Settings::values.generate_mipmaps.GetValue()} {
     using TextureConfig = Pica::TexturingRegs::TextureConfig;
 
     // Create null handles for all cached resources
@@ -68,6 +79,15 @@ RasterizerCache<T>::RasterizerCache(Memory::MemorySystem& memory_,
                                            .wrap_t = TextureConfig::WrapMode::ClampToBorder,
                                        }));
 
+    // Custom textures of formats the host GPU can not sample are transcoded when they are loaded.
+    u32 supported_formats = 0;
+    for (u32 format = 0; format <= static_cast<u32>(CustomPixelFormat::ASTC8); format++) {
+        if (runtime.IsCustomFormatSupported(static_cast<CustomPixelFormat>(format))) {
+            supported_formats |= CustomFormatBit(static_cast<CustomPixelFormat>(format));
+        }
+    }
+    custom_tex_manager.SetSupportedFormats(supported_formats);
+
     auto& null_surface = slot_surfaces[NULL_SURFACE_ID];
     runtime.ClearTexture(null_surface, {
                                            .texture_level = 0,
@@ -82,6 +102,10 @@ RasterizerCache<T>::RasterizerCache(Memory::MemorySystem& memory_,
 template <class T>
 RasterizerCache<T>::~RasterizerCache() {
     ClearAll(false);
+    if (skip_unchanged_uploads) {
+        LOG_INFO(HW_GPU, "Skipped {} of {} texture uploads with unchanged data", upload_hash_hits,
+                 upload_hash_hits + upload_hash_misses);
+    }
 }
 
 template <class T>
@@ -123,6 +147,73 @@ void RasterizerCache<T>::RunGarbageCollector() {
         slot_surfaces.erase(surface_id);
         it = sentenced.erase(it);
     }
+    EvictSurfaces();
+}
+
+template <class T>
+void RasterizerCache<T>::EvictSurfaces() {
+    struct Candidate {
+        u64 last_used_tick;
+        u64 usage;
+        SurfaceId surface_id;
+    };
+    std::vector<Candidate> candidates;
+    u64 used = 0;
+    ForEachSurfaceInRegion(0, 0xFFFFFFFF, [&](SurfaceId surface_id, Surface& surface) {
+        const u64 usage = surface.MemoryUsage();
+        used += usage;
+        if (usage != 0 && surface.last_used_tick < frame_tick) {
+            candidates.push_back({surface.last_used_tick, usage, surface_id});
+        }
+    });
+
+    u64 budget = Settings::values.texture_memory_budget.GetValue() != 0
+                     ? u64{Settings::values.texture_memory_budget.GetValue()} << 20
+                     : runtime.SurfaceMemoryBudget(used);
+    if (Settings::values.texture_memory_budget.GetValue() == 0 && Common::IsLowMemoryHost()) {
+        budget = budget == 0 ? LOW_MEMORY_SURFACE_BUDGET
+                             : std::min(budget, LOW_MEMORY_SURFACE_BUDGET);
+    }
+
+    // A memory trim request evicts every clean surface that was not used this frame.
+    const u64 trim_count = Common::GetMemoryTrimCount();
+    const bool trim = trim_count != memory_trim_count;
+    memory_trim_count = trim_count;
+    if (!trim && (budget == 0 || used <= budget)) {
+        renderer.ReportTextureMemory(used, budget, 0);
+        return;
+    }
+
+    // Evict down to a bit below the budget, so that the next few surfaces created do not
+    // immediately push the cache over it again.
+    const u64 target = trim ? 0 : budget - budget / 8;
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.last_used_tick < rhs.last_used_tick;
+    });
+    u32 evicted = 0;
+    for (const Candidate& candidate : candidates) {
+        if (used <= target) {
+            break;
+        }
+        if (IsSurfaceDirty(candidate.surface_id)) {
+            continue;
+        }
+        UnregisterSurface(candidate.surface_id);
+        used -= candidate.usage;
+        evicted++;
+    }
+    renderer.ReportTextureMemory(used, budget, evicted);
+}
+
+template <class T>
+bool RasterizerCache<T>::IsSurfaceDirty(SurfaceId surface_id) {
+    const Surface& surface = slot_surfaces[surface_id];
+    for (const auto& [region, owner_id] : RangeFromInterval(dirty_regions, surface.GetInterval())) {
+        if (owner_id == surface_id) {
+            return true;
+        }
+    }
+    return false;
 }
 
 template <class T>
@@ -332,6 +423,13 @@ bool RasterizerCache<T>::AccelerateDisplayTransfer(const Pica::DisplayTransferCo
     runtime.BlitTextures(src_surface, dst_surface, texture_blit);
 
     InvalidateRegion(dst_params.addr, dst_params.size, dst_surface_id);
+
+    // Transfers to linear memory are usually done for the CPU to read the result, so start the
+    // readback right away. The same goes for surfaces the CPU has been reading repeatedly.
+    if (!dst_surface.is_tiled || dst_surface.flush_count >= MIN_FLUSHES_FOR_READBACK) {
+        const u32 level = dst_surface.LevelOf(dst_params.addr);
+        StartDownload(dst_surface, dst_params.GetInterval() & dst_surface.LevelInterval(level));
+    }
     return true;
 }
 
@@ -651,31 +749,25 @@ typename T::Surface& RasterizerCache<T>::GetTextureCube(const TextureCubeConfig&
         cube.surface_id = CreateSurface(cube_params);
     }
 
-    Surface& cube_surface = slot_surfaces[cube.surface_id];
+    // Copy all modified faces together, so the backend can batch them into a single command.
+    std::array<Surface*, 6> modified_faces{};
+    bool any_modified = false;
     for (u32 i = 0; i < addresses.size(); i++) {
         const SurfaceId& face_id = cube.face_ids[i];
         if (!addresses[i] || !face_id) {
             continue;
         }
         Surface& surface = slot_surfaces[face_id];
+        surface.last_used_tick = frame_tick;
         if (cube.ticks[i] == surface.modification_tick) {
             continue;
         }
         cube.ticks[i] = surface.modification_tick;
-        boost::container::small_vector<TextureCopy, 8> upload_copies;
-        for (u32 level = 0; level < config.levels; level++) {
-            const u32 width_lod = surface.GetScaledWidth() >> level;
-            upload_copies.push_back({
-                .src_level = level,
-                .dst_level = level,
-                .src_layer = 0,
-                .dst_layer = i,
-                .src_offset = {0, 0},
-                .dst_offset = {0, 0},
-                .extent = {width_lod, width_lod},
-            });
-        }
-        runtime.CopyTextures(surface, cube_surface, upload_copies);
+        modified_faces[i] = &surface;
+        any_modified = true;
+    }
+    if (any_modified) {
+        runtime.CopyCubeFaces(modified_faces, slot_surfaces[cube.surface_id], config.levels);
     }
 
     return slot_surfaces[cube.surface_id];
@@ -810,16 +902,8 @@ void RasterizerCache<T>::ForEachSurfaceInRegion(PAddr addr, std::size_t size, Fu
     using FuncReturn = typename std::invoke_result<Func, SurfaceId, Surface&>::type;
     static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
     boost::container::small_vector<SurfaceId, 8> surfaces;
-    ForEachPage(addr, size, [this, &surfaces, addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
-            if constexpr (BOOL_BREAK) {
-                return false;
-            } else {
-                return;
-            }
-        }
-        for (const SurfaceId surface_id : it->second) {
+    page_table.ForEachPage(addr, size, [&](const std::vector<SurfaceId>& page_surfaces) {
+        for (const SurfaceId surface_id : page_surfaces) {
             Surface& surface = slot_surfaces[surface_id];
             if (True(surface.flags & SurfaceFlagBits::Picked)) {
                 continue;
@@ -838,9 +922,7 @@ void RasterizerCache<T>::ForEachSurfaceInRegion(PAddr addr, std::size_t size, Fu
                 func(surface_id, surface);
             }
         }
-        if constexpr (BOOL_BREAK) {
-            return false;
-        }
+        return false;
     });
     for (const SurfaceId surface_id : surfaces) {
         slot_surfaces[surface_id].flags &= ~SurfaceFlagBits::Picked;
@@ -931,6 +1013,9 @@ SurfaceId RasterizerCache<T>::FindMatch(const SurfaceParams& params, ScaleMatch
             return std::make_pair(surface.CanTexCopy(params), surface.GetInterval());
         });
     });
+    if (match_id) {
+        slot_surfaces[match_id].last_used_tick = frame_tick;
+    }
     return match_id;
 }
 
@@ -964,6 +1049,12 @@ void RasterizerCache<T>::ValidateSurface(SurfaceId surface_id, PAddr addr, u32 s
                            "RasterizerCache::ValidateSurface (from {:#x} to {:#x})", addr,
                            addr + size};
 
+    // When enabled, the guest mip levels are not uploaded but blitted from the base level instead.
+    const bool can_generate_mipmaps =
+        generate_mipmaps && surface.levels > 1 && !surface.IsCustom() &&
+        (surface.type == SurfaceType::Color || surface.type == SurfaceType::Texture);
+    bool mipmaps_stale = false;
+
     u32 level = surface.LevelOf(addr);
     SurfaceInterval level_interval = surface.LevelInterval(level);
     while (!validate_regions.empty()) {
@@ -976,6 +1067,14 @@ void RasterizerCache<T>::ValidateSurface(SurfaceId surface_id, PAddr addr, u32 s
             continue;
         }
 
+        if (can_generate_mipmaps) {
+            mipmaps_stale = true;
+            if (level != 0 && surface.IsRegionValid(surface.LevelInterval(0))) {
+                notify_validated(interval);
+                continue;
+            }
+        }
+
         // Look for a valid surface to copy from.
         const SurfaceParams params = surface.FromInterval(interval);
         const SurfaceId copy_surface_id =
@@ -984,6 +1083,7 @@ void RasterizerCache<T>::ValidateSurface(SurfaceId surface_id, PAddr addr, u32 s
             Surface& copy_surface = slot_surfaces[copy_surface_id];
             const SurfaceInterval copy_interval = copy_surface.GetCopyableInterval(params);
             CopySurface(copy_surface, surface, copy_interval);
+            surface.ForgetUploadHashes(copy_interval);
             notify_validated(copy_interval);
             continue;
         }
@@ -991,17 +1091,26 @@ void RasterizerCache<T>::ValidateSurface(SurfaceId surface_id, PAddr addr, u32 s
         // Try to find surface in cache with different format
         // that can can be reinterpreted to the requested format.
         if (ValidateByReinterpretation(surface, params, interval)) {
+            surface.ForgetUploadHashes(interval);
             notify_validated(interval);
             continue;
         }
 
         FlushRegion(params.addr, params.size);
-        if (!use_custom_textures || !UploadCustomSurface(surface_id, interval)) {
+        if (use_custom_textures && UploadCustomSurface(surface_id, interval)) {
+            surface.ForgetUploadHashes(params.GetInterval());
+        } else {
             UploadSurface(surface, interval);
         }
         notify_validated(params.GetInterval());
     }
 
+    if (mipmaps_stale && surface.IsRegionValid(surface.LevelInterval(0))) {
+        runtime.GenerateMipmaps(surface);
+        surface.MarkValid(SurfaceInterval{surface.LevelInterval(1).lower(), surface.end});
+        return;
+    }
+
     // Filtered mipmaps often look really bad. We can achieve better quality by
     // generating them from the base level.
     if (surface.res_scale != 1 && level != 0) {
@@ -1016,17 +1125,32 @@ void RasterizerCache<T>::UploadSurface(Surface& surface, SurfaceInterval interva
     const SurfaceParams load_info = surface.FromInterval(interval);
     ASSERT(load_info.addr >= surface.addr && load_info.end <= surface.end);
 
-    const auto staging = runtime.FindStaging(
-        load_info.width * load_info.height * surface.GetInternalBytesPerPixel(), true);
-
     MemoryRef source_ptr = memory.GetPhysicalRef(load_info.addr);
     if (!source_ptr) [[unlikely]] {
         return;
     }
 
+    // Games often write the same data to a texture again, which leaves the texture as it is.
     const auto upload_data = source_ptr.GetWriteBytes(load_info.end - load_info.addr);
-    DecodeTexture(load_info, load_info.addr, load_info.end, upload_data, staging.mapped,
-                  runtime.NeedsConversion(surface.pixel_format));
+    if (skip_unchanged_uploads) {
+        const u64 hash = Common::ComputeHash64(upload_data.data(), upload_data.size());
+        if (surface.MatchesUploadHash(load_info.GetInterval(), hash)) {
+            upload_hash_hits++;
+            return;
+        }
+        upload_hash_misses++;
+        surface.SetUploadHash(load_info.GetInterval(), hash);
+    }
+
+    const auto staging = runtime.FindStaging(
+        load_info.width * load_info.height * surface.GetInternalBytesPerPixel(), true);
+
+    // Let the runtime decode the texture on the GPU when it can, and fall back to the CPU.
+    const bool convert = runtime.NeedsConversion(surface.pixel_format);
+    if (!runtime.DecodeTexture(load_info, upload_data, staging, convert)) {
+        DecodeTexture(load_info, load_info.addr, load_info.end, upload_data, staging.mapped,
+                      convert);
+    }
 
     const bool should_dump = False(surface.flags & SurfaceFlagBits::Custom) &&
                              False(surface.flags & SurfaceFlagBits::RenderTarget);
@@ -1116,6 +1240,23 @@ void RasterizerCache<T>::DownloadSurface(Surface& surface, SurfaceInterval inter
     const u32 flush_end = boost::icl::last_next(interval);
     ASSERT(flush_start >= surface.addr && flush_end <= surface.end);
 
+    MemoryRef dest_ptr = memory.GetPhysicalRef(flush_start);
+    if (!dest_ptr) [[unlikely]] {
+        return;
+    }
+
+    const auto download_dest = dest_ptr.GetWriteBytes(flush_end - flush_start);
+    const bool convert = runtime.NeedsConversion(surface.pixel_format);
+    if (FinishDownload(surface, interval, download_dest, convert)) {
+        return;
+    }
+
+    surface.flush_count++;
+    if (flush_start == flush_info.addr && flush_end == flush_info.end &&
+        runtime.EncodeTexture(surface, flush_info, download_dest, convert)) {
+        return;
+    }
+
     const auto staging = runtime.FindStaging(
         flush_info.width * flush_info.height * surface.GetInternalBytesPerPixel(), false);
 
@@ -1126,15 +1267,46 @@ void RasterizerCache<T>::DownloadSurface(Surface& surface, SurfaceInterval inter
         .texture_level = surface.LevelOf(flush_start),
     };
     surface.Download(download, staging);
+    EncodeTexture(flush_info, flush_start, flush_end, staging.mapped, download_dest, convert);
+}
 
-    MemoryRef dest_ptr = memory.GetPhysicalRef(flush_start);
-    if (!dest_ptr) [[unlikely]] {
-        return;
+template <class T>
+void RasterizerCache<T>::StartDownload(Surface& surface, SurfaceInterval interval) {
+    PendingDownload pending = {
+        .interval = interval,
+        .modification_tick = surface.modification_tick,
+    };
+    if (runtime.DownloadAsync(surface, surface.FromInterval(interval), pending)) {
+        surface.pending_download = pending;
+    } else {
+        surface.pending_download.reset();
     }
+}
 
-    const auto download_dest = dest_ptr.GetWriteBytes(flush_end - flush_start);
-    EncodeTexture(flush_info, flush_start, flush_end, staging.mapped, download_dest,
-                  runtime.NeedsConversion(surface.pixel_format));
+template <class T>
+bool RasterizerCache<T>::FinishDownload(Surface& surface, SurfaceInterval interval,
+                                        std::span<u8> dest, bool convert) {
+    if (!surface.pending_download) {
+        return false;
+    }
+
+    // The download is only usable while the surface has not been written to since it started.
+    // Tiled data can be encoded from any part of it, linear data only from its start.
+    const PendingDownload& pending = *surface.pending_download;
+    const SurfaceParams pending_info = surface.FromInterval(pending.interval);
+    const u32 flush_start = boost::icl::first(interval);
+    const u32 flush_end = boost::icl::last_next(interval);
+    const bool contained =
+        flush_start >= pending_info.addr && flush_end <= pending_info.end &&
+        (pending_info.is_tiled || surface.FromInterval(interval).addr == pending_info.addr);
+    if (pending.modification_tick != surface.modification_tick || !contained ||
+        !runtime.FinishDownload(pending)) {
+        surface.pending_download.reset();
+        return false;
+    }
+
+    EncodeTexture(pending_info, flush_start, flush_end, pending.staging.mapped, dest, convert);
+    return true;
 }
 
 template <class T>
@@ -1232,7 +1404,75 @@ void RasterizerCache<T>::ClearAll(bool flush) {
     // Remove the whole cache without really looking at it.
     cached_pages -= flush_interval;
     dirty_regions.clear();
-    page_table.clear();
+    page_table.Clear();
+}
+
+template <class T>
+std::vector<SurfaceDescriptor> RasterizerCache<T>::GetSurfaceDescriptors(std::size_t max_count) {
+    std::vector<std::pair<u64, SurfaceDescriptor>> surfaces;
+    ForEachSurfaceInRegion(0, 0xFFFFFFFF, [&](SurfaceId surface_id, Surface& surface) {
+        // Fills, cubes and custom textures are not loaded from emulated memory as they are, and
+        // surfaces with a stride are only accessed through the surface they are a part of.
+        if (surface_id == NULL_SURFACE_ID || surface.type == SurfaceType::Fill ||
+            surface.texture_type != TextureType::Texture2D || surface.IsCustom() ||
+            surface.width != surface.stride) {
+            return;
+        }
+        surfaces.emplace_back(surface.last_used_tick,
+                              SurfaceDescriptor{
+                                  .addr = surface.addr,
+                                  .width = static_cast<u16>(surface.width),
+                                  .height = static_cast<u16>(surface.height),
+                                  .stride = static_cast<u16>(surface.stride),
+                                  .levels = static_cast<u8>(surface.levels),
+                                  .pixel_format = static_cast<u8>(surface.pixel_format),
+                                  .is_tiled = surface.is_tiled,
+                                  .texture_type = static_cast<u8>(surface.texture_type),
+                                  .scaled = surface.res_scale > 1,
+                                  .reserved = 0,
+                              });
+    });
+
+    std::ranges::sort(surfaces, std::greater{}, &std::pair<u64, SurfaceDescriptor>::first);
+    std::vector<SurfaceDescriptor> descriptors;
+    descriptors.reserve(std::min(surfaces.size(), max_count));
+    for (std::size_t i = 0; i < std::min(surfaces.size(), max_count); i++) {
+        descriptors.push_back(surfaces[i].second);
+    }
+    return descriptors;
+}
+
+template <class T>
+void RasterizerCache<T>::PrewarmSurfaces(std::span<const SurfaceDescriptor> surfaces) {
+    // Loaded in the opposite order so that the most recently used surfaces are created last and
+    // win over older surfaces they overlap.
+    for (auto it = surfaces.rbegin(); it != surfaces.rend(); ++it) {
+        const SurfaceDescriptor& descriptor = *it;
+        SurfaceParams params;
+        params.addr = descriptor.addr;
+        params.width = descriptor.width;
+        params.height = descriptor.height;
+        params.stride = descriptor.stride;
+        params.levels = descriptor.levels;
+        params.is_tiled = descriptor.is_tiled != 0;
+        params.pixel_format = static_cast<PixelFormat>(descriptor.pixel_format);
+        params.res_scale = descriptor.scaled ? resolution_scale_factor : 1;
+
+        // The descriptors come from a file, surfaces the cache could not have created are skipped.
+        if (params.pixel_format >= PixelFormat::MaxPixelFormat || params.width == 0 ||
+            params.height == 0 || params.width != params.stride || params.levels == 0 ||
+            params.levels > MAX_PICA_LEVELS ||
+            (params.is_tiled && (params.width % 8 != 0 || params.height % 8 != 0)) ||
+            static_cast<TextureType>(descriptor.texture_type) != TextureType::Texture2D) {
+            continue;
+        }
+        params.UpdateParams();
+        if (!memory.IsValidPhysicalAddress(params.addr) ||
+            !memory.IsValidPhysicalAddress(params.end - 1)) {
+            continue;
+        }
+        GetSurface(params, ScaleMatch::Ignore, true);
+    }
 }
 
 template <class T>
@@ -1301,6 +1541,7 @@ void RasterizerCache<T>::InvalidateRegion(PAddr addr, u32 size, SurfaceId region
         ASSERT(addr >= region_owner.addr && addr + size <= region_owner.end);
         ASSERT(region_owner.width == region_owner.stride);
         region_owner.MarkValid(invalid_interval);
+        region_owner.ForgetUploadHashes(invalid_interval);
     }
 
     boost::container::small_vector<SurfaceId, 4> remove_surfaces;
@@ -1310,7 +1551,10 @@ void RasterizerCache<T>::InvalidateRegion(PAddr addr, u32 size, SurfaceId region
         }
         // If the CPU is invalidating this region we want to remove it
         // to (likely) mark the memory pages as uncached
-        if (!region_owner_id && size <= 8) {
+        if (!region_owner_id && size <= RasterizerInterface::MaxFlushingInvalidationSize) {
+            if (InvalidateRowsOfScaled(surface_id, surface, invalid_interval)) {
+                return;
+            }
             FlushRegion(surface.addr, surface.size, surface_id);
             remove_surfaces.push_back(surface_id);
             return;
@@ -1334,6 +1578,30 @@ void RasterizerCache<T>::InvalidateRegion(PAddr addr, u32 size, SurfaceId region
     }
 }
 
+template <class T>
+bool RasterizerCache<T>::InvalidateRowsOfScaled(SurfaceId surface_id, Surface& surface,
+                                                const SurfaceInterval& invalid_interval) {
+    // Removing an upscaled surface loses its scaled contents and uploads all of it again. Titles
+    // writing small elements into render targets with the CPU only need the rows they write to be
+    // uploaded and scaled again. The pages of a kept surface stay cached and every CPU write to
+    // them traps, so surfaces written to extensively are still removed.
+    if (surface.res_scale == 1 || surface.levels != 1) {
+        return false;
+    }
+    const auto interval = surface.GetInterval() & invalid_interval;
+    const u32 invalid_size =
+        boost::icl::length(surface.invalid_regions) + boost::icl::length(interval);
+    if (boost::icl::is_empty(interval) || invalid_size * 4 > surface.size) {
+        return false;
+    }
+
+    // The rows are uploaded from guest memory as a whole, write back the parts the CPU keeps.
+    const SurfaceParams rows = surface.FromInterval(interval);
+    FlushRegion(rows.addr, rows.size, surface_id);
+    surface.MarkInvalid(interval);
+    return true;
+}
+
 template <class T>
 SurfaceId RasterizerCache<T>::CreateSurface(const SurfaceParams& params) {
     const SurfaceId surface_id = [&] {
@@ -1352,6 +1620,7 @@ SurfaceId RasterizerCache<T>::CreateSurface(const SurfaceParams& params) {
         surface.ScaleUp(params.res_scale);
     }
     surface.MarkInvalid(surface.GetInterval());
+    surface.last_used_tick = frame_tick;
     return surface_id;
 }
 
@@ -1363,8 +1632,7 @@ void RasterizerCache<T>::RegisterSurface(SurfaceId surface_id) {
 
     surface.flags |= SurfaceFlagBits::Registered;
     UpdatePagesCachedCount(surface.addr, surface.size, 1);
-    ForEachPage(surface.addr, surface.size,
-                [this, surface_id](u64 page) { page_table[page].push_back(surface_id); });
+    page_table.Add(surface.addr, surface.size, surface_id);
 }
 
 template <class T>
@@ -1375,21 +1643,8 @@ void RasterizerCache<T>::UnregisterSurface(SurfaceId surface_id) {
 
     surface.flags &= ~SurfaceFlagBits::Registered;
     UpdatePagesCachedCount(surface.addr, surface.size, -1);
-    ForEachPage(surface.addr, surface.size, [this, surface_id](u64 page) {
-        const auto page_it = page_table.find(page);
-        if (page_it == page_table.end()) {
-            ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << CITRA_PAGEBITS);
-            return;
-        }
-        std::vector<SurfaceId>& surfaces = page_it.value();
-        const auto vector_it = std::find(surfaces.begin(), surfaces.end(), surface_id);
-        if (vector_it == surfaces.end()) {
-            ASSERT_MSG(false, "Unregistering unregistered surface in page=0x{:x}",
-                       page << CITRA_PAGEBITS);
-            return;
-        }
-        surfaces.erase(vector_it);
-    });
+    const bool removed = page_table.Remove(surface.addr, surface.size, surface_id);
+    ASSERT_MSG(removed, "Unregistering unregistered surface at 0x{:x}", surface.addr);
 
     if (surface.type != SurfaceType::Fill) {
         RemoveTextureCubeFace(surface_id);
@@ -1403,10 +1658,12 @@ void RasterizerCache<T>::UnregisterSurface(SurfaceId surface_id) {
 template <class T>
 void RasterizerCache<T>::UnregisterAll() {
     FlushAll();
-    for (auto& [page, surfaces] : page_table) {
-        while (!surfaces.empty()) {
-            UnregisterSurface(surfaces.back());
-        }
+    std::vector<SurfaceId> surfaces;
+    ForEachSurfaceInRegion(0, 0xFFFFFFFF, [&](SurfaceId surface_id, Surface&) {
+        surfaces.push_back(surface_id);
+    });
+    for (const SurfaceId surface_id : surfaces) {
+        UnregisterSurface(surface_id);
     }
     runtime.Finish();
     frame_tick += runtime.RemoveThreshold();
@@ -11,12 +11,13 @@
 #include <unordered_map>
 #include <vector>
 #include <boost/icl/interval_map.hpp>
-#include <tsl/robin_map.h>
 
 #include "video_core/rasterizer_cache/framebuffer_base.h"
 #include "video_core/rasterizer_cache/sampler_params.h"
+#include "video_core/rasterizer_cache/surface_page_table.h"
 #include "video_core/rasterizer_cache/surface_params.h"
 #include "video_core/rasterizer_cache/texture_cube.h"
+#include "video_core/rasterizer_interface.h"
 
 namespace Memory {
 class MemorySystem;
@@ -59,9 +60,6 @@ class RendererBase;
 
 template <class T>
 class RasterizerCache {
-    /// Address shift for caching surfaces into a hash table
-    static constexpr u64 CITRA_PAGEBITS = 18;
-
     using Runtime = typename T::Runtime;
     using Sampler = typename T::Sampler;
     using Surface = typename T::Surface;
@@ -136,23 +134,16 @@ public:
     /// Clear all cached resources tracked by this cache manager
     void ClearAll(bool flush);
 
-private:
-    /// Iterate over all page indices in a range
-    template <typename Func>
-    void ForEachPage(PAddr addr, std::size_t size, Func&& func) {
-        static constexpr bool RETURNS_BOOL = std::is_same_v<std::invoke_result<Func, u64>, bool>;
-        const u64 page_end = (addr + size - 1) >> CITRA_PAGEBITS;
-        for (u64 page = addr >> CITRA_PAGEBITS; page <= page_end; ++page) {
-            if constexpr (RETURNS_BOOL) {
-                if (func(page)) {
-                    break;
-                }
-            } else {
-                func(page);
-            }
-        }
-    }
+    /// Describes up to max_count registered surfaces, most recently used first
+    std::vector<SurfaceDescriptor> GetSurfaceDescriptors(std::size_t max_count);
+
+    /// Creates the described surfaces and uploads them from emulated memory
+    void PrewarmSurfaces(std::span<const SurfaceDescriptor> surfaces);
 
+    /// Increase/decrease the number of cached resources in pages touching the specified region
+    void UpdatePagesCachedCount(PAddr addr, u32 size, int delta);
+
+private:
     /// Iterates over all the surfaces in a region calling func
     template <typename Func>
     void ForEachSurfaceInRegion(PAddr addr, std::size_t size, Func&& func);
@@ -165,6 +156,12 @@ private:
     /// Unregisters sentenced surfaces that have surpassed the destruction threshold.
     void RunGarbageCollector();
 
+    /// Unregisters the least recently used clean surfaces while the cache is over its budget.
+    void EvictSurfaces();
+
+    /// Returns true if the surface owns guest memory that has not been flushed yet.
+    bool IsSurfaceDirty(SurfaceId surface_id);
+
     /// Removes any framebuffers that reference the provided surface_id.
     void RemoveFramebuffers(SurfaceId surface_id);
 
@@ -186,6 +183,13 @@ private:
     /// Copies pixel data in interval from the host GPU surface to the guest VRAM
     void DownloadSurface(Surface& surface, SurfaceInterval interval);
 
+    /// Starts copying pixel data in interval to the host ahead of the CPU reading it
+    void StartDownload(Surface& surface, SurfaceInterval interval);
+
+    /// Encodes the pixel data of a started download to dest, returns false if it is unusable
+    bool FinishDownload(Surface& surface, SurfaceInterval interval, std::span<u8> dest,
+                        bool convert);
+
     /// Downloads a fill surface to guest VRAM
     void DownloadFillSurface(Surface& surface, SurfaceInterval interval);
 
@@ -193,6 +197,11 @@ private:
     bool ValidateByReinterpretation(Surface& surface, SurfaceParams params,
                                     const SurfaceInterval& interval);
 
+    /// Invalidates only the rows of an upscaled surface a small CPU write touches, returns false
+    /// when the surface should be flushed and removed instead
+    bool InvalidateRowsOfScaled(SurfaceId surface_id, Surface& surface,
+                                const SurfaceInterval& invalid_interval);
+
     /// Create a new surface
     SurfaceId CreateSurface(const SurfaceParams& params);
 
@@ -205,9 +214,6 @@ private:
     /// Unregisters all surfaces from the cache
     void UnregisterAll();
 
-    /// Increase/decrease the number of surface in pages touching the specified region
-    void UpdatePagesCachedCount(PAddr addr, u32 size, int delta);
-
 private:
     Memory::MemorySystem& memory;
     CustomTexManager& custom_tex_manager;
@@ -215,7 +221,7 @@ private:
     Pica::RegsInternal& regs;
     RendererBase& renderer;
     std::unordered_map<TextureCubeConfig, TextureCube> texture_cube_cache;
-    tsl::robin_pg_map<u64, std::vector<SurfaceId>, Common::IdentityHash<u64>> page_table;
+    SurfacePageTable page_table;
     std::unordered_map<FramebufferParams, FramebufferId> framebuffers;
     std::unordered_map<SamplerParams, SamplerId> samplers;
     std::list<std::pair<SurfaceId, u64>> sentenced;
@@ -226,10 +232,15 @@ private:
     PageMap cached_pages;
     u32 resolution_scale_factor;
     u64 frame_tick{};
+    u64 memory_trim_count{};
     FramebufferParams fb_params;
     Settings::TextureFilter filter;
     bool dump_textures;
     bool use_custom_textures;
+    bool skip_unchanged_uploads;
+    bool generate_mipmaps;
+    u64 upload_hash_hits{};
+    u64 upload_hash_misses{};
 };
 
 } // namespace VideoCore
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include "common/alignment.h"
 #include "video_core/custom_textures/material.h"
 #include "video_core/rasterizer_cache/surface_base.h"
@@ -9,6 +10,10 @@
 
 namespace VideoCore {
 
+// Surfaces are usually uploaded a level at a time, data uploaded in many small pieces is
+// unlikely to repeat all of them.
+constexpr std::size_t MAX_UPLOAD_HASHES = 8;
+
 SurfaceBase::SurfaceBase(const SurfaceParams& params) : SurfaceParams{params} {}
 
 SurfaceBase::~SurfaceBase() = default;
@@ -105,6 +110,26 @@ SurfaceInterval SurfaceBase::GetCopyableInterval(const SurfaceParams& params) co
     return result;
 }
 
+u64 SurfaceBase::MemoryUsage() const noexcept {
+    if (type == SurfaceType::Fill) {
+        return 0;
+    }
+    // Backends store three byte formats with an alpha channel, and custom textures are at most
+    // four bytes per pixel.
+    const u32 format_bytes = GetFormatBytesPerPixel(pixel_format);
+    const u32 bytes_per_pixel = IsCustom() || format_bytes == 3 ? 4 : format_bytes;
+    const Extent extent = RealExtent();
+    u64 usage = static_cast<u64>(extent.width) * extent.height * bytes_per_pixel;
+    if (res_scale > 1 && !IsCustom()) {
+        usage += static_cast<u64>(width) * height * bytes_per_pixel;
+    }
+    // A full mipmap chain adds another third of the base level.
+    if (levels > 1) {
+        usage += usage / 3;
+    }
+    return texture_type == TextureType::CubeMap ? usage * 6 : usage;
+}
+
 Extent SurfaceBase::RealExtent(bool scaled) const {
     const bool is_custom = IsCustom();
     u32 real_width = width;
@@ -178,4 +203,24 @@ std::array<u8, 4> SurfaceBase::MakeFillBuffer(PAddr copy_addr) {
     return fill_buffer;
 }
 
+bool SurfaceBase::MatchesUploadHash(SurfaceInterval interval, u64 hash) const {
+    return std::ranges::any_of(upload_hashes, [&](const UploadHash& upload_hash) {
+        return upload_hash.interval == interval && upload_hash.hash == hash;
+    });
+}
+
+void SurfaceBase::SetUploadHash(SurfaceInterval interval, u64 hash) {
+    ForgetUploadHashes(interval);
+    if (upload_hashes.size() >= MAX_UPLOAD_HASHES) {
+        upload_hashes.erase(upload_hashes.begin());
+    }
+    upload_hashes.push_back({interval, hash});
+}
+
+void SurfaceBase::ForgetUploadHashes(SurfaceInterval interval) {
+    std::erase_if(upload_hashes, [&](const UploadHash& upload_hash) {
+        return boost::icl::intersects(upload_hash.interval, interval);
+    });
+}
+
 } // namespace VideoCore
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
 #include <boost/icl/interval_set.hpp>
 #include "video_core/rasterizer_cache/surface_params.h"
 #include "video_core/rasterizer_cache/utils.h"
@@ -24,6 +26,21 @@ enum class SurfaceFlagBits : u32 {
 };
 DECLARE_ENUM_FLAG_OPERATORS(SurfaceFlagBits);
 
+/// Readback of a surface interval that was started before the CPU asked for it.
+struct PendingDownload {
+    SurfaceInterval interval;
+    StagingData staging;
+    u64 modification_tick; ///< Modification tick of the surface when the download started.
+    u64 fence;             ///< Backend defined fence that signals the end of the download.
+    u64 position;          ///< Backend defined position used to detect reuse of the staging.
+};
+
+/// Hash of the guest data that was last uploaded to an interval of a surface.
+struct UploadHash {
+    SurfaceInterval interval;
+    u64 hash;
+};
+
 class SurfaceBase : public SurfaceParams {
 public:
     SurfaceBase(const SurfaceParams& params);
@@ -47,6 +64,9 @@ public:
     /// Returns true if the surface contains a custom material with a normal map.
     bool HasNormalMap() const noexcept;
 
+    /// Returns an estimate of the host memory taken by the surface textures, in bytes.
+    u64 MemoryUsage() const noexcept;
+
     bool Overlaps(PAddr overlap_addr, std::size_t overlap_size) const noexcept {
         const PAddr overlap_end = overlap_addr + static_cast<PAddr>(overlap_size);
         return addr < overlap_end && overlap_addr < end;
@@ -79,6 +99,15 @@ public:
         return *invalid_regions.equal_range(interval).first == interval;
     }
 
+    /// Returns true if the guest data of interval hashed to hash when it was last uploaded
+    bool MatchesUploadHash(SurfaceInterval interval, u64 hash) const;
+
+    /// Records the hash of the guest data uploaded to interval
+    void SetUploadHash(SurfaceInterval interval, u64 hash);
+
+    /// Forgets the upload hashes of interval, after the texture was written by other means
+    void ForgetUploadHashes(SurfaceInterval interval);
+
 private:
     /// Returns the fill buffer value starting from copy_addr
     std::array<u8, 4> MakeFillBuffer(PAddr copy_addr);
@@ -90,6 +119,10 @@ public:
     u32 fill_size = 0;
     std::array<u8, 4> fill_data;
     u64 modification_tick = 1;
+    u32 flush_count = 0;
+    u64 last_used_tick = 0;
+    std::optional<PendingDownload> pending_download;
+    std::vector<UploadHash> upload_hashes;
 };
 
 } // namespace VideoCore
@@ -0,0 +1,70 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/rasterizer_cache/surface_page_table.h"
+
+namespace VideoCore {
+
+SurfacePageTable::SurfacePageTable() = default;
+
+SurfacePageTable::~SurfacePageTable() = default;
+
+void SurfacePageTable::Add(PAddr addr, u32 size, SurfaceId surface_id) {
+    if (size == 0) {
+        return;
+    }
+    const u32 last_page = (addr + size - 1) >> PAGE_BITS;
+    for (u32 page = addr >> PAGE_BITS; page <= last_page; ++page) {
+        const u32 chunk_index = page >> CHUNK_BITS;
+        auto& chunk = chunks[chunk_index];
+        if (!chunk) {
+            chunk = std::make_unique<Chunk>();
+        }
+        const u32 index = page & (PAGES_PER_CHUNK - 1);
+        chunk->pages[index].push_back(surface_id);
+        chunk->occupied[index / 64] |= u64{1} << (index % 64);
+        occupied_chunks |= u64{1} << chunk_index;
+    }
+}
+
+bool SurfacePageTable::Remove(PAddr addr, u32 size, SurfaceId surface_id) {
+    if (size == 0) {
+        return true;
+    }
+    bool found = true;
+    const u32 last_page = (addr + size - 1) >> PAGE_BITS;
+    for (u32 page = addr >> PAGE_BITS; page <= last_page; ++page) {
+        const u32 chunk_index = page >> CHUNK_BITS;
+        Chunk* const chunk = chunks[chunk_index].get();
+        const u32 index = page & (PAGES_PER_CHUNK - 1);
+        if (!chunk) {
+            found = false;
+            continue;
+        }
+        std::vector<SurfaceId>& surfaces = chunk->pages[index];
+        const auto it = std::find(surfaces.begin(), surfaces.end(), surface_id);
+        if (it == surfaces.end()) {
+            found = false;
+            continue;
+        }
+        surfaces.erase(it);
+        if (!surfaces.empty()) {
+            continue;
+        }
+        chunk->occupied[index / 64] &= ~(u64{1} << (index % 64));
+        if (std::ranges::all_of(chunk->occupied, [](u64 word) { return word == 0; })) {
+            occupied_chunks &= ~(u64{1} << chunk_index);
+        }
+    }
+    return found;
+}
+
+void SurfacePageTable::Clear() {
+    for (auto& chunk : chunks) {
+        chunk.reset();
+    }
+    occupied_chunks = 0;
+}
+
+} // namespace VideoCore
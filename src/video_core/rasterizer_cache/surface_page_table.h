@@ -0,0 +1,95 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <vector>
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "video_core/rasterizer_cache/slot_id.h"
+
+namespace VideoCore {
+
+/**
+ * Spatial index of the surfaces registered in the rasterizer cache. The physical address space
+ * is split into large pages, and each page lists the surfaces that overlap it. Pages are stored
+ * in lazily allocated chunks with a bitmap of the pages that are not empty, so walking a region
+ * skips the empty parts of it a chunk or 64 pages at a time, instead of looking up every page.
+ */
+class SurfacePageTable {
+public:
+    static constexpr u32 PAGE_BITS = 18;
+
+    SurfacePageTable();
+    ~SurfacePageTable();
+
+    /// Adds the surface to all pages overlapping the region
+    void Add(PAddr addr, u32 size, SurfaceId surface_id);
+
+    /// Removes the surface from all pages overlapping the region, returns false if it was missing
+    bool Remove(PAddr addr, u32 size, SurfaceId surface_id);
+
+    /// Removes all surfaces
+    void Clear();
+
+    /**
+     * Calls func with the surfaces of each non-empty page overlapping the region, in address
+     * order. A surface is passed once for every page it overlaps. Stops when func returns true.
+     */
+    template <typename Func>
+    void ForEachPage(PAddr addr, std::size_t size, Func&& func) const {
+        if (size == 0) {
+            return;
+        }
+        const u64 last_page = std::min<u64>((addr + size - 1) >> PAGE_BITS, NUM_PAGES - 1);
+        u64 page = addr >> PAGE_BITS;
+        while (page <= last_page) {
+            const u32 chunk_index = static_cast<u32>(page >> CHUNK_BITS);
+            const u64 chunks = occupied_chunks >> chunk_index;
+            if (chunks == 0) {
+                return;
+            }
+            if ((chunks & 1) == 0) {
+                page = static_cast<u64>(chunk_index + std::countr_zero(chunks)) << CHUNK_BITS;
+                continue;
+            }
+            const Chunk& chunk = *this->chunks[chunk_index];
+            const u32 index = static_cast<u32>(page & (PAGES_PER_CHUNK - 1));
+            const u64 word = chunk.occupied[index / 64] >> (index % 64);
+            if (word == 0) {
+                page = Common::AlignUp(page + 1, 64);
+                continue;
+            }
+            page += std::countr_zero(word);
+            if (page > last_page) {
+                return;
+            }
+            if (func(chunk.pages[page & (PAGES_PER_CHUNK - 1)])) {
+                return;
+            }
+            ++page;
+        }
+    }
+
+private:
+    static constexpr u32 NUM_PAGES = 1U << (32 - PAGE_BITS);
+    static constexpr u32 CHUNK_BITS = 8;
+    static constexpr u32 PAGES_PER_CHUNK = 1U << CHUNK_BITS;
+    static constexpr u32 NUM_CHUNKS = NUM_PAGES / PAGES_PER_CHUNK;
+    static_assert(NUM_CHUNKS <= 64, "Occupied chunks must fit in a single word");
+
+    struct Chunk {
+        std::array<std::vector<SurfaceId>, PAGES_PER_CHUNK> pages;
+        std::array<u64, PAGES_PER_CHUNK / 64> occupied{};
+    };
+
+    std::array<std::unique_ptr<Chunk>, NUM_CHUNKS> chunks;
+    u64 occupied_chunks{};
+};
+
+} // namespace VideoCore
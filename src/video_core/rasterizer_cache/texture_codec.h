@@ -10,6 +10,7 @@
 #include "common/alignment.h"
 #include "common/color.h"
 #include "video_core/rasterizer_cache/pixel_format.h"
+#include "video_core/rasterizer_cache/texture_codec_simd.h"
 #include "video_core/texture/etc1.h"
 #include "video_core/utils.h"
 
@@ -196,8 +197,10 @@ constexpr void EncodePixel4(u32 x, u32 y, const u8* source_pixel, u8* dest_tile_
     }
 }
 
+/// Reference implementation of MortonCopyTile that converts a single pixel at a time
 template <bool morton_to_linear, PixelFormat format, bool converted>
-constexpr void MortonCopyTile(u32 stride, std::span<u8> tile_buffer, std::span<u8> linear_buffer) {
+constexpr void MortonCopyTileScalar(u32 stride, std::span<u8> tile_buffer,
+                                    std::span<u8> linear_buffer) {
     constexpr u32 bytes_per_pixel = GetFormatBpp(format) / 8;
     constexpr u32 linear_bytes_per_pixel = converted ? 4 : GetFormatBytesPerPixel(format);
     constexpr bool is_compressed = format == PixelFormat::ETC1 || format == PixelFormat::ETC1A4;
@@ -228,6 +231,17 @@ constexpr void MortonCopyTile(u32 stride, std::span<u8> tile_buffer, std::span<u
     }
 }
 
+template <bool morton_to_linear, PixelFormat format, bool converted>
+constexpr void MortonCopyTile(u32 stride, std::span<u8> tile_buffer, std::span<u8> linear_buffer) {
+    if constexpr (HasVectorTileCopy<format, converted>()) {
+        MortonCopyTileVector<morton_to_linear, format, converted>(stride, tile_buffer.data(),
+                                                                 linear_buffer.data());
+    } else {
+        MortonCopyTileScalar<morton_to_linear, format, converted>(stride, tile_buffer,
+                                                                 linear_buffer);
+    }
+}
+
 /**
  * @brief Performs morton to/from linear convertions on the provided pixel data
  * @param converted If true performs RGBA8 to/from convertion to all color formats
@@ -0,0 +1,458 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include "common/arch.h"
+#include "video_core/rasterizer_cache/texture_codec_simd.h"
+
+#ifdef CITRA_HAS_SSE42
+#include <emmintrin.h>
+#include <smmintrin.h>
+#elif CITRA_ARCH(arm64)
+#include <arm_neon.h>
+#endif
+
+namespace VideoCore {
+
+namespace {
+
+using ByteShuffle = std::array<u8, 16>;
+
+// Indices of 0x80 produce zero bytes with both pshufb and tbl.
+constexpr ByteShuffle UNPACK_24_TO_32 = {0, 1, 2, 0x80, 3, 4, 5, 0x80,
+                                         6, 7, 8, 0x80, 9, 10, 11, 0x80};
+constexpr ByteShuffle PACK_32_TO_24 = {0, 1, 2,  4,  5,  6,    8,    9,
+                                       10, 12, 13, 14, 0x80, 0x80, 0x80, 0x80};
+constexpr ByteShuffle SWAP_32 = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+constexpr ByteShuffle SWAP_24 = {2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80};
+
+u32 ReadU32(const u8* source) {
+    u32 value;
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+void WriteU32(u8* dest, u32 value) {
+    std::memcpy(dest, &value, sizeof(value));
+}
+
+// Four pixels, each of them in a 32-bit lane.
+#if defined(CITRA_HAS_SSE42)
+using Pixels = __m128i;
+
+Pixels Load(const u8* source) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+}
+
+void Store(u8* dest, Pixels pixels) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), pixels);
+}
+
+Pixels Load16(const u8* source) {
+    return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+}
+
+void Store16(u8* dest, Pixels pixels) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest), _mm_packus_epi32(pixels, pixels));
+}
+
+Pixels Load12(const u8* source) {
+    const Pixels low = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+    return _mm_insert_epi32(low, static_cast<s32>(ReadU32(source + 8)), 2);
+}
+
+void Store12(u8* dest, Pixels pixels) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest), pixels);
+    WriteU32(dest + 8, static_cast<u32>(_mm_extract_epi32(pixels, 2)));
+}
+
+Pixels Shuffle(Pixels pixels, const ByteShuffle& shuffle) {
+    return _mm_shuffle_epi8(pixels, Load(shuffle.data()));
+}
+
+template <int shift>
+Pixels ShiftLeft(Pixels pixels) {
+    return _mm_slli_epi32(pixels, shift);
+}
+
+template <int shift>
+Pixels ShiftRight(Pixels pixels) {
+    return _mm_srli_epi32(pixels, shift);
+}
+
+Pixels And(Pixels pixels, u32 mask) {
+    return _mm_and_si128(pixels, _mm_set1_epi32(static_cast<s32>(mask)));
+}
+
+Pixels Or(Pixels a, Pixels b) {
+    return _mm_or_si128(a, b);
+}
+
+Pixels Or(Pixels pixels, u32 value) {
+    return _mm_or_si128(pixels, _mm_set1_epi32(static_cast<s32>(value)));
+}
+
+Pixels Add(Pixels a, Pixels b) {
+    return _mm_add_epi32(a, b);
+}
+
+Pixels Multiply(Pixels pixels, u32 factor) {
+    return _mm_mullo_epi32(pixels, _mm_set1_epi32(static_cast<s32>(factor)));
+}
+
+/// Returns the first two pixels of a followed by the first two pixels of b
+Pixels InterleaveLow(Pixels a, Pixels b) {
+    return _mm_unpacklo_epi64(a, b);
+}
+
+/// Returns the last two pixels of a followed by the last two pixels of b
+Pixels InterleaveHigh(Pixels a, Pixels b) {
+    return _mm_unpackhi_epi64(a, b);
+}
+#elif CITRA_ARCH(arm64)
+using Pixels = uint32x4_t;
+
+Pixels Load(const u8* source) {
+    return vreinterpretq_u32_u8(vld1q_u8(source));
+}
+
+void Store(u8* dest, Pixels pixels) {
+    vst1q_u8(dest, vreinterpretq_u8_u32(pixels));
+}
+
+Pixels Load16(const u8* source) {
+    return vmovl_u16(vreinterpret_u16_u8(vld1_u8(source)));
+}
+
+void Store16(u8* dest, Pixels pixels) {
+    vst1_u8(dest, vreinterpret_u8_u16(vmovn_u32(pixels)));
+}
+
+Pixels Load12(const u8* source) {
+    const uint32x2_t low = vreinterpret_u32_u8(vld1_u8(source));
+    return vcombine_u32(low, vdup_n_u32(ReadU32(source + 8)));
+}
+
+void Store12(u8* dest, Pixels pixels) {
+    vst1_u8(dest, vreinterpret_u8_u32(vget_low_u32(pixels)));
+    WriteU32(dest + 8, vgetq_lane_u32(pixels, 2));
+}
+
+Pixels Shuffle(Pixels pixels, const ByteShuffle& shuffle) {
+    return vreinterpretq_u32_u8(vqtbl1q_u8(vreinterpretq_u8_u32(pixels), vld1q_u8(shuffle.data())));
+}
+
+template <int shift>
+Pixels ShiftLeft(Pixels pixels) {
+    return vshlq_n_u32(pixels, shift);
+}
+
+template <int shift>
+Pixels ShiftRight(Pixels pixels) {
+    return vshrq_n_u32(pixels, shift);
+}
+
+Pixels And(Pixels pixels, u32 mask) {
+    return vandq_u32(pixels, vdupq_n_u32(mask));
+}
+
+Pixels Or(Pixels a, Pixels b) {
+    return vorrq_u32(a, b);
+}
+
+Pixels Or(Pixels pixels, u32 value) {
+    return vorrq_u32(pixels, vdupq_n_u32(value));
+}
+
+Pixels Add(Pixels a, Pixels b) {
+    return vaddq_u32(a, b);
+}
+
+Pixels Multiply(Pixels pixels, u32 factor) {
+    return vmulq_n_u32(pixels, factor);
+}
+
+/// Returns the first two pixels of a followed by the first two pixels of b
+Pixels InterleaveLow(Pixels a, Pixels b) {
+    return vcombine_u32(vget_low_u32(a), vget_low_u32(b));
+}
+
+/// Returns the last two pixels of a followed by the last two pixels of b
+Pixels InterleaveHigh(Pixels a, Pixels b) {
+    return vcombine_u32(vget_high_u32(a), vget_high_u32(b));
+}
+#else
+// Without vector instructions the same kernels still copy whole blocks, which the compiler can
+// vectorize on its own.
+using Pixels = std::array<u32, 4>;
+
+Pixels Load(const u8* source) {
+    Pixels pixels;
+    std::memcpy(pixels.data(), source, sizeof(pixels));
+    return pixels;
+}
+
+void Store(u8* dest, Pixels pixels) {
+    std::memcpy(dest, pixels.data(), sizeof(pixels));
+}
+
+Pixels Load16(const u8* source) {
+    std::array<u16, 4> values;
+    std::memcpy(values.data(), source, sizeof(values));
+    return {values[0], values[1], values[2], values[3]};
+}
+
+void Store16(u8* dest, Pixels pixels) {
+    const std::array<u16, 4> values = {static_cast<u16>(pixels[0]), static_cast<u16>(pixels[1]),
+                                       static_cast<u16>(pixels[2]), static_cast<u16>(pixels[3])};
+    std::memcpy(dest, values.data(), sizeof(values));
+}
+
+Pixels Load12(const u8* source) {
+    return {ReadU32(source), ReadU32(source + 4), ReadU32(source + 8), 0};
+}
+
+void Store12(u8* dest, Pixels pixels) {
+    for (u32 i = 0; i < 3; i++) {
+        WriteU32(dest + i * 4, pixels[i]);
+    }
+}
+
+Pixels Shuffle(Pixels pixels, const ByteShuffle& shuffle) {
+    std::array<u8, 16> source, result;
+    std::memcpy(source.data(), pixels.data(), sizeof(pixels));
+    for (std::size_t i = 0; i < result.size(); i++) {
+        result[i] = shuffle[i] < 16 ? source[shuffle[i]] : 0;
+    }
+    return Load(result.data());
+}
+
+template <typename Op>
+Pixels Map(Pixels pixels, Op op) {
+    for (u32& pixel : pixels) {
+        pixel = op(pixel);
+    }
+    return pixels;
+}
+
+template <int shift>
+Pixels ShiftLeft(Pixels pixels) {
+    return Map(pixels, [](u32 pixel) { return pixel << shift; });
+}
+
+template <int shift>
+Pixels ShiftRight(Pixels pixels) {
+    return Map(pixels, [](u32 pixel) { return pixel >> shift; });
+}
+
+Pixels And(Pixels pixels, u32 mask) {
+    return Map(pixels, [mask](u32 pixel) { return pixel & mask; });
+}
+
+Pixels Or(Pixels a, Pixels b) {
+    return {a[0] | b[0], a[1] | b[1], a[2] | b[2], a[3] | b[3]};
+}
+
+Pixels Or(Pixels pixels, u32 value) {
+    return Map(pixels, [value](u32 pixel) { return pixel | value; });
+}
+
+Pixels Add(Pixels a, Pixels b) {
+    return {a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3]};
+}
+
+Pixels Multiply(Pixels pixels, u32 factor) {
+    return Map(pixels, [factor](u32 pixel) { return pixel * factor; });
+}
+
+/// Returns the first two pixels of a followed by the first two pixels of b
+Pixels InterleaveLow(Pixels a, Pixels b) {
+    return {a[0], a[1], b[0], b[1]};
+}
+
+/// Returns the last two pixels of a followed by the last two pixels of b
+Pixels InterleaveHigh(Pixels a, Pixels b) {
+    return {a[2], a[3], b[2], b[3]};
+}
+#endif
+
+/// Reads four consecutive pixels into the low bytes of each lane
+template <u32 bytes_per_pixel>
+Pixels ReadPixels(const u8* source) {
+    if constexpr (bytes_per_pixel == 4) {
+        return Load(source);
+    } else if constexpr (bytes_per_pixel == 2) {
+        return Load16(source);
+    } else {
+        // Only read the 12 bytes of the pixels, the source might end right after them.
+        return Shuffle(Load12(source), UNPACK_24_TO_32);
+    }
+}
+
+/// Writes the low bytes of each lane as four consecutive pixels
+template <u32 bytes_per_pixel>
+void WritePixels(u8* dest, Pixels pixels) {
+    if constexpr (bytes_per_pixel == 4) {
+        Store(dest, pixels);
+    } else if constexpr (bytes_per_pixel == 2) {
+        Store16(dest, pixels);
+    } else {
+        Store12(dest, Shuffle(pixels, PACK_32_TO_24));
+    }
+}
+
+template <u32 bits>
+Pixels ExpandTo8(Pixels value) {
+    return Or(ShiftLeft<8 - bits>(value), ShiftRight<2 * bits - 8>(value));
+}
+
+template <>
+Pixels ExpandTo8<4>(Pixels value) {
+    return Or(ShiftLeft<4>(value), value);
+}
+
+Pixels PackRGBA(Pixels r, Pixels g, Pixels b, Pixels a) {
+    return Or(Or(r, ShiftLeft<8>(g)), Or(ShiftLeft<16>(b), ShiftLeft<24>(a)));
+}
+
+/// Vector version of DecodePixel, converts tiled pixels to their linear representation
+template <PixelFormat format, bool converted>
+Pixels DecodePixels(Pixels pixels) {
+    if constexpr (format == PixelFormat::RGBA8 && converted) {
+        return Shuffle(pixels, SWAP_32);
+    } else if constexpr (format == PixelFormat::RGB8 && converted) {
+        return Or(Shuffle(pixels, SWAP_24), 0xFF000000);
+    } else if constexpr (format == PixelFormat::RGB565 && converted) {
+        const Pixels r = ExpandTo8<5>(ShiftRight<11>(pixels));
+        const Pixels g = ExpandTo8<6>(And(ShiftRight<5>(pixels), 0x3F));
+        const Pixels b = ExpandTo8<5>(And(pixels, 0x1F));
+        return Or(Or(r, ShiftLeft<8>(g)), Or(ShiftLeft<16>(b), 0xFF000000));
+    } else if constexpr (format == PixelFormat::RGB5A1 && converted) {
+        const Pixels r = ExpandTo8<5>(ShiftRight<11>(pixels));
+        const Pixels g = ExpandTo8<5>(And(ShiftRight<6>(pixels), 0x1F));
+        const Pixels b = ExpandTo8<5>(And(ShiftRight<1>(pixels), 0x1F));
+        const Pixels a = Multiply(And(pixels, 1), 0xFF000000);
+        return Or(Or(r, ShiftLeft<8>(g)), Or(ShiftLeft<16>(b), a));
+    } else if constexpr (format == PixelFormat::RGBA4 && converted) {
+        const Pixels r = ExpandTo8<4>(ShiftRight<12>(pixels));
+        const Pixels g = ExpandTo8<4>(And(ShiftRight<8>(pixels), 0xF));
+        const Pixels b = ExpandTo8<4>(And(ShiftRight<4>(pixels), 0xF));
+        const Pixels a = ExpandTo8<4>(And(pixels, 0xF));
+        return PackRGBA(r, g, b, a);
+    } else if constexpr (format == PixelFormat::IA8) {
+        const Pixels intensity = Multiply(ShiftRight<8>(pixels), 0x010101);
+        return Or(intensity, ShiftLeft<24>(And(pixels, 0xFF)));
+    } else if constexpr (format == PixelFormat::D24S8) {
+        return Or(ShiftLeft<8>(pixels), ShiftRight<24>(pixels));
+    } else {
+        return pixels;
+    }
+}
+
+/// Vector version of EncodePixel, converts linear pixels to their tiled representation
+template <PixelFormat format, bool converted>
+Pixels EncodePixels(Pixels pixels) {
+    const auto r = [&] { return And(pixels, 0xFF); };
+    const auto g = [&] { return And(ShiftRight<8>(pixels), 0xFF); };
+    const auto b = [&] { return And(ShiftRight<16>(pixels), 0xFF); };
+    const auto a = [&] { return ShiftRight<24>(pixels); };
+
+    if constexpr (format == PixelFormat::RGBA8 && converted) {
+        return Shuffle(pixels, SWAP_32);
+    } else if constexpr (format == PixelFormat::RGB8 && converted) {
+        return Shuffle(pixels, SWAP_24);
+    } else if constexpr (format == PixelFormat::RGB565 && converted) {
+        return Or(Or(ShiftLeft<11>(ShiftRight<3>(r())), ShiftLeft<5>(ShiftRight<2>(g()))),
+                  ShiftRight<3>(b()));
+    } else if constexpr (format == PixelFormat::RGB5A1 && converted) {
+        return Or(Or(ShiftLeft<11>(ShiftRight<3>(r())), ShiftLeft<6>(ShiftRight<3>(g()))),
+                  Or(ShiftLeft<1>(ShiftRight<3>(b())), ShiftRight<7>(a())));
+    } else if constexpr (format == PixelFormat::RGBA4 && converted) {
+        return Or(Or(ShiftLeft<12>(ShiftRight<4>(r())), ShiftLeft<8>(ShiftRight<4>(g()))),
+                  Or(ShiftLeft<4>(ShiftRight<4>(b())), ShiftRight<4>(a())));
+    } else if constexpr (format == PixelFormat::IA8) {
+        // Divides the sum of the components by three, which is exact for sums below 98304.
+        const Pixels intensity = ShiftRight<17>(Multiply(Add(Add(r(), g()), b()), 0xAAAB));
+        return Or(ShiftLeft<8>(intensity), a());
+    } else if constexpr (format == PixelFormat::D24S8) {
+        return Or(ShiftRight<8>(pixels), ShiftLeft<24>(pixels));
+    } else {
+        return pixels;
+    }
+}
+
+} // Anonymous namespace
+
+template <bool morton_to_linear, PixelFormat format, bool converted>
+void MortonCopyTileVector(u32 stride, u8* tile_buffer, u8* linear_buffer) {
+    static_assert(HasVectorTileCopy<format, converted>());
+    constexpr u32 bytes_per_pixel = GetFormatBpp(format) / 8;
+    constexpr u32 linear_bytes_per_pixel = converted ? 4 : GetFormatBytesPerPixel(format);
+
+    // A tile is made of four 4x4 quads in morton order, which are made of four 2x2 blocks in
+    // morton order in turn. Each block holds two consecutive pixels of two rows, so
+    // interleaving the halves of two blocks yields four consecutive pixels of a row.
+    for (u32 quad = 0; quad < 4; quad++) {
+        u8* const quad_ptr = tile_buffer + quad * 16 * bytes_per_pixel;
+        const u32 x = (quad % 2) * 4;
+        const u32 y = (quad / 2) * 4;
+        const auto linear_row = [&](u32 row) {
+            return linear_buffer + ((7 - y - row) * stride + x) * linear_bytes_per_pixel;
+        };
+        const auto tiled_block = [&](u32 block) { return quad_ptr + block * 4 * bytes_per_pixel; };
+
+        if constexpr (morton_to_linear) {
+            Pixels blocks[4];
+            for (u32 block = 0; block < 4; block++) {
+                blocks[block] = DecodePixels<format, converted>(
+                    ReadPixels<bytes_per_pixel>(tiled_block(block)));
+            }
+            WritePixels<linear_bytes_per_pixel>(linear_row(0),
+                                                InterleaveLow(blocks[0], blocks[1]));
+            WritePixels<linear_bytes_per_pixel>(linear_row(1),
+                                                InterleaveHigh(blocks[0], blocks[1]));
+            WritePixels<linear_bytes_per_pixel>(linear_row(2),
+                                                InterleaveLow(blocks[2], blocks[3]));
+            WritePixels<linear_bytes_per_pixel>(linear_row(3),
+                                                InterleaveHigh(blocks[2], blocks[3]));
+        } else {
+            Pixels rows[4];
+            for (u32 row = 0; row < 4; row++) {
+                rows[row] = ReadPixels<linear_bytes_per_pixel>(linear_row(row));
+            }
+            const Pixels blocks[4] = {
+                InterleaveLow(rows[0], rows[1]),
+                InterleaveHigh(rows[0], rows[1]),
+                InterleaveLow(rows[2], rows[3]),
+                InterleaveHigh(rows[2], rows[3]),
+            };
+            for (u32 block = 0; block < 4; block++) {
+                WritePixels<bytes_per_pixel>(tiled_block(block),
+                                             EncodePixels<format, converted>(blocks[block]));
+            }
+        }
+    }
+}
+
+#define INSTANTIATE_TILE_COPY(format, converted)                                                   \
+    template void MortonCopyTileVector<true, PixelFormat::format, converted>(u32, u8*, u8*);      \
+    template void MortonCopyTileVector<false, PixelFormat::format, converted>(u32, u8*, u8*);
+
+INSTANTIATE_TILE_COPY(RGBA8, false)
+INSTANTIATE_TILE_COPY(RGBA8, true)
+INSTANTIATE_TILE_COPY(RGB8, false)
+INSTANTIATE_TILE_COPY(RGB8, true)
+INSTANTIATE_TILE_COPY(RGB5A1, false)
+INSTANTIATE_TILE_COPY(RGB5A1, true)
+INSTANTIATE_TILE_COPY(RGB565, false)
+INSTANTIATE_TILE_COPY(RGB565, true)
+INSTANTIATE_TILE_COPY(RGBA4, false)
+INSTANTIATE_TILE_COPY(RGBA4, true)
+INSTANTIATE_TILE_COPY(IA8, false)
+INSTANTIATE_TILE_COPY(D24S8, false)
+
+#undef INSTANTIATE_TILE_COPY
+
+} // namespace VideoCore
@@ -0,0 +1,41 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+#include "video_core/rasterizer_cache/pixel_format.h"
+
+namespace VideoCore {
+
+/// Returns true if MortonCopyTileVector is implemented for the format
+template <PixelFormat format, bool converted>
+constexpr bool HasVectorTileCopy() {
+    switch (format) {
+    case PixelFormat::RGBA8:
+    case PixelFormat::RGB8:
+    case PixelFormat::RGB5A1:
+    case PixelFormat::RGB565:
+    case PixelFormat::RGBA4:
+        return true;
+    case PixelFormat::IA8:
+    case PixelFormat::D24S8:
+        // These are always converted, so there are no converted variants of them.
+        return !converted;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Copies an 8x8 tile between the tiled and the linear layout like MortonCopyTile does, but
+ * converts four pixels at once with SSE4.2 or NEON when the build targets them.
+ * @param stride The width in pixels of the linear rectangle the tile is part of
+ * @param tile_buffer The tiled pixel data of the tile
+ * @param linear_buffer The linear pixel data, starting at the lowest row of the tile
+ */
+template <bool morton_to_linear, PixelFormat format, bool converted>
+void MortonCopyTileVector(u32 stride, u8* tile_buffer, u8* linear_buffer);
+
+} // namespace VideoCore
@@ -0,0 +1,94 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "video_core/rasterizer_cache/vertex_buffer_cache.h"
+
+namespace VideoCore {
+
+namespace {
+
+// Number of draws a range must be used in before it is cached.
+constexpr u32 MIN_DRAWS_TO_CACHE = 2;
+// Larger ranges are always streamed, so that a single one can not take over the cache buffer.
+constexpr u32 MAX_CACHED_RANGE_SIZE = 4 * 1024 * 1024;
+// Bound on the ranges that are tracked without being cached.
+constexpr std::size_t MAX_TRACKED_RANGES = 4096;
+
+} // Anonymous namespace
+
+VertexBufferCache::VertexBufferCache(PageCountUpdater update_page_count_)
+    : update_page_count{std::move(update_page_count_)} {}
+
+VertexBufferCache::~VertexBufferCache() = default;
+
+std::optional<u32> VertexBufferCache::Find(PAddr addr, u32 size) const {
+    const auto it = entries.find(addr);
+    if (it == entries.end() || it->second.size < size) {
+        return std::nullopt;
+    }
+    return it->second.offset;
+}
+
+bool VertexBufferCache::ShouldCache(PAddr addr, u32 size) {
+    if (size == 0 || size > MAX_CACHED_RANGE_SIZE || dynamic_ranges.contains(addr)) {
+        return false;
+    }
+    if (candidates.size() >= MAX_TRACKED_RANGES) {
+        candidates.clear();
+    }
+    u32& draws = candidates[addr];
+    if (++draws < MIN_DRAWS_TO_CACHE) {
+        return false;
+    }
+    candidates.erase(addr);
+    return true;
+}
+
+void VertexBufferCache::Insert(PAddr addr, u32 size, u32 offset) {
+    if (const auto it = entries.find(addr); it != entries.end()) {
+        Remove(it);
+    }
+    entries.emplace(addr, Entry{size, offset});
+    max_entry_size = std::max(max_entry_size, size);
+    update_page_count(addr, size, 1);
+}
+
+void VertexBufferCache::InvalidateRegion(PAddr addr, u32 size) {
+    if (entries.empty() || size == 0) {
+        return;
+    }
+    // Entries are sorted by their start, so only the ones that start less than the largest entry
+    // size before the region can reach into it.
+    const PAddr search_start = addr > max_entry_size ? addr - max_entry_size : 0;
+    const PAddr end = addr + size;
+    for (auto it = entries.lower_bound(search_start); it != entries.end() && it->first < end;) {
+        const auto next = std::next(it);
+        if (it->first + it->second.size > addr) {
+            if (dynamic_ranges.size() >= MAX_TRACKED_RANGES) {
+                dynamic_ranges.clear();
+            }
+            dynamic_ranges.insert(it->first);
+            Remove(it);
+        }
+        it = next;
+    }
+}
+
+void VertexBufferCache::Clear(bool release_pages) {
+    if (release_pages) {
+        for (const auto& [addr, entry] : entries) {
+            update_page_count(addr, entry.size, -1);
+        }
+    }
+    entries.clear();
+    max_entry_size = 0;
+}
+
+void VertexBufferCache::Remove(std::map<PAddr, Entry>::iterator it) {
+    update_page_count(it->first, it->second.size, -1);
+    entries.erase(it);
+}
+
+} // namespace VideoCore
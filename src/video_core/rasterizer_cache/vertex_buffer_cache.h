@@ -0,0 +1,71 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include "common/common_types.h"
+
+namespace VideoCore {
+
+/**
+ * Keeps track of guest vertex data that is resident in a GPU buffer, so that draws reading the
+ * same unchanged vertex range can skip copying it again. It is used for index data as well.
+ * Cached ranges mark their pages as cached like surfaces do, so any CPU write to them invalidates
+ * the range. The buffer itself is owned by the backend, which allocates the ranges linearly and
+ * clears the cache when it wraps around. It must be larger than the 4 MiB a single cached range
+ * can take.
+ */
+class VertexBufferCache {
+public:
+    /// Increases or decreases the number of cached resources in the pages of a region
+    using PageCountUpdater = std::function<void(PAddr addr, u32 size, int delta)>;
+
+    explicit VertexBufferCache(PageCountUpdater update_page_count);
+    ~VertexBufferCache();
+
+    /// Returns the buffer offset of the vertex data at addr if at least size bytes are resident
+    [[nodiscard]] std::optional<u32> Find(PAddr addr, u32 size) const;
+
+    /**
+     * Returns true if the vertex data should be uploaded to the cache instead of being streamed.
+     * Ranges are cached when they are drawn with again, unless the CPU has written to them while
+     * they were cached before.
+     */
+    bool ShouldCache(PAddr addr, u32 size);
+
+    /// Records that the vertex data at addr was uploaded to offset in the cache buffer
+    void Insert(PAddr addr, u32 size, u32 offset);
+
+    /// Drops the cached ranges that overlap the region
+    void InvalidateRegion(PAddr addr, u32 size);
+
+    /**
+     * Drops all cached ranges. The page counts are only released when the pages are still
+     * tracked, which is not the case after the surface cache has cleared all of them.
+     */
+    void Clear(bool release_pages = true);
+
+private:
+    struct Entry {
+        u32 size;
+        u32 offset;
+    };
+
+    void Remove(std::map<PAddr, Entry>::iterator it);
+
+    PageCountUpdater update_page_count;
+    std::map<PAddr, Entry> entries;
+    u32 max_entry_size = 0;
+    // Number of draws that used a range which is not cached yet, by its address.
+    std::unordered_map<PAddr, u32> candidates;
+    // Ranges that were written by the CPU, and therefore are streamed every draw.
+    std::unordered_set<PAddr> dynamic_ranges;
+};
+
+} // namespace VideoCore
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <span>
+#include <vector>
 #include "common/common_types.h"
+#include "common/swap.h"
 
 namespace Pica {
 struct OutputVertex;
@@ -28,8 +32,28 @@ enum class LoadCallbackStage {
 };
 using DiskResourceLoadCallback = std::function<void(LoadCallbackStage, std::size_t, std::size_t)>;
 
+/// Compact description of a cached surface, save states store them so that loading can recreate
+/// the surfaces instead of uploading each one the first time it is used.
+struct SurfaceDescriptor {
+    u32_le addr;
+    u16_le width;
+    u16_le height;
+    u16_le stride;
+    u8 levels;
+    u8 pixel_format;
+    u8 is_tiled;
+    u8 texture_type;
+    u8 scaled; ///< Whether the surface was created with the resolution scale factor.
+    u8 reserved;
+};
+static_assert(sizeof(SurfaceDescriptor) == 16, "SurfaceDescriptor should be 16 bytes");
+
 class RasterizerInterface {
 public:
+    /// CPU invalidations up to this size flush and drop the overlapping surfaces instead of only
+    /// marking them invalid, so they have to reach the rasterizer before the CPU write lands.
+    static constexpr u32 MaxFlushingInvalidationSize = 8;
+
     virtual ~RasterizerInterface() = default;
 
     /// Queues the primitive formed by the given vertices for rendering
@@ -55,6 +79,15 @@ public:
     /// Removes as much state as possible from the rasterizer in preparation for a save/load state
     virtual void ClearAll(bool flush) = 0;
 
+    /// Describes up to max_count cached surfaces, most recently used first
+    virtual std::vector<SurfaceDescriptor> GetSurfaceDescriptors(
+        [[maybe_unused]] std::size_t max_count) {
+        return {};
+    }
+
+    /// Creates the described surfaces and uploads them from emulated memory
+    virtual void PrewarmSurfaces([[maybe_unused]] std::span<const SurfaceDescriptor> surfaces) {}
+
     /// Attempt to use a faster method to perform a display transfer with is_texture_copy = 0
     virtual bool AccelerateDisplayTransfer(const Pica::DisplayTransferConfig&) {
         return false;
@@ -89,8 +122,21 @@ public:
         accurate_mul = accurate_mul_;
     }
 
+    /// Sets the color buffers draws are skipped to, zero entries match none
+    void SetSkippedColorBuffers(const std::array<PAddr, 2>& addresses) {
+        skipped_color_buffers = addresses;
+    }
+
+protected:
+    /// Whether draws to the color buffer at the address are skipped
+    [[nodiscard]] bool IsColorBufferSkipped(PAddr address) const {
+        return address != 0 &&
+               (address == skipped_color_buffers[0] || address == skipped_color_buffers[1]);
+    }
+
 protected:
     bool accurate_mul = false;
+    std::array<PAddr, 2> skipped_color_buffers{};
 
     // Rasterizer gets destroyed on reboot, so make the callback
     // static until a better solution is found.
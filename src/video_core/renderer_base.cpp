@@ -44,6 +44,7 @@ void RendererBase::EndFrame() {
     current_frame++;
 
     system.perf_stats->EndSystemFrame();
+    system.PushRPCSubscriptions();
 
     render_window.PollEvents();
 
@@ -51,6 +52,12 @@ void RendererBase::EndFrame() {
     system.perf_stats->BeginSystemFrame();
 }
 
+void RendererBase::ReportTextureMemory(u64 used, u64 budget, u32 evicted) {
+    if (system.perf_stats) {
+        system.perf_stats->ReportTextureMemory(used, budget, evicted);
+    }
+}
+
 bool RendererBase::IsScreenshotPending() const {
     return settings.screenshot_requested;
 }
@@ -72,6 +72,9 @@ public:
     /// Ends the current frame
     void EndFrame();
 
+    /// Reports the texture cache memory usage and evictions of the last frame to the perf stats
+    void ReportTextureMemory(u64 used, u64 budget, u32 evicted);
+
     f32 GetCurrentFPS() const {
         return current_fps;
     }
@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include "common/hash.h"
+#include "common/literals.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "video_core/rasterizer_cache/pixel_format.h"
@@ -11,7 +14,7 @@
 #include "video_core/renderer_opengl/gl_texture_runtime.h"
 
 #include "video_core/host_shaders/format_reinterpreter/d24s8_to_rgba8_frag.h"
-#include "video_core/host_shaders/format_reinterpreter/rgba4_to_rgb5a1_frag.h"
+#include "video_core/host_shaders/format_reinterpreter/rgb16_reinterpret_frag.h"
 #include "video_core/host_shaders/full_screen_triangle_vert.h"
 #include "video_core/host_shaders/texture_filtering/bicubic_frag.h"
 #include "video_core/host_shaders/texture_filtering/mmpx_frag.h"
@@ -23,11 +26,15 @@
 
 namespace OpenGL {
 
+using namespace Common::Literals;
 using Settings::TextureFilter;
 using VideoCore::SurfaceType;
 
 namespace {
 
+/// Memory the cached filtering results may take, the least recently used are dropped beyond it.
+constexpr std::size_t FilterCacheBudget = 64_MiB;
+
 struct TempTexture {
     OGLTexture tex;
     OGLFramebuffer fbo;
@@ -64,7 +71,7 @@ BlitHelper::BlitHelper(const Driver& driver_)
       gradient_y_program{CreateProgram(HostShaders::Y_GRADIENT_FRAG)},
       refine_program{CreateProgram(HostShaders::REFINE_FRAG)},
       d24s8_to_rgba8{CreateProgram(HostShaders::D24S8_TO_RGBA8_FRAG)},
-      rgba4_to_rgb5a1{CreateProgram(HostShaders::RGBA4_TO_RGB5A1_FRAG)} {
+      rgb16_reinterpret{CreateProgram(HostShaders::RGB16_REINTERPRET_FRAG)} {
     vao.Create();
     draw_fbo.Create();
     state.draw.vertex_array = vao.handle;
@@ -138,24 +145,37 @@ bool BlitHelper::ConvertDS24S8ToRGBA8(Surface& source, Surface& dest,
     return true;
 }
 
-bool BlitHelper::ConvertRGBA4ToRGB5A1(Surface& source, Surface& dest,
-                                      const VideoCore::TextureCopy& copy) {
+bool BlitHelper::ReinterpretRGB16(Surface& source, Surface& dest,
+                                  const VideoCore::TextureCopy& copy) {
     OpenGLState prev_state = OpenGLState::GetCurState();
     SCOPE_EXIT({ prev_state.Apply(); });
 
     state.texture_units[0].texture_2d = source.Handle();
+    glProgramUniform1i(rgb16_reinterpret.handle, 2, static_cast<GLint>(source.pixel_format));
+    glProgramUniform1i(rgb16_reinterpret.handle, 3, static_cast<GLint>(dest.pixel_format));
 
     const Common::Rectangle src_rect{copy.src_offset.x, copy.src_offset.y + copy.extent.height,
                                      copy.src_offset.x + copy.extent.width, copy.src_offset.x};
     const Common::Rectangle dst_rect{copy.dst_offset.x, copy.dst_offset.y + copy.extent.height,
                                      copy.dst_offset.x + copy.extent.width, copy.dst_offset.x};
-    SetParams(rgba4_to_rgb5a1, source.RealExtent(), src_rect);
-    Draw(rgba4_to_rgb5a1, dest.Handle(), draw_fbo.handle, 0, dst_rect);
+    SetParams(rgb16_reinterpret, source.RealExtent(), src_rect);
+    Draw(rgb16_reinterpret, dest.Handle(), draw_fbo.handle, 0, dst_rect);
 
     return true;
 }
 
-bool BlitHelper::Filter(Surface& surface, const VideoCore::TextureBlit& blit) {
+bool BlitHelper::IsFilterCacheable(const Surface& surface,
+                                   const VideoCore::TextureBlit& blit) const {
+    // Filters sample past the edges of the blit, only results of whole surfaces are the same
+    // wherever the data is uploaded to.
+    const auto filter = Settings::values.texture_filter.GetValue();
+    const bool is_depth =
+        surface.type == SurfaceType::Depth || surface.type == SurfaceType::DepthStencil;
+    return filter != TextureFilter::NoFilter && !is_depth && surface.res_scale != 1 &&
+           blit.src_level == 0 && blit.src_rect == surface.GetRect();
+}
+
+bool BlitHelper::Filter(Surface& surface, const VideoCore::TextureBlit& blit, u64 content_hash) {
     const auto filter = Settings::values.texture_filter.GetValue();
     const bool is_depth =
         surface.type == SurfaceType::Depth || surface.type == SurfaceType::DepthStencil;
@@ -166,6 +186,18 @@ bool BlitHelper::Filter(Surface& surface, const VideoCore::TextureBlit& blit) {
         return true;
     }
 
+    u64 cache_key = 0;
+    if (content_hash != 0) {
+        const u64 params = static_cast<u64>(surface.pixel_format) | static_cast<u64>(filter) << 8 |
+                           static_cast<u64>(surface.res_scale) << 16 |
+                           static_cast<u64>(surface.width) << 32 |
+                           static_cast<u64>(surface.height) << 48;
+        cache_key = Common::HashCombine(content_hash, params);
+        if (CopyFilterCache(cache_key, surface, blit)) {
+            return true;
+        }
+    }
+
     switch (filter) {
     case TextureFilter::Anime4K:
         FilterAnime4K(surface, blit);
@@ -186,9 +218,59 @@ bool BlitHelper::Filter(Surface& surface, const VideoCore::TextureBlit& blit) {
         LOG_ERROR(Render_OpenGL, "Unknown texture filter {}", filter);
     }
 
+    if (cache_key != 0) {
+        InsertFilterCache(cache_key, surface, blit);
+    }
     return true;
 }
 
+bool BlitHelper::CopyFilterCache(u64 key, Surface& surface, const VideoCore::TextureBlit& blit) {
+    const auto it = std::find_if(filter_cache.begin(), filter_cache.end(),
+                                 [key](const FilterCacheEntry& entry) { return entry.key == key; });
+    if (it == filter_cache.end()) {
+        return false;
+    }
+    it->last_use = ++filter_cache_tick;
+    glCopyImageSubData(it->texture.handle, GL_TEXTURE_2D, 0, 0, 0, 0, surface.Handle(),
+                       GL_TEXTURE_2D, blit.dst_level, blit.dst_rect.left, blit.dst_rect.bottom, 0,
+                       blit.dst_rect.GetWidth(), blit.dst_rect.GetHeight(), 1);
+    return true;
+}
+
+void BlitHelper::InsertFilterCache(u64 key, Surface& surface, const VideoCore::TextureBlit& blit) {
+    const u32 width = blit.dst_rect.GetWidth();
+    const u32 height = blit.dst_rect.GetHeight();
+    const std::size_t size = std::size_t{width} * height * surface.GetInternalBytesPerPixel();
+    if (size > FilterCacheBudget / 4) {
+        return;
+    }
+    while (filter_cache_size + size > FilterCacheBudget) {
+        const auto oldest = std::min_element(
+            filter_cache.begin(), filter_cache.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.last_use < rhs.last_use; });
+        filter_cache_size -= oldest->size;
+        filter_cache.erase(oldest);
+    }
+
+    OGLTexture texture;
+    texture.Create();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, texture.handle);
+    glTexStorage2D(GL_TEXTURE_2D, 1, surface.Tuple().internal_format, width, height);
+    glBindTexture(GL_TEXTURE_2D, OpenGLState::GetCurState().texture_units[1].texture_2d);
+    glCopyImageSubData(surface.Handle(), GL_TEXTURE_2D, blit.dst_level, blit.dst_rect.left,
+                       blit.dst_rect.bottom, 0, texture.handle, GL_TEXTURE_2D, 0, 0, 0, 0, width,
+                       height, 1);
+
+    filter_cache.push_back({
+        .key = key,
+        .last_use = ++filter_cache_tick,
+        .size = size,
+        .texture = std::move(texture),
+    });
+    filter_cache_size += size;
+}
+
 void BlitHelper::FilterAnime4K(Surface& surface, const VideoCore::TextureBlit& blit) {
     static constexpr u8 internal_scale_factor = 2;
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <vector>
 #include "common/math_util.h"
 #include "video_core/rasterizer_cache/utils.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
@@ -25,11 +26,20 @@ public:
     explicit BlitHelper(const Driver& driver);
     ~BlitHelper();
 
-    bool Filter(Surface& surface, const VideoCore::TextureBlit& blit);
+    /// Whether the result of filtering the blit only depends on the uploaded data
+    [[nodiscard]] bool IsFilterCacheable(const Surface& surface,
+                                         const VideoCore::TextureBlit& blit) const;
+
+    /**
+     * Scales the blit with the texture filter, returns false when no filter applies.
+     * @param content_hash Hash of the uploaded data to reuse earlier results of, 0 for none.
+     */
+    bool Filter(Surface& surface, const VideoCore::TextureBlit& blit, u64 content_hash = 0);
 
     bool ConvertDS24S8ToRGBA8(Surface& source, Surface& dest, const VideoCore::TextureCopy& copy);
 
-    bool ConvertRGBA4ToRGB5A1(Surface& source, Surface& dest, const VideoCore::TextureCopy& copy);
+    /// Reinterprets the bits of a 16-bit color surface (RGB5A1, RGB565 or RGBA4) as another one.
+    bool ReinterpretRGB16(Surface& source, Surface& dest, const VideoCore::TextureCopy& copy);
 
 private:
     void FilterAnime4K(Surface& surface, const VideoCore::TextureBlit& blit);
@@ -38,12 +48,23 @@ private:
     void FilterXbrz(Surface& surface, const VideoCore::TextureBlit& blit);
     void FilterMMPX(Surface& surface, const VideoCore::TextureBlit& blit);
 
+    /// Copies the cached result for the key to the blit destination, returns false on a miss
+    bool CopyFilterCache(u64 key, Surface& surface, const VideoCore::TextureBlit& blit);
+    void InsertFilterCache(u64 key, Surface& surface, const VideoCore::TextureBlit& blit);
+
     void SetParams(OGLProgram& program, const VideoCore::Extent& src_extent,
                    Common::Rectangle<u32> src_rect);
     void Draw(OGLProgram& program, GLuint dst_tex, GLuint dst_fbo, u32 dst_level,
               Common::Rectangle<u32> dst_rect);
 
 private:
+    struct FilterCacheEntry {
+        u64 key;
+        u64 last_use;
+        std::size_t size;
+        OGLTexture texture;
+    };
+
     const Driver& driver;
     OGLVertexArray vao;
     OpenGLState state;
@@ -59,11 +80,15 @@ private:
     OGLProgram gradient_y_program;
     OGLProgram refine_program;
     OGLProgram d24s8_to_rgba8;
-    OGLProgram rgba4_to_rgb5a1;
+    OGLProgram rgb16_reinterpret;
 
     OGLTexture temp_tex;
     VideoCore::Extent temp_extent{};
     bool use_texture_view{true};
+
+    std::vector<FilterCacheEntry> filter_cache;
+    std::size_t filter_cache_size{};
+    u64 filter_cache_tick{};
 };
 
 } // namespace OpenGL
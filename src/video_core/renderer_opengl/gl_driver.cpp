@@ -177,6 +177,9 @@ void Driver::CheckExtensionSupport() {
     nv_fragment_shader_interlock = GLAD_GL_NV_fragment_shader_interlock;
     intel_fragment_shader_ordering = GLAD_GL_INTEL_fragment_shader_ordering;
     blend_minmax_factor = GLAD_GL_AMD_blend_minmax_factor || GLAD_GL_NV_blend_minmax_factor;
+    parallel_shader_compile = GLAD_GL_KHR_parallel_shader_compile;
+    use_bindless_textures =
+        GLAD_GL_ARB_bindless_texture && Settings::values.bindless_textures.GetValue();
     is_suitable = GLAD_GL_VERSION_4_3 || GLAD_GL_ES_VERSION_3_2;
 }
 
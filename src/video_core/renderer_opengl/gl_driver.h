@@ -69,6 +69,16 @@ public:
         return gpu_vendor;
     }
 
+    /// Returns the gpu model string returned by the driver
+    std::string_view GetModelString() const {
+        return gpu_model;
+    }
+
+    /// Returns the version string returned by the driver
+    std::string_view GetVersionString() const {
+        return gl_version;
+    }
+
     /// Returns true if the an OpenGLES context is used
     bool IsOpenGLES() const noexcept {
         return is_gles;
@@ -134,6 +144,16 @@ public:
         return blend_minmax_factor;
     }
 
+    /// Returns true if the implementation supports KHR_parallel_shader_compile
+    bool HasParallelShaderCompile() const {
+        return parallel_shader_compile;
+    }
+
+    /// Returns true if textures are referenced through ARB_bindless_texture handles
+    bool UseBindlessTextures() const {
+        return use_bindless_textures;
+    }
+
 private:
     void ReportDriverInfo();
     void DeduceGLES();
@@ -160,6 +180,8 @@ private:
     bool nv_fragment_shader_interlock{};
     bool intel_fragment_shader_ordering{};
     bool blend_minmax_factor{};
+    bool parallel_shader_compile{};
+    bool use_bindless_textures{};
 
     std::string_view gl_version{};
     std::string_view gpu_vendor{};
@@ -25,12 +25,17 @@ MICROPROFILE_DEFINE(OpenGL_VS, "OpenGL", "Vertex Shader Setup", MP_RGB(192, 128,
 MICROPROFILE_DEFINE(OpenGL_GS, "OpenGL", "Geometry Shader Setup", MP_RGB(128, 192, 128));
 MICROPROFILE_DEFINE(OpenGL_Drawing, "OpenGL", "Drawing", MP_RGB(128, 128, 192));
 MICROPROFILE_DEFINE(OpenGL_Display, "OpenGL", "Display", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(OpenGL_SyncRasterState, "OpenGL", "Sync Raster State", MP_RGB(192, 128, 64));
+MICROPROFILE_DEFINE(OpenGL_SyncBlendState, "OpenGL", "Sync Blend State", MP_RGB(192, 128, 64));
+MICROPROFILE_DEFINE(OpenGL_SyncDepthStencilState, "OpenGL", "Sync Depth Stencil State",
+                    MP_RGB(192, 128, 64));
 
 using VideoCore::SurfaceType;
 using namespace Common::Literals;
 using namespace Pica::Shader::Generator;
 
 constexpr std::size_t VERTEX_BUFFER_SIZE = 16_MiB;
+constexpr std::size_t VERTEX_CACHE_BUFFER_SIZE = 32_MiB;
 constexpr std::size_t INDEX_BUFFER_SIZE = 2_MiB;
 constexpr std::size_t UNIFORM_BUFFER_SIZE = 8_MiB;
 constexpr std::size_t TEXTURE_BUFFER_SIZE = 2_MiB;
@@ -50,6 +55,18 @@ GLenum MakePrimitiveMode(Pica::PipelineRegs::TriangleTopology topology) {
     return GL_TRIANGLES;
 }
 
+/// Returns the primitive mode that feeds each geometry shader invocation its input vertices
+GLenum MakeGSInputMode(const Pica::RegsInternal& regs) {
+    switch (GetGSVerticesPerPrimitive(regs)) {
+    case 1:
+        return GL_POINTS;
+    case 2:
+        return GL_LINES;
+    default:
+        return GL_TRIANGLES;
+    }
+}
+
 GLenum MakeAttributeType(Pica::PipelineRegs::VertexAttributeFormat format) {
     switch (format) {
     case Pica::PipelineRegs::VertexAttributeFormat::BYTE:
@@ -87,7 +104,11 @@ RasterizerOpenGL::RasterizerOpenGL(Memory::MemorySystem& memory, Pica::PicaCore&
     : VideoCore::RasterizerAccelerated{memory, pica}, driver{driver_},
       render_window{renderer.GetRenderWindow()}, runtime{driver, renderer},
       res_cache{memory, custom_tex_manager, runtime, regs, renderer},
+      vertex_buffer_cache{[this](PAddr addr, u32 size, int delta) {
+          res_cache.UpdatePagesCachedCount(addr, size, delta);
+      }},
       vertex_buffer{driver, GL_ARRAY_BUFFER, VERTEX_BUFFER_SIZE},
+      vertex_cache_buffer{driver, GL_ARRAY_BUFFER, VERTEX_CACHE_BUFFER_SIZE},
       uniform_buffer{driver, GL_UNIFORM_BUFFER, UNIFORM_BUFFER_SIZE},
       index_buffer{driver, GL_ELEMENT_ARRAY_BUFFER, INDEX_BUFFER_SIZE},
       texture_buffer{driver, GL_TEXTURE_BUFFER, TextureBufferSize(driver, false)},
@@ -107,6 +128,14 @@ RasterizerOpenGL::RasterizerOpenGL(Memory::MemorySystem& memory, Pica::PicaCore&
         Common::AlignUp<std::size_t>(sizeof(VSUniformData), uniform_buffer_alignment);
     uniform_size_aligned_fs =
         Common::AlignUp<std::size_t>(sizeof(FSUniformData), uniform_buffer_alignment);
+    uniform_size_aligned_textures =
+        Common::AlignUp<std::size_t>(sizeof(texture_handles), uniform_buffer_alignment);
+    use_bindless_textures = driver.UseBindlessTextures();
+    if (use_bindless_textures) {
+        // Units without a texture are given this one, as a null handle must not be sampled.
+        null_texture.Create();
+        null_texture.Allocate(GL_TEXTURE_2D, 1, GL_RGBA8, 1, 1);
+    }
 
     // Set vertex attributes for software shader path
     state.draw.vertex_array = sw_vao.handle;
@@ -172,6 +201,10 @@ void RasterizerOpenGL::TickFrame() {
     res_cache.TickFrame();
 }
 
+u32 RasterizerOpenGL::GetAndResetShaderCompiles() {
+    return curr_shader_manager ? curr_shader_manager->GetAndResetShaderCompiles() : 0;
+}
+
 void RasterizerOpenGL::LoadDefaultDiskResources(
     const std::atomic_bool& stop_loading, const VideoCore::DiskResourceLoadCallback& callback) {
     // First element in vector is the default one and cannot be removed.
@@ -255,112 +288,129 @@ void RasterizerOpenGL::SwitchDiskResources(u64 title_id) {
 }
 
 void RasterizerOpenGL::SyncDrawState() {
-    SyncDrawUniforms();
-
-    // SyncClipEnabled();
-    state.clip_distance[1] = regs.rasterizer.clip_enable != 0;
-    // SyncCullMode();
-    state.cull.enabled = regs.rasterizer.cull_mode != Pica::RasterizerRegs::CullMode::KeepAll;
-    if (state.cull.enabled) {
-        state.cull.front_face =
-            regs.rasterizer.cull_mode == Pica::RasterizerRegs::CullMode::KeepClockWise ? GL_CW
-                                                                                       : GL_CCW;
+    // Fixed function state is only rebuilt from the registers written since the last draw.
+    // The dirty registers are reset when syncing the uniforms, so it has to come last.
+    const auto& dirty = pica.dirty_regs;
+    if (dirty.CheckRasterState()) {
+        MICROPROFILE_SCOPE(OpenGL_SyncRasterState);
+        // SyncClipEnabled();
+        state.clip_distance[1] = regs.rasterizer.clip_enable != 0;
+        // SyncCullMode();
+        state.cull.enabled = regs.rasterizer.cull_mode != Pica::RasterizerRegs::CullMode::KeepAll;
+        if (state.cull.enabled) {
+            state.cull.front_face =
+                regs.rasterizer.cull_mode == Pica::RasterizerRegs::CullMode::KeepClockWise
+                    ? GL_CW
+                    : GL_CCW;
+        }
+        // If the framebuffer is flipped, vertex shader flips vertex y, so invert culling
+        const bool is_flipped = regs.framebuffer.framebuffer.IsFlipped();
+        state.cull.mode = is_flipped && state.cull.enabled ? GL_FRONT : GL_BACK;
     }
-    // If the framebuffer is flipped, vertex shader flips vertex y, so invert culling
-    const bool is_flipped = regs.framebuffer.framebuffer.IsFlipped();
-    state.cull.mode = is_flipped && state.cull.enabled ? GL_FRONT : GL_BACK;
-    // SyncBlendEnabled();
-    state.blend.enabled = (regs.framebuffer.output_merger.alphablend_enable == 1);
-    // SyncBlendFuncs();
-    const bool has_minmax_factor = driver.HasBlendMinMaxFactor();
-    state.blend.rgb_equation = PicaToGL::BlendEquation(
-        regs.framebuffer.output_merger.alpha_blending.blend_equation_rgb, has_minmax_factor);
-    state.blend.a_equation = PicaToGL::BlendEquation(
-        regs.framebuffer.output_merger.alpha_blending.blend_equation_a, has_minmax_factor);
-    state.blend.src_rgb_func =
-        PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_source_rgb);
-    state.blend.dst_rgb_func =
-        PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_dest_rgb);
-    state.blend.src_a_func =
-        PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_source_a);
-    state.blend.dst_a_func =
-        PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_dest_a);
-    if (!has_minmax_factor) {
-        // Blending with min/max equations is emulated in the fragment shader so
-        // configure blending to not modify the incoming fragment color.
-        emulate_minmax_blend = false;
-        if (state.EmulateColorBlend()) {
-            emulate_minmax_blend = true;
-            state.blend.rgb_equation = GL_FUNC_ADD;
-            state.blend.src_rgb_func = GL_ONE;
-            state.blend.dst_rgb_func = GL_ZERO;
+
+    if (dirty.CheckBlendState()) {
+        MICROPROFILE_SCOPE(OpenGL_SyncBlendState);
+        // SyncBlendEnabled();
+        state.blend.enabled = (regs.framebuffer.output_merger.alphablend_enable == 1);
+        // SyncBlendFuncs();
+        const bool has_minmax_factor = driver.HasBlendMinMaxFactor();
+        state.blend.rgb_equation = PicaToGL::BlendEquation(
+            regs.framebuffer.output_merger.alpha_blending.blend_equation_rgb, has_minmax_factor);
+        state.blend.a_equation = PicaToGL::BlendEquation(
+            regs.framebuffer.output_merger.alpha_blending.blend_equation_a, has_minmax_factor);
+        state.blend.src_rgb_func =
+            PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_source_rgb);
+        state.blend.dst_rgb_func =
+            PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_dest_rgb);
+        state.blend.src_a_func =
+            PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_source_a);
+        state.blend.dst_a_func =
+            PicaToGL::BlendFunc(regs.framebuffer.output_merger.alpha_blending.factor_dest_a);
+        if (!has_minmax_factor) {
+            // Blending with min/max equations is emulated in the fragment shader so
+            // configure blending to not modify the incoming fragment color.
+            emulate_minmax_blend = false;
+            if (state.EmulateColorBlend()) {
+                emulate_minmax_blend = true;
+                state.blend.rgb_equation = GL_FUNC_ADD;
+                state.blend.src_rgb_func = GL_ONE;
+                state.blend.dst_rgb_func = GL_ZERO;
+            }
+            if (state.EmulateAlphaBlend()) {
+                emulate_minmax_blend = true;
+                state.blend.a_equation = GL_FUNC_ADD;
+                state.blend.src_a_func = GL_ONE;
+                state.blend.dst_a_func = GL_ZERO;
+            }
         }
-        if (state.EmulateAlphaBlend()) {
-            emulate_minmax_blend = true;
-            state.blend.a_equation = GL_FUNC_ADD;
-            state.blend.src_a_func = GL_ONE;
-            state.blend.dst_a_func = GL_ZERO;
+        // SyncBlendColor();
+        const auto blend_color =
+            PicaToGL::ColorRGBA8(regs.framebuffer.output_merger.blend_const.raw);
+        state.blend.color.red = blend_color[0];
+        state.blend.color.green = blend_color[1];
+        state.blend.color.blue = blend_color[2];
+        state.blend.color.alpha = blend_color[3];
+        // SyncLogicOp();
+        // SyncColorWriteMask();
+        state.logic_op = PicaToGL::LogicOp(regs.framebuffer.output_merger.logic_op);
+        if (driver.IsOpenGLES() && !regs.framebuffer.output_merger.alphablend_enable &&
+            regs.framebuffer.output_merger.logic_op == Pica::FramebufferRegs::LogicOp::NoOp) {
+            // Color output is disabled by logic operation. We use color write mask to skip
+            // color but allow depth write.
+            state.color_mask = {};
+        } else {
+            auto is_color_write_enabled = [&](u32 value) {
+                return (regs.framebuffer.framebuffer.allow_color_write != 0 && value != 0)
+                           ? GL_TRUE
+                           : GL_FALSE;
+            };
+            state.color_mask.red_enabled =
+                is_color_write_enabled(regs.framebuffer.output_merger.red_enable);
+            state.color_mask.green_enabled =
+                is_color_write_enabled(regs.framebuffer.output_merger.green_enable);
+            state.color_mask.blue_enabled =
+                is_color_write_enabled(regs.framebuffer.output_merger.blue_enable);
+            state.color_mask.alpha_enabled =
+                is_color_write_enabled(regs.framebuffer.output_merger.alpha_enable);
         }
     }
-    // SyncBlendColor();
-    const auto blend_color = PicaToGL::ColorRGBA8(regs.framebuffer.output_merger.blend_const.raw);
-    state.blend.color.red = blend_color[0];
-    state.blend.color.green = blend_color[1];
-    state.blend.color.blue = blend_color[2];
-    state.blend.color.alpha = blend_color[3];
-    // SyncLogicOp();
-    // SyncColorWriteMask();
-    state.logic_op = PicaToGL::LogicOp(regs.framebuffer.output_merger.logic_op);
-    if (driver.IsOpenGLES() && !regs.framebuffer.output_merger.alphablend_enable &&
-        regs.framebuffer.output_merger.logic_op == Pica::FramebufferRegs::LogicOp::NoOp) {
-        // Color output is disabled by logic operation. We use color write mask to skip
-        // color but allow depth write.
-        state.color_mask = {};
-    } else {
-        auto is_color_write_enabled = [&](u32 value) {
-            return (regs.framebuffer.framebuffer.allow_color_write != 0 && value != 0) ? GL_TRUE
-                                                                                       : GL_FALSE;
-        };
-        state.color_mask.red_enabled =
-            is_color_write_enabled(regs.framebuffer.output_merger.red_enable);
-        state.color_mask.green_enabled =
-            is_color_write_enabled(regs.framebuffer.output_merger.green_enable);
-        state.color_mask.blue_enabled =
-            is_color_write_enabled(regs.framebuffer.output_merger.blue_enable);
-        state.color_mask.alpha_enabled =
-            is_color_write_enabled(regs.framebuffer.output_merger.alpha_enable);
+
+    if (dirty.CheckDepthStencilState()) {
+        MICROPROFILE_SCOPE(OpenGL_SyncDepthStencilState);
+        // SyncStencilTest();
+        state.stencil.test_enabled =
+            regs.framebuffer.output_merger.stencil_test.enable &&
+            regs.framebuffer.framebuffer.depth_format == Pica::FramebufferRegs::DepthFormat::D24S8;
+        state.stencil.test_func =
+            PicaToGL::CompareFunc(regs.framebuffer.output_merger.stencil_test.func);
+        state.stencil.test_ref = regs.framebuffer.output_merger.stencil_test.reference_value;
+        state.stencil.test_mask = regs.framebuffer.output_merger.stencil_test.input_mask;
+        state.stencil.action_stencil_fail =
+            PicaToGL::StencilOp(regs.framebuffer.output_merger.stencil_test.action_stencil_fail);
+        state.stencil.action_depth_fail =
+            PicaToGL::StencilOp(regs.framebuffer.output_merger.stencil_test.action_depth_fail);
+        state.stencil.action_depth_pass =
+            PicaToGL::StencilOp(regs.framebuffer.output_merger.stencil_test.action_depth_pass);
+        // SyncDepthTest();
+        state.depth.test_enabled = regs.framebuffer.output_merger.depth_test_enable == 1 ||
+                                   regs.framebuffer.output_merger.depth_write_enable == 1;
+        state.depth.test_func =
+            regs.framebuffer.output_merger.depth_test_enable == 1
+                ? PicaToGL::CompareFunc(regs.framebuffer.output_merger.depth_test_func)
+                : GL_ALWAYS;
+        // SyncStencilWriteMask();
+        state.stencil.write_mask =
+            (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
+                ? static_cast<GLuint>(regs.framebuffer.output_merger.stencil_test.write_mask)
+                : 0;
+        // SyncDepthWriteMask();
+        state.depth.write_mask = (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0 &&
+                                  regs.framebuffer.output_merger.depth_write_enable)
+                                     ? GL_TRUE
+                                     : GL_FALSE;
     }
-    // SyncStencilTest();
-    state.stencil.test_enabled =
-        regs.framebuffer.output_merger.stencil_test.enable &&
-        regs.framebuffer.framebuffer.depth_format == Pica::FramebufferRegs::DepthFormat::D24S8;
-    state.stencil.test_func =
-        PicaToGL::CompareFunc(regs.framebuffer.output_merger.stencil_test.func);
-    state.stencil.test_ref = regs.framebuffer.output_merger.stencil_test.reference_value;
-    state.stencil.test_mask = regs.framebuffer.output_merger.stencil_test.input_mask;
-    state.stencil.action_stencil_fail =
-        PicaToGL::StencilOp(regs.framebuffer.output_merger.stencil_test.action_stencil_fail);
-    state.stencil.action_depth_fail =
-        PicaToGL::StencilOp(regs.framebuffer.output_merger.stencil_test.action_depth_fail);
-    state.stencil.action_depth_pass =
-        PicaToGL::StencilOp(regs.framebuffer.output_merger.stencil_test.action_depth_pass);
-    // SyncDepthTest();
-    state.depth.test_enabled = regs.framebuffer.output_merger.depth_test_enable == 1 ||
-                               regs.framebuffer.output_merger.depth_write_enable == 1;
-    state.depth.test_func =
-        regs.framebuffer.output_merger.depth_test_enable == 1
-            ? PicaToGL::CompareFunc(regs.framebuffer.output_merger.depth_test_func)
-            : GL_ALWAYS;
-    // SyncStencilWriteMask();
-    state.stencil.write_mask =
-        (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
-            ? static_cast<GLuint>(regs.framebuffer.output_merger.stencil_test.write_mask)
-            : 0;
-    // SyncDepthWriteMask();
-    state.depth.write_mask = (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0 &&
-                              regs.framebuffer.output_merger.depth_write_enable)
-                                 ? GL_TRUE
-                                 : GL_FALSE;
+
+    SyncDrawUniforms();
 }
 
 void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
@@ -380,6 +430,21 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
             continue;
         }
 
+        const PAddr data_addr =
+            base_address + loader.data_offset + (vs_input_index_min * loader.byte_count);
+
+        const u32 vertex_num = vs_input_index_max - vs_input_index_min + 1;
+        const u32 data_size = loader.byte_count * vertex_num;
+
+        res_cache.FlushRegion(data_addr, data_size);
+
+        // Static vertex data is read from the vertex cache, everything else is streamed.
+        const auto cached_offset = LoadCachedVertices(data_addr, data_size);
+        const GLintptr loader_offset = cached_offset ? *cached_offset : buffer_offset;
+        state.draw.vertex_buffer =
+            cached_offset ? vertex_cache_buffer.GetHandle() : vertex_buffer.GetHandle();
+        state.Apply();
+
         u32 offset = 0;
         for (u32 comp = 0; comp < loader.component_count && comp < 12; ++comp) {
             u32 attribute_index = loader.GetComponent(comp);
@@ -393,7 +458,7 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
                     GLenum type = MakeAttributeType(vertex_attributes.GetFormat(attribute_index));
                     GLsizei stride = loader.byte_count;
                     glVertexAttribPointer(input_reg, size, type, GL_FALSE, stride,
-                                          reinterpret_cast<GLvoid*>(buffer_offset + offset));
+                                          reinterpret_cast<GLvoid*>(loader_offset + offset));
                     enable_attributes[input_reg] = true;
 
                     offset += vertex_attributes.GetStride(attribute_index);
@@ -406,19 +471,19 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
             }
         }
 
-        const PAddr data_addr =
-            base_address + loader.data_offset + (vs_input_index_min * loader.byte_count);
-
-        const u32 vertex_num = vs_input_index_max - vs_input_index_min + 1;
-        const u32 data_size = loader.byte_count * vertex_num;
-
-        res_cache.FlushRegion(data_addr, data_size);
+        if (cached_offset) {
+            continue;
+        }
         std::memcpy(array_ptr, memory.GetPhysicalPointer(data_addr), data_size);
 
         array_ptr += data_size;
         buffer_offset += data_size;
     }
 
+    // The stream buffer is unmapped once the draw is set up, which requires it to be bound.
+    state.draw.vertex_buffer = vertex_buffer.GetHandle();
+    state.Apply();
+
     for (std::size_t i = 0; i < enable_attributes.size(); ++i) {
         if (enable_attributes[i] != hw_vao_enabled_attributes[i]) {
             if (enable_attributes[i]) {
@@ -440,6 +505,28 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
     }
 }
 
+std::optional<GLintptr> RasterizerOpenGL::LoadCachedVertices(PAddr addr, u32 size) {
+    if (const auto offset = vertex_buffer_cache.Find(addr, size)) {
+        return static_cast<GLintptr>(*offset);
+    }
+    if (!vertex_buffer_cache.ShouldCache(addr, size)) {
+        return std::nullopt;
+    }
+
+    state.draw.vertex_buffer = vertex_cache_buffer.GetHandle();
+    state.Apply();
+
+    const auto [data, offset, invalidate] = vertex_cache_buffer.Map(size, 4);
+    if (invalidate) {
+        vertex_buffer_cache.Clear();
+    }
+    std::memcpy(data, memory.GetPhysicalPointer(addr), size);
+    vertex_cache_buffer.Unmap(size);
+
+    vertex_buffer_cache.Insert(addr, size, static_cast<u32>(offset));
+    return offset;
+}
+
 bool RasterizerOpenGL::SetupVertexShader() {
     MICROPROFILE_SCOPE(OpenGL_VS);
     return curr_shader_manager->UseProgrammableVertexShader(regs, pica.vs_setup, accurate_mul);
@@ -449,8 +536,8 @@ bool RasterizerOpenGL::SetupGeometryShader() {
     MICROPROFILE_SCOPE(OpenGL_GS);
 
     if (regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No) {
-        LOG_ERROR(Render_OpenGL, "Accelerate draw doesn't support geometry shader");
-        return false;
+        return curr_shader_manager->UseProgrammableGeometryShader(regs, pica.gs_setup,
+                                                                  accurate_mul);
     }
 
     // Enable the quaternion fix-up geometry-shader only if we are actually doing per-fragment
@@ -467,7 +554,7 @@ bool RasterizerOpenGL::SetupGeometryShader() {
 
 bool RasterizerOpenGL::AccelerateDrawBatch(bool is_indexed) {
     if (regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No) {
-        if (regs.pipeline.gs_config.mode != Pica::PipelineRegs::GSMode::Point) {
+        if (GetGSVerticesPerPrimitive(regs) == 0) {
             return false;
         }
         if (regs.pipeline.triangle_topology != Pica::PipelineRegs::TriangleTopology::Shader) {
@@ -487,7 +574,9 @@ bool RasterizerOpenGL::AccelerateDrawBatch(bool is_indexed) {
 }
 
 bool RasterizerOpenGL::AccelerateDrawBatchInternal(bool is_indexed) {
-    const GLenum primitive_mode = MakePrimitiveMode(regs.pipeline.triangle_topology);
+    const GLenum primitive_mode = regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No
+                                      ? MakeGSInputMode(regs)
+                                      : MakePrimitiveMode(regs.pipeline.triangle_topology);
     auto [vs_input_index_min, vs_input_index_max, vs_input_size] = AnalyzeVertexArray(is_indexed);
 
     if (vs_input_size > VERTEX_BUFFER_SIZE) {
@@ -541,6 +630,11 @@ void RasterizerOpenGL::DrawTriangles() {
 
 bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
     MICROPROFILE_SCOPE(OpenGL_Drawing);
+    // Right eye images that are never shown are not drawn at all.
+    if (IsColorBufferSkipped(regs.framebuffer.framebuffer.GetColorBufferPhysicalAddress())) {
+        vertex_batch.clear();
+        return true;
+    }
     SyncDrawState();
 
     const bool shadow_rendering = regs.framebuffer.IsShadowRendering();
@@ -708,6 +802,52 @@ void RasterizerOpenGL::SyncTextureUnits(const Framebuffer* framebuffer) {
     if (emulate_minmax_blend && !driver.HasShaderFramebufferFetch()) {
         state.color_buffer.texture_2d = framebuffer->Attachment(SurfaceType::Color);
     }
+
+    if (use_bindless_textures) {
+        SyncTextureHandles();
+    }
+}
+
+void RasterizerOpenGL::SyncTextureHandles() {
+    // Handles of deleted textures are freed with them, and their names may be reused.
+    if (texture_handle_generation != runtime.TextureGeneration()) {
+        texture_handle_generation = runtime.TextureGeneration();
+        texture_handle_cache.clear();
+    }
+
+    for (u32 texture_index = 0; texture_index < texture_handles.size(); ++texture_index) {
+        auto& unit = state.texture_units[texture_index];
+        const GLuint64 handle = unit.texture_2d
+                                    ? GetTextureHandle(unit.texture_2d, unit.sampler)
+                                    : GetTextureHandle(null_texture.handle, 0);
+        if (texture_handles[texture_index] != handle) {
+            texture_handles[texture_index] = handle;
+            texture_handles_dirty = true;
+        }
+
+        // The shaders read the handles instead, so the units are left as they are.
+        unit.texture_2d = 0;
+        unit.sampler = 0;
+        unit.target = GL_TEXTURE_2D;
+    }
+}
+
+GLuint64 RasterizerOpenGL::GetTextureHandle(GLuint texture, GLuint sampler) {
+    const u64 key = static_cast<u64>(texture) << 32 | sampler;
+    auto [it, is_new] = texture_handle_cache.try_emplace(key);
+    if (!is_new) {
+        return it->second;
+    }
+
+    // A handle is unique to its texture and sampler, and may still be resident from before the
+    // cache was last cleared.
+    const GLuint64 handle =
+        sampler ? glGetTextureSamplerHandleARB(texture, sampler) : glGetTextureHandleARB(texture);
+    if (!glIsTextureHandleResidentARB(handle)) {
+        glMakeTextureHandleResidentARB(handle);
+    }
+    it->second = handle;
+    return handle;
 }
 
 void RasterizerOpenGL::BindShadowCube(const Pica::TexturingRegs::FullTextureConfig& texture) {
@@ -801,15 +941,28 @@ void RasterizerOpenGL::FlushRegion(PAddr addr, u32 size) {
 
 void RasterizerOpenGL::InvalidateRegion(PAddr addr, u32 size) {
     res_cache.InvalidateRegion(addr, size);
+    vertex_buffer_cache.InvalidateRegion(addr, size);
 }
 
 void RasterizerOpenGL::FlushAndInvalidateRegion(PAddr addr, u32 size) {
     res_cache.FlushRegion(addr, size);
     res_cache.InvalidateRegion(addr, size);
+    vertex_buffer_cache.InvalidateRegion(addr, size);
 }
 
 void RasterizerOpenGL::ClearAll(bool flush) {
     res_cache.ClearAll(flush);
+    // The surface cache has released every cached page, including the ones of vertex data.
+    vertex_buffer_cache.Clear(false);
+}
+
+std::vector<VideoCore::SurfaceDescriptor> RasterizerOpenGL::GetSurfaceDescriptors(
+    std::size_t max_count) {
+    return res_cache.GetSurfaceDescriptors(max_count);
+}
+
+void RasterizerOpenGL::PrewarmSurfaces(std::span<const VideoCore::SurfaceDescriptor> surfaces) {
+    res_cache.PrewarmSurfaces(surfaces);
 }
 
 bool RasterizerOpenGL::AccelerateDisplayTransfer(const Pica::DisplayTransferConfig& config) {
@@ -885,33 +1038,38 @@ void RasterizerOpenGL::SyncAndUploadLUTsLF() {
     if (invalidate) {
         pica.lighting.lut_dirty = pica.lighting.LutAllDirty;
         pica.fog.lut_dirty = true;
+        lf_lut_cache.Clear();
     }
 
+    // LUTs still in the buffer from an earlier upload are only pointed to again.
+    const auto sync_lut = [&](const auto& lut, u64 kind, int& lut_offset) {
+        const u64 hash = lf_lut_cache.Hash(lut, kind);
+        auto cached_offset = lf_lut_cache.Find(hash);
+        if (!cached_offset) {
+            Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
+            for (u32 i = 0; i < lut.size(); i++) {
+                new_data[i] = {lut[i].ToFloat(), lut[i].DiffToFloat()};
+            }
+            cached_offset = static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
+            lf_lut_cache.Insert(hash, *cached_offset);
+            bytes_used += lut.size() * sizeof(Common::Vec2f);
+        }
+        if (lut_offset != *cached_offset) {
+            lut_offset = *cached_offset;
+            fs_data_dirty = true;
+        }
+    };
+
     // Sync the lighting luts
     while (pica.lighting.lut_dirty) {
         const u32 index = std::countr_zero(pica.lighting.lut_dirty);
         pica.lighting.lut_dirty &= ~(1 << index);
-
-        Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
-        const auto& source_lut = pica.lighting.luts[index];
-        for (u32 i = 0; i < source_lut.size(); i++) {
-            new_data[i] = {source_lut[i].ToFloat(), source_lut[i].DiffToFloat()};
-        }
-        fs_data.lighting_lut_offset[index / 4][index % 4] =
-            static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
-        fs_data_dirty = true;
-        bytes_used += source_lut.size() * sizeof(Common::Vec2f);
+        sync_lut(pica.lighting.luts[index], 0, fs_data.lighting_lut_offset[index / 4][index % 4]);
     }
 
     // Sync the fog lut
     if (pica.fog.lut_dirty) {
-        Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
-        for (u32 i = 0; i < pica.fog.lut.size(); i++) {
-            new_data[i] = {pica.fog.lut[i].ToFloat(), pica.fog.lut[i].DiffToFloat()};
-        }
-        fs_data.fog_lut_offset = static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
-        fs_data_dirty = true;
-        bytes_used += pica.fog.lut.size() * sizeof(Common::Vec2f);
+        sync_lut(pica.fog.lut, 1, fs_data.fog_lut_offset);
         pica.fog.lut_dirty = false;
     }
 
@@ -934,56 +1092,56 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
 
     if (invalidate) {
         pica.proctex.table_dirty = pica.proctex.TableAllDirty;
+        proctex_lut_cache.Clear();
     }
 
-    // helper function for SyncProcTexNoiseLUT/ColorMap/AlphaMap
-    const auto sync_proc_tex_value_lut = [&](const auto& lut, GLint& lut_offset) {
-        Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
-        for (u32 i = 0; i < lut.size(); i++) {
-            new_data[i] = {lut[i].ToFloat(), lut[i].DiffToFloat()};
+    // LUTs still in the buffer from an earlier upload are only pointed to again.
+    const auto sync_lut = [&](const auto& lut, u64 kind, int& lut_offset, auto&& convert) {
+        using T = decltype(convert(lut[0]));
+        const u64 hash = proctex_lut_cache.Hash(lut, kind);
+        auto cached_offset = proctex_lut_cache.Find(hash);
+        if (!cached_offset) {
+            T* new_data = reinterpret_cast<T*>(buffer + bytes_used);
+            for (u32 i = 0; i < lut.size(); i++) {
+                new_data[i] = convert(lut[i]);
+            }
+            cached_offset = static_cast<int>((offset + bytes_used) / sizeof(T));
+            proctex_lut_cache.Insert(hash, *cached_offset);
+            bytes_used += lut.size() * sizeof(T);
+        }
+        if (lut_offset != *cached_offset) {
+            lut_offset = *cached_offset;
+            fs_data_dirty = true;
         }
-        lut_offset = static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
-        fs_data_dirty = true;
-        bytes_used += lut.size() * sizeof(Common::Vec2f);
     };
+    const auto value_entry = [](const auto& entry) {
+        return Common::Vec2f{entry.ToFloat(), entry.DiffToFloat()};
+    };
+    const auto color_entry = [](const auto& entry) { return entry.ToVector() / 255.0f; };
 
     // Sync the proctex noise lut
     if (pica.proctex.noise_lut_dirty) {
-        sync_proc_tex_value_lut(pica.proctex.noise_table, fs_data.proctex_noise_lut_offset);
+        sync_lut(pica.proctex.noise_table, 0, fs_data.proctex_noise_lut_offset, value_entry);
     }
 
     // Sync the proctex color map
     if (pica.proctex.color_map_dirty) {
-        sync_proc_tex_value_lut(pica.proctex.color_map_table, fs_data.proctex_color_map_offset);
+        sync_lut(pica.proctex.color_map_table, 0, fs_data.proctex_color_map_offset, value_entry);
     }
 
     // Sync the proctex alpha map
     if (pica.proctex.alpha_map_dirty) {
-        sync_proc_tex_value_lut(pica.proctex.alpha_map_table, fs_data.proctex_alpha_map_offset);
+        sync_lut(pica.proctex.alpha_map_table, 0, fs_data.proctex_alpha_map_offset, value_entry);
     }
 
     // Sync the proctex lut
     if (pica.proctex.lut_dirty) {
-        Common::Vec4f* new_data = reinterpret_cast<Common::Vec4f*>(buffer + bytes_used);
-        for (u32 i = 0; i < pica.proctex.color_table.size(); i++) {
-            new_data[i] = pica.proctex.color_table[i].ToVector() / 255.0f;
-        }
-        fs_data.proctex_lut_offset =
-            static_cast<int>((offset + bytes_used) / sizeof(Common::Vec4f));
-        fs_data_dirty = true;
-        bytes_used += pica.proctex.color_table.size() * sizeof(Common::Vec4f);
+        sync_lut(pica.proctex.color_table, 1, fs_data.proctex_lut_offset, color_entry);
     }
 
     // Sync the proctex difference lut
     if (pica.proctex.diff_lut_dirty) {
-        Common::Vec4f* new_data = reinterpret_cast<Common::Vec4f*>(buffer + bytes_used);
-        for (u32 i = 0; i < pica.proctex.color_diff_table.size(); i++) {
-            new_data[i] = pica.proctex.color_diff_table[i].ToVector() / 255.0f;
-        }
-        fs_data.proctex_diff_lut_offset =
-            static_cast<int>((offset + bytes_used) / sizeof(Common::Vec4f));
-        fs_data_dirty = true;
-        bytes_used += pica.proctex.color_diff_table.size() * sizeof(Common::Vec4f);
+        sync_lut(pica.proctex.color_diff_table, 2, fs_data.proctex_diff_lut_offset, color_entry);
     }
 
     pica.proctex.table_dirty = 0;
@@ -997,44 +1155,99 @@ void RasterizerOpenGL::UploadUniforms(bool accelerate_draw) {
     state.Apply();
 
     const bool sync_vs_pica = accelerate_draw && pica.vs_setup.uniforms_dirty;
-    if (!sync_vs_pica && !vs_data_dirty && !fs_data_dirty) {
+    const bool sync_gs_pica = accelerate_draw && pica.gs_setup.uniforms_dirty &&
+                              regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No;
+    const bool sync_textures = use_bindless_textures && texture_handles_dirty;
+    if (!sync_vs_pica && !sync_gs_pica && !vs_data_dirty && !fs_data_dirty && !sync_textures) {
         return;
     }
 
-    std::size_t uniform_size =
-        uniform_size_aligned_vs_pica + uniform_size_aligned_vs + uniform_size_aligned_fs;
-    std::size_t used_bytes = 0;
-
-    const auto [uniforms, offset, invalidate] =
-        uniform_buffer.Map(uniform_size, uniform_buffer_alignment);
+    // Blocks with the contents of an earlier upload still in the buffer are bound there again.
+    // The PICA blocks are identified by the uniforms they are converted from, and shared by the
+    // VS and the GS.
+    const auto vs_hash = uniform_cache.Hash(vs_data, 0);
+    const auto fs_hash = uniform_cache.Hash(fs_data, 1);
+    const auto vs_pica_hash = uniform_cache.Hash(pica.vs_setup.uniforms, 2);
+    const auto gs_pica_hash = uniform_cache.Hash(pica.gs_setup.uniforms, 2);
+    const auto is_cached = [&](bool sync, u64 hash) {
+        return !sync || uniform_cache.Find(hash).has_value();
+    };
 
-    if (vs_data_dirty || invalidate) {
-        std::memcpy(uniforms + used_bytes, &vs_data, sizeof(vs_data));
-        glBindBufferRange(GL_UNIFORM_BUFFER, UniformBindings::VSData, uniform_buffer.GetHandle(),
-                          offset + used_bytes, sizeof(vs_data));
-        vs_data_dirty = false;
-        used_bytes += uniform_size_aligned_vs;
+    u8* uniforms = nullptr;
+    GLintptr offset = 0;
+    bool invalidate = false;
+    const bool map = sync_textures || !is_cached(vs_data_dirty, vs_hash) ||
+                     !is_cached(fs_data_dirty, fs_hash) ||
+                     !is_cached(sync_vs_pica, vs_pica_hash) ||
+                     !is_cached(sync_gs_pica, gs_pica_hash);
+    if (map) {
+        const std::size_t uniform_size = uniform_size_aligned_vs_pica * 2 +
+                                         uniform_size_aligned_vs + uniform_size_aligned_fs +
+                                         uniform_size_aligned_textures;
+        std::tie(uniforms, offset, invalidate) =
+            uniform_buffer.Map(uniform_size, uniform_buffer_alignment);
+        if (invalidate) {
+            uniform_cache.Clear();
+        }
     }
 
-    if (fs_data_dirty || invalidate) {
-        std::memcpy(uniforms + used_bytes, &fs_data, sizeof(fs_data));
-        glBindBufferRange(GL_UNIFORM_BUFFER, UniformBindings::FSData, uniform_buffer.GetHandle(),
-                          offset + used_bytes, sizeof(fs_data));
-        fs_data_dirty = false;
-        used_bytes += uniform_size_aligned_fs;
-    }
+    std::size_t used_bytes = 0;
+    const auto upload = [&](bool sync, u64 hash, GLuint binding, std::size_t size,
+                            std::size_t aligned_size, const auto& write) {
+        if (!sync && !invalidate) {
+            return;
+        }
+        if (const auto cached_offset = uniform_cache.Find(hash)) {
+            glBindBufferRange(GL_UNIFORM_BUFFER, binding, uniform_buffer.GetHandle(),
+                              *cached_offset, size);
+            return;
+        }
+        write(uniforms + used_bytes);
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, uniform_buffer.GetHandle(),
+                          offset + used_bytes, size);
+        uniform_cache.Insert(hash, static_cast<int>(offset + used_bytes));
+        used_bytes += aligned_size;
+    };
 
+    upload(vs_data_dirty, vs_hash, UniformBindings::VSData, sizeof(vs_data),
+           uniform_size_aligned_vs,
+           [&](u8* data) { std::memcpy(data, &vs_data, sizeof(vs_data)); });
+    upload(fs_data_dirty, fs_hash, UniformBindings::FSData, sizeof(fs_data),
+           uniform_size_aligned_fs,
+           [&](u8* data) { std::memcpy(data, &fs_data, sizeof(fs_data)); });
+    upload(sync_vs_pica, vs_pica_hash, UniformBindings::VSPicaData, sizeof(VSPicaUniformData),
+           uniform_size_aligned_vs_pica, [&](u8* data) {
+               VSPicaUniformData vs_uniforms;
+               vs_uniforms.SetFromRegs(pica.vs_setup);
+               std::memcpy(data, &vs_uniforms, sizeof(vs_uniforms));
+           });
+    upload(sync_gs_pica, gs_pica_hash, UniformBindings::GSPicaData, sizeof(VSPicaUniformData),
+           uniform_size_aligned_vs_pica, [&](u8* data) {
+               VSPicaUniformData gs_uniforms;
+               gs_uniforms.SetFromRegs(pica.gs_setup);
+               std::memcpy(data, &gs_uniforms, sizeof(gs_uniforms));
+           });
+
+    vs_data_dirty = false;
+    fs_data_dirty = false;
     if (sync_vs_pica || invalidate) {
-        VSPicaUniformData vs_uniforms;
-        vs_uniforms.SetFromRegs(pica.vs_setup);
-        std::memcpy(uniforms + used_bytes, &vs_uniforms, sizeof(vs_uniforms));
-        glBindBufferRange(GL_UNIFORM_BUFFER, UniformBindings::VSPicaData,
-                          uniform_buffer.GetHandle(), offset + used_bytes, sizeof(vs_uniforms));
         pica.vs_setup.uniforms_dirty = false;
-        used_bytes += uniform_size_aligned_vs_pica;
+    }
+    if (sync_gs_pica || invalidate) {
+        pica.gs_setup.uniforms_dirty = false;
     }
 
-    uniform_buffer.Unmap(used_bytes);
+    if (use_bindless_textures && (sync_textures || invalidate)) {
+        std::memcpy(uniforms + used_bytes, texture_handles.data(), sizeof(texture_handles));
+        glBindBufferRange(GL_UNIFORM_BUFFER, UniformBindings::FSTextures,
+                          uniform_buffer.GetHandle(), offset + used_bytes, sizeof(texture_handles));
+        texture_handles_dirty = false;
+        used_bytes += uniform_size_aligned_textures;
+    }
+
+    if (map) {
+        uniform_buffer.Unmap(used_bytes);
+    }
 }
 
 } // namespace OpenGL
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "video_core/rasterizer_accelerated.h"
+#include "video_core/rasterizer_cache/vertex_buffer_cache.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_state.h"
@@ -40,6 +41,8 @@ public:
     ~RasterizerOpenGL() override;
 
     void TickFrame();
+    /// Returns the number of shaders compiled since the last call.
+    u32 GetAndResetShaderCompiles();
     void LoadDefaultDiskResources(const std::atomic_bool& stop_loading,
                                   const VideoCore::DiskResourceLoadCallback& callback) override;
     void SwitchDiskResources(u64 title_id) override;
@@ -50,6 +53,8 @@ public:
     void InvalidateRegion(PAddr addr, u32 size) override;
     void FlushAndInvalidateRegion(PAddr addr, u32 size) override;
     void ClearAll(bool flush) override;
+    std::vector<VideoCore::SurfaceDescriptor> GetSurfaceDescriptors(std::size_t max_count) override;
+    void PrewarmSurfaces(std::span<const VideoCore::SurfaceDescriptor> surfaces) override;
     bool AccelerateDisplayTransfer(const Pica::DisplayTransferConfig& config) override;
     bool AccelerateTextureCopy(const Pica::DisplayTransferConfig& config) override;
     bool AccelerateFill(const Pica::MemoryFillConfig& config) override;
@@ -83,6 +88,12 @@ private:
     /// Binds the custom material referenced by surface if it exists.
     void BindMaterial(u32 texture_index, Surface& surface);
 
+    /// Moves the textures bound to the PICA texture units to the bindless handle uniform block.
+    void SyncTextureHandles();
+
+    /// Returns the resident bindless handle of the texture sampled with sampler.
+    GLuint64 GetTextureHandle(GLuint texture, GLuint sampler);
+
     /// Upload the uniform blocks to the uniform buffer object
     void UploadUniforms(bool accelerate_draw);
 
@@ -96,6 +107,10 @@ private:
     void SetupVertexArray(u8* array_ptr, GLintptr buffer_offset, GLuint vs_input_index_min,
                           GLuint vs_input_index_max);
 
+    /// Returns the offset of the vertex data in the vertex cache buffer if it is cached there,
+    /// uploading it first when it has become worth caching
+    std::optional<GLintptr> LoadCachedVertices(PAddr addr, u32 size);
+
     /// Setup vertex shader for AccelerateDrawBatch
     bool SetupVertexShader();
 
@@ -110,12 +125,14 @@ private:
     std::shared_ptr<ShaderProgramManager> curr_shader_manager{};
     TextureRuntime runtime;
     RasterizerCache res_cache;
+    VideoCore::VertexBufferCache vertex_buffer_cache;
 
     OGLVertexArray sw_vao; // VAO for software shader draw
     OGLVertexArray hw_vao; // VAO for hardware shader / accelerate draw
     std::array<bool, 16> hw_vao_enabled_attributes{};
 
     OGLStreamBuffer vertex_buffer;
+    OGLStreamBuffer vertex_cache_buffer;
     OGLStreamBuffer uniform_buffer;
     OGLStreamBuffer index_buffer;
     OGLStreamBuffer texture_buffer;
@@ -124,6 +141,14 @@ private:
     std::size_t uniform_size_aligned_vs_pica;
     std::size_t uniform_size_aligned_vs;
     std::size_t uniform_size_aligned_fs;
+    std::size_t uniform_size_aligned_textures;
+
+    bool use_bindless_textures{};
+    bool texture_handles_dirty{true};
+    std::array<GLuint64, 3> texture_handles{};
+    std::unordered_map<u64, GLuint64> texture_handle_cache;
+    u64 texture_handle_generation{};
+    OGLTexture null_texture;
 
     OGLTexture texture_buffer_lut_lf;
     OGLTexture texture_buffer_lut_rg;
@@ -103,14 +103,14 @@ void OGLSampler::Release() {
     handle = 0;
 }
 
-void OGLShader::Create(std::string_view source, GLenum type) {
+void OGLShader::Create(std::string_view source, GLenum type, bool check_status) {
     if (handle != 0)
         return;
     if (source.empty())
         return;
 
     MICROPROFILE_SCOPE(OpenGL_ResourceCreation);
-    handle = LoadShader(source, type);
+    handle = LoadShader(source, type, check_status);
 }
 
 void OGLShader::Release() {
@@ -122,12 +122,13 @@ void OGLShader::Release() {
     handle = 0;
 }
 
-void OGLProgram::Create(bool separable_program, std::span<const GLuint> shaders) {
+void OGLProgram::Create(bool separable_program, std::span<const GLuint> shaders,
+                        bool check_status) {
     if (handle != 0)
         return;
 
     MICROPROFILE_SCOPE(OpenGL_ResourceCreation);
-    handle = LoadProgram(separable_program, shaders);
+    handle = LoadProgram(separable_program, shaders, check_status);
 }
 
 void OGLProgram::Create(std::string_view vert_shader, std::string_view frag_shader) {
@@ -107,7 +107,7 @@ public:
         return *this;
     }
 
-    void Create(std::string_view source, GLenum type);
+    void Create(std::string_view source, GLenum type, bool check_status = true);
 
     void Release();
 
@@ -130,8 +130,9 @@ public:
         return *this;
     }
 
-    /// Creates a new program from given shader objects
-    void Create(bool separable_program, std::span<const GLuint> shaders);
+    /// Creates a new program from given shader objects. Unless check_status is set, the program
+    /// may still be linking in the background when this returns.
+    void Create(bool separable_program, std::span<const GLuint> shaders, bool check_status = true);
 
     /// Creates a new program from given shader soruce code
     void Create(std::string_view vert_shader, std::string_view frag_shader);
@@ -30,6 +30,7 @@ enum class TransferableEntryKind : u32 {
 enum class PrecompiledEntryKind : u32 {
     Decompiled,
     Dump,
+    CompressedDump,
 };
 
 constexpr u32 NativeVersion = 1;
@@ -105,8 +106,9 @@ bool ShaderDiskCacheRaw::Save(FileUtil::IOFile& file) const {
     return true;
 }
 
-ShaderDiskCache::ShaderDiskCache(u64 program_id, bool separable)
-    : separable{separable}, program_id{program_id}, transferable_file(AppendTransferableFile()),
+ShaderDiskCache::ShaderDiskCache(u64 program_id, bool separable, bool bindless)
+    : separable{separable}, bindless{bindless}, program_id{program_id},
+      transferable_file(AppendTransferableFile()),
       // seperable shaders use the virtual precompile file, that already has a header.
       precompiled_file(AppendPrecompiledFile(!separable)) {}
 
@@ -250,13 +252,15 @@ ShaderDiskCache::LoadPrecompiledFile(FileUtil::IOFile& file, bool compressed) {
             decompiled.insert({unique_identifier, std::move(*entry)});
             break;
         }
-        case PrecompiledEntryKind::Dump: {
+        case PrecompiledEntryKind::Dump:
+        case PrecompiledEntryKind::CompressedDump: {
             u64 unique_identifier;
             if (!LoadObjectFromPrecompiled(unique_identifier)) {
                 return std::nullopt;
             }
 
             ShaderDiskCacheDump dump;
+            dump.compressed = kind == PrecompiledEntryKind::CompressedDump;
             if (!LoadObjectFromPrecompiled(dump.binary_format)) {
                 return std::nullopt;
             }
@@ -266,6 +270,10 @@ ShaderDiskCache::LoadPrecompiledFile(FileUtil::IOFile& file, bool compressed) {
                 return std::nullopt;
             }
 
+            if (binary_length > decompressed_precompiled_cache.size() -
+                                    decompressed_precompiled_cache_offset) {
+                return std::nullopt;
+            }
             dump.binary.resize(binary_length);
             if (!LoadArrayFromPrecompiled(dump.binary.data(), dump.binary.size())) {
                 return std::nullopt;
@@ -428,11 +436,15 @@ void ShaderDiskCache::SaveDumpToFile(u64 unique_identifier, GLuint program, bool
     std::vector<u8> binary(binary_length);
     glGetProgramBinary(program, binary_length, nullptr, &binary_format, binary.data());
 
-    if (precompiled_file.WriteObject(static_cast<u32>(PrecompiledEntryKind::Dump)) != 1 ||
+    // Conventional programs are appended one at a time, so each binary is compressed on its own
+    // instead of compressing the whole file.
+    const std::vector<u8> compressed = Common::Compression::CompressDataZSTDDefault(binary);
+    if (compressed.empty() ||
+        precompiled_file.WriteObject(static_cast<u32>(PrecompiledEntryKind::CompressedDump)) != 1 ||
         precompiled_file.WriteObject(unique_identifier) != 1 ||
         precompiled_file.WriteObject(static_cast<u32>(binary_format)) != 1 ||
-        precompiled_file.WriteObject(static_cast<u32>(binary_length)) != 1 ||
-        precompiled_file.WriteArray(binary.data(), binary.size()) != binary.size()) {
+        precompiled_file.WriteObject(static_cast<u32>(compressed.size())) != 1 ||
+        precompiled_file.WriteArray(compressed.data(), compressed.size()) != compressed.size()) {
         LOG_ERROR(Render_OpenGL, "Failed to save binary program file in shader={:016x} - removing",
                   unique_identifier);
         InvalidatePrecompiled();
@@ -560,10 +572,11 @@ std::string ShaderDiskCache::GetPrecompiledDir() const {
 }
 
 std::string ShaderDiskCache::GetPrecompiledShaderDir() const {
+    const std::string bindless_suffix = bindless ? "_bindless" : "";
     if (separable) {
-        return GetPrecompiledDir() + DIR_SEP "separable";
+        return GetPrecompiledDir() + DIR_SEP "separable" + bindless_suffix;
     }
-    return GetPrecompiledDir() + DIR_SEP "conventional";
+    return GetPrecompiledDir() + DIR_SEP "conventional" + bindless_suffix;
 }
 
 std::string ShaderDiskCache::GetBaseDir() const {
@@ -83,11 +83,13 @@ struct ShaderDiskCacheDecompiled {
 struct ShaderDiskCacheDump {
     GLenum binary_format;
     std::vector<u8> binary;
+    // The binary is zstd compressed on its own, so that entries can be decompressed in parallel
+    bool compressed{};
 };
 
 class ShaderDiskCache {
 public:
-    explicit ShaderDiskCache(u64 title_id, bool separable);
+    explicit ShaderDiskCache(u64 title_id, bool separable, bool bindless);
     ~ShaderDiskCache() = default;
 
     /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
@@ -218,6 +220,9 @@ private:
 
     bool separable{};
 
+    // Programs reading bindless texture handles can't be used with texture unit bindings
+    bool bindless{};
+
     u64 program_id{};
     std::string title_id;
 
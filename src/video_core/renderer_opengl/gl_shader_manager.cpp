@@ -3,23 +3,29 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <span>
 #include <thread>
 #include <unordered_map>
 #include <variant>
+#include <fmt/format.h>
 #include "common/settings.h"
+#include "common/zstd_compression.h"
 #include "core/frontend/emu_window.h"
 #include "video_core/pica/shader_setup.h"
 #include "video_core/renderer_opengl/gl_driver.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_shader_disk_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
+#include "video_core/renderer_opengl/gl_shader_util.h"
 #include "video_core/renderer_opengl/gl_state.h"
 #include "video_core/shader/generator/glsl_fs_shader_gen.h"
 #include "video_core/shader/generator/glsl_shader_gen.h"
 #include "video_core/shader/generator/profile.h"
+#include "video_core/shader/generator/shared_fs_cache.h"
 
 using namespace Pica::Shader::Generator;
 using Pica::Shader::FSConfig;
@@ -49,13 +55,23 @@ static OGLProgram GeneratePrecompiledProgram(const ShaderDiskCacheDump& dump,
         return {};
     }
 
+    std::vector<u8> decompressed;
+    if (dump.compressed) {
+        decompressed = Common::Compression::DecompressDataZSTD(dump.binary);
+        if (decompressed.empty()) {
+            LOG_INFO(Render_OpenGL, "Precompiled cache entry could not be decompressed - removing");
+            return {};
+        }
+    }
+    const std::vector<u8>& binary = dump.compressed ? decompressed : dump.binary;
+
     auto shader = OGLProgram();
     shader.handle = glCreateProgram();
     if (separable) {
         glProgramParameteri(shader.handle, GL_PROGRAM_SEPARABLE, GL_TRUE);
     }
-    glProgramBinary(shader.handle, dump.binary_format, dump.binary.data(),
-                    static_cast<GLsizei>(dump.binary.size()));
+    glProgramBinary(shader.handle, dump.binary_format, binary.data(),
+                    static_cast<GLsizei>(binary.size()));
 
     GLint link_status{};
     glGetProgramiv(shader.handle, GL_LINK_STATUS, &link_status);
@@ -81,6 +97,43 @@ static std::set<GLenum> GetSupportedFormats() {
     return supported_formats;
 }
 
+/// Returns the program binary prefixed by its format, as stored in the shared shader cache.
+static std::vector<u8> GetSharedProgramBlob(GLuint program) {
+    GLint binary_length{};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+    if (binary_length <= 0) {
+        return {};
+    }
+    std::vector<u8> blob(sizeof(u32) + binary_length);
+    GLenum binary_format{};
+    glGetProgramBinary(program, binary_length, nullptr, &binary_format, blob.data() + sizeof(u32));
+    const u32 format = static_cast<u32>(binary_format);
+    std::memcpy(blob.data(), &format, sizeof(u32));
+    return blob;
+}
+
+static OGLProgram LoadSharedProgramBlob(std::span<const u8> blob,
+                                        const std::set<GLenum>& supported_formats) {
+    if (blob.size() <= sizeof(u32)) {
+        return {};
+    }
+    u32 format{};
+    std::memcpy(&format, blob.data(), sizeof(u32));
+    const ShaderDiskCacheDump dump{
+        .binary_format = static_cast<GLenum>(format),
+        .binary = {blob.begin() + sizeof(u32), blob.end()},
+    };
+    return GeneratePrecompiledProgram(dump, supported_formats, true);
+}
+
+static u64 GetSharedCacheDriverId(const Driver& driver, const Pica::Shader::Profile& profile) {
+    const std::string driver_name = fmt::format("{}|{}|{}", driver.GetVendorString(),
+                                                driver.GetModelString(),
+                                                driver.GetVersionString());
+    return Common::HashCombine(Common::ComputeHash64(driver_name.data(), driver_name.size()),
+                               Pica::Shader::SharedFragmentCache::HashProfile(profile));
+}
+
 static std::tuple<PicaVSConfig, Pica::ShaderSetup> BuildVSConfigFromRaw(
     const ShaderDiskCacheRaw& raw, const Driver& driver, bool accurate_mul) {
     Pica::ProgramCode program_code{};
@@ -94,7 +147,9 @@ static std::tuple<PicaVSConfig, Pica::ShaderSetup> BuildVSConfigFromRaw(
 
     // Enable the geometry-shader only if we are actually doing per-fragment lighting
     // and care about proper quaternions. Otherwise just use standard vertex+fragment shaders
-    const bool use_geometry_shader = !raw.GetRawShaderConfig().lighting.disable;
+    const auto& regs = raw.GetRawShaderConfig();
+    const bool use_geometry_shader =
+        !regs.lighting.disable || regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No;
     return {PicaVSConfig{raw.GetRawShaderConfig(), setup, driver.HasClipCullDistance(),
                          use_geometry_shader, accurate_mul},
             setup};
@@ -114,14 +169,14 @@ public:
         }
     }
 
-    void Create(const char* source, GLenum type) {
+    void Create(const char* source, GLenum type, bool check_status = true) {
         if (shader_or_program.index() == 0) {
-            std::get<OGLShader>(shader_or_program).Create(source, type);
+            std::get<OGLShader>(shader_or_program).Create(source, type, check_status);
         } else {
             OGLShader shader;
-            shader.Create(source, type);
+            shader.Create(source, type, check_status);
             OGLProgram& program = std::get<OGLProgram>(shader_or_program);
-            program.Create(true, std::array{shader.handle});
+            program.Create(true, std::array{shader.handle}, check_status);
         }
     }
 
@@ -159,7 +214,8 @@ private:
 template <typename KeyConfigType, auto CodeGenerator, GLenum ShaderType>
 class ShaderCache {
 public:
-    explicit ShaderCache(bool separable_) : separable{separable_} {}
+    explicit ShaderCache(bool separable_, bool async_compile_ = false)
+        : separable{separable_}, async_compile{async_compile_} {}
     ~ShaderCache() = default;
 
     template <typename... Args>
@@ -170,11 +226,15 @@ public:
         std::optional<std::string> result{};
         if (new_shader) {
             result = CodeGenerator(config, args...);
-            cached_shader.Create(result->c_str(), ShaderType);
+            cached_shader.Create(result->c_str(), ShaderType, !async_compile);
         }
         return {cached_shader.GetHandle(), std::move(result)};
     }
 
+    bool Contains(const KeyConfigType& config) const {
+        return shaders.contains(config);
+    }
+
     void Inject(const KeyConfigType& key, OGLProgram&& program) {
         OGLShaderStage stage{separable};
         stage.Inject(std::move(program));
@@ -187,6 +247,7 @@ public:
 
 private:
     bool separable;
+    bool async_compile;
     std::unordered_map<KeyConfigType, OGLShaderStage> shaders;
 };
 
@@ -200,7 +261,8 @@ template <typename KeyConfigType,
           GLenum ShaderType>
 class ShaderDoubleCache {
 public:
-    explicit ShaderDoubleCache(bool separable) : separable(separable) {}
+    explicit ShaderDoubleCache(bool separable, bool async_compile = false)
+        : separable(separable), async_compile(async_compile) {}
     std::tuple<GLuint, std::optional<std::string>> Get(const KeyConfigType& key,
                                                        const Pica::ShaderSetup& setup) {
         std::optional<std::string> result{};
@@ -216,7 +278,7 @@ public:
             OGLShaderStage& cached_shader = iter->second;
             if (new_shader) {
                 result = program;
-                cached_shader.Create(program.c_str(), ShaderType);
+                cached_shader.Create(program.c_str(), ShaderType, !async_compile);
             }
             shader_map[key] = &cached_shader;
             return {cached_shader.GetHandle(), std::move(result)};
@@ -245,6 +307,7 @@ public:
 
 private:
     bool separable;
+    bool async_compile;
     std::unordered_map<KeyConfigType, OGLShaderStage*> shader_map;
     std::unordered_map<std::string, OGLShaderStage> shader_cache;
 };
@@ -252,20 +315,39 @@ private:
 using ProgrammableVertexShaders =
     ShaderDoubleCache<PicaVSConfig, &GLSL::GenerateVertexShader, GL_VERTEX_SHADER>;
 
+using ProgrammableGeometryShaders =
+    ShaderDoubleCache<PicaGSProgramConfig, &GLSL::GenerateGeometryShader, GL_GEOMETRY_SHADER>;
+
 using FixedGeometryShaders =
     ShaderCache<PicaFixedGSConfig, &GLSL::GenerateFixedGeometryShader, GL_GEOMETRY_SHADER>;
 
 using FragmentShaders = ShaderCache<FSConfig, &GLSL::GenerateFragmentShader, GL_FRAGMENT_SHADER>;
 
+/// Returns true if new shaders can be compiled without waiting for the driver.
+static bool UseParallelShaderCompile(const Driver& driver, bool separable) {
+    // Conventional programs link all stages together, so a stage that is still compiling has
+    // nothing to be replaced with. Separable programs swap a single stage instead.
+    return separable && driver.HasParallelShaderCompile() &&
+           Settings::values.async_shader_compilation.GetValue();
+}
+
 class ShaderProgramManager::Impl {
 public:
     explicit Impl(const Driver& driver, u64 title_id, bool separable)
-        : separable(separable), programmable_vertex_shaders(separable),
-          trivial_vertex_shader(driver, separable), fixed_geometry_shaders(separable),
-          fragment_shaders(separable), disk_cache(title_id, separable) {
+        : separable(separable), async_compile(UseParallelShaderCompile(driver, separable)),
+          programmable_vertex_shaders(separable, async_compile),
+          trivial_vertex_shader(driver, separable),
+          programmable_geometry_shaders(separable, async_compile),
+          fixed_geometry_shaders(separable),
+          fragment_shaders(separable, async_compile),
+          disk_cache(title_id, separable, driver.UseBindlessTextures()) {
         if (separable) {
             pipeline.Create();
         }
+        if (async_compile) {
+            // Let the driver pick the number of compiler threads.
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        }
         profile = Pica::Shader::Profile{
             .has_separable_shaders = separable,
             .has_clip_planes = driver.HasClipCullDistance(),
@@ -283,8 +365,66 @@ public:
             .has_gl_intel_fragment_shader_ordering = driver.HasIntelFragmentShaderOrdering(),
             // TODO: This extension requires GLSL 450 / OpenGL 4.5 context.
             .has_gl_nv_fragment_shader_barycentric = false,
+            .has_gl_arb_bindless_texture = driver.UseBindlessTextures(),
             .is_vulkan = false,
         };
+        // Only separable fragment shaders are programs of their own that can be shared.
+        if (separable) {
+            shared_fs_cache = std::make_unique<Pica::Shader::SharedFragmentCache>(
+                "opengl", GetSharedCacheDriverId(driver, profile));
+            if (shared_fs_cache->IsEnabled()) {
+                supported_formats = GetSupportedFormats();
+            }
+        }
+    }
+
+    /// Injects the fragment shader of the config from the shared shader cache, if it is stored.
+    bool LoadSharedFragmentShader(const FSConfig& config) {
+        if (!shared_fs_cache || !shared_fs_cache->IsEnabled()) {
+            return false;
+        }
+        const auto blob = shared_fs_cache->Find(config);
+        if (!blob) {
+            return false;
+        }
+        OGLProgram program = LoadSharedProgramBlob(*blob, supported_formats);
+        if (program.handle == 0) {
+            return false;
+        }
+        fragment_shaders.Inject(config, std::move(program));
+        return true;
+    }
+
+    /// Tracks a program that was created without waiting for the driver to link it.
+    void AddPendingProgram(GLuint program, std::optional<FSConfig> fs_config = std::nullopt) {
+        pending_programs.insert_or_assign(program, std::move(fs_config));
+    }
+
+    /// Returns true unless the program is still being compiled in the background. Once it is
+    /// done, the link status is reported and fragment shaders are stored to the shared cache.
+    bool IsProgramReady(GLuint program) {
+        if (pending_programs.empty()) {
+            return true;
+        }
+        const auto it = pending_programs.find(program);
+        if (it == pending_programs.end()) {
+            return true;
+        }
+        if (IsProgramCompiling(program)) {
+            return false;
+        }
+        if (IsProgramLinked(program) && it->second) {
+            SaveSharedFragmentShader(*it->second, program);
+        }
+        pending_programs.erase(it);
+        return true;
+    }
+
+    /// Stores a newly compiled fragment shader in the shared shader cache.
+    void SaveSharedFragmentShader(const FSConfig& config, GLuint program) {
+        if (program != 0 && shared_fs_cache && shared_fs_cache->IsEnabled()) {
+            shared_fs_cache->Insert(config, GetSharedProgramBlob(program));
+        }
     }
 
     struct ShaderTuple {
@@ -314,18 +454,24 @@ public:
                   "ShaderTuple layout changed!");
 
     bool separable;
+    bool async_compile;
     Pica::Shader::Profile profile{};
     ShaderTuple current;
 
     ProgrammableVertexShaders programmable_vertex_shaders;
     TrivialVertexShader trivial_vertex_shader;
 
+    ProgrammableGeometryShaders programmable_geometry_shaders;
     FixedGeometryShaders fixed_geometry_shaders;
 
     FragmentShaders fragment_shaders;
     std::unordered_map<u64, OGLProgram> program_cache;
     OGLPipeline pipeline;
     ShaderDiskCache disk_cache;
+    std::unique_ptr<Pica::Shader::SharedFragmentCache> shared_fs_cache;
+    std::set<GLenum> supported_formats;
+    // Programs that are compiled in the background, with the config of fragment shaders.
+    std::unordered_map<GLuint, std::optional<FSConfig>> pending_programs;
 };
 
 ShaderProgramManager::ShaderProgramManager(Frontend::EmuWindow& emu_window_, const Driver& driver_,
@@ -340,19 +486,20 @@ bool ShaderProgramManager::UseProgrammableVertexShader(const Pica::RegsInternal&
                                                        Pica::ShaderSetup& setup,
                                                        bool accurate_mul) {
     // Enable the geometry-shader only if we are actually doing per-fragment lighting
-    // and care about proper quaternions. Otherwise just use standard vertex+fragment shaders
-    const bool use_geometry_shader = !regs.lighting.disable;
+    // and care about proper quaternions, or if the PICA geometry shader runs on the host.
+    // Otherwise just use standard vertex+fragment shaders
+    const bool use_geometry_shader =
+        !regs.lighting.disable || regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No;
 
     PicaVSConfig config{regs, setup, driver.HasClipCullDistance(), use_geometry_shader,
                         accurate_mul};
     auto [handle, result] = impl->programmable_vertex_shaders.Get(config, setup);
     if (handle == 0)
         return false;
-    impl->current.vs = handle;
-    impl->current.vs_hash = config.Hash();
 
     // Save VS to the disk cache if its a new shader
     if (result) {
+        shader_compiles++;
         auto& disk_cache = impl->disk_cache;
         ProgramCode program_code{setup.program_code.begin(), setup.program_code.end()};
         program_code.insert(program_code.end(), setup.swizzle_data.begin(),
@@ -362,7 +509,18 @@ bool ShaderProgramManager::UseProgrammableVertexShader(const Pica::RegsInternal&
                                      std::move(program_code)};
         disk_cache.SaveRaw(raw);
         disk_cache.SaveDecompiled(unique_identifier, *result, accurate_mul);
+        if (impl->async_compile) {
+            impl->AddPendingProgram(handle);
+        }
+    }
+
+    // Until the shader is compiled the batch is drawn with the software vertex shader.
+    if (!impl->IsProgramReady(handle)) {
+        return false;
     }
+
+    impl->current.vs = handle;
+    impl->current.vs_hash = config.Hash();
     return true;
 }
 
@@ -371,9 +529,38 @@ void ShaderProgramManager::UseTrivialVertexShader() {
     impl->current.vs_hash = 0;
 }
 
+bool ShaderProgramManager::UseProgrammableGeometryShader(const Pica::RegsInternal& regs,
+                                                         Pica::ShaderSetup& setup,
+                                                         bool accurate_mul) {
+    PicaGSProgramConfig config{regs, setup, driver.HasClipCullDistance(), accurate_mul};
+    auto [handle, result] = impl->programmable_geometry_shaders.Get(config, setup);
+    if (handle == 0) {
+        return false;
+    }
+
+    // Geometry shaders are not stored in the disk cache, as it can only rebuild vertex and
+    // fragment shaders from their raw configuration.
+    if (result) {
+        shader_compiles++;
+        if (impl->async_compile) {
+            impl->AddPendingProgram(handle);
+        }
+    }
+    if (!impl->IsProgramReady(handle)) {
+        return false;
+    }
+
+    impl->current.gs = handle;
+    impl->current.gs_hash = config.Hash();
+    return true;
+}
+
 void ShaderProgramManager::UseFixedGeometryShader(const Pica::RegsInternal& regs) {
     PicaFixedGSConfig gs_config(regs, driver.HasClipCullDistance());
-    auto [handle, _] = impl->fixed_geometry_shaders.Get(gs_config, impl->separable);
+    auto [handle, result] = impl->fixed_geometry_shaders.Get(gs_config, impl->separable);
+    if (result) {
+        shader_compiles++;
+    }
     impl->current.gs = handle;
     impl->current.gs_hash = gs_config.Hash();
 }
@@ -386,17 +573,32 @@ void ShaderProgramManager::UseTrivialGeometryShader() {
 void ShaderProgramManager::UseFragmentShader(const Pica::RegsInternal& regs,
                                              const Pica::Shader::UserConfig& user) {
     const FSConfig fs_config{regs, user, impl->profile};
+    if (!impl->fragment_shaders.Contains(fs_config)) {
+        impl->LoadSharedFragmentShader(fs_config);
+    }
     auto [handle, result] = impl->fragment_shaders.Get(fs_config, impl->profile);
-    impl->current.fs = handle;
-    impl->current.fs_hash = fs_config.Hash();
     // Save FS to the disk cache if its a new shader
     if (result) {
+        shader_compiles++;
         auto& disk_cache = impl->disk_cache;
         u64 unique_identifier = GetUniqueIdentifier(regs, {});
         ShaderDiskCacheRaw raw{unique_identifier, ProgramType::FS, regs, {}};
         disk_cache.SaveRaw(raw);
         disk_cache.SaveDecompiled(unique_identifier, *result, false);
+        if (impl->async_compile) {
+            impl->AddPendingProgram(handle, fs_config);
+        } else {
+            impl->SaveSharedFragmentShader(fs_config, handle);
+        }
     }
+
+    // Keep drawing with the previous fragment shader while the new one is compiled.
+    if (!impl->IsProgramReady(handle) && impl->current.fs != 0) {
+        return;
+    }
+
+    impl->current.fs = handle;
+    impl->current.fs_hash = fs_config.Hash();
 }
 
 void ShaderProgramManager::ApplyTo(OpenGLState& state, bool accurate_mul) {
@@ -455,20 +657,19 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
 
     std::mutex mutex;
     std::atomic_bool compilation_failed = false;
+    std::atomic_bool invalid_entry = false;
     if (callback) {
         callback(VideoCore::LoadCallbackStage::Decompile, 0, raws.size());
     }
     std::vector<std::size_t> load_raws_index;
+    std::size_t loaded_shaders = 0; // It doesn't have be atomic since it's used behind a mutex
     // Loads both decompiled and precompiled shaders from the cache. If either one is missing for
-    const auto LoadPrecompiledShader = [&](std::size_t begin, std::size_t end,
-                                           std::span<const ShaderDiskCacheRaw> raw_cache,
-                                           const ShaderDecompiledMap& decompiled_map,
-                                           const ShaderDumpsMap& dump_map) {
+    const auto LoadPrecompiledShader = [&](std::size_t begin, std::size_t end) {
         for (std::size_t i = begin; i < end; ++i) {
-            if (stop_loading || compilation_failed) {
+            if (stop_loading || compilation_failed || invalid_entry) {
                 return;
             }
-            const auto& raw{raw_cache[i]};
+            const auto& raw{raws[i]};
             const u64 unique_identifier{raw.GetUniqueIdentifier()};
 
             const u64 calculated_hash =
@@ -478,16 +679,16 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
                           "Invalid hash in entry={:016x} (obtained hash={:016x}) - removing "
                           "shader cache",
                           raw.GetUniqueIdentifier(), calculated_hash);
-                disk_cache.InvalidateAll();
+                invalid_entry = true;
                 return;
             }
 
-            const auto dump{dump_map.find(unique_identifier)};
-            const auto decomp{decompiled_map.find(unique_identifier)};
+            const auto dump{dumps.find(unique_identifier)};
+            const auto decomp{decompiled.find(unique_identifier)};
 
             OGLProgram shader;
 
-            if (dump != dump_map.end() && decomp != decompiled_map.end()) {
+            if (dump != dumps.end() && decomp != decompiled.end()) {
                 // Only load the vertex shader if its sanitize_mul setting matches
                 if (raw.GetProgramType() == ProgramType::VS &&
                     decomp->second.sanitize_mul != accurate_mul) {
@@ -513,6 +714,7 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
                 } else if (raw.GetProgramType() == ProgramType::FS) {
                     // TODO: Support UserConfig in disk shader cache
                     const FSConfig conf(raw.GetRawShaderConfig(), {}, impl->profile);
+                    impl->SaveSharedFragmentShader(conf, shader.handle);
                     std::scoped_lock lock(mutex);
                     impl->fragment_shaders.Inject(conf, std::move(shader));
                 } else {
@@ -528,47 +730,60 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
                 std::scoped_lock lock(mutex);
                 load_raws_index.push_back(i);
             }
+
+            std::scoped_lock lock(mutex);
             if (callback) {
-                callback(VideoCore::LoadCallbackStage::Decompile, i, raw_cache.size());
+                callback(VideoCore::LoadCallbackStage::Decompile, ++loaded_shaders, raws.size());
             }
         }
     };
 
-    const auto LoadPrecompiledProgram = [&](const ShaderDecompiledMap& decompiled_map,
-                                            const ShaderDumpsMap& dump_map) {
-        std::size_t i{0};
-        for (const auto& dump : dump_map) {
-            if (stop_loading) {
-                break;
+    // The dumps are loaded by index, so that they can be split between the workers
+    std::vector<const std::pair<const u64, ShaderDiskCacheDump>*> dump_entries;
+    const auto LoadPrecompiledProgram = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (stop_loading || compilation_failed) {
+                return;
             }
-            const u64 unique_identifier{dump.first};
-            const auto decomp{decompiled_map.find(unique_identifier)};
+            const auto& [unique_identifier, dump] = *dump_entries[i];
+            const auto decomp{decompiled.find(unique_identifier)};
 
             // Only load the program if its sanitize_mul setting matches
-            if (decomp->second.sanitize_mul != accurate_mul) {
+            if (decomp == decompiled.end() || decomp->second.sanitize_mul != accurate_mul) {
                 continue;
             }
 
             // If the shader program is dumped, attempt to load it
             OGLProgram shader =
-                GeneratePrecompiledProgram(dump.second, supported_formats, impl->separable);
-            if (shader.handle != 0) {
-                impl->program_cache.emplace(unique_identifier, std::move(shader));
-            } else {
+                GeneratePrecompiledProgram(dump, supported_formats, impl->separable);
+            if (shader.handle == 0) {
                 LOG_ERROR(Frontend, "Failed to link Precompiled program!");
                 compilation_failed = true;
-                break;
+                return;
             }
+
+            std::scoped_lock lock(mutex);
+            impl->program_cache.emplace(unique_identifier, std::move(shader));
             if (callback) {
-                callback(VideoCore::LoadCallbackStage::Decompile, ++i, dump_map.size());
+                callback(VideoCore::LoadCallbackStage::Decompile, ++loaded_shaders,
+                         dump_entries.size());
             }
         }
     };
 
     if (impl->separable) {
-        LoadPrecompiledShader(0, raws.size(), raws, decompiled, dumps);
+        RunOnWorkerContexts(raws.size(), LoadPrecompiledShader);
     } else {
-        LoadPrecompiledProgram(decompiled, dumps);
+        dump_entries.reserve(dumps.size());
+        for (const auto& entry : dumps) {
+            dump_entries.push_back(&entry);
+        }
+        RunOnWorkerContexts(dump_entries.size(), LoadPrecompiledProgram);
+    }
+
+    if (invalid_entry) {
+        disk_cache.InvalidateAll();
+        return;
     }
 
     bool load_all_raws = false;
@@ -595,9 +810,7 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
     compilation_failed = false;
 
     std::size_t built_shaders = 0; // It doesn't have be atomic since it's used behind a mutex
-    const auto LoadRawSepareble = [&](std::size_t begin, std::size_t end,
-                                      Frontend::GraphicsContext* context = nullptr) {
-        const auto scope = context->Acquire();
+    const auto LoadRawSepareble = [&](std::size_t begin, std::size_t end) {
         for (std::size_t i = begin; i < end; ++i) {
             if (stop_loading || compilation_failed) {
                 return;
@@ -628,6 +841,7 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
                 OGLShaderStage stage{impl->separable};
                 stage.Create(code.c_str(), GL_FRAGMENT_SHADER);
                 handle = stage.GetHandle();
+                impl->SaveSharedFragmentShader(fs_config, handle);
                 std::scoped_lock lock(mutex);
                 impl->fragment_shaders.Inject(fs_config, std::move(stage));
             } else {
@@ -657,32 +871,7 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
         }
     };
 
-    if (!strict_context_required) {
-        const std::size_t num_workers{std::max(1U, std::thread::hardware_concurrency())};
-        const std::size_t bucket_size{load_raws_size / num_workers};
-        std::vector<std::unique_ptr<Frontend::GraphicsContext>> contexts(num_workers);
-        std::vector<std::thread> threads(num_workers);
-
-        emu_window.SaveContext();
-        for (std::size_t i = 0; i < num_workers; ++i) {
-            const bool is_last_worker = i + 1 == num_workers;
-            const std::size_t start{bucket_size * i};
-            const std::size_t end{is_last_worker ? load_raws_size : start + bucket_size};
-
-            // On some platforms the shared context has to be created from the GUI thread
-            contexts[i] = emu_window.CreateSharedContext();
-            // Release the context, so it can be immediately used by the spawned thread
-            contexts[i]->DoneCurrent();
-            threads[i] = std::thread(LoadRawSepareble, start, end, contexts[i].get());
-        }
-        for (auto& thread : threads) {
-            thread.join();
-        }
-        emu_window.RestoreContext();
-    } else {
-        const auto dummy_context{std::make_unique<Frontend::GraphicsContext>()};
-        LoadRawSepareble(0, load_raws_size, dummy_context.get());
-    }
+    RunOnWorkerContexts(load_raws_size, LoadRawSepareble);
 
     if (compilation_failed) {
         disk_cache.InvalidateAll();
@@ -693,4 +882,43 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
     }
 }
 
+void ShaderProgramManager::RunOnWorkerContexts(
+    std::size_t count, const std::function<void(std::size_t, std::size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+    if (strict_context_required) {
+        const auto dummy_context{std::make_unique<Frontend::GraphicsContext>()};
+        const auto scope = dummy_context->Acquire();
+        func(0, count);
+        return;
+    }
+
+    const std::size_t num_workers{
+        std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, count)};
+    const std::size_t bucket_size{count / num_workers};
+    std::vector<std::unique_ptr<Frontend::GraphicsContext>> contexts(num_workers);
+    std::vector<std::thread> threads(num_workers);
+
+    emu_window.SaveContext();
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        const bool is_last_worker = i + 1 == num_workers;
+        const std::size_t start{bucket_size * i};
+        const std::size_t end{is_last_worker ? count : start + bucket_size};
+
+        // On some platforms the shared context has to be created from the GUI thread
+        contexts[i] = emu_window.CreateSharedContext();
+        // Release the context, so it can be immediately used by the spawned thread
+        contexts[i]->DoneCurrent();
+        threads[i] = std::thread([&func, context = contexts[i].get(), start, end] {
+            const auto scope = context->Acquire();
+            func(start, end);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    emu_window.RestoreContext();
+}
+
 } // namespace OpenGL
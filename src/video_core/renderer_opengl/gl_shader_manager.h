@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <utility>
 #include "video_core/rasterizer_interface.h"
 
 namespace Frontend {
@@ -29,6 +31,8 @@ enum UniformBindings {
     VSPicaData = 0,
     VSData = 1,
     FSData = 2,
+    GSPicaData = 3,
+    FSTextures = 4,
 };
 
 /// A class that manage different shader stages and configures them with given config data.
@@ -46,6 +50,9 @@ public:
 
     void UseTrivialVertexShader();
 
+    bool UseProgrammableGeometryShader(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup,
+                                       bool accurate_mul);
+
     void UseFixedGeometryShader(const Pica::RegsInternal& regs);
 
     void UseTrivialGeometryShader();
@@ -56,10 +63,21 @@ public:
 
     u64 GetProgramID() const;
 
+    /// Returns the number of shaders compiled since the last call
+    u32 GetAndResetShaderCompiles() {
+        return std::exchange(shader_compiles, 0);
+    }
+
 private:
+    /// Splits [0, count) between worker threads that each own a shared context, or runs it on the
+    /// calling thread when the frontend requires a strict context.
+    void RunOnWorkerContexts(std::size_t count,
+                             const std::function<void(std::size_t, std::size_t)>& func);
+
     Frontend::EmuWindow& emu_window;
     const Driver& driver;
     bool strict_context_required;
+    u32 shader_compiles{};
     class Impl;
     std::unique_ptr<Impl> impl;
 };
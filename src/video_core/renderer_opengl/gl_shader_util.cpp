@@ -13,7 +13,7 @@
 
 namespace OpenGL {
 
-GLuint LoadShader(std::string_view source, GLenum type) {
+GLuint LoadShader(std::string_view source, GLenum type, bool check_status) {
     std::string preamble;
     if (GLES) {
         preamble = R"(#version 320 es
@@ -52,6 +52,9 @@ GLuint LoadShader(std::string_view source, GLenum type) {
     glShaderSource(shader_id, static_cast<GLsizei>(src_arr.size()), src_arr.data(), lengths.data());
     LOG_DEBUG(Render_OpenGL, "Compiling {} shader...", debug_type);
     glCompileShader(shader_id);
+    if (!check_status) {
+        return shader_id;
+    }
 
     GLint result = GL_FALSE;
     GLint info_log_length;
@@ -72,7 +75,7 @@ GLuint LoadShader(std::string_view source, GLenum type) {
     return shader_id;
 }
 
-GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders) {
+GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders, bool check_status) {
     // Link the program
     LOG_DEBUG(Render_OpenGL, "Linking program...");
 
@@ -92,14 +95,29 @@ GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders) {
     glLinkProgram(program_id);
 
     // Check the program
+    if (check_status) {
+        const bool linked = IsProgramLinked(program_id);
+        ASSERT_MSG(linked, "Shader not linked");
+    }
+
+    for (GLuint shader : shaders) {
+        if (shader != 0) {
+            glDetachShader(program_id, shader);
+        }
+    }
+
+    return program_id;
+}
+
+bool IsProgramLinked(GLuint program) {
     GLint result = GL_FALSE;
     GLint info_log_length;
-    glGetProgramiv(program_id, GL_LINK_STATUS, &result);
-    glGetProgramiv(program_id, GL_INFO_LOG_LENGTH, &info_log_length);
+    glGetProgramiv(program, GL_LINK_STATUS, &result);
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &info_log_length);
 
     if (info_log_length > 1) {
         std::vector<char> program_error(info_log_length);
-        glGetProgramInfoLog(program_id, info_log_length, nullptr, &program_error[0]);
+        glGetProgramInfoLog(program, info_log_length, nullptr, &program_error[0]);
         if (result == GL_TRUE) {
             LOG_DEBUG(Render_OpenGL, "{}", &program_error[0]);
         } else {
@@ -107,15 +125,13 @@ GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders) {
         }
     }
 
-    ASSERT_MSG(result == GL_TRUE, "Shader not linked");
-
-    for (GLuint shader : shaders) {
-        if (shader != 0) {
-            glDetachShader(program_id, shader);
-        }
-    }
+    return result == GL_TRUE;
+}
 
-    return program_id;
+bool IsProgramCompiling(GLuint program) {
+    GLint completed = GL_TRUE;
+    glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_FALSE;
 }
 
 } // namespace OpenGL
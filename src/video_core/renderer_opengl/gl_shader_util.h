@@ -13,15 +13,26 @@ namespace OpenGL {
  * Utility function to create and compile an OpenGL GLSL shader
  * @param source String of the GLSL shader program
  * @param type Type of the shader (GL_VERTEX_SHADER, GL_GEOMETRY_SHADER or GL_FRAGMENT_SHADER)
+ * @param check_status whether to wait for the compile status. When false, errors are reported by
+ * the program the shader is linked into.
  */
-GLuint LoadShader(std::string_view source, GLenum type);
+GLuint LoadShader(std::string_view source, GLenum type, bool check_status = true);
 
 /**
  * Utility function to create and link an OpenGL GLSL shader program
  * @param separable_program whether to create a separable program
  * @param shaders ID of shaders to attach to the program
+ * @param check_status whether to wait for the link status. When false, the program may still be
+ * linking in the background and its status must be checked with IsProgramLinked.
  * @returns Handle of the newly created OpenGL program object
  */
-GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders);
+GLuint LoadProgram(bool separable_program, std::span<const GLuint> shaders,
+                   bool check_status = true);
+
+/// Returns true if the program linked successfully, logging the link errors otherwise
+bool IsProgramLinked(GLuint program);
+
+/// Returns true while the driver is still compiling or linking the program in the background
+bool IsProgramCompiling(GLuint program);
 
 } // namespace OpenGL
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/microprofile.h"
@@ -10,12 +11,15 @@
 
 MICROPROFILE_DEFINE(OpenGL_StreamBuffer, "OpenGL", "Stream Buffer Orphaning",
                     MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(OpenGL_StreamBufferWait, "OpenGL", "Stream Buffer Wait",
+                    MP_RGB(192, 128, 128));
 
 namespace OpenGL {
 
-OGLStreamBuffer::OGLStreamBuffer(Driver& driver, GLenum target, GLsizeiptr size,
+OGLStreamBuffer::OGLStreamBuffer(const Driver& driver, GLenum target, GLsizeiptr size,
                                  bool prefer_coherent)
-    : gl_target(target), buffer_size(size) {
+    : gl_target(target), buffer_size(size),
+      region_size((size + NumRegions - 1) / NumRegions) {
     gl_buffer.Create();
     glBindBuffer(gl_target, gl_buffer.handle);
 
@@ -38,6 +42,11 @@ OGLStreamBuffer::OGLStreamBuffer(Driver& driver, GLenum target, GLsizeiptr size,
 }
 
 OGLStreamBuffer::~OGLStreamBuffer() {
+    for (GLsync fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
     if (persistent) {
         glBindBuffer(gl_target, gl_buffer.handle);
         glUnmapBuffer(gl_target);
@@ -66,23 +75,28 @@ std::tuple<u8*, GLintptr, bool> OGLStreamBuffer::Map(GLsizeiptr size, GLintptr a
     if (buffer_pos + size > buffer_size) {
         buffer_pos = 0;
         invalidate = true;
+    }
 
-        if (persistent) {
-            glUnmapBuffer(gl_target);
+    if (persistent) {
+        // The buffer stays mapped, so instead of orphaning it the chunk waits for the commands
+        // that read its regions in the previous pass over the ring.
+        FenceRegions(invalidate ? NumRegions : buffer_pos / region_size);
+        if (invalidate) {
+            fenced_region = 0;
         }
+        WaitRegions(buffer_pos, buffer_pos + size);
+        return std::make_tuple(mapped_ptr + buffer_pos, buffer_pos, invalidate);
     }
 
-    if (invalidate || !persistent) {
-        MICROPROFILE_SCOPE(OpenGL_StreamBuffer);
-        GLbitfield flags = GL_MAP_WRITE_BIT | (persistent ? GL_MAP_PERSISTENT_BIT : 0) |
-                           (coherent ? GL_MAP_COHERENT_BIT : GL_MAP_FLUSH_EXPLICIT_BIT) |
-                           (invalidate ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_UNSYNCHRONIZED_BIT);
-        mapped_ptr = static_cast<u8*>(
-            glMapBufferRange(gl_target, buffer_pos, buffer_size - buffer_pos, flags));
-        mapped_offset = buffer_pos;
-    }
+    MICROPROFILE_SCOPE(OpenGL_StreamBuffer);
+    const GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
+        (invalidate ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_UNSYNCHRONIZED_BIT);
+    mapped_ptr = static_cast<u8*>(
+        glMapBufferRange(gl_target, buffer_pos, buffer_size - buffer_pos, flags));
+    mapped_offset = buffer_pos;
 
-    return std::make_tuple(mapped_ptr + buffer_pos - mapped_offset, buffer_pos, invalidate);
+    return std::make_tuple(mapped_ptr, buffer_pos, invalidate);
 }
 
 void OGLStreamBuffer::Unmap(GLsizeiptr size) {
@@ -99,4 +113,30 @@ void OGLStreamBuffer::Unmap(GLsizeiptr size) {
     buffer_pos += size;
 }
 
+void OGLStreamBuffer::FenceRegions(std::size_t end) {
+    for (std::size_t region = fenced_region; region < end; region++) {
+        // Regions skipped at the end of the ring still hold the fence of the previous pass.
+        if (fences[region]) {
+            glDeleteSync(fences[region]);
+        }
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    fenced_region = std::max(fenced_region, end);
+}
+
+void OGLStreamBuffer::WaitRegions(GLintptr begin, GLintptr end) {
+    const std::size_t first = static_cast<std::size_t>(begin / region_size);
+    const std::size_t last = static_cast<std::size_t>((end - 1) / region_size);
+    for (std::size_t region = first; region <= last; region++) {
+        GLsync& fence = fences[region];
+        if (!fence) {
+            continue;
+        }
+        MICROPROFILE_SCOPE(OpenGL_StreamBufferWait);
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
 } // namespace OpenGL
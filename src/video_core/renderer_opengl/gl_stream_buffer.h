@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <tuple>
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 
@@ -12,8 +13,10 @@ namespace OpenGL {
 class Driver;
 
 class OGLStreamBuffer : private NonCopyable {
+    static constexpr std::size_t NumRegions = 16;
+
 public:
-    explicit OGLStreamBuffer(Driver& driver, GLenum target, GLsizeiptr size,
+    explicit OGLStreamBuffer(const Driver& driver, GLenum target, GLsizeiptr size,
                              bool prefer_coherent = false);
     ~OGLStreamBuffer();
 
@@ -23,15 +26,25 @@ public:
     /*
      * Allocates a linear chunk of memory in the GPU buffer with at least "size" bytes
      * and the optional alignment requirement.
-     * If the buffer is full, the whole buffer is reallocated which invalidates old chunks.
+     * If the buffer is full, allocation wraps around to the start, which invalidates old chunks.
+     * With persistent mapping the regions of the ring are fenced and only rewritten once the GPU
+     * is done with them, otherwise the whole buffer is orphaned.
      * The return values are the pointer to the new chunk, the offset within the buffer,
      * and the invalidation flag for previous chunks.
-     * The actual used size must be specified on unmapping the chunk.
+     * The actual used size must be specified on unmapping the chunk, and the commands using it
+     * must be issued before the next chunk is mapped.
      */
     std::tuple<u8*, GLintptr, bool> Map(GLsizeiptr size, GLintptr alignment = 0);
 
     void Unmap(GLsizeiptr size);
 
+private:
+    /// Fences the regions the commands issued so far read from, up to region end.
+    void FenceRegions(std::size_t end);
+
+    /// Waits for the GPU to finish reading the regions overlapping the range.
+    void WaitRegions(GLintptr begin, GLintptr end);
+
 private:
     OGLBuffer gl_buffer;
     GLenum gl_target;
@@ -44,6 +57,10 @@ private:
     GLintptr mapped_offset = 0;
     GLsizeiptr mapped_size = 0;
     u8* mapped_ptr = nullptr;
+
+    GLsizeiptr region_size = 0;
+    std::size_t fenced_region = 0;
+    std::array<GLsync, NumRegions> fences{};
 };
 
 } // namespace OpenGL
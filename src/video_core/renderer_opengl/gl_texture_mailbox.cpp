@@ -8,7 +8,8 @@
 
 namespace OpenGL {
 
-OGLTextureMailbox::OGLTextureMailbox(bool has_debug_tool_) : has_debug_tool{has_debug_tool_} {
+OGLTextureMailbox::OGLTextureMailbox(bool has_debug_tool_, std::size_t num_frames)
+    : swap_chain(num_frames), has_debug_tool{has_debug_tool_} {
     for (auto& frame : swap_chain) {
         free_queue.push(&frame);
     }
@@ -83,6 +84,9 @@ Frontend::Frame* OGLTextureMailbox::GetRenderFrame() {
 }
 
 void OGLTextureMailbox::ReleaseRenderFrame(Frontend::Frame* frame) {
+    frame->presented = false;
+    frame->queue_time = std::chrono::steady_clock::now();
+
     std::unique_lock lock{swap_chain_lock};
     present_queue.push_front(frame);
     present_cv.notify_one();
@@ -124,6 +128,22 @@ Frontend::Frame* OGLTextureMailbox::TryGetPresentFrame(int timeout_ms) {
     return previous_frame;
 }
 
+void OGLTextureMailbox::AddPresentLatency(Frontend::Frame* frame) {
+    if (std::exchange(frame->presented, true)) {
+        return;
+    }
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - frame->queue_time);
+    present_latency_us.fetch_add(latency.count(), std::memory_order_relaxed);
+    present_latency_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::chrono::microseconds OGLTextureMailbox::GetAndResetPresentLatency() {
+    const u32 samples = present_latency_samples.exchange(0, std::memory_order_relaxed);
+    const u64 latency_us = present_latency_us.exchange(0, std::memory_order_relaxed);
+    return std::chrono::microseconds{samples ? latency_us / samples : 0};
+}
+
 void OGLTextureMailbox::DebugNotifyNextFrame() {
     if (!has_debug_tool) {
         return;
@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 #include "core/frontend/emu_window.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
@@ -22,6 +25,9 @@ struct Frame {
     OpenGL::OGLFramebuffer present{}; ///< FBO created on the present thread
     GLsync render_fence{};            ///< Fence created on the render thread
     GLsync present_fence{};           ///< Fence created on the presentation thread
+    bool presented = false;           ///< Frame has been presented at least once
+    /// Time the frame was handed to the presentation thread
+    std::chrono::steady_clock::time_point queue_time{};
 };
 } // namespace Frontend
 
@@ -39,7 +45,8 @@ constexpr std::size_t SWAP_CHAIN_SIZE = 9;
 
 class OGLTextureMailbox : public Frontend::TextureMailbox {
 public:
-    explicit OGLTextureMailbox(bool has_debug_tool = false);
+    explicit OGLTextureMailbox(bool has_debug_tool = false,
+                               std::size_t num_frames = SWAP_CHAIN_SIZE);
     ~OGLTextureMailbox() override;
 
     void ReloadPresentFrame(Frontend::Frame* frame, u32 height, u32 width) override;
@@ -52,6 +59,12 @@ public:
     /// This is virtual as it is to be overriden in OGLVideoDumpingMailbox below.
     virtual void LoadPresentFrame();
 
+    /// Records the latency of a frame presented for the first time (called from present thread)
+    void AddPresentLatency(Frontend::Frame* frame);
+
+    /// Returns the mean time from rendering to presentation since the last call.
+    std::chrono::microseconds GetAndResetPresentLatency();
+
 private:
     /// Signal that a new frame is available (called from GPU thread)
     void DebugNotifyNextFrame();
@@ -63,13 +76,15 @@ public:
     std::mutex swap_chain_lock;
     std::condition_variable free_cv;
     std::condition_variable present_cv;
-    std::array<Frontend::Frame, SWAP_CHAIN_SIZE> swap_chain{};
+    std::vector<Frontend::Frame> swap_chain;
     std::queue<Frontend::Frame*> free_queue{};
     std::deque<Frontend::Frame*> present_queue{};
     Frontend::Frame* previous_frame = nullptr;
     std::mutex debug_synch_mutex;
     std::condition_variable debug_synch_condition;
     std::atomic_int frame_for_debug{};
+    std::atomic<u64> present_latency_us{};
+    std::atomic<u32> present_latency_samples{};
     const bool has_debug_tool; ///< When true, using a GPU debugger, so keep frames in lock-step
 };
 
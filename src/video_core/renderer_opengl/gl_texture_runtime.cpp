@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include "common/hash.h"
+#include "common/literals.h"
+#include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "video_core/custom_textures/material.h"
@@ -12,10 +15,13 @@
 #include "video_core/renderer_opengl/gl_texture_runtime.h"
 #include "video_core/renderer_opengl/pica_to_gl.h"
 
+MICROPROFILE_DEFINE(OpenGL_WaitForDownload, "OpenGL", "Wait for download", MP_RGB(128, 192, 64));
+
 namespace OpenGL {
 
 namespace {
 
+using namespace Common::Literals;
 using VideoCore::MapType;
 using VideoCore::PixelFormat;
 using VideoCore::SurfaceFlagBits;
@@ -24,6 +30,11 @@ using VideoCore::TextureType;
 
 constexpr GLenum TEMP_UNIT = GL_TEXTURE15;
 
+constexpr GLsizeiptr UPLOAD_BUFFER_SIZE = 16_MiB;
+
+/// Larger uploads would leave little room for the others before the ring waits for the GPU.
+constexpr u32 MAX_BUFFERED_UPLOAD = UPLOAD_BUFFER_SIZE / 4;
+
 constexpr FormatTuple DEFAULT_TUPLE = {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
 
 static constexpr std::array<FormatTuple, 4> DEPTH_TUPLES = {{
@@ -100,6 +111,8 @@ static constexpr std::array<FormatTuple, 8> CUSTOM_TUPLES = {{
     glBindTexture(target, texture.handle);
     glTexStorage2D(target, levels, tuple.internal_format, width, height);
 
+    // Textures referenced by bindless handles can't change their parameters afterwards.
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
     glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -111,22 +124,41 @@ static constexpr std::array<FormatTuple, 8> CUSTOM_TUPLES = {{
     return texture;
 }
 
+/// Whether the format is one of the 16-bit color formats ReinterpretRGB16 converts between.
+[[nodiscard]] constexpr bool IsRGB16(PixelFormat format) {
+    return format == PixelFormat::RGB5A1 || format == PixelFormat::RGB565 ||
+           format == PixelFormat::RGBA4;
+}
+
 } // Anonymous namespace
 
 TextureRuntime::TextureRuntime(const Driver& driver_, VideoCore::RendererBase& renderer)
-    : driver{driver_}, blit_helper{driver} {
+    : driver{driver_}, blit_helper{driver},
+      upload_buffer{driver, GL_PIXEL_UNPACK_BUFFER, UPLOAD_BUFFER_SIZE} {
+    // Client memory uploads would read from the buffer while it is bound.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     for (std::size_t i = 0; i < draw_fbos.size(); ++i) {
         draw_fbos[i].Create();
         read_fbos[i].Create();
     }
 }
 
-TextureRuntime::~TextureRuntime() = default;
+TextureRuntime::~TextureRuntime() {
+    for (DownloadSlot& slot : download_slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+    }
+}
 
 u32 TextureRuntime::RemoveThreshold() {
     return SWAP_CHAIN_SIZE;
 }
 
+bool TextureRuntime::IsCustomFormatSupported(VideoCore::CustomPixelFormat format) const {
+    return driver.IsCustomFormatSupported(format);
+}
+
 bool TextureRuntime::NeedsConversion(VideoCore::PixelFormat pixel_format) const {
     const bool should_convert = pixel_format == PixelFormat::RGBA8 || // Needs byteswap
                                 pixel_format == PixelFormat::RGB8;    // Is converted to RGBA8
@@ -134,6 +166,18 @@ bool TextureRuntime::NeedsConversion(VideoCore::PixelFormat pixel_format) const
 }
 
 VideoCore::StagingData TextureRuntime::FindStaging(u32 size, bool upload) {
+    // Uploads are decoded straight to the pixel unpack buffer, so that the driver does not need
+    // to copy the pixels out of client memory before glTexSubImage2D returns.
+    if (upload && size <= MAX_BUFFERED_UPLOAD) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload_buffer.GetHandle());
+        const auto [data, offset, invalidate] = upload_buffer.Map(size, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return VideoCore::StagingData{
+            .size = size,
+            .offset = static_cast<u32>(offset),
+            .mapped = std::span{data, size},
+        };
+    }
     if (size > staging_buffer.size()) {
         staging_buffer.resize(size);
     }
@@ -144,6 +188,82 @@ VideoCore::StagingData TextureRuntime::FindStaging(u32 size, bool upload) {
     };
 }
 
+bool TextureRuntime::DownloadAsync(Surface& surface, const VideoCore::SurfaceParams& params,
+                                   VideoCore::PendingDownload& pending) {
+    const u32 size = params.width * params.height * surface.GetInternalBytesPerPixel();
+    const std::size_t index = download_count % NUM_DOWNLOAD_SLOTS;
+    DownloadSlot& slot = download_slots[index];
+    if (slot.fence) {
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (!slot.buffer.handle) {
+        slot.buffer.Create();
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer.handle);
+    if (slot.buffer_size < static_cast<GLsizeiptr>(size)) {
+        slot.buffer_size = size;
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        slot.data.resize(size);
+    }
+
+    pending.staging = VideoCore::StagingData{
+        .size = size,
+        .offset = 0,
+        .mapped = std::span{slot.data.data(), size},
+    };
+    pending.fence = index;
+    pending.position = download_count++;
+    const VideoCore::BufferTextureCopy download = {
+        .buffer_offset = 0,
+        .buffer_size = size,
+        .texture_rect = surface.GetSubRect(params),
+        .texture_level = surface.LevelOf(params.addr),
+    };
+    surface.Download(download, pending.staging);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    return true;
+}
+
+bool TextureRuntime::FinishDownload(const VideoCore::PendingDownload& pending) {
+    // The slot has been handed to a newer download since this one started.
+    if (download_count - pending.position > NUM_DOWNLOAD_SLOTS) {
+        return false;
+    }
+
+    // A missing fence means the pixels have already been copied out of the buffer.
+    DownloadSlot& slot = download_slots[pending.fence];
+    if (!slot.fence) {
+        return true;
+    }
+    {
+        MICROPROFILE_SCOPE(OpenGL_WaitForDownload);
+        glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    const GLsizeiptr size = pending.staging.size;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer.handle);
+    const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    std::memcpy(pending.staging.mapped.data(), data, size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+void* TextureRuntime::PixelPointer(const VideoCore::StagingData& staging) const {
+    // Staging outside the client buffer is read or written through a bound pixel buffer.
+    if (staging.mapped.data() == staging_buffer.data()) {
+        return staging.mapped.data();
+    }
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(staging.offset));
+}
+
 const FormatTuple& TextureRuntime::GetFormatTuple(PixelFormat pixel_format) const {
     if (pixel_format == PixelFormat::Invalid) {
         return DEFAULT_TUPLE;
@@ -176,8 +296,8 @@ bool TextureRuntime::Reinterpret(Surface& source, Surface& dest,
     ASSERT_MSG(src_format != dst_format, "Reinterpretation with the same format is invalid");
     if (src_format == PixelFormat::D24S8 && dst_format == PixelFormat::RGBA8) {
         blit_helper.ConvertDS24S8ToRGBA8(source, dest, copy);
-    } else if (src_format == PixelFormat::RGBA4 && dst_format == PixelFormat::RGB5A1) {
-        blit_helper.ConvertRGBA4ToRGB5A1(source, dest, copy);
+    } else if (IsRGB16(src_format) && IsRGB16(dst_format)) {
+        blit_helper.ReinterpretRGB16(source, dest, copy);
     } else {
         LOG_WARNING(Render_OpenGL, "Unimplemented reinterpretation {} -> {}",
                     VideoCore::PixelFormatAsString(src_format),
@@ -276,6 +396,21 @@ bool TextureRuntime::CopyTextures(Surface& source, Surface& dest,
     return true;
 }
 
+void TextureRuntime::CopyCubeFaces(std::span<Surface* const, 6> faces, Surface& cube,
+                                   u32 levels) {
+    for (u32 layer = 0; layer < faces.size(); layer++) {
+        Surface* face = faces[layer];
+        if (!face) {
+            continue;
+        }
+        for (u32 level = 0; level < levels; level++) {
+            const u32 width_lod = face->GetScaledWidth() >> level;
+            glCopyImageSubData(face->Handle(), GL_TEXTURE_2D, level, 0, 0, 0, cube.Handle(),
+                               GL_TEXTURE_CUBE_MAP, level, 0, 0, layer, width_lod, width_lod, 1);
+        }
+    }
+}
+
 bool TextureRuntime::BlitTextures(Surface& source, Surface& dest,
                                   const VideoCore::TextureBlit& blit) {
     OpenGLState state = OpenGLState::GetCurState();
@@ -306,7 +441,6 @@ void TextureRuntime::GenerateMipmaps(Surface& surface) {
     const auto generate = [&](u32 index) {
         state.texture_units[0].texture_2d = surface.Handle(index);
         state.Apply();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, surface.levels - 1);
         glGenerateMipmap(GL_TEXTURE_2D);
     };
 
@@ -334,9 +468,10 @@ Surface::Surface(TextureRuntime& runtime_, const VideoCore::SurfaceParams& param
     }
 }
 
-Surface::Surface(TextureRuntime& runtime, const VideoCore::SurfaceBase& surface,
+Surface::Surface(TextureRuntime& runtime_, const VideoCore::SurfaceBase& surface,
                  const VideoCore::Material* mat)
-    : SurfaceBase{surface}, tuple{runtime.GetFormatTuple(mat->format)} {
+    : SurfaceBase{surface}, driver{&runtime_.GetDriver()}, runtime{&runtime_},
+      tuple{runtime->GetFormatTuple(mat->format)} {
     if (mat && !driver->IsCustomFormatSupported(mat->format)) {
         return;
     }
@@ -360,7 +495,10 @@ Surface::Surface(TextureRuntime& runtime, const VideoCore::SurfaceBase& surface,
     }
 }
 
-Surface::~Surface() = default;
+Surface::~Surface() {
+    // The names of the deleted textures may be reused, invalidating handles made from them.
+    runtime->texture_generation++;
+}
 
 GLuint Surface::Handle(u32 index) const noexcept {
     if (!textures[index].handle) {
@@ -393,22 +531,36 @@ void Surface::Upload(const VideoCore::BufferTextureCopy& upload,
     const u32 unscaled_height = upload.texture_rect.GetHeight();
     glPixelStorei(GL_UNPACK_ROW_LENGTH, unscaled_width);
 
+    const VideoCore::TextureBlit blit = {
+        .src_level = upload.texture_level,
+        .dst_level = upload.texture_level,
+        .src_rect = upload.texture_rect,
+        .dst_rect = upload.texture_rect * res_scale,
+    };
+    // Hash before the staging memory is unmapped, identical data reuses the filtered result.
+    const u64 filter_hash = runtime->blit_helper.IsFilterCacheable(*this, blit)
+                                ? Common::ComputeHash64(staging.mapped.data(), staging.size)
+                                : 0;
+
     glActiveTexture(TEMP_UNIT);
     glBindTexture(GL_TEXTURE_2D, Handle(0));
 
+    const bool buffered = staging.mapped.data() != runtime->staging_buffer.data();
+    if (buffered) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, runtime->upload_buffer.GetHandle());
+        runtime->upload_buffer.Unmap(staging.size);
+    }
+
     glTexSubImage2D(GL_TEXTURE_2D, upload.texture_level, upload.texture_rect.left,
                     upload.texture_rect.bottom, unscaled_width, unscaled_height, tuple.format,
-                    tuple.type, staging.mapped.data());
+                    tuple.type, runtime->PixelPointer(staging));
 
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    if (buffered) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
 
-    const VideoCore::TextureBlit blit = {
-        .src_level = upload.texture_level,
-        .dst_level = upload.texture_level,
-        .src_rect = upload.texture_rect,
-        .dst_rect = upload.texture_rect * res_scale,
-    };
-    if (res_scale != 1 && !runtime->blit_helper.Filter(*this, blit)) {
+    if (res_scale != 1 && !runtime->blit_helper.Filter(*this, blit, filter_hash)) {
         BlitScale(blit, true);
     }
 }
@@ -488,7 +640,7 @@ void Surface::Download(const VideoCore::BufferTextureCopy& download,
     // Read the pixel data to the staging buffer
     const auto& tuple = runtime->GetFormatTuple(pixel_format);
     glReadPixels(download.texture_rect.left, download.texture_rect.bottom, unscaled_width,
-                 unscaled_height, tuple.format, tuple.type, staging.mapped.data());
+                 unscaled_height, tuple.format, tuple.type, runtime->PixelPointer(staging));
 
     glPixelStorei(GL_PACK_ROW_LENGTH, 0);
 }
@@ -514,7 +666,7 @@ bool Surface::DownloadWithoutFbo(const VideoCore::BufferTextureCopy& download,
         glGetTextureSubImage(Handle(0), download.texture_level, download.texture_rect.left,
                              download.texture_rect.bottom, 0, download.texture_rect.GetWidth(),
                              download.texture_rect.GetHeight(), 1, tuple.format, tuple.type,
-                             buf_size, staging.mapped.data());
+                             buf_size, runtime->PixelPointer(staging));
         return true;
     } else if (is_full_download) {
         // This should only trigger for full texture downloads in oldish intel drivers
@@ -524,7 +676,7 @@ bool Surface::DownloadWithoutFbo(const VideoCore::BufferTextureCopy& download,
         state.Apply();
 
         glGetTexImage(GL_TEXTURE_2D, download.texture_level, tuple.format, tuple.type,
-                      staging.mapped.data());
+                      runtime->PixelPointer(staging));
 
         return true;
     }
@@ -559,6 +711,7 @@ void Surface::ScaleUp(u32 new_scale) {
     }
 
     res_scale = new_scale;
+    runtime->texture_generation++;
     textures[1] = MakeHandle(GL_TEXTURE_2D, GetScaledWidth(), GetScaledHeight(), levels, tuple,
                              DebugName(true));
 
@@ -8,6 +8,7 @@
 #include "video_core/rasterizer_cache/rasterizer_cache_base.h"
 #include "video_core/rasterizer_cache/surface_base.h"
 #include "video_core/renderer_opengl/gl_blit_helper.h"
+#include "video_core/renderer_opengl/gl_stream_buffer.h"
 
 namespace VideoCore {
 struct Material;
@@ -48,12 +49,44 @@ public:
     /// Submits and waits for current GPU work.
     void Finish() {}
 
+    /// Returns a counter that changes whenever a surface texture is deleted.
+    u64 TextureGeneration() const noexcept {
+        return texture_generation;
+    }
+
+    /// OpenGL does not report a memory budget, surfaces are only limited by the user setting.
+    u64 SurfaceMemoryBudget(u64 surface_memory) const {
+        return 0;
+    }
+
     /// Returns true if the provided pixel format cannot be used natively by the runtime.
     bool NeedsConversion(VideoCore::PixelFormat pixel_format) const;
 
+    /// Returns true if custom textures of the provided format can be sampled directly.
+    bool IsCustomFormatSupported(VideoCore::CustomPixelFormat format) const;
+
     /// Maps an internal staging buffer of the provided size of pixel uploads/downloads
     VideoCore::StagingData FindStaging(u32 size, bool upload);
 
+    /// Textures are always decoded on the CPU, the upload staging is written through a mapping.
+    bool DecodeTexture(const VideoCore::SurfaceParams& params, std::span<const u8> source,
+                       const VideoCore::StagingData& staging, bool convert) {
+        return false;
+    }
+
+    /// Downloaded textures are always encoded on the CPU for the same reason.
+    bool EncodeTexture(Surface& surface, const VideoCore::SurfaceParams& params,
+                       std::span<u8> dest, bool convert) {
+        return false;
+    }
+
+    /// Starts reading back a region of the surface to a pixel pack buffer without waiting for it.
+    bool DownloadAsync(Surface& surface, const VideoCore::SurfaceParams& params,
+                       VideoCore::PendingDownload& pending);
+
+    /// Waits for a download started by DownloadAsync and copies its pixels to the staging.
+    bool FinishDownload(const VideoCore::PendingDownload& pending);
+
     /// Returns the OpenGL format tuple associated with the provided pixel format
     const FormatTuple& GetFormatTuple(VideoCore::PixelFormat pixel_format) const;
     const FormatTuple& GetFormatTuple(VideoCore::CustomPixelFormat pixel_format);
@@ -72,6 +105,9 @@ public:
         return CopyTextures(source, dest, std::array{copy});
     }
 
+    /// Copies the first levels of each face surface to its layer of the cube, faces may be null
+    void CopyCubeFaces(std::span<Surface* const, 6> faces, Surface& cube, u32 levels);
+
     /// Blits a rectangle of source to another rectange of dest
     bool BlitTextures(Surface& source, Surface& dest, const VideoCore::TextureBlit& blit);
 
@@ -87,10 +123,26 @@ private:
     /// Fills the rectangle of the surface with the value provided, without an fbo.
     bool ClearTextureWithoutFbo(Surface& surface, const VideoCore::TextureClear& clear);
 
+    /// Returns the pixel pointer of the staging, an offset when it lives in a pixel buffer.
+    void* PixelPointer(const VideoCore::StagingData& staging) const;
+
 private:
+    /// Pixel pack buffer a single asynchronous download is read back to.
+    struct DownloadSlot {
+        OGLBuffer buffer;
+        GLsizeiptr buffer_size{};
+        GLsync fence{};
+        std::vector<u8> data;
+    };
+    static constexpr std::size_t NUM_DOWNLOAD_SLOTS = 8;
+
     const Driver& driver;
     BlitHelper blit_helper;
     std::vector<u8> staging_buffer;
+    OGLStreamBuffer upload_buffer;
+    std::array<DownloadSlot, NUM_DOWNLOAD_SLOTS> download_slots;
+    u64 download_count{};
+    u64 texture_generation{};
     std::array<OGLFramebuffer, 3> draw_fbos;
     std::array<OGLFramebuffer, 3> read_fbos;
 };
@@ -6,14 +6,9 @@
 
 #include <string>
 #include <string_view>
-#include <vector>
 
 namespace OpenGL {
 
-// Returns a vector of the names of the shaders available in the
-// "shaders" directory in citra's data directory
-std::vector<std::string> GetPostProcessingShaderList(bool anaglyph);
-
 // Returns the shader code for the shader named "shader_name"
 // with the appropriate header prepended to it
 // If anaglyph is true, it searches the shaders/anaglyph directory rather than
@@ -78,9 +78,12 @@ RendererOpenGL::RendererOpenGL(Core::System& system, Pica::PicaCore& pica_,
       rasterizer{system.Memory(), pica, system.CustomTexManager(), *this, driver},
       frame_dumper{system, window} {
     const bool has_debug_tool = driver.HasDebugTool();
-    window.mailbox = std::make_unique<OGLTextureMailbox>(has_debug_tool);
+    // One frame is on screen and one is rendered while the others wait to be presented.
+    const std::size_t num_frames = Settings::values.present_queue_depth.GetValue() + 2;
+    window.mailbox = std::make_unique<OGLTextureMailbox>(has_debug_tool, num_frames);
     if (secondary_window) {
-        secondary_window->mailbox = std::make_unique<OGLTextureMailbox>(has_debug_tool);
+        secondary_window->mailbox =
+            std::make_unique<OGLTextureMailbox>(has_debug_tool, num_frames);
     }
     frame_dumper.mailbox = std::make_unique<OGLVideoDumpingMailbox>();
     InitOpenGLObjects();
@@ -117,6 +120,9 @@ void RendererOpenGL::SwapBuffers() {
     }
 
     system.perf_stats->EndSwap();
+    auto* mailbox = static_cast<OGLTextureMailbox*>(render_window.mailbox.get());
+    system.perf_stats->ReportPresentLatency(mailbox->GetAndResetPresentLatency());
+    system.perf_stats->ReportShaderCompiles(rasterizer.GetAndResetShaderCompiles());
     EndFrame();
     prev_state.Apply();
     rasterizer.TickFrame();
@@ -868,9 +874,11 @@ void RendererOpenGL::TryPresent(int timeout_ms, bool is_secondary) {
     // glDeleteSync(frame.render_sync);
     // frame.render_sync = 0;
 
+    // The frame normally matches the window, where a plain copy lets drivers skip filtering.
+    const bool is_scaled = frame->width != layout.width || frame->height != layout.height;
     glBindFramebuffer(GL_READ_FRAMEBUFFER, frame->present.handle);
     glBlitFramebuffer(0, 0, frame->width, frame->height, 0, 0, layout.width, layout.height,
-                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+                      GL_COLOR_BUFFER_BIT, is_scaled ? GL_LINEAR : GL_NEAREST);
 
     // Delete the fence if we're re-presenting to avoid leaking fences
     if (frame->present_fence) {
@@ -880,6 +888,7 @@ void RendererOpenGL::TryPresent(int timeout_ms, bool is_secondary) {
     /* insert fence for the main thread to block on */
     frame->present_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     glFlush();
+    static_cast<OGLTextureMailbox*>(window.mailbox.get())->AddPresentLatency(frame);
 
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 }
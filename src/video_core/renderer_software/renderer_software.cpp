@@ -20,6 +20,9 @@ RendererSoftware::~RendererSoftware() = default;
 void RendererSoftware::SwapBuffers() {
     system.perf_stats->StartSwap();
     PrepareRenderTarget();
+    if (frame_callback) {
+        frame_callback(screen_infos);
+    }
     system.perf_stats->EndSwap();
     EndFrame();
 }
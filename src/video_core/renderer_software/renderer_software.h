@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <functional>
+#include <span>
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_software/sw_rasterizer.h"
 
@@ -21,6 +23,9 @@ struct ScreenInfo {
 
 class RendererSoftware : public VideoCore::RendererBase {
 public:
+    /// Receives the top left, top right and bottom screens of every frame.
+    using FrameCallback = std::function<void(std::span<const ScreenInfo, 3> screens)>;
+
     explicit RendererSoftware(Core::System& system, Pica::PicaCore& pica,
                               Frontend::EmuWindow& window);
     ~RendererSoftware() override;
@@ -33,6 +38,14 @@ public:
         return screen_infos[static_cast<u32>(id)];
     }
 
+    /**
+     * Hands every frame to the callback on the emulation thread once it is composed, so the
+     * frames can be consumed without a window presenting them.
+     */
+    void SetFrameCallback(FrameCallback callback) {
+        frame_callback = std::move(callback);
+    }
+
     void SwapBuffers() override;
     void TryPresent(int timeout_ms, bool is_secondary) override {}
 
@@ -45,6 +58,7 @@ private:
     Pica::PicaCore& pica;
     RasterizerSoftware rasterizer;
     std::array<ScreenInfo, 3> screen_infos{};
+    FrameCallback frame_callback;
 };
 
 } // namespace SwRenderer
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <bit>
 #include "video_core/renderer_software/sw_lighting.h"
 
 namespace SwRenderer {
@@ -10,23 +11,45 @@ namespace SwRenderer {
 using Pica::f16;
 using Pica::LightingRegs;
 
-static float LookupLightingLut(const Pica::PicaCore::Lighting& lighting, std::size_t lut_index,
-                               u8 index, float delta) {
-    ASSERT_MSG(lut_index < lighting.luts.size(), "Out of range lut");
-    ASSERT_MSG(index < lighting.luts[lut_index].size(), "Out of range index");
-
-    const auto& lut = lighting.luts[lut_index][index];
+void LightingTables::Update(const Pica::LightingRegs& lighting,
+                            Pica::PicaCore::Lighting& lighting_state) {
+    // Nothing has been decoded yet, the dirty bits may have been consumed by another renderer.
+    if (!valid) {
+        lighting_state.lut_dirty = lighting_state.LutAllDirty;
+        valid = true;
+    }
 
-    const float lut_value = lut.ToFloat();
-    const float lut_diff = lut.DiffToFloat();
+    while (lighting_state.lut_dirty) {
+        const u32 index = std::countr_zero(lighting_state.lut_dirty);
+        lighting_state.lut_dirty &= ~(1 << index);
+        for (std::size_t i = 0; i < luts[index].size(); i++) {
+            const auto& entry = lighting_state.luts[index][i];
+            luts[index][i] = {entry.ToFloat(), entry.DiffToFloat()};
+        }
+    }
 
-    return lut_value + lut_diff * delta;
+    for (std::size_t num = 0; num < lights.size(); num++) {
+        const auto& light_config = lighting.light[num];
+        const Common::Vec3<s32> spot_dir{light_config.spot_x.Value(), light_config.spot_y.Value(),
+                                         light_config.spot_z.Value()};
+        lights[num] = Light{
+            .position = {f16::FromRaw(light_config.x).ToFloat32(),
+                         f16::FromRaw(light_config.y).ToFloat32(),
+                         f16::FromRaw(light_config.z).ToFloat32()},
+            .spot_direction = spot_dir.Cast<float>() / 2047.0f,
+            .specular_0 = light_config.specular_0.ToVec3f(),
+            .specular_1 = light_config.specular_1.ToVec3f(),
+            .diffuse = light_config.diffuse.ToVec3f(),
+            .ambient = light_config.ambient.ToVec3f(),
+            .dist_atten_scale = Pica::f20::FromRaw(light_config.dist_atten_scale).ToFloat32(),
+            .dist_atten_bias = Pica::f20::FromRaw(light_config.dist_atten_bias).ToFloat32(),
+        };
+    }
 }
 
-std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
-    const Pica::LightingRegs& lighting, const Pica::PicaCore::Lighting& lighting_state,
-    const Common::Quaternion<f32>& normquat, const Common::Vec3f& view,
-    std::span<const Common::Vec4<u8>, 4> texture_color) {
+std::pair<Common::Vec4<u8>, Common::Vec4<u8>> LightingTables::ComputeFragmentsColors(
+    const Pica::LightingRegs& lighting, const Common::Quaternion<f32>& normquat,
+    const Common::Vec3f& view, std::span<const Common::Vec4<u8>, 4> texture_color) const {
 
     Common::Vec4f shadow;
     if (lighting.config0.enable_shadow) {
@@ -70,42 +93,39 @@ std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
 
     Common::Vec4f diffuse_sum = {0.0f, 0.0f, 0.0f, 1.0f};
     Common::Vec4f specular_sum = {0.0f, 0.0f, 0.0f, 1.0f};
+    const Common::Vec3f norm_view = view.Normalized();
 
     for (u32 light_index = 0; light_index <= lighting.max_light_index; ++light_index) {
         u32 num = lighting.light_enable.GetNum(light_index);
         const auto& light_config = lighting.light[num];
+        const Light& light = lights[num];
 
-        const Common::Vec3f position = {f16::FromRaw(light_config.x).ToFloat32(),
-                                        f16::FromRaw(light_config.y).ToFloat32(),
-                                        f16::FromRaw(light_config.z).ToFloat32()};
         Common::Vec3f refl_value{};
         Common::Vec3f light_vector{};
 
         if (light_config.config.directional) {
-            light_vector = position;
+            light_vector = light.position;
         } else {
-            light_vector = position + view;
+            light_vector = light.position + view;
         }
 
         [[maybe_unused]] const f32 length = light_vector.Normalize();
 
-        Common::Vec3f norm_view = view.Normalized();
         Common::Vec3f half_vector = norm_view + light_vector;
 
         f32 dist_atten = 1.0f;
         if (!lighting.IsDistAttenDisabled(num)) {
-            const f32 scale = Pica::f20::FromRaw(light_config.dist_atten_scale).ToFloat32();
-            const f32 bias = Pica::f20::FromRaw(light_config.dist_atten_bias).ToFloat32();
             const std::size_t lut =
                 static_cast<std::size_t>(LightingRegs::LightingSampler::DistanceAttenuation) + num;
 
-            const f32 sample_loc = std::clamp(scale * length + bias, 0.0f, 1.0f);
+            const f32 sample_loc =
+                std::clamp(light.dist_atten_scale * length + light.dist_atten_bias, 0.0f, 1.0f);
 
             const u8 lutindex =
                 static_cast<u8>(std::clamp(std::floor(sample_loc * 256.0f), 0.0f, 255.0f));
             const f32 delta = sample_loc * 256 - lutindex;
 
-            dist_atten = LookupLightingLut(lighting_state, lut, lutindex, delta);
+            dist_atten = LookupLut(lut, lutindex, delta);
         }
 
         auto get_lut_value = [&](LightingRegs::LightingLutInput input, bool abs,
@@ -126,12 +146,9 @@ std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
             case LightingRegs::LightingLutInput::LN:
                 result = Common::Dot(light_vector, normal);
                 break;
-            case LightingRegs::LightingLutInput::SP: {
-                Common::Vec3<s32> spot_dir{light_config.spot_x.Value(), light_config.spot_y.Value(),
-                                           light_config.spot_z.Value()};
-                result = Common::Dot(light_vector, spot_dir.Cast<float>() / 2047.0f);
+            case LightingRegs::LightingLutInput::SP:
+                result = Common::Dot(light_vector, light.spot_direction);
                 break;
-            }
             case LightingRegs::LightingLutInput::CP:
                 if (lighting.config0.config == LightingRegs::LightingConfig::Config7) {
                     const Common::Vec3f norm_half_vector = half_vector.Normalized();
@@ -169,8 +186,7 @@ std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
             }
 
             const f32 scale = lighting.lut_scale.GetScale(scale_enum);
-            return scale * LookupLightingLut(lighting_state, static_cast<std::size_t>(sampler),
-                                             index, delta);
+            return scale * LookupLut(static_cast<std::size_t>(sampler), index, delta);
         };
 
         // If enabled, compute spot light attenuation value
@@ -194,7 +210,7 @@ std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
                               lighting.lut_scale.d0, LightingRegs::LightingSampler::Distribution0);
         }
 
-        Common::Vec3f specular_0 = d0_lut_value * light_config.specular_0.ToVec3f();
+        Common::Vec3f specular_0 = d0_lut_value * light.specular_0;
 
         // If enabled, lookup ReflectRed value, otherwise, 1.0 is used
         if (lighting.config1.disable_lut_rr == 0 &&
@@ -239,7 +255,7 @@ std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
                               lighting.lut_scale.d1, LightingRegs::LightingSampler::Distribution1);
         }
 
-        Common::Vec3f specular_1 = d1_lut_value * refl_value * light_config.specular_1.ToVec3f();
+        Common::Vec3f specular_1 = d1_lut_value * refl_value * light.specular_1;
 
         // Fresnel
         // Note: only the last entry in the light slots applies the Fresnel factor
@@ -294,8 +310,7 @@ std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
         const auto shadow_secondary =
             shadow_secondary_enable ? shadow.xyz() : Common::MakeVec(1.f, 1.f, 1.f);
 
-        const auto diffuse = (light_config.diffuse.ToVec3f() * dot_product * shadow_primary +
-                              light_config.ambient.ToVec3f()) *
+        const auto diffuse = (light.diffuse * dot_product * shadow_primary + light.ambient) *
                              dist_atten * spot_atten;
         const auto specular = (specular_0 + specular_1) * clamp_highlights * dist_atten *
                               spot_atten * shadow_secondary;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <span>
 #include <utility>
 
@@ -13,9 +14,43 @@
 
 namespace SwRenderer {
 
-std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
-    const Pica::LightingRegs& lighting, const Pica::PicaCore::Lighting& lighting_state,
-    const Common::Quaternion<f32>& normquat, const Common::Vec3f& view,
-    std::span<const Common::Vec4<u8>, 4> texture_color);
+/**
+ * The lighting LUTs and light parameters of the current configuration decoded to floats once
+ * per draw, so lighting a fragment only has to interpolate the LUTs and accumulate the lights.
+ */
+class LightingTables {
+public:
+    /// Decodes the light parameters and the LUTs written since the last call.
+    void Update(const Pica::LightingRegs& lighting, Pica::PicaCore::Lighting& lighting_state);
+
+    /// Returns the primary and secondary fragment colors of a fragment.
+    [[nodiscard]] std::pair<Common::Vec4<u8>, Common::Vec4<u8>> ComputeFragmentsColors(
+        const Pica::LightingRegs& lighting, const Common::Quaternion<f32>& normquat,
+        const Common::Vec3f& view, std::span<const Common::Vec4<u8>, 4> texture_color) const;
+
+private:
+    struct Light {
+        Common::Vec3f position;
+        Common::Vec3f spot_direction;
+        Common::Vec3f specular_0;
+        Common::Vec3f specular_1;
+        Common::Vec3f diffuse;
+        Common::Vec3f ambient;
+        f32 dist_atten_scale;
+        f32 dist_atten_bias;
+    };
+
+    /// Returns the LUT entry at index interpolated towards the next one by delta.
+    [[nodiscard]] f32 LookupLut(std::size_t lut, u8 index, f32 delta) const {
+        const auto& entry = luts[lut][index];
+        return entry[0] + entry[1] * delta;
+    }
+
+private:
+    /// The value and difference of every entry, next to each other so a lookup loads both.
+    std::array<std::array<std::array<f32, 2>, 256>, Pica::LightingRegs::NumLightingSampler> luts{};
+    std::array<Light, 8> lights{};
+    bool valid{};
+};
 
 } // namespace SwRenderer
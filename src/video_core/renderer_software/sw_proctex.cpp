@@ -14,15 +14,16 @@ using ProcTexShift = Pica::TexturingRegs::ProcTexShift;
 using ProcTexCombiner = Pica::TexturingRegs::ProcTexCombiner;
 using ProcTexFilter = Pica::TexturingRegs::ProcTexFilter;
 using Pica::f16;
+using ValueTable = std::array<std::array<f32, 2>, 128>;
 
-float LookupLUT(const std::array<Pica::PicaCore::ProcTex::ValueEntry, 128>& lut, float coord) {
+float LookupLUT(const ValueTable& lut, float coord) {
     // For NoiseLUT/ColorMap/AlphaMap, coord=0.0 is lut[0], coord=127.0/128.0 is lut[127] and
     // coord=1.0 is lut[127]+lut_diff[127]. For other indices, the result is interpolated using
     // value entries and difference entries.
     coord *= 128;
     const int index_int = std::min(static_cast<int>(coord), 127);
     const float frac = coord - index_int;
-    return lut[index_int].ToFloat() + frac * lut[index_int].DiffToFloat();
+    return lut[index_int][0] + frac * lut[index_int][1];
 }
 
 // These function are used to generate random noise for procedural texture. Their results are
@@ -46,28 +47,6 @@ float NoiseRand2D(unsigned int x, unsigned int y) {
     return -1.0f + v2 * 2.0f / 15.0f;
 }
 
-float NoiseCoef(float u, float v, const Pica::TexturingRegs& regs,
-                const Pica::PicaCore::ProcTex& state) {
-    const float freq_u = f16::FromRaw(regs.proctex_noise_frequency.u).ToFloat32();
-    const float freq_v = f16::FromRaw(regs.proctex_noise_frequency.v).ToFloat32();
-    const float phase_u = f16::FromRaw(regs.proctex_noise_u.phase).ToFloat32();
-    const float phase_v = f16::FromRaw(regs.proctex_noise_v.phase).ToFloat32();
-    const float x = 9 * freq_u * std::abs(u + phase_u);
-    const float y = 9 * freq_v * std::abs(v + phase_v);
-    const int x_int = static_cast<int>(x);
-    const int y_int = static_cast<int>(y);
-    const float x_frac = x - x_int;
-    const float y_frac = y - y_int;
-
-    const float g0 = NoiseRand2D(x_int, y_int) * (x_frac + y_frac);
-    const float g1 = NoiseRand2D(x_int + 1, y_int) * (x_frac + y_frac - 1);
-    const float g2 = NoiseRand2D(x_int, y_int + 1) * (x_frac + y_frac - 1);
-    const float g3 = NoiseRand2D(x_int + 1, y_int + 1) * (x_frac + y_frac - 2);
-    const float x_noise = LookupLUT(state.noise_table, x_frac);
-    const float y_noise = LookupLUT(state.noise_table, y_frac);
-    return Common::BilinearInterp(g0, g1, g2, g3, x_noise, y_noise);
-}
-
 float GetShiftOffset(float v, ProcTexShift mode, ProcTexClamp clamp_mode) {
     const float offset = (clamp_mode == ProcTexClamp::MirroredRepeat) ? 1 : 0.5f;
     switch (mode) {
@@ -114,8 +93,7 @@ void ClampCoord(float& coord, ProcTexClamp mode) {
     }
 }
 
-float CombineAndMap(float u, float v, ProcTexCombiner combiner,
-                    const std::array<Pica::PicaCore::ProcTex::ValueEntry, 128>& map_table) {
+float CombineAndMap(float u, float v, ProcTexCombiner combiner, const ValueTable& map_table) {
     float f;
     switch (combiner) {
     case ProcTexCombiner::U:
@@ -157,8 +135,68 @@ float CombineAndMap(float u, float v, ProcTexCombiner combiner,
 }
 } // Anonymous namespace
 
-Common::Vec4<u8> ProcTex(float u, float v, const Pica::TexturingRegs& regs,
-                         const Pica::PicaCore::ProcTex& state) {
+float ProcTexTables::NoiseCoef(float u, float v) const {
+    const float x = 9 * noise_frequency.x * std::abs(u + noise_phase.x);
+    const float y = 9 * noise_frequency.y * std::abs(v + noise_phase.y);
+    const int x_int = static_cast<int>(x);
+    const int y_int = static_cast<int>(y);
+    const float x_frac = x - x_int;
+    const float y_frac = y - y_int;
+
+    const float g0 = NoiseRand2D(x_int, y_int) * (x_frac + y_frac);
+    const float g1 = NoiseRand2D(x_int + 1, y_int) * (x_frac + y_frac - 1);
+    const float g2 = NoiseRand2D(x_int, y_int + 1) * (x_frac + y_frac - 1);
+    const float g3 = NoiseRand2D(x_int + 1, y_int + 1) * (x_frac + y_frac - 2);
+    const float x_noise = LookupLUT(noise_table, x_frac);
+    const float y_noise = LookupLUT(noise_table, y_frac);
+    return Common::BilinearInterp(g0, g1, g2, g3, x_noise, y_noise);
+}
+
+void ProcTexTables::Update(const Pica::TexturingRegs& regs, Pica::PicaCore::ProcTex& state) {
+    noise_frequency = {f16::FromRaw(regs.proctex_noise_frequency.u).ToFloat32(),
+                       f16::FromRaw(regs.proctex_noise_frequency.v).ToFloat32()};
+    noise_phase = {f16::FromRaw(regs.proctex_noise_u.phase).ToFloat32(),
+                   f16::FromRaw(regs.proctex_noise_v.phase).ToFloat32()};
+    noise_amplitude = {static_cast<f32>(regs.proctex_noise_u.amplitude),
+                       static_cast<f32>(regs.proctex_noise_v.amplitude)};
+
+    // Nothing has been decoded yet, the dirty bits may have been consumed by another renderer.
+    if (!valid) {
+        state.table_dirty = state.TableAllDirty;
+        valid = true;
+    }
+    if (!state.table_dirty) {
+        return;
+    }
+
+    const auto decode_values = [](ValueTable& table, const auto& entries) {
+        for (std::size_t i = 0; i < table.size(); i++) {
+            table[i] = {entries[i].ToFloat(), entries[i].DiffToFloat()};
+        }
+    };
+    if (state.noise_lut_dirty) {
+        decode_values(noise_table, state.noise_table);
+    }
+    if (state.color_map_dirty) {
+        decode_values(color_map_table, state.color_map_table);
+    }
+    if (state.alpha_map_dirty) {
+        decode_values(alpha_map_table, state.alpha_map_table);
+    }
+    if (state.lut_dirty) {
+        for (std::size_t i = 0; i < color_table.size(); i++) {
+            color_table[i] = state.color_table[i].ToVector().Cast<float>();
+        }
+    }
+    if (state.diff_lut_dirty) {
+        for (std::size_t i = 0; i < color_diff_table.size(); i++) {
+            color_diff_table[i] = state.color_diff_table[i].ToVector().Cast<float>();
+        }
+    }
+    state.table_dirty = 0;
+}
+
+Common::Vec4<u8> ProcTexTables::ProcTex(float u, float v, const Pica::TexturingRegs& regs) const {
     u = std::abs(u);
     v = std::abs(v);
 
@@ -168,9 +206,9 @@ Common::Vec4<u8> ProcTex(float u, float v, const Pica::TexturingRegs& regs,
 
     // Generate noise
     if (regs.proctex.noise_enable) {
-        float noise = NoiseCoef(u, v, regs, state);
-        u += noise * regs.proctex_noise_u.amplitude / 4095.0f;
-        v += noise * regs.proctex_noise_v.amplitude / 4095.0f;
+        const float noise = NoiseCoef(u, v);
+        u += noise * noise_amplitude.x / 4095.0f;
+        v += noise * noise_amplitude.y / 4095.0f;
         u = std::abs(u);
         v = std::abs(v);
     }
@@ -184,7 +222,7 @@ Common::Vec4<u8> ProcTex(float u, float v, const Pica::TexturingRegs& regs,
     ClampCoord(v, regs.proctex.v_clamp);
 
     // Combine and map
-    const float lut_coord = CombineAndMap(u, v, regs.proctex.color_combiner, state.color_map_table);
+    const float lut_coord = CombineAndMap(u, v, regs.proctex.color_combiner, color_map_table);
 
     // Look up the color
     // For the color lut, coord=0.0 is lut[offset] and coord=1.0 is lut[offset+width-1]
@@ -199,15 +237,13 @@ Common::Vec4<u8> ProcTex(float u, float v, const Pica::TexturingRegs& regs,
     case ProcTexFilter::LinearMipmapNearest: {
         const int index_int = static_cast<int>(index);
         const float frac = index - index_int;
-        const auto color_value = state.color_table[index_int].ToVector().Cast<float>();
-        const auto color_diff = state.color_diff_table[index_int].ToVector().Cast<float>();
-        final_color = (color_value + frac * color_diff).Cast<u8>();
+        final_color = (color_table[index_int] + frac * color_diff_table[index_int]).Cast<u8>();
         break;
     }
     case ProcTexFilter::Nearest:
     case ProcTexFilter::NearestMipmapLinear:
     case ProcTexFilter::NearestMipmapNearest:
-        final_color = state.color_table[static_cast<int>(std::round(index))].ToVector();
+        final_color = color_table[static_cast<int>(std::round(index))].Cast<u8>();
         break;
     }
 
@@ -215,7 +251,7 @@ Common::Vec4<u8> ProcTex(float u, float v, const Pica::TexturingRegs& regs,
         // Note: in separate alpha mode, the alpha channel skips the color LUT look up stage. It
         // uses the output of CombineAndMap directly instead.
         const float final_alpha =
-            CombineAndMap(u, v, regs.proctex.alpha_combiner, state.alpha_map_table);
+            CombineAndMap(u, v, regs.proctex.alpha_combiner, alpha_map_table);
         return Common::MakeVec<u8>(final_color.rgb(), static_cast<u8>(final_alpha * 255));
     } else {
         return final_color;
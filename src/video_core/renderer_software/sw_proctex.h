@@ -4,14 +4,43 @@
 
 #pragma once
 
+#include <array>
 #include "common/common_types.h"
 #include "common/vector_math.h"
 #include "video_core/pica/pica_core.h"
 
 namespace SwRenderer {
 
-/// Generates procedural texture color for the given coordinates
-Common::Vec4<u8> ProcTex(float u, float v, const Pica::TexturingRegs& regs,
-                         const Pica::PicaCore::ProcTex& state);
+/**
+ * The procedural texture LUTs and noise parameters of the current configuration decoded to
+ * floats once per draw, so generating a texel only has to interpolate the tables.
+ */
+class ProcTexTables {
+public:
+    /// Decodes the noise parameters and the tables written since the last call.
+    void Update(const Pica::TexturingRegs& regs, Pica::PicaCore::ProcTex& state);
+
+    /// Generates procedural texture color for the given coordinates
+    [[nodiscard]] Common::Vec4<u8> ProcTex(float u, float v,
+                                           const Pica::TexturingRegs& regs) const;
+
+private:
+    /// The value and difference of every entry, next to each other so a lookup loads both.
+    using ValueTable = std::array<std::array<f32, 2>, 128>;
+
+    /// Returns the noise offset of the given coordinates.
+    [[nodiscard]] float NoiseCoef(float u, float v) const;
+
+private:
+    ValueTable noise_table{};
+    ValueTable color_map_table{};
+    ValueTable alpha_map_table{};
+    std::array<Common::Vec4f, 256> color_table{};
+    std::array<Common::Vec4f, 256> color_diff_table{};
+    Common::Vec2f noise_frequency{};
+    Common::Vec2f noise_phase{};
+    Common::Vec2f noise_amplitude{};
+    bool valid{};
+};
 
 } // namespace SwRenderer
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <limits>
 #include <boost/container/static_vector.hpp>
+#include "common/arch.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/quaternion.h"
@@ -11,12 +13,16 @@
 #include "video_core/pica/output_vertex.h"
 #include "video_core/pica/pica_core.h"
 #include "video_core/renderer_software/sw_framebuffer.h"
-#include "video_core/renderer_software/sw_lighting.h"
-#include "video_core/renderer_software/sw_proctex.h"
 #include "video_core/renderer_software/sw_rasterizer.h"
 #include "video_core/renderer_software/sw_texturing.h"
 #include "video_core/texture/texture_decode.h"
 
+#ifdef CITRA_HAS_SSE42
+#include <xmmintrin.h>
+#elif CITRA_ARCH(arm64)
+#include <arm_neon.h>
+#endif
+
 namespace SwRenderer {
 
 using Pica::f24;
@@ -32,6 +38,11 @@ using Pica::Texture::TextureInfo;
 // we can use a very small epsilon value for clip plane comparison.
 constexpr f32 EPSILON_Z = 0.00000001f;
 
+// NOTE: We clip against a w=epsilon plane to guarantee that the output has a positive w value.
+// TODO: Not sure if this is a valid approach. Also should probably instead use the smallest
+//       epsilon possible within f24 accuracy.
+constexpr f32 EPSILON_W = 0.00001f;
+
 struct Vertex : Pica::OutputVertex {
     Vertex(const OutputVertex& v) : OutputVertex(v) {}
 
@@ -66,10 +77,24 @@ struct Vertex : Pica::OutputVertex {
     }
 };
 
+/// A triangle set up for rasterization, queued until the draw is flushed.
+struct BinnedTriangle {
+    std::array<Vertex, 3> vertices;
+    std::array<Common::Vec3<Fix12P4>, 3> vtxpos;
+    std::array<int, 3> bias;
+    u16 min_x;
+    u16 min_y;
+    u16 max_x;
+    u16 max_y;
+};
+
 namespace {
 
 MICROPROFILE_DEFINE(GPU_Rasterization, "GPU", "Rasterization", MP_RGB(50, 50, 240));
 
+/// Tiles are 32x32 pixels; each is rasterized by a single worker which owns its pixels.
+constexpr u32 TILE_SHIFT = 5 + 4;
+
 struct ClippingEdge {
 public:
     constexpr ClippingEdge(Common::Vec4<f24> coeffs,
@@ -98,12 +123,57 @@ private:
     Common::Vec4<f24> bias;
 };
 
+/**
+ * Returns a mask of the fixed clipping planes the vertex is outside of, in the order of the
+ * clipping edges. The signed distances to all planes are compared against the tolerance at once.
+ **/
+u32 ComputeOutcode(const Vertex& vertex) {
+    const f32 x = vertex.pos.x.ToFloat32();
+    const f32 y = vertex.pos.y.ToFloat32();
+    const f32 z = vertex.pos.z.ToFloat32();
+    const f32 w = vertex.pos.w.ToFloat32();
+#ifdef CITRA_HAS_SSE42
+    const __m128 tolerance = _mm_set1_ps(-EPSILON_Z);
+    const __m128 xy_distances = _mm_add_ps(_mm_set1_ps(w), _mm_setr_ps(-x, x, -y, y));
+    const __m128 zw_distances = _mm_setr_ps(-z, z + w, w + EPSILON_W, 0.0f);
+    // The not greater or equal comparison treats NaN distances as outside, like IsInside.
+    const u32 xy_mask = _mm_movemask_ps(_mm_cmpnge_ps(xy_distances, tolerance));
+    const u32 zw_mask = _mm_movemask_ps(_mm_cmpnge_ps(zw_distances, tolerance));
+    return xy_mask | (zw_mask << 4);
+#elif CITRA_ARCH(arm64)
+    static constexpr std::array<u32, 4> lane_bits = {1, 2, 4, 8};
+    const std::array xy_values = {w - x, w + x, w - y, w + y};
+    const std::array zw_values = {-z, z + w, w + EPSILON_W, 0.0f};
+    const uint32x4_t bits = vld1q_u32(lane_bits.data());
+    const float32x4_t tolerance = vdupq_n_f32(-EPSILON_Z);
+    const float32x4_t xy_distances = vld1q_f32(xy_values.data());
+    const float32x4_t zw_distances = vld1q_f32(zw_values.data());
+    const uint32x4_t xy_outside = vmvnq_u32(vcgeq_f32(xy_distances, tolerance));
+    const uint32x4_t zw_outside = vmvnq_u32(vcgeq_f32(zw_distances, tolerance));
+    const u32 xy_mask = vaddvq_u32(vandq_u32(xy_outside, bits));
+    const u32 zw_mask = vaddvq_u32(vandq_u32(zw_outside, bits));
+    return xy_mask | (zw_mask << 4);
+#else
+    const std::array distances = {w - x, w + x, w - y, w + y, -z, z + w, w + EPSILON_W};
+    u32 mask = 0;
+    for (std::size_t i = 0; i < distances.size(); i++) {
+        if (!(distances[i] >= -EPSILON_Z)) {
+            mask |= 1U << i;
+        }
+    }
+    return mask;
+#endif
+}
+
 } // Anonymous namespace
 
 RasterizerSoftware::RasterizerSoftware(Memory::MemorySystem& memory_, Pica::PicaCore& pica_)
     : memory{memory_}, pica{pica_}, regs{pica.regs.internal},
       num_sw_threads{std::max(std::thread::hardware_concurrency(), 2U)},
-      sw_workers{num_sw_threads, "SwRenderer workers"}, fb{memory, regs.framebuffer} {}
+      sw_workers{num_sw_threads, "SwRenderer workers", [](std::size_t) { return TileCache{}; }},
+      fb{memory, regs.framebuffer} {}
+
+RasterizerSoftware::~RasterizerSoftware() = default;
 
 void RasterizerSoftware::AddTriangle(const Pica::OutputVertex& v0, const Pica::OutputVertex& v1,
                                      const Pica::OutputVertex& v2) {
@@ -124,10 +194,7 @@ void RasterizerSoftware::AddTriangle(const Pica::OutputVertex& v0, const Pica::O
     auto* output_list = &buffer_a;
     auto* input_list = &buffer_b;
 
-    // NOTE: We clip against a w=epsilon plane to guarantee that the output has a positive w value.
-    // TODO: Not sure if this is a valid approach. Also should probably instead use the smallest
-    //       epsilon possible within f24 accuracy.
-    static constexpr f24 EPSILON = f24::FromFloat32(0.00001f);
+    static constexpr f24 EPSILON = f24::FromFloat32(EPSILON_W);
     static constexpr f24 f0 = f24::Zero();
     static constexpr f24 f1 = f24::One();
     static constexpr std::array<ClippingEdge, 7> clipping_edges = {{
@@ -141,7 +208,6 @@ void RasterizerSoftware::AddTriangle(const Pica::OutputVertex& v0, const Pica::O
     }};
 
     // Simple implementation of the Sutherland-Hodgman clipping algorithm.
-    // TODO: Make this less inefficient (currently lots of useless buffering overhead happens here)
     const auto clip = [&](const ClippingEdge& edge) {
         std::swap(input_list, output_list);
         output_list->clear();
@@ -161,8 +227,22 @@ void RasterizerSoftware::AddTriangle(const Pica::OutputVertex& v0, const Pica::O
         }
     };
 
-    for (const ClippingEdge& edge : clipping_edges) {
-        clip(edge);
+    // Triangles entirely outside of a plane are rejected, and only the planes crossed by the
+    // triangle are clipped against. Clipping against a plane all the vertices are inside of
+    // leaves them untouched, so most triangles skip the clipper altogether.
+    const u32 outcode0 = ComputeOutcode(buffer_a[0]);
+    const u32 outcode1 = ComputeOutcode(buffer_a[1]);
+    const u32 outcode2 = ComputeOutcode(buffer_a[2]);
+    if ((outcode0 & outcode1 & outcode2) != 0) {
+        return;
+    }
+
+    const u32 crossed_planes = outcode0 | outcode1 | outcode2;
+    for (std::size_t i = 0; i < clipping_edges.size(); i++) {
+        if ((crossed_planes & (1U << i)) == 0) {
+            continue;
+        }
+        clip(clipping_edges[i]);
         if (output_list->size() < 3) {
             return;
         }
@@ -229,8 +309,6 @@ void RasterizerSoftware::MakeScreenCoords(Vertex& vtx) {
 
 void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2,
                                          bool reversed) {
-    MICROPROFILE_SCOPE(GPU_Rasterization);
-
     // Vertex positions in rasterizer coordinates
     static auto screen_to_rasterizer_coords = [](const Common::Vec3<f24>& vec) {
         return Common::Vec3{Fix12P4::FromFloat24(vec.x), Fix12P4::FromFloat24(vec.y),
@@ -286,198 +364,302 @@ void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, con
     max_x = ((max_x + Fix12P4::FracMask()) & Fix12P4::IntMask());
     max_y = ((max_y + Fix12P4::FracMask()) & Fix12P4::IntMask());
 
-    const int bias0 =
-        IsRightSideOrFlatBottomEdge(vtxpos[0].xy(), vtxpos[1].xy(), vtxpos[2].xy()) ? -1 : 0;
-    const int bias1 =
-        IsRightSideOrFlatBottomEdge(vtxpos[1].xy(), vtxpos[2].xy(), vtxpos[0].xy()) ? -1 : 0;
-    const int bias2 =
-        IsRightSideOrFlatBottomEdge(vtxpos[2].xy(), vtxpos[0].xy(), vtxpos[1].xy()) ? -1 : 0;
+    if (min_x >= max_x || min_y >= max_y) {
+        return;
+    }
 
-    const auto w_inverse = Common::MakeVec(v0.pos.w, v1.pos.w, v2.pos.w);
+    const std::array bias = {
+        IsRightSideOrFlatBottomEdge(vtxpos[0].xy(), vtxpos[1].xy(), vtxpos[2].xy()) ? -1 : 0,
+        IsRightSideOrFlatBottomEdge(vtxpos[1].xy(), vtxpos[2].xy(), vtxpos[0].xy()) ? -1 : 0,
+        IsRightSideOrFlatBottomEdge(vtxpos[2].xy(), vtxpos[0].xy(), vtxpos[1].xy()) ? -1 : 0,
+    };
+
+    triangles.push_back(BinnedTriangle{
+        .vertices = {v0, v1, v2},
+        .vtxpos = vtxpos,
+        .bias = bias,
+        .min_x = min_x,
+        .min_y = min_y,
+        .max_x = max_x,
+        .max_y = max_y,
+    });
+}
+
+void RasterizerSoftware::DrawTriangles() {
+    if (triangles.empty()) {
+        return;
+    }
+
+    MICROPROFILE_SCOPE(GPU_Rasterization);
+
+    // Texture memory may have changed since the last draw, retire the decoded texels.
+    draw_count++;
+
+    // Bin the triangles to the tiles covered by their bounding box, in submission order.
+    u32 tile_x0 = std::numeric_limits<u32>::max();
+    u32 tile_y0 = std::numeric_limits<u32>::max();
+    u32 tile_x1 = 0;
+    u32 tile_y1 = 0;
+    for (const BinnedTriangle& triangle : triangles) {
+        tile_x0 = std::min<u32>(tile_x0, triangle.min_x >> TILE_SHIFT);
+        tile_y0 = std::min<u32>(tile_y0, triangle.min_y >> TILE_SHIFT);
+        tile_x1 = std::max<u32>(tile_x1, ((triangle.max_x - 1) >> TILE_SHIFT) + 1);
+        tile_y1 = std::max<u32>(tile_y1, ((triangle.max_y - 1) >> TILE_SHIFT) + 1);
+    }
+
+    const u32 tiles_width = tile_x1 - tile_x0;
+    const u32 num_tiles = tiles_width * (tile_y1 - tile_y0);
+    if (tile_bins.size() < num_tiles) {
+        tile_bins.resize(num_tiles);
+    }
+    for (u32 i = 0; i < num_tiles; i++) {
+        tile_bins[i].clear();
+    }
+    for (u32 index = 0; index < static_cast<u32>(triangles.size()); index++) {
+        const BinnedTriangle& triangle = triangles[index];
+        const u32 x0 = (triangle.min_x >> TILE_SHIFT) - tile_x0;
+        const u32 y0 = (triangle.min_y >> TILE_SHIFT) - tile_y0;
+        const u32 x1 = ((triangle.max_x - 1) >> TILE_SHIFT) + 1 - tile_x0;
+        const u32 y1 = ((triangle.max_y - 1) >> TILE_SHIFT) + 1 - tile_y0;
+        for (u32 y = y0; y < y1; y++) {
+            for (u32 x = x0; x < x1; x++) {
+                tile_bins[y * tiles_width + x].push_back(index);
+            }
+        }
+    }
 
     const auto textures = regs.texturing.GetTextures();
-    const auto tev_stages = regs.texturing.GetTevStages();
+    tev_program.Update(regs.texturing);
+    if (!regs.lighting.disable) {
+        lighting_tables.Update(regs.lighting, pica.lighting);
+    }
+    if (regs.texturing.main_config.texture3_enable) {
+        proctex_tables.Update(regs.texturing, pica.proctex);
+    }
+
+    // Lighting may read any texture unit for bump mapping or shadows.
+    const u32 used_textures = regs.lighting.disable ? tev_program.UsedTextures() : 0xF;
 
     fb.Bind();
 
+    // Every pixel belongs to a single tile, so the tiles need no synchronization between them
+    // and each of them preserves the primitive order by walking its bin in order.
+    const auto rasterize_tile = [&](u32 tile, TileCache& cache) {
+        const u32 tile_x = (tile_x0 + tile % tiles_width) << TILE_SHIFT;
+        const u32 tile_y = (tile_y0 + tile / tiles_width) << TILE_SHIFT;
+        for (const u32 index : tile_bins[tile]) {
+            RasterizeTriangle(triangles[index], tile_x, tile_y, textures, used_textures, cache);
+        }
+    };
+
+    if (num_tiles == 1) {
+        rasterize_tile(0, main_tile_cache);
+    } else {
+        for (u32 tile = 0; tile < num_tiles; tile++) {
+            if (!tile_bins[tile].empty()) {
+                sw_workers.QueueWork(
+                    [&rasterize_tile, tile](TileCache* cache) { rasterize_tile(tile, *cache); });
+            }
+        }
+        sw_workers.WaitForRequests();
+    }
+    triangles.clear();
+}
+
+void RasterizerSoftware::RasterizeTriangle(
+    const BinnedTriangle& triangle, u32 tile_x, u32 tile_y,
+    std::span<const TexturingRegs::FullTextureConfig, 3> textures, u32 used_textures,
+    TileCache& tile_cache) {
+    const auto& [v0, v1, v2] = triangle.vertices;
+    const auto& vtxpos = triangle.vtxpos;
+    const auto [bias0, bias1, bias2] = triangle.bias;
+
+    // Clip the bounding box to the tile, keeping the coordinates on the pixel centers.
+    static constexpr u32 TILE_EXTENT = 1U << TILE_SHIFT;
+    const u16 min_x = static_cast<u16>(std::max<u32>(triangle.min_x, tile_x));
+    const u16 min_y = static_cast<u16>(std::max<u32>(triangle.min_y, tile_y));
+    const u16 max_x = static_cast<u16>(std::min<u32>(triangle.max_x, tile_x + TILE_EXTENT));
+    const u16 max_y = static_cast<u16>(std::min<u32>(triangle.max_y, tile_y + TILE_EXTENT));
+
+    // Convert the scissor box coordinates to 12.4 fixed point
+    const u16 scissor_x1 = static_cast<u16>(regs.rasterizer.scissor_test.x1 << 4);
+    const u16 scissor_y1 = static_cast<u16>(regs.rasterizer.scissor_test.y1 << 4);
+    // x2,y2 have +1 added to cover the entire sub-pixel area
+    const u16 scissor_x2 = static_cast<u16>((regs.rasterizer.scissor_test.x2 + 1) << 4);
+    const u16 scissor_y2 = static_cast<u16>((regs.rasterizer.scissor_test.y2 + 1) << 4);
+
+    const auto w_inverse = Common::MakeVec(v0.pos.w, v1.pos.w, v2.pos.w);
+
     // Enter rasterization loop, starting at the center of the topleft bounding box corner.
     // TODO: Not sure if looping through x first might be faster
     for (u16 y = min_y + 8; y < max_y; y += 0x10) {
-        const auto process_scanline = [&, y] {
-            for (u16 x = min_x + 8; x < max_x; x += 0x10) {
-                // Do not process the pixel if it's inside the scissor box and the scissor mode is
-                // set to Exclude.
-                if (regs.rasterizer.scissor_test.mode == RasterizerRegs::ScissorMode::Exclude) {
-                    if (x >= scissor_x1 && x < scissor_x2 && y >= scissor_y1 && y < scissor_y2) {
-                        continue;
-                    }
+        for (u16 x = min_x + 8; x < max_x; x += 0x10) {
+            // Do not process the pixel if it's inside the scissor box and the scissor mode is
+            // set to Exclude.
+            if (regs.rasterizer.scissor_test.mode == RasterizerRegs::ScissorMode::Exclude) {
+                if (x >= scissor_x1 && x < scissor_x2 && y >= scissor_y1 && y < scissor_y2) {
+                    continue;
                 }
+            }
 
-                // Calculate the barycentric coordinates w0, w1 and w2
-                const s32 w0 = bias0 + SignedArea(vtxpos[1].xy(), vtxpos[2].xy(), {x, y});
-                const s32 w1 = bias1 + SignedArea(vtxpos[2].xy(), vtxpos[0].xy(), {x, y});
-                const s32 w2 = bias2 + SignedArea(vtxpos[0].xy(), vtxpos[1].xy(), {x, y});
-                const s32 wsum = w0 + w1 + w2;
+            // Calculate the barycentric coordinates w0, w1 and w2
+            const s32 w0 = bias0 + SignedArea(vtxpos[1].xy(), vtxpos[2].xy(), {x, y});
+            const s32 w1 = bias1 + SignedArea(vtxpos[2].xy(), vtxpos[0].xy(), {x, y});
+            const s32 w2 = bias2 + SignedArea(vtxpos[0].xy(), vtxpos[1].xy(), {x, y});
+            const s32 wsum = w0 + w1 + w2;
 
-                // If current pixel is not covered by the current primitive
-                if (w0 < 0 || w1 < 0 || w2 < 0) {
-                    continue;
-                }
+            // If current pixel is not covered by the current primitive
+            if (w0 < 0 || w1 < 0 || w2 < 0) {
+                continue;
+            }
 
-                const auto baricentric_coordinates = Common::MakeVec(
-                    f24::FromFloat32(static_cast<f32>(w0)), f24::FromFloat32(static_cast<f32>(w1)),
-                    f24::FromFloat32(static_cast<f32>(w2)));
-                const f24 interpolated_w_inverse =
-                    f24::One() / Common::Dot(w_inverse, baricentric_coordinates);
-
-                // interpolated_z = z / w
-                const float interpolated_z_over_w =
-                    (v0.screenpos[2].ToFloat32() * w0 + v1.screenpos[2].ToFloat32() * w1 +
-                     v2.screenpos[2].ToFloat32() * w2) /
-                    wsum;
-
-                // Not fully accurate. About 3 bits in precision are missing.
-                // Z-Buffer (z / w * scale + offset)
-                const float depth_scale =
-                    f24::FromRaw(regs.rasterizer.viewport_depth_range).ToFloat32();
-                const float depth_offset =
-                    f24::FromRaw(regs.rasterizer.viewport_depth_near_plane).ToFloat32();
-                float depth = interpolated_z_over_w * depth_scale + depth_offset;
-
-                // Potentially switch to W-Buffer
-                if (regs.rasterizer.depthmap_enable ==
-                    Pica::RasterizerRegs::DepthBuffering::WBuffering) {
-                    // W-Buffer (z * scale + w * offset = (z / w * scale + offset) * w)
-                    depth *= interpolated_w_inverse.ToFloat32() * wsum;
-                }
+            const auto baricentric_coordinates = Common::MakeVec(
+                f24::FromFloat32(static_cast<f32>(w0)), f24::FromFloat32(static_cast<f32>(w1)),
+                f24::FromFloat32(static_cast<f32>(w2)));
+            const f24 interpolated_w_inverse =
+                f24::One() / Common::Dot(w_inverse, baricentric_coordinates);
+
+            // interpolated_z = z / w
+            const float interpolated_z_over_w =
+                (v0.screenpos[2].ToFloat32() * w0 + v1.screenpos[2].ToFloat32() * w1 +
+                 v2.screenpos[2].ToFloat32() * w2) /
+                wsum;
+
+            // Not fully accurate. About 3 bits in precision are missing.
+            // Z-Buffer (z / w * scale + offset)
+            const float depth_scale =
+                f24::FromRaw(regs.rasterizer.viewport_depth_range).ToFloat32();
+            const float depth_offset =
+                f24::FromRaw(regs.rasterizer.viewport_depth_near_plane).ToFloat32();
+            float depth = interpolated_z_over_w * depth_scale + depth_offset;
+
+            // Potentially switch to W-Buffer
+            if (regs.rasterizer.depthmap_enable ==
+                Pica::RasterizerRegs::DepthBuffering::WBuffering) {
+                // W-Buffer (z * scale + w * offset = (z / w * scale + offset) * w)
+                depth *= interpolated_w_inverse.ToFloat32() * wsum;
+            }
 
-                // Clamp the result
-                depth = std::clamp(depth, 0.0f, 1.0f);
-
-                /**
-                 * Perspective correct attribute interpolation:
-                 * Attribute values cannot be calculated by simple linear interpolation since
-                 * they are not linear in screen space. For example, when interpolating a
-                 * texture coordinate across two vertices, something simple like
-                 *     u = (u0*w0 + u1*w1)/(w0+w1)
-                 * will not work. However, the attribute value divided by the
-                 * clipspace w-coordinate (u/w) and and the inverse w-coordinate (1/w) are linear
-                 * in screenspace. Hence, we can linearly interpolate these two independently and
-                 * calculate the interpolated attribute by dividing the results.
-                 * I.e.
-                 *     u_over_w   = ((u0/v0.pos.w)*w0 + (u1/v1.pos.w)*w1)/(w0+w1)
-                 *     one_over_w = (( 1/v0.pos.w)*w0 + ( 1/v1.pos.w)*w1)/(w0+w1)
-                 *     u = u_over_w / one_over_w
-                 *
-                 * The generalization to three vertices is straightforward in baricentric
-                 *coordinates.
-                 **/
-                const auto get_interpolated_attribute = [&](f24 attr0, f24 attr1, f24 attr2) {
-                    auto attr_over_w = Common::MakeVec(attr0, attr1, attr2);
-                    f24 interpolated_attr_over_w =
-                        Common::Dot(attr_over_w, baricentric_coordinates);
-                    return interpolated_attr_over_w * interpolated_w_inverse;
-                };
+            // Clamp the result
+            depth = std::clamp(depth, 0.0f, 1.0f);
+
+            /**
+             * Perspective correct attribute interpolation:
+             * Attribute values cannot be calculated by simple linear interpolation since
+             * they are not linear in screen space. For example, when interpolating a
+             * texture coordinate across two vertices, something simple like
+             *     u = (u0*w0 + u1*w1)/(w0+w1)
+             * will not work. However, the attribute value divided by the
+             * clipspace w-coordinate (u/w) and and the inverse w-coordinate (1/w) are linear
+             * in screenspace. Hence, we can linearly interpolate these two independently and
+             * calculate the interpolated attribute by dividing the results.
+             * I.e.
+             *     u_over_w   = ((u0/v0.pos.w)*w0 + (u1/v1.pos.w)*w1)/(w0+w1)
+             *     one_over_w = (( 1/v0.pos.w)*w0 + ( 1/v1.pos.w)*w1)/(w0+w1)
+             *     u = u_over_w / one_over_w
+             *
+             * The generalization to three vertices is straightforward in baricentric
+             *coordinates.
+             **/
+            const auto get_interpolated_attribute = [&](f24 attr0, f24 attr1, f24 attr2) {
+                auto attr_over_w = Common::MakeVec(attr0, attr1, attr2);
+                f24 interpolated_attr_over_w = Common::Dot(attr_over_w, baricentric_coordinates);
+                return interpolated_attr_over_w * interpolated_w_inverse;
+            };
+
+            const Common::Vec4<u8> primary_color{
+                static_cast<u8>(
+                    round(get_interpolated_attribute(v0.color.r(), v1.color.r(), v2.color.r())
+                              .ToFloat32() *
+                          255)),
+                static_cast<u8>(
+                    round(get_interpolated_attribute(v0.color.g(), v1.color.g(), v2.color.g())
+                              .ToFloat32() *
+                          255)),
+                static_cast<u8>(
+                    round(get_interpolated_attribute(v0.color.b(), v1.color.b(), v2.color.b())
+                              .ToFloat32() *
+                          255)),
+                static_cast<u8>(
+                    round(get_interpolated_attribute(v0.color.a(), v1.color.a(), v2.color.a())
+                              .ToFloat32() *
+                          255)),
+            };
+
+            std::array<Common::Vec2<f24>, 3> uv;
+            uv[0].u() = get_interpolated_attribute(v0.tc0.u(), v1.tc0.u(), v2.tc0.u());
+            uv[0].v() = get_interpolated_attribute(v0.tc0.v(), v1.tc0.v(), v2.tc0.v());
+            uv[1].u() = get_interpolated_attribute(v0.tc1.u(), v1.tc1.u(), v2.tc1.u());
+            uv[1].v() = get_interpolated_attribute(v0.tc1.v(), v1.tc1.v(), v2.tc1.v());
+            uv[2].u() = get_interpolated_attribute(v0.tc2.u(), v1.tc2.u(), v2.tc2.u());
+            uv[2].v() = get_interpolated_attribute(v0.tc2.v(), v1.tc2.v(), v2.tc2.v());
+
+            // Sample bound texture units.
+            const f24 tc0_w = get_interpolated_attribute(v0.tc0_w, v1.tc0_w, v2.tc0_w);
+            const auto texture_color = TextureColor(uv, textures, tc0_w, used_textures, tile_cache);
+
+            Common::Vec4<u8> primary_fragment_color = {0, 0, 0, 0};
+            Common::Vec4<u8> secondary_fragment_color = {0, 0, 0, 0};
+
+            if (!regs.lighting.disable) {
+                const auto normquat =
+                    Common::Quaternion<f32>{
+                        {get_interpolated_attribute(v0.quat.x, v1.quat.x, v2.quat.x).ToFloat32(),
+                         get_interpolated_attribute(v0.quat.y, v1.quat.y, v2.quat.y).ToFloat32(),
+                         get_interpolated_attribute(v0.quat.z, v1.quat.z, v2.quat.z).ToFloat32()},
+                        get_interpolated_attribute(v0.quat.w, v1.quat.w, v2.quat.w).ToFloat32(),
+                    }
+                        .Normalized();
 
-                const Common::Vec4<u8> primary_color{
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.r(), v1.color.r(), v2.color.r())
-                                  .ToFloat32() *
-                              255)),
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.g(), v1.color.g(), v2.color.g())
-                                  .ToFloat32() *
-                              255)),
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.b(), v1.color.b(), v2.color.b())
-                                  .ToFloat32() *
-                              255)),
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.a(), v1.color.a(), v2.color.a())
-                                  .ToFloat32() *
-                              255)),
+                const Common::Vec3f view{
+                    get_interpolated_attribute(v0.view.x, v1.view.x, v2.view.x).ToFloat32(),
+                    get_interpolated_attribute(v0.view.y, v1.view.y, v2.view.y).ToFloat32(),
+                    get_interpolated_attribute(v0.view.z, v1.view.z, v2.view.z).ToFloat32(),
                 };
+                std::tie(primary_fragment_color, secondary_fragment_color) =
+                    lighting_tables.ComputeFragmentsColors(regs.lighting, normquat, view,
+                                                           texture_color);
+            }
 
-                std::array<Common::Vec2<f24>, 3> uv;
-                uv[0].u() = get_interpolated_attribute(v0.tc0.u(), v1.tc0.u(), v2.tc0.u());
-                uv[0].v() = get_interpolated_attribute(v0.tc0.v(), v1.tc0.v(), v2.tc0.v());
-                uv[1].u() = get_interpolated_attribute(v0.tc1.u(), v1.tc1.u(), v2.tc1.u());
-                uv[1].v() = get_interpolated_attribute(v0.tc1.v(), v1.tc1.v(), v2.tc1.v());
-                uv[2].u() = get_interpolated_attribute(v0.tc2.u(), v1.tc2.u(), v2.tc2.u());
-                uv[2].v() = get_interpolated_attribute(v0.tc2.v(), v1.tc2.v(), v2.tc2.v());
-
-                // Sample bound texture units.
-                const f24 tc0_w = get_interpolated_attribute(v0.tc0_w, v1.tc0_w, v2.tc0_w);
-                const auto texture_color = TextureColor(uv, textures, tc0_w);
-
-                Common::Vec4<u8> primary_fragment_color = {0, 0, 0, 0};
-                Common::Vec4<u8> secondary_fragment_color = {0, 0, 0, 0};
-
-                if (!regs.lighting.disable) {
-                    const auto normquat =
-                        Common::Quaternion<f32>{
-                            {get_interpolated_attribute(v0.quat.x, v1.quat.x, v2.quat.x)
-                                 .ToFloat32(),
-                             get_interpolated_attribute(v0.quat.y, v1.quat.y, v2.quat.y)
-                                 .ToFloat32(),
-                             get_interpolated_attribute(v0.quat.z, v1.quat.z, v2.quat.z)
-                                 .ToFloat32()},
-                            get_interpolated_attribute(v0.quat.w, v1.quat.w, v2.quat.w).ToFloat32(),
-                        }
-                            .Normalized();
-
-                    const Common::Vec3f view{
-                        get_interpolated_attribute(v0.view.x, v1.view.x, v2.view.x).ToFloat32(),
-                        get_interpolated_attribute(v0.view.y, v1.view.y, v2.view.y).ToFloat32(),
-                        get_interpolated_attribute(v0.view.z, v1.view.z, v2.view.z).ToFloat32(),
-                    };
-                    std::tie(primary_fragment_color, secondary_fragment_color) =
-                        ComputeFragmentsColors(regs.lighting, pica.lighting, normquat, view,
-                                               texture_color);
-                }
-
-                // Write the TEV stages.
-                auto combiner_output =
-                    WriteTevConfig(texture_color, tev_stages, primary_color, primary_fragment_color,
-                                   secondary_fragment_color);
-
-                const auto& output_merger = regs.framebuffer.output_merger;
-                if (output_merger.fragment_operation_mode ==
-                    FramebufferRegs::FragmentOperationMode::Shadow) {
-                    const u32 depth_int = static_cast<u32>(depth * 0xFFFFFF);
-                    // Use green color as the shadow intensity
-                    const u8 stencil = combiner_output.y;
-                    fb.DrawShadowMapPixel(x >> 4, y >> 4, depth_int, stencil);
-                    // Skip the normal output merger pipeline if it is in shadow mode
-                    continue;
-                }
+            // Write the TEV stages.
+            auto combiner_output = tev_program.Run(texture_color, primary_color,
+                                                   primary_fragment_color, secondary_fragment_color);
+
+            const auto& output_merger = regs.framebuffer.output_merger;
+            if (output_merger.fragment_operation_mode ==
+                FramebufferRegs::FragmentOperationMode::Shadow) {
+                const u32 depth_int = static_cast<u32>(depth * 0xFFFFFF);
+                // Use green color as the shadow intensity
+                const u8 stencil = combiner_output.y;
+                fb.DrawShadowMapPixel(x >> 4, y >> 4, depth_int, stencil);
+                // Skip the normal output merger pipeline if it is in shadow mode
+                continue;
+            }
 
-                // Does alpha testing happen before or after stencil?
-                if (!DoAlphaTest(combiner_output.a())) {
-                    continue;
-                }
-                WriteFog(depth, combiner_output);
-                if (!DoDepthStencilTest(x, y, depth)) {
-                    continue;
-                }
-                const auto result = PixelColor(x, y, combiner_output);
-                if (regs.framebuffer.framebuffer.allow_color_write != 0) {
-                    fb.DrawPixel(x >> 4, y >> 4, result);
-                }
+            // Does alpha testing happen before or after stencil?
+            if (!DoAlphaTest(combiner_output.a())) {
+                continue;
             }
-        };
-        sw_workers.QueueWork(std::move(process_scanline));
+            WriteFog(depth, combiner_output);
+            if (!DoDepthStencilTest(x, y, depth)) {
+                continue;
+            }
+            const auto result = PixelColor(x, y, combiner_output);
+            if (regs.framebuffer.framebuffer.allow_color_write != 0) {
+                fb.DrawPixel(x >> 4, y >> 4, result);
+            }
+        }
     }
-    sw_workers.WaitForRequests();
 }
 
 std::array<Common::Vec4<u8>, 4> RasterizerSoftware::TextureColor(
     std::span<const Common::Vec2<f24>, 3> uv,
-    std::span<const Pica::TexturingRegs::FullTextureConfig, 3> textures, f24 tc0_w) const {
+    std::span<const Pica::TexturingRegs::FullTextureConfig, 3> textures, f24 tc0_w,
+    u32 used_textures, TileCache& tile_cache) const {
     std::array<Common::Vec4<u8>, 4> texture_color{};
     for (u32 i = 0; i < 3; ++i) {
         const auto& texture = textures[i];
-        if (!texture.enabled) [[unlikely]] {
+        if (!texture.enabled || (used_textures & (1U << i)) == 0) [[unlikely]] {
             continue;
         }
         if (texture.config.address == 0) [[unlikely]] {
@@ -524,49 +706,67 @@ std::array<Common::Vec4<u8>, 4> RasterizerSoftware::TextureColor(
             }
         }
 
-        const f24 width = f24::FromFloat32(static_cast<f32>(texture.config.width));
-        const f24 height = f24::FromFloat32(static_cast<f32>(texture.config.height));
-        s32 s = static_cast<s32>((u * width).ToFloat32());
-        s32 t = static_cast<s32>((v * height).ToFloat32());
+        const u8* texture_data = memory.GetPhysicalPointer(texture_address);
+        const auto info = TextureInfo::FromPicaRegister(texture.config, texture.format);
+        const auto sample = [&](s32 s, s32 t) -> Common::Vec4<u8> {
+            bool use_border_s = false;
+            bool use_border_t = false;
 
-        bool use_border_s = false;
-        bool use_border_t = false;
+            if (texture.config.wrap_s == TexturingRegs::TextureConfig::ClampToBorder) {
+                use_border_s = s < 0 || s >= static_cast<s32>(texture.config.width);
+            } else if (texture.config.wrap_s == TexturingRegs::TextureConfig::ClampToBorder2) {
+                use_border_s = s >= static_cast<s32>(texture.config.width);
+            }
 
-        if (texture.config.wrap_s == TexturingRegs::TextureConfig::ClampToBorder) {
-            use_border_s = s < 0 || s >= static_cast<s32>(texture.config.width);
-        } else if (texture.config.wrap_s == TexturingRegs::TextureConfig::ClampToBorder2) {
-            use_border_s = s >= static_cast<s32>(texture.config.width);
-        }
+            if (texture.config.wrap_t == TexturingRegs::TextureConfig::ClampToBorder) {
+                use_border_t = t < 0 || t >= static_cast<s32>(texture.config.height);
+            } else if (texture.config.wrap_t == TexturingRegs::TextureConfig::ClampToBorder2) {
+                use_border_t = t >= static_cast<s32>(texture.config.height);
+            }
 
-        if (texture.config.wrap_t == TexturingRegs::TextureConfig::ClampToBorder) {
-            use_border_t = t < 0 || t >= static_cast<s32>(texture.config.height);
-        } else if (texture.config.wrap_t == TexturingRegs::TextureConfig::ClampToBorder2) {
-            use_border_t = t >= static_cast<s32>(texture.config.height);
-        }
+            if (use_border_s || use_border_t) {
+                const auto border_color = texture.config.border_color;
+                return Common::MakeVec(border_color.r.Value(), border_color.g.Value(),
+                                       border_color.b.Value(), border_color.a.Value())
+                    .Cast<u8>();
+            }
 
-        if (use_border_s || use_border_t) {
-            const auto border_color = texture.config.border_color;
-            texture_color[i] = Common::MakeVec(border_color.r.Value(), border_color.g.Value(),
-                                               border_color.b.Value(), border_color.a.Value())
-                                   .Cast<u8>();
-        } else {
             // Textures are laid out from bottom to top, hence we invert the t coordinate.
             // NOTE: This may not be the right place for the inversion.
             // TODO: Check if this applies to ETC textures, too.
             s = GetWrappedTexCoord(texture.config.wrap_s, s, texture.config.width);
             t = texture.config.height - 1 -
                 GetWrappedTexCoord(texture.config.wrap_t, t, texture.config.height);
+            return tile_cache.Lookup(texture_data, s, t, info, draw_count);
+        };
 
-            const u8* texture_data = memory.GetPhysicalPointer(texture_address);
-            const auto info = TextureInfo::FromPicaRegister(texture.config, texture.format);
+        const bool is_shadow =
+            i == 0 && (texture.config.type == TexturingRegs::TextureConfig::Shadow2D ||
+                       texture.config.type == TexturingRegs::TextureConfig::ShadowCube);
+        const f24 width = f24::FromFloat32(static_cast<f32>(texture.config.width));
+        const f24 height = f24::FromFloat32(static_cast<f32>(texture.config.height));
 
-            // TODO: Apply the min and mag filters to the texture
-            texture_color[i] = LookupTexture(texture_data, s, t, info);
+        // TODO: There is no level of detail, so the magnification filter is used throughout.
+        if (texture.config.mag_filter == TexturingRegs::TextureConfig::Linear && !is_shadow) {
+            // Blend the four texels around the sample position with 8 bits of weight precision.
+            const s32 s = static_cast<s32>((u * width).ToFloat32() * 256.0f) - 128;
+            const s32 t = static_cast<s32>((v * height).ToFloat32() * 256.0f) - 128;
+            const s32 s0 = s >> 8;
+            const s32 t0 = t >> 8;
+            const std::array texels = {
+                sample(s0, t0),
+                sample(s0 + 1, t0),
+                sample(s0, t0 + 1),
+                sample(s0 + 1, t0 + 1),
+            };
+            texture_color[i] = BilinearFilter(texels, s & 0xFF, t & 0xFF);
+        } else {
+            const s32 s = static_cast<s32>((u * width).ToFloat32());
+            const s32 t = static_cast<s32>((v * height).ToFloat32());
+            texture_color[i] = sample(s, t);
         }
 
-        if (i == 0 && (texture.config.type == TexturingRegs::TextureConfig::Shadow2D ||
-                       texture.config.type == TexturingRegs::TextureConfig::ShadowCube)) {
-
+        if (is_shadow) {
             s32 z_int = static_cast<s32>(std::min(shadow_z.ToFloat32(), 1.0f) * 0xFFFFFF);
             z_int -= regs.texturing.shadow.bias << 1;
             const auto& color = texture_color[i];
@@ -582,10 +782,10 @@ std::array<Common::Vec4<u8>, 4> RasterizerSoftware::TextureColor(
     }
 
     // Sample procedural texture
-    if (regs.texturing.main_config.texture3_enable) {
+    if (regs.texturing.main_config.texture3_enable && (used_textures & (1U << 3)) != 0) {
         const auto& proctex_uv = uv[regs.texturing.main_config.texture3_coordinates];
-        texture_color[3] = ProcTex(proctex_uv.u().ToFloat32(), proctex_uv.v().ToFloat32(),
-                                   regs.texturing, pica.proctex);
+        texture_color[3] = proctex_tables.ProcTex(proctex_uv.u().ToFloat32(),
+                                                  proctex_uv.v().ToFloat32(), regs.texturing);
     }
 
     return texture_color;
@@ -682,120 +882,6 @@ Common::Vec4<u8> RasterizerSoftware::PixelColor(u16 x, u16 y,
     return result;
 }
 
-Common::Vec4<u8> RasterizerSoftware::WriteTevConfig(
-    std::span<const Common::Vec4<u8>, 4> texture_color,
-    std::span<const Pica::TexturingRegs::TevStageConfig, 6> tev_stages,
-    Common::Vec4<u8> primary_color, Common::Vec4<u8> primary_fragment_color,
-    Common::Vec4<u8> secondary_fragment_color) {
-    /**
-     * Texture environment - consists of 6 stages of color and alpha combining.
-     * Color combiners take three input color values from some source (e.g. interpolated
-     * vertex color, texture color, previous stage, etc), perform some very simple
-     * operations on each of them (e.g. inversion) and then calculate the output color
-     * with some basic arithmetic. Alpha combiners can be configured separately but work
-     * analogously.
-     **/
-    Common::Vec4<u8> combiner_output = {0, 0, 0, 0};
-    Common::Vec4<u8> combiner_buffer = {0, 0, 0, 0};
-    Common::Vec4<u8> next_combiner_buffer =
-        Common::MakeVec(regs.texturing.tev_combiner_buffer_color.r.Value(),
-                        regs.texturing.tev_combiner_buffer_color.g.Value(),
-                        regs.texturing.tev_combiner_buffer_color.b.Value(),
-                        regs.texturing.tev_combiner_buffer_color.a.Value())
-            .Cast<u8>();
-
-    for (u32 tev_stage_index = 0; tev_stage_index < tev_stages.size(); ++tev_stage_index) {
-        const auto& tev_stage = tev_stages[tev_stage_index];
-        using Source = TexturingRegs::TevStageConfig::Source;
-
-        auto get_source = [&](Source source) -> Common::Vec4<u8> {
-            switch (source) {
-            case Source::PrimaryColor:
-                return primary_color;
-            case Source::PrimaryFragmentColor:
-                return primary_fragment_color;
-            case Source::SecondaryFragmentColor:
-                return secondary_fragment_color;
-            case Source::Texture0:
-                return texture_color[0];
-            case Source::Texture1:
-                return texture_color[1];
-            case Source::Texture2:
-                return texture_color[2];
-            case Source::Texture3:
-                return texture_color[3];
-            case Source::PreviousBuffer:
-                return combiner_buffer;
-            case Source::Constant:
-                return Common::MakeVec(tev_stage.const_r.Value(), tev_stage.const_g.Value(),
-                                       tev_stage.const_b.Value(), tev_stage.const_a.Value())
-                    .Cast<u8>();
-            case Source::Previous:
-                return combiner_output;
-            default:
-                LOG_ERROR(HW_GPU, "Unknown color combiner source {}", (int)source);
-                UNIMPLEMENTED();
-                return {0, 0, 0, 0};
-            }
-        };
-
-        /**
-         * Color combiner
-         * NOTE: Not sure if the alpha combiner might use the color output of the previous
-         *       stage as input. Hence, we currently don't directly write the result to
-         *       combiner_output.rgb(), but instead store it in a temporary variable until
-         *       alpha combining has been done.
-         **/
-        const auto source1 = tev_stage_index == 0 && tev_stage.color_source1 == Source::Previous
-                                 ? tev_stage.color_source3.Value()
-                                 : tev_stage.color_source1.Value();
-        const auto source2 = tev_stage_index == 0 && tev_stage.color_source2 == Source::Previous
-                                 ? tev_stage.color_source3.Value()
-                                 : tev_stage.color_source2.Value();
-        const std::array<Common::Vec3<u8>, 3> color_result = {
-            GetColorModifier(tev_stage.color_modifier1, get_source(source1)),
-            GetColorModifier(tev_stage.color_modifier2, get_source(source2)),
-            GetColorModifier(tev_stage.color_modifier3, get_source(tev_stage.color_source3)),
-        };
-        const Common::Vec3<u8> color_output = ColorCombine(tev_stage.color_op, color_result);
-
-        u8 alpha_output;
-        if (tev_stage.color_op == TexturingRegs::TevStageConfig::Operation::Dot3_RGBA) {
-            // result of Dot3_RGBA operation is also placed to the alpha component
-            alpha_output = color_output.x;
-        } else {
-            // alpha combiner
-            const std::array<u8, 3> alpha_result = {{
-                GetAlphaModifier(tev_stage.alpha_modifier1, get_source(tev_stage.alpha_source1)),
-                GetAlphaModifier(tev_stage.alpha_modifier2, get_source(tev_stage.alpha_source2)),
-                GetAlphaModifier(tev_stage.alpha_modifier3, get_source(tev_stage.alpha_source3)),
-            }};
-            alpha_output = AlphaCombine(tev_stage.alpha_op, alpha_result);
-        }
-
-        combiner_output[0] = std::min(255U, color_output.r() * tev_stage.GetColorMultiplier());
-        combiner_output[1] = std::min(255U, color_output.g() * tev_stage.GetColorMultiplier());
-        combiner_output[2] = std::min(255U, color_output.b() * tev_stage.GetColorMultiplier());
-        combiner_output[3] = std::min(255U, alpha_output * tev_stage.GetAlphaMultiplier());
-
-        combiner_buffer = next_combiner_buffer;
-
-        if (regs.texturing.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferColor(
-                tev_stage_index)) {
-            next_combiner_buffer.r() = combiner_output.r();
-            next_combiner_buffer.g() = combiner_output.g();
-            next_combiner_buffer.b() = combiner_output.b();
-        }
-
-        if (regs.texturing.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferAlpha(
-                tev_stage_index)) {
-            next_combiner_buffer.a() = combiner_output.a();
-        }
-    }
-
-    return combiner_output;
-}
-
 void RasterizerSoftware::WriteFog(float depth, Common::Vec4<u8>& combiner_output) const {
     /**
      * Apply fog combiner. Not fully accurate. We'd have to know what data type is used to
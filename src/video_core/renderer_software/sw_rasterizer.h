@@ -5,11 +5,16 @@
 #pragma once
 
 #include <span>
+#include <vector>
 #include "common/thread_worker.h"
 #include "video_core/pica/regs_texturing.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_software/sw_clipper.h"
 #include "video_core/renderer_software/sw_framebuffer.h"
+#include "video_core/renderer_software/sw_lighting.h"
+#include "video_core/renderer_software/sw_proctex.h"
+#include "video_core/renderer_software/sw_tev.h"
+#include "video_core/renderer_software/sw_texturing.h"
 
 namespace Pica {
 struct RegsInternal;
@@ -19,14 +24,16 @@ class PicaCore;
 namespace SwRenderer {
 
 struct Vertex;
+struct BinnedTriangle;
 
 class RasterizerSoftware : public VideoCore::RasterizerInterface {
 public:
     explicit RasterizerSoftware(Memory::MemorySystem& memory, Pica::PicaCore& pica);
+    ~RasterizerSoftware() override;
 
     void AddTriangle(const Pica::OutputVertex& v0, const Pica::OutputVertex& v1,
                      const Pica::OutputVertex& v2) override;
-    void DrawTriangles() override {}
+    void DrawTriangles() override;
     void FlushAll() override {}
     void FlushRegion(PAddr addr, u32 size) override {}
     void InvalidateRegion(PAddr addr, u32 size) override {}
@@ -37,25 +44,24 @@ private:
     /// Computes the screen coordinates of the provided vertex.
     void MakeScreenCoords(Vertex& vtx);
 
-    /// Processes the triangle defined by the provided vertices.
+    /// Sets up the triangle defined by the provided vertices and queues it for rasterization.
     void ProcessTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2,
                          bool reversed = false);
 
-    /// Returns the texture color of the currently processed pixel.
+    /// Rasterizes the part of the triangle inside the tile with the provided 12.4 origin.
+    void RasterizeTriangle(const BinnedTriangle& triangle, u32 tile_x, u32 tile_y,
+                           std::span<const Pica::TexturingRegs::FullTextureConfig, 3> textures,
+                           u32 used_textures, TileCache& tile_cache);
+
+    /// Returns the color of the texture units in used_textures for the currently processed pixel.
     std::array<Common::Vec4<u8>, 4> TextureColor(
         std::span<const Common::Vec2<f24>, 3> uv,
-        std::span<const Pica::TexturingRegs::FullTextureConfig, 3> textures, f24 tc0_w) const;
+        std::span<const Pica::TexturingRegs::FullTextureConfig, 3> textures, f24 tc0_w,
+        u32 used_textures, TileCache& tile_cache) const;
 
     /// Returns the final pixel color with blending or logic ops applied.
     Common::Vec4<u8> PixelColor(u16 x, u16 y, Common::Vec4<u8> combiner_output) const;
 
-    /// Emulates the TEV configuration and returns the combiner output.
-    Common::Vec4<u8> WriteTevConfig(
-        std::span<const Common::Vec4<u8>, 4> texture_color,
-        std::span<const Pica::TexturingRegs::TevStageConfig, 6> tev_stages,
-        Common::Vec4<u8> primary_color, Common::Vec4<u8> primary_fragment_color,
-        Common::Vec4<u8> secondary_fragment_color);
-
     /// Blends fog to the combiner output if enabled.
     void WriteFog(float depth, Common::Vec4<u8>& combiner_output) const;
 
@@ -70,8 +76,15 @@ private:
     Pica::PicaCore& pica;
     Pica::RegsInternal& regs;
     std::size_t num_sw_threads;
-    Common::ThreadWorker sw_workers;
+    Common::StatefulThreadWorker<TileCache> sw_workers;
+    TileCache main_tile_cache;
+    u64 draw_count{};
     Framebuffer fb;
+    TevProgram tev_program;
+    LightingTables lighting_tables;
+    ProcTexTables proctex_tables;
+    std::vector<BinnedTriangle> triangles;
+    std::vector<std::vector<u32>> tile_bins;
 };
 
 } // namespace SwRenderer
@@ -0,0 +1,202 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "common/logging/log.h"
+#include "video_core/renderer_software/sw_tev.h"
+#include "video_core/renderer_software/sw_texturing.h"
+
+namespace SwRenderer {
+
+using TevStageConfig = Pica::TexturingRegs::TevStageConfig;
+using Source = TevStageConfig::Source;
+
+namespace {
+
+/// Number of register file slots, one per value of the source field.
+constexpr std::size_t NUM_SLOTS = 16;
+
+constexpr std::size_t Slot(Source source) {
+    return static_cast<std::size_t>(source);
+}
+
+bool IsValidSource(Source source) {
+    return source <= Source::Texture3 || source >= Source::PreviousBuffer;
+}
+
+bool IsPassThrough(const TevStageConfig& stage, Source color_source1) {
+    return stage.color_op == TevStageConfig::Operation::Replace &&
+           stage.alpha_op == TevStageConfig::Operation::Replace &&
+           color_source1 == Source::Previous && stage.alpha_source1 == Source::Previous &&
+           stage.color_modifier1 == TevStageConfig::ColorModifier::SourceColor &&
+           stage.alpha_modifier1 == TevStageConfig::AlphaModifier::SourceAlpha &&
+           stage.GetColorMultiplier() == 1 && stage.GetAlphaMultiplier() == 1;
+}
+
+} // Anonymous namespace
+
+void TevProgram::Update(const Pica::TexturingRegs& regs) {
+    Key new_key{};
+    const auto tev_stages = regs.GetTevStages();
+    for (std::size_t i = 0; i < tev_stages.size(); i++) {
+        const auto& stage = tev_stages[i];
+        new_key[i * 5 + 0] = stage.sources_raw;
+        new_key[i * 5 + 1] = stage.modifiers_raw;
+        new_key[i * 5 + 2] = stage.ops_raw;
+        new_key[i * 5 + 3] = stage.const_color;
+        new_key[i * 5 + 4] = stage.scales_raw;
+    }
+    new_key[30] = regs.tev_combiner_buffer_input.update_mask_rgb |
+                  (regs.tev_combiner_buffer_input.update_mask_a << 4);
+    new_key[31] = regs.tev_combiner_buffer_color.raw;
+
+    if (valid && new_key == key) {
+        return;
+    }
+    key = new_key;
+    valid = true;
+    Build(regs);
+}
+
+void TevProgram::Build(const Pica::TexturingRegs& regs) {
+    num_stages = 0;
+    used_textures = 0;
+    buffer_color = Common::MakeVec(regs.tev_combiner_buffer_color.r.Value(),
+                                   regs.tev_combiner_buffer_color.g.Value(),
+                                   regs.tev_combiner_buffer_color.b.Value(),
+                                   regs.tev_combiner_buffer_color.a.Value())
+                       .Cast<u8>();
+
+    const auto use_source = [this](Source source) {
+        if (source >= Source::Texture0 && source <= Source::Texture3) {
+            used_textures |= 1U << (Slot(source) - Slot(Source::Texture0));
+        } else if (!IsValidSource(source)) {
+            LOG_ERROR(HW_GPU, "Unknown color combiner source {}", static_cast<u32>(source));
+        }
+    };
+
+    bool previous_dropped = false;
+    const auto tev_stages = regs.GetTevStages();
+    for (u32 index = 0; index < tev_stages.size(); index++) {
+        const auto& tev_stage = tev_stages[index];
+
+        // The first stage has no previous output, its first inputs fall back to the third one.
+        const auto resolve = [&](Source source) {
+            return index == 0 && source == Source::Previous ? tev_stage.color_source3.Value()
+                                                            : source;
+        };
+
+        Stage stage = {
+            .color_sources = {resolve(tev_stage.color_source1), resolve(tev_stage.color_source2),
+                              tev_stage.color_source3.Value()},
+            .color_modifiers = {tev_stage.color_modifier1.Value(),
+                                tev_stage.color_modifier2.Value(),
+                                tev_stage.color_modifier3.Value()},
+            .alpha_sources = {tev_stage.alpha_source1.Value(), tev_stage.alpha_source2.Value(),
+                              tev_stage.alpha_source3.Value()},
+            .alpha_modifiers = {tev_stage.alpha_modifier1.Value(),
+                                tev_stage.alpha_modifier2.Value(),
+                                tev_stage.alpha_modifier3.Value()},
+            .color_op = tev_stage.color_op.Value(),
+            .alpha_op = tev_stage.alpha_op.Value(),
+            .constant = Common::MakeVec(tev_stage.const_r.Value(), tev_stage.const_g.Value(),
+                                        tev_stage.const_b.Value(), tev_stage.const_a.Value())
+                            .Cast<u8>(),
+            .color_multiplier = tev_stage.GetColorMultiplier(),
+            .alpha_multiplier = tev_stage.GetAlphaMultiplier(),
+            .combine = false,
+            .latch_buffer = previous_dropped,
+            .update_buffer_color =
+                regs.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferColor(index),
+            .update_buffer_alpha =
+                regs.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferAlpha(index),
+        };
+        stage.combine = !IsPassThrough(tev_stage, stage.color_sources[0]);
+
+        // A stage that changes neither the output nor the buffer is dropped, the stage after it
+        // latches the buffer in its place.
+        if (!stage.combine && !stage.update_buffer_color && !stage.update_buffer_alpha) {
+            previous_dropped = true;
+            continue;
+        }
+        previous_dropped = false;
+
+        if (stage.combine) {
+            std::ranges::for_each(stage.color_sources, use_source);
+            if (stage.color_op != TevStageConfig::Operation::Dot3_RGBA) {
+                std::ranges::for_each(stage.alpha_sources, use_source);
+            }
+        }
+        stages[num_stages++] = stage;
+    }
+}
+
+Common::Vec4<u8> TevProgram::Run(std::span<const Common::Vec4<u8>, 4> texture_color,
+                                 Common::Vec4<u8> primary_color,
+                                 Common::Vec4<u8> primary_fragment_color,
+                                 Common::Vec4<u8> secondary_fragment_color) const {
+    std::array<Common::Vec4<u8>, NUM_SLOTS> inputs{};
+    inputs[Slot(Source::PrimaryColor)] = primary_color;
+    inputs[Slot(Source::PrimaryFragmentColor)] = primary_fragment_color;
+    inputs[Slot(Source::SecondaryFragmentColor)] = secondary_fragment_color;
+    std::copy(texture_color.begin(), texture_color.end(),
+              inputs.begin() + Slot(Source::Texture0));
+
+    Common::Vec4<u8>& combiner_output = inputs[Slot(Source::Previous)];
+    Common::Vec4<u8>& combiner_buffer = inputs[Slot(Source::PreviousBuffer)];
+    Common::Vec4<u8> next_combiner_buffer = buffer_color;
+
+    for (u32 i = 0; i < num_stages; i++) {
+        const Stage& stage = stages[i];
+        if (stage.latch_buffer) {
+            combiner_buffer = next_combiner_buffer;
+        }
+
+        if (stage.combine) {
+            inputs[Slot(Source::Constant)] = stage.constant;
+
+            const std::array<Common::Vec3<u8>, 3> color_result = {
+                GetColorModifier(stage.color_modifiers[0], inputs[Slot(stage.color_sources[0])]),
+                GetColorModifier(stage.color_modifiers[1], inputs[Slot(stage.color_sources[1])]),
+                GetColorModifier(stage.color_modifiers[2], inputs[Slot(stage.color_sources[2])]),
+            };
+            const Common::Vec3<u8> color_output = ColorCombine(stage.color_op, color_result);
+
+            u8 alpha_output;
+            if (stage.color_op == TevStageConfig::Operation::Dot3_RGBA) {
+                // result of Dot3_RGBA operation is also placed to the alpha component
+                alpha_output = color_output.x;
+            } else {
+                const std::array<u8, 3> alpha_result = {{
+                    GetAlphaModifier(stage.alpha_modifiers[0],
+                                     inputs[Slot(stage.alpha_sources[0])]),
+                    GetAlphaModifier(stage.alpha_modifiers[1],
+                                     inputs[Slot(stage.alpha_sources[1])]),
+                    GetAlphaModifier(stage.alpha_modifiers[2],
+                                     inputs[Slot(stage.alpha_sources[2])]),
+                }};
+                alpha_output = AlphaCombine(stage.alpha_op, alpha_result);
+            }
+
+            combiner_output[0] = std::min(255U, color_output.r() * stage.color_multiplier);
+            combiner_output[1] = std::min(255U, color_output.g() * stage.color_multiplier);
+            combiner_output[2] = std::min(255U, color_output.b() * stage.color_multiplier);
+            combiner_output[3] = std::min(255U, alpha_output * stage.alpha_multiplier);
+        }
+
+        combiner_buffer = next_combiner_buffer;
+        if (stage.update_buffer_color) {
+            next_combiner_buffer.r() = combiner_output.r();
+            next_combiner_buffer.g() = combiner_output.g();
+            next_combiner_buffer.b() = combiner_output.b();
+        }
+        if (stage.update_buffer_alpha) {
+            next_combiner_buffer.a() = combiner_output.a();
+        }
+    }
+
+    return combiner_output;
+}
+
+} // namespace SwRenderer
@@ -0,0 +1,71 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <span>
+#include "common/common_types.h"
+#include "common/vector_math.h"
+#include "video_core/pica/regs_texturing.h"
+
+namespace SwRenderer {
+
+/**
+ * The texture environment of the current configuration, decoded once instead of per pixel.
+ * Stages that pass the previous output through are dropped and the sources of the remaining
+ * stages are resolved to slots of a small register file, so running the program only has to
+ * fetch, modify and combine.
+ */
+class TevProgram {
+    using TevStageConfig = Pica::TexturingRegs::TevStageConfig;
+
+public:
+    /// Rebuilds the program when the combiner registers changed since the last call.
+    void Update(const Pica::TexturingRegs& regs);
+
+    /// Returns a mask of the texture units, including the procedural one, read by the program.
+    [[nodiscard]] u32 UsedTextures() const noexcept {
+        return used_textures;
+    }
+
+    /// Runs the combiner stages for a fragment and returns the combiner output.
+    [[nodiscard]] Common::Vec4<u8> Run(std::span<const Common::Vec4<u8>, 4> texture_color,
+                                       Common::Vec4<u8> primary_color,
+                                       Common::Vec4<u8> primary_fragment_color,
+                                       Common::Vec4<u8> secondary_fragment_color) const;
+
+private:
+    struct Stage {
+        std::array<TevStageConfig::Source, 3> color_sources;
+        std::array<TevStageConfig::ColorModifier, 3> color_modifiers;
+        std::array<TevStageConfig::Source, 3> alpha_sources;
+        std::array<TevStageConfig::AlphaModifier, 3> alpha_modifiers;
+        TevStageConfig::Operation color_op;
+        TevStageConfig::Operation alpha_op;
+        Common::Vec4<u8> constant;
+        u32 color_multiplier;
+        u32 alpha_multiplier;
+        bool combine;      ///< False for pass through stages kept for their buffer updates.
+        bool latch_buffer; ///< Takes the buffer the dropped stage before it would have latched.
+        bool update_buffer_color;
+        bool update_buffer_alpha;
+    };
+
+    /// The raw values of the registers the program was built from.
+    using Key = std::array<u32, 32>;
+
+    /// Decodes the stages from the registers.
+    void Build(const Pica::TexturingRegs& regs);
+
+private:
+    Key key{};
+    bool valid{};
+    std::array<Stage, 6> stages{};
+    u32 num_stages{};
+    u32 used_textures{};
+    Common::Vec4<u8> buffer_color{};
+};
+
+} // namespace SwRenderer
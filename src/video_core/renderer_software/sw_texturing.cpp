@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <bit>
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/vector_math.h"
@@ -204,4 +205,36 @@ u8 AlphaCombine(TevStageConfig::Operation op, const std::array<u8, 3>& input) {
     }
 };
 
+Common::Vec4<u8> BilinearFilter(std::span<const Common::Vec4<u8>, 4> texels, u32 s_weight,
+                                u32 t_weight) {
+    // All four channels are blended at once, which compiles to vector multiply-adds.
+    const auto top = texels[0].Cast<u32>() * (256 - s_weight) + texels[1].Cast<u32>() * s_weight;
+    const auto bottom = texels[2].Cast<u32>() * (256 - s_weight) + texels[3].Cast<u32>() * s_weight;
+    const auto rounding = Common::MakeVec(0x8000U, 0x8000U, 0x8000U, 0x8000U);
+    return ((top * (256 - t_weight) + bottom * t_weight + rounding) / 0x10000U).Cast<u8>();
+}
+
+Common::Vec4<u8> TileCache::Lookup(const u8* source, u32 x, u32 y,
+                                   const Pica::Texture::TextureInfo& info, u64 draw) {
+    const u8* tile = source + (y / 8) * info.stride +
+                     (x / 8) * Pica::Texture::CalculateTileSize(info.format);
+
+    // Tiles are at least 32 bytes apart, hash the address to spread them over the entries.
+    const auto address = static_cast<u64>(std::bit_cast<uintptr_t>(tile));
+    Entry& entry = entries[((address >> 5) * 0x9E3779B97F4A7C15ULL) >> (64 - ENTRY_BITS)];
+    if (entry.tile != tile || entry.draw != draw || entry.format != info.format) {
+        entry.tile = tile;
+        entry.draw = draw;
+        entry.format = info.format;
+        entry.decoded_mask = 0;
+    }
+
+    const u32 index = (y % 8) * 8 + (x % 8);
+    if ((entry.decoded_mask & (1ULL << index)) == 0) {
+        entry.texels[index] = Pica::Texture::LookupTexelInTile(tile, x % 8, y % 8, info, false);
+        entry.decoded_mask |= 1ULL << index;
+    }
+    return entry.texels[index];
+}
+
 } // namespace SwRenderer
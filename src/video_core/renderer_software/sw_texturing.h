@@ -4,11 +4,13 @@
 
 #pragma once
 
+#include <array>
 #include <span>
 
 #include "common/common_types.h"
 #include "common/vector_math.h"
 #include "video_core/pica/regs_texturing.h"
+#include "video_core/texture/texture_decode.h"
 
 namespace SwRenderer {
 
@@ -25,4 +27,36 @@ Common::Vec3<u8> ColorCombine(Pica::TexturingRegs::TevStageConfig::Operation op,
 
 u8 AlphaCombine(Pica::TexturingRegs::TevStageConfig::Operation op, const std::array<u8, 3>& input);
 
+/// Blends the four texels around a sample position by their 8-bit sub-texel weights. The texels
+/// are ordered (s, t), (s + 1, t), (s, t + 1) and (s + 1, t + 1).
+Common::Vec4<u8> BilinearFilter(std::span<const Common::Vec4<u8>, 4> texels, u32 s_weight,
+                                u32 t_weight);
+
+/**
+ * Keeps the texels of recently sampled 8x8 texture tiles, so that neighbouring pixels and the
+ * taps of a filtered lookup do not decode the same texels over again. Texels are decoded on
+ * first use and the entries only stay valid for the draw they were filled in, as the texture
+ * memory may change between draws. Each rasterizer thread owns one.
+ */
+class TileCache {
+public:
+    /// Returns the texel at the provided texture coordinates, decoding it on a miss.
+    Common::Vec4<u8> Lookup(const u8* source, u32 x, u32 y,
+                            const Pica::Texture::TextureInfo& info, u64 draw);
+
+private:
+    static constexpr std::size_t ENTRY_BITS = 6;
+    static constexpr std::size_t NUM_ENTRIES = 1 << ENTRY_BITS;
+
+    struct Entry {
+        const u8* tile;
+        u64 draw;
+        u64 decoded_mask;
+        Pica::TexturingRegs::TextureFormat format;
+        std::array<Common::Vec4<u8>, 64> texels;
+    };
+
+    std::array<Entry, NUM_ENTRIES> entries{};
+};
+
 } // namespace SwRenderer
@@ -177,6 +177,18 @@ inline vk::PrimitiveTopology PrimitiveTopology(Pica::PipelineRegs::TriangleTopol
     return vk::PrimitiveTopology::eTriangleList;
 }
 
+/// Returns the topology that feeds each geometry shader invocation its input vertices
+inline vk::PrimitiveTopology GSInputTopology(u32 vertices_per_primitive) {
+    switch (vertices_per_primitive) {
+    case 1:
+        return vk::PrimitiveTopology::ePointList;
+    case 2:
+        return vk::PrimitiveTopology::eLineList;
+    default:
+        return vk::PrimitiveTopology::eTriangleList;
+    }
+}
+
 inline vk::CullModeFlags CullMode(Pica::RasterizerRegs::CullMode mode, bool flip_viewport) {
     switch (mode) {
     case Pica::RasterizerRegs::CullMode::KeepAll:
@@ -2,17 +2,20 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <utility>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/memory_detect.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "core/dumping/backend.h"
 #include "core/frontend/emu_window.h"
 #include "video_core/gpu.h"
 #include "video_core/pica/pica_core.h"
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
 #include "video_core/renderer_vulkan/vk_memory_util.h"
+#include "video_core/renderer_vulkan/vk_post_processing.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
 
 #include "video_core/host_shaders/vulkan_present_anaglyph_frag.h"
@@ -50,6 +53,72 @@ constexpr static std::array<vk::DescriptorSetLayoutBinding, 1> PRESENT_BINDINGS
     {0, vk::DescriptorType::eCombinedImageSampler, 3, vk::ShaderStageFlagBits::eFragment},
 }};
 
+/// Records a copy of a present frame, in the transfer source layout, to a buffer.
+static void RecordFrameReadback(vk::CommandBuffer cmdbuf, vk::Image source_image,
+                                vk::Buffer buffer, u32 width, u32 height) {
+    const vk::ImageMemoryBarrier read_barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+        .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+        .oldLayout = vk::ImageLayout::eTransferSrcOptimal,
+        .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = source_image,
+        .subresourceRange{
+            .aspectMask = vk::ImageAspectFlagBits::eColor,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        },
+    };
+    const vk::ImageMemoryBarrier write_barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eTransferRead,
+        .dstAccessMask = vk::AccessFlagBits::eMemoryWrite,
+        .oldLayout = vk::ImageLayout::eTransferSrcOptimal,
+        .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = source_image,
+        .subresourceRange{
+            .aspectMask = vk::ImageAspectFlagBits::eColor,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        },
+    };
+    static constexpr vk::MemoryBarrier memory_write_barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+        .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+    };
+
+    const vk::BufferImageCopy image_copy = {
+        .bufferOffset = 0,
+        .bufferRowLength = 0,
+        .bufferImageHeight = 0,
+        .imageSubresource =
+            {
+                .aspectMask = vk::ImageAspectFlagBits::eColor,
+                .mipLevel = 0,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+        .imageOffset = {0, 0, 0},
+        .imageExtent = {width, height, 1},
+    };
+
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits::eByRegion,
+                           {}, {}, read_barrier);
+    cmdbuf.copyImageToBuffer(source_image, vk::ImageLayout::eTransferSrcOptimal, buffer,
+                             image_copy);
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eAllCommands,
+                           vk::DependencyFlagBits::eByRegion, memory_write_barrier, {},
+                           write_barrier);
+}
+
 RendererVulkan::RendererVulkan(Core::System& system, Pica::PicaCore& pica_,
                                Frontend::EmuWindow& window, Frontend::EmuWindow* secondary_window)
     : RendererBase{system, window, secondary_window}, memory{system.Memory()}, pica{pica_},
@@ -76,6 +145,10 @@ RendererVulkan::~RendererVulkan() {
     main_window.WaitPresent();
     device.waitIdle();
 
+    for (auto& dump : dump_frames) {
+        DestroyDumpFrame(dump);
+    }
+
     device.destroyShaderModule(present_vertex_shader);
     for (u32 i = 0; i < PRESENT_PIPELINES; i++) {
         device.destroyPipeline(present_pipelines[i]);
@@ -269,6 +342,12 @@ void RendererVulkan::BuildLayouts() {
 }
 
 void RendererVulkan::BuildPipelines() {
+    for (u32 i = 0; i < PostProcessingPipeline; i++) {
+        present_pipelines[i] = BuildPipeline(present_shaders[i]);
+    }
+}
+
+vk::Pipeline RendererVulkan::BuildPipeline(vk::ShaderModule fragment_shader) {
     const vk::VertexInputBindingDescription binding = {
         .binding = 0,
         .stride = sizeof(ScreenRectVertex),
@@ -356,40 +435,70 @@ void RendererVulkan::BuildPipelines() {
         .stencilTestEnable = false,
     };
 
-    for (u32 i = 0; i < PRESENT_PIPELINES; i++) {
-        const std::array shader_stages = {
-            vk::PipelineShaderStageCreateInfo{
-                .stage = vk::ShaderStageFlagBits::eVertex,
-                .module = present_vertex_shader,
-                .pName = "main",
-            },
-            vk::PipelineShaderStageCreateInfo{
-                .stage = vk::ShaderStageFlagBits::eFragment,
-                .module = present_shaders[i],
-                .pName = "main",
-            },
-        };
+    const std::array shader_stages = {
+        vk::PipelineShaderStageCreateInfo{
+            .stage = vk::ShaderStageFlagBits::eVertex,
+            .module = present_vertex_shader,
+            .pName = "main",
+        },
+        vk::PipelineShaderStageCreateInfo{
+            .stage = vk::ShaderStageFlagBits::eFragment,
+            .module = fragment_shader,
+            .pName = "main",
+        },
+    };
 
-        const vk::GraphicsPipelineCreateInfo pipeline_info = {
-            .stageCount = static_cast<u32>(shader_stages.size()),
-            .pStages = shader_stages.data(),
-            .pVertexInputState = &vertex_input_info,
-            .pInputAssemblyState = &input_assembly,
-            .pViewportState = &viewport_info,
-            .pRasterizationState = &raster_state,
-            .pMultisampleState = &multisampling,
-            .pDepthStencilState = &depth_info,
-            .pColorBlendState = &color_blending,
-            .pDynamicState = &dynamic_info,
-            .layout = *present_pipeline_layout,
-            .renderPass = main_window.Renderpass(),
-        };
+    const vk::GraphicsPipelineCreateInfo pipeline_info = {
+        .stageCount = static_cast<u32>(shader_stages.size()),
+        .pStages = shader_stages.data(),
+        .pVertexInputState = &vertex_input_info,
+        .pInputAssemblyState = &input_assembly,
+        .pViewportState = &viewport_info,
+        .pRasterizationState = &raster_state,
+        .pMultisampleState = &multisampling,
+        .pDepthStencilState = &depth_info,
+        .pColorBlendState = &color_blending,
+        .pDynamicState = &dynamic_info,
+        .layout = *present_pipeline_layout,
+        .renderPass = main_window.Renderpass(),
+    };
+
+    const auto [result, pipeline] = instance.GetDevice().createGraphicsPipeline({}, pipeline_info);
+    ASSERT_MSG(result == vk::Result::eSuccess, "Unable to build present pipelines");
+    return pipeline;
+}
+
+bool RendererVulkan::LoadPostProcessingShader(bool anaglyph, const std::string& shader_name) {
+    const std::string shader_key = anaglyph ? "anaglyph/" + shader_name : shader_name;
+    if (shader_key == post_processing_shader) {
+        return static_cast<bool>(present_pipelines[PostProcessingPipeline]);
+    }
+    post_processing_shader = shader_key;
 
-        const auto [result, pipeline] =
-            instance.GetDevice().createGraphicsPipeline({}, pipeline_info);
-        ASSERT_MSG(result == vk::Result::eSuccess, "Unable to build present pipelines");
-        present_pipelines[i] = pipeline;
+    // The previous shader may still be in use by frames in flight.
+    const vk::Device device = instance.GetDevice();
+    scheduler.Finish();
+    device.destroyPipeline(present_pipelines[PostProcessingPipeline]);
+    device.destroyShaderModule(present_shaders[PostProcessingPipeline]);
+    present_pipelines[PostProcessingPipeline] = nullptr;
+    present_shaders[PostProcessingPipeline] = nullptr;
+
+    const std::string shader_code = GetPostProcessingShaderCode(anaglyph, shader_name);
+    if (shader_code.empty()) {
+        LOG_ERROR(Render_Vulkan, "Unable to load post processing shader {}", shader_name);
+        return false;
+    }
+    const std::string_view preamble =
+        instance.IsImageArrayDynamicIndexSupported() ? "#define ARRAY_DYNAMIC_INDEX" : "";
+    present_shaders[PostProcessingPipeline] =
+        Compile(shader_code, vk::ShaderStageFlagBits::eFragment, device, preamble);
+    if (!present_shaders[PostProcessingPipeline]) {
+        LOG_ERROR(Render_Vulkan, "Unable to compile post processing shader {}", shader_name);
+        return false;
     }
+    present_pipelines[PostProcessingPipeline] =
+        BuildPipeline(present_shaders[PostProcessingPipeline]);
+    return true;
 }
 
 void RendererVulkan::ConfigureFramebufferTexture(TextureInfo& texture,
@@ -525,6 +634,18 @@ void RendererVulkan::ReloadPipeline() {
         current_pipeline = 0;
         break;
     }
+
+    // User shaders replace the present shader of the layout pass instead of adding a pass.
+    if (current_pipeline == 2) {
+        return;
+    }
+    const bool anaglyph = current_pipeline == 1;
+    const std::string shader_name = anaglyph ? Settings::values.anaglyph_shader_name.GetValue()
+                                             : Settings::values.pp_shader_name.GetValue();
+    const bool builtin = shader_name == (anaglyph ? "dubois (builtin)" : "none (builtin)");
+    if (!builtin && LoadPostProcessingShader(anaglyph, shader_name)) {
+        current_pipeline = PostProcessingPipeline;
+    }
 }
 
 void RendererVulkan::DrawSingleScreen(u32 screen_id, float x, float y, float w, float h,
@@ -836,6 +957,7 @@ void RendererVulkan::SwapBuffers() {
     const Layout::FramebufferLayout& layout = render_window.GetFramebufferLayout();
     PrepareRendertarget();
     RenderScreenshot();
+    RenderToVideoDumper();
     RenderToWindow(main_window, layout, false);
 #ifndef ANDROID
     if (Settings::values.layout_option.GetValue() == Settings::LayoutOption::SeparateWindows) {
@@ -849,6 +971,13 @@ void RendererVulkan::SwapBuffers() {
     }
 #endif
     system.perf_stats->EndSwap();
+    const StagingAllocator::Stats staging = rasterizer.GetAndResetStagingStats();
+    system.perf_stats->ReportStagingMemory(staging.memory, staging.stalls);
+    const RenderManager::Stats passes = renderpass_cache.GetAndResetStats();
+    system.perf_stats->ReportRenderPasses(passes.render_passes, passes.merged_passes,
+                                          passes.bytes_saved);
+    system.perf_stats->ReportPresentLatency(main_window.GetAndResetPresentLatency());
+    system.perf_stats->ReportShaderCompiles(rasterizer.GetAndResetShaderCompiles());
     rasterizer.TickFrame();
     EndFrame();
 }
@@ -908,66 +1037,7 @@ void RendererVulkan::RenderScreenshotWithStagingCopy() {
 
     scheduler.Record(
         [width, height, source_image = frame.image, staging_buffer](vk::CommandBuffer cmdbuf) {
-            const vk::ImageMemoryBarrier read_barrier = {
-                .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
-                .dstAccessMask = vk::AccessFlagBits::eTransferRead,
-                .oldLayout = vk::ImageLayout::eTransferSrcOptimal,
-                .newLayout = vk::ImageLayout::eTransferSrcOptimal,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image = source_image,
-                .subresourceRange{
-                    .aspectMask = vk::ImageAspectFlagBits::eColor,
-                    .baseMipLevel = 0,
-                    .levelCount = VK_REMAINING_MIP_LEVELS,
-                    .baseArrayLayer = 0,
-                    .layerCount = VK_REMAINING_ARRAY_LAYERS,
-                },
-            };
-            const vk::ImageMemoryBarrier write_barrier = {
-                .srcAccessMask = vk::AccessFlagBits::eTransferRead,
-                .dstAccessMask = vk::AccessFlagBits::eMemoryWrite,
-                .oldLayout = vk::ImageLayout::eTransferSrcOptimal,
-                .newLayout = vk::ImageLayout::eTransferSrcOptimal,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image = source_image,
-                .subresourceRange{
-                    .aspectMask = vk::ImageAspectFlagBits::eColor,
-                    .baseMipLevel = 0,
-                    .levelCount = VK_REMAINING_MIP_LEVELS,
-                    .baseArrayLayer = 0,
-                    .layerCount = VK_REMAINING_ARRAY_LAYERS,
-                },
-            };
-            static constexpr vk::MemoryBarrier memory_write_barrier = {
-                .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
-                .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
-            };
-
-            const vk::BufferImageCopy image_copy = {
-                .bufferOffset = 0,
-                .bufferRowLength = 0,
-                .bufferImageHeight = 0,
-                .imageSubresource =
-                    {
-                        .aspectMask = vk::ImageAspectFlagBits::eColor,
-                        .mipLevel = 0,
-                        .baseArrayLayer = 0,
-                        .layerCount = 1,
-                    },
-                .imageOffset = {0, 0, 0},
-                .imageExtent = {width, height, 1},
-            };
-
-            cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
-                                   vk::PipelineStageFlagBits::eTransfer,
-                                   vk::DependencyFlagBits::eByRegion, {}, {}, read_barrier);
-            cmdbuf.copyImageToBuffer(source_image, vk::ImageLayout::eTransferSrcOptimal,
-                                     staging_buffer, image_copy);
-            cmdbuf.pipelineBarrier(
-                vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands,
-                vk::DependencyFlagBits::eByRegion, memory_write_barrier, {}, write_barrier);
+            RecordFrameReadback(cmdbuf, source_image, staging_buffer, width, height);
         });
 
     // Ensure the copy is fully completed before saving the screenshot
@@ -983,6 +1053,110 @@ void RendererVulkan::RenderScreenshotWithStagingCopy() {
     device.destroyImageView(frame.image_view);
 }
 
+void RendererVulkan::RenderToVideoDumper() {
+    const auto video_dumper = system.GetVideoDumper();
+    if (!video_dumper || !video_dumper->IsDumping()) {
+        if (dump_frames[0].buffer || dump_frames[1].buffer) {
+            scheduler.Finish();
+            for (auto& dump : dump_frames) {
+                DestroyDumpFrame(dump);
+            }
+        }
+        return;
+    }
+
+    DumpFrame& dump = dump_frames[dump_index];
+    dump_index = (dump_index + 1) % static_cast<u32>(dump_frames.size());
+
+    // The frame rendered into this slot two swaps ago has long finished on the GPU by now.
+    if (dump.pending) {
+        SendDumpFrame(dump);
+    }
+
+    const Layout::FramebufferLayout layout = video_dumper->GetLayout();
+    if (!dump.buffer || dump.frame.width != layout.width || dump.frame.height != layout.height) {
+        DestroyDumpFrame(dump);
+        CreateDumpFrame(dump, layout.width, layout.height);
+    }
+
+    DrawScreens(&dump.frame, layout, false);
+    scheduler.Record([width = layout.width, height = layout.height, image = dump.frame.image,
+                      buffer = dump.buffer](vk::CommandBuffer cmdbuf) {
+        RecordFrameReadback(cmdbuf, image, buffer, width, height);
+    });
+    dump.tick = scheduler.CurrentTick();
+    dump.pending = true;
+}
+
+void RendererVulkan::CreateDumpFrame(DumpFrame& dump, u32 width, u32 height) {
+    const vk::BufferCreateInfo buffer_info = {
+        .size = width * height * 4,
+        .usage = vk::BufferUsageFlagBits::eTransferDst,
+    };
+
+    const VmaAllocationCreateInfo alloc_create_info = {
+        .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+        .requiredFlags = 0,
+        .preferredFlags = 0,
+        .pool = VK_NULL_HANDLE,
+        .pUserData = nullptr,
+    };
+
+    VkBuffer unsafe_buffer{};
+    VmaAllocationInfo alloc_info;
+    VkBufferCreateInfo unsafe_buffer_info = static_cast<VkBufferCreateInfo>(buffer_info);
+
+    VkResult result = vmaCreateBuffer(instance.GetAllocator(), &unsafe_buffer_info,
+                                      &alloc_create_info, &unsafe_buffer, &dump.allocation,
+                                      &alloc_info);
+    if (result != VK_SUCCESS) [[unlikely]] {
+        LOG_CRITICAL(Render_Vulkan, "Failed allocating video dump buffer with error {}", result);
+        UNREACHABLE();
+    }
+
+    dump.buffer = vk::Buffer{unsafe_buffer};
+    dump.mapped = static_cast<u8*>(alloc_info.pMappedData);
+    main_window.RecreateFrame(&dump.frame, width, height);
+}
+
+void RendererVulkan::DestroyDumpFrame(DumpFrame& dump) {
+    const vk::Device device = instance.GetDevice();
+    if (dump.buffer) {
+        vmaDestroyBuffer(instance.GetAllocator(), dump.buffer, dump.allocation);
+    }
+    if (dump.frame.framebuffer) {
+        device.destroyFramebuffer(dump.frame.framebuffer);
+    }
+    if (dump.frame.image_view) {
+        device.destroyImageView(dump.frame.image_view);
+    }
+    if (dump.frame.image) {
+        vmaDestroyImage(instance.GetAllocator(), dump.frame.image, dump.frame.allocation);
+    }
+    dump = {};
+}
+
+void RendererVulkan::SendDumpFrame(DumpFrame& dump) {
+    scheduler.Wait(dump.tick);
+    vmaInvalidateAllocation(instance.GetAllocator(), dump.allocation, 0, VK_WHOLE_SIZE);
+    dump.pending = false;
+
+    VideoDumper::VideoFrame frame{dump.frame.width, dump.frame.height, dump.mapped};
+
+    // The dumper takes BGRA pixels, swapchains may also be RGBA.
+    const vk::Format format = main_window.FrameFormat();
+    if (format == vk::Format::eR8G8B8A8Unorm || format == vk::Format::eR8G8B8A8Srgb) {
+        for (std::size_t i = 0; i < frame.data.size(); i += 4) {
+            std::swap(frame.data[i], frame.data[i + 2]);
+        }
+    }
+
+    if (const auto video_dumper = system.GetVideoDumper()) {
+        video_dumper->AddVideoFrame(std::move(frame));
+    }
+}
+
 bool RendererVulkan::TryRenderScreenshotWithHostMemory() {
     // If the host-memory import alignment matches the allocation granularity of the platform, then
     // the entire span of memory can be trivially imported
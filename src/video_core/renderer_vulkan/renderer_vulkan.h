@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <string>
 #include "common/common_types.h"
 #include "common/math_util.h"
 #include "video_core/renderer_base.h"
@@ -63,7 +64,9 @@ static_assert(sizeof(PresentUniformData) == 112,
               "PresentUniformData does not structure in shader!");
 
 class RendererVulkan : public VideoCore::RendererBase {
-    static constexpr std::size_t PRESENT_PIPELINES = 3;
+    static constexpr std::size_t PRESENT_PIPELINES = 4;
+    /// Pipeline of the user post processing shader, after the builtin ones.
+    static constexpr u32 PostProcessingPipeline = 3;
 
 public:
     explicit RendererVulkan(Core::System& system, Pica::PicaCore& pica, Frontend::EmuWindow& window,
@@ -82,10 +85,22 @@ public:
     void TryPresent(int timeout_ms, bool is_secondary) override {}
 
 private:
+    /// A frame rendered for the video dumper and the host visible buffer it is read back into.
+    struct DumpFrame {
+        Frame frame{};
+        vk::Buffer buffer{};
+        VmaAllocation allocation{};
+        u8* mapped{};
+        u64 tick{};
+        bool pending{};
+    };
+
     void ReloadPipeline();
     void CompileShaders();
     void BuildLayouts();
     void BuildPipelines();
+    vk::Pipeline BuildPipeline(vk::ShaderModule fragment_shader);
+    bool LoadPostProcessingShader(bool anaglyph, const std::string& shader_name);
     void ConfigureFramebufferTexture(TextureInfo& texture,
                                      const Pica::FramebufferConfig& framebuffer);
     void ConfigureRenderPipeline();
@@ -93,6 +108,7 @@ private:
     void RenderScreenshot();
     void RenderScreenshotWithStagingCopy();
     bool TryRenderScreenshotWithHostMemory();
+    void RenderToVideoDumper();
     void PrepareDraw(Frame* frame, const Layout::FramebufferLayout& layout);
     void RenderToWindow(PresentWindow& window, const Layout::FramebufferLayout& layout,
                         bool flipped);
@@ -109,6 +125,9 @@ private:
     void LoadFBToScreenInfo(const Pica::FramebufferConfig& framebuffer, ScreenInfo& screen_info,
                             bool right_eye);
     void FillScreen(Common::Vec3<u8> color, const TextureInfo& texture);
+    void CreateDumpFrame(DumpFrame& dump, u32 width, u32 height);
+    void DestroyDumpFrame(DumpFrame& dump);
+    void SendDumpFrame(DumpFrame& dump);
 
 private:
     Memory::MemorySystem& memory;
@@ -130,10 +149,15 @@ private:
     std::array<vk::Sampler, 2> present_samplers;
     vk::ShaderModule present_vertex_shader;
     u32 current_pipeline = 0;
+    std::string post_processing_shader; ///< Name of the user shader in the last pipeline.
 
     std::array<ScreenInfo, 3> screen_infos{};
     PresentUniformData draw_info{};
     vk::ClearColorValue clear_color{};
+
+    // Frames are read back two swaps after they are rendered, so dumping never waits on the GPU.
+    std::array<DumpFrame, 2> dump_frames{};
+    u32 dump_index = 0;
 };
 
 } // namespace Vulkan
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include "common/alignment.h"
 #include "common/vector_math.h"
 #include "video_core/renderer_vulkan/vk_blit_helper.h"
 #include "video_core/renderer_vulkan/vk_descriptor_update_queue.h"
@@ -15,6 +16,8 @@
 #include "video_core/host_shaders/full_screen_triangle_vert.h"
 #include "video_core/host_shaders/vulkan_blit_depth_stencil_frag.h"
 #include "video_core/host_shaders/vulkan_depth_to_buffer_comp.h"
+#include "video_core/host_shaders/vulkan_texture_decode_comp.h"
+#include "video_core/host_shaders/vulkan_texture_encode_comp.h"
 
 namespace Vulkan {
 
@@ -32,6 +35,15 @@ struct ComputeInfo {
     Common::Vec2i src_extent;
 };
 
+struct TextureCodecInfo {
+    u32 format;
+    u32 converted;
+    u32 width;
+    u32 height;
+    u32 src_offset; ///< In words
+    u32 dst_offset; ///< In words
+};
+
 inline constexpr vk::PushConstantRange COMPUTE_PUSH_CONSTANT_RANGE{
     .stageFlags = vk::ShaderStageFlagBits::eCompute,
     .offset = 0,
@@ -50,6 +62,17 @@ constexpr std::array<vk::DescriptorSetLayoutBinding, 3> COMPUTE_BUFFER_BINDINGS
     {2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
 }};
 
+constexpr std::array<vk::DescriptorSetLayoutBinding, 2> TEXTURE_CODEC_BINDINGS = {{
+    {0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+    {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+}};
+
+inline constexpr vk::PushConstantRange TEXTURE_CODEC_PUSH_CONSTANT_RANGE{
+    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+    .offset = 0,
+    .size = sizeof(TextureCodecInfo),
+};
+
 constexpr std::array<vk::DescriptorSetLayoutBinding, 2> TWO_TEXTURES_BINDINGS = {{
     {0, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment},
     {1, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment},
@@ -185,23 +208,38 @@ BlitHelper::BlitHelper(const Instance& instance_, Scheduler& scheduler_,
       compute_provider{instance, scheduler.GetMasterSemaphore(), COMPUTE_BINDINGS},
       compute_buffer_provider{instance, scheduler.GetMasterSemaphore(), COMPUTE_BUFFER_BINDINGS},
       two_textures_provider{instance, scheduler.GetMasterSemaphore(), TWO_TEXTURES_BINDINGS, 16},
+      texture_codec_provider{instance, scheduler.GetMasterSemaphore(), TEXTURE_CODEC_BINDINGS},
       compute_pipeline_layout{
           device.createPipelineLayout(PipelineLayoutCreateInfo(&compute_provider.Layout(), true))},
       compute_buffer_pipeline_layout{device.createPipelineLayout(
           PipelineLayoutCreateInfo(&compute_buffer_provider.Layout(), true))},
       two_textures_pipeline_layout{
           device.createPipelineLayout(PipelineLayoutCreateInfo(&two_textures_provider.Layout()))},
+      texture_codec_pipeline_layout{device.createPipelineLayout(vk::PipelineLayoutCreateInfo{
+          .setLayoutCount = 1,
+          .pSetLayouts = &texture_codec_provider.Layout(),
+          .pushConstantRangeCount = 1,
+          .pPushConstantRanges = &TEXTURE_CODEC_PUSH_CONSTANT_RANGE,
+      })},
       full_screen_vert{Compile(HostShaders::FULL_SCREEN_TRIANGLE_VERT,
                                vk::ShaderStageFlagBits::eVertex, device)},
       d24s8_to_rgba8_comp{Compile(HostShaders::VULKAN_D24S8_TO_RGBA8_COMP,
                                   vk::ShaderStageFlagBits::eCompute, device)},
       depth_to_buffer_comp{Compile(HostShaders::VULKAN_DEPTH_TO_BUFFER_COMP,
                                    vk::ShaderStageFlagBits::eCompute, device)},
+      texture_decode_comp{Compile(HostShaders::VULKAN_TEXTURE_DECODE_COMP,
+                                  vk::ShaderStageFlagBits::eCompute, device)},
+      texture_encode_comp{Compile(HostShaders::VULKAN_TEXTURE_ENCODE_COMP,
+                                  vk::ShaderStageFlagBits::eCompute, device)},
       blit_depth_stencil_frag{Compile(HostShaders::VULKAN_BLIT_DEPTH_STENCIL_FRAG,
                                       vk::ShaderStageFlagBits::eFragment, device)},
       d24s8_to_rgba8_pipeline{MakeComputePipeline(d24s8_to_rgba8_comp, compute_pipeline_layout)},
       depth_to_buffer_pipeline{
           MakeComputePipeline(depth_to_buffer_comp, compute_buffer_pipeline_layout)},
+      texture_decode_pipeline{
+          MakeComputePipeline(texture_decode_comp, texture_codec_pipeline_layout)},
+      texture_encode_pipeline{
+          MakeComputePipeline(texture_encode_comp, texture_codec_pipeline_layout)},
       depth_blit_pipeline{MakeDepthStencilBlitPipeline()},
       linear_sampler{device.createSampler(SAMPLER_CREATE_INFO<vk::Filter::eLinear>)},
       nearest_sampler{device.createSampler(SAMPLER_CREATE_INFO<vk::Filter::eNearest>)} {
@@ -212,12 +250,18 @@ BlitHelper::BlitHelper(const Instance& instance_, Scheduler& scheduler_,
                       "BlitHelper: compute_buffer_pipeline_layout");
         SetObjectName(device, two_textures_pipeline_layout,
                       "BlitHelper: two_textures_pipeline_layout");
+        SetObjectName(device, texture_codec_pipeline_layout,
+                      "BlitHelper: texture_codec_pipeline_layout");
         SetObjectName(device, full_screen_vert, "BlitHelper: full_screen_vert");
         SetObjectName(device, d24s8_to_rgba8_comp, "BlitHelper: d24s8_to_rgba8_comp");
         SetObjectName(device, depth_to_buffer_comp, "BlitHelper: depth_to_buffer_comp");
+        SetObjectName(device, texture_decode_comp, "BlitHelper: texture_decode_comp");
+        SetObjectName(device, texture_encode_comp, "BlitHelper: texture_encode_comp");
         SetObjectName(device, blit_depth_stencil_frag, "BlitHelper: blit_depth_stencil_frag");
         SetObjectName(device, d24s8_to_rgba8_pipeline, "BlitHelper: d24s8_to_rgba8_pipeline");
         SetObjectName(device, depth_to_buffer_pipeline, "BlitHelper: depth_to_buffer_pipeline");
+        SetObjectName(device, texture_decode_pipeline, "BlitHelper: texture_decode_pipeline");
+        SetObjectName(device, texture_encode_pipeline, "BlitHelper: texture_encode_pipeline");
         if (depth_blit_pipeline) {
             SetObjectName(device, depth_blit_pipeline, "BlitHelper: depth_blit_pipeline");
         }
@@ -230,12 +274,17 @@ BlitHelper::~BlitHelper() {
     device.destroyPipelineLayout(compute_pipeline_layout);
     device.destroyPipelineLayout(compute_buffer_pipeline_layout);
     device.destroyPipelineLayout(two_textures_pipeline_layout);
+    device.destroyPipelineLayout(texture_codec_pipeline_layout);
     device.destroyShaderModule(full_screen_vert);
     device.destroyShaderModule(d24s8_to_rgba8_comp);
     device.destroyShaderModule(depth_to_buffer_comp);
+    device.destroyShaderModule(texture_decode_comp);
+    device.destroyShaderModule(texture_encode_comp);
     device.destroyShaderModule(blit_depth_stencil_frag);
     device.destroyPipeline(depth_to_buffer_pipeline);
     device.destroyPipeline(d24s8_to_rgba8_pipeline);
+    device.destroyPipeline(texture_decode_pipeline);
+    device.destroyPipeline(texture_encode_pipeline);
     device.destroyPipeline(depth_blit_pipeline);
     device.destroySampler(linear_sampler);
     device.destroySampler(nearest_sampler);
@@ -498,6 +547,108 @@ bool BlitHelper::DepthToBuffer(Surface& source, vk::Buffer buffer,
     return true;
 }
 
+void BlitHelper::DecodeTexture(const VideoCore::SurfaceParams& params, bool convert,
+                               vk::Buffer source, u32 source_offset, u32 source_size,
+                               vk::Buffer dest, u32 dest_offset, u32 dest_size) {
+    // One invocation decodes one pixel.
+    const vk::Extent2D groups = {(params.width + 7) / 8, (params.height + 7) / 8};
+    RecordTextureCodec(texture_decode_pipeline, groups, params, convert, source, source_offset,
+                       source_size, dest, dest_offset, dest_size);
+
+    scheduler.Record([dest, dest_offset, dest_size](vk::CommandBuffer cmdbuf) {
+        const vk::BufferMemoryBarrier post_barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+            .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = dest,
+            .offset = dest_offset,
+            .size = dest_size,
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                               vk::PipelineStageFlagBits::eTransfer,
+                               vk::DependencyFlagBits::eByRegion, {}, post_barrier, {});
+    });
+}
+
+void BlitHelper::EncodeTexture(const VideoCore::SurfaceParams& params, bool convert,
+                               vk::Buffer source, u32 source_offset, u32 source_size,
+                               vk::Buffer dest, u32 dest_offset, u32 dest_size) {
+    renderpass_cache.EndRendering();
+    scheduler.Record([source, source_offset, source_size](vk::CommandBuffer cmdbuf) {
+        const vk::BufferMemoryBarrier pre_barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .dstAccessMask = vk::AccessFlagBits::eShaderRead,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = source,
+            .offset = source_offset,
+            .size = source_size,
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                               vk::PipelineStageFlagBits::eComputeShader,
+                               vk::DependencyFlagBits::eByRegion, {}, pre_barrier, {});
+    });
+
+    // One invocation encodes a 2x2 block of pixels, which are consecutive in the tiled layout.
+    const vk::Extent2D groups = {(params.width + 15) / 16, (params.height + 15) / 16};
+    RecordTextureCodec(texture_encode_pipeline, groups, params, convert, source, source_offset,
+                       source_size, dest, dest_offset, dest_size);
+
+    scheduler.Record([dest, dest_offset, dest_size](vk::CommandBuffer cmdbuf) {
+        const vk::BufferMemoryBarrier post_barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+            .dstAccessMask = vk::AccessFlagBits::eHostRead,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = dest,
+            .offset = dest_offset,
+            .size = dest_size,
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                               vk::PipelineStageFlagBits::eHost, {}, {}, post_barrier, {});
+    });
+}
+
+void BlitHelper::RecordTextureCodec(vk::Pipeline pipeline, vk::Extent2D groups,
+                                    const VideoCore::SurfaceParams& params, bool convert,
+                                    vk::Buffer source, u32 source_offset, u32 source_size,
+                                    vk::Buffer dest, u32 dest_offset, u32 dest_size) {
+    // Storage buffers can only be bound at aligned offsets, the shader adds the remainder.
+    const u32 alignment = static_cast<u32>(instance.StorageMinAlignment());
+    const u32 bound_source_offset = Common::AlignDown(source_offset, alignment);
+    const u32 bound_dest_offset = Common::AlignDown(dest_offset, alignment);
+    ASSERT((source_offset - bound_source_offset) % 4 == 0 &&
+           (dest_offset - bound_dest_offset) % 4 == 0);
+
+    const auto descriptor_set = texture_codec_provider.Commit();
+    update_queue.AddBuffer(descriptor_set, 0, source, bound_source_offset,
+                           source_offset - bound_source_offset + source_size,
+                           vk::DescriptorType::eStorageBuffer);
+    update_queue.AddBuffer(descriptor_set, 1, dest, bound_dest_offset,
+                           dest_offset - bound_dest_offset + dest_size,
+                           vk::DescriptorType::eStorageBuffer);
+
+    const TextureCodecInfo info = {
+        .format = static_cast<u32>(params.pixel_format),
+        .converted = convert,
+        .width = params.width,
+        .height = params.height,
+        .src_offset = (source_offset - bound_source_offset) / 4,
+        .dst_offset = (dest_offset - bound_dest_offset) / 4,
+    };
+
+    renderpass_cache.EndRendering();
+    scheduler.Record([this, pipeline, groups, descriptor_set, info](vk::CommandBuffer cmdbuf) {
+        cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eCompute, texture_codec_pipeline_layout,
+                                  0, descriptor_set, {});
+        cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline);
+        cmdbuf.pushConstants(texture_codec_pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0,
+                             sizeof(info), &info);
+        cmdbuf.dispatch(groups.width, groups.height, 1);
+    });
+}
+
 vk::Pipeline BlitHelper::MakeComputePipeline(vk::ShaderModule shader, vk::PipelineLayout layout) {
     const vk::ComputePipelineCreateInfo compute_info = {
         .stage = MakeStages(shader),
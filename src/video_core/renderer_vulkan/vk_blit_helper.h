@@ -10,6 +10,7 @@ namespace VideoCore {
 struct TextureBlit;
 struct TextureCopy;
 struct BufferTextureCopy;
+class SurfaceParams;
 } // namespace VideoCore
 
 namespace Vulkan {
@@ -35,10 +36,28 @@ public:
     bool DepthToBuffer(Surface& source, vk::Buffer buffer,
                        const VideoCore::BufferTextureCopy& copy);
 
+    /// Untiles and decodes the raw guest texture data in source into the linear layout and
+    /// format the surface is uploaded from.
+    void DecodeTexture(const VideoCore::SurfaceParams& params, bool convert, vk::Buffer source,
+                       u32 source_offset, u32 source_size, vk::Buffer dest, u32 dest_offset,
+                       u32 dest_size);
+
+    /// Encodes the linear pixel data downloaded to source into the tiled guest layout, which
+    /// the host can read from dest once the work has completed.
+    void EncodeTexture(const VideoCore::SurfaceParams& params, bool convert, vk::Buffer source,
+                       u32 source_offset, u32 source_size, vk::Buffer dest, u32 dest_offset,
+                       u32 dest_size);
+
 private:
     vk::Pipeline MakeComputePipeline(vk::ShaderModule shader, vk::PipelineLayout layout);
     vk::Pipeline MakeDepthStencilBlitPipeline();
 
+    /// Records a dispatch of one of the texture codec pipelines
+    void RecordTextureCodec(vk::Pipeline pipeline, vk::Extent2D groups,
+                            const VideoCore::SurfaceParams& params, bool convert,
+                            vk::Buffer source, u32 source_offset, u32 source_size,
+                            vk::Buffer dest, u32 dest_offset, u32 dest_size);
+
 private:
     const Instance& instance;
     Scheduler& scheduler;
@@ -51,17 +70,23 @@ private:
     DescriptorHeap compute_provider;
     DescriptorHeap compute_buffer_provider;
     DescriptorHeap two_textures_provider;
+    DescriptorHeap texture_codec_provider;
     vk::PipelineLayout compute_pipeline_layout;
     vk::PipelineLayout compute_buffer_pipeline_layout;
     vk::PipelineLayout two_textures_pipeline_layout;
+    vk::PipelineLayout texture_codec_pipeline_layout;
 
     vk::ShaderModule full_screen_vert;
     vk::ShaderModule d24s8_to_rgba8_comp;
     vk::ShaderModule depth_to_buffer_comp;
+    vk::ShaderModule texture_decode_comp;
+    vk::ShaderModule texture_encode_comp;
     vk::ShaderModule blit_depth_stencil_frag;
 
     vk::Pipeline d24s8_to_rgba8_pipeline;
     vk::Pipeline depth_to_buffer_pipeline;
+    vk::Pipeline texture_decode_pipeline;
+    vk::Pipeline texture_encode_pipeline;
     vk::Pipeline depth_blit_pipeline;
     vk::Sampler linear_sampler;
     vk::Sampler nearest_sampler;
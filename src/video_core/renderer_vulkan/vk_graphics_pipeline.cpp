@@ -40,7 +40,7 @@ u64 PipelineInfo::Hash(const Instance& instance) const {
 
     append_hash(vertex_layout);
     append_hash(attachments);
-    append_hash(blending);
+    info_hash = Common::HashCombine(info_hash, BlendingHash(instance));
 
     if (!instance.IsExtendedDynamicStateSupported()) {
         append_hash(rasterization);
@@ -50,6 +50,30 @@ u64 PipelineInfo::Hash(const Instance& instance) const {
     return info_hash;
 }
 
+u64 PipelineInfo::BlendingHash(const Instance& instance) const {
+    const bool dynamic_blend = instance.IsDynamicColorBlendSupported();
+    const bool dynamic_logic_op = instance.IsDynamicLogicOpSupported();
+    u64 blending_hash = 0;
+    const auto append_hash = [&blending_hash](const auto& data) {
+        const u64 data_hash = Common::ComputeStructHash64(data);
+        blending_hash = Common::HashCombine(blending_hash, data_hash);
+    };
+
+    // The logic op enable is derived from the blend enable.
+    if (!dynamic_blend || !dynamic_logic_op) {
+        append_hash(blending.blend_enable);
+    }
+    if (!dynamic_blend) {
+        append_hash(blending.color_write_mask);
+        append_hash(blending.value);
+    }
+    if (!dynamic_logic_op) {
+        append_hash(blending.logic_op);
+    }
+
+    return blending_hash;
+}
+
 Shader::Shader(const Instance& instance) : device{instance.GetDevice()} {}
 
 Shader::Shader(const Instance& instance, vk::ShaderStageFlagBits stage, std::string code)
@@ -64,12 +88,50 @@ Shader::~Shader() {
     }
 }
 
+PipelineLibraryCache::PipelineLibraryCache() = default;
+
+PipelineLibraryCache::~PipelineLibraryCache() = default;
+
+vk::Pipeline PipelineLibraryCache::Find(u64 hash) {
+    std::scoped_lock lock{mutex};
+    const auto it = libraries.find(hash);
+    if (it == libraries.end() || !it->second->IsDone()) {
+        return {};
+    }
+    return *it->second->pipeline;
+}
+
+vk::Pipeline PipelineLibraryCache::Get(u64 hash,
+                                       const std::function<vk::UniquePipeline()>& build) {
+    Library* library;
+    bool new_library;
+    {
+        std::scoped_lock lock{mutex};
+        auto [it, inserted] = libraries.try_emplace(hash);
+        if (inserted) {
+            it->second = std::make_unique<Library>();
+        }
+        library = it->second.get();
+        new_library = inserted;
+    }
+
+    if (new_library) {
+        library->pipeline = build();
+        library->MarkDone();
+    } else {
+        library->WaitDone();
+    }
+    return *library->pipeline;
+}
+
 GraphicsPipeline::GraphicsPipeline(const Instance& instance_, RenderManager& renderpass_cache_,
                                    const PipelineInfo& info_, vk::PipelineCache pipeline_cache_,
                                    vk::PipelineLayout layout_, std::array<Shader*, 3> stages_,
-                                   Common::ThreadWorker* worker_)
+                                   Common::ThreadWorker* worker_,
+                                   PipelineLibraryCache* library_cache_)
     : instance{instance_}, renderpass_cache{renderpass_cache_}, worker{worker_},
-      pipeline_layout{layout_}, pipeline_cache{pipeline_cache_}, info{info_}, stages{stages_} {}
+      library_cache{library_cache_}, pipeline_layout{layout_}, pipeline_cache{pipeline_cache_},
+      info{info_}, stages{stages_} {}
 
 GraphicsPipeline::~GraphicsPipeline() = default;
 
@@ -87,8 +149,9 @@ bool GraphicsPipeline::TryBuild(bool wait_built) {
         return false;
     }
 
-    // Ask the driver if it can give us the pipeline quickly.
-    if (!shaders_pending && instance.IsPipelineCreationCacheControlSupported() && Build(true)) {
+    // Ask the driver if it can give us the pipeline quickly, or link it from existing libraries.
+    const bool can_build_fast = instance.IsPipelineCreationCacheControlSupported() || library_cache;
+    if (!shaders_pending && can_build_fast && Build(true)) {
         return true;
     }
 
@@ -138,7 +201,9 @@ bool GraphicsPipeline::Build(bool fail_on_compile_required) {
     };
 
     const vk::PipelineInputAssemblyStateCreateInfo input_assembly = {
-        .topology = PicaToVK::PrimitiveTopology(info.rasterization.topology),
+        .topology = info.rasterization.gs_vertices_per_primitive != 0
+                        ? PicaToVK::GSInputTopology(info.rasterization.gs_vertices_per_primitive)
+                        : PicaToVK::PrimitiveTopology(info.rasterization.topology),
         .primitiveRestartEnable = false,
     };
 
@@ -197,7 +262,7 @@ bool GraphicsPipeline::Build(bool fail_on_compile_required) {
         .pScissors = &scissor,
     };
 
-    boost::container::static_vector<vk::DynamicState, 14> dynamic_states = {
+    boost::container::static_vector<vk::DynamicState, 19> dynamic_states = {
         vk::DynamicState::eViewport,           vk::DynamicState::eScissor,
         vk::DynamicState::eStencilCompareMask, vk::DynamicState::eStencilWriteMask,
         vk::DynamicState::eStencilReference,   vk::DynamicState::eBlendConstants,
@@ -213,6 +278,23 @@ bool GraphicsPipeline::Build(bool fail_on_compile_required) {
         dynamic_states.insert(dynamic_states.end(), extended.begin(), extended.end());
     }
 
+    if (instance.IsDynamicColorBlendSupported()) {
+        constexpr std::array color_blend = {
+            vk::DynamicState::eColorBlendEnableEXT,
+            vk::DynamicState::eColorBlendEquationEXT,
+            vk::DynamicState::eColorWriteMaskEXT,
+        };
+        dynamic_states.insert(dynamic_states.end(), color_blend.begin(), color_blend.end());
+    }
+
+    if (instance.IsDynamicLogicOpSupported()) {
+        constexpr std::array logic_op = {
+            vk::DynamicState::eLogicOpEXT,
+            vk::DynamicState::eLogicOpEnableEXT,
+        };
+        dynamic_states.insert(dynamic_states.end(), logic_op.begin(), logic_op.end());
+    }
+
     const vk::PipelineDynamicStateCreateInfo dynamic_info = {
         .dynamicStateCount = static_cast<u32>(dynamic_states.size()),
         .pDynamicStates = dynamic_states.data(),
@@ -267,6 +349,16 @@ bool GraphicsPipeline::Build(bool fail_on_compile_required) {
             renderpass_cache.GetRenderpass(info.attachments.color, info.attachments.depth, false),
     };
 
+    if (library_cache) {
+        if (BuildFromLibraries(pipeline_info, fail_on_compile_required)) {
+            MarkDone();
+            return true;
+        }
+        if (fail_on_compile_required && !instance.IsPipelineCreationCacheControlSupported()) {
+            return false;
+        }
+    }
+
     if (fail_on_compile_required) {
         pipeline_info.flags |= vk::PipelineCreateFlagBits::eFailOnPipelineCompileRequiredEXT;
     }
@@ -284,4 +376,147 @@ bool GraphicsPipeline::Build(bool fail_on_compile_required) {
     return true;
 }
 
+bool GraphicsPipeline::BuildFromLibraries(const vk::GraphicsPipelineCreateInfo& pipeline_info,
+                                          bool link_only) {
+    using LibraryFlags = vk::GraphicsPipelineLibraryFlagBitsEXT;
+    const vk::Device device = instance.GetDevice();
+
+    const auto create_library = [&](LibraryFlags flags,
+                                    vk::GraphicsPipelineCreateInfo create_info) {
+        const vk::GraphicsPipelineLibraryCreateInfoEXT library_info = {
+            .flags = flags,
+        };
+        create_info.pNext = &library_info;
+        create_info.flags = vk::PipelineCreateFlagBits::eLibraryKHR;
+        try {
+            auto result = device.createGraphicsPipelineUnique(pipeline_cache, create_info);
+            return std::move(result.value);
+        } catch (const vk::SystemError& err) {
+            LOG_ERROR(Render_Vulkan, "Failed to create {} pipeline library: {}",
+                      vk::to_string(flags), err.what());
+            return vk::UniquePipeline{};
+        }
+    };
+
+    // Libraries are shared between pipelines, so they are keyed by the state they contain. The
+    // rasterization and depth stencil states are dynamic with extended dynamic state.
+    const bool dynamic_state = instance.IsExtendedDynamicStateSupported();
+    const auto library_hash = [](LibraryFlags flags, auto... data) {
+        u64 hash = static_cast<u64>(flags);
+        ((hash = Common::HashCombine(hash, Common::ComputeStructHash64(data))), ...);
+        return hash;
+    };
+
+    std::array<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGES> vertex_stages;
+    u32 vertex_stage_count = 0;
+    const vk::PipelineShaderStageCreateInfo* fragment_stage = nullptr;
+    for (u32 i = 0; i < pipeline_info.stageCount; i++) {
+        const auto& stage = pipeline_info.pStages[i];
+        if (stage.stage == vk::ShaderStageFlagBits::eFragment) {
+            fragment_stage = &stage;
+        } else {
+            vertex_stages[vertex_stage_count++] = stage;
+        }
+    }
+    const std::array vertex_modules = {stages[0] ? stages[0]->Handle() : vk::ShaderModule{},
+                                       stages[2] ? stages[2]->Handle() : vk::ShaderModule{}};
+    const vk::ShaderModule fragment_module = stages[1] ? stages[1]->Handle() : vk::ShaderModule{};
+
+    const u64 pre_raster_hash =
+        dynamic_state
+            ? library_hash(LibraryFlags::ePreRasterizationShaders, vertex_modules, info.attachments)
+            : library_hash(LibraryFlags::ePreRasterizationShaders, vertex_modules, info.attachments,
+                           info.rasterization);
+    const u64 fragment_hash =
+        dynamic_state
+            ? library_hash(LibraryFlags::eFragmentShader, fragment_module, info.attachments)
+            : library_hash(LibraryFlags::eFragmentShader, fragment_module, info.attachments,
+                           info.depth_stencil);
+    const u64 vertex_input_hash =
+        dynamic_state ? library_hash(LibraryFlags::eVertexInputInterface, info.vertex_layout)
+                      : library_hash(LibraryFlags::eVertexInputInterface, info.vertex_layout,
+                                     info.rasterization);
+    const u64 fragment_output_hash =
+        library_hash(LibraryFlags::eFragmentOutputInterface, info.BlendingHash(instance),
+                     info.attachments);
+
+    // The shader libraries are where the compilation happens, so they are only looked up when the
+    // pipeline has to be ready immediately. The interface libraries are cheap to build.
+    vk::Pipeline pre_raster_library;
+    vk::Pipeline fragment_library;
+    if (link_only) {
+        pre_raster_library = library_cache->Find(pre_raster_hash);
+        fragment_library = library_cache->Find(fragment_hash);
+        if (!pre_raster_library || !fragment_library) {
+            return false;
+        }
+    } else {
+        pre_raster_library = library_cache->Get(pre_raster_hash, [&] {
+            return create_library(LibraryFlags::ePreRasterizationShaders,
+                                  {
+                                      .stageCount = vertex_stage_count,
+                                      .pStages = vertex_stages.data(),
+                                      .pViewportState = pipeline_info.pViewportState,
+                                      .pRasterizationState = pipeline_info.pRasterizationState,
+                                      .pDynamicState = pipeline_info.pDynamicState,
+                                      .layout = pipeline_info.layout,
+                                      .renderPass = pipeline_info.renderPass,
+                                  });
+        });
+        fragment_library = library_cache->Get(fragment_hash, [&] {
+            return create_library(LibraryFlags::eFragmentShader,
+                                  {
+                                      .stageCount = fragment_stage ? 1U : 0U,
+                                      .pStages = fragment_stage,
+                                      .pMultisampleState = pipeline_info.pMultisampleState,
+                                      .pDepthStencilState = pipeline_info.pDepthStencilState,
+                                      .pDynamicState = pipeline_info.pDynamicState,
+                                      .layout = pipeline_info.layout,
+                                      .renderPass = pipeline_info.renderPass,
+                                  });
+        });
+    }
+
+    const vk::Pipeline vertex_input_library = library_cache->Get(vertex_input_hash, [&] {
+        return create_library(LibraryFlags::eVertexInputInterface,
+                              {
+                                  .pVertexInputState = pipeline_info.pVertexInputState,
+                                  .pInputAssemblyState = pipeline_info.pInputAssemblyState,
+                                  .pDynamicState = pipeline_info.pDynamicState,
+                              });
+    });
+    const vk::Pipeline fragment_output_library = library_cache->Get(fragment_output_hash, [&] {
+        return create_library(LibraryFlags::eFragmentOutputInterface,
+                              {
+                                  .pMultisampleState = pipeline_info.pMultisampleState,
+                                  .pColorBlendState = pipeline_info.pColorBlendState,
+                                  .pDynamicState = pipeline_info.pDynamicState,
+                                  .renderPass = pipeline_info.renderPass,
+                              });
+    });
+
+    const std::array libraries = {vertex_input_library, pre_raster_library, fragment_library,
+                                  fragment_output_library};
+    if (std::ranges::find(libraries, vk::Pipeline{}) != libraries.end()) {
+        return false;
+    }
+
+    const vk::PipelineLibraryCreateInfoKHR link_info = {
+        .libraryCount = static_cast<u32>(libraries.size()),
+        .pLibraries = libraries.data(),
+    };
+    const vk::GraphicsPipelineCreateInfo linked_info = {
+        .pNext = &link_info,
+        .layout = pipeline_info.layout,
+    };
+    try {
+        auto result = device.createGraphicsPipelineUnique(pipeline_cache, linked_info);
+        pipeline = std::move(result.value);
+    } catch (const vk::SystemError& err) {
+        LOG_ERROR(Render_Vulkan, "Failed to link graphics pipeline: {}", err.what());
+        return false;
+    }
+    return true;
+}
+
 } // namespace Vulkan
@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <functional>
+#include <unordered_map>
+
 #include "common/thread_worker.h"
 #include "video_core/pica/regs_pipeline.h"
 #include "video_core/pica/regs_rasterizer.h"
@@ -53,6 +56,8 @@ constexpr u32 MAX_VERTEX_BINDINGS = 13;
 union RasterizationState {
     u8 value = 0;
     BitField<0, 2, Pica::PipelineRegs::TriangleTopology> topology;
+    // Vertices consumed per PICA geometry shader invocation, or zero without one.
+    BitField<2, 2, u8> gs_vertices_per_primitive;
     BitField<4, 2, Pica::RasterizerRegs::CullMode> cull_mode;
     BitField<6, 1, u8> flip_viewport;
 };
@@ -139,6 +144,9 @@ struct PipelineInfo {
 
     [[nodiscard]] u64 Hash(const Instance& instance) const;
 
+    /// Returns the hash of the blending state that is not set dynamically
+    [[nodiscard]] u64 BlendingHash(const Instance& instance) const;
+
     [[nodiscard]] bool IsDepthWriteEnabled() const noexcept {
         const bool has_stencil = attachments.depth == VideoCore::PixelFormat::D24S8;
         const bool depth_write =
@@ -164,12 +172,37 @@ struct Shader : public Common::AsyncHandle {
     std::string program;
 };
 
+/**
+ * Stores the pipeline libraries of VK_EXT_graphics_pipeline_library. Each library is built once,
+ * even when several pipelines request it from different worker threads at the same time.
+ */
+class PipelineLibraryCache {
+public:
+    PipelineLibraryCache();
+    ~PipelineLibraryCache();
+
+    /// Returns the library with the provided hash if it has been built, otherwise a null handle
+    [[nodiscard]] vk::Pipeline Find(u64 hash);
+
+    /// Returns the library with the provided hash, building it or waiting for it if needed
+    [[nodiscard]] vk::Pipeline Get(u64 hash, const std::function<vk::UniquePipeline()>& build);
+
+private:
+    struct Library : public Common::AsyncHandle {
+        vk::UniquePipeline pipeline;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<u64, std::unique_ptr<Library>> libraries;
+};
+
 class GraphicsPipeline : public Common::AsyncHandle {
 public:
     explicit GraphicsPipeline(const Instance& instance, RenderManager& renderpass_cache,
                               const PipelineInfo& info, vk::PipelineCache pipeline_cache,
                               vk::PipelineLayout layout, std::array<Shader*, 3> stages,
-                              Common::ThreadWorker* worker);
+                              Common::ThreadWorker* worker,
+                              PipelineLibraryCache* library_cache = nullptr);
     ~GraphicsPipeline();
 
     bool TryBuild(bool wait_built);
@@ -181,9 +214,17 @@ public:
     }
 
 private:
+    /**
+     * Links the pipeline from the vertex input, pre-rasterization, fragment shader and fragment
+     * output libraries of its state, building the missing ones. When link_only is set, the
+     * libraries that contain shaders are not built and false is returned if one of them is missing.
+     */
+    bool BuildFromLibraries(const vk::GraphicsPipelineCreateInfo& pipeline_info, bool link_only);
+
     const Instance& instance;
     RenderManager& renderpass_cache;
     Common::ThreadWorker* worker;
+    PipelineLibraryCache* library_cache;
 
     vk::UniquePipeline pipeline;
     vk::PipelineLayout pipeline_layout;
@@ -0,0 +1,136 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "video_core/renderer_vulkan/vk_descriptor_update_queue.h"
+#include "video_core/renderer_vulkan/vk_index_converter.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_render_manager.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_shader_util.h"
+
+#include "video_core/host_shaders/vulkan_index_u8_to_u16_comp.h"
+
+namespace Vulkan {
+
+namespace {
+
+struct ComputeInfo {
+    u32 src_offset;
+    u32 dst_offset;
+    u32 num_words;
+};
+
+constexpr u32 WORKGROUP_SIZE = 64;
+
+constexpr vk::PushConstantRange PUSH_CONSTANT_RANGE{
+    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+    .offset = 0,
+    .size = sizeof(ComputeInfo),
+};
+
+constexpr std::array<vk::DescriptorSetLayoutBinding, 2> BINDINGS = {{
+    {0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+    {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+}};
+
+vk::Pipeline MakeComputePipeline(vk::Device device, vk::ShaderModule shader,
+                                 vk::PipelineLayout layout) {
+    const vk::ComputePipelineCreateInfo compute_info = {
+        .stage =
+            {
+                .stage = vk::ShaderStageFlagBits::eCompute,
+                .module = shader,
+                .pName = "main",
+            },
+        .layout = layout,
+    };
+
+    if (const auto result = device.createComputePipeline({}, compute_info);
+        result.result == vk::Result::eSuccess) {
+        return result.value;
+    } else {
+        LOG_CRITICAL(Render_Vulkan, "Compute pipeline creation failed!");
+        UNREACHABLE();
+    }
+}
+
+} // Anonymous namespace
+
+IndexConverter::IndexConverter(const Instance& instance, Scheduler& scheduler_,
+                               RenderManager& renderpass_cache_,
+                               DescriptorUpdateQueue& update_queue_)
+    : scheduler{scheduler_}, renderpass_cache{renderpass_cache_}, update_queue{update_queue_},
+      device{instance.GetDevice()},
+      descriptor_heap{instance, scheduler.GetMasterSemaphore(), BINDINGS},
+      pipeline_layout{device.createPipelineLayout({
+          .setLayoutCount = 1,
+          .pSetLayouts = &descriptor_heap.Layout(),
+          .pushConstantRangeCount = 1,
+          .pPushConstantRanges = &PUSH_CONSTANT_RANGE,
+      })},
+      index_u8_to_u16_comp{Compile(HostShaders::VULKAN_INDEX_U8_TO_U16_COMP,
+                                   vk::ShaderStageFlagBits::eCompute, device)},
+      index_u8_to_u16_pipeline{
+          MakeComputePipeline(device, index_u8_to_u16_comp, pipeline_layout)} {
+
+    if (instance.HasDebuggingToolAttached()) {
+        SetObjectName(device, pipeline_layout, "IndexConverter: pipeline_layout");
+        SetObjectName(device, index_u8_to_u16_comp, "IndexConverter: index_u8_to_u16_comp");
+        SetObjectName(device, index_u8_to_u16_pipeline,
+                      "IndexConverter: index_u8_to_u16_pipeline");
+    }
+}
+
+IndexConverter::~IndexConverter() {
+    device.destroyPipeline(index_u8_to_u16_pipeline);
+    device.destroyShaderModule(index_u8_to_u16_comp);
+    device.destroyPipelineLayout(pipeline_layout);
+}
+
+void IndexConverter::ConvertU8ToU16(vk::Buffer source, u32 src_offset, vk::Buffer dest,
+                                    u32 dst_offset, u32 num_indices) {
+    ASSERT(src_offset % 4 == 0 && dst_offset % 4 == 0);
+
+    const auto descriptor_set = descriptor_heap.Commit();
+    update_queue.AddBuffer(descriptor_set, 0, source, 0, VK_WHOLE_SIZE,
+                           vk::DescriptorType::eStorageBuffer);
+    update_queue.AddBuffer(descriptor_set, 1, dest, 0, VK_WHOLE_SIZE,
+                           vk::DescriptorType::eStorageBuffer);
+
+    const ComputeInfo info = {
+        .src_offset = src_offset / 4,
+        .dst_offset = dst_offset / 4,
+        .num_words = (num_indices + 1) / 2,
+    };
+
+    renderpass_cache.EndRendering();
+    scheduler.Record([this, descriptor_set, info](vk::CommandBuffer cmdbuf) {
+        // Host writes are made visible by the submission, the barrier only orders the conversion
+        // after earlier draws that read the destination range.
+        const vk::MemoryBarrier pre_barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eIndexRead,
+            .dstAccessMask = vk::AccessFlagBits::eShaderWrite,
+        };
+        const vk::MemoryBarrier post_barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+            .dstAccessMask = vk::AccessFlagBits::eIndexRead,
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eVertexInput,
+                               vk::PipelineStageFlagBits::eComputeShader, {}, pre_barrier, {}, {});
+
+        cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline_layout, 0,
+                                  descriptor_set, {});
+        cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, index_u8_to_u16_pipeline);
+        cmdbuf.pushConstants(pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0,
+                             sizeof(ComputeInfo), &info);
+        cmdbuf.dispatch((info.num_words + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                               vk::PipelineStageFlagBits::eVertexInput, {}, post_barrier, {}, {});
+    });
+}
+
+} // namespace Vulkan
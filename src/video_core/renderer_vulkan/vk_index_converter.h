@@ -0,0 +1,46 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "video_core/renderer_vulkan/vk_resource_pool.h"
+
+namespace Vulkan {
+
+class Instance;
+class RenderManager;
+class Scheduler;
+class DescriptorUpdateQueue;
+
+/**
+ * Expands 8-bit index data to 16-bit indices with a compute shader, for devices that do not
+ * support VK_EXT_index_type_uint8.
+ */
+class IndexConverter {
+public:
+    explicit IndexConverter(const Instance& instance, Scheduler& scheduler,
+                            RenderManager& renderpass_cache, DescriptorUpdateQueue& update_queue);
+    ~IndexConverter();
+
+    /**
+     * Converts num_indices 8-bit indices from source to 16-bit indices in dest. Both offsets must
+     * be 4 byte aligned, and the destination is written in whole words, so it must have room for
+     * an even number of indices.
+     */
+    void ConvertU8ToU16(vk::Buffer source, u32 src_offset, vk::Buffer dest, u32 dst_offset,
+                        u32 num_indices);
+
+private:
+    Scheduler& scheduler;
+    RenderManager& renderpass_cache;
+    DescriptorUpdateQueue& update_queue;
+
+    vk::Device device;
+    DescriptorHeap descriptor_heap;
+    vk::PipelineLayout pipeline_layout;
+    vk::ShaderModule index_u8_to_u16_comp;
+    vk::Pipeline index_u8_to_u16_pipeline;
+};
+
+} // namespace Vulkan
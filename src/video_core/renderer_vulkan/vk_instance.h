@@ -93,6 +93,19 @@ public:
         return present_queue;
     }
 
+    /// Returns true when a queue family without graphics support can run transfers on its own.
+    bool HasDedicatedTransferQueue() const {
+        return dedicated_transfer_queue;
+    }
+
+    u32 GetTransferQueueFamilyIndex() const {
+        return transfer_queue_family_index;
+    }
+
+    vk::Queue GetTransferQueue() const {
+        return transfer_queue;
+    }
+
     /// Returns true when a known debugging tool is attached.
     bool HasDebuggingToolAttached() const {
         return has_renderdoc || has_nsight_graphics;
@@ -133,6 +146,19 @@ public:
         return extended_dynamic_state;
     }
 
+    /// Returns true when the blend enable, equations and color write mask can be set dynamically
+    /// with VK_EXT_extended_dynamic_state3
+    bool IsDynamicColorBlendSupported() const {
+        return extended_dynamic_state3_blend_enable && extended_dynamic_state3_blend_equation &&
+               extended_dynamic_state3_color_write_mask;
+    }
+
+    /// Returns true when the logic op and its enable can be set dynamically with
+    /// VK_EXT_extended_dynamic_state2 and VK_EXT_extended_dynamic_state3
+    bool IsDynamicLogicOpSupported() const {
+        return extended_dynamic_state2_logic_op && extended_dynamic_state3_logic_op_enable;
+    }
+
     /// Returns true when VK_EXT_custom_border_color is supported
     bool IsCustomBorderColorSupported() const {
         return custom_border_color;
@@ -168,11 +194,31 @@ public:
         return external_memory_host;
     }
 
+    /// Returns true when VK_EXT_memory_budget is supported
+    bool IsMemoryBudgetSupported() const {
+        return memory_budget;
+    }
+
+    /// Returns true when VK_KHR_push_descriptor is supported
+    bool IsPushDescriptorSupported() const {
+        return push_descriptor;
+    }
+
+    /// Returns true when VK_KHR_present_id and VK_KHR_present_wait are supported
+    bool IsPresentWaitSupported() const {
+        return present_id && present_wait;
+    }
+
     /// Returns true when VK_KHR_fragment_shader_barycentric is supported
     bool IsFragmentShaderBarycentricSupported() const {
         return fragment_shader_barycentric;
     }
 
+    /// Returns true when VK_EXT_graphics_pipeline_library is supported with fast linking
+    bool IsGraphicsPipelineLibrarySupported() const {
+        return graphics_pipeline_library && graphics_pipeline_library_fast_linking;
+    }
+
     /// Returns the vendor ID of the physical device
     u32 GetVendorID() const {
         return properties.vendorID;
@@ -223,6 +269,11 @@ public:
         return properties.limits.minUniformBufferOffsetAlignment;
     }
 
+    /// Returns the minimum required alignment for storage buffers
+    vk::DeviceSize StorageMinAlignment() const {
+        return properties.limits.minStorageBufferOffsetAlignment;
+    }
+
     /// Returns the minimum alignemt required for accessing host-mapped device memory
     vk::DeviceSize NonCoherentAtomSize() const {
         return properties.limits.nonCoherentAtomSize;
@@ -301,6 +352,7 @@ private:
     VmaAllocator allocator{};
     vk::Queue present_queue;
     vk::Queue graphics_queue;
+    vk::Queue transfer_queue;
     std::vector<vk::PhysicalDevice> physical_devices;
     FormatTraits null_traits;
     std::array<FormatTraits, VideoCore::PIXEL_FORMAT_COUNT> format_table;
@@ -308,21 +360,34 @@ private:
     std::array<FormatTraits, 16> attrib_table;
     std::vector<std::string> available_extensions;
     u32 queue_family_index{0};
+    u32 transfer_queue_family_index{0};
+    bool dedicated_transfer_queue{};
     bool triangle_fan_supported{true};
     bool image_view_reinterpretation{true};
     u32 min_vertex_stride_alignment{1};
     bool timeline_semaphores{};
     bool extended_dynamic_state{};
+    bool extended_dynamic_state2_logic_op{};
+    bool extended_dynamic_state3_blend_enable{};
+    bool extended_dynamic_state3_blend_equation{};
+    bool extended_dynamic_state3_color_write_mask{};
+    bool extended_dynamic_state3_logic_op_enable{};
     bool custom_border_color{};
     bool index_type_uint8{};
     bool fragment_shader_interlock{};
     bool image_format_list{};
     bool pipeline_creation_cache_control{};
     bool fragment_shader_barycentric{};
+    bool graphics_pipeline_library{};
+    bool graphics_pipeline_library_fast_linking{};
     bool shader_stencil_export{};
     bool external_memory_host{};
     u64 min_imported_host_pointer_alignment{};
     bool tooling_info{};
+    bool memory_budget{};
+    bool push_descriptor{};
+    bool present_id{};
+    bool present_wait{};
     bool debug_utils_supported{};
     bool has_nsight_graphics{};
     bool has_renderdoc{};
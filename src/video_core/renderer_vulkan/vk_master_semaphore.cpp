@@ -10,7 +10,8 @@ namespace Vulkan {
 
 constexpr u64 WAIT_TIMEOUT = std::numeric_limits<u64>::max();
 
-MasterSemaphoreTimeline::MasterSemaphoreTimeline(const Instance& instance_) : instance{instance_} {
+MasterSemaphoreTimeline::MasterSemaphoreTimeline(const Instance& instance_, vk::Queue queue_)
+    : instance{instance_}, queue{queue_} {
     const vk::StructureChain semaphore_chain = {
         vk::SemaphoreCreateInfo{},
         vk::SemaphoreTypeCreateInfoKHR{
@@ -61,20 +62,29 @@ void MasterSemaphoreTimeline::Wait(u64 tick) {
 }
 
 void MasterSemaphoreTimeline::SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait,
-                                         vk::Semaphore signal, u64 signal_value) {
+                                         vk::Semaphore signal, u64 signal_value,
+                                         vk::Semaphore timeline_wait, u64 timeline_wait_value) {
     cmdbuf.end();
 
     const u32 num_signal_semaphores = signal ? 2U : 1U;
     const std::array signal_values{signal_value, u64(0)};
     const std::array signal_semaphores{Handle(), signal};
 
-    const u32 num_wait_semaphores = wait ? 1U : 0U;
-    const std::array wait_values{u64(1)};
-    const std::array wait_semaphores{wait};
+    u32 num_wait_semaphores = 0;
+    std::array<u64, 2> wait_values{};
+    std::array<vk::Semaphore, 2> wait_semaphores{};
+    if (wait) {
+        wait_values[num_wait_semaphores] = 1;
+        wait_semaphores[num_wait_semaphores++] = wait;
+    }
+    if (timeline_wait) {
+        wait_values[num_wait_semaphores] = timeline_wait_value;
+        wait_semaphores[num_wait_semaphores++] = timeline_wait;
+    }
 
     static constexpr std::array<vk::PipelineStageFlags, 2> wait_stage_masks = {
         vk::PipelineStageFlagBits::eAllCommands,
-        vk::PipelineStageFlagBits::eColorAttachmentOutput,
+        vk::PipelineStageFlagBits::eAllCommands,
     };
 
     const vk::TimelineSemaphoreSubmitInfoKHR timeline_si = {
@@ -96,7 +106,7 @@ void MasterSemaphoreTimeline::SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore
     };
 
     try {
-        instance.GetGraphicsQueue().submit(submit_info);
+        queue.submit(submit_info);
     } catch (vk::DeviceLostError& err) {
         UNREACHABLE_MSG("Device lost during submit: {}", err.what());
     }
@@ -125,7 +135,9 @@ void MasterSemaphoreFence::Wait(u64 tick) {
 }
 
 void MasterSemaphoreFence::SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait,
-                                      vk::Semaphore signal, u64 signal_value) {
+                                      vk::Semaphore signal, u64 signal_value,
+                                      vk::Semaphore timeline_wait, u64 timeline_wait_value) {
+    ASSERT_MSG(!timeline_wait, "Timeline waits need timeline semaphore support");
     cmdbuf.end();
 
     const u32 num_signal_semaphores = signal ? 1U : 0U;
@@ -41,9 +41,13 @@ public:
     /// Waits for a tick to be hit on the GPU
     virtual void Wait(u64 tick) = 0;
 
-    /// Submits the provided command buffer for execution
+    /**
+     * Submits the provided command buffer for execution. When timeline_wait is provided the
+     * submission also waits for that timeline semaphore to reach timeline_wait_value.
+     */
     virtual void SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait, vk::Semaphore signal,
-                            u64 signal_value) = 0;
+                            u64 signal_value, vk::Semaphore timeline_wait = {},
+                            u64 timeline_wait_value = 0) = 0;
 
 protected:
     std::atomic<u64> gpu_tick{0};     ///< Current known GPU tick.
@@ -52,7 +56,7 @@ protected:
 
 class MasterSemaphoreTimeline : public MasterSemaphore {
 public:
-    explicit MasterSemaphoreTimeline(const Instance& instance);
+    explicit MasterSemaphoreTimeline(const Instance& instance, vk::Queue queue);
     ~MasterSemaphoreTimeline() override;
 
     [[nodiscard]] vk::Semaphore Handle() const noexcept {
@@ -64,10 +68,12 @@ public:
     void Wait(u64 tick) override;
 
     void SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait, vk::Semaphore signal,
-                    u64 signal_value) override;
+                    u64 signal_value, vk::Semaphore timeline_wait = {},
+                    u64 timeline_wait_value = 0) override;
 
 private:
     const Instance& instance;
+    vk::Queue queue;               ///< Queue the work is submitted to.
     vk::UniqueSemaphore semaphore; ///< Timeline semaphore.
 };
 
@@ -83,7 +89,8 @@ public:
     void Wait(u64 tick) override;
 
     void SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait, vk::Semaphore signal,
-                    u64 signal_value) override;
+                    u64 signal_value, vk::Semaphore timeline_wait = {},
+                    u64 timeline_wait_value = 0) override;
 
 private:
     void WaitThread(std::stop_token token);
@@ -2,12 +2,16 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <bit>
+#include <cstring>
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_paths.h"
 #include "common/file_util.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/scm_rev.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -26,6 +30,7 @@
 
 using namespace Pica::Shader::Generator;
 using Pica::Shader::FSConfig;
+using Pica::Shader::Generator::FSUberUniformData;
 
 MICROPROFILE_DEFINE(Vulkan_Bind, "Vulkan", "Pipeline Bind", MP_RGB(192, 32, 32));
 
@@ -56,7 +61,65 @@ AttribLoadFlags MakeAttribLoadFlag(Pica::PipelineRegs::VertexAttributeFormat for
     }
 }
 
-constexpr std::array<vk::DescriptorSetLayoutBinding, 6> BUFFER_BINDINGS = {{
+namespace {
+
+/**
+ * The pipeline key list records the shader configs and pipeline state of every pipeline a title
+ * has used. Unlike the driver pipeline cache it does not depend on the GPU, so it can be moved
+ * between devices, and it is replayed on boot to build the pipelines before they are needed.
+ * The header is followed by records, each carrying the hash of its payload so that corrupted
+ * entries are skipped individually.
+ */
+struct PipelineKeysHeader {
+    u32 magic;
+    u32 version;
+    u64 shader_cache_version;
+    u32 fs_config_size;
+    u32 gs_config_size;
+    u32 pipeline_info_size;
+    u32 reserved;
+};
+
+constexpr u32 PipelineKeysMagic = 0x4B505056; // "VPPK"
+constexpr u32 PipelineKeysVersion = 1;
+
+enum class PipelineKeyKind : u32 {
+    VertexProgram = 0,
+    Pipeline = 1,
+};
+
+struct PipelineKeyRecord {
+    PipelineKeyKind kind;
+    u32 size;
+    u64 hash;
+};
+
+struct PipelineKey {
+    std::array<u64, MAX_SHADER_STAGES> shader_hashes;
+    u64 vertex_program_hash; ///< Hash of the programmable vertex program, or 0 if trivial
+    u32 has_geometry_shader;
+    u32 reserved;
+    std::array<u8, sizeof(PicaFixedGSConfig)> gs_config;
+    std::array<u8, sizeof(FSConfig)> fs_config;
+    PipelineInfo info;
+};
+static_assert(std::is_trivially_copyable_v<PipelineKey>);
+
+PipelineKeysHeader MakePipelineKeysHeader() {
+    PipelineKeysHeader header{};
+    header.magic = PipelineKeysMagic;
+    header.version = PipelineKeysVersion;
+    header.shader_cache_version = Common::ComputeHash64(
+        Common::g_shader_cache_version, std::strlen(Common::g_shader_cache_version));
+    header.fs_config_size = sizeof(FSConfig);
+    header.gs_config_size = sizeof(PicaFixedGSConfig);
+    header.pipeline_info_size = sizeof(PipelineInfo);
+    return header;
+}
+
+} // Anonymous namespace
+
+constexpr std::array<vk::DescriptorSetLayoutBinding, 7> BUFFER_BINDINGS = {{
     {0, vk::DescriptorType::eUniformBufferDynamic, 1, vk::ShaderStageFlagBits::eVertex},
     {1, vk::DescriptorType::eUniformBufferDynamic, 1,
      vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eGeometry},
@@ -64,6 +127,7 @@ constexpr std::array<vk::DescriptorSetLayoutBinding, 6> BUFFER_BINDINGS = {{
     {3, vk::DescriptorType::eUniformTexelBuffer, 1, vk::ShaderStageFlagBits::eFragment},
     {4, vk::DescriptorType::eUniformTexelBuffer, 1, vk::ShaderStageFlagBits::eFragment},
     {5, vk::DescriptorType::eUniformTexelBuffer, 1, vk::ShaderStageFlagBits::eFragment},
+    {6, vk::DescriptorType::eUniformBufferDynamic, 1, vk::ShaderStageFlagBits::eGeometry},
 }};
 
 template <u32 NumTex0>
@@ -83,7 +147,7 @@ constexpr std::array<vk::DescriptorSetLayoutBinding, 2> UTILITY_BINDINGS = {{
 PipelineCache::PipelineCache(const Instance& instance_, Scheduler& scheduler_,
                              RenderManager& renderpass_cache_, DescriptorUpdateQueue& update_queue_)
     : instance{instance_}, scheduler{scheduler_}, renderpass_cache{renderpass_cache_},
-      update_queue{update_queue_},
+      update_queue{update_queue_}, uber_fragment_shader{instance},
       num_worker_threads{std::max(std::thread::hardware_concurrency(), 2U) >> 1},
       workers{num_worker_threads, "Pipeline workers"},
       descriptor_heaps{
@@ -106,20 +170,61 @@ PipelineCache::PipelineCache(const Instance& instance_, Scheduler& scheduler_,
         .has_logic_op = !instance.NeedsLogicOpEmulation(),
         .is_vulkan = true,
     };
+    using Pica::Shader::SharedFragmentCache;
+    u64 driver_id = Common::HashCombine(instance.GetVendorID(), instance.GetDeviceID());
+    driver_id = Common::HashCombine(driver_id, instance.GetDriverVersion());
+    driver_id = Common::HashCombine(driver_id, SharedFragmentCache::HashProfile(profile));
+    driver_id = Common::HashCombine(driver_id, Settings::values.spirv_shader_gen.GetValue());
+    driver_id = Common::HashCombine(driver_id, Settings::values.disable_spirv_optimizer.GetValue());
+    shared_fs_cache = std::make_unique<SharedFragmentCache>("vulkan", driver_id);
+    if (instance.IsGraphicsPipelineLibrarySupported()) {
+        library_cache = std::make_unique<PipelineLibraryCache>();
+    }
     BuildLayout();
+
+    // The uber shader is only drawn with while asynchronous shader compilation is enabled.
+    use_uber_shaders = Settings::values.use_uber_shaders.GetValue() &&
+                       Settings::values.async_shader_compilation.GetValue();
+    if (use_uber_shaders) {
+        workers.QueueWork([this] {
+            uber_fragment_shader.module =
+                Compile(GLSL::GenerateUberFragmentShader(profile),
+                        vk::ShaderStageFlagBits::eFragment, instance.GetDevice());
+            uber_fragment_shader.MarkDone();
+        });
+    }
 }
 
 void PipelineCache::BuildLayout() {
+    // Pushing the textures with each pipeline bind avoids allocating and writing descriptor sets
+    // for the binding that changes the most between draws.
+    if (instance.IsPushDescriptorSupported()) {
+        const vk::DescriptorSetLayoutCreateInfo push_layout_info = {
+            .flags = vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR,
+            .bindingCount = static_cast<u32>(TEXTURE_BINDINGS<1>.size()),
+            .pBindings = TEXTURE_BINDINGS<1>.data(),
+        };
+        push_texture_layout =
+            instance.GetDevice().createDescriptorSetLayoutUnique(push_layout_info);
+    }
+
     std::array<vk::DescriptorSetLayout, NumRasterizerSets> descriptor_set_layouts;
     descriptor_set_layouts[0] = descriptor_heaps[0].Layout();
-    descriptor_set_layouts[1] = descriptor_heaps[1].Layout();
+    descriptor_set_layouts[1] =
+        UsePushDescriptors() ? *push_texture_layout : descriptor_heaps[1].Layout();
     descriptor_set_layouts[2] = descriptor_heaps[2].Layout();
 
+    const vk::PushConstantRange uber_range = {
+        .stageFlags = vk::ShaderStageFlagBits::eFragment,
+        .offset = 0,
+        .size = sizeof(FSUberUniformData),
+    };
+
     const vk::PipelineLayoutCreateInfo layout_info = {
         .setLayoutCount = NumRasterizerSets,
         .pSetLayouts = descriptor_set_layouts.data(),
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = nullptr,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &uber_range,
     };
     pipeline_layout = instance.GetDevice().createPipelineLayoutUnique(layout_info);
 }
@@ -139,7 +244,7 @@ void PipelineCache::LoadDiskCache(const std::atomic_bool& stop_loading,
         callback(VideoCore::LoadCallbackStage::Build, 0, 1);
     }
 
-    auto load_cache = [this, &cache_info, &callback](bool allow_fallback) {
+    auto load_cache = [this, &cache_info, &stop_loading, &callback](bool allow_fallback) {
         const vk::Device device = instance.GetDevice();
         try {
             pipeline_cache = device.createPipelineCacheUnique(cache_info);
@@ -157,6 +262,9 @@ void PipelineCache::LoadDiskCache(const std::atomic_bool& stop_loading,
                 }
             }
         }
+        if (pipeline_cache && Settings::values.use_disk_shader_cache) {
+            LoadPipelineKeys(stop_loading, callback);
+        }
         if (callback) {
             callback(VideoCore::LoadCallbackStage::Complete, 0, 0);
         }
@@ -211,6 +319,8 @@ void PipelineCache::LoadDiskCache(const std::atomic_bool& stop_loading,
 }
 
 void PipelineCache::SaveDiskCache() {
+    shared_fs_cache->Save();
+
     // Save Vulkan pipeline cache
     if (!Settings::values.use_disk_shader_cache || !pipeline_cache) {
         return;
@@ -254,23 +364,69 @@ bool PipelineCache::BindPipeline(const PipelineInfo& info, bool wait_built) {
     if (new_pipeline) {
         it.value() =
             std::make_unique<GraphicsPipeline>(instance, renderpass_cache, info, *pipeline_cache,
-                                               *pipeline_layout, current_shaders, &workers);
+                                               *pipeline_layout, current_shaders, &workers,
+                                               library_cache.get());
+        StorePipelineKey(info);
     }
 
-    GraphicsPipeline* const pipeline{it->second.get()};
+    // Pipelines that only differ by their fragment shader share the same fallback key.
+    const u64 fallback_hash = Common::HashCombine(
+        Common::HashCombine(shader_hashes[ProgramType::VS], shader_hashes[ProgramType::GS]),
+        info_hash);
+
+    GraphicsPipeline* pipeline{it->second.get()};
+    bool is_uber = false;
     if (!pipeline->IsDone() && !pipeline->TryBuild(wait_built)) {
-        return false;
+        // While the fragment shader of a new configuration compiles, draw with the uber shader if
+        // it supports the configuration, otherwise with the last pipeline built for the same state
+        // rather than skipping the draw.
+        if (GraphicsPipeline* uber_pipeline = GetUberPipeline(info, fallback_hash)) {
+            pipeline = uber_pipeline;
+            is_uber = true;
+        } else {
+            const auto fallback = fallback_pipelines.find(fallback_hash);
+            if (fallback == fallback_pipelines.end()) {
+                return false;
+            }
+            pipeline = fallback->second;
+        }
+    } else if (pipeline->IsDone()) {
+        fallback_pipelines.insert_or_assign(fallback_hash, pipeline);
     }
 
     const bool is_dirty = scheduler.IsStateDirty(StateFlags::Pipeline);
     const bool pipeline_dirty = (current_pipeline != pipeline) || is_dirty;
+    if (UsePushDescriptors() && (push_textures_dirty || is_dirty)) {
+        scheduler.Record([this, textures = push_textures](vk::CommandBuffer cmdbuf) {
+            std::array<vk::DescriptorImageInfo, TextureDescriptors::static_capacity> infos;
+            std::array<vk::WriteDescriptorSet, TextureDescriptors::static_capacity> writes;
+            for (std::size_t i = 0; i < textures.size(); i++) {
+                infos[i] = vk::DescriptorImageInfo{
+                    .sampler = textures[i].sampler,
+                    .imageView = textures[i].image_view,
+                    .imageLayout = vk::ImageLayout::eGeneral,
+                };
+                writes[i] = vk::WriteDescriptorSet{
+                    .dstBinding = textures[i].binding,
+                    .dstArrayElement = textures[i].array_index,
+                    .descriptorCount = 1,
+                    .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+                    .pImageInfo = &infos[i],
+                };
+            }
+            cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eGraphics, *pipeline_layout, 1,
+                                        static_cast<u32>(textures.size()), writes.data());
+        });
+        push_textures_dirty = false;
+    }
     scheduler.Record([this, is_dirty, pipeline_dirty, pipeline,
                       current_dynamic = current_info.dynamic, dynamic = info.dynamic,
                       descriptor_sets = bound_descriptor_sets, offsets = offsets,
                       current_rasterization = current_info.rasterization,
                       current_depth_stencil = current_info.depth_stencil,
-                      rasterization = info.rasterization,
-                      depth_stencil = info.depth_stencil](vk::CommandBuffer cmdbuf) {
+                      current_blending = current_info.blending,
+                      rasterization = info.rasterization, depth_stencil = info.depth_stencil,
+                      blending = info.blending](vk::CommandBuffer cmdbuf) {
         if (dynamic.viewport != current_dynamic.viewport || is_dirty) {
             const vk::Viewport vk_viewport = {
                 .x = static_cast<f32>(dynamic.viewport.left),
@@ -365,6 +521,40 @@ bool PipelineCache::BindPipeline(const PipelineInfo& info, bool wait_built) {
             }
         }
 
+        if (instance.IsDynamicColorBlendSupported()) {
+            if (blending.blend_enable != current_blending.blend_enable || is_dirty) {
+                cmdbuf.setColorBlendEnableEXT(0, vk::Bool32{blending.blend_enable});
+            }
+
+            if (blending.value != current_blending.value || is_dirty) {
+                const vk::ColorBlendEquationEXT equation = {
+                    .srcColorBlendFactor = PicaToVK::BlendFunc(blending.src_color_blend_factor),
+                    .dstColorBlendFactor = PicaToVK::BlendFunc(blending.dst_color_blend_factor),
+                    .colorBlendOp = PicaToVK::BlendEquation(blending.color_blend_eq),
+                    .srcAlphaBlendFactor = PicaToVK::BlendFunc(blending.src_alpha_blend_factor),
+                    .dstAlphaBlendFactor = PicaToVK::BlendFunc(blending.dst_alpha_blend_factor),
+                    .alphaBlendOp = PicaToVK::BlendEquation(blending.alpha_blend_eq),
+                };
+                cmdbuf.setColorBlendEquationEXT(0, equation);
+            }
+
+            if (blending.color_write_mask != current_blending.color_write_mask || is_dirty) {
+                cmdbuf.setColorWriteMaskEXT(
+                    0, static_cast<vk::ColorComponentFlags>(blending.color_write_mask));
+            }
+        }
+
+        if (instance.IsDynamicLogicOpSupported()) {
+            if (blending.logic_op != current_blending.logic_op || is_dirty) {
+                cmdbuf.setLogicOpEXT(PicaToVK::LogicOp(blending.logic_op));
+            }
+
+            if (blending.blend_enable != current_blending.blend_enable || is_dirty) {
+                cmdbuf.setLogicOpEnableEXT(!blending.blend_enable &&
+                                           !instance.NeedsLogicOpEmulation());
+            }
+        }
+
         if (pipeline_dirty) {
             if (!pipeline->IsDone()) {
                 pipeline->WaitDone();
@@ -372,10 +562,25 @@ bool PipelineCache::BindPipeline(const PipelineInfo& info, bool wait_built) {
             cmdbuf.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Handle());
         }
 
-        cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipeline_layout, 0,
-                                  descriptor_sets, offsets);
+        if (UsePushDescriptors()) {
+            // The pushed texture set sits between the buffer and utility sets.
+            cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipeline_layout, 0, 1,
+                                      &descriptor_sets[0], NumDynamicOffsets, offsets.data());
+            cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipeline_layout, 2, 1,
+                                      &descriptor_sets[2], 0, nullptr);
+        } else {
+            cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipeline_layout, 0,
+                                      descriptor_sets, offsets);
+        }
     });
 
+    if (is_uber) {
+        scheduler.Record([this, data = uber_data](vk::CommandBuffer cmdbuf) {
+            cmdbuf.pushConstants(*pipeline_layout, vk::ShaderStageFlagBits::eFragment, 0,
+                                 sizeof(data), &data);
+        });
+    }
+
     current_info = info;
     current_pipeline = pipeline;
     scheduler.MarkStateNonDirty(StateFlags::Pipeline | StateFlags::DescriptorSets);
@@ -383,14 +588,38 @@ bool PipelineCache::BindPipeline(const PipelineInfo& info, bool wait_built) {
     return true;
 }
 
+GraphicsPipeline* PipelineCache::GetUberPipeline(const PipelineInfo& info, u64 fallback_hash) {
+    if (!uber_compatible) {
+        return nullptr;
+    }
+
+    auto [it, new_pipeline] = uber_pipelines.try_emplace(fallback_hash);
+    if (new_pipeline) {
+        auto stages = current_shaders;
+        stages[ProgramType::FS] = &uber_fragment_shader;
+        it.value() = std::make_unique<GraphicsPipeline>(instance, renderpass_cache, info,
+                                                        *pipeline_cache, *pipeline_layout, stages,
+                                                        &workers, library_cache.get());
+    }
+
+    GraphicsPipeline* pipeline{it->second.get()};
+    if (!pipeline->IsDone() && !pipeline->TryBuild(false)) {
+        return nullptr;
+    }
+    return pipeline;
+}
+
 bool PipelineCache::UseProgrammableVertexShader(const Pica::RegsInternal& regs,
                                                 Pica::ShaderSetup& setup,
                                                 const VertexLayout& layout, bool accurate_mul) {
     // Enable the geometry-shader only if we are actually doing per-fragment lighting
     // and care about proper quaternions. Otherwise just use standard vertex+fragment shaders.
-    // We also don't need the geometry shader if we have the barycentric extension.
-    const bool use_geometry_shader = instance.UseGeometryShaders() && !regs.lighting.disable &&
-                                     !instance.IsFragmentShaderBarycentricSupported();
+    // We also don't need the geometry shader if we have the barycentric extension. The PICA
+    // geometry shader always needs one when it runs on the host.
+    const bool use_geometry_shader =
+        instance.UseGeometryShaders() &&
+        ((!regs.lighting.disable && !instance.IsFragmentShaderBarycentricSupported()) ||
+         regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No);
     PicaVSConfig config{regs, setup, instance.IsShaderClipDistanceSupported(), use_geometry_shader,
                         accurate_mul};
 
@@ -417,19 +646,7 @@ bool PipelineCache::UseProgrammableVertexShader(const Pica::RegsInternal& regs,
             return false;
         }
 
-        auto [iter, new_program] = programmable_vertex_cache.try_emplace(program, instance);
-        auto& shader = iter->second;
-
-        if (new_program) {
-            shader.program = std::move(program);
-            const vk::Device device = instance.GetDevice();
-            workers.QueueWork([device, &shader] {
-                shader.module = Compile(shader.program, vk::ShaderStageFlagBits::eVertex, device);
-                shader.MarkDone();
-            });
-        }
-
-        it->second = &shader;
+        it->second = &GetVertexProgramShader(std::move(program));
     }
 
     Shader* const shader{it->second};
@@ -449,6 +666,38 @@ void PipelineCache::UseTrivialVertexShader() {
     shader_hashes[ProgramType::VS] = 0;
 }
 
+bool PipelineCache::UseProgrammableGeometryShader(const Pica::RegsInternal& regs,
+                                                  Pica::ShaderSetup& setup, bool accurate_mul) {
+    if (!instance.UseGeometryShaders()) {
+        return false;
+    }
+
+    const PicaGSProgramConfig config{regs, setup, instance.IsShaderClipDistanceSupported(),
+                                     accurate_mul};
+    const auto [it, new_config] = programmable_geometry_map.try_emplace(config);
+    if (new_config) {
+        auto program = GLSL::GenerateGeometryShader(setup, config, true);
+        if (program.empty()) {
+            LOG_ERROR(Render_Vulkan, "Failed to retrieve programmable geometry shader");
+            programmable_geometry_map[config] = nullptr;
+            return false;
+        }
+
+        it->second = &GetGeometryProgramShader(std::move(program));
+    }
+
+    Shader* const shader{it->second};
+    if (!shader) {
+        return false;
+    }
+
+    current_shaders[ProgramType::GS] = shader;
+    shader_hashes[ProgramType::GS] = config.Hash();
+    current_gs_config.reset();
+
+    return true;
+}
+
 bool PipelineCache::UseFixedGeometryShader(const Pica::RegsInternal& regs) {
     if (!instance.UseGeometryShaders()) {
         UseTrivialGeometryShader();
@@ -456,19 +705,9 @@ bool PipelineCache::UseFixedGeometryShader(const Pica::RegsInternal& regs) {
     }
 
     const PicaFixedGSConfig gs_config{regs, instance.IsShaderClipDistanceSupported()};
-    auto [it, new_shader] = fixed_geometry_shaders.try_emplace(gs_config, instance);
-    auto& shader = it->second;
-
-    if (new_shader) {
-        workers.QueueWork([gs_config, device = instance.GetDevice(), &shader]() {
-            const auto code = GLSL::GenerateFixedGeometryShader(gs_config, true);
-            shader.module = Compile(code, vk::ShaderStageFlagBits::eGeometry, device);
-            shader.MarkDone();
-        });
-    }
-
-    current_shaders[ProgramType::GS] = &shader;
+    current_shaders[ProgramType::GS] = &GetGeometryShader(gs_config);
     shader_hashes[ProgramType::GS] = gs_config.Hash();
+    current_gs_config = gs_config;
 
     return true;
 }
@@ -476,31 +715,300 @@ bool PipelineCache::UseFixedGeometryShader(const Pica::RegsInternal& regs) {
 void PipelineCache::UseTrivialGeometryShader() {
     current_shaders[ProgramType::GS] = nullptr;
     shader_hashes[ProgramType::GS] = 0;
+    current_gs_config.reset();
 }
 
 void PipelineCache::UseFragmentShader(const Pica::RegsInternal& regs,
                                       const Pica::Shader::UserConfig& user) {
     const FSConfig fs_config{regs, user, profile};
+    current_shaders[ProgramType::FS] = &GetFragmentShader(fs_config);
+    shader_hashes[ProgramType::FS] = fs_config.Hash();
+    current_fs_config = fs_config;
+
+    uber_compatible = use_uber_shaders && !fs_config.UsesUberShaderIncompatibleConfig();
+    if (uber_compatible) {
+        uber_data.SetFromConfig(fs_config);
+    }
+}
+
+Shader& PipelineCache::GetVertexProgramShader(std::string&& program) {
+    auto [it, new_program] = programmable_vertex_cache.try_emplace(program, instance);
+    auto& shader = it->second;
+
+    if (new_program) {
+        shader_compiles++;
+        shader.program = std::move(program);
+        const vk::Device device = instance.GetDevice();
+        workers.QueueWork([device, &shader] {
+            shader.module = Compile(shader.program, vk::ShaderStageFlagBits::eVertex, device);
+            shader.MarkDone();
+        });
+    }
+
+    return shader;
+}
+
+Shader& PipelineCache::GetGeometryProgramShader(std::string&& program) {
+    auto [it, new_program] = programmable_geometry_cache.try_emplace(program, instance);
+    auto& shader = it->second;
+
+    if (new_program) {
+        shader_compiles++;
+        shader.program = std::move(program);
+        const vk::Device device = instance.GetDevice();
+        workers.QueueWork([device, &shader] {
+            shader.module = Compile(shader.program, vk::ShaderStageFlagBits::eGeometry, device);
+            shader.MarkDone();
+        });
+    }
+
+    return shader;
+}
+
+Shader& PipelineCache::GetGeometryShader(const PicaFixedGSConfig& gs_config) {
+    auto [it, new_shader] = fixed_geometry_shaders.try_emplace(gs_config, instance);
+    auto& shader = it->second;
+
+    if (new_shader) {
+        shader_compiles++;
+        workers.QueueWork([gs_config, device = instance.GetDevice(), &shader]() {
+            const auto code = GLSL::GenerateFixedGeometryShader(gs_config, true);
+            shader.module = Compile(code, vk::ShaderStageFlagBits::eGeometry, device);
+            shader.MarkDone();
+        });
+    }
+
+    return shader;
+}
+
+Shader& PipelineCache::GetFragmentShader(const FSConfig& fs_config) {
     const auto [it, new_shader] = fragment_shaders.try_emplace(fs_config, instance);
     auto& shader = it->second;
 
     if (new_shader) {
+        shader_compiles++;
         workers.QueueWork([fs_config, this, &shader]() {
-            const bool use_spirv = Settings::values.spirv_shader_gen.GetValue();
-            if (use_spirv && !fs_config.UsesSpirvIncompatibleConfig()) {
-                const std::vector code = SPIRV::GenerateFragmentShader(fs_config, profile);
-                shader.module = CompileSPV(code, instance.GetDevice());
+            std::vector<u32> code;
+            if (const auto blob = shared_fs_cache->Find(fs_config)) {
+                code.resize(blob->size() / sizeof(u32));
+                std::memcpy(code.data(), blob->data(), code.size() * sizeof(u32));
             } else {
-                const std::string code = GLSL::GenerateFragmentShader(fs_config, profile);
-                shader.module =
-                    Compile(code, vk::ShaderStageFlagBits::eFragment, instance.GetDevice());
+                const bool use_spirv = Settings::values.spirv_shader_gen.GetValue();
+                if (use_spirv && !fs_config.UsesSpirvIncompatibleConfig()) {
+                    code = SPIRV::GenerateFragmentShader(fs_config, profile);
+                } else {
+                    code = CompileGLSLToSPV(GLSL::GenerateFragmentShader(fs_config, profile),
+                                            vk::ShaderStageFlagBits::eFragment);
+                }
+                const auto* bytes = reinterpret_cast<const u8*>(code.data());
+                shared_fs_cache->Insert(fs_config, {bytes, bytes + code.size() * sizeof(u32)});
+            }
+            if (!code.empty()) {
+                shader.module = CompileSPV(code, instance.GetDevice());
             }
             shader.MarkDone();
         });
     }
 
-    current_shaders[ProgramType::FS] = &shader;
-    shader_hashes[ProgramType::FS] = fs_config.Hash();
+    return shader;
+}
+
+void PipelineCache::LoadPipelineKeys(const std::atomic_bool& stop_loading,
+                                     const VideoCore::DiskResourceLoadCallback& callback) {
+    pipeline_keys_file.Close();
+    stored_vertex_programs.clear();
+
+    const auto keys_file_path =
+        fmt::format("{}{:016X}.keys", GetPipelineCacheDir(), GetProgramID());
+    const PipelineKeysHeader expected_header = MakePipelineKeysHeader();
+
+    std::vector<u8> data;
+    {
+        FileUtil::IOFile keys_file{keys_file_path, "rb"};
+        if (keys_file.IsOpen()) {
+            data.resize(keys_file.GetSize());
+            if (keys_file.ReadBytes(data.data(), data.size()) != data.size()) {
+                data.clear();
+            }
+        }
+    }
+
+    PipelineKeysHeader header{};
+    if (data.size() >= sizeof(header)) {
+        std::memcpy(&header, data.data(), sizeof(header));
+    }
+    if (std::memcmp(&header, &expected_header, sizeof(header)) != 0) {
+        if (!data.empty()) {
+            LOG_WARNING(Render_Vulkan, "Pipeline key list is outdated or invalid, removing");
+        }
+        pipeline_keys_file = FileUtil::IOFile{keys_file_path, "wb"};
+        if (!pipeline_keys_file.IsOpen() || pipeline_keys_file.WriteObject(expected_header) != 1) {
+            LOG_ERROR(Render_Vulkan, "Unable to create pipeline key list");
+            pipeline_keys_file.Close();
+        }
+        return;
+    }
+
+    std::unordered_map<u64, std::string> vertex_programs;
+    std::vector<PipelineKey> keys;
+    std::size_t offset = sizeof(header);
+    std::size_t num_corrupted = 0;
+    while (offset + sizeof(PipelineKeyRecord) <= data.size()) {
+        PipelineKeyRecord record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        const std::size_t payload_offset = offset + sizeof(record);
+        if (record.size > data.size() - payload_offset) {
+            break;
+        }
+        const u8* payload = data.data() + payload_offset;
+        offset = payload_offset + record.size;
+
+        if (Common::ComputeHash64(payload, record.size) != record.hash) {
+            ++num_corrupted;
+            continue;
+        }
+        if (record.kind == PipelineKeyKind::VertexProgram) {
+            vertex_programs.try_emplace(record.hash, reinterpret_cast<const char*>(payload),
+                                        record.size);
+        } else if (record.kind == PipelineKeyKind::Pipeline && record.size == sizeof(PipelineKey)) {
+            std::memcpy(&keys.emplace_back(), payload, sizeof(PipelineKey));
+        }
+    }
+
+    // Drop a record that was cut short, so that new records are appended after a valid one.
+    if (offset != data.size()) {
+        LOG_WARNING(Render_Vulkan, "Pipeline key list is truncated, dropping the last record");
+        FileUtil::IOFile keys_file{keys_file_path, "wb"};
+        keys_file.WriteBytes(data.data(), offset);
+    }
+    if (num_corrupted > 0) {
+        LOG_WARNING(Render_Vulkan, "Skipped {} corrupted pipeline key records", num_corrupted);
+    }
+    data.clear();
+
+    pipeline_keys_file = FileUtil::IOFile{keys_file_path, "ab"};
+    if (!pipeline_keys_file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Unable to open pipeline key list for writing");
+    }
+    for (const auto& [hash, program] : vertex_programs) {
+        stored_vertex_programs.insert(hash);
+    }
+
+    LOG_INFO(Render_Vulkan, "Building {} pipelines for title_id={:016X}", keys.size(),
+             GetProgramID());
+
+    // Queue the shaders and pipelines on the workers. The workers run in queue order, so every
+    // pipeline starts after the shaders it waits for.
+    std::vector<GraphicsPipeline*> pending;
+    pending.reserve(keys.size());
+    for (const PipelineKey& key : keys) {
+        if (stop_loading) {
+            return;
+        }
+
+        const auto fs_config = std::bit_cast<FSConfig>(key.fs_config);
+        if (fs_config.Hash() != key.shader_hashes[ProgramType::FS]) {
+            continue;
+        }
+        std::optional<PicaFixedGSConfig> gs_config;
+        if (key.has_geometry_shader) {
+            gs_config = std::bit_cast<PicaFixedGSConfig>(key.gs_config);
+            if (!instance.UseGeometryShaders() ||
+                gs_config->Hash() != key.shader_hashes[ProgramType::GS]) {
+                continue;
+            }
+        }
+
+        std::array<Shader*, MAX_SHADER_STAGES> shaders{};
+        shaders[ProgramType::VS] = &trivial_vertex_shader;
+        if (key.vertex_program_hash != 0) {
+            const auto program = vertex_programs.find(key.vertex_program_hash);
+            if (program == vertex_programs.end()) {
+                continue;
+            }
+            shaders[ProgramType::VS] = &GetVertexProgramShader(std::string{program->second});
+        }
+        if (gs_config) {
+            shaders[ProgramType::GS] = &GetGeometryShader(*gs_config);
+        }
+        shaders[ProgramType::FS] = &GetFragmentShader(fs_config);
+
+        u64 shader_hash = 0;
+        for (u32 i = 0; i < MAX_SHADER_STAGES; i++) {
+            shader_hash = Common::HashCombine(shader_hash, key.shader_hashes[i]);
+        }
+        const u64 pipeline_hash = Common::HashCombine(shader_hash, key.info.Hash(instance));
+
+        auto [it, new_pipeline] = graphics_pipelines.try_emplace(pipeline_hash);
+        if (!new_pipeline) {
+            continue;
+        }
+        it.value() = std::make_unique<GraphicsPipeline>(instance, renderpass_cache, key.info,
+                                                        *pipeline_cache, *pipeline_layout, shaders,
+                                                        &workers, library_cache.get());
+        it->second->TryBuild(true);
+        pending.push_back(it->second.get());
+    }
+
+    for (std::size_t i = 0; i < pending.size(); i++) {
+        if (stop_loading) {
+            return;
+        }
+        pending[i]->WaitDone();
+        if (callback) {
+            callback(VideoCore::LoadCallbackStage::Build, i + 1, pending.size());
+        }
+    }
+}
+
+void PipelineCache::StorePipelineKey(const PipelineInfo& info) {
+    if (!pipeline_keys_file.IsOpen()) {
+        return;
+    }
+    // Decompiled geometry programs are not part of the key, so the pipeline can not be rebuilt.
+    if (current_shaders[ProgramType::GS] && !current_gs_config) {
+        return;
+    }
+
+    const auto write_record = [this](PipelineKeyKind kind, const u8* payload, u32 size) {
+        const PipelineKeyRecord record{
+            .kind = kind,
+            .size = size,
+            .hash = Common::ComputeHash64(payload, size),
+        };
+        return pipeline_keys_file.WriteObject(record) == 1 &&
+               pipeline_keys_file.WriteBytes(payload, size) == size;
+    };
+
+    PipelineKey key{};
+    key.shader_hashes = shader_hashes;
+    const std::string& program = current_shaders[ProgramType::VS]->program;
+    if (!program.empty()) {
+        key.vertex_program_hash = Common::ComputeHash64(program.data(), program.size());
+        if (stored_vertex_programs.insert(key.vertex_program_hash).second &&
+            !write_record(PipelineKeyKind::VertexProgram,
+                          reinterpret_cast<const u8*>(program.data()),
+                          static_cast<u32>(program.size()))) {
+            LOG_ERROR(Render_Vulkan, "Error during pipeline key list write");
+            pipeline_keys_file.Close();
+            return;
+        }
+    }
+    if (current_gs_config) {
+        key.has_geometry_shader = 1;
+        key.gs_config = std::bit_cast<decltype(key.gs_config)>(*current_gs_config);
+    }
+    if (current_fs_config) {
+        key.fs_config = std::bit_cast<decltype(key.fs_config)>(*current_fs_config);
+    }
+    key.info = info;
+
+    if (!write_record(PipelineKeyKind::Pipeline, reinterpret_cast<const u8*>(&key),
+                      sizeof(key)) ||
+        !pipeline_keys_file.Flush()) {
+        LOG_ERROR(Render_Vulkan, "Error during pipeline key list write");
+        pipeline_keys_file.Close();
+    }
 }
 
 bool PipelineCache::IsCacheValid(std::span<const u8> data) const {
@@ -5,14 +5,21 @@
 #pragma once
 
 #include <bitset>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <boost/container/static_vector.hpp>
 #include <tsl/robin_map.h>
 
+#include "common/file_util.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
 #include "video_core/shader/generator/pica_fs_config.h"
 #include "video_core/shader/generator/profile.h"
 #include "video_core/shader/generator/shader_gen.h"
+#include "video_core/shader/generator/shader_uniforms.h"
+#include "video_core/shader/generator/shared_fs_cache.h"
 
 namespace Pica {
 struct RegsInternal;
@@ -32,13 +39,23 @@ enum class DescriptorHeapType : u32 {
     Utility,
 };
 
+struct TextureDescriptor {
+    u8 binding;
+    u8 array_index;
+    vk::ImageView image_view;
+    vk::Sampler sampler;
+
+    bool operator==(const TextureDescriptor&) const = default;
+};
+using TextureDescriptors = boost::container::static_vector<TextureDescriptor, 8>;
+
 /**
  * Stores a collection of rasterizer pipelines used during rendering.
  */
 class PipelineCache {
     static constexpr u32 NumRasterizerSets = 3;
     static constexpr u32 NumDescriptorHeaps = 3;
-    static constexpr u32 NumDynamicOffsets = 3;
+    static constexpr u32 NumDynamicOffsets = 4;
 
 public:
     explicit PipelineCache(const Instance& instance, Scheduler& scheduler,
@@ -53,9 +70,39 @@ public:
         return descriptor_set;
     }
 
-    /// Sets the dynamic offset for the uniform buffer at binding
-    void UpdateRange(u8 binding, u32 offset) {
-        offsets[binding] = offset;
+    /**
+     * Binds the descriptor set of the appropriate heap last acquired with the provided hash of
+     * its resources, or a free one. The second member is false when the set must be written.
+     */
+    std::pair<vk::DescriptorSet, bool> Acquire(DescriptorHeapType type, u64 hash) {
+        const u32 index = static_cast<u32>(type);
+        const auto result = descriptor_heaps[index].Commit(hash);
+        bound_descriptor_sets[index] = result.first;
+        return result;
+    }
+
+    /// Forgets the resources of all cached descriptor sets, used when image views are destroyed.
+    void ClearDescriptorCache() {
+        for (DescriptorHeap& heap : descriptor_heaps) {
+            heap.ClearCache();
+        }
+    }
+
+    /// Returns true when the textures are pushed with the pipeline instead of a descriptor set.
+    bool UsePushDescriptors() const {
+        return push_texture_layout.get() != VK_NULL_HANDLE;
+    }
+
+    /// Sets the textures pushed with the next pipeline bind when push descriptors are used.
+    void PushTextures(const TextureDescriptors& descriptors) {
+        push_textures = descriptors;
+        push_textures_dirty = true;
+    }
+
+    /// Sets the dynamic offset of a uniform buffer. Dynamic offsets are ordered by binding, so
+    /// the geometry shader uniforms at binding 6 use index 3.
+    void UpdateRange(u8 index, u32 offset) {
+        offsets[index] = offset;
     }
 
     /// Loads the pipeline cache stored to disk
@@ -76,6 +123,10 @@ public:
     void UseTrivialVertexShader();
 
     /// Binds a PICA decompiled geometry shader
+    bool UseProgrammableGeometryShader(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup,
+                                       bool accurate_mul);
+
+    /// Binds a geometry shader generated for the fixed PICA pipeline
     bool UseFixedGeometryShader(const Pica::RegsInternal& regs);
 
     /// Binds a passthrough geometry shader
@@ -84,6 +135,11 @@ public:
     /// Binds a fragment shader generated from PICA state
     void UseFragmentShader(const Pica::RegsInternal& regs, const Pica::Shader::UserConfig& user);
 
+    /// Returns the number of shaders queued for compilation since the last call
+    u32 GetAndResetShaderCompiles() {
+        return std::exchange(shader_compiles, 0);
+    }
+
     /// Switches the shader disk cache to the specified title
     void SwitchPipelineCache(u64 title_id,
                              const std::atomic_bool& stop_loading = std::atomic_bool{false},
@@ -102,6 +158,28 @@ private:
     /// Builds the rasterizer pipeline layout
     void BuildLayout();
 
+    /// Returns the uber shader pipeline for the current state, or nullptr if it cannot be used yet
+    GraphicsPipeline* GetUberPipeline(const PipelineInfo& info, u64 fallback_hash);
+
+    /// Returns the shader of a programmable vertex program, queueing its compilation if new
+    Shader& GetVertexProgramShader(std::string&& program);
+
+    /// Returns the shader of a programmable geometry program, queueing its compilation if new
+    Shader& GetGeometryProgramShader(std::string&& program);
+
+    /// Returns the shader of a fixed geometry shader config, queueing its compilation if new
+    Shader& GetGeometryShader(const Pica::Shader::Generator::PicaFixedGSConfig& gs_config);
+
+    /// Returns the shader of a fragment shader config, queueing its compilation if new
+    Shader& GetFragmentShader(const Pica::Shader::FSConfig& fs_config);
+
+    /// Builds the pipelines recorded in the pipeline key list of the current title
+    void LoadPipelineKeys(const std::atomic_bool& stop_loading,
+                          const VideoCore::DiskResourceLoadCallback& callback);
+
+    /// Appends the pipeline of the currently bound shaders to the pipeline key list
+    void StorePipelineKey(const PipelineInfo& info);
+
     /// Returns true when the disk data can be used by the current driver
     bool IsCacheValid(std::span<const u8> cache_data) const;
 
@@ -120,25 +198,50 @@ private:
     Pica::Shader::Profile profile{};
     vk::UniquePipelineCache pipeline_cache;
     vk::UniquePipelineLayout pipeline_layout;
+    // Declared before the workers so that it outlives the shaders they are still compiling.
+    std::unique_ptr<Pica::Shader::SharedFragmentCache> shared_fs_cache;
+    Shader uber_fragment_shader;
+    std::unique_ptr<PipelineLibraryCache> library_cache;
     std::size_t num_worker_threads;
     Common::ThreadWorker workers;
     PipelineInfo current_info{};
     GraphicsPipeline* current_pipeline{};
     tsl::robin_map<u64, std::unique_ptr<GraphicsPipeline>, Common::IdentityHash<u64>>
         graphics_pipelines;
+    // Most recently bound built pipeline of each state and vertex stage combination.
+    tsl::robin_map<u64, GraphicsPipeline*, Common::IdentityHash<u64>> fallback_pipelines;
+    // Uber shader pipelines of each state and vertex stage combination.
+    tsl::robin_map<u64, std::unique_ptr<GraphicsPipeline>, Common::IdentityHash<u64>>
+        uber_pipelines;
+    bool use_uber_shaders{};
+    bool uber_compatible{};
+    Pica::Shader::Generator::FSUberUniformData uber_data{};
     std::array<DescriptorHeap, NumDescriptorHeaps> descriptor_heaps;
     std::array<vk::DescriptorSet, NumRasterizerSets> bound_descriptor_sets{};
+    vk::UniqueDescriptorSetLayout push_texture_layout;
+    TextureDescriptors push_textures;
+    bool push_textures_dirty{};
     std::array<u32, NumDynamicOffsets> offsets{};
 
     std::array<u64, MAX_SHADER_STAGES> shader_hashes;
     std::array<Shader*, MAX_SHADER_STAGES> current_shaders;
     std::unordered_map<Pica::Shader::Generator::PicaVSConfig, Shader*> programmable_vertex_map;
     std::unordered_map<std::string, Shader> programmable_vertex_cache;
+    std::unordered_map<Pica::Shader::Generator::PicaGSProgramConfig, Shader*>
+        programmable_geometry_map;
+    std::unordered_map<std::string, Shader> programmable_geometry_cache;
     std::unordered_map<Pica::Shader::Generator::PicaFixedGSConfig, Shader> fixed_geometry_shaders;
     std::unordered_map<Pica::Shader::FSConfig, Shader> fragment_shaders;
     Shader trivial_vertex_shader;
 
+    // Configs of the bound generated shaders, written to the pipeline key list.
+    std::optional<Pica::Shader::Generator::PicaFixedGSConfig> current_gs_config;
+    std::optional<Pica::Shader::FSConfig> current_fs_config;
+    FileUtil::IOFile pipeline_keys_file;
+    std::unordered_set<u64> stored_vertex_programs;
+
     u64 current_program_id{0};
+    u32 shader_compiles{};
 };
 
 } // namespace Vulkan
@@ -0,0 +1,155 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/post_processing.h"
+#include "video_core/renderer_vulkan/vk_post_processing.h"
+
+namespace Vulkan {
+
+// The same interface as the Dolphin shader header of the OpenGL renderer, on top of the push
+// constants and screen textures of the present pipelines. The screens are sampled through
+// their index in the texture array.
+constexpr char dolphin_shader_header[] = R"(#version 450 core
+#extension GL_ARB_separate_shader_objects : enable
+
+// hlsl to glsl types
+#define float2 vec2
+#define float3 vec3
+#define float4 vec4
+#define uint2 uvec2
+#define uint3 uvec3
+#define uint4 uvec4
+#define int2 ivec2
+#define int3 ivec3
+#define int4 ivec4
+
+// hlsl to glsl function translation
+#define frac fract
+#define lerp mix
+
+// Output variable
+layout (location = 0) out float4 color;
+// Input coordinates
+layout (location = 0) in float2 frag_tex_coord;
+
+layout (push_constant, std140) uniform DrawInfo {
+    mat4 modelview_matrix;
+    vec4 i_resolution;
+    vec4 o_resolution;
+    int screen_id_l;
+    int screen_id_r;
+    int layer;
+    int reverse_interlaced;
+};
+
+layout (set = 0, binding = 0) uniform sampler2D screen_textures[3];
+
+#ifdef ARRAY_DYNAMIC_INDEX
+#define SampleScreenOffset(screen_id, offset) \
+    textureOffset(screen_textures[screen_id], frag_tex_coord, offset)
+#else
+#define SampleScreenOffset(screen_id, offset) \
+    ((screen_id) == 0 ? textureOffset(screen_textures[0], frag_tex_coord, offset) : \
+     (screen_id) == 1 ? textureOffset(screen_textures[1], frag_tex_coord, offset) : \
+                        textureOffset(screen_textures[2], frag_tex_coord, offset))
+#endif
+
+float4 SampleScreen(int screen_id, float2 location)
+{
+#ifdef ARRAY_DYNAMIC_INDEX
+    return texture(screen_textures[screen_id], location);
+#else
+    switch (screen_id) {
+    case 0:
+        return texture(screen_textures[0], location);
+    case 1:
+        return texture(screen_textures[1], location);
+    default:
+        return texture(screen_textures[2], location);
+    }
+#endif
+}
+
+// Interfacing functions
+float4 Sample()
+{
+    return SampleScreen(screen_id_l, frag_tex_coord);
+}
+
+float4 SampleLocation(float2 location)
+{
+    return SampleScreen(screen_id_l, location);
+}
+
+float4 SampleLayer(int layer)
+{
+    if(layer == 0)
+        return SampleScreen(screen_id_l, frag_tex_coord);
+    else
+        return SampleScreen(screen_id_r, frag_tex_coord);
+}
+
+#define SampleOffset(offset) SampleScreenOffset(screen_id_l, offset)
+
+float2 GetResolution()
+{
+    return i_resolution.xy;
+}
+
+float2 GetInvResolution()
+{
+    return i_resolution.zw;
+}
+
+float2 GetIResolution()
+{
+    return i_resolution.xy;
+}
+
+float2 GetIInvResolution()
+{
+    return i_resolution.zw;
+}
+
+float2 GetWindowResolution()
+{
+  return o_resolution.xy;
+}
+
+float2 GetInvWindowResolution()
+{
+  return o_resolution.zw;
+}
+
+float2 GetOResolution()
+{
+    return o_resolution.xy;
+}
+
+float2 GetOInvResolution()
+{
+    return o_resolution.zw;
+}
+
+float2 GetCoordinates()
+{
+    return frag_tex_coord;
+}
+
+void SetOutput(float4 color_in)
+{
+    color = color_in;
+}
+
+)";
+
+std::string GetPostProcessingShaderCode(bool anaglyph, std::string_view shader) {
+    const std::string shader_text = VideoCore::GetPostProcessingShaderSource(anaglyph, shader);
+    if (shader_text.empty()) {
+        return "";
+    }
+    return dolphin_shader_header + shader_text;
+}
+
+} // namespace Vulkan
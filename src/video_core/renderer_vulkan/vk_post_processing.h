@@ -0,0 +1,18 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Vulkan {
+
+// Returns the shader code for the shader named "shader_name" with the header
+// matching the present pipeline layout prepended to it, so it can replace the
+// present fragment shader
+// If the shader cannot be loaded, an empty string is returned
+std::string GetPostProcessingShaderCode(bool anaglyph, std::string_view shader_name);
+
+} // namespace Vulkan
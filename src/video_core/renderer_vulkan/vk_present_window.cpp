@@ -275,6 +275,7 @@ Frame* PresentWindow::GetRenderFrame() {
 }
 
 void PresentWindow::Present(Frame* frame) {
+    frame->queue_time = std::chrono::steady_clock::now();
     if (!use_present_thread) {
         scheduler.WaitWorker();
         CopyToSwapchain(frame);
@@ -336,6 +337,19 @@ void PresentWindow::PresentThread(std::stop_token token) {
     }
 }
 
+std::chrono::microseconds PresentWindow::GetAndResetPresentLatency() {
+    const u32 samples = present_latency_samples.exchange(0, std::memory_order_relaxed);
+    const u64 latency_us = present_latency_us.exchange(0, std::memory_order_relaxed);
+    return std::chrono::microseconds{samples ? latency_us / samples : 0};
+}
+
+void PresentWindow::AddPresentLatency(std::chrono::steady_clock::time_point queue_time) {
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - queue_time);
+    present_latency_us.fetch_add(latency.count(), std::memory_order_relaxed);
+    present_latency_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
 void PresentWindow::NotifySurfaceChanged() {
 #ifdef ANDROID
     std::scoped_lock lock{recreate_surface_mutex};
@@ -369,6 +383,13 @@ void PresentWindow::CopyToSwapchain(Frame* frame) {
     }
 #endif
 
+    // Pace presentation to the display by keeping no more than the configured number of frames
+    // queued ahead of it. A shallow queue keeps the latency from input to display low.
+    const u32 queue_depth = Settings::values.present_queue_depth.GetValue();
+    if (const auto displayed_id = swapchain.WaitForPresent(queue_depth)) {
+        AddPresentLatency(present_queue_times[*displayed_id % present_queue_times.size()]);
+    }
+
     while (!swapchain.AcquireNextImage()) {
         recreate_swapchain();
     }
@@ -483,6 +504,12 @@ void PresentWindow::CopyToSwapchain(Frame* frame) {
     }
 
     swapchain.Present();
+    if (instance.IsPresentWaitSupported()) {
+        present_queue_times[swapchain.GetPresentId() % present_queue_times.size()] =
+            frame->queue_time;
+    } else {
+        AddPresentLatency(frame->queue_time);
+    }
 }
 
 vk::RenderPass PresentWindow::CreateRenderpass() {
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -32,6 +34,7 @@ struct Frame {
     vk::Semaphore render_ready;
     vk::Fence present_done;
     vk::CommandBuffer cmdbuf;
+    std::chrono::steady_clock::time_point queue_time;
 };
 
 class PresentWindow final {
@@ -55,10 +58,21 @@ public:
     /// This is called to notify the rendering backend of a surface change
     void NotifySurfaceChanged();
 
+    /**
+     * Returns the mean time between queueing a frame and it reaching the display, or being
+     * handed to the presentation engine when that can not be observed, and resets it.
+     */
+    std::chrono::microseconds GetAndResetPresentLatency();
+
     [[nodiscard]] vk::RenderPass Renderpass() const noexcept {
         return present_renderpass;
     }
 
+    /// Returns the format of the render frames, which is the format of the swapchain.
+    [[nodiscard]] vk::Format FrameFormat() const noexcept {
+        return swapchain.GetSurfaceFormat().format;
+    }
+
     u32 ImageCount() const noexcept {
         return swapchain.GetImageCount();
     }
@@ -68,6 +82,9 @@ private:
 
     void CopyToSwapchain(Frame* frame);
 
+    /// Records the presentation latency of a frame queued at queue_time.
+    void AddPresentLatency(std::chrono::steady_clock::time_point queue_time);
+
     vk::RenderPass CreateRenderpass();
 
 private:
@@ -90,6 +107,10 @@ private:
     std::mutex recreate_surface_mutex;
     std::mutex queue_mutex;
     std::mutex free_mutex;
+    // Queue times of the last presented frames by present id, more than the deepest present queue.
+    std::array<std::chrono::steady_clock::time_point, 4> present_queue_times{};
+    std::atomic<u64> present_latency_us{};
+    std::atomic<u32> present_latency_samples{};
     std::jthread present_thread;
     bool vsync_enabled{};
     bool blit_supported;
@@ -25,6 +25,10 @@ namespace {
 MICROPROFILE_DEFINE(Vulkan_VS, "Vulkan", "Vertex Shader Setup", MP_RGB(192, 128, 128));
 MICROPROFILE_DEFINE(Vulkan_GS, "Vulkan", "Geometry Shader Setup", MP_RGB(128, 192, 128));
 MICROPROFILE_DEFINE(Vulkan_Drawing, "Vulkan", "Drawing", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Vulkan_SyncRasterState, "Vulkan", "Sync Raster State", MP_RGB(192, 128, 64));
+MICROPROFILE_DEFINE(Vulkan_SyncBlendState, "Vulkan", "Sync Blend State", MP_RGB(192, 128, 64));
+MICROPROFILE_DEFINE(Vulkan_SyncDepthStencilState, "Vulkan", "Sync Depth Stencil State",
+                    MP_RGB(192, 128, 64));
 
 using TriangleTopology = Pica::PipelineRegs::TriangleTopology;
 using VideoCore::SurfaceType;
@@ -33,11 +37,14 @@ using namespace Common::Literals;
 using namespace Pica::Shader::Generator;
 
 constexpr u64 STREAM_BUFFER_SIZE = 64_MiB;
+constexpr u64 VERTEX_CACHE_BUFFER_SIZE = 32_MiB;
+constexpr u64 INDEX_CACHE_BUFFER_SIZE = 16_MiB;
 constexpr u64 UNIFORM_BUFFER_SIZE = 8_MiB;
 constexpr u64 TEXTURE_BUFFER_SIZE = 2_MiB;
 
 constexpr vk::BufferUsageFlags BUFFER_USAGE =
-    vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer;
+    vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer |
+    vk::BufferUsageFlagBits::eStorageBuffer;
 
 struct DrawParams {
     u32 vertex_count;
@@ -45,6 +52,9 @@ struct DrawParams {
     u32 binding_count;
     std::array<u32, 16> bindings;
     bool is_indexed;
+    vk::Buffer index_buffer;
+    u32 index_offset;
+    vk::IndexType index_type;
 };
 
 [[nodiscard]] u64 TextureBufferSize(const Instance& instance) {
@@ -67,7 +77,19 @@ RasterizerVulkan::RasterizerVulkan(Memory::MemorySystem& memory, Pica::PicaCore&
       pipeline_cache{instance, scheduler, renderpass_cache, update_queue},
       runtime{instance, scheduler, renderpass_cache, update_queue, image_count},
       res_cache{memory, custom_tex_manager, runtime, regs, renderer},
+      index_converter{instance, scheduler, renderpass_cache, update_queue},
+      vertex_buffer_cache{[this](PAddr addr, u32 size, int delta) {
+          res_cache.UpdatePagesCachedCount(addr, size, delta);
+      }},
+      index_buffer_cache_u8{[this](PAddr addr, u32 size, int delta) {
+          res_cache.UpdatePagesCachedCount(addr, size, delta);
+      }},
+      index_buffer_cache_u16{[this](PAddr addr, u32 size, int delta) {
+          res_cache.UpdatePagesCachedCount(addr, size, delta);
+      }},
       stream_buffer{instance, scheduler, BUFFER_USAGE, STREAM_BUFFER_SIZE},
+      vertex_cache_buffer{instance, scheduler, BUFFER_USAGE, VERTEX_CACHE_BUFFER_SIZE},
+      index_cache_buffer{instance, scheduler, BUFFER_USAGE, INDEX_CACHE_BUFFER_SIZE},
       uniform_buffer{instance, scheduler, vk::BufferUsageFlagBits::eUniformBuffer,
                      UNIFORM_BUFFER_SIZE},
       texture_buffer{instance, scheduler, vk::BufferUsageFlagBits::eUniformTexelBuffer,
@@ -119,15 +141,24 @@ RasterizerVulkan::RasterizerVulkan(Memory::MemorySystem& memory, Pica::PicaCore&
     update_queue.AddTexelBuffer(buffer_set, 3, *texture_lf_view);
     update_queue.AddTexelBuffer(buffer_set, 4, *texture_rg_view);
     update_queue.AddTexelBuffer(buffer_set, 5, *texture_rgba_view);
+    update_queue.AddBuffer(buffer_set, 6, uniform_buffer.Handle(), 0, sizeof(VSPicaUniformData));
 
-    const auto texture_set = pipeline_cache.Acquire(DescriptorHeapType::Texture);
     Surface& null_surface = res_cache.GetSurface(VideoCore::NULL_SURFACE_ID);
     Sampler& null_sampler = res_cache.GetSampler(VideoCore::NULL_SAMPLER_ID);
 
     // Prepare texture and utility descriptor sets.
-    for (u32 i = 0; i < 3; i++) {
-        update_queue.AddImageSampler(texture_set, i, 0, null_surface.ImageView(),
-                                     null_sampler.Handle());
+    if (pipeline_cache.UsePushDescriptors()) {
+        TextureDescriptors null_textures;
+        for (u8 i = 0; i < 3; i++) {
+            null_textures.push_back({i, 0, null_surface.ImageView(), null_sampler.Handle()});
+        }
+        pipeline_cache.PushTextures(null_textures);
+    } else {
+        const auto texture_set = pipeline_cache.Acquire(DescriptorHeapType::Texture);
+        for (u32 i = 0; i < 3; i++) {
+            update_queue.AddImageSampler(texture_set, i, 0, null_surface.ImageView(),
+                                         null_sampler.Handle());
+        }
     }
 
     const auto utility_set = pipeline_cache.Acquire(DescriptorHeapType::Utility);
@@ -157,77 +188,93 @@ void RasterizerVulkan::LoadDefaultDiskResources(
 }
 
 void RasterizerVulkan::SyncDrawState() {
-    SyncDrawUniforms();
+    // Fixed function state is only rebuilt from the registers written since the last draw.
+    // The dirty registers are reset when syncing the uniforms, so it has to come last.
+    const auto& dirty = pica.dirty_regs;
+    if (dirty.CheckRasterState()) {
+        MICROPROFILE_SCOPE(Vulkan_SyncRasterState);
+        // SyncCullMode();
+        pipeline_info.rasterization.cull_mode.Assign(regs.rasterizer.cull_mode);
+        // If the framebuffer is flipped, request to also flip vulkan viewport
+        const bool is_flipped = regs.framebuffer.framebuffer.IsFlipped();
+        pipeline_info.rasterization.flip_viewport.Assign(is_flipped);
+    }
 
-    // SyncCullMode();
-    pipeline_info.rasterization.cull_mode.Assign(regs.rasterizer.cull_mode);
-    // If the framebuffer is flipped, request to also flip vulkan viewport
-    const bool is_flipped = regs.framebuffer.framebuffer.IsFlipped();
-    pipeline_info.rasterization.flip_viewport.Assign(is_flipped);
-    // SyncBlendEnabled();
-    pipeline_info.blending.blend_enable = regs.framebuffer.output_merger.alphablend_enable;
-    // SyncBlendFuncs();
-    pipeline_info.blending.color_blend_eq.Assign(
-        regs.framebuffer.output_merger.alpha_blending.blend_equation_rgb);
-    pipeline_info.blending.alpha_blend_eq.Assign(
-        regs.framebuffer.output_merger.alpha_blending.blend_equation_a);
-    pipeline_info.blending.src_color_blend_factor.Assign(
-        regs.framebuffer.output_merger.alpha_blending.factor_source_rgb);
-    pipeline_info.blending.dst_color_blend_factor.Assign(
-        regs.framebuffer.output_merger.alpha_blending.factor_dest_rgb);
-    pipeline_info.blending.src_alpha_blend_factor.Assign(
-        regs.framebuffer.output_merger.alpha_blending.factor_source_a);
-    pipeline_info.blending.dst_alpha_blend_factor.Assign(
-        regs.framebuffer.output_merger.alpha_blending.factor_dest_a);
-    // SyncBlendColor();
-    pipeline_info.dynamic.blend_color = regs.framebuffer.output_merger.blend_const.raw;
-    // SyncLogicOp();
-    // SyncColorWriteMask();
-    pipeline_info.blending.logic_op = regs.framebuffer.output_merger.logic_op;
-    const bool is_logic_op_emulated =
-        instance.NeedsLogicOpEmulation() && !regs.framebuffer.output_merger.alphablend_enable;
-    const bool is_logic_op_noop =
-        regs.framebuffer.output_merger.logic_op == Pica::FramebufferRegs::LogicOp::NoOp;
-    if (is_logic_op_emulated && is_logic_op_noop) {
-        // Color output is disabled by logic operation. We use color write mask to skip
-        // color but allow depth write.
-        pipeline_info.blending.color_write_mask = 0;
-    } else {
-        const u32 color_mask = regs.framebuffer.framebuffer.allow_color_write != 0
-                                   ? (regs.framebuffer.output_merger.depth_color_mask >> 8) & 0xF
-                                   : 0;
-        pipeline_info.blending.color_write_mask = color_mask;
-    }
-    // SyncStencilTest();
-    const auto& stencil_test = regs.framebuffer.output_merger.stencil_test;
-    const bool test_enable = stencil_test.enable && regs.framebuffer.framebuffer.depth_format ==
-                                                        Pica::FramebufferRegs::DepthFormat::D24S8;
-
-    pipeline_info.depth_stencil.stencil_test_enable.Assign(test_enable);
-    pipeline_info.depth_stencil.stencil_fail_op.Assign(stencil_test.action_stencil_fail);
-    pipeline_info.depth_stencil.stencil_pass_op.Assign(stencil_test.action_depth_pass);
-    pipeline_info.depth_stencil.stencil_depth_fail_op.Assign(stencil_test.action_depth_fail);
-    pipeline_info.depth_stencil.stencil_compare_op.Assign(stencil_test.func);
-    pipeline_info.dynamic.stencil_reference = stencil_test.reference_value;
-    pipeline_info.dynamic.stencil_compare_mask = stencil_test.input_mask;
-    // SyncStencilWriteMask();
-    pipeline_info.dynamic.stencil_write_mask =
-        (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
-            ? static_cast<u32>(regs.framebuffer.output_merger.stencil_test.write_mask)
-            : 0;
-    // SyncDepthTest();
-    const bool test_enabled = regs.framebuffer.output_merger.depth_test_enable == 1 ||
-                              regs.framebuffer.output_merger.depth_write_enable == 1;
-    const auto compare_op = regs.framebuffer.output_merger.depth_test_enable == 1
-                                ? regs.framebuffer.output_merger.depth_test_func.Value()
-                                : Pica::FramebufferRegs::CompareFunc::Always;
-
-    pipeline_info.depth_stencil.depth_test_enable.Assign(test_enabled);
-    pipeline_info.depth_stencil.depth_compare_op.Assign(compare_op);
-    // SyncDepthWriteMask();
-    const bool write_enable = (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0 &&
-                               regs.framebuffer.output_merger.depth_write_enable);
-    pipeline_info.depth_stencil.depth_write_enable.Assign(write_enable);
+    if (dirty.CheckBlendState()) {
+        MICROPROFILE_SCOPE(Vulkan_SyncBlendState);
+        // SyncBlendEnabled();
+        pipeline_info.blending.blend_enable = regs.framebuffer.output_merger.alphablend_enable;
+        // SyncBlendFuncs();
+        pipeline_info.blending.color_blend_eq.Assign(
+            regs.framebuffer.output_merger.alpha_blending.blend_equation_rgb);
+        pipeline_info.blending.alpha_blend_eq.Assign(
+            regs.framebuffer.output_merger.alpha_blending.blend_equation_a);
+        pipeline_info.blending.src_color_blend_factor.Assign(
+            regs.framebuffer.output_merger.alpha_blending.factor_source_rgb);
+        pipeline_info.blending.dst_color_blend_factor.Assign(
+            regs.framebuffer.output_merger.alpha_blending.factor_dest_rgb);
+        pipeline_info.blending.src_alpha_blend_factor.Assign(
+            regs.framebuffer.output_merger.alpha_blending.factor_source_a);
+        pipeline_info.blending.dst_alpha_blend_factor.Assign(
+            regs.framebuffer.output_merger.alpha_blending.factor_dest_a);
+        // SyncBlendColor();
+        pipeline_info.dynamic.blend_color = regs.framebuffer.output_merger.blend_const.raw;
+        // SyncLogicOp();
+        // SyncColorWriteMask();
+        pipeline_info.blending.logic_op = regs.framebuffer.output_merger.logic_op;
+        const bool is_logic_op_emulated =
+            instance.NeedsLogicOpEmulation() && !regs.framebuffer.output_merger.alphablend_enable;
+        const bool is_logic_op_noop =
+            regs.framebuffer.output_merger.logic_op == Pica::FramebufferRegs::LogicOp::NoOp;
+        if (is_logic_op_emulated && is_logic_op_noop) {
+            // Color output is disabled by logic operation. We use color write mask to skip
+            // color but allow depth write.
+            pipeline_info.blending.color_write_mask = 0;
+        } else {
+            const u32 color_mask =
+                regs.framebuffer.framebuffer.allow_color_write != 0
+                    ? (regs.framebuffer.output_merger.depth_color_mask >> 8) & 0xF
+                    : 0;
+            pipeline_info.blending.color_write_mask = color_mask;
+        }
+    }
+
+    if (dirty.CheckDepthStencilState()) {
+        MICROPROFILE_SCOPE(Vulkan_SyncDepthStencilState);
+        // SyncStencilTest();
+        const auto& stencil_test = regs.framebuffer.output_merger.stencil_test;
+        const bool test_enable =
+            stencil_test.enable &&
+            regs.framebuffer.framebuffer.depth_format == Pica::FramebufferRegs::DepthFormat::D24S8;
+
+        pipeline_info.depth_stencil.stencil_test_enable.Assign(test_enable);
+        pipeline_info.depth_stencil.stencil_fail_op.Assign(stencil_test.action_stencil_fail);
+        pipeline_info.depth_stencil.stencil_pass_op.Assign(stencil_test.action_depth_pass);
+        pipeline_info.depth_stencil.stencil_depth_fail_op.Assign(stencil_test.action_depth_fail);
+        pipeline_info.depth_stencil.stencil_compare_op.Assign(stencil_test.func);
+        pipeline_info.dynamic.stencil_reference = stencil_test.reference_value;
+        pipeline_info.dynamic.stencil_compare_mask = stencil_test.input_mask;
+        // SyncStencilWriteMask();
+        pipeline_info.dynamic.stencil_write_mask =
+            (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
+                ? static_cast<u32>(regs.framebuffer.output_merger.stencil_test.write_mask)
+                : 0;
+        // SyncDepthTest();
+        const bool test_enabled = regs.framebuffer.output_merger.depth_test_enable == 1 ||
+                                  regs.framebuffer.output_merger.depth_write_enable == 1;
+        const auto compare_op = regs.framebuffer.output_merger.depth_test_enable == 1
+                                    ? regs.framebuffer.output_merger.depth_test_func.Value()
+                                    : Pica::FramebufferRegs::CompareFunc::Always;
+
+        pipeline_info.depth_stencil.depth_test_enable.Assign(test_enabled);
+        pipeline_info.depth_stencil.depth_compare_op.Assign(compare_op);
+        // SyncDepthWriteMask();
+        const bool write_enable = (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0 &&
+                                   regs.framebuffer.output_merger.depth_write_enable);
+        pipeline_info.depth_stencil.depth_write_enable.Assign(write_enable);
+    }
+
+    SyncDrawUniforms();
 }
 
 void RasterizerVulkan::SetupVertexArray() {
@@ -303,12 +350,29 @@ void RasterizerVulkan::SetupVertexArray() {
                       data_size, src_ref.GetSize(), data_addr);
         }
 
-        const u8* src_ptr = src_ref.GetPtr();
-        u8* dst_ptr = array_ptr + buffer_offset;
-
         // Align stride up if required by Vulkan implementation.
         const u32 aligned_stride =
             Common::AlignUp(static_cast<u32>(loader.byte_count), stride_alignment);
+
+        // Create the binding associated with this loader
+        VertexBinding& binding = layout.bindings[layout.binding_count];
+        binding.binding.Assign(layout.binding_count);
+        binding.fixed.Assign(0);
+        binding.stride.Assign(aligned_stride);
+
+        // Only tightly packed data is cached, as the padded layout depends on the loader.
+        const std::optional<u32> cached_offset =
+            aligned_stride == loader.byte_count && src_ref.GetSize() >= data_size
+                ? LoadCachedVertices(data_addr, data_size)
+                : std::nullopt;
+        if (cached_offset) {
+            vertex_buffers[layout.binding_count] = vertex_cache_buffer.Handle();
+            binding_offsets[layout.binding_count++] = *cached_offset;
+            continue;
+        }
+
+        const u8* src_ptr = src_ref.GetPtr();
+        u8* dst_ptr = array_ptr + buffer_offset;
         if (aligned_stride == loader.byte_count) {
             std::memcpy(dst_ptr, src_ptr, data_size);
         } else {
@@ -318,13 +382,8 @@ void RasterizerVulkan::SetupVertexArray() {
             }
         }
 
-        // Create the binding associated with this loader
-        VertexBinding& binding = layout.bindings[layout.binding_count];
-        binding.binding.Assign(layout.binding_count);
-        binding.fixed.Assign(0);
-        binding.stride.Assign(aligned_stride);
-
         // Keep track of the binding offsets so we can bind the vertex buffer later
+        vertex_buffers[layout.binding_count] = stream_buffer.Handle();
         binding_offsets[layout.binding_count++] = static_cast<u32>(array_offset + buffer_offset);
         buffer_offset += Common::AlignUp(aligned_stride * vertex_num, 4);
     }
@@ -340,6 +399,7 @@ void RasterizerVulkan::SetupFixedAttribs() {
     VertexLayout& layout = pipeline_info.vertex_layout;
 
     auto [fixed_ptr, fixed_offset, _] = stream_buffer.Map(16 * sizeof(Common::Vec4f), 0);
+    vertex_buffers[layout.binding_count] = stream_buffer.Handle();
     binding_offsets[layout.binding_count] = static_cast<u32>(fixed_offset);
 
     // Reserve the last binding for fixed and default attributes
@@ -396,6 +456,25 @@ void RasterizerVulkan::SetupFixedAttribs() {
     stream_buffer.Commit(offset);
 }
 
+std::optional<u32> RasterizerVulkan::LoadCachedVertices(PAddr addr, u32 size) {
+    if (const auto offset = vertex_buffer_cache.Find(addr, size)) {
+        return offset;
+    }
+    if (!vertex_buffer_cache.ShouldCache(addr, size)) {
+        return std::nullopt;
+    }
+
+    const auto [data, offset, invalidate] = vertex_cache_buffer.Map(size, 4);
+    if (invalidate) {
+        vertex_buffer_cache.Clear();
+    }
+    std::memcpy(data, memory.GetPhysicalPointer(addr), size);
+    vertex_cache_buffer.Commit(size);
+
+    vertex_buffer_cache.Insert(addr, size, offset);
+    return offset;
+}
+
 bool RasterizerVulkan::SetupVertexShader() {
     MICROPROFILE_SCOPE(Vulkan_VS);
     return pipeline_cache.UseProgrammableVertexShader(regs, pica.vs_setup,
@@ -406,8 +485,7 @@ bool RasterizerVulkan::SetupGeometryShader() {
     MICROPROFILE_SCOPE(Vulkan_GS);
 
     if (regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No) {
-        LOG_ERROR(Render_Vulkan, "Accelerate draw doesn't support geometry shader");
-        return false;
+        return pipeline_cache.UseProgrammableGeometryShader(regs, pica.gs_setup, accurate_mul);
     }
 
     // Enable the quaternion fix-up geometry-shader only if we are actually doing per-fragment
@@ -422,8 +500,10 @@ bool RasterizerVulkan::SetupGeometryShader() {
 }
 
 bool RasterizerVulkan::AccelerateDrawBatch(bool is_indexed) {
+    u32 gs_vertices_per_primitive = 0;
     if (regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No) {
-        if (regs.pipeline.gs_config.mode != Pica::PipelineRegs::GSMode::Point) {
+        gs_vertices_per_primitive = GetGSVerticesPerPrimitive(regs);
+        if (gs_vertices_per_primitive == 0) {
             return false;
         }
         if (regs.pipeline.triangle_topology != Pica::PipelineRegs::TriangleTopology::Shader) {
@@ -432,6 +512,7 @@ bool RasterizerVulkan::AccelerateDrawBatch(bool is_indexed) {
     }
 
     pipeline_info.rasterization.topology.Assign(regs.pipeline.triangle_topology);
+    pipeline_info.rasterization.gs_vertices_per_primitive.Assign(gs_vertices_per_primitive);
     if (regs.pipeline.triangle_topology == TriangleTopology::Fan &&
         !instance.IsTriangleFanSupported()) {
         LOG_DEBUG(Render_Vulkan,
@@ -443,6 +524,9 @@ bool RasterizerVulkan::AccelerateDrawBatch(bool is_indexed) {
     // early to avoid invalidating our state in the middle of the draw.
     vertex_info = AnalyzeVertexArray(is_indexed, instance.GetMinVertexStrideAlignment());
     SetupVertexArray();
+    if (is_indexed) {
+        SetupIndexArray();
+    }
 
     if (!SetupVertexShader()) {
         return false;
@@ -455,10 +539,6 @@ bool RasterizerVulkan::AccelerateDrawBatch(bool is_indexed) {
 }
 
 bool RasterizerVulkan::AccelerateDrawBatchInternal(bool is_indexed) {
-    if (is_indexed) {
-        SetupIndexArray();
-    }
-
     const bool wait_built = !async_shaders || regs.pipeline.num_vertices <= 6;
     if (!pipeline_cache.BindPipeline(pipeline_info, wait_built)) {
         return true;
@@ -470,14 +550,18 @@ bool RasterizerVulkan::AccelerateDrawBatchInternal(bool is_indexed) {
         .binding_count = pipeline_info.vertex_layout.binding_count,
         .bindings = binding_offsets,
         .is_indexed = is_indexed,
+        .index_buffer = index_buffer,
+        .index_offset = index_offset,
+        .index_type = index_type,
     };
 
-    scheduler.Record([this, params](vk::CommandBuffer cmdbuf) {
+    scheduler.Record([params, buffers = vertex_buffers](vk::CommandBuffer cmdbuf) {
         std::array<vk::DeviceSize, 16> offsets;
         std::transform(params.bindings.begin(), params.bindings.end(), offsets.begin(),
                        [](u32 offset) { return static_cast<vk::DeviceSize>(offset); });
-        cmdbuf.bindVertexBuffers(0, params.binding_count, vertex_buffers.data(), offsets.data());
+        cmdbuf.bindVertexBuffers(0, params.binding_count, buffers.data(), offsets.data());
         if (params.is_indexed) {
+            cmdbuf.bindIndexBuffer(params.index_buffer, params.index_offset, params.index_type);
             cmdbuf.drawIndexed(params.vertex_count, 1, 0, params.vertex_offset, 0);
         } else {
             cmdbuf.draw(params.vertex_count, 1, 0, 0);
@@ -490,18 +574,53 @@ bool RasterizerVulkan::AccelerateDrawBatchInternal(bool is_indexed) {
 void RasterizerVulkan::SetupIndexArray() {
     const bool index_u8 = regs.pipeline.index_array.format == 0;
     const bool native_u8 = index_u8 && instance.IsIndexTypeUint8Supported();
-    const u32 index_buffer_size = regs.pipeline.num_vertices * (native_u8 ? 1 : 2);
-    const vk::IndexType index_type = native_u8 ? vk::IndexType::eUint8EXT : vk::IndexType::eUint16;
+    const u32 num_indices = regs.pipeline.num_vertices;
+    const u32 index_data_size = num_indices * (index_u8 ? 1 : 2);
+    const u32 index_buffer_size = num_indices * (native_u8 ? 1 : 2);
+    index_type = native_u8 ? vk::IndexType::eUint8EXT : vk::IndexType::eUint16;
+
+    const PAddr index_addr = regs.pipeline.vertex_attributes.GetPhysicalBaseAddress() +
+                             regs.pipeline.index_array.offset;
+    const u8* index_data = memory.GetPhysicalPointer(index_addr);
+
+    // Index data that is drawn with repeatedly is kept in the index cache buffer, converted to
+    // the format the draw reads it in.
+    auto& index_buffer_cache = index_u8 ? index_buffer_cache_u8 : index_buffer_cache_u16;
+    if (const auto cached_offset = index_buffer_cache.Find(index_addr, index_data_size)) {
+        index_buffer = index_cache_buffer.Handle();
+        index_offset = *cached_offset;
+        return;
+    }
+    if (index_buffer_cache.ShouldCache(index_addr, index_data_size)) {
+        // Converted indices are written in whole words.
+        const u32 cache_size = Common::AlignUp(index_buffer_size, 4);
+        const auto [cache_ptr, cache_offset, invalidate] = index_cache_buffer.Map(cache_size, 4);
+        if (invalidate) {
+            index_buffer_cache_u8.Clear();
+            index_buffer_cache_u16.Clear();
+        }
+        if (index_u8 && !native_u8) {
+            const auto [src_ptr, src_offset, _] = stream_buffer.Map(index_data_size, 4);
+            std::memcpy(src_ptr, index_data, index_data_size);
+            stream_buffer.Commit(index_data_size);
+            index_converter.ConvertU8ToU16(stream_buffer.Handle(), src_offset,
+                                           index_cache_buffer.Handle(), cache_offset, num_indices);
+        } else {
+            std::memcpy(cache_ptr, index_data, index_buffer_size);
+        }
+        index_cache_buffer.Commit(cache_size);
 
-    const u8* index_data =
-        memory.GetPhysicalPointer(regs.pipeline.vertex_attributes.GetPhysicalBaseAddress() +
-                                  regs.pipeline.index_array.offset);
+        index_buffer_cache.Insert(index_addr, index_data_size, cache_offset);
+        index_buffer = index_cache_buffer.Handle();
+        index_offset = cache_offset;
+        return;
+    }
 
-    auto [index_ptr, index_offset, _] = stream_buffer.Map(index_buffer_size, 2);
+    auto [index_ptr, stream_offset, _] = stream_buffer.Map(index_buffer_size, 2);
 
     if (index_u8 && !native_u8) {
         u16* index_ptr_u16 = reinterpret_cast<u16*>(index_ptr);
-        for (u32 i = 0; i < regs.pipeline.num_vertices; i++) {
+        for (u32 i = 0; i < num_indices; i++) {
             index_ptr_u16[i] = index_data[i];
         }
     } else {
@@ -509,11 +628,8 @@ void RasterizerVulkan::SetupIndexArray() {
     }
 
     stream_buffer.Commit(index_buffer_size);
-
-    scheduler.Record(
-        [this, index_offset = index_offset, index_type = index_type](vk::CommandBuffer cmdbuf) {
-            cmdbuf.bindIndexBuffer(stream_buffer.Handle(), index_offset, index_type);
-        });
+    index_buffer = stream_buffer.Handle();
+    index_offset = stream_offset;
 }
 
 void RasterizerVulkan::DrawTriangles() {
@@ -522,6 +638,7 @@ void RasterizerVulkan::DrawTriangles() {
     }
 
     pipeline_info.rasterization.topology.Assign(Pica::PipelineRegs::TriangleTopology::List);
+    pipeline_info.rasterization.gs_vertices_per_primitive.Assign(0);
     pipeline_info.vertex_layout = software_layout;
 
     pipeline_cache.UseTrivialVertexShader();
@@ -532,6 +649,11 @@ void RasterizerVulkan::DrawTriangles() {
 
 bool RasterizerVulkan::Draw(bool accelerate, bool is_indexed) {
     MICROPROFILE_SCOPE(Vulkan_Drawing);
+    // Right eye images that are never shown are not drawn at all.
+    if (IsColorBufferSkipped(regs.framebuffer.framebuffer.GetColorBufferPhysicalAddress())) {
+        vertex_batch.clear();
+        return true;
+    }
     SyncDrawState();
 
     const bool shadow_rendering = regs.framebuffer.IsShadowRendering();
@@ -621,10 +743,16 @@ void RasterizerVulkan::SyncTextureUnits(const Framebuffer* framebuffer) {
     using TextureType = Pica::TexturingRegs::TextureConfig::TextureType;
 
     const auto pica_textures = regs.texturing.GetTextures();
-    const bool use_cube_heap =
-        pica_textures[0].enabled && pica_textures[0].config.type == TextureType::ShadowCube;
-    const auto texture_set = pipeline_cache.Acquire(use_cube_heap ? DescriptorHeapType::Texture
-                                                                  : DescriptorHeapType::Texture);
+    texture_descriptors.clear();
+
+    // Cached descriptor sets may reference the views of destroyed surfaces.
+    if (const u64 generation = runtime.ImageViewGeneration();
+        generation != image_view_generation) {
+        pipeline_cache.ClearDescriptorCache();
+        image_view_generation = generation;
+        texture_set_tick = 0;
+        utility_set_tick = 0;
+    }
 
     for (u32 texture_index = 0; texture_index < pica_textures.size(); ++texture_index) {
         const auto& texture = pica_textures[texture_index];
@@ -633,8 +761,8 @@ void RasterizerVulkan::SyncTextureUnits(const Framebuffer* framebuffer) {
         if (!texture.enabled) {
             const Surface& null_surface = res_cache.GetSurface(VideoCore::NULL_SURFACE_ID);
             const Sampler& null_sampler = res_cache.GetSampler(VideoCore::NULL_SAMPLER_ID);
-            update_queue.AddImageSampler(texture_set, texture_index, 0, null_surface.ImageView(),
-                                         null_sampler.Handle());
+            texture_descriptors.push_back({static_cast<u8>(texture_index), 0,
+                                           null_surface.ImageView(), null_sampler.Handle()});
             continue;
         }
 
@@ -645,16 +773,16 @@ void RasterizerVulkan::SyncTextureUnits(const Framebuffer* framebuffer) {
                 Surface& surface = res_cache.GetTextureSurface(texture);
                 Sampler& sampler = res_cache.GetSampler(texture.config);
                 surface.flags |= VideoCore::SurfaceFlagBits::ShadowMap;
-                update_queue.AddImageSampler(texture_set, texture_index, 0, surface.StorageView(),
-                                             sampler.Handle());
+                texture_descriptors.push_back({static_cast<u8>(texture_index), 0,
+                                               surface.StorageView(), sampler.Handle()});
                 continue;
             }
             case TextureType::ShadowCube: {
-                BindShadowCube(texture, texture_set);
+                BindShadowCube(texture);
                 continue;
             }
             case TextureType::TextureCube: {
-                BindTextureCube(texture, texture_set);
+                BindTextureCube(texture);
                 continue;
             }
             default:
@@ -669,7 +797,39 @@ void RasterizerVulkan::SyncTextureUnits(const Framebuffer* framebuffer) {
         const bool is_feedback_loop = color_view == surface.ImageView();
         const vk::ImageView texture_view =
             is_feedback_loop ? surface.CopyImageView() : surface.ImageView();
-        update_queue.AddImageSampler(texture_set, texture_index, 0, texture_view, sampler.Handle());
+        texture_descriptors.push_back(
+            {static_cast<u8>(texture_index), 0, texture_view, sampler.Handle()});
+    }
+
+    // Streams of draws often share their textures. Descriptor sets are only recycled once the
+    // tick they were acquired in has completed, so the previous set can be bound again as long as
+    // it was acquired in the current tick.
+    const u64 current_tick = scheduler.CurrentTick();
+    if (texture_set_tick == current_tick && texture_descriptors == bound_texture_descriptors) {
+        return;
+    }
+    bound_texture_descriptors = texture_descriptors;
+    texture_set_tick = current_tick;
+
+    if (pipeline_cache.UsePushDescriptors()) {
+        pipeline_cache.PushTextures(texture_descriptors);
+        return;
+    }
+
+    // Materials are usually bound again later on, so reuse the set written for them before.
+    u64 hash = 0;
+    for (const TextureDescriptor& descriptor : texture_descriptors) {
+        hash = Common::HashCombine(hash, (descriptor.binding << 8) | descriptor.array_index);
+        hash = Common::HashCombine(hash, std::hash<vk::ImageView>{}(descriptor.image_view));
+        hash = Common::HashCombine(hash, std::hash<vk::Sampler>{}(descriptor.sampler));
+    }
+    const auto [texture_set, cached] = pipeline_cache.Acquire(DescriptorHeapType::Texture, hash);
+    if (cached) {
+        return;
+    }
+    for (const TextureDescriptor& descriptor : texture_descriptors) {
+        update_queue.AddImageSampler(texture_set, descriptor.binding, descriptor.array_index,
+                                     descriptor.image_view, descriptor.sampler);
     }
 }
 
@@ -679,12 +839,23 @@ void RasterizerVulkan::SyncUtilityTextures(const Framebuffer* framebuffer) {
         return;
     }
 
-    const auto utility_set = pipeline_cache.Acquire(DescriptorHeapType::Utility);
-    update_queue.AddStorageImage(utility_set, 0, framebuffer->ImageView(SurfaceType::Color));
+    const vk::ImageView color_view = framebuffer->ImageView(SurfaceType::Color);
+    const u64 current_tick = scheduler.CurrentTick();
+    if (utility_set_tick == current_tick && bound_utility_view == color_view) {
+        return;
+    }
+
+    bound_utility_view = color_view;
+    utility_set_tick = current_tick;
+
+    const u64 hash = std::hash<vk::ImageView>{}(color_view);
+    const auto [utility_set, cached] = pipeline_cache.Acquire(DescriptorHeapType::Utility, hash);
+    if (!cached) {
+        update_queue.AddStorageImage(utility_set, 0, color_view);
+    }
 }
 
-void RasterizerVulkan::BindShadowCube(const Pica::TexturingRegs::FullTextureConfig& texture,
-                                      vk::DescriptorSet texture_set) {
+void RasterizerVulkan::BindShadowCube(const Pica::TexturingRegs::FullTextureConfig& texture) {
     using CubeFace = Pica::TexturingRegs::CubeFace;
     auto info = Pica::Texture::TextureInfo::FromPicaRegister(texture.config, texture.format);
     constexpr std::array faces = {
@@ -701,13 +872,12 @@ void RasterizerVulkan::BindShadowCube(const Pica::TexturingRegs::FullTextureConf
         const VideoCore::SurfaceId surface_id = res_cache.GetTextureSurface(info);
         Surface& surface = res_cache.GetSurface(surface_id);
         surface.flags |= VideoCore::SurfaceFlagBits::ShadowMap;
-        update_queue.AddImageSampler(texture_set, 0, binding, surface.StorageView(),
-                                     sampler.Handle());
+        texture_descriptors.push_back(
+            {0, static_cast<u8>(binding), surface.StorageView(), sampler.Handle()});
     }
 }
 
-void RasterizerVulkan::BindTextureCube(const Pica::TexturingRegs::FullTextureConfig& texture,
-                                       vk::DescriptorSet texture_set) {
+void RasterizerVulkan::BindTextureCube(const Pica::TexturingRegs::FullTextureConfig& texture) {
     using CubeFace = Pica::TexturingRegs::CubeFace;
     const VideoCore::TextureCubeConfig config = {
         .px = regs.texturing.GetCubePhysicalAddress(CubeFace::PositiveX),
@@ -723,7 +893,7 @@ void RasterizerVulkan::BindTextureCube(const Pica::TexturingRegs::FullTextureCon
 
     Surface& surface = res_cache.GetTextureCube(config);
     Sampler& sampler = res_cache.GetSampler(texture.config);
-    update_queue.AddImageSampler(texture_set, 0, 0, surface.ImageView(), sampler.Handle());
+    texture_descriptors.push_back({0, 0, surface.ImageView(), sampler.Handle()});
 }
 
 void RasterizerVulkan::FlushAll() {
@@ -736,15 +906,35 @@ void RasterizerVulkan::FlushRegion(PAddr addr, u32 size) {
 
 void RasterizerVulkan::InvalidateRegion(PAddr addr, u32 size) {
     res_cache.InvalidateRegion(addr, size);
+    vertex_buffer_cache.InvalidateRegion(addr, size);
+    index_buffer_cache_u8.InvalidateRegion(addr, size);
+    index_buffer_cache_u16.InvalidateRegion(addr, size);
 }
 
 void RasterizerVulkan::FlushAndInvalidateRegion(PAddr addr, u32 size) {
     res_cache.FlushRegion(addr, size);
     res_cache.InvalidateRegion(addr, size);
+    vertex_buffer_cache.InvalidateRegion(addr, size);
+    index_buffer_cache_u8.InvalidateRegion(addr, size);
+    index_buffer_cache_u16.InvalidateRegion(addr, size);
 }
 
 void RasterizerVulkan::ClearAll(bool flush) {
     res_cache.ClearAll(flush);
+    // The surface cache has released every cached page, including the ones of cached vertices
+    // and indices.
+    vertex_buffer_cache.Clear(false);
+    index_buffer_cache_u8.Clear(false);
+    index_buffer_cache_u16.Clear(false);
+}
+
+std::vector<VideoCore::SurfaceDescriptor> RasterizerVulkan::GetSurfaceDescriptors(
+    std::size_t max_count) {
+    return res_cache.GetSurfaceDescriptors(max_count);
+}
+
+void RasterizerVulkan::PrewarmSurfaces(std::span<const VideoCore::SurfaceDescriptor> surfaces) {
+    res_cache.PrewarmSurfaces(surfaces);
 }
 
 bool RasterizerVulkan::AccelerateDisplayTransfer(const Pica::DisplayTransferConfig& config) {
@@ -837,47 +1027,54 @@ void RasterizerVulkan::SyncAndUploadLUTsLF() {
     if (invalidate) {
         pica.lighting.lut_dirty = pica.lighting.LutAllDirty;
         pica.fog.lut_dirty = true;
+        lf_lut_cache.Clear();
     }
 
+    // LUTs still in the buffer from an earlier upload are only pointed to again.
+    const auto sync_lut = [&](const auto& lut, u64 kind, int& lut_offset) {
+        const u64 hash = lf_lut_cache.Hash(lut, kind);
+        auto cached_offset = lf_lut_cache.Find(hash);
+        if (!cached_offset) {
+            Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
+            for (u32 i = 0; i < lut.size(); i++) {
+                new_data[i] = {lut[i].ToFloat(), lut[i].DiffToFloat()};
+            }
+            cached_offset = static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
+            lf_lut_cache.Insert(hash, *cached_offset);
+            bytes_used += lut.size() * sizeof(Common::Vec2f);
+        }
+        if (lut_offset != *cached_offset) {
+            lut_offset = *cached_offset;
+            fs_data_dirty = true;
+        }
+    };
+
     // Sync the lighting luts
     while (pica.lighting.lut_dirty) {
-        u32 index = std::countr_zero(pica.lighting.lut_dirty);
+        const u32 index = std::countr_zero(pica.lighting.lut_dirty);
         pica.lighting.lut_dirty &= ~(1 << index);
-
-        Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
-        const auto& source_lut = pica.lighting.luts[index];
-        for (u32 i = 0; i < source_lut.size(); i++) {
-            new_data[i] = {source_lut[i].ToFloat(), source_lut[i].DiffToFloat()};
-        }
-        fs_data.lighting_lut_offset[index / 4][index % 4] =
-            static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
-        fs_data_dirty = true;
-        bytes_used += source_lut.size() * sizeof(Common::Vec2f);
+        sync_lut(pica.lighting.luts[index], 0, fs_data.lighting_lut_offset[index / 4][index % 4]);
     }
 
     // Sync the fog lut
     if (pica.fog.lut_dirty) {
-        Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
-        for (u32 i = 0; i < pica.fog.lut.size(); i++) {
-            new_data[i] = {pica.fog.lut[i].ToFloat(), pica.fog.lut[i].DiffToFloat()};
-        }
-        fs_data.fog_lut_offset = static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
-        fs_data_dirty = true;
-        bytes_used += pica.fog.lut.size() * sizeof(Common::Vec2f);
+        sync_lut(pica.fog.lut, 1, fs_data.fog_lut_offset);
         pica.fog.lut_dirty = false;
     }
 
-    texture_lf_buffer.Commit(static_cast<u32>(bytes_used));
+    // Flushing an empty range is invalid, every LUT may have been found in the buffer.
+    if (bytes_used > 0) {
+        texture_lf_buffer.Commit(static_cast<u32>(bytes_used));
+    }
 }
 
 void RasterizerVulkan::SyncAndUploadLUTs() {
-    const auto& proctex = pica.proctex;
     constexpr std::size_t max_size =
         sizeof(Common::Vec2f) * 128 * 3 + // proctex: noise + color + alpha
         sizeof(Common::Vec4f) * 256 +     // proctex
         sizeof(Common::Vec4f) * 256;      // proctex diff
 
-    if (!pica.proctex.lut_dirty) {
+    if (!pica.proctex.table_dirty) {
         return;
     }
 
@@ -886,101 +1083,143 @@ void RasterizerVulkan::SyncAndUploadLUTs() {
 
     if (invalidate) {
         pica.proctex.table_dirty = pica.proctex.TableAllDirty;
+        proctex_lut_cache.Clear();
     }
 
-    // helper function for SyncProcTexNoiseLUT/ColorMap/AlphaMap
-    const auto sync_proctex_value_lut =
-        [&](const std::array<Pica::PicaCore::ProcTex::ValueEntry, 128>& lut, int& lut_offset) {
-            Common::Vec2f* new_data = reinterpret_cast<Common::Vec2f*>(buffer + bytes_used);
+    // LUTs still in the buffer from an earlier upload are only pointed to again.
+    const auto sync_lut = [&](const auto& lut, u64 kind, int& lut_offset, auto&& convert) {
+        using T = decltype(convert(lut[0]));
+        const u64 hash = proctex_lut_cache.Hash(lut, kind);
+        auto cached_offset = proctex_lut_cache.Find(hash);
+        if (!cached_offset) {
+            T* new_data = reinterpret_cast<T*>(buffer + bytes_used);
             for (u32 i = 0; i < lut.size(); i++) {
-                new_data[i] = {lut[i].ToFloat(), lut[i].DiffToFloat()};
+                new_data[i] = convert(lut[i]);
             }
-            lut_offset = static_cast<int>((offset + bytes_used) / sizeof(Common::Vec2f));
+            cached_offset = static_cast<int>((offset + bytes_used) / sizeof(T));
+            proctex_lut_cache.Insert(hash, *cached_offset);
+            bytes_used += lut.size() * sizeof(T);
+        }
+        if (lut_offset != *cached_offset) {
+            lut_offset = *cached_offset;
             fs_data_dirty = true;
-            bytes_used += lut.size() * sizeof(Common::Vec2f);
-        };
+        }
+    };
+    const auto value_entry = [](const auto& entry) {
+        return Common::Vec2f{entry.ToFloat(), entry.DiffToFloat()};
+    };
+    const auto color_entry = [](const auto& entry) { return entry.ToVector() / 255.0f; };
 
     // Sync the proctex noise lut
     if (pica.proctex.noise_lut_dirty) {
-        sync_proctex_value_lut(proctex.noise_table, fs_data.proctex_noise_lut_offset);
+        sync_lut(pica.proctex.noise_table, 0, fs_data.proctex_noise_lut_offset, value_entry);
     }
 
     // Sync the proctex color map
     if (pica.proctex.color_map_dirty) {
-        sync_proctex_value_lut(proctex.color_map_table, fs_data.proctex_color_map_offset);
+        sync_lut(pica.proctex.color_map_table, 0, fs_data.proctex_color_map_offset, value_entry);
     }
 
     // Sync the proctex alpha map
     if (pica.proctex.alpha_map_dirty) {
-        sync_proctex_value_lut(proctex.alpha_map_table, fs_data.proctex_alpha_map_offset);
+        sync_lut(pica.proctex.alpha_map_table, 0, fs_data.proctex_alpha_map_offset, value_entry);
     }
 
     // Sync the proctex lut
     if (pica.proctex.lut_dirty) {
-        Common::Vec4f* new_data = reinterpret_cast<Common::Vec4f*>(buffer + bytes_used);
-        for (u32 i = 0; i < proctex.color_table.size(); i++) {
-            new_data[i] = proctex.color_table[i].ToVector() / 255.0f;
-        }
-        fs_data.proctex_lut_offset =
-            static_cast<int>((offset + bytes_used) / sizeof(Common::Vec4f));
-        fs_data_dirty = true;
-        bytes_used += proctex.color_table.size() * sizeof(Common::Vec4f);
+        sync_lut(pica.proctex.color_table, 1, fs_data.proctex_lut_offset, color_entry);
     }
 
     // Sync the proctex difference lut
     if (pica.proctex.diff_lut_dirty) {
-        Common::Vec4f* new_data = reinterpret_cast<Common::Vec4f*>(buffer + bytes_used);
-        for (u32 i = 0; i < proctex.color_diff_table.size(); i++) {
-            new_data[i] = proctex.color_diff_table[i].ToVector() / 255.0f;
-        }
-        fs_data.proctex_diff_lut_offset =
-            static_cast<int>((offset + bytes_used) / sizeof(Common::Vec4f));
-        fs_data_dirty = true;
-        bytes_used += proctex.color_diff_table.size() * sizeof(Common::Vec4f);
+        sync_lut(pica.proctex.color_diff_table, 2, fs_data.proctex_diff_lut_offset, color_entry);
     }
 
     pica.proctex.table_dirty = 0;
 
-    texture_buffer.Commit(static_cast<u32>(bytes_used));
+    // Flushing an empty range is invalid, every LUT may have been found in the buffer.
+    if (bytes_used > 0) {
+        texture_buffer.Commit(static_cast<u32>(bytes_used));
+    }
 }
 
 void RasterizerVulkan::UploadUniforms(bool accelerate_draw) {
     const bool sync_vs_pica = accelerate_draw && pica.vs_setup.uniforms_dirty;
-    if (!sync_vs_pica && !vs_data_dirty && !fs_data_dirty) {
+    const bool sync_gs_pica = accelerate_draw && pica.gs_setup.uniforms_dirty &&
+                              regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No;
+    if (!sync_vs_pica && !sync_gs_pica && !vs_data_dirty && !fs_data_dirty) {
         return;
     }
 
-    const u32 uniform_size =
-        uniform_size_aligned_vs_pica + uniform_size_aligned_vs + uniform_size_aligned_fs;
-    auto [uniforms, offset, invalidate] =
-        uniform_buffer.Map(uniform_size, uniform_buffer_alignment);
-
-    u32 used_bytes = 0;
+    // Blocks with the contents of an earlier upload still in the buffer are bound there again.
+    // The PICA blocks are identified by the uniforms they are converted from, and shared by the
+    // VS and the GS.
+    const auto vs_hash = uniform_cache.Hash(vs_data, 0);
+    const auto fs_hash = uniform_cache.Hash(fs_data, 1);
+    const auto vs_pica_hash = uniform_cache.Hash(pica.vs_setup.uniforms, 2);
+    const auto gs_pica_hash = uniform_cache.Hash(pica.gs_setup.uniforms, 2);
+    const auto is_cached = [&](bool sync, u64 hash) {
+        return !sync || uniform_cache.Find(hash).has_value();
+    };
 
-    if (vs_data_dirty || invalidate) {
-        std::memcpy(uniforms + used_bytes, &vs_data, sizeof(vs_data));
-        pipeline_cache.UpdateRange(1, offset + used_bytes);
-        vs_data_dirty = false;
-        used_bytes += uniform_size_aligned_vs;
+    u8* uniforms = nullptr;
+    u32 offset = 0;
+    bool invalidate = false;
+    if (!is_cached(vs_data_dirty, vs_hash) || !is_cached(fs_data_dirty, fs_hash) ||
+        !is_cached(sync_vs_pica, vs_pica_hash) || !is_cached(sync_gs_pica, gs_pica_hash)) {
+        const u32 uniform_size =
+            uniform_size_aligned_vs_pica * 2 + uniform_size_aligned_vs + uniform_size_aligned_fs;
+        std::tie(uniforms, offset, invalidate) =
+            uniform_buffer.Map(uniform_size, uniform_buffer_alignment);
+        if (invalidate) {
+            uniform_cache.Clear();
+        }
     }
 
-    if (fs_data_dirty || invalidate) {
-        std::memcpy(uniforms + used_bytes, &fs_data, sizeof(fs_data));
-        pipeline_cache.UpdateRange(2, offset + used_bytes);
-        fs_data_dirty = false;
-        used_bytes += uniform_size_aligned_fs;
-    }
+    u32 used_bytes = 0;
+    const auto upload = [&](bool sync, u64 hash, u8 binding, u32 aligned_size,
+                            const auto& write) {
+        if (!sync && !invalidate) {
+            return;
+        }
+        if (const auto cached_offset = uniform_cache.Find(hash)) {
+            pipeline_cache.UpdateRange(binding, static_cast<u32>(*cached_offset));
+            return;
+        }
+        write(uniforms + used_bytes);
+        pipeline_cache.UpdateRange(binding, offset + used_bytes);
+        uniform_cache.Insert(hash, static_cast<int>(offset + used_bytes));
+        used_bytes += aligned_size;
+    };
 
-    if (sync_vs_pica || invalidate) {
+    upload(vs_data_dirty, vs_hash, 1, uniform_size_aligned_vs,
+           [&](u8* data) { std::memcpy(data, &vs_data, sizeof(vs_data)); });
+    upload(fs_data_dirty, fs_hash, 2, uniform_size_aligned_fs,
+           [&](u8* data) { std::memcpy(data, &fs_data, sizeof(fs_data)); });
+    upload(sync_vs_pica, vs_pica_hash, 0, uniform_size_aligned_vs_pica, [&](u8* data) {
         VSPicaUniformData vs_uniforms;
         vs_uniforms.SetFromRegs(pica.vs_setup);
-        std::memcpy(uniforms + used_bytes, &vs_uniforms, sizeof(vs_uniforms));
-        pipeline_cache.UpdateRange(0, offset + used_bytes);
+        std::memcpy(data, &vs_uniforms, sizeof(vs_uniforms));
+    });
+    upload(sync_gs_pica, gs_pica_hash, 3, uniform_size_aligned_vs_pica, [&](u8* data) {
+        VSPicaUniformData gs_uniforms;
+        gs_uniforms.SetFromRegs(pica.gs_setup);
+        std::memcpy(data, &gs_uniforms, sizeof(gs_uniforms));
+    });
+
+    vs_data_dirty = false;
+    fs_data_dirty = false;
+    if (sync_vs_pica || invalidate) {
         pica.vs_setup.uniforms_dirty = false;
-        used_bytes += uniform_size_aligned_vs_pica;
+    }
+    if (sync_gs_pica || invalidate) {
+        pica.gs_setup.uniforms_dirty = false;
     }
 
-    uniform_buffer.Commit(used_bytes);
+    // Flushing an empty range is invalid, every block may have been found in the buffer.
+    if (used_bytes > 0) {
+        uniform_buffer.Commit(used_bytes);
+    }
 }
 
 void RasterizerVulkan::SwitchDiskResources(u64 title_id) {
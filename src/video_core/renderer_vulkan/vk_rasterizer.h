@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <boost/container/static_vector.hpp>
 #include "video_core/rasterizer_accelerated.h"
+#include "video_core/rasterizer_cache/vertex_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_descriptor_update_queue.h"
+#include "video_core/renderer_vulkan/vk_index_converter.h"
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_render_manager.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
@@ -45,6 +48,17 @@ public:
     ~RasterizerVulkan() override;
 
     void TickFrame();
+
+    /// Returns the texture upload staging usage of the last frame.
+    StagingAllocator::Stats GetAndResetStagingStats() {
+        return runtime.GetAndResetStagingStats();
+    }
+
+    /// Returns the number of shaders compiled since the last call.
+    u32 GetAndResetShaderCompiles() {
+        return pipeline_cache.GetAndResetShaderCompiles();
+    }
+
     void LoadDefaultDiskResources(const std::atomic_bool& stop_loading,
                                   const VideoCore::DiskResourceLoadCallback& callback) override;
 
@@ -54,6 +68,8 @@ public:
     void InvalidateRegion(PAddr addr, u32 size) override;
     void FlushAndInvalidateRegion(PAddr addr, u32 size) override;
     void ClearAll(bool flush) override;
+    std::vector<VideoCore::SurfaceDescriptor> GetSurfaceDescriptors(std::size_t max_count) override;
+    void PrewarmSurfaces(std::span<const VideoCore::SurfaceDescriptor> surfaces) override;
     bool AccelerateDisplayTransfer(const Pica::DisplayTransferConfig& config) override;
     bool AccelerateTextureCopy(const Pica::DisplayTransferConfig& config) override;
     bool AccelerateFill(const Pica::MemoryFillConfig& config) override;
@@ -72,19 +88,18 @@ private:
     void SyncAndUploadLUTs();
     void SyncAndUploadLUTsLF();
 
-    /// Syncs all enabled PICA texture units
+    /// Syncs all enabled PICA texture units. The texture descriptor set of the previous draw is
+    /// reused when the textures have not changed.
     void SyncTextureUnits(const Framebuffer* framebuffer);
 
     /// Syncs all utility textures in the fragment shader.
     void SyncUtilityTextures(const Framebuffer* framebuffer);
 
     /// Binds the PICA shadow cube required for shadow mapping
-    void BindShadowCube(const Pica::TexturingRegs::FullTextureConfig& texture,
-                        vk::DescriptorSet texture_set);
+    void BindShadowCube(const Pica::TexturingRegs::FullTextureConfig& texture);
 
     /// Binds a texture cube to texture unit 0
-    void BindTextureCube(const Pica::TexturingRegs::FullTextureConfig& texture,
-                         vk::DescriptorSet texture_set);
+    void BindTextureCube(const Pica::TexturingRegs::FullTextureConfig& texture);
 
     /// Upload the uniform blocks to the uniform buffer object
     void UploadUniforms(bool accelerate_draw);
@@ -104,6 +119,10 @@ private:
     /// Setup the fixed attribute emulation in vulkan
     void SetupFixedAttribs();
 
+    /// Returns the offset of the vertex data in the vertex cache buffer if it is cached there,
+    /// uploading it first when it has become worth caching
+    std::optional<u32> LoadCachedVertices(PAddr addr, u32 size);
+
     /// Setup vertex shader for AccelerateDrawBatch
     bool SetupVertexShader();
 
@@ -121,18 +140,33 @@ private:
     PipelineCache pipeline_cache;
     TextureRuntime runtime;
     RasterizerCache res_cache;
+    IndexConverter index_converter;
+    VideoCore::VertexBufferCache vertex_buffer_cache;
+    VideoCore::VertexBufferCache index_buffer_cache_u8;
+    VideoCore::VertexBufferCache index_buffer_cache_u16;
 
     VertexLayout software_layout;
     std::array<u32, 16> binding_offsets{};
     std::array<bool, 16> enable_attributes{};
     std::array<vk::Buffer, 16> vertex_buffers;
+    vk::Buffer index_buffer;
+    u32 index_offset{};
+    vk::IndexType index_type{};
+    TextureDescriptors texture_descriptors;
+    TextureDescriptors bound_texture_descriptors;
+    vk::ImageView bound_utility_view;
+    u64 texture_set_tick{};
+    u64 utility_set_tick{};
+    u64 image_view_generation{};
     VertexArrayInfo vertex_info;
     PipelineInfo pipeline_info{};
 
-    StreamBuffer stream_buffer;     ///< Vertex+Index buffer
-    StreamBuffer uniform_buffer;    ///< Uniform buffer
-    StreamBuffer texture_buffer;    ///< Texture buffer
-    StreamBuffer texture_lf_buffer; ///< Texture Light-Fog buffer
+    StreamBuffer stream_buffer;       ///< Vertex+Index buffer
+    StreamBuffer vertex_cache_buffer; ///< Cached vertex buffer
+    StreamBuffer index_cache_buffer;  ///< Cached index buffer
+    StreamBuffer uniform_buffer;      ///< Uniform buffer
+    StreamBuffer texture_buffer;      ///< Texture buffer
+    StreamBuffer texture_lf_buffer;   ///< Texture Light-Fog buffer
     vk::UniqueBufferView texture_lf_view;
     vk::UniqueBufferView texture_rg_view;
     vk::UniqueBufferView texture_rgba_view;
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <utility>
 #include "common/assert.h"
 #include "video_core/rasterizer_cache/pixel_format.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
@@ -21,6 +23,34 @@ RenderManager::RenderManager(const Instance& instance, Scheduler& scheduler)
 
 RenderManager::~RenderManager() = default;
 
+namespace {
+
+bool Contains(const vk::Rect2D& outer, const vk::Rect2D& inner) {
+    return inner.offset.x >= outer.offset.x && inner.offset.y >= outer.offset.y &&
+           inner.offset.x + inner.extent.width <= outer.offset.x + outer.extent.width &&
+           inner.offset.y + inner.extent.height <= outer.offset.y + outer.extent.height;
+}
+
+vk::Rect2D Union(const vk::Rect2D& a, const vk::Rect2D& b) {
+    const s32 left = std::min(a.offset.x, b.offset.x);
+    const s32 top = std::min(a.offset.y, b.offset.y);
+    const s32 right = std::max<s32>(a.offset.x + a.extent.width, b.offset.x + b.extent.width);
+    const s32 bottom = std::max<s32>(a.offset.y + a.extent.height, b.offset.y + b.extent.height);
+    return vk::Rect2D{
+        .offset{.x = left, .y = top},
+        .extent{
+            .width = static_cast<u32>(right - left),
+            .height = static_cast<u32>(bottom - top),
+        },
+    };
+}
+
+u32 BytesPerPixel(PixelFormat format) {
+    return format == PixelFormat::Invalid ? 0 : VideoCore::GetFormatBytesPerPixel(format);
+}
+
+} // Anonymous namespace
+
 void RenderManager::BeginRendering(const Framebuffer* framebuffer,
                                    Common::Rectangle<u32> draw_rect) {
     const vk::Rect2D render_area = {
@@ -42,17 +72,27 @@ void RenderManager::BeginRendering(const Framebuffer* framebuffer,
     };
     images = framebuffer->Images();
     aspects = framebuffer->Aspects();
+    bytes_per_pixel = BytesPerPixel(framebuffer->Format(SurfaceType::Color)) +
+                      BytesPerPixel(framebuffer->Format(SurfaceType::DepthStencil));
     BeginRendering(new_pass);
 }
 
-void RenderManager::BeginRendering(const RenderPass& new_pass) {
-    if (pass == new_pass) [[likely]] {
+void RenderManager::BeginRendering(const RenderPass& render_pass) {
+    if (pass == render_pass) [[likely]] {
+        num_draws++;
+        return;
+    }
+
+    RenderPass new_pass = render_pass;
+    if (TryMergePass(new_pass)) {
         num_draws++;
         return;
     }
 
     EndRendering();
-    scheduler.Record([info = new_pass](vk::CommandBuffer cmdbuf) {
+    stats.render_passes++;
+    const bool use_secondary = scheduler.IsParallelRecording();
+    scheduler.Record([info = new_pass, use_secondary](vk::CommandBuffer cmdbuf) {
         const vk::RenderPassBeginInfo renderpass_begin_info = {
             .renderPass = info.render_pass,
             .framebuffer = info.framebuffer,
@@ -60,8 +100,13 @@ void RenderManager::BeginRendering(const RenderPass& new_pass) {
             .clearValueCount = info.do_clear ? 1u : 0u,
             .pClearValues = &info.clear,
         };
-        cmdbuf.beginRenderPass(renderpass_begin_info, vk::SubpassContents::eInline);
+        cmdbuf.beginRenderPass(renderpass_begin_info,
+                               use_secondary ? vk::SubpassContents::eSecondaryCommandBuffers
+                                             : vk::SubpassContents::eInline);
     });
+    if (use_secondary) {
+        scheduler.BeginSecondary(new_pass.render_pass, new_pass.framebuffer);
+    }
 
     pass = new_pass;
 }
@@ -71,6 +116,7 @@ void RenderManager::EndRendering() {
         return;
     }
 
+    scheduler.EndSecondary();
     scheduler.Record([images = images, aspects = aspects](vk::CommandBuffer cmdbuf) {
         u32 num_barriers = 0;
         vk::PipelineStageFlags pipeline_flags{};
@@ -129,6 +175,31 @@ void RenderManager::EndRendering() {
     }
 }
 
+bool RenderManager::TryMergePass(RenderPass& new_pass) {
+    if (!pass.render_pass || pass.framebuffer != new_pass.framebuffer ||
+        pass.render_pass != new_pass.render_pass || pass.do_clear || new_pass.do_clear) {
+        return false;
+    }
+
+    // Draws are scissored to their own area, so they may continue rendering in a pass with a
+    // larger render area. On tilers this avoids storing the attachments only to load them again.
+    const vk::Rect2D& area = new_pass.render_area;
+    if (!Contains(pass.render_area, area)) {
+        // Draws alternating between areas of the same attachments are common, the restarted
+        // pass covers both areas so that the following draws merge with it.
+        new_pass.render_area = Union(pass.render_area, area);
+        return false;
+    }
+
+    stats.merged_passes++;
+    stats.bytes_saved += u64{area.extent.width} * area.extent.height * bytes_per_pixel * 2;
+    return true;
+}
+
+RenderManager::Stats RenderManager::GetAndResetStats() {
+    return std::exchange(stats, Stats{});
+}
+
 vk::RenderPass RenderManager::GetRenderpass(VideoCore::PixelFormat color,
                                             VideoCore::PixelFormat depth, bool is_clear) {
     std::scoped_lock lock{cache_mutex};
@@ -147,14 +218,16 @@ vk::RenderPass RenderManager::GetRenderpass(VideoCore::PixelFormat color,
         const vk::Format depth_format = instance.GetTraits(depth).native;
         const vk::AttachmentLoadOp load_op =
             is_clear ? vk::AttachmentLoadOp::eClear : vk::AttachmentLoadOp::eLoad;
-        renderpass = CreateRenderPass(color_format, depth_format, load_op);
+        renderpass =
+            CreateRenderPass(color_format, depth_format, load_op, depth == PixelFormat::D24S8);
     }
 
     return *renderpass;
 }
 
 vk::UniqueRenderPass RenderManager::CreateRenderPass(vk::Format color, vk::Format depth,
-                                                     vk::AttachmentLoadOp load_op) const {
+                                                     vk::AttachmentLoadOp load_op,
+                                                     bool has_stencil) const {
     u32 attachment_count = 0;
     std::array<vk::AttachmentDescription, 2> attachments;
 
@@ -187,8 +260,10 @@ vk::UniqueRenderPass RenderManager::CreateRenderPass(vk::Format color, vk::Forma
             .format = depth,
             .loadOp = load_op,
             .storeOp = vk::AttachmentStoreOp::eStore,
-            .stencilLoadOp = load_op,
-            .stencilStoreOp = vk::AttachmentStoreOp::eStore,
+            // Depth formats emulated with a stencil aspect never have it read back.
+            .stencilLoadOp = has_stencil ? load_op : vk::AttachmentLoadOp::eDontCare,
+            .stencilStoreOp =
+                has_stencil ? vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare,
             .initialLayout = vk::ImageLayout::eGeneral,
             .finalLayout = vk::ImageLayout::eGeneral,
         };
@@ -39,6 +39,12 @@ class RenderManager {
     static constexpr u32 NumDepthFormats = 4;
 
 public:
+    struct Stats {
+        u32 render_passes; ///< Render passes begun since the last query.
+        u32 merged_passes; ///< Render passes that continued the previous one instead.
+        u64 bytes_saved;   ///< Estimated attachment bytes that were not stored and loaded again.
+    };
+
     explicit RenderManager(const Instance& instance, Scheduler& scheduler);
     ~RenderManager();
 
@@ -51,6 +57,9 @@ public:
     /// Exits from any currently active renderpass instance
     void EndRendering();
 
+    /// Returns the render pass statistics and resets them.
+    Stats GetAndResetStats();
+
     /// Returns the renderpass associated with the color-depth format pair
     vk::RenderPass GetRenderpass(VideoCore::PixelFormat color, VideoCore::PixelFormat depth,
                                  bool is_clear);
@@ -58,7 +67,10 @@ public:
 private:
     /// Creates a renderpass configured appropriately and stores it in cached_renderpasses
     vk::UniqueRenderPass CreateRenderPass(vk::Format color, vk::Format depth,
-                                          vk::AttachmentLoadOp load_op) const;
+                                          vk::AttachmentLoadOp load_op, bool has_stencil) const;
+
+    /// Returns true when the new pass can continue the current one, widening its render area.
+    bool TryMergePass(RenderPass& new_pass);
 
 private:
     const Instance& instance;
@@ -67,8 +79,10 @@ private:
     std::mutex cache_mutex;
     std::array<vk::Image, 2> images;
     std::array<vk::ImageAspectFlags, 2> aspects;
+    u32 bytes_per_pixel{};
     RenderPass pass{};
     u32 num_draws{};
+    Stats stats{};
 };
 
 } // namespace Vulkan
@@ -61,12 +61,14 @@ std::size_t ResourcePool::ManageOverflow() {
 
 constexpr std::size_t COMMAND_BUFFER_POOL_SIZE = 4;
 
-CommandPool::CommandPool(const Instance& instance, MasterSemaphore* master_semaphore)
-    : ResourcePool{master_semaphore, COMMAND_BUFFER_POOL_SIZE}, instance{instance} {
+CommandPool::CommandPool(const Instance& instance, MasterSemaphore* master_semaphore,
+                         u32 queue_family_index, vk::CommandBufferLevel level_)
+    : ResourcePool{master_semaphore, COMMAND_BUFFER_POOL_SIZE}, instance{instance},
+      level{level_} {
     const vk::CommandPoolCreateInfo pool_create_info = {
         .flags = vk::CommandPoolCreateFlagBits::eTransient |
                  vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-        .queueFamilyIndex = instance.GetGraphicsQueueFamilyIndex(),
+        .queueFamilyIndex = queue_family_index,
     };
     const vk::Device device = instance.GetDevice();
     cmd_pool = device.createCommandPoolUnique(pool_create_info);
@@ -82,7 +84,7 @@ void CommandPool::Allocate(std::size_t begin, std::size_t end) {
 
     const vk::CommandBufferAllocateInfo buffer_alloc_info = {
         .commandPool = *cmd_pool,
-        .level = vk::CommandBufferLevel::ePrimary,
+        .level = level,
         .commandBufferCount = COMMAND_BUFFER_POOL_SIZE,
     };
 
@@ -140,6 +142,7 @@ DescriptorHeap::~DescriptorHeap() = default;
 void DescriptorHeap::Allocate(std::size_t begin, std::size_t end) {
     ASSERT(end - begin == DESCRIPTOR_SET_BATCH);
     descriptor_sets.resize(end);
+    set_hashes.resize(end);
 
     std::array<vk::DescriptorSetLayout, DESCRIPTOR_SET_BATCH> layouts;
     layouts.fill(*descriptor_set_layout);
@@ -172,9 +175,35 @@ void DescriptorHeap::Allocate(std::size_t begin, std::size_t end) {
 
 vk::DescriptorSet DescriptorHeap::Commit() {
     const std::size_t index = CommitResource();
+    ForgetSet(index);
     return descriptor_sets[index];
 }
 
+std::pair<vk::DescriptorSet, bool> DescriptorHeap::Commit(u64 hash) {
+    if (const auto it = cached_sets.find(hash); it != cached_sets.end()) {
+        // Keep the set from being recycled while the commands of this tick use it.
+        ticks[it->second] = master_semaphore->CurrentTick();
+        return {descriptor_sets[it->second], true};
+    }
+
+    const std::size_t index = CommitResource();
+    ForgetSet(index);
+    set_hashes[index] = hash;
+    cached_sets.emplace(hash, index);
+    return {descriptor_sets[index], false};
+}
+
+void DescriptorHeap::ClearCache() {
+    cached_sets.clear();
+}
+
+void DescriptorHeap::ForgetSet(std::size_t index) {
+    const auto it = cached_sets.find(set_hashes[index]);
+    if (it != cached_sets.end() && it->second == index) {
+        cached_sets.erase(it);
+    }
+}
+
 void DescriptorHeap::AppendDescriptorPool() {
     const vk::DescriptorPoolCreateInfo pool_info = {
         .flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
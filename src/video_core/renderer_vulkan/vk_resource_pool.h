@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "video_core/renderer_vulkan/vk_common.h"
 
 namespace Vulkan {
@@ -48,7 +51,9 @@ protected:
 
 class CommandPool final : public ResourcePool {
 public:
-    explicit CommandPool(const Instance& instance, MasterSemaphore* master_semaphore);
+    explicit CommandPool(const Instance& instance, MasterSemaphore* master_semaphore,
+                         u32 queue_family_index,
+                         vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
     ~CommandPool() override;
 
     void Allocate(std::size_t begin, std::size_t end) override;
@@ -57,6 +62,7 @@ public:
 
 private:
     const Instance& instance;
+    vk::CommandBufferLevel level;
     vk::UniqueCommandPool cmd_pool;
     std::vector<vk::CommandBuffer> cmd_buffers;
 };
@@ -76,9 +82,22 @@ public:
 
     vk::DescriptorSet Commit();
 
+    /**
+     * Returns the descriptor set last committed with the provided hash of its resources when it
+     * has not been recycled yet, or a free one otherwise. The second member is true when the set
+     * was reused and does not need to be written again.
+     */
+    std::pair<vk::DescriptorSet, bool> Commit(u64 hash);
+
+    /// Forgets the resources of the committed descriptor sets, so that none is reused.
+    void ClearCache();
+
 private:
     void AppendDescriptorPool();
 
+    /// Removes the cache entry of a descriptor set that is about to be rewritten.
+    void ForgetSet(std::size_t index);
+
 private:
     vk::Device device;
     vk::UniqueDescriptorSetLayout descriptor_set_layout;
@@ -86,6 +105,8 @@ private:
     std::vector<vk::DescriptorPoolSize> pool_sizes;
     std::vector<vk::UniqueDescriptorPool> pools;
     std::vector<vk::DescriptorSet> descriptor_sets;
+    std::vector<u64> set_hashes;
+    std::unordered_map<u64, std::size_t, Common::IdentityHash<u64>> cached_sets;
 };
 
 } // namespace Vulkan
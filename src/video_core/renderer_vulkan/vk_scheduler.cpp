@@ -3,14 +3,19 @@
 // Refer to the license.txt file included.
 
 #include <mutex>
+#include <thread>
 #include <utility>
+#include "common/assert.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 
 MICROPROFILE_DEFINE(Vulkan_WaitForWorker, "Vulkan", "Wait for worker", MP_RGB(255, 192, 192));
 MICROPROFILE_DEFINE(Vulkan_Submit, "Vulkan", "Submit Exectution", MP_RGB(255, 192, 255));
+MICROPROFILE_DEFINE(Vulkan_WaitForSecondary, "Vulkan", "Wait for secondary",
+                    MP_RGB(255, 128, 192));
 
 namespace Vulkan {
 
@@ -18,7 +23,7 @@ namespace {
 
 std::unique_ptr<MasterSemaphore> MakeMasterSemaphore(const Instance& instance) {
     if (instance.IsTimelineSemaphoreSupported()) {
-        return std::make_unique<MasterSemaphoreTimeline>(instance);
+        return std::make_unique<MasterSemaphoreTimeline>(instance, instance.GetGraphicsQueue());
     } else {
         return std::make_unique<MasterSemaphoreFence>(instance);
     }
@@ -42,10 +47,23 @@ void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf) {
 
 Scheduler::Scheduler(const Instance& instance)
     : master_semaphore{MakeMasterSemaphore(instance)},
-      command_pool{instance, master_semaphore.get()}, use_worker_thread{true} {
+      command_pool{instance, master_semaphore.get(), instance.GetGraphicsQueueFamilyIndex()},
+      use_worker_thread{true} {
     AllocateWorkerCommandBuffers();
     if (use_worker_thread) {
         AcquireNewChunk();
+        // Secondary command buffers are recycled by tick from the recorder threads, which
+        // requires the thread safe refresh of timeline semaphores.
+        if (Settings::values.parallel_command_recording.GetValue() &&
+            instance.IsTimelineSemaphoreSupported()) {
+            const u32 num_recorders = std::clamp(std::thread::hardware_concurrency() / 2, 2U, 4U);
+            recorders = std::make_unique<Common::StatefulThreadWorker<CommandPool>>(
+                num_recorders, "VulkanRecorder", [this, &instance](std::size_t) {
+                    return CommandPool{instance, master_semaphore.get(),
+                                       instance.GetGraphicsQueueFamilyIndex(),
+                                       vk::CommandBufferLevel::eSecondary};
+                });
+        }
         worker_thread = std::jthread([this](std::stop_token token) { WorkerThread(token); });
     }
 }
@@ -98,6 +116,13 @@ void Scheduler::DispatchWork() {
 
     on_dispatch();
 
+    // The chunks of an open render pass are held back until the pass ends.
+    if (secondary) {
+        secondary->chunks.push_back(std::move(chunk));
+        AcquireNewChunk();
+        return;
+    }
+
     {
         std::scoped_lock ql{queue_mutex};
         work_queue.push(std::move(chunk));
@@ -107,6 +132,69 @@ void Scheduler::DispatchWork() {
     AcquireNewChunk();
 }
 
+void Scheduler::BeginSecondary(vk::RenderPass render_pass, vk::Framebuffer framebuffer) {
+    ASSERT(recorders && !secondary);
+    DispatchWork();
+    secondary = std::make_shared<SecondaryRecording>();
+    secondary->render_pass = render_pass;
+    secondary->framebuffer = framebuffer;
+
+    // Secondary command buffers do not inherit any state from the primary one.
+    state = StateFlags::AllDirty;
+}
+
+void Scheduler::EndSecondary() {
+    if (!secondary) {
+        return;
+    }
+    DispatchWork();
+    std::shared_ptr<SecondaryRecording> recording = std::move(secondary);
+    state = StateFlags::AllDirty;
+    if (recording->chunks.empty()) {
+        return;
+    }
+
+    recorders->QueueWork([this, recording](CommandPool* pool) {
+        RecordSecondary(*pool, *recording);
+    });
+    Record([recording](vk::CommandBuffer cmdbuf) {
+        {
+            MICROPROFILE_SCOPE(Vulkan_WaitForSecondary);
+            recording->recorded.Wait();
+        }
+        cmdbuf.executeCommands(recording->cmdbuf);
+    });
+}
+
+void Scheduler::RecordSecondary(CommandPool& pool, SecondaryRecording& recording) {
+    const vk::CommandBufferInheritanceInfo inheritance_info = {
+        .renderPass = recording.render_pass,
+        .subpass = 0,
+        .framebuffer = recording.framebuffer,
+    };
+    const vk::CommandBufferBeginInfo begin_info = {
+        .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                 vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+        .pInheritanceInfo = &inheritance_info,
+    };
+
+    recording.cmdbuf = pool.Commit();
+    recording.cmdbuf.begin(begin_info);
+    for (auto& work : recording.chunks) {
+        work->ExecuteAll(recording.cmdbuf);
+    }
+    recording.cmdbuf.end();
+
+    {
+        std::scoped_lock rl{reserve_mutex};
+        for (auto& work : recording.chunks) {
+            chunk_reserve.emplace_back(std::move(work));
+        }
+    }
+    recording.chunks.clear();
+    recording.recorded.Set();
+}
+
 void Scheduler::WorkerThread(std::stop_token stop_token) {
     Common::SetCurrentThreadName("VulkanWorker");
 
@@ -175,10 +263,14 @@ void Scheduler::SubmitExecution(vk::Semaphore signal_semaphore, vk::Semaphore wa
 
     on_submit();
 
-    Record([signal_semaphore, wait_semaphore, signal_value, this](vk::CommandBuffer cmdbuf) {
+    const u64 wait_value = std::exchange(timeline_wait_value, 0);
+    const vk::Semaphore wait_timeline = wait_value != 0 ? timeline_wait : vk::Semaphore{};
+    Record([signal_semaphore, wait_semaphore, signal_value, wait_timeline, wait_value,
+            this](vk::CommandBuffer cmdbuf) {
         MICROPROFILE_SCOPE(Vulkan_Submit);
         std::scoped_lock lock{submit_mutex};
-        master_semaphore->SubmitWork(cmdbuf, wait_semaphore, signal_semaphore, signal_value);
+        master_semaphore->SubmitWork(cmdbuf, wait_semaphore, signal_semaphore, signal_value,
+                                     wait_timeline, wait_value);
     });
 
     master_semaphore->Refresh();
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
 #include "common/alignment.h"
 #include "common/common_funcs.h"
 #include "common/polyfill_thread.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
 
@@ -57,6 +60,30 @@ public:
         (void)chunk->Record(command);
     }
 
+    /**
+     * Makes the next submission wait for the timeline semaphore to reach value, used to order
+     * rendering after work submitted to other queues.
+     */
+    void WaitTimeline(vk::Semaphore semaphore, u64 value) noexcept {
+        timeline_wait = semaphore;
+        timeline_wait_value = std::max(timeline_wait_value, value);
+    }
+
+    /**
+     * Records the following commands to a secondary command buffer executed inside the given
+     * render pass. The buffer is filled by a recorder thread once the pass ends, so that the
+     * passes of a frame are recorded in parallel and executed in order.
+     */
+    void BeginSecondary(vk::RenderPass render_pass, vk::Framebuffer framebuffer);
+
+    /// Queues the current secondary command buffer and executes it from the primary one.
+    void EndSecondary();
+
+    /// Returns true when render passes are recorded to secondary command buffers.
+    [[nodiscard]] bool IsParallelRecording() const noexcept {
+        return recorders != nullptr;
+    }
+
     /// Marks the provided state as non dirty
     void MarkStateNonDirty(StateFlags flag) noexcept {
         state |= flag;
@@ -183,6 +210,15 @@ private:
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
+    /// The chunks of a render pass, recorded to a secondary command buffer by a recorder thread.
+    struct SecondaryRecording {
+        vk::RenderPass render_pass;
+        vk::Framebuffer framebuffer;
+        vk::CommandBuffer cmdbuf;
+        std::vector<std::unique_ptr<CommandChunk>> chunks;
+        Common::Event recorded;
+    };
+
 private:
     void WorkerThread(std::stop_token stop_token);
 
@@ -192,6 +228,8 @@ private:
 
     void AcquireNewChunk();
 
+    void RecordSecondary(CommandPool& pool, SecondaryRecording& recording);
+
 private:
     std::unique_ptr<MasterSemaphore> master_semaphore;
     CommandPool command_pool;
@@ -202,10 +240,14 @@ private:
     StateFlags state{};
     std::function<void()> on_submit;
     std::function<void()> on_dispatch;
+    vk::Semaphore timeline_wait;
+    u64 timeline_wait_value{};
     std::mutex execution_mutex;
     std::mutex reserve_mutex;
     std::mutex queue_mutex;
     std::condition_variable_any event_cv;
+    std::shared_ptr<SecondaryRecording> secondary;
+    std::unique_ptr<Common::StatefulThreadWorker<CommandPool>> recorders;
     std::jthread worker_thread;
     bool use_worker_thread;
 };
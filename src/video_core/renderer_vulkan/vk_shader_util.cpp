@@ -160,8 +160,8 @@ bool InitializeCompiler() {
 }
 } // Anonymous namespace
 
-vk::ShaderModule Compile(std::string_view code, vk::ShaderStageFlagBits stage, vk::Device device,
-                         std::string_view premable) {
+std::vector<u32> CompileGLSLToSPV(std::string_view code, vk::ShaderStageFlagBits stage,
+                                  std::string_view premable) {
     if (!InitializeCompiler()) {
         return {};
     }
@@ -217,7 +217,16 @@ vk::ShaderModule Compile(std::string_view code, vk::ShaderStageFlagBits stage, v
         LOG_INFO(Render_Vulkan, "SPIR-V conversion messages: {}", spv_messages);
     }
 
-    return CompileSPV(out_code, device);
+    return out_code;
+}
+
+vk::ShaderModule Compile(std::string_view code, vk::ShaderStageFlagBits stage, vk::Device device,
+                         std::string_view premable) {
+    const std::vector<u32> spv_code = CompileGLSLToSPV(code, stage, premable);
+    if (spv_code.empty()) {
+        return {};
+    }
+    return CompileSPV(spv_code, device);
 }
 
 vk::ShaderModule CompileSPV(std::span<const u32> code, vk::Device device) {
@@ -0,0 +1,193 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_staging_allocator.h"
+
+#include <vk_mem_alloc.h>
+
+MICROPROFILE_DEFINE(Vulkan_WaitForStaging, "Vulkan", "Wait for staging", MP_RGB(192, 128, 64));
+
+namespace Vulkan {
+
+using namespace Common::Literals;
+
+namespace {
+
+constexpr u64 RING_SIZE = 32_MiB;
+constexpr std::size_t MAX_RINGS = 16;
+
+/// Requests larger than this would retire most of a ring, so they get their own buffer.
+constexpr u64 DEDICATED_THRESHOLD = RING_SIZE / 2;
+
+} // Anonymous namespace
+
+StagingAllocator::StagingAllocator(const Instance& instance_, Scheduler& scheduler_,
+                                   vk::BufferUsageFlags usage_)
+    : instance{instance_}, scheduler{scheduler_}, usage{usage_} {
+    rings.push_back(CreateBuffer(RING_SIZE));
+}
+
+StagingAllocator::~StagingAllocator() {
+    for (Buffer& ring : rings) {
+        DestroyBuffer(ring);
+    }
+    for (Buffer& buffer : dedicated) {
+        DestroyBuffer(buffer);
+    }
+}
+
+StagingRegion StagingAllocator::Map(u32 size, u64 alignment) {
+    ReleaseDedicated();
+    bytes_moved += size;
+
+    if (size > DEDICATED_THRESHOLD) {
+        Buffer& buffer = dedicated.emplace_back(CreateBuffer(size));
+        buffer.tick = scheduler.CurrentTick();
+        return StagingRegion{
+            .buffer = buffer.buffer,
+            .offset = 0,
+            .mapped = std::span{buffer.mapped, size},
+        };
+    }
+
+    u64 offset = Common::AlignUp(rings[current_ring].offset, std::max<u64>(alignment, 1));
+    if (offset + size > rings[current_ring].size) {
+        NextRing();
+        offset = 0;
+    }
+
+    Buffer& ring = rings[current_ring];
+    ring.offset = offset + size;
+    ring.tick = scheduler.CurrentTick();
+    return StagingRegion{
+        .buffer = ring.buffer,
+        .offset = static_cast<u32>(offset),
+        .mapped = std::span{ring.mapped + offset, size},
+    };
+}
+
+void StagingAllocator::Commit(const StagingRegion& region, u32 size) {
+    const auto owns = [&](const Buffer& buffer) { return buffer.buffer == region.buffer; };
+    auto it = std::ranges::find_if(rings, owns);
+    Buffer& buffer = it != rings.end() ? *it : *std::ranges::find_if(dedicated, owns);
+    vmaFlushAllocation(instance.GetAllocator(), buffer.allocation, region.offset, size);
+
+    // The commands using the region may be recorded after a submission following the map.
+    buffer.tick = scheduler.CurrentTick();
+}
+
+StagingRegion StagingAllocator::Find(std::span<const u8> mapped) const {
+    const auto contains = [&](const Buffer& buffer) {
+        return mapped.data() >= buffer.mapped && mapped.data() < buffer.mapped + buffer.size;
+    };
+    const auto make_region = [&](const Buffer& buffer) {
+        return StagingRegion{
+            .buffer = buffer.buffer,
+            .offset = static_cast<u32>(mapped.data() - buffer.mapped),
+            .mapped = std::span{buffer.mapped + (mapped.data() - buffer.mapped), mapped.size()},
+        };
+    };
+    if (const auto it = std::ranges::find_if(rings, contains); it != rings.end()) {
+        return make_region(*it);
+    }
+    const auto it = std::ranges::find_if(dedicated, contains);
+    ASSERT_MSG(it != dedicated.end(), "Memory does not belong to any staging buffer");
+    return make_region(*it);
+}
+
+StagingAllocator::Stats StagingAllocator::GetAndResetStats() {
+    const Stats stats = {
+        .memory = memory,
+        .rings = static_cast<u32>(rings.size()),
+        .dedicated = static_cast<u32>(dedicated.size()),
+        .stalls = stalls,
+        .bytes_moved = bytes_moved,
+    };
+    stalls = 0;
+    bytes_moved = 0;
+    return stats;
+}
+
+StagingAllocator::Buffer StagingAllocator::CreateBuffer(u64 size) {
+    const vk::BufferCreateInfo buffer_info = {
+        .size = size,
+        .usage = usage,
+    };
+    const VmaAllocationCreateInfo alloc_create_info = {
+        .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                 VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+        .requiredFlags = 0,
+        .preferredFlags = 0,
+        .pool = VK_NULL_HANDLE,
+        .pUserData = nullptr,
+    };
+
+    VkBuffer unsafe_buffer{};
+    VmaAllocation allocation{};
+    VmaAllocationInfo alloc_info{};
+    const VkBufferCreateInfo unsafe_buffer_info = static_cast<VkBufferCreateInfo>(buffer_info);
+    const VkResult result = vmaCreateBuffer(instance.GetAllocator(), &unsafe_buffer_info,
+                                            &alloc_create_info, &unsafe_buffer, &allocation,
+                                            &alloc_info);
+    if (result != VK_SUCCESS) [[unlikely]] {
+        LOG_CRITICAL(Render_Vulkan, "Failed allocating staging buffer with error {}", result);
+        UNREACHABLE();
+    }
+
+    memory += size;
+    if (instance.HasDebuggingToolAttached()) {
+        SetObjectName(instance.GetDevice(), vk::Buffer{unsafe_buffer}, "StagingBuffer: {} KiB",
+                      size / 1024);
+    }
+    return Buffer{
+        .buffer = vk::Buffer{unsafe_buffer},
+        .allocation = allocation,
+        .mapped = static_cast<u8*>(alloc_info.pMappedData),
+        .size = size,
+        .offset = 0,
+        .tick = 0,
+    };
+}
+
+void StagingAllocator::DestroyBuffer(Buffer& buffer) {
+    memory -= buffer.size;
+    vmaDestroyBuffer(instance.GetAllocator(), buffer.buffer, buffer.allocation);
+    buffer = {};
+}
+
+void StagingAllocator::NextRing() {
+    // Rings are used in order, so the next one is always the one the GPU used the longest ago.
+    const std::size_t next_ring = (current_ring + 1) % rings.size();
+    if (next_ring != current_ring && scheduler.IsFree(rings[next_ring].tick)) {
+        current_ring = next_ring;
+    } else if (rings.size() < MAX_RINGS) {
+        current_ring++;
+        rings.insert(rings.begin() + current_ring, CreateBuffer(RING_SIZE));
+        LOG_DEBUG(Render_Vulkan, "Growing upload staging to {} rings", rings.size());
+    } else {
+        MICROPROFILE_SCOPE(Vulkan_WaitForStaging);
+        current_ring = next_ring;
+        scheduler.Wait(rings[current_ring].tick);
+        stalls++;
+    }
+    rings[current_ring].offset = 0;
+}
+
+void StagingAllocator::ReleaseDedicated() {
+    while (!dedicated.empty() && scheduler.IsFree(dedicated.front().tick)) {
+        DestroyBuffer(dedicated.front());
+        dedicated.pop_front();
+    }
+}
+
+} // namespace Vulkan
@@ -0,0 +1,93 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <span>
+#include <vector>
+#include "video_core/renderer_vulkan/vk_common.h"
+
+VK_DEFINE_HANDLE(VmaAllocation)
+
+namespace Vulkan {
+
+class Instance;
+class Scheduler;
+
+/// A region of staging memory, which may be reused once the GPU has executed the tick it was
+/// mapped in.
+struct StagingRegion {
+    vk::Buffer buffer;
+    u32 offset;
+    std::span<u8> mapped;
+};
+
+/**
+ * Hands out persistently mapped host memory for uploads from a set of rings. A full ring is
+ * retired until the GPU is done with it, and the allocator moves on to a free ring or grows
+ * another one instead of waiting. Requests too large for the rings get a dedicated buffer that
+ * is released once the GPU has consumed it.
+ */
+class StagingAllocator {
+public:
+    struct Stats {
+        u64 memory;      ///< Bytes held by the rings and dedicated buffers.
+        u32 rings;       ///< Number of rings allocated.
+        u32 dedicated;   ///< Number of dedicated buffers still in use by the GPU.
+        u32 stalls;      ///< Times a request waited for the GPU since the last query.
+        u64 bytes_moved; ///< Bytes handed out since the last query.
+    };
+
+    explicit StagingAllocator(const Instance& instance, Scheduler& scheduler,
+                              vk::BufferUsageFlags usage);
+    ~StagingAllocator();
+
+    /// Reserves size bytes of staging memory aligned to alignment.
+    StagingRegion Map(u32 size, u64 alignment);
+
+    /// Makes the host writes to the region visible to the GPU.
+    void Commit(const StagingRegion& region, u32 size);
+
+    /// Returns the region that contains the provided mapped memory.
+    StagingRegion Find(std::span<const u8> mapped) const;
+
+    /// Returns the usage statistics and resets the per query counters.
+    Stats GetAndResetStats();
+
+private:
+    struct Buffer {
+        vk::Buffer buffer;
+        VmaAllocation allocation;
+        u8* mapped;
+        u64 size;
+        u64 offset;
+        u64 tick;
+    };
+
+    /// Allocates a persistently mapped buffer of the provided size.
+    Buffer CreateBuffer(u64 size);
+
+    /// Destroys the buffer and releases its memory.
+    void DestroyBuffer(Buffer& buffer);
+
+    /// Switches to a ring the GPU is done with, growing a new one when there is none.
+    void NextRing();
+
+    /// Releases the dedicated buffers the GPU is done with.
+    void ReleaseDedicated();
+
+private:
+    const Instance& instance;
+    Scheduler& scheduler;
+    vk::BufferUsageFlags usage;
+    std::vector<Buffer> rings;
+    std::deque<Buffer> dedicated;
+    std::size_t current_ring{};
+    u64 memory{};
+    u32 stalls{};
+    u64 bytes_moved{};
+};
+
+} // namespace Vulkan
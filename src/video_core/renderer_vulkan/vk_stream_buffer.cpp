@@ -112,6 +112,7 @@ std::tuple<u8*, u32, bool> StreamBuffer::Map(u32 size, u64 alignment) {
     ASSERT(size <= stream_buffer_size);
     mapped_size = size;
 
+    const u32 previous_offset = offset;
     if (alignment > 0) {
         offset = Common::AlignUp(offset, alignment);
     }
@@ -128,6 +129,9 @@ std::tuple<u8*, u32, bool> StreamBuffer::Map(u32 size, u64 alignment) {
         std::swap(previous_watches, current_watches);
         wait_cursor = 0;
         wait_bound = 0;
+        position += stream_buffer_size - previous_offset;
+    } else {
+        position += offset - previous_offset;
     }
 
     const u64 mapped_upper_bound = offset + size;
@@ -157,6 +161,7 @@ void StreamBuffer::Commit(u32 size) {
     }
 
     offset += size;
+    position += size;
 
     if (current_watch_cursor + 1 >= current_watches.size()) {
         // Ensure that there are enough watches.
@@ -167,6 +172,22 @@ void StreamBuffer::Commit(u32 size) {
     watch.tick = scheduler.CurrentTick();
 }
 
+void StreamBuffer::Invalidate(u32 region_offset, u32 region_size) {
+    if (is_coherent) {
+        return;
+    }
+    const u64 atom_size = instance.NonCoherentAtomSize();
+    const u64 begin = Common::AlignDown<u64>(region_offset, atom_size);
+    const u64 end = std::min(Common::AlignUp<u64>(region_offset + region_size, atom_size),
+                             stream_buffer_size);
+    const vk::MappedMemoryRange range = {
+        .memory = memory,
+        .offset = begin,
+        .size = end - begin,
+    };
+    device.invalidateMappedMemoryRanges(range);
+}
+
 void StreamBuffer::CreateBuffers(u64 prefered_size) {
     const vk::Device device = instance.GetDevice();
     const auto memory_properties = instance.GetPhysicalDevice().getMemoryProperties();
@@ -40,6 +40,22 @@ public:
     /// Ensures that "size" bytes of memory are available to the GPU, potentially recording a copy.
     void Commit(u32 size);
 
+    /// Makes the GPU writes to a previously committed region visible to the host.
+    void Invalidate(u32 region_offset, u32 region_size);
+
+    /**
+     * Returns the total amount of bytes the buffer has advanced by, including the space that is
+     * skipped when wrapping around.
+     */
+    u64 Position() const noexcept {
+        return position;
+    }
+
+    /// Returns true when the region mapped at the provided position may have been reused since.
+    bool IsReused(u64 region_position) const noexcept {
+        return position > region_position + stream_buffer_size;
+    }
+
     vk::Buffer Handle() const noexcept {
         return buffer;
     }
@@ -72,6 +88,7 @@ private:
 
     u32 offset{};       ///< Buffer iterator.
     u32 mapped_size{};  ///< Size reserved for the current copy.
+    u64 position{};     ///< Total advance of the buffer iterator.
     bool is_coherent{}; ///< True if the buffer is coherent
 
     std::vector<Watch> current_watches;           ///< Watches recorded in the current iteration.
@@ -75,6 +75,7 @@ void Swapchain::Create(u32 width_, u32 height_, vk::SurfaceKHR surface_) {
 
     SetupImages();
     RefreshSemaphores();
+    present_id = 0;
 }
 
 bool Swapchain::AcquireNextImage() {
@@ -106,7 +107,14 @@ bool Swapchain::AcquireNextImage() {
 }
 
 void Swapchain::Present() {
+    // Present ids let the presentation thread wait for an image to reach the display.
+    const u64 next_present_id = present_id + 1;
+    const vk::PresentIdKHR present_id_info = {
+        .swapchainCount = 1,
+        .pPresentIds = &next_present_id,
+    };
     const vk::PresentInfoKHR present_info = {
+        .pNext = instance.IsPresentWaitSupported() ? &present_id_info : nullptr,
         .waitSemaphoreCount = 1,
         .pWaitSemaphores = &present_ready[image_index],
         .swapchainCount = 1,
@@ -128,9 +136,33 @@ void Swapchain::Present() {
         UNREACHABLE();
     }
 
+    present_id = next_present_id;
     frame_index = (frame_index + 1) % image_count;
 }
 
+std::optional<u64> Swapchain::WaitForPresent(u32 queue_depth) {
+    if (!instance.IsPresentWaitSupported() || needs_recreation || present_id <= queue_depth) {
+        return std::nullopt;
+    }
+
+    // A frame never takes longer than this to be displayed unless the window is hidden, in which
+    // case presentation continues unpaced.
+    constexpr u64 PresentTimeoutNs = 100'000'000;
+    const u64 wait_id = present_id - queue_depth;
+    try {
+        const vk::Result result =
+            instance.GetDevice().waitForPresentKHR(swapchain, wait_id, PresentTimeoutNs);
+        if (result == vk::Result::eSuccess) {
+            return wait_id;
+        }
+    } catch (vk::OutOfDateKHRError&) {
+        needs_recreation = true;
+    } catch (vk::SurfaceLostKHRError&) {
+        needs_recreation = true;
+    }
+    return std::nullopt;
+}
+
 void Swapchain::FindPresentFormat() {
     const auto formats = instance.GetPhysicalDevice().getSurfaceFormatsKHR(surface);
 
@@ -197,6 +229,12 @@ void Swapchain::SetPresentMode() {
         }
         return;
     }
+
+    // The 3DS refresh rate is slightly below 60Hz, so a frame occasionally misses the vblank of
+    // the host display. Relaxed Fifo presents it right away instead of holding it a whole refresh.
+    if (find_mode(vk::PresentModeKHR::eFifoRelaxed)) {
+        present_mode = vk::PresentModeKHR::eFifoRelaxed;
+    }
 }
 
 void Swapchain::SetSurfaceProperties() {
@@ -211,8 +249,9 @@ void Swapchain::SetSurfaceProperties() {
                                  std::min(capabilities.maxImageExtent.height, height));
     }
 
-    // Select number of images in swap chain, we prefer one buffer in the background to work on
-    image_count = capabilities.minImageCount + 1;
+    // Select number of images in swap chain, with as many buffers in the background to work on
+    // as frames may be queued for presentation
+    image_count = capabilities.minImageCount + Settings::values.present_queue_depth.GetValue();
     if (capabilities.maxImageCount > 0) {
         image_count = std::min(image_count, capabilities.maxImageCount);
     }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <mutex>
+#include <optional>
 #include <vector>
 #include "common/common_types.h"
 #include "video_core/renderer_vulkan/vk_common.h"
@@ -28,6 +29,17 @@ public:
     /// Presents the current image and move to the next one
     void Present();
 
+    /**
+     * Waits until no more than queue_depth presented images are waiting to be displayed. Returns
+     * the present id of the image that was displayed, or nothing when there was none to wait for.
+     */
+    std::optional<u64> WaitForPresent(u32 queue_depth);
+
+    /// Returns the present id of the last presented image.
+    u64 GetPresentId() const {
+        return present_id;
+    }
+
     vk::SurfaceKHR GetSurface() const {
         return surface;
     }
@@ -104,6 +116,7 @@ private:
     u32 image_count = 0;
     u32 image_index = 0;
     u32 frame_index = 0;
+    u64 present_id = 0;
     bool needs_recreation = true;
 };
 
@@ -5,6 +5,7 @@
 #include <boost/container/small_vector.hpp>
 #include <boost/container/static_vector.hpp>
 
+#include "common/alignment.h"
 #include "common/literals.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
@@ -16,6 +17,7 @@
 #include "video_core/renderer_vulkan/vk_render_manager.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_texture_runtime.h"
+#include "video_core/renderer_vulkan/vk_transfer_scheduler.h"
 
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan_format_traits.hpp>
@@ -142,11 +144,8 @@ boost::container::small_vector<vk::ImageMemoryBarrier, 3> MakeInitBarriers(
     return barriers;
 }
 
-Handle MakeHandle(const Instance* instance, u32 width, u32 height, u32 levels, TextureType type,
-                  vk::Format format, vk::ImageUsageFlags usage, vk::ImageCreateFlags flags,
-                  vk::ImageAspectFlags aspect, bool need_format_list,
-                  std::string_view debug_name = {}) {
-    const u32 layers = type == TextureType::CubeMap ? 6 : 1;
+Handle MakeHandle(const Instance* instance, VmaPool pool, const HandleInfo& info) {
+    const u32 layers = info.type == TextureType::CubeMap ? 6 : 1;
 
     const std::array format_list = {
         vk::Format::eR8G8B8A8Unorm,
@@ -158,23 +157,23 @@ Handle MakeHandle(const Instance* instance, u32 width, u32 height, u32 levels, T
     };
 
     const vk::ImageCreateInfo image_info = {
-        .pNext = need_format_list ? &image_format_list : nullptr,
-        .flags = flags,
+        .pNext = info.need_format_list ? &image_format_list : nullptr,
+        .flags = info.flags,
         .imageType = vk::ImageType::e2D,
-        .format = format,
-        .extent = {width, height, 1},
-        .mipLevels = levels,
+        .format = info.format,
+        .extent = {info.width, info.height, 1},
+        .mipLevels = info.levels,
         .arrayLayers = layers,
         .samples = vk::SampleCountFlagBits::e1,
-        .usage = usage,
+        .usage = info.usage,
     };
 
-    const VmaAllocationCreateInfo alloc_info = {
+    VmaAllocationCreateInfo alloc_info = {
         .flags = VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT,
         .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
         .requiredFlags = 0,
         .preferredFlags = 0,
-        .pool = VK_NULL_HANDLE,
+        .pool = pool,
         .pUserData = nullptr,
     };
 
@@ -184,6 +183,12 @@ Handle MakeHandle(const Instance* instance, u32 width, u32 height, u32 levels, T
 
     VkResult result = vmaCreateImage(instance->GetAllocator(), &unsafe_image_info, &alloc_info,
                                      &unsafe_image, &allocation, nullptr);
+    if (result != VK_SUCCESS && pool) {
+        // The memory type of the pool may not suit every format, use the default pools then.
+        alloc_info.pool = VK_NULL_HANDLE;
+        result = vmaCreateImage(instance->GetAllocator(), &unsafe_image_info, &alloc_info,
+                                &unsafe_image, &allocation, nullptr);
+    }
     if (result != VK_SUCCESS) [[unlikely]] {
         LOG_CRITICAL(Render_Vulkan, "Failed allocating image with error {}", result);
         UNREACHABLE();
@@ -193,31 +198,69 @@ Handle MakeHandle(const Instance* instance, u32 width, u32 height, u32 levels, T
     const vk::ImageViewCreateInfo view_info = {
         .image = image,
         .viewType =
-            type == TextureType::CubeMap ? vk::ImageViewType::eCube : vk::ImageViewType::e2D,
-        .format = format,
+            info.type == TextureType::CubeMap ? vk::ImageViewType::eCube : vk::ImageViewType::e2D,
+        .format = info.format,
         .subresourceRange{
-            .aspectMask = aspect,
+            .aspectMask = info.aspect,
             .baseMipLevel = 0,
-            .levelCount = levels,
+            .levelCount = info.levels,
             .baseArrayLayer = 0,
             .layerCount = layers,
         },
     };
     vk::UniqueImageView image_view = instance->GetDevice().createImageViewUnique(view_info);
 
-    if (!debug_name.empty() && instance->HasDebuggingToolAttached()) {
-        SetObjectName(instance->GetDevice(), image, debug_name);
-        SetObjectName(instance->GetDevice(), image_view.get(), "{} View({})", debug_name,
-                      vk::to_string(aspect));
-    }
-
     return Handle{
         .alloc = allocation,
         .image = image,
         .image_view = std::move(image_view),
+        .hash = info.Hash(),
     };
 }
 
+void SetHandleName(const Instance* instance, const Handle& handle, vk::ImageAspectFlags aspect,
+                   std::string_view debug_name) {
+    if (debug_name.empty() || !instance->HasDebuggingToolAttached()) {
+        return;
+    }
+    SetObjectName(instance->GetDevice(), handle.image, debug_name);
+    SetObjectName(instance->GetDevice(), handle.image_view.get(), "{} View({})", debug_name,
+                  vk::to_string(aspect));
+}
+
+/// Creates a memory pool in the memory type chosen for RGBA8 images of the usage class.
+VmaPool MakeImagePool(const Instance& instance, vk::ImageUsageFlags usage) {
+    const vk::ImageCreateInfo image_info = {
+        .imageType = vk::ImageType::e2D,
+        .format = vk::Format::eR8G8B8A8Unorm,
+        .extent = {512, 512, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = vk::SampleCountFlagBits::e1,
+        .usage = usage,
+    };
+    const VmaAllocationCreateInfo alloc_info = {
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+    };
+
+    const VkImageCreateInfo unsafe_image_info = static_cast<VkImageCreateInfo>(image_info);
+    u32 memory_type_index{};
+    if (vmaFindMemoryTypeIndexForImageInfo(instance.GetAllocator(), &unsafe_image_info,
+                                           &alloc_info, &memory_type_index) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    const VmaPoolCreateInfo pool_info = {
+        .memoryTypeIndex = memory_type_index,
+    };
+    VmaPool pool{};
+    if (vmaCreatePool(instance.GetAllocator(), &pool_info, &pool) != VK_SUCCESS) {
+        LOG_WARNING(Render_Vulkan, "Unable to create image memory pool");
+        return VK_NULL_HANDLE;
+    }
+    return pool;
+}
+
 vk::UniqueFramebuffer MakeFramebuffer(vk::Device device, vk::RenderPass render_pass, u32 width,
                                       u32 height, std::span<const vk::ImageView> attachments) {
     const vk::FramebufferCreateInfo framebuffer_info = {
@@ -242,29 +285,108 @@ vk::ImageSubresourceRange MakeSubresourceRange(vk::ImageAspectFlags aspect, u32
     };
 }
 
-constexpr u64 UPLOAD_BUFFER_SIZE = 512_MiB;
 constexpr u64 DOWNLOAD_BUFFER_SIZE = 16_MiB;
+constexpr u64 DECODE_BUFFER_SIZE = 32_MiB;
+
+/// Images of destroyed surfaces kept for reuse are capped, evicted surfaces should free memory.
+constexpr u64 RECYCLED_MEMORY_LIMIT = 128_MiB;
 
 } // Anonymous namespace
 
+u64 HandleInfo::Hash() const noexcept {
+    const std::array<u32, 9> key = {
+        width,
+        height,
+        levels,
+        static_cast<u32>(type),
+        static_cast<u32>(format),
+        static_cast<VkImageUsageFlags>(usage),
+        static_cast<VkImageCreateFlags>(flags),
+        static_cast<VkImageAspectFlags>(aspect),
+        need_format_list,
+    };
+    return Common::ComputeHash64(key.data(), sizeof(key));
+}
+
 TextureRuntime::TextureRuntime(const Instance& instance, Scheduler& scheduler,
                                RenderManager& renderpass_cache, DescriptorUpdateQueue& update_queue,
                                u32 num_swapchain_images_)
     : instance{instance}, scheduler{scheduler}, renderpass_cache{renderpass_cache},
       blit_helper{instance, scheduler, renderpass_cache, update_queue},
-      upload_buffer{instance, scheduler, vk::BufferUsageFlagBits::eTransferSrc, UPLOAD_BUFFER_SIZE,
-                    BufferType::Upload},
+      upload_staging{instance, scheduler,
+                     vk::BufferUsageFlagBits::eTransferSrc |
+                         vk::BufferUsageFlagBits::eStorageBuffer},
       download_buffer{instance, scheduler,
                       vk::BufferUsageFlagBits::eTransferDst |
                           vk::BufferUsageFlagBits::eStorageBuffer,
                       DOWNLOAD_BUFFER_SIZE, BufferType::Download},
-      num_swapchain_images{num_swapchain_images_} {}
+      decode_buffer{instance, scheduler, vk::BufferUsageFlagBits::eStorageBuffer,
+                    DECODE_BUFFER_SIZE, BufferType::Upload},
+      num_swapchain_images{num_swapchain_images_} {
+    if (instance.HasDedicatedTransferQueue() && instance.IsTimelineSemaphoreSupported()) {
+        transfer_scheduler = std::make_unique<TransferScheduler>(instance);
+    }
+    constexpr vk::ImageUsageFlags sampled_usage =
+        vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferSrc |
+        vk::ImageUsageFlagBits::eTransferDst;
+    image_pools[static_cast<std::size_t>(ImagePool::RenderTarget)] =
+        MakeImagePool(instance, sampled_usage | vk::ImageUsageFlagBits::eColorAttachment);
+    image_pools[static_cast<std::size_t>(ImagePool::Sampled)] =
+        MakeImagePool(instance, sampled_usage);
+}
+
+TextureRuntime::~TextureRuntime() {
+    for (auto& [hash, handle] : recycled_handles) {
+        handle.image_view.reset();
+        vmaDestroyImage(instance.GetAllocator(), handle.image, handle.alloc);
+    }
+    recycled_handles.clear();
+    for (const VmaPool pool : image_pools) {
+        if (pool) {
+            vmaDestroyPool(instance.GetAllocator(), pool);
+        }
+    }
+}
+
+Handle TextureRuntime::AcquireHandle(const HandleInfo& info, std::string_view debug_name) {
+    Handle handle{};
+    if (const auto it = recycled_handles.find(info.Hash()); it != recycled_handles.end()) {
+        handle = std::move(it->second);
+        recycled_handles.erase(it);
+        VmaAllocationInfo alloc_info{};
+        vmaGetAllocationInfo(instance.GetAllocator(), handle.alloc, &alloc_info);
+        recycled_memory -= std::min<u64>(recycled_memory, alloc_info.size);
+    } else {
+        MICROPROFILE_SCOPE(Vulkan_ImageAlloc);
+        handle = MakeHandle(&instance, image_pools[static_cast<std::size_t>(info.pool)], info);
+    }
+    SetHandleName(&instance, handle, info.aspect, debug_name);
+    return handle;
+}
 
-TextureRuntime::~TextureRuntime() = default;
+void TextureRuntime::RecycleHandle(Handle&& handle) {
+    VmaAllocationInfo alloc_info{};
+    vmaGetAllocationInfo(instance.GetAllocator(), handle.alloc, &alloc_info);
+    if (recycled_memory + alloc_info.size > RECYCLED_MEMORY_LIMIT) {
+        handle.image_view.reset();
+        vmaDestroyImage(instance.GetAllocator(), handle.image, handle.alloc);
+        return;
+    }
+    recycled_memory += alloc_info.size;
+    const u64 hash = handle.hash;
+    recycled_handles.emplace(hash, std::move(handle));
+}
 
 VideoCore::StagingData TextureRuntime::FindStaging(u32 size, bool upload) {
-    StreamBuffer& buffer = upload ? upload_buffer : download_buffer;
-    const auto [data, offset, invalidate] = buffer.Map(size, 16);
+    if (upload) {
+        const StagingRegion region = upload_staging.Map(size, 16);
+        return VideoCore::StagingData{
+            .size = size,
+            .offset = region.offset,
+            .mapped = region.mapped,
+        };
+    }
+    const auto [data, offset, invalidate] = download_buffer.Map(size, 16);
     return VideoCore::StagingData{
         .size = size,
         .offset = offset,
@@ -272,10 +394,127 @@ VideoCore::StagingData TextureRuntime::FindStaging(u32 size, bool upload) {
     };
 }
 
+bool TextureRuntime::DecodeTexture(const VideoCore::SurfaceParams& params,
+                                   std::span<const u8> source,
+                                   const VideoCore::StagingData& staging, bool convert) {
+    // Only whole tiles of color textures that are decoded to 4 bytes per pixel are handled, the
+    // remaining formats are uploaded as is or need depth stencil de-interleaving.
+    const u32 source_size = static_cast<u32>(source.size());
+    if (!params.is_tiled ||
+        (params.type != SurfaceType::Color && params.type != SurfaceType::Texture) ||
+        staging.size != params.width * params.height * 4 ||
+        source_size != params.BytesInPixels(params.width * params.height) ||
+        source_size > DECODE_BUFFER_SIZE) {
+        return false;
+    }
+
+    const u64 alignment = std::max<u64>(instance.StorageMinAlignment(), 4);
+    const auto [data, offset, invalidate] = decode_buffer.Map(source_size, alignment);
+    std::memcpy(data, source.data(), source_size);
+    decode_buffer.Commit(source_size);
+
+    blit_helper.DecodeTexture(params, convert, decode_buffer.Handle(), offset, source_size,
+                              upload_staging.Find(staging.mapped).buffer, staging.offset,
+                              staging.size);
+    return true;
+}
+
+bool TextureRuntime::EncodeTexture(Surface& surface, const VideoCore::SurfaceParams& params,
+                                   std::span<u8> dest, bool convert) {
+    // The encoded data is read back in whole tiles, so partial flushes, depth formats and the
+    // formats that are not stored with 4 bytes per pixel are left to the CPU.
+    const u32 linear_size = params.width * params.height * 4;
+    const u32 encoded_size = static_cast<u32>(dest.size());
+    const u32 encoded_offset = Common::AlignUp(linear_size, 16);
+    if (!params.is_tiled || params.type != SurfaceType::Color ||
+        surface.GetInternalBytesPerPixel() != 4 ||
+        encoded_size != params.BytesInPixels(params.width * params.height) ||
+        encoded_offset + encoded_size > DOWNLOAD_BUFFER_SIZE) {
+        return false;
+    }
+
+    const u32 total_size = encoded_offset + encoded_size;
+    const u64 alignment = std::max<u64>(instance.StorageMinAlignment(), 16);
+    const auto [data, offset, invalidate] = download_buffer.Map(total_size, alignment);
+    const VideoCore::BufferTextureCopy download = {
+        .buffer_offset = offset,
+        .buffer_size = linear_size,
+        .texture_rect = surface.GetSubRect(params),
+        .texture_level = surface.LevelOf(params.addr),
+    };
+    surface.RecordDownload(download);
+
+    const vk::Buffer buffer = download_buffer.Handle();
+    blit_helper.EncodeTexture(params, convert, buffer, offset, linear_size, buffer,
+                              offset + encoded_offset, encoded_size);
+
+    scheduler.Finish();
+    download_buffer.Commit(total_size);
+    std::memcpy(dest.data(), data + encoded_offset, encoded_size);
+    return true;
+}
+
+bool TextureRuntime::DownloadAsync(Surface& surface, const VideoCore::SurfaceParams& params,
+                                   VideoCore::PendingDownload& pending) {
+    // Larger downloads would leave little room for the others before the staging is reused.
+    const u32 size = params.width * params.height * surface.GetInternalBytesPerPixel();
+    if (size > DOWNLOAD_BUFFER_SIZE / 4) {
+        return false;
+    }
+
+    pending.staging = FindStaging(size, false);
+    pending.position = download_buffer.Position();
+    const VideoCore::BufferTextureCopy download = {
+        .buffer_offset = pending.staging.offset,
+        .buffer_size = size,
+        .texture_rect = surface.GetSubRect(params),
+        .texture_level = surface.LevelOf(params.addr),
+    };
+    surface.RecordDownload(download);
+    download_buffer.Commit(size);
+
+    pending.fence = scheduler.CurrentTick();
+    scheduler.Flush();
+    return true;
+}
+
+bool TextureRuntime::FinishDownload(const VideoCore::PendingDownload& pending) {
+    if (download_buffer.IsReused(pending.position)) {
+        return false;
+    }
+    scheduler.Wait(pending.fence);
+    download_buffer.Invalidate(pending.staging.offset, pending.staging.size);
+    return true;
+}
+
 u32 TextureRuntime::RemoveThreshold() {
     return num_swapchain_images;
 }
 
+u64 TextureRuntime::SurfaceMemoryBudget(u64 surface_memory) const {
+    if (!instance.IsMemoryBudgetSupported()) {
+        return 0;
+    }
+    const VkPhysicalDeviceMemoryProperties* properties{};
+    vmaGetMemoryProperties(instance.GetAllocator(), &properties);
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(instance.GetAllocator(), budgets.data());
+
+    u64 budget = 0;
+    u64 usage = 0;
+    for (u32 i = 0; i < properties->memoryHeapCount; i++) {
+        if (properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            budget += budgets[i].budget;
+            usage += budgets[i].usage;
+        }
+    }
+    // Leave some headroom for the driver and for the memory the rest of the renderer may still
+    // allocate, which is everything not taken by surfaces or kept for their reuse.
+    const u64 other_usage = usage - std::min(usage, surface_memory + recycled_memory);
+    const u64 usable = budget * 9 / 10;
+    return usable > other_usage ? usable - other_usage : 1;
+}
+
 void TextureRuntime::Finish() {
     scheduler.Finish();
 }
@@ -553,6 +792,117 @@ bool TextureRuntime::CopyTextures(Surface& source, Surface& dest,
     return true;
 }
 
+void TextureRuntime::CopyCubeFaces(std::span<Surface* const, 6> faces, Surface& cube,
+                                   u32 levels) {
+    renderpass_cache.EndRendering();
+
+    // All faces are copied with a single pair of barriers, instead of a pair per face.
+    struct FaceCopies {
+        vk::Image image;
+        boost::container::static_vector<vk::ImageCopy, VideoCore::MAX_PICA_LEVELS> copies;
+    };
+    boost::container::static_vector<FaceCopies, 6> face_copies;
+    boost::container::static_vector<vk::ImageMemoryBarrier, 7> pre_barriers;
+    boost::container::static_vector<vk::ImageMemoryBarrier, 7> post_barriers;
+    vk::PipelineStageFlags pipeline_flags = cube.PipelineStageFlags();
+    const vk::ImageAspectFlags aspect = cube.Aspect();
+
+    for (u32 layer = 0; layer < faces.size(); layer++) {
+        Surface* face = faces[layer];
+        if (!face) {
+            continue;
+        }
+        const vk::Image image = face->Image();
+        const bool has_barrier = std::ranges::any_of(
+            face_copies, [image](const FaceCopies& other) { return other.image == image; });
+        FaceCopies& face_copy = face_copies.emplace_back();
+        face_copy.image = image;
+        for (u32 level = 0; level < levels; level++) {
+            const u32 width_lod = face->GetScaledWidth() >> level;
+            face_copy.copies.push_back(vk::ImageCopy{
+                .srcSubresource{
+                    .aspectMask = aspect,
+                    .mipLevel = level,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+                .srcOffset = {0, 0, 0},
+                .dstSubresource{
+                    .aspectMask = aspect,
+                    .mipLevel = level,
+                    .baseArrayLayer = layer,
+                    .layerCount = 1,
+                },
+                .dstOffset = {0, 0, 0},
+                .extent = {width_lod, width_lod, 1},
+            });
+        }
+
+        // The same surface may back several faces, its layout must only be transitioned once.
+        if (has_barrier) {
+            continue;
+        }
+        pipeline_flags |= face->PipelineStageFlags();
+        pre_barriers.push_back(vk::ImageMemoryBarrier{
+            .srcAccessMask = face->AccessFlags(),
+            .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+            .oldLayout = vk::ImageLayout::eGeneral,
+            .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange = MakeSubresourceRange(aspect, 0, VK_REMAINING_MIP_LEVELS),
+        });
+        post_barriers.push_back(vk::ImageMemoryBarrier{
+            .srcAccessMask = vk::AccessFlagBits::eNone,
+            .dstAccessMask = vk::AccessFlagBits::eNone,
+            .oldLayout = vk::ImageLayout::eTransferSrcOptimal,
+            .newLayout = vk::ImageLayout::eGeneral,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange = MakeSubresourceRange(aspect, 0, VK_REMAINING_MIP_LEVELS),
+        });
+    }
+    if (face_copies.empty()) {
+        return;
+    }
+
+    const vk::Image cube_image = cube.Image();
+    pre_barriers.push_back(vk::ImageMemoryBarrier{
+        .srcAccessMask = cube.AccessFlags(),
+        .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .oldLayout = vk::ImageLayout::eGeneral,
+        .newLayout = vk::ImageLayout::eTransferDstOptimal,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = cube_image,
+        .subresourceRange = MakeSubresourceRange(aspect, 0, VK_REMAINING_MIP_LEVELS),
+    });
+    post_barriers.push_back(vk::ImageMemoryBarrier{
+        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .dstAccessMask = cube.AccessFlags(),
+        .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+        .newLayout = vk::ImageLayout::eGeneral,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = cube_image,
+        .subresourceRange = MakeSubresourceRange(aspect, 0, VK_REMAINING_MIP_LEVELS),
+    });
+
+    scheduler.Record([pipeline_flags, cube_image, face_copies = std::move(face_copies),
+                      pre_barriers, post_barriers](vk::CommandBuffer cmdbuf) {
+        cmdbuf.pipelineBarrier(pipeline_flags, vk::PipelineStageFlagBits::eTransfer,
+                               vk::DependencyFlagBits::eByRegion, {}, {}, pre_barriers);
+        for (const FaceCopies& face_copy : face_copies) {
+            cmdbuf.copyImage(face_copy.image, vk::ImageLayout::eTransferSrcOptimal, cube_image,
+                             vk::ImageLayout::eTransferDstOptimal, face_copy.copies);
+        }
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, pipeline_flags,
+                               vk::DependencyFlagBits::eByRegion, {}, {}, post_barriers);
+    });
+}
+
 bool TextureRuntime::BlitTextures(Surface& source, Surface& dest,
                                   const VideoCore::TextureBlit& blit) {
     const bool is_depth_stencil = source.type == VideoCore::SurfaceType::DepthStencil;
@@ -689,6 +1039,10 @@ void TextureRuntime::GenerateMipmaps(Surface& surface) {
     }
 }
 
+bool TextureRuntime::IsCustomFormatSupported(VideoCore::CustomPixelFormat format) const {
+    return instance.GetTraits(format).transfer_support;
+}
+
 bool TextureRuntime::NeedsConversion(VideoCore::PixelFormat format) const {
     const FormatTraits traits = instance.GetTraits(format);
     return traits.needs_conversion &&
@@ -721,14 +1075,26 @@ Surface::Surface(TextureRuntime& runtime_, const VideoCore::SurfaceParams& param
     }
 
     const bool need_format_list = is_mutable && instance->IsImageFormatListSupported();
-    handles[0] = MakeHandle(instance, width, height, levels, texture_type, format, traits.usage,
-                            flags, traits.aspect, need_format_list, DebugName(false));
+    HandleInfo info = {
+        .width = width,
+        .height = height,
+        .levels = levels,
+        .type = texture_type,
+        .format = format,
+        .usage = traits.usage,
+        .flags = flags,
+        .aspect = traits.aspect,
+        .need_format_list = need_format_list,
+        .pool = ImagePool::Sampled,
+    };
+    handles[0] = runtime->AcquireHandle(info, DebugName(false));
     raw_images.emplace_back(handles[0].image);
 
     if (res_scale != 1) {
-        handles[1] =
-            MakeHandle(instance, GetScaledWidth(), GetScaledHeight(), levels, texture_type, format,
-                       traits.usage, flags, traits.aspect, need_format_list, DebugName(true));
+        info.width = GetScaledWidth();
+        info.height = GetScaledHeight();
+        info.pool = ImagePool::RenderTarget;
+        handles[1] = runtime->AcquireHandle(info, DebugName(true));
         raw_images.emplace_back(handles[1].image);
     }
 
@@ -752,7 +1118,7 @@ Surface::Surface(TextureRuntime& runtime_, const VideoCore::SurfaceBase& surface
     const bool has_normal = mat && mat->Map(MapType::Normal);
     const vk::Format format = traits.native;
 
-    boost::container::static_vector<vk::Image, 2> raw_images;
+    boost::container::static_vector<vk::Image, 3> raw_images;
 
     vk::ImageCreateFlags flags{};
     if (texture_type == VideoCore::TextureType::CubeMap) {
@@ -760,20 +1126,38 @@ Surface::Surface(TextureRuntime& runtime_, const VideoCore::SurfaceBase& surface
     }
 
     const std::string debug_name = DebugName(false, true);
-    handles[0] = MakeHandle(instance, mat->width, mat->height, levels, texture_type, format,
-                            traits.usage, flags, traits.aspect, false, debug_name);
+    HandleInfo info = {
+        .width = mat->width,
+        .height = mat->height,
+        .levels = levels,
+        .type = texture_type,
+        .format = format,
+        .usage = traits.usage,
+        .flags = flags,
+        .aspect = traits.aspect,
+        .need_format_list = false,
+        .pool = ImagePool::Sampled,
+    };
+    handles[0] = runtime->AcquireHandle(info, debug_name);
     raw_images.emplace_back(handles[0].image);
 
+    if (has_normal) {
+        handles[2] = runtime->AcquireHandle(info, debug_name);
+        raw_images.emplace_back(handles[2].image);
+    }
     if (res_scale != 1) {
-        handles[1] = MakeHandle(instance, mat->width, mat->height, levels, texture_type,
-                                vk::Format::eR8G8B8A8Unorm, traits.usage, flags, traits.aspect,
-                                false, debug_name);
+        info.format = vk::Format::eR8G8B8A8Unorm;
+        handles[1] = runtime->AcquireHandle(info, debug_name);
         raw_images.emplace_back(handles[1].image);
     }
-    if (has_normal) {
-        handles[2] = MakeHandle(instance, mat->width, mat->height, levels, texture_type, format,
-                                traits.usage, flags, traits.aspect, false, debug_name);
-        raw_images.emplace_back(handles[2].image);
+
+    // Material images are initialized by their first upload when it runs on the transfer queue.
+    transfer_init = runtime->transfer_scheduler != nullptr;
+    if (transfer_init) {
+        raw_images.clear();
+        if (handles[1].image) {
+            raw_images.emplace_back(handles[1].image);
+        }
     }
 
     runtime->renderpass_cache.EndRendering();
@@ -792,13 +1176,15 @@ Surface::~Surface() {
     if (!handles[0].image_view) {
         return;
     }
-    for (const auto& [alloc, image, image_view] : handles) {
-        if (image) {
-            vmaDestroyImage(instance->GetAllocator(), image, alloc);
+    // Descriptor sets cached with the views of the surface can no longer be bound.
+    runtime->image_view_generation++;
+    for (Handle& handle : handles) {
+        if (handle.image) {
+            runtime->RecycleHandle(std::move(handle));
         }
     }
     if (copy_handle.image_view) {
-        vmaDestroyImage(instance->GetAllocator(), copy_handle.image, copy_handle.alloc);
+        runtime->RecycleHandle(std::move(copy_handle));
     }
 }
 
@@ -813,8 +1199,9 @@ void Surface::Upload(const VideoCore::BufferTextureCopy& upload,
         .src_image = Image(0),
     };
 
-    scheduler->Record([buffer = runtime->upload_buffer.Handle(), format = traits.native, params,
-                       staging, upload](vk::CommandBuffer cmdbuf) {
+    const StagingRegion region = runtime->upload_staging.Find(staging.mapped);
+    scheduler->Record([buffer = region.buffer, format = traits.native, params, staging,
+                       upload](vk::CommandBuffer cmdbuf) {
         boost::container::static_vector<vk::BufferImageCopy, 2> buffer_image_copies;
 
         const auto rect = upload.texture_rect;
@@ -873,7 +1260,7 @@ void Surface::Upload(const VideoCore::BufferTextureCopy& upload,
                                vk::DependencyFlagBits::eByRegion, {}, {}, write_barrier);
     });
 
-    runtime->upload_buffer.Commit(staging.size);
+    runtime->upload_staging.Commit(region, staging.size);
 
     if (res_scale != 1) {
         const VideoCore::TextureBlit blit = {
@@ -888,6 +1275,11 @@ void Surface::Upload(const VideoCore::BufferTextureCopy& upload,
 }
 
 void Surface::UploadCustom(const VideoCore::Material* material, u32 level) {
+    if (std::exchange(transfer_init, false)) {
+        UploadCustomTransfer(material, level);
+        return;
+    }
+
     const u32 width = material->width;
     const u32 height = material->height;
     const auto color = material->textures[0];
@@ -902,12 +1294,12 @@ void Surface::UploadCustom(const VideoCore::Material* material, u32 level) {
             .src_image = Image(index),
         };
 
-        const auto [data, offset, invalidate] = runtime->upload_buffer.Map(custom_size, 0);
-        std::memcpy(data, texture->data.data(), custom_size);
-        runtime->upload_buffer.Commit(custom_size);
+        const StagingRegion region = runtime->upload_staging.Map(custom_size, 0);
+        std::memcpy(region.mapped.data(), texture->data.data(), custom_size);
+        runtime->upload_staging.Commit(region, custom_size);
 
-        scheduler->Record([buffer = runtime->upload_buffer.Handle(), level, params, rect,
-                           offset = offset](vk::CommandBuffer cmdbuf) {
+        scheduler->Record([buffer = region.buffer, level, params, rect,
+                           offset = region.offset](vk::CommandBuffer cmdbuf) {
             const vk::BufferImageCopy buffer_image_copy = {
                 .bufferOffset = offset,
                 .bufferRowLength = 0,
@@ -965,6 +1357,89 @@ void Surface::UploadCustom(const VideoCore::Material* material, u32 level) {
     }
 }
 
+void Surface::UploadCustomTransfer(const VideoCore::Material* material, u32 level) {
+    TransferScheduler& transfer_scheduler = *runtime->transfer_scheduler;
+    const vk::CommandBuffer cmdbuf = transfer_scheduler.CommandBuffer();
+    const vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor;
+    const Common::Rectangle rect{0U, material->height, material->width, 0U};
+
+    boost::container::static_vector<vk::ImageMemoryBarrier, 2> release_barriers;
+    for (u32 i = 0; i < VideoCore::MAX_MAPS; i++) {
+        const VideoCore::CustomTexture* texture = material->textures[i];
+        if (!texture) {
+            continue;
+        }
+        const vk::Image image = Image(i == 0 ? 0 : i + 1);
+
+        // The staging memory is reused once the graphics submission of this tick completes,
+        // which waits for the transfer below.
+        const u32 custom_size = static_cast<u32>(texture->data.size());
+        const StagingRegion region = runtime->upload_staging.Map(custom_size, 0);
+        std::memcpy(region.mapped.data(), texture->data.data(), custom_size);
+        runtime->upload_staging.Commit(region, custom_size);
+
+        // The images have never been used, so all levels start from the undefined layout.
+        const vk::ImageMemoryBarrier init_barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eNone,
+            .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .oldLayout = vk::ImageLayout::eUndefined,
+            .newLayout = vk::ImageLayout::eTransferDstOptimal,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange = MakeSubresourceRange(aspect, 0, levels),
+        };
+        const vk::BufferImageCopy buffer_image_copy = {
+            .bufferOffset = region.offset,
+            .bufferRowLength = 0,
+            .bufferImageHeight = rect.GetHeight(),
+            .imageSubresource{
+                .aspectMask = aspect,
+                .mipLevel = level,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+            .imageOffset = {0, 0, 0},
+            .imageExtent = {rect.GetWidth(), rect.GetHeight(), 1},
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
+                               vk::PipelineStageFlagBits::eTransfer,
+                               vk::DependencyFlagBits::eByRegion, {}, {}, init_barrier);
+        cmdbuf.copyBufferToImage(region.buffer, image,
+                                 vk::ImageLayout::eTransferDstOptimal, buffer_image_copy);
+
+        // Hand the images over to the graphics queue in the layout the runtime expects.
+        release_barriers.push_back(vk::ImageMemoryBarrier{
+            .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .dstAccessMask = vk::AccessFlagBits::eNone,
+            .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+            .newLayout = vk::ImageLayout::eGeneral,
+            .srcQueueFamilyIndex = instance->GetTransferQueueFamilyIndex(),
+            .dstQueueFamilyIndex = instance->GetGraphicsQueueFamilyIndex(),
+            .image = image,
+            .subresourceRange = MakeSubresourceRange(aspect, 0, levels),
+        });
+    }
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eBottomOfPipe,
+                           vk::DependencyFlagBits::eByRegion, {}, {}, release_barriers);
+
+    const u64 transfer_tick = transfer_scheduler.Submit();
+    scheduler->WaitTimeline(transfer_scheduler.Handle(), transfer_tick);
+
+    // The matching acquire runs on the graphics queue before anything else uses the images.
+    runtime->renderpass_cache.EndRendering();
+    scheduler->Record([barriers = release_barriers, pipeline_flags = PipelineStageFlags(),
+                       access = AccessFlags()](vk::CommandBuffer cmdbuf) mutable {
+        for (vk::ImageMemoryBarrier& barrier : barriers) {
+            barrier.srcAccessMask = vk::AccessFlagBits::eNone;
+            barrier.dstAccessMask = access;
+        }
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, pipeline_flags,
+                               vk::DependencyFlagBits::eByRegion, {}, {}, barriers);
+    });
+}
+
 void Surface::Download(const VideoCore::BufferTextureCopy& download,
                        const VideoCore::StagingData& staging) {
     SCOPE_EXIT({
@@ -972,6 +1447,10 @@ void Surface::Download(const VideoCore::BufferTextureCopy& download,
         runtime->download_buffer.Commit(staging.size);
     });
 
+    RecordDownload(download);
+}
+
+void Surface::RecordDownload(const VideoCore::BufferTextureCopy& download) {
     runtime->renderpass_cache.EndRendering();
 
     if (pixel_format == PixelFormat::D24S8) {
@@ -1068,9 +1547,19 @@ void Surface::ScaleUp(u32 new_scale) {
         flags |= vk::ImageCreateFlagBits::eMutableFormat;
     }
 
-    handles[1] =
-        MakeHandle(instance, GetScaledWidth(), GetScaledHeight(), levels, texture_type,
-                   traits.native, traits.usage, flags, traits.aspect, false, DebugName(true));
+    const HandleInfo info = {
+        .width = GetScaledWidth(),
+        .height = GetScaledHeight(),
+        .levels = levels,
+        .type = texture_type,
+        .format = traits.native,
+        .usage = traits.usage,
+        .flags = flags,
+        .aspect = traits.aspect,
+        .need_format_list = false,
+        .pool = ImagePool::RenderTarget,
+    };
+    handles[1] = runtime->AcquireHandle(info, DebugName(true));
 
     runtime->renderpass_cache.EndRendering();
     scheduler->Record(
@@ -1144,9 +1633,19 @@ vk::ImageView Surface::CopyImageView() noexcept {
         if (texture_type == VideoCore::TextureType::CubeMap) {
             flags |= vk::ImageCreateFlagBits::eCubeCompatible;
         }
-        copy_handle =
-            MakeHandle(instance, GetScaledWidth(), GetScaledHeight(), levels, texture_type,
-                       traits.native, traits.usage, flags, traits.aspect, false);
+        const HandleInfo info = {
+            .width = GetScaledWidth(),
+            .height = GetScaledHeight(),
+            .levels = levels,
+            .type = texture_type,
+            .format = traits.native,
+            .usage = traits.usage,
+            .flags = flags,
+            .aspect = traits.aspect,
+            .need_format_list = false,
+            .pool = ImagePool::RenderTarget,
+        };
+        copy_handle = runtime->AcquireHandle(info);
         copy_layout = vk::ImageLayout::eUndefined;
     }
 
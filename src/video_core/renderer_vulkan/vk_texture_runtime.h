@@ -5,15 +5,20 @@
 #pragma once
 
 #include <deque>
+#include <memory>
 #include <span>
+#include <unordered_map>
+#include "common/hash.h"
 #include "video_core/rasterizer_cache/framebuffer_base.h"
 #include "video_core/rasterizer_cache/rasterizer_cache_base.h"
 #include "video_core/rasterizer_cache/surface_base.h"
 #include "video_core/renderer_vulkan/vk_blit_helper.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_staging_allocator.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
 
 VK_DEFINE_HANDLE(VmaAllocation)
+VK_DEFINE_HANDLE(VmaPool)
 
 namespace VideoCore {
 struct Material;
@@ -25,11 +30,36 @@ class Instance;
 class RenderManager;
 class Surface;
 class DescriptorUpdateQueue;
+class TransferScheduler;
 
 struct Handle {
     VmaAllocation alloc;
     vk::Image image;
     vk::UniqueImageView image_view;
+    u64 hash;
+};
+
+/// Memory pools images are suballocated from, split by how long their images tend to live.
+enum class ImagePool : u32 {
+    RenderTarget, ///< Upscaled images, which the rasterizer cache only creates for draw targets.
+    Sampled,      ///< Images at the guest resolution and custom textures.
+    Count,
+};
+
+struct HandleInfo {
+    u32 width;
+    u32 height;
+    u32 levels;
+    VideoCore::TextureType type;
+    vk::Format format;
+    vk::ImageUsageFlags usage;
+    vk::ImageCreateFlags flags;
+    vk::ImageAspectFlags aspect;
+    bool need_format_list;
+    ImagePool pool;
+
+    /// Returns the hash of the image parameters, images with equal hashes are interchangeable.
+    u64 Hash() const noexcept;
 };
 
 /**
@@ -57,15 +87,58 @@ public:
         return renderpass_cache;
     }
 
+    /// Returns a counter that changes whenever surface image views are destroyed.
+    u64 ImageViewGeneration() const {
+        return image_view_generation;
+    }
+
     /// Returns the removal threshold ticks for the garbage collector
     u32 RemoveThreshold();
 
     /// Submits and waits for current GPU work.
     void Finish();
 
+    /**
+     * Returns the device memory surfaces may use given that they currently use surface_memory
+     * bytes, or zero when the driver does not report a memory budget.
+     */
+    u64 SurfaceMemoryBudget(u64 surface_memory) const;
+
+    /// Returns the upload staging usage statistics and resets the per frame counters.
+    StagingAllocator::Stats GetAndResetStagingStats() {
+        return upload_staging.GetAndResetStats();
+    }
+
     /// Maps an internal staging buffer of the provided size for pixel uploads/downloads
     VideoCore::StagingData FindStaging(u32 size, bool upload);
 
+    /**
+     * Untiles and decodes the raw guest texture data into the staging buffer with a compute
+     * shader. Returns false when the texture must be decoded on the CPU instead.
+     */
+    bool DecodeTexture(const VideoCore::SurfaceParams& params, std::span<const u8> source,
+                       const VideoCore::StagingData& staging, bool convert);
+
+    /**
+     * Downloads a rectangle of the surface and encodes it into the tiled guest layout in dest
+     * with a compute shader. Returns false when the data must be encoded on the CPU instead.
+     */
+    bool EncodeTexture(Surface& surface, const VideoCore::SurfaceParams& params,
+                       std::span<u8> dest, bool convert);
+
+    /**
+     * Records a download of a rectangle of the surface to the staging of pending and submits it
+     * without waiting for it. Returns false when the download could not be started.
+     */
+    bool DownloadAsync(Surface& surface, const VideoCore::SurfaceParams& params,
+                       VideoCore::PendingDownload& pending);
+
+    /**
+     * Waits for a download started with DownloadAsync to complete. Returns false when its staging
+     * memory has been reused since, in which case the download must be repeated.
+     */
+    bool FinishDownload(const VideoCore::PendingDownload& pending);
+
     /// Attempts to reinterpret a rectangle of source to another rectangle of dest
     bool Reinterpret(Surface& source, Surface& dest, const VideoCore::TextureCopy& copy);
 
@@ -80,6 +153,9 @@ public:
         return CopyTextures(source, dest, std::array{copy});
     }
 
+    /// Copies the first levels of each face surface to its layer of the cube, faces may be null
+    void CopyCubeFaces(std::span<Surface* const, 6> faces, Surface& cube, u32 levels);
+
     /// Blits a rectangle of src_tex to another rectange of dst_rect
     bool BlitTextures(Surface& surface, Surface& dest, const VideoCore::TextureBlit& blit);
 
@@ -89,6 +165,18 @@ public:
     /// Returns true if the provided pixel format needs convertion
     bool NeedsConversion(VideoCore::PixelFormat format) const;
 
+    /// Returns true if custom textures of the provided format can be sampled directly.
+    bool IsCustomFormatSupported(VideoCore::CustomPixelFormat format) const;
+
+    /**
+     * Returns an image with the provided parameters, reusing the image of a destroyed surface
+     * when one matches.
+     */
+    Handle AcquireHandle(const HandleInfo& info, std::string_view debug_name = {});
+
+    /// Keeps the image of a destroyed surface for reuse, or destroys it when the list is full.
+    void RecycleHandle(Handle&& handle);
+
 private:
     /// Clears a partial texture rect using a clear rectangle
     void ClearTextureWithRenderpass(Surface& surface, const VideoCore::TextureClear& clear);
@@ -98,8 +186,14 @@ private:
     Scheduler& scheduler;
     RenderManager& renderpass_cache;
     BlitHelper blit_helper;
-    StreamBuffer upload_buffer;
+    StagingAllocator upload_staging;
     StreamBuffer download_buffer;
+    StreamBuffer decode_buffer;
+    std::unique_ptr<TransferScheduler> transfer_scheduler;
+    std::array<VmaPool, static_cast<std::size_t>(ImagePool::Count)> image_pools{};
+    std::unordered_multimap<u64, Handle, Common::IdentityHash<u64>> recycled_handles;
+    u64 recycled_memory{};
+    u64 image_view_generation{};
     u32 num_swapchain_images;
 };
 
@@ -172,10 +266,16 @@ private:
     /// Performs blit between the scaled/unscaled images
     void BlitScale(const VideoCore::TextureBlit& blit, bool up_scale);
 
+    /// Records the download of a rectangle of the surface to the download buffer
+    void RecordDownload(const VideoCore::BufferTextureCopy& download);
+
     /// Downloads scaled depth stencil data
     void DepthStencilDownload(const VideoCore::BufferTextureCopy& download,
                               const VideoCore::StagingData& staging);
 
+    /// Initializes the images with the first custom upload on the transfer queue
+    void UploadCustomTransfer(const VideoCore::Material* material, u32 level);
+
 public:
     TextureRuntime* runtime;
     const Instance* instance;
@@ -189,6 +289,7 @@ public:
     vk::UniqueImageView storage_view;
     bool is_framebuffer{};
     bool is_storage{};
+    bool transfer_init{};
 };
 
 class Framebuffer : public VideoCore::FramebufferParams {
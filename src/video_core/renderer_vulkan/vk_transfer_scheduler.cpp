@@ -0,0 +1,40 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_transfer_scheduler.h"
+
+namespace Vulkan {
+
+TransferScheduler::TransferScheduler(const Instance& instance)
+    : master_semaphore{instance, instance.GetTransferQueue()},
+      command_pool{instance, &master_semaphore, instance.GetTransferQueueFamilyIndex()} {}
+
+TransferScheduler::~TransferScheduler() {
+    // The command buffers can not be freed while the queue is still executing them.
+    master_semaphore.Wait(master_semaphore.CurrentTick() - 1);
+}
+
+vk::CommandBuffer TransferScheduler::CommandBuffer() {
+    if (!current_cmdbuf) {
+        current_cmdbuf = command_pool.Commit();
+        current_cmdbuf.begin(vk::CommandBufferBeginInfo{
+            .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+        });
+    }
+    return current_cmdbuf;
+}
+
+u64 TransferScheduler::Submit() {
+    if (!current_cmdbuf) {
+        return master_semaphore.CurrentTick() - 1;
+    }
+    const u64 signal_value = master_semaphore.NextTick();
+    master_semaphore.SubmitWork(current_cmdbuf, nullptr, nullptr, signal_value);
+    master_semaphore.Refresh();
+    current_cmdbuf = nullptr;
+    return signal_value;
+}
+
+} // namespace Vulkan
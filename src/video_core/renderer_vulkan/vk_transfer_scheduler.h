@@ -0,0 +1,41 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
+#include "video_core/renderer_vulkan/vk_resource_pool.h"
+
+namespace Vulkan {
+
+class Instance;
+
+/**
+ * Records work for the dedicated transfer queue, which runs alongside the graphics queue.
+ * Graphics submissions that use the results wait for the timeline semaphore value returned by
+ * Submit. This requires a dedicated transfer queue and timeline semaphore support.
+ */
+class TransferScheduler {
+public:
+    explicit TransferScheduler(const Instance& instance);
+    ~TransferScheduler();
+
+    /// Returns the command buffer being recorded, beginning a new one when needed.
+    vk::CommandBuffer CommandBuffer();
+
+    /// Submits the recorded commands and returns the timeline value they signal.
+    u64 Submit();
+
+    /// Returns the timeline semaphore signaled by the submissions.
+    [[nodiscard]] vk::Semaphore Handle() const noexcept {
+        return master_semaphore.Handle();
+    }
+
+private:
+    MasterSemaphoreTimeline master_semaphore;
+    CommandPool command_pool;
+    vk::CommandBuffer current_cmdbuf;
+};
+
+} // namespace Vulkan
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include "common/settings.h"
 #include "right_eye_disabler.h"
 #include "video_core/gpu.h"
@@ -54,7 +55,52 @@ bool RightEyeDisabler::ShouldAllowDisplayTransfer(PAddr src_address, size_t size
         display_tranfer_happened = true;
     return true;
 }
+void RightEyeDisabler::ReportDisplayTransfer(PAddr src_address, PAddr dst_address) {
+    const auto& framebuffer = gpu.impl->pica.regs.framebuffer_config[0];
+    const bool to_left =
+        dst_address == framebuffer.address_left1 || dst_address == framebuffer.address_left2;
+    const bool to_right =
+        dst_address == framebuffer.address_right1 || dst_address == framebuffer.address_right2;
+    if (dst_address == 0 || src_address == 0 || (!to_left && !to_right)) {
+        return;
+    }
+
+    // Games showing the same image to both eyes transfer it to both framebuffers, an image shown
+    // to the left eye is never skipped.
+    const auto right_it = std::ranges::find(right_eye_buffers, src_address);
+    const bool shown_left = std::ranges::find(left_eye_buffers, src_address) !=
+                            left_eye_buffers.end();
+    if (to_left) {
+        if (right_it != right_eye_buffers.end()) {
+            *right_it = 0;
+        }
+        if (!shown_left) {
+            left_eye_buffers[next_left_eye_buffer] = src_address;
+            next_left_eye_buffer ^= 1;
+        }
+    } else if (right_it == right_eye_buffers.end() && !shown_left) {
+        right_eye_buffers[next_right_eye_buffer] = src_address;
+        next_right_eye_buffer ^= 1;
+    }
+    UpdateSkippedDraws();
+}
+
+bool RightEyeDisabler::ShouldSkipRightEyeDraws() const {
+    return enabled && Settings::values.disable_right_eye_draws.GetValue() &&
+           Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Off;
+}
+
+void RightEyeDisabler::UpdateSkippedDraws() {
+    skip_right_eye_draws = ShouldSkipRightEyeDraws();
+    gpu.impl->rasterizer->SetSkippedColorBuffers(skip_right_eye_draws ? right_eye_buffers
+                                                                      : std::array<PAddr, 2>{});
+}
+
 void RightEyeDisabler::ReportEndFrame() {
+    // The settings may have changed since the last transfer.
+    if (skip_right_eye_draws != ShouldSkipRightEyeDraws()) {
+        UpdateSkippedDraws();
+    }
     if (!enabled)
         return;
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include "common/common_types.h"
 
 namespace VideoCore {
@@ -16,6 +17,10 @@ public:
     bool ShouldAllowCmdQueueTrigger(PAddr addr, u32 size);
     bool ShouldAllowDisplayTransfer(PAddr src_address, size_t size);
 
+    /// Learns the color buffers that are only transferred to the right eye of the top screen, so
+    /// the draws to them can be skipped.
+    void ReportDisplayTransfer(PAddr src_address, PAddr dst_address);
+
     void ReportEndFrame();
 
     void SetEnabled(bool enable) {
@@ -36,6 +41,16 @@ private:
     bool display_tranfer_happened = false;
     bool report_end_frame_pending = false;
 
+    bool ShouldSkipRightEyeDraws() const;
+    void UpdateSkippedDraws();
+
+    // Double buffered games alternate between two color buffers for each eye.
+    std::array<PAddr, 2> right_eye_buffers{};
+    std::array<PAddr, 2> left_eye_buffers{};
+    u32 next_right_eye_buffer = 0;
+    u32 next_left_eye_buffer = 0;
+    bool skip_right_eye_draws = false;
+
     GPU& gpu;
 };
 } // namespace VideoCore
\ No newline at end of file
@@ -1246,6 +1246,10 @@ void FragmentModule::DefineExtensions() {
         }
     }
 
+    if (profile.has_gl_arb_bindless_texture) {
+        out += "#extension GL_ARB_bindless_texture : require\n";
+    }
+
     if (!profile.is_vulkan) {
         out += fragment_shader_precision_OES;
     }
@@ -1321,10 +1325,20 @@ void FragmentModule::DefineBindingsGL() {
 
     // Texture samplers
     const auto texture_type = config.texture.texture0_type.Value();
-    for (u32 i = 0; i < 3; i++) {
-        const auto sampler =
-            i == 0 && texture_type == TextureType::TextureCube ? "samplerCube" : "sampler2D";
-        out += fmt::format("layout(binding = {0}) uniform {1} tex{0};\n", i, sampler);
+    const auto sampler_tex0 =
+        texture_type == TextureType::TextureCube ? "samplerCube" : "sampler2D";
+    if (profile.has_gl_arb_bindless_texture) {
+        // The texture handles are read from a uniform block, so draws do not rebind texture units.
+        out += "layout(binding = 4, std140) uniform fs_textures {\n";
+        out += fmt::format("    {} tex0;\n", sampler_tex0);
+        out += "    sampler2D tex1;\n";
+        out += "    sampler2D tex2;\n";
+        out += "};\n";
+    } else {
+        for (u32 i = 0; i < 3; i++) {
+            const auto sampler = i == 0 ? sampler_tex0 : "sampler2D";
+            out += fmt::format("layout(binding = {0}) uniform {1} tex{0};\n", i, sampler);
+        }
     }
 
     // Utility textures
@@ -1753,4 +1767,390 @@ std::string GenerateFragmentShader(const FSConfig& config, const Profile& profil
     return module.Generate();
 }
 
+constexpr static std::string_view FSUberShaderBody = R"(
+layout(push_constant, std430) uniform uber_data {
+    uvec4 tev_stages[NUM_TEV_STAGES];
+    uint texture_config;
+    uint framebuffer_config;
+    uint texture_border;
+};
+
+layout(set = 0, binding = 3) uniform samplerBuffer texture_buffer_lut_lf;
+layout(set = 1, binding = 0) uniform sampler2D tex0;
+layout(set = 1, binding = 1) uniform sampler2D tex1;
+layout(set = 1, binding = 2) uniform sampler2D tex2;
+
+vec4 rounded_primary_color;
+vec4 tex_color[3];
+vec4 combiner_buffer;
+vec4 combiner_output;
+
+float byteround(float x) {
+    return round(x * 255.0) * (1.0 / 255.0);
+}
+
+vec3 byteround(vec3 x) {
+    return round(x * 255.0) * (1.0 / 255.0);
+}
+
+vec4 byteround(vec4 x) {
+    return round(x * 255.0) * (1.0 / 255.0);
+}
+
+float getLod(vec2 coord) {
+    vec2 d = max(abs(dFdx(coord)), abs(dFdy(coord)));
+    return log2(max(d.x, d.y));
+}
+
+vec4 sampleTexUnit(sampler2D tex, vec2 coord, uint unit) {
+    float lod = getLod(coord * vec2(textureSize(tex, 0))) + tex_lod_bias[unit];
+    uint border = texture_border >> (unit * 2u);
+    if (((border & 1u) != 0u && (coord.x < 0.0 || coord.x > 1.0)) ||
+        ((border & 2u) != 0u && (coord.y < 0.0 || coord.y > 1.0))) {
+        return tex_border_color[unit];
+    }
+    return textureLod(tex, coord, lod);
+}
+
+vec4 GetSource(uint source, uint stage) {
+    switch (source) {
+    case SOURCE_PRIMARY_COLOR:
+        return rounded_primary_color;
+    case SOURCE_TEXTURE0:
+        return tex_color[0];
+    case SOURCE_TEXTURE1:
+        return tex_color[1];
+    case SOURCE_TEXTURE2:
+        return tex_color[2];
+    case SOURCE_PREVIOUS_BUFFER:
+        return combiner_buffer;
+    case SOURCE_CONSTANT:
+        return const_color[stage];
+    case SOURCE_PREVIOUS:
+        return combiner_output;
+    default:
+        // Fragment lighting and procedural textures are never enabled with this shader.
+        return vec4(0.0);
+    }
+}
+
+vec3 ColorModifier(uint modifier, vec4 value) {
+    switch (modifier) {
+    case 0u:
+        return value.rgb;
+    case 1u:
+        return vec3(1.0) - value.rgb;
+    case 2u:
+        return value.aaa;
+    case 3u:
+        return vec3(1.0) - value.aaa;
+    case 4u:
+        return value.rrr;
+    case 5u:
+        return vec3(1.0) - value.rrr;
+    case 8u:
+        return value.ggg;
+    case 9u:
+        return vec3(1.0) - value.ggg;
+    case 12u:
+        return value.bbb;
+    case 13u:
+        return vec3(1.0) - value.bbb;
+    default:
+        return vec3(0.0);
+    }
+}
+
+float AlphaModifier(uint modifier, vec4 value) {
+    switch (modifier) {
+    case 0u:
+        return value.a;
+    case 1u:
+        return 1.0 - value.a;
+    case 2u:
+        return value.r;
+    case 3u:
+        return 1.0 - value.r;
+    case 4u:
+        return value.g;
+    case 5u:
+        return 1.0 - value.g;
+    case 6u:
+        return value.b;
+    default:
+        return 1.0 - value.b;
+    }
+}
+
+vec3 ColorCombiner(uint op, vec3 r1, vec3 r2, vec3 r3) {
+    vec3 result;
+    switch (op) {
+    case 0u:
+        result = r1;
+        break;
+    case 1u:
+        result = r1 * r2;
+        break;
+    case 2u:
+        result = r1 + r2;
+        break;
+    case 3u:
+        result = r1 + r2 - vec3(0.5);
+        break;
+    case 4u:
+        result = mix(r2, r1, r3);
+        break;
+    case 5u:
+        result = r1 - r2;
+        break;
+    case 6u:
+    case 7u:
+        result = vec3(dot(r1 - vec3(0.5), r2 - vec3(0.5)) * 4.0);
+        break;
+    case 8u:
+        result = fma(r1, r2, r3);
+        break;
+    case 9u:
+        result = min(r1 + r2, vec3(1.0)) * r3;
+        break;
+    default:
+        result = vec3(0.0);
+        break;
+    }
+    return clamp(result, vec3(0.0), vec3(1.0));
+}
+
+float AlphaCombiner(uint op, float r1, float r2, float r3) {
+    float result;
+    switch (op) {
+    case 0u:
+        result = r1;
+        break;
+    case 1u:
+        result = r1 * r2;
+        break;
+    case 2u:
+        result = r1 + r2;
+        break;
+    case 3u:
+        result = r1 + r2 - 0.5;
+        break;
+    case 4u:
+        result = mix(r2, r1, r3);
+        break;
+    case 5u:
+        result = r1 - r2;
+        break;
+    case 8u:
+        result = fma(r1, r2, r3);
+        break;
+    case 9u:
+        result = min(r1 + r2, 1.0) * r3;
+        break;
+    default:
+        result = 0.0;
+        break;
+    }
+    return clamp(result, 0.0, 1.0);
+}
+
+float GetMultiplier(uint scale) {
+    return scale < 3u ? float(1u << scale) : 1.0;
+}
+
+void main() {
+    uint alpha_test_func = bitfieldExtract(framebuffer_config, 0, 3);
+    if (alpha_test_func == COMPARE_NEVER) {
+        discard;
+    }
+
+    uint scissor_mode = bitfieldExtract(framebuffer_config, 3, 2);
+    if (scissor_mode != SCISSOR_DISABLED) {
+        bool inside = gl_FragCoord.x >= float(scissor_x1) && gl_FragCoord.y >= float(scissor_y1) &&
+                      gl_FragCoord.x < float(scissor_x2) && gl_FragCoord.y < float(scissor_y2);
+        if (inside != (scissor_mode == SCISSOR_INCLUDE)) {
+            discard;
+        }
+    }
+
+    float depth = Z_OVER_W * depth_scale + depth_offset;
+    if (bitfieldExtract(framebuffer_config, 5, 1) == DEPTH_W_BUFFERING) {
+        depth /= gl_FragCoord.w;
+    }
+
+    // Every texture is sampled up front, so that implicit derivatives stay in uniform control flow.
+    rounded_primary_color = byteround(primary_color);
+    tex_color[0] = bitfieldExtract(texture_config, 0, 3) == TEXTURE_2D
+                       ? sampleTexUnit(tex0, texcoord0, 0u) : vec4(0.0);
+    tex_color[1] = sampleTexUnit(tex1, texcoord1, 1u);
+    tex_color[2] = sampleTexUnit(tex2, bitfieldExtract(texture_config, 3, 1) != 0u
+                                           ? texcoord1 : texcoord2, 2u);
+
+    combiner_buffer = vec4(0.0);
+    combiner_output = vec4(0.0);
+    vec4 next_combiner_buffer = tev_combiner_buffer_color;
+    uint combiner_buffer_input = bitfieldExtract(texture_config, 4, 8);
+    for (uint i = 0u; i < uint(NUM_TEV_STAGES); i++) {
+        uint sources = tev_stages[i].x;
+        uint modifiers = tev_stages[i].y;
+        uint color_op = bitfieldExtract(tev_stages[i].z, 0, 4);
+        uint alpha_op = bitfieldExtract(tev_stages[i].z, 16, 4);
+        uint color_scale = bitfieldExtract(tev_stages[i].w, 0, 2);
+        uint alpha_scale = bitfieldExtract(tev_stages[i].w, 16, 2);
+
+        bool pass_through = color_op == OP_REPLACE && alpha_op == OP_REPLACE &&
+                            bitfieldExtract(sources, 0, 4) == SOURCE_PREVIOUS &&
+                            bitfieldExtract(sources, 16, 4) == SOURCE_PREVIOUS &&
+                            bitfieldExtract(modifiers, 0, 4) == 0u &&
+                            bitfieldExtract(modifiers, 12, 3) == 0u &&
+                            GetMultiplier(color_scale) == 1.0 &&
+                            GetMultiplier(alpha_scale) == 1.0;
+        if (!pass_through) {
+            // The first stage reads its third source in place of the previous stage output.
+            uint color_sources[3];
+            uint alpha_sources[3];
+            for (int j = 0; j < 3; j++) {
+                color_sources[j] = bitfieldExtract(sources, j * 4, 4);
+                alpha_sources[j] = bitfieldExtract(sources, 16 + j * 4, 4);
+                if (i == 0u && color_sources[j] == SOURCE_PREVIOUS) {
+                    color_sources[j] = bitfieldExtract(sources, 8, 4);
+                }
+                if (i == 0u && alpha_sources[j] == SOURCE_PREVIOUS) {
+                    alpha_sources[j] = bitfieldExtract(sources, 24, 4);
+                }
+            }
+
+            vec3 color_results_1 = ColorModifier(bitfieldExtract(modifiers, 0, 4),
+                                                 GetSource(color_sources[0], i));
+            vec3 color_results_2 = ColorModifier(bitfieldExtract(modifiers, 4, 4),
+                                                 GetSource(color_sources[1], i));
+            vec3 color_results_3 = ColorModifier(bitfieldExtract(modifiers, 8, 4),
+                                                 GetSource(color_sources[2], i));
+            vec3 color_output = byteround(ColorCombiner(color_op, color_results_1,
+                                                        color_results_2, color_results_3));
+
+            float alpha_output;
+            if (color_op == OP_DOT3_RGBA) {
+                // result of Dot3_RGBA operation is also placed to the alpha component
+                alpha_output = color_output.r;
+            } else {
+                float alpha_results_1 = AlphaModifier(bitfieldExtract(modifiers, 12, 3),
+                                                      GetSource(alpha_sources[0], i));
+                float alpha_results_2 = AlphaModifier(bitfieldExtract(modifiers, 16, 3),
+                                                      GetSource(alpha_sources[1], i));
+                float alpha_results_3 = AlphaModifier(bitfieldExtract(modifiers, 20, 3),
+                                                      GetSource(alpha_sources[2], i));
+                alpha_output = byteround(AlphaCombiner(alpha_op, alpha_results_1,
+                                                       alpha_results_2, alpha_results_3));
+            }
+
+            combiner_output = vec4(
+                clamp(color_output * GetMultiplier(color_scale), vec3(0.0), vec3(1.0)),
+                clamp(alpha_output * GetMultiplier(alpha_scale), 0.0, 1.0));
+        }
+
+        combiner_buffer = next_combiner_buffer;
+        if (i < 4u && bitfieldExtract(combiner_buffer_input, int(i), 1) != 0u) {
+            next_combiner_buffer.rgb = combiner_output.rgb;
+        }
+        if (i < 4u && bitfieldExtract(combiner_buffer_input, int(i) + 4, 1) != 0u) {
+            next_combiner_buffer.a = combiner_output.a;
+        }
+    }
+
+    int alpha = int(combiner_output.a * 255.0);
+    bool alpha_pass;
+    switch (alpha_test_func) {
+    case COMPARE_EQUAL:
+        alpha_pass = alpha == alphatest_ref;
+        break;
+    case COMPARE_NOT_EQUAL:
+        alpha_pass = alpha != alphatest_ref;
+        break;
+    case COMPARE_LESS_THAN:
+        alpha_pass = alpha < alphatest_ref;
+        break;
+    case COMPARE_LESS_THAN_OR_EQUAL:
+        alpha_pass = alpha <= alphatest_ref;
+        break;
+    case COMPARE_GREATER_THAN:
+        alpha_pass = alpha > alphatest_ref;
+        break;
+    case COMPARE_GREATER_THAN_OR_EQUAL:
+        alpha_pass = alpha >= alphatest_ref;
+        break;
+    default:
+        alpha_pass = true;
+        break;
+    }
+    if (!alpha_pass) {
+        discard;
+    }
+
+    if (bitfieldExtract(texture_config, 12, 3) == FOG_MODE_FOG) {
+        float fog_index = (bitfieldExtract(texture_config, 15, 1) != 0u ? 1.0 - depth : depth) *
+                          128.0;
+        float fog_i = clamp(floor(fog_index), 0.0, 127.0);
+        float fog_f = fog_index - fog_i;
+        vec2 fog_lut_entry = texelFetch(texture_buffer_lut_lf, int(fog_i) + fog_lut_offset).rg;
+        float fog_factor = clamp(fog_lut_entry.r + fog_lut_entry.g * fog_f, 0.0, 1.0);
+        combiner_output.rgb = mix(fog_color.rgb, combiner_output.rgb, fog_factor);
+    }
+
+    gl_FragDepth = depth;
+    color = byteround(combiner_output);
+}
+)";
+
+std::string GenerateUberFragmentShader(const Profile& profile) {
+    using Source = Pica::TexturingRegs::TevStageConfig::Source;
+    using Operation = Pica::TexturingRegs::TevStageConfig::Operation;
+    using CompareFunc = Pica::FramebufferRegs::CompareFunc;
+    std::string out;
+    out += "#extension GL_ARB_separate_shader_objects : enable\n";
+
+    const auto define_input = [&](std::string_view var, Semantic location) {
+        out += fmt::format("layout (location = {}) in {};\n", location, var);
+    };
+    define_input("vec4 primary_color", Semantic::Color);
+    define_input("vec2 texcoord0", Semantic::Texcoord0);
+    define_input("vec2 texcoord1", Semantic::Texcoord1);
+    define_input("vec2 texcoord2", Semantic::Texcoord2);
+    out += "layout (location = 0) out vec4 color;\n";
+
+    const auto define_constant = [&](std::string_view name, auto value) {
+        out += fmt::format("#define {} {}u\n", name, static_cast<u32>(value));
+    };
+    define_constant("SOURCE_PRIMARY_COLOR", Source::PrimaryColor);
+    define_constant("SOURCE_TEXTURE0", Source::Texture0);
+    define_constant("SOURCE_TEXTURE1", Source::Texture1);
+    define_constant("SOURCE_TEXTURE2", Source::Texture2);
+    define_constant("SOURCE_PREVIOUS_BUFFER", Source::PreviousBuffer);
+    define_constant("SOURCE_CONSTANT", Source::Constant);
+    define_constant("SOURCE_PREVIOUS", Source::Previous);
+    define_constant("OP_REPLACE", Operation::Replace);
+    define_constant("OP_DOT3_RGBA", Operation::Dot3_RGBA);
+    define_constant("COMPARE_NEVER", CompareFunc::Never);
+    define_constant("COMPARE_EQUAL", CompareFunc::Equal);
+    define_constant("COMPARE_NOT_EQUAL", CompareFunc::NotEqual);
+    define_constant("COMPARE_LESS_THAN", CompareFunc::LessThan);
+    define_constant("COMPARE_LESS_THAN_OR_EQUAL", CompareFunc::LessThanOrEqual);
+    define_constant("COMPARE_GREATER_THAN", CompareFunc::GreaterThan);
+    define_constant("COMPARE_GREATER_THAN_OR_EQUAL", CompareFunc::GreaterThanOrEqual);
+    define_constant("SCISSOR_DISABLED", RasterizerRegs::ScissorMode::Disabled);
+    define_constant("SCISSOR_INCLUDE", RasterizerRegs::ScissorMode::Include);
+    define_constant("DEPTH_W_BUFFERING", RasterizerRegs::DepthBuffering::WBuffering);
+    define_constant("TEXTURE_2D", TextureType::Texture2D);
+    define_constant("FOG_MODE_FOG", TexturingRegs::FogMode::Fog);
+
+    // See FragmentModule::WriteDepth for the depth range conversion.
+    out += profile.has_minus_one_to_one_range
+               ? "#define Z_OVER_W (-2.0 * gl_FragCoord.z + 1.0)\n"
+               : "#define Z_OVER_W (-gl_FragCoord.z)\n";
+
+    out += FSUniformBlockDef;
+    out += FSUberShaderBody;
+    return out;
+}
+
 } // namespace Pica::Shader::Generator::GLSL
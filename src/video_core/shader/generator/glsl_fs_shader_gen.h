@@ -99,4 +99,13 @@ private:
  */
 std::string GenerateFragmentShader(const FSConfig& config, const Profile& profile);
 
+/**
+ * Generates a Vulkan GLSL fragment shader that reads the TEV stages, texture, fog, alpha test,
+ * scissor and depth configuration from FSUberUniformData push constants instead of baking them
+ * in. It is used to draw configurations where UsesUberShaderIncompatibleConfig is false while
+ * their specialized shader is compiled.
+ * @returns String of the shader source code
+ */
+std::string GenerateUberFragmentShader(const Profile& profile);
+
 } // namespace Pica::Shader::Generator::GLSL
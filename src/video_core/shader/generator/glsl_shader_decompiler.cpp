@@ -3,14 +3,18 @@
 // Refer to the license.txt file included.
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <fmt/format.h>
 #include <nihstro/shader_bytecode.h>
 #include "common/assert.h"
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "video_core/shader/generator/glsl_shader_decompiler.h"
 
 namespace Pica::Shader::Generator::GLSL {
@@ -267,10 +271,10 @@ public:
     GLSLGenerator(const std::set<Subroutine>& subroutines, const ProgramCode& program_code,
                   const SwizzleData& swizzle_data, u32 main_offset,
                   const RegGetter& inputreg_getter, const RegGetter& outputreg_getter,
-                  bool sanitize_mul)
+                  bool sanitize_mul, bool is_gs)
         : subroutines(subroutines), program_code(program_code), swizzle_data(swizzle_data),
           main_offset(main_offset), inputreg_getter(inputreg_getter),
-          outputreg_getter(outputreg_getter), sanitize_mul(sanitize_mul) {
+          outputreg_getter(outputreg_getter), sanitize_mul(sanitize_mul), is_gs(is_gs) {
 
         Generate();
     }
@@ -359,7 +363,8 @@ private:
 
     /// Generates code representing a bool uniform
     std::string GetUniformBool(u32 index, bool invert_test = false) const {
-        return fmt::format("(uniforms.b & {}u) {} 0u", 1 << index, invert_test ? "==" : "!=");
+        return fmt::format("({} & {}u) {} 0u", is_gs ? "gs_bool_uniforms" : "uniforms.b",
+                           1 << index, invert_test ? "==" : "!=");
     }
 
     /**
@@ -790,8 +795,20 @@ private:
             }
 
             case OpCode::Id::EMIT:
+                if (!is_gs) {
+                    LOG_ERROR(HW_GPU, "Geometry shader operation detected in vertex shader");
+                    break;
+                }
+                shader.AddLine("emit();");
+                break;
+
             case OpCode::Id::SETEMIT:
-                LOG_ERROR(HW_GPU, "Geometry shader operation detected in vertex shader");
+                if (!is_gs) {
+                    LOG_ERROR(HW_GPU, "Geometry shader operation detected in vertex shader");
+                    break;
+                }
+                shader.AddLine("setemit({}u, {}, {});", instr.setemit.vertex_id.Value(),
+                               instr.setemit.prim_emit != 0, instr.setemit.winding != 0);
                 break;
 
             default: {
@@ -924,18 +941,60 @@ private:
     const RegGetter& inputreg_getter;
     const RegGetter& outputreg_getter;
     const bool sanitize_mul;
+    const bool is_gs;
 
     ShaderWriter shader;
 };
 
+using SubroutineSet = std::set<Subroutine>;
+
+/**
+ * Returns the subroutines of the program starting at main_offset, or null if its control flow
+ * can not be decompiled. The analysis only depends on the program code, so it is shared by all
+ * the variants of a program that differ in their swizzle data or register mapping.
+ */
+std::shared_ptr<const SubroutineSet> AnalyzeControlFlow(const ProgramCode& program_code,
+                                                        u32 main_offset) {
+    constexpr std::size_t MAX_CACHED_PROGRAMS = 256;
+    static std::mutex cache_mutex;
+    static std::unordered_map<u64, std::shared_ptr<const SubroutineSet>> cache;
+
+    const u64 key = Common::HashCombine(
+        Common::ComputeHash64(program_code.data(), sizeof(program_code)), main_offset);
+    {
+        std::scoped_lock lock{cache_mutex};
+        if (const auto it = cache.find(key); it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    std::shared_ptr<const SubroutineSet> subroutines;
+    try {
+        subroutines = std::make_shared<const SubroutineSet>(
+            ControlFlowAnalyzer(program_code, main_offset).MoveSubroutines());
+    } catch (const DecompileFail& exception) {
+        LOG_INFO(HW_GPU, "Shader decompilation failed: {}", exception.what());
+    }
+
+    std::scoped_lock lock{cache_mutex};
+    if (cache.size() >= MAX_CACHED_PROGRAMS) {
+        cache.clear();
+    }
+    cache.emplace(key, subroutines);
+    return subroutines;
+}
+
 std::string DecompileProgram(const ProgramCode& program_code, const SwizzleData& swizzle_data,
                              u32 main_offset, const RegGetter& inputreg_getter,
-                             const RegGetter& outputreg_getter, bool sanitize_mul) {
+                             const RegGetter& outputreg_getter, bool sanitize_mul, bool is_gs) {
+    const auto subroutines = AnalyzeControlFlow(program_code, main_offset);
+    if (!subroutines) {
+        return "";
+    }
 
     try {
-        auto subroutines = ControlFlowAnalyzer(program_code, main_offset).MoveSubroutines();
-        GLSLGenerator generator(subroutines, program_code, swizzle_data, main_offset,
-                                inputreg_getter, outputreg_getter, sanitize_mul);
+        GLSLGenerator generator(*subroutines, program_code, swizzle_data, main_offset,
+                                inputreg_getter, outputreg_getter, sanitize_mul, is_gs);
         return generator.MoveShaderCode();
     } catch (const DecompileFail& exception) {
         LOG_INFO(HW_GPU, "Shader decompilation failed: {}", exception.what());
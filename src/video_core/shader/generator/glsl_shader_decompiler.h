@@ -12,9 +12,15 @@ namespace Pica::Shader::Generator::GLSL {
 
 using RegGetter = std::function<std::string(u32)>;
 
+/**
+ * Decompiles the PICA program starting at main_offset to GLSL. Geometry shader programs call the
+ * emit() and setemit(vertex_id, prim_emit, winding) functions, which must be defined by the
+ * caller, and read the bool uniforms from gs_bool_uniforms instead of the uniform block.
+ * @returns String of the shader source code; empty on failure
+ */
 std::string DecompileProgram(const Pica::ProgramCode& program_code,
                              const Pica::SwizzleData& swizzle_data, u32 main_offset,
                              const RegGetter& inputreg_getter, const RegGetter& outputreg_getter,
-                             bool sanitize_mul);
+                             bool sanitize_mul, bool is_gs = false);
 
 } // namespace Pica::Shader::Generator::GLSL
@@ -26,6 +26,18 @@ layout (binding = 0, std140) uniform vs_pica_data {
 } uniforms;
 )";
 
+constexpr std::string_view GSPicaUniformBlockDef = R"(
+#ifdef VULKAN
+layout (set = 0, binding = 6, std140) uniform gs_pica_data {
+#else
+layout (binding = 3, std140) uniform gs_pica_data {
+#endif
+    uint b;
+    uvec4 i[4];
+    vec4 f[96];
+} uniforms;
+)";
+
 constexpr std::string_view VSUniformBlockDef = R"(
 #ifdef VULKAN
 layout (set = 0, binding = 1, std140) uniform vs_data {
@@ -419,4 +431,120 @@ void main() {
 
     return out;
 }
+
+std::string GenerateGeometryShader(const ShaderSetup& setup, const PicaGSProgramConfig& config,
+                                   bool separable_shader) {
+    std::string_view input_primitive;
+    switch (config.state.vertices_per_primitive) {
+    case 1:
+        input_primitive = "points";
+        break;
+    case 2:
+        input_primitive = "lines";
+        break;
+    case 3:
+        input_primitive = "triangles";
+        break;
+    default:
+        return "";
+    }
+
+    std::array<bool, 16> used_regs{};
+    const auto get_input_reg = [&used_regs](u32 reg) {
+        ASSERT(reg < 16);
+        used_regs[reg] = true;
+        return fmt::format("gs_in_reg{}", reg);
+    };
+
+    const auto get_output_reg = [&](u32 reg) -> std::string {
+        ASSERT(reg < 16);
+        if (config.state.output_map[reg] < config.state.num_outputs) {
+            return fmt::format("gs_out_attr{}", config.state.output_map[reg]);
+        }
+        return "";
+    };
+
+    auto program_source =
+        DecompileProgram(setup.program_code, setup.swizzle_data, config.state.main_offset,
+                         get_input_reg, get_output_reg, config.state.sanitize_mul, true);
+
+    if (program_source.empty()) {
+        return "";
+    }
+
+    std::string out;
+    if (separable_shader) {
+        out += "#extension GL_ARB_separate_shader_objects : enable\n";
+    }
+
+    // Every emitted primitive is a separate triangle, so the output vertex count bounds the
+    // number of primitives a single invocation can emit.
+    out += fmt::format("layout({}) in;\n", input_primitive);
+    out += "layout(triangle_strip, max_vertices = 30) out;\n";
+
+    out += GSPicaUniformBlockDef;
+    out += GetGSCommonSource(config.state.gs_state, separable_shader);
+
+    for (std::size_t i = 0; i < used_regs.size(); ++i) {
+        if (used_regs[i]) {
+            out += fmt::format("vec4 gs_in_reg{} = vec4(0.0, 0.0, 0.0, 1.0);\n", i);
+        }
+    }
+    for (u32 i = 0; i < config.state.num_outputs; ++i) {
+        out += fmt::format("vec4 gs_out_attr{} = vec4(0.0, 0.0, 0.0, 1.0);\n", i);
+    }
+    out += "uint gs_bool_uniforms;\n\n";
+
+    // The emitter state of the PICA geometry shader unit.
+    out += R"(
+Vertex output_buffer[3];
+uint vertex_id = 0u;
+bool prim_emit = false;
+bool winding = false;
+
+void setemit(uint vertex_id_, bool prim_emit_, bool winding_) {
+    vertex_id = vertex_id_;
+    prim_emit = prim_emit_;
+    winding = winding_;
+}
+
+)";
+    out += "void emit() {\n";
+    out += fmt::format("    output_buffer[vertex_id].attributes = vec4[{}](",
+                       config.state.gs_state.gs_output_attributes);
+    for (u32 i = 0; i < config.state.num_outputs; ++i) {
+        out += fmt::format("{}gs_out_attr{}", i == 0 ? "" : ", ", i);
+    }
+    out += ");\n";
+    out += R"(    if (prim_emit) {
+        if (winding) {
+            EmitPrim(output_buffer[1], output_buffer[0], output_buffer[2]);
+            winding = false;
+        } else {
+            EmitPrim(output_buffer[0], output_buffer[1], output_buffer[2]);
+        }
+    }
+}
+
+bool exec_shader();
+
+void main() {
+    // The PICA sets b15 after every invocation so that programs can detect the first one.
+    gs_bool_uniforms = gl_PrimitiveIDIn == 0 ? uniforms.b : (uniforms.b | 0x8000u);
+)";
+    for (u32 attr = 0; attr < config.state.num_inputs; ++attr) {
+        const u32 reg = config.state.input_map[attr];
+        if (used_regs[reg]) {
+            out += fmt::format("    gs_in_reg{} = vs_out_attr{}[{}];\n", reg,
+                               attr % config.state.attributes_per_vertex,
+                               attr / config.state.attributes_per_vertex);
+        }
+    }
+    out += "\n    exec_shader();\n}\n\n";
+
+    out += program_source;
+
+    return out;
+}
+
 } // namespace Pica::Shader::Generator::GLSL
@@ -180,6 +180,19 @@ struct FSConfig {
                framebuffer.shadow_rendering.Value();
     }
 
+    [[nodiscard]] bool UsesUberShaderIncompatibleConfig() const {
+        using TextureType = Pica::TexturingRegs::TextureConfig::TextureType;
+        using LogicOp = Pica::FramebufferRegs::LogicOp;
+        const auto texture0_type = texture.texture0_type.Value();
+        const auto logic_op = framebuffer.logic_op.Value();
+        return (texture0_type != TextureType::Texture2D &&
+                texture0_type != TextureType::Disabled) ||
+               texture.fog_mode == Pica::TexturingRegs::FogMode::Gas ||
+               (logic_op != LogicOp::Copy && logic_op != LogicOp::NoOp) ||
+               framebuffer.shadow_rendering.Value() || lighting.enable.Value() ||
+               proctex.enable.Value();
+    }
+
     bool operator==(const FSConfig& other) const noexcept {
         return std::memcmp(this, &other, sizeof(FSConfig)) == 0;
     }
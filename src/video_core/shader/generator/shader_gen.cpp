@@ -59,11 +59,59 @@ void PicaVSConfigState::Init(const Pica::RegsInternal& regs, Pica::ShaderSetup&
     }
 }
 
+void PicaGSProgramConfigState::Init(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup,
+                                    bool use_clip_planes_, bool accurate_mul_) {
+    sanitize_mul = accurate_mul_;
+
+    program_hash = setup.GetProgramCodeHash();
+    swizzle_hash = setup.GetSwizzleDataHash();
+    main_offset = regs.gs.main_offset;
+
+    vertices_per_primitive = GetGSVerticesPerPrimitive(regs);
+    attributes_per_vertex = regs.pipeline.vs_outmap_total_minus_1_a + 1;
+    num_inputs = regs.gs.max_input_attribute_index + 1;
+    input_map.fill(16);
+    for (u32 attr = 0; attr < num_inputs; ++attr) {
+        input_map[attr] = regs.gs.GetRegisterForAttribute(attr);
+    }
+
+    num_outputs = 0;
+    output_map.fill(16);
+    for (u32 reg : Common::BitSet<u32>(regs.gs.output_mask)) {
+        output_map[reg] = num_outputs++;
+    }
+
+    // The rasterizer output attributes describe the geometry shader outputs in this pipeline.
+    gs_state.Init(regs, use_clip_planes_);
+    gs_state.gs_output_attributes = num_outputs;
+}
+
+u32 GetGSVerticesPerPrimitive(const Pica::RegsInternal& regs) {
+    if (regs.pipeline.gs_config.mode != Pica::PipelineRegs::GSMode::Point ||
+        regs.pipeline.variable_primitive != 0 || regs.gs.input_to_uniform != 0) {
+        return 0;
+    }
+    const u32 attributes_per_vertex = regs.pipeline.vs_outmap_total_minus_1_a + 1;
+    const u32 num_inputs = regs.gs.max_input_attribute_index + 1;
+    if (num_inputs % attributes_per_vertex != 0) {
+        return 0;
+    }
+    // Only the primitive types that both GL and Vulkan can feed a geometry shader with a
+    // plain list of vertices are supported.
+    const u32 vertices_per_primitive = num_inputs / attributes_per_vertex;
+    return vertices_per_primitive <= 3 ? vertices_per_primitive : 0;
+}
+
 PicaVSConfig::PicaVSConfig(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup,
                            bool use_clip_planes_, bool use_geometry_shader_, bool accurate_mul_) {
     state.Init(regs, setup, use_clip_planes_, use_geometry_shader_, accurate_mul_);
 }
 
+PicaGSProgramConfig::PicaGSProgramConfig(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup,
+                                         bool use_clip_planes_, bool accurate_mul_) {
+    state.Init(regs, setup, use_clip_planes_, accurate_mul_);
+}
+
 PicaFixedGSConfig::PicaFixedGSConfig(const Pica::RegsInternal& regs, bool use_clip_planes_) {
     state.Init(regs, use_clip_planes_);
 }
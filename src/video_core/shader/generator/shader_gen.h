@@ -86,6 +86,40 @@ struct PicaVSConfigState {
     PicaGSConfigState gs_state;
 };
 
+/**
+ * This struct contains information to identify a GLSL geometry shader generated from a PICA
+ * geometry shader program running in point mode.
+ */
+struct PicaGSProgramConfigState {
+    void Init(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup, bool use_clip_planes_,
+              bool accurate_mul_);
+
+    u64 program_hash;
+    u64 swizzle_hash;
+    u32 main_offset;
+    bool sanitize_mul;
+
+    // Number of vertices that are consumed by one invocation of the program
+    u32 vertices_per_primitive;
+    // Number of vertex shader outputs that make up a single input vertex
+    u32 attributes_per_vertex;
+    u32 num_inputs;
+    // input_map[input attribute index] -> input register index
+    std::array<u32, 16> input_map;
+
+    u32 num_outputs;
+    // output_map[output register index] -> output attribute index
+    std::array<u32, 16> output_map;
+
+    PicaGSConfigState gs_state;
+};
+
+/**
+ * Returns the number of vertices each invocation of the geometry shader program consumes, or 0
+ * if the geometry shader configuration can not be run on the host GPU.
+ */
+u32 GetGSVerticesPerPrimitive(const Pica::RegsInternal& regs);
+
 /**
  * This struct contains information to identify a GL vertex shader generated from PICA vertex
  * shader.
@@ -103,6 +137,15 @@ struct PicaFixedGSConfig : Common::HashableStruct<PicaGSConfigState> {
     explicit PicaFixedGSConfig(const Pica::RegsInternal& regs, bool use_clip_planes_);
 };
 
+/**
+ * This struct contains information to identify a GL geometry shader generated from PICA geometry
+ * shader.
+ */
+struct PicaGSProgramConfig : Common::HashableStruct<PicaGSProgramConfigState> {
+    explicit PicaGSProgramConfig(const Pica::RegsInternal& regs, Pica::ShaderSetup& setup,
+                                 bool use_clip_planes_, bool accurate_mul_);
+};
+
 } // namespace Pica::Shader::Generator
 
 namespace std {
@@ -119,4 +162,11 @@ struct hash<Pica::Shader::Generator::PicaFixedGSConfig> {
         return k.Hash();
     }
 };
+
+template <>
+struct hash<Pica::Shader::Generator::PicaGSProgramConfig> {
+    std::size_t operator()(const Pica::Shader::Generator::PicaGSProgramConfig& k) const noexcept {
+        return k.Hash();
+    }
+};
 } // namespace std
@@ -3,10 +3,26 @@
 // Refer to the license.txt file included.
 
 #include "video_core/pica/shader_setup.h"
+#include "video_core/shader/generator/pica_fs_config.h"
 #include "video_core/shader/generator/shader_uniforms.h"
 
 namespace Pica::Shader::Generator {
 
+void FSUberUniformData::SetFromConfig(const FSConfig& config) {
+    for (u32 j = 0; j < tev_stages.size(); j++) {
+        const auto& stage = config.texture.tev_stages[j];
+        tev_stages[j] = Common::MakeVec(stage.sources_raw, stage.modifiers_raw, stage.ops_raw,
+                                        stage.scales_raw);
+    }
+    texture_config = config.texture.raw;
+    framebuffer_config = config.framebuffer.raw;
+    texture_border = 0;
+    for (u32 j = 0; j < config.texture.texture_border_color.size(); j++) {
+        const auto& border = config.texture.texture_border_color[j];
+        texture_border |= (border.enable_s.Value() | border.enable_t.Value() << 1) << (j * 2);
+    }
+}
+
 void VSPicaUniformData::SetFromRegs(const Pica::ShaderSetup& setup) {
     b = 0;
     for (u32 j = 0; j < setup.uniforms.b.size(); j++) {
@@ -11,6 +11,10 @@ namespace Pica {
 struct ShaderSetup;
 } // namespace Pica
 
+namespace Pica::Shader {
+struct FSConfig;
+} // namespace Pica::Shader
+
 namespace Pica::Shader::Generator {
 
 struct LightSrc {
@@ -68,6 +72,24 @@ static_assert(sizeof(FSUniformData) == 0x530,
 static_assert(sizeof(FSUniformData) < 16384,
               "UniformData structure must be less than 16kb as per the OpenGL spec");
 
+/**
+ * Push constant block read by the uber fragment shader. It holds the parts of the fragment
+ * configuration that the specialized shaders bake in, using the same bit layout as FSConfig.
+ * NOTE: Must fit in the 128 bytes of push constants that every Vulkan device provides.
+ */
+struct FSUberUniformData {
+    void SetFromConfig(const FSConfig& config);
+
+    std::array<Common::Vec4u, 6> tev_stages; // sources, modifiers, ops and scales of each stage
+    u32 texture_config;
+    u32 framebuffer_config;
+    u32 texture_border;
+};
+static_assert(sizeof(FSUberUniformData) == 108,
+              "The size of the FSUberUniformData does not match the structure in the shader");
+static_assert(sizeof(FSUberUniformData) <= 128,
+              "FSUberUniformData structure must fit in the guaranteed push constant size");
+
 struct VSUniformData {
     u32 enable_clip1;
     u32 flip_viewport;
@@ -0,0 +1,190 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <span>
+#include <fmt/format.h>
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "video_core/shader/generator/shared_fs_cache.h"
+
+namespace Pica::Shader {
+
+namespace {
+
+constexpr u32 SharedCacheMagic = 0x43534653; // "SFSC"
+constexpr u32 SharedCacheVersion = 1;
+
+struct SharedCacheHeader {
+    u32 magic;
+    u32 version;
+    u32 config_size;
+    u32 entry_count;
+    u64 driver_id;
+    u64 generator_version;
+};
+static_assert(sizeof(SharedCacheHeader) == 0x20, "SharedCacheHeader has incorrect size");
+
+/// Identifies the shader generators, as their output changes along with the shader cache version.
+u64 GetGeneratorVersion() {
+    return Common::ComputeHash64(Common::g_shader_cache_version,
+                                 std::strlen(Common::g_shader_cache_version));
+}
+
+template <typename T>
+void Append(std::vector<u8>& data, const T& value) {
+    const auto* bytes = reinterpret_cast<const u8*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool Extract(std::span<const u8> data, std::size_t& offset, T& value) {
+    if (data.size() - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+} // Anonymous namespace
+
+SharedFragmentCache::SharedFragmentCache(std::string_view backend, u64 driver_id_)
+    : enabled{Settings::values.use_shared_shader_cache.GetValue()}, driver_id{driver_id_} {
+    if (!enabled) {
+        return;
+    }
+    path = fmt::format("{}shared{}{}_{:016X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::ShaderDir), DIR_SEP, backend,
+                       driver_id);
+    Load();
+}
+
+SharedFragmentCache::~SharedFragmentCache() {
+    Save();
+}
+
+std::optional<std::vector<u8>> SharedFragmentCache::Find(const FSConfig& config) const {
+    if (!enabled) {
+        return std::nullopt;
+    }
+    std::scoped_lock lock{mutex};
+    const auto it = entries.find(config.Hash());
+    if (it == entries.end() ||
+        std::memcmp(it->second.config.data(), &config, sizeof(FSConfig)) != 0) {
+        return std::nullopt;
+    }
+    return it->second.blob;
+}
+
+void SharedFragmentCache::Insert(const FSConfig& config, std::vector<u8> blob) {
+    if (!enabled || blob.empty()) {
+        return;
+    }
+    Entry entry{};
+    std::memcpy(entry.config.data(), &config, sizeof(FSConfig));
+    entry.blob = std::move(blob);
+
+    std::scoped_lock lock{mutex};
+    entries.insert_or_assign(config.Hash(), std::move(entry));
+    dirty = true;
+}
+
+void SharedFragmentCache::Save() {
+    std::scoped_lock lock{mutex};
+    if (!enabled || !dirty) {
+        return;
+    }
+
+    std::vector<u8> payload;
+    for (const auto& [hash, entry] : entries) {
+        payload.insert(payload.end(), entry.config.begin(), entry.config.end());
+        Append(payload, static_cast<u64>(entry.blob.size()));
+        payload.insert(payload.end(), entry.blob.begin(), entry.blob.end());
+    }
+    const std::vector<u8> compressed = Common::Compression::CompressDataZSTDDefault(payload);
+
+    const SharedCacheHeader header{
+        .magic = SharedCacheMagic,
+        .version = SharedCacheVersion,
+        .config_size = static_cast<u32>(sizeof(FSConfig)),
+        .entry_count = static_cast<u32>(entries.size()),
+        .driver_id = driver_id,
+        .generator_version = GetGeneratorVersion(),
+    };
+
+    // Written to a temporary file first so that other instances never see a partial store.
+    const std::string temp_path = path + ".tmp";
+    if (!FileUtil::CreateFullPath(path)) {
+        LOG_ERROR(Render, "Could not create the shared shader cache directory");
+        return;
+    }
+    {
+        FileUtil::IOFile file{temp_path, "wb"};
+        if (!file.IsOpen() || file.WriteObject(header) != 1 ||
+            file.WriteBytes(compressed.data(), compressed.size()) != compressed.size()) {
+            LOG_ERROR(Render, "Could not write the shared shader cache {}", temp_path);
+            return;
+        }
+    }
+    if (FileUtil::Exists(path)) {
+        FileUtil::Delete(path);
+    }
+    if (!FileUtil::Rename(temp_path, path)) {
+        LOG_ERROR(Render, "Could not replace the shared shader cache {}", path);
+        return;
+    }
+    dirty = false;
+    LOG_INFO(Render, "Saved {} shared fragment shaders", entries.size());
+}
+
+u64 SharedFragmentCache::HashProfile(const Profile& profile) {
+    static_assert(std::has_unique_object_representations_v<Profile>);
+    return Common::ComputeHash64(&profile, sizeof(Profile));
+}
+
+void SharedFragmentCache::Load() {
+    FileUtil::IOFile file{path, "rb"};
+    if (!file.IsOpen()) {
+        return;
+    }
+    SharedCacheHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != SharedCacheMagic || header.version != SharedCacheVersion ||
+        header.config_size != sizeof(FSConfig) || header.driver_id != driver_id ||
+        header.generator_version != GetGeneratorVersion()) {
+        LOG_INFO(Render, "Ignoring outdated shared shader cache {}", path);
+        return;
+    }
+
+    std::vector<u8> compressed(file.GetSize() - sizeof(header));
+    if (file.ReadBytes(compressed.data(), compressed.size()) != compressed.size()) {
+        LOG_ERROR(Render, "Could not read the shared shader cache {}", path);
+        return;
+    }
+    const std::vector<u8> payload = Common::Compression::DecompressDataZSTD(compressed);
+
+    std::size_t offset = 0;
+    for (u32 i = 0; i < header.entry_count; ++i) {
+        Entry entry{};
+        u64 blob_size{};
+        if (!Extract(payload, offset, entry.config) || !Extract(payload, offset, blob_size) ||
+            payload.size() - offset < blob_size) {
+            LOG_ERROR(Render, "Shared shader cache {} is truncated", path);
+            entries.clear();
+            return;
+        }
+        entry.blob.assign(payload.begin() + offset, payload.begin() + offset + blob_size);
+        offset += blob_size;
+        const u64 hash = Common::ComputeHash64(entry.config.data(), entry.config.size());
+        entries.insert_or_assign(hash, std::move(entry));
+    }
+    LOG_INFO(Render, "Loaded {} shared fragment shaders", entries.size());
+}
+
+} // namespace Pica::Shader
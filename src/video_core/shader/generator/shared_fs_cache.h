@@ -0,0 +1,70 @@
+// Copyright Citra Emulator Project / Azahar Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+#include "video_core/shader/generator/pica_fs_config.h"
+
+namespace Pica::Shader {
+
+/**
+ * Store of compiled fragment shaders that is shared by every title. Fragment shaders only depend
+ * on the fixed function configuration, which many titles have in common, so a title that was never
+ * run before can reuse the shaders compiled by others. Entries are opaque blobs keyed by the
+ * FSConfig, and each backend and driver combination has its own file, since their blobs can not be
+ * used by any other. The store is only used when use_shared_shader_cache is enabled, and its
+ * methods can be called from several threads at once.
+ */
+class SharedFragmentCache {
+public:
+    /**
+     * @param backend name of the backend, which is part of the file name.
+     * @param driver_id identifies everything the stored blobs depend on, such as the driver
+     * version and the shader profile.
+     */
+    explicit SharedFragmentCache(std::string_view backend, u64 driver_id);
+    ~SharedFragmentCache();
+
+    /// Returns whether the store is in use.
+    [[nodiscard]] bool IsEnabled() const {
+        return enabled;
+    }
+
+    /// Returns the blob stored for the config, if any.
+    [[nodiscard]] std::optional<std::vector<u8>> Find(const FSConfig& config) const;
+
+    /// Stores the blob of a newly compiled shader, replacing any previous one.
+    void Insert(const FSConfig& config, std::vector<u8> blob);
+
+    /// Writes the store to disk if shaders were added since it was loaded.
+    void Save();
+
+    /// Returns an identifier for the profile, to be combined into the driver id.
+    [[nodiscard]] static u64 HashProfile(const Profile& profile);
+
+private:
+    struct Entry {
+        std::array<u8, sizeof(FSConfig)> config;
+        std::vector<u8> blob;
+    };
+
+    void Load();
+
+    bool enabled;
+    u64 driver_id;
+    std::string path;
+    mutable std::mutex mutex;
+    std::unordered_map<u64, Entry> entries;
+    bool dirty = false;
+};
+
+} // namespace Pica::Shader
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include "common/common_types.h"
 
 namespace Pica {
@@ -29,6 +30,21 @@ public:
      * @param state Shader unit state, must be setup with input data before each shader invocation.
      */
     virtual void Run(const ShaderSetup& setup, ShaderUnit& state) const = 0;
+
+    /**
+     * Runs the currently setup shader once for each of the provided shader units, which allows
+     * engines to only pay their per invocation overhead once for a whole batch of vertices.
+     *
+     * @param setup Shader engine state, must be setup with SetupBatch on each shader change.
+     * @param states Shader unit states, each must be setup with the input data of one vertex.
+     */
+    virtual void RunBatch(const ShaderSetup& setup, std::span<ShaderUnit> states) const;
+
+    /**
+     * Switches the on-disk record of shader programs to the provided title, and prepares any
+     * programs the title has used before so that they are ready before their first use.
+     */
+    virtual void SwitchDiskCache([[maybe_unused]] u64 title_id) {}
 };
 
 std::unique_ptr<ShaderEngine> CreateEngine(bool use_jit);
@@ -5,9 +5,16 @@
 #include "common/arch.h"
 #if CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
 
+#include <cstring>
+#include <fmt/format.h>
 #include "common/assert.h"
+#include "common/common_paths.h"
 #include "common/hash.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "video_core/pica/shader_unit.h"
 #include "video_core/shader/shader.h"
 #include "video_core/shader/shader_jit.h"
 #if CITRA_ARCH(arm64)
@@ -19,6 +26,53 @@
 
 namespace Pica::Shader {
 
+namespace {
+
+/**
+ * The program list records the program code and swizzle data of every shader a title has used.
+ * Each record holds the hash of its compressed payload, so corrupted entries are skipped on their
+ * own, followed by the payload itself.
+ */
+struct ProgramListHeader {
+    u32 magic;
+    u32 version;
+    u32 program_code_size;
+    u32 swizzle_data_size;
+};
+
+constexpr u32 ProgramListMagic = 0x4C505350; // "PSPL"
+constexpr u32 ProgramListVersion = 1;
+
+struct ProgramListRecord {
+    u64 hash;
+    u32 size;
+    u32 reserved;
+};
+
+struct StoredProgram {
+    ProgramCode program_code;
+    SwizzleData swizzle_data;
+};
+static_assert(std::is_trivially_copyable_v<StoredProgram>);
+
+constexpr ProgramListHeader MakeProgramListHeader() {
+    return {
+        .magic = ProgramListMagic,
+        .version = ProgramListVersion,
+        .program_code_size = sizeof(ProgramCode),
+        .swizzle_data_size = sizeof(SwizzleData),
+    };
+}
+
+u64 MakeCacheKey(const ProgramCode& program_code, const SwizzleData& swizzle_data) {
+    // Matches the hashes computed by ShaderSetup.
+    const u64 code_hash = Common::ComputeHash64(&program_code, sizeof(program_code));
+    const u64 swizzle_hash = Common::ComputeHash64(&swizzle_data, sizeof(swizzle_data));
+    return Common::HashCombine(code_hash, swizzle_hash);
+}
+
+} // Anonymous namespace
+
 JitEngine::JitEngine() = default;
 JitEngine::~JitEngine() = default;
 
@@ -34,10 +88,131 @@ void JitEngine::SetupBatch(ShaderSetup& setup, u32 entry_point) {
     if (iter != cache.end()) {
         setup.cached_shader = iter->second.get();
     } else {
-        auto shader = std::make_unique<JitShader>();
-        shader->Compile(&setup.program_code, &setup.swizzle_data);
-        setup.cached_shader = shader.get();
-        cache.emplace_hint(iter, cache_key, std::move(shader));
+        setup.cached_shader = Compile(cache_key, setup.program_code, setup.swizzle_data);
+        StoreProgram(cache_key, setup.program_code, setup.swizzle_data);
+    }
+}
+
+JitShader* JitEngine::Compile(u64 cache_key, const ProgramCode& program_code,
+                              const SwizzleData& swizzle_data) {
+    auto shader = std::make_unique<JitShader>();
+    shader->Compile(&program_code, &swizzle_data);
+    return cache.insert_or_assign(cache_key, std::move(shader)).first->second.get();
+}
+
+void JitEngine::SwitchDiskCache(u64 title_id) {
+    if (!Settings::values.use_disk_shader_cache || title_id == 0 ||
+        disk_cache_title_id == title_id) {
+        return;
+    }
+    disk_cache_title_id = title_id;
+    disk_cache_file.Close();
+    stored_programs.clear();
+
+    const std::string dir =
+        FileUtil::GetUserPath(FileUtil::UserPath::ShaderDir) + "jit" + DIR_SEP;
+    if (!FileUtil::CreateFullPath(dir)) {
+        LOG_ERROR(HW_GPU, "Failed to create directory={}", dir);
+        return;
+    }
+    const std::string path = fmt::format("{}{:016X}.bin", dir, title_id);
+    constexpr ProgramListHeader expected_header = MakeProgramListHeader();
+
+    std::vector<u8> data;
+    {
+        FileUtil::IOFile file{path, "rb"};
+        if (file.IsOpen()) {
+            data.resize(file.GetSize());
+            if (file.ReadBytes(data.data(), data.size()) != data.size()) {
+                data.clear();
+            }
+        }
+    }
+
+    ProgramListHeader header{};
+    if (data.size() >= sizeof(header)) {
+        std::memcpy(&header, data.data(), sizeof(header));
+    }
+    if (std::memcmp(&header, &expected_header, sizeof(header)) != 0) {
+        if (!data.empty()) {
+            LOG_WARNING(HW_GPU, "Shader program list is outdated or invalid, removing");
+        }
+        disk_cache_file = FileUtil::IOFile{path, "wb"};
+        if (!disk_cache_file.IsOpen() || disk_cache_file.WriteObject(expected_header) != 1) {
+            LOG_ERROR(HW_GPU, "Unable to create shader program list");
+            disk_cache_file.Close();
+        }
+        return;
+    }
+
+    std::size_t offset = sizeof(header);
+    std::size_t num_corrupted = 0;
+    while (offset + sizeof(ProgramListRecord) <= data.size()) {
+        ProgramListRecord record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.size > data.size() - offset) {
+            // The last record was only partially written.
+            offset -= sizeof(record);
+            break;
+        }
+
+        const std::span<const u8> payload{data.data() + offset, record.size};
+        offset += record.size;
+        if (Common::ComputeHash64(payload.data(), payload.size()) != record.hash) {
+            ++num_corrupted;
+            continue;
+        }
+        const std::vector<u8> decompressed = Common::Compression::DecompressDataZSTD(payload);
+        if (decompressed.size() != sizeof(StoredProgram)) {
+            ++num_corrupted;
+            continue;
+        }
+
+        auto program = std::make_unique<StoredProgram>();
+        std::memcpy(program.get(), decompressed.data(), sizeof(StoredProgram));
+        const u64 cache_key = MakeCacheKey(program->program_code, program->swizzle_data);
+        if (stored_programs.insert(cache_key).second && !cache.contains(cache_key)) {
+            Compile(cache_key, program->program_code, program->swizzle_data);
+        }
+    }
+    if (num_corrupted > 0) {
+        LOG_WARNING(HW_GPU, "Skipped {} corrupted entries of the shader program list",
+                    num_corrupted);
+    }
+    LOG_INFO(HW_GPU, "Prepared {} shader programs for title_id={:016X}", stored_programs.size(),
+             title_id);
+
+    // Drop a partially written tail record by rewriting the file up to the last complete one.
+    disk_cache_file = FileUtil::IOFile{path, "r+b"};
+    if (!disk_cache_file.IsOpen() || !disk_cache_file.Resize(offset) ||
+        !disk_cache_file.Seek(0, SEEK_END)) {
+        LOG_ERROR(HW_GPU, "Unable to open shader program list for writing");
+        disk_cache_file.Close();
+    }
+}
+
+void JitEngine::StoreProgram(u64 cache_key, const ProgramCode& program_code,
+                             const SwizzleData& swizzle_data) {
+    if (!disk_cache_file.IsOpen() || !stored_programs.insert(cache_key).second) {
+        return;
+    }
+
+    auto program = std::make_unique<StoredProgram>();
+    program->program_code = program_code;
+    program->swizzle_data = swizzle_data;
+    const std::vector<u8> payload = Common::Compression::CompressDataZSTDDefault(
+        std::span{reinterpret_cast<const u8*>(program.get()), sizeof(StoredProgram)});
+    const ProgramListRecord record{
+        .hash = Common::ComputeHash64(payload.data(), payload.size()),
+        .size = static_cast<u32>(payload.size()),
+        .reserved = 0,
+    };
+    if (payload.empty() || disk_cache_file.WriteObject(record) != 1 ||
+        disk_cache_file.WriteBytes(payload.data(), payload.size()) != payload.size() ||
+        !disk_cache_file.Flush()) {
+        LOG_ERROR(HW_GPU, "Error during shader program list write");
+        disk_cache_file.Close();
     }
 }
 
@@ -52,6 +227,17 @@ void JitEngine::Run(const ShaderSetup& setup, ShaderUnit& state) const {
     shader->Run(setup, state, setup.entry_point);
 }
 
+void JitEngine::RunBatch(const ShaderSetup& setup, std::span<ShaderUnit> states) const {
+    ASSERT(setup.cached_shader != nullptr);
+
+    MICROPROFILE_SCOPE(GPU_Shader);
+
+    const JitShader* shader = static_cast<const JitShader*>(setup.cached_shader);
+    for (ShaderUnit& state : states) {
+        shader->Run(setup, state, setup.entry_point);
+    }
+}
+
 } // namespace Pica::Shader
 
 #endif // CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
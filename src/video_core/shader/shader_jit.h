@@ -8,8 +8,12 @@
 #if CITRA_ARCH(x86_64) || CITRA_ARCH(arm64)
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include "common/common_types.h"
+#include "common/file_util.h"
+#include "video_core/pica/shader_setup.h"
 #include "video_core/shader/shader.h"
 
 namespace Pica::Shader {
@@ -23,9 +27,24 @@ public:
 
     void SetupBatch(ShaderSetup& setup, u32 entry_point) override;
     void Run(const ShaderSetup& setup, ShaderUnit& state) const override;
+    void RunBatch(const ShaderSetup& setup, std::span<ShaderUnit> states) const override;
+    void SwitchDiskCache(u64 title_id) override;
 
 private:
+    JitShader* Compile(u64 cache_key, const ProgramCode& program_code,
+                       const SwizzleData& swizzle_data);
+
+    /// Appends a newly compiled program to the on-disk record of the current title.
+    void StoreProgram(u64 cache_key, const ProgramCode& program_code,
+                      const SwizzleData& swizzle_data);
+
     std::unordered_map<u64, std::unique_ptr<JitShader>> cache;
+
+    // The compiled programs are not stored themselves, as they embed host addresses. Instead the
+    // PICA programs a title has used are recorded and compiled again when the title boots.
+    std::optional<u64> disk_cache_title_id;
+    FileUtil::IOFile disk_cache_file;
+    std::unordered_set<u64> stored_programs;
 };
 
 } // namespace Pica::Shader
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+
+# Copyright Citra Emulator Project / Azahar Emulator Project
+# Licensed under GPLv2 or any later version
+# Refer to the license.txt file included.
+
+# Packs a custom texture directory into a single textures.pack file, which loads without scanning
+# the directory tree. The textures are matched to hashes the same way the emulator matches the
+# files of a directory: by the pack.json "textures" mappings and by their tex1_ filenames.
+# The file format is documented in src/video_core/custom_textures/texture_pack.h.
+#
+# Usage: ./tools/build-texture-pack.py <texture directory> [output file]
+# The output defaults to textures.pack inside the texture directory. The pack.json options are
+# still read from the texture directory, so keep it next to the pack.
+
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x4B505443
+VERSION = 1
+HEADER = struct.Struct("<IIIIQ")
+ENTRY = struct.Struct("<QQQII")
+PAYLOAD_ALIGNMENT = 16
+
+FILE_FORMATS = {"png": 1, "dds": 2, "ktx": 3}
+MAP_TYPES = {"norm": 1}
+TEXTURE_NAME = re.compile(r"tex1_(\d+)x(\d+)_([0-9A-Fa-f]+)_(\d+)")
+
+
+def read_mappings(directory):
+    mappings = {}
+    try:
+        with open(os.path.join(directory, "pack.json"), encoding="utf-8") as file:
+            config = json.load(file)
+    except FileNotFoundError:
+        return mappings
+    for key, value in config.get("textures", {}).items():
+        texture_hash = int(key, 16)
+        for path in [value] if isinstance(value, str) else value:
+            mappings.setdefault(os.path.basename(path), []).append(texture_hash)
+    return mappings
+
+
+def collect_textures(directory, mappings):
+    textures = []
+    for root, _, files in os.walk(directory):
+        for name in sorted(files):
+            parts = name.split(".")
+            if len(parts) > 3 or parts[-1] not in FILE_FORMATS:
+                continue
+            file_format = FILE_FORMATS[parts[-1]]
+            map_type = MAP_TYPES.get(parts[1], 0) if len(parts) == 3 else 0
+
+            hashes = list(mappings.get(name, []))
+            match = TEXTURE_NAME.match(parts[0])
+            if match and int(match.group(3), 16) not in hashes:
+                hashes.append(int(match.group(3), 16))
+            if hashes:
+                textures.append((os.path.join(root, name), file_format, map_type, hashes))
+    return textures
+
+
+def build_pack(directory, output):
+    textures = collect_textures(directory, read_mappings(directory))
+    entries = []
+    with open(output, "wb") as pack:
+        pack.write(b"\0" * HEADER.size)
+        for path, file_format, map_type, hashes in textures:
+            if os.path.abspath(path) == os.path.abspath(output):
+                continue
+            pack.write(b"\0" * (-pack.tell() % PAYLOAD_ALIGNMENT))
+            offset = pack.tell()
+            with open(path, "rb") as file:
+                data = file.read()
+            pack.write(data)
+            for texture_hash in hashes:
+                entries.append((texture_hash, offset, len(data), file_format, map_type))
+
+        # Materials can only have one texture of each map type, keep the first like the emulator.
+        entries.sort(key=lambda entry: (entry[0], entry[4]))
+        unique_entries = []
+        for entry in entries:
+            if unique_entries and unique_entries[-1][0] == entry[0] and \
+                    unique_entries[-1][4] == entry[4]:
+                print(f"Hash {entry[0]:016X} has several textures of the same type, ignoring one")
+                continue
+            unique_entries.append(entry)
+
+        pack.write(b"\0" * (-pack.tell() % 8))
+        index_offset = pack.tell()
+        for entry in unique_entries:
+            pack.write(ENTRY.pack(*entry))
+        pack.seek(0)
+        pack.write(HEADER.pack(MAGIC, VERSION, len(unique_entries), 0, index_offset))
+    print(f"Packed {len(textures)} files for {len(unique_entries)} textures into {output}")
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print(f"Usage: {sys.argv[0]} <texture directory> [output file]")
+        return 1
+    directory = sys.argv[1]
+    output = sys.argv[2] if len(sys.argv) == 3 else os.path.join(directory, "textures.pack")
+    build_pack(directory, output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())